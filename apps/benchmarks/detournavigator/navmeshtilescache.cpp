@@ -5,6 +5,7 @@
 #include <components/esm3/loadland.hpp>
 
 #include <algorithm>
+#include <chrono>
 #include <iterator>
 #include <random>
 
@@ -129,10 +130,8 @@ namespace
         return result;
     }
 
-    Key generateKey(std::size_t triangles, auto& random)
+    Key generateKey(std::size_t triangles, const AgentBounds& agentBounds, auto& random)
     {
-        const CollisionShapeType agentShapeType = CollisionShapeType::Aabb;
-        const osg::Vec3f agentHalfExtents = generateAgentHalfExtents(0.5, 1.5, random);
         const TilePosition tilePosition = generateVec2i(10000, random);
         const Version version{
             .mGeneration = std::uniform_int_distribution<std::size_t>(0, 100)(random),
@@ -143,7 +142,14 @@ namespace
         generateWater(std::back_inserter(water), 1, random);
         RecastMesh recastMesh(version, std::move(mesh), std::move(water), { generateHeightfield(random) },
             { generateFlatHeightfield(random) }, {});
-        return Key{ AgentBounds{ agentShapeType, agentHalfExtents }, tilePosition, std::move(recastMesh) };
+        return Key{ agentBounds, tilePosition, std::move(recastMesh) };
+    }
+
+    Key generateKey(std::size_t triangles, auto& random)
+    {
+        const CollisionShapeType agentShapeType = CollisionShapeType::Aabb;
+        const osg::Vec3f agentHalfExtents = generateAgentHalfExtents(0.5, 1.5, random);
+        return generateKey(triangles, AgentBounds{ agentShapeType, agentHalfExtents }, random);
     }
 
     constexpr std::size_t trianglesPerTile = 239;
@@ -266,6 +272,114 @@ namespace
     {
         setToBoundedNonEmptyCache<64 * 1024 * 1024>(state);
     }
+
+    // Generates keys of the agent to take the given share of the cache
+    std::vector<Key> generateAgentKeys(
+        const AgentBounds& agentBounds, std::size_t cacheSize, double share, auto& random)
+    {
+        std::vector<Key> result;
+        result.push_back(generateKey(trianglesPerTile, agentBounds, random));
+        const std::size_t itemSize
+            = sizeof(RecastMesh) + getSize(result.front().mRecastMesh) + sizeof(PreparedNavMeshData);
+        const auto count = static_cast<std::size_t>(share * static_cast<double>(cacheSize / itemSize));
+        std::generate_n(std::back_inserter(result), std::max<std::size_t>(count, 1) - 1,
+            [&] { return generateKey(trianglesPerTile, agentBounds, random); });
+        return result;
+    }
+
+    // Gets tiles of a single agent, every tile that is missing is generated again and set. Every tenth tile is
+    // expensive to generate. Reports the time that would be spent on generating the tiles again.
+    template <std::size_t maxCacheSize>
+    void getOrSetWithGenerationTime(benchmark::State& state, bool withGenerationTime)
+    {
+        const AgentBounds agentBounds{ CollisionShapeType::Aabb, osg::Vec3f(29, 29, 66) };
+        const auto getGenerationTime = [](std::size_t index) {
+            return index % 10 == 0 ? std::chrono::milliseconds(100) : std::chrono::milliseconds(1);
+        };
+        NavMeshTilesCache cache(maxCacheSize);
+        std::minstd_rand random;
+        const std::vector<Key> keys = generateAgentKeys(agentBounds, maxCacheSize, 2, random);
+        std::uniform_int_distribution<std::size_t> distribution(0, keys.size() - 1);
+        std::chrono::steady_clock::duration generationTime{};
+
+        for ([[maybe_unused]] auto _ : state)
+        {
+            const std::size_t index = distribution(random);
+            const Key& key = keys[index];
+            auto result = cache.get(key.mAgentBounds, key.mTilePosition, key.mRecastMesh);
+            if (!result)
+            {
+                generationTime += getGenerationTime(index);
+                result = cache.set(key.mAgentBounds, key.mTilePosition, key.mRecastMesh,
+                    std::make_unique<PreparedNavMeshData>(),
+                    withGenerationTime ? getGenerationTime(index) : std::chrono::steady_clock::duration());
+            }
+            benchmark::DoNotOptimize(result);
+        }
+
+        state.counters["GenerationTime"] = benchmark::Counter(
+            std::chrono::duration<double>(generationTime).count(), benchmark::Counter::kAvgIterations);
+    }
+
+    void getOrSetWithoutGenerationTime_16m(benchmark::State& state)
+    {
+        getOrSetWithGenerationTime<16 * 1024 * 1024>(state, false);
+    }
+
+    void getOrSetWithGenerationTime_16m(benchmark::State& state)
+    {
+        getOrSetWithGenerationTime<16 * 1024 * 1024>(state, true);
+    }
+
+    // Gets tiles of a common agent while tiles of a rare agent are set, reports the hit ratio of the common agent.
+    template <std::size_t maxCacheSize, std::size_t maxAgentCacheSize>
+    void getCommonWhileSettingRareAgentTiles(benchmark::State& state)
+    {
+        const AgentBounds commonAgentBounds{ CollisionShapeType::Aabb, osg::Vec3f(29, 29, 66) };
+        const AgentBounds rareAgentBounds{ CollisionShapeType::Aabb, osg::Vec3f(150, 150, 200) };
+        NavMeshTilesCache cache(maxCacheSize, maxAgentCacheSize);
+        std::minstd_rand random;
+        const std::vector<Key> keys = generateAgentKeys(commonAgentBounds, maxCacheSize, 0.75, random);
+        for (const Key& key : keys)
+            cache.set(key.mAgentBounds, key.mTilePosition, key.mRecastMesh, std::make_unique<PreparedNavMeshData>());
+        std::uniform_int_distribution<std::size_t> distribution(0, keys.size() - 1);
+        std::size_t hits = 0;
+        std::size_t gets = 0;
+        std::size_t n = 0;
+
+        for ([[maybe_unused]] auto _ : state)
+        {
+            if (n++ % 2 == 0)
+            {
+                const Key key = generateKey(trianglesPerTile, rareAgentBounds, random);
+                auto result = cache.set(
+                    key.mAgentBounds, key.mTilePosition, key.mRecastMesh, std::make_unique<PreparedNavMeshData>());
+                benchmark::DoNotOptimize(result);
+                continue;
+            }
+            const Key& key = keys[distribution(random)];
+            auto result = cache.get(key.mAgentBounds, key.mTilePosition, key.mRecastMesh);
+            ++gets;
+            if (result)
+                ++hits;
+            else
+                result = cache.set(
+                    key.mAgentBounds, key.mTilePosition, key.mRecastMesh, std::make_unique<PreparedNavMeshData>());
+            benchmark::DoNotOptimize(result);
+        }
+
+        state.counters["HitRatio"] = gets == 0 ? 0.0 : static_cast<double>(hits) / static_cast<double>(gets);
+    }
+
+    void getCommonWhileSettingRareAgentTiles_16m_without_quota(benchmark::State& state)
+    {
+        getCommonWhileSettingRareAgentTiles<16 * 1024 * 1024, 16 * 1024 * 1024>(state);
+    }
+
+    void getCommonWhileSettingRareAgentTiles_16m_4m_quota(benchmark::State& state)
+    {
+        getCommonWhileSettingRareAgentTiles<16 * 1024 * 1024, 4 * 1024 * 1024>(state);
+    }
 } // namespace
 
 BENCHMARK(getFromFilledCache_1m_100hit);
@@ -280,5 +394,9 @@ BENCHMARK(setToBoundedNonEmptyCache_1m);
 BENCHMARK(setToBoundedNonEmptyCache_4m);
 BENCHMARK(setToBoundedNonEmptyCache_16m);
 BENCHMARK(setToBoundedNonEmptyCache_64m);
+BENCHMARK(getOrSetWithoutGenerationTime_16m);
+BENCHMARK(getOrSetWithGenerationTime_16m);
+BENCHMARK(getCommonWhileSettingRareAgentTiles_16m_without_quota);
+BENCHMARK(getCommonWhileSettingRareAgentTiles_16m_4m_quota);
 
 BENCHMARK_MAIN();
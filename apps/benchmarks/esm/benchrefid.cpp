@@ -4,8 +4,10 @@
 
 #include <algorithm>
 #include <cstddef>
+#include <map>
 #include <random>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
 namespace
@@ -99,6 +101,101 @@ namespace
         return generateSerializedRefIds(generateESM3ExteriorCellRefIds(random), serialize);
     }
 
+    // Content file ids are mostly a few shared prefixes followed by a name and a number, like "misc_com_bottle_07"
+    template <class Random>
+    std::vector<ESM::RefId> generateContentRefIds(std::size_t count, Random& random)
+    {
+        constexpr std::string_view prefixes[] = { "misc_", "misc_com_", "ingred_", "p_", "a_", "ex_", "furn_", "light_",
+            "in_", "t_" };
+        std::uniform_int_distribution<std::size_t> prefixDistribution(0, std::size(prefixes) - 1);
+        std::uniform_int_distribution<std::size_t> sizeDistribution(4, 16);
+        std::uniform_int_distribution<int> numberDistribution(0, 99);
+        std::vector<ESM::RefId> result;
+        result.reserve(count);
+        std::generate_n(std::back_inserter(result), count, [&] {
+            std::string value(prefixes[prefixDistribution(random)]);
+            value += generateText(sizeDistribution(random), random);
+            value += '_';
+            value += std::to_string(numberDistribution(random));
+            return ESM::RefId::stringRefId(value);
+        });
+        return result;
+    }
+
+    // A few ids like gold and common ingredients are looked up much more often than the others
+    template <class Random>
+    std::vector<ESM::RefId> generateLookups(const std::vector<ESM::RefId>& refIds, Random& random)
+    {
+        std::geometric_distribution<std::size_t> distribution(16.0 / refIds.size());
+        std::vector<ESM::RefId> result;
+        result.reserve(refIdsCount);
+        std::generate_n(std::back_inserter(result), refIdsCount,
+            [&] { return refIds[std::min(distribution(random), refIds.size() - 1)]; });
+        return result;
+    }
+
+    template <class Map>
+    void findRefIdInMap(benchmark::State& state)
+    {
+        std::minstd_rand random;
+        const std::vector<ESM::RefId> refIds = generateContentRefIds(state.range(0), random);
+        Map map;
+        for (const ESM::RefId& refId : refIds)
+            map.emplace(refId, 0);
+        const std::vector<ESM::RefId> lookups = generateLookups(refIds, random);
+        std::size_t i = 0;
+        for ([[maybe_unused]] auto _ : state)
+        {
+            benchmark::DoNotOptimize(map.find(lookups[i]));
+            if (++i >= lookups.size())
+                i = 0;
+        }
+    }
+
+    template <class Map>
+    void insertRefIdsIntoMap(benchmark::State& state)
+    {
+        std::minstd_rand random;
+        const std::vector<ESM::RefId> refIds = generateContentRefIds(state.range(0), random);
+        for ([[maybe_unused]] auto _ : state)
+        {
+            Map map;
+            for (const ESM::RefId& refId : refIds)
+                map.emplace(refId, 0);
+            benchmark::DoNotOptimize(map);
+        }
+        state.SetItemsProcessed(state.iterations() * refIds.size());
+    }
+
+    void compareRefIds(benchmark::State& state)
+    {
+        std::minstd_rand random;
+        const std::vector<ESM::RefId> refIds = generateContentRefIds(state.range(0), random);
+        const std::vector<ESM::RefId> lookups = generateLookups(refIds, random);
+        std::size_t i = 0;
+        for ([[maybe_unused]] auto _ : state)
+        {
+            benchmark::DoNotOptimize(lookups[i] == lookups[(i + 1) % lookups.size()]);
+            if (++i >= lookups.size())
+                i = 0;
+        }
+    }
+
+    void compareRefIdWithString(benchmark::State& state)
+    {
+        std::minstd_rand random;
+        const std::vector<ESM::RefId> refIds = generateContentRefIds(state.range(0), random);
+        const std::vector<ESM::RefId> lookups = generateLookups(refIds, random);
+        const std::string value = lookups.front().getRefIdString();
+        std::size_t i = 0;
+        for ([[maybe_unused]] auto _ : state)
+        {
+            benchmark::DoNotOptimize(lookups[i] == value);
+            if (++i >= lookups.size())
+                i = 0;
+        }
+    }
+
     void serializeRefId(benchmark::State& state)
     {
         std::minstd_rand random;
@@ -246,4 +343,11 @@ BENCHMARK(deserializeTextIndexRefId);
 BENCHMARK(serializeTextESM3ExteriorCellRefId);
 BENCHMARK(deserializeTextESM3ExteriorCellRefId);
 
+BENCHMARK(findRefIdInMap<std::map<ESM::RefId, int>>)->RangeMultiplier(8)->Range(64, 32 * 1024);
+BENCHMARK(findRefIdInMap<std::unordered_map<ESM::RefId, int>>)->RangeMultiplier(8)->Range(64, 32 * 1024);
+BENCHMARK(insertRefIdsIntoMap<std::map<ESM::RefId, int>>)->RangeMultiplier(8)->Range(64, 32 * 1024);
+BENCHMARK(insertRefIdsIntoMap<std::unordered_map<ESM::RefId, int>>)->RangeMultiplier(8)->Range(64, 32 * 1024);
+BENCHMARK(compareRefIds)->Arg(1024);
+BENCHMARK(compareRefIdWithString)->Arg(1024);
+
 BENCHMARK_MAIN();
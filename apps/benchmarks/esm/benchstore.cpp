@@ -0,0 +1,133 @@
+#include <benchmark/benchmark.h>
+
+#include "apps/openmw/mwworld/store.hpp"
+
+#include <components/esm3/loadstat.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace
+{
+    template <class Random>
+    std::string generateText(std::size_t size, Random& random)
+    {
+        std::uniform_int_distribution<int> distribution('a', 'z');
+        std::string result;
+        result.reserve(size);
+        std::generate_n(std::back_inserter(result), size, [&] { return distribution(random); });
+        return result;
+    }
+
+    template <class Random>
+    std::vector<ESM::RefId> generateRefIds(std::size_t count, Random& random)
+    {
+        std::vector<ESM::RefId> result;
+        result.reserve(count);
+        std::generate_n(
+            std::back_inserter(result), count, [&] { return ESM::RefId::stringRefId(generateText(16, random)); });
+        return result;
+    }
+
+    void fillStore(const std::vector<ESM::RefId>& refIds, bool flat, MWWorld::Store<ESM::Static>& store)
+    {
+        for (const ESM::RefId& refId : refIds)
+        {
+            ESM::Static record;
+            record.blank();
+            record.mId = refId;
+            record.mModel = "meshes/" + refId.getRefIdString() + ".nif";
+            store.insertStatic(record);
+        }
+        if (flat)
+            store.makeFlat();
+    }
+
+    void searchStore(benchmark::State& state, bool flat)
+    {
+        std::minstd_rand random;
+        const std::vector<ESM::RefId> refIds = generateRefIds(state.range(0), random);
+        MWWorld::Store<ESM::Static> store;
+        fillStore(refIds, flat, store);
+        std::vector<ESM::RefId> queries = refIds;
+        std::shuffle(queries.begin(), queries.end(), random);
+        std::size_t i = 0;
+        for ([[maybe_unused]] auto _ : state)
+        {
+            benchmark::DoNotOptimize(store.search(queries[i]));
+            if (++i >= queries.size())
+                i = 0;
+        }
+    }
+
+    void searchMissingInStore(benchmark::State& state, bool flat)
+    {
+        std::minstd_rand random;
+        MWWorld::Store<ESM::Static> store;
+        fillStore(generateRefIds(state.range(0), random), flat, store);
+        const std::vector<ESM::RefId> queries = generateRefIds(state.range(0), random);
+        std::size_t i = 0;
+        for ([[maybe_unused]] auto _ : state)
+        {
+            benchmark::DoNotOptimize(store.search(queries[i]));
+            if (++i >= queries.size())
+                i = 0;
+        }
+    }
+
+    void iterateStore(benchmark::State& state, bool flat)
+    {
+        std::minstd_rand random;
+        MWWorld::Store<ESM::Static> store;
+        fillStore(generateRefIds(state.range(0), random), flat, store);
+        for ([[maybe_unused]] auto _ : state)
+        {
+            std::size_t size = 0;
+            for (const ESM::Static& record : store)
+                size += record.mModel.size();
+            benchmark::DoNotOptimize(size);
+        }
+    }
+
+    void searchMapStore(benchmark::State& state)
+    {
+        searchStore(state, false);
+    }
+
+    void searchFlatStore(benchmark::State& state)
+    {
+        searchStore(state, true);
+    }
+
+    void searchMissingInMapStore(benchmark::State& state)
+    {
+        searchMissingInStore(state, false);
+    }
+
+    void searchMissingInFlatStore(benchmark::State& state)
+    {
+        searchMissingInStore(state, true);
+    }
+
+    void iterateMapStore(benchmark::State& state)
+    {
+        iterateStore(state, false);
+    }
+
+    void iterateFlatStore(benchmark::State& state)
+    {
+        iterateStore(state, true);
+    }
+}
+
+BENCHMARK(searchMapStore)->RangeMultiplier(8)->Range(64, 32 * 1024);
+BENCHMARK(searchFlatStore)->RangeMultiplier(8)->Range(64, 32 * 1024);
+BENCHMARK(searchMissingInMapStore)->RangeMultiplier(8)->Range(64, 32 * 1024);
+BENCHMARK(searchMissingInFlatStore)->RangeMultiplier(8)->Range(64, 32 * 1024);
+BENCHMARK(iterateMapStore)->RangeMultiplier(8)->Range(64, 32 * 1024);
+BENCHMARK(iterateFlatStore)->RangeMultiplier(8)->Range(64, 32 * 1024);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,148 @@
+#include <benchmark/benchmark.h>
+
+#include <components/misc/strings/algorithm.hpp>
+#include <components/misc/strings/lower.hpp>
+#include <components/vfs/pathutil.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <iterator>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace
+{
+    constexpr std::size_t valuesCount = 1024;
+
+    template <class Random>
+    std::string generateText(std::size_t size, Random& random)
+    {
+        std::uniform_int_distribution<int> distribution('A', 'z');
+        std::string result;
+        result.reserve(size);
+        std::generate_n(std::back_inserter(result), size, [&] { return distribution(random); });
+        return result;
+    }
+
+    template <class Random>
+    std::vector<std::string> generateValues(std::size_t size, Random& random)
+    {
+        std::vector<std::string> result;
+        result.reserve(valuesCount);
+        std::generate_n(std::back_inserter(result), valuesCount, [&] { return generateText(size, random); });
+        return result;
+    }
+
+    template <class Random>
+    std::vector<std::string> generatePaths(std::size_t size, Random& random)
+    {
+        std::vector<std::string> result = generateValues(size, random);
+        for (std::string& value : result)
+            for (std::size_t i = 7; i < value.size(); i += 8)
+                value[i] = '\\';
+        return result;
+    }
+
+    // The same values with different case, equal ignoring case
+    std::vector<std::string> swapCase(const std::vector<std::string>& values)
+    {
+        std::vector<std::string> result = values;
+        for (std::string& value : result)
+            for (char& c : value)
+                if (c >= 'a' && c <= 'z')
+                    c = static_cast<char>(c - 'a' + 'A');
+                else if (c >= 'A' && c <= 'Z')
+                    c = static_cast<char>(c - 'A' + 'a');
+        return result;
+    }
+
+    void lowerCaseInPlace(benchmark::State& state)
+    {
+        std::minstd_rand random;
+        const std::vector<std::string> values = generateValues(state.range(0), random);
+        std::string value;
+        std::size_t i = 0;
+        for ([[maybe_unused]] auto _ : state)
+        {
+            value = values[i];
+            Misc::StringUtils::lowerCaseInPlace(value);
+            benchmark::DoNotOptimize(value);
+            if (++i >= values.size())
+                i = 0;
+        }
+        state.SetBytesProcessed(state.iterations() * state.range(0));
+    }
+
+    void ciEqual(benchmark::State& state)
+    {
+        std::minstd_rand random;
+        const std::vector<std::string> values = generateValues(state.range(0), random);
+        const std::vector<std::string> others = swapCase(values);
+        std::size_t i = 0;
+        for ([[maybe_unused]] auto _ : state)
+        {
+            benchmark::DoNotOptimize(Misc::StringUtils::ciEqual(values[i], others[i]));
+            if (++i >= values.size())
+                i = 0;
+        }
+        state.SetBytesProcessed(state.iterations() * state.range(0));
+    }
+
+    void ciLess(benchmark::State& state)
+    {
+        std::minstd_rand random;
+        std::vector<std::string> values = generateValues(state.range(0), random);
+        // A common prefix like the ones of the names of many records
+        for (std::string& value : values)
+            std::fill_n(value.begin(), value.size() / 2, 'a');
+        const std::vector<std::string> others = swapCase(values);
+        std::size_t i = 0;
+        for ([[maybe_unused]] auto _ : state)
+        {
+            benchmark::DoNotOptimize(Misc::StringUtils::ciLess(values[i], others[(i + 1) % others.size()]));
+            if (++i >= values.size())
+                i = 0;
+        }
+        state.SetBytesProcessed(state.iterations() * state.range(0));
+    }
+
+    void ciHash(benchmark::State& state)
+    {
+        std::minstd_rand random;
+        const std::vector<std::string> values = generateValues(state.range(0), random);
+        std::size_t i = 0;
+        for ([[maybe_unused]] auto _ : state)
+        {
+            benchmark::DoNotOptimize(Misc::StringUtils::CiHash()(values[i]));
+            if (++i >= values.size())
+                i = 0;
+        }
+        state.SetBytesProcessed(state.iterations() * state.range(0));
+    }
+
+    void normalizeFilenameInPlace(benchmark::State& state)
+    {
+        std::minstd_rand random;
+        const std::vector<std::string> values = generatePaths(state.range(0), random);
+        std::string value;
+        std::size_t i = 0;
+        for ([[maybe_unused]] auto _ : state)
+        {
+            value = values[i];
+            VFS::Path::normalizeFilenameInPlace(value);
+            benchmark::DoNotOptimize(value);
+            if (++i >= values.size())
+                i = 0;
+        }
+        state.SetBytesProcessed(state.iterations() * state.range(0));
+    }
+}
+
+BENCHMARK(lowerCaseInPlace)->RangeMultiplier(4)->Range(8, 512);
+BENCHMARK(ciEqual)->RangeMultiplier(4)->Range(8, 512);
+BENCHMARK(ciLess)->RangeMultiplier(4)->Range(8, 512);
+BENCHMARK(ciHash)->RangeMultiplier(4)->Range(8, 512);
+BENCHMARK(normalizeFilenameInPlace)->RangeMultiplier(4)->Range(8, 512);
+
+BENCHMARK_MAIN();
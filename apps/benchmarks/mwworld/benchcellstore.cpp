@@ -0,0 +1,102 @@
+#include <benchmark/benchmark.h>
+
+#include "apps/openmw/mwbase/environment.hpp"
+#include "apps/openmw/mwworld/cell.hpp"
+#include "apps/openmw/mwworld/cellstore.hpp"
+#include "apps/openmw/mwworld/esmstore.hpp"
+#include "apps/openmw/mwworld/livecellref.hpp"
+#include "apps/openmw/mwworld/ptr.hpp"
+#include "apps/openmw/mwworld/worldmodel.hpp"
+
+#include <components/esm3/loadcell.hpp>
+#include <components/esm3/loadnpc.hpp>
+#include <components/esm3/loadstat.hpp>
+#include <components/esm3/readerscache.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace
+{
+    ESM::Cell makeCell(const std::string& name)
+    {
+        ESM::Cell cell;
+        cell.blank();
+        cell.mName = name;
+        cell.mId = ESM::RefId::stringRefId(name);
+        cell.mData.mFlags = ESM::Cell::Interior;
+        return cell;
+    }
+
+    ESM::CellRef makeCellRef(const ESM::RefId& id, std::uint32_t index)
+    {
+        ESM::CellRef cellRef;
+        cellRef.blank();
+        cellRef.mRefID = id;
+        cellRef.mRefNum = ESM::RefNum{ .mIndex = index, .mContentFile = 0 };
+        return cellRef;
+    }
+
+    // Every iteration walks the given number of actors to a neighbouring cell and back and visits every reference
+    void forEachWithActorsWalkingBetweenCells(benchmark::State& state)
+    {
+        constexpr std::uint32_t refsCount = 2000;
+        const std::size_t walkingCount = static_cast<std::size_t>(state.range(0));
+
+        ESM::Static staticRecord;
+        staticRecord.blank();
+        staticRecord.mId = ESM::RefId::stringRefId("static");
+        ESM::NPC npcRecord;
+        npcRecord.blank();
+        npcRecord.mId = ESM::RefId::stringRefId("npc");
+
+        MWWorld::ESMStore store;
+        store.insert(staticRecord);
+        store.insert(npcRecord);
+        ESM::ReadersCache readers;
+        MWWorld::WorldModel worldModel(store, readers);
+        MWBase::Environment environment;
+        environment.setWorldModel(worldModel);
+
+        MWWorld::CellStore cell(MWWorld::Cell(makeCell("cell")), store, readers);
+        MWWorld::CellStore neighbour(MWWorld::Cell(makeCell("neighbour")), store, readers);
+        cell.load();
+        neighbour.load();
+
+        std::vector<MWWorld::Ptr> actors;
+        for (std::uint32_t i = 0; i < refsCount; ++i)
+        {
+            if (i < walkingCount)
+            {
+                const MWWorld::LiveCellRef<ESM::NPC> ref(makeCellRef(npcRecord.mId, i), &npcRecord);
+                actors.emplace_back(cell.insert(&ref), &cell);
+            }
+            else
+            {
+                const MWWorld::LiveCellRef<ESM::Static> ref(makeCellRef(staticRecord.mId, i), &staticRecord);
+                cell.insert(&ref);
+            }
+        }
+
+        for ([[maybe_unused]] auto _ : state)
+        {
+            for (MWWorld::Ptr& actor : actors)
+                actor = cell.moveTo(actor, &neighbour);
+            for (MWWorld::Ptr& actor : actors)
+                actor = neighbour.moveTo(actor, &cell);
+
+            std::size_t count = 0;
+            cell.forEach([&](const MWWorld::Ptr& /*ptr*/) {
+                ++count;
+                return true;
+            });
+            benchmark::DoNotOptimize(count);
+        }
+    }
+}
+
+BENCHMARK(forEachWithActorsWalkingBetweenCells)->Arg(0)->Arg(1)->Arg(8)->Arg(64);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,368 @@
+#include <benchmark/benchmark.h>
+
+#include <components/bsa/bsafile.hpp>
+#include <components/files/conversion.hpp>
+#include <components/nif/niffile.hpp>
+#include <components/nifosg/nifloader.hpp>
+#include <components/resource/bgsmfilemanager.hpp>
+#include <components/resource/bulletshapemanager.hpp>
+#include <components/resource/imagemanager.hpp>
+#include <components/resource/niffilemanager.hpp>
+#include <components/resource/objectcache.hpp>
+#include <components/resource/resourcesystem.hpp>
+#include <components/resource/scenemanager.hpp>
+#include <components/resource/shardedobjectcache.hpp>
+#include <components/testing/util.hpp>
+#include <components/toutf8/toutf8.hpp>
+#include <components/vfs/bsaarchive.hpp>
+#include <components/vfs/filesystemarchive.hpp>
+#include <components/vfs/manager.hpp>
+#include <components/vfs/recursivedirectoryiterator.hpp>
+
+#include <osg/Node>
+
+#include <algorithm>
+#include <cctype>
+#include <cstdlib>
+#include <filesystem>
+#include <format>
+#include <functional>
+#include <iostream>
+#include <iterator>
+#include <memory>
+#include <random>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace
+{
+    // Assets are generated by the benchmarks to be reproducible, files of the type are taken from this data directory
+    // for the benchmarks that need real assets
+    constexpr const char* dataDirectoryVariable = "OPENMW_BENCHMARK_DATA";
+
+    constexpr std::size_t filesCount = 4096;
+    constexpr std::size_t fileSize = 4096;
+    // Number of files of each type taken from the data directory
+    constexpr std::size_t dataFilesCount = 256;
+
+    // The cache used by the resource managers
+    using ShardedObjectCache = Resource::ShardedObjectCache<std::string, VFS::Path::Hash>;
+
+    std::vector<VFS::Path::Normalized> generatePaths()
+    {
+        std::vector<VFS::Path::Normalized> result;
+        result.reserve(filesCount);
+        for (std::size_t i = 0; i < filesCount; ++i)
+            result.emplace_back(std::format("meshes/directory{}/file{}.nif", i % 64, i));
+        return result;
+    }
+
+    std::string generateContent(std::size_t index)
+    {
+        std::minstd_rand random(static_cast<std::minstd_rand::result_type>(index + 1));
+        std::uniform_int_distribution<int> distribution(0, 255);
+        std::string result(fileSize, '\0');
+        for (char& c : result)
+            c = static_cast<char>(distribution(random));
+        return result;
+    }
+
+    struct TestVfs
+    {
+        std::vector<VFS::Path::Normalized> mPaths = generatePaths();
+        std::vector<std::unique_ptr<TestingOpenMW::VFSTestFile>> mFiles;
+        std::unique_ptr<VFS::Manager> mVfs;
+
+        TestVfs()
+        {
+            VFS::FileMap files;
+            for (std::size_t i = 0; i < mPaths.size(); ++i)
+            {
+                mFiles.push_back(std::make_unique<TestingOpenMW::VFSTestFile>(generateContent(i)));
+                files.emplace(mPaths[i], mFiles.back().get());
+            }
+            mVfs = TestingOpenMW::createTestVFS(std::move(files));
+        }
+    };
+
+    const TestVfs& getTestVfs()
+    {
+        static const TestVfs vfs;
+        return vfs;
+    }
+
+    std::filesystem::path getTestBsaPath()
+    {
+        static const std::filesystem::path path = [] {
+            const std::filesystem::path result = TestingOpenMW::outputFilePath("benchmark.bsa");
+            Bsa::BSAFile bsa;
+            bsa.open(result);
+            const std::vector<VFS::Path::Normalized> paths = generatePaths();
+            for (std::size_t i = 0; i < paths.size(); ++i)
+            {
+                std::stringstream content(generateContent(i));
+                bsa.addFile(std::string(paths[i].value()), content);
+            }
+            bsa.close();
+            return result;
+        }();
+        return path;
+    }
+
+    std::string readAll(Files::IStreamPtr&& stream)
+    {
+        return std::string(std::istreambuf_iterator<char>(*stream), std::istreambuf_iterator<char>());
+    }
+
+    void vfsExists(benchmark::State& state)
+    {
+        const TestVfs& vfs = getTestVfs();
+        std::size_t i = 0;
+        for (auto _ : state)
+        {
+            benchmark::DoNotOptimize(vfs.mVfs->exists(vfs.mPaths[i]));
+            i = (i + 1) % vfs.mPaths.size();
+        }
+    }
+
+    void vfsExistsNotNormalized(benchmark::State& state)
+    {
+        const TestVfs& vfs = getTestVfs();
+        std::vector<std::string> paths;
+        for (const VFS::Path::Normalized& path : vfs.mPaths)
+        {
+            std::string value(path.value());
+            std::replace(value.begin(), value.end(), '/', '\\');
+            value[0] = static_cast<char>(std::toupper(static_cast<unsigned char>(value[0])));
+            paths.push_back(std::move(value));
+        }
+        std::size_t i = 0;
+        for (auto _ : state)
+        {
+            benchmark::DoNotOptimize(vfs.mVfs->exists(VFS::Path::Normalized(paths[i])));
+            i = (i + 1) % paths.size();
+        }
+    }
+
+    void vfsGet(benchmark::State& state)
+    {
+        const TestVfs& vfs = getTestVfs();
+        std::size_t i = 0;
+        for (auto _ : state)
+        {
+            benchmark::DoNotOptimize(vfs.mVfs->get(vfs.mPaths[i]));
+            i = (i + 1) % vfs.mPaths.size();
+        }
+    }
+
+    // Argument: use memory mapping
+    void bsaReadFile(benchmark::State& state)
+    {
+        VFS::Manager vfs;
+        vfs.addArchive(VFS::makeBsaArchive(getTestBsaPath(), nullptr, state.range(0) != 0));
+        vfs.buildIndex();
+        const std::vector<VFS::Path::Normalized> paths = generatePaths();
+        std::size_t i = 0;
+        for (auto _ : state)
+        {
+            benchmark::DoNotOptimize(readAll(vfs.get(paths[i])));
+            i = (i + 1) % paths.size();
+        }
+        state.SetBytesProcessed(static_cast<std::int64_t>(state.iterations() * fileSize));
+    }
+
+    std::vector<std::string> generateKeys()
+    {
+        std::vector<std::string> result;
+        for (const VFS::Path::Normalized& path : generatePaths())
+            result.emplace_back(path.value());
+        return result;
+    }
+
+    template <class Cache>
+    Cache& getObjectCache()
+    {
+        static const osg::ref_ptr<Cache> cache = [] {
+            osg::ref_ptr<Cache> result(new Cache);
+            for (const std::string& key : generateKeys())
+                result->addEntryToObjectCache(key, new osg::Node);
+            return result;
+        }();
+        return *cache;
+    }
+
+    template <class Cache>
+    void objectCacheGet(benchmark::State& state)
+    {
+        Cache& cache = getObjectCache<Cache>();
+        const std::vector<std::string> keys = generateKeys();
+        std::minstd_rand random(static_cast<std::minstd_rand::result_type>(state.thread_index() + 1));
+        std::uniform_int_distribution<std::size_t> distribution(0, keys.size() - 1);
+        for (auto _ : state)
+            benchmark::DoNotOptimize(cache.getRefFromObjectCache(keys[distribution(random)]));
+    }
+
+    template <class Cache>
+    void objectCacheAdd(benchmark::State& state)
+    {
+        Cache& cache = getObjectCache<Cache>();
+        const std::vector<std::string> keys = generateKeys();
+        std::minstd_rand random(static_cast<std::minstd_rand::result_type>(state.thread_index() + 1));
+        std::uniform_int_distribution<std::size_t> distribution(0, keys.size() - 1);
+        const osg::ref_ptr<osg::Node> node(new osg::Node);
+        for (auto _ : state)
+            cache.addEntryToObjectCache(keys[distribution(random)], node.get());
+    }
+
+    struct DataDirectory
+    {
+        VFS::Manager mVfs;
+        ToUTF8::Utf8Encoder mEncoder{ ToUTF8::WINDOWS_1252 };
+        std::vector<VFS::Path::Normalized> mMeshes;
+        std::vector<VFS::Path::Normalized> mTextures;
+
+        explicit DataDirectory(const std::filesystem::path& path)
+        {
+            mVfs.addArchive(std::make_unique<VFS::FileSystemArchive>(path));
+            mVfs.buildIndex();
+            for (const VFS::Path::Normalized& file : mVfs.getRecursiveDirectoryIterator())
+            {
+                if (mMeshes.size() < dataFilesCount && file.value().starts_with("meshes/")
+                    && file.value().ends_with(".nif"))
+                    mMeshes.push_back(file);
+                if (mTextures.size() < dataFilesCount && file.value().starts_with("textures/")
+                    && file.value().ends_with(".dds"))
+                    mTextures.push_back(file);
+            }
+        }
+    };
+
+    void nifFileParse(benchmark::State& state, const DataDirectory& data)
+    {
+        std::vector<std::string> contents;
+        for (const VFS::Path::Normalized& path : data.mMeshes)
+            contents.push_back(readAll(data.mVfs.get(path)));
+        std::size_t i = 0;
+        std::int64_t bytes = 0;
+        for (auto _ : state)
+        {
+            Nif::NIFFile file(data.mMeshes[i]);
+            Nif::Reader reader(file, nullptr);
+            reader.parse(std::make_unique<std::istringstream>(contents[i]));
+            bytes += static_cast<std::int64_t>(contents[i].size());
+            i = (i + 1) % contents.size();
+        }
+        state.SetBytesProcessed(bytes);
+    }
+
+    void nifOsgLoaderLoad(benchmark::State& state, const DataDirectory& data)
+    {
+        Resource::ImageManager imageManager(&data.mVfs, 0);
+        Resource::BgsmFileManager materialManager(&data.mVfs, 0);
+        std::vector<std::unique_ptr<Nif::NIFFile>> files;
+        for (const VFS::Path::Normalized& path : data.mMeshes)
+        {
+            files.push_back(std::make_unique<Nif::NIFFile>(path));
+            Nif::Reader reader(*files.back(), nullptr);
+            reader.parse(data.mVfs.get(path));
+        }
+        std::size_t i = 0;
+        for (auto _ : state)
+        {
+            benchmark::DoNotOptimize(NifOsg::Loader::load(*files[i], &imageManager, &materialManager));
+            i = (i + 1) % files.size();
+        }
+    }
+
+    // Set OPENMW_OPTIMIZE=OFF to measure without the optimizer, the options are read once per process
+    void sceneManagerGetTemplate(benchmark::State& state, const DataDirectory& data)
+    {
+        Resource::ResourceSystem resourceSystem(&data.mVfs, 0, &data.mEncoder.getStatelessEncoder());
+        Resource::SceneManager& sceneManager = *resourceSystem.getSceneManager();
+        std::size_t i = 0;
+        for (auto _ : state)
+        {
+            benchmark::DoNotOptimize(sceneManager.getTemplate(data.mMeshes[i], false));
+            i = (i + 1) % data.mMeshes.size();
+            // Keep the parsed files and images cached to measure the conversion
+            state.PauseTiming();
+            sceneManager.clearCache();
+            state.ResumeTiming();
+        }
+    }
+
+    void imageManagerGetImage(benchmark::State& state, const DataDirectory& data)
+    {
+        Resource::ImageManager imageManager(&data.mVfs, 0);
+        std::size_t i = 0;
+        for (auto _ : state)
+        {
+            benchmark::DoNotOptimize(imageManager.getImage(data.mTextures[i]));
+            i = (i + 1) % data.mTextures.size();
+            state.PauseTiming();
+            imageManager.clearCache();
+            state.ResumeTiming();
+        }
+    }
+
+    void bulletShapeManagerGetShape(benchmark::State& state, const DataDirectory& data)
+    {
+        Resource::ResourceSystem resourceSystem(&data.mVfs, 0, &data.mEncoder.getStatelessEncoder());
+        Resource::BulletShapeManager bulletShapeManager(
+            &data.mVfs, resourceSystem.getSceneManager(), resourceSystem.getNifFileManager(), 0);
+        std::size_t i = 0;
+        for (auto _ : state)
+        {
+            benchmark::DoNotOptimize(bulletShapeManager.getShape(data.mMeshes[i]));
+            i = (i + 1) % data.mMeshes.size();
+            // Keep the parsed files cached to measure the shape creation
+            state.PauseTiming();
+            bulletShapeManager.clearCache();
+            state.ResumeTiming();
+        }
+    }
+}
+
+BENCHMARK(vfsExists);
+BENCHMARK(vfsExistsNotNormalized);
+BENCHMARK(vfsGet);
+BENCHMARK(bsaReadFile)->Arg(0)->Arg(1);
+
+BENCHMARK_TEMPLATE(objectCacheGet, Resource::GenericObjectCache<std::string>)->ThreadRange(1, 8);
+BENCHMARK_TEMPLATE(objectCacheGet, ShardedObjectCache)->ThreadRange(1, 8);
+BENCHMARK_TEMPLATE(objectCacheAdd, Resource::GenericObjectCache<std::string>)->ThreadRange(1, 8);
+BENCHMARK_TEMPLATE(objectCacheAdd, ShardedObjectCache)->ThreadRange(1, 8);
+
+int main(int argc, char* argv[])
+{
+    benchmark::Initialize(&argc, argv);
+
+    std::unique_ptr<DataDirectory> data;
+    if (const char* path = std::getenv(dataDirectoryVariable))
+    {
+        data = std::make_unique<DataDirectory>(Files::pathFromUnicodeString(path));
+
+        if (!data->mMeshes.empty())
+        {
+            benchmark::RegisterBenchmark("nifFileParse", nifFileParse, std::cref(*data));
+            benchmark::RegisterBenchmark("nifOsgLoaderLoad", nifOsgLoaderLoad, std::cref(*data));
+            benchmark::RegisterBenchmark("sceneManagerGetTemplate", sceneManagerGetTemplate, std::cref(*data));
+            benchmark::RegisterBenchmark("bulletShapeManagerGetShape", bulletShapeManagerGetShape, std::cref(*data));
+        }
+
+        if (!data->mTextures.empty())
+            benchmark::RegisterBenchmark("imageManagerGetImage", imageManagerGetImage, std::cref(*data));
+    }
+    else
+    {
+        std::cerr << "Set " << dataDirectoryVariable
+                  << " to a data directory to run the benchmarks that need meshes and textures" << std::endl;
+    }
+
+    benchmark::RunSpecifiedBenchmarks();
+    benchmark::Shutdown();
+
+    return 0;
+}
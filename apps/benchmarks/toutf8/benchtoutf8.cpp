@@ -0,0 +1,76 @@
+#include <benchmark/benchmark.h>
+
+#include <components/toutf8/toutf8.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <iterator>
+#include <random>
+#include <string>
+
+namespace
+{
+    // Every nth character is not ASCII, 0 for ASCII only text
+    template <class Random>
+    std::string generateText(std::size_t size, std::size_t nonAsciiPeriod, Random& random)
+    {
+        std::uniform_int_distribution<int> ascii(' ', '~');
+        std::uniform_int_distribution<int> nonAscii(0xc0, 0xff);
+        std::string result;
+        result.reserve(size);
+        for (std::size_t i = 0; i < size; ++i)
+        {
+            if (nonAsciiPeriod != 0 && i % nonAsciiPeriod == nonAsciiPeriod - 1)
+                result.push_back(static_cast<char>(nonAscii(random)));
+            else
+                result.push_back(static_cast<char>(ascii(random)));
+        }
+        return result;
+    }
+
+    void getUtf8(benchmark::State& state, ToUTF8::FromType encoding, std::size_t nonAsciiPeriod)
+    {
+        std::minstd_rand random;
+        const std::string input = generateText(static_cast<std::size_t>(state.range(0)), nonAsciiPeriod, random);
+        ToUTF8::Utf8Encoder encoder(encoding);
+        for ([[maybe_unused]] auto _ : state)
+            benchmark::DoNotOptimize(encoder.getUtf8(input));
+        state.SetBytesProcessed(state.iterations() * input.size());
+    }
+
+    void getUtf8FromStateless(benchmark::State& state, ToUTF8::FromType encoding, std::size_t nonAsciiPeriod)
+    {
+        std::minstd_rand random;
+        const std::string input = generateText(static_cast<std::size_t>(state.range(0)), nonAsciiPeriod, random);
+        const ToUTF8::StatelessUtf8Encoder encoder(encoding);
+        std::string buffer;
+        for ([[maybe_unused]] auto _ : state)
+            benchmark::DoNotOptimize(
+                encoder.getUtf8(input, ToUTF8::BufferAllocationPolicy::FitToRequiredSize, buffer));
+        state.SetBytesProcessed(state.iterations() * input.size());
+    }
+
+    void getLegacyEnc(benchmark::State& state, ToUTF8::FromType encoding, std::size_t nonAsciiPeriod)
+    {
+        std::minstd_rand random;
+        const std::string legacy = generateText(static_cast<std::size_t>(state.range(0)), nonAsciiPeriod, random);
+        ToUTF8::Utf8Encoder encoder(encoding);
+        const std::string input(encoder.getUtf8(legacy));
+        for ([[maybe_unused]] auto _ : state)
+            benchmark::DoNotOptimize(encoder.getLegacyEnc(input));
+        state.SetBytesProcessed(state.iterations() * input.size());
+    }
+}
+
+BENCHMARK_CAPTURE(getUtf8, ascii, ToUTF8::WINDOWS_1252, 0)->RangeMultiplier(8)->Range(8, 64 * 1024);
+// Like books with typographic quotes
+BENCHMARK_CAPTURE(getUtf8, mostly_ascii, ToUTF8::WINDOWS_1252, 200)->RangeMultiplier(8)->Range(8, 64 * 1024);
+BENCHMARK_CAPTURE(getUtf8, cyrillic, ToUTF8::WINDOWS_1251, 2)->RangeMultiplier(8)->Range(8, 64 * 1024);
+BENCHMARK_CAPTURE(getUtf8FromStateless, ascii, ToUTF8::WINDOWS_1252, 0)->RangeMultiplier(8)->Range(8, 64 * 1024);
+BENCHMARK_CAPTURE(getUtf8FromStateless, mostly_ascii, ToUTF8::WINDOWS_1252, 200)
+    ->RangeMultiplier(8)
+    ->Range(8, 64 * 1024);
+BENCHMARK_CAPTURE(getLegacyEnc, ascii, ToUTF8::WINDOWS_1252, 0)->RangeMultiplier(8)->Range(8, 64 * 1024);
+BENCHMARK_CAPTURE(getLegacyEnc, mostly_ascii, ToUTF8::WINDOWS_1252, 200)->RangeMultiplier(8)->Range(8, 64 * 1024);
+
+BENCHMARK_MAIN();
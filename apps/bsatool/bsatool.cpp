@@ -1,7 +1,9 @@
+#include <algorithm>
 #include <filesystem>
 #include <fstream>
 #include <iomanip>
 #include <iostream>
+#include <unordered_map>
 #include <vector>
 
 #include <boost/program_options.hpp>
@@ -13,6 +15,8 @@
 #include <components/files/conversion.hpp>
 #include <components/misc/strings/algorithm.hpp>
 #include <components/misc/strings/conversion.hpp>
+#include <components/vfs/accesslog.hpp>
+#include <components/vfs/pathutil.hpp>
 
 #define BSATOOL_VERSION 1.1
 
@@ -26,6 +30,8 @@ struct Arguments
     std::filesystem::path extractfile;
     std::filesystem::path addfile;
     std::filesystem::path outdir;
+    std::filesystem::path sourcedir;
+    std::filesystem::path accesslog;
 
     bool longformat;
     bool fullpath;
@@ -50,6 +56,11 @@ Usages:
 
   bsatool create [-c] archivefile
       Create an archive.
+
+  bsatool repack archivefile source_directory [access_log]
+      Create an archive from all files of the directory. Files found in the access log
+      written by the engine with "record resource access" come first in the order they
+      were opened, others follow.
 Allowed options)");
 
     auto addOption = desc.add_options();
@@ -104,7 +115,7 @@ Allowed options)");
 
     info.mode = variables["mode"].as<std::string>();
     if (!(info.mode == "list" || info.mode == "extract" || info.mode == "extractall" || info.mode == "add"
-            || info.mode == "create"))
+            || info.mode == "create" || info.mode == "repack"))
     {
         std::cout << std::endl << "ERROR: invalid mode \"" << info.mode << "\"\n\n" << desc << std::endl;
         return false;
@@ -148,6 +159,17 @@ Allowed options)");
             info.addfile = inputFiles[1].u8string(); // This call to u8string is redundant, but required to build on
                                                      // MSVC 14.26 due to implementation bugs.
     }
+    else if (info.mode == "repack")
+    {
+        if (inputFiles.size() < 2)
+        {
+            std::cout << "\nERROR: source directory unspecified\n\n" << desc << std::endl;
+            return false;
+        }
+        info.sourcedir = inputFiles[1].u8string();
+        if (inputFiles.size() > 2)
+            info.accesslog = inputFiles[2].u8string();
+    }
     else if (inputFiles.size() > 1)
         info.outdir = inputFiles[1].u8string(); // This call to u8string is redundant, but required to build on
                                                 // MSVC 14.26 due to implementation bugs.
@@ -284,6 +306,86 @@ int add(std::unique_ptr<File>& bsa, Arguments& info)
     return 0;
 }
 
+int repack(Arguments& info)
+{
+    if (std::filesystem::exists(info.filename))
+    {
+        std::cout << "ERROR: " << Files::pathToUnicodeString(info.filename) << " already exists" << std::endl;
+        return 3;
+    }
+
+    struct SourceFile
+    {
+        std::filesystem::path mPath;
+        std::string mName;
+    };
+
+    std::vector<SourceFile> files;
+    std::unordered_map<std::string, std::size_t> indices;
+    for (const auto& entry : std::filesystem::recursive_directory_iterator(info.sourcedir))
+    {
+        if (!entry.is_regular_file())
+            continue;
+        std::string name = Files::pathToUnicodeString(entry.path().lexically_relative(info.sourcedir));
+        Misc::StringUtils::replaceAll(name, "/", "\\");
+        indices.emplace(VFS::Path::normalizeFilename(name), files.size());
+        files.push_back(SourceFile{ entry.path(), std::move(name) });
+    }
+
+    // Files from the access log go first and keep their order, the rest of the files follow sorted by path to
+    // keep the files of the same directory together
+    std::vector<std::size_t> order;
+    order.reserve(files.size());
+    std::vector<bool> added(files.size(), false);
+    if (!info.accesslog.empty())
+    {
+        std::ifstream log(info.accesslog);
+        if (!log)
+        {
+            std::cout << "ERROR: failed to open " << Files::pathToUnicodeString(info.accesslog) << std::endl;
+            return 3;
+        }
+        for (const VFS::Path::Normalized& path : VFS::readAccessLog(log))
+        {
+            const auto it = indices.find(path.value());
+            if (it == indices.end() || added[it->second])
+                continue;
+            added[it->second] = true;
+            order.push_back(it->second);
+        }
+    }
+    const std::size_t logged = order.size();
+    for (std::size_t i = 0; i < files.size(); ++i)
+        if (!added[i])
+            order.push_back(i);
+    std::sort(order.begin() + static_cast<std::ptrdiff_t>(logged), order.end(),
+        [&](std::size_t l, std::size_t r) { return files[l].mName < files[r].mName; });
+
+    std::size_t namesSize = 0;
+    for (const SourceFile& file : files)
+        namesSize += file.mName.size();
+
+    Bsa::BSAFile bsa;
+    bsa.open(info.filename);
+    bsa.reserveDirectory(files.size(), namesSize);
+    for (const std::size_t i : order)
+    {
+        std::ifstream stream(files[i].mPath, std::ios_base::binary);
+        if (!stream)
+        {
+            std::cout << "ERROR: failed to open " << Files::pathToUnicodeString(files[i].mPath) << std::endl;
+            return 3;
+        }
+        bsa.addFile(files[i].mName, stream);
+    }
+    bsa.close();
+
+    std::cout << "Packed " << files.size() << " files, " << logged << " of them in the access log order"
+              << std::endl;
+
+    return 0;
+}
+
 template <typename File>
 int call(Arguments& info)
 {
@@ -325,6 +427,9 @@ int main(int argc, char** argv)
         if (info.mode == "create")
             return call<Bsa::BSAFile>(info);
 
+        if (info.mode == "repack")
+            return repack(info);
+
         Bsa::BsaVersion bsaVersion = Bsa::BSAFile::detectVersion(info.filename);
 
         switch (bsaVersion)
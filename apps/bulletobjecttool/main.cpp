@@ -23,22 +23,30 @@
 #include <components/toutf8/toutf8.hpp>
 #include <components/version/version.hpp>
 #include <components/vfs/manager.hpp>
+#include <components/vfs/pathutil.hpp>
 #include <components/vfs/registerarchives.hpp>
 
 #include <boost/program_options.hpp>
 
+#include <algorithm>
+#include <atomic>
 #include <charconv>
+#include <chrono>
 #include <cstddef>
 #include <cstdint>
+#include <exception>
 #include <filesystem>
 #include <iomanip>
+#include <iostream>
 #include <limits>
 #include <map>
 #include <memory>
 #include <ostream>
+#include <span>
 #include <string>
 #include <string_view>
 #include <system_error>
+#include <thread>
 #include <type_traits>
 #include <utility>
 #include <vector>
@@ -89,6 +97,13 @@ namespace
             bpo::value<Fallback::FallbackMap>()->default_value(Fallback::FallbackMap(), "")->multitoken()->composing(),
             "fallback values");
 
+        addOption("threads",
+            bpo::value<std::size_t>()->default_value(std::max<std::size_t>(std::thread::hardware_concurrency(), 1)),
+            "number of threads to load shapes in parallel");
+
+        addOption("slowest", bpo::value<std::size_t>()->default_value(10),
+            "number of shapes with the longest load time to report");
+
         Files::ConfigurationManager::addCommonOptions(result);
 
         return result;
@@ -106,6 +121,59 @@ namespace
         }
     };
 
+    struct ShapeLoadTime
+    {
+        std::chrono::steady_clock::duration mDuration;
+        VFS::Path::NormalizedView mModel;
+    };
+
+    // Loads the shapes on multiple threads to have them in cache when they are used, returns how long each one took
+    std::vector<ShapeLoadTime> loadShapes(Resource::BulletShapeManager& bulletShapeManager,
+        std::span<const VFS::Path::Normalized> models, std::size_t threadsNumber)
+    {
+        std::vector<ShapeLoadTime> result(models.size());
+        std::atomic_size_t next{ 0 };
+
+        const auto load = [&] {
+            for (std::size_t i = next++; i < models.size(); i = next++)
+            {
+                const auto start = std::chrono::steady_clock::now();
+                try
+                {
+                    bulletShapeManager.getShape(models[i]);
+                }
+                catch (const std::exception& e)
+                {
+                    Log(Debug::Warning) << "Failed to load shape \"" << models[i] << "\": " << e.what();
+                }
+                result[i] = ShapeLoadTime{ std::chrono::steady_clock::now() - start, models[i] };
+                Log(Debug::Verbose) << "Loaded shape \"" << models[i] << "\" in "
+                                    << std::chrono::duration<double, std::milli>(result[i].mDuration).count()
+                                    << " ms";
+            }
+        };
+
+        std::vector<std::thread> threads;
+        for (std::size_t i = 1; i < threadsNumber; ++i)
+            threads.emplace_back(load);
+        load();
+        for (std::thread& thread : threads)
+            thread.join();
+
+        return result;
+    }
+
+    void reportSlowest(std::vector<ShapeLoadTime>& loadTimes, std::size_t count)
+    {
+        count = std::min(count, loadTimes.size());
+        std::partial_sort(loadTimes.begin(), loadTimes.begin() + static_cast<std::ptrdiff_t>(count), loadTimes.end(),
+            [](const ShapeLoadTime& lhs, const ShapeLoadTime& rhs) { return lhs.mDuration > rhs.mDuration; });
+        for (std::size_t i = 0; i < count; ++i)
+            Log(Debug::Info) << "Shape \"" << loadTimes[i].mModel << "\" took "
+                             << std::chrono::duration<double, std::milli>(loadTimes[i].mDuration).count()
+                             << " ms to load";
+    }
+
     int runBulletObjectTool(int argc, char* argv[])
     {
         Platform::init();
@@ -130,6 +198,14 @@ namespace
 
         Debug::setupLogging(config.getLogPath(), applicationName);
 
+        const std::size_t threadsNumber = variables["threads"].as<std::size_t>();
+
+        if (threadsNumber < 1)
+        {
+            std::cerr << "Invalid threads number: " << threadsNumber << ", expected >= 1";
+            return -1;
+        }
+
         const std::string encoding(variables["encoding"].as<std::string>());
         Log(Debug::Info) << ToUTF8::encodingUsingMessage(encoding);
         ToUTF8::Utf8Encoder encoder(ToUTF8::calculateEncoding(encoding));
@@ -178,6 +254,17 @@ namespace
         Resource::SceneManager sceneManager(&vfs, &imageManager, &nifFileManager, &bgsmFileManager, expiryDelay);
         Resource::BulletShapeManager bulletShapeManager(&vfs, &sceneManager, &nifFileManager, expiryDelay);
 
+        {
+            const std::vector<VFS::Path::Normalized> models = Resource::getBulletObjectModels(readers, vfs, esmData);
+            Log(Debug::Info) << "Loading " << models.size() << " shapes using " << threadsNumber << " threads...";
+            const auto start = std::chrono::steady_clock::now();
+            std::vector<ShapeLoadTime> loadTimes = loadShapes(bulletShapeManager, models, threadsNumber);
+            Log(Debug::Info) << "Loaded " << models.size() << " shapes in "
+                             << std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count()
+                             << " s";
+            reportSlowest(loadTimes, variables["slowest"].as<std::size_t>());
+        }
+
         Resource::forEachBulletObject(
             readers, vfs, bulletShapeManager, esmData, [](const ESM::Cell& cell, const Resource::BulletObject& object) {
                 Log(Debug::Verbose) << "Found bullet object in " << (cell.isExterior() ? "exterior" : "interior")
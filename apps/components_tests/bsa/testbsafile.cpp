@@ -13,6 +13,7 @@
 #include <filesystem>
 #include <format>
 #include <fstream>
+#include <iterator>
 #include <memory>
 #include <sstream>
 #include <vector>
@@ -219,6 +220,94 @@ namespace Bsa
                 }));
         }
 
+        TEST(BSAFileTest, memoryMappedShouldReadSameContentAsStream)
+        {
+            const std::filesystem::path path = makeOutputPath();
+            const std::string content = "abcd";
+
+            {
+                std::ofstream stream;
+                stream.exceptions(std::ifstream::failbit | std::ifstream::badbit);
+
+                stream.open(path, std::ios::binary);
+
+                const Header header{
+                    .mFormat = static_cast<std::uint32_t>(BsaVersion::Uncompressed),
+                    .mDirSize = 14,
+                    .mFileCount = 1,
+                };
+
+                const BSAFile::Hash hash{
+                    .mLow = 0xaaaabbbb,
+                    .mHigh = 0xccccdddd,
+                };
+
+                const Archive archive{
+                    .mHeader = header,
+                    .mOffsets = { static_cast<std::uint32_t>(content.size()), 0, 0 },
+                    .mStringBuffer = { 'a', '\0' },
+                    .mHashes = { hash },
+                    .mTailSize = 0,
+                };
+
+                writeArchive(archive, stream);
+                stream.write(content.data(), content.size());
+            }
+
+            for (const bool memoryMapped : { false, true })
+            {
+                BSAFile file;
+                file.setMemoryMapped(memoryMapped);
+                file.open(path);
+
+                ASSERT_EQ(file.getList().size(), 1);
+                Files::IStreamPtr stream = file.getFile(&file.getList().front());
+                const std::string actual(std::istreambuf_iterator<char>(*stream), {});
+                EXPECT_EQ(actual, content) << "memoryMapped=" << memoryMapped;
+            }
+        }
+
+        TEST(BSAFileTest, filesAddedAfterReserveDirectoryShouldBeStoredInTheSameOrder)
+        {
+            const std::filesystem::path path = makeOutputPath();
+            std::filesystem::remove(path);
+            const std::vector<std::pair<std::string, std::string>> files = {
+                { "b\\second", "bbbb" },
+                { "a\\first", "aa" },
+                { "c", "cccccc" },
+            };
+
+            {
+                BSAFile file;
+                file.open(path);
+                std::size_t namesSize = 0;
+                for (const auto& [name, content] : files)
+                    namesSize += name.size();
+                file.reserveDirectory(files.size(), namesSize);
+                for (const auto& [name, content] : files)
+                {
+                    std::istringstream stream(content);
+                    file.addFile(name, stream);
+                }
+                file.close();
+            }
+
+            BSAFile file;
+            file.open(path);
+            ASSERT_EQ(file.getList().size(), files.size());
+            std::uint32_t offset = file.getList().front().mOffset;
+            EXPECT_EQ(offset, 12 + 20 * files.size() + std::size("b\\second") + std::size("a\\first") + std::size("c"));
+            for (std::size_t i = 0; i < files.size(); ++i)
+            {
+                const BSAFile::FileStruct& fileStruct = file.getList()[i];
+                EXPECT_EQ(fileStruct.name(), files[i].first);
+                EXPECT_EQ(fileStruct.mOffset, offset);
+                Files::IStreamPtr stream = file.getFile(&fileStruct);
+                EXPECT_EQ(std::string(std::istreambuf_iterator<char>(*stream), {}), files[i].second);
+                offset += fileStruct.mFileSize;
+            }
+        }
+
         TEST(BSAFileTest, shouldHandleTwoFiles)
         {
             const std::filesystem::path path = makeOutputPath();
@@ -0,0 +1,104 @@
+#include <components/debug/logfilter.hpp>
+
+#include <gtest/gtest.h>
+
+namespace
+{
+    using namespace testing;
+    using namespace Debug;
+
+    using Clock = LogFilter::Clock;
+
+    TEST(DebugLogFilterTest, differentLinesShouldBeWritten)
+    {
+        LogFilter filter;
+        LogFilter::Skipped skipped;
+        const Clock::time_point now = Clock::now();
+        EXPECT_TRUE(filter.filter("a\n", Info, now, skipped));
+        EXPECT_TRUE(filter.filter("b\n", Info, now, skipped));
+        EXPECT_EQ(skipped.mRepeated, 0);
+        EXPECT_EQ(skipped.mDropped, 0);
+    }
+
+    TEST(DebugLogFilterTest, repeatedLineShouldBeCountedAndReportedBeforeNextLine)
+    {
+        LogFilter filter;
+        LogFilter::Skipped skipped;
+        const Clock::time_point now = Clock::now();
+        EXPECT_TRUE(filter.filter("a\n", Info, now, skipped));
+        EXPECT_FALSE(filter.filter("a\n", Info, now, skipped));
+        EXPECT_FALSE(filter.filter("a\n", Info, now, skipped));
+        EXPECT_TRUE(filter.filter("b\n", Info, now, skipped));
+        EXPECT_EQ(skipped.mRepeated, 2);
+        EXPECT_EQ(skipped.mDropped, 0);
+    }
+
+    TEST(DebugLogFilterTest, sameLineWithDifferentLevelShouldBeWritten)
+    {
+        LogFilter filter;
+        LogFilter::Skipped skipped;
+        const Clock::time_point now = Clock::now();
+        EXPECT_TRUE(filter.filter("a\n", Info, now, skipped));
+        EXPECT_TRUE(filter.filter("a\n", Warning, now, skipped));
+    }
+
+    TEST(DebugLogFilterTest, linesBeyondBurstShouldBeDropped)
+    {
+        LogFilter filter;
+        LogFilter::Skipped skipped;
+        const Clock::time_point now = Clock::now();
+        for (std::size_t i = 0; i < LogFilter::sMaxBurst; ++i)
+            ASSERT_TRUE(filter.filter(std::to_string(i), Info, now, skipped)) << i;
+        EXPECT_FALSE(filter.filter("dropped", Info, now, skipped));
+        EXPECT_EQ(filter.takeSkipped().mDropped, 1);
+    }
+
+    TEST(DebugLogFilterTest, errorsShouldNeverBeDropped)
+    {
+        LogFilter filter;
+        LogFilter::Skipped skipped;
+        const Clock::time_point now = Clock::now();
+        for (std::size_t i = 0; i < LogFilter::sMaxBurst; ++i)
+            ASSERT_TRUE(filter.filter(std::to_string(i), Info, now, skipped)) << i;
+        EXPECT_FALSE(filter.filter("dropped", Info, now, skipped));
+        EXPECT_TRUE(filter.filter("error", Error, now, skipped));
+        EXPECT_EQ(skipped.mDropped, 1);
+    }
+
+    TEST(DebugLogFilterTest, linesShouldBeWrittenAgainAfterRefill)
+    {
+        LogFilter filter;
+        LogFilter::Skipped skipped;
+        const Clock::time_point now = Clock::now();
+        for (std::size_t i = 0; i < LogFilter::sMaxBurst; ++i)
+            ASSERT_TRUE(filter.filter(std::to_string(i), Info, now, skipped)) << i;
+        EXPECT_FALSE(filter.filter("dropped", Info, now, skipped));
+        EXPECT_TRUE(filter.filter("written", Info, now + std::chrono::seconds(1), skipped));
+        EXPECT_EQ(skipped.mDropped, 1);
+    }
+
+    TEST(DebugLogFilterTest, repeatsOfDroppedLineShouldBeCountedAsDropped)
+    {
+        LogFilter filter;
+        LogFilter::Skipped skipped;
+        const Clock::time_point now = Clock::now();
+        for (std::size_t i = 0; i < LogFilter::sMaxBurst; ++i)
+            ASSERT_TRUE(filter.filter(std::to_string(i), Info, now, skipped)) << i;
+        EXPECT_FALSE(filter.filter("dropped", Info, now, skipped));
+        EXPECT_FALSE(filter.filter("dropped", Info, now, skipped));
+        const LogFilter::Skipped result = filter.takeSkipped();
+        EXPECT_EQ(result.mRepeated, 0);
+        EXPECT_EQ(result.mDropped, 2);
+    }
+
+    TEST(DebugLogFilterTest, takeSkippedShouldReset)
+    {
+        LogFilter filter;
+        LogFilter::Skipped skipped;
+        const Clock::time_point now = Clock::now();
+        EXPECT_TRUE(filter.filter("a\n", Info, now, skipped));
+        EXPECT_FALSE(filter.filter("a\n", Info, now, skipped));
+        EXPECT_EQ(filter.takeSkipped().mRepeated, 1);
+        EXPECT_EQ(filter.takeSkipped().mRepeated, 0);
+    }
+}
@@ -0,0 +1,98 @@
+#include <components/debug/tracing.hpp>
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <sstream>
+#include <thread>
+
+namespace
+{
+    using namespace testing;
+    using namespace Debug;
+
+    struct DebugTracingTest : Test
+    {
+        ~DebugTracingTest() override { Tracing::setCapacity(0); }
+    };
+
+    std::vector<const char*> getNames(const TraceThread& thread)
+    {
+        std::vector<const char*> result;
+        for (const TraceEvent& event : thread.mEvents)
+            result.push_back(event.mName);
+        return result;
+    }
+
+    TEST_F(DebugTracingTest, zoneShouldNotBeRecordedWhenDisabled)
+    {
+        {
+            TraceZone zone("zone");
+        }
+        EXPECT_THAT(Tracing::collect(), IsEmpty());
+    }
+
+    TEST_F(DebugTracingTest, zoneShouldBeRecordedWhenEnabled)
+    {
+        Tracing::setCapacity(4);
+        Tracing::setThreadName("main");
+        {
+            TraceZone zone("zone");
+        }
+        const std::vector<TraceThread> threads = Tracing::collect();
+        ASSERT_EQ(threads.size(), 1u);
+        EXPECT_EQ(threads[0].mName, "main");
+        EXPECT_THAT(getNames(threads[0]), ElementsAre(StrEq("zone")));
+        EXPECT_LE(threads[0].mEvents[0].mBegin, threads[0].mEvents[0].mEnd);
+    }
+
+    TEST_F(DebugTracingTest, collectShouldReturnLatestZonesOldestFirst)
+    {
+        Tracing::setCapacity(2);
+        for (const char* name : { "a", "b", "c" })
+            TraceZone zone(name);
+        const std::vector<TraceThread> threads = Tracing::collect();
+        ASSERT_EQ(threads.size(), 1u);
+        EXPECT_THAT(getNames(threads[0]), ElementsAre(StrEq("b"), StrEq("c")));
+    }
+
+    TEST_F(DebugTracingTest, collectShouldReturnZonesOfEveryThread)
+    {
+        Tracing::setCapacity(2);
+        {
+            TraceZone zone("main");
+        }
+        std::thread([] { TraceZone zone("other"); }).join();
+        const std::vector<TraceThread> threads = Tracing::collect();
+        ASSERT_EQ(threads.size(), 2u);
+        EXPECT_NE(threads[0].mId, threads[1].mId);
+    }
+
+    TEST_F(DebugTracingTest, setCapacityShouldDropRecordedZones)
+    {
+        Tracing::setCapacity(2);
+        {
+            TraceZone zone("zone");
+        }
+        Tracing::setCapacity(2);
+        EXPECT_THAT(Tracing::collect(), IsEmpty());
+    }
+
+    TEST_F(DebugTracingTest, writeChromeTraceShouldWriteCompleteEventsAndThreadNames)
+    {
+        const TraceClock::time_point start{};
+        const std::vector<TraceThread> threads{
+            TraceThread{ 3, "Main \"thread\"",
+                { TraceEvent{ "Physics", start + std::chrono::microseconds(10), start + std::chrono::microseconds(25) },
+                    TraceEvent{ "Lua", start, start + std::chrono::microseconds(5) } } },
+        };
+        std::ostringstream stream;
+        Tracing::writeChromeTrace(threads, stream);
+        EXPECT_EQ(stream.str(),
+            "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n"
+            "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":3,\"args\":{\"name\":\"Main \\\"thread\\\"\"}},\n"
+            "{\"name\":\"Physics\",\"ph\":\"X\",\"pid\":1,\"tid\":3,\"ts\":10.000,\"dur\":15.000},\n"
+            "{\"name\":\"Lua\",\"ph\":\"X\",\"pid\":1,\"tid\":3,\"ts\":0.000,\"dur\":5.000}\n"
+            "]}\n");
+    }
+}
@@ -156,6 +156,35 @@ namespace
         EXPECT_EQ(tile->mVersion, navMeshFormatVersion);
     }
 
+    TEST_F(DetourNavigatorAsyncNavMeshUpdaterTest, stop_should_commit_tiles_written_to_db_in_open_transaction)
+    {
+        mRecastMeshManager.setWorldspace(mWorldspace, nullptr);
+        addHeightFieldPlane(mRecastMeshManager);
+        addObject(mBox, mRecastMeshManager);
+        mSettings.mDbTransactionTiles = 100;
+        mSettings.mDbTransactionInterval = std::chrono::hours(1);
+        auto db = std::make_unique<NavMeshDb>(":memory:", std::numeric_limits<std::uint64_t>::max());
+        NavMeshDb* const dbPtr = db.get();
+        AsyncNavMeshUpdater updater(mSettings, mRecastMeshManager, mOffMeshConnectionsManager, std::move(db));
+        const auto navMeshCacheItem = std::make_shared<GuardedNavMeshCacheItem>(1, mSettings);
+        const TilePosition tilePosition{ 0, 0 };
+        const std::map<TilePosition, ChangeType> changedTiles{ { tilePosition, ChangeType::add } };
+        updater.post(mAgentBounds, navMeshCacheItem, mPlayerTile, mWorldspace, changedTiles);
+        updater.wait(WaitConditionType::allJobsDone, &mListener);
+        updater.stop();
+        // Fails if the transaction is still open
+        ASSERT_NO_THROW(dbPtr->startTransaction().commit());
+        const auto recastMesh = mRecastMeshManager.getMesh(mWorldspace, tilePosition);
+        ASSERT_NE(recastMesh, nullptr);
+        ShapeId nextShapeId{ 1 };
+        const std::vector<DbRefGeometryObject> objects = makeDbRefGeometryObjects(recastMesh->getMeshSources(),
+            [&](const MeshSource& v) { return resolveMeshSource(*dbPtr, v, nextShapeId); });
+        const auto tile = dbPtr->findTile(
+            mWorldspace, tilePosition, serialize(mSettings.mRecast, mAgentBounds, *recastMesh, objects));
+        ASSERT_TRUE(tile.has_value());
+        EXPECT_EQ(tile->mTileId, 1);
+    }
+
     TEST_F(DetourNavigatorAsyncNavMeshUpdaterTest, post_when_writing_to_db_disabled_should_not_write_tiles)
     {
         mRecastMeshManager.setWorldspace(mWorldspace, nullptr);
@@ -581,6 +610,82 @@ namespace
         EXPECT_EQ((*job)->mChangedTile, TilePosition(1, 0));
     }
 
+    TEST_F(DetourNavigatorJobQueueTest, pop_should_return_demanded_before_nearest_to_player_tile)
+    {
+        std::list<Job> jobs;
+
+        JobQueue queue;
+        queue.push(jobs.emplace(jobs.end(), mAgentBounds, mNavMeshCacheItem, mWorldspace, TilePosition(1, 0),
+            ChangeType::update, mProcessTime));
+        queue.push(jobs.emplace(jobs.end(), mAgentBounds, mNavMeshCacheItem, mWorldspace, TilePosition(3, 0),
+            ChangeType::update, mProcessTime));
+
+        queue.demand(mAgentBounds, TilePosition(3, 0));
+        queue.demand(mAgentBounds, TilePosition(3, 0));
+        queue.demand(mAgentBounds, TilePosition(3, 0));
+
+        EXPECT_EQ(queue.getStats().mDemanded, 1);
+
+        const auto job = queue.pop(mPlayerTile);
+        ASSERT_TRUE(job.has_value());
+        EXPECT_EQ((*job)->mChangedTile, TilePosition(3, 0));
+        EXPECT_EQ((*job)->mDemand, 3);
+        EXPECT_EQ(queue.getStats().mDemanded, 0);
+    }
+
+    TEST_F(DetourNavigatorJobQueueTest, pop_should_return_nearest_to_player_tile_when_demand_is_too_low)
+    {
+        std::list<Job> jobs;
+
+        JobQueue queue;
+        queue.push(jobs.emplace(jobs.end(), mAgentBounds, mNavMeshCacheItem, mWorldspace, TilePosition(1, 0),
+            ChangeType::update, mProcessTime));
+        queue.push(jobs.emplace(jobs.end(), mAgentBounds, mNavMeshCacheItem, mWorldspace, TilePosition(3, 0),
+            ChangeType::update, mProcessTime));
+
+        queue.demand(mAgentBounds, TilePosition(3, 0));
+
+        const auto job = queue.pop(mPlayerTile);
+        ASSERT_TRUE(job.has_value());
+        EXPECT_EQ((*job)->mChangedTile, TilePosition(1, 0));
+    }
+
+    TEST_F(DetourNavigatorJobQueueTest, demand_should_be_ignored_for_other_agent_bounds)
+    {
+        const AgentBounds otherAgentBounds{ CollisionShapeType::Aabb, osg::Vec3f(2, 2, 2) };
+
+        std::list<Job> jobs;
+
+        JobQueue queue;
+        queue.push(jobs.emplace(
+            jobs.end(), mAgentBounds, mNavMeshCacheItem, mWorldspace, mChangedTile, ChangeType::update, mProcessTime));
+
+        queue.demand(otherAgentBounds, mChangedTile);
+
+        EXPECT_EQ(queue.getStats().mDemanded, 0);
+    }
+
+    TEST_F(DetourNavigatorJobQueueTest, update_should_keep_demand_of_ready_delayed)
+    {
+        const std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+        const std::chrono::steady_clock::time_point processTime = now + std::chrono::seconds(1);
+
+        std::list<Job> jobs;
+        const JobIt job = jobs.emplace(
+            jobs.end(), mAgentBounds, mNavMeshCacheItem, mWorldspace, mChangedTile, ChangeType::update, processTime);
+
+        JobQueue queue;
+        queue.push(job, now);
+        queue.demand(mAgentBounds, mChangedTile, now);
+
+        EXPECT_EQ(job->mDemand, 1);
+        EXPECT_EQ(job->mFirstDemandTime, now);
+
+        queue.update(mPlayerTile, mMaxTiles, processTime);
+
+        EXPECT_EQ(queue.getStats().mDemanded, 1);
+    }
+
     TEST_F(DetourNavigatorJobQueueTest, push_on_processing_time_more_than_now_should_add_to_delayed)
     {
         const std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
@@ -21,6 +21,7 @@
 #include <gtest/gtest.h>
 
 #include <array>
+#include <chrono>
 #include <condition_variable>
 #include <deque>
 #include <limits>
@@ -200,6 +201,40 @@ namespace
         EXPECT_THAT(mPath, ElementsAre(Vec3fEq(56.66666412353515625, 460, 1.99998295307159423828125))) << mPath;
     }
 
+    TEST_F(DetourNavigatorNavigatorTest, request_path_for_not_existing_agent_should_be_done_without_navmesh)
+    {
+        const std::shared_ptr<const PathRequest> request
+            = mNavigator->requestPath(PathQuery{ mAgentBounds, mStart, mEnd, Flag_walk, mAreaCosts, mEndTolerance });
+        ASSERT_TRUE(request->isDone());
+        EXPECT_EQ(request->getStatus(), Status::NavMeshNotFound);
+        EXPECT_TRUE(request->getPath().empty());
+    }
+
+    TEST_F(DetourNavigatorNavigatorTest, update_then_request_path_should_return_path)
+    {
+        const HeightfieldSurface surface = makeSquareHeightfieldSurface(defaultHeightfieldData);
+        const int cellSize = heightfieldTileSize * static_cast<int>(surface.mSize - 1);
+
+        ASSERT_TRUE(mNavigator->addAgent(mAgentBounds));
+        auto updateGuard = mNavigator->makeUpdateGuard();
+        mNavigator->addHeightfield(mCellPosition, cellSize, surface, updateGuard.get());
+        mNavigator->update(mPlayerPosition, updateGuard.get());
+        updateGuard.reset();
+        mNavigator->wait(WaitConditionType::requiredTilesPresent, &mListener);
+
+        const std::shared_ptr<const PathRequest> request
+            = mNavigator->requestPath(PathQuery{ mAgentBounds, mStart, mEnd, Flag_walk, mAreaCosts, mEndTolerance });
+        for (int i = 0; i < 1000 && !request->isDone(); ++i)
+            std::this_thread::sleep_for(std::chrono::milliseconds(10));
+
+        ASSERT_TRUE(request->isDone());
+        EXPECT_EQ(request->getStatus(), Status::Success);
+        EXPECT_THAT(request->getPath(),
+            ElementsAre( //
+                Vec3fEq(56.66664886474609375, 460, 1.99999392032623291015625),
+                Vec3fEq(460, 56.66664886474609375, 1.99999392032623291015625)));
+    }
+
     TEST_F(DetourNavigatorNavigatorTest, add_object_should_change_navmesh)
     {
         mSettings.mWaitUntilMinDistanceToPlayer = 0;
@@ -1,14 +1,22 @@
 #include "generate.hpp"
 
 #include <components/detournavigator/navmeshdb.hpp>
+#include <components/files/conversion.hpp>
+#include <components/testing/util.hpp>
 
 #include <DetourAlloc.h>
 
 #include <gmock/gmock.h>
 #include <gtest/gtest.h>
 
+#include <algorithm>
+#include <chrono>
+#include <filesystem>
+#include <functional>
+#include <optional>
 #include <limits>
 #include <random>
+#include <vector>
 
 namespace
 {
@@ -84,6 +92,42 @@ namespace
         EXPECT_EQ(row->mData, data);
     }
 
+    TEST_F(DetourNavigatorNavMeshDbTest, get_tiles_data_should_return_data_for_each_key_in_the_same_order)
+    {
+        const ESM::RefId worldspace = ESM::RefId::stringRefId("sys::default");
+        const std::vector<std::byte> missingInput = generateData();
+        std::vector<std::vector<std::byte>> inputs;
+        std::vector<std::vector<std::byte>> datas;
+        std::vector<TileKey> keys;
+        const int count = static_cast<int>(NavMeshDb::sTilesDataBatchSize) + 3;
+        for (int i = 0; i < count; ++i)
+        {
+            inputs.push_back(generateData());
+            datas.push_back(generateData());
+        }
+        for (int i = 0; i < count; ++i)
+        {
+            const TilePosition tilePosition{ i, -i };
+            ASSERT_EQ(
+                mDb.insertTile(TileId{ i + 1 }, worldspace, tilePosition, TileVersion{ 1 }, inputs[i], datas[i]), 1);
+            keys.push_back(TileKey{ worldspace, tilePosition, std::cref(inputs[i]) });
+        }
+        keys.push_back(TileKey{ worldspace, TilePosition{ 0, 0 }, std::cref(missingInput) });
+        std::reverse(keys.begin(), keys.end());
+
+        const std::vector<std::optional<TileData>> result = mDb.getTilesData(keys);
+
+        ASSERT_EQ(result.size(), keys.size());
+        EXPECT_FALSE(result[0].has_value());
+        for (std::size_t i = 1; i < result.size(); ++i)
+        {
+            const std::size_t tile = result.size() - i - 1;
+            ASSERT_TRUE(result[i].has_value()) << i;
+            EXPECT_EQ(result[i]->mTileId, TileId{ static_cast<std::int64_t>(tile + 1) }) << i;
+            EXPECT_EQ(result[i]->mData, datas[tile]) << i;
+        }
+    }
+
     TEST_F(DetourNavigatorNavMeshDbTest, on_inserted_duplicate_should_throw_exception)
     {
         const TileId tileId{ 53 };
@@ -176,4 +220,65 @@ namespace
         };
         EXPECT_THROW(f(), std::runtime_error);
     }
+
+    TEST_F(DetourNavigatorNavMeshDbTest, enable_write_ahead_log_should_fail_for_in_memory_db)
+    {
+        EXPECT_FALSE(mDb.enableWriteAheadLog(Sqlite3::Synchronous::Normal, std::chrono::milliseconds(0)));
+    }
+
+    TEST_F(DetourNavigatorNavMeshDbTest, tiles_should_be_readable_from_db_with_write_ahead_log)
+    {
+        const std::filesystem::path path = TestingOpenMW::outputFilePath("navmeshdb_write_ahead_log.db");
+        std::filesystem::remove(path);
+        const ESM::RefId worldspace = ESM::RefId::stringRefId("sys::default");
+        const TilePosition tilePosition{ 3, 4 };
+        const std::vector<std::byte> input = generateData();
+        const std::vector<std::byte> data = generateData();
+        {
+            NavMeshDb db(Files::pathToUnicodeString(path), std::numeric_limits<std::uint64_t>::max());
+            ASSERT_TRUE(db.enableWriteAheadLog(Sqlite3::Synchronous::Normal, std::chrono::milliseconds(1)));
+            auto transaction = db.startTransaction(Sqlite3::TransactionMode::Immediate);
+            ASSERT_EQ(db.insertTile(TileId{ 1 }, worldspace, tilePosition, TileVersion{ 1 }, input, data), 1);
+            transaction.commit();
+        }
+        NavMeshDb db(Files::pathToUnicodeString(path), std::numeric_limits<std::uint64_t>::max());
+        const auto row = db.getTileData(worldspace, tilePosition, input);
+        ASSERT_TRUE(row.has_value());
+        EXPECT_EQ(row->mData, data);
+    }
+
+    TEST_F(DetourNavigatorNavMeshDbTest, merge_from_should_copy_tiles_with_new_ids)
+    {
+        const std::filesystem::path path = TestingOpenMW::outputFilePath("navmeshdb_merge_from_tiles.db");
+        std::filesystem::remove(path);
+        const ESM::RefId worldspace = ESM::RefId::stringRefId("sys::default");
+        const TilePosition tilePosition{ 3, 4 };
+        const std::vector<std::byte> input = generateData();
+        const std::vector<std::byte> data = generateData();
+        {
+            NavMeshDb other(Files::pathToUnicodeString(path), std::numeric_limits<std::uint64_t>::max());
+            ASSERT_EQ(other.insertTile(TileId{ 1 }, worldspace, tilePosition, TileVersion{ 1 }, input, data), 1);
+        }
+        insertTile(TileId{ 1 }, TileVersion{ 1 });
+        EXPECT_EQ(mDb.mergeFrom(Files::pathToUnicodeString(path)), 1);
+        const auto row = mDb.getTileData(worldspace, tilePosition, input);
+        ASSERT_TRUE(row.has_value());
+        EXPECT_EQ(row->mTileId, TileId{ 2 });
+        EXPECT_EQ(row->mData, data);
+    }
+
+    TEST_F(DetourNavigatorNavMeshDbTest, merge_from_should_throw_exception_for_different_shape_ids)
+    {
+        const std::filesystem::path path = TestingOpenMW::outputFilePath("navmeshdb_merge_from_shapes.db");
+        std::filesystem::remove(path);
+        const std::vector<std::byte> hash = generateData();
+        const Sqlite3::ConstBlob hashData{ reinterpret_cast<const char*>(hash.data()), static_cast<int>(hash.size()) };
+        {
+            NavMeshDb other(Files::pathToUnicodeString(path), std::numeric_limits<std::uint64_t>::max());
+            ASSERT_EQ(other.insertShape(ShapeId{ 2 }, "meshes/a.nif", ShapeType::Collision, hashData), 1);
+        }
+        ASSERT_EQ(mDb.insertShape(ShapeId{ 1 }, "meshes/a.nif", ShapeType::Collision, hashData), 1);
+        EXPECT_THROW(mDb.mergeFrom(Files::pathToUnicodeString(path)), std::runtime_error);
+        EXPECT_EQ(mDb.getMaxShapeId(), ShapeId{ 1 });
+    }
 }
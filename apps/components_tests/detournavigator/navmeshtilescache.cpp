@@ -11,6 +11,7 @@
 
 #include <gtest/gtest.h>
 
+#include <chrono>
 #include <random>
 #include <stdexcept>
 
@@ -367,4 +368,71 @@ namespace
         EXPECT_FALSE(cache.set(mAgentBounds, mTilePosition, anotherRecastMesh, std::move(anotherData)));
         EXPECT_TRUE(cache.get(mAgentBounds, mTilePosition, mRecastMesh));
     }
+
+    TEST_F(DetourNavigatorNavMeshTilesCacheTest, set_should_replace_unused_value_with_lowest_generation_cost)
+    {
+        const std::size_t maxSize = 2 * (mRecastMeshWithWaterSize + mPreparedNavMeshDataSize);
+        NavMeshTilesCache cache(maxSize);
+        const auto copy = clone(*mPreparedNavMeshData);
+
+        const std::vector<CellWater> expensiveWater(1, CellWater{ osg::Vec2i(), Water{ 1, 0.0f } });
+        const RecastMesh expensiveRecastMesh(
+            mVersion, mMesh, expensiveWater, mHeightfields, mFlatHeightfields, mSources);
+        auto expensiveData = makePeparedNavMeshData(3);
+
+        const std::vector<CellWater> cheapWater(1, CellWater{ osg::Vec2i(), Water{ 2, 0.0f } });
+        const RecastMesh cheapRecastMesh(mVersion, mMesh, cheapWater, mHeightfields, mFlatHeightfields, mSources);
+        auto cheapData = makePeparedNavMeshData(3);
+
+        ASSERT_TRUE(cache.set(mAgentBounds, mTilePosition, expensiveRecastMesh, std::move(expensiveData),
+            std::chrono::seconds(1)));
+        ASSERT_TRUE(cache.set(
+            mAgentBounds, mTilePosition, cheapRecastMesh, std::move(cheapData), std::chrono::milliseconds(1)));
+
+        const auto result = cache.set(mAgentBounds, mTilePosition, mRecastMesh, std::move(mPreparedNavMeshData));
+        EXPECT_EQ(result.get(), *copy);
+
+        EXPECT_TRUE(cache.get(mAgentBounds, mTilePosition, expensiveRecastMesh));
+        EXPECT_FALSE(cache.get(mAgentBounds, mTilePosition, cheapRecastMesh));
+    }
+
+    TEST_F(DetourNavigatorNavMeshTilesCacheTest, set_over_agent_bounds_limit_should_replace_same_agent_bounds_value)
+    {
+        const std::size_t maxSize = 3 * (mRecastMeshWithWaterSize + mPreparedNavMeshDataSize);
+        const std::size_t maxAgentBoundsSize = mRecastMeshWithWaterSize + mPreparedNavMeshDataSize;
+        NavMeshTilesCache cache(maxSize, maxAgentBoundsSize);
+        const auto copy = clone(*mPreparedNavMeshData);
+
+        const AgentBounds anotherAgentBounds{ CollisionShapeType::Aabb, { 3, 2, 1 } };
+        auto anotherAgentBoundsData = makePeparedNavMeshData(3);
+
+        const std::vector<CellWater> water(1, CellWater{ osg::Vec2i(), Water{ 1, 0.0f } });
+        const RecastMesh anotherRecastMesh(mVersion, mMesh, water, mHeightfields, mFlatHeightfields, mSources);
+        auto anotherData = makePeparedNavMeshData(3);
+
+        ASSERT_TRUE(cache.set(anotherAgentBounds, mTilePosition, mRecastMesh, std::move(anotherAgentBoundsData)));
+        ASSERT_TRUE(cache.set(mAgentBounds, mTilePosition, anotherRecastMesh, std::move(anotherData)));
+
+        const auto result = cache.set(mAgentBounds, mTilePosition, mRecastMesh, std::move(mPreparedNavMeshData));
+        ASSERT_TRUE(result);
+        EXPECT_EQ(result.get(), *copy);
+
+        EXPECT_TRUE(cache.get(anotherAgentBounds, mTilePosition, mRecastMesh));
+        EXPECT_FALSE(cache.get(mAgentBounds, mTilePosition, anotherRecastMesh));
+    }
+
+    TEST_F(DetourNavigatorNavMeshTilesCacheTest, set_over_agent_bounds_limit_should_not_replace_used_value)
+    {
+        const std::size_t maxSize = 2 * (mRecastMeshWithWaterSize + mPreparedNavMeshDataSize);
+        const std::size_t maxAgentBoundsSize = mRecastMeshWithWaterSize + mPreparedNavMeshDataSize;
+        NavMeshTilesCache cache(maxSize, maxAgentBoundsSize);
+
+        const std::vector<CellWater> water(1, CellWater{ osg::Vec2i(), Water{ 1, 0.0f } });
+        const RecastMesh anotherRecastMesh(mVersion, mMesh, water, mHeightfields, mFlatHeightfields, mSources);
+        auto anotherData = makePeparedNavMeshData(3);
+
+        const auto value = cache.set(mAgentBounds, mTilePosition, anotherRecastMesh, std::move(anotherData));
+        ASSERT_TRUE(value);
+        EXPECT_FALSE(cache.set(mAgentBounds, mTilePosition, mRecastMesh, std::move(mPreparedNavMeshData)));
+    }
 }
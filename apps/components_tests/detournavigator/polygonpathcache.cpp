@@ -0,0 +1,96 @@
+#include <components/detournavigator/polygonpathcache.hpp>
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <vector>
+
+namespace
+{
+    using namespace testing;
+    using namespace DetourNavigator;
+
+    constexpr Flags includeFlags = Flag_walk;
+
+    struct DetourNavigatorPolygonPathCacheTest : Test
+    {
+        PolygonPathCache mCache{ 2 };
+        AreaCosts mAreaCosts;
+        const std::vector<dtPolyRef> mPath{ 1, 2, 3, 4 };
+        std::vector<dtPolyRef> mBuffer = std::vector<dtPolyRef>(16);
+    };
+
+    TEST_F(DetourNavigatorPolygonPathCacheTest, find_should_return_nullopt_for_empty_cache)
+    {
+        EXPECT_EQ(mCache.find(1, 4, includeFlags, mAreaCosts, mBuffer), std::nullopt);
+    }
+
+    TEST_F(DetourNavigatorPolygonPathCacheTest, find_should_return_added_path)
+    {
+        mCache.add(includeFlags, mAreaCosts, mPath);
+        const std::optional<std::size_t> size = mCache.find(1, 4, includeFlags, mAreaCosts, mBuffer);
+        ASSERT_EQ(size, mPath.size());
+        EXPECT_THAT(std::vector<dtPolyRef>(mBuffer.begin(), mBuffer.begin() + *size), ElementsAreArray(mPath));
+    }
+
+    TEST_F(DetourNavigatorPolygonPathCacheTest, find_should_return_suffix_of_path_going_over_start)
+    {
+        mCache.add(includeFlags, mAreaCosts, mPath);
+        const std::optional<std::size_t> size = mCache.find(3, 4, includeFlags, mAreaCosts, mBuffer);
+        ASSERT_EQ(size, 2);
+        EXPECT_THAT(std::vector<dtPolyRef>(mBuffer.begin(), mBuffer.begin() + *size), ElementsAre(3, 4));
+    }
+
+    TEST_F(DetourNavigatorPolygonPathCacheTest, find_should_return_nullopt_for_different_end)
+    {
+        mCache.add(includeFlags, mAreaCosts, mPath);
+        EXPECT_EQ(mCache.find(1, 3, includeFlags, mAreaCosts, mBuffer), std::nullopt);
+    }
+
+    TEST_F(DetourNavigatorPolygonPathCacheTest, find_should_return_nullopt_for_different_filter)
+    {
+        mCache.add(includeFlags, mAreaCosts, mPath);
+        EXPECT_EQ(mCache.find(1, 4, Flag_swim, mAreaCosts, mBuffer), std::nullopt);
+        AreaCosts areaCosts = mAreaCosts;
+        areaCosts.mWater *= 2;
+        EXPECT_EQ(mCache.find(1, 4, includeFlags, areaCosts, mBuffer), std::nullopt);
+    }
+
+    TEST_F(DetourNavigatorPolygonPathCacheTest, find_should_return_nullopt_when_buffer_is_too_small)
+    {
+        mCache.add(includeFlags, mAreaCosts, mPath);
+        std::vector<dtPolyRef> buffer(2);
+        EXPECT_EQ(mCache.find(1, 4, includeFlags, mAreaCosts, buffer), std::nullopt);
+    }
+
+    TEST_F(DetourNavigatorPolygonPathCacheTest, add_should_evict_least_recently_used_path)
+    {
+        mCache.add(includeFlags, mAreaCosts, std::vector<dtPolyRef>{ 1, 2 });
+        mCache.add(includeFlags, mAreaCosts, std::vector<dtPolyRef>{ 3, 4 });
+        ASSERT_NE(mCache.find(1, 2, includeFlags, mAreaCosts, mBuffer), std::nullopt);
+        mCache.add(includeFlags, mAreaCosts, std::vector<dtPolyRef>{ 5, 6 });
+        EXPECT_NE(mCache.find(1, 2, includeFlags, mAreaCosts, mBuffer), std::nullopt);
+        EXPECT_EQ(mCache.find(3, 4, includeFlags, mAreaCosts, mBuffer), std::nullopt);
+        EXPECT_NE(mCache.find(5, 6, includeFlags, mAreaCosts, mBuffer), std::nullopt);
+    }
+
+    TEST_F(DetourNavigatorPolygonPathCacheTest, clear_should_remove_all_paths)
+    {
+        mCache.add(includeFlags, mAreaCosts, mPath);
+        mCache.clear();
+        EXPECT_EQ(mCache.find(1, 4, includeFlags, mAreaCosts, mBuffer), std::nullopt);
+    }
+
+    TEST_F(DetourNavigatorPolygonPathCacheTest, get_stats_should_return_number_of_gets_and_hits)
+    {
+        mCache.add(includeFlags, mAreaCosts, mPath);
+        mCache.find(1, 4, includeFlags, mAreaCosts, mBuffer);
+        mCache.find(1, 5, includeFlags, mAreaCosts, mBuffer);
+        mCache.reportQuery(std::chrono::milliseconds(3));
+        const PathQueryStats stats = mCache.getStats();
+        EXPECT_EQ(stats.mCount, 1);
+        EXPECT_EQ(stats.mDuration, std::chrono::milliseconds(3));
+        EXPECT_EQ(stats.mCacheGetCount, 2);
+        EXPECT_EQ(stats.mCacheHitCount, 1);
+    }
+}
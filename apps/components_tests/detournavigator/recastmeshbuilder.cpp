@@ -561,4 +561,30 @@ namespace
         expected.mMinY = 1;
         EXPECT_EQ(recastMesh->getHeightfields(), std::vector<Heightfield>({ expected }));
     }
+
+    TEST_F(DetourNavigatorRecastMeshBuilderTest, add_obstacle_should_add_bounding_box)
+    {
+        const btBoxShape shape(btVector3(1, 2, 3));
+        RecastMeshBuilder builder(mBounds);
+        builder.addObstacle(shape, btTransform(btMatrix3x3::getIdentity(), btVector3(10, 20, 30)));
+        const auto recastMesh = std::move(builder).create(mVersion);
+        EXPECT_EQ(recastMesh->getMesh().getIndices(), std::vector<int>());
+        ASSERT_EQ(recastMesh->getObstacles().size(), 1);
+        for (int i = 0; i < 3; ++i)
+        {
+            EXPECT_NEAR(recastMesh->getObstacles()[0].mMin[i], osg::Vec3f(9, 18, 27)[i], 1e-5f) << i;
+            EXPECT_NEAR(recastMesh->getObstacles()[0].mMax[i], osg::Vec3f(11, 22, 33)[i], 1e-5f) << i;
+        }
+    }
+
+    TEST_F(DetourNavigatorRecastMeshBuilderTest, add_obstacle_outside_bounds_should_not_add_obstacle)
+    {
+        const btBoxShape shape(btVector3(1, 2, 3));
+        mBounds.mMin = osg::Vec2f(100, 100);
+        mBounds.mMax = osg::Vec2f(200, 200);
+        RecastMeshBuilder builder(mBounds);
+        builder.addObstacle(shape, btTransform::getIdentity());
+        const auto recastMesh = std::move(builder).create(mVersion);
+        EXPECT_THAT(recastMesh->getObstacles(), IsEmpty());
+    }
 }
@@ -0,0 +1,105 @@
+#include "generate.hpp"
+
+#include <components/detournavigator/preparednavmeshdata.hpp>
+#include <components/detournavigator/recast.hpp>
+#include <components/detournavigator/serialization.hpp>
+
+#include <RecastAlloc.h>
+
+#include <gtest/gtest.h>
+
+#include <cstddef>
+#include <random>
+#include <vector>
+
+namespace
+{
+    using namespace testing;
+    using namespace DetourNavigator;
+    using namespace DetourNavigator::Tests;
+
+    template <class T, class Random>
+    void generateRecastArray(T*& values, size_t size, Random& random)
+    {
+        values = static_cast<T*>(permRecastAlloc(size * sizeof(T)));
+        generateRange(values, values + static_cast<std::ptrdiff_t>(size), random);
+    }
+
+    template <class Random>
+    void generate(rcPolyMesh& value, int size, Random& random)
+    {
+        value.nverts = size;
+        value.maxpolys = size;
+        value.nvp = size;
+        value.npolys = size;
+        generateValue(value.cs, random);
+        generateValue(value.ch, random);
+        generateValue(value.borderSize, random);
+        generateValue(value.maxEdgeError, random);
+        generateRecastArray(value.verts, getVertsLength(value), random);
+        generateRecastArray(value.polys, getPolysLength(value), random);
+        generateRecastArray(value.regs, getRegsLength(value), random);
+        generateRecastArray(value.flags, getFlagsLength(value), random);
+        generateRecastArray(value.areas, getAreasLength(value), random);
+    }
+
+    template <class Random>
+    void generate(rcPolyMeshDetail& value, int size, Random& random)
+    {
+        value.nmeshes = size;
+        value.nverts = size;
+        value.ntris = size;
+        generateRecastArray(value.meshes, getMeshesLength(value), random);
+        generateRecastArray(value.verts, getVertsLength(value), random);
+        generateRecastArray(value.tris, getTrisLength(value), random);
+    }
+
+    template <class Random>
+    void generate(PreparedNavMeshData& value, int size, Random& random)
+    {
+        generateValue(value.mUserId, random);
+        generateValue(value.mCellHeight, random);
+        generateValue(value.mCellSize, random);
+        generate(value.mPolyMesh, size, random);
+        generate(value.mPolyMeshDetail, size, random);
+    }
+
+    TEST(DetourNavigatorSerializationTest, deserialized_prepared_nav_mesh_data_should_be_equal_to_serialized)
+    {
+        std::minstd_rand random;
+        PreparedNavMeshData value;
+        generate(value, 5, random);
+        PreparedNavMeshData result;
+        ASSERT_TRUE(deserialize(serialize(value), result));
+        EXPECT_EQ(result, value);
+    }
+
+    TEST(DetourNavigatorSerializationTest, serialized_prepared_nav_mesh_data_should_be_smaller_for_nearby_vertices)
+    {
+        std::minstd_rand random;
+        PreparedNavMeshData value;
+        generate(value, 8, random);
+        for (std::size_t i = 0; i < getVertsLength(value.mPolyMesh); ++i)
+            value.mPolyMesh.verts[i] = static_cast<unsigned short>(1000 + i);
+        for (std::size_t i = 0; i < getPolysLength(value.mPolyMesh); ++i)
+            value.mPolyMesh.polys[i] = i % 2 == 0 ? static_cast<unsigned short>(i % 8) : RC_MESH_NULL_IDX;
+        for (std::size_t i = 0; i < getMeshesLength(value.mPolyMeshDetail); ++i)
+            value.mPolyMeshDetail.meshes[i] = static_cast<unsigned int>(i);
+        const std::vector<std::byte> data = serialize(value);
+        EXPECT_LT(data.size(), getSize(value));
+        PreparedNavMeshData result;
+        ASSERT_TRUE(deserialize(data, result));
+        EXPECT_EQ(result, value);
+    }
+
+    TEST(DetourNavigatorSerializationTest, deserialize_should_fail_for_truncated_prepared_nav_mesh_data)
+    {
+        std::minstd_rand random;
+        PreparedNavMeshData value;
+        generate(value, 5, random);
+        std::vector<std::byte> data = serialize(value);
+        data.resize(data.size() / 2);
+        PreparedNavMeshData result;
+        EXPECT_FALSE(deserialize(data, result));
+    }
+}
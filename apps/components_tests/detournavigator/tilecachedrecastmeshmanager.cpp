@@ -503,4 +503,53 @@ namespace
 
         ASSERT_EQ(manager.getCachedMesh(mWorldspace, tilePosition), nullptr);
     }
+
+    TEST_F(DetourNavigatorTileCachedRecastMeshManagerTest, get_mesh_for_moved_small_object_should_return_obstacle)
+    {
+        mSettings.mMaxObstacleSize = 50;
+        TileCachedRecastMeshManager manager(mSettings);
+        manager.setWorldspace(mWorldspace, nullptr);
+        const btBoxShape boxShape(btVector3(20, 20, 20));
+        const CollisionShape shape(mInstance, boxShape, mObjectTransform);
+        ASSERT_TRUE(manager.addObject(
+            ObjectId(&boxShape), shape, btTransform::getIdentity(), AreaType::AreaType_ground, nullptr));
+        const btTransform transform(btMatrix3x3::getIdentity(), btVector3(10, 0, 0));
+        ASSERT_TRUE(manager.updateObject(ObjectId(&boxShape), transform, AreaType::AreaType_ground, nullptr));
+        const std::shared_ptr<RecastMesh> recastMesh = manager.getMesh(mWorldspace, TilePosition(0, 0));
+        ASSERT_NE(recastMesh, nullptr);
+        EXPECT_THAT(recastMesh->getMesh().getIndices(), IsEmpty());
+        EXPECT_EQ(recastMesh->getObstacles().size(), 1);
+    }
+
+    TEST_F(DetourNavigatorTileCachedRecastMeshManagerTest, get_mesh_for_not_moved_small_object_should_return_triangles)
+    {
+        mSettings.mMaxObstacleSize = 50;
+        TileCachedRecastMeshManager manager(mSettings);
+        manager.setWorldspace(mWorldspace, nullptr);
+        const btBoxShape boxShape(btVector3(20, 20, 20));
+        const CollisionShape shape(mInstance, boxShape, mObjectTransform);
+        ASSERT_TRUE(manager.addObject(
+            ObjectId(&boxShape), shape, btTransform::getIdentity(), AreaType::AreaType_ground, nullptr));
+        const std::shared_ptr<RecastMesh> recastMesh = manager.getMesh(mWorldspace, TilePosition(0, 0));
+        ASSERT_NE(recastMesh, nullptr);
+        EXPECT_THAT(recastMesh->getMesh().getIndices(), Not(IsEmpty()));
+        EXPECT_THAT(recastMesh->getObstacles(), IsEmpty());
+    }
+
+    TEST_F(DetourNavigatorTileCachedRecastMeshManagerTest, get_mesh_for_moved_big_object_should_return_triangles)
+    {
+        mSettings.mMaxObstacleSize = 50;
+        TileCachedRecastMeshManager manager(mSettings);
+        manager.setWorldspace(mWorldspace, nullptr);
+        const btBoxShape boxShape(btVector3(20, 20, 100));
+        const CollisionShape shape(mInstance, boxShape, mObjectTransform);
+        ASSERT_TRUE(manager.addObject(
+            ObjectId(&boxShape), shape, btTransform::getIdentity(), AreaType::AreaType_ground, nullptr));
+        const btTransform transform(btMatrix3x3::getIdentity(), btVector3(10, 0, 0));
+        ASSERT_TRUE(manager.updateObject(ObjectId(&boxShape), transform, AreaType::AreaType_ground, nullptr));
+        const std::shared_ptr<RecastMesh> recastMesh = manager.getMesh(mWorldspace, TilePosition(0, 0));
+        ASSERT_NE(recastMesh, nullptr);
+        EXPECT_THAT(recastMesh->getMesh().getIndices(), Not(IsEmpty()));
+        EXPECT_THAT(recastMesh->getObstacles(), IsEmpty());
+    }
 }
@@ -0,0 +1,83 @@
+#include <components/esm/defs.hpp>
+#include <components/esm3/compressedsavedgame.hpp>
+#include <components/esm3/esmreader.hpp>
+#include <components/esm3/esmwriter.hpp>
+#include <components/esm3/formatversion.hpp>
+
+#include <gtest/gtest.h>
+
+#include <memory>
+#include <sstream>
+#include <string>
+
+namespace ESM
+{
+    namespace
+    {
+        using namespace ::testing;
+
+        struct Esm3CompressedSavedGameTest : Test
+        {
+            std::string mData;
+            std::size_t mBodyOffset = 0;
+
+            Esm3CompressedSavedGameTest()
+            {
+                std::stringstream stream;
+                ESMWriter writer;
+                writer.setFormatVersion(CurrentSaveGameFormatVersion);
+                writer.save(stream);
+                writer.startRecord(REC_SAVE);
+                writer.writeHNString("PLNA", "player");
+                writer.endRecord(REC_SAVE);
+                mBodyOffset = static_cast<std::size_t>(stream.tellp());
+                for (int i = 0; i < 100; ++i)
+                {
+                    writer.startRecord(REC_GLOB);
+                    writer.writeHNT("DATA", i);
+                    writer.writeHNString("NAME", std::string(100, static_cast<char>('a' + i % 26)));
+                    writer.endRecord(REC_GLOB);
+                }
+                writer.close();
+                mData = stream.str();
+            }
+        };
+
+        TEST_F(Esm3CompressedSavedGameTest, compressSavedGameShouldKeepHeaderUncompressed)
+        {
+            const std::string compressed = compressSavedGame(mData, mBodyOffset, 1024);
+            ASSERT_GT(compressed.size(), mBodyOffset);
+            EXPECT_EQ(compressed.substr(0, mBodyOffset), mData.substr(0, mBodyOffset));
+            EXPECT_LT(compressed.size(), mData.size());
+        }
+
+        TEST_F(Esm3CompressedSavedGameTest, decompressSavedGameShouldRestoreCompressedData)
+        {
+            const std::string compressed = compressSavedGame(mData, mBodyOffset, 1024);
+            EXPECT_EQ(decompressSavedGame(compressed), mData);
+        }
+
+        TEST_F(Esm3CompressedSavedGameTest, decompressSavedGameShouldKeepUncompressedData)
+        {
+            EXPECT_EQ(decompressSavedGame(mData), mData);
+        }
+
+        TEST_F(Esm3CompressedSavedGameTest, decompressedSavedGameShouldBeReadable)
+        {
+            ESMReader reader;
+            reader.open(std::make_unique<std::istringstream>(
+                            decompressSavedGame(compressSavedGame(mData, mBodyOffset, 1024))),
+                "test");
+            EXPECT_EQ(reader.getFormatVersion(), CurrentSaveGameFormatVersion);
+            ASSERT_TRUE(reader.hasMoreRecs());
+            EXPECT_EQ(reader.getRecName().toInt(), REC_SAVE);
+        }
+
+        TEST_F(Esm3CompressedSavedGameTest, decompressSavedGameShouldThrowOnTruncatedData)
+        {
+            const std::string compressed = compressSavedGame(mData, mBodyOffset, 1024);
+            EXPECT_THROW(decompressSavedGame(std::string_view(compressed).substr(0, compressed.size() - 1)),
+                std::runtime_error);
+        }
+    }
+}
@@ -0,0 +1,131 @@
+#include <components/esm/fourcc.hpp>
+#include <components/esm3/esmreader.hpp>
+#include <components/esm3/esmwriter.hpp>
+
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <memory>
+#include <sstream>
+#include <string>
+
+namespace ESM
+{
+    namespace
+    {
+        using namespace ::testing;
+
+        constexpr std::uint32_t fakeRecordId = fourCC("FAKE");
+
+        std::unique_ptr<std::istream> makeEsmStream()
+        {
+            ESMWriter writer;
+            auto stream = std::make_unique<std::stringstream>();
+            writer.setFormatVersion(CurrentSaveGameFormatVersion);
+            writer.save(*stream);
+            writer.startRecord(fakeRecordId);
+            writer.writeHNString("NAME", "first");
+            writer.writeHNT("DATA", std::int32_t{ 42 });
+            writer.writeHNString("TEXT", "second");
+            writer.endRecord(fakeRecordId);
+            writer.startRecord(fakeRecordId);
+            writer.writeHNString("NAME", "third");
+            writer.endRecord(fakeRecordId);
+            return stream;
+        }
+
+        struct Esm3EsmReaderTest : TestWithParam<bool>
+        {
+            ESMReader mReader;
+
+            void SetUp() override
+            {
+                mReader.setBufferRecords(GetParam());
+                mReader.open(makeEsmStream(), "stream");
+            }
+
+            void readRecordHeader()
+            {
+                ASSERT_TRUE(mReader.hasMoreRecs());
+                ASSERT_EQ(mReader.getRecName().toInt(), fakeRecordId);
+                mReader.getRecHeader();
+            }
+        };
+
+        TEST_P(Esm3EsmReaderTest, shouldReadAllRecords)
+        {
+            readRecordHeader();
+            EXPECT_EQ(mReader.getHNString("NAME"), "first");
+            std::int32_t data = 0;
+            mReader.getHNT(data, "DATA");
+            EXPECT_EQ(data, 42);
+            EXPECT_EQ(mReader.getHNString("TEXT"), "second");
+            EXPECT_FALSE(mReader.hasMoreSubs());
+
+            readRecordHeader();
+            EXPECT_EQ(mReader.getHNString("NAME"), "third");
+            EXPECT_FALSE(mReader.hasMoreSubs());
+            EXPECT_FALSE(mReader.hasMoreRecs());
+        }
+
+        TEST_P(Esm3EsmReaderTest, shouldReadNextRecordAfterSkippingSubrecords)
+        {
+            readRecordHeader();
+            mReader.getSubName();
+            mReader.skipHSub();
+            mReader.skipRecord();
+
+            readRecordHeader();
+            EXPECT_EQ(mReader.getHNString("NAME"), "third");
+        }
+
+        TEST_P(Esm3EsmReaderTest, restoreContextShouldContinueWithinRecord)
+        {
+            readRecordHeader();
+            EXPECT_EQ(mReader.getHNString("NAME"), "first");
+            const ESM_Context context = mReader.getContext();
+            mReader.skipRecord();
+            readRecordHeader();
+            mReader.skipRecord();
+
+            mReader.restoreContext(context);
+            std::int32_t data = 0;
+            mReader.getHNT(data, "DATA");
+            EXPECT_EQ(data, 42);
+            EXPECT_EQ(mReader.getHNString("TEXT"), "second");
+        }
+
+        TEST_P(Esm3EsmReaderTest, getFileOffsetShouldNotDependOnBuffering)
+        {
+            ESMReader unbuffered;
+            unbuffered.open(makeEsmStream(), "stream");
+            ASSERT_EQ(unbuffered.getRecName().toInt(), fakeRecordId);
+            unbuffered.getRecHeader();
+            unbuffered.getHNString("NAME");
+
+            readRecordHeader();
+            mReader.getHNString("NAME");
+            EXPECT_EQ(mReader.getFileOffset(), unbuffered.getFileOffset());
+        }
+
+        INSTANTIATE_TEST_SUITE_P(BufferRecords, Esm3EsmReaderTest, Values(false, true));
+
+        TEST(Esm3EsmReaderBufferTest, getHStringViewShouldPointIntoRecordBuffer)
+        {
+            ESMReader reader;
+            reader.setBufferRecords(true);
+            reader.open(makeEsmStream(), "stream");
+            ASSERT_EQ(reader.getRecName().toInt(), fakeRecordId);
+            reader.getRecHeader();
+            reader.getSubNameIs("NAME");
+            const std::string_view first = reader.getHStringView();
+            reader.getSubNameIs("DATA");
+            reader.skipHSub();
+            reader.getSubNameIs("TEXT");
+            const std::string_view second = reader.getHStringView();
+            // Both views stay valid while the record is read
+            EXPECT_EQ(first, "first");
+            EXPECT_EQ(second, "second");
+        }
+    }
+}
@@ -0,0 +1,99 @@
+#include <components/esm3/esmwriter.hpp>
+#include <components/esmloader/headercache.hpp>
+#include <components/testing/util.hpp>
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <vector>
+
+namespace
+{
+    using namespace testing;
+    using namespace EsmLoader;
+
+    void writePlugin(const std::filesystem::path& path, std::string_view author, std::string_view master)
+    {
+        ESM::ESMWriter writer;
+        writer.setVersion();
+        writer.setType(0);
+        writer.setAuthor(author);
+        writer.setDescription("description");
+        writer.addMaster(master, 42);
+        std::ofstream stream(path, std::ios::binary);
+        writer.save(stream);
+        writer.close();
+    }
+
+    struct EsmLoaderHeaderCacheTest : Test
+    {
+        const std::filesystem::path mPlugin = TestingOpenMW::outputFilePath("header_cache_plugin.esp");
+        const std::filesystem::path mCache = TestingOpenMW::outputFilePath("header_cache");
+
+        EsmLoaderHeaderCacheTest()
+        {
+            std::filesystem::remove(mCache);
+            writePlugin(mPlugin, "author", "master.esm");
+        }
+    };
+
+    TEST_F(EsmLoaderHeaderCacheTest, getShouldReadHeaders)
+    {
+        HeaderCache cache;
+        const std::vector<PluginHeaderResult> result = cache.get(std::vector{ mPlugin });
+        ASSERT_EQ(result.size(), 1);
+        ASSERT_TRUE(result[0].mHeader.has_value()) << result[0].mError;
+        EXPECT_EQ(result[0].mHeader->mFormat, ESM::Format::Tes3);
+        EXPECT_EQ(result[0].mHeader->mAuthor, "author");
+        EXPECT_EQ(result[0].mHeader->mDescription, "description");
+        EXPECT_EQ(result[0].mHeader->mMasters, std::vector<std::string>({ "master.esm" }));
+    }
+
+    TEST_F(EsmLoaderHeaderCacheTest, getShouldReportMissingFile)
+    {
+        HeaderCache cache;
+        const std::vector<PluginHeaderResult> result
+            = cache.get(std::vector{ TestingOpenMW::outputFilePath("header_cache_missing.esp") });
+        ASSERT_EQ(result.size(), 1);
+        EXPECT_FALSE(result[0].mHeader.has_value());
+        EXPECT_FALSE(result[0].mError.empty());
+    }
+
+    TEST_F(EsmLoaderHeaderCacheTest, persistentCacheShouldKeepHeadersOfUnchangedFiles)
+    {
+        {
+            HeaderCache cache(mCache);
+            cache.get(std::vector{ mPlugin });
+            cache.write();
+        }
+        // Replace the content without changing the size and the modification time
+        const auto time = std::filesystem::last_write_time(mPlugin);
+        writePlugin(mPlugin, "other!", "master.esm");
+        std::filesystem::last_write_time(mPlugin, time);
+
+        HeaderCache cache(mCache);
+        const std::vector<PluginHeaderResult> result = cache.get(std::vector{ mPlugin });
+        ASSERT_TRUE(result[0].mHeader.has_value()) << result[0].mError;
+        EXPECT_EQ(result[0].mHeader->mAuthor, "author");
+    }
+
+    TEST_F(EsmLoaderHeaderCacheTest, persistentCacheShouldReadChangedFilesAgain)
+    {
+        {
+            HeaderCache cache(mCache);
+            cache.get(std::vector{ mPlugin });
+            cache.write();
+        }
+        const auto time = std::filesystem::last_write_time(mPlugin);
+        writePlugin(mPlugin, "other!", "master.esm");
+        std::filesystem::last_write_time(mPlugin, time + std::chrono::seconds(10));
+
+        HeaderCache cache(mCache);
+        const std::vector<PluginHeaderResult> result = cache.get(std::vector{ mPlugin });
+        ASSERT_TRUE(result[0].mHeader.has_value()) << result[0].mError;
+        EXPECT_EQ(result[0].mHeader->mAuthor, "other!");
+    }
+}
@@ -54,6 +54,21 @@ namespace ESMTerrain
             }
         };
 
+        TEST(ESMTerrainToSharedCellAndLocal, borderVertexShouldBelongToNextCell)
+        {
+            EXPECT_EQ(toSharedCellAndLocal(0, 64), std::make_pair(0, std::size_t{ 0 }));
+            EXPECT_EQ(toSharedCellAndLocal(63, 64), std::make_pair(0, std::size_t{ 63 }));
+            EXPECT_EQ(toSharedCellAndLocal(64, 64), std::make_pair(1, std::size_t{ 0 }));
+            EXPECT_EQ(toSharedCellAndLocal(129, 64), std::make_pair(2, std::size_t{ 1 }));
+        }
+
+        TEST(ESMTerrainToSharedCellAndLocal, negativeGlobalShouldBelongToPreviousCell)
+        {
+            EXPECT_EQ(toSharedCellAndLocal(-1, 64), std::make_pair(-1, std::size_t{ 63 }));
+            EXPECT_EQ(toSharedCellAndLocal(-64, 64), std::make_pair(-1, std::size_t{ 0 }));
+            EXPECT_EQ(toSharedCellAndLocal(-65, 64), std::make_pair(-2, std::size_t{ 63 }));
+        }
+
         TEST(ESMTerrainSampleCellGrid, doesNotSupportCellSizeLessThanTwo)
         {
             const std::size_t cellSize = 2;
@@ -0,0 +1,48 @@
+#include <components/esmterrain/morphtargets.hpp>
+
+#include <gtest/gtest.h>
+
+#include <cstddef>
+
+namespace ESMTerrain
+{
+    namespace
+    {
+        using namespace testing;
+
+        // Height of each vertex is unique, so the result tells which vertices it is interpolated from
+        float getHeight(std::size_t x, std::size_t y)
+        {
+            return static_cast<float>(x * 100 + y);
+        }
+
+        TEST(ESMTerrainCanMorph, shouldRequireEvenNumberOfCoarserQuads)
+        {
+            EXPECT_FALSE(canMorph(1));
+            EXPECT_FALSE(canMorph(3));
+            EXPECT_TRUE(canMorph(5));
+            EXPECT_FALSE(canMorph(7));
+            EXPECT_TRUE(canMorph(65));
+        }
+
+        TEST(ESMTerrainGetMorphTargetHeight, vertexOfCoarserLevelShouldKeepHeight)
+        {
+            EXPECT_EQ(getMorphTargetHeight(0, 0, getHeight), getHeight(0, 0));
+            EXPECT_EQ(getMorphTargetHeight(2, 4, getHeight), getHeight(2, 4));
+        }
+
+        TEST(ESMTerrainGetMorphTargetHeight, vertexOnEdgeOfCoarserLevelShouldBeInterpolatedAlongEdge)
+        {
+            EXPECT_EQ(getMorphTargetHeight(1, 2, getHeight), (getHeight(0, 2) + getHeight(2, 2)) / 2);
+            EXPECT_EQ(getMorphTargetHeight(2, 3, getHeight), (getHeight(2, 2) + getHeight(2, 4)) / 2);
+        }
+
+        TEST(ESMTerrainGetMorphTargetHeight, vertexInQuadOfCoarserLevelShouldBeInterpolatedAlongDiagonal)
+        {
+            EXPECT_EQ(getMorphTargetHeight(1, 1, getHeight), (getHeight(0, 0) + getHeight(2, 2)) / 2);
+            EXPECT_EQ(getMorphTargetHeight(3, 1, getHeight), (getHeight(4, 0) + getHeight(2, 2)) / 2);
+            EXPECT_EQ(getMorphTargetHeight(1, 3, getHeight), (getHeight(2, 2) + getHeight(0, 4)) / 2);
+            EXPECT_EQ(getMorphTargetHeight(3, 3, getHeight), (getHeight(2, 2) + getHeight(4, 4)) / 2);
+        }
+    }
+}
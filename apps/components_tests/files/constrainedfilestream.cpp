@@ -0,0 +1,72 @@
+#include <components/files/constrainedfilestream.hpp>
+#include <components/testing/util.hpp>
+
+#include <gtest/gtest.h>
+
+#include <filesystem>
+#include <fstream>
+#include <string>
+
+namespace
+{
+    using namespace testing;
+    using namespace TestingOpenMW;
+    using namespace Files;
+
+    std::string makeContent(std::size_t size)
+    {
+        std::string content(size, '\0');
+        for (std::size_t i = 0; i < size; ++i)
+            content[i] = static_cast<char>(i % 251);
+        return content;
+    }
+
+    std::filesystem::path writeFile(std::string_view fileName, const std::string& content)
+    {
+        const auto file = outputFilePath(fileName);
+        std::fstream(file, std::ios_base::out | std::ios_base::binary)
+            .write(content.data(), static_cast<std::streamsize>(content.size()));
+        return file;
+    }
+
+    TEST(FilesConstrainedFileStreamTest, shouldReadLargeBlockAfterBufferedData)
+    {
+        const std::string content = makeContent(100000);
+        const auto file = writeFile("shouldReadLargeBlockAfterBufferedData.bin", content);
+        const auto stream = openConstrainedFileStream(file, 10, 50000);
+
+        std::string result(50000, '\0');
+        ASSERT_TRUE(stream->read(result.data(), 3));
+        ASSERT_TRUE(stream->read(result.data() + 3, 40000));
+        ASSERT_TRUE(stream->read(result.data() + 40003, 9997));
+        EXPECT_EQ(result, content.substr(10, 50000));
+        EXPECT_EQ(stream->get(), std::char_traits<char>::eof());
+    }
+
+    TEST(FilesConstrainedFileStreamTest, shouldNotReadLargeBlockBeyondEnd)
+    {
+        const std::string content = makeContent(100000);
+        const auto file = writeFile("shouldNotReadLargeBlockBeyondEnd.bin", content);
+        const auto stream = openConstrainedFileStream(file, 1000, 20000);
+
+        std::string result(30000, '\0');
+        stream->read(result.data(), static_cast<std::streamsize>(result.size()));
+        EXPECT_TRUE(stream->eof());
+        ASSERT_EQ(stream->gcount(), 20000);
+        result.resize(20000);
+        EXPECT_EQ(result, content.substr(1000, 20000));
+    }
+
+    TEST(FilesConstrainedFileStreamTest, shouldTrackPositionAfterLargeBlock)
+    {
+        const std::string content = makeContent(100000);
+        const auto file = writeFile("shouldTrackPositionAfterLargeBlock.bin", content);
+        const auto stream = openConstrainedFileStream(file, 0, content.size());
+
+        std::string result(30000, '\0');
+        ASSERT_TRUE(stream->read(result.data(), static_cast<std::streamsize>(result.size())));
+        EXPECT_EQ(stream->tellg(), 30000);
+        ASSERT_TRUE(stream->seekg(-100, std::ios_base::cur));
+        EXPECT_EQ(stream->get(), static_cast<unsigned char>(content[29900]));
+    }
+}
@@ -37,6 +37,7 @@ namespace
         source_type = float;
         source_format = red;
         mipmaps = true;
+        transient = true;
         wrap_s = clamp_to_edge;
         wrap_t = repeat;
         min_filter = linear;
@@ -215,6 +216,7 @@ namespace
 
         EXPECT_EQ(name, "rendertarget");
         EXPECT_EQ(rt.mMipMap, true);
+        EXPECT_EQ(rt.mTransient, true);
         EXPECT_EQ(rt.mSize.mWidthRatio, 0.5f);
         EXPECT_EQ(rt.mSize.mHeightRatio, 0.5f);
         EXPECT_EQ(texture->getWrap(osg::Texture::WRAP_S), osg::Texture::CLAMP_TO_EDGE);
@@ -0,0 +1,86 @@
+#include <components/loadinglistener/loadinglistener.hpp>
+#include <components/loadinglistener/reporter.hpp>
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <thread>
+
+namespace
+{
+    using namespace testing;
+
+    struct CountingListener final : Loading::Listener
+    {
+        std::size_t mRange = 0;
+        std::size_t mProgress = 0;
+        std::size_t mUpdates = 0;
+        std::size_t mRangeUpdates = 0;
+
+        void setProgressRange(std::size_t range) override
+        {
+            mRange = range;
+            ++mRangeUpdates;
+        }
+
+        void setProgress(std::size_t value) override
+        {
+            mProgress = value;
+            ++mUpdates;
+        }
+    };
+
+    TEST(LoadingReporterTest, waitShouldUpdateListenerWhileThereIsNoProgress)
+    {
+        Loading::Reporter reporter;
+        reporter.addTotal(2);
+        reporter.addProgress(1);
+        CountingListener listener;
+        std::thread worker([&] {
+            std::this_thread::sleep_for(Loading::listenerUpdateInterval * 20);
+            reporter.complete();
+        });
+        reporter.wait(listener);
+        worker.join();
+        EXPECT_GT(listener.mUpdates, 2);
+        EXPECT_EQ(listener.mRangeUpdates, 1);
+        EXPECT_EQ(listener.mRange, 2);
+        EXPECT_EQ(listener.mProgress, 1);
+    }
+
+    TEST(LoadingReporterTest, workShouldNotWaitForListener)
+    {
+        struct SlowListener final : Loading::Listener
+        {
+            Loading::Reporter& mReporter;
+            std::atomic<bool>& mProgressed;
+
+            SlowListener(Loading::Reporter& reporter, std::atomic<bool>& progressed)
+                : mReporter(reporter)
+                , mProgressed(progressed)
+            {
+            }
+
+            void setProgress(std::size_t /*value*/) override
+            {
+                // Progress is reported from another thread while the listener is busy
+                if (!mProgressed)
+                {
+                    std::thread([&] {
+                        mReporter.addProgress(1);
+                        mProgressed = true;
+                        mReporter.complete();
+                    }).join();
+                }
+            }
+        };
+
+        Loading::Reporter reporter;
+        std::atomic<bool> progressed{ false };
+        SlowListener listener(reporter, progressed);
+        reporter.wait(listener);
+        EXPECT_TRUE(progressed);
+    }
+}
@@ -0,0 +1,32 @@
+#include <gtest/gtest.h>
+
+#include <components/lua/bytecodecache.hpp>
+#include <components/testing/util.hpp>
+
+namespace
+{
+    using namespace testing;
+
+    TEST(LuaBytecodeCacheTest, makeKeyShouldDependOnPathAndSource)
+    {
+        const std::string key = LuaUtil::BytecodeCache::makeKey("scripts/a.lua", "return 1");
+        EXPECT_EQ(key, LuaUtil::BytecodeCache::makeKey("scripts/a.lua", "return 1"));
+        EXPECT_NE(key, LuaUtil::BytecodeCache::makeKey("scripts/b.lua", "return 1"));
+        EXPECT_NE(key, LuaUtil::BytecodeCache::makeKey("scripts/a.lua", "return 2"));
+    }
+
+    TEST(LuaBytecodeCacheTest, readShouldReturnWrittenBytecode)
+    {
+        const LuaUtil::BytecodeCache cache(TestingOpenMW::outputDirPath("lua_bytecode_cache_test"));
+        const std::string key = LuaUtil::BytecodeCache::makeKey("scripts/a.lua", "return 1");
+        const std::string bytecode("\x1bLJ\0\x02", 5);
+        cache.write(key, bytecode);
+        EXPECT_EQ(cache.read(key), bytecode);
+    }
+
+    TEST(LuaBytecodeCacheTest, readShouldReturnNulloptForUnknownKey)
+    {
+        const LuaUtil::BytecodeCache cache(TestingOpenMW::outputDirPath("lua_bytecode_cache_test"));
+        EXPECT_EQ(cache.read(LuaUtil::BytecodeCache::makeKey("scripts/unknown.lua", "")), std::nullopt);
+    }
+}
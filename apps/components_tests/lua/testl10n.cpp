@@ -160,6 +160,11 @@ speed: "Speed"
             EXPECT_EQ(get<std::string>(l, "t1('{mismatched_braces')"), "{mismatched_braces");
             EXPECT_EQ(get<std::string>(l, "t1('{unknown_arg}')"), "{unknown_arg}");
             EXPECT_EQ(get<std::string>(l, "t1('{num, integer}', {num=1})"), "{num, integer}");
+            // Messages are kept between calls, the arguments are not
+            EXPECT_EQ(get<std::string>(l, "t1('{name} arrived', {name='Caius'})"), "Caius arrived");
+            EXPECT_EQ(get<std::string>(l, "t1('{name} arrived', {name='Fargoth'})"), "Fargoth arrived");
+            EXPECT_EQ(get<std::string>(l, "t1('{mismatched_braces')"), "{mismatched_braces");
+            EXPECT_EQ(get<std::string>(l, "t1('good_morning')"), "Good morning.");
             // Doesn't give a valid currency symbol with `en`. Not that openmw is designed for real world currency.
             l10nManager.setPreferredLocales({ "en-US", "de" });
             EXPECT_EQ(get<std::string>(l, "t1('currency', {money=10000.10})"), "You have $10,000.10");
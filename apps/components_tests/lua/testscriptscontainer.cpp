@@ -10,6 +10,8 @@
 
 #include <components/testing/util.hpp>
 
+#include <chrono>
+
 namespace
 {
     using namespace testing;
@@ -276,6 +278,45 @@ CUSTOM: customdata.lua
             "Test[test2.lua]:\t update 1.5\n");
     }
 
+    TEST_F(LuaScriptsContainerTest, updateShouldAddSkippedTime)
+    {
+        LuaUtil::ScriptsContainer scripts(&mLua, "Test");
+        EXPECT_TRUE(scripts.addCustomScript(getId(test1Path)));
+        scripts.skipUpdate(0.5f);
+        scripts.skipUpdate(0.25f);
+        testing::internal::CaptureStdout();
+        scripts.update(1.0f);
+        scripts.update(1.5f);
+        EXPECT_EQ(internal::GetCapturedStdout(),
+            "Test[test1.lua]:\t update 1.75\n"
+            "Test[test1.lua]:\t update 1.5\n");
+    }
+
+    TEST_F(LuaScriptsContainerTest, collectHandlerStatsShouldCountCallsPerHandler)
+    {
+        LuaUtil::ScriptsContainer scripts(&mLua, "Test");
+        EXPECT_TRUE(scripts.addCustomScript(getId(test1Path)));
+        EXPECT_TRUE(scripts.addCustomScript(getId(test2Path)));
+        testing::internal::CaptureStdout();
+        scripts.update(1.0f);
+        scripts.update(1.0f);
+        std::string data = LuaUtil::serialize(sol::state_view(mLua.unsafeState()).create_table_with("x", 1));
+        scripts.receiveEvent("Event1", data);
+        internal::GetCapturedStdout();
+
+        std::vector<LuaUtil::ScriptsContainer::ScriptHandlerStats> stats;
+        scripts.collectHandlerStats(stats);
+        ASSERT_EQ(stats.size(), mCfg.size());
+        const auto& engineHandlers
+            = stats[getId(test1Path)][static_cast<std::size_t>(LuaUtil::ScriptsContainer::HandlerType::Engine)];
+        ASSERT_EQ(engineHandlers.count("onUpdate"), 1);
+        EXPECT_EQ(engineHandlers.at("onUpdate").mCallCount, 2);
+        const auto& eventHandlers
+            = stats[getId(test2Path)][static_cast<std::size_t>(LuaUtil::ScriptsContainer::HandlerType::Event)];
+        ASSERT_EQ(eventHandlers.count("Event1"), 1);
+        EXPECT_EQ(eventHandlers.at("Event1").mCallCount, 1);
+    }
+
     TEST_F(LuaScriptsContainerTest, CallEvent)
     {
         LuaUtil::ScriptsContainer scripts(&mLua, "Test");
@@ -539,6 +580,63 @@ CUSTOM: customdata.lua
         EXPECT_EQ(counter4, 25);
     }
 
+    TEST_F(LuaScriptsContainerTest, TimersOfTrackedContainers)
+    {
+        struct TrackedScriptsContainer : LuaUtil::ScriptsContainer
+        {
+            using LuaUtil::ScriptsContainer::ScriptsContainer;
+            bool mActive = true;
+            bool isActive() const override { return mActive; }
+        };
+        using TimerType = LuaUtil::ScriptsContainer::TimerType;
+        LuaUtil::ScriptTracker tracker;
+        TrackedScriptsContainer scripts1(&mLua, "Test", &tracker);
+        TrackedScriptsContainer scripts2(&mLua, "Test", &tracker);
+        const int test1Id = getId(test1Path);
+
+        testing::internal::CaptureStdout();
+        EXPECT_TRUE(scripts1.addCustomScript(test1Id));
+        EXPECT_TRUE(scripts2.addCustomScript(test1Id));
+        EXPECT_EQ(internal::GetCapturedStdout(), "");
+
+        int counter1 = 0, counter2 = 0;
+        sol::function fn1 = sol::make_object(mLua.unsafeState(), [&]() { counter1++; });
+        sol::function fn2 = sol::make_object(mLua.unsafeState(), [&]() { counter2++; });
+
+        scripts1.setupUnsavableTimer(TimerType::SIMULATION_TIME, 10, test1Id, fn1);
+        scripts1.setupUnsavableTimer(TimerType::SIMULATION_TIME, 5, test1Id, fn1);
+        scripts2.setupUnsavableTimer(TimerType::GAME_TIME, 5, test1Id, fn2);
+
+        EXPECT_EQ(tracker.processTimers(4, 4), 0);
+        EXPECT_EQ(counter1, 0);
+        EXPECT_EQ(counter2, 0);
+
+        EXPECT_EQ(tracker.processTimers(6, 4), 0);
+        EXPECT_EQ(counter1, 1);
+        EXPECT_EQ(counter2, 0);
+
+        // Timers of inactive containers wait till the container is active
+        scripts2.mActive = false;
+        EXPECT_EQ(tracker.processTimers(6, 6), 0);
+        EXPECT_EQ(counter2, 0);
+        scripts2.mActive = true;
+        scripts2.scheduleTimers();
+        EXPECT_EQ(tracker.processTimers(6, 6), 0);
+        EXPECT_EQ(counter2, 1);
+
+        // Deferred after the deadline till the next call
+        EXPECT_EQ(tracker.processTimers(11, 6, std::chrono::steady_clock::time_point()), 1);
+        EXPECT_EQ(counter1, 1);
+        EXPECT_EQ(tracker.processTimers(11, 6), 0);
+        EXPECT_EQ(counter1, 2);
+
+        // Timers of removed scripts are cancelled
+        scripts1.setupUnsavableTimer(TimerType::SIMULATION_TIME, 20, test1Id, fn1);
+        scripts1.removeAllScripts();
+        EXPECT_EQ(tracker.processTimers(21, 21), 0);
+        EXPECT_EQ(counter1, 2);
+    }
+
     TEST_F(LuaScriptsContainerTest, CallbackWrapper)
     {
         sol::state_view view = mLua.unsafeState();
@@ -15,6 +15,8 @@
 
 #include <components/testing/expecterror.hpp>
 
+#include <map>
+
 namespace
 {
     using namespace testing;
@@ -276,4 +278,79 @@ namespace
         EXPECT_EQ(ry.b, 3);
     }
 
+    TEST(LuaSerializationTest, CopySerializable)
+    {
+        sol::state lua;
+        sol::table table(lua, sol::create);
+        table["aa"] = 1;
+        table["nested"] = sol::table(lua, sol::create);
+        table["nested"]["bb"] = "something";
+        table[1] = osg::Vec2f(1, 2);
+
+        std::optional<sol::object> copy = LuaUtil::copySerializable(lua, table);
+        ASSERT_TRUE(copy.has_value());
+        sol::table res = copy->as<sol::table>();
+        EXPECT_NE(res, table);
+        EXPECT_NE(res.get<sol::table>("nested"), table.get<sol::table>("nested"));
+        EXPECT_EQ(res.get<int>("aa"), 1);
+        EXPECT_EQ(res.get<sol::table>("nested").get<std::string>("bb"), "something");
+        EXPECT_EQ(res.get<osg::Vec2f>(1), osg::Vec2f(1, 2));
+
+        table["aa"] = 2;
+        EXPECT_EQ(res.get<int>("aa"), 1);
+    }
+
+    TEST(LuaSerializationTest, CopySerializableShouldRejectWhatNeedsUserdataSerializer)
+    {
+        sol::state lua;
+        sol::table table(lua, sol::create);
+        table["x"] = TestStruct1{ 1.5, 2.5 };
+        EXPECT_FALSE(LuaUtil::copySerializable(lua, table).has_value());
+
+        lua.safe_script("f = function() end; t = {}; t.t = t");
+        EXPECT_FALSE(LuaUtil::copySerializable(lua, lua.get<sol::object>("f")).has_value());
+        EXPECT_FALSE(LuaUtil::copySerializable(lua, lua.get<sol::object>("t")).has_value());
+    }
+
+    TEST(LuaSerializationTest, SerializeTableShouldBeSameAsSerializingTable)
+    {
+        sol::state lua;
+        const std::string number = LuaUtil::serialize(sol::make_object<double>(lua, 3.5));
+        const std::string longString = LuaUtil::serialize(sol::make_object(lua, std::string(40, 'x')));
+        sol::table nested(lua, sol::create);
+        nested["v"] = osg::Vec3f(1, 2, 3);
+        nested[1] = Misc::Color(0.5, 0.5, 0.5, 1);
+        const std::string nestedTable = LuaUtil::serialize(nested);
+        const std::string longKey(40, 'k');
+        const std::vector<std::pair<std::string_view, std::string_view>> entries
+            = { { "a", number }, { longKey, longString }, { "nested", nestedTable } };
+
+        const std::string serialized = LuaUtil::serializeTable(entries);
+        sol::table table = LuaUtil::deserialize(lua, serialized);
+        EXPECT_DOUBLE_EQ(table.get<double>("a"), 3.5);
+        EXPECT_EQ(table.get<std::string>(longKey), std::string(40, 'x'));
+        EXPECT_EQ(table.get<sol::table>("nested").get<osg::Vec3f>("v"), osg::Vec3f(1, 2, 3));
+        EXPECT_EQ(LuaUtil::serialize(table).size(), serialized.size());
+
+        const std::vector<std::pair<std::string, std::string>> split = LuaUtil::splitSerializedTable(serialized);
+        std::map<std::string, std::string> values(split.begin(), split.end());
+        const std::map<std::string, std::string> expected
+            = { { "a", number }, { longKey, longString }, { "nested", nestedTable } };
+        EXPECT_EQ(values, expected);
+    }
+
+    TEST(LuaSerializationTest, SplitSerializedTableShouldRejectInvalidData)
+    {
+        sol::state lua;
+        sol::table table(lua, sol::create);
+        table[1] = "value";
+        EXPECT_ERROR(LuaUtil::splitSerializedTable(LuaUtil::serialize(table)), "key that is not a string");
+        EXPECT_ERROR(LuaUtil::splitSerializedTable(LuaUtil::serialize(sol::make_object(lua, "value"))), "not a table");
+
+        table = sol::table(lua, sol::create);
+        table["key"] = osg::Vec2f(1, 2);
+        const std::string serialized = LuaUtil::serialize(table);
+        EXPECT_ERROR(LuaUtil::splitSerializedTable(serialized.substr(0, serialized.size() - 2)), "end of serialized");
+    }
+
 }
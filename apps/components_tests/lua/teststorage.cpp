@@ -1,4 +1,5 @@
 #include <filesystem>
+#include <fstream>
 #include <gmock/gmock.h>
 #include <gtest/gtest.h>
 
@@ -100,7 +101,7 @@ namespace
             lua.safe_script("temporary:set('y', 2)");
 
             const auto tmpFile = std::filesystem::temp_directory_path() / "test_storage.bin";
-            storage.save(lua, tmpFile);
+            storage.save(tmpFile);
             EXPECT_EQ(get<int>(lua, "permanent:get('x')"), 1);
             EXPECT_EQ(get<int>(lua, "temporary:get('y')"), 2);
 
@@ -115,7 +116,7 @@ namespace
 
             LuaUtil::LuaStorage storage2;
             storage2.setActive(true);
-            storage2.load(lua, tmpFile);
+            storage2.load(tmpFile);
             lua["permanent"] = storage2.getMutableSection(lua, "permanent");
             lua["temporary"] = storage2.getMutableSection(lua, "temporary");
 
@@ -125,4 +126,49 @@ namespace
         });
     }
 
+    TEST(LuaUtilStorageTest, ShouldKeepUnchangedSectionsWhenSaving)
+    {
+        LuaUtil::LuaState luaState{ nullptr, nullptr };
+        luaState.protectedCall([](LuaUtil::LuaView& view) {
+            LuaUtil::LuaStorage::initLuaBindings(view);
+            auto& lua = view.sol();
+            const auto tmpFile = std::filesystem::temp_directory_path() / "test_storage_sections.bin";
+            {
+                LuaUtil::LuaStorage storage;
+                storage.setActive(true);
+                lua["first"] = storage.getMutableSection(lua, "first");
+                lua["second"] = storage.getMutableSection(lua, "second");
+                lua.safe_script("first:set('x', { a = 1, b = 'text' })");
+                lua.safe_script("second:set('y', 2)");
+                storage.save(tmpFile);
+            }
+
+            LuaUtil::LuaStorage storage;
+            storage.setActive(true);
+            storage.load(tmpFile);
+            lua["second"] = storage.getMutableSection(lua, "second");
+            lua.safe_script("second:set('y', 3)");
+            storage.save(tmpFile);
+
+            // Nothing changed, so the file is not written
+            std::filesystem::remove(tmpFile);
+            std::ofstream(tmpFile) << "unchanged";
+            storage.save(tmpFile);
+            EXPECT_EQ(std::filesystem::file_size(tmpFile), 9);
+
+            lua.safe_script("second:set('z', 4)");
+            storage.save(tmpFile);
+
+            LuaUtil::LuaStorage storage2;
+            storage2.setActive(true);
+            storage2.load(tmpFile);
+            lua["first"] = storage2.getMutableSection(lua, "first");
+            lua["second"] = storage2.getMutableSection(lua, "second");
+            EXPECT_EQ(get<int>(lua, "first:get('x').a"), 1);
+            EXPECT_EQ(get<std::string>(lua, "first:get('x').b"), "text");
+            EXPECT_EQ(get<int>(lua, "second:get('y')"), 3);
+            EXPECT_EQ(get<int>(lua, "second:get('z')"), 4);
+        });
+    }
+
 }
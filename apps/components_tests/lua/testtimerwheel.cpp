@@ -0,0 +1,141 @@
+#include <components/lua/timerwheel.hpp>
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <vector>
+
+namespace
+{
+    using namespace testing;
+
+    using Wheel = LuaUtil::TimerWheel<int>;
+
+    std::vector<int> advance(Wheel& wheel, double time)
+    {
+        std::vector<Wheel::Entry> expired;
+        wheel.advance(time, expired);
+        std::vector<int> result;
+        for (const Wheel::Entry& entry : expired)
+            result.push_back(entry.mValue);
+        return result;
+    }
+
+    TEST(LuaTimerWheelTest, shouldReturnExpiredEntriesOrderedByTime)
+    {
+        Wheel wheel(1);
+        wheel.insert(3.5, 1);
+        wheel.insert(1.5, 2);
+        wheel.insert(2, 3);
+        wheel.insert(10, 4);
+        EXPECT_EQ(wheel.size(), 4);
+        EXPECT_EQ(advance(wheel, 3.5), std::vector<int>({ 2, 3, 1 }));
+        EXPECT_EQ(wheel.size(), 1);
+        EXPECT_EQ(advance(wheel, 9.9), std::vector<int>());
+        EXPECT_EQ(advance(wheel, 10), std::vector<int>({ 4 }));
+        EXPECT_EQ(wheel.size(), 0);
+    }
+
+    TEST(LuaTimerWheelTest, shouldKeepEntriesOfCurrentTickTillTheirTime)
+    {
+        Wheel wheel(1);
+        wheel.insert(5.75, 1);
+        wheel.insert(5.25, 2);
+        EXPECT_EQ(advance(wheel, 5.5), std::vector<int>({ 2 }));
+        EXPECT_EQ(advance(wheel, 5.6), std::vector<int>());
+        EXPECT_EQ(advance(wheel, 5.8), std::vector<int>({ 1 }));
+    }
+
+    TEST(LuaTimerWheelTest, entriesInThePastShouldExpireOnNextAdvance)
+    {
+        Wheel wheel(1);
+        EXPECT_EQ(advance(wheel, 100), std::vector<int>());
+        wheel.insert(50, 1);
+        EXPECT_EQ(advance(wheel, 100), std::vector<int>({ 1 }));
+    }
+
+    TEST(LuaTimerWheelTest, shouldHandleTimeGoingBack)
+    {
+        Wheel wheel(1);
+        wheel.insert(1000, 1);
+        EXPECT_EQ(advance(wheel, 500), std::vector<int>());
+        wheel.insert(20, 2);
+        EXPECT_EQ(advance(wheel, 10), std::vector<int>());
+        EXPECT_EQ(advance(wheel, 20), std::vector<int>({ 2 }));
+        EXPECT_EQ(advance(wheel, 1000), std::vector<int>({ 1 }));
+    }
+
+    TEST(LuaTimerWheelTest, shouldMoveEntriesFromCoarserLevelsWhenTimeReachesThem)
+    {
+        Wheel wheel(1);
+        // Close to the span of all levels
+        const double start = (1 << 24) - 20;
+        EXPECT_EQ(advance(wheel, start), std::vector<int>());
+        wheel.insert(start + 25, 1);
+        wheel.insert(start + 70000, 2);
+        wheel.insert(start + 2e7, 3);
+        std::vector<int> expired;
+        std::vector<double> times;
+        for (double time = start; time <= start + 2.1e7; time += 64)
+        {
+            for (int value : advance(wheel, time))
+            {
+                expired.push_back(value);
+                times.push_back(time);
+            }
+        }
+        EXPECT_EQ(expired, std::vector<int>({ 1, 2, 3 }));
+        EXPECT_EQ(times, std::vector<double>({ start + 64, start + 70016, start + 2e7 }));
+    }
+
+    TEST(LuaTimerWheelTest, clearShouldRemoveAllEntries)
+    {
+        Wheel wheel(1);
+        wheel.insert(1, 1);
+        wheel.insert(1e9, 2);
+        wheel.clear();
+        EXPECT_EQ(wheel.size(), 0);
+        EXPECT_EQ(advance(wheel, 2e9), std::vector<int>());
+    }
+
+    TEST(LuaTimerWheelTest, shouldExpireSameEntriesAsSortedList)
+    {
+        std::mt19937 random(42);
+        // Spans of every level and the overflow
+        std::uniform_real_distribution<double> delay(0, 3e7);
+        std::uniform_int_distribution<int> magnitude(0, 5);
+        std::uniform_real_distribution<double> step(0, 2);
+        Wheel wheel(1);
+        std::vector<Wheel::Entry> expected;
+        double time = 0;
+        int value = 0;
+        for (int i = 0; i < 5000; ++i)
+        {
+            for (int j = 0; j < 2; ++j)
+            {
+                const double entryTime = time + delay(random) / std::pow(64, magnitude(random));
+                wheel.insert(entryTime, value);
+                expected.push_back(Wheel::Entry{ entryTime, value });
+                ++value;
+            }
+            // Mostly short steps, sometimes a long jump
+            time += i % 500 == 499 ? 1e6 : step(random);
+
+            std::vector<Wheel::Entry> expired;
+            wheel.advance(time, expired);
+            const auto notExpired = std::stable_partition(
+                expected.begin(), expected.end(), [&](const Wheel::Entry& entry) { return entry.mTime <= time; });
+            std::vector<Wheel::Entry> expectedExpired(expected.begin(), notExpired);
+            expected.erase(expected.begin(), notExpired);
+
+            ASSERT_EQ(expired.size(), expectedExpired.size()) << i;
+            std::sort(expectedExpired.begin(), expectedExpired.end(),
+                [](const Wheel::Entry& l, const Wheel::Entry& r) { return l.mTime < r.mTime; });
+            for (std::size_t k = 0; k < expired.size(); ++k)
+                ASSERT_EQ(expired[k].mTime, expectedExpired[k].mTime) << i;
+            ASSERT_EQ(wheel.size(), expected.size()) << i;
+        }
+    }
+}
@@ -0,0 +1,53 @@
+#include <components/misc/framearena.hpp>
+
+#include <gtest/gtest.h>
+
+#include <thread>
+
+namespace
+{
+    using namespace testing;
+    using namespace Misc;
+
+    TEST(MiscFrameArenaTest, shouldCountAllocationsPerUser)
+    {
+        resetFrameArena();
+        {
+            FrameVector<int> values = makeFrameVector<int>(FrameArenaUser::Mechanics);
+            values.assign(10, 1);
+        }
+        EXPECT_EQ(getFrameArenaStats(FrameArenaUser::Mechanics).mAllocations, 1);
+        EXPECT_EQ(getFrameArenaStats(FrameArenaUser::Mechanics).mBytes, 10 * sizeof(int));
+        EXPECT_EQ(getFrameArenaStats(FrameArenaUser::Lua).mAllocations, 0);
+        resetFrameArena();
+        EXPECT_EQ(getFrameArenaStats(FrameArenaUser::Mechanics).mAllocations, 0);
+        EXPECT_EQ(getFrameArenaStats(FrameArenaUser::Mechanics).mBytes, 0);
+    }
+
+    TEST(MiscFrameArenaTest, shouldReuseMemoryAfterReset)
+    {
+        resetFrameArena();
+        const void* first = nullptr;
+        {
+            FrameVector<int> values = makeFrameVector<int>(FrameArenaUser::Rendering);
+            values.resize(100);
+            first = values.data();
+        }
+        resetFrameArena();
+        FrameVector<int> values = makeFrameVector<int>(FrameArenaUser::Rendering);
+        values.resize(100);
+        EXPECT_EQ(values.data(), first);
+    }
+
+    TEST(MiscFrameArenaTest, otherThreadsShouldAllocateFromHeap)
+    {
+        resetFrameArena();
+        const std::pmr::memory_resource* const arena = getFrameArena(FrameArenaUser::Lua);
+        std::thread([&] {
+            FrameVector<int> values = makeFrameVector<int>(FrameArenaUser::Lua);
+            values.assign(10, 1);
+            EXPECT_NE(values.get_allocator().resource(), arena);
+        }).join();
+        EXPECT_EQ(getFrameArenaStats(FrameArenaUser::Lua).mAllocations, 1);
+    }
+}
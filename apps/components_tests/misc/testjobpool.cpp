@@ -0,0 +1,51 @@
+#include <components/misc/jobpool.hpp>
+
+#include <gtest/gtest.h>
+
+#include <stdexcept>
+#include <vector>
+
+namespace
+{
+    using namespace testing;
+    using namespace Misc;
+
+    TEST(MiscJobPoolTest, runShouldCallJobForEachIndexOnce)
+    {
+        JobPool pool(3);
+        std::vector<int> calls(1000, 0);
+        pool.run(calls.size(), 7, [&](std::size_t i) { ++calls[i]; });
+        EXPECT_EQ(calls, std::vector<int>(calls.size(), 1));
+    }
+
+    TEST(MiscJobPoolTest, runShouldWorkWithoutWorkerThreads)
+    {
+        JobPool pool(0);
+        std::vector<int> calls(10, 0);
+        pool.run(calls.size(), 1, [&](std::size_t i) { ++calls[i]; });
+        EXPECT_EQ(calls, std::vector<int>(calls.size(), 1));
+    }
+
+    TEST(MiscJobPoolTest, runShouldBeReusable)
+    {
+        JobPool pool(2);
+        std::vector<int> calls(100, 0);
+        for (int run = 0; run < 10; ++run)
+            pool.run(calls.size(), 1, [&](std::size_t i) { ++calls[i]; });
+        EXPECT_EQ(calls, std::vector<int>(calls.size(), 10));
+    }
+
+    TEST(MiscJobPoolTest, runShouldRethrowJobException)
+    {
+        JobPool pool(2);
+        EXPECT_THROW(pool.run(100, 1,
+                         [](std::size_t i) {
+                             if (i == 42)
+                                 throw std::runtime_error("error");
+                         }),
+            std::runtime_error);
+        std::vector<int> calls(10, 0);
+        pool.run(calls.size(), 1, [&](std::size_t i) { ++calls[i]; });
+        EXPECT_EQ(calls, std::vector<int>(calls.size(), 1));
+    }
+}
@@ -232,4 +232,81 @@ namespace
     {
         EXPECT_EQ(ciFind("foobar", "baz"), std::string_view::npos);
     }
+
+    TEST(MiscStringsWordToLower, should_match_to_lower_for_every_character_in_every_position)
+    {
+        for (int c = 0; c < 256; ++c)
+        {
+            for (std::size_t position = 0; position < Word::size; ++position)
+            {
+                char value[Word::size] = { 'A', 'z', '@', '[', '`', '{', '\x80', '\xC1' };
+                value[position] = static_cast<char>(c);
+                char expected[Word::size];
+                for (std::size_t i = 0; i < Word::size; ++i)
+                    expected[i] = toLower(value[i]);
+                char result[Word::size];
+                Word::store(Word::toLower(Word::load(value)), result);
+                EXPECT_EQ(std::string_view(result, Word::size), std::string_view(expected, Word::size))
+                    << "c=" << c << " position=" << position;
+            }
+        }
+    }
+
+    TEST(MiscStringsWordEqual, should_find_only_equal_characters)
+    {
+        for (int c = 0; c < 256; ++c)
+        {
+            const char value[Word::size] = { static_cast<char>(c), '\\', '/', '\x5C', '\xDC', '\0', '\x5D', '\x5B' };
+            const std::uint64_t mask = Word::equal(Word::load(value), '\\');
+            char result[Word::size];
+            Word::store(mask, result);
+            for (std::size_t i = 0; i < Word::size; ++i)
+                EXPECT_EQ(result[i] != 0, value[i] == '\\') << "c=" << c << " i=" << i;
+        }
+    }
+
+    TEST(MiscStringsLowerCase, should_lower_case_strings_of_any_length)
+    {
+        const std::string upper = "ABCDEFGHIJKLMNOPQRSTUVWXYZ\xC0\xC1 @[`{";
+        const std::string lower = "abcdefghijklmnopqrstuvwxyz\xC0\xC1 @[`{";
+        for (std::size_t size = 0; size <= upper.size(); ++size)
+            EXPECT_EQ(lowerCase(std::string_view(upper).substr(0, size)), lower.substr(0, size)) << size;
+    }
+
+    TEST(MiscStringsCiEqual, should_compare_strings_differing_at_any_position)
+    {
+        const std::string value = "Some String Longer Than A Few Words";
+        for (std::size_t position = 0; position < value.size(); ++position)
+        {
+            std::string other = lowerCase(value);
+            EXPECT_TRUE(ciEqual(value, other));
+            other[position] = '#';
+            EXPECT_FALSE(ciEqual(value, other)) << position;
+        }
+    }
+
+    TEST(MiscStringsCiLess, should_match_lexicographical_compare)
+    {
+        const std::vector<std::string> values = { "", "a", "A", "ab", "aB", "abcdefgh", "ABCDEFGHI", "abcdefgh_",
+            "abcdefgh[", "abcdefghij", "abcdefgi", "b", "\xC0", "a\xC0", "ABCDEFGH\xC0" };
+        for (const std::string& x : values)
+            for (const std::string& y : values)
+                EXPECT_EQ(ciLess(x, y),
+                    std::lexicographical_compare(x.begin(), x.end(), y.begin(), y.end(), CiCharLess()))
+                    << x << " < " << y;
+    }
+
+    TEST(MiscStringsCiHash, should_be_equal_for_strings_with_different_case)
+    {
+        const std::string value = "Some String Longer Than A Few Words";
+        for (std::size_t size = 0; size <= value.size(); ++size)
+            EXPECT_EQ(CiHash()(value.substr(0, size)), CiHash()(lowerCase(value.substr(0, size)))) << size;
+    }
+
+    TEST(MiscStringsCiHash, should_differ_for_different_strings)
+    {
+        EXPECT_NE(CiHash()("a"), CiHash()("b"));
+        EXPECT_NE(CiHash()("abcdefgh"), CiHash()("abcdefgi"));
+        EXPECT_NE(CiHash()("a"), CiHash()(std::string_view("a\0", 2)));
+    }
 }
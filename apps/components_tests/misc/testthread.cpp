@@ -0,0 +1,31 @@
+#include <components/misc/thread.hpp>
+
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+
+namespace
+{
+    using namespace testing;
+    using namespace Misc;
+
+    TEST(MiscParseCoreListTest, shouldReturnNothingForEmptyValue)
+    {
+        EXPECT_THAT(parseCoreList(""), IsEmpty());
+    }
+
+    TEST(MiscParseCoreListTest, shouldSupportIndicesAndRanges)
+    {
+        EXPECT_THAT(parseCoreList("0-3,8"), ElementsAre(0u, 1u, 2u, 3u, 8u));
+        EXPECT_THAT(parseCoreList("5"), ElementsAre(5u));
+        EXPECT_THAT(parseCoreList("2-2"), ElementsAre(2u));
+    }
+
+    TEST(MiscParseCoreListTest, shouldReturnNothingForMalformedValue)
+    {
+        EXPECT_THAT(parseCoreList("a"), IsEmpty());
+        EXPECT_THAT(parseCoreList("1,"), IsEmpty());
+        EXPECT_THAT(parseCoreList("3-1"), IsEmpty());
+        EXPECT_THAT(parseCoreList("1-"), IsEmpty());
+        EXPECT_THAT(parseCoreList("1 2"), IsEmpty());
+    }
+}
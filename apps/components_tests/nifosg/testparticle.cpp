@@ -0,0 +1,99 @@
+#include <components/nif/particle.hpp>
+#include <components/nifosg/particle.hpp>
+
+#include <gtest/gtest.h>
+
+#include <array>
+
+namespace
+{
+    using namespace testing;
+    using namespace NifOsg;
+
+    struct NifOsgParticleBatchTest : Test
+    {
+        osg::ref_ptr<ParticleSystem> mScalar = new ParticleSystem;
+        osg::ref_ptr<ParticleSystem> mBatched = new ParticleSystem;
+        osg::ref_ptr<ParticleProgram> mProgram = new ParticleProgram;
+
+        NifOsgParticleBatchTest()
+        {
+            const std::array positions = { osg::Vec3f(0, 0, 0), osg::Vec3f(10, -5, 3), osg::Vec3f(-20, 40, 100) };
+            const std::array velocities = { osg::Vec3f(1, 2, 3), osg::Vec3f(0, 0, -10), osg::Vec3f(-4, 0, 2) };
+            for (ParticleSystem* partsys : { mScalar.get(), mBatched.get() })
+            {
+                for (std::size_t i = 0; i < positions.size(); ++i)
+                {
+                    osgParticle::Particle* particle = partsys->createParticle(nullptr);
+                    particle->setPosition(positions[i]);
+                    particle->setVelocity(velocities[i]);
+                    particle->setLifeTime(5);
+                }
+            }
+            mProgram->setParticleSystem(mScalar);
+        }
+
+        void operate(osgParticle::Operator& op, BatchOperator& batchOp, float dt)
+        {
+            op.beginOperate(mProgram);
+            for (int i = 0; i < mScalar->numParticles(); ++i)
+                op.operate(mScalar->getParticle(i), dt);
+
+            ParticleBatch batch;
+            batch.gather(*mBatched);
+            batchOp.operateBatch(batch, dt);
+            batch.scatter();
+        }
+
+        void expectSameVelocities() const
+        {
+            ASSERT_EQ(mScalar->numParticles(), mBatched->numParticles());
+            for (int i = 0; i < mScalar->numParticles(); ++i)
+            {
+                const osg::Vec3f expected = mScalar->getParticle(i)->getVelocity();
+                const osg::Vec3f actual = mBatched->getParticle(i)->getVelocity();
+                EXPECT_NEAR(actual.x(), expected.x(), 1e-4f) << i;
+                EXPECT_NEAR(actual.y(), expected.y(), 1e-4f) << i;
+                EXPECT_NEAR(actual.z(), expected.z(), 1e-4f) << i;
+            }
+        }
+    };
+
+    TEST_F(NifOsgParticleBatchTest, gravityAffectorBatchShouldMatchPerParticleUpdateForWind)
+    {
+        Nif::NiGravity gravity;
+        gravity.mForce = 2;
+        gravity.mType = Nif::ForceType::Wind;
+        gravity.mDecay = 0.01f;
+        gravity.mPosition = osg::Vec3f(1, 2, 3);
+        gravity.mDirection = osg::Vec3f(0, 0, -1);
+        osg::ref_ptr<GravityAffector> affector = new GravityAffector(&gravity);
+        operate(*affector, *affector, 0.1f);
+        expectSameVelocities();
+    }
+
+    TEST_F(NifOsgParticleBatchTest, gravityAffectorBatchShouldMatchPerParticleUpdateForPoint)
+    {
+        Nif::NiGravity gravity;
+        gravity.mForce = 3;
+        gravity.mType = Nif::ForceType::Point;
+        gravity.mDecay = 0.02f;
+        gravity.mPosition = osg::Vec3f(10, -5, 3);
+        gravity.mDirection = osg::Vec3f(1, 0, 0);
+        osg::ref_ptr<GravityAffector> affector = new GravityAffector(&gravity);
+        operate(*affector, *affector, 0.1f);
+        expectSameVelocities();
+    }
+
+    TEST_F(NifOsgParticleBatchTest, growFadeAffectorBatchShouldMatchPerParticleUpdate)
+    {
+        for (ParticleSystem* partsys : { mScalar.get(), mBatched.get() })
+            partsys->getParticle(1)->update(4.5, false);
+        osg::ref_ptr<GrowFadeAffector> affector = new GrowFadeAffector(1, 1);
+        operate(*affector, *affector, 0);
+        for (int i = 0; i < mScalar->numParticles(); ++i)
+            EXPECT_NEAR(mBatched->getParticle(i)->getSizeRange().minimum,
+                mScalar->getParticle(i)->getSizeRange().minimum, 1e-5f)
+                << i;
+    }
+}
@@ -1,3 +1,4 @@
+#include <components/resource/resourcemanager.hpp>
 #include <components/resource/resourcesystem.hpp>
 #include <components/resource/scenemanager.hpp>
 #include <components/toutf8/toutf8.hpp>
@@ -29,4 +30,44 @@ namespace
         for (std::thread& thread : threads)
             thread.join();
     }
+
+    struct Object : osg::Object
+    {
+        Object() = default;
+
+        Object(const Object& other, const osg::CopyOp& copyOp = osg::CopyOp())
+            : osg::Object(other, copyOp)
+        {
+        }
+
+        META_Object(ResourceTest, Object)
+    };
+
+    struct TestResourceManager : Resource::GenericResourceManager<int>
+    {
+        using GenericResourceManager::GenericResourceManager;
+
+        void add(int key, osg::Object* object) { mCache->addEntryToObjectCache(key, object); }
+
+        bool has(int key) { return mCache->getRefFromObjectCache(key) != nullptr; }
+    };
+
+    TEST(ResourceResourceSystem, expire_cache_should_use_given_expiry_delay)
+    {
+        const VFS::Manager vfsManager;
+        const ToUTF8::Utf8Encoder encoder(ToUTF8::WINDOWS_1252);
+        Resource::ResourceSystem resourceSystem(&vfsManager, 1.0, &encoder.getStatelessEncoder());
+        TestResourceManager manager(&vfsManager, 100.0);
+        resourceSystem.addResourceManager(&manager);
+
+        manager.add(1, new Object);
+        resourceSystem.updateCache(1.0);
+        resourceSystem.updateCache(2.0);
+        EXPECT_TRUE(manager.has(1));
+
+        resourceSystem.expireCache(2.0, 0.5);
+        EXPECT_FALSE(manager.has(1));
+
+        resourceSystem.removeResourceManager(&manager);
+    }
 }
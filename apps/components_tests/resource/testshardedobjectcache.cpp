@@ -0,0 +1,153 @@
+#include <components/resource/shardedobjectcache.hpp>
+#include <components/vfs/pathutil.hpp>
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <osg/Object>
+
+#include <string>
+
+namespace Resource
+{
+    namespace
+    {
+        using namespace ::testing;
+
+        struct Object : osg::Object
+        {
+            Object() = default;
+
+            Object(const Object& other, const osg::CopyOp& copyOp = osg::CopyOp())
+                : osg::Object(other, copyOp)
+            {
+            }
+
+            META_Object(ResourceTest, Object)
+        };
+
+        using Cache = ShardedObjectCache<int>;
+        using PathCache = ShardedObjectCache<std::string, VFS::Path::Hash>;
+
+        TEST(ResourceShardedObjectCacheTest, getRefFromObjectCacheShouldReturnNullptrByDefault)
+        {
+            osg::ref_ptr<Cache> cache(new Cache);
+            EXPECT_EQ(cache->getRefFromObjectCache(42), nullptr);
+        }
+
+        TEST(ResourceShardedObjectCacheTest, shouldStoreValues)
+        {
+            osg::ref_ptr<Cache> cache(new Cache);
+            osg::ref_ptr<Object> value(new Object);
+            cache->addEntryToObjectCache(42, value);
+            EXPECT_EQ(cache->getRefFromObjectCache(42), value);
+        }
+
+        TEST(ResourceShardedObjectCacheTest, shouldSupportHeterogeneousLookup)
+        {
+            osg::ref_ptr<PathCache> cache(new PathCache);
+            osg::ref_ptr<Object> value(new Object);
+            cache->addEntryToObjectCache(std::string("meshes/a.nif"), value);
+            EXPECT_EQ(cache->getRefFromObjectCache(VFS::Path::NormalizedView("meshes/a.nif")), value);
+            EXPECT_EQ(cache->getRefFromObjectCache(std::string_view("meshes/a.nif")), value);
+        }
+
+        TEST(ResourceShardedObjectCacheTest, updateShouldRemoveExpiredItems)
+        {
+            osg::ref_ptr<Cache> cache(new Cache);
+
+            const double referenceTime = 1;
+            const double expiryDelay = 1;
+
+            osg::ref_ptr<Object> value(new Object);
+            cache->addEntryToObjectCache(42, value);
+            value = nullptr;
+
+            cache->update(referenceTime, expiryDelay);
+            ASSERT_THAT(cache->getRefFromObjectCacheOrNone(42), Optional(_));
+
+            cache->update(referenceTime + expiryDelay, expiryDelay);
+            EXPECT_EQ(cache->getRefFromObjectCacheOrNone(42), std::nullopt);
+            EXPECT_EQ(cache->getStats().mExpired, 1);
+        }
+
+        TEST(ResourceShardedObjectCacheTest, updateShouldKeepExternallyReferencedItems)
+        {
+            osg::ref_ptr<Cache> cache(new Cache);
+
+            const double referenceTime = 1;
+            const double expiryDelay = 1;
+
+            osg::ref_ptr<Object> value(new Object);
+            cache->addEntryToObjectCache(42, value);
+
+            cache->update(referenceTime, expiryDelay);
+            cache->update(referenceTime + expiryDelay, expiryDelay);
+            EXPECT_THAT(cache->getRefFromObjectCacheOrNone(42), Optional(value));
+        }
+
+        TEST(ResourceShardedObjectCacheTest, addEntryToObjectCacheShouldEvictLeastRecentlyUsedItem)
+        {
+            osg::ref_ptr<Cache> cache(new Cache(1, 2));
+
+            cache->addEntryToObjectCache(1, new Object);
+            cache->addEntryToObjectCache(2, new Object);
+            ASSERT_NE(cache->getRefFromObjectCache(1), nullptr);
+            cache->addEntryToObjectCache(3, new Object);
+
+            EXPECT_THAT(cache->getRefFromObjectCacheOrNone(1), Optional(_));
+            EXPECT_EQ(cache->getRefFromObjectCacheOrNone(2), std::nullopt);
+            EXPECT_THAT(cache->getRefFromObjectCacheOrNone(3), Optional(_));
+            EXPECT_EQ(cache->getStats().mEvicted, 1);
+        }
+
+        TEST(ResourceShardedObjectCacheTest, evictionShouldPreferNotReferencedItems)
+        {
+            osg::ref_ptr<Cache> cache(new Cache(1, 2));
+
+            osg::ref_ptr<Object> value(new Object);
+            cache->addEntryToObjectCache(1, value);
+            cache->addEntryToObjectCache(2, new Object);
+            cache->addEntryToObjectCache(3, new Object);
+
+            EXPECT_THAT(cache->getRefFromObjectCacheOrNone(1), Optional(value));
+            EXPECT_EQ(cache->getRefFromObjectCacheOrNone(2), std::nullopt);
+        }
+
+        TEST(ResourceShardedObjectCacheTest, clearShouldRemoveItemsFromAllShards)
+        {
+            osg::ref_ptr<Cache> cache(new Cache(4));
+            for (int i = 0; i < 16; ++i)
+                cache->addEntryToObjectCache(i, new Object);
+            ASSERT_EQ(cache->getStats().mSize, 16);
+            cache->clear();
+            EXPECT_EQ(cache->getStats().mSize, 0);
+        }
+
+        TEST(ResourceShardedObjectCacheTest, callShouldIterateOverAllItems)
+        {
+            osg::ref_ptr<Cache> cache(new Cache(4));
+            for (int i = 0; i < 8; ++i)
+                cache->addEntryToObjectCache(i, new Object);
+
+            std::vector<int> actual;
+            cache->call([&](int key, osg::Object* /*value*/) { actual.push_back(key); });
+
+            EXPECT_THAT(actual, UnorderedElementsAre(0, 1, 2, 3, 4, 5, 6, 7));
+        }
+
+        TEST(ResourceShardedObjectCacheTest, getStatsShouldReturnNumberOfGetsAndHits)
+        {
+            osg::ref_ptr<Cache> cache(new Cache);
+
+            cache->addEntryToObjectCache(13, new Object);
+            cache->getRefFromObjectCache(13);
+            cache->getRefFromObjectCache(42);
+
+            const CacheStats stats = cache->getStats();
+
+            EXPECT_EQ(stats.mGet, 2);
+            EXPECT_EQ(stats.mHit, 1);
+        }
+    }
+}
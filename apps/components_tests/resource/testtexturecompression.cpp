@@ -0,0 +1,104 @@
+#include <components/resource/texturecompression.hpp>
+
+#include <gtest/gtest.h>
+
+#include <osg/Image>
+#include <osg/Texture>
+
+namespace Resource
+{
+    namespace
+    {
+        using namespace ::testing;
+
+        osg::ref_ptr<osg::Image> makeImage(int width, int height, GLenum pixelFormat, const osg::Vec4& color)
+        {
+            osg::ref_ptr<osg::Image> image = new osg::Image;
+            image->allocateImage(width, height, 1, pixelFormat, GL_UNSIGNED_BYTE);
+            for (int t = 0; t < height; ++t)
+                for (int s = 0; s < width; ++s)
+                    image->setColor(color, s, t);
+            return image;
+        }
+
+        TEST(ResourceTextureCompressionTest, canCompressImageShouldRequireBlockAlignedSize)
+        {
+            EXPECT_TRUE(canCompressImage(*makeImage(8, 4, GL_RGB, osg::Vec4(1, 1, 1, 1))));
+            EXPECT_FALSE(canCompressImage(*makeImage(6, 4, GL_RGB, osg::Vec4(1, 1, 1, 1))));
+        }
+
+        TEST(ResourceTextureCompressionTest, canCompressImageShouldRejectCompressedImages)
+        {
+            osg::ref_ptr<osg::Image> image
+                = compressImage(*makeImage(4, 4, GL_RGB, osg::Vec4(1, 1, 1, 1)), TextureCompression::BC1, false);
+            EXPECT_FALSE(canCompressImage(*image));
+        }
+
+        TEST(ResourceTextureCompressionTest, isNormalMapShouldMatchPatternButNotNormalHeightPattern)
+        {
+            EXPECT_TRUE(isNormalMap("textures/rock_n.tga", "_n", "_nh"));
+            EXPECT_FALSE(isNormalMap("textures/rock_nh.tga", "_n", "_nh"));
+            EXPECT_FALSE(isNormalMap("textures/rock.tga", "_n", "_nh"));
+            EXPECT_FALSE(isNormalMap("textures/rock_n.tga", "", "_nh"));
+        }
+
+        TEST(ResourceTextureCompressionTest, chooseTextureCompressionShouldUseBC1ForOpaqueImages)
+        {
+            EXPECT_EQ(chooseTextureCompression(*makeImage(4, 4, GL_RGBA, osg::Vec4(1, 0, 0, 1)), false),
+                TextureCompression::BC1);
+        }
+
+        TEST(ResourceTextureCompressionTest, chooseTextureCompressionShouldUseBC3ForTranslucentImages)
+        {
+            EXPECT_EQ(chooseTextureCompression(*makeImage(4, 4, GL_RGBA, osg::Vec4(1, 0, 0, 0.5f)), false),
+                TextureCompression::BC3);
+        }
+
+        TEST(ResourceTextureCompressionTest, chooseTextureCompressionShouldUseBC5ForNormalMaps)
+        {
+            EXPECT_EQ(chooseTextureCompression(*makeImage(4, 4, GL_RGB, osg::Vec4(0.5f, 0.5f, 1, 1)), true),
+                TextureCompression::BC5);
+        }
+
+        TEST(ResourceTextureCompressionTest, compressImageShouldGenerateAllMipmapLevels)
+        {
+            osg::ref_ptr<osg::Image> image
+                = compressImage(*makeImage(16, 8, GL_RGB, osg::Vec4(1, 1, 1, 1)), TextureCompression::BC1, false);
+            EXPECT_EQ(image->getPixelFormat(), static_cast<GLenum>(GL_COMPRESSED_RGB_S3TC_DXT1_EXT));
+            EXPECT_EQ(image->s(), 16);
+            EXPECT_EQ(image->t(), 8);
+            ASSERT_EQ(image->getNumMipmapLevels(), 5u);
+            // 4x2 blocks, then 2x1 and three levels of a single block, 8 bytes each
+            EXPECT_EQ(image->getMipmapOffset(1), 64u);
+            EXPECT_EQ(image->getMipmapOffset(2), 80u);
+            EXPECT_EQ(image->getTotalSizeInBytesIncludingMipmaps(), 104u);
+        }
+
+        TEST(ResourceTextureCompressionTest, compressImageShouldStoreSolidColorAsEndpoint)
+        {
+            osg::ref_ptr<osg::Image> image
+                = compressImage(*makeImage(4, 4, GL_RGB, osg::Vec4(1, 0, 0, 1)), TextureCompression::BC1, false);
+            const unsigned char* data = image->data();
+            EXPECT_EQ(data[0] | (data[1] << 8), 0xf800);
+            EXPECT_EQ(data[2] | (data[3] << 8), 0xf800);
+        }
+
+        TEST(ResourceTextureCompressionTest, compressImageShouldStoreAlphaForBC3)
+        {
+            osg::ref_ptr<osg::Image> image = compressImage(
+                *makeImage(4, 4, GL_RGBA, osg::Vec4(1, 1, 1, 0)), TextureCompression::BC3, false);
+            EXPECT_EQ(image->getPixelFormat(), static_cast<GLenum>(GL_COMPRESSED_RGBA_S3TC_DXT5_EXT));
+            EXPECT_EQ(image->data()[0], 0);
+            EXPECT_EQ(image->data()[1], 0);
+        }
+
+        TEST(ResourceTextureCompressionTest, compressImageShouldStoreRedAndGreenForBC5)
+        {
+            osg::ref_ptr<osg::Image> image = compressImage(
+                *makeImage(4, 4, GL_RGB, osg::Vec4(1, 0, 1, 1)), TextureCompression::BC5, true);
+            EXPECT_EQ(image->getPixelFormat(), static_cast<GLenum>(GL_COMPRESSED_RED_GREEN_RGTC2_EXT));
+            EXPECT_EQ(image->data()[0], 255);
+            EXPECT_EQ(image->data()[8], 0);
+        }
+    }
+}
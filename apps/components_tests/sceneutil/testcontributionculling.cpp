@@ -0,0 +1,37 @@
+#include <components/misc/constants.hpp>
+#include <components/sceneutil/contributionculling.hpp>
+
+#include <osg/Camera>
+
+#include <gtest/gtest.h>
+
+namespace
+{
+    using namespace testing;
+    using namespace SceneUtil;
+
+    TEST(SceneUtilContributionCullingTest, getCullingViewShouldRecognizeViewsByCameraName)
+    {
+        osg::ref_ptr<osg::Camera> camera = new osg::Camera;
+        camera->setName(Constants::SceneCamera);
+        EXPECT_EQ(getCullingView(*camera), CullingView::Main);
+        camera->setName(Constants::RefractionCamera);
+        EXPECT_EQ(getCullingView(*camera), CullingView::Reflection);
+        camera->setName(Constants::StaticShadowCamera);
+        EXPECT_EQ(getCullingView(*camera), CullingView::Shadow);
+        camera->setName("LocalMap");
+        EXPECT_EQ(getCullingView(*camera), CullingView::Other);
+    }
+
+    TEST(SceneUtilContributionCullingTest, isContributingShouldCompareSizeWithThreshold)
+    {
+        EXPECT_TRUE(isContributing(4, 4, 1.5f, false));
+        EXPECT_FALSE(isContributing(3.9f, 4, 1.5f, false));
+    }
+
+    TEST(SceneUtilContributionCullingTest, isContributingShouldRequireCulledNodeToGrowPastHysteresis)
+    {
+        EXPECT_FALSE(isContributing(5, 4, 1.5f, true));
+        EXPECT_TRUE(isContributing(6, 4, 1.5f, true));
+    }
+}
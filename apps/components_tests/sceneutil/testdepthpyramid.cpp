@@ -0,0 +1,98 @@
+#include <components/sceneutil/depthpyramid.hpp>
+
+#include <gtest/gtest.h>
+
+#include <vector>
+
+namespace
+{
+    using namespace testing;
+    using namespace SceneUtil;
+
+    constexpr std::size_t width = 64;
+    constexpr std::size_t height = 32;
+
+    struct SceneUtilDepthPyramidTest : Test
+    {
+        // Looks along +y from the origin
+        const osg::Matrixd mViewProjection = osg::Matrixd::lookAt(osg::Vec3d(0, 0, 0), osg::Vec3d(0, 1, 0),
+                                                 osg::Vec3d(0, 0, 1))
+            * osg::Matrixd::perspective(60, static_cast<double>(width) / height, 1, 10000);
+
+        static osg::BoundingBox makeBox(const osg::Vec3f& center, float halfSize)
+        {
+            const osg::Vec3f extent(halfSize, halfSize, halfSize);
+            return osg::BoundingBox(center - extent, center + extent);
+        }
+    };
+
+    TEST_F(SceneUtilDepthPyramidTest, shouldReduceToSingleTexel)
+    {
+        const DepthPyramid pyramid(std::vector<float>(width * height, 100), width, height, mViewProjection);
+        EXPECT_EQ(pyramid.getNumLevels(), 7);
+    }
+
+    TEST_F(SceneUtilDepthPyramidTest, boxBehindDepthShouldBeOccluded)
+    {
+        const DepthPyramid pyramid(std::vector<float>(width * height, 100), width, height, mViewProjection);
+        EXPECT_TRUE(pyramid.isOccluded(makeBox(osg::Vec3f(0, 500, 0), 10)));
+    }
+
+    TEST_F(SceneUtilDepthPyramidTest, boxInFrontOfDepthShouldNotBeOccluded)
+    {
+        const DepthPyramid pyramid(std::vector<float>(width * height, 100), width, height, mViewProjection);
+        EXPECT_FALSE(pyramid.isOccluded(makeBox(osg::Vec3f(0, 50, 0), 10)));
+    }
+
+    TEST_F(SceneUtilDepthPyramidTest, boxOnDepthShouldNotBeOccluded)
+    {
+        const DepthPyramid pyramid(std::vector<float>(width * height, 100), width, height, mViewProjection);
+        EXPECT_FALSE(pyramid.isOccluded(makeBox(osg::Vec3f(0, 110, 0), 10)));
+    }
+
+    TEST_F(SceneUtilDepthPyramidTest, boxSeenThroughHoleShouldNotBeOccluded)
+    {
+        std::vector<float> depth(width * height, 100);
+        depth[(height / 2) * width + width / 2] = 10000;
+        const DepthPyramid pyramid(std::move(depth), width, height, mViewProjection);
+        EXPECT_FALSE(pyramid.isOccluded(makeBox(osg::Vec3f(0, 500, 0), 10)));
+    }
+
+    TEST_F(SceneUtilDepthPyramidTest, boxReachingOutOfViewShouldNotBeOccluded)
+    {
+        const DepthPyramid pyramid(std::vector<float>(width * height, 100), width, height, mViewProjection);
+        EXPECT_FALSE(pyramid.isOccluded(makeBox(osg::Vec3f(500, 500, 0), 100)));
+    }
+
+    TEST_F(SceneUtilDepthPyramidTest, boxBehindCameraShouldNotBeOccluded)
+    {
+        const DepthPyramid pyramid(std::vector<float>(width * height, 100), width, height, mViewProjection);
+        EXPECT_FALSE(pyramid.isOccluded(makeBox(osg::Vec3f(0, -500, 0), 10)));
+    }
+
+    TEST(SceneUtilLinearizeDepthTest, shouldReturnDistanceFromCameraPlane)
+    {
+        const float near = 1;
+        const float far = 1000;
+        const float distance = 100;
+        const float depth = far * (distance - near) / (distance * (far - near));
+        const float reversedDepth = near * (far - distance) / (distance * (far - near));
+        EXPECT_NEAR(linearizeDepth(depth, near, far, false), distance, 1e-2f);
+        EXPECT_NEAR(linearizeDepth(reversedDepth, near, far, true), distance, 1e-2f);
+        EXPECT_FLOAT_EQ(linearizeDepth(0, near, far, false), near);
+        EXPECT_FLOAT_EQ(linearizeDepth(1, near, far, false), far);
+        EXPECT_FLOAT_EQ(linearizeDepth(1, near, far, true), near);
+        EXPECT_FLOAT_EQ(linearizeDepth(0, near, far, true), far);
+    }
+
+    TEST(SceneUtilDownsampleDepthTest, shouldKeepFarthestDepthOfBlocks)
+    {
+        const std::vector<float> depth{
+            0.1f, 0.2f, 0.3f, //
+            0.4f, 0.5f, 0.6f, //
+            0.7f, 0.8f, 0.9f, //
+        };
+        EXPECT_EQ(downsampleDepth(depth, 3, 3, 2, false), std::vector<float>({ 0.5f, 0.6f, 0.8f, 0.9f }));
+        EXPECT_EQ(downsampleDepth(depth, 3, 3, 2, true), std::vector<float>({ 0.1f, 0.3f, 0.7f, 0.9f }));
+    }
+}
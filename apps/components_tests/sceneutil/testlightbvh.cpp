@@ -0,0 +1,66 @@
+#include <components/sceneutil/lightbvh.hpp>
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <random>
+#include <vector>
+
+namespace
+{
+    using namespace testing;
+    using namespace SceneUtil;
+
+    std::vector<std::size_t> intersect(const LightBvh& bvh, const osg::BoundingSphere& sphere)
+    {
+        std::vector<std::size_t> result;
+        bvh.intersect(sphere, [&](std::size_t index) { result.push_back(index); });
+        std::sort(result.begin(), result.end());
+        return result;
+    }
+
+    TEST(SceneUtilLightBvhTest, emptyShouldNotIntersectAnything)
+    {
+        LightBvh bvh;
+        bvh.build({});
+        EXPECT_TRUE(intersect(bvh, osg::BoundingSphere(osg::Vec3f(), 1000)).empty());
+    }
+
+    TEST(SceneUtilLightBvhTest, shouldReportIndicesOfIntersectingBounds)
+    {
+        const std::vector<osg::BoundingSphere> bounds{
+            osg::BoundingSphere(osg::Vec3f(0, 0, 0), 10),
+            osg::BoundingSphere(osg::Vec3f(100, 0, 0), 10),
+            osg::BoundingSphere(osg::Vec3f(25, 0, 0), 10),
+        };
+        LightBvh bvh;
+        bvh.build(bounds);
+        EXPECT_EQ(intersect(bvh, osg::BoundingSphere(osg::Vec3f(12, 0, 0), 5)), std::vector<std::size_t>({ 0, 2 }));
+        EXPECT_EQ(intersect(bvh, osg::BoundingSphere(osg::Vec3f(60, 0, 0), 5)), std::vector<std::size_t>());
+    }
+
+    TEST(SceneUtilLightBvhTest, shouldFindSameBoundsAsTestingEveryBound)
+    {
+        std::mt19937 random(42);
+        std::uniform_real_distribution<float> position(-4096, 4096);
+        std::uniform_real_distribution<float> radius(16, 512);
+        std::vector<osg::BoundingSphere> bounds;
+        for (int i = 0; i < 500; ++i)
+            bounds.emplace_back(osg::Vec3f(position(random), position(random), position(random)), radius(random));
+
+        LightBvh bvh;
+        bvh.build(bounds);
+        EXPECT_EQ(bvh.size(), bounds.size());
+
+        for (int i = 0; i < 100; ++i)
+        {
+            const osg::BoundingSphere sphere(
+                osg::Vec3f(position(random), position(random), position(random)), radius(random));
+            std::vector<std::size_t> expected;
+            for (std::size_t j = 0; j < bounds.size(); ++j)
+                if (bounds[j].intersects(sphere))
+                    expected.push_back(j);
+            EXPECT_EQ(intersect(bvh, sphere), expected);
+        }
+    }
+}
@@ -0,0 +1,78 @@
+#include <components/sceneutil/lightclustering.hpp>
+
+#include <gtest/gtest.h>
+
+#include <array>
+
+namespace
+{
+    using namespace testing;
+    using namespace SceneUtil;
+
+    struct SceneUtilLightClusteringTest : Test
+    {
+        const LightClustering::Settings mSettings{
+            .clustersX = 4,
+            .clustersY = 4,
+            .clustersZ = 8,
+            .maxLightsPerCluster = 2,
+            .clusterNear = 1,
+            .clusterFar = 8192,
+        };
+        const osg::Matrixf mProjection = osg::Matrixf::perspective(60, 16.0 / 9.0, 1, 10000);
+        LightClustering mClustering{ mSettings };
+
+        // View space position projected to the given NDC at the given distance from the camera
+        osg::Vec3f getViewPosition(float ndcX, float ndcY, float depth) const
+        {
+            return osg::Vec3f(depth * ndcX / mProjection(0, 0), depth * ndcY / mProjection(1, 1), -depth);
+        }
+
+        SceneUtilLightClusteringTest() { mClustering.updateClusters(mProjection); }
+    };
+
+    TEST_F(SceneUtilLightClusteringTest, depthToClusterZShouldBeClampedToSlices)
+    {
+        EXPECT_EQ(mClustering.depthToClusterZ(0), 0);
+        EXPECT_EQ(mClustering.depthToClusterZ(100000), mSettings.clustersZ - 1);
+        EXPECT_LT(mClustering.depthToClusterZ(10), mClustering.depthToClusterZ(1000));
+    }
+
+    TEST_F(SceneUtilLightClusteringTest, assignLightsShouldAddLightToClusterContainingIt)
+    {
+        mClustering.assignLights({ { getViewPosition(0.25f, 0.25f, 100), 1 } });
+        const int z = mClustering.depthToClusterZ(100);
+        const std::vector<int>& lights = mClustering.getClusterLights(mClustering.getClusterIndex(2, 2, z));
+        ASSERT_EQ(lights.size(), 1u);
+        EXPECT_EQ(lights[0], 0);
+        EXPECT_TRUE(mClustering.getClusterLights(mClustering.getClusterIndex(0, 0, z)).empty());
+    }
+
+    TEST_F(SceneUtilLightClusteringTest, assignLightsShouldIgnoreLightsBehindCamera)
+    {
+        mClustering.assignLights({ { osg::Vec3f(0, 0, 100), 10 } });
+        for (int i = 0; i < mClustering.getTotalClusters(); ++i)
+            EXPECT_TRUE(mClustering.getClusterLights(i).empty()) << i;
+    }
+
+    TEST_F(SceneUtilLightClusteringTest, writeGridShouldStoreCountAndMappedIndices)
+    {
+        mClustering.assignLights({ { getViewPosition(-0.75f, -0.75f, 100), 1 } });
+        int width = 0;
+        int height = 0;
+        mClustering.getGridSize(width, height);
+        ASSERT_EQ(width, mSettings.clustersX * (mSettings.maxLightsPerCluster + 1));
+        ASSERT_EQ(height, mSettings.clustersY * mSettings.clustersZ);
+
+        osg::ref_ptr<osg::Image> image = new osg::Image;
+        image->allocateImage(width, height, 1, GL_RED, GL_FLOAT);
+        const std::array lightIndices = { 7 };
+        mClustering.writeGrid(*image, lightIndices);
+
+        const int z = mClustering.depthToClusterZ(100);
+        const float* cell = reinterpret_cast<const float*>(image->data(0, z * mSettings.clustersY));
+        EXPECT_EQ(cell[0], 1);
+        EXPECT_EQ(cell[1], 7);
+        EXPECT_EQ(cell[mSettings.maxLightsPerCluster + 1], 0);
+    }
+}
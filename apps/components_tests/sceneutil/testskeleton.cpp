@@ -0,0 +1,66 @@
+#include <components/sceneutil/skeleton.hpp>
+
+#include <osg/MatrixTransform>
+
+#include <gtest/gtest.h>
+
+namespace
+{
+    using namespace testing;
+    using namespace SceneUtil;
+
+    struct SceneUtilSkeletonTest : Test
+    {
+        osg::ref_ptr<Skeleton> mSkeleton = new Skeleton;
+        osg::ref_ptr<osg::MatrixTransform> mRoot = new osg::MatrixTransform(osg::Matrix::translate(1, 0, 0));
+        osg::ref_ptr<osg::MatrixTransform> mLeft = new osg::MatrixTransform(osg::Matrix::translate(0, 2, 0));
+        osg::ref_ptr<osg::MatrixTransform> mRight = new osg::MatrixTransform(osg::Matrix::translate(0, 0, 3));
+
+        SceneUtilSkeletonTest()
+        {
+            mRoot->setName("Root");
+            mLeft->setName("Left");
+            mRight->setName("Right");
+            mRoot->addChild(mLeft);
+            mRoot->addChild(mRight);
+            mSkeleton->addChild(mRoot);
+        }
+    };
+
+    TEST_F(SceneUtilSkeletonTest, getBoneShouldLinkParent)
+    {
+        Bone* const left = mSkeleton->getBone("left");
+        ASSERT_NE(left, nullptr);
+        ASSERT_NE(left->mParent, nullptr);
+        EXPECT_EQ(left->mParent->mNode, mRoot.get());
+        EXPECT_EQ(left->mParent->mParent, nullptr);
+    }
+
+    TEST_F(SceneUtilSkeletonTest, updateBoneMatricesShouldUpdateOnlyGivenBonesAndTheirParents)
+    {
+        Bone* const left = mSkeleton->getBone("left");
+        Bone* const right = mSkeleton->getBone("right");
+        ASSERT_NE(left, nullptr);
+        ASSERT_NE(right, nullptr);
+
+        mSkeleton->updateBoneMatrices(1, { left });
+
+        EXPECT_EQ(left->mMatrixInSkeletonSpace, osg::Matrixf::translate(1, 2, 0));
+        EXPECT_EQ(left->mParent->mMatrixInSkeletonSpace, osg::Matrixf::translate(1, 0, 0));
+        EXPECT_EQ(right->mMatrixInSkeletonSpace, osg::Matrixf());
+    }
+
+    TEST_F(SceneUtilSkeletonTest, updateBoneMatricesShouldUpdateBonesOncePerFrame)
+    {
+        Bone* const left = mSkeleton->getBone("left");
+        ASSERT_NE(left, nullptr);
+
+        mSkeleton->updateBoneMatrices(1, { left });
+        mLeft->setMatrix(osg::Matrix::translate(0, 4, 0));
+        mSkeleton->updateBoneMatrices(1, { left });
+        EXPECT_EQ(left->mMatrixInSkeletonSpace, osg::Matrixf::translate(1, 2, 0));
+
+        mSkeleton->updateBoneMatrices(2, { left });
+        EXPECT_EQ(left->mMatrixInSkeletonSpace, osg::Matrixf::translate(1, 4, 0));
+    }
+}
@@ -0,0 +1,62 @@
+#include <components/sceneutil/textkeymap.hpp>
+
+#include <gtest/gtest.h>
+
+namespace
+{
+    using namespace testing;
+    using namespace SceneUtil;
+
+    struct SceneUtilTextKeyMapTest : Test
+    {
+        TextKeyMap mTextKeys;
+
+        SceneUtilTextKeyMapTest()
+        {
+            mTextKeys.emplace(0.5f, "idle: start");
+            mTextKeys.emplace(1.5f, "idle: stop");
+            mTextKeys.emplace(2.f, "weapononehand: chop start");
+            mTextKeys.emplace(2.25f, "weapononehand: chop min attack");
+            mTextKeys.emplace(2.5f, "weapononehand: chop max attack");
+            mTextKeys.emplace(3.f, "weapononehand: chop min hit");
+            mTextKeys.emplace(3.f, "weapononehand: chop hit");
+            mTextKeys.emplace(4.f, "idle: loop start");
+        }
+    };
+
+    TEST_F(SceneUtilTextKeyMapTest, findTimeShouldReturnTimeOfFullKey)
+    {
+        EXPECT_EQ(mTextKeys.findTime("weapononehand: chop min attack"), 2.25f);
+        EXPECT_EQ(mTextKeys.findTime("idle: loop start"), 4.f);
+    }
+
+    TEST_F(SceneUtilTextKeyMapTest, findTimeShouldReturnEarliestTimeOfKeysWithPrefix)
+    {
+        EXPECT_EQ(mTextKeys.findTime("weapononehand: chop"), 2.f);
+        EXPECT_EQ(mTextKeys.findTime("idle"), 0.5f);
+        EXPECT_EQ(mTextKeys.findTime(""), 0.5f);
+    }
+
+    TEST_F(SceneUtilTextKeyMapTest, findTimeShouldReturnNegativeForMissingKey)
+    {
+        EXPECT_EQ(mTextKeys.findTime("idle: loop stop"), -1.f);
+        EXPECT_EQ(mTextKeys.findTime("weapontwohand"), -1.f);
+    }
+
+    TEST_F(SceneUtilTextKeyMapTest, findTimeShouldMatchLinearSearchByTime)
+    {
+        for (std::string_view prefix : { "idle: ", "weapononehand: chop m", "weapononehand: chop hit", "x" })
+        {
+            float expected = -1;
+            for (const auto& [time, key] : mTextKeys)
+            {
+                if (key.starts_with(prefix))
+                {
+                    expected = time;
+                    break;
+                }
+            }
+            EXPECT_EQ(mTextKeys.findTime(prefix), expected) << prefix;
+        }
+    }
+}
@@ -0,0 +1,92 @@
+#include <components/sceneutil/workqueue.hpp>
+
+#include <gtest/gtest.h>
+
+namespace
+{
+    using namespace testing;
+    using namespace SceneUtil;
+
+    osg::ref_ptr<WorkItem> makeItem(WorkPriority priority)
+    {
+        osg::ref_ptr<WorkItem> item(new WorkItem);
+        item->setPriority(priority);
+        return item;
+    }
+
+    TEST(SceneUtilWorkQueueTest, removeWorkItemShouldReturnItemsInOrderOfAddition)
+    {
+        osg::ref_ptr<WorkQueue> queue(new WorkQueue(0));
+        const osg::ref_ptr<WorkItem> first = makeItem(WorkPriority::Normal);
+        const osg::ref_ptr<WorkItem> second = makeItem(WorkPriority::Normal);
+        queue->addWorkItem(first);
+        queue->addWorkItem(second);
+        EXPECT_EQ(queue->removeWorkItem(), first);
+        EXPECT_EQ(queue->removeWorkItem(), second);
+    }
+
+    TEST(SceneUtilWorkQueueTest, addWorkItemToFrontShouldPutItemBeforeOthersWithSamePriority)
+    {
+        osg::ref_ptr<WorkQueue> queue(new WorkQueue(0));
+        const osg::ref_ptr<WorkItem> first = makeItem(WorkPriority::Normal);
+        const osg::ref_ptr<WorkItem> second = makeItem(WorkPriority::Normal);
+        queue->addWorkItem(first);
+        queue->addWorkItem(second, true);
+        EXPECT_EQ(queue->removeWorkItem(), second);
+        EXPECT_EQ(queue->removeWorkItem(), first);
+    }
+
+    TEST(SceneUtilWorkQueueTest, removeWorkItemShouldReturnHigherPriorityItemsFirst)
+    {
+        osg::ref_ptr<WorkQueue> queue(new WorkQueue(0));
+        const osg::ref_ptr<WorkItem> low = makeItem(WorkPriority::Low);
+        const osg::ref_ptr<WorkItem> normal = makeItem(WorkPriority::Normal);
+        const osg::ref_ptr<WorkItem> high = makeItem(WorkPriority::High);
+        queue->addWorkItem(low);
+        queue->addWorkItem(normal);
+        queue->addWorkItem(high);
+        EXPECT_EQ(queue->removeWorkItem(), high);
+        EXPECT_EQ(queue->removeWorkItem(), normal);
+        EXPECT_EQ(queue->removeWorkItem(), low);
+    }
+
+    TEST(SceneUtilWorkQueueTest, removeWorkItemShouldReturnOverdueItemsFirst)
+    {
+        osg::ref_ptr<WorkQueue> queue(new WorkQueue(0));
+        const osg::ref_ptr<WorkItem> high = makeItem(WorkPriority::High);
+        const osg::ref_ptr<WorkItem> overdue = makeItem(WorkPriority::Low);
+        overdue->setDeadline(WorkItem::Clock::now() - std::chrono::seconds(1));
+        queue->addWorkItem(high);
+        queue->addWorkItem(overdue);
+        EXPECT_EQ(queue->removeWorkItem(), overdue);
+        EXPECT_EQ(queue->removeWorkItem(), high);
+    }
+
+    TEST(SceneUtilWorkQueueTest, removeWorkItemShouldReturnItemsCloserToViewPointFirst)
+    {
+        osg::ref_ptr<WorkQueue> queue(new WorkQueue(0));
+        const osg::ref_ptr<WorkItem> far = makeItem(WorkPriority::Normal);
+        far->setPosition(osg::Vec3f(1000, 0, 0));
+        const osg::ref_ptr<WorkItem> near = makeItem(WorkPriority::Normal);
+        near->setPosition(osg::Vec3f(10, 0, 0));
+        queue->addWorkItem(far);
+        queue->addWorkItem(near);
+        queue->setViewPoint(osg::Vec3f(0, 0, 0));
+        EXPECT_EQ(queue->removeWorkItem(), near);
+        queue->setViewPoint(osg::Vec3f(2000, 0, 0));
+        queue->addWorkItem(near);
+        EXPECT_EQ(queue->removeWorkItem(), far);
+    }
+
+    TEST(SceneUtilWorkQueueTest, getStatsShouldReturnDepthPerPriority)
+    {
+        osg::ref_ptr<WorkQueue> queue(new WorkQueue(0));
+        queue->addWorkItem(makeItem(WorkPriority::High));
+        queue->addWorkItem(makeItem(WorkPriority::Low));
+        queue->addWorkItem(makeItem(WorkPriority::Low));
+        const WorkQueueStats stats = queue->getStats();
+        EXPECT_EQ(stats.mPriorities[static_cast<std::size_t>(WorkPriority::High)].mDepth, 1);
+        EXPECT_EQ(stats.mPriorities[static_cast<std::size_t>(WorkPriority::Normal)].mDepth, 0);
+        EXPECT_EQ(stats.mPriorities[static_cast<std::size_t>(WorkPriority::Low)].mDepth, 2);
+    }
+}
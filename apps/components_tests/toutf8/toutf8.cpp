@@ -80,6 +80,43 @@ namespace
         EXPECT_EQ(result, "a\xE2\x80\x99");
     }
 
+    TEST(Utf8EncoderTest, getUtf8ShouldConvertNonAsciiAtAnyPosition)
+    {
+        Utf8Encoder encoder(FromType::WINDOWS_1252);
+        for (std::size_t size = 1; size <= 64; ++size)
+        {
+            for (std::size_t position = 0; position < size; ++position)
+            {
+                std::string input(size, 'a');
+                input[position] = '\x92';
+                std::string expected(size - 1, 'a');
+                expected.insert(position, "\xE2\x80\x99");
+                EXPECT_EQ(encoder.getUtf8(input), expected) << "size=" << size << " position=" << position;
+            }
+        }
+    }
+
+    TEST(Utf8EncoderTest, getUtf8ShouldLookUpUntilZeroAtAnyPosition)
+    {
+        Utf8Encoder encoder(FromType::WINDOWS_1252);
+        for (std::size_t size = 1; size <= 64; ++size)
+        {
+            for (std::size_t position = 0; position < size; ++position)
+            {
+                std::string input(size, 'a');
+                input[position] = '\0';
+                EXPECT_EQ(encoder.getUtf8(input), std::string(position, 'a'))
+                    << "size=" << size << " position=" << position;
+                input.back() = '\x92';
+                if (position + 1 < size)
+                {
+                    EXPECT_EQ(encoder.getUtf8(input), std::string(position, 'a'))
+                        << "size=" << size << " position=" << position;
+                }
+            }
+        }
+    }
+
     TEST_P(Utf8EncoderTest, getUtf8ShouldConvertFromLegacyEncodingToUtf8)
     {
         const std::string input(readContent(GetParam().mLegacyEncodingFileName));
@@ -0,0 +1,76 @@
+#include <components/testing/util.hpp>
+#include <components/vfs/manager.hpp>
+#include <components/vfs/recursivedirectoryiterator.hpp>
+
+#include <gtest/gtest.h>
+
+#include <iterator>
+#include <string>
+#include <vector>
+
+namespace VFS
+{
+    namespace
+    {
+        using namespace testing;
+
+        std::string read(const Manager& manager, Path::NormalizedView path)
+        {
+            Files::IStreamPtr stream = manager.get(path);
+            return std::string(std::istreambuf_iterator<char>(*stream), {});
+        }
+
+        struct VFSManagerTest : Test
+        {
+            TestingOpenMW::VFSTestFile mFirst{ "first" };
+            TestingOpenMW::VFSTestFile mSecond{ "second" };
+            Manager mManager;
+
+            VFSManagerTest()
+            {
+                mManager.addArchive(std::make_unique<TestingOpenMW::VFSTestData>(FileMap{
+                    { Path::Normalized("textures/a.dds"), &mFirst },
+                    { Path::Normalized("textures/b.dds"), &mFirst },
+                }));
+                mManager.addArchive(std::make_unique<TestingOpenMW::VFSTestData>(FileMap{
+                    { Path::Normalized("meshes/c.nif"), &mSecond },
+                    { Path::Normalized("textures/b.dds"), &mSecond },
+                }));
+                mManager.buildIndex();
+            }
+        };
+
+        TEST_F(VFSManagerTest, existsShouldFindFilesOfAllArchives)
+        {
+            EXPECT_TRUE(mManager.exists(Path::NormalizedView("textures/a.dds")));
+            EXPECT_TRUE(mManager.exists(Path::NormalizedView("meshes/c.nif")));
+            EXPECT_FALSE(mManager.exists(Path::NormalizedView("textures/a_n.dds")));
+        }
+
+        TEST_F(VFSManagerTest, lastAddedArchiveShouldHavePriority)
+        {
+            EXPECT_EQ(read(mManager, Path::NormalizedView("textures/a.dds")), "first");
+            EXPECT_EQ(read(mManager, Path::NormalizedView("textures/b.dds")), "second");
+        }
+
+        TEST_F(VFSManagerTest, findShouldReturnNullptrForMissingFile)
+        {
+            EXPECT_EQ(mManager.find(Path::NormalizedView("textures/c.dds")), nullptr);
+        }
+
+        TEST_F(VFSManagerTest, recursiveDirectoryIteratorShouldListFilesWithPrefix)
+        {
+            std::vector<std::string> files;
+            const Path::NormalizedView path("textures");
+            for (const Path::Normalized& file : mManager.getRecursiveDirectoryIterator(path))
+                files.emplace_back(file.value());
+            EXPECT_EQ(files, (std::vector<std::string>{ "textures/a.dds", "textures/b.dds" }));
+        }
+
+        TEST_F(VFSManagerTest, resetShouldRemoveAllFiles)
+        {
+            mManager.reset();
+            EXPECT_FALSE(mManager.exists(Path::NormalizedView("textures/a.dds")));
+        }
+    }
+}
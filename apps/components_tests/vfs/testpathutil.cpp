@@ -10,6 +10,21 @@ namespace VFS::Path
     {
         using namespace testing;
 
+        TEST(NormalizeFilenameTest, shouldNormalizeFilenamesOfAnyLength)
+        {
+            const std::string value = "Meshes\\Some\\Long/Path\\To\\A\\File.NIF";
+            const std::string expected = "meshes/some/long/path/to/a/file.nif";
+            for (std::size_t size = 0; size <= value.size(); ++size)
+                EXPECT_EQ(normalizeFilename(std::string_view(value).substr(0, size)), expected.substr(0, size)) << size;
+        }
+
+        TEST(NormalizeFilenameTest, shouldNormalizeRange)
+        {
+            std::string value = "Meshes\\Some\\Long/Path";
+            normalizeFilenameInPlace(value.begin() + 7, value.end());
+            EXPECT_EQ(value, "Meshes\\some/long/path");
+        }
+
         TEST(NormalizedTest, shouldSupportDefaultConstructor)
         {
             const Normalized value;
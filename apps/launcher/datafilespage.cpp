@@ -29,6 +29,7 @@
 
 #include <components/bsa/compressedbsafile.hpp>
 #include <components/debug/debuglog.hpp>
+#include <components/esmloader/headercache.hpp>
 #include <components/files/qtconversion.hpp>
 #include <components/misc/strings/conversion.hpp>
 #include <components/navmeshtool/protocol.hpp>
@@ -167,6 +168,9 @@ Launcher::DataFilesPage::DataFilesPage(const Files::ConfigurationManager& cfg, C
     mSelector = new ContentSelectorView::ContentSelector(ui.contentSelectorWidget, /*showOMWScripts=*/true);
     const QString encoding = mGameSettings.value("encoding", { "win1252" }).value;
     mSelector->setEncoding(encoding);
+    // The engine validates the content list with the same cache
+    mHeaderCache = std::make_shared<EsmLoader::HeaderCache>(mCfgMgr.getUserDataPath() / "pluginheaders");
+    mSelector->setHeaderCache(mHeaderCache);
 
     QVector<std::pair<QString, QString>> languages = { { "English", tr("English") }, { "French", tr("French") },
         { "German", tr("German") }, { "Italian", tr("Italian") }, { "Polish", tr("Polish") },
@@ -460,6 +464,7 @@ void Launcher::DataFilesPage::populateFileViews(const QString& contentModelName)
     }
     progressBar.setValue(progressBar.maximum());
     mSelector->sortFiles();
+    mHeaderCache->write();
 
     QList<Config::SettingValue> selectedArchives = mGameSettings.getArchiveList();
     QStringList contentModelSelectedArchives = mLauncherSettings.getArchiveList(contentModelName);
@@ -12,6 +12,7 @@
 #include <QWidget>
 
 #include <condition_variable>
+#include <memory>
 #include <mutex>
 #include <thread>
 
@@ -28,6 +29,10 @@ namespace ContentSelectorView
 {
     class ContentSelector;
 }
+namespace EsmLoader
+{
+    class HeaderCache;
+}
 namespace Config
 {
     class GameSettings;
@@ -46,6 +51,7 @@ namespace Launcher
         Q_OBJECT
 
         ContentSelectorView::ContentSelector* mSelector;
+        std::shared_ptr<EsmLoader::HeaderCache> mHeaderCache;
         Ui::DataFilesPage ui;
         QDialog* mDirectoryPickerDialog;
         Ui::SelectSubdirs mDirectoryPicker;
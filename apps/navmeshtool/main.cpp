@@ -18,6 +18,7 @@
 #include <components/files/configurationmanager.hpp>
 #include <components/files/conversion.hpp>
 #include <components/files/multidircollection.hpp>
+#include <components/misc/strings/conversion.hpp>
 #include <components/platform/platform.hpp>
 #include <components/resource/bgsmfilemanager.hpp>
 #include <components/resource/bulletshapemanager.hpp>
@@ -25,6 +26,7 @@
 #include <components/resource/niffilemanager.hpp>
 #include <components/resource/scenemanager.hpp>
 #include <components/settings/values.hpp>
+#include <components/sqlite3/db.hpp>
 #include <components/toutf8/toutf8.hpp>
 #include <components/version/version.hpp>
 #include <components/vfs/manager.hpp>
@@ -34,12 +36,17 @@
 
 #include <boost/program_options.hpp>
 
+#include <algorithm>
+#include <chrono>
 #include <cstddef>
 #include <cstdint>
 #include <filesystem>
 #include <iostream>
 #include <map>
+#include <optional>
+#include <stdexcept>
 #include <string>
+#include <string_view>
 #include <thread>
 #include <type_traits>
 #include <utility>
@@ -119,11 +126,65 @@ namespace NavMeshTool
             addOption("write-binary-log", bpo::value<bool>()->implicit_value(true)->default_value(false),
                 "write progress in binary messages to be consumed by the launcher");
 
+            addOption("agent-bounds",
+                bpo::value<StringsVector>()->default_value(StringsVector(), "")->multitoken()->composing(),
+                "additional agent bounds to build navmesh for in format <shape>:<x>,<y>,<z> where shape is aabb, "
+                "rotating-box or cylinder and x, y, z are half extents");
+
+            addOption("creature-agent-bounds", bpo::value<bool>()->implicit_value(true)->default_value(false),
+                "build navmesh for bounds of each distinct creature placed in interior cells");
+
+            addOption("navmeshdb", bpo::value<Files::MaybeQuotedPath>()->default_value(Files::MaybeQuotedPath(), ""),
+                "path to navmeshdb, navmesh.db in user data directory by default");
+
+            addOption("shard-index", bpo::value<std::size_t>()->default_value(0),
+                "build navmesh only for tiles of the given shard, each process should use own navmeshdb");
+
+            addOption("shard-count", bpo::value<std::size_t>()->default_value(1),
+                "number of shards to split tiles into for parallel processing by multiple processes");
+
+            addOption("merge-navmeshdb",
+                bpo::value<Files::MaybeQuotedPathContainer>()
+                    ->default_value(Files::MaybeQuotedPathContainer(), "")
+                    ->multitoken()
+                    ->composing(),
+                "merge tiles from given navmeshdb files produced by shards into navmeshdb and quit");
+
             Files::ConfigurationManager::addCommonOptions(result);
 
             return result;
         }
 
+        DetourNavigator::CollisionShapeType parseCollisionShapeType(std::string_view value)
+        {
+            if (value == "aabb")
+                return DetourNavigator::CollisionShapeType::Aabb;
+            if (value == "rotating-box")
+                return DetourNavigator::CollisionShapeType::RotatingBox;
+            if (value == "cylinder")
+                return DetourNavigator::CollisionShapeType::Cylinder;
+            throw std::runtime_error("Invalid agent bounds shape: \"" + std::string(value) + "\"");
+        }
+
+        DetourNavigator::AgentBounds parseAgentBounds(std::string_view value)
+        {
+            const std::size_t separator = value.find(':');
+            if (separator == std::string_view::npos)
+                throw std::runtime_error("Invalid agent bounds format: \"" + std::string(value) + "\"");
+            DetourNavigator::AgentBounds result{ parseCollisionShapeType(value.substr(0, separator)), osg::Vec3f() };
+            std::string_view halfExtents = value.substr(separator + 1);
+            for (int i = 0; i < 3; ++i)
+            {
+                const std::size_t end = i < 2 ? halfExtents.find(',') : halfExtents.size();
+                const std::optional<float> number = Misc::StringUtils::toNumeric<float>(halfExtents.substr(0, end));
+                if (end == std::string_view::npos || !number.has_value() || *number <= 0)
+                    throw std::runtime_error("Invalid agent bounds half extents: \"" + std::string(value) + "\"");
+                result.mHalfExtents[i] = *number;
+                halfExtents.remove_prefix(std::min(end + 1, halfExtents.size()));
+            }
+            return result;
+        }
+
         int runNavMeshTool(int argc, char* argv[])
         {
             Platform::init();
@@ -179,6 +240,24 @@ namespace NavMeshTool
             const bool processInteriorCells = variables["process-interior-cells"].as<bool>();
             const bool removeUnusedTiles = variables["remove-unused-tiles"].as<bool>();
             const bool writeBinaryLog = variables["write-binary-log"].as<bool>();
+            const bool creatureAgentBounds = variables["creature-agent-bounds"].as<bool>();
+            const Shard shard{
+                .mIndex = variables["shard-index"].as<std::size_t>(),
+                .mCount = variables["shard-count"].as<std::size_t>(),
+            };
+
+            if (shard.mCount < 1 || shard.mIndex >= shard.mCount)
+            {
+                std::cerr << "Invalid shard: " << shard.mIndex << "/" << shard.mCount
+                          << ", expected shard-count >= 1 and shard-index < shard-count";
+                return -1;
+            }
+
+            if (shard.mCount > 1 && removeUnusedTiles)
+            {
+                std::cerr << "Unused tiles can not be removed when processing a shard";
+                return -1;
+            }
 
 #ifdef WIN32
             if (writeBinaryLog)
@@ -193,22 +272,61 @@ namespace NavMeshTool
 
             Settings::Manager::load(config);
 
-            const DetourNavigator::AgentBounds agentBounds{
-                Settings::game().mActorCollisionShapeType,
-                Settings::game().mDefaultActorPathfindHalfExtents,
+            std::vector<DetourNavigator::AgentBounds> agentBounds{
+                DetourNavigator::AgentBounds{
+                    Settings::game().mActorCollisionShapeType,
+                    Settings::game().mDefaultActorPathfindHalfExtents,
+                },
             };
+            for (const std::string& value : variables["agent-bounds"].as<StringsVector>())
+                agentBounds.push_back(parseAgentBounds(value));
+            std::sort(agentBounds.begin(), agentBounds.end());
+            agentBounds.erase(std::unique(agentBounds.begin(), agentBounds.end()), agentBounds.end());
+
+            if (creatureAgentBounds && !processInteriorCells)
+                Log(Debug::Warning) << "Creature agent bounds are used only for interior cells that are not processed";
+
             const std::uint64_t maxDbFileSize = Settings::navigator().mMaxNavmeshdbFileSize;
-            const auto dbPath = Files::pathToUnicodeString(config.getUserDataPath() / "navmesh.db");
+            const std::filesystem::path& customDbPath = variables["navmeshdb"].as<Files::MaybeQuotedPath>();
+            const auto dbPath = Files::pathToUnicodeString(
+                customDbPath.empty() ? config.getUserDataPath() / "navmesh.db" : customDbPath);
 
             Log(Debug::Info) << "Using navmeshdb at " << dbPath;
 
             DetourNavigator::NavMeshDb db(dbPath, maxDbFileSize);
 
+            if (Settings::navigator().mNavmeshdbWriteAheadLog
+                && !db.enableWriteAheadLog(
+                    static_cast<Sqlite3::Synchronous>(Settings::navigator().mNavmeshdbSynchronous.get()),
+                    std::chrono::milliseconds(Settings::navigator().mNavmeshdbCheckpointIntervalMs)))
+                Log(Debug::Warning) << "Write-ahead log is not supported for navmeshdb at " << dbPath;
+
+            const auto& mergedDbs = variables["merge-navmeshdb"].as<Files::MaybeQuotedPathContainer>();
+            if (!mergedDbs.empty())
+            {
+                for (const std::filesystem::path& path : mergedDbs)
+                {
+                    if (!std::filesystem::exists(path))
+                    {
+                        std::cerr << "Navmeshdb to merge is not found: " << path;
+                        return -1;
+                    }
+                    Log(Debug::Info) << "Merging navmeshdb " << path << "...";
+                    const int tiles = db.mergeFrom(Files::pathToUnicodeString(path));
+                    Log(Debug::Info) << "Merged " << tiles << " tiles";
+                }
+                Log(Debug::Info) << "Vacuuming the database...";
+                db.vacuum();
+                Log(Debug::Info) << "Done";
+                return 0;
+            }
+
             ESM::ReadersCache readers;
             EsmLoader::Query query;
             query.mLoadActivators = true;
             query.mLoadCells = true;
             query.mLoadContainers = true;
+            query.mLoadCreatures = creatureAgentBounds && processInteriorCells;
             query.mLoadDoors = true;
             query.mLoadGameSettings = true;
             query.mLoadLands = true;
@@ -233,7 +351,7 @@ namespace NavMeshTool
                 navigatorSettings, readers, vfs, bulletShapeManager, esmData, processInteriorCells, writeBinaryLog);
 
             const Status status = generateAllNavMeshTiles(agentBounds, navigatorSettings, threadsNumber,
-                removeUnusedTiles, writeBinaryLog, cellsData, std::move(db));
+                removeUnusedTiles, writeBinaryLog, shard, cellsData, std::move(db));
 
             switch (status)
             {
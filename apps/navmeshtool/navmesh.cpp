@@ -21,11 +21,14 @@
 
 #include <osg/Vec3f>
 
+#include <algorithm>
 #include <atomic>
 #include <chrono>
 #include <cstddef>
 #include <random>
+#include <string>
 #include <string_view>
+#include <tuple>
 #include <utility>
 #include <vector>
 
@@ -38,6 +41,7 @@ namespace NavMeshTool
         using DetourNavigator::MeshSource;
         using DetourNavigator::NavMeshDb;
         using DetourNavigator::NavMeshTileInfo;
+        using DetourNavigator::ObjectTransform;
         using DetourNavigator::PreparedNavMeshData;
         using DetourNavigator::RecastMeshProvider;
         using DetourNavigator::Settings;
@@ -78,9 +82,11 @@ namespace NavMeshTool
         public:
             std::atomic_size_t mExpected{ 0 };
 
-            explicit NavMeshTileConsumer(NavMeshDb&& db, bool removeUnusedTiles, bool writeBinaryLog)
+            explicit NavMeshTileConsumer(
+                NavMeshDb&& db, bool removeUnusedTiles, bool removeOtherTilesAtPosition, bool writeBinaryLog)
                 : mDb(std::move(db))
                 , mRemoveUnusedTiles(removeUnusedTiles)
+                , mRemoveOtherTilesAtPosition(removeOtherTilesAtPosition)
                 , mWriteBinaryLog(writeBinaryLog)
                 , mTransaction(mDb.startTransaction(Sqlite3::TransactionMode::Immediate))
                 , mNextTileId(mDb.getMaxTileId() + 1)
@@ -106,6 +112,34 @@ namespace NavMeshTool
                 return DetourNavigator::resolveMeshSource(mDb, source, mNextShapeId);
             }
 
+            // Shape ids are a part of tile input so they are assigned in a deterministic order before generation
+            // to make processes starting from the same db produce compatible results.
+            void registerShapes(const std::vector<BulletObject>& objects)
+            {
+                std::vector<MeshSource> sources;
+                sources.reserve(objects.size());
+                for (const BulletObject& object : objects)
+                {
+                    const Resource::BulletShapeInstance& instance = *object.getShapeInstance();
+                    const ObjectTransform& transform = object.getObjectTransform();
+                    sources.push_back(MeshSource{ instance.getSource(), transform, DetourNavigator::AreaType_ground });
+                    if (instance.mAvoidCollisionShape != nullptr)
+                        sources.push_back(
+                            MeshSource{ instance.getSource(), transform, DetourNavigator::AreaType_null });
+                }
+                const auto key = [](const MeshSource& v) {
+                    return std::tie(v.mShape->mFileName.value(), v.mAreaType, v.mShape->mFileHash);
+                };
+                std::sort(
+                    sources.begin(), sources.end(), [&](const auto& l, const auto& r) { return key(l) < key(r); });
+                sources.erase(std::unique(sources.begin(), sources.end(),
+                                  [&](const auto& l, const auto& r) { return key(l) == key(r); }),
+                    sources.end());
+                const std::lock_guard lock(mMutex);
+                for (const MeshSource& source : sources)
+                    DetourNavigator::resolveMeshSource(mDb, source, mNextShapeId);
+            }
+
             std::optional<NavMeshTileInfo> find(
                 ESM::RefId worldspace, const TilePosition& tilePosition, const std::vector<std::byte>& input) override
             {
@@ -133,7 +167,7 @@ namespace NavMeshTool
 
             void identity(ESM::RefId worldspace, const TilePosition& tilePosition, std::int64_t tileId) override
             {
-                if (mRemoveUnusedTiles)
+                if (mRemoveOtherTilesAtPosition)
                 {
                     std::lock_guard lock(mMutex);
                     mDeleted += static_cast<std::size_t>(
@@ -147,7 +181,7 @@ namespace NavMeshTool
             {
                 {
                     std::lock_guard lock(mMutex);
-                    if (mRemoveUnusedTiles)
+                    if (mRemoveOtherTilesAtPosition)
                         mDeleted += static_cast<std::size_t>(mDb.deleteTilesAt(worldspace, tilePosition));
                     data.mUserId = static_cast<unsigned>(mNextTileId);
                     mDb.insertTile(
@@ -164,7 +198,7 @@ namespace NavMeshTool
                 data.mUserId = static_cast<unsigned>(tileId);
                 {
                     std::lock_guard lock(mMutex);
-                    if (mRemoveUnusedTiles)
+                    if (mRemoveOtherTilesAtPosition)
                         mDeleted += static_cast<std::size_t>(
                             mDb.deleteTilesAtExcept(worldspace, tilePosition, TileId{ tileId }));
                     mDb.updateTile(TileId{ tileId }, TileVersion{ version }, serialize(data));
@@ -235,6 +269,7 @@ namespace NavMeshTool
             mutable std::mutex mMutex;
             NavMeshDb mDb;
             const bool mRemoveUnusedTiles;
+            const bool mRemoveOtherTilesAtPosition;
             const bool mWriteBinaryLog;
             Transaction mTransaction;
             TileId mNextTileId;
@@ -254,31 +289,60 @@ namespace NavMeshTool
         };
     }
 
-    Status generateAllNavMeshTiles(const AgentBounds& agentBounds, const Settings& settings, std::size_t threadsNumber,
-        bool removeUnusedTiles, bool writeBinaryLog, WorldspaceData& data, NavMeshDb&& db)
+    Status generateAllNavMeshTiles(const std::vector<AgentBounds>& agentBounds, const Settings& settings,
+        std::size_t threadsNumber, bool removeUnusedTiles, bool writeBinaryLog, const Shard& shard,
+        WorldspaceData& data, NavMeshDb&& db)
     {
+        std::vector<std::vector<AgentBounds>> worldspaceAgentBounds;
+        worldspaceAgentBounds.reserve(data.mNavMeshInputs.size());
+        bool singleAgentBounds = true;
+
+        for (const std::unique_ptr<WorldspaceNavMeshInput>& input : data.mNavMeshInputs)
+        {
+            std::vector<AgentBounds>& bounds = worldspaceAgentBounds.emplace_back();
+            std::set_union(agentBounds.begin(), agentBounds.end(), input->mAgentBounds.begin(),
+                input->mAgentBounds.end(), std::back_inserter(bounds));
+            singleAgentBounds = singleAgentBounds && bounds.size() == 1;
+        }
+
+        // Tiles at the same position for different agent bounds are not distinguishable by the db queries
+        if (removeUnusedTiles && !singleAgentBounds)
+            Log(Debug::Info) << "Only tiles outside processed range or without geometry will be removed because "
+                                "multiple agent bounds are used";
+
+        if (shard.mCount > 1)
+            Log(Debug::Info) << "Processing shard " << shard.mIndex << "/" << shard.mCount;
+
         Log(Debug::Info) << "Generating navmesh tiles by " << threadsNumber << " parallel workers...";
 
         SceneUtil::WorkQueue workQueue(threadsNumber);
-        auto navMeshTileConsumer
-            = std::make_shared<NavMeshTileConsumer>(std::move(db), removeUnusedTiles, writeBinaryLog);
+        auto navMeshTileConsumer = std::make_shared<NavMeshTileConsumer>(
+            std::move(db), removeUnusedTiles, removeUnusedTiles && singleAgentBounds, writeBinaryLog);
+        navMeshTileConsumer->registerShapes(data.mObjects);
         std::size_t tiles = 0;
+        std::size_t tileIndex = 0;
         std::mt19937_64 random;
+        const auto start = std::chrono::steady_clock::now();
 
-        for (const std::unique_ptr<WorldspaceNavMeshInput>& input : data.mNavMeshInputs)
+        for (std::size_t i = 0; i < data.mNavMeshInputs.size(); ++i)
         {
-            const auto range = DetourNavigator::makeTilesPositionsRange(Misc::Convert::toOsgXY(input->mAabb.m_min),
-                Misc::Convert::toOsgXY(input->mAabb.m_max), settings.mRecast);
+            const WorldspaceNavMeshInput& input = *data.mNavMeshInputs[i];
+            const auto range = DetourNavigator::makeTilesPositionsRange(Misc::Convert::toOsgXY(input.mAabb.m_min),
+                Misc::Convert::toOsgXY(input.mAabb.m_max), settings.mRecast);
 
             if (removeUnusedTiles)
-                navMeshTileConsumer->removeTilesOutsideRange(input->mWorldspace, range);
+                navMeshTileConsumer->removeTilesOutsideRange(input.mWorldspace, range);
 
             std::vector<TilePosition> worldspaceTiles;
 
-            DetourNavigator::getTilesPositions(
-                range, [&](const TilePosition& tilePosition) { worldspaceTiles.push_back(tilePosition); });
+            DetourNavigator::getTilesPositions(range, [&](const TilePosition& tilePosition) {
+                if (tileIndex++ % shard.mCount == shard.mIndex)
+                    worldspaceTiles.push_back(tilePosition);
+            });
+
+            const std::vector<AgentBounds>& bounds = worldspaceAgentBounds[i];
 
-            tiles += worldspaceTiles.size();
+            tiles += worldspaceTiles.size() * bounds.size();
 
             if (writeBinaryLog)
                 serializeToStderr(ExpectedTiles{ static_cast<std::uint64_t>(tiles) });
@@ -288,21 +352,25 @@ namespace NavMeshTool
             std::shuffle(worldspaceTiles.begin(), worldspaceTiles.end(), random);
 
             for (const TilePosition& tilePosition : worldspaceTiles)
-                workQueue.addWorkItem(new GenerateNavMeshTile(input->mWorldspace, tilePosition,
-                    RecastMeshProvider(input->mTileCachedRecastMeshManager), agentBounds, settings,
-                    navMeshTileConsumer));
+                for (const AgentBounds& tileAgentBounds : bounds)
+                    workQueue.addWorkItem(new GenerateNavMeshTile(input.mWorldspace, tilePosition,
+                        RecastMeshProvider(input.mTileCachedRecastMeshManager), tileAgentBounds, settings,
+                        navMeshTileConsumer));
         }
 
         const Status status = navMeshTileConsumer->wait();
         if (status == Status::Ok)
             navMeshTileConsumer->commit();
 
+        const std::chrono::duration<double> duration = std::chrono::steady_clock::now() - start;
+        const auto provided = navMeshTileConsumer->getProvided();
         const auto inserted = navMeshTileConsumer->getInserted();
         const auto updated = navMeshTileConsumer->getUpdated();
         const auto deleted = navMeshTileConsumer->getDeleted();
 
-        Log(Debug::Info) << "Generated navmesh for " << navMeshTileConsumer->getProvided() << " tiles, " << inserted
-                         << " are inserted, " << updated << " updated and " << deleted << " deleted";
+        Log(Debug::Info) << "Generated navmesh for " << provided << " tiles in " << duration.count() << " seconds ("
+                         << static_cast<double>(provided) / std::max(duration.count(), 1e-3) << " tiles/s), "
+                         << inserted << " are inserted, " << updated << " updated and " << deleted << " deleted";
 
         if (inserted + updated + deleted > 0)
         {
@@ -2,6 +2,7 @@
 #define OPENMW_NAVMESHTOOL_NAVMESH_H
 
 #include <cstddef>
+#include <vector>
 
 namespace DetourNavigator
 {
@@ -21,9 +22,16 @@ namespace NavMeshTool
         NotEnoughSpace,
     };
 
-    Status generateAllNavMeshTiles(const DetourNavigator::AgentBounds& agentBounds,
+    // Part of all tiles to be generated by a process when generation is split over multiple processes
+    struct Shard
+    {
+        std::size_t mIndex = 0;
+        std::size_t mCount = 1;
+    };
+
+    Status generateAllNavMeshTiles(const std::vector<DetourNavigator::AgentBounds>& agentBounds,
         const DetourNavigator::Settings& settings, std::size_t threadsNumber, bool removeUnusedTiles,
-        bool writeBinaryLog, WorldspaceData& cellsData, DetourNavigator::NavMeshDb&& db);
+        bool writeBinaryLog, const Shard& shard, WorldspaceData& cellsData, DetourNavigator::NavMeshDb&& db);
 }
 
 #endif
@@ -13,6 +13,7 @@
 #include <components/esm3/cellref.hpp>
 #include <components/esm3/esmreader.hpp>
 #include <components/esm3/loadcell.hpp>
+#include <components/esm3/loadcrea.hpp>
 #include <components/esm3/loadland.hpp>
 #include <components/esm3/readerscache.hpp>
 #include <components/esmloader/esmdata.hpp>
@@ -24,6 +25,7 @@
 #include <components/navmeshtool/protocol.hpp>
 #include <components/resource/bulletshapemanager.hpp>
 #include <components/settings/settings.hpp>
+#include <components/settings/values.hpp>
 #include <components/vfs/manager.hpp>
 
 #include <LinearMath/btVector3.h>
@@ -32,7 +34,9 @@
 #include <osg/ref_ptr>
 
 #include <algorithm>
+#include <cmath>
 #include <memory>
+#include <optional>
 #include <sstream>
 #include <stdexcept>
 #include <string>
@@ -45,6 +49,7 @@ namespace NavMeshTool
 {
     namespace
     {
+        using DetourNavigator::AgentBounds;
         using DetourNavigator::CollisionShape;
         using DetourNavigator::HeightfieldPlane;
         using DetourNavigator::HeightfieldShape;
@@ -111,9 +116,69 @@ namespace NavMeshTool
             return result;
         }
 
-        template <class F>
+        // Follows MWPhysics::Actor to get the same bounds as World::getPathfindingAgentBounds for an interior cell
+        std::optional<AgentBounds> getCreatureAgentBounds(const CellRef& cellRef, const EsmLoader::EsmData& esmData,
+            const VFS::Manager& vfs, Resource::BulletShapeManager& bulletShapeManager)
+        {
+            const auto creature = std::lower_bound(
+                esmData.mCreatures.begin(), esmData.mCreatures.end(), cellRef.mRefId, EsmLoader::LessById{});
+            if (creature == esmData.mCreatures.end() || creature->mId != cellRef.mRefId || creature->mModel.empty())
+                return std::nullopt;
+
+            const VFS::Path::Normalized model(creature->mModel);
+            const VFS::Path::Normalized mesh = Misc::ResourceHelpers::correctMeshPath(model);
+            const VFS::Path::Normalized animationMesh = Misc::ResourceHelpers::correctActorModelPath(mesh, &vfs);
+
+            osg::ref_ptr<const Resource::BulletShape> shape;
+            try
+            {
+                shape = bulletShapeManager.getShape(animationMesh);
+                if (shape != nullptr && shape->mCollisionBox.mExtents.length2() == 0 && animationMesh != mesh)
+                    shape = bulletShapeManager.getShape(mesh);
+            }
+            catch (const std::exception& e)
+            {
+                Log(Debug::Warning) << "Failed to load creature \"" << cellRef.mRefId << "\" model \"" << mesh
+                                    << "\": " << e.what();
+                return std::nullopt;
+            }
+
+            if (shape == nullptr)
+                return std::nullopt;
+
+            osg::Vec3f halfExtents = shape->mCollisionBox.mExtents;
+            osg::Vec3f meshTranslation = shape->mCollisionBox.mCenter;
+
+            if (halfExtents.length2() == 0 && shape->mCollisionShape != nullptr)
+            {
+                btTransform transform;
+                transform.setIdentity();
+                btVector3 min;
+                btVector3 max;
+                shape->mCollisionShape->getAabb(transform, min, max);
+                halfExtents.x() = static_cast<float>((max[0] - min[0]) / 2.f);
+                halfExtents.y() = static_cast<float>((max[1] - min[1]) / 2.f);
+                halfExtents.z() = static_cast<float>((max[2] - min[2]) / 2.f);
+                meshTranslation = osg::Vec3f(0.f, 0.f, halfExtents.z());
+            }
+
+            if (halfExtents.length2() == 0)
+                return std::nullopt;
+
+            DetourNavigator::CollisionShapeType shapeType = Settings::game().mActorCollisionShapeType;
+            if (meshTranslation.x() != 0 || meshTranslation.y() != 0
+                || std::fabs(halfExtents.x() - halfExtents.y()) >= 2.2)
+                shapeType = DetourNavigator::CollisionShapeType::RotatingBox;
+
+            osg::Vec3f scale(cellRef.mScale, cellRef.mScale, cellRef.mScale);
+            scale *= creature->mScale;
+
+            return AgentBounds{ shapeType, osg::componentMultiply(halfExtents, scale) };
+        }
+
+        template <class F, class C>
         void forEachObject(const ESM::Cell& cell, const EsmLoader::EsmData& esmData, const VFS::Manager& vfs,
-            Resource::BulletShapeManager& bulletShapeManager, ESM::ReadersCache& readers, F&& f)
+            Resource::BulletShapeManager& bulletShapeManager, ESM::ReadersCache& readers, F&& f, C&& onCreature)
         {
             std::vector<CellRef> cellRefs = loadCellRefs(cell, esmData, readers);
 
@@ -121,6 +186,14 @@ namespace NavMeshTool
 
             for (CellRef& cellRef : cellRefs)
             {
+                if (cellRef.mType == ESM::REC_CREA)
+                {
+                    if (const std::optional<AgentBounds> agentBounds
+                        = getCreatureAgentBounds(cellRef, esmData, vfs, bulletShapeManager))
+                        onCreature(*agentBounds);
+                    continue;
+                }
+
                 VFS::Path::Normalized model(getModel(esmData, cellRef.mRefId, cellRef.mType));
                 if (model.empty())
                     continue;
@@ -346,6 +419,9 @@ namespace NavMeshTool
                 }
 
                 data.mObjects.emplace_back(std::move(object));
+            }, [&](const AgentBounds& agentBounds) {
+                if (!exterior)
+                    navMeshInput.mAgentBounds.push_back(agentBounds);
             });
 
             const auto cellDescription = cell.getDescription();
@@ -358,9 +434,24 @@ namespace NavMeshTool
                              << (data.mObjects.size() - cellObjectsBegin) << " objects";
         }
 
+        std::size_t agentBoundsCount = 0;
         data.mNavMeshInputs.reserve(navMeshInputs.size());
-        std::transform(navMeshInputs.begin(), navMeshInputs.end(), std::back_inserter(data.mNavMeshInputs),
-            [](auto& v) { return std::move(v.second); });
+        for (auto& [worldspace, input] : navMeshInputs)
+        {
+            std::sort(input->mAgentBounds.begin(), input->mAgentBounds.end());
+            input->mAgentBounds.erase(
+                std::unique(input->mAgentBounds.begin(), input->mAgentBounds.end()), input->mAgentBounds.end());
+            agentBoundsCount += input->mAgentBounds.size();
+            data.mNavMeshInputs.push_back(std::move(input));
+        }
+
+        // Shard processes have to see the same worldspaces order to split tiles in the same way
+        std::sort(data.mNavMeshInputs.begin(), data.mNavMeshInputs.end(), [](const auto& l, const auto& r) {
+            return l->mWorldspace.serializeText() < r->mWorldspace.serializeText();
+        });
+
+        if (agentBoundsCount > 0)
+            Log(Debug::Info) << "Found " << agentBoundsCount << " distinct creature agent bounds in interior cells";
 
         Log(Debug::Info) << "Processed " << esmData.mCells.size() << " cells, added " << data.mObjects.size()
                          << " objects and " << data.mHeightfields.size() << " height fields";
@@ -2,6 +2,7 @@
 #define OPENMW_NAVMESHTOOL_WORLDSPACEDATA_H
 
 #include <components/bullethelpers/collisionobject.hpp>
+#include <components/detournavigator/agentbounds.hpp>
 #include <components/detournavigator/tilecachedrecastmeshmanager.hpp>
 #include <components/esm3/loadland.hpp>
 #include <components/misc/convert.hpp>
@@ -52,6 +53,8 @@ namespace NavMeshTool
         TileCachedRecastMeshManager mTileCachedRecastMeshManager;
         btAABB mAabb;
         bool mAabbInitialized = false;
+        // Distinct bounds of creatures placed in the worldspace used in addition to the common ones
+        std::vector<DetourNavigator::AgentBounds> mAgentBounds;
 
         explicit WorldspaceNavMeshInput(ESM::RefId worldspace, const DetourNavigator::RecastSettings& settings);
     };
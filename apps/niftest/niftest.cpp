@@ -1,10 +1,22 @@
 /// Program to test .nif files both on the FileSystem and in BSA archives.
 
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstdint>
 #include <exception>
 #include <filesystem>
+#include <fstream>
+#include <iomanip>
 #include <iostream>
+#include <iterator>
 #include <memory>
+#include <mutex>
+#include <optional>
+#include <sstream>
 #include <string>
+#include <string_view>
+#include <thread>
 #include <utility>
 #include <vector>
 
@@ -12,8 +24,12 @@
 #include <components/files/configurationmanager.hpp>
 #include <components/files/constrainedfilestream.hpp>
 #include <components/files/conversion.hpp>
+#include <components/misc/jobpool.hpp>
 #include <components/misc/strings/algorithm.hpp>
 #include <components/nif/niffile.hpp>
+#include <components/nifbullet/bulletnifloader.hpp>
+#include <components/nifosg/nifloader.hpp>
+#include <components/sceneutil/keyframe.hpp>
 #include <components/vfs/archive.hpp>
 #include <components/vfs/bsaarchive.hpp>
 #include <components/vfs/filesystemarchive.hpp>
@@ -22,6 +38,14 @@
 
 #include <boost/program_options.hpp>
 
+#ifdef _WIN32
+#include <components/misc/windows.hpp>
+
+#include <psapi.h>
+#else
+#include <sys/resource.h>
+#endif
+
 // Create local aliases for brevity
 namespace bpo = boost::program_options;
 
@@ -105,6 +129,54 @@ std::string getFileTypeName(FileType fileType)
     }
 }
 
+enum class Stage
+{
+    Read,
+    Parse,
+    Nodes,
+    Shapes,
+};
+
+constexpr std::array stageNames{ "read", "parse", "nodes", "shapes" };
+
+struct Options
+{
+    bool mWriteDebugLog = false;
+    bool mQuiet = false;
+    bool mLoadNodes = false;
+    bool mLoadShapes = false;
+    std::size_t mThreads = 1;
+    std::size_t mSlowest = 10;
+    std::filesystem::path mReport;
+};
+
+struct FileReport
+{
+    std::string mPath;
+    std::uint64_t mSize = 0;
+    // Time spent in each stage in seconds, empty for stages not run on the file
+    std::array<std::optional<double>, stageNames.size()> mDurations;
+    bool mFailed = false;
+
+    double getDuration() const
+    {
+        double result = 0;
+        for (const std::optional<double>& duration : mDurations)
+            result += duration.value_or(0);
+        return result;
+    }
+};
+
+struct Context
+{
+    const Options& mOptions;
+    Misc::JobPool* mJobPool;
+    // Keeps lines written by different threads apart
+    std::mutex mOutputMutex;
+    std::mutex mFilesMutex;
+    std::vector<FileReport> mFiles;
+};
+
 bool isBSA(const std::filesystem::path& path)
 {
     return classifyFile(path).second == FileClass::Archive;
@@ -119,42 +191,96 @@ std::unique_ptr<VFS::Archive> makeArchive(const std::filesystem::path& path)
     return nullptr;
 }
 
-bool readFile(
-    const std::filesystem::path& source, const std::filesystem::path& path, const VFS::Manager* vfs, bool quiet)
+bool isReadable(const std::filesystem::path& path)
+{
+    const FileClass fileClass = classifyFile(path).second;
+    return fileClass == FileClass::NIF || fileClass == FileClass::Material;
+}
+
+std::optional<std::uint64_t> getPeakMemoryUsage()
+{
+#ifdef _WIN32
+    PROCESS_MEMORY_COUNTERS counters;
+    if (!GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters)))
+        return std::nullopt;
+    return counters.PeakWorkingSetSize;
+#else
+    rusage usage;
+    if (getrusage(RUSAGE_SELF, &usage) != 0)
+        return std::nullopt;
+#ifdef __APPLE__
+    return static_cast<std::uint64_t>(usage.ru_maxrss);
+#else
+    return static_cast<std::uint64_t>(usage.ru_maxrss) * 1024;
+#endif
+#endif
+}
+
+void readFile(
+    const std::filesystem::path& source, const std::filesystem::path& path, const VFS::Manager* vfs, Context& context)
 {
     const auto [fileType, fileClass] = classifyFile(path);
     if (fileClass != FileClass::NIF && fileClass != FileClass::Material)
-        return false;
+        return;
 
     const std::string pathStr = Files::pathToUnicodeString(path);
-    if (!quiet)
+    if (!context.mOptions.mQuiet)
     {
-        std::cout << "Reading " << getFileTypeName(fileType) << " file '" << pathStr << "'";
+        std::ostringstream message;
+        message << "Reading " << getFileTypeName(fileType) << " file '" << pathStr << "'";
         if (!source.empty())
-            std::cout << " from '" << Files::pathToUnicodeString(isBSA(source) ? source.filename() : source) << "'";
-        std::cout << std::endl;
+            message << " from '" << Files::pathToUnicodeString(isBSA(source) ? source.filename() : source) << "'";
+        std::lock_guard<std::mutex> lock(context.mOutputMutex);
+        std::cout << message.str() << std::endl;
     }
     const std::filesystem::path fullPath = !source.empty() ? source / path : path;
+
+    FileReport report;
+    report.mPath = Files::pathToUnicodeString(fullPath);
+    Stage stage = Stage::Read;
+    const auto measure = [&](Stage value, auto&& function) {
+        stage = value;
+        const auto start = std::chrono::steady_clock::now();
+        function();
+        report.mDurations[static_cast<std::size_t>(value)]
+            = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    };
+
     try
     {
+        // Read the whole file first to measure reading and parsing separately
+        std::string data;
+        measure(Stage::Read, [&] {
+            Files::IStreamPtr stream = vfs != nullptr ? vfs->get(pathStr) : Files::openConstrainedFileStream(fullPath);
+            data.assign(std::istreambuf_iterator<char>(*stream), std::istreambuf_iterator<char>());
+        });
+        report.mSize = data.size();
+
         switch (fileClass)
         {
             case FileClass::NIF:
             {
                 Nif::NIFFile file(VFS::Path::Normalized(Files::pathToUnicodeString(fullPath)));
-                Nif::Reader reader(file, nullptr);
-                if (vfs != nullptr)
-                    reader.parse(vfs->get(pathStr));
-                else
-                    reader.parse(Files::openConstrainedFileStream(fullPath));
+                measure(Stage::Parse, [&] {
+                    Nif::Reader reader(file, nullptr);
+                    reader.parse(std::make_unique<std::istringstream>(std::move(data)));
+                });
+                if (context.mOptions.mLoadNodes && fileType == FileType::NIF)
+                    measure(Stage::Nodes, [&] { NifOsg::Loader::load(file, nullptr, nullptr); });
+                if (context.mOptions.mLoadNodes && fileType == FileType::KF)
+                {
+                    measure(Stage::Nodes, [&] {
+                        SceneUtil::KeyframeHolder keyframes;
+                        NifOsg::Loader::loadKf(file, keyframes);
+                    });
+                }
+                if (context.mOptions.mLoadShapes && fileType == FileType::NIF)
+                    measure(Stage::Shapes, [&] { NifBullet::BulletNifLoader().load(file); });
                 break;
             }
             case FileClass::Material:
             {
-                if (vfs != nullptr)
-                    Bgsm::parse(vfs->get(pathStr));
-                else
-                    Bgsm::parse(Files::openConstrainedFileStream(fullPath));
+                measure(Stage::Parse, [&] { Bgsm::parse(std::make_unique<std::istringstream>(std::move(data))); });
                 break;
             }
             default:
@@ -163,30 +289,170 @@ bool readFile(
     }
     catch (std::exception& e)
     {
-        std::cerr << "Failed to read '" << pathStr << "':" << std::endl << e.what() << std::endl;
+        report.mFailed = true;
+        std::lock_guard<std::mutex> lock(context.mOutputMutex);
+        switch (stage)
+        {
+            case Stage::Nodes:
+                std::cerr << "Failed to load nodes from '" << pathStr << "':" << std::endl << e.what() << std::endl;
+                break;
+            case Stage::Shapes:
+                std::cerr << "Failed to load shapes from '" << pathStr << "':" << std::endl << e.what() << std::endl;
+                break;
+            default:
+                std::cerr << "Failed to read '" << pathStr << "':" << std::endl << e.what() << std::endl;
+                break;
+        }
+    }
+
+    std::lock_guard<std::mutex> lock(context.mFilesMutex);
+    context.mFiles.push_back(std::move(report));
+}
+
+void readFiles(const std::filesystem::path& source, const std::vector<std::filesystem::path>& paths,
+    const VFS::Manager* vfs, Context& context)
+{
+    const auto job = [&](std::size_t index) { readFile(source, paths[index], vfs, context); };
+
+    if (context.mJobPool == nullptr)
+    {
+        for (std::size_t i = 0; i < paths.size(); ++i)
+            job(i);
+        return;
+    }
+
+    context.mJobPool->run(paths.size(), 1, job);
+}
+
+std::string escapeJson(std::string_view value)
+{
+    std::ostringstream result;
+    for (const char c : value)
+    {
+        switch (c)
+        {
+            case '"':
+                result << "\\\"";
+                break;
+            case '\\':
+                result << "\\\\";
+                break;
+            case '\n':
+                result << "\\n";
+                break;
+            case '\t':
+                result << "\\t";
+                break;
+            default:
+                if (static_cast<unsigned char>(c) < 0x20)
+                    result << "\\u" << std::hex << std::setw(4) << std::setfill('0') << static_cast<int>(c)
+                           << std::dec;
+                else
+                    result << c;
+                break;
+        }
     }
-    return true;
+    return result.str();
+}
+
+/// Write the throughput of the stages, the peak memory usage and the slowest files as JSON.
+/// \note Stage throughput is based on the time the threads spent in the stage, the total throughput on the time it
+/// took to process all files.
+void writeReport(std::ostream& stream, Context& context, double seconds)
+{
+    constexpr double megabyte = 1024 * 1024;
+
+    std::uint64_t size = 0;
+    std::size_t failed = 0;
+    for (const FileReport& file : context.mFiles)
+    {
+        size += file.mSize;
+        failed += file.mFailed ? 1 : 0;
+    }
+
+    const auto writeThroughput = [&](std::size_t files, std::uint64_t bytes, double duration) {
+        stream << "\"files\": " << files << ", \"bytes\": " << bytes << ", \"seconds\": " << duration
+               << ", \"files_per_second\": " << (duration > 0 ? files / duration : 0)
+               << ", \"megabytes_per_second\": " << (duration > 0 ? bytes / megabyte / duration : 0);
+    };
+
+    stream << "{\n";
+    stream << "  \"threads\": " << context.mOptions.mThreads << ",\n";
+    stream << "  \"failed\": " << failed << ",\n";
+    stream << "  ";
+    writeThroughput(context.mFiles.size(), size, seconds);
+    stream << ",\n";
+
+    stream << "  \"peak_memory_bytes\": ";
+    if (const std::optional<std::uint64_t> peakMemory = getPeakMemoryUsage())
+        stream << *peakMemory;
+    else
+        stream << "null";
+    stream << ",\n";
+
+    stream << "  \"stages\": {";
+    for (std::size_t i = 0; i < stageNames.size(); ++i)
+    {
+        std::size_t files = 0;
+        std::uint64_t bytes = 0;
+        double duration = 0;
+        for (const FileReport& file : context.mFiles)
+        {
+            if (!file.mDurations[i].has_value())
+                continue;
+            ++files;
+            bytes += file.mSize;
+            duration += *file.mDurations[i];
+        }
+        stream << (i == 0 ? "\n" : ",\n") << "    \"" << stageNames[i] << "\": { ";
+        writeThroughput(files, bytes, duration);
+        stream << " }";
+    }
+    stream << "\n  },\n";
+
+    const std::size_t slowest = std::min(context.mOptions.mSlowest, context.mFiles.size());
+    std::partial_sort(context.mFiles.begin(), context.mFiles.begin() + slowest, context.mFiles.end(),
+        [](const FileReport& lhs, const FileReport& rhs) { return lhs.getDuration() > rhs.getDuration(); });
+
+    stream << "  \"slowest\": [";
+    for (std::size_t i = 0; i < slowest; ++i)
+    {
+        const FileReport& file = context.mFiles[i];
+        stream << (i == 0 ? "\n" : ",\n") << "    { \"path\": \"" << escapeJson(file.mPath)
+               << "\", \"bytes\": " << file.mSize << ", \"seconds\": " << file.getDuration()
+               << ", \"failed\": " << (file.mFailed ? "true" : "false");
+        for (std::size_t j = 0; j < stageNames.size(); ++j)
+            if (file.mDurations[j].has_value())
+                stream << ", \"" << stageNames[j] << "_seconds\": " << *file.mDurations[j];
+        stream << " }";
+    }
+    stream << (slowest == 0 ? "]\n" : "\n  ]\n");
+    stream << "}" << std::endl;
 }
 
 /// Check all the nif files in a given VFS::Archive
 /// \note Can not read a bsa file inside of a bsa file.
-void readVFS(std::unique_ptr<VFS::Archive>&& archive, const std::filesystem::path& archivePath, bool quiet)
+void readVFS(std::unique_ptr<VFS::Archive>&& archive, const std::filesystem::path& archivePath, Context& context)
 {
     if (archive == nullptr)
         return;
 
-    if (!quiet)
+    if (!context.mOptions.mQuiet)
         std::cout << "Reading data source '" << Files::pathToUnicodeString(archivePath) << "'" << std::endl;
 
     VFS::Manager vfs;
     vfs.addArchive(std::move(archive));
     vfs.buildIndex();
 
+    std::vector<std::filesystem::path> paths;
     for (const auto& name : vfs.getRecursiveDirectoryIterator())
     {
-        readFile(archivePath, name.value(), &vfs, quiet);
+        if (isReadable(name.value()))
+            paths.emplace_back(name.value());
     }
 
+    readFiles(archivePath, paths, &vfs, context);
+
     if (!archivePath.empty() && !isBSA(archivePath))
     {
         const Files::Collections fileCollections({ archivePath });
@@ -198,7 +464,7 @@ void readVFS(std::unique_ptr<VFS::Archive>&& archive, const std::filesystem::pat
             {
                 try
                 {
-                    readVFS(VFS::makeBsaArchive(file.second, nullptr), file.second, quiet);
+                    readVFS(VFS::makeBsaArchive(file.second, nullptr), file.second, context);
                 }
                 catch (const std::exception& e)
                 {
@@ -210,8 +476,7 @@ void readVFS(std::unique_ptr<VFS::Archive>&& archive, const std::filesystem::pat
     }
 }
 
-bool parseOptions(int argc, char** argv, Files::PathContainer& files, Files::PathContainer& archives,
-    bool& writeDebugLog, bool& quiet)
+bool parseOptions(int argc, char** argv, Files::PathContainer& files, Files::PathContainer& archives, Options& options)
 {
     bpo::options_description desc(
         R"(Ensure that OpenMW can use the provided NIF, KF, BTO/BTR, RDT, PSA, BGEM/BGSM and BSA/BA2 files
@@ -225,6 +490,13 @@ Allowed options)");
     addOption("help,h", "print help message.");
     addOption("write-debug-log,v", "write debug log for unsupported nif files");
     addOption("quiet,q", "do not log read archives/files");
+    addOption("threads,j", bpo::value<std::size_t>()->default_value(1),
+        "number of threads to read files with, 0 to use all hardware threads");
+    addOption("load-nodes", "also convert NIF and KF files into scene graphs like the game does");
+    addOption("load-shapes", "also create collision shapes from NIF files like the game does");
+    addOption("report", bpo::value<Files::MaybeQuotedPath>(),
+        "write throughput, peak memory usage and the slowest files as JSON to the file, - for standard output");
+    addOption("slowest", bpo::value<std::size_t>()->default_value(10), "number of slowest files in the report");
     addOption("archives", bpo::value<Files::MaybeQuotedPathContainer>(), "path to archive files to provide files");
     addOption("input-file", bpo::value<Files::MaybeQuotedPathContainer>(), "input file");
 
@@ -243,8 +515,16 @@ Allowed options)");
             std::cout << desc << std::endl;
             return false;
         }
-        writeDebugLog = variables.count("write-debug-log") > 0;
-        quiet = variables.count("quiet") > 0;
+        options.mWriteDebugLog = variables.count("write-debug-log") > 0;
+        options.mQuiet = variables.count("quiet") > 0;
+        options.mLoadNodes = variables.count("load-nodes") > 0;
+        options.mLoadShapes = variables.count("load-shapes") > 0;
+        options.mThreads = variables["threads"].as<std::size_t>();
+        if (options.mThreads == 0)
+            options.mThreads = std::max(1u, std::thread::hardware_concurrency());
+        options.mSlowest = variables["slowest"].as<std::size_t>();
+        if (const auto it = variables.find("report"); it != variables.end())
+            options.mReport = it->second.as<Files::MaybeQuotedPath>();
         if (variables.count("input-file"))
         {
             files = asPathContainer(variables["input-file"].as<Files::MaybeQuotedPathContainer>());
@@ -267,13 +547,17 @@ Allowed options)");
 int main(int argc, char** argv)
 {
     Files::PathContainer files, sources;
-    bool writeDebugLog = false;
-    bool quiet = false;
-    if (!parseOptions(argc, argv, files, sources, writeDebugLog, quiet))
+    Options options;
+    if (!parseOptions(argc, argv, files, sources, options))
         return 1;
 
     Nif::Reader::setLoadUnsupportedFiles(true);
-    Nif::Reader::setWriteNifDebugLog(writeDebugLog);
+    Nif::Reader::setWriteNifDebugLog(options.mWriteDebugLog);
+
+    std::unique_ptr<Misc::JobPool> jobPool;
+    if (options.mThreads > 1)
+        jobPool = std::make_unique<Misc::JobPool>(options.mThreads - 1);
+    Context context{ .mOptions = options, .mJobPool = jobPool.get() };
 
     std::unique_ptr<VFS::Manager> vfs;
     if (!sources.empty())
@@ -282,7 +566,7 @@ int main(int argc, char** argv)
         for (const std::filesystem::path& path : sources)
         {
             const std::string pathStr = Files::pathToUnicodeString(path);
-            if (!quiet)
+            if (!options.mQuiet)
                 std::cout << "Adding data source '" << pathStr << "'" << std::endl;
 
             try
@@ -301,17 +585,24 @@ int main(int argc, char** argv)
         vfs->buildIndex();
     }
 
+    const auto start = std::chrono::steady_clock::now();
+
+    std::vector<std::filesystem::path> readableFiles;
+    for (const auto& path : files)
+        if (isReadable(path))
+            readableFiles.push_back(path);
+    readFiles({}, readableFiles, vfs.get(), context);
+
     for (const auto& path : files)
     {
         const std::string pathStr = Files::pathToUnicodeString(path);
         try
         {
-            const bool isFile = readFile({}, path, vfs.get(), quiet);
-            if (!isFile)
+            if (!isReadable(path))
             {
                 if (auto archive = makeArchive(path))
                 {
-                    readVFS(std::move(archive), path, quiet);
+                    readVFS(std::move(archive), path, context);
                 }
                 else
                 {
@@ -325,5 +616,24 @@ int main(int argc, char** argv)
             std::cerr << "Failed to read '" << pathStr << "':  " << e.what() << std::endl;
         }
     }
+
+    const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    if (options.mReport == "-")
+    {
+        writeReport(std::cout, context, seconds);
+    }
+    else if (!options.mReport.empty())
+    {
+        std::ofstream stream(options.mReport);
+        if (!stream.is_open())
+        {
+            std::cerr << "Failed to open report file '" << Files::pathToUnicodeString(options.mReport) << "'"
+                      << std::endl;
+            return 1;
+        }
+        writeReport(stream, context, seconds);
+    }
+
     return 0;
 }
@@ -6,6 +6,7 @@
 #include <apps/opencs/model/doc/operationholder.hpp>
 #include <apps/opencs/model/doc/runner.hpp>
 #include <apps/opencs/model/doc/saving.hpp>
+#include <apps/opencs/model/prefs/state.hpp>
 #include <apps/opencs/model/tools/tools.hpp>
 #include <apps/opencs/model/world/data.hpp>
 #include <apps/opencs/model/world/idcollection.hpp>
@@ -341,6 +342,8 @@ CSMDoc::Document::Document(const Files::ConfigurationManager& configuration, std
     addOptionalGlobals();
     addOptionalMagicEffects();
 
+    // Can only be set while the stack is empty
+    mUndoStack.setUndoLimit(CSMPrefs::get()["Records"]["undo-limit"].toInt());
     connect(&mUndoStack, &QUndoStack::cleanChanged, this, &Document::modificationStateChanged);
 
     connect(&mTools, &CSMTools::Tools::progress, this, qOverload<int, int, int>(&Document::progress));
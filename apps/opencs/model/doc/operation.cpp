@@ -1,7 +1,11 @@
 #include "operation.hpp"
 
 #include <algorithm>
+#include <atomic>
 #include <exception>
+#include <optional>
+#include <string>
+#include <thread>
 #include <vector>
 
 #include <QTimer>
@@ -37,6 +41,9 @@ namespace CSMDoc
             }
             return "Unknown";
         }
+
+        // Steps of a parallel stage performed by each thread per timer tick, keeps the operation responsive to abort
+        constexpr int sParallelStepsPerThread = 32;
     }
 }
 
@@ -145,6 +152,11 @@ void CSMDoc::Operation::executeStage()
             mCurrentStep = 0;
             ++mCurrentStage;
         }
+        else if (mCurrentStage->first->isParallel())
+        {
+            executeParallelSteps();
+            break;
+        }
         else
         {
             try
@@ -182,6 +194,74 @@ void CSMDoc::Operation::executeStage()
     }
 }
 
+void CSMDoc::Operation::executeParallelSteps()
+{
+    Stage& stage = *mCurrentStage->first;
+    const int threadCount = static_cast<int>(std::max(1u, std::thread::hardware_concurrency()));
+    const int firstStep = mCurrentStep;
+    const int stepCount = std::min(mCurrentStage->second - firstStep, threadCount * sParallelStepsPerThread);
+
+    // Every step gets its own messages, they are reported in the order of the steps no matter which thread performed
+    // which step
+    std::vector<Messages> stepMessages(stepCount, Messages(mDefaultSeverity));
+    std::vector<std::optional<std::string>> stepErrors(stepCount);
+    std::atomic_int nextStep{ 0 };
+
+    const auto performSteps = [&] {
+        for (int i = nextStep++; i < stepCount; i = nextStep++)
+        {
+            try
+            {
+                stage.perform(firstStep + i, stepMessages[i]);
+            }
+            catch (const std::exception& e)
+            {
+                stepErrors[i] = e.what();
+            }
+        }
+    };
+
+    std::vector<std::thread> threads;
+    for (int i = 1; i < std::min(threadCount, stepCount); ++i)
+        threads.emplace_back(performSteps);
+    performSteps();
+    for (std::thread& thread : threads)
+        thread.join();
+
+    mCurrentStep += stepCount;
+    mCurrentStepTotal += stepCount;
+
+    for (int i = 0; i < stepCount; ++i)
+    {
+        for (Messages::Iterator iter(stepMessages[i].begin()); iter != stepMessages[i].end(); ++iter)
+            emit reportMessage(*iter, mType);
+
+        if (!stepErrors[i].has_value())
+        {
+            Messages messages(mDefaultSeverity);
+            try
+            {
+                stage.finishStep(firstStep + i, messages);
+            }
+            catch (const std::exception& e)
+            {
+                stepErrors[i] = e.what();
+            }
+
+            for (Messages::Iterator iter(messages.begin()); iter != messages.end(); ++iter)
+                emit reportMessage(*iter, mType);
+        }
+
+        if (stepErrors[i].has_value())
+        {
+            emit reportMessage(
+                Message(CSMWorld::UniversalId(), *stepErrors[i], "", Message::Severity_SeriousError), mType);
+            abort();
+            break;
+        }
+    }
+}
+
 void CSMDoc::Operation::operationDone()
 {
     mTimer->stop();
@@ -38,6 +38,8 @@ namespace CSMDoc
 
         void prepareStages();
 
+        void executeParallelSteps();
+
     public:
         Operation(State type, bool ordered, bool finalAlways = false);
         ///< \param ordered Stages must be executed in the given order.
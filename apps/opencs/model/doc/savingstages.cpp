@@ -217,12 +217,21 @@ CSMDoc::WriteRefIdCollectionStage::WriteRefIdCollectionStage(Document& document,
 
 int CSMDoc::WriteRefIdCollectionStage::setup()
 {
+    mRecords.clear();
+    mRecords.resize(mDocument.getData().getReferenceables().getSize());
     return mDocument.getData().getReferenceables().getSize();
 }
 
 void CSMDoc::WriteRefIdCollectionStage::perform(int stage, Messages& messages)
 {
-    mDocument.getData().getReferenceables().save(stage, mState.getWriter());
+    mRecords[stage] = mState.writeRecords(
+        [&](ESM::ESMWriter& writer) { mDocument.getData().getReferenceables().save(stage, writer); });
+}
+
+void CSMDoc::WriteRefIdCollectionStage::finishStep(int stage, Messages& messages)
+{
+    mState.appendRecords(mRecords[stage]);
+    mRecords[stage] = std::string();
 }
 
 CSMDoc::CollectionReferencesStage::CollectionReferencesStage(Document& document, SavingState& state)
@@ -467,6 +476,7 @@ void CSMDoc::WriteLandCollectionStage::perform(int stage, Messages& messages)
     if (land.isModified() || land.mState == CSMWorld::RecordBase::State_Deleted)
     {
         CSMWorld::Land record = land.get();
+        record.loadAllData();
         writer.startRecord(record.sRecordId);
         record.save(writer, land.mState == CSMWorld::RecordBase::State_Deleted);
         writer.endRecord(record.sRecordId);
@@ -4,7 +4,9 @@
 #include "stage.hpp"
 
 #include <deque>
+#include <string>
 #include <unordered_map>
+#include <vector>
 
 #include "../world/idcollection.hpp"
 #include "../world/infocollection.hpp"
@@ -69,6 +71,7 @@ namespace CSMDoc
         const CollectionT& mCollection;
         SavingState& mState;
         CSMWorld::Scope mScope;
+        std::vector<std::string> mRecords;
 
     public:
         WriteCollectionStage(
@@ -79,6 +82,10 @@ namespace CSMDoc
 
         void perform(int stage, Messages& messages) override;
         ///< Messages resulting from this stage will be appended to \a messages.
+
+        bool isParallel() const override { return true; }
+
+        void finishStep(int stage, Messages& messages) override;
     };
 
     template <class CollectionT>
@@ -93,6 +100,8 @@ namespace CSMDoc
     template <class CollectionT>
     int WriteCollectionStage<CollectionT>::setup()
     {
+        mRecords.clear();
+        mRecords.resize(mCollection.getSize());
         return mCollection.getSize();
     }
 
@@ -102,19 +111,27 @@ namespace CSMDoc
         if (CSMWorld::getScopeFromId(mCollection.getRecord(stage).get().mId) != mScope)
             return;
 
-        ESM::ESMWriter& writer = mState.getWriter();
         CSMWorld::RecordBase::State state = mCollection.getRecord(stage).mState;
         typename CollectionT::ESXRecord record = mCollection.getRecord(stage).get();
 
         if (state == CSMWorld::RecordBase::State_Modified || state == CSMWorld::RecordBase::State_ModifiedOnly
             || state == CSMWorld::RecordBase::State_Deleted)
         {
-            writer.startRecord(record.sRecordId, record.mRecordFlags);
-            record.save(writer, state == CSMWorld::RecordBase::State_Deleted);
-            writer.endRecord(record.sRecordId);
+            mRecords[stage] = mState.writeRecords([&](ESM::ESMWriter& writer) {
+                writer.startRecord(record.sRecordId, record.mRecordFlags);
+                record.save(writer, state == CSMWorld::RecordBase::State_Deleted);
+                writer.endRecord(record.sRecordId);
+            });
         }
     }
 
+    template <class CollectionT>
+    void WriteCollectionStage<CollectionT>::finishStep(int stage, Messages& messages)
+    {
+        mState.appendRecords(mRecords[stage]);
+        mRecords[stage] = std::string();
+    }
+
     class WriteDialogueCollectionStage : public Stage
     {
         SavingState& mState;
@@ -136,6 +153,7 @@ namespace CSMDoc
     {
         Document& mDocument;
         SavingState& mState;
+        std::vector<std::string> mRecords;
 
     public:
         WriteRefIdCollectionStage(Document& document, SavingState& state);
@@ -145,6 +163,10 @@ namespace CSMDoc
 
         void perform(int stage, Messages& messages) override;
         ///< Messages resulting from this stage will be appended to \a messages.
+
+        bool isParallel() const override { return true; }
+
+        void finishStep(int stage, Messages& messages) override;
     };
 
     class CollectionReferencesStage : public Stage
@@ -6,8 +6,31 @@
 #include "document.hpp"
 #include "operation.hpp"
 
+CSMDoc::RecordBuffer::RecordBuffer(ToUTF8::FromType encoding)
+    : mEncoder(encoding)
+{
+    mWriter.setEncoder(&mEncoder);
+}
+
+ESM::ESMWriter& CSMDoc::RecordBuffer::start(const ESM::ESMWriter& writer)
+{
+    mStream.str(std::string());
+    mStream.clear();
+    mWriter.setVersion(writer.getVersion());
+    mWriter.setFormatVersion(writer.getFormatVersion());
+    mWriter.setStream(mStream);
+    return mWriter;
+}
+
+std::string CSMDoc::RecordBuffer::finish()
+{
+    mWriter.close();
+    return std::move(mStream).str();
+}
+
 CSMDoc::SavingState::SavingState(Operation& operation, std::filesystem::path projectPath, ToUTF8::FromType encoding)
     : mOperation(operation)
+    , mEncoding(encoding)
     , mEncoder(encoding)
     , mProjectPath(std::move(projectPath))
     , mProjectFile(false)
@@ -85,3 +108,28 @@ void CSMDoc::SavingState::clearSubRecords()
 {
     mSubRecords.clear();
 }
+
+std::unique_ptr<CSMDoc::RecordBuffer> CSMDoc::SavingState::acquireRecordBuffer()
+{
+    {
+        std::lock_guard<std::mutex> lock(mRecordBuffersMutex);
+        if (!mRecordBuffers.empty())
+        {
+            std::unique_ptr<RecordBuffer> buffer = std::move(mRecordBuffers.back());
+            mRecordBuffers.pop_back();
+            return buffer;
+        }
+    }
+    return std::make_unique<RecordBuffer>(mEncoding);
+}
+
+void CSMDoc::SavingState::releaseRecordBuffer(std::unique_ptr<RecordBuffer> buffer)
+{
+    std::lock_guard<std::mutex> lock(mRecordBuffersMutex);
+    mRecordBuffers.push_back(std::move(buffer));
+}
+
+void CSMDoc::SavingState::appendRecords(std::string_view records)
+{
+    mStream.write(records.data(), static_cast<std::streamsize>(records.size()));
+}
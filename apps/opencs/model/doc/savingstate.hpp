@@ -5,7 +5,12 @@
 #include <filesystem>
 #include <fstream>
 #include <map>
+#include <memory>
+#include <mutex>
+#include <sstream>
 #include <string>
+#include <string_view>
+#include <vector>
 
 #include <components/esm3/esmwriter.hpp>
 #include <components/misc/algorithm.hpp>
@@ -16,9 +21,28 @@ namespace CSMDoc
     class Operation;
     class Document;
 
+    /// Serializes records into memory, so they can be written on another thread than the file and appended to it
+    /// afterwards.
+    class RecordBuffer
+    {
+        ToUTF8::Utf8Encoder mEncoder;
+        std::ostringstream mStream;
+        ESM::ESMWriter mWriter;
+
+    public:
+        explicit RecordBuffer(ToUTF8::FromType encoding);
+
+        ESM::ESMWriter& start(const ESM::ESMWriter& writer);
+        ///< Start writing records with the same version and format version as \a writer.
+
+        std::string finish();
+        ///< \return the records written since start
+    };
+
     class SavingState
     {
         Operation& mOperation;
+        ToUTF8::FromType mEncoding;
         std::filesystem::path mPath;
         std::filesystem::path mTmpPath;
         ToUTF8::Utf8Encoder mEncoder;
@@ -27,6 +51,12 @@ namespace CSMDoc
         std::filesystem::path mProjectPath;
         bool mProjectFile;
         std::map<ESM::RefId, std::deque<int>> mSubRecords; // record ID, list of subrecords
+        std::mutex mRecordBuffersMutex;
+        std::vector<std::unique_ptr<RecordBuffer>> mRecordBuffers;
+
+        std::unique_ptr<RecordBuffer> acquireRecordBuffer();
+
+        void releaseRecordBuffer(std::unique_ptr<RecordBuffer> buffer);
 
     public:
         SavingState(Operation& operation, std::filesystem::path projectPath, ToUTF8::FromType encoding);
@@ -52,8 +82,26 @@ namespace CSMDoc
         std::deque<int>& getOrInsertSubRecord(const ESM::RefId& refId);
 
         void clearSubRecords();
+
+        template <class Function>
+        std::string writeRecords(Function&& function);
+        ///< Call \a function with a writer that serializes records into memory instead of the file. Can be called
+        /// from several threads at the same time.
+        /// \return the serialized records, to be passed to appendRecords
+
+        void appendRecords(std::string_view records);
     };
 
+    template <class Function>
+    std::string SavingState::writeRecords(Function&& function)
+    {
+        std::unique_ptr<RecordBuffer> buffer = acquireRecordBuffer();
+        function(buffer->start(mWriter));
+        std::string records = buffer->finish();
+        releaseRecordBuffer(std::move(buffer));
+        return records;
+    }
+
 }
 
 #endif
@@ -14,6 +14,14 @@ namespace CSMDoc
 
         virtual void perform(int stage, Messages& messages) = 0;
         ///< Messages resulting from this stage will be appended to \a messages.
+
+        virtual bool isParallel() const { return false; }
+        ///< \return true if perform only reads the document and the state set up by setup, so different steps can be
+        /// performed on different threads at the same time.
+
+        virtual void finishStep(int stage, Messages& messages) {}
+        ///< Called on the operation thread in the order of the steps after a parallel step is performed, for work
+        /// that has to be done in order (e.g. writing to a file).
     };
 }
 
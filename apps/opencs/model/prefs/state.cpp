@@ -63,6 +63,12 @@ void CSMPrefs::State::declare()
     declareCategory("Records");
     declareEnum(mValues->mRecords.mStatusFormat, "Modification Status Display Format");
     declareEnum(mValues->mRecords.mTypeFormat, "ID Type Display Format");
+    declareInt(mValues->mRecords.mUndoLimit, "Undo History Size")
+        .setTooltip(
+            "Maximum number of commands kept in the undo history of a document, the oldest ones are dropped "
+            "when it is exceeded. 0 keeps all commands.\n\n"
+            "This only affects documents opened after the change.")
+        .setRange(0, 100000);
 
     declareCategory("ID Tables");
     declareEnum(mValues->mIdTables.mDouble, "Double Click");
@@ -106,6 +106,7 @@ namespace CSMPrefs
 
         EnumSettingValue mStatusFormat{ mIndex, sName, "status-format", sRecordValues, 0 };
         EnumSettingValue mTypeFormat{ mIndex, sName, "type-format", sRecordValues, 0 };
+        Settings::SettingValue<int> mUndoLimit{ mIndex, sName, "undo-limit", 0 };
     };
 
     struct IdTablesCategory : Settings::WithIndex
@@ -5,6 +5,7 @@
 #include <QString>
 
 #include <memory>
+#include <optional>
 #include <sstream>
 #include <stdexcept>
 #include <utility>
@@ -21,20 +22,24 @@
 #include "../world/universalid.hpp"
 
 void CSMTools::Search::searchTextCell(const CSMWorld::IdTableBase* model, const QModelIndex& index,
-    const CSMWorld::UniversalId& id, bool writable, CSMDoc::Messages& messages) const
+    const CSMWorld::UniversalId& id, CSMDoc::Messages& messages) const
 {
     // using QString here for easier handling of case folding.
 
-    QString search = QString::fromUtf8(mText.c_str());
+    const QString& search = mSearchText;
     QString text = model->data(index).toString();
 
     int pos = 0;
 
     Qt::CaseSensitivity caseSensitivity = mCase ? Qt::CaseSensitive : Qt::CaseInsensitive;
+    std::optional<bool> writable;
     while ((pos = text.indexOf(search, pos, caseSensitivity)) != -1)
     {
+        if (!writable.has_value())
+            writable = isWritable(model, index);
+
         std::ostringstream hint;
-        hint << (writable ? 'R' : 'r') << ": " << model->getColumnId(index.column()) << " " << pos << " "
+        hint << (*writable ? 'R' : 'r') << ": " << model->getColumnId(index.column()) << " " << pos << " "
              << search.length();
 
         messages.add(id, formatDescription(text, pos, search.length()).toUtf8().data(), hint.str());
@@ -44,7 +49,7 @@ void CSMTools::Search::searchTextCell(const CSMWorld::IdTableBase* model, const
 }
 
 void CSMTools::Search::searchRegExCell(const CSMWorld::IdTableBase* model, const QModelIndex& index,
-    const CSMWorld::UniversalId& id, bool writable, CSMDoc::Messages& messages) const
+    const CSMWorld::UniversalId& id, CSMDoc::Messages& messages) const
 {
     // TODO: verify regular expression before starting a search
     if (!mRegExp.isValid())
@@ -53,6 +58,7 @@ void CSMTools::Search::searchRegExCell(const CSMWorld::IdTableBase* model, const
     QString text = model->data(index).toString();
 
     QRegularExpressionMatchIterator i = mRegExp.globalMatch(text);
+    std::optional<bool> writable;
     while (i.hasNext())
     {
         QRegularExpressionMatch match = i.next();
@@ -60,17 +66,20 @@ void CSMTools::Search::searchRegExCell(const CSMWorld::IdTableBase* model, const
         int pos = match.capturedStart();
         int length = match.capturedLength();
 
+        if (!writable.has_value())
+            writable = isWritable(model, index);
+
         std::ostringstream hint;
-        hint << (writable ? 'R' : 'r') << ": " << model->getColumnId(index.column()) << " " << pos << " " << length;
+        hint << (*writable ? 'R' : 'r') << ": " << model->getColumnId(index.column()) << " " << pos << " " << length;
 
         messages.add(id, formatDescription(text, pos, length).toUtf8().data(), hint.str());
     }
 }
 
 void CSMTools::Search::searchRecordStateCell(const CSMWorld::IdTableBase* model, const QModelIndex& index,
-    const CSMWorld::UniversalId& id, bool writable, CSMDoc::Messages& messages) const
+    const CSMWorld::UniversalId& id, CSMDoc::Messages& messages) const
 {
-    if (writable)
+    if (isWritable(model, index))
         throw std::logic_error("Record state can not be modified by search and replace");
 
     int data = model->data(index).toInt();
@@ -117,6 +126,11 @@ QString CSMTools::Search::flatten(const QString& text) const
     return flat;
 }
 
+bool CSMTools::Search::isWritable(const CSMWorld::IdTableBase* model, const QModelIndex& index)
+{
+    return model->flags(index) & Qt::ItemIsEditable;
+}
+
 CSMTools::Search::Search()
     : mType(Type_None)
     , mValue(0)
@@ -131,6 +145,7 @@ CSMTools::Search::Search()
 CSMTools::Search::Search(Type type, bool caseSensitive, const std::string& value)
     : mType(type)
     , mText(value)
+    , mSearchText(QString::fromUtf8(value.c_str()))
     , mValue(0)
     , mCase(caseSensitive)
     , mIdColumn(0)
@@ -227,34 +242,36 @@ void CSMTools::Search::configure(const CSMWorld::IdTableBase* model)
 
 void CSMTools::Search::searchRow(const CSMWorld::IdTableBase* model, int row, CSMDoc::Messages& messages) const
 {
-    for (std::set<int>::const_iterator iter(mColumns.begin()); iter != mColumns.end(); ++iter)
-    {
-        QModelIndex index = model->index(row, *iter);
+    if (mColumns.empty())
+        return;
 
-        CSMWorld::UniversalId::Type type
-            = static_cast<CSMWorld::UniversalId::Type>(model->data(model->index(row, mTypeColumn)).toInt());
+    // The id is the same for every column of the row, don't look it up for each cell
+    CSMWorld::UniversalId::Type type
+        = static_cast<CSMWorld::UniversalId::Type>(model->data(model->index(row, mTypeColumn)).toInt());
 
-        CSMWorld::UniversalId id(type, model->data(model->index(row, mIdColumn)).toString().toUtf8().data());
+    CSMWorld::UniversalId id(type, model->data(model->index(row, mIdColumn)).toString().toUtf8().data());
 
-        bool writable = model->flags(index) & Qt::ItemIsEditable;
+    for (std::set<int>::const_iterator iter(mColumns.begin()); iter != mColumns.end(); ++iter)
+    {
+        QModelIndex index = model->index(row, *iter);
 
         switch (mType)
         {
             case Type_Text:
             case Type_Id:
 
-                searchTextCell(model, index, id, writable, messages);
+                searchTextCell(model, index, id, messages);
                 break;
 
             case Type_TextRegEx:
             case Type_IdRegEx:
 
-                searchRegExCell(model, index, id, writable, messages);
+                searchRegExCell(model, index, id, messages);
                 break;
 
             case Type_RecordState:
 
-                searchRecordStateCell(model, index, id, writable, messages);
+                searchRecordStateCell(model, index, id, messages);
                 break;
 
             case Type_None:
@@ -39,6 +39,7 @@ namespace CSMTools
     private:
         Type mType;
         std::string mText;
+        QString mSearchText;
         QRegularExpression mRegExp;
         int mValue;
         bool mCase;
@@ -49,18 +50,20 @@ namespace CSMTools
         int mPaddingAfter;
 
         void searchTextCell(const CSMWorld::IdTableBase* model, const QModelIndex& index,
-            const CSMWorld::UniversalId& id, bool writable, CSMDoc::Messages& messages) const;
+            const CSMWorld::UniversalId& id, CSMDoc::Messages& messages) const;
 
         void searchRegExCell(const CSMWorld::IdTableBase* model, const QModelIndex& index,
-            const CSMWorld::UniversalId& id, bool writable, CSMDoc::Messages& messages) const;
+            const CSMWorld::UniversalId& id, CSMDoc::Messages& messages) const;
 
         void searchRecordStateCell(const CSMWorld::IdTableBase* model, const QModelIndex& index,
-            const CSMWorld::UniversalId& id, bool writable, CSMDoc::Messages& messages) const;
+            const CSMWorld::UniversalId& id, CSMDoc::Messages& messages) const;
 
         QString formatDescription(const QString& description, int pos, int length) const;
 
         QString flatten(const QString& text) const;
 
+        static bool isWritable(const CSMWorld::IdTableBase* model, const QModelIndex& index);
+
     public:
         Search();
 
@@ -91,10 +91,10 @@ namespace CSMWorld
 
         DataType values(size, 0);
 
-        if (land.isDataLoaded(Land::DATA_VNML))
+        if (const Land::LandData* landData = land.getLandData(Land::DATA_VNML))
         {
             for (int i = 0; i < size; ++i)
-                values[i] = land.getLandData()->mNormals[i];
+                values[i] = landData->mNormals[i];
         }
 
         QVariant variant;
@@ -110,6 +110,7 @@ namespace CSMWorld
             throw std::runtime_error("invalid land normals data");
 
         Land copy = record.get();
+        copy.loadAllData();
         copy.add(Land::DATA_VNML);
 
         for (int i = 0; i < values.size(); ++i)
@@ -138,10 +139,10 @@ namespace CSMWorld
 
         DataType values(size, 0);
 
-        if (land.isDataLoaded(Land::DATA_VHGT))
+        if (const Land::LandData* landData = land.getLandData(Land::DATA_VHGT))
         {
             for (int i = 0; i < size; ++i)
-                values[i] = land.getLandData()->mHeights[i];
+                values[i] = landData->mHeights[i];
         }
 
         QVariant variant;
@@ -157,6 +158,7 @@ namespace CSMWorld
             throw std::runtime_error("invalid land heights data");
 
         Land copy = record.get();
+        copy.loadAllData();
         copy.add(Land::DATA_VHGT);
 
         for (int i = 0; i < values.size(); ++i)
@@ -187,10 +189,10 @@ namespace CSMWorld
 
         DataType values(size, 0);
 
-        if (land.isDataLoaded(Land::DATA_VCLR))
+        if (const Land::LandData* landData = land.getLandData(Land::DATA_VCLR))
         {
             for (int i = 0; i < size; ++i)
-                values[i] = land.getLandData()->mColours[i];
+                values[i] = landData->mColours[i];
         }
 
         QVariant variant;
@@ -206,6 +208,7 @@ namespace CSMWorld
             throw std::runtime_error("invalid land colours data");
 
         Land copy = record.get();
+        copy.loadAllData();
         copy.add(Land::DATA_VCLR);
 
         for (int i = 0; i < values.size(); ++i)
@@ -236,10 +239,10 @@ namespace CSMWorld
 
         DataType values(size, 0);
 
-        if (land.isDataLoaded(Land::DATA_VTEX))
+        if (const Land::LandData* landData = land.getLandData(Land::DATA_VTEX))
         {
             for (int i = 0; i < size; ++i)
-                values[i] = land.getLandData()->mTextures[i];
+                values[i] = landData->mTextures[i];
         }
 
         QVariant variant;
@@ -255,6 +258,7 @@ namespace CSMWorld
             throw std::runtime_error("invalid land textures data");
 
         Land copy = record.get();
+        copy.loadAllData();
         copy.add(Land::DATA_VTEX);
 
         for (int i = 0; i < values.size(); ++i)
@@ -2,7 +2,9 @@
 
 #include <algorithm>
 #include <cmath>
+#include <cstring>
 #include <sstream>
+#include <stdexcept>
 #include <unordered_set>
 
 #include <apps/opencs/model/world/columns.hpp>
@@ -23,6 +25,56 @@
 #include "nestedtablewrapper.hpp"
 #include "pathgrid.hpp"
 
+namespace
+{
+    template <class Function>
+    void visitLandData(int type, Function&& function)
+    {
+        if (type == qMetaTypeId<CSMWorld::LandHeightsColumn::DataType>())
+            function(CSMWorld::LandHeightsColumn::DataType());
+        else if (type == qMetaTypeId<CSMWorld::LandNormalsColumn::DataType>())
+            function(CSMWorld::LandNormalsColumn::DataType());
+        else if (type == qMetaTypeId<CSMWorld::LandColoursColumn::DataType>())
+            function(CSMWorld::LandColoursColumn::DataType());
+        else if (type == qMetaTypeId<CSMWorld::LandTexturesColumn::DataType>())
+            function(CSMWorld::LandTexturesColumn::DataType());
+        else
+            throw std::logic_error("Value is not land data");
+    }
+
+    QByteArray getLandBytes(int type, const QVariant& value)
+    {
+        QByteArray bytes;
+        visitLandData(type, [&](auto empty) {
+            using DataType = decltype(empty);
+            const DataType data = value.value<DataType>();
+            bytes = QByteArray(reinterpret_cast<const char*>(data.constData()),
+                static_cast<int>(data.size() * sizeof(typename DataType::value_type)));
+        });
+        return bytes;
+    }
+
+    QVariant makeLandValue(int type, const QByteArray& bytes)
+    {
+        QVariant value;
+        visitLandData(type, [&](auto empty) {
+            using DataType = decltype(empty);
+            DataType data(static_cast<int>(bytes.size() / sizeof(typename DataType::value_type)));
+            std::memcpy(data.data(), bytes.constData(), data.size() * sizeof(typename DataType::value_type));
+            value.setValue(data);
+        });
+        return value;
+    }
+
+    void xorBytes(QByteArray& bytes, const QByteArray& other)
+    {
+        if (bytes.size() != other.size())
+            throw std::logic_error("Land data size has changed");
+        for (int i = 0; i < bytes.size(); ++i)
+            bytes[i] = static_cast<char>(bytes[i] ^ other[i]);
+    }
+}
+
 CSMWorld::TouchCommand::TouchCommand(IdTable& table, const std::string& id, QUndoCommand* parent)
     : QUndoCommand(parent)
     , mTable(table)
@@ -37,6 +89,9 @@ void CSMWorld::TouchCommand::redo()
 {
     mOld = mTable.getRecord(mId).clone();
     mChanged = mTable.touchRecord(mId);
+    // The copy is only needed to undo an actual touch
+    if (!mChanged)
+        mOld.reset();
 }
 
 void CSMWorld::TouchCommand::undo()
@@ -175,6 +230,9 @@ void CSMWorld::TouchLandCommand::onRedo()
 {
     mOld = mLands.getRecord(mId).clone();
     mChanged = mLands.touchRecord(mId);
+    // Land records are large and most touches during terrain editing don't change anything
+    if (!mChanged)
+        mOld.reset();
 }
 
 void CSMWorld::TouchLandCommand::onUndo()
@@ -246,6 +304,67 @@ void CSMWorld::ModifyCommand::undo()
     }
 }
 
+CSMWorld::ModifyLandCommand::ModifyLandCommand(
+    IdTable& model, const QModelIndex& index, const QVariant& newValue, QUndoCommand* parent)
+    : QUndoCommand(parent)
+    , mModel(model)
+    , mIndex(index)
+    , mRecordStateIndex(model.index(index.row(), model.findColumnIndex(Columns::ColumnId_Modification)))
+    , mOldRecordState(RecordBase::State_BaseOnly)
+    , mType(newValue.userType())
+    , mValue(newValue)
+    , mAlreadyApplied(false)
+{
+    setText("Modify " + mModel.headerData(mIndex.column(), Qt::Horizontal, Qt::DisplayRole).toString());
+}
+
+CSMWorld::ModifyLandCommand::ModifyLandCommand(IdTable& model, const QModelIndex& index, const QVariant& oldValue,
+    RecordBase::State oldRecordState, QUndoCommand* parent)
+    : QUndoCommand(parent)
+    , mModel(model)
+    , mIndex(index)
+    , mRecordStateIndex(model.index(index.row(), model.findColumnIndex(Columns::ColumnId_Modification)))
+    , mOldRecordState(oldRecordState)
+    , mType(oldValue.userType())
+    , mValue(oldValue)
+    , mAlreadyApplied(true)
+{
+    setText("Modify " + mModel.headerData(mIndex.column(), Qt::Horizontal, Qt::DisplayRole).toString());
+}
+
+void CSMWorld::ModifyLandCommand::applyDelta()
+{
+    QByteArray bytes = getLandBytes(mType, mModel.data(mIndex, Qt::EditRole));
+    xorBytes(bytes, qUncompress(mDelta));
+    mModel.setData(mIndex, makeLandValue(mType, bytes));
+}
+
+void CSMWorld::ModifyLandCommand::redo()
+{
+    if (!mValue.isValid())
+    {
+        applyDelta();
+        return;
+    }
+
+    // Record state and old data are taken at the first redo, like in ModifyCommand
+    if (!mAlreadyApplied)
+        mOldRecordState = static_cast<RecordBase::State>(mModel.data(mRecordStateIndex).toInt());
+    const QVariant current = mModel.data(mIndex, Qt::EditRole);
+    QByteArray delta = getLandBytes(mType, current);
+    xorBytes(delta, getLandBytes(mType, mValue));
+    mDelta = qCompress(delta);
+    if (!mAlreadyApplied)
+        mModel.setData(mIndex, mValue);
+    mValue = QVariant();
+}
+
+void CSMWorld::ModifyLandCommand::undo()
+{
+    applyDelta();
+    mModel.setData(mRecordStateIndex, mOldRecordState);
+}
+
 void CSMWorld::CreateCommand::applyModifications()
 {
     if (!mNestedValues.empty())
@@ -10,6 +10,7 @@
 #include <vector>
 
 #include <QAbstractItemModel>
+#include <QByteArray>
 #include <QModelIndex>
 #include <QUndoCommand>
 #include <QVariant>
@@ -133,6 +134,39 @@ namespace CSMWorld
         void undo() override;
     };
 
+    /// \brief Modifies land heights, normals, colours or textures.
+    ///
+    /// Brush edits only change a part of the land, so instead of the old and
+    /// the new data the command keeps the compressed XOR of both, which is
+    /// applied to the current data on undo and redo.
+    class ModifyLandCommand : public QUndoCommand
+    {
+        IdTable& mModel;
+        QModelIndex mIndex;
+        QModelIndex mRecordStateIndex;
+        CSMWorld::RecordBase::State mOldRecordState;
+        int mType;
+        QVariant mValue; // only used till the first redo
+        bool mAlreadyApplied;
+        QByteArray mDelta;
+
+        void applyDelta();
+
+    public:
+        ModifyLandCommand(
+            IdTable& model, const QModelIndex& index, const QVariant& newValue, QUndoCommand* parent = nullptr);
+
+        /// \brief Command for a modification that is already in the model.
+        /// \param oldValue Data before the modification
+        /// \param oldRecordState Record state before the modification
+        ModifyLandCommand(IdTable& model, const QModelIndex& index, const QVariant& oldValue,
+            CSMWorld::RecordBase::State oldRecordState, QUndoCommand* parent = nullptr);
+
+        void redo() override;
+
+        void undo() override;
+    };
+
     class CreateCommand : public QUndoCommand
     {
         std::map<int, QVariant> mValues;
@@ -90,15 +90,13 @@ namespace CSMWorld
     {
         record.load(reader, isDeleted);
 
-        // Load all land data for now. A future optimisation may only load non-base data
-        // if a suitable mechanism for avoiding race conditions can be established.
-        int flags = ESM::Land::DATA_VHGT | ESM::Land::DATA_VNML | ESM::Land::DATA_VCLR | ESM::Land::DATA_VTEX;
-        record.loadData(flags);
-
-        // Prevent data from being reloaded.
-        record.mContext.filename.clear();
-        if (!base)
-            record.setPlugin(-1);
+        // The data of base files is loaded when it is used first, the editor never writes to these files. The data of
+        // the edited file is loaded right away, the file is replaced when saving.
+        if (base)
+            return;
+
+        record.loadAllData();
+        record.setPlugin(-1);
     }
 
     template <typename ESXRecordT>
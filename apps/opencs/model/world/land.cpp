@@ -17,6 +17,14 @@ namespace CSMWorld
         ESM::Land::load(esm, isDeleted);
     }
 
+    void Land::loadAllData()
+    {
+        loadData(DATA_VHGT | DATA_VNML | DATA_VCLR | DATA_VTEX);
+
+        // Prevent data from being reloaded.
+        mContext.filename.clear();
+    }
+
     std::string Land::createUniqueRecordId(int x, int y)
     {
         std::ostringstream stream;
@@ -20,6 +20,10 @@ namespace CSMWorld
         /// Loads the metadata and ID
         void load(ESM::ESMReader& esm, bool& isDeleted);
 
+        /// Loads all data and detaches the record from the file it was read from, has to be done before the data
+        /// is changed
+        void loadAllData();
+
         static std::string createUniqueRecordId(int x, int y);
         static void parseUniqueRecordId(const std::string& id, int& x, int& y);
     };
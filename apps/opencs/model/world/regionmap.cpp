@@ -8,6 +8,7 @@
 #include <QVariant>
 
 #include <algorithm>
+#include <memory>
 #include <sstream>
 #include <stdexcept>
 #include <type_traits>
@@ -34,9 +35,17 @@ namespace CSMWorld
 
         // If any part of land is above water, returns > 0 - otherwise returns < 0
         const Land& land = lands.getRecord(landIndex).get();
-        if (land.getLandData())
+        if (land.getLandData() != nullptr)
             return land.getLandData()->mMaxHeight - cell.mWater;
 
+        // Read the heights of land that is not loaded yet without keeping them, the map shows every cell
+        if (land.mDataTypes & ESM::Land::DATA_VHGT)
+        {
+            const auto landData = std::make_unique<ESM::Land::LandData>();
+            land.loadData(ESM::Land::DATA_VHGT, *landData);
+            return landData->mMaxHeight - cell.mWater;
+        }
+
         return 0.0f;
     }
 }
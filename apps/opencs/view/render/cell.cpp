@@ -43,6 +43,17 @@
 #include <apps/opencs/model/world/universalid.hpp>
 #include <apps/opencs/view/render/tagbase.hpp>
 
+namespace
+{
+    bool isInCell(const CSMWorld::CellRef& reference, ESM::RefId cellId)
+    {
+        // The cell of a reference is kept as a string id, comparing it with the cell doesn't need to create an id
+        if (reference.mCell.is<ESM::StringRefId>())
+            return reference.mCell == cellId;
+        return ESM::RefId::stringRefId(reference.mCell.toString()) == cellId;
+    }
+}
+
 namespace CSVRender
 {
     class CellNodeContainer : public osg::Referenced
@@ -98,13 +109,11 @@ bool CSVRender::Cell::addObjects(int start, int end)
 
     for (int i = start; i <= end; ++i)
     {
-        const auto& cellId = ESM::RefId::stringRefId(collection.getRecord(i).get().mCell.toString());
-
-        CSMWorld::RecordBase::State state = collection.getRecord(i).mState;
+        const CSMWorld::Record<CSMWorld::CellRef>& record = collection.getRecord(i);
 
-        if (cellId == mId && state != CSMWorld::RecordBase::State_Deleted)
+        if (record.mState != CSMWorld::RecordBase::State_Deleted && isInCell(record.get(), mId))
         {
-            const std::string& id = collection.getRecord(i).get().mId.getRefIdString();
+            const std::string& id = record.get().mId.getRefIdString();
 
             auto object = std::make_unique<Object>(mData, mCellNode, id, false);
 
@@ -260,29 +269,20 @@ bool CSVRender::Cell::referenceDataChanged(const QModelIndex& topLeft, const QMo
     if (mDeleted)
         return false;
 
-    CSMWorld::IdTable& references
-        = dynamic_cast<CSMWorld::IdTable&>(*mData.getTableModel(CSMWorld::UniversalId::Type_References));
-
-    int idColumn = references.findColumnIndex(CSMWorld::Columns::ColumnId_Id);
-    int cellColumn = references.findColumnIndex(CSMWorld::Columns::ColumnId_Cell);
-    int stateColumn = references.findColumnIndex(CSMWorld::Columns::ColumnId_Modification);
+    const CSMWorld::RefCollection& references = mData.getReferences();
 
     // list IDs in cell
     std::map<std::string, bool> ids; // id, deleted state
 
     for (int i = topLeft.row(); i <= bottomRight.row(); ++i)
     {
-        auto cell
-            = ESM::RefId::stringRefId(references.data(references.index(i, cellColumn)).toString().toUtf8().constData());
+        const CSMWorld::Record<CSMWorld::CellRef>& record = references.getRecord(i);
 
-        if (cell == mId)
+        if (isInCell(record.get(), mId))
         {
-            std::string id = Misc::StringUtils::lowerCase(
-                references.data(references.index(i, idColumn)).toString().toUtf8().constData());
-
-            int state = references.data(references.index(i, stateColumn)).toInt();
+            std::string id = Misc::StringUtils::lowerCase(record.get().mId.getRefIdString());
 
-            ids.insert(std::make_pair(id, state == CSMWorld::RecordBase::State_Deleted));
+            ids.insert(std::make_pair(id, record.mState == CSMWorld::RecordBase::State_Deleted));
         }
     }
 
@@ -310,7 +310,8 @@ bool CSVRender::TerrainSelection::noLandLoaded(const std::string& cellId)
 {
     CSMDoc::Document& document = mWorldspaceWidget->getDocument();
     const CSMWorld::IdCollection<CSMWorld::Land>& landCollection = document.getData().getLand();
-    return !landCollection.getRecord(ESM::RefId::stringRefId(cellId)).get().isDataLoaded(ESM::Land::DATA_VNML);
+    return landCollection.getRecord(ESM::RefId::stringRefId(cellId)).get().getLandData(ESM::Land::DATA_VNML)
+        == nullptr;
 }
 
 bool CSVRender::TerrainSelection::isLandLoaded(const std::string& cellId)
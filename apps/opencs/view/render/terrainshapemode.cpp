@@ -1336,7 +1336,7 @@ void CSVRender::TerrainShapeMode::pushEditToCommand(const CSMWorld::LandHeightsC
         landTable.getModelIndex(cellId, landTable.findColumnIndex(CSMWorld::Columns::ColumnId_LandHeightsIndex)));
 
     QUndoStack& undoStack = document.getUndoStack();
-    undoStack.push(new CSMWorld::ModifyCommand(landTable, index, changedLand));
+    undoStack.push(new CSMWorld::ModifyLandCommand(landTable, index, changedLand));
 }
 
 void CSVRender::TerrainShapeMode::pushNormalsEditToCommand(const CSMWorld::LandNormalsColumn::DataType& newLandGrid,
@@ -1349,7 +1349,7 @@ void CSVRender::TerrainShapeMode::pushNormalsEditToCommand(const CSMWorld::LandN
         landTable.getModelIndex(cellId, landTable.findColumnIndex(CSMWorld::Columns::ColumnId_LandNormalsIndex)));
 
     QUndoStack& undoStack = document.getUndoStack();
-    undoStack.push(new CSMWorld::ModifyCommand(landTable, index, changedLand));
+    undoStack.push(new CSMWorld::ModifyLandCommand(landTable, index, changedLand));
 }
 
 bool CSVRender::TerrainShapeMode::noCell(const std::string& cellId)
@@ -1370,7 +1370,8 @@ bool CSVRender::TerrainShapeMode::noLandLoaded(const std::string& cellId)
 {
     CSMDoc::Document& document = getWorldspaceWidget().getDocument();
     const CSMWorld::IdCollection<CSMWorld::Land>& landCollection = document.getData().getLand();
-    return !landCollection.getRecord(ESM::RefId::stringRefId(cellId)).get().isDataLoaded(ESM::Land::DATA_VNML);
+    return landCollection.getRecord(ESM::RefId::stringRefId(cellId)).get().getLandData(ESM::Land::DATA_VNML)
+        == nullptr;
 }
 
 bool CSVRender::TerrainShapeMode::isLandLoaded(const std::string& cellId)
@@ -1492,8 +1493,8 @@ void CSVRender::TerrainShapeMode::createNewLandData(const CSMWorld::CellCoordina
     QModelIndex indexNormal(
         landTable.getModelIndex(cellId, landTable.findColumnIndex(CSMWorld::Columns::ColumnId_LandNormalsIndex)));
     document.getUndoStack().push(new CSMWorld::TouchLandCommand(landTable, ltexTable, cellId));
-    document.getUndoStack().push(new CSMWorld::ModifyCommand(landTable, indexShape, changedShape));
-    document.getUndoStack().push(new CSMWorld::ModifyCommand(landTable, indexNormal, changedNormals));
+    document.getUndoStack().push(new CSMWorld::ModifyLandCommand(landTable, indexShape, changedShape));
+    document.getUndoStack().push(new CSMWorld::ModifyLandCommand(landTable, indexNormal, changedNormals));
 }
 
 bool CSVRender::TerrainShapeMode::allowLandShapeEditing(const std::string& cellId, bool useTool)
@@ -1643,7 +1644,7 @@ void CSVRender::TerrainShapeMode::fixEdges(CSMWorld::CellCoordinates cellCoords)
     QModelIndex index(
         landTable.getModelIndex(cellId, landTable.findColumnIndex(CSMWorld::Columns::ColumnId_LandHeightsIndex)));
     QUndoStack& undoStack = document.getUndoStack();
-    undoStack.push(new CSMWorld::ModifyCommand(landTable, index, changedLand));
+    undoStack.push(new CSMWorld::ModifyLandCommand(landTable, index, changedLand));
 }
 
 void CSVRender::TerrainShapeMode::dragMoveEvent(QDragMoveEvent* event) {}
@@ -270,6 +270,21 @@ void CSVRender::TerrainTextureMode::dragCompleted(const QPoint& pos)
     {
         CSMDoc::Document& document = getWorldspaceWidget().getDocument();
         QUndoStack& undoStack = document.getUndoStack();
+        CSMWorld::IdTable& landTable
+            = dynamic_cast<CSMWorld::IdTable&>(*document.getData().getTableModel(CSMWorld::UniversalId::Type_Land));
+        CSMWorld::IdTable& ltexTable = dynamic_cast<CSMWorld::IdTable&>(
+            *document.getData().getTableModel(CSMWorld::UniversalId::Type_LandTextures));
+        const int textureColumn = landTable.findColumnIndex(CSMWorld::Columns::ColumnId_LandTexturesIndex);
+
+        for (const auto& [cellId, cell] : mDraggedCells)
+        {
+            QVariant oldTextures;
+            oldTextures.setValue(cell.mTextures);
+            undoStack.push(new CSMWorld::ModifyLandCommand(
+                landTable, landTable.getModelIndex(cellId, textureColumn), oldTextures, cell.mState));
+            undoStack.push(new CSMWorld::TouchLandCommand(landTable, ltexTable, cellId));
+        }
+        mDraggedCells.clear();
 
         CSMWorld::IdCollection<ESM::LandTexture>& landtexturesCollection = document.getData().getLandTextures();
         const int index = landtexturesCollection.searchId(mBrushTexture);
@@ -639,8 +654,24 @@ void CSVRender::TerrainTextureMode::pushEditToCommand(CSMWorld::LandTexturesColu
     QModelIndex index(
         landTable.getModelIndex(cellId, landTable.findColumnIndex(CSMWorld::Columns::ColumnId_LandTexturesIndex)));
 
+    if (mIsEditing)
+    {
+        // Dragging edits the same cells many times, so the model is changed right away and the commands are
+        // pushed when the drag is completed
+        if (!mDraggedCells.contains(cellId))
+        {
+            const int stateColumn = landTable.findColumnIndex(CSMWorld::Columns::ColumnId_Modification);
+            const auto state = static_cast<CSMWorld::RecordBase::State>(
+                landTable.data(landTable.getModelIndex(cellId, stateColumn)).toInt());
+            mDraggedCells.emplace(cellId,
+                DraggedCell{ landTable.data(index).value<CSMWorld::LandTexturesColumn::DataType>(), state });
+        }
+        landTable.setData(index, changedLand);
+        return;
+    }
+
     QUndoStack& undoStack = document.getUndoStack();
-    undoStack.push(new CSMWorld::ModifyCommand(landTable, index, changedLand));
+    undoStack.push(new CSMWorld::ModifyLandCommand(landTable, index, changedLand));
     undoStack.push(new CSMWorld::TouchLandCommand(landTable, ltexTable, cellId));
 }
 
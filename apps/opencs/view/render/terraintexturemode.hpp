@@ -3,6 +3,7 @@
 
 #include "editmode.hpp"
 
+#include <map>
 #include <memory>
 #include <string>
 #include <utility>
@@ -12,6 +13,7 @@
 
 #ifndef Q_MOC_RUN
 #include "../../model/world/columnimp.hpp"
+#include "../../model/world/record.hpp"
 #include "../widget/brushshapes.hpp"
 #include "brushdraw.hpp"
 #endif
@@ -132,6 +134,16 @@ namespace CSVRender
         bool mIsEditing;
         std::shared_ptr<TerrainSelection> mTerrainTextureSelection;
 
+        struct DraggedCell
+        {
+            CSMWorld::LandTexturesColumn::DataType mTextures;
+            CSMWorld::RecordBase::State mState;
+        };
+
+        /// Textures and record states of the cells edited by the current drag before it started, the edits are
+        /// pushed as one command per cell when the drag is completed
+        std::map<std::string, DraggedCell> mDraggedCells;
+
         const int cellSize{ ESM::Land::REAL_SIZE };
         const int landTextureSize{ ESM::Land::LAND_TEXTURE_SIZE };
 
@@ -0,0 +1,65 @@
+#include "benchmark.hpp"
+
+#include <osg/Stats>
+
+#include <algorithm>
+#include <format>
+#include <numeric>
+
+#include "profile.hpp"
+
+namespace OMW
+{
+    namespace
+    {
+        void reportValues(std::string_view label, std::vector<double> values, std::ostream& stream)
+        {
+            if (values.empty())
+                return;
+            std::sort(values.begin(), values.end());
+            const double mean = std::accumulate(values.begin(), values.end(), 0.0) / values.size();
+            const auto percentile = [&](std::size_t value) { return values[(values.size() - 1) * value / 100]; };
+            stream << std::format("{:<12} {:>10.3f} {:>10.3f} {:>10.3f} {:>10.3f} {:>8}\n", label, mean * 1000,
+                percentile(50) * 1000, percentile(95) * 1000, values.back() * 1000, values.size());
+        }
+    }
+
+    Benchmark::Benchmark(std::size_t frames)
+        : mMaxFrames(frames)
+    {
+        mFrameDurations.reserve(frames);
+        forEachUserStatsValue([&](const UserStats& v) {
+            mStats.push_back(Stat{ v.mLabel, v.mTaken, {} });
+            mStats.back().mValues.reserve(frames);
+        });
+    }
+
+    void Benchmark::addFrame(unsigned frameNumber, double frameDuration, const osg::Stats& stats)
+    {
+        if (isDone())
+            return;
+        ++mFrames;
+        mFrameDurations.push_back(frameDuration);
+        // Subsystems that don't run every frame, like the async physics, have no value for some frames
+        for (Stat& stat : mStats)
+        {
+            double value = 0;
+            if (stats.getAttribute(frameNumber, stat.mAttribute, value))
+                stat.mValues.push_back(value);
+        }
+    }
+
+    void Benchmark::report(std::ostream& stream) const
+    {
+        stream << std::format(
+            "{:<12} {:>10} {:>10} {:>10} {:>10} {:>8}\n", "Stat", "Mean ms", "Median ms", "P95 ms", "Max ms", "Frames");
+        reportValues("Frame", mFrameDurations, stream);
+        for (const Stat& stat : mStats)
+        {
+            // Labels of the profiler overlay may start with spaces to show nesting
+            std::string_view label = stat.mLabel;
+            label.remove_prefix(std::min(label.find_first_not_of(" -"), label.size()));
+            reportValues(label, stat.mValues, stream);
+        }
+    }
+}
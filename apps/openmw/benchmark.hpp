@@ -0,0 +1,49 @@
+#ifndef OPENMW_BENCHMARK_H
+#define OPENMW_BENCHMARK_H
+
+#include <cstddef>
+#include <ostream>
+#include <string>
+#include <vector>
+
+namespace osg
+{
+    class Stats;
+}
+
+namespace OMW
+{
+    /// @brief Collects the time taken by every engine subsystem over a fixed number of frames to report them once
+    /// all frames are done.
+    /// @par Times are read from the "engine" stats of the viewer, which have to be collected while benchmarking.
+    class Benchmark
+    {
+    public:
+        explicit Benchmark(std::size_t frames);
+
+        bool isDone() const { return mFrames >= mMaxFrames; }
+
+        std::size_t getFrames() const { return mFrames; }
+
+        /// @param frameDuration time in seconds taken by the whole frame
+        void addFrame(unsigned frameNumber, double frameDuration, const osg::Stats& stats);
+
+        /// Write mean, median, 95th percentile and maximum of every subsystem in milliseconds.
+        void report(std::ostream& stream) const;
+
+    private:
+        struct Stat
+        {
+            std::string mLabel;
+            std::string mAttribute;
+            std::vector<double> mValues;
+        };
+
+        std::size_t mMaxFrames;
+        std::size_t mFrames = 0;
+        std::vector<double> mFrameDurations;
+        std::vector<Stat> mStats;
+    };
+}
+
+#endif
@@ -0,0 +1,56 @@
+#include "deferredtasks.hpp"
+
+#include <osg/Stats>
+
+#include <algorithm>
+#include <tuple>
+
+namespace OMW
+{
+    void DeferredTasks::add(const std::string& name, int priority, std::function<void()> function)
+    {
+        mTasks.push_back(Task{ "Deferred " + name, priority, std::move(function) });
+        mOrder.clear();
+    }
+
+    void DeferredTasks::run(double budget, unsigned frameNumber, osg::Stats& stats)
+    {
+        if (mOrder.size() != mTasks.size())
+        {
+            mOrder.clear();
+            for (Task& task : mTasks)
+                mOrder.push_back(&task);
+        }
+
+        // Tasks delayed for longer go first
+        std::stable_sort(mOrder.begin(), mOrder.end(), [](const Task* left, const Task* right) {
+            return std::tuple(right->mDelayedFrames, left->mPriority)
+                < std::tuple(left->mDelayedFrames, right->mPriority);
+        });
+
+        const bool reportStats = stats.collectStats("resource");
+        const osg::Timer* const timer = osg::Timer::instance();
+        const osg::Timer_t start = timer->tick();
+        mLastSkipped = 0;
+
+        for (Task* task : mOrder)
+        {
+            const osg::Timer_t taskStart = timer->tick();
+            if (budget > 0 && timer->delta_s(start, taskStart) >= budget && task->mDelayedFrames < maxDelayedFrames)
+            {
+                ++task->mDelayedFrames;
+                ++mLastSkipped;
+                continue;
+            }
+
+            task->mFunction();
+            task->mDelayedFrames = 0;
+
+            if (reportStats)
+                stats.setAttribute(frameNumber, task->mStatName, timer->delta_m(taskStart, timer->tick()));
+        }
+
+        if (reportStats)
+            stats.setAttribute(frameNumber, "Deferred Skipped", static_cast<double>(mLastSkipped));
+    }
+}
@@ -0,0 +1,51 @@
+#ifndef OPENMW_DEFERREDTASKS_H
+#define OPENMW_DEFERREDTASKS_H
+
+#include <osg/Timer>
+
+#include <cstddef>
+#include <functional>
+#include <string>
+#include <vector>
+
+namespace osg
+{
+    class Stats;
+}
+
+namespace OMW
+{
+    /// @brief Runs the work that can wait for a later frame once per frame, in priority order while the budget
+    /// lasts.
+    /// @par Tasks that didn't fit into the budget run before the others in the next frame. A task is never delayed for
+    /// more than maxDelayedFrames frames in a row, so the work it does can't pile up.
+    class DeferredTasks
+    {
+    public:
+        static constexpr unsigned maxDelayedFrames = 8;
+
+        /// @param name used for the stats as "Deferred <name>" with the time taken in milliseconds
+        /// @param priority tasks with lower values run first
+        void add(const std::string& name, int priority, std::function<void()> function);
+
+        /// @param budget time in seconds, 0 runs all tasks
+        void run(double budget, unsigned frameNumber, osg::Stats& stats);
+
+        std::size_t getLastSkipped() const { return mLastSkipped; }
+
+    private:
+        struct Task
+        {
+            std::string mStatName;
+            int mPriority;
+            std::function<void()> mFunction;
+            unsigned mDelayedFrames = 0;
+        };
+
+        std::vector<Task> mTasks;
+        std::vector<Task*> mOrder;
+        std::size_t mLastSkipped = 0;
+    };
+}
+
+#endif
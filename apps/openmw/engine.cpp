@@ -2,7 +2,12 @@
 
 #include <cerrno>
 #include <chrono>
+#include <format>
+#include <fstream>
+#include <functional>
 #include <future>
+#include <optional>
+#include <sstream>
 #include <system_error>
 
 #include <osgDB/ReaderWriter>
@@ -13,11 +18,15 @@
 
 #include <components/debug/debuglog.hpp>
 #include <components/debug/gldebug.hpp>
+#include <components/debug/tracing.hpp>
 
+#include <components/misc/framearena.hpp>
 #include <components/misc/rng.hpp>
 #include <components/misc/strings/format.hpp>
 
+#include <components/vfs/accesslog.hpp>
 #include <components/vfs/manager.hpp>
+#include <components/vfs/prefetcher.hpp>
 #include <components/vfs/registerarchives.hpp>
 
 #include <components/sdlutil/imagetosurface.hpp>
@@ -34,6 +43,10 @@
 #include <components/sceneutil/glextensions.hpp>
 #include <components/sceneutil/workqueue.hpp>
 
+#include <components/shader/asyncprogram.hpp>
+#include <components/shader/programbinarycache.hpp>
+#include <components/shader/shadermanager.hpp>
+
 #include <components/files/configurationmanager.hpp>
 
 #include <components/version/version.hpp>
@@ -67,6 +80,8 @@
 #include "mwsound/constants.hpp"
 #include "mwsound/soundmanagerimp.hpp"
 
+#include "mwworld/cell.hpp"
+#include "mwworld/cellstore.hpp"
 #include "mwworld/class.hpp"
 #include "mwworld/datetimemanager.hpp"
 #include "mwworld/worldimp.hpp"
@@ -84,7 +99,9 @@
 
 #include "mwstate/statemanagerimp.hpp"
 
+#include "benchmark.hpp"
 #include "profile.hpp"
+#include "spikedetector.hpp"
 
 namespace
 {
@@ -154,6 +171,9 @@ namespace
             Log(Debug::Info) << "OpenGL Renderer: " << glGetString(GL_RENDERER);
             Log(Debug::Info) << "OpenGL Version: " << glGetString(GL_VERSION);
             glGetIntegerv(GL_MAX_TEXTURE_IMAGE_UNITS, &mMaxTextureImageUnits);
+            mDriver = std::format("{}\n{}\n{}", reinterpret_cast<const char*>(glGetString(GL_VENDOR)),
+                reinterpret_cast<const char*>(glGetString(GL_RENDERER)),
+                reinterpret_cast<const char*>(glGetString(GL_VERSION)));
         }
 
         int getMaxTextureImageUnits() const
@@ -163,8 +183,41 @@ namespace
             return mMaxTextureImageUnits;
         }
 
+        const std::string& getDriver() const { return mDriver; }
+
     private:
         int mMaxTextureImageUnits = 0;
+        std::string mDriver;
+    };
+
+    class CreateSharedContextOperation : public osg::GraphicsOperation
+    {
+    public:
+        explicit CreateSharedContextOperation(SDL_Window* window)
+            : GraphicsOperation("CreateSharedContextOperation", false)
+            , mWindow(window)
+        {
+        }
+
+        void operator()(osg::GraphicsContext* /*graphicsContext*/) override
+        {
+            // Creating a context makes it current, the context of the window has to stay current for the rest of the
+            // realize operations
+            const SDL_GLContext current = SDL_GL_GetCurrentContext();
+            SDL_GL_SetAttribute(SDL_GL_SHARE_WITH_CURRENT_CONTEXT, 1);
+            mContext = SDL_GL_CreateContext(mWindow);
+            SDL_GL_SetAttribute(SDL_GL_SHARE_WITH_CURRENT_CONTEXT, 0);
+            if (mContext == nullptr)
+                Log(Debug::Warning) << "Async program compilation is disabled: failed to create a shared context: "
+                                    << SDL_GetError();
+            SDL_GL_MakeCurrent(mWindow, current);
+        }
+
+        SDL_GLContext getContext() const { return mContext; }
+
+    private:
+        SDL_Window* mWindow;
+        SDL_GLContext mContext = nullptr;
     };
 
     void reportStats(unsigned frameNumber, osgViewer::Viewer& viewer, std::ostream& stream)
@@ -175,6 +228,82 @@ namespace
         for (osg::Camera* camera : cameras)
             camera->getStats()->report(stream, frameNumber);
     }
+
+    class WriteTraceWorkItem : public SceneUtil::WorkItem
+    {
+    public:
+        explicit WriteTraceWorkItem(std::filesystem::path path, std::vector<Debug::TraceThread>&& threads)
+            : mPath(std::move(path))
+            , mThreads(std::move(threads))
+        {
+        }
+
+        void doWork() override
+        {
+            std::ofstream stream(mPath, std::ios::binary);
+            if (!stream.is_open())
+            {
+                Log(Debug::Warning) << "Failed to open " << mPath << " to write trace";
+                return;
+            }
+            Debug::Tracing::writeChromeTrace(mThreads, stream);
+            Log(Debug::Info) << "Trace written to " << mPath;
+        }
+
+    private:
+        const std::filesystem::path mPath;
+        const std::vector<Debug::TraceThread> mThreads;
+    };
+
+    class TraceHandler : public osgGA::GUIEventHandler
+    {
+    public:
+        explicit TraceHandler(std::function<void()> writeTrace)
+            : mWriteTrace(std::move(writeTrace))
+        {
+        }
+
+        bool handle(const osgGA::GUIEventAdapter& ea, osgGA::GUIActionAdapter& /*aa*/) override
+        {
+            if (ea.getHandled() || ea.getEventType() != osgGA::GUIEventAdapter::KEYDOWN
+                || ea.getKey() != osgGA::GUIEventAdapter::KEY_F7)
+                return false;
+            mWriteTrace();
+            return true;
+        }
+
+    private:
+        std::function<void()> mWriteTrace;
+    };
+
+    // Logs how long each step of the engine initialisation takes, a step lasts until the next one is started
+    class StartupSteps
+    {
+    public:
+        ~StartupSteps() { finish(); }
+
+        void start(std::string_view name)
+        {
+            finish();
+            mName = name;
+            mStart = std::chrono::steady_clock::now();
+        }
+
+        void finish()
+        {
+            if (mName.empty())
+                return;
+            Log(Debug::Info) << "Startup step \"" << mName << "\" took "
+                             << std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - mStart)
+                                    .count()
+                             << " ms";
+            mName = {};
+        }
+
+    private:
+        std::string_view mName;
+        std::chrono::steady_clock::time_point mStart;
+    };
 }
 
 void OMW::Engine::executeLocalScripts()
@@ -185,6 +314,9 @@ void OMW::Engine::executeLocalScripts()
     std::pair<ESM::RefId, MWWorld::Ptr> script;
     while (localScripts.getNext(script))
     {
+        // Such a script would only find OnActivate unset again
+        if (script.second.getRefData().isWaitingForActivation() && mScriptManager->isActivationOnly(script.first))
+            continue;
         MWScript::InterpreterContext interpreterContext(&script.second.getRefData().getLocals(), script.second);
         mScriptManager->run(script.first, interpreterContext);
     }
@@ -198,6 +330,9 @@ bool OMW::Engine::frame(unsigned frameNumber, float frametime)
 
     mEnvironment.setFrameDuration(frametime);
 
+    if (mStartupProfile != nullptr && mStateManager->getState() == MWBase::StateManager::State_Running)
+        stopStartupProfile();
+
     try
     {
         // update input
@@ -281,7 +416,7 @@ bool OMW::Engine::frame(unsigned frameNumber, float frametime)
             // Update A-Life simulation
             if (mStateManager->getState() != MWBase::StateManager::State_NoGame && !paused)
             {
-                double gameHours = mWorld->getTimeManager()->getGameTime();
+                double gameHours = mWorld->getTimeManager()->getGameTime() / 3600.0;
                 MWMechanics::getALifeSimulation().update(gameHours, frametime);
             }
 
@@ -329,7 +464,10 @@ bool OMW::Engine::frame(unsigned frameNumber, float frametime)
     if (reportResource)
         stats->setAttribute(frameNumber, "UnrefQueue", static_cast<double>(mUnrefQueue->getSize()));
 
-    mUnrefQueue->flush(*mWorkQueue);
+    {
+        ScopedProfile<UserStatsType::Deferred> profile(frameStart, frameNumber, *timer, *stats);
+        mDeferredTasks.run(Settings::general().mDeferredTaskBudget / 1000.0, frameNumber, *stats);
+    }
 
     if (reportResource)
     {
@@ -339,6 +477,7 @@ bool OMW::Engine::frame(unsigned frameNumber, float frametime)
 
         stats->setAttribute(frameNumber, "WorkQueue", static_cast<double>(mWorkQueue->getNumItems()));
         stats->setAttribute(frameNumber, "WorkThread", static_cast<double>(mWorkQueue->getNumActiveThreads()));
+        SceneUtil::reportStats(frameNumber, mWorkQueue->getStats(), *stats);
 
         mMechanicsManager->reportStats(frameNumber, *stats);
         mWorld->reportStats(frameNumber, *stats);
@@ -359,10 +498,30 @@ bool OMW::Engine::frame(unsigned frameNumber, float frametime)
     // if there is a separate Lua thread, it starts the update now
     mLuaWorker->allowUpdate(frameStart, frameNumber, *stats);
 
-    mViewer->renderingTraversals();
+    {
+        Debug::TraceZone zone("Render");
+        mViewer->renderingTraversals();
+    }
 
     mLuaWorker->finishUpdate(frameStart, frameNumber, *stats);
 
+    if (reportResource)
+    {
+        std::size_t frameArenaBytes = 0;
+        for (std::size_t i = 0; i < Misc::frameArenaUserCount; ++i)
+        {
+            const auto user = static_cast<Misc::FrameArenaUser>(i);
+            const Misc::FrameArenaStats arenaStats = Misc::getFrameArenaStats(user);
+            stats->setAttribute(frameNumber, "FrameArena " + std::string(Misc::getFrameArenaUserName(user)),
+                static_cast<double>(arenaStats.mAllocations));
+            frameArenaBytes += arenaStats.mBytes;
+        }
+        stats->setAttribute(frameNumber, "FrameArena Bytes", static_cast<double>(frameArenaBytes));
+    }
+
+    // Everything allocated from the arena during the frame is released at once
+    Misc::resetFrameArena();
+
     return true;
 }
 
@@ -409,6 +568,8 @@ OMW::Engine::~Engine()
     if (mScreenCaptureOperation != nullptr)
         mScreenCaptureOperation->stop();
 
+    mPrefetcher = nullptr;
+
     mMechanicsManager = nullptr;
     mDialogueManager = nullptr;
     mJournal = nullptr;
@@ -428,6 +589,9 @@ OMW::Engine::~Engine()
     mUnrefQueue = nullptr;
     mWorkQueue = nullptr;
 
+    if (mAsyncProgramCompiler)
+        mAsyncProgramCompiler->stop();
+
     mViewer = nullptr;
 
     mResourceSystem.reset();
@@ -491,6 +655,32 @@ void OMW::Engine::setSkipMenu(bool skipMenu, bool newGame)
     mNewGame = newGame;
 }
 
+void OMW::Engine::startStartupProfile()
+{
+    const std::filesystem::path path = mCfgMgr.getUserDataPath() / "startupprofile.log";
+
+    std::vector<VFS::Path::Normalized> paths;
+    if (std::ifstream stream(path); stream)
+        paths = VFS::readAccessLog(stream);
+
+    if (!paths.empty())
+    {
+        Log(Debug::Info) << "Prefetching " << paths.size() << " files from the startup profile";
+        mPrefetcher = std::make_unique<VFS::Prefetcher>(*mVFS, std::move(paths));
+    }
+
+    auto profile = std::make_unique<VFS::AccessLog>(path);
+    mStartupProfile = profile.get();
+    mVFS->addAccessLog(std::move(profile));
+}
+
+void OMW::Engine::stopStartupProfile()
+{
+    mStartupProfile->stop();
+    mStartupProfile = nullptr;
+    mPrefetcher = nullptr;
+}
+
 void OMW::Engine::createWindow()
 {
     const int screen = Settings::video().mScreen;
@@ -614,7 +804,7 @@ void OMW::Engine::createWindow()
         if (traits->depth < 24)
             Log(Debug::Warning) << "Warning: Framebuffer only has " << traits->depth << " bits of depth precision.";
 
-        traits->alpha = 0; // set to 0 to stop ScreenCaptureHandler reading the alpha channel
+        traits->alpha = 0;
     }
 
     osg::ref_ptr<osg::Camera> camera = mViewer->getCamera();
@@ -633,6 +823,13 @@ void OMW::Engine::createWindow()
     realizeOperations->add(mSelectDepthFormatOperation);
     realizeOperations->add(mSelectColorFormatOperation);
 
+    osg::ref_ptr<CreateSharedContextOperation> createSharedContextOp;
+    if (Settings::shaders().mAsyncProgramCompilation)
+    {
+        createSharedContextOp = new CreateSharedContextOperation(mWindow);
+        realizeOperations->add(createSharedContextOp);
+    }
+
     if (Stereo::getStereo())
     {
         Stereo::Settings settings;
@@ -694,6 +891,20 @@ void OMW::Engine::createWindow()
 
     mViewer->realize();
     mGlMaxTextureImageUnits = identifyOp->getMaxTextureImageUnits();
+    mGlDriver = identifyOp->getDriver();
+
+    if (createSharedContextOp != nullptr && createSharedContextOp->getContext() != nullptr)
+    {
+        SDL_Window* const window = mWindow;
+        const SDL_GLContext context = createSharedContextOp->getContext();
+        mAsyncProgramCompiler = new Shader::AsyncProgramCompiler(
+            graphicsWindow->getState()->getContextID(),
+            [=] { return SDL_GL_MakeCurrent(window, context) == 0; },
+            [=] {
+                SDL_GL_MakeCurrent(window, nullptr);
+                SDL_GL_DeleteContext(context);
+            });
+    }
 
     mViewer->getEventQueue()->getCurrentEventState()->setWindowRectangle(
         0, 0, graphicsWindow->getTraits()->width, graphicsWindow->getTraits()->height);
@@ -726,6 +937,9 @@ void OMW::Engine::setWindowIcon()
 
 void OMW::Engine::prepareEngine()
 {
+    StartupSteps steps;
+
+    steps.start("window");
     mStateManager = std::make_unique<MWState::StateManager>(mCfgMgr.getUserDataPath() / "saves", mContentFiles);
     mEnvironment.setStateManager(*mStateManager);
 
@@ -738,21 +952,65 @@ void OMW::Engine::prepareEngine()
 
     createWindow();
 
+    steps.start("VFS");
     mVFS = std::make_unique<VFS::Manager>();
+    if (Settings::general().mRecordResourceAccess)
+        mVFS->addAccessLog(std::make_unique<VFS::AccessLog>(mCfgMgr.getUserDataPath() / "resourceaccess.log"));
 
-    VFS::registerArchives(mVFS.get(), mFileCollections, mArchives, true, &mEncoder.get()->getStatelessEncoder());
+    VFS::registerArchives(mVFS.get(), mFileCollections, mArchives, true, &mEncoder.get()->getStatelessEncoder(),
+        Settings::general().mMemoryMappedArchives);
 
+    if (Settings::general().mStartupPrefetch)
+        startStartupProfile();
+
+    // Opening the audio device and probing HRTF don't depend on anything but the VFS and take a while with some
+    // drivers, so let them run while the resource system and the GUI are set up
+    auto soundManager = std::async(std::launch::async, [vfs = mVFS.get(), useSound = mUseSound] {
+        StartupSteps soundSteps;
+        soundSteps.start("sound");
+        return std::make_unique<MWSound::SoundManager>(vfs, useSound);
+    });
+
+    steps.start("resource system");
     mResourceSystem = std::make_unique<Resource::ResourceSystem>(
         mVFS.get(), Settings::cells().mCacheExpiryDelay, &mEncoder.get()->getStatelessEncoder());
+    mResourceSystem->setCacheShardSizeLimit(Settings::cells().mCacheShardSizeLimit);
     mResourceSystem->getSceneManager()->getShaderManager().setMaxTextureUnits(mGlMaxTextureImageUnits);
+    if (Settings::shaders().mProgramBinaryCache)
+    {
+        if (osg::isGLExtensionOrVersionSupported(
+                SceneUtil::getGLExtensions().contextID, "GL_ARB_get_program_binary", 4.1f))
+        {
+            Shader::ShaderManager& shaderManager = mResourceSystem->getSceneManager()->getShaderManager();
+            shaderManager.enableProgramBinaryCache(mCfgMgr.getUserDataPath() / "shadercache", mGlDriver);
+            mViewer->getCamera()->getGraphicsContext()->add(
+                new Shader::ProgramBinaryCacheOperation(*shaderManager.getProgramBinaryCache()));
+        }
+        else
+            Log(Debug::Warning) << "Program binary cache is disabled: GL_ARB_get_program_binary is not supported";
+    }
+    if (mAsyncProgramCompiler != nullptr)
+    {
+        mResourceSystem->getSceneManager()->getShaderManager().setAsyncProgramCompiler(mAsyncProgramCompiler);
+        Shader::allowSkippingDraws(*mViewer->getCamera());
+    }
     mResourceSystem->getSceneManager()->setUnRefImageDataAfterApply(
         false); // keep to Off for now to allow better state sharing
     mResourceSystem->getSceneManager()->setFilterSettings(Settings::general().mTextureMagFilter,
         Settings::general().mTextureMinFilter, Settings::general().mTextureMipmap,
         static_cast<float>(Settings::general().mAnisotropy));
+    if (Settings::cells().mMeshCache)
+        mResourceSystem->getSceneManager()->enableMeshCache(mCfgMgr.getUserDataPath() / "meshcache",
+            static_cast<std::uint64_t>(Settings::cells().mMeshCacheSize) * 1024 * 1024);
+    if (Settings::vramManagement().mEnableTextureStreaming)
+        mResourceSystem->getImageManager()->setStreamedImageSize(Settings::vramManagement().mStreamedTextureSize);
     mEnvironment.setResourceSystem(*mResourceSystem);
 
     mWorkQueue = new SceneUtil::WorkQueue(Settings::cells().mPreloadNumThreads);
+    if (Settings::vramManagement().mTextureCompressionCache)
+        mResourceSystem->getImageManager()->enableTextureCache(mCfgMgr.getUserDataPath() / "texturecache",
+            static_cast<std::uint64_t>(Settings::vramManagement().mTextureCompressionCacheSize) * 1024 * 1024,
+            mWorkQueue, Settings::shaders().mNormalMapPattern, Settings::shaders().mNormalHeightMapPattern);
     mUnrefQueue = std::make_unique<SceneUtil::UnrefQueue>();
 
     mScreenCaptureOperation = new SceneUtil::AsyncScreenCaptureOperation(mWorkQueue,
@@ -761,20 +1019,22 @@ void OMW::Engine::prepareEngine()
             Settings::general().mNotifyOnSavedScreenshot ? std::function<void(std::string)>(ScreenCaptureMessageBox{})
                                                          : std::function<void(std::string)>(IgnoreString{})));
 
-    mScreenCaptureHandler = new osgViewer::ScreenCaptureHandler(mScreenCaptureOperation);
+    mScreenCapture = new SceneUtil::AsyncScreenCapture(mScreenCaptureOperation);
 
-    mViewer->addEventHandler(mScreenCaptureHandler);
+    mViewer->getCamera()->getGraphicsContext()->setSwapCallback(mScreenCapture);
 
+    steps.start("l10n and Lua");
     mL10nManager = std::make_unique<L10n::Manager>(mVFS.get());
     mL10nManager->setPreferredLocales(Settings::general().mPreferredLocales, Settings::general().mGmstOverridesL10n);
     mEnvironment.setL10nManager(*mL10nManager);
 
-    mLuaManager = std::make_unique<MWLua::LuaManager>(mVFS.get(), mResDir / "lua_libs");
+    mLuaManager = std::make_unique<MWLua::LuaManager>(mVFS.get(), mResDir / "lua_libs", mCfgMgr.getUserDataPath());
     mEnvironment.setLuaManager(*mLuaManager);
 
     // Create input and UI first to set up a bootstrapping environment for
     // showing a loading screen and keeping the window responsive while doing so
 
+    steps.start("GUI and input");
     const auto keybinderUser = mCfgMgr.getUserConfigPath() / "input_v3.xml";
     bool keybinderUserExists = std::filesystem::exists(keybinderUser);
     if (!keybinderUserExists)
@@ -830,15 +1090,17 @@ void OMW::Engine::prepareEngine()
         Version::getOpenmwVersionDescription(), shadersSupported, mCfgMgr);
     mEnvironment.setWindowManager(*mWindowManager);
 
-    mInputManager = std::make_unique<MWInput::InputManager>(mWindow, mViewer, mScreenCaptureHandler, keybinderUser,
+    mInputManager = std::make_unique<MWInput::InputManager>(mWindow, mViewer, mScreenCapture, keybinderUser,
         keybinderUserExists, userGameControllerdb, gameControllerdb, mGrab);
     mEnvironment.setInputManager(*mInputManager);
 
     // Create sound system
-    mSoundManager = std::make_unique<MWSound::SoundManager>(mVFS.get(), mUseSound);
+    steps.start("waiting for sound");
+    mSoundManager = soundManager.get();
     mEnvironment.setSoundManager(*mSoundManager);
 
     // Create the world
+    steps.start("content files");
     mWorld = std::make_unique<MWWorld::World>(
         mResourceSystem.get(), mActivationDistanceOverride, mCellName, mCfgMgr.getUserDataPath());
     mEnvironment.setWorld(*mWorld);
@@ -857,6 +1119,12 @@ void OMW::Engine::prepareEngine()
             mWindowManager->playVideo(logo, true);
     }
 
+    // Link the programs of the previous session while the loading screen is shown
+    mResourceSystem->getSceneManager()->getShaderManager().warmUpPrograms();
+
+    // Nothing reads the Lua storage until the scripts start, so load it while the content files are loaded
+    mLuaManager->loadPermanentStorage(mCfgMgr.getUserConfigPath());
+
     listener->loadingOn();
     {
         using namespace std::chrono_literals;
@@ -866,7 +1134,13 @@ void OMW::Engine::prepareEngine()
     }
     listener->loadingOff();
 
+    steps.start("world");
     mWorld->init(mMaxRecastLogLevel, mViewer, std::move(rootNode), mWorkQueue.get(), *mUnrefQueue);
+    mDeferredTasks.add("UnrefQueue", 0, [this] { mUnrefQueue->flush(*mWorkQueue); });
+    mDeferredTasks.add("CellPreloader", 1, [this] {
+        if (mStateManager->getState() != MWBase::StateManager::State_NoGame)
+            mWorld->getWorldScene().updateCache();
+    });
     mEnvironment.setWorldScene(mWorld->getWorldScene());
     mWorld->setupPlayer();
     mWorld->setRandomSeed(mRandomSeed);
@@ -888,10 +1162,12 @@ void OMW::Engine::prepareEngine()
             }
         });
 
+    steps.start("UI");
     mWindowManager->setStore(mWorld->getStore());
     mWindowManager->initUI();
 
     // Load translation data
+    steps.start("scripts and dialogue");
     mTranslationDataStorage.setEncoder(mEncoder.get());
     for (auto& mContentFile : mContentFiles)
         mTranslationDataStorage.loadTranslationData(mFileCollections, mContentFile);
@@ -932,7 +1208,7 @@ void OMW::Engine::prepareEngine()
                              << 100 * static_cast<double>(result.second) / result.first << "%)";
     }
 
-    mLuaManager->loadPermanentStorage(mCfgMgr.getUserConfigPath());
+    steps.start("Lua");
     mLuaManager->init();
 
     // starts a separate lua thread if "lua num threads" > 0
@@ -1001,6 +1277,25 @@ void OMW::Engine::go()
     osg::ref_ptr<Resource::StatsHandler> resourcesHandler = new Resource::StatsHandler(stats.is_open(), *mVFS);
     mViewer->addEventHandler(resourcesHandler);
 
+    const float frameSpikeFactor = Settings::general().mFrameSpikeFactor;
+    if (mBenchmarkFrames != 0 || frameSpikeFactor > 0)
+    {
+        statsHandler->setCollectEngineStats(true);
+        mViewer->getViewerStats()->collectStats("engine", true);
+    }
+    if (frameSpikeFactor > 0)
+    {
+        resourcesHandler->setCollectResourceStats(true);
+        mViewer->getViewerStats()->collectStats("resource", true);
+    }
+
+    Debug::Tracing::setCapacity(Settings::general().mTraceBufferSize);
+    if (Debug::Tracing::isEnabled())
+    {
+        Debug::Tracing::setThreadName("Main");
+        mViewer->addEventHandler(new TraceHandler([this] { writeTrace(); }));
+    }
+
     if (stats.is_open())
         Resource::collectStatistics(*mViewer);
 
@@ -1033,26 +1328,90 @@ void OMW::Engine::go()
         mWindowManager->executeInConsole(mStartupScript);
     }
 
+    std::optional<Benchmark> benchmark;
+    if (mBenchmarkFrames != 0)
+    {
+        Log(Debug::Info) << "Benchmarking " << mBenchmarkFrames << " frames";
+        benchmark.emplace(mBenchmarkFrames);
+    }
+
+    std::optional<SpikeDetector> spikeDetector;
+    if (frameSpikeFactor > 0)
+        spikeDetector.emplace(frameSpikeFactor);
+
     // Start the main rendering loop
     MWWorld::DateTimeManager& timeManager = *mWorld->getTimeManager();
     Misc::FrameRateLimiter frameRateLimiter = Misc::makeFrameRateLimiter(mEnvironment.getFrameRateLimit());
     const std::chrono::steady_clock::duration maxSimulationInterval(std::chrono::milliseconds(200));
+    // Benchmarks simulate the same time every frame to not depend on how fast the machine is
+    constexpr double benchmarkFrameTime = 1.0 / 60.0;
+    const double traceFrameThreshold = Settings::general().mTraceFrameThreshold / 1000.0;
+    // Stutters often come in series, tracing every one of them would only add more
+    constexpr std::chrono::seconds minAutomaticTraceInterval(10);
+    std::chrono::steady_clock::time_point nextAutomaticTrace{};
     while (!mViewer->done() && !mStateManager->hasQuitRequest())
     {
-        const double dt = std::chrono::duration_cast<std::chrono::duration<double>>(
-                              std::min(frameRateLimiter.getLastFrameDuration(), maxSimulationInterval))
-                              .count()
-            * timeManager.getSimulationTimeScale();
+        double dt = benchmarkFrameTime;
+        if (!benchmark.has_value())
+            dt = std::chrono::duration_cast<std::chrono::duration<double>>(
+                std::min(frameRateLimiter.getLastFrameDuration(), maxSimulationInterval))
+                     .count();
+        dt *= timeManager.getSimulationTimeScale();
 
         mViewer->advance(timeManager.getRenderingSimulationTime());
 
         const unsigned frameNumber = mViewer->getFrameStamp()->getFrameNumber();
+        const osg::Timer_t frameStart = osg::Timer::instance()->tick();
 
-        if (!frame(frameNumber, static_cast<float>(dt)))
+        bool rendered = false;
+        {
+            Debug::TraceZone zone("Frame");
+            rendered = frame(frameNumber, static_cast<float>(dt));
+        }
+        if (!rendered)
         {
             std::this_thread::sleep_for(std::chrono::milliseconds(5));
             continue;
         }
+
+        const double frameDuration = osg::Timer::instance()->delta_s(frameStart, osg::Timer::instance()->tick());
+
+        if (traceFrameThreshold > 0 && frameDuration > traceFrameThreshold && Debug::Tracing::isEnabled())
+        {
+            const auto now = std::chrono::steady_clock::now();
+            if (now >= nextAutomaticTrace)
+            {
+                Log(Debug::Info) << "Frame " << frameNumber << " took " << frameDuration * 1000 << " ms";
+                writeTrace();
+                nextAutomaticTrace = now + minAutomaticTraceInterval;
+            }
+        }
+
+        const bool running = mStateManager->getState() == MWState::StateManager::State_Running;
+
+        if (spikeDetector.has_value() && running)
+        {
+            if (const std::optional<double> percentile = spikeDetector->addFrame(frameDuration))
+            {
+                std::ostringstream report;
+                reportSpike(frameNumber, frameDuration, *percentile, getPlayerLocation(), *mViewer->getViewerStats(),
+                    report);
+                Log(Debug::Warning) << report.str();
+            }
+        }
+
+        if (benchmark.has_value() && running)
+        {
+            benchmark->addFrame(frameNumber, frameDuration, *mViewer->getViewerStats());
+            if (benchmark->isDone())
+            {
+                std::ostringstream report;
+                benchmark->report(report);
+                Log(Debug::Info) << "Benchmark results:\n" << report.str();
+                mStateManager->requestQuit();
+            }
+        }
+
         timeManager.updateIsPaused();
         if (!timeManager.isPaused())
         {
@@ -1075,7 +1434,8 @@ void OMW::Engine::go()
             }
         }
 
-        frameRateLimiter.limit();
+        if (!benchmark.has_value())
+            frameRateLimiter.limit();
     }
 
     mLuaWorker->join();
@@ -1086,6 +1446,27 @@ void OMW::Engine::go()
     mLuaManager->savePermanentStorage(mCfgMgr.getUserConfigPath());
 }
 
+std::string OMW::Engine::getPlayerLocation() const
+{
+    const MWWorld::ConstPtr player = mWorld->getPlayerConstPtr();
+    if (player.isEmpty() || !player.isInCell())
+        return "no cell";
+    const osg::Vec3f position = player.getRefData().getPosition().asVec3();
+    return std::format("{} ({:.0f}, {:.0f}, {:.0f})", player.getCell()->getCell()->getDescription(), position.x(),
+        position.y(), position.z());
+}
+
+void OMW::Engine::writeTrace()
+{
+    std::vector<Debug::TraceThread> threads = Debug::Tracing::collect();
+    const auto now = std::chrono::floor<std::chrono::seconds>(std::chrono::system_clock::now());
+    const std::filesystem::path path = mCfgMgr.getLogPath() / std::format("openmw-trace-{:%Y%m%d-%H%M%S}.json", now);
+    // Writing takes a while, the zones are only copied in the frame
+    osg::ref_ptr<WriteTraceWorkItem> item = new WriteTraceWorkItem(path, std::move(threads));
+    item->setPriority(SceneUtil::WorkPriority::Low);
+    mWorkQueue->addWorkItem(item);
+}
+
 void OMW::Engine::setCompileAll(bool all)
 {
     mCompileAll = all;
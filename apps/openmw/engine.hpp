@@ -15,6 +15,8 @@
 
 #include "mwbase/environment.hpp"
 
+#include "deferredtasks.hpp"
+
 namespace Resource
 {
     class ResourceSystem;
@@ -23,13 +25,16 @@ namespace Resource
 namespace SceneUtil
 {
     class WorkQueue;
+    class AsyncScreenCapture;
     class AsyncScreenCaptureOperation;
     class UnrefQueue;
 }
 
 namespace VFS
 {
+    class AccessLog;
     class Manager;
+    class Prefetcher;
 }
 
 namespace Compiler
@@ -48,14 +53,14 @@ namespace Stereo
     class Manager;
 }
 
-namespace Files
+namespace Shader
 {
-    struct ConfigurationManager;
+    class AsyncProgramCompiler;
 }
 
-namespace osgViewer
+namespace Files
 {
-    class ScreenCaptureHandler;
+    struct ConfigurationManager;
 }
 
 namespace SceneUtil
@@ -127,6 +132,9 @@ namespace OMW
     {
         SDL_Window* mWindow;
         std::unique_ptr<VFS::Manager> mVFS;
+        std::unique_ptr<VFS::Prefetcher> mPrefetcher;
+        // Owned by mVFS, nullptr once the first gameplay frame is reached
+        VFS::AccessLog* mStartupProfile = nullptr;
         std::unique_ptr<Resource::ResourceSystem> mResourceSystem;
         osg::ref_ptr<SceneUtil::WorkQueue> mWorkQueue;
         std::unique_ptr<SceneUtil::UnrefQueue> mUnrefQueue;
@@ -149,16 +157,19 @@ namespace OMW
         std::vector<std::string> mArchives;
         std::filesystem::path mResDir;
         osg::ref_ptr<osgViewer::Viewer> mViewer;
-        osg::ref_ptr<osgViewer::ScreenCaptureHandler> mScreenCaptureHandler;
+        osg::ref_ptr<SceneUtil::AsyncScreenCapture> mScreenCapture;
         osg::ref_ptr<SceneUtil::AsyncScreenCaptureOperation> mScreenCaptureOperation;
         osg::ref_ptr<SceneUtil::SelectDepthFormatOperation> mSelectDepthFormatOperation;
         osg::ref_ptr<SceneUtil::Color::SelectColorFormatOperation> mSelectColorFormatOperation;
+        osg::ref_ptr<Shader::AsyncProgramCompiler> mAsyncProgramCompiler;
         std::string mCellName;
         std::vector<std::string> mContentFiles;
         std::vector<std::string> mGroundcoverFiles;
 
         std::unique_ptr<Stereo::Manager> mStereoManager;
 
+        DeferredTasks mDeferredTasks;
+
         bool mSkipMenu;
         bool mUseSound;
         bool mCompileAll;
@@ -174,6 +185,7 @@ namespace OMW
 
         bool mExportFonts;
         unsigned int mRandomSeed;
+        std::size_t mBenchmarkFrames = 0;
         Debug::Level mMaxRecastLogLevel = Debug::Error;
 
         Compiler::Extensions mExtensions;
@@ -185,6 +197,7 @@ namespace OMW
 
         Files::ConfigurationManager& mCfgMgr;
         int mGlMaxTextureImageUnits;
+        std::string mGlDriver;
 
         // not implemented
         Engine(const Engine&);
@@ -200,6 +213,15 @@ namespace OMW
         void createWindow();
         void setWindowIcon();
 
+        /// Read the files recorded by the last start ahead and record the ones opened by this start
+        void startStartupProfile();
+        void stopStartupProfile();
+
+        /// Write the zones collected by the tracer into the log directory on the work queue
+        void writeTrace();
+
+        std::string getPlayerLocation() const;
+
     public:
         Engine(Files::ConfigurationManager& configurationManager);
         virtual ~Engine();
@@ -265,6 +287,10 @@ namespace OMW
         void setRandomSeed(unsigned int seed);
 
         void setRecastMaxLogLevel(Debug::Level value) { mMaxRecastLogLevel = value; }
+
+        /// Run the given number of frames with a fixed frame time once the game is running, report the time taken by
+        /// every subsystem and quit. 0 disables benchmarking.
+        void setBenchmarkFrames(std::size_t frames) { mBenchmarkFrames = frames; }
     };
 }
 
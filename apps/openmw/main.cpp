@@ -157,6 +157,11 @@ bool parseOptions(int argc, char** argv, OMW::Engine& engine, Files::Configurati
     engine.setActivationDistanceOverride(variables["activate-dist"].as<int>());
     engine.enableFontExport(variables["export-fonts"].as<bool>());
     engine.setRandomSeed(variables["random-seed"].as<unsigned int>());
+    engine.setBenchmarkFrames(variables["benchmark-frames"].as<std::size_t>());
+    if (variables["benchmark-frames"].as<std::size_t>() != 0 && !variables["skip-menu"].as<bool>()
+        && variables["load-savegame"].as<Files::MaybeQuotedPath>().empty())
+        Log(Debug::Warning) << "Warning: benchmark-frames used without skip-menu or load-savegame -> benchmark starts "
+                               "once a game is started from the main menu";
 
     return true;
 }
@@ -163,6 +163,10 @@ namespace MWBase
             = 0;
 
         virtual std::string formatResourceUsageStats() const = 0;
+
+        // Writes per script handler profile as a tab separated table to the user data directory. Returns path to the
+        // written file.
+        virtual std::filesystem::path exportResourceUsageStats() const = 0;
     };
 
 }
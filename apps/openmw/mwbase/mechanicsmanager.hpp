@@ -309,6 +309,9 @@ namespace MWBase
         virtual float getAngleToPlayer(const MWWorld::Ptr& ptr) const = 0;
         virtual MWMechanics::GreetingState getGreetingState(const MWWorld::Ptr& ptr) const = 0;
         virtual bool isTurningToPlayer(const MWWorld::Ptr& ptr) const = 0;
+
+        /// Check if actor is updated this frame, distant actors are updated less often
+        virtual bool isActorUpdateDue(const MWWorld::Ptr& ptr) const = 0;
     };
 }
 
@@ -192,6 +192,9 @@ namespace MWBase
         ///< Play a 3D sound at \a initialPos. If the sound should be moving, it must be updated using
         ///< Sound::setPosition.
 
+        virtual void preloadSound(const ESM::RefId& soundId) = 0;
+        ///< Start decoding the given sound in background so it's ready by the time it's played.
+
         virtual void stopSound(Sound* sound) = 0;
         ///< Stop the given sound from playing
 
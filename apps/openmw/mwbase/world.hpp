@@ -414,6 +414,10 @@ namespace MWBase
         virtual bool getLOS(const MWWorld::ConstPtr& actor, const MWWorld::ConstPtr& targetActor) = 0;
         ///< get Line of Sight (morrowind stupid implementation)
 
+        virtual std::vector<bool> getLOS(const MWWorld::ConstPtr& actor, std::span<const MWWorld::ConstPtr> targets)
+            = 0;
+        ///< get Line of Sight from actor to each of the targets, uncached ones are cast in one batch
+
         virtual float getDistToNearestRayHit(
             const osg::Vec3f& from, const osg::Vec3f& dir, float maxDist, bool includeWater = false)
             = 0;
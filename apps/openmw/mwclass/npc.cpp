@@ -1250,7 +1250,8 @@ namespace MWClass
 
     float Npc::getSkill(const MWWorld::Ptr& ptr, ESM::RefId id) const
     {
-        return getNpcStats(ptr).getSkill(id).getModified();
+        const MWMechanics::NpcStats& stats = getNpcStats(ptr);
+        return stats.getSkill(id).getModified();
     }
 
     void Npc::readAdditionalState(const MWWorld::Ptr& ptr, const ESM::ObjectState& state) const
@@ -67,6 +67,9 @@ namespace MWDialogue
         mIsInChoice = false;
         mGoodbye = false;
         mCompilerContext.setExtensions(&extensions);
+
+        for (const ESM::Dialogue& dialogue : MWBase::Environment::get().getESMStore()->get<ESM::Dialogue>())
+            mInfoIndex.add(dialogue);
     }
 
     void DialogueManager::clear()
@@ -76,6 +79,7 @@ namespace MWDialogue
         mOriginalDisposition = 0;
         mCurrentDisposition = 0;
         mPermanentDispositionChange = 0;
+        mInfoIndex.setSpeaker(nullptr);
     }
 
     void DialogueManager::addTopic(const ESM::RefId& topic)
@@ -151,6 +155,9 @@ namespace MWDialogue
         mChoices.clear();
 
         mActor = actor;
+        // The topic list is built and responses are searched many times while the dialogue window is open
+        const InfoIndex::Speaker speaker = InfoIndex::makeSpeaker(actor);
+        mInfoIndex.setSpeaker(&speaker);
 
         MWMechanics::CreatureStats& creatureStats = actor.getClass().getCreatureStats(actor);
         mTalkedTo = creatureStats.hasTalkedToPlayer();
@@ -160,7 +167,7 @@ namespace MWDialogue
         // greeting
         const MWWorld::Store<ESM::Dialogue>& dialogs = MWBase::Environment::get().getESMStore()->get<ESM::Dialogue>();
 
-        Filter filter(actor, mChoice, mTalkedTo);
+        Filter filter(actor, mChoice, mTalkedTo, &mInfoIndex);
 
         for (const ESM::Dialogue& dialogue : dialogs)
         {
@@ -277,7 +284,7 @@ namespace MWDialogue
 
     void DialogueManager::executeTopic(const ESM::RefId& topic, ResponseCallback* callback)
     {
-        Filter filter(mActor, mChoice, mTalkedTo);
+        Filter filter(mActor, mChoice, mTalkedTo, &mInfoIndex);
 
         const MWWorld::Store<ESM::Dialogue>& dialogues = MWBase::Environment::get().getESMStore()->get<ESM::Dialogue>();
 
@@ -342,7 +349,7 @@ namespace MWDialogue
 
         const auto& dialogs = MWBase::Environment::get().getESMStore()->get<ESM::Dialogue>();
 
-        Filter filter(mActor, -1, mTalkedTo);
+        Filter filter(mActor, -1, mTalkedTo, &mInfoIndex);
 
         for (const auto& dialog : dialogs)
         {
@@ -452,6 +459,7 @@ namespace MWDialogue
         mPermanentDispositionChange = 0;
         mOriginalDisposition = 0;
         mCurrentDisposition = 0;
+        mInfoIndex.setSpeaker(nullptr);
     }
 
     void DialogueManager::questionAnswered(int answer, ResponseCallback* callback)
@@ -461,7 +469,7 @@ namespace MWDialogue
         const ESM::Dialogue* dialogue = searchDialogue(mLastTopic);
         if (dialogue)
         {
-            Filter filter(mActor, mChoice, mTalkedTo);
+            Filter filter(mActor, mChoice, mTalkedTo, &mInfoIndex);
 
             if (dialogue->mType == ESM::Dialogue::Topic || dialogue->mType == ESM::Dialogue::Greeting)
             {
@@ -586,7 +594,7 @@ namespace MWDialogue
 
     bool DialogueManager::checkServiceRefused(ResponseCallback* callback, ServiceType service)
     {
-        Filter filter(mActor, service, mTalkedTo);
+        Filter filter(mActor, service, mTalkedTo, &mInfoIndex);
 
         const MWWorld::Store<ESM::Dialogue>& dialogues = MWBase::Environment::get().getESMStore()->get<ESM::Dialogue>();
 
@@ -638,7 +646,7 @@ namespace MWDialogue
         const ESM::Dialogue* dial = store.get<ESM::Dialogue>().find(topic);
 
         const MWMechanics::CreatureStats& creatureStats = actor.getClass().getCreatureStats(actor);
-        Filter filter(actor, 0, creatureStats.hasTalkedToPlayer());
+        Filter filter(actor, 0, creatureStats.hasTalkedToPlayer(), &mInfoIndex);
         const ESM::DialInfo* info = filter.search(*dial, false).second;
         if (info != nullptr)
         {
@@ -18,6 +18,8 @@
 
 #include "../mwscript/compilercontext.hpp"
 
+#include "infoindex.hpp"
+
 namespace ESM
 {
     struct Dialogue;
@@ -44,6 +46,7 @@ namespace MWDialogue
         Translation::Storage& mTranslationDataStorage;
         MWScript::CompilerContext mCompilerContext;
         Compiler::StreamErrorHandler mErrorHandler;
+        InfoIndex mInfoIndex;
 
         MWWorld::Ptr mActor;
         bool mTalkedTo;
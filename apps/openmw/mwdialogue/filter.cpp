@@ -24,6 +24,7 @@
 #include "../mwmechanics/magiceffects.hpp"
 #include "../mwmechanics/npcstats.hpp"
 
+#include "infoindex.hpp"
 #include "selectwrapper.hpp"
 
 namespace
@@ -711,10 +712,11 @@ bool MWDialogue::Filter::hasFactionRankReputationRequirements(
     return stats.getFactionReputation(factionId) >= faction.mData.mRankData.at(rank).mFactReaction;
 }
 
-MWDialogue::Filter::Filter(const MWWorld::Ptr& actor, int choice, bool talkedToPlayer)
+MWDialogue::Filter::Filter(const MWWorld::Ptr& actor, int choice, bool talkedToPlayer, InfoIndex* index)
     : mActor(actor)
     , mChoice(choice)
     , mTalkedToPlayer(talkedToPlayer)
+    , mIndex(index)
 {
 }
 
@@ -734,6 +736,26 @@ bool MWDialogue::Filter::couldPotentiallyMatch(const ESM::DialInfo& info) const
     return testActor(info) && matchesStaticFilters(info, mActor);
 }
 
+template <class Function>
+void MWDialogue::Filter::forEachCandidate(const ESM::Dialogue& dialogue, Function&& function) const
+{
+    const std::vector<const ESM::DialInfo*>* candidates = nullptr;
+    if (mIndex != nullptr)
+        candidates = mIndex->getCandidates(dialogue, InfoIndex::makeSpeaker(mActor));
+
+    if (candidates == nullptr)
+    {
+        for (const auto& info : dialogue.mInfo)
+            if (!function(info))
+                return;
+        return;
+    }
+
+    for (const ESM::DialInfo* info : *candidates)
+        if (!function(*info))
+            return;
+}
+
 std::vector<MWDialogue::Filter::Response> MWDialogue::Filter::list(
     const ESM::Dialogue& dialogue, bool fallbackToInfoRefusal, bool searchAll, bool invertDisposition) const
 {
@@ -742,20 +764,20 @@ std::vector<MWDialogue::Filter::Response> MWDialogue::Filter::list(
     bool infoRefusal = false;
 
     // Iterate over topic responses to find a matching one
-    for (const auto& info : dialogue.mInfo)
-    {
+    forEachCandidate(dialogue, [&](const ESM::DialInfo& info) {
         if (testActor(info) && testPlayer(info) && testSelectStructs(info))
         {
             if (testDisposition(info, invertDisposition))
             {
                 infos.emplace_back(&dialogue, &info);
                 if (!searchAll)
-                    break;
+                    return false;
             }
             else
                 infoRefusal = true;
         }
-    }
+        return true;
+    });
 
     if (infos.empty() && infoRefusal && fallbackToInfoRefusal)
     {
@@ -766,14 +788,16 @@ std::vector<MWDialogue::Filter::Response> MWDialogue::Filter::list(
 
         const ESM::Dialogue& infoRefusalDialogue = *dialogues.find(ESM::RefId::stringRefId("Info Refusal"));
 
-        for (const auto& info : infoRefusalDialogue.mInfo)
+        forEachCandidate(infoRefusalDialogue, [&](const ESM::DialInfo& info) {
             if (testActor(info) && testPlayer(info) && testSelectStructs(info)
                 && testDisposition(info, invertDisposition))
             {
                 infos.emplace_back(&infoRefusalDialogue, &info);
                 if (!searchAll)
-                    break;
+                    return false;
             }
+            return true;
+        });
     }
 
     return infos;
@@ -15,6 +15,7 @@ namespace ESM
 
 namespace MWDialogue
 {
+    class InfoIndex;
     class SelectWrapper;
 
     class Filter
@@ -22,6 +23,7 @@ namespace MWDialogue
         MWWorld::Ptr mActor;
         int mChoice;
         bool mTalkedToPlayer;
+        InfoIndex* mIndex;
 
         bool testActor(const ESM::DialInfo& info) const;
         ///< Is this the right actor for this \a info?
@@ -52,10 +54,15 @@ namespace MWDialogue
         bool hasFactionRankReputationRequirements(
             const MWWorld::Ptr& actor, const ESM::RefId& factionId, int rank) const;
 
+        template <class Function>
+        void forEachCandidate(const ESM::Dialogue& dialogue, Function&& function) const;
+        ///< Call \a function for the infos of \a dialogue that could be said by the actor until it returns false.
+
     public:
         using Response = std::pair<const ESM::Dialogue*, const ESM::DialInfo*>;
 
-        Filter(const MWWorld::Ptr& actor, int choice, bool talkedToPlayer);
+        /// @param index to only test the infos that could be said by the actor, all infos are tested if nullptr
+        Filter(const MWWorld::Ptr& actor, int choice, bool talkedToPlayer, InfoIndex* index = nullptr);
 
         std::vector<Response> list(const ESM::Dialogue& dialogue, bool fallbackToInfoRefusal, bool searchAll,
             bool invertDisposition = false) const;
@@ -0,0 +1,120 @@
+#include "infoindex.hpp"
+
+#include <algorithm>
+
+#include <components/esm3/loaddial.hpp>
+#include <components/esm3/loadinfo.hpp>
+#include <components/esm3/loadnpc.hpp>
+
+#include "../mwworld/class.hpp"
+
+namespace MWDialogue
+{
+    namespace
+    {
+        template <class T>
+        void append(
+            const std::unordered_map<ESM::RefId, T>& buckets, const ESM::RefId& key, std::vector<const T*>& result)
+        {
+            if (key.empty())
+                return;
+            const auto it = buckets.find(key);
+            if (it != buckets.end())
+                result.push_back(&it->second);
+        }
+    }
+
+    InfoIndex::Speaker InfoIndex::makeSpeaker(const MWWorld::ConstPtr& actor)
+    {
+        Speaker speaker;
+        speaker.mId = actor.getCellRef().getRefId();
+        speaker.mIsNpc = actor.getType() == ESM::NPC::sRecordId;
+        if (speaker.mIsNpc)
+        {
+            const ESM::NPC& npc = *actor.get<ESM::NPC>()->mBase;
+            speaker.mRace = npc.mRace;
+            speaker.mClass = npc.mClass;
+            speaker.mFaction = actor.getClass().getPrimaryFaction(actor);
+            speaker.mIsFemale = (npc.mFlags & ESM::NPC::Female) != 0;
+        }
+        return speaker;
+    }
+
+    void InfoIndex::add(const ESM::Dialogue& dialogue)
+    {
+        Topic& topic = mTopics[&dialogue];
+        topic = Topic{};
+        topic.mInfos.reserve(dialogue.mInfo.size());
+        for (const ESM::DialInfo& info : dialogue.mInfo)
+        {
+            const auto index = static_cast<std::uint32_t>(topic.mInfos.size());
+            topic.mInfos.push_back(&info);
+            if (!info.mActor.empty())
+                topic.mByActor[info.mActor].push_back(index);
+            else if (!info.mRace.empty())
+                topic.mByRace[info.mRace].push_back(index);
+            else if (!info.mClass.empty())
+                topic.mByClass[info.mClass].push_back(index);
+            else if (!info.mFactionLess && !info.mFaction.empty())
+                topic.mByFaction[info.mFaction].push_back(index);
+            else if (info.mData.mGender == ESM::DialInfo::Male || info.mData.mGender == ESM::DialInfo::Female)
+                topic.mBySex[info.mData.mGender].push_back(index);
+            else
+                topic.mAny.push_back(index);
+        }
+        mMemo.erase(&dialogue);
+    }
+
+    void InfoIndex::collect(const Topic& topic, const Speaker& speaker, std::vector<const ESM::DialInfo*>& result)
+    {
+        std::vector<const Bucket*> buckets;
+        append(topic.mByActor, speaker.mId, buckets);
+        // Creatures only say infos specific to their id
+        if (speaker.mIsNpc)
+        {
+            append(topic.mByRace, speaker.mRace, buckets);
+            append(topic.mByClass, speaker.mClass, buckets);
+            append(topic.mByFaction, speaker.mFaction, buckets);
+            buckets.push_back(&topic.mBySex[speaker.mIsFemale ? ESM::DialInfo::Female : ESM::DialInfo::Male]);
+            buckets.push_back(&topic.mAny);
+        }
+
+        Bucket indices;
+        for (const Bucket* bucket : buckets)
+            indices.insert(indices.end(), bucket->begin(), bucket->end());
+        // The first matching info is used, keep the order of the topic
+        std::sort(indices.begin(), indices.end());
+
+        result.clear();
+        result.reserve(indices.size());
+        for (const std::uint32_t index : indices)
+            result.push_back(topic.mInfos[index]);
+    }
+
+    const std::vector<const ESM::DialInfo*>* InfoIndex::getCandidates(
+        const ESM::Dialogue& dialogue, const Speaker& speaker)
+    {
+        const auto topic = mTopics.find(&dialogue);
+        if (topic == mTopics.end())
+            return nullptr;
+
+        if (!mHasSpeaker || !(speaker == mSpeaker))
+        {
+            collect(topic->second, speaker, mScratch);
+            return &mScratch;
+        }
+
+        const auto [memo, inserted] = mMemo.try_emplace(&dialogue);
+        if (inserted)
+            collect(topic->second, speaker, memo->second);
+        return &memo->second;
+    }
+
+    void InfoIndex::setSpeaker(const Speaker* speaker)
+    {
+        mMemo.clear();
+        mHasSpeaker = speaker != nullptr;
+        if (speaker != nullptr)
+            mSpeaker = *speaker;
+    }
+}
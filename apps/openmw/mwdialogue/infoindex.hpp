@@ -0,0 +1,75 @@
+#ifndef GAME_MWDIALOGUE_INFOINDEX_H
+#define GAME_MWDIALOGUE_INFOINDEX_H
+
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+#include <components/esm/refid.hpp>
+
+#include "../mwworld/ptr.hpp"
+
+namespace ESM
+{
+    struct DialInfo;
+    struct Dialogue;
+}
+
+namespace MWDialogue
+{
+    /// @brief Buckets the infos of every topic by the fields of the speaker that don't change at runtime, so only
+    /// the infos that could be said by the speaker have to be tested by the Filter.
+    /// @par An info is put into the bucket of the first of its actor, race, class, faction and sex conditions that is
+    /// set. The candidates of a speaker are the union of its buckets and the infos without such a condition, in the
+    /// order of the topic. They still have to be tested against all conditions.
+    class InfoIndex
+    {
+    public:
+        struct Speaker
+        {
+            ESM::RefId mId;
+            bool mIsNpc = false;
+            ESM::RefId mRace;
+            ESM::RefId mClass;
+            ESM::RefId mFaction;
+            bool mIsFemale = false;
+
+            friend bool operator==(const Speaker&, const Speaker&) = default;
+        };
+
+        static Speaker makeSpeaker(const MWWorld::ConstPtr& actor);
+
+        void add(const ESM::Dialogue& dialogue);
+
+        /// @return nullptr if the dialogue was not added
+        const std::vector<const ESM::DialInfo*>* getCandidates(const ESM::Dialogue& dialogue, const Speaker& speaker);
+
+        /// Memoise the candidates of the speaker until a different one is set, nullptr to stop memoising.
+        void setSpeaker(const Speaker* speaker);
+
+    private:
+        using Bucket = std::vector<std::uint32_t>;
+
+        struct Topic
+        {
+            std::vector<const ESM::DialInfo*> mInfos;
+            std::unordered_map<ESM::RefId, Bucket> mByActor;
+            std::unordered_map<ESM::RefId, Bucket> mByRace;
+            std::unordered_map<ESM::RefId, Bucket> mByClass;
+            std::unordered_map<ESM::RefId, Bucket> mByFaction;
+            Bucket mBySex[2];
+            Bucket mAny;
+        };
+
+        static void collect(const Topic& topic, const Speaker& speaker, std::vector<const ESM::DialInfo*>& result);
+
+        std::unordered_map<const ESM::Dialogue*, Topic> mTopics;
+
+        bool mHasSpeaker = false;
+        Speaker mSpeaker;
+        std::unordered_map<const ESM::Dialogue*, std::vector<const ESM::DialInfo*>> mMemo;
+        std::vector<const ESM::DialInfo*> mScratch;
+    };
+}
+
+#endif
@@ -1,5 +1,7 @@
 #include "bookpage.hpp"
 
+#include <algorithm>
+#include <map>
 #include <optional>
 
 #include "MyGUI_FactoryManager.h"
@@ -212,10 +214,13 @@ namespace MWGui
         template <typename Visitor>
         void visitRuns(int top, int bottom, MyGUI::IFont* font, Visitor const& visitor) const
         {
-            for (const Section& section : mSections)
+            // Sections are laid out one below another, skip the ones above the page instead of testing every line of
+            // the book
+            const auto begin = std::partition_point(mSections.begin(), mSections.end(),
+                [&](const Section& section) { return section.mRect.bottom <= top; });
+            for (auto it = begin; it != mSections.end() && it->mRect.top < bottom; ++it)
             {
-                if (top >= mRect.bottom || bottom <= section.mRect.top)
-                    continue;
+                const Section& section = *it;
                 for (const Line& line : section.mLines)
                 {
                     if (top >= line.mRect.bottom || bottom <= line.mRect.top)
@@ -1215,7 +1220,21 @@ namespace MWGui
 
         void createActiveFormats(std::shared_ptr<TypesetBookImpl> newBook)
         {
-            newBook->visitRuns(0, 0x7FFFFFFF, CreateActiveFormat(this));
+            // Only one page is rendered at a time, size the vertex buffers for the largest page instead of the whole
+            // book
+            std::map<MyGUI::IFont*, int> maxCountVertex;
+            for (const TypesetBookImpl::Page& page : newBook->mPages)
+            {
+                newBook->visitRuns(page.first, page.second, CreateActiveFormat(this));
+                for (auto& [font, textFormat] : mActiveTextFormats)
+                {
+                    int& count = maxCountVertex[font];
+                    count = std::max(count, textFormat->mCountVertex);
+                    textFormat->mCountVertex = 0;
+                }
+            }
+            for (auto& [font, textFormat] : mActiveTextFormats)
+                textFormat->mCountVertex = maxCountVertex[font];
 
             if (mNode != nullptr)
                 for (ActiveTextFormats::iterator i = mActiveTextFormats.begin(); i != mActiveTextFormats.end(); ++i)
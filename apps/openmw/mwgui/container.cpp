@@ -3,6 +3,8 @@
 #include <MyGUI_Button.h>
 #include <MyGUI_InputManager.h>
 
+#include <optional>
+
 #include <components/settings/values.hpp>
 
 #include "../mwbase/environment.hpp"
@@ -242,10 +244,12 @@ namespace MWGui
         assert(mModel);
         mModel->update();
 
-        // unequip all items to avoid unequipping/reequipping
+        // unequip all items to avoid unequipping/reequipping, update the actor once when everything is taken
+        std::optional<MWWorld::InventoryStore::UpdateBatch> updateBatch;
         if (mPtr.getClass().hasInventoryStore(mPtr))
         {
             MWWorld::InventoryStore& invStore = mPtr.getClass().getInventoryStore(mPtr);
+            updateBatch.emplace(invStore);
             for (size_t i = 0; i < mModel->getItemCount(); ++i)
             {
                 const ItemStack& item = mModel->getItem(static_cast<ItemModel::ModelIndex>(i));
@@ -276,6 +280,8 @@ namespace MWGui
             mModel->moveItem(item, item.mCount, playerModel);
         }
 
+        updateBatch.reset();
+
         MWBase::Environment::get().getWindowManager()->removeGuiMode(GM_Container);
     }
 
@@ -71,6 +71,7 @@ namespace MWGui
         getWidget(mMagicka, "Magicka");
         getWidget(mStamina, "Stamina");
         getWidget(mEnemyHealth, "EnemyHealth");
+        mEnemyHealth->setProgressRange(100);
         mHealthManaStaminaBaseLeft = mHealthFrame->getLeft();
 
         MyGUI::Widget *healthFrame, *magickaFrame, *fatigueFrame;
@@ -583,10 +584,12 @@ namespace MWGui
         if (enemy.isEmpty())
             return;
         MWMechanics::CreatureStats& stats = enemy.getClass().getCreatureStats(enemy);
-        mEnemyHealth->setProgressRange(100);
         // Health is usually cast to int before displaying. Actors die whenever they are < 1 health.
         // Therefore any value < 1 should show as an empty health bar. We do the same in statswindow :)
-        mEnemyHealth->setProgressPosition(static_cast<size_t>(stats.getHealth().getRatio() * 100));
+        const size_t healthPosition = static_cast<size_t>(stats.getHealth().getRatio() * 100);
+        // Called every frame while the bar is visible, the bar only has to be updated when the health changes
+        if (mEnemyHealth->getProgressPosition() != healthPosition)
+            mEnemyHealth->setProgressPosition(healthPosition);
 
         static const float fNPCHealthBarFade = MWBase::Environment::get()
                                                    .getESMStore()
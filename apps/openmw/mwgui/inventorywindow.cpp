@@ -99,6 +99,8 @@ namespace MWGui
         mPreviewTexture
             = std::make_unique<MyGUIPlatform::OSGTexture>(mPreview->getTexture(), mPreview->getTextureStateSet());
         mPreview->rebuild();
+        // The window is hidden until it's opened
+        mPreview->setShown(false);
 
         mMainWidget->castType<MyGUI::Window>()->eventWindowChangeCoord
             += MyGUI::newDelegate(this, &InventoryWindow::onWindowResize);
@@ -505,11 +507,15 @@ namespace MWGui
         adjustPanes();
 
         mItemTransfer->addTarget(*mItemView);
+
+        mPreview->setShown(true);
     }
 
     void InventoryWindow::onClose()
     {
         mItemTransfer->removeTarget(*mItemView);
+
+        mPreview->setShown(false);
     }
 
     void InventoryWindow::onWindowResize(MyGUI::Window* sender)
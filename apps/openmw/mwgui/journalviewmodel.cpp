@@ -1,6 +1,8 @@
 #include "journalviewmodel.hpp"
 
 #include <map>
+#include <unordered_map>
+#include <vector>
 
 #include <MyGUI_LanguageManager.h>
 
@@ -24,21 +26,52 @@ namespace MWGui
     {
         using TopicSearch = MWDialogue::KeywordSearch<const MWDialogue::Topic*>;
 
+        struct Span
+        {
+            const MWDialogue::Topic* mTopic;
+            size_t mBegin;
+            size_t mEnd;
+        };
+
+        struct HighlightedText
+        {
+            std::string mText;
+            std::vector<Span> mSpans;
+        };
+
         mutable bool mKeywordSearchLoaded;
         mutable TopicSearch mKeywordSearch;
 
+        // Texts are highlighted once and kept while the known topics stay the same, many entries are shown every
+        // time the journal is opened. Keyed by the text of the entry, it does not change once heard.
+        mutable std::unordered_map<std::string, HighlightedText> mHighlightedTexts;
+        // The ids are compared as well, a topic may be allocated at the address of a removed one
+        std::vector<std::pair<const MWDialogue::Topic*, ESM::RefId>> mLoadedTopics;
+
         JournalViewModelImpl() { mKeywordSearchLoaded = false; }
 
         virtual ~JournalViewModelImpl() = default;
 
-        void load() override {}
-
-        void unload() override
+        void load() override
         {
+            MWBase::Journal* journal = MWBase::Environment::get().getJournal();
+
+            std::vector<std::pair<const MWDialogue::Topic*, ESM::RefId>> topics;
+            topics.reserve(journal->getTopics().size());
+            for (const auto& [id, topic] : journal->getTopics())
+                topics.emplace_back(&topic, id);
+
+            if (topics == mLoadedTopics)
+                return;
+
             mKeywordSearch.clear();
             mKeywordSearchLoaded = false;
+            mHighlightedTexts.clear();
+            mLoadedTopics = std::move(topics);
         }
 
+        void unload() override {}
+
         void ensureKeyWordSearchLoaded() const
         {
             if (!mKeywordSearchLoaded)
@@ -52,6 +85,91 @@ namespace MWGui
             }
         }
 
+        const HighlightedText& highlight(const std::string& text) const
+        {
+            const auto [it, inserted] = mHighlightedTexts.try_emplace(text);
+            if (!inserted)
+                return it->second;
+
+            ensureKeyWordSearchLoaded();
+
+            std::string& utf8text = it->second.mText;
+            utf8text = text;
+
+            // hyperlinks in @link# notation
+            std::map<std::pair<size_t, size_t>, const MWDialogue::Topic*> hyperLinks;
+
+            size_t posEnd = 0;
+            for (;;)
+            {
+                const size_t posBegin = utf8text.find('@');
+                if (posBegin != std::string::npos)
+                    posEnd = utf8text.find('#', posBegin);
+
+                if (posBegin != std::string::npos && posEnd != std::string::npos)
+                {
+                    std::string link = utf8text.substr(posBegin + 1, posEnd - posBegin - 1);
+                    const char specialPseudoAsteriskCharacter = 127;
+                    std::replace(link.begin(), link.end(), specialPseudoAsteriskCharacter, '*');
+                    std::string_view topicName = MWBase::Environment::get()
+                                                     .getWindowManager()
+                                                     ->getTranslationDataStorage()
+                                                     .topicStandardForm(link);
+
+                    std::string displayName = link;
+                    while (displayName[displayName.size() - 1] == '*')
+                        displayName.erase(displayName.size() - 1, 1);
+
+                    utf8text.replace(posBegin, posEnd + 1 - posBegin, displayName);
+
+                    const MWDialogue::Topic* value = nullptr;
+                    if (mKeywordSearch.containsKeyword(topicName, value))
+                        hyperLinks[std::make_pair(posBegin, posBegin + displayName.size())] = value;
+                }
+                else
+                    break;
+            }
+
+            std::vector<Span>& spans = it->second.mSpans;
+            if (hyperLinks.size()
+                && MWBase::Environment::get().getWindowManager()->getTranslationDataStorage().hasTranslation())
+            {
+                size_t formatted = 0; // points to the first character that is not laid out yet
+                for (const auto& [range, topicId] : hyperLinks)
+                {
+                    if (formatted < range.first)
+                        spans.push_back({ nullptr, formatted, range.first });
+                    spans.push_back({ topicId, range.first, range.second });
+                    formatted = range.second;
+                }
+                if (formatted < utf8text.size())
+                    spans.push_back({ nullptr, formatted, utf8text.size() });
+            }
+            else
+            {
+                std::vector<TopicSearch::Match> matches;
+                mKeywordSearch.highlightKeywords(utf8text.begin(), utf8text.end(), matches);
+
+                std::string::const_iterator i = utf8text.begin();
+                for (const TopicSearch::Match& match : matches)
+                {
+                    const size_t begin = match.mBeg - utf8text.begin();
+                    const size_t end = match.mEnd - utf8text.begin();
+                    if (i != match.mBeg)
+                        spans.push_back({ nullptr, static_cast<size_t>(i - utf8text.begin()), begin });
+
+                    spans.push_back({ match.mValue, begin, end });
+
+                    i = match.mEnd;
+                }
+
+                if (i != utf8text.end())
+                    spans.push_back({ nullptr, static_cast<size_t>(i - utf8text.begin()), utf8text.size() });
+            }
+
+            return it->second;
+        }
+
         bool isEmpty() const override
         {
             MWBase::Journal* journal = MWBase::Environment::get().getJournal();
@@ -68,108 +186,28 @@ namespace MWGui
             BaseEntry(JournalViewModelImpl const* model, const EntryType& entry)
                 : mEntry(&entry)
                 , mModel(model)
-                , loaded(false)
             {
             }
 
             virtual ~BaseEntry() = default;
 
-            mutable bool loaded;
-            mutable std::string utf8text;
-
-            // hyperlinks in @link# notation
-            mutable std::map<std::pair<size_t, size_t>, const MWDialogue::Topic*> mHyperLinks;
+            mutable const HighlightedText* mHighlighted = nullptr;
 
             virtual std::string getText() const = 0;
 
-            void ensureLoaded() const
+            const HighlightedText& ensureLoaded() const
             {
-                if (!loaded)
-                {
-                    mModel->ensureKeyWordSearchLoaded();
-
-                    utf8text = getText();
-
-                    size_t posEnd = 0;
-                    for (;;)
-                    {
-                        const size_t posBegin = utf8text.find('@');
-                        if (posBegin != std::string::npos)
-                            posEnd = utf8text.find('#', posBegin);
-
-                        if (posBegin != std::string::npos && posEnd != std::string::npos)
-                        {
-                            std::string link = utf8text.substr(posBegin + 1, posEnd - posBegin - 1);
-                            const char specialPseudoAsteriskCharacter = 127;
-                            std::replace(link.begin(), link.end(), specialPseudoAsteriskCharacter, '*');
-                            std::string_view topicName = MWBase::Environment::get()
-                                                             .getWindowManager()
-                                                             ->getTranslationDataStorage()
-                                                             .topicStandardForm(link);
-
-                            std::string displayName = link;
-                            while (displayName[displayName.size() - 1] == '*')
-                                displayName.erase(displayName.size() - 1, 1);
-
-                            utf8text.replace(posBegin, posEnd + 1 - posBegin, displayName);
-
-                            const MWDialogue::Topic* value = nullptr;
-                            if (mModel->mKeywordSearch.containsKeyword(topicName, value))
-                                mHyperLinks[std::make_pair(posBegin, posBegin + displayName.size())] = value;
-                        }
-                        else
-                            break;
-                    }
-
-                    loaded = true;
-                }
+                if (mHighlighted == nullptr)
+                    mHighlighted = &mModel->highlight(getText());
+                return *mHighlighted;
             }
 
-            std::string_view body() const override
-            {
-                ensureLoaded();
-
-                return utf8text;
-            }
+            std::string_view body() const override { return ensureLoaded().mText; }
 
             void visitSpans(std::function<void(const MWDialogue::Topic*, size_t, size_t)> visitor) const override
             {
-                ensureLoaded();
-                mModel->ensureKeyWordSearchLoaded();
-
-                if (mHyperLinks.size()
-                    && MWBase::Environment::get().getWindowManager()->getTranslationDataStorage().hasTranslation())
-                {
-                    size_t formatted = 0; // points to the first character that is not laid out yet
-                    for (const auto& [range, topicId] : mHyperLinks)
-                    {
-                        if (formatted < range.first)
-                            visitor(0, formatted, range.first);
-                        visitor(topicId, range.first, range.second);
-                        formatted = range.second;
-                    }
-                    if (formatted < utf8text.size())
-                        visitor(0, formatted, utf8text.size());
-                }
-                else
-                {
-                    std::vector<TopicSearch::Match> matches;
-                    mModel->mKeywordSearch.highlightKeywords(utf8text.begin(), utf8text.end(), matches);
-
-                    std::string::const_iterator i = utf8text.begin();
-                    for (const TopicSearch::Match& match : matches)
-                    {
-                        if (i != match.mBeg)
-                            visitor(0, i - utf8text.begin(), match.mBeg - utf8text.begin());
-
-                        visitor(match.mValue, match.mBeg - utf8text.begin(), match.mEnd - utf8text.begin());
-
-                        i = match.mEnd;
-                    }
-
-                    if (i != utf8text.end())
-                        visitor(0, i - utf8text.begin(), utf8text.size());
-                }
+                for (const Span& span : ensureLoaded().mSpans)
+                    visitor(span.mTopic, span.mBegin, span.mEnd);
             }
         };
 
@@ -231,10 +231,13 @@ namespace MWGui
 
     void LoadingScreen::setProgress(size_t value)
     {
-        // skip expensive update if there isn't enough visible progress
+        // skip expensive update if there isn't enough visible progress, but keep drawing at the target frame rate
         if (mProgressBar->getWidth() <= 0
             || value - mProgress < mProgressBar->getScrollRange() / mProgressBar->getWidth())
+        {
+            draw();
             return;
+        }
         value = std::min(value, mProgressBar->getScrollRange() - 1);
         mProgress = value;
         mProgressBar->setScrollPosition(0);
@@ -1135,10 +1135,14 @@ namespace MWGui
 
     void MapWindow::cellExplored(int x, int y)
     {
-        mGlobalMapRender->cleanupCameras();
         mGlobalMapRender->exploreCell(x, y, mLocalMapRender->getMapTexture(x, y));
     }
 
+    void MapWindow::updateExploredCells()
+    {
+        mGlobalMapRender->updateExploredCells();
+    }
+
     void MapWindow::onFrame(float dt)
     {
         LocalMapBase::onFrame(dt);
@@ -486,9 +486,21 @@ namespace MWGui
         mScreenshot->setRenderItemTexture(nullptr);
         mScreenshot->getSubWidgetMain()->_setUVSet(MyGUI::FloatRect(0.f, 0.f, 1.f, 1.f));
 
-        // Decode screenshot
-        const std::vector<char>& data = mCurrentSlot->mProfile.mScreenshot;
-        if (!data.size())
+        // Decode screenshot, slots restored from the saved games index don't have it loaded
+        std::vector<char> data = mCurrentSlot->mProfile.mScreenshot;
+        if (data.empty())
+        {
+            try
+            {
+                data = MWState::readScreenshot(mCurrentSlot->mPath);
+            }
+            catch (const std::exception& e)
+            {
+                Log(Debug::Warning) << "Failed to read screenshot from save file '"
+                                    << Files::pathToUnicodeString(mCurrentSlot->mPath.filename()) << "': " << e.what();
+            }
+        }
+        if (data.empty())
         {
             Log(Debug::Warning) << "Selected save file '" << Files::pathToUnicodeString(mCurrentSlot->mPath.filename())
                                 << "' has no savegame screenshot";
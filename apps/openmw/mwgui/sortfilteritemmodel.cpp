@@ -67,6 +67,38 @@ namespace
         return getTypeOrder(type1) < getTypeOrder(type2);
     }
 
+    int getChargePercent(const MWWorld::Ptr& item)
+    {
+        // 1. enchanted items showed before non-enchanted
+        // 2. item with lesser charge percent comes after items with more charge percent
+        // 3. item with constant effect comes before items with non-constant effects
+        const ESM::RefId& enchantmentId = item.getClass().getEnchantment(item);
+        if (enchantmentId.empty())
+            return -1;
+        const ESM::Enchantment* ench
+            = MWBase::Environment::get().getESMStore()->get<ESM::Enchantment>().search(enchantmentId);
+        if (!ench)
+            return -1;
+        if (ench->mData.mType == ESM::Enchantment::ConstantEffect)
+            return 101;
+        return static_cast<int>(item.getCellRef().getNormalizedEnchantmentCharge(*ench) * 100);
+    }
+
+    // The keys that are expensive to get are computed once per item instead of for every comparison
+    struct SortEntry
+    {
+        MWGui::ItemStack mItem;
+        std::string mName;
+        int mChargePercent;
+
+        explicit SortEntry(const MWGui::ItemStack& item)
+            : mItem(item)
+            , mName(Utf8Stream::lowerCaseUtf8(item.mBase.getClass().getName(item.mBase)))
+            , mChargePercent(getChargePercent(item.mBase))
+        {
+        }
+    };
+
     struct Compare
     {
         bool mSortByType;
@@ -74,8 +106,11 @@ namespace
             : mSortByType(true)
         {
         }
-        bool operator()(const MWGui::ItemStack& left, const MWGui::ItemStack& right)
+        bool operator()(const SortEntry& leftEntry, const SortEntry& rightEntry)
         {
+            const MWGui::ItemStack& left = leftEntry.mItem;
+            const MWGui::ItemStack& right = rightEntry.mItem;
+
             if (mSortByType && left.mType != right.mType)
                 return left.mType < right.mType;
 
@@ -87,54 +122,15 @@ namespace
                 return compareType(leftType, rightType);
 
             // compare items by name
-            std::string leftName = Utf8Stream::lowerCaseUtf8(left.mBase.getClass().getName(left.mBase));
-            std::string rightName = Utf8Stream::lowerCaseUtf8(right.mBase.getClass().getName(right.mBase));
-
             {
-                int result = leftName.compare(rightName);
+                int result = leftEntry.mName.compare(rightEntry.mName);
                 if (result != 0)
                     return result < 0;
             }
 
-            // compare items by enchantment:
-            // 1. enchanted items showed before non-enchanted
-            // 2. item with lesser charge percent comes after items with more charge percent
-            // 3. item with constant effect comes before items with non-constant effects
-            int leftChargePercent = -1;
-            int rightChargePercent = -1;
-            const ESM::RefId& leftNameEnch = left.mBase.getClass().getEnchantment(left.mBase);
-            const ESM::RefId& rightNameEnch = right.mBase.getClass().getEnchantment(right.mBase);
-
-            if (!leftNameEnch.empty())
-            {
-                const ESM::Enchantment* ench
-                    = MWBase::Environment::get().getESMStore()->get<ESM::Enchantment>().search(leftNameEnch);
-                if (ench)
-                {
-                    if (ench->mData.mType == ESM::Enchantment::ConstantEffect)
-                        leftChargePercent = 101;
-                    else
-                        leftChargePercent
-                            = static_cast<int>(left.mBase.getCellRef().getNormalizedEnchantmentCharge(*ench) * 100);
-                }
-            }
-
-            if (!rightNameEnch.empty())
-            {
-                const ESM::Enchantment* ench
-                    = MWBase::Environment::get().getESMStore()->get<ESM::Enchantment>().search(rightNameEnch);
-                if (ench)
-                {
-                    if (ench->mData.mType == ESM::Enchantment::ConstantEffect)
-                        rightChargePercent = 101;
-                    else
-                        rightChargePercent
-                            = static_cast<int>(right.mBase.getCellRef().getNormalizedEnchantmentCharge(*ench) * 100);
-                }
-            }
-
+            // compare items by enchantment
             {
-                int result = leftChargePercent - rightChargePercent;
+                int result = leftEntry.mChargePercent - rightEntry.mChargePercent;
                 if (result != 0)
                     return result > 0;
             }
@@ -380,7 +376,8 @@ namespace MWGui
 
         size_t count = mSourceModel->getItemCount();
 
-        mItems.clear();
+        std::vector<SortEntry> entries;
+        entries.reserve(count);
         for (size_t i = 0; i < count; ++i)
         {
             ItemStack item = mSourceModel->getItem(static_cast<ModelIndex>(i));
@@ -396,12 +393,17 @@ namespace MWGui
             }
 
             if (item.mCount > 0 && filterAccepts(item))
-                mItems.push_back(item);
+                entries.emplace_back(item);
         }
 
         Compare cmp;
         cmp.mSortByType = mSortByType;
-        std::sort(mItems.begin(), mItems.end(), cmp);
+        std::sort(entries.begin(), entries.end(), cmp);
+
+        mItems.clear();
+        mItems.reserve(entries.size());
+        for (SortEntry& entry : entries)
+            mItems.push_back(std::move(entry.mItem));
     }
 
     void SortFilterItemModel::onClose()
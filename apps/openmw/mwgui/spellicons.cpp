@@ -28,6 +28,10 @@ namespace MWGui
         MWWorld::Ptr player = MWMechanics::getPlayer();
         const MWMechanics::CreatureStats& stats = player.getClass().getCreatureStats(player);
 
+        // Nothing to update every frame while no effects are shown
+        if (stats.getActiveSpells().begin() == stats.getActiveSpells().end() && !mHasEffects)
+            return;
+
         std::map<int, std::vector<MagicEffectInfo>> effects;
         for (const auto& params : stats.getActiveSpells())
         {
@@ -202,6 +206,8 @@ namespace MWGui
             if (effects.find(widgetPair.first) == effects.end())
                 widgetPair.second->setVisible(false);
         }
+
+        mHasEffects = !effects.empty();
     }
 
 }
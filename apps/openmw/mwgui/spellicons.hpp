@@ -45,6 +45,7 @@ namespace MWGui
 
     private:
         std::map<int, MyGUI::ImageBox*> mWidgetMap;
+        bool mHasEffects = true;
     };
 
 }
@@ -18,7 +18,9 @@ namespace MWGui
     // mWatchedTimeToStartDrowning = -1 for correct drowning state check,
     // if stats.getTimeToStartDrowning() == 0 already on game start
     StatsWatcher::StatsWatcher()
-        : mWatchedLevel(-1)
+        : mWatchedAttributesRevision(0)
+        , mWatchedSkillsRevision(0)
+        , mWatchedLevel(-1)
         , mWatchedTimeToStartDrowning(-1)
         , mWatchedStatsEmpty(true)
     {
@@ -26,6 +28,9 @@ namespace MWGui
 
     void StatsWatcher::watchActor(const MWWorld::Ptr& ptr)
     {
+        // The revisions of other stats say nothing about what was watched before
+        if (ptr != mWatched)
+            mWatchedStatsEmpty = true;
         mWatched = ptr;
     }
 
@@ -37,13 +42,17 @@ namespace MWGui
         const auto& store = MWBase::Environment::get().getESMStore();
         MWBase::WindowManager* winMgr = MWBase::Environment::get().getWindowManager();
         const MWMechanics::NpcStats& stats = mWatched.getClass().getNpcStats(mWatched);
-        for (const ESM::Attribute& attribute : store->get<ESM::Attribute>())
+        if (stats.getAttributesRevision() != mWatchedAttributesRevision || mWatchedStatsEmpty)
         {
-            const auto& value = stats.getAttribute(attribute.mId);
-            if (value != mWatchedAttributes[attribute.mId] || mWatchedStatsEmpty)
+            mWatchedAttributesRevision = stats.getAttributesRevision();
+            for (const ESM::Attribute& attribute : store->get<ESM::Attribute>())
             {
-                mWatchedAttributes[attribute.mId] = value;
-                setAttribute(attribute.mId, value);
+                const auto& value = stats.getAttribute(attribute.mId);
+                if (value != mWatchedAttributes[attribute.mId] || mWatchedStatsEmpty)
+                {
+                    mWatchedAttributes[attribute.mId] = value;
+                    setAttribute(attribute.mId, value);
+                }
             }
         }
 
@@ -84,13 +93,17 @@ namespace MWGui
             }
         }
 
-        for (const ESM::Skill& skill : store->get<ESM::Skill>())
+        if (stats.getSkillsRevision() != mWatchedSkillsRevision || mWatchedStatsEmpty)
         {
-            const auto& value = stats.getSkill(skill.mId);
-            if (value != mWatchedSkills[skill.mId] || mWatchedStatsEmpty)
+            mWatchedSkillsRevision = stats.getSkillsRevision();
+            for (const ESM::Skill& skill : store->get<ESM::Skill>())
             {
-                mWatchedSkills[skill.mId] = value;
-                setValue(skill.mId, value);
+                const auto& value = stats.getSkill(skill.mId);
+                if (value != mWatchedSkills[skill.mId] || mWatchedStatsEmpty)
+                {
+                    mWatchedSkills[skill.mId] = value;
+                    setValue(skill.mId, value);
+                }
             }
         }
 
@@ -33,6 +33,9 @@ namespace MWGui
 
         std::map<ESM::RefId, MWMechanics::AttributeValue> mWatchedAttributes;
         std::map<ESM::RefId, MWMechanics::SkillValue> mWatchedSkills;
+        // Attributes and skills are only compared when the revisions of the watched stats change
+        std::size_t mWatchedAttributesRevision;
+        std::size_t mWatchedSkillsRevision;
 
         MWMechanics::DynamicStat<float> mWatchedHealth;
         MWMechanics::DynamicStat<float> mWatchedMagicka;
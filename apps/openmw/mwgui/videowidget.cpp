@@ -8,6 +8,7 @@
 
 #include <components/debug/debuglog.hpp>
 #include <components/myguiplatform/myguitexture.hpp>
+#include <components/settings/values.hpp>
 #include <components/vfs/manager.hpp>
 
 #include "../mwsound/movieaudiofactory.hpp"
@@ -32,6 +33,7 @@ namespace MWGui
     void VideoWidget::playVideo(const std::string& video)
     {
         mPlayer->setAudioFactory(new MWSound::MovieAudioFactory());
+        mPlayer->setHardwareDecoding(Settings::video().mHardwareMovieDecoding);
 
         Files::IStreamPtr videoStream;
         try
@@ -886,6 +886,8 @@ namespace MWGui
         mMap->setPlayerPos(x, y, u, v);
         mHud->setPlayerDir(playerdirection.x(), playerdirection.y());
         mHud->setPlayerPos(x, y, u, v);
+
+        mMap->updateExploredCells();
     }
 
     WindowBase* WindowManager::getActiveControllerWindow()
@@ -4,6 +4,7 @@
 
 #include <SDL_keyboard.h>
 
+#include <components/sceneutil/screencapture.hpp>
 #include <components/settings/values.hpp>
 
 #include "../mwbase/environment.hpp"
@@ -28,10 +29,10 @@ namespace MWInput
 {
 
     ActionManager::ActionManager(BindingsManager* bindingsManager, osg::ref_ptr<osgViewer::Viewer> viewer,
-        osg::ref_ptr<osgViewer::ScreenCaptureHandler> screenCaptureHandler)
+        osg::ref_ptr<SceneUtil::AsyncScreenCapture> screenCapture)
         : mBindingsManager(bindingsManager)
         , mViewer(std::move(viewer))
-        , mScreenCaptureHandler(std::move(screenCaptureHandler))
+        , mScreenCapture(std::move(screenCapture))
         , mTimeIdle(0.f)
     {
     }
@@ -168,8 +169,7 @@ namespace MWInput
 
     void ActionManager::screenshot()
     {
-        mScreenCaptureHandler->setFramesToCapture(1);
-        mScreenCaptureHandler->captureNextFrame(*mViewer);
+        mScreenCapture->capture();
     }
 
     void ActionManager::toggleMainMenu()
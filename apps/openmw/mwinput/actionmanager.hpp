@@ -7,7 +7,11 @@
 namespace osgViewer
 {
     class Viewer;
-    class ScreenCaptureHandler;
+}
+
+namespace SceneUtil
+{
+    class AsyncScreenCapture;
 }
 
 namespace MWInput
@@ -18,7 +22,7 @@ namespace MWInput
     {
     public:
         ActionManager(BindingsManager* bindingsManager, osg::ref_ptr<osgViewer::Viewer> viewer,
-            osg::ref_ptr<osgViewer::ScreenCaptureHandler> screenCaptureHandler);
+            osg::ref_ptr<SceneUtil::AsyncScreenCapture> screenCapture);
 
         void update(float dt);
 
@@ -46,7 +50,7 @@ namespace MWInput
 
         BindingsManager* mBindingsManager;
         osg::ref_ptr<osgViewer::Viewer> mViewer;
-        osg::ref_ptr<osgViewer::ScreenCaptureHandler> mScreenCaptureHandler;
+        osg::ref_ptr<SceneUtil::AsyncScreenCapture> mScreenCapture;
 
         float mTimeIdle;
     };
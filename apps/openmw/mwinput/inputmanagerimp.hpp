@@ -24,6 +24,11 @@ namespace MWBase
     class WindowManager;
 }
 
+namespace SceneUtil
+{
+    class AsyncScreenCapture;
+}
+
 namespace SDLUtil
 {
     class InputWrapper;
@@ -49,7 +54,7 @@ namespace MWInput
     {
     public:
         InputManager(SDL_Window* window, osg::ref_ptr<osgViewer::Viewer> viewer,
-            osg::ref_ptr<osgViewer::ScreenCaptureHandler> screenCaptureHandler, const std::filesystem::path& userFile,
+            osg::ref_ptr<SceneUtil::AsyncScreenCapture> screenCapture, const std::filesystem::path& userFile,
             bool userFileExists, const std::filesystem::path& userControllerBindingsFile,
             const std::filesystem::path& controllerBindingsFile, bool grab);
 
@@ -145,8 +145,7 @@ namespace MWLua
         if (context.mType != Context::Menu)
         {
             api["sendGlobalEvent"] = [context](std::string eventName, const sol::object& eventData) {
-                context.mLuaEvents->addGlobalEvent(
-                    { std::move(eventName), LuaUtil::serialize(eventData, context.mSerializer) });
+                context.mLuaEvents->addGlobalEvent(std::move(eventName), eventData, context.mSerializer);
             };
             api["sound"]
                 = context.cachePackage("openmw_core_sound", [context]() { return initCoreSoundBindings(context); });
@@ -158,8 +157,7 @@ namespace MWLua
                 {
                     throw std::logic_error("Can't send global events when no game is loaded");
                 }
-                context.mLuaEvents->addGlobalEvent(
-                    { std::move(eventName), LuaUtil::serialize(eventData, context.mSerializer) });
+                context.mLuaEvents->addGlobalEvent(std::move(eventName), eventData, context.mSerializer);
             };
         }
 
@@ -234,6 +234,8 @@ namespace MWLua
     void LocalScripts::setActive(bool active, bool callHandlers)
     {
         mData.mIsActive = active;
+        if (active)
+            scheduleTimers();
         if (callHandlers)
         {
             if (active)
@@ -18,6 +18,43 @@
 namespace MWLua
 {
 
+    namespace
+    {
+        template <class Event>
+        void setEventData(Event& event, const sol::object& eventData, const LuaUtil::UserdataSerializer* serializer)
+        {
+            if (std::optional<sol::object> copy = LuaUtil::copySerializable(eventData.lua_state(), eventData))
+                event.mEventObject = sol::main_object(*copy);
+            else
+                event.mEventData = LuaUtil::serialize(eventData, serializer);
+        }
+
+        template <class Scripts, class Event>
+        void sendEvent(Scripts& scripts, const Event& event)
+        {
+            if (event.mEventObject != sol::nil)
+                scripts.receiveEventObject(event.mEventName, event.mEventObject);
+            else
+                scripts.receiveEvent(event.mEventName, event.mEventData);
+        }
+    }
+
+    void LuaEvents::addGlobalEvent(
+        std::string eventName, const sol::object& eventData, const LuaUtil::UserdataSerializer* serializer)
+    {
+        Global event{ std::move(eventName), {} };
+        setEventData(event, eventData, serializer);
+        mNewGlobalEventBatch.push_back(std::move(event));
+    }
+
+    void LuaEvents::addLocalEvent(ESM::RefNum dest, std::string eventName, const sol::object& eventData,
+        const LuaUtil::UserdataSerializer* serializer)
+    {
+        Local event{ dest, std::move(eventName), {} };
+        setEventData(event, eventData, serializer);
+        mNewLocalEventBatch.push_back(std::move(event));
+    }
+
     void LuaEvents::clear()
     {
         mGlobalEventBatch.clear();
@@ -38,14 +75,14 @@ namespace MWLua
     void LuaEvents::callEventHandlers()
     {
         for (const Global& e : mGlobalEventBatch)
-            mGlobalScripts.receiveEvent(e.mEventName, e.mEventData);
+            sendEvent(mGlobalScripts, e);
         mGlobalEventBatch.clear();
         for (const Local& e : mLocalEventBatch)
         {
             MWWorld::Ptr ptr = MWBase::Environment::get().getWorldModel()->getPtr(e.mDest);
             LocalScripts* scripts = ptr.isEmpty() ? nullptr : ptr.getRefData().getLuaScripts();
             if (scripts)
-                scripts->receiveEvent(e.mEventName, e.mEventData);
+                sendEvent(*scripts, e);
             else
                 Log(Debug::Debug) << "Ignored event " << e.mEventName << " to L" << e.mDest.toString()
                                   << ". Object not found or has no attached scripts";
@@ -56,7 +93,7 @@ namespace MWLua
     void LuaEvents::callMenuEventHandlers()
     {
         for (const Global& e : mMenuEvents)
-            mMenuScripts.receiveEvent(e.mEventName, e.mEventData);
+            sendEvent(mMenuScripts, e);
         mMenuEvents.clear();
     }
 
@@ -65,8 +102,11 @@ namespace MWLua
     {
         esm.writeHNString("LUAE", event.mEventName);
         esm.writeFormId(dest, true);
-        if (!event.mEventData.empty())
-            saveLuaBinaryData(esm, event.mEventData);
+        // Copied data contains nothing a UserdataSerializer is needed for
+        const std::string data
+            = event.mEventObject != sol::nil ? LuaUtil::serialize(event.mEventObject) : event.mEventData;
+        if (!data.empty())
+            saveLuaBinaryData(esm, data);
     }
 
     void LuaEvents::load(lua_State* lua, ESM::ESMReader& esm, const std::map<int, int>& contentFileMapping,
@@ -4,6 +4,8 @@
 #include <map>
 #include <string>
 
+#include <sol/sol.hpp>
+
 #include <components/esm3/cellref.hpp> // defines RefNum that is used as a unique id
 
 struct lua_State;
@@ -34,22 +36,32 @@ namespace MWLua
         {
         }
 
+        // mEventObject is used instead of mEventData if set. It is a copy of the sent data that didn't need to be
+        // serialized, as it is received in the same Lua state.
         struct Global
         {
             std::string mEventName;
             std::string mEventData;
+            sol::main_object mEventObject = sol::nil;
         };
         struct Local
         {
             ESM::RefNum mDest;
             std::string mEventName;
             std::string mEventData;
+            sol::main_object mEventObject = sol::nil;
         };
 
         void addGlobalEvent(Global event) { mNewGlobalEventBatch.push_back(std::move(event)); }
         void addMenuEvent(Global event) { mMenuEvents.push_back(std::move(event)); }
         void addLocalEvent(Local event) { mNewLocalEventBatch.push_back(std::move(event)); }
 
+        // Serialize the data only if it contains userdata the serializer is needed for
+        void addGlobalEvent(
+            std::string eventName, const sol::object& eventData, const LuaUtil::UserdataSerializer* serializer);
+        void addLocalEvent(ESM::RefNum dest, std::string eventName, const sol::object& eventData,
+            const LuaUtil::UserdataSerializer* serializer);
+
         void clear();
         void finalizeEventBatch();
         void callEventHandlers();
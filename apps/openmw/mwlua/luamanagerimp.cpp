@@ -1,6 +1,8 @@
 #include "luamanagerimp.hpp"
 
+#include <algorithm>
 #include <filesystem>
+#include <fstream>
 
 #include <MyGUI_InputManager.h>
 #include <osg/Stats>
@@ -19,15 +21,18 @@
 
 #include <components/l10n/manager.hpp>
 
+#include <components/lua_ui/element.hpp>
 #include <components/lua_ui/registerscriptsettings.hpp>
 #include <components/lua_ui/util.hpp>
 
+#include "../mwbase/mechanicsmanager.hpp"
 #include "../mwbase/windowmanager.hpp"
 #include "../mwbase/world.hpp"
 
 #include "../mwrender/bonegroup.hpp"
 #include "../mwrender/postprocessor.hpp"
 
+#include "../mwworld/class.hpp"
 #include "../mwworld/datetimemanager.hpp"
 #include "../mwworld/esmstore.hpp"
 #include "../mwworld/player.hpp"
@@ -57,6 +62,34 @@ namespace MWLua
         };
     }
 
+    static std::string_view handlerTypeName(std::size_t type)
+    {
+        switch (static_cast<LuaUtil::ScriptsContainer::HandlerType>(type))
+        {
+            case LuaUtil::ScriptsContainer::HandlerType::Engine:
+                return "engine";
+            case LuaUtil::ScriptsContainer::HandlerType::Event:
+                return "event";
+            case LuaUtil::ScriptsContainer::HandlerType::Timer:
+                return "timer";
+        }
+        return "unknown";
+    }
+
+    static std::string_view handlerTypePrefix(std::size_t type)
+    {
+        switch (static_cast<LuaUtil::ScriptsContainer::HandlerType>(type))
+        {
+            case LuaUtil::ScriptsContainer::HandlerType::Engine:
+                return "";
+            case LuaUtil::ScriptsContainer::HandlerType::Event:
+                return "event ";
+            case LuaUtil::ScriptsContainer::HandlerType::Timer:
+                return "timer ";
+        }
+        return "";
+    }
+
     static LuaUtil::LuaStateSettings createLuaStateSettings()
     {
         if (!Settings::lua().mLuaProfiler)
@@ -67,11 +100,15 @@ namespace MWLua
             .mLogMemoryUsage = Settings::lua().mLogMemoryUsage };
     }
 
-    LuaManager::LuaManager(const VFS::Manager* vfs, const std::filesystem::path& libsDir)
+    LuaManager::LuaManager(
+        const VFS::Manager* vfs, const std::filesystem::path& libsDir, const std::filesystem::path& userDataPath)
         : mLua(vfs, &mConfiguration, createLuaStateSettings())
+        , mUserDataPath(userDataPath)
     {
         Log(Debug::Info) << "Lua version: " << LuaUtil::getLuaVersion();
         mLua.addInternalLibSearchPath(libsDir);
+        if (Settings::lua().mBytecodeCache)
+            mLua.enableBytecodeCache(userDataPath / "luacache");
 
         mGlobalSerializer = createUserdataSerializer(false);
         mLocalSerializer = createUserdataSerializer(true);
@@ -150,21 +187,17 @@ namespace MWLua
         const auto globalPath = userConfigPath / "global_storage.bin";
         const auto playerPath = userConfigPath / "player_storage.bin";
 
-        mLua.protectedCall([&](LuaUtil::LuaView& view) {
-            if (std::filesystem::exists(globalPath))
-                mGlobalStorage.load(view.sol(), globalPath);
-            if (std::filesystem::exists(playerPath))
-                mPlayerStorage.load(view.sol(), playerPath);
-        });
+        if (std::filesystem::exists(globalPath))
+            mGlobalStorage.load(globalPath);
+        if (std::filesystem::exists(playerPath))
+            mPlayerStorage.load(playerPath);
     }
 
     void LuaManager::savePermanentStorage(const std::filesystem::path& userConfigPath)
     {
-        mLua.protectedCall([&](LuaUtil::LuaView& view) {
-            if (mGlobalScriptsStarted)
-                mGlobalStorage.save(view.sol(), userConfigPath / "global_storage.bin");
-            mPlayerStorage.save(view.sol(), userConfigPath / "player_storage.bin");
-        });
+        if (mGlobalScriptsStarted)
+            mGlobalStorage.save(userConfigPath / "global_storage.bin");
+        mPlayerStorage.save(userConfigPath / "player_storage.bin");
     }
 
     void LuaManager::sendLocalEvent(
@@ -178,10 +211,60 @@ namespace MWLua
         mLuaEvents.addLocalEvent({ getId(target), name, std::move(binary) });
     }
 
+    template <class Run, class Skip>
+    void LuaManager::runLocalScripts(
+        std::optional<std::chrono::steady_clock::time_point> deadline, Run&& run, Skip&& skip)
+    {
+        if (mActiveLocalScripts.empty())
+            return;
+        const LocalScripts* const playerScripts = mPlayer.isEmpty() ? nullptr : mPlayer.getRefData().getLuaScripts();
+        const std::size_t first = mFirstDeferredLocalScripts % mActiveLocalScripts.size();
+        const auto firstIt = std::next(mActiveLocalScripts.begin(), static_cast<std::ptrdiff_t>(first));
+        std::optional<std::size_t> firstDeferred;
+        std::size_t deferredCount = 0;
+        std::size_t index = first;
+        const auto process = [&](LocalScripts* scripts) {
+            const std::size_t current = index;
+            index = (index + 1) % mActiveLocalScripts.size();
+            if (scripts != playerScripts && deadline.has_value()
+                && (firstDeferred.has_value() || std::chrono::steady_clock::now() > *deadline))
+            {
+                if (!firstDeferred.has_value())
+                    firstDeferred = current;
+                ++deferredCount;
+                skip(*scripts);
+                return;
+            }
+            run(*scripts);
+        };
+        for (auto it = firstIt; it != mActiveLocalScripts.end(); ++it)
+            process(*it);
+        for (auto it = mActiveLocalScripts.begin(); it != firstIt; ++it)
+            process(*it);
+        mFirstDeferredLocalScripts = firstDeferred.value_or(0);
+        mDeferredLocalScriptsCount = std::max(mDeferredLocalScriptsCount, deferredCount);
+    }
+
     void LuaManager::update()
     {
-        if (const int steps = Settings::lua().mGcStepsPerFrame; steps > 0)
+        const auto gcStart = std::chrono::steady_clock::now();
+        mGcSteps = 0;
+        if (const float budget = Settings::lua().mGcTimeBudget; budget > 0)
+        {
+            const auto gcDeadline = gcStart
+                + std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+                    std::chrono::duration<float, std::milli>(budget));
+            // Small steps to not overshoot the budget, don't start the next cycle in the same frame
+            do
+                ++mGcSteps;
+            while (lua_gc(mLua.unsafeState(), LUA_GCSTEP, 1) == 0 && std::chrono::steady_clock::now() < gcDeadline);
+        }
+        else if (const int steps = Settings::lua().mGcStepsPerFrame; steps > 0)
+        {
             lua_gc(mLua.unsafeState(), LUA_GCSTEP, steps);
+            mGcSteps = 1;
+        }
+        mGcTime = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - gcStart).count();
 
         if (mPlayer.isEmpty())
             return; // The game is not started yet.
@@ -210,13 +293,26 @@ namespace MWLua
 
         mLuaEvents.finalizeEventBatch();
 
+        std::optional<std::chrono::steady_clock::time_point> deadline;
+        if (const float budget = Settings::lua().mUpdateBudget; budget > 0)
+            deadline = std::chrono::steady_clock::now()
+                + std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+                    std::chrono::duration<float, std::milli>(budget));
+        mDeferredLocalScriptsCount = 0;
+
         MWWorld::DateTimeManager& timeManager = *MWBase::Environment::get().getWorld()->getTimeManager();
         if (!timeManager.isPaused())
         {
             mMenuScripts.processTimers(timeManager.getSimulationTime(), timeManager.getGameTime());
             mGlobalScripts.processTimers(timeManager.getSimulationTime(), timeManager.getGameTime());
-            for (LocalScripts* scripts : mActiveLocalScripts)
-                scripts->processTimers(timeManager.getSimulationTime(), timeManager.getGameTime());
+            // Player scripts aren't tracked and never deferred
+            if (!mPlayer.isEmpty())
+                if (LocalScripts* playerScripts = mPlayer.getRefData().getLuaScripts())
+                    playerScripts->processTimers(timeManager.getSimulationTime(), timeManager.getGameTime());
+            // Only the local scripts with expired timers are visited, deferred timers are called on the next frame
+            const std::size_t deferredCount = mScriptTracker.processTimers(
+                timeManager.getSimulationTime(), timeManager.getGameTime(), deadline);
+            mDeferredLocalScriptsCount = std::max(mDeferredLocalScriptsCount, deferredCount);
         }
 
         // Run event handlers for events that were sent before `finalizeEventBatch`.
@@ -232,10 +328,20 @@ namespace MWLua
             mEngineEvents.callEngineHandlers();
             bool isPaused = timeManager.isPaused();
 
-            float frameDuration = MWBase::Environment::get().getFrameDuration();
-            for (LocalScripts* scripts : mActiveLocalScripts)
-                scripts->update(isPaused ? 0 : frameDuration);
-            mGlobalScripts.update(isPaused ? 0 : frameDuration);
+            const float dt = isPaused ? 0 : MWBase::Environment::get().getFrameDuration();
+            const MWBase::MechanicsManager& mechanics = *MWBase::Environment::get().getMechanicsManager();
+            runLocalScripts(
+                deadline,
+                [&](LocalScripts& scripts) {
+                    // Distant actors are updated less often, skipped time is added to the next update
+                    const MWWorld::Ptr& ptr = scripts.getPtrOrEmpty();
+                    if (ptr.getClass().isActor() && !mechanics.isActorUpdateDue(ptr))
+                        scripts.skipUpdate(dt);
+                    else
+                        scripts.update(dt);
+                },
+                [&](LocalScripts& scripts) { scripts.skipUpdate(dt); });
+            mGlobalScripts.update(dt);
 
             mScriptTracker.unloadInactiveScripts(lua);
         });
@@ -350,6 +456,7 @@ namespace MWLua
         mUiResourceManager.clear();
         MWBase::Environment::get().getWorld()->getPostProcessor()->disableDynamicShaders();
         mActiveLocalScripts.clear();
+        mScriptTracker.clearTimers();
         mLuaEvents.clear();
         mEngineEvents.clear();
         mInputEvents.clear();
@@ -844,6 +951,9 @@ namespace MWLua
     void LuaManager::reportStats(unsigned int frameNumber, osg::Stats& stats) const
     {
         stats.setAttribute(frameNumber, "Lua UsedMemory", static_cast<double>(mLua.getTotalMemoryUsage()));
+        stats.setAttribute(frameNumber, "Lua Deferred", static_cast<double>(mDeferredLocalScriptsCount));
+        stats.setAttribute(frameNumber, "Lua GC", mGcTime);
+        stats.setAttribute(frameNumber, "Lua GC Steps", static_cast<double>(mGcSteps));
     }
 
     std::string LuaManager::formatResourceUsageStats() const
@@ -874,6 +984,9 @@ namespace MWLua
         outMemSize(mLua.getTotalMemoryUsage());
         out << "\n";
         out << "LuaUtil::ScriptsContainer count: " << LuaUtil::ScriptsContainer::getInstanceCount() << "\n";
+        out << "Garbage collection: " << std::fixed << std::setprecision(3) << mGcTime << " ms in " << mGcSteps
+            << " steps last frame (gc time budget = " << Settings::lua().mGcTimeBudget.get() << " ms)\n";
+        out.unsetf(std::ios::floatfield);
         out << "\n";
         out << "small alloc max size = " << smallAllocSize << " (section [Lua] in settings.cfg)\n";
         out << "Smaller values give more information for the profiler, but increase performance overhead.\n";
@@ -961,6 +1074,125 @@ namespace MWLua
             out << "\n";
         }
 
+        struct HandlerRow
+        {
+            std::size_t mScriptIndex;
+            std::string mName;
+            const LuaUtil::ScriptsContainer::HandlerStats* mStats;
+        };
+
+        const std::vector<LuaUtil::ScriptsContainer::ScriptHandlerStats> handlerStats = collectHandlerStats();
+        std::vector<HandlerRow> handlerRows;
+        for (std::size_t i = 0; i < handlerStats.size(); ++i)
+            for (std::size_t type = 0; type < LuaUtil::ScriptsContainer::sHandlerTypeCount; ++type)
+                for (const auto& [name, stats] : handlerStats[i][type])
+                    handlerRows.push_back(HandlerRow{ i, std::string(handlerTypePrefix(type)) + name, &stats });
+        std::sort(handlerRows.begin(), handlerRows.end(), [](const HandlerRow& l, const HandlerRow& r) {
+            return l.mStats->mDuration > r.mStats->mDuration;
+        });
+
+        out << "\n";
+        out << "calls:      Number of handler calls since scripts were loaded;\n";
+        out << "time:       Total wall time spent in the handler;\n";
+        out << "per call:   Average wall time of one call;\n";
+        out << "allocated:  Aggregated size of Lua allocations > " << smallAllocSize << " bytes made by the handler;\n";
+        out << "Use 'dumpluaprofile' console command to save the table to a file.\n";
+        out << "\n";
+
+        out << std::left;
+        out << " " << std::setw(nameW + 2) << "*** Handlers of active scripts";
+        out << std::right;
+        out << std::setw(valueW) << "calls";
+        out << std::setw(valueW) << "time (ms)";
+        out << std::setw(valueW) << "per call";
+        out << std::setw(valueW) << "allocated";
+        out << "\n";
+
+        for (const HandlerRow& row : handlerRows)
+        {
+            const std::string name = mConfiguration[row.mScriptIndex].mScriptPath.value() + " " + row.mName;
+            const double time = std::chrono::duration<double, std::milli>(row.mStats->mDuration).count();
+            out << std::left;
+            out << " " << std::setw(nameW) << name;
+            if (name.size() > nameW)
+                out << "\n " << std::setw(nameW) << "";
+            out << std::right << std::fixed << std::setprecision(3);
+            out << std::setw(valueW) << row.mStats->mCallCount;
+            out << std::setw(valueW) << time;
+            out << std::setw(valueW) << time / static_cast<double>(std::max<int64_t>(row.mStats->mCallCount, 1));
+            outMemSize(static_cast<size_t>(row.mStats->mAllocated));
+            out << "\n";
+        }
+
+        std::vector<const LuaUi::Element*> elements;
+        const auto addElement = [&](const LuaUi::Element* element) {
+            if (element->mUpdateCount > 0)
+                elements.push_back(element);
+        };
+        LuaUi::Element::forEach(true, addElement);
+        LuaUi::Element::forEach(false, addElement);
+        std::sort(elements.begin(), elements.end(), [](const LuaUi::Element* l, const LuaUi::Element* r) {
+            return l->mUpdateDuration > r->mUpdateDuration;
+        });
+
+        out << "\n";
+        out << std::left;
+        out << " " << std::setw(nameW + 2) << "*** Updated UI elements";
+        out << std::right;
+        out << std::setw(valueW) << "updates";
+        out << std::setw(valueW) << "time (ms)";
+        out << std::setw(valueW) << "per update";
+        out << "\n";
+
+        for (const LuaUi::Element* element : elements)
+        {
+            std::string name = element->mLayer.empty() ? std::string("[no layer]") : element->mLayer;
+            if (element->mRoot != nullptr && !element->mRoot->widget()->getName().empty())
+                name += " " + element->mRoot->widget()->getName();
+            const double time = std::chrono::duration<double, std::milli>(element->mUpdateDuration).count();
+            out << std::left;
+            out << " " << std::setw(nameW) << name;
+            if (name.size() > nameW)
+                out << "\n " << std::setw(nameW) << "";
+            out << std::right << std::fixed << std::setprecision(3);
+            out << std::setw(valueW) << element->mUpdateCount;
+            out << std::setw(valueW) << time;
+            out << std::setw(valueW) << time / static_cast<double>(element->mUpdateCount);
+            out << "\n";
+        }
+
         return out.str();
     }
+
+    std::vector<LuaUtil::ScriptsContainer::ScriptHandlerStats> LuaManager::collectHandlerStats() const
+    {
+        std::vector<LuaUtil::ScriptsContainer::ScriptHandlerStats> result;
+        mMenuScripts.collectHandlerStats(result);
+        mGlobalScripts.collectHandlerStats(result);
+        for (LocalScripts* scripts : mActiveLocalScripts)
+            scripts->collectHandlerStats(result);
+        return result;
+    }
+
+    std::filesystem::path LuaManager::exportResourceUsageStats() const
+    {
+        const std::filesystem::path path = mUserDataPath / "luaprofile.tsv";
+        std::ofstream stream(path);
+        stream << "script\ttype\thandler\tcalls\ttime_ms\tallocated_bytes\n";
+        const std::vector<LuaUtil::ScriptsContainer::ScriptHandlerStats> handlerStats = collectHandlerStats();
+        for (std::size_t i = 0; i < handlerStats.size(); ++i)
+        {
+            for (std::size_t type = 0; type < LuaUtil::ScriptsContainer::sHandlerTypeCount; ++type)
+            {
+                for (const auto& [name, stats] : handlerStats[i][type])
+                    stream << mConfiguration[i].mScriptPath.value() << '\t' << handlerTypeName(type) << '\t' << name
+                           << '\t' << stats.mCallCount << '\t'
+                           << std::chrono::duration<double, std::milli>(stats.mDuration).count() << '\t'
+                           << stats.mAllocated << '\n';
+            }
+        }
+        if (!stream)
+            Log(Debug::Error) << "Failed to write Lua profile to " << path;
+        return path;
+    }
 }
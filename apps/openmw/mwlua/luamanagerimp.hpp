@@ -1,9 +1,12 @@
 #ifndef MWLUA_LUAMANAGERIMP_H
 #define MWLUA_LUAMANAGERIMP_H
 
+#include <chrono>
 #include <filesystem>
 #include <map>
+#include <optional>
 #include <set>
+#include <vector>
 
 #include <osg/Stats>
 
@@ -35,7 +38,8 @@ namespace MWLua
     class LuaManager : public MWBase::LuaManager
     {
     public:
-        LuaManager(const VFS::Manager* vfs, const std::filesystem::path& libsDir);
+        LuaManager(
+            const VFS::Manager* vfs, const std::filesystem::path& libsDir, const std::filesystem::path& userDataPath);
         LuaManager(const LuaManager&) = delete;
         LuaManager(LuaManager&&) = delete;
         ~LuaManager();
@@ -167,6 +171,7 @@ namespace MWLua
 
         void reportStats(unsigned int frameNumber, osg::Stats& stats) const;
         std::string formatResourceUsageStats() const override;
+        std::filesystem::path exportResourceUsageStats() const override;
 
         LuaUtil::InputAction::Registry& inputActions() { return mInputActions; }
         LuaUtil::InputTrigger::Registry& inputTriggers() { return mInputTriggers; }
@@ -182,6 +187,12 @@ namespace MWLua
             std::optional<LuaUtil::ScriptIdsWithInitializationData> autoStartConf = std::nullopt);
         void reloadAllScriptsImpl();
         void synchronizedUpdateUnsafe();
+        std::vector<LuaUtil::ScriptsContainer::ScriptHandlerStats> collectHandlerStats() const;
+
+        // Calls `run` for active local scripts starting with ones deferred on the previous frame. After `deadline`
+        // remaining scripts except player scripts are passed to `skip` to be processed first on the next frame.
+        template <class Run, class Skip>
+        void runLocalScripts(std::optional<std::chrono::steady_clock::time_point> deadline, Run&& run, Skip&& skip);
 
         bool mInitialized = false;
         bool mGlobalScriptsStarted = false;
@@ -199,10 +210,15 @@ namespace MWLua
         MenuScripts mMenuScripts{ &mLua };
         GlobalScripts mGlobalScripts{ &mLua };
         std::set<LocalScripts*> mActiveLocalScripts;
+        std::size_t mFirstDeferredLocalScripts = 0;
+        std::size_t mDeferredLocalScriptsCount = 0;
+        double mGcTime = 0;
+        int mGcSteps = 0;
         std::vector<LocalScripts*> mQueuedAutoStartedScripts;
         ObjectLists mObjectLists;
 
         MWWorld::Ptr mPlayer;
+        std::filesystem::path mUserDataPath;
 
         LuaEvents mLuaEvents{ mGlobalScripts, mMenuScripts };
         EngineEvents mEngineEvents{ mGlobalScripts };
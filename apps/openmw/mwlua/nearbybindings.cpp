@@ -200,6 +200,30 @@ namespace MWLua
         api["items"] = LObjectList{ objectLists->getItemsInScene() };
         api["players"] = LObjectList{ objectLists->getPlayers() };
 
+        api["OBJECT_GROUP"]
+            = LuaUtil::makeStrictReadOnly(LuaUtil::tableFromPairs<std::string_view, ObjectLists::Group>(lua,
+                {
+                    { "Activators", ObjectLists::Group::Activators },
+                    { "Actors", ObjectLists::Group::Actors },
+                    { "Containers", ObjectLists::Group::Containers },
+                    { "Doors", ObjectLists::Group::Doors },
+                    { "Items", ObjectLists::Group::Items },
+                }));
+
+        api["query"] = [objectLists](const sol::table& options) {
+            const osg::Vec3f center = options.get<osg::Vec3f>("center");
+            const float radius = options.get<float>("radius");
+            const ObjectLists::Group group = options.get<ObjectLists::Group>("type");
+            const sol::optional<sol::function> filter = options.get<sol::optional<sol::function>>("filter");
+            std::vector<ObjectId> found = objectLists->getInRadius(group, center, radius);
+            if (filter.has_value())
+            {
+                std::erase_if(
+                    found, [&](ObjectId id) { return !LuaUtil::call(*filter, LObject(id)).get<bool>(); });
+            }
+            return LObjectList{ std::make_shared<std::vector<ObjectId>>(std::move(found)) };
+        };
+
         api["NAVIGATOR_FLAGS"]
             = LuaUtil::makeStrictReadOnly(LuaUtil::tableFromPairs<std::string_view, DetourNavigator::Flag>(lua,
                 {
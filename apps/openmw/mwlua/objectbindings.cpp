@@ -1,5 +1,8 @@
 #include "objectbindings.hpp"
 
+#include <limits>
+#include <map>
+
 #include <components/esm3/loadfact.hpp>
 #include <components/esm3/loadnpc.hpp>
 #include <components/lua/luastate.hpp>
@@ -178,6 +181,23 @@ namespace MWLua
             };
             listT[sol::meta_function::pairs] = lua["ipairsForArray"].template get<sol::function>();
             listT[sol::meta_function::ipairs] = lua["ipairsForArray"].template get<sol::function>();
+            listT["getPositions"] = [](const ListT& list, sol::this_state thisState) {
+                // A flat array of numbers, so that no Vector3 is created per object
+                const std::size_t size = list.mIds->size();
+                sol::table res = sol::state_view(thisState).create_table(static_cast<int>(size * 3), 0);
+                for (std::size_t i = 0; i < size; ++i)
+                {
+                    osg::Vec3f position(std::numeric_limits<float>::quiet_NaN(),
+                        std::numeric_limits<float>::quiet_NaN(), std::numeric_limits<float>::quiet_NaN());
+                    const ObjectT object((*list.mIds)[i]);
+                    const MWWorld::Ptr& ptr = object.ptrOrEmpty();
+                    if (!ptr.isEmpty())
+                        position = ptr.getRefData().getPosition().asVec3();
+                    for (int j = 0; j < 3; ++j)
+                        res.raw_set(i * 3 + j + 1, position[j]);
+                }
+                return res;
+            };
         }
 
         osg::Vec3f toEulerRotation(const sol::object& transform, bool isActor)
@@ -339,8 +359,7 @@ namespace MWLua
             objectT[sol::meta_function::equal_to] = [](const ObjectT& a, const ObjectT& b) { return a.id() == b.id(); };
             objectT[sol::meta_function::to_string] = &ObjectT::toString;
             objectT["sendEvent"] = [context](const ObjectT& dest, std::string eventName, const sol::object& eventData) {
-                context.mLuaEvents->addLocalEvent(
-                    { dest.id(), std::move(eventName), LuaUtil::serialize(eventData, context.mSerializer) });
+                context.mLuaEvents->addLocalEvent(dest.id(), std::move(eventName), eventData, context.mSerializer);
             };
 
             objectT["activateBy"] = [](const ObjectT& object, const ObjectT& actor) {
@@ -551,6 +570,67 @@ namespace MWLua
             }
         }
 
+        // ContainerStore type mask of an optional type argument of the inventory functions
+        int getInventoryTypeMask(
+            const sol::table& ids, const sol::optional<sol::table>& type, std::string_view functionName)
+        {
+            int mask = -1;
+            sol::optional<uint32_t> typeId = sol::nullopt;
+            if (type.has_value())
+                typeId = ids[*type];
+            else
+                mask = MWWorld::ContainerStore::Type_All;
+
+            if (typeId.has_value())
+            {
+                switch (*typeId)
+                {
+                    case ESM::REC_ALCH:
+                        mask = MWWorld::ContainerStore::Type_Potion;
+                        break;
+                    case ESM::REC_ARMO:
+                        mask = MWWorld::ContainerStore::Type_Armor;
+                        break;
+                    case ESM::REC_BOOK:
+                        mask = MWWorld::ContainerStore::Type_Book;
+                        break;
+                    case ESM::REC_CLOT:
+                        mask = MWWorld::ContainerStore::Type_Clothing;
+                        break;
+                    case ESM::REC_INGR:
+                        mask = MWWorld::ContainerStore::Type_Ingredient;
+                        break;
+                    case ESM::REC_LIGH:
+                        mask = MWWorld::ContainerStore::Type_Light;
+                        break;
+                    case ESM::REC_MISC:
+                        mask = MWWorld::ContainerStore::Type_Miscellaneous;
+                        break;
+                    case ESM::REC_WEAP:
+                        mask = MWWorld::ContainerStore::Type_Weapon;
+                        break;
+                    case ESM::REC_APPA:
+                        mask = MWWorld::ContainerStore::Type_Apparatus;
+                        break;
+                    case ESM::REC_LOCK:
+                        mask = MWWorld::ContainerStore::Type_Lockpick;
+                        break;
+                    case ESM::REC_PROB:
+                        mask = MWWorld::ContainerStore::Type_Probe;
+                        break;
+                    case ESM::REC_REPA:
+                        mask = MWWorld::ContainerStore::Type_Repair;
+                        break;
+                    default:;
+                }
+            }
+
+            if (mask == -1)
+                throw std::runtime_error("Incorrect type argument in inventory:" + std::string(functionName) + ": "
+                    + LuaUtil::toString(*type));
+            return mask;
+        }
+
         template <class ObjectT>
         void addInventoryBindings(sol::usertype<ObjectT>& objectT, const std::string& prefix, const Context& context)
         {
@@ -562,61 +642,7 @@ namespace MWLua
 
             inventoryT["getAll"] = [ids = getPackageToTypeTable(context.mLua->unsafeState())](
                                        const InventoryT& inventory, sol::optional<sol::table> type) {
-                int mask = -1;
-                sol::optional<uint32_t> typeId = sol::nullopt;
-                if (type.has_value())
-                    typeId = ids[*type];
-                else
-                    mask = MWWorld::ContainerStore::Type_All;
-
-                if (typeId.has_value())
-                {
-                    switch (*typeId)
-                    {
-                        case ESM::REC_ALCH:
-                            mask = MWWorld::ContainerStore::Type_Potion;
-                            break;
-                        case ESM::REC_ARMO:
-                            mask = MWWorld::ContainerStore::Type_Armor;
-                            break;
-                        case ESM::REC_BOOK:
-                            mask = MWWorld::ContainerStore::Type_Book;
-                            break;
-                        case ESM::REC_CLOT:
-                            mask = MWWorld::ContainerStore::Type_Clothing;
-                            break;
-                        case ESM::REC_INGR:
-                            mask = MWWorld::ContainerStore::Type_Ingredient;
-                            break;
-                        case ESM::REC_LIGH:
-                            mask = MWWorld::ContainerStore::Type_Light;
-                            break;
-                        case ESM::REC_MISC:
-                            mask = MWWorld::ContainerStore::Type_Miscellaneous;
-                            break;
-                        case ESM::REC_WEAP:
-                            mask = MWWorld::ContainerStore::Type_Weapon;
-                            break;
-                        case ESM::REC_APPA:
-                            mask = MWWorld::ContainerStore::Type_Apparatus;
-                            break;
-                        case ESM::REC_LOCK:
-                            mask = MWWorld::ContainerStore::Type_Lockpick;
-                            break;
-                        case ESM::REC_PROB:
-                            mask = MWWorld::ContainerStore::Type_Probe;
-                            break;
-                        case ESM::REC_REPA:
-                            mask = MWWorld::ContainerStore::Type_Repair;
-                            break;
-                        default:;
-                    }
-                }
-
-                if (mask == -1)
-                    throw std::runtime_error(
-                        std::string("Incorrect type argument in inventory:getAll: " + LuaUtil::toString(*type)));
-
+                const int mask = getInventoryTypeMask(ids, type, "getAll");
                 const MWWorld::Ptr& ptr = inventory.mObj.ptr();
                 MWWorld::ContainerStore& store = ptr.getClass().getContainerStore(ptr);
                 ObjectIdList list = std::make_shared<std::vector<ObjectId>>();
@@ -630,6 +656,26 @@ namespace MWLua
                 return ObjectList<ObjectT>{ std::move(list) };
             };
 
+            inventoryT["getRecordCounts"] = [ids = getPackageToTypeTable(context.mLua->unsafeState())](
+                                                const InventoryT& inventory, sol::optional<sol::table> type,
+                                                sol::this_state lua) {
+                const int mask = getInventoryTypeMask(ids, type, "getRecordCounts");
+                const MWWorld::Ptr& ptr = inventory.mObj.ptr();
+                MWWorld::ContainerStore& store = ptr.getClass().getContainerStore(ptr);
+                // The items aren't registered in the world model, no objects are created for them
+                std::map<ESM::RefId, int> counts;
+                auto it = store.begin(mask);
+                while (it.getType() != -1)
+                {
+                    const MWWorld::Ptr& item = *(it++);
+                    counts[item.getCellRef().getRefId()] += item.getCellRef().getCount();
+                }
+                sol::table res(lua, sol::create);
+                for (const auto& [recordId, count] : counts)
+                    res[recordId.serializeText()] = count;
+                return res;
+            };
+
             inventoryT["countOf"] = [](const InventoryT& inventory, std::string_view recordId) {
                 const MWWorld::Ptr& ptr = inventory.mObj.ptr();
                 MWWorld::ContainerStore& store = ptr.getClass().getContainerStore(ptr);
@@ -1,5 +1,11 @@
 #include "objectlists.hpp"
 
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+#include <string>
+
+#include <components/misc/framearena.hpp>
 #include <components/misc/resourcehelpers.hpp>
 
 #include "../mwbase/environment.hpp"
@@ -11,14 +17,27 @@
 
 namespace MWLua
 {
+    namespace
+    {
+        // Several objects per grid cell in towns, few cells to visit for the usual query radius
+        constexpr float gridCellSize = 512;
+
+        osg::Vec2i getGridCell(const osg::Vec3f& position)
+        {
+            return osg::Vec2i(static_cast<int>(std::floor(position.x() / gridCellSize)),
+                static_cast<int>(std::floor(position.y() / gridCellSize)));
+        }
+    }
 
     void ObjectLists::update()
     {
-        mActivatorsInScene.updateList();
-        mActorsInScene.updateList();
-        mContainersInScene.updateList();
-        mDoorsInScene.updateList();
-        mItemsInScene.updateList();
+        for (ObjectGroup* group :
+            { &mActivatorsInScene, &mActorsInScene, &mContainersInScene, &mDoorsInScene, &mItemsInScene })
+        {
+            group->updateList();
+            // Objects move every frame, positions have to be taken again
+            group->mGridValid = false;
+        }
     }
 
     void ObjectLists::clear()
@@ -30,6 +49,69 @@ namespace MWLua
         mItemsInScene.clear();
     }
 
+    ObjectLists::ObjectGroup& ObjectLists::getGroup(Group group)
+    {
+        switch (group)
+        {
+            case Group::Activators:
+                return mActivatorsInScene;
+            case Group::Actors:
+                return mActorsInScene;
+            case Group::Containers:
+                return mContainersInScene;
+            case Group::Doors:
+                return mDoorsInScene;
+            case Group::Items:
+                return mItemsInScene;
+        }
+        throw std::logic_error("Invalid object group: " + std::to_string(static_cast<int>(group)));
+    }
+
+    std::vector<ObjectId> ObjectLists::getInRadius(Group group, const osg::Vec3f& center, float radius)
+    {
+        ObjectGroup& objectGroup = getGroup(group);
+        objectGroup.updateGrid();
+
+        auto found = Misc::makeFrameVector<std::pair<float, ObjectId>>(Misc::FrameArenaUser::Lua);
+        const float radius2 = radius * radius;
+        const auto check = [&](const std::vector<GridEntry>& entries) {
+            for (const GridEntry& entry : entries)
+            {
+                const float distance2 = (entry.mPosition - center).length2();
+                if (distance2 <= radius2)
+                    found.emplace_back(distance2, entry.mId);
+            }
+        };
+
+        const osg::Vec2i min = getGridCell(center - osg::Vec3f(radius, radius, 0));
+        const osg::Vec2i max = getGridCell(center + osg::Vec3f(radius, radius, 0));
+        const long long cells = static_cast<long long>(max.x() - min.x() + 1) * (max.y() - min.y() + 1);
+        if (cells >= static_cast<long long>(objectGroup.mGrid.size()))
+        {
+            for (const auto& [_, entries] : objectGroup.mGrid)
+                check(entries);
+        }
+        else
+        {
+            for (int x = min.x(); x <= max.x(); ++x)
+            {
+                for (int y = min.y(); y <= max.y(); ++y)
+                {
+                    const auto it = objectGroup.mGrid.find(osg::Vec2i(x, y));
+                    if (it != objectGroup.mGrid.end())
+                        check(it->second);
+                }
+            }
+        }
+
+        std::sort(found.begin(), found.end());
+        std::vector<ObjectId> result;
+        result.reserve(found.size());
+        for (const auto& [_, id] : found)
+            result.push_back(id);
+        return result;
+    }
+
     ObjectLists::ObjectGroup* ObjectLists::chooseGroup(const MWWorld::Ptr& ptr)
     {
         // It is important to check `isMarker` first.
@@ -81,17 +163,38 @@ namespace MWLua
         mChanged = false;
         mList->clear();
         mSet.clear();
+        mGridValid = false;
+        mGrid.clear();
+    }
+
+    void ObjectLists::ObjectGroup::updateGrid()
+    {
+        if (mGridValid)
+            return;
+        mGrid.clear();
+        const MWWorld::WorldModel& worldModel = *MWBase::Environment::get().getWorldModel();
+        for (ObjectId id : mSet)
+        {
+            const MWWorld::Ptr ptr = worldModel.getPtr(id);
+            if (ptr.isEmpty())
+                continue;
+            const osg::Vec3f position = ptr.getRefData().getPosition().asVec3();
+            mGrid[getGridCell(position)].push_back(GridEntry{ id, position });
+        }
+        mGridValid = true;
     }
 
     void ObjectLists::addToGroup(ObjectGroup& group, const MWWorld::Ptr& ptr)
     {
         group.mSet.insert(getId(ptr));
         group.mChanged = true;
+        group.mGridValid = false;
     }
 
     void ObjectLists::removeFromGroup(ObjectGroup& group, const MWWorld::Ptr& ptr)
     {
         group.mSet.erase(getId(ptr));
         group.mChanged = true;
+        group.mGridValid = false;
     }
 }
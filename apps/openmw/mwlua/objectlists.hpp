@@ -1,7 +1,12 @@
 #ifndef MWLUA_OBJECTLISTS_H
 #define MWLUA_OBJECTLISTS_H
 
+#include <map>
 #include <set>
+#include <vector>
+
+#include <osg/Vec2i>
+#include <osg/Vec3f>
 
 #include "object.hpp"
 
@@ -12,6 +17,15 @@ namespace MWLua
     class ObjectLists
     {
     public:
+        enum class Group
+        {
+            Activators,
+            Actors,
+            Containers,
+            Doors,
+            Items,
+        };
+
         void update(); // Should be called every frame.
         void clear(); // Should be called every time before starting or loading a new game.
 
@@ -27,17 +41,34 @@ namespace MWLua
 
         void setPlayer(const MWWorld::Ptr& player) { *mPlayers = { getId(player) }; }
 
+        /// Objects of the group closer than radius to center, closest first.
+        /// @note The grid the objects are looked up in is built on the first query of a group in a frame, an object
+        /// that moved later in the same frame may be missed.
+        std::vector<ObjectId> getInRadius(Group group, const osg::Vec3f& center, float radius);
+
     private:
+        struct GridEntry
+        {
+            ObjectId mId;
+            osg::Vec3f mPosition;
+        };
+
         struct ObjectGroup
         {
             void updateList();
             void clear();
+            void updateGrid();
 
             bool mChanged = false;
             ObjectIdList mList = std::make_shared<std::vector<ObjectId>>();
             std::set<ObjectId> mSet;
+
+            bool mGridValid = false;
+            std::map<osg::Vec2i, std::vector<GridEntry>> mGrid;
         };
 
+        ObjectGroup& getGroup(Group group);
+
         ObjectGroup* chooseGroup(const MWWorld::Ptr& ptr);
         void addToGroup(ObjectGroup& group, const MWWorld::Ptr& ptr);
         void removeFromGroup(ObjectGroup& group, const MWWorld::Ptr& ptr);
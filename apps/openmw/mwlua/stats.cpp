@@ -1,6 +1,7 @@
 #include "stats.hpp"
 
 #include <algorithm>
+#include <limits>
 #include <optional>
 #include <string>
 #include <string_view>
@@ -23,6 +24,7 @@
 #include "../mwworld/class.hpp"
 #include "../mwworld/esmstore.hpp"
 
+#include "object.hpp"
 #include "objectvariant.hpp"
 #include "recordstore.hpp"
 
@@ -58,6 +60,30 @@ namespace
         }
         return sol::make_object(context.mLua->unsafeState(), getter(obj.ptr()));
     }
+
+    // Calls f with the Ptr of every object of an ObjectList or a table of objects, the Ptr is empty if the object
+    // doesn't exist anymore
+    template <class F>
+    void forEachObject(const sol::object& objects, F&& f)
+    {
+        auto forEachId = [&](const MWLua::ObjectIdList& ids) {
+            for (const MWLua::ObjectId& id : *ids)
+            {
+                const MWWorld::SafePtr object(id);
+                f(object.ptrOrEmpty());
+            }
+        };
+        if (objects.is<MWLua::LObjectList>())
+            forEachId(objects.as<const MWLua::LObjectList&>().mIds);
+        else if (objects.is<MWLua::GObjectList>())
+            forEachId(objects.as<const MWLua::GObjectList&>().mIds);
+        else
+        {
+            const sol::table table = LuaUtil::cast<sol::table>(objects);
+            for (std::size_t i = 1, n = table.size(); i <= n; ++i)
+                f(LuaUtil::cast<const MWLua::Object&>(table[i].get<sol::object>()).ptrOrEmpty());
+        }
+    }
 }
 
 namespace MWLua
@@ -373,7 +399,8 @@ namespace MWLua
         sol::object get(const Context& context, std::string_view prop, G getter) const
         {
             return getValue(context, mObject, &SkillStat::setValue, mId, prop, [this, getter](const MWWorld::Ptr& ptr) {
-                return (ptr.getClass().getNpcStats(ptr).getSkill(mId).*getter)();
+                const MWMechanics::NpcStats& stats = ptr.getClass().getNpcStats(ptr);
+                return (stats.getSkill(mId).*getter)();
             });
         }
 
@@ -388,7 +415,8 @@ namespace MWLua
         sol::object getProgress(const Context& context) const
         {
             return getValue(context, mObject, &SkillStat::setValue, mId, "progress", [this](const MWWorld::Ptr& ptr) {
-                return getProgress(ptr, mId, ptr.getClass().getNpcStats(ptr).getSkill(mId));
+                const MWMechanics::NpcStats& stats = ptr.getClass().getNpcStats(ptr);
+                return getProgress(ptr, mId, stats.getSkill(mId));
             });
         }
 
@@ -581,6 +609,29 @@ namespace MWLua
         dynamic["health"] = addIndexedAccessor<DynamicStat>(0);
         dynamic["magicka"] = addIndexedAccessor<DynamicStat>(1);
         dynamic["fatigue"] = addIndexedAccessor<DynamicStat>(2);
+        dynamic["snapshot"] = [](const sol::object& objects, sol::this_state thisState) {
+            // A flat array of numbers, so that no DynamicStat is created per actor
+            sol::table res(thisState, sol::create);
+            std::size_t index = 0;
+            forEachObject(objects, [&](const MWWorld::Ptr& ptr) {
+                const bool isActor = !ptr.isEmpty() && ptr.getClass().isActor();
+                for (int i = 0; i < 3; ++i)
+                {
+                    float current = std::numeric_limits<float>::quiet_NaN();
+                    float base = std::numeric_limits<float>::quiet_NaN();
+                    if (isActor)
+                    {
+                        const MWMechanics::DynamicStat<float>& stat
+                            = ptr.getClass().getCreatureStats(ptr).getDynamic(i);
+                        current = stat.getCurrent();
+                        base = stat.getBase();
+                    }
+                    res.raw_set(++index, current);
+                    res.raw_set(++index, base);
+                }
+            });
+            return res;
+        };
 
         auto attributeStatT = lua.new_usertype<AttributeStat>("AttributeStat");
         addProp(context, attributeStatT, "base", &MWMechanics::AttributeValue::getBase);
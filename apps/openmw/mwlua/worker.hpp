@@ -18,6 +18,8 @@ namespace MWLua
 {
     class LuaManager;
 
+    // Runs LuaManager::update in parallel with the rendering of the previous frame. There is one such thread: all
+    // scripts share one LuaState that can't be used by several threads at once.
     class Worker
     {
     public:
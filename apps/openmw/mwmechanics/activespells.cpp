@@ -1,5 +1,6 @@
 #include "activespells.hpp"
 
+#include <algorithm>
 #include <optional>
 
 #include <components/debug/debuglog.hpp>
@@ -238,6 +239,10 @@ namespace MWMechanics
         auto& creatureStats = ptr.getClass().getCreatureStats(ptr);
         assert(&creatureStats.getActiveSpells() == this);
         IterationGuard guard{ *this };
+        // Actors can have hundreds of abilities, so look them up in sorted copies instead of searching the spell lists
+        // for every spell
+        std::vector<const ESM::Spell*> knownSpells(creatureStats.getSpells().begin(), creatureStats.getSpells().end());
+        std::sort(knownSpells.begin(), knownSpells.end());
         // Erase no longer active spells and effects
         for (auto spellIt = mSpells.begin(); spellIt != mSpells.end();)
         {
@@ -245,7 +250,7 @@ namespace MWMechanics
             {
                 const ESM::Spell* spell
                     = MWBase::Environment::get().getESMStore()->get<ESM::Spell>().search(spellIt->mSourceSpellId);
-                if (spell && ptr.getClass().getCreatureStats(ptr).getSpells().hasSpell(spell))
+                if (spell && std::binary_search(knownSpells.begin(), knownSpells.end(), spell))
                     ++spellIt;
                 else
                 {
@@ -297,11 +302,15 @@ namespace MWMechanics
         if (!creatureStats.isDead())
         {
             // Vanilla only does this on cell change I think
-            const auto& spells = creatureStats.getSpells();
-            for (const ESM::Spell* spell : spells)
+            std::vector<ESM::RefId> activeSpellIds;
+            activeSpellIds.reserve(mSpells.size());
+            for (const ActiveSpellParams& params : mSpells)
+                activeSpellIds.push_back(params.mSourceSpellId);
+            std::sort(activeSpellIds.begin(), activeSpellIds.end());
+            for (const ESM::Spell* spell : creatureStats.getSpells())
             {
                 if (spell->mData.mType != ESM::Spell::ST_Spell && spell->mData.mType != ESM::Spell::ST_Power
-                    && !isSpellActive(spell->mId))
+                    && !std::binary_search(activeSpellIds.begin(), activeSpellIds.end(), spell->mId))
                 {
                     initParams(ptr, ActiveSpellParams{ spell, ptr, true }, context);
                 }
@@ -375,8 +384,12 @@ namespace MWMechanics
     bool ActiveSpells::updateActiveSpell(
         const MWWorld::Ptr& ptr, float duration, Collection::iterator& spellIt, UpdateContext& context)
     {
-        const auto caster = MWBase::Environment::get().getWorld()->searchPtrViaActorId(
-            spellIt->mCasterActorId); // Maybe make this search outside active grid?
+        // Abilities, diseases and constant effect enchantments are cast by the actor itself, don't search the active
+        // cells for it every frame
+        const auto caster = ptr.getClass().getCreatureStats(ptr).matchesActorId(spellIt->mCasterActorId)
+            ? ptr
+            : MWBase::Environment::get().getWorld()->searchPtrViaActorId(
+                spellIt->mCasterActorId); // Maybe make this search outside active grid?
         bool removedSpell = false;
         std::optional<ActiveSpellParams> reflected;
         for (auto it = spellIt->mEffects.begin(); it != spellIt->mEffects.end();)
@@ -6,6 +6,7 @@
 #include "character.hpp"
 #include "creaturestats.hpp"
 #include "greetingstate.hpp"
+#include "updatescheduler.hpp"
 
 #include "../mwbase/environment.hpp"
 #include "../mwbase/world.hpp"
@@ -62,6 +63,9 @@ namespace MWMechanics
         void setPositionAdjusted(bool adjusted) { mPositionAdjusted = adjusted; }
         bool getPositionAdjusted() const { return mPositionAdjusted; }
 
+        UpdateScheduler::Entry& getUpdateSchedule() { return mUpdateSchedule; }
+        const UpdateScheduler::Entry& getUpdateSchedule() const { return mUpdateSchedule; }
+
         void invalidate()
         {
             mInvalid = true;
@@ -79,6 +83,7 @@ namespace MWMechanics
         bool mIsTurningToPlayer{ false };
         bool mInvalid{ false };
         bool mPositionAdjusted;
+        UpdateScheduler::Entry mUpdateSchedule;
     };
 
 }
@@ -7,6 +7,8 @@
 #include <components/esm3/esmwriter.hpp>
 
 #include <components/debug/debuglog.hpp>
+#include <components/misc/framearena.hpp>
+#include <components/misc/jobpool.hpp>
 #include <components/misc/mathutil.hpp>
 #include <components/misc/resourcehelpers.hpp>
 #include <components/misc/rng.hpp>
@@ -37,6 +39,8 @@
 
 #include "../mwmechanics/aibreathe.hpp"
 
+#include "../mwrender/animationlod.hpp"
+#include "../mwrender/renderingmanager.hpp"
 #include "../mwrender/vismask.hpp"
 
 #include "../mwsound/constants.hpp"
@@ -59,6 +63,19 @@
 namespace
 {
 
+    void preloadCreatureSounds(const MWWorld::Ptr& ptr)
+    {
+        if (ptr.getType() != ESM::Creature::sRecordId)
+            return;
+        MWBase::SoundManager* const sndMgr = MWBase::Environment::get().getSoundManager();
+        for (std::string_view name : { "moan", "roar", "scream", "left", "right" })
+        {
+            const ESM::RefId soundId = ptr.getClass().getSoundIdFromSndGen(ptr, name);
+            if (!soundId.empty())
+                sndMgr->preloadSound(soundId);
+        }
+    }
+
     bool isConscious(const MWWorld::Ptr& ptr)
     {
         const MWMechanics::CreatureStats& stats = ptr.getClass().getCreatureStats(ptr);
@@ -408,6 +425,14 @@ namespace MWMechanics
         }
     }
 
+    Actors::Actors()
+    {
+        if (const int threads = Settings::game().mActorsUpdateThreads; threads > 0)
+            mJobPool = std::make_unique<Misc::JobPool>(static_cast<std::size_t>(threads));
+    }
+
+    Actors::~Actors() = default;
+
     void Actors::updateActor(const MWWorld::Ptr& ptr, float duration) const
     {
         ptr.getClass().getCreatureStats(ptr).updateAwareness(duration);
@@ -609,14 +634,7 @@ namespace MWMechanics
     void Actors::engageCombat(
         const MWWorld::Ptr& actor1, const MWWorld::Ptr& actor2, SidingCache& cachedAllies, bool againstPlayer) const
     {
-        CreatureStats& creatureStats1 = actor1.getClass().getCreatureStats(actor1);
-        if (creatureStats1.isDead() || creatureStats1.getAiSequence().isInCombat(actor2))
-            return;
-
-        const CreatureStats& creatureStats2 = actor2.getClass().getCreatureStats(actor2);
-        if (creatureStats2.isDead())
-            return;
-
+        // Reject distant pairs first, the checks below look through the AI packages of both actors
         const osg::Vec3f actor1Pos(actor1.getRefData().getPosition().asVec3());
         const osg::Vec3f actor2Pos(actor2.getRefData().getPosition().asVec3());
         const float sqrDist = (actor1Pos - actor2Pos).length2();
@@ -625,6 +643,14 @@ namespace MWMechanics
         if (sqrDist > actorsProcessingRange * actorsProcessingRange)
             return;
 
+        CreatureStats& creatureStats1 = actor1.getClass().getCreatureStats(actor1);
+        if (creatureStats1.isDead() || creatureStats1.getAiSequence().isInCombat(actor2))
+            return;
+
+        const CreatureStats& creatureStats2 = actor2.getClass().getCreatureStats(actor2);
+        if (creatureStats2.isDead())
+            return;
+
         // If this is set to true, actor1 will start combat with actor2 if the awareness check at the end of the method
         // returns true
         bool aggressive = false;
@@ -1200,6 +1226,8 @@ namespace MWMechanics
             return;
         const auto it = mActors.emplace(mActors.end(), ptr, *anim);
         mIndex.emplace(ptr.mRef, it);
+        SidingCache::invalidate();
+        preloadCreatureSounds(ptr);
 
         if (updateImmediately)
             it->getCharacterController().update(0);
@@ -1252,6 +1280,7 @@ namespace MWMechanics
                 removeTemporaryEffects(iter->second->getPtr());
             iter->second->invalidate();
             mIndex.erase(iter);
+            SidingCache::invalidate();
         }
     }
 
@@ -1297,7 +1326,10 @@ namespace MWMechanics
     {
         const auto iter = mIndex.find(old.mRef);
         if (iter != mIndex.end())
+        {
             iter->second->updatePtr(ptr);
+            SidingCache::invalidate();
+        }
     }
 
     void Actors::dropActors(const MWWorld::CellStore* cellStore, const MWWorld::Ptr& ignore)
@@ -1310,6 +1342,7 @@ namespace MWMechanics
                 removeTemporaryEffects(actor.getPtr());
                 mIndex.erase(actor.getPtr().mRef);
                 actor.invalidate();
+                SidingCache::invalidate();
             }
         }
     }
@@ -1328,15 +1361,35 @@ namespace MWMechanics
         const MWWorld::Ptr player = getPlayer();
         const MWBase::World* const world = MWBase::Environment::get().getWorld();
 
+        // Everything the prediction reads from the actors is copied here first, so the prediction itself doesn't
+        // access the world and can run for all actors in parallel. Corrections are applied afterwards in the actors
+        // order.
         struct CacheEntry
         {
             MWWorld::Ptr mPtr;
             float mMaxSpeed;
             osg::Vec3f mHalfExtents;
             Movement& mMovement;
+            osg::Vec3f mPosition;
+            float mRotZ;
+            osg::Vec3f mSpeed;
+            // Combat or pursue target (NPCs should not avoid collision with their targets).
+            MWWorld::Ptr mCurrentTarget;
+            bool mShouldAvoidCollision = false;
+            bool mShouldGiveWay = false;
+            bool mShouldTurnToApproachingActor = false;
+            float mTimeToCheck = 0;
         };
 
-        std::vector<CacheEntry> cache;
+        struct Collision
+        {
+            std::size_t mOther;
+            float mTime;
+            float mAngle;
+            osg::Vec2f mMovementCorrection;
+        };
+
+        Misc::FrameVector<CacheEntry> cache = Misc::makeFrameVector<CacheEntry>(Misc::FrameArenaUser::Mechanics);
         cache.reserve(mActors.size());
         for (const Actor& actor : mActors)
         {
@@ -1344,20 +1397,18 @@ namespace MWMechanics
                 continue;
             const MWWorld::Ptr& ptr = actor.getPtr();
             const MWWorld::Class& cls = ptr.getClass();
-            cache.push_back({ ptr, cls.getMaxSpeed(ptr), world->getHalfExtents(ptr), cls.getMovementSettings(ptr) });
-        }
+            const float maxSpeed = cls.getMaxSpeed(ptr);
+            Movement& movement = cls.getMovementSettings(ptr);
+            const ESM::Position& position = ptr.getRefData().getPosition();
+            CacheEntry& cached = cache.emplace_back(CacheEntry{ ptr, maxSpeed, world->getHalfExtents(ptr), movement,
+                position.asVec3(), position.rot[2], movement.asVec3() * maxSpeed });
 
-        for (const CacheEntry& cached : cache)
-        {
-            const MWWorld::Ptr& ptr = cached.mPtr;
             if (ptr == player)
                 continue; // Don't interfere with player controls.
 
-            const float maxSpeed = cached.mMaxSpeed;
             if (maxSpeed == 0.0)
                 continue; // Can't move, so there is no sense to predict collisions.
 
-            Movement& movement = cached.mMovement;
             const osg::Vec2f origMovement(movement.mPosition[0], movement.mPosition[1]);
             const bool isMoving = origMovement.length2() > 0.01;
             if (movement.mPosition[1] < 0)
@@ -1369,8 +1420,7 @@ namespace MWMechanics
             bool shouldAvoidCollision = isMoving;
             bool shouldGiveWay = false;
             bool shouldTurnToApproachingActor = !isMoving;
-            MWWorld::Ptr currentTarget; // Combat or pursue target (NPCs should not avoid collision with their targets).
-            const auto& aiSequence = ptr.getClass().getCreatureStats(ptr).getAiSequence();
+            const auto& aiSequence = cls.getCreatureStats(ptr).getAiSequence();
             if (!aiSequence.isEmpty())
             {
                 const auto& package = aiSequence.getActivePackage();
@@ -1386,7 +1436,7 @@ namespace MWMechanics
                 else if (package.getTypeId() == AiPackageTypeId::Combat
                     || package.getTypeId() == AiPackageTypeId::Pursue)
                 {
-                    currentTarget = package.getTarget();
+                    cached.mCurrentTarget = package.getTarget();
                     shouldAvoidCollision = isMoving;
                     shouldTurnToApproachingActor = false;
                 }
@@ -1395,30 +1445,46 @@ namespace MWMechanics
             if (!shouldAvoidCollision && !shouldGiveWay)
                 continue;
 
-            const osg::Vec2f baseSpeed = origMovement * maxSpeed;
-            const osg::Vec3f basePos = ptr.getRefData().getPosition().asVec3();
-            const float baseRotZ = ptr.getRefData().getPosition().rot[2];
-            const osg::Vec3f& halfExtents = cached.mHalfExtents;
-            const float maxDistToCheck = isMoving ? maxDistForPartialAvoiding : maxDistForStrictAvoiding;
-
             float timeToCheck = maxTimeToCheck;
             if (!shouldGiveWay && !aiSequence.isEmpty())
-                timeToCheck = std::min(
-                    timeToCheck, getTimeToDestination(**aiSequence.begin(), basePos, maxSpeed, duration, halfExtents));
+                timeToCheck = std::min(timeToCheck,
+                    getTimeToDestination(
+                        **aiSequence.begin(), cached.mPosition, maxSpeed, duration, cached.mHalfExtents));
+
+            cached.mShouldAvoidCollision = shouldAvoidCollision;
+            cached.mShouldGiveWay = shouldGiveWay;
+            cached.mShouldTurnToApproachingActor = shouldTurnToApproachingActor;
+            cached.mTimeToCheck = timeToCheck;
+        }
 
-            float timeToCollision = timeToCheck;
-            osg::Vec2f movementCorrection(0, 0);
-            float angleToApproachingActor = 0;
+        // Predict possible collisions with all other actors ordered as the actors are.
+        // The inner vectors are filled by the job pool threads, which don't have the arena
+        Misc::FrameVector<std::vector<Collision>> collisions(
+            cache.size(), Misc::getFrameArena(Misc::FrameArenaUser::Mechanics));
+        const auto predictCollisions = [&](std::size_t index) {
+            const CacheEntry& cached = cache[index];
+            if (!cached.mShouldAvoidCollision && !cached.mShouldGiveWay)
+                return;
+
+            const MWWorld::Ptr& ptr = cached.mPtr;
+            const float maxSpeed = cached.mMaxSpeed;
+            const osg::Vec2f origMovement(cached.mMovement.mPosition[0], cached.mMovement.mPosition[1]);
+            const bool isMoving = origMovement.length2() > 0.01;
+            const osg::Vec2f baseSpeed = origMovement * maxSpeed;
+            const osg::Vec3f& basePos = cached.mPosition;
+            const float baseRotZ = cached.mRotZ;
+            const osg::Vec3f& halfExtents = cached.mHalfExtents;
+            const float maxDistToCheck = isMoving ? maxDistForPartialAvoiding : maxDistForStrictAvoiding;
 
-            // Iterate through all other actors and predict collisions.
-            for (const CacheEntry& otherCached : cache)
+            for (std::size_t otherIndex = 0; otherIndex < cache.size(); ++otherIndex)
             {
+                const CacheEntry& otherCached = cache[otherIndex];
                 const MWWorld::Ptr& otherPtr = otherCached.mPtr;
-                if (otherPtr == ptr || otherPtr == currentTarget)
+                if (otherPtr == ptr || otherPtr == cached.mCurrentTarget)
                     continue;
 
                 const osg::Vec3f& otherHalfExtents = otherCached.mHalfExtents;
-                const osg::Vec3f deltaPos = otherPtr.getRefData().getPosition().asVec3() - basePos;
+                const osg::Vec3f deltaPos = otherCached.mPosition - basePos;
                 const osg::Vec2f relPos = Misc::rotateVec2f(osg::Vec2f(deltaPos.x(), deltaPos.y()), baseRotZ);
                 const float dist = deltaPos.length();
 
@@ -1430,8 +1496,8 @@ namespace MWMechanics
                 if (deltaPos.z() > halfExtents.z() * 2 || deltaPos.z() < -otherHalfExtents.z() * 2)
                     continue;
 
-                const osg::Vec3f speed = otherCached.mMovement.asVec3() * otherCached.mMaxSpeed;
-                const float rotZ = otherPtr.getRefData().getPosition().rot[2];
+                const osg::Vec3f& speed = otherCached.mSpeed;
+                const float rotZ = otherCached.mRotZ;
                 const osg::Vec2f relSpeed
                     = Misc::rotateVec2f(osg::Vec2f(speed.x(), speed.y()), baseRotZ - rotZ) - baseSpeed;
 
@@ -1446,31 +1512,61 @@ namespace MWMechanics
                     continue; // No solution; distance is always >= collisionDist.
                 const float t = (-vr - std::sqrt(dh)) / v2;
 
-                if (t < 0 || t > timeToCollision)
-                    continue;
-
-                // Check visibility and awareness last as it's expensive.
-                if (!MWBase::Environment::get().getWorld()->getLOS(otherPtr, ptr))
-                    continue;
-                if (!MWBase::Environment::get().getMechanicsManager()->awarenessCheck(otherPtr, ptr))
+                if (t < 0 || t > cached.mTimeToCheck)
                     continue;
 
-                timeToCollision = t;
-                angleToApproachingActor = std::atan2(deltaPos.x(), deltaPos.y());
                 const osg::Vec2f posAtT = relPos + relSpeed * t;
                 const float coef = (posAtT.x() * relSpeed.x() + posAtT.y() * relSpeed.y())
                     / (collisionDist * collisionDist * maxSpeed)
                     * std::clamp(
                         (maxDistForPartialAvoiding - dist) / (maxDistForPartialAvoiding - maxDistForStrictAvoiding),
                         0.f, 1.f);
-                movementCorrection = posAtT * coef;
+                collisions[index].push_back(
+                    Collision{ otherIndex, t, std::atan2(deltaPos.x(), deltaPos.y()), posAtT * coef });
+            }
+        };
+
+        if (mJobPool != nullptr)
+            mJobPool->run(cache.size(), 4, predictCollisions);
+        else
+            for (std::size_t i = 0; i < cache.size(); ++i)
+                predictCollisions(i);
+
+        for (std::size_t index = 0; index < cache.size(); ++index)
+        {
+            const CacheEntry& cached = cache[index];
+            const MWWorld::Ptr& ptr = cached.mPtr;
+
+            float timeToCollision = cached.mTimeToCheck;
+            osg::Vec2f movementCorrection(0, 0);
+            float angleToApproachingActor = 0;
+
+            for (const Collision& collision : collisions[index])
+            {
+                if (collision.mTime > timeToCollision)
+                    continue;
+
+                const MWWorld::Ptr& otherPtr = cache[collision.mOther].mPtr;
+
+                // Check visibility and awareness last as it's expensive.
+                if (!MWBase::Environment::get().getWorld()->getLOS(otherPtr, ptr))
+                    continue;
+                if (!MWBase::Environment::get().getMechanicsManager()->awarenessCheck(otherPtr, ptr))
+                    continue;
+
+                timeToCollision = collision.mTime;
+                angleToApproachingActor = collision.mAngle;
+                movementCorrection = collision.mMovementCorrection;
                 if (otherPtr.getClass().getCreatureStats(otherPtr).isDead())
                     // In case of dead body still try to go around (it looks natural), but reduce the correction twice.
                     movementCorrection.y() *= 0.5f;
             }
 
-            if (timeToCollision < timeToCheck)
+            if (timeToCollision < cached.mTimeToCheck)
             {
+                Movement& movement = cached.mMovement;
+                const osg::Vec2f origMovement(movement.mPosition[0], movement.mPosition[1]);
+                const bool isMoving = origMovement.length2() > 0.01;
                 // Try to evade the nearest collision.
                 osg::Vec2f newMovement = origMovement + movementCorrection;
                 // Step to the side rather than backward. Otherwise player will be able to push the NPC far away from
@@ -1481,7 +1577,7 @@ namespace MWMechanics
                     newMovement *= origMovement.length(); // Keep the original speed.
                 movement.mPosition[0] = newMovement.x();
                 movement.mPosition[1] = newMovement.y();
-                if (shouldTurnToApproachingActor)
+                if (cached.mShouldTurnToApproachingActor)
                     zTurn(ptr, angleToApproachingActor);
             }
         }
@@ -1514,7 +1610,9 @@ namespace MWMechanics
 
             /// \todo move update logic to Actor class where appropriate
 
-            SidingCache cachedAllies{ *this, true }; // will be filled as engageCombat iterates
+            // will be filled as engageCombat iterates
+            SidingCache& cachedAllies = mAlliesExcludingInfighting;
+            cachedAllies.refresh();
 
             const bool aiActive = MWBase::Environment::get().getMechanicsManager()->isAIActive();
             const int attackedByPlayerId = player.getClass().getCreatureStats(player).getHitAttemptActorId();
@@ -1527,12 +1625,27 @@ namespace MWMechanics
             }
             const int actorsProcessingRange = Settings::game().mActorsProcessingRange;
 
+            MWRender::RenderingManager* const rendering = world->getRenderingManager();
+            const MWRender::AnimationLOD* const animationLOD
+                = rendering != nullptr ? rendering->getAnimationLOD() : nullptr;
+            // Updates AI packages and character controllers of distant actors less often
+            const auto scheduleUpdate = [&](Actor& actor, bool isPlayer) {
+                unsigned bucket = 0;
+                if (!isPlayer && animationLOD != nullptr)
+                    bucket = animationLOD->getUpdateBucket(actor.getPtr().getRefData().getPosition().asVec3(),
+                        world->getHalfExtents(actor.getPtr()).length());
+                return mUpdateScheduler.schedule(actor.getUpdateSchedule(), bucket, duration);
+            };
+            mUpdateScheduler.nextFrame();
+
             // AI and magic effects update
             for (Actor& actor : mActors)
             {
                 if (actor.isInvalid())
                     continue;
                 const bool isPlayer = actor.getPtr() == player;
+                const bool updateDue = scheduleUpdate(actor, isPlayer);
+                const float updateDuration = actor.getUpdateSchedule().mDuration;
                 CharacterController& ctrl = actor.getCharacterController();
                 MWBase::LuaManager::ActorControls* luaControls
                     = MWBase::Environment::get().getLuaManager()->getActorControls(actor.getPtr());
@@ -1610,20 +1723,20 @@ namespace MWMechanics
                         if (!isPlayer)
                         {
                             CreatureStats& stats = actor.getPtr().getClass().getCreatureStats(actor.getPtr());
-                            if (isConscious(actor.getPtr()) && !(luaControls && luaControls->mDisableAI))
+                            if (updateDue && isConscious(actor.getPtr()) && !(luaControls && luaControls->mDisableAI))
                             {
-                                stats.getAiSequence().execute(actor.getPtr(), ctrl, duration);
+                                stats.getAiSequence().execute(actor.getPtr(), ctrl, updateDuration);
                                 updateGreetingState(actor.getPtr(), actor, mTimerUpdateHello > 0);
                                 playIdleDialogue(actor.getPtr());
                                 updateMovementSpeed(actor.getPtr());
                             }
                         }
                     }
-                    else if (aiActive && !isPlayer && isConscious(actor.getPtr())
+                    else if (updateDue && aiActive && !isPlayer && isConscious(actor.getPtr())
                         && !(luaControls && luaControls->mDisableAI))
                     {
                         CreatureStats& stats = actor.getPtr().getClass().getCreatureStats(actor.getPtr());
-                        stats.getAiSequence().execute(actor.getPtr(), ctrl, duration, /*outOfRange*/ true);
+                        stats.getAiSequence().execute(actor.getPtr(), ctrl, updateDuration, /*outOfRange*/ true);
                     }
 
                     if (inProcessingRange && actor.getPtr().getClass().isNpc())
@@ -1703,7 +1816,18 @@ namespace MWMechanics
                     actor.setPositionAdjusted(true);
                 }
 
-                ctrl.update(duration);
+                // Physics keeps moving skipped actors with the last queued velocity
+                const bool updateDue = scheduleUpdate(actor, isPlayer);
+                if (updateDue)
+                    ctrl.update(actor.getUpdateSchedule().mDuration);
+
+                // Bones of skipped actors don't move, so neither do their skinned body parts
+                if (MWRender::Animation* animation = world->getAnimation(actor.getPtr()))
+                {
+                    animation->setSkinOnRequest(actor.getUpdateSchedule().mBucket != 0);
+                    if (updateDue)
+                        animation->requestSkinning();
+                }
 
                 updateVisibility(actor.getPtr(), ctrl);
             }
@@ -2207,6 +2331,13 @@ namespace MWMechanics
     void Actors::getActorsSidingWith(
         const MWWorld::Ptr& actor, std::set<MWWorld::Ptr>& out, bool excludeInfighting) const
     {
+        if (!excludeInfighting)
+        {
+            mAllies.refresh();
+            const std::set<MWWorld::Ptr>& allies = mAllies.getActorsSidingWith(actor);
+            out.insert(allies.begin(), allies.end());
+            return;
+        }
         auto followers = getActorsSidingWith(actor, excludeInfighting);
         for (const MWWorld::Ptr& follower : followers)
             if (out.insert(follower).second && follower != actor)
@@ -2326,6 +2457,7 @@ namespace MWMechanics
         mIndex.clear();
         mActors.clear();
         mDeathCount.clear();
+        SidingCache::invalidate();
     }
 
     void Actors::updateMagicEffects(const MWWorld::Ptr& ptr) const
@@ -2396,6 +2528,15 @@ namespace MWMechanics
         return it->second->isTurningToPlayer();
     }
 
+    bool Actors::isUpdateDue(const MWWorld::Ptr& ptr) const
+    {
+        const auto it = mIndex.find(ptr.mRef);
+        if (it == mIndex.end())
+            return true;
+
+        return it->second->getUpdateSchedule().mDue;
+    }
+
     void Actors::fastForwardAi() const
     {
         if (!MWBase::Environment::get().getMechanicsManager()->isAIActive())
@@ -2412,32 +2553,4 @@ namespace MWMechanics
             seq.fastForward(ptr);
         }
     }
-
-    const std::set<MWWorld::Ptr>& SidingCache::getActorsSidingWith(const MWWorld::Ptr& actor)
-    {
-        // If we have already found actor's allies, use the cache
-        auto search = mCache.find(actor);
-        if (search != mCache.end())
-            return search->second;
-        std::set<MWWorld::Ptr>& out = mCache[actor];
-        for (const MWWorld::Ptr& follower : mActors.getActorsSidingWith(actor, mExcludeInfighting))
-        {
-            if (out.insert(follower).second && follower != actor)
-            {
-                const auto& allies = getActorsSidingWith(follower);
-                out.insert(allies.begin(), allies.end());
-            }
-        }
-
-        // Cache ptrs and their sets of allies
-        for (const MWWorld::Ptr& iter : out)
-        {
-            if (iter == actor)
-                continue;
-            search = mCache.find(iter);
-            if (search == mCache.end())
-                mCache.emplace(iter, out);
-        }
-        return out;
-    }
 }
@@ -3,11 +3,14 @@
 
 #include <list>
 #include <map>
+#include <memory>
 #include <set>
 #include <string>
 #include <vector>
 
 #include "actor.hpp"
+#include "sidingcache.hpp"
+#include "updatescheduler.hpp"
 
 namespace ESM
 {
@@ -25,6 +28,11 @@ namespace Loading
     class Listener;
 }
 
+namespace Misc
+{
+    class JobPool;
+}
+
 namespace MWWorld
 {
     class Ptr;
@@ -36,11 +44,13 @@ namespace MWMechanics
     class Actor;
     class CharacterController;
     class CreatureStats;
-    class SidingCache;
 
     class Actors
     {
     public:
+        Actors();
+        ~Actors();
+
         std::list<Actor>::const_iterator begin() const { return mActors.begin(); }
         std::list<Actor>::const_iterator end() const { return mActors.end(); }
         std::size_t size() const { return mActors.size(); }
@@ -137,7 +147,7 @@ namespace MWMechanics
 
         /// Recursive version of getActorsFollowing
         void getActorsFollowing(const MWWorld::Ptr& actor, std::set<MWWorld::Ptr>& out) const;
-        /// Recursive version of getActorsSidingWith
+        /// Recursive version of getActorsSidingWith. The result is cached until AI packages or actors change.
         void getActorsSidingWith(
             const MWWorld::Ptr& actor, std::set<MWWorld::Ptr>& out, bool excludeInfighting = false) const;
 
@@ -167,6 +177,9 @@ namespace MWMechanics
         GreetingState getGreetingState(const MWWorld::Ptr& ptr) const;
         bool isTurningToPlayer(const MWWorld::Ptr& ptr) const;
 
+        /// Returns false if actor update is skipped this frame due to reduced update rate
+        bool isUpdateDue(const MWWorld::Ptr& ptr) const;
+
     private:
         std::map<ESM::RefId, int> mDeathCount;
         std::list<Actor> mActors;
@@ -178,6 +191,12 @@ namespace MWMechanics
         float mTimerUpdateHello = 0;
         float mSneakTimer = 0; // Times update of sneak icon
         float mSneakSkillTimer = 0; // Times sneak skill progress from "avoid notice"
+        UpdateScheduler mUpdateScheduler;
+        // Runs independent per actor computations, nullptr when they are done on the main thread
+        std::unique_ptr<Misc::JobPool> mJobPool;
+        mutable SidingCache mAllies{ *this, false };
+        // Refreshed once per update, engageCombat and updateCrimePursuit hold references between calls
+        SidingCache mAlliesExcludingInfighting{ *this, true };
 
         void updateVisibility(const MWWorld::Ptr& ptr, CharacterController& ctrl) const;
 
@@ -200,23 +219,6 @@ namespace MWMechanics
         void engageCombat(const MWWorld::Ptr& actor1, const MWWorld::Ptr& actor2, SidingCache& cachedAllies,
             bool againstPlayer) const;
     };
-
-    class SidingCache
-    {
-        const Actors& mActors;
-        const bool mExcludeInfighting;
-        std::map<MWWorld::Ptr, std::set<MWWorld::Ptr>> mCache;
-
-    public:
-        SidingCache(const Actors& actors, bool excludeInfighting)
-            : mActors(actors)
-            , mExcludeInfighting(excludeInfighting)
-        {
-        }
-
-        /// Recursive version of getActorsSidingWith that takes, returns a cached set of allies
-        const std::set<MWWorld::Ptr>& getActorsSidingWith(const MWWorld::Ptr& actor);
-    };
 }
 
 #endif
@@ -232,14 +232,18 @@ namespace MWMechanics
             }
         }
 
-        for (const ESM::Spell* spell : spells)
+        const float magicka = actor.getClass().getCreatureStats(actor).getMagicka().getCurrent();
+        for (const CastableSpell& castable : spells.getCastableSpells())
         {
-            float rating = rateSpell(spell, actor, enemy);
+            // The success chance of a spell the actor can't afford is 0, don't calculate it
+            if (castable.mCost > 0 && magicka < castable.mCost)
+                continue;
+            float rating = rateSpell(castable.mSpell, actor, enemy);
             if (rating > bestActionRating)
             {
                 bestActionRating = rating;
-                bestAction = std::make_unique<ActionSpell>(spell->mId);
-                antiFleeRating = vanillaRateSpell(spell, actor, enemy);
+                bestAction = std::make_unique<ActionSpell>(castable.mSpell->mId);
+                antiFleeRating = vanillaRateSpell(castable.mSpell, actor, enemy);
             }
         }
 
@@ -290,9 +294,12 @@ namespace MWMechanics
             }
         }
 
-        for (const ESM::Spell* spell : spells)
+        const float magicka = actor.getClass().getCreatureStats(actor).getMagicka().getCurrent();
+        for (const CastableSpell& castable : spells.getCastableSpells())
         {
-            float rating = rateSpell(spell, actor, enemy);
+            if (castable.mCost > 0 && magicka < castable.mCost)
+                continue;
+            float rating = rateSpell(castable.mSpell, actor, enemy);
             if (rating > bestActionRating)
             {
                 bestActionRating = rating;
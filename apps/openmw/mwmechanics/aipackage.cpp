@@ -174,40 +174,47 @@ bool MWMechanics::AiPackage::pathTo(const MWWorld::Ptr& actor, const osg::Vec3f&
 
         if (!mIsShortcutting)
         {
-            if (wasShortcutting || doesPathNeedRecalc(dest, actor)) // if need to rebuild path
+            // if need to rebuild path and it's not being found already
+            if (!mPathFinder.isPathRequested() && (wasShortcutting || doesPathNeedRecalc(dest, actor)))
             {
                 const ESM::Pathgrid* pathgrid
                     = world->getStore().get<ESM::Pathgrid>().search(*actor.getCell()->getCell());
                 const DetourNavigator::Flags navigatorFlags = getNavigatorFlags(actor);
                 const DetourNavigator::AreaCosts areaCosts = getAreaCosts(actor, navigatorFlags);
-                mPathFinder.buildLimitedPath(actor, position, dest, getPathGridGraph(pathgrid), agentBounds,
+                mPathFinder.requestLimitedPath(actor, position, dest, getPathGridGraph(pathgrid), agentBounds,
                     navigatorFlags, areaCosts, endTolerance, pathType);
-                mRotateOnTheRunChecks = 3;
-
-                // give priority to go directly on target if there is minimal opportunity
-                if (destInLOS && mPathFinder.getPath().size() > 1)
-                {
-                    // get point just before dest
-                    auto pPointBeforeDest = mPathFinder.getPath().rbegin() + 1;
-
-                    // if start point is closer to the target then last point of path (excluding target itself) then go
-                    // straight on the target
-                    if (distance(position, dest) <= distance(dest, *pPointBeforeDest))
-                    {
-                        mPathFinder.clearPath();
-                        mPathFinder.addPointToPath(dest);
-                    }
-                }
+                mRequestedDestInLOS = destInLOS;
             }
 
-            if (!mPathFinder.getPath().empty()) // Path has points in it
+            // the requested path is adjusted once it is found
+            if (!mPathFinder.isPathRequested())
+                addDestinationToPath(dest);
+        }
+    }
+
+    if (!mIsShortcutting && mPathFinder.isPathRequested())
+    {
+        const ESM::Pathgrid* pathgrid = world->getStore().get<ESM::Pathgrid>().search(*actor.getCell()->getCell());
+        if (mPathFinder.updateRequestedPath(actor, getPathGridGraph(pathgrid)))
+        {
+            mRotateOnTheRunChecks = 3;
+
+            // give priority to go directly on target if there is minimal opportunity
+            if (mRequestedDestInLOS && mPathFinder.getPath().size() > 1)
             {
-                const osg::Vec3f& lastPos = mPathFinder.getPath().back(); // Get the end of the proposed path
+                // get point just before dest
+                auto pPointBeforeDest = mPathFinder.getPath().rbegin() + 1;
 
-                if (distance(dest, lastPos) > 100) // End of the path is far from the destination
-                    mPathFinder.addPointToPath(
-                        dest); // Adds the final destination to the path, to try to get to where you want to go
+                // if start point is closer to the target then last point of path (excluding target itself) then go
+                // straight on the target
+                if (distance(position, dest) <= distance(dest, *pPointBeforeDest))
+                {
+                    mPathFinder.clearPath();
+                    mPathFinder.addPointToPath(dest);
+                }
             }
+
+            addDestinationToPath(dest);
         }
     }
 
@@ -432,6 +439,18 @@ bool MWMechanics::AiPackage::checkWayIsClearForActor(
     return false;
 }
 
+void MWMechanics::AiPackage::addDestinationToPath(const osg::Vec3f& dest)
+{
+    if (!mPathFinder.getPath().empty()) // Path has points in it
+    {
+        const osg::Vec3f& lastPos = mPathFinder.getPath().back(); // Get the end of the proposed path
+
+        if (distance(dest, lastPos) > 100) // End of the path is far from the destination
+            mPathFinder.addPointToPath(
+                dest); // Adds the final destination to the path, to try to get to where you want to go
+    }
+}
+
 bool MWMechanics::AiPackage::doesPathNeedRecalc(const osg::Vec3f& newDest, const MWWorld::Ptr& actor) const
 {
     return mPathFinder.getPath().empty() || getPathDistance(actor, mPathFinder.getPath().back(), newDest) > 10
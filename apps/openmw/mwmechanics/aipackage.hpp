@@ -151,6 +151,8 @@ namespace MWMechanics
 
         bool doesPathNeedRecalc(const osg::Vec3f& newDest, const MWWorld::Ptr& actor) const;
 
+        void addDestinationToPath(const osg::Vec3f& dest);
+
         void evadeObstacles(const MWWorld::Ptr& actor);
 
         void openDoors(const MWWorld::Ptr& actor);
@@ -177,6 +179,7 @@ namespace MWMechanics
         short mRotateOnTheRunChecks; // attempts to check rotation to the pathpoint on the run possibility
 
         bool mIsShortcutting; // if shortcutting at the moment
+        bool mRequestedDestInLOS = false; // if destination was in line of sight when the path was requested
         bool mShortcutProhibited; // shortcutting may be prohibited after unsuccessful attempt
         osg::Vec3f mShortcutFailPos; // position of last shortcut fail
         float mLastDestinationTolerance = 0;
@@ -8,6 +8,7 @@
 
 #include "../mwbase/environment.hpp"
 #include "../mwbase/mechanicsmanager.hpp"
+#include "../mwbase/world.hpp"
 #include "../mwworld/class.hpp"
 #include "actorutil.hpp"
 #include "aiactivate.hpp"
@@ -17,9 +18,11 @@
 #include "aifollow.hpp"
 #include "aipackage.hpp"
 #include "aipursue.hpp"
+#include "aitimer.hpp"
 #include "aitravel.hpp"
 #include "aiwander.hpp"
 #include "creaturestats.hpp"
+#include "sidingcache.hpp"
 
 namespace MWMechanics
 {
@@ -35,6 +38,8 @@ namespace MWMechanics
 
         mNumCombatPackages = sequence.mNumCombatPackages;
         mNumPursuitPackages = sequence.mNumPursuitPackages;
+
+        SidingCache::invalidate();
     }
 
     AiSequence::AiSequence()
@@ -77,6 +82,8 @@ namespace MWMechanics
 
         assert(mNumCombatPackages >= 0);
         assert(mNumPursuitPackages >= 0);
+
+        SidingCache::invalidate();
     }
 
     void AiSequence::onPackageRemoved(const AiPackage& package)
@@ -92,6 +99,8 @@ namespace MWMechanics
 
         assert(mNumCombatPackages >= 0);
         assert(mNumPursuitPackages >= 0);
+
+        SidingCache::invalidate();
     }
 
     AiPackageTypeId AiSequence::getTypeId() const
@@ -280,6 +289,14 @@ namespace MWMechanics
 
             float bestRating = 0.f;
 
+            mCombatTargetRatingsTimer -= duration;
+            if (mCombatTargetRatingsTimer <= 0)
+            {
+                mCombatTargetRatings.clear();
+                mCombatTargetRatingsTimer = Misc::Rng::deviate(AI_REACTION_TIME, AiReactionTimer::sDeviation,
+                    MWBase::Environment::get().getWorld()->getPrng());
+            }
+
             for (auto it = mPackages.begin(); it != mPackages.end();)
             {
                 if ((*it)->getTypeId() != AiPackageTypeId::Combat)
@@ -294,9 +311,7 @@ namespace MWMechanics
                 }
                 else
                 {
-                    float rating = 0.f;
-                    if (MWMechanics::canFight(actor, target))
-                        rating = MWMechanics::getBestActionRating(actor, target);
+                    const float rating = getCombatTargetRating(actor, target);
 
                     const ESM::Position& targetPos = target.getRefData().getPosition();
 
@@ -325,6 +340,7 @@ namespace MWMechanics
                 assert(itActualCombat != mPackages.end());
                 // move combat package with nearest target to the front
                 std::rotate(mPackages.begin(), itActualCombat, std::next(itActualCombat));
+                SidingCache::invalidate();
             }
 
             package = mPackages.front().get();
@@ -364,11 +380,28 @@ namespace MWMechanics
         }
     }
 
+    float AiSequence::getCombatTargetRating(const MWWorld::Ptr& actor, const MWWorld::Ptr& target)
+    {
+        const int targetActorId = target.getClass().getCreatureStats(target).getActorId();
+        const auto it = std::find_if(mCombatTargetRatings.begin(), mCombatTargetRatings.end(),
+            [&](const CombatTargetRating& v) { return v.mActorId == targetActorId; });
+        if (it != mCombatTargetRatings.end())
+            return it->mRating;
+
+        float rating = 0.f;
+        if (MWMechanics::canFight(actor, target))
+            rating = MWMechanics::getBestActionRating(actor, target);
+        mCombatTargetRatings.push_back(CombatTargetRating{ targetActorId, rating });
+        return rating;
+    }
+
     void AiSequence::clear()
     {
         mPackages.clear();
+        mCombatTargetRatings.clear();
         mNumCombatPackages = 0;
         mNumPursuitPackages = 0;
+        SidingCache::invalidate();
     }
 
     void AiSequence::stack(const AiPackage& package, const MWWorld::Ptr& actor, bool cancelOther)
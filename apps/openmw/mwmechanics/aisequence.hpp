@@ -44,6 +44,18 @@ namespace MWMechanics
         int mNumCombatPackages{};
         int mNumPursuitPackages{};
 
+        struct CombatTargetRating
+        {
+            int mActorId;
+            float mRating;
+        };
+
+        /// Best action ratings against the combat targets, rating every weapon, spell and item of the actor against
+        /// every target each frame is too slow for large battles
+        std::vector<CombatTargetRating> mCombatTargetRatings;
+        /// Time left until the ratings are recalculated, deviates to spread recalculations of actors over frames
+        float mCombatTargetRatingsTimer{};
+
         /// Copy AiSequence
         void copy(const AiSequence& sequence);
 
@@ -56,6 +68,8 @@ namespace MWMechanics
 
         AiPackages::iterator erase(AiPackages::iterator package);
 
+        float getCombatTargetRating(const MWWorld::Ptr& actor, const MWWorld::Ptr& target);
+
     public:
         /// Default constructor
         AiSequence();
@@ -13,11 +13,26 @@
 
 #include "../mwworld/class.hpp"
 #include "../mwworld/cellstore.hpp"
+#include "../mwworld/datetimemanager.hpp"
 #include "../mwworld/esmstore.hpp"
+#include "../mwworld/worldmodel.hpp"
+
+#include "actorutil.hpp"
 
 namespace
 {
     std::unique_ptr<MWMechanics::ALifeSimulation> sALifeSimulation;
+
+    // A pass over all simulated NPCs is spread over frames to not spike the frame time with long lists
+    constexpr std::size_t sNPCsPerFrame = 32;
+
+    // Game hours between updates of things simulated coarsely
+    constexpr float sCoarseUpdateHours = 1.0f;
+
+    float getCurrentGameHours()
+    {
+        return static_cast<float>(MWBase::Environment::get().getWorld()->getTimeManager()->getGameTime() / 3600.0);
+    }
 }
 
 namespace MWMechanics
@@ -105,9 +120,9 @@ namespace MWMechanics
 
     // ======================== SimulatedNPCState ========================
 
-    void SimulatedNPCState::updateSimulated(float gameHours, float dt)
+    void SimulatedNPCState::updateSimulated(float gameHours)
     {
-        needs.update(dt / 3600.0f); // Convert to game hours
+        needs.update(std::max(0.0f, gameHours - lastUpdateTime));
         lastUpdateTime = gameHours;
     }
 
@@ -115,7 +130,10 @@ namespace MWMechanics
     {
         for (auto& entry : schedule)
         {
-            if (gameHour >= entry.startHour && gameHour < entry.endHour)
+            const bool inEntry = entry.startHour <= entry.endHour
+                ? gameHour >= entry.startHour && gameHour < entry.endHour
+                : gameHour >= entry.startHour || gameHour < entry.endHour;
+            if (inEntry)
                 return &entry;
         }
         return nullptr;
@@ -150,6 +168,8 @@ namespace MWMechanics
         if (!mEnabled)
             return;
 
+        updateNPCs(gameHours, dt);
+
         // Check if enough time has passed for update
         float gameMinutesPassed = (gameHours - mLastUpdateTime) * 60.0f;
         if (gameMinutesPassed < mUpdateInterval)
@@ -157,24 +177,10 @@ namespace MWMechanics
 
         mLastUpdateTime = gameHours;
 
-        // Update simulated NPCs
-        int maxNPCs = Settings::game().mALifeMaxSimulatedNPCs;
-        int updatedCount = 0;
-
-        for (auto& [npcId, state] : mSimulatedNPCs)
-        {
-            if (updatedCount >= maxNPCs)
-                break;
-
-            if (mSchedulesEnabled)
-                updateNPCSchedule(state, gameHours);
-
-            if (mNeedsEnabled)
-                updateNPCNeeds(state, gameHours, dt);
-
-            state.updateSimulated(gameHours, dt);
-            ++updatedCount;
-        }
+        // Start a new pass over the simulated NPCs from the next frame on, continuing where the last one stopped when
+        // not all of them fit
+        const std::size_t maxNPCs = static_cast<std::size_t>(Settings::game().mALifeMaxSimulatedNPCs);
+        mPendingNPCs = std::min(mSimulatedNPCs.size(), maxNPCs);
 
         // Update world systems
         if (mEconomyEnabled)
@@ -190,18 +196,89 @@ namespace MWMechanics
         }
     }
 
+    ALifeSimulation::SimulationTier ALifeSimulation::getSimulationTier(
+        const ESM::RefId& cell, const MWWorld::CellStore* playerCell)
+    {
+        if (playerCell == nullptr)
+            return SimulationTier::Full;
+
+        const MWWorld::Cell& player = *playerCell->getCell();
+        if (cell == player.getId())
+            return SimulationTier::Full;
+
+        const MWWorld::CellStore* cellStore = MWBase::Environment::get().getWorldModel()->findCell(cell, false);
+        if (cellStore == nullptr)
+            return SimulationTier::Dormant;
+
+        const MWWorld::Cell& other = *cellStore->getCell();
+        if (other.isExterior() && player.isExterior() && other.getWorldSpace() == player.getWorldSpace()
+            && std::abs(other.getGridX() - player.getGridX()) <= 1
+            && std::abs(other.getGridY() - player.getGridY()) <= 1)
+            return SimulationTier::Full;
+
+        if (!other.getRegion().empty() && other.getRegion() == player.getRegion())
+            return SimulationTier::Coarse;
+
+        return SimulationTier::Dormant;
+    }
+
+    bool ALifeSimulation::needsUpdate(SimulationTier tier, float lastUpdateTime, float gameHours)
+    {
+        switch (tier)
+        {
+            case SimulationTier::Full:
+                return true;
+            case SimulationTier::Coarse:
+                return gameHours - lastUpdateTime >= sCoarseUpdateHours;
+            case SimulationTier::Dormant:
+                break;
+        }
+        return false;
+    }
+
+    void ALifeSimulation::updateNPCs(float gameHours, float dt)
+    {
+        const MWWorld::Ptr player = getPlayer();
+        const MWWorld::CellStore* playerCell = player.isEmpty() ? nullptr : player.getCell();
+
+        for (std::size_t i = 0; i < sNPCsPerFrame && mPendingNPCs > 0 && !mSimulatedNPCs.empty(); ++i)
+        {
+            if (mNextNPC >= mSimulatedNPCs.size())
+                mNextNPC = 0;
+
+            SimulatedNPCState& state = mSimulatedNPCs[mNextNPC];
+            if (needsUpdate(getSimulationTier(state.currentCell, playerCell), state.lastUpdateTime, gameHours))
+                updateNPC(state, gameHours);
+
+            ++mNextNPC;
+            --mPendingNPCs;
+        }
+    }
+
+    void ALifeSimulation::updateNPC(SimulatedNPCState& state, float gameHours)
+    {
+        if (mSchedulesEnabled)
+            updateNPCSchedule(state, gameHours);
+
+        state.updateSimulated(gameHours);
+
+        if (mNeedsEnabled)
+            updateNPCNeeds(state, gameHours);
+    }
+
     void ALifeSimulation::registerNPC(const MWWorld::Ptr& npc)
     {
         if (!mEnabled || npc.isEmpty())
             return;
 
         ESM::RefId npcId = npc.getCellRef().getRefId();
-        if (mSimulatedNPCs.find(npcId) != mSimulatedNPCs.end())
+        if (mSimulatedNPCIndices.find(npcId) != mSimulatedNPCIndices.end())
             return;
 
         SimulatedNPCState state;
         state.npcId = npcId;
         state.position = npc.getRefData().getPosition().asVec3();
+        state.lastUpdateTime = getCurrentGameHours();
 
         if (npc.getCell())
             state.currentCell = npc.getCell()->getCell()->getId();
@@ -228,19 +305,31 @@ namespace MWMechanics
         eat.mandatory = false;
         state.schedule.push_back(eat);
 
-        mSimulatedNPCs[npcId] = state;
+        mSimulatedNPCIndices.emplace(npcId, mSimulatedNPCs.size());
+        mSimulatedNPCs.push_back(std::move(state));
     }
 
     void ALifeSimulation::unregisterNPC(const ESM::RefId& npcId)
     {
-        mSimulatedNPCs.erase(npcId);
+        auto it = mSimulatedNPCIndices.find(npcId);
+        if (it == mSimulatedNPCIndices.end())
+            return;
+
+        const std::size_t index = it->second;
+        mSimulatedNPCIndices.erase(it);
+        if (index + 1 != mSimulatedNPCs.size())
+        {
+            mSimulatedNPCs[index] = std::move(mSimulatedNPCs.back());
+            mSimulatedNPCIndices[mSimulatedNPCs[index].npcId] = index;
+        }
+        mSimulatedNPCs.pop_back();
     }
 
     const SimulatedNPCState* ALifeSimulation::getNPCState(const ESM::RefId& npcId) const
     {
-        auto it = mSimulatedNPCs.find(npcId);
-        if (it != mSimulatedNPCs.end())
-            return &it->second;
+        auto it = mSimulatedNPCIndices.find(npcId);
+        if (it != mSimulatedNPCIndices.end())
+            return &mSimulatedNPCs[it->second];
         return nullptr;
     }
 
@@ -250,9 +339,13 @@ namespace MWMechanics
             return;
 
         ESM::RefId npcId = npc.getCellRef().getRefId();
-        const SimulatedNPCState* state = getNPCState(npcId);
-        if (!state)
+        auto it = mSimulatedNPCIndices.find(npcId);
+        if (it == mSimulatedNPCIndices.end())
             return;
+        SimulatedNPCState* state = &mSimulatedNPCs[it->second];
+
+        // Catch up with the time the NPC spent far from the player
+        updateNPC(*state, getCurrentGameHours());
 
         // Apply simulated position if NPC was simulated in background
         // In a full implementation, this would teleport NPC to correct location
@@ -318,9 +411,9 @@ namespace MWMechanics
         }
     }
 
-    void ALifeSimulation::updateNPCSchedule(SimulatedNPCState& state, float gameHour)
+    void ALifeSimulation::updateNPCSchedule(SimulatedNPCState& state, float gameHours)
     {
-        ScheduleEntry* currentEntry = state.getCurrentScheduleEntry(gameHour);
+        ScheduleEntry* currentEntry = state.getCurrentScheduleEntry(std::fmod(gameHours, 24.0f));
         if (currentEntry)
         {
             state.currentActivity = currentEntry->activity;
@@ -329,10 +422,8 @@ namespace MWMechanics
         }
     }
 
-    void ALifeSimulation::updateNPCNeeds(SimulatedNPCState& state, float gameHours, float dt)
+    void ALifeSimulation::updateNPCNeeds(SimulatedNPCState& state, float gameHours)
     {
-        state.needs.update(dt / 3600.0f);
-
         // NPCs act on urgent needs
         if (state.needs.hunger > 80.0f && state.currentActivity != "eat")
         {
@@ -346,17 +437,26 @@ namespace MWMechanics
 
     void ALifeSimulation::updateEconomy(float gameHours, float dt)
     {
+        const MWWorld::Ptr player = getPlayer();
+        const MWWorld::CellStore* playerCell = player.isEmpty() ? nullptr : player.getCell();
         for (auto& [location, economy] : mLocationEconomies)
         {
-            economy.update(dt / 3600.0f);
+            if (!needsUpdate(getSimulationTier(location, playerCell), economy.lastUpdateTime, gameHours))
+                continue;
+            economy.update(std::max(0.0f, gameHours - economy.lastUpdateTime));
+            economy.lastUpdateTime = gameHours;
         }
     }
 
     void ALifeSimulation::updateFactionTerritories(float gameHours, float dt)
     {
+        // Territories span many cells, they are always simulated coarsely
         for (auto& [faction, territory] : mFactionTerritories)
         {
-            territory.update(dt / 3600.0f);
+            if (!needsUpdate(SimulationTier::Coarse, territory.lastUpdateTime, gameHours))
+                continue;
+            territory.update(std::max(0.0f, gameHours - territory.lastUpdateTime));
+            territory.lastUpdateTime = gameHours;
         }
     }
 
@@ -443,7 +543,7 @@ namespace MWMechanics
             {
                 case WorldEventType::BanditRaid:
                     // Could spawn bandits, affect NPC safety
-                    for (auto& [npcId, state] : mSimulatedNPCs)
+                    for (SimulatedNPCState& state : mSimulatedNPCs)
                     {
                         if (state.currentCell == event.location)
                             state.needs.safety -= event.intensity * 10.0f * (dt / 3600.0f);
@@ -464,7 +564,7 @@ namespace MWMechanics
 
                 case WorldEventType::Festival:
                     // Increases NPC social satisfaction
-                    for (auto& [npcId, state] : mSimulatedNPCs)
+                    for (SimulatedNPCState& state : mSimulatedNPCs)
                     {
                         if (state.currentCell == event.location)
                             state.needs.social = std::min(100.0f, state.needs.social + 5.0f * (dt / 3600.0f));
@@ -9,6 +9,7 @@
 #include <memory>
 #include <set>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
 namespace MWMechanics
@@ -55,6 +56,7 @@ namespace MWMechanics
         std::map<ESM::RefId, int> itemSupply;            // Item -> supply level
         std::map<ESM::RefId, int> itemDemand;            // Item -> demand level
         float wealthLevel = 1.0f;                         // Overall economic health
+        float lastUpdateTime = 0.0f;                      // Game time in hours the economy is updated to
 
         void update(float gameHours);
         float getPriceModifier(const ESM::RefId& item) const;
@@ -67,6 +69,7 @@ namespace MWMechanics
         std::set<ESM::RefId> controlledCells;
         float influence = 1.0f;     // 0-1, strength in area
         float stability = 1.0f;     // 0-1, how secure the control is
+        float lastUpdateTime = 0.0f; // Game time in hours the territory is updated to
         
         void update(float gameHours);
     };
@@ -116,7 +119,9 @@ namespace MWMechanics
         std::vector<ScheduleEntry> schedule;
         int currentScheduleIndex = 0;
 
-        void updateSimulated(float gameHours, float dt);
+        /// Advance the needs to the game time, the needs change linearly so any time span is caught up at once
+        void updateSimulated(float gameHours);
+        /// @param gameHour hour of the day, entries may wrap around midnight
         ScheduleEntry* getCurrentScheduleEntry(float gameHour);
     };
 
@@ -141,6 +146,7 @@ namespace MWMechanics
         void unregisterNPC(const ESM::RefId& npcId);
 
         /// Get simulated state for an NPC
+        /// @note The pointer is invalidated by registering or unregistering NPCs
         const SimulatedNPCState* getNPCState(const ESM::RefId& npcId) const;
 
         /// Apply simulated state when NPC becomes active
@@ -172,14 +178,35 @@ namespace MWMechanics
         void notifyPlayerOfEvent(const WorldEvent& event);
 
     private:
-        void updateNPCSchedule(SimulatedNPCState& state, float gameHour);
-        void updateNPCNeeds(SimulatedNPCState& state, float gameHours, float dt);
+        /// How closely something is simulated depending on the distance of its cell from the player
+        enum class SimulationTier
+        {
+            Full, // The player's cell and its neighbours, updated on every pass
+            Coarse, // The player's region, updated once per game hour
+            Dormant, // Not updated, caught up at once when it gets closer to the player
+        };
+
+        static SimulationTier getSimulationTier(const ESM::RefId& cell, const MWWorld::CellStore* playerCell);
+
+        static bool needsUpdate(SimulationTier tier, float lastUpdateTime, float gameHours);
+
+        void updateNPC(SimulatedNPCState& state, float gameHours);
+        void updateNPCSchedule(SimulatedNPCState& state, float gameHours);
+        void updateNPCNeeds(SimulatedNPCState& state, float gameHours);
         void updateEconomy(float gameHours, float dt);
         void updateFactionTerritories(float gameHours, float dt);
         void generateWorldEvent(float gameHours);
         void processActiveEvents(float gameHours, float dt);
 
-        std::map<ESM::RefId, SimulatedNPCState> mSimulatedNPCs;
+        void updateNPCs(float gameHours, float dt);
+
+        // Kept dense to walk them cache friendly, unregistering moves the last NPC into the freed slot
+        std::vector<SimulatedNPCState> mSimulatedNPCs;
+        std::unordered_map<ESM::RefId, std::size_t> mSimulatedNPCIndices;
+        // Position of the update pass in mSimulatedNPCs and how many NPCs it still has to update, a pass is spread
+        // over frames
+        std::size_t mNextNPC = 0;
+        std::size_t mPendingNPCs = 0;
         std::map<ESM::RefId, LocationEconomy> mLocationEconomies;
         std::map<ESM::RefId, FactionTerritory> mFactionTerritories;
         std::vector<WorldEvent> mActiveEvents;
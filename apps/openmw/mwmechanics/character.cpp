@@ -21,6 +21,7 @@
 
 #include <array>
 #include <unordered_set>
+#include <utility>
 
 #include <components/esm/records.hpp>
 #include <components/misc/mathutil.hpp>
@@ -2534,7 +2535,7 @@ namespace MWMechanics
 
     void CharacterController::unpersistAnimationState()
     {
-        const ESM::AnimationState& state = mPtr.getRefData().getAnimationState();
+        const ESM::AnimationState& state = std::as_const(mPtr.getRefData()).getAnimationState();
 
         if (!state.mScriptedAnims.empty())
         {
@@ -15,6 +15,8 @@
 #include "../mwbase/environment.hpp"
 #include "../mwbase/world.hpp"
 
+#include "sidingcache.hpp"
+
 namespace MWMechanics
 {
     int CreatureStats::sActorId = 0;
@@ -136,6 +138,7 @@ namespace MWMechanics
         if (value != currentValue)
         {
             mAttributes[id] = value;
+            ++mAttributesRevision;
 
             if (id == ESM::Attribute::Intelligence)
                 recalculateMagicka();
@@ -180,7 +183,10 @@ namespace MWMechanics
         if (index == 0 && mDynamic[index].getCurrent() < 1)
         {
             if (!mDead)
+            {
                 mTimeOfDeath = MWBase::Environment::get().getWorld()->getTimeStamp();
+                SidingCache::invalidate();
+            }
 
             mDead = true;
 
@@ -266,6 +272,7 @@ namespace MWMechanics
         {
             mDynamic[0].setCurrent(mDynamic[0].getBase());
             mDead = false;
+            SidingCache::invalidate();
             mDeathAnimationFinished = false;
         }
     }
@@ -565,6 +572,7 @@ namespace MWMechanics
         {
             for (size_t i = 0; i < state.mAttributes.size(); ++i)
                 mAttributes[ESM::Attribute::indexToRefId(static_cast<int>(i))].readState(state.mAttributes[i]);
+            ++mAttributesRevision;
 
             for (size_t i = 0; i < state.mDynamic.size(); ++i)
                 mDynamic[i].readState(state.mDynamic[i]);
@@ -577,6 +585,7 @@ namespace MWMechanics
         mLastRestock = MWWorld::TimeStamp(state.mTradeTime);
 
         mDead = state.mDead;
+        SidingCache::invalidate();
         mDeathAnimationFinished = state.mDeathAnimationFinished;
         mDied = state.mDied;
         mMurdered = state.mMurdered;
@@ -40,6 +40,7 @@ namespace MWMechanics
     {
         static int sActorId;
         std::map<ESM::RefId, AttributeValue> mAttributes;
+        std::size_t mAttributesRevision = 0;
         DynamicStat<float> mDynamic[3]; // health, magicka, fatigue
         DrawState mDrawState = DrawState::Nothing;
         Spells mSpells;
@@ -121,6 +122,9 @@ namespace MWMechanics
 
         const AttributeValue& getAttribute(ESM::RefId id) const;
 
+        /// Changes every time an attribute changes, to not compare all of them to find out
+        std::size_t getAttributesRevision() const { return mAttributesRevision; }
+
         const DynamicStat<float>& getHealth() const;
 
         const DynamicStat<float>& getMagicka() const;
@@ -1,9 +1,11 @@
+#include <algorithm>
+#include <iterator>
+
 #include <components/debug/debuglog.hpp>
 #include <components/esm3/loadlevlist.hpp>
 
 #include "../mwworld/class.hpp"
 #include "../mwworld/esmstore.hpp"
-#include "../mwworld/manualref.hpp"
 #include "../mwworld/ptr.hpp"
 
 #include "../mwbase/environment.hpp"
@@ -14,12 +16,67 @@
 
 namespace MWMechanics
 {
+    namespace
+    {
+        LevelledListTable::Category getCategory(const ESM::RefId& id, const MWWorld::ESMStore& store)
+        {
+            switch (store.find(id))
+            {
+                case 0:
+                    return LevelledListTable::Category::Missing;
+                case ESM::ItemLevList::sRecordId:
+                    return LevelledListTable::Category::ItemList;
+                case ESM::CreatureLevList::sRecordId:
+                    return LevelledListTable::Category::CreatureList;
+                default:
+                    return LevelledListTable::Category::Object;
+            }
+        }
+    }
+
+    LevelledListTable::LevelledListTable(
+        const ESM::LevelledListBase& list, bool creature, const MWWorld::ESMStore& store)
+    {
+        // For levelled creatures, the flags are swapped. This file format just makes so much sense.
+        bool allLevels = (list.mFlags & ESM::ItemLevList::AllLevels) != 0;
+        if (creature)
+            allLevels = list.mFlags & ESM::CreatureLevList::AllLevels;
+
+        std::vector<const ESM::LevelledListBase::LevelItem*> items;
+        items.reserve(list.mList.size());
+        for (const ESM::LevelledListBase::LevelItem& item : list.mList)
+            items.push_back(&item);
+        std::stable_sort(items.begin(), items.end(),
+            [](const auto* lhs, const auto* rhs) { return lhs->mLevel < rhs->mLevel; });
+
+        mCandidates.reserve(items.size());
+        for (const ESM::LevelledListBase::LevelItem* item : items)
+        {
+            const int level = item->mLevel;
+            if (mLevels.empty() || mLevels.back().mLevel != level)
+            {
+                const std::size_t begin = allLevels ? 0 : mCandidates.size();
+                mLevels.push_back(Level{ level, begin, begin });
+            }
+            mCandidates.push_back(Candidate{ item->mId, getCategory(item->mId, store) });
+            mLevels.back().mEnd = mCandidates.size();
+        }
+    }
+
+    std::span<const LevelledListTable::Candidate> LevelledListTable::getCandidates(int level) const
+    {
+        // Only the highest level not above the given one, or everything up to it for lists using all levels
+        const auto it = std::upper_bound(
+            mLevels.begin(), mLevels.end(), level, [](int value, const Level& entry) { return value < entry.mLevel; });
+        if (it == mLevels.begin())
+            return {};
+        const Level& found = *std::prev(it);
+        return std::span(mCandidates).subspan(found.mBegin, found.mEnd - found.mBegin);
+    }
 
     ESM::RefId getLevelledItem(
         const ESM::LevelledListBase* levItem, bool creature, Misc::Rng::Generator& prng, std::optional<int> level)
     {
-        const std::vector<ESM::LevelledListBase::LevelItem>& items = levItem->mList;
-
         int playerLevel;
         if (level.has_value())
             playerLevel = *level;
@@ -33,49 +90,29 @@ namespace MWMechanics
         if (Misc::Rng::roll0to99(prng) < levItem->mChanceNone)
             return ESM::RefId();
 
-        std::vector<const ESM::RefId*> candidates;
-        int highestLevel = 0;
-        for (const auto& levelledItem : items)
-        {
-            if (levelledItem.mLevel > highestLevel && levelledItem.mLevel <= playerLevel)
-                highestLevel = levelledItem.mLevel;
-        }
-
-        // For levelled creatures, the flags are swapped. This file format just makes so much sense.
-        bool allLevels = (levItem->mFlags & ESM::ItemLevList::AllLevels) != 0;
-        if (creature)
-            allLevels = levItem->mFlags & ESM::CreatureLevList::AllLevels;
-
-        for (const auto& levelledItem : items)
-        {
-            if (playerLevel >= levelledItem.mLevel && (allLevels || levelledItem.mLevel == highestLevel))
-                candidates.push_back(&levelledItem.mId);
-        }
+        const MWWorld::ESMStore& store = *MWBase::Environment::get().getESMStore();
+        const std::shared_ptr<const LevelledListTable> table = store.getLevelledListTable(*levItem, creature);
+        const std::span<const LevelledListTable::Candidate> candidates = table->getCandidates(playerLevel);
         if (candidates.empty())
             return ESM::RefId();
-        const ESM::RefId& item = *candidates[Misc::Rng::rollDice(candidates.size(), prng)];
-
-        // Vanilla doesn't fail on nonexistent items in levelled lists
-        if (!MWBase::Environment::get().getESMStore()->find(item))
-        {
-            Log(Debug::Warning) << "Warning: ignoring nonexistent item " << item << " in levelled list "
-                                << levItem->mId;
-            return ESM::RefId();
-        }
+        const LevelledListTable::Candidate& item = candidates[Misc::Rng::rollDice(candidates.size(), prng)];
 
         // Is this another levelled item or a real item?
-        MWWorld::ManualRef ref(*MWBase::Environment::get().getESMStore(), item, 1);
-        if (ref.getPtr().getType() != ESM::ItemLevList::sRecordId
-            && ref.getPtr().getType() != ESM::CreatureLevList::sRecordId)
+        switch (item.mCategory)
         {
-            return item;
-        }
-        else
-        {
-            if (ref.getPtr().getType() == ESM::ItemLevList::sRecordId)
-                return getLevelledItem(ref.getPtr().get<ESM::ItemLevList>()->mBase, false, prng, level);
-            else
-                return getLevelledItem(ref.getPtr().get<ESM::CreatureLevList>()->mBase, true, prng, level);
+            case LevelledListTable::Category::Object:
+                return item.mId;
+            case LevelledListTable::Category::ItemList:
+                return getLevelledItem(store.get<ESM::ItemLevList>().find(item.mId), false, prng, level);
+            case LevelledListTable::Category::CreatureList:
+                return getLevelledItem(store.get<ESM::CreatureLevList>().find(item.mId), true, prng, level);
+            case LevelledListTable::Category::Missing:
+                break;
         }
+
+        // Vanilla doesn't fail on nonexistent items in levelled lists
+        Log(Debug::Warning) << "Warning: ignoring nonexistent item " << item.mId << " in levelled list "
+                            << levItem->mId;
+        return ESM::RefId();
     }
 }
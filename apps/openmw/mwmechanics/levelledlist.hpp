@@ -1,18 +1,60 @@
 #ifndef OPENMW_MECHANICS_LEVELLEDLIST_H
 #define OPENMW_MECHANICS_LEVELLEDLIST_H
 
+#include <components/esm/refid.hpp>
 #include <components/misc/rng.hpp>
 
 #include <optional>
+#include <span>
+#include <vector>
 
 namespace ESM
 {
     struct LevelledListBase;
-    class RefId;
+}
+
+namespace MWWorld
+{
+    class ESMStore;
 }
 
 namespace MWMechanics
 {
+    /// Entries of a levelled list ordered by level, so the candidates for any level are a range of them
+    class LevelledListTable
+    {
+    public:
+        enum class Category
+        {
+            Object,
+            ItemList,
+            CreatureList,
+            Missing,
+        };
+
+        struct Candidate
+        {
+            ESM::RefId mId;
+            Category mCategory;
+        };
+
+        LevelledListTable(const ESM::LevelledListBase& list, bool creature, const MWWorld::ESMStore& store);
+
+        /// @return the entries that can be picked at the given level, empty if there are none
+        std::span<const Candidate> getCandidates(int level) const;
+
+    private:
+        struct Level
+        {
+            int mLevel;
+            std::size_t mBegin;
+            std::size_t mEnd;
+        };
+
+        std::vector<Candidate> mCandidates;
+        // One for each distinct level of the entries, ascending
+        std::vector<Level> mLevels;
+    };
 
     /// @return ID of resulting item, or empty if none
     ESM::RefId getLevelledItem(
@@ -275,6 +275,7 @@ namespace MWMechanics
             MWBase::Environment::get().getWindowManager()->watchActor(MWWorld::Ptr());
         mActors.removeActor(ptr, keepActive);
         mObjects.removeObject(ptr);
+        mCrimeWitnesses = {};
     }
 
     void MechanicsManager::updateCell(const MWWorld::Ptr& old, const MWWorld::Ptr& ptr)
@@ -283,7 +284,10 @@ namespace MWMechanics
             MWBase::Environment::get().getWindowManager()->watchActor(ptr);
 
         if (ptr.getClass().isActor())
+        {
             mActors.updateActor(old, ptr);
+            mCrimeWitnesses = {};
+        }
         else
             mObjects.updateObject(old, ptr);
     }
@@ -292,10 +296,14 @@ namespace MWMechanics
     {
         mActors.dropActors(cellStore, getPlayer());
         mObjects.dropObjects(cellStore);
+        mCrimeWitnesses = {};
     }
 
     void MechanicsManager::update(float duration, bool paused)
     {
+        // Actors move and roll awareness again, witnesses of the previous frame are outdated
+        mCrimeWitnesses = {};
+
         // Note: we should do it here since game mechanics and world updates use these values
         MWWorld::Ptr ptr = getPlayer();
         MWBase::WindowManager* winMgr = MWBase::Environment::get().getWindowManager();
@@ -1157,35 +1165,36 @@ namespace MWMechanics
             victimAware = true;
 
         // Find all the actors within the alarm radius
-        std::vector<MWWorld::Ptr> neighbors;
-
-        osg::Vec3f from(player.getRefData().getPosition().asVec3());
-        const MWWorld::ESMStore& esmStore = *MWBase::Environment::get().getESMStore();
-        float radius = esmStore.get<ESM::GameSetting>().find("fAlarmRadius")->mValue.getFloat();
-
-        mActors.getObjectsInRange(from, radius, neighbors);
-
-        // victim should be considered even beyond alarm radius
-        if (!victim.isEmpty() && (from - victim.getRefData().getPosition().asVec3()).length2() > radius * radius)
-            neighbors.push_back(victim);
+        std::vector<MWWorld::Ptr> neighbors = getCrimeNeighbors(player, victim);
 
         // get the player's followers / allies (works recursively) that will not report crimes
         std::set<MWWorld::Ptr> playerFollowers;
         getActorsSidingWith(player, playerFollowers);
 
+        std::erase_if(neighbors,
+            [&](const MWWorld::Ptr& neighbor) { return !canReportCrime(neighbor, victim, playerFollowers); });
+
+        const auto isAware = [&](const MWWorld::Ptr& neighbor) {
+            if (neighbor == victim)
+                return victimAware;
+            // Murder crime can be reported even if no one saw it (hearing is enough, I guess).
+            // TODO: Add mod support for stealth executions!
+            return type == OT_Murder;
+        };
+
+        // The others have to see it, check all of them at once
+        std::vector<MWWorld::Ptr> observers;
+        for (const MWWorld::Ptr& neighbor : neighbors)
+            if (!isAware(neighbor))
+                observers.push_back(neighbor);
+        const std::vector<bool> noticed = getCrimeObservers(player, observers);
+
         // Did anyone see it?
         bool crimeSeen = false;
+        std::size_t observer = 0;
         for (const MWWorld::Ptr& neighbor : neighbors)
         {
-            if (!canReportCrime(neighbor, victim, playerFollowers))
-                continue;
-
-            if ((neighbor == victim && victimAware)
-                // Murder crime can be reported even if no one saw it (hearing is enough, I guess).
-                // TODO: Add mod support for stealth executions!
-                || (type == OT_Murder && neighbor != victim)
-                || (MWBase::Environment::get().getWorld()->getLOS(player, neighbor)
-                    && awarenessCheck(player, neighbor)))
+            if (isAware(neighbor) || noticed[observer++])
             {
                 // NPC will complain about theft even if he will do nothing about it
                 if (type == OT_Theft || type == OT_Pickpocket)
@@ -1211,6 +1220,61 @@ namespace MWMechanics
         return crimeSeen;
     }
 
+    std::vector<MWWorld::Ptr> MechanicsManager::getCrimeNeighbors(
+        const MWWorld::Ptr& player, const MWWorld::Ptr& victim)
+    {
+        const osg::Vec3f from(player.getRefData().getPosition().asVec3());
+        const MWWorld::ESMStore& esmStore = *MWBase::Environment::get().getESMStore();
+        const float radius = esmStore.get<ESM::GameSetting>().find("fAlarmRadius")->mValue.getFloat();
+
+        if (mCrimeWitnesses.mPosition != from)
+        {
+            mCrimeWitnesses = {};
+            mCrimeWitnesses.mPosition = from;
+            mActors.getObjectsInRange(from, radius, mCrimeWitnesses.mNeighbors);
+        }
+
+        std::vector<MWWorld::Ptr> neighbors = mCrimeWitnesses.mNeighbors;
+
+        // victim should be considered even beyond alarm radius
+        if (!victim.isEmpty() && (from - victim.getRefData().getPosition().asVec3()).length2() > radius * radius)
+            neighbors.push_back(victim);
+
+        return neighbors;
+    }
+
+    std::vector<bool> MechanicsManager::getCrimeObservers(
+        const MWWorld::Ptr& player, std::span<const MWWorld::Ptr> observers)
+    {
+        std::vector<bool> result(observers.size(), false);
+        std::vector<MWWorld::ConstPtr> uncached;
+        std::vector<std::size_t> indices;
+        for (std::size_t i = 0; i < observers.size(); ++i)
+        {
+            const auto it = mCrimeWitnesses.mNoticed.find(observers[i]);
+            if (it != mCrimeWitnesses.mNoticed.end())
+            {
+                result[i] = it->second;
+                continue;
+            }
+            uncached.emplace_back(observers[i]);
+            indices.push_back(i);
+        }
+
+        if (uncached.empty())
+            return result;
+
+        const std::vector<bool> linesOfSight = MWBase::Environment::get().getWorld()->getLOS(player, uncached);
+        for (std::size_t i = 0; i < indices.size(); ++i)
+        {
+            const MWWorld::Ptr& observer = observers[indices[i]];
+            const bool noticed = linesOfSight[i] && awarenessCheck(player, observer);
+            mCrimeWitnesses.mNoticed.emplace(observer, noticed);
+            result[indices[i]] = noticed;
+        }
+        return result;
+    }
+
     bool MechanicsManager::canReportCrime(
         const MWWorld::Ptr& actor, const MWWorld::Ptr& victim, std::set<MWWorld::Ptr>& playerFollowers)
     {
@@ -1280,19 +1344,10 @@ namespace MWMechanics
         }
 
         // Make surrounding actors within alarm distance respond to the crime
-        std::vector<MWWorld::Ptr> neighbors;
+        const std::vector<MWWorld::Ptr> neighbors = getCrimeNeighbors(player, victim);
 
         const MWWorld::ESMStore& esmStore = *MWBase::Environment::get().getESMStore();
 
-        osg::Vec3f from(player.getRefData().getPosition().asVec3());
-        float radius = esmStore.get<ESM::GameSetting>().find("fAlarmRadius")->mValue.getFloat();
-
-        mActors.getObjectsInRange(from, radius, neighbors);
-
-        // victim should be considered even beyond alarm radius
-        if (!victim.isEmpty() && (from - victim.getRefData().getPosition().asVec3()).length2() > radius * radius)
-            neighbors.push_back(victim);
-
         int id = MWBase::Environment::get().getWorld()->getPlayer().getNewCrimeId();
 
         // What amount of provocation did this crime generate?
@@ -1860,6 +1915,7 @@ namespace MWMechanics
     {
         mActors.clear();
         mStolenItems.clear();
+        mCrimeWitnesses = {};
         mClassSelected = false;
         mRaceSelected = false;
     }
@@ -2071,4 +2127,9 @@ namespace MWMechanics
     {
         return mActors.isTurningToPlayer(ptr);
     }
+
+    bool MechanicsManager::isActorUpdateDue(const MWWorld::Ptr& ptr) const
+    {
+        return mActors.isUpdateDue(ptr);
+    }
 }
@@ -1,6 +1,13 @@
 #ifndef GAME_MWMECHANICS_MECHANICSMANAGERIMP_H
 #define GAME_MWMECHANICS_MECHANICSMANAGERIMP_H
 
+#include <map>
+#include <optional>
+#include <span>
+#include <vector>
+
+#include <osg/Vec3f>
+
 #include <components/settings/settings.hpp>
 
 #include "../mwbase/mechanicsmanager.hpp"
@@ -38,6 +45,16 @@ namespace MWMechanics
         typedef std::map<ESM::RefId, OwnerMap> StolenItemsMap;
         StolenItemsMap mStolenItems;
 
+        // Crimes committed in the same frame, like taking every item of a container, share the actors in the alarm
+        // radius and whether they noticed the player
+        struct CrimeWitnessCache
+        {
+            std::optional<osg::Vec3f> mPosition;
+            std::vector<MWWorld::Ptr> mNeighbors;
+            std::map<MWWorld::Ptr, bool> mNoticed;
+        };
+        CrimeWitnessCache mCrimeWitnesses;
+
     public:
         void buildPlayer();
         ///< build player according to stored class/race/birthsign information. Will
@@ -242,6 +259,7 @@ namespace MWMechanics
         float getAngleToPlayer(const MWWorld::Ptr& ptr) const override;
         GreetingState getGreetingState(const MWWorld::Ptr& ptr) const override;
         bool isTurningToPlayer(const MWWorld::Ptr& ptr) const override;
+        bool isActorUpdateDue(const MWWorld::Ptr& ptr) const override;
 
     private:
         bool canCommitCrimeAgainst(const MWWorld::Ptr& victim, const MWWorld::Ptr& attacker);
@@ -250,6 +268,12 @@ namespace MWMechanics
 
         bool reportCrime(const MWWorld::Ptr& ptr, const MWWorld::Ptr& victim, OffenseType type,
             const ESM::RefId& factionId, int arg = 0);
+
+        /// @return the actors within the alarm radius of the player and the victim
+        std::vector<MWWorld::Ptr> getCrimeNeighbors(const MWWorld::Ptr& player, const MWWorld::Ptr& victim);
+
+        /// @return for each of the observers whether they see and notice the player
+        std::vector<bool> getCrimeObservers(const MWWorld::Ptr& player, std::span<const MWWorld::Ptr> observers);
     };
 }
 
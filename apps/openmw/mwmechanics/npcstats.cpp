@@ -72,6 +72,8 @@ MWMechanics::SkillValue& MWMechanics::NpcStats::getSkill(ESM::RefId id)
     auto it = mSkills.find(id);
     if (it == mSkills.end())
         throw std::runtime_error("skill not found");
+    // The skill may be changed through the reference
+    ++mSkillsRevision;
     return it->second;
 }
 
@@ -81,6 +83,7 @@ void MWMechanics::NpcStats::setSkill(ESM::RefId id, const MWMechanics::SkillValu
     if (it == mSkills.end())
         throw std::runtime_error("skill not found");
     it->second = value;
+    ++mSkillsRevision;
 }
 
 const std::map<ESM::RefId, int>& MWMechanics::NpcStats::getFactionRanks() const
@@ -497,6 +500,7 @@ void MWMechanics::NpcStats::readState(const ESM::NpcStats& state)
         assert(!id.empty());
         mSkills[id].readState(state.mSkills[i]);
     }
+    ++mSkillsRevision;
 
     mIsWerewolf = state.mIsWerewolf;
 
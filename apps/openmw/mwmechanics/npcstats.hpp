@@ -25,6 +25,7 @@ namespace MWMechanics
         int mDisposition;
         int mCrimeDispositionModifier;
         std::map<ESM::RefId, SkillValue> mSkills; // SkillValue.mProgress used by the player only
+        std::size_t mSkillsRevision = 0;
 
         int mReputation;
         int mCrimeId;
@@ -67,9 +68,13 @@ namespace MWMechanics
         void setCrimeId(int id);
 
         const SkillValue& getSkill(ESM::RefId id) const;
+        /// @note Counts as a change of the skill, use the const overload to only read it
         SkillValue& getSkill(ESM::RefId id);
         void setSkill(ESM::RefId id, const SkillValue& value);
 
+        /// Changes every time a skill might have changed, to not compare all of them to find out
+        std::size_t getSkillsRevision() const { return mSkillsRevision; }
+
         int getFactionRank(const ESM::RefId& faction) const;
         const std::map<ESM::RefId, int>& getFactionRanks() const;
 
@@ -6,11 +6,13 @@
 #include <osg/io_utils>
 
 #include <components/debug/debuglog.hpp>
+#include <components/detournavigator/asyncpathfinder.hpp>
 #include <components/detournavigator/debug.hpp>
 #include <components/detournavigator/navigatorutils.hpp>
 #include <components/misc/coordinateconverter.hpp>
 #include <components/misc/math.hpp>
 #include <components/misc/pathgridutils.hpp>
+#include <components/settings/values.hpp>
 
 #include "../mwbase/environment.hpp"
 #include "../mwbase/world.hpp"
@@ -441,10 +443,7 @@ namespace MWMechanics
         return status;
     }
 
-    void PathFinder::buildLimitedPath(const MWWorld::ConstPtr& actor, const osg::Vec3f& startPoint,
-        const osg::Vec3f& endPoint, const PathgridGraph& pathgridGraph, const DetourNavigator::AgentBounds& agentBounds,
-        const DetourNavigator::Flags flags, const DetourNavigator::AreaCosts& areaCosts, float endTolerance,
-        PathType pathType)
+    osg::Vec3f PathFinder::getLimitedPathEnd(const osg::Vec3f& startPoint, const osg::Vec3f& endPoint)
     {
         const auto navigator = MWBase::Environment::get().getWorld()->getNavigator();
         const auto maxDistance
@@ -452,9 +451,114 @@ namespace MWMechanics
         const auto startToEnd = endPoint - startPoint;
         const auto distance = startToEnd.length();
         if (distance <= maxDistance)
-            return buildPath(
+            return endPoint;
+        return startPoint + startToEnd * maxDistance / distance;
+    }
+
+    void PathFinder::buildLimitedPath(const MWWorld::ConstPtr& actor, const osg::Vec3f& startPoint,
+        const osg::Vec3f& endPoint, const PathgridGraph& pathgridGraph, const DetourNavigator::AgentBounds& agentBounds,
+        const DetourNavigator::Flags flags, const DetourNavigator::AreaCosts& areaCosts, float endTolerance,
+        PathType pathType)
+    {
+        buildPath(actor, startPoint, getLimitedPathEnd(startPoint, endPoint), pathgridGraph, agentBounds, flags,
+            areaCosts, endTolerance, pathType);
+    }
+
+    void PathFinder::requestPath(const MWWorld::ConstPtr& actor, const osg::Vec3f& startPoint,
+        const osg::Vec3f& endPoint, const PathgridGraph& pathgridGraph, const DetourNavigator::AgentBounds& agentBounds,
+        const DetourNavigator::Flags flags, const DetourNavigator::AreaCosts& areaCosts, float endTolerance,
+        PathType pathType)
+    {
+        if (!Settings::navigator().mAsyncPathRequests || actor.getClass().isPureWaterCreature(actor)
+            || actor.getClass().isPureFlyingCreature(actor))
+        {
+            buildPath(
                 actor, startPoint, endPoint, pathgridGraph, agentBounds, flags, areaCosts, endTolerance, pathType);
-        const auto end = startPoint + startToEnd * maxDistance / distance;
-        buildPath(actor, startPoint, end, pathgridGraph, agentBounds, flags, areaCosts, endTolerance, pathType);
+            mRequest = nullptr;
+            mRequestedPathReady = true;
+            return;
+        }
+
+        DetourNavigator::Navigator& navigator = *MWBase::Environment::get().getWorld()->getNavigator();
+        mRequest = navigator.requestPath(
+            DetourNavigator::PathQuery{ agentBounds, startPoint, endPoint, flags, areaCosts, endTolerance });
+        mRequestedCell = actor.getCell();
+        mRequestedStart = startPoint;
+        mRequestedEnd = endPoint;
+        mRequestedPathType = pathType;
+        mRequestedPathReady = false;
+
+        // Keep steering along the current path, head straight to the destination if there is none
+        if (mPath.empty())
+            buildStraightPath(endPoint);
+    }
+
+    void PathFinder::requestLimitedPath(const MWWorld::ConstPtr& actor, const osg::Vec3f& startPoint,
+        const osg::Vec3f& endPoint, const PathgridGraph& pathgridGraph, const DetourNavigator::AgentBounds& agentBounds,
+        const DetourNavigator::Flags flags, const DetourNavigator::AreaCosts& areaCosts, float endTolerance,
+        PathType pathType)
+    {
+        requestPath(actor, startPoint, getLimitedPathEnd(startPoint, endPoint), pathgridGraph, agentBounds, flags,
+            areaCosts, endTolerance, pathType);
+    }
+
+    bool PathFinder::updateRequestedPath(const MWWorld::ConstPtr& actor, const PathgridGraph& pathgridGraph)
+    {
+        if (mRequestedPathReady)
+        {
+            mRequestedPathReady = false;
+            return true;
+        }
+
+        if (mRequest == nullptr || !mRequest->isDone())
+            return false;
+
+        const std::shared_ptr<const DetourNavigator::PathRequest> request = std::move(mRequest);
+        mRequest = nullptr;
+
+        // The pathgrid fallback needs the pathgrid of the cell the path was requested in
+        if (actor.getCell() != mRequestedCell)
+            return false;
+
+        const DetourNavigator::PathQuery& query = request->getQuery();
+        DetourNavigator::Status status = request->getStatus();
+
+        if (mRequestedPathType == PathType::Partial && status == DetourNavigator::Status::PartialPath)
+            status = DetourNavigator::Status::Success;
+
+        if (status != DetourNavigator::Status::Success)
+        {
+            Log(Debug::Debug) << "Build path by navigator error: \"" << DetourNavigator::getMessage(status)
+                              << "\" for \"" << actor.getClass().getName(actor) << "\" (" << actor.getBase()
+                              << ") from " << mRequestedStart << " to " << mRequestedEnd << " with flags ("
+                              << DetourNavigator::WriteFlags{ query.mIncludeFlags } << ")";
+        }
+
+        // Same fallbacks as buildPath
+        if (status != DetourNavigator::Status::Success && status != DetourNavigator::Status::NavMeshNotFound
+            && (query.mIncludeFlags & DetourNavigator::Flag_usePathgrid) == 0)
+        {
+            DetourNavigator::PathQuery withPathgrid = query;
+            withPathgrid.mStart = mRequestedStart;
+            withPathgrid.mEnd = mRequestedEnd;
+            withPathgrid.mIncludeFlags |= DetourNavigator::Flag_usePathgrid;
+            mRequest = MWBase::Environment::get().getWorld()->getNavigator()->requestPath(withPathgrid);
+            return false;
+        }
+
+        mPath.clear();
+        mCell = mRequestedCell;
+
+        if (status == DetourNavigator::Status::Success)
+            mPath.assign(request->getPath().begin(), request->getPath().end());
+
+        if (mPath.empty())
+            buildPathByPathgridImpl(mRequestedStart, mRequestedEnd, pathgridGraph, std::back_inserter(mPath));
+
+        if (status == DetourNavigator::Status::NavMeshNotFound && mPath.empty())
+            mPath.push_back(mRequestedEnd);
+
+        mConstructed = !mPath.empty();
+        return true;
     }
 }
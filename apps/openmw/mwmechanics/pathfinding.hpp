@@ -4,6 +4,7 @@
 #include <cassert>
 #include <deque>
 #include <iterator>
+#include <memory>
 #include <span>
 
 #include <osg/Vec3f>
@@ -22,6 +23,7 @@ namespace MWWorld
 namespace DetourNavigator
 {
     struct AgentBounds;
+    class PathRequest;
 }
 
 namespace MWMechanics
@@ -99,6 +101,8 @@ namespace MWMechanics
             mConstructed = false;
             mPath.clear();
             mCell = nullptr;
+            mRequest = nullptr;
+            mRequestedPathReady = false;
         }
 
         void buildStraightPath(const osg::Vec3f& endPoint);
@@ -118,6 +122,25 @@ namespace MWMechanics
             const DetourNavigator::Flags flags, const DetourNavigator::AreaCosts& areaCosts, float endTolerance,
             PathType pathType);
 
+        /// Starts to find a path over the navmesh in a background thread like buildPath does, the current path is
+        /// kept until the result is applied by updateRequestedPath. The path is built immediately when async path
+        /// requests are disabled or the actor can't walk on the navmesh.
+        void requestPath(const MWWorld::ConstPtr& actor, const osg::Vec3f& startPoint, const osg::Vec3f& endPoint,
+            const PathgridGraph& pathgridGraph, const DetourNavigator::AgentBounds& agentBounds,
+            const DetourNavigator::Flags flags, const DetourNavigator::AreaCosts& areaCosts, float endTolerance,
+            PathType pathType);
+
+        void requestLimitedPath(const MWWorld::ConstPtr& actor, const osg::Vec3f& startPoint,
+            const osg::Vec3f& endPoint, const PathgridGraph& pathgridGraph,
+            const DetourNavigator::AgentBounds& agentBounds, const DetourNavigator::Flags flags,
+            const DetourNavigator::AreaCosts& areaCosts, float endTolerance, PathType pathType);
+
+        bool isPathRequested() const { return mRequest != nullptr || mRequestedPathReady; }
+
+        /// Replace the path by the requested one once it is found
+        /// @return true if the path is replaced
+        bool updateRequestedPath(const MWWorld::ConstPtr& actor, const PathgridGraph& pathgridGraph);
+
         /// Remove front point if exist and within tolerance
         void update(const osg::Vec3f& position, float pointTolerance, float destinationTolerance,
             UpdateFlags updateFlags, const DetourNavigator::AgentBounds& agentBounds, DetourNavigator::Flags pathFlags);
@@ -147,6 +170,14 @@ namespace MWMechanics
         bool mConstructed = false;
         std::deque<osg::Vec3f> mPath;
         const MWWorld::CellStore* mCell = nullptr;
+        std::shared_ptr<const DetourNavigator::PathRequest> mRequest;
+        const MWWorld::CellStore* mRequestedCell = nullptr;
+        osg::Vec3f mRequestedStart;
+        osg::Vec3f mRequestedEnd;
+        PathType mRequestedPathType = PathType::Full;
+        bool mRequestedPathReady = false;
+
+        static osg::Vec3f getLimitedPathEnd(const osg::Vec3f& startPoint, const osg::Vec3f& endPoint);
 
         void buildPathByPathgridImpl(const osg::Vec3f& startPoint, const osg::Vec3f& endPoint,
             const PathgridGraph& pathgridGraph, std::back_insert_iterator<std::deque<osg::Vec3f>> out);
@@ -1,8 +1,8 @@
 #include "pathgrid.hpp"
 
 #include <algorithm>
-#include <list>
-#include <set>
+#include <functional>
+#include <queue>
 
 namespace
 {
@@ -214,7 +214,7 @@ namespace MWMechanics
      * Uses mGraph which has pre-computed costs for allowed edges.  It is assumed
      * that mGraph is already constructed.
      *
-     * Should be possible to make this MT safe.
+     * Not MT safe because of the path cache, the search itself only reads mGraph.
      *
      * Returns path which may be empty.  path contains pathgrid points in local
      * cell coordinates (indoors) or world coordinates (external).
@@ -223,77 +223,88 @@ namespace MWMechanics
      *   start, goal - pathgrid point indexes (for this cell)
      *
      * Variables:
-     *   openset - point indexes to be traversed, lowest cost at the front
+     *   openset - point indexes to be traversed with their future estimated costs,
+     *             lowest cost on top
      *   closedset - point indexes already traversed
      *   gScore - past accumulated costs vector indexed by point index
-     *   fScore - future estimated costs vector indexed by point index
      *
-     * TODO: An interesting exercise might be to cache the paths created for a
-     *       start/goal pair.  To cache the results the paths need to be in
-     *       pathgrid points form (currently they are converted to world
-     *       coordinates).  Essentially trading speed w/ memory.
+     * Found paths are kept in a small LRU cache in pathgrid points form,
+     * pathgrids never change during runtime.
      */
     std::deque<ESM::Pathgrid::Point> PathgridGraph::aStarSearch(const size_t start, const size_t goal) const
     {
-        std::deque<ESM::Pathgrid::Point> path;
         if (!isPointConnected(start, goal))
+            return {}; // there is no path, return an empty path
+
+        const std::pair<size_t, size_t> key(start, goal);
+        auto found = mPathCache.find(key);
+        if (found != mPathCache.end())
+        {
+            mPathCacheLru.splice(mPathCacheLru.end(), mPathCacheLru, found->second.mLruIt);
+            return found->second.mPath;
+        }
+
+        std::deque<ESM::Pathgrid::Point> path = search(start, goal);
+
+        if (mPathCache.size() >= sPathCacheSize)
         {
-            return path; // there is no path, return an empty path
+            mPathCache.erase(mPathCacheLru.front());
+            mPathCacheLru.pop_front();
         }
+        auto lruIt = mPathCacheLru.insert(mPathCacheLru.end(), key);
+        mPathCache.emplace(key, CachedPath{ path, lruIt });
+
+        return path;
+    }
+
+    std::deque<ESM::Pathgrid::Point> PathgridGraph::search(const size_t start, const size_t goal) const
+    {
+        std::deque<ESM::Pathgrid::Point> path;
 
         size_t graphSize = mGraph.size();
         std::vector<float> gScore(graphSize, -1);
-        std::vector<float> fScore(graphSize, -1);
         std::vector<size_t> graphParent(graphSize, NoIndex);
+        std::vector<bool> closedset(graphSize, false);
 
-        // gScore & fScore keep costs for each pathgrid point in mPoints
-        gScore[start] = 0;
-        fScore[start] = costAStar(mPathgrid->mPoints[start], mPathgrid->mPoints[goal]);
+        // openset - fScore and point index, lowest cost on top. Points are pushed again
+        // when their cost decreases, outdated entries are skipped when popped.
+        using OpenEntry = std::pair<float, size_t>;
+        std::priority_queue<OpenEntry, std::vector<OpenEntry>, std::greater<>> openset;
 
-        std::list<size_t> openset;
-        std::set<size_t> closedset;
-        openset.push_back(start);
+        // gScore keeps the past accumulated costs for each pathgrid point in mPoints
+        gScore[start] = 0;
+        openset.emplace(costAStar(mPathgrid->mPoints[start], mPathgrid->mPoints[goal]), start);
 
         size_t current = start;
 
         while (!openset.empty())
         {
-            current = openset.front(); // front has the lowest cost
-            openset.pop_front();
+            current = openset.top().second;
+            openset.pop();
 
             if (current == goal)
                 break;
 
-            closedset.insert(current); // remember we've been here
+            if (closedset[current])
+                continue;
+            closedset[current] = true; // remember we've been here
 
             // check all edges for the current point index
             for (const auto& edge : mGraph[current].edges)
             {
-                if (!closedset.contains(edge.index))
+                // if in closedset, i.e. traversed this edge already, try the next edge
+                const size_t dest = edge.index;
+                if (closedset[dest])
+                    continue;
+
+                const float tentativeG = gScore[current] + edge.cost;
+                if (gScore[dest] < 0 || tentativeG < gScore[dest])
                 {
-                    // not in closedset - i.e. have not traversed this edge destination
-                    size_t dest = edge.index;
-                    float tentativeG = gScore[current] + edge.cost;
-                    bool isInOpenSet = std::find(openset.begin(), openset.end(), dest) != openset.end();
-                    if (!isInOpenSet || tentativeG < gScore[dest])
-                    {
-                        graphParent[dest] = current;
-                        gScore[dest] = tentativeG;
-                        fScore[dest] = tentativeG + costAStar(mPathgrid->mPoints[dest], mPathgrid->mPoints[goal]);
-                        if (!isInOpenSet)
-                        {
-                            // add this edge to openset, lowest cost goes to the front
-                            // TODO: if this causes performance problems a hash table may help
-                            auto it = openset.begin();
-                            for (; it != openset.end(); ++it)
-                            {
-                                if (fScore[*it] > fScore[dest])
-                                    break;
-                            }
-                            openset.insert(it, dest);
-                        }
-                    }
-                } // if in closedset, i.e. traversed this edge already, try the next edge
+                    graphParent[dest] = current;
+                    gScore[dest] = tentativeG;
+                    openset.emplace(
+                        tentativeG + costAStar(mPathgrid->mPoints[dest], mPathgrid->mPoints[goal]), dest);
+                }
             }
         }
 
@@ -2,6 +2,9 @@
 #define GAME_MWMECHANICS_PATHGRID_H
 
 #include <deque>
+#include <list>
+#include <map>
+#include <utility>
 
 #include <components/esm3/loadpgrd.hpp>
 
@@ -17,6 +20,10 @@ namespace MWMechanics
     public:
         explicit PathgridGraph(const ESM::Pathgrid& pathGrid);
 
+        // the path cache refers to itself
+        PathgridGraph(const PathgridGraph&) = delete;
+        PathgridGraph& operator=(const PathgridGraph&) = delete;
+
         const ESM::Pathgrid* getPathgrid() const { return mPathgrid; }
 
         // returns true if end point is strongly connected (i.e. reachable
@@ -31,6 +38,9 @@ namespace MWMechanics
         // cells) coordinates
         //
         // NOTE: if start equals end an empty path is returned
+        //
+        // Recent searches are cached, actors wandering between or travelling to the same
+        // points get the same path without searching again. Not thread safe.
         std::deque<ESM::Pathgrid::Point> aStarSearch(const size_t start, const size_t end) const;
 
         static const PathgridGraph sEmpty;
@@ -62,6 +72,20 @@ namespace MWMechanics
         //   all other pathgrid points are the third set
         //
         std::vector<Node> mGraph;
+
+        static constexpr std::size_t sPathCacheSize = 32;
+
+        struct CachedPath
+        {
+            std::deque<ESM::Pathgrid::Point> mPath;
+            std::list<std::pair<size_t, size_t>>::iterator mLruIt;
+        };
+
+        std::deque<ESM::Pathgrid::Point> search(const size_t start, const size_t goal) const;
+
+        // least recently used first
+        mutable std::list<std::pair<size_t, size_t>> mPathCacheLru;
+        mutable std::map<std::pair<size_t, size_t>, CachedPath> mPathCache;
     };
 }
 
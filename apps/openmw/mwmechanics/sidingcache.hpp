@@ -0,0 +1,43 @@
+#ifndef GAME_MWMECHANICS_SIDINGCACHE_H
+#define GAME_MWMECHANICS_SIDINGCACHE_H
+
+#include <cstdint>
+#include <map>
+#include <set>
+
+#include "../mwworld/ptr.hpp"
+
+namespace MWMechanics
+{
+    class Actors;
+
+    class SidingCache
+    {
+        static inline std::uint64_t sRevision = 0;
+
+        const Actors& mActors;
+        const bool mExcludeInfighting;
+        std::uint64_t mRevision = sRevision;
+        std::map<MWWorld::Ptr, std::set<MWWorld::Ptr>> mCache;
+
+    public:
+        SidingCache(const Actors& actors, bool excludeInfighting)
+            : mActors(actors)
+            , mExcludeInfighting(excludeInfighting)
+        {
+        }
+
+        /// Recursive version of getActorsSidingWith that takes, returns a cached set of allies
+        const std::set<MWWorld::Ptr>& getActorsSidingWith(const MWWorld::Ptr& actor);
+
+        /// Drop cached sets when anything they depend on was changed since the last call. Invalidates references
+        /// returned by getActorsSidingWith.
+        void refresh();
+
+        /// Must be called on any change affecting who sides with whom: AI packages, deaths, resurrections and
+        /// addition or removal of active actors.
+        static void invalidate() { ++sRevision; }
+    };
+}
+
+#endif
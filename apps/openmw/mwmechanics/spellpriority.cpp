@@ -133,11 +133,12 @@ namespace MWMechanics
 
     float rateSpell(const ESM::Spell* spell, const MWWorld::Ptr& actor, const MWWorld::Ptr& enemy, bool checkMagicka)
     {
-        float successChance = MWMechanics::getSpellSuccessChance(spell, actor, nullptr, true, checkMagicka);
-        if (successChance == 0.f)
+        // Abilities, powers and diseases are never rated, don't calculate their success chance
+        if (spell->mData.mType != ESM::Spell::ST_Spell)
             return 0.f;
 
-        if (spell->mData.mType != ESM::Spell::ST_Spell)
+        float successChance = MWMechanics::getSpellSuccessChance(spell, actor, nullptr, true, checkMagicka);
+        if (successChance == 0.f)
             return 0.f;
 
         // Don't make use of racial bonus spells, like MW. Can be made optional later
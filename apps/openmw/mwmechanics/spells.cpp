@@ -14,6 +14,7 @@
 
 #include "actorutil.hpp"
 #include "creaturestats.hpp"
+#include "spellutil.hpp"
 #include "stat.hpp"
 
 namespace MWMechanics
@@ -60,6 +61,19 @@ namespace MWMechanics
         return std::find(mSpells.begin(), mSpells.end(), spell) != mSpells.end();
     }
 
+    const std::vector<CastableSpell>& Spells::getCastableSpells() const
+    {
+        if (mCastableSpellsDirty)
+        {
+            mCastableSpells.clear();
+            for (const ESM::Spell* spell : mSpells)
+                if (spell->mData.mType == ESM::Spell::ST_Spell)
+                    mCastableSpells.push_back(CastableSpell{ spell, calcSpellCost(*spell) });
+            mCastableSpellsDirty = false;
+        }
+        return mCastableSpells;
+    }
+
     void Spells::add(const ESM::Spell* spell, bool modifyBase)
     {
         if (modifyBase)
@@ -76,7 +90,10 @@ namespace MWMechanics
     void Spells::addSpell(const ESM::Spell* spell)
     {
         if (!hasSpell(spell))
+        {
             mSpells.emplace_back(spell);
+            mCastableSpellsDirty = true;
+        }
     }
 
     void Spells::remove(const ESM::RefId& spellId, bool modifyBase)
@@ -97,12 +114,16 @@ namespace MWMechanics
     {
         const auto it = std::find(mSpells.begin(), mSpells.end(), spell);
         if (it != mSpells.end())
+        {
             mSpells.erase(it);
+            mCastableSpellsDirty = true;
+        }
     }
 
     void Spells::removeAllSpells()
     {
         mSpells.clear();
+        mCastableSpellsDirty = true;
     }
 
     void Spells::clear(bool modifyBase)
@@ -154,7 +175,10 @@ namespace MWMechanics
                 ++iter;
         }
         if (!purged.empty())
+        {
             mSpellList->removeAll(purged);
+            mCastableSpellsDirty = true;
+        }
     }
 
     void Spells::purgeCommonDisease()
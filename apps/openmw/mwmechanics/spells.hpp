@@ -21,6 +21,12 @@ namespace MWMechanics
 
     class MagicEffects;
 
+    struct CastableSpell
+    {
+        const ESM::Spell* mSpell;
+        int mCost;
+    };
+
     /// \brief Spell list
     ///
     /// This class manages known spells as well as abilities, powers and permanent negative effects like
@@ -35,6 +41,9 @@ namespace MWMechanics
 
         std::vector<std::pair<const ESM::Spell*, MWWorld::TimeStamp>> mUsedPowers;
 
+        mutable std::vector<CastableSpell> mCastableSpells;
+        mutable bool mCastableSpellsDirty = true;
+
         bool hasSpellType(const ESM::Spell::SpellType type) const;
 
         using SpellFilter = bool (*)(const ESM::Spell*);
@@ -74,6 +83,10 @@ namespace MWMechanics
         bool hasSpell(const ESM::RefId& spell) const;
         bool hasSpell(const ESM::Spell* spell) const;
 
+        /// Spells of type ST_Spell with their magicka cost in the order of the spell list. Rebuilt when the spell list
+        /// changes, so the AI doesn't have to skip over abilities and calculate the costs whenever it picks an action.
+        const std::vector<CastableSpell>& getCastableSpells() const;
+
         void add(const ESM::RefId& spell, bool modifyBase = true);
         ///< Adding a spell that is already listed in *this is a no-op.
 
@@ -0,0 +1,36 @@
+#include "updatescheduler.hpp"
+
+#include <algorithm>
+
+namespace MWMechanics
+{
+    bool UpdateScheduler::schedule(Entry& entry, unsigned bucket, float duration)
+    {
+        if (entry.mFrame == mFrame)
+            return entry.mDue;
+
+        entry.mFrame = mFrame;
+        bucket = std::min(bucket, sBucketCount - 1);
+
+        if (entry.mBucket != bucket)
+        {
+            entry.mBucket = bucket;
+            entry.mPhase = mNextPhase[bucket]++;
+        }
+
+        entry.mSkippedTime += duration;
+
+        const std::size_t mask = (std::size_t(1) << bucket) - 1;
+        entry.mDue = ((mFrame + entry.mPhase) & mask) == 0;
+
+        if (entry.mDue)
+        {
+            entry.mDuration = entry.mSkippedTime;
+            entry.mSkippedTime = 0;
+        }
+        else
+            entry.mDuration = 0;
+
+        return entry.mDue;
+    }
+}
@@ -0,0 +1,47 @@
+#ifndef OPENMW_MECHANICS_UPDATESCHEDULER_H
+#define OPENMW_MECHANICS_UPDATESCHEDULER_H
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+
+namespace MWMechanics
+{
+    /// @brief Spreads updates of actors with reduced update rate evenly over frames.
+    /// @par Actor in bucket N is updated once per 2^N frames. Actors entering a bucket get phases in round robin order,
+    /// so each frame updates about the same number of actors from every bucket. Time of skipped frames is accumulated
+    /// and passed to the next update.
+    class UpdateScheduler
+    {
+    public:
+        static constexpr unsigned sBucketCount = 5;
+
+        struct Entry
+        {
+            unsigned mBucket = 0;
+            std::uint32_t mPhase = 0;
+            float mSkippedTime = 0;
+            // Valid after schedule for the current frame
+            std::size_t mFrame = std::numeric_limits<std::size_t>::max();
+            bool mDue = true;
+            float mDuration = 0;
+        };
+
+        void nextFrame() { ++mFrame; }
+
+        /// Assigns entry to the bucket and decides whether it is updated this frame. When it is, sets mDuration to
+        /// the time passed since the previous update. Does nothing when the entry is already scheduled for the current
+        /// frame.
+        /// @return true if entry is updated this frame
+        bool schedule(Entry& entry, unsigned bucket, float duration);
+
+        std::size_t getFrame() const { return mFrame; }
+
+    private:
+        std::size_t mFrame = 0;
+        std::array<std::uint32_t, sBucketCount> mNextPhase{};
+    };
+}
+
+#endif
@@ -1,6 +1,7 @@
 #ifndef OPENMW_MWPHYSICS_ACTOR_H
 #define OPENMW_MWPHYSICS_ACTOR_H
 
+#include <cstddef>
 #include <memory>
 #include <mutex>
 
@@ -11,6 +12,7 @@
 #include <osg/Quat>
 #include <osg/Vec3f>
 
+class btCollisionObject;
 class btCollisionShape;
 class btCollisionWorld;
 class btConvexShape;
@@ -24,6 +26,17 @@ namespace MWPhysics
 {
     class PhysicsTaskScheduler;
 
+    /// @brief Where an actor came to rest, lets the movement solver skip the collision checks while nothing changes
+    struct RestingState
+    {
+        /// nullptr when the actor isn't resting
+        const btCollisionObject* mGround = nullptr;
+        osg::Vec3f mPosition;
+        bool mOnWater = false;
+        /// PhysicsTaskScheduler::getWorldVersion when the actor came to rest
+        std::size_t mWorldVersion = 0;
+    };
+
     class Actor final : public PtrHolder
     {
     public:
@@ -140,6 +153,9 @@ namespace MWPhysics
         const osg::Vec3f& getLastStuckPosition() const { return mLastStuckPosition; }
         void setLastStuckPosition(osg::Vec3f position) { mLastStuckPosition = position; }
 
+        const RestingState& getRestingState() const { return mRestingState; }
+        void setRestingState(const RestingState& state) { mRestingState = state; }
+
         bool canMoveToWaterSurface(float waterlevel, const btCollisionWorld* world) const;
 
         bool isActive() const { return mActive; }
@@ -182,6 +198,8 @@ namespace MWPhysics
         unsigned int mStuckFrames;
         osg::Vec3f mLastStuckPosition;
 
+        RestingState mRestingState;
+
         osg::Vec3f mForce;
         bool mOnGround;
         bool mOnSlope;
@@ -55,12 +55,19 @@ namespace MWPhysics
     HeightField::HeightField(const float* heights, int x, int y, int size, int verts, float minH, float maxH,
         const osg::Object* holdObject, PhysicsTaskScheduler* scheduler)
         : mHoldObject(holdObject)
-#if BT_BULLET_VERSION < 310
-        , mHeights(makeHeights(heights, verts))
-#endif
         , mTaskScheduler(scheduler)
     {
+        // A flat heightfield, like the one of a cell without land, collides the same using only its corners, and
+        // tests against it don't have to go through every triangle
+        if (minH == maxH)
+        {
+            mFlatHeights.fill(minH);
+            heights = mFlatHeights.data();
+            verts = 2;
+        }
+
 #if BT_BULLET_VERSION < 310
+        mHeights = makeHeights(heights, verts);
         mShape = std::make_unique<btHeightfieldTerrainShape>(
             verts, verts, getHeights(heights, mHeights), 1, minH, maxH, 2, PHY_FLOAT, false);
 #else
@@ -5,6 +5,7 @@
 
 #include <LinearMath/btScalar.h>
 
+#include <array>
 #include <memory>
 #include <vector>
 
@@ -35,6 +36,7 @@ namespace MWPhysics
         std::unique_ptr<btHeightfieldTerrainShape> mShape;
         std::unique_ptr<btCollisionObject> mCollisionObject;
         osg::ref_ptr<const osg::Object> mHoldObject;
+        std::array<float, 4> mFlatHeights;
 #if BT_BULLET_VERSION < 310
         std::vector<btScalar> mHeights;
 #endif
@@ -32,6 +32,14 @@ namespace MWPhysics
         return obj->getBroadphaseHandle()->m_collisionFilterGroup == CollisionType_Actor;
     }
 
+    static bool isResting(const ActorFrameData& actor, const WorldFrameData& worldData)
+    {
+        return actor.mResting.mGround != nullptr && actor.mResting.mWorldVersion == worldData.mWorldVersion
+            && actor.mResting.mPosition == actor.mPosition && actor.mMovement.length2() == 0
+            && actor.mInertia.length2() == 0 && actor.mIsOnGround && !actor.mIsOnSlope && !actor.mFlying
+            && actor.mPosition.z() >= actor.mSwimLevel;
+    }
+
     namespace
     {
         class ContactCollectionCallback : public btCollisionWorld::ContactResultCallback
@@ -125,7 +133,7 @@ namespace MWPhysics
         return tracer.mEndPos - offset + osg::Vec3f(0.f, 0.f, sGroundOffset);
     }
 
-    void MovementSolver::move(
+    bool MovementSolver::move(
         ActorFrameData& actor, float time, const btCollisionWorld* collisionWorld, const WorldFrameData& worldData)
     {
         // Reset per-frame data
@@ -136,7 +144,16 @@ namespace MWPhysics
             actor.mPosition += (osg::Quat(actor.mRotation.x(), osg::Vec3f(-1, 0, 0))
                                    * osg::Quat(actor.mRotation.y(), osg::Vec3f(0, 0, -1)))
                 * actor.mMovement * time;
-            return;
+            actor.mResting = {};
+            return false;
+        }
+
+        // An actor standing still on flat ground stays where it is until something in the world changes
+        if (isResting(actor, worldData))
+        {
+            actor.mStandingOn = actor.mResting.mGround;
+            actor.mWalkingOnWater = actor.mResting.mOnWater;
+            return false;
         }
 
         // Adjust for collision mesh offset relative to actor's "location"
@@ -444,6 +461,17 @@ namespace MWPhysics
         actor.mPosition = newPosition;
         // remove what was added earlier in compensating for doTrace not taking interior transformation into account
         actor.mPosition.z() -= actor.mHalfExtentsZ; // vanilla-accurate
+
+        // Actors don't push each other, but a supporting one may walk away
+        if (isOnGround && !isOnSlope && !actor.mFlying && actor.mMovement.length2() == 0
+            && actor.mInertia.length2() == 0 && actor.mStuckFrames == 0 && actor.mStandingOn != nullptr
+            && !isActor(actor.mStandingOn))
+            actor.mResting = RestingState{ actor.mStandingOn, actor.mPosition, actor.mWalkingOnWater,
+                worldData.mWorldVersion };
+        else
+            actor.mResting = {};
+
+        return true;
     }
 
     void MovementSolver::move(ProjectileFrameData& projectile, float time, const btCollisionWorld* collisionWorld)
@@ -43,7 +43,8 @@ namespace MWPhysics
     public:
         static osg::Vec3f traceDown(const MWWorld::Ptr& ptr, const osg::Vec3f& position, Actor* actor,
             btCollisionWorld* collisionWorld, float maxHeight);
-        static void move(
+        /// @return false if no collision checks were needed, for example because the actor is resting
+        static bool move(
             ActorFrameData& actor, float time, const btCollisionWorld* collisionWorld, const WorldFrameData& worldData);
         static void move(ProjectileFrameData& projectile, float time, const btCollisionWorld* collisionWorld);
         static void unstuck(ActorFrameData& actor, const btCollisionWorld* collisionWorld);
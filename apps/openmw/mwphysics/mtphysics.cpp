@@ -15,8 +15,10 @@
 #include <osg/Stats>
 
 #include "components/debug/debuglog.hpp"
+#include "components/debug/tracing.hpp"
 #include "components/misc/convert.hpp"
 #include <components/misc/barrier.hpp>
+#include <components/misc/thread.hpp>
 #include <components/settings/values.hpp>
 
 #include "../mwmechanics/actorutil.hpp"
@@ -121,11 +123,39 @@ namespace MWPhysics
         private:
             std::variant<std::monostate, std::unique_lock<Mutex>, std::shared_lock<Mutex>> mImpl;
         };
+
+        btCollisionWorld::ClosestRayResultCallback makeLineOfSightCallback(const Actor* actor1, const Actor* actor2)
+        {
+            // eye level
+            const btVector3 pos1 = Misc::Convert::toBullet(
+                actor1->getCollisionObjectPosition() + osg::Vec3f(0, 0, actor1->getHalfExtents().z() * 0.9f));
+            const btVector3 pos2 = Misc::Convert::toBullet(
+                actor2->getCollisionObjectPosition() + osg::Vec3f(0, 0, actor2->getHalfExtents().z() * 0.9f));
+
+            btCollisionWorld::ClosestRayResultCallback callback(pos1, pos2);
+            callback.m_collisionFilterGroup = CollisionType_AnyPhysical;
+            callback.m_collisionFilterMask = CollisionType_World | CollisionType_HeightMap | CollisionType_Door;
+            return callback;
+        }
     }
 }
 
 namespace
 {
+    MWPhysics::RayCastingResult makeRayCastingResult(const btVector3& hitPoint, const btVector3& hitNormal,
+        const btCollisionObject* hitObject)
+    {
+        MWPhysics::RayCastingResult result;
+        result.mHit = hitObject != nullptr;
+        if (!result.mHit)
+            return result;
+        result.mHitPos = Misc::Convert::toOsg(hitPoint);
+        result.mHitNormal = Misc::Convert::toOsg(hitNormal);
+        if (auto* ptrHolder = static_cast<MWPhysics::PtrHolder*>(hitObject->getUserPointer()))
+            result.mHitObject = ptrHolder->getPtr();
+        return result;
+    }
+
     bool isUnderWater(const MWPhysics::ActorFrameData& actorData)
     {
         return actorData.mPosition.z() < actorData.mSwimLevel;
@@ -234,9 +264,14 @@ namespace
             const float mPhysicsDt;
             const btCollisionWorld* mCollisionWorld;
             const MWPhysics::WorldFrameData& mWorldFrameData;
+            std::atomic<unsigned>& mFullSolves;
+            std::atomic<unsigned>& mSkippedSolves;
             void operator()(const LockedActorSimulation& sim) const
             {
-                MWPhysics::MovementSolver::move(sim.second, mPhysicsDt, mCollisionWorld, mWorldFrameData);
+                if (MWPhysics::MovementSolver::move(sim.second, mPhysicsDt, mCollisionWorld, mWorldFrameData))
+                    mFullSolves.fetch_add(1, std::memory_order_relaxed);
+                else
+                    mSkippedSolves.fetch_add(1, std::memory_order_relaxed);
             }
             void operator()(const LockedProjectileSimulation& sim) const
             {
@@ -290,6 +325,7 @@ namespace
                     actor->setOnSlope(frameData.mIsOnSlope);
                     actor->setWalkingOnWater(frameData.mWalkingOnWater);
                     actor->setInertialForce(frameData.mInertia);
+                    actor->setRestingState(frameData.mResting);
                 }
             }
             void operator()(MWPhysics::ProjectileSimulation& sim) const
@@ -399,6 +435,14 @@ namespace MWPhysics
         std::mutex mHasJobMutex;
     };
 
+    struct PhysicsTaskScheduler::QueryBatch
+    {
+        std::vector<RayRequest> mRays;
+        std::vector<SweepRequest> mSweeps;
+        std::vector<RayCastingResult> mResults;
+        std::promise<std::vector<RayCastingResult>> mPromise;
+    };
+
     PhysicsTaskScheduler::PhysicsTaskScheduler(
         float physicsDt, btCollisionWorld* collisionWorld, MWRender::DebugDrawer* debugDrawer)
         : mDefaultPhysicsDt(physicsDt)
@@ -411,9 +455,12 @@ namespace MWPhysics
         , mNumJobs(0)
         , mRemainingSteps(0)
         , mLOSCacheExpiry(Settings::physics().mLineofsightKeepInactiveCache)
+        , mLOSMaxRefreshInterval(Settings::physics().mLineofsightMaxRefreshInterval)
+        , mLOSCacheSize(static_cast<std::size_t>(Settings::physics().mLineofsightCacheSize.get()))
         , mAdvanceSimulation(false)
         , mNextJob(0)
         , mNextLOS(0)
+        , mNextQuery(0)
         , mFrameNumber(0)
         , mTimer(osg::Timer::instance())
         , mPrevStepCount(1)
@@ -429,6 +476,10 @@ namespace MWPhysics
         if (mNumThreads >= 1)
         {
             Log(Debug::Info) << "Using " << mNumThreads << " async physics threads";
+            const std::string& cores = Settings::physics().mAsyncThreadCores;
+            mThreadCores = Misc::parseCoreList(cores);
+            if (mThreadCores.empty() && !cores.empty())
+                Log(Debug::Warning) << "Invalid physics async thread cores: " << cores;
             for (unsigned i = 0; i < mNumThreads; ++i)
                 mThreads.emplace_back([&] { worker(); });
         }
@@ -535,6 +586,13 @@ namespace MWPhysics
             updateStats(frameStart, frameNumber, stats);
         }
 
+        {
+            // The broadphase moves objects that didn't move for a few frames into a separate tree that is not
+            // rebalanced when actors move, but only when it computes the overlapping pairs. Nothing else does that.
+            MaybeExclusiveLock collisionWorldLock(mCollisionWorldMutex, mLockingPolicy);
+            mCollisionWorld->getBroadphase()->calculateOverlappingPairs(mCollisionWorld->getDispatcher());
+        }
+
         auto [numSteps, newDelta] = calculateStepConfig(timeAccum);
         timeAccum -= numSteps * newDelta;
 
@@ -552,6 +610,7 @@ namespace MWPhysics
         mAdvanceSimulation = (mRemainingSteps != 0);
         mNumJobs = static_cast<int>(mSimulations->size());
         mNextLOS.store(0, std::memory_order_relaxed);
+        startQueries();
         mNextJob.store(0, std::memory_order_release);
 
         if (mAdvanceSimulation)
@@ -590,6 +649,11 @@ namespace MWPhysics
             actor->updatePosition();
             actor->updateCollisionObjectPosition();
         }
+
+        // Queries don't depend on the simulation, don't leave them waiting while it is skipped
+        startQueries();
+        runQueries();
+        finishQueries();
     }
 
     void PhysicsTaskScheduler::rayTest(const btVector3& rayFromWorld, const btVector3& rayToWorld,
@@ -599,6 +663,13 @@ namespace MWPhysics
         mCollisionWorld->rayTest(rayFromWorld, rayToWorld, resultCallback);
     }
 
+    void PhysicsTaskScheduler::rayTest(std::span<btCollisionWorld::ClosestRayResultCallback> callbacks) const
+    {
+        MaybeLock lock(mCollisionWorldMutex, mLockingPolicy);
+        for (btCollisionWorld::ClosestRayResultCallback& callback : callbacks)
+            mCollisionWorld->rayTest(callback.m_rayFromWorld, callback.m_rayToWorld, callback);
+    }
+
     void PhysicsTaskScheduler::convexSweepTest(const btConvexShape* castShape, const btTransform& from,
         const btTransform& to, btCollisionWorld::ConvexResultCallback& resultCallback) const
     {
@@ -613,6 +684,24 @@ namespace MWPhysics
         ContactTestWrapper::contactTest(mCollisionWorld, colObj, resultCallback);
     }
 
+    std::future<std::vector<RayCastingResult>> PhysicsTaskScheduler::submitRayBatch(
+        std::span<const RayRequest> requests)
+    {
+        auto batch = std::make_unique<QueryBatch>();
+        batch->mRays.assign(requests.begin(), requests.end());
+        batch->mResults.resize(requests.size());
+        return queueQueries(std::move(batch));
+    }
+
+    std::future<std::vector<RayCastingResult>> PhysicsTaskScheduler::submitSweepBatch(
+        std::span<const SweepRequest> requests)
+    {
+        auto batch = std::make_unique<QueryBatch>();
+        batch->mSweeps.assign(requests.begin(), requests.end());
+        batch->mResults.resize(requests.size());
+        return queueQueries(std::move(batch));
+    }
+
     std::optional<btVector3> PhysicsTaskScheduler::getHitPoint(const btTransform& from, btCollisionObject* target)
     {
         MaybeLock lock(mCollisionWorldMutex, mLockingPolicy);
@@ -647,6 +736,7 @@ namespace MWPhysics
     void PhysicsTaskScheduler::setCollisionFilterMask(btCollisionObject* collisionObject, int collisionFilterMask)
     {
         MaybeExclusiveLock lock(mCollisionWorldMutex, mLockingPolicy);
+        mWorldVersion.fetch_add(1, std::memory_order_relaxed);
         collisionObject->getBroadphaseHandle()->m_collisionFilterMask = collisionFilterMask;
     }
 
@@ -654,6 +744,7 @@ namespace MWPhysics
         btCollisionObject* collisionObject, int collisionFilterGroup, int collisionFilterMask)
     {
         MaybeExclusiveLock lock(mCollisionWorldMutex, mLockingPolicy);
+        mWorldVersion.fetch_add(1, std::memory_order_relaxed);
         mCollisionObjects.insert(collisionObject);
         mCollisionWorld->addCollisionObject(collisionObject, collisionFilterGroup, collisionFilterMask);
     }
@@ -661,6 +752,7 @@ namespace MWPhysics
     void PhysicsTaskScheduler::removeCollisionObject(btCollisionObject* collisionObject)
     {
         MaybeExclusiveLock lock(mCollisionWorldMutex, mLockingPolicy);
+        mWorldVersion.fetch_add(1, std::memory_order_relaxed);
         mCollisionObjects.erase(collisionObject);
         mCollisionWorld->removeCollisionObject(collisionObject);
     }
@@ -683,18 +775,114 @@ namespace MWPhysics
     {
         MaybeExclusiveLock lock(mLOSCacheMutex, mLockingPolicy);
 
+        ++mLOSRequests;
         auto req = LOSRequest(actor1, actor2);
         auto result = std::find(mLOSCache.begin(), mLOSCache.end(), req);
         if (result == mLOSCache.end())
         {
             req.mResult = hasLineOfSight(actor1.get(), actor2.get());
-            mLOSCache.push_back(req);
+            cacheLineOfSight(req);
             return req.mResult;
         }
         result->mAge = 0;
+        if (result->mInvalidated)
+        {
+            result->mResult = hasLineOfSight(actor1.get(), actor2.get());
+            result->mInvalidated = false;
+            return result->mResult;
+        }
+        ++mLOSHits;
         return result->mResult;
     }
 
+    std::vector<bool> PhysicsTaskScheduler::getLinesOfSight(
+        const std::shared_ptr<Actor>& actor, std::span<const std::shared_ptr<Actor>> targets)
+    {
+        MaybeExclusiveLock lock(mLOSCacheMutex, mLockingPolicy);
+
+        std::vector<bool> result(targets.size(), false);
+        std::vector<std::size_t> missed;
+        std::vector<btCollisionWorld::ClosestRayResultCallback> callbacks;
+        for (std::size_t i = 0; i < targets.size(); ++i)
+        {
+            ++mLOSRequests;
+            const auto cached = std::find(mLOSCache.begin(), mLOSCache.end(), LOSRequest(actor, targets[i]));
+            if (cached != mLOSCache.end() && !cached->mInvalidated)
+            {
+                cached->mAge = 0;
+                ++mLOSHits;
+                result[i] = cached->mResult;
+                continue;
+            }
+            missed.push_back(i);
+            callbacks.push_back(makeLineOfSightCallback(actor.get(), targets[i].get()));
+        }
+
+        if (callbacks.empty())
+            return result;
+
+        {
+            MaybeLock lockColWorld(mCollisionWorldMutex, mLockingPolicy);
+            for (btCollisionWorld::ClosestRayResultCallback& callback : callbacks)
+                mCollisionWorld->rayTest(callback.m_rayFromWorld, callback.m_rayToWorld, callback);
+        }
+
+        for (std::size_t i = 0; i < missed.size(); ++i)
+        {
+            const std::size_t index = missed[i];
+            result[index] = !callbacks[i].hasHit();
+            auto req = LOSRequest(actor, targets[index]);
+            req.mResult = result[index];
+            const auto cached = std::find(mLOSCache.begin(), mLOSCache.end(), req);
+            if (cached == mLOSCache.end())
+                cacheLineOfSight(req);
+            else
+            {
+                cached->mAge = 0;
+                cached->mResult = req.mResult;
+                cached->mInvalidated = false;
+            }
+        }
+        return result;
+    }
+
+    void PhysicsTaskScheduler::cacheLineOfSight(const LOSRequest& request)
+    {
+        if (mLOSCache.size() < mLOSCacheSize)
+            mLOSCache.push_back(request);
+        else
+            *std::max_element(mLOSCache.begin(), mLOSCache.end(),
+                [](const LOSRequest& lhs, const LOSRequest& rhs) { return lhs.mAge < rhs.mAge; })
+                = request;
+    }
+
+    void PhysicsTaskScheduler::invalidateLineOfSight(const Actor* actor)
+    {
+        MaybeExclusiveLock lock(mLOSCacheMutex, mLockingPolicy);
+        for (LOSRequest& req : mLOSCache)
+        {
+            if (req.mRawActors[0] != actor && req.mRawActors[1] != actor)
+                continue;
+            req.mInvalidated = true;
+            req.mRefreshInterval = 1;
+            req.mFramesUntilRefresh = 1;
+        }
+    }
+
+    void PhysicsTaskScheduler::reportStats(unsigned int frameNumber, osg::Stats& stats) const
+    {
+        stats.setAttribute(frameNumber, "Physics Full Solves",
+            static_cast<double>(mLastFullSolves.load(std::memory_order_relaxed)));
+        stats.setAttribute(frameNumber, "Physics Skipped Solves",
+            static_cast<double>(mLastSkippedSolves.load(std::memory_order_relaxed)));
+        MaybeSharedLock lock(mLOSCacheMutex, mLockingPolicy);
+        stats.setAttribute(frameNumber, "Physics LOS Cache", static_cast<double>(mLOSCache.size()));
+        stats.setAttribute(frameNumber, "Physics LOS Requests", static_cast<double>(mLOSRequests));
+        if (mLOSRequests > 0)
+            stats.setAttribute(frameNumber, "Physics LOS HitRate",
+                100.0 * static_cast<double>(mLOSHits) / static_cast<double>(mLOSRequests));
+    }
+
     void PhysicsTaskScheduler::refreshLOSCache()
     {
         MaybeSharedLock lock(mLOSCacheMutex, mLockingPolicy);
@@ -708,11 +896,87 @@ namespace MWPhysics
 
             if (req.mAge++ > mLOSCacheExpiry || !actorPtr1 || !actorPtr2)
                 req.mStale = true;
+            else if (--req.mFramesUntilRefresh <= 0)
+            {
+                const bool result = hasLineOfSight(actorPtr1.get(), actorPtr2.get());
+                // Back off for pairs that keep the same result
+                req.mRefreshInterval
+                    = result == req.mResult ? std::min(req.mRefreshInterval * 2, mLOSMaxRefreshInterval) : 1;
+                req.mFramesUntilRefresh = req.mRefreshInterval;
+                req.mResult = result;
+                req.mInvalidated = false;
+            }
+        }
+    }
+
+    std::future<std::vector<RayCastingResult>> PhysicsTaskScheduler::queueQueries(std::unique_ptr<QueryBatch> batch)
+    {
+        std::future<std::vector<RayCastingResult>> result = batch->mPromise.get_future();
+        if (batch->mResults.empty())
+        {
+            batch->mPromise.set_value({});
+            return result;
+        }
+        const std::lock_guard lock(mQueuedQueriesMutex);
+        mQueuedQueries.push_back(std::move(batch));
+        return result;
+    }
+
+    void PhysicsTaskScheduler::startQueries()
+    {
+        {
+            const std::lock_guard lock(mQueuedQueriesMutex);
+            std::swap(mQueries, mQueuedQueries);
+        }
+        mQueryJobs.clear();
+        for (const std::unique_ptr<QueryBatch>& batch : mQueries)
+            for (std::size_t i = 0; i < batch->mResults.size(); ++i)
+                mQueryJobs.emplace_back(batch.get(), i);
+        mNextQuery.store(0, std::memory_order_relaxed);
+    }
+
+    void PhysicsTaskScheduler::runQueries()
+    {
+        if (mQueryJobs.empty())
+            return;
+        MaybeLock lock(mCollisionWorldMutex, mLockingPolicy);
+        int job = 0;
+        const int numQueries = static_cast<int>(mQueryJobs.size());
+        while ((job = mNextQuery.fetch_add(1, std::memory_order_relaxed)) < numQueries)
+        {
+            const auto [batch, index] = mQueryJobs[job];
+            if (!batch->mRays.empty())
+            {
+                const RayRequest& request = batch->mRays[index];
+                btCollisionWorld::ClosestRayResultCallback callback(request.mFrom, request.mTo);
+                callback.m_collisionFilterGroup = request.mCollisionFilterGroup;
+                callback.m_collisionFilterMask = request.mCollisionFilterMask;
+                mCollisionWorld->rayTest(request.mFrom, request.mTo, callback);
+                batch->mResults[index] = makeRayCastingResult(callback.m_hitPointWorld, callback.m_hitNormalWorld,
+                    callback.hasHit() ? callback.m_collisionObject : nullptr);
+            }
             else
-                req.mResult = hasLineOfSight(actorPtr1.get(), actorPtr2.get());
+            {
+                const SweepRequest& request = batch->mSweeps[index];
+                btCollisionWorld::ClosestConvexResultCallback callback(
+                    request.mFrom.getOrigin(), request.mTo.getOrigin());
+                callback.m_collisionFilterGroup = request.mCollisionFilterGroup;
+                callback.m_collisionFilterMask = request.mCollisionFilterMask;
+                mCollisionWorld->convexSweepTest(request.mShape.get(), request.mFrom, request.mTo, callback);
+                batch->mResults[index] = makeRayCastingResult(callback.m_hitPointWorld, callback.m_hitNormalWorld,
+                    callback.hasHit() ? callback.m_hitCollisionObject : nullptr);
+            }
         }
     }
 
+    void PhysicsTaskScheduler::finishQueries()
+    {
+        for (const std::unique_ptr<QueryBatch>& batch : mQueries)
+            batch->mPromise.set_value(std::move(batch->mResults));
+        mQueries.clear();
+        mQueryJobs.clear();
+    }
+
     void PhysicsTaskScheduler::updateAabbs()
     {
         MaybeExclusiveLock lock(mUpdateAabbMutex, mLockingPolicy);
@@ -734,6 +998,8 @@ namespace MWPhysics
         }
         else if (const auto object = std::dynamic_pointer_cast<Object>(ptr))
         {
+            // Actors resting on or next to the object have to check their collisions again
+            mWorldVersion.fetch_add(1, std::memory_order_relaxed);
             object->commitPositionChange();
             mCollisionWorld->updateSingleAabb(object->getCollisionObject());
         }
@@ -746,8 +1012,12 @@ namespace MWPhysics
 
     void PhysicsTaskScheduler::worker()
     {
+        if (!mThreadCores.empty())
+            Misc::setCurrentThreadAffinity(mThreadCores);
+        Debug::Tracing::setThreadName("Physics");
         mWorkersSync->runWorker([this] {
             std::shared_lock lock(mSimulationMutex);
+            const Debug::TraceZone zone("Physics simulation");
             doSimulation();
         });
     }
@@ -763,17 +1033,10 @@ namespace MWPhysics
 
     bool PhysicsTaskScheduler::hasLineOfSight(const Actor* actor1, const Actor* actor2)
     {
-        btVector3 pos1 = Misc::Convert::toBullet(
-            actor1->getCollisionObjectPosition() + osg::Vec3f(0, 0, actor1->getHalfExtents().z() * 0.9f)); // eye level
-        btVector3 pos2 = Misc::Convert::toBullet(
-            actor2->getCollisionObjectPosition() + osg::Vec3f(0, 0, actor2->getHalfExtents().z() * 0.9f));
-
-        btCollisionWorld::ClosestRayResultCallback resultCallback(pos1, pos2);
-        resultCallback.m_collisionFilterGroup = CollisionType_AnyPhysical;
-        resultCallback.m_collisionFilterMask = CollisionType_World | CollisionType_HeightMap | CollisionType_Door;
+        btCollisionWorld::ClosestRayResultCallback resultCallback = makeLineOfSightCallback(actor1, actor2);
 
         MaybeLock lockColWorld(mCollisionWorldMutex, mLockingPolicy);
-        mCollisionWorld->rayTest(pos1, pos2, resultCallback);
+        mCollisionWorld->rayTest(resultCallback.m_rayFromWorld, resultCallback.m_rayToWorld, resultCallback);
 
         return !resultCallback.hasHit();
     }
@@ -784,7 +1047,7 @@ namespace MWPhysics
         {
             mPreStepBarrier->wait([this] { afterPreStep(); });
             int job = 0;
-            const Visitors::Move impl{ mPhysicsDt, mCollisionWorld, *mWorldFrameData };
+            const Visitors::Move impl{ mPhysicsDt, mCollisionWorld, *mWorldFrameData, mFullSolves, mSkippedSolves };
             const Visitors::WithLockedPtr<Visitors::Move, MaybeLock> vis{ impl, mCollisionWorldMutex, mLockingPolicy };
             while ((job = mNextJob.fetch_add(1, std::memory_order_relaxed)) < mNumJobs)
                 std::visit(vis, (*mSimulations)[job]);
@@ -793,6 +1056,7 @@ namespace MWPhysics
         }
 
         refreshLOSCache();
+        runQueries();
         mPostSimBarrier->wait([this] { afterPostSim(); });
     }
 
@@ -842,6 +1106,7 @@ namespace MWPhysics
         updateAabbs();
         if (!mRemainingSteps)
             return;
+        mWorldFrameData->mWorldVersion = mWorldVersion.load(std::memory_order_relaxed);
         const Visitors::PreStep impl{ mCollisionWorld };
         const Visitors::WithLockedPtr<Visitors::PreStep, MaybeExclusiveLock> vis{ impl, mCollisionWorldMutex,
             mLockingPolicy };
@@ -867,6 +1132,9 @@ namespace MWPhysics
                 std::remove_if(mLOSCache.begin(), mLOSCache.end(), [](const LOSRequest& req) { return req.mStale; }),
                 mLOSCache.end());
         }
+        finishQueries();
+        mLastFullSolves.store(mFullSolves.exchange(0, std::memory_order_relaxed), std::memory_order_relaxed);
+        mLastSkippedSolves.store(mSkippedSolves.exchange(0, std::memory_order_relaxed), std::memory_order_relaxed);
         mTimeEnd = mTimer->tick();
         if (mWorkersSync != nullptr)
             mWorkersSync->workIsDone();
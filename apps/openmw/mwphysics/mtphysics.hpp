@@ -3,12 +3,15 @@
 
 #include <atomic>
 #include <condition_variable>
+#include <future>
 #include <memory>
 #include <optional>
 #include <set>
 #include <shared_mutex>
+#include <span>
 #include <thread>
 #include <unordered_set>
+#include <vector>
 
 #include <BulletCollision/CollisionDispatch/btCollisionWorld.h>
 
@@ -37,6 +40,23 @@ namespace MWPhysics
         AllowSharedLocks,
     };
 
+    struct RayRequest
+    {
+        btVector3 mFrom;
+        btVector3 mTo;
+        int mCollisionFilterGroup;
+        int mCollisionFilterMask;
+    };
+
+    struct SweepRequest
+    {
+        std::shared_ptr<const btConvexShape> mShape;
+        btTransform mFrom;
+        btTransform mTo;
+        int mCollisionFilterGroup;
+        int mCollisionFilterMask;
+    };
+
     class PhysicsTaskScheduler
     {
     public:
@@ -56,9 +76,17 @@ namespace MWPhysics
         // Thread safe wrappers
         void rayTest(const btVector3& rayFromWorld, const btVector3& rayToWorld,
             btCollisionWorld::RayResultCallback& resultCallback) const;
+        /// Cast rays defined by each callback from and to points under a single lock
+        void rayTest(std::span<btCollisionWorld::ClosestRayResultCallback> callbacks) const;
         void convexSweepTest(const btConvexShape* castShape, const btTransform& from, const btTransform& to,
             btCollisionWorld::ConvexResultCallback& resultCallback) const;
         void contactTest(btCollisionObject* colObj, btCollisionWorld::ContactResultCallback& resultCallback);
+        /// Queue the rays to be cast by the physics threads after the next simulation steps instead of locking the
+        /// collision world for each of them. Results are in the order of the requests.
+        /// @note The future is ready at the latest when the next frame's simulation starts.
+        std::future<std::vector<RayCastingResult>> submitRayBatch(std::span<const RayRequest> requests);
+        /// Same as submitRayBatch for convex sweeps
+        std::future<std::vector<RayCastingResult>> submitSweepBatch(std::span<const SweepRequest> requests);
         std::optional<btVector3> getHitPoint(const btTransform& from, btCollisionObject* target);
         void aabbTest(const btVector3& aabbMin, const btVector3& aabbMax, btBroadphaseAabbCallback& callback);
         void getAabb(const btCollisionObject* obj, btVector3& min, btVector3& max);
@@ -67,6 +95,12 @@ namespace MWPhysics
         void removeCollisionObject(btCollisionObject* collisionObject);
         void updateSingleAabb(const std::shared_ptr<PtrHolder>& ptr, bool immediate = false);
         bool getLineOfSight(const std::shared_ptr<Actor>& actor1, const std::shared_ptr<Actor>& actor2);
+        /// Same as getLineOfSight for each of the targets, the rays of the uncached ones are cast under a single lock
+        std::vector<bool> getLinesOfSight(
+            const std::shared_ptr<Actor>& actor, std::span<const std::shared_ptr<Actor>> targets);
+        /// Compute the cached lines of sight of the actor again when they are next requested
+        void invalidateLineOfSight(const Actor* actor);
+        void reportStats(unsigned int frameNumber, osg::Stats& stats) const;
         void debugDraw();
         void* getUserPointer(const btCollisionObject* object) const;
         void releaseSharedStates(); // destroy all objects whose destructor can't be safely called from
@@ -74,12 +108,18 @@ namespace MWPhysics
 
     private:
         class WorkersSync;
+        struct QueryBatch;
 
         void doSimulation();
         void worker();
         void updateActorsPositions();
         bool hasLineOfSight(const Actor* actor1, const Actor* actor2);
+        void cacheLineOfSight(const LOSRequest& request);
         void refreshLOSCache();
+        std::future<std::vector<RayCastingResult>> queueQueries(std::unique_ptr<QueryBatch> batch);
+        void startQueries();
+        void runQueries();
+        void finishQueries();
         void updateAabbs();
         void updatePtrAabb(const std::shared_ptr<PtrHolder>& ptr);
         void updateStats(osg::Timer_t frameStart, unsigned int frameNumber, osg::Stats& stats);
@@ -113,9 +153,21 @@ namespace MWPhysics
         int mNumJobs;
         unsigned mRemainingSteps;
         int mLOSCacheExpiry;
+        int mLOSMaxRefreshInterval;
+        std::size_t mLOSCacheSize;
+        std::size_t mLOSRequests = 0;
+        std::size_t mLOSHits = 0;
         bool mAdvanceSimulation;
         std::atomic<int> mNextJob;
         std::atomic<int> mNextLOS;
+        std::atomic<int> mNextQuery;
+        // Incremented whenever something actors can stand on or collide with is added, removed or moved
+        std::atomic<std::size_t> mWorldVersion{ 0 };
+        std::atomic<unsigned> mFullSolves{ 0 };
+        std::atomic<unsigned> mSkippedSolves{ 0 };
+        std::atomic<unsigned> mLastFullSolves{ 0 };
+        std::atomic<unsigned> mLastSkippedSolves{ 0 };
+        std::vector<unsigned> mThreadCores;
         std::vector<std::thread> mThreads;
 
         mutable std::shared_mutex mSimulationMutex;
@@ -123,6 +175,12 @@ namespace MWPhysics
         mutable std::shared_mutex mLOSCacheMutex;
         mutable std::mutex mUpdateAabbMutex;
 
+        std::mutex mQueuedQueriesMutex;
+        std::vector<std::unique_ptr<QueryBatch>> mQueuedQueries;
+        // Only touched by the main thread while the workers are waiting, and by the workers during the simulation
+        std::vector<std::unique_ptr<QueryBatch>> mQueries;
+        std::vector<std::pair<QueryBatch*, std::size_t>> mQueryJobs;
+
         unsigned int mFrameNumber;
         const osg::Timer* mTimer;
 
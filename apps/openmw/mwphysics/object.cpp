@@ -1,6 +1,8 @@
 #include "object.hpp"
 #include "mtphysics.hpp"
 
+#include <cassert>
+
 #include <components/bullethelpers/collisionobject.hpp>
 #include <components/debug/debuglog.hpp>
 #include <components/misc/convert.hpp>
@@ -12,12 +14,50 @@
 
 #include <LinearMath/btTransform.h>
 
+#include <osg/MatrixTransform>
+#include <osg/Transform>
+
 namespace MWPhysics
 {
+    namespace
+    {
+        // Transforms along the node path are set by the animation controllers in many ways, compare their results
+        // instead of tracking the changes
+        bool updateLocalMatrices(const osg::NodePath& nodePath, std::vector<osg::Matrix>& matrices)
+        {
+            bool changed = false;
+            std::size_t index = 0;
+            for (const osg::Node* node : nodePath)
+            {
+                const osg::Transform* transform = node->asTransform();
+                if (transform == nullptr)
+                    continue;
+                osg::Matrix matrix;
+                if (const osg::MatrixTransform* matrixTransform = transform->asMatrixTransform())
+                    matrix = matrixTransform->getMatrix();
+                else
+                    transform->computeLocalToWorldMatrix(matrix, nullptr);
+                if (index == matrices.size())
+                {
+                    matrices.push_back(matrix);
+                    changed = true;
+                }
+                else if (matrices[index] != matrix)
+                {
+                    matrices[index] = matrix;
+                    changed = true;
+                }
+                ++index;
+            }
+            return changed;
+        }
+    }
+
     Object::Object(const MWWorld::Ptr& ptr, osg::ref_ptr<Resource::BulletShapeInstance> shapeInstance,
-        osg::Quat rotation, int collisionType, PhysicsTaskScheduler* scheduler)
+        osg::Quat rotation, int collisionType, PhysicsTaskScheduler* scheduler, bool sharedShape)
         : PtrHolder(ptr, osg::Vec3f())
         , mShapeInstance(std::move(shapeInstance))
+        , mSharedShape(sharedShape)
         , mSolid(true)
         , mScale(ptr.getCellRef().getScale(), ptr.getCellRef().getScale(), ptr.getCellRef().getScale())
         , mPosition(ptr.getRefData().getPosition().asVec3())
@@ -28,7 +68,8 @@ namespace MWPhysics
         mCollisionObject = BulletHelpers::makeCollisionObject(mShapeInstance->mCollisionShape.get(),
             Misc::Convert::toBullet(mPosition), Misc::Convert::toBullet(rotation));
         mCollisionObject->setUserPointer(this);
-        mShapeInstance->setLocalScaling(mScale);
+        if (!mSharedShape)
+            mShapeInstance->setLocalScaling(mScale);
         mTaskScheduler->addCollisionObject(mCollisionObject.get(), collisionType,
             CollisionType_Actor | CollisionType_HeightMap | CollisionType_Projectile);
     }
@@ -43,6 +84,16 @@ namespace MWPhysics
         return mShapeInstance.get();
     }
 
+    void Object::setShapeInstance(osg::ref_ptr<Resource::BulletShapeInstance> shapeInstance)
+    {
+        assert(mSharedShape);
+        std::unique_lock<std::mutex> lock(mPositionMutex);
+        if (!mShapeUpdatePending)
+            mPreviousShapeInstance = std::move(mShapeInstance);
+        mShapeInstance = std::move(shapeInstance);
+        mShapeUpdatePending = true;
+    }
+
     void Object::setScale(float scale)
     {
         std::unique_lock<std::mutex> lock(mPositionMutex);
@@ -67,9 +118,17 @@ namespace MWPhysics
     void Object::commitPositionChange()
     {
         std::unique_lock<std::mutex> lock(mPositionMutex);
+        if (mShapeUpdatePending)
+        {
+            mCollisionObject->setCollisionShape(mShapeInstance->mCollisionShape.get());
+            mPreviousShapeInstance = nullptr;
+            mShapeUpdatePending = false;
+        }
         if (mScaleUpdatePending)
         {
-            mShapeInstance->setLocalScaling(mScale);
+            // A shared instance is replaced by one with the new scale instead
+            if (!mSharedShape)
+                mShapeInstance->setLocalScaling(mScale);
             mScaleUpdatePending = false;
         }
         if (mTransformUpdatePending)
@@ -120,8 +179,8 @@ namespace MWPhysics
         bool result = false;
         for (const auto& [recIndex, shapeIndex] : mShapeInstance->mAnimatedShapes)
         {
-            auto nodePathFound = mRecIndexToNodePath.find(recIndex);
-            if (nodePathFound == mRecIndexToNodePath.end())
+            auto nodePathFound = mAnimatedNodes.find(recIndex);
+            if (nodePathFound == mAnimatedNodes.end())
             {
                 NifOsg::FindGroupByRecIndex visitor(recIndex);
                 mPtr.getRefData().getBaseNode()->accept(visitor);
@@ -136,11 +195,18 @@ namespace MWPhysics
                 }
                 osg::NodePath nodePath = visitor.mFoundPath;
                 nodePath.erase(nodePath.begin());
-                nodePathFound = mRecIndexToNodePath.emplace(recIndex, nodePath).first;
+                nodePathFound = mAnimatedNodes.emplace(recIndex, AnimatedNode{ std::move(nodePath) }).first;
             }
 
-            osg::NodePath& nodePath = nodePathFound->second;
-            osg::Matrixf matrix = osg::computeLocalToWorld(nodePath);
+            AnimatedNode& animatedNode = nodePathFound->second;
+            const bool matricesChanged = updateLocalMatrices(animatedNode.mNodePath, animatedNode.mLocalMatrices);
+            if (!matricesChanged && animatedNode.mCompound == compound
+                && animatedNode.mCompoundScaling == compound->getLocalScaling())
+                continue;
+            animatedNode.mCompound = compound;
+            animatedNode.mCompoundScaling = compound->getLocalScaling();
+
+            osg::Matrixf matrix = osg::computeLocalToWorld(animatedNode.mNodePath);
             btVector3 scale = Misc::Convert::toBullet(matrix.getScale());
             matrix.orthoNormalize(matrix);
 
@@ -4,10 +4,14 @@
 #include "ptrholder.hpp"
 
 #include <LinearMath/btTransform.h>
+#include <osg/Matrix>
 #include <osg/Node>
 
 #include <map>
 #include <mutex>
+#include <vector>
+
+class btCompoundShape;
 
 namespace Resource
 {
@@ -29,11 +33,15 @@ namespace MWPhysics
     class Object final : public PtrHolder
     {
     public:
+        /// @param sharedShape the instance is shared with other objects and already has the scale of the object
         Object(const MWWorld::Ptr& ptr, osg::ref_ptr<Resource::BulletShapeInstance> shapeInstance, osg::Quat rotation,
-            int collisionType, PhysicsTaskScheduler* scheduler);
+            int collisionType, PhysicsTaskScheduler* scheduler, bool sharedShape = false);
         ~Object() override;
 
         const Resource::BulletShapeInstance* getShapeInstance() const;
+        bool isShapeShared() const { return mSharedShape; }
+        /// Replace a shared shape instance by one with a different scale.
+        void setShapeInstance(osg::ref_ptr<Resource::BulletShapeInstance> shapeInstance);
         void setScale(float scale);
         void setRotation(osg::Quat quat);
         void updatePosition();
@@ -52,12 +60,25 @@ namespace MWPhysics
 
     private:
         osg::ref_ptr<Resource::BulletShapeInstance> mShapeInstance;
-        std::map<int, osg::NodePath> mRecIndexToNodePath;
+        // Used by the collision object until the next commitPositionChange
+        osg::ref_ptr<Resource::BulletShapeInstance> mPreviousShapeInstance;
+        bool mSharedShape;
+        struct AnimatedNode
+        {
+            osg::NodePath mNodePath;
+            // The state the child shape was last updated for, the update is skipped when none of it changed
+            std::vector<osg::Matrix> mLocalMatrices;
+            const btCompoundShape* mCompound = nullptr;
+            btVector3 mCompoundScaling;
+        };
+
+        std::map<int, AnimatedNode> mAnimatedNodes;
         bool mSolid;
         btVector3 mScale;
         osg::Vec3f mPosition;
         osg::Quat mRotation;
         bool mScaleUpdatePending = false;
+        bool mShapeUpdatePending = false;
         bool mTransformUpdatePending = false;
         mutable std::mutex mPositionMutex;
         PhysicsTaskScheduler* mTaskScheduler;
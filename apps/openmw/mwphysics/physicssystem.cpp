@@ -9,6 +9,7 @@
 #include <osg/Timer>
 
 #include <BulletCollision/BroadphaseCollision/btDbvtBroadphase.h>
+#include <BulletCollision/BroadphaseCollision/btOverlappingPairCache.h>
 #include <BulletCollision/CollisionDispatch/btCollisionObject.h>
 #include <BulletCollision/CollisionDispatch/btCollisionWorld.h>
 #include <BulletCollision/CollisionDispatch/btDefaultCollisionConfiguration.h>
@@ -55,6 +56,7 @@
 #include "mtphysics.hpp"
 #include "object.hpp"
 #include "projectile.hpp"
+#include "simulationrecording.hpp"
 
 namespace
 {
@@ -109,7 +111,10 @@ namespace MWPhysics
 
         mCollisionConfiguration = std::make_unique<btDefaultCollisionConfiguration>();
         mDispatcher = std::make_unique<btCollisionDispatcher>(mCollisionConfiguration.get());
-        mBroadphase = std::make_unique<btDbvtBroadphase>();
+        // Nothing is dispatched from the overlapping pairs, all collisions are found by queries. Don't spend time and
+        // memory on storing the pairs found whenever an object moves.
+        mPairCache = std::make_unique<btNullPairCache>();
+        mBroadphase = std::make_unique<btDbvtBroadphase>(mPairCache.get());
 
         mCollisionWorld
             = std::make_unique<btCollisionWorld>(mDispatcher.get(), mBroadphase.get(), mCollisionConfiguration.get());
@@ -130,6 +135,18 @@ namespace MWPhysics
             }
         }
 
+        if (const char* env = getenv("OPENMW_PHYSICS_RECORD"))
+        {
+            mRecorder = std::make_unique<SimulationRecorder>(env);
+            Log(Debug::Warning) << "Warning: recording physics simulation to " << env;
+        }
+
+        if (const char* env = getenv("OPENMW_PHYSICS_REPLAY"))
+        {
+            mReplay = std::make_unique<SimulationReplay>(env);
+            Log(Debug::Warning) << "Warning: replaying physics simulation from " << env;
+        }
+
         mDebugDrawer = std::make_unique<MWRender::DebugDrawer>(mParentNode, mCollisionWorld.get(), mDebugDrawEnabled);
         mTaskScheduler = std::make_unique<PhysicsTaskScheduler>(mPhysicsDt, mCollisionWorld.get(), mDebugDrawer.get());
     }
@@ -251,6 +268,31 @@ namespace MWPhysics
         return result;
     }
 
+    std::vector<bool> PhysicsSystem::castRays(std::span<const RaySegment> rays, int mask, int group) const
+    {
+        std::vector<bool> result(rays.size(), false);
+        std::vector<std::size_t> indices;
+        std::vector<btCollisionWorld::ClosestRayResultCallback> callbacks;
+        indices.reserve(rays.size());
+        callbacks.reserve(rays.size());
+        for (std::size_t i = 0; i < rays.size(); ++i)
+        {
+            if (rays[i].mFrom == rays[i].mTo)
+                continue;
+            btCollisionWorld::ClosestRayResultCallback& callback = callbacks.emplace_back(
+                Misc::Convert::toBullet(rays[i].mFrom), Misc::Convert::toBullet(rays[i].mTo));
+            callback.m_collisionFilterGroup = group;
+            callback.m_collisionFilterMask = mask;
+            indices.push_back(i);
+        }
+
+        mTaskScheduler->rayTest(callbacks);
+
+        for (std::size_t i = 0; i < callbacks.size(); ++i)
+            result[indices[i]] = callbacks[i].hasHit();
+        return result;
+    }
+
     RayCastingResult PhysicsSystem::castSphere(
         const osg::Vec3f& from, const osg::Vec3f& to, float radius, int mask, int group) const
     {
@@ -277,6 +319,30 @@ namespace MWPhysics
         return result;
     }
 
+    std::future<std::vector<RayCastingResult>> PhysicsSystem::submitRayBatch(
+        std::span<const RaySegment> rays, int mask, int group) const
+    {
+        std::vector<RayRequest> requests;
+        requests.reserve(rays.size());
+        for (const RaySegment& ray : rays)
+            requests.push_back(
+                RayRequest{ Misc::Convert::toBullet(ray.mFrom), Misc::Convert::toBullet(ray.mTo), group, mask });
+        return mTaskScheduler->submitRayBatch(requests);
+    }
+
+    std::future<std::vector<RayCastingResult>> PhysicsSystem::submitSweepBatch(
+        std::span<const RaySegment> segments, float radius, int mask, int group) const
+    {
+        const auto shape = std::make_shared<const btSphereShape>(radius);
+        const btQuaternion btrot = btQuaternion::getIdentity();
+        std::vector<SweepRequest> requests;
+        requests.reserve(segments.size());
+        for (const RaySegment& segment : segments)
+            requests.push_back(SweepRequest{ shape, btTransform(btrot, Misc::Convert::toBullet(segment.mFrom)),
+                btTransform(btrot, Misc::Convert::toBullet(segment.mTo)), group, mask });
+        return mTaskScheduler->submitSweepBatch(requests);
+    }
+
     bool PhysicsSystem::getLineOfSight(const MWWorld::ConstPtr& actor1, const MWWorld::ConstPtr& actor2) const
     {
         if (actor1 == actor2)
@@ -290,6 +356,36 @@ namespace MWPhysics
         return mTaskScheduler->getLineOfSight(it1->second, it2->second);
     }
 
+    std::vector<bool> PhysicsSystem::getLinesOfSight(
+        const MWWorld::ConstPtr& actor, std::span<const MWWorld::ConstPtr> targets) const
+    {
+        std::vector<bool> result(targets.size(), false);
+        const auto it = mActors.find(actor.mRef);
+        if (it == mActors.end())
+            return result;
+
+        std::vector<std::size_t> indices;
+        std::vector<std::shared_ptr<Actor>> physicsTargets;
+        for (std::size_t i = 0; i < targets.size(); ++i)
+        {
+            if (targets[i] == actor)
+            {
+                result[i] = true;
+                continue;
+            }
+            const auto target = mActors.find(targets[i].mRef);
+            if (target == mActors.end())
+                continue;
+            indices.push_back(i);
+            physicsTargets.push_back(target->second);
+        }
+
+        const std::vector<bool> linesOfSight = mTaskScheduler->getLinesOfSight(it->second, physicsTargets);
+        for (std::size_t i = 0; i < indices.size(); ++i)
+            result[indices[i]] = linesOfSight[i];
+        return result;
+    }
+
     bool PhysicsSystem::isOnGround(const MWWorld::Ptr& actor)
     {
         Actor* physactor = getActor(actor);
@@ -413,8 +509,16 @@ namespace MWPhysics
         const VFS::Path::Normalized animationMesh = ptr.getClass().useAnim()
             ? Misc::ResourceHelpers::correctActorModelPath(mesh, mResourceSystem->getVFS())
             : VFS::Path::Normalized(mesh);
-        osg::ref_ptr<Resource::BulletShapeInstance> shapeInstance = mShapeManager->getInstance(animationMesh);
-        if (!shapeInstance || !shapeInstance->mCollisionShape)
+        osg::ref_ptr<const Resource::BulletShape> shape = mShapeManager->getShape(animationMesh);
+        if (!shape || !shape->mCollisionShape)
+            return;
+
+        // Animated shapes are modified by each object
+        const bool sharedShape = !shape->isAnimated();
+        osg::ref_ptr<Resource::BulletShapeInstance> shapeInstance = sharedShape
+            ? mShapeManager->getScaledInstance(std::move(shape), ptr.getCellRef().getScale())
+            : mShapeManager->getInstance(animationMesh);
+        if (!shapeInstance)
             return;
 
         assert(!getObject(ptr));
@@ -432,7 +536,8 @@ namespace MWPhysics
                 break;
         }
 
-        auto obj = std::make_shared<Object>(ptr, shapeInstance, rotation, collisionType, mTaskScheduler.get());
+        auto obj = std::make_shared<Object>(
+            ptr, shapeInstance, rotation, collisionType, mTaskScheduler.get(), sharedShape);
         mObjects.emplace(ptr.mRef, obj);
 
         if (obj->isAnimated())
@@ -517,7 +622,11 @@ namespace MWPhysics
         if (auto foundObject = mObjects.find(ptr.mRef); foundObject != mObjects.end())
         {
             float scale = ptr.getCellRef().getScale();
-            foundObject->second->setScale(scale);
+            Object& object = *foundObject->second;
+            if (object.isShapeShared())
+                object.setShapeInstance(
+                    mShapeManager->getScaledInstance(object.getShapeInstance()->getSource(), scale));
+            object.setScale(scale);
             mTaskScheduler->updateSingleAabb(foundObject->second);
         }
         else if (auto foundActor = mActors.find(ptr.mRef); foundActor != mActors.end())
@@ -555,6 +664,7 @@ namespace MWPhysics
         {
             foundActor->second->updatePosition();
             mTaskScheduler->updateSingleAabb(foundActor->second, true);
+            mTaskScheduler->invalidateLineOfSight(foundActor->second.get());
         }
     }
 
@@ -695,6 +805,7 @@ namespace MWPhysics
     void PhysicsSystem::stepSimulation(
         float dt, bool skipSimulation, osg::Timer_t frameStart, unsigned int frameNumber, osg::Stats& stats)
     {
+        mUpdatedAnimatedObjects = 0;
         for (auto& [animatedObject, changed] : mAnimatedObjects)
         {
             if (animatedObject->animateCollisionShapes())
@@ -703,6 +814,7 @@ namespace MWPhysics
                 assert(obj != mObjects.end());
                 mTaskScheduler->updateSingleAabb(obj->second);
                 changed = true;
+                ++mUpdatedAnimatedObjects;
             }
             else
             {
@@ -717,16 +829,88 @@ namespace MWPhysics
         CProfileManager::Increment_Frame_Counter();
 #endif
 
+        if (mReplay != nullptr && !skipSimulation)
+            replayFrame(dt);
+        else if (mRecorder != nullptr && !skipSimulation)
+            mRecorder->record(makeRecordedFrame(dt));
+
         mTimeAccum += dt;
 
         if (skipSimulation)
             mTaskScheduler->resetSimulation(mActors);
         else
         {
+            const osg::Timer_t start = osg::Timer::instance()->tick();
             std::vector<Simulation>& simulations = mSimulations[mSimulationsCounter++ % mSimulations.size()];
             prepareSimulation(mTimeAccum >= mPhysicsDt, simulations);
             // modifies mTimeAccum
             mTaskScheduler->applyQueuedMovements(mTimeAccum, simulations, frameStart, frameNumber, stats);
+            if (mReplay != nullptr)
+                mReplay->reportTime(osg::Timer::instance()->delta_s(start, osg::Timer::instance()->tick()));
+        }
+    }
+
+    RecordedFrame PhysicsSystem::makeRecordedFrame(float dt) const
+    {
+        RecordedFrame frame;
+        frame.mDt = dt;
+        const MWWorld::ConstPtr player = MWBase::Environment::get().getWorld()->getPlayerConstPtr();
+        for (const auto& [_, actor] : mActors)
+        {
+            const MWWorld::Ptr ptr = actor->getPtr();
+            const bool isPlayer = ptr == player;
+            const ESM::RefNum refNum = ptr.getCellRef().getRefNum();
+            // Can't find the actor again on replay
+            if (!isPlayer && !refNum.isSet())
+                continue;
+            const ESM::Position& position = ptr.getRefData().getPosition();
+            frame.mActors.push_back(RecordedActor{
+                refNum, isPlayer, position.asVec3(), position.asRotationVec3(), actor->getVelocity() });
+        }
+        return frame;
+    }
+
+    void PhysicsSystem::replayFrame(float& dt)
+    {
+        // Recorded actors are moved to the recorded position when the replayed simulation diverges from the
+        // recorded one by more than this distance, or they were teleported
+        constexpr float teleportDistance = 16;
+
+        const RecordedFrame* frame = mReplay->next();
+        if (frame == nullptr)
+            return;
+        dt = frame->mDt;
+
+        MWBase::World* world = MWBase::Environment::get().getWorld();
+        const MWWorld::ConstPtr player = world->getPlayerConstPtr();
+        std::unordered_map<ESM::RefNum, Actor*> actors;
+        Actor* playerActor = nullptr;
+        for (const auto& [_, actor] : mActors)
+        {
+            const MWWorld::Ptr ptr = actor->getPtr();
+            if (ptr == player)
+                playerActor = actor.get();
+            else
+                actors.emplace(ptr.getCellRef().getRefNum(), actor.get());
+        }
+
+        for (const RecordedActor& recorded : frame->mActors)
+        {
+            Actor* actor = playerActor;
+            if (!recorded.mIsPlayer)
+            {
+                const auto it = actors.find(recorded.mRefNum);
+                actor = it == actors.end() ? nullptr : it->second;
+            }
+            if (actor == nullptr)
+                continue;
+            MWWorld::Ptr ptr = actor->getPtr();
+            const ESM::Position& position = ptr.getRefData().getPosition();
+            if ((position.asVec3() - recorded.mPosition).length2() > teleportDistance * teleportDistance)
+                ptr = world->moveObject(ptr, recorded.mPosition);
+            if (ptr.getRefData().getPosition().asRotationVec3() != recorded.mRotation)
+                world->rotateObject(ptr, recorded.mRotation, MWBase::RotationFlag_none);
+            actor->setVelocity(recorded.mVelocity);
         }
     }
 
@@ -869,6 +1053,10 @@ namespace MWPhysics
         stats.setAttribute(frameNumber, "Physics Objects", static_cast<double>(mObjects.size()));
         stats.setAttribute(frameNumber, "Physics Projectiles", static_cast<double>(mProjectiles.size()));
         stats.setAttribute(frameNumber, "Physics HeightFields", static_cast<double>(mHeightFields.size()));
+        stats.setAttribute(frameNumber, "Physics Animated Objects", static_cast<double>(mAnimatedObjects.size()));
+        stats.setAttribute(
+            frameNumber, "Physics Animated Objects Updated", static_cast<double>(mUpdatedAnimatedObjects));
+        mTaskScheduler->reportStats(frameNumber, stats);
     }
 
     void PhysicsSystem::reportCollision(const btVector3& position, const btVector3& normal)
@@ -906,6 +1094,7 @@ namespace MWPhysics
         , mWaterCollision(waterCollision)
         , mSkipCollisionDetection(!actor.getCollisionMode())
         , mIsPlayer(isPlayer)
+        , mResting(actor.getRestingState())
     {
     }
 
@@ -927,7 +1116,10 @@ namespace MWPhysics
     LOSRequest::LOSRequest(const std::weak_ptr<Actor>& a1, const std::weak_ptr<Actor>& a2)
         : mResult(false)
         , mStale(false)
+        , mInvalidated(false)
         , mAge(0)
+        , mRefreshInterval(1)
+        , mFramesUntilRefresh(1)
     {
         // we use raw actor pointer pair to uniquely identify request
         // sort the pointer value in ascending order to not duplicate equivalent requests, eg. getLOS(A, B) and
@@ -4,6 +4,7 @@
 #include <algorithm>
 #include <array>
 #include <functional>
+#include <future>
 #include <map>
 #include <memory>
 #include <optional>
@@ -20,6 +21,7 @@
 
 #include "../mwworld/ptr.hpp"
 
+#include "actor.hpp"
 #include "collisiontype.hpp"
 #include "raycasting.hpp"
 
@@ -43,6 +45,7 @@ namespace Resource
 
 class btCollisionWorld;
 class btBroadphaseInterface;
+class btOverlappingPairCache;
 class btDefaultCollisionConfiguration;
 class btCollisionDispatcher;
 class btCollisionObject;
@@ -56,6 +59,9 @@ namespace MWPhysics
     class Actor;
     class PhysicsTaskScheduler;
     class Projectile;
+    class SimulationRecorder;
+    class SimulationReplay;
+    struct RecordedFrame;
     enum ScriptedCollisionType : char;
 
     using ActorMap = std::unordered_map<const MWWorld::LiveCellRefBase*, std::shared_ptr<Actor>>;
@@ -74,7 +80,12 @@ namespace MWPhysics
         std::array<const Actor*, 2> mRawActors;
         bool mResult;
         bool mStale;
+        // Has to be computed again on the next request, one of the actors was teleported
+        bool mInvalidated;
         int mAge;
+        // Frames between refreshes, grows while the result stays the same
+        int mRefreshInterval;
+        int mFramesUntilRefresh;
     };
     bool operator==(const LOSRequest& lhs, const LOSRequest& rhs) noexcept;
 
@@ -104,6 +115,7 @@ namespace MWPhysics
         const bool mWaterCollision;
         const bool mSkipCollisionDetection;
         const bool mIsPlayer;
+        RestingState mResting;
     };
 
     struct ProjectileFrameData
@@ -121,6 +133,8 @@ namespace MWPhysics
         WorldFrameData();
         bool mIsInStorm;
         osg::Vec3f mStormDirection;
+        /// PhysicsTaskScheduler::getWorldVersion at the start of the step
+        std::size_t mWorldVersion = 0;
     };
 
     template <class Ptr, class FrameData>
@@ -216,12 +230,27 @@ namespace MWPhysics
             int mask = CollisionType_Default, int group = 0xff) const override;
         using RayCastingInterface::castRay;
 
+        std::vector<bool> castRays(
+            std::span<const RaySegment> rays, int mask = CollisionType_Default, int group = 0xff) const override;
+
         RayCastingResult castSphere(const osg::Vec3f& from, const osg::Vec3f& to, float radius,
             int mask = CollisionType_Default, int group = 0xff) const override;
 
+        /// Cast the rays on the physics threads after the next simulation steps, for callers that can use the
+        /// results a frame later. Results are in the order of the rays.
+        std::future<std::vector<RayCastingResult>> submitRayBatch(
+            std::span<const RaySegment> rays, int mask = CollisionType_Default, int group = 0xff) const;
+
+        /// Same as submitRayBatch for spheres of the given radius moved along the segments
+        std::future<std::vector<RayCastingResult>> submitSweepBatch(std::span<const RaySegment> segments,
+            float radius, int mask = CollisionType_Default, int group = 0xff) const;
+
         /// Return true if actor1 can see actor2.
         bool getLineOfSight(const MWWorld::ConstPtr& actor1, const MWWorld::ConstPtr& actor2) const override;
 
+        std::vector<bool> getLinesOfSight(
+            const MWWorld::ConstPtr& actor, std::span<const MWWorld::ConstPtr> targets) const override;
+
         bool isOnGround(const MWWorld::Ptr& actor);
 
         bool canMoveToWaterSurface(const MWWorld::ConstPtr& actor, const float waterlevel);
@@ -294,6 +323,12 @@ namespace MWPhysics
 
         void prepareSimulation(bool willSimulate, std::vector<Simulation>& simulations);
 
+        RecordedFrame makeRecordedFrame(float dt) const;
+
+        /// Apply the inputs of the next replayed frame to the actors, replaces dt by the recorded one.
+        void replayFrame(float& dt);
+
+        std::unique_ptr<btOverlappingPairCache> mPairCache;
         std::unique_ptr<btBroadphaseInterface> mBroadphase;
         std::unique_ptr<btDefaultCollisionConfiguration> mCollisionConfiguration;
         std::unique_ptr<btCollisionDispatcher> mDispatcher;
@@ -307,6 +342,7 @@ namespace MWPhysics
         ObjectMap mObjects;
 
         std::map<Object*, bool> mAnimatedObjects; // stores pointers to elements in mObjects
+        std::size_t mUpdatedAnimatedObjects = 0;
 
         ActorMap mActors;
 
@@ -336,6 +372,9 @@ namespace MWPhysics
         std::array<std::vector<Simulation>, 2> mSimulations;
         std::vector<std::pair<MWWorld::Ptr, osg::Vec3f>> mActorsPositions;
 
+        std::unique_ptr<SimulationRecorder> mRecorder;
+        std::unique_ptr<SimulationReplay> mReplay;
+
         PhysicsSystem(const PhysicsSystem&);
         PhysicsSystem& operator=(const PhysicsSystem&);
     };
@@ -36,6 +36,8 @@ namespace MWPhysics
 
         osg::Vec3f velocity() { return std::exchange(mVelocity, osg::Vec3f()); }
 
+        const osg::Vec3f& getVelocity() const { return mVelocity; }
+
         void setSimulationPosition(const osg::Vec3f& position) { mSimulationPosition = position; }
 
         osg::Vec3f getSimulationPosition() const { return mSimulationPosition; }
@@ -3,6 +3,9 @@
 
 #include <osg/Vec3f>
 
+#include <span>
+#include <vector>
+
 #include "../mwworld/ptr.hpp"
 
 #include "collisiontype.hpp"
@@ -18,6 +21,12 @@ namespace MWPhysics
         MWWorld::Ptr mHitObject;
     };
 
+    struct RaySegment
+    {
+        osg::Vec3f mFrom;
+        osg::Vec3f mTo;
+    };
+
     class RayCastingInterface
     {
     public:
@@ -34,11 +43,22 @@ namespace MWPhysics
             return castRay(from, to, {}, {}, mask);
         }
 
+        /// Check each segment for a hit with anything of the given mask. Collision world is locked once for the whole
+        /// batch, prefer it over multiple castRay calls when hit details are not needed.
+        virtual std::vector<bool> castRays(
+            std::span<const RaySegment> rays, int mask = CollisionType_Default, int group = 0xff) const
+            = 0;
+
         virtual RayCastingResult castSphere(const osg::Vec3f& from, const osg::Vec3f& to, float radius,
             int mask = CollisionType_Default, int group = 0xff) const = 0;
 
         /// Return true if actor1 can see actor2.
         virtual bool getLineOfSight(const MWWorld::ConstPtr& actor1, const MWWorld::ConstPtr& actor2) const = 0;
+
+        /// Return for each of the targets whether actor can see it. Prefer it over multiple getLineOfSight calls.
+        virtual std::vector<bool> getLinesOfSight(
+            const MWWorld::ConstPtr& actor, std::span<const MWWorld::ConstPtr> targets) const
+            = 0;
     };
 }
 
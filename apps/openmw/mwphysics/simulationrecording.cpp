@@ -0,0 +1,123 @@
+#include "simulationrecording.hpp"
+
+#include <components/debug/debuglog.hpp>
+#include <components/settings/values.hpp>
+
+#include <algorithm>
+#include <iomanip>
+#include <limits>
+#include <string>
+#include <string_view>
+
+namespace MWPhysics
+{
+    namespace
+    {
+        // Increment when the format changes
+        constexpr int recordingVersion = 1;
+
+        constexpr std::string_view sRecordingHeader = "openmw-physics-recording";
+
+        void writeVec3f(std::ostream& stream, const osg::Vec3f& value)
+        {
+            stream << ' ' << value.x() << ' ' << value.y() << ' ' << value.z();
+        }
+
+        void readVec3f(std::istream& stream, osg::Vec3f& value)
+        {
+            stream >> value.x() >> value.y() >> value.z();
+        }
+    }
+
+    void writeRecordingHeader(std::ostream& stream)
+    {
+        stream << sRecordingHeader << ' ' << recordingVersion << '\n';
+    }
+
+    void writeRecordedFrame(std::ostream& stream, const RecordedFrame& frame)
+    {
+        // Replayed values have to match the recorded ones exactly to get the same simulation
+        stream << std::setprecision(std::numeric_limits<float>::max_digits10);
+        stream << "frame " << frame.mDt << ' ' << frame.mActors.size() << '\n';
+        for (const RecordedActor& actor : frame.mActors)
+        {
+            stream << actor.mIsPlayer << ' ' << actor.mRefNum.mIndex << ' ' << actor.mRefNum.mContentFile;
+            writeVec3f(stream, actor.mPosition);
+            writeVec3f(stream, actor.mRotation);
+            writeVec3f(stream, actor.mVelocity);
+            stream << '\n';
+        }
+    }
+
+    std::vector<RecordedFrame> readRecordedFrames(std::istream& stream)
+    {
+        std::vector<RecordedFrame> result;
+        std::string header;
+        int version = 0;
+        if (!(stream >> header >> version) || header != sRecordingHeader || version != recordingVersion)
+            return result;
+
+        std::string tag;
+        std::size_t count = 0;
+        RecordedFrame frame;
+        while (stream >> tag >> frame.mDt >> count && tag == "frame")
+        {
+            frame.mActors.resize(count);
+            for (RecordedActor& actor : frame.mActors)
+            {
+                stream >> actor.mIsPlayer >> actor.mRefNum.mIndex >> actor.mRefNum.mContentFile;
+                readVec3f(stream, actor.mPosition);
+                readVec3f(stream, actor.mRotation);
+                readVec3f(stream, actor.mVelocity);
+            }
+            if (!stream)
+                break;
+            result.push_back(frame);
+        }
+        return result;
+    }
+
+    SimulationRecorder::SimulationRecorder(const std::filesystem::path& path)
+        : mPath(path)
+        , mStream(path)
+    {
+        if (!mStream.is_open())
+            Log(Debug::Warning) << "Failed to open " << mPath << " to record physics simulation";
+        writeRecordingHeader(mStream);
+    }
+
+    void SimulationRecorder::record(const RecordedFrame& frame)
+    {
+        writeRecordedFrame(mStream, frame);
+    }
+
+    SimulationReplay::SimulationReplay(const std::filesystem::path& path)
+        : mPath(path)
+    {
+        std::ifstream stream(path);
+        if (!stream.is_open())
+            Log(Debug::Warning) << "Failed to open " << mPath << " to replay physics simulation";
+        mFrames = readRecordedFrames(stream);
+        Log(Debug::Info) << "Replaying " << mFrames.size() << " physics frames from " << mPath;
+    }
+
+    const RecordedFrame* SimulationReplay::next()
+    {
+        if (mNext >= mFrames.size())
+            return nullptr;
+        return &mFrames[mNext++];
+    }
+
+    void SimulationReplay::reportTime(double time)
+    {
+        ++mTimedFrames;
+        mTotalTime += time;
+        mMaxTime = std::max(mMaxTime, time);
+        if (mTimedFrames != mFrames.size())
+            return;
+        Log(Debug::Info) << "Replayed " << mTimedFrames << " physics frames from " << mPath << " with "
+                         << Settings::physics().mAsyncNumThreads.get() << " async threads: total "
+                         << mTotalTime * 1000 << " ms, mean " << mTotalTime * 1000 / mTimedFrames << " ms, max "
+                         << mMaxTime * 1000 << " ms";
+    }
+}
@@ -0,0 +1,76 @@
+#ifndef OPENMW_MWPHYSICS_SIMULATIONRECORDING_H
+#define OPENMW_MWPHYSICS_SIMULATIONRECORDING_H
+
+#include <components/esm3/refnum.hpp>
+
+#include <osg/Vec3f>
+
+#include <cstddef>
+#include <filesystem>
+#include <fstream>
+#include <istream>
+#include <ostream>
+#include <vector>
+
+namespace MWPhysics
+{
+    struct RecordedActor
+    {
+        ESM::RefNum mRefNum;
+        bool mIsPlayer = false;
+        osg::Vec3f mPosition;
+        osg::Vec3f mRotation;
+        osg::Vec3f mVelocity;
+    };
+
+    /// Inputs of the actor simulation for a single frame.
+    struct RecordedFrame
+    {
+        float mDt = 0;
+        std::vector<RecordedActor> mActors;
+    };
+
+    void writeRecordingHeader(std::ostream& stream);
+
+    void writeRecordedFrame(std::ostream& stream, const RecordedFrame& frame);
+
+    /// @return no frames if the stream doesn't start with a supported header
+    std::vector<RecordedFrame> readRecordedFrames(std::istream& stream);
+
+    /// @brief Writes the per-frame inputs of the actor simulation to a file to replay them by SimulationReplay.
+    class SimulationRecorder
+    {
+    public:
+        explicit SimulationRecorder(const std::filesystem::path& path);
+
+        void record(const RecordedFrame& frame);
+
+    private:
+        std::filesystem::path mPath;
+        std::ofstream mStream;
+    };
+
+    /// @brief Provides the frames written by SimulationRecorder one by one and logs the time spent on simulating them
+    /// once all are replayed.
+    class SimulationReplay
+    {
+    public:
+        explicit SimulationReplay(const std::filesystem::path& path);
+
+        /// @return nullptr when all frames are replayed
+        const RecordedFrame* next();
+
+        /// @param time spent on applying the queued movements of the last frame returned by next
+        void reportTime(double time);
+
+    private:
+        std::filesystem::path mPath;
+        std::vector<RecordedFrame> mFrames;
+        std::size_t mNext = 0;
+        std::size_t mTimedFrames = 0;
+        double mTotalTime = 0;
+        double mMaxTime = 0;
+    };
+}
+
+#endif
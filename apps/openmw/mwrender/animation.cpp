@@ -597,6 +597,18 @@ namespace MWRender
             mSkeleton->setActive(static_cast<SceneUtil::Skeleton::ActiveType>(active));
     }
 
+    void Animation::setSkinOnRequest(bool value)
+    {
+        if (mSkeleton)
+            mSkeleton->setSkinOnRequest(value);
+    }
+
+    void Animation::requestSkinning()
+    {
+        if (mSkeleton)
+            mSkeleton->requestSkinning();
+    }
+
     void Animation::updatePtr(const MWWorld::Ptr& ptr)
     {
         mPtr = ptr;
@@ -859,13 +871,9 @@ namespace MWRender
     {
         for (AnimSourceList::const_reverse_iterator iter(mAnimSources.rbegin()); iter != mAnimSources.rend(); ++iter)
         {
-            const SceneUtil::TextKeyMap& keys = (*iter)->getTextKeys();
-
-            for (auto iterKey = keys.begin(); iterKey != keys.end(); ++iterKey)
-            {
-                if (iterKey->second.starts_with(textKey))
-                    return iterKey->first;
-            }
+            const float time = (*iter)->getTextKeys().findTime(textKey);
+            if (time >= 0)
+                return time;
         }
 
         return -1.f;
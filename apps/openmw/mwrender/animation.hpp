@@ -331,6 +331,12 @@ namespace MWRender
         /// 0 = Inactive, 1 = Active in place, 2 = Active
         void setActive(int active);
 
+        /// @see SceneUtil::Skeleton::setSkinOnRequest
+        void setSkinOnRequest(bool value);
+
+        /// @see SceneUtil::Skeleton::requestSkinning
+        void requestSkinning();
+
         osg::Group* getOrCreateObjectRoot();
 
         osg::Group* getObjectRoot();
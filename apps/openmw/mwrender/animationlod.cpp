@@ -1,5 +1,6 @@
 #include "animationlod.hpp"
 
+#include <algorithm>
 #include <cmath>
 
 #include <components/settings/values.hpp>
@@ -13,7 +14,9 @@ namespace MWRender
         , mFOVCulling(false)
         , mFullRateDistance(1024.0f)
         , mMinRateDistance(4096.0f)
-        , mMinUpdateInterval(0.1f)
+        , mMaxUpdateBucket(3)
+        , mMaxVisibleUpdateBucket(1)
+        , mFullRateScreenSize(0.05f)
         , mFOVMargin(15.0f)
         , mCameraPosition(0, 0, 0)
         , mCameraForward(0, 1, 0)
@@ -21,6 +24,7 @@ namespace MWRender
         , mCameraUp(0, 0, 1)
         , mFOVCos(0.0f)
         , mAspectRatio(16.0f / 9.0f)
+        , mTanHalfFOV(1.0f)
     {
         loadSettings();
     }
@@ -32,7 +36,10 @@ namespace MWRender
         mFOVCulling = settings.mFOVCulling;
         mFullRateDistance = settings.mFullRateDistance;
         mMinRateDistance = settings.mMinRateDistance;
-        mMinUpdateInterval = settings.mMinUpdateInterval;
+        mMaxUpdateBucket = static_cast<unsigned>(settings.mMaxUpdateBucket.get());
+        mMaxVisibleUpdateBucket
+            = std::min(mMaxUpdateBucket, static_cast<unsigned>(settings.mMaxVisibleUpdateBucket.get()));
+        mFullRateScreenSize = settings.mFullRateScreenSize;
         mFOVMargin = settings.mFOVMargin;
     }
 
@@ -50,6 +57,7 @@ namespace MWRender
         // Calculate FOV cosine with margin for culling
         float halfFOV = (fovDegrees + mFOVMargin) * 0.5f;
         mFOVCos = std::cos(osg::DegreesToRadians(halfFOV));
+        mTanHalfFOV = std::tan(osg::DegreesToRadians(fovDegrees * 0.5f));
 
         // Extract aspect ratio from projection matrix if available
         if (std::abs(projMatrix(0, 0)) > 0.001f)
@@ -103,60 +111,59 @@ namespace MWRender
         return (position - mCameraPosition).length();
     }
 
-    float AnimationLOD::getUpdateInterval(float distance) const
+    float AnimationLOD::getScreenSize(float distance, float radius) const
+    {
+        if (distance <= radius || mTanHalfFOV <= 0.0f)
+            return 1.0f;
+        return radius / (distance * mTanHalfFOV);
+    }
+
+    unsigned AnimationLOD::getDistanceUpdateBucket(float distance) const
     {
         if (distance <= mFullRateDistance)
-            return 0.0f; // Update every frame
+            return 0; // Update every frame
 
         if (distance >= mMinRateDistance)
-            return mMinUpdateInterval;
+            return mMaxUpdateBucket;
 
         // Linear interpolation between full rate and min rate
         float t = (distance - mFullRateDistance) / (mMinRateDistance - mFullRateDistance);
-        return t * mMinUpdateInterval;
+        return static_cast<unsigned>(std::ceil(t * static_cast<float>(mMaxUpdateBucket)));
     }
 
-    bool AnimationLOD::shouldUpdateAnimation(const osg::Vec3f& position, float currentTime, const void* actorId)
+    unsigned AnimationLOD::getUpdateBucket(const osg::Vec3f& position, float radius) const
     {
         if (!mEnabled)
-            return true;
+            return 0;
 
-        // Check FOV culling
-        if (mFOVCulling && !isInFOV(position))
-            return false;
+        const float distance = getDistanceToCamera(position);
+        const unsigned bucket = getDistanceUpdateBucket(distance);
 
-        // Calculate distance-based update interval
-        float distance = getDistanceToCamera(position);
-        float updateInterval = getUpdateInterval(distance);
+        if (bucket == 0)
+            return 0;
 
-        if (updateInterval <= 0.0f)
-            return true; // Full rate update
+        if (!isInFOV(position))
+            return mMaxUpdateBucket;
 
-        // Check if enough time has passed since last update
-        auto it = mLastUpdateTimes.find(actorId);
-        if (it == mLastUpdateTimes.end())
-        {
-            mLastUpdateTimes[actorId] = currentTime;
-            return true;
-        }
+        // Large actors on the screen are updated at full rate regardless of distance
+        if (getScreenSize(distance, radius) >= mFullRateScreenSize)
+            return 0;
 
-        float timeSinceLastUpdate = currentTime - it->second;
-        if (timeSinceLastUpdate >= updateInterval)
-        {
-            it->second = currentTime;
-            return true;
-        }
-
-        return false;
+        return std::min(bucket, mMaxVisibleUpdateBucket);
     }
 
-    void AnimationLOD::resetActor(const void* actorId)
+    IKDetail AnimationLOD::getIKDetail(const osg::Vec3f& position, float radius) const
     {
-        mLastUpdateTimes.erase(actorId);
-    }
+        if (!mEnabled)
+            return IKDetail::Full;
 
-    void AnimationLOD::clear()
-    {
-        mLastUpdateTimes.clear();
+        const float distance = getDistanceToCamera(position);
+        if (distance >= mMinRateDistance || !isInFOV(position))
+            return IKDetail::None;
+
+        if (distance <= mFullRateDistance || getScreenSize(distance, radius) >= mFullRateScreenSize)
+            return IKDetail::Full;
+
+        return IKDetail::Feet;
     }
 }
@@ -4,14 +4,19 @@
 #include <osg/Matrix>
 #include <osg/Vec3f>
 
-#include <unordered_map>
-
-#include "../mwworld/ptr.hpp"
-
 namespace MWRender
 {
+    /// Which IK chains are solved for an actor
+    enum class IKDetail
+    {
+        None,
+        Feet,
+        Full,
+    };
+
     /// Animation Level of Detail system for performance optimization.
-    /// Manages animation update rates based on distance and FOV visibility.
+    /// Estimates actor update rates based on distance, projected size and FOV visibility. The rates are applied by
+    /// MWMechanics::UpdateScheduler.
     class AnimationLOD
     {
     public:
@@ -23,28 +28,27 @@ namespace MWRender
         /// @param fovDegrees The current field of view in degrees
         void updateCamera(const osg::Matrixf& viewMatrix, const osg::Matrixf& projMatrix, float fovDegrees);
 
-        /// Check if an actor should be updated this frame based on LOD settings
+        /// Get update bucket for an actor, actor in bucket N should be updated once per 2^N frames
         /// @param position The world position of the actor
-        /// @param currentTime The current simulation time
-        /// @param actorId A unique identifier for the actor (for tracking update times)
-        /// @return true if the actor should be animated this frame
-        bool shouldUpdateAnimation(const osg::Vec3f& position, float currentTime, const void* actorId);
+        /// @param radius The bounding radius of the actor
+        /// @return 0 for actors which should be updated every frame
+        unsigned getUpdateBucket(const osg::Vec3f& position, float radius) const;
+
+        /// Get the IK chains to solve for an actor: none off-screen or far away, feet only at mid-range and all of them
+        /// close up or when the actor is large on the screen
+        IKDetail getIKDetail(const osg::Vec3f& position, float radius) const;
 
         /// Check if a position is within the camera's FOV (with margin)
         /// @param position The world position to check
         /// @return true if the position is visible or within the margin
         bool isInFOV(const osg::Vec3f& position) const;
 
-        /// Calculate the update interval for an actor at a given distance
+        /// Calculate the update bucket for an actor at a given distance ignoring visibility
         /// @param distance The distance from the camera
-        /// @return The minimum time between animation updates
-        float getUpdateInterval(float distance) const;
+        unsigned getDistanceUpdateBucket(float distance) const;
 
-        /// Reset tracking data for an actor (call when actor is removed)
-        void resetActor(const void* actorId);
-
-        /// Clear all tracking data
-        void clear();
+        /// Calculate projected radius as a fraction of half screen height
+        float getScreenSize(float distance, float radius) const;
 
         /// Get the distance from the camera to a world position
         float getDistanceToCamera(const osg::Vec3f& position) const;
@@ -57,7 +61,9 @@ namespace MWRender
         bool mFOVCulling;
         float mFullRateDistance;
         float mMinRateDistance;
-        float mMinUpdateInterval;
+        unsigned mMaxUpdateBucket;
+        unsigned mMaxVisibleUpdateBucket;
+        float mFullRateScreenSize;
         float mFOVMargin;
 
         osg::Vec3f mCameraPosition;
@@ -66,9 +72,7 @@ namespace MWRender
         osg::Vec3f mCameraUp;
         float mFOVCos;        // Cosine of half FOV angle + margin
         float mAspectRatio;
-
-        // Track last update time for each actor
-        std::unordered_map<const void*, float> mLastUpdateTimes;
+        float mTanHalfFOV;
 
         void loadSettings();
     };
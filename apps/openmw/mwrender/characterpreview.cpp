@@ -24,6 +24,7 @@
 #include <components/sceneutil/nodecallback.hpp>
 #include <components/sceneutil/rtt.hpp>
 #include <components/sceneutil/shadow.hpp>
+#include <components/sceneutil/shareduniforms.hpp>
 #include <components/settings/values.hpp>
 #include <components/stereo/multiview.hpp>
 
@@ -80,6 +81,8 @@ namespace MWRender
 
         void redrawNextFrame() { mRendered = false; }
 
+        bool isRedrawPending() const { return !mRendered; }
+
         unsigned int getLastRenderedFrame() const { return mLastRenderedFrame; }
 
     private:
@@ -258,9 +261,13 @@ namespace MWRender
 
         // TODO: Clean up this mess of loose uniforms that shaders depend on.
         // turn off sky blending
-        stateset->addUniform(new osg::Uniform("far", 10000000.0f));
-        stateset->addUniform(new osg::Uniform("skyBlendingStart", 8000000.0f));
-        stateset->addUniform(new osg::Uniform("screenRes", osg::Vec2f{ 1, 1 }));
+        SceneUtil::SharedUniformData sharedUniforms;
+        sharedUniforms.get<SceneUtil::SharedUniform::Near>() = Settings::camera().mNearClip;
+        sharedUniforms.get<SceneUtil::SharedUniform::Far>() = 10000000.0f;
+        sharedUniforms.get<SceneUtil::SharedUniform::SkyBlendingStart>() = 8000000.0f;
+        sharedUniforms.get<SceneUtil::SharedUniform::ScreenRes>() = osg::Vec2f(1, 1);
+        SceneUtil::addSharedUniforms(
+            *stateset, sharedUniforms, mResourceSystem->getSceneManager()->getUseUniformBuffers());
 
         stateset->addUniform(new osg::Uniform("emissiveMult", 1.f));
 
@@ -382,10 +389,36 @@ namespace MWRender
 
     void CharacterPreview::redraw()
     {
+        if (!mShown)
+        {
+            mRedrawWhenShown = true;
+            return;
+        }
         mRTTNode->setNodeMask(Mask_RenderToTexture);
         mDrawOnceCallback->redrawNextFrame();
     }
 
+    void CharacterPreview::setShown(bool shown)
+    {
+        if (mShown == shown)
+            return;
+        mShown = shown;
+        if (shown)
+        {
+            mParent->addChild(mRTTNode);
+            if (mRedrawWhenShown)
+            {
+                mRedrawWhenShown = false;
+                redraw();
+            }
+        }
+        else
+        {
+            mRedrawWhenShown = mDrawOnceCallback->isRedrawPending();
+            mParent->removeChild(mRTTNode);
+        }
+    }
+
     // --------------------------------------------------------------------------------------------------
 
     InventoryPreview::InventoryPreview(
@@ -38,10 +38,15 @@ namespace MWRender
         int getTextureWidth() const;
         int getTextureHeight() const;
 
+        /// Render the preview again on the next frame, or once it's shown again when it's hidden.
         void redraw();
 
         void rebuild();
 
+        /// Detach the render to texture camera while the preview is not visible, so it's not rendered and its
+        /// update callbacks don't run. Redraws requested meanwhile are done once it's shown.
+        void setShown(bool shown);
+
         osg::ref_ptr<osg::Texture2D> getTexture();
         /// Get the osg::StateSet required to render the texture correctly, if any.
         osg::StateSet* getTextureStateSet() { return mTextureStateSet; }
@@ -72,6 +77,9 @@ namespace MWRender
 
         int mSizeX;
         int mSizeY;
+
+        bool mShown = true;
+        bool mRedrawWhenShown = false;
     };
 
     class InventoryPreview : public CharacterPreview
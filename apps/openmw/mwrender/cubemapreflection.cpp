@@ -10,6 +10,8 @@
 #include <components/resource/resourcesystem.hpp>
 #include <components/resource/scenemanager.hpp>
 #include <components/sceneutil/depth.hpp>
+#include <components/sceneutil/gputimer.hpp>
+#include <components/sceneutil/parallelcull.hpp>
 #include <components/settings/values.hpp>
 
 #include "vismask.hpp"
@@ -35,6 +37,11 @@ namespace MWRender
         osg::Vec3f(0, -1, 0)  // -Z
     };
 
+    // The face looking down only sees what the water clip plane removes, it's rendered with full updates only
+    static constexpr int sNumSlicedFaces = 5;
+    static constexpr std::uint8_t sAllFaces = (1 << 6) - 1;
+    static constexpr std::uint8_t sSlicedFaces = (1 << sNumSlicedFaces) - 1;
+
     CubemapReflection::CubemapReflection(osg::Group* sceneRoot, Resource::ResourceSystem* resourceSystem,
         int cubemapSize, CubemapReflectionType type, float reflectionDistance)
         : mSceneRoot(sceneRoot)
@@ -48,8 +55,10 @@ namespace MWRender
         , mNodeMask(Mask_Scene | Mask_Sky | Mask_Terrain | Mask_Static | Mask_Lighting)
         , mReflectActors(type == CubemapReflectionType::Dynamic)
         , mDirty(true)
+        , mRendered(false)
+        , mPendingFaces(0)
         , mCurrentFace(0)
-        , mFacesPerFrame(type == CubemapReflectionType::Dynamic ? 2 : 6)
+        , mFacesPerFrame(2)
     {
         // Create cubemap texture
         mCubemap = new osg::TextureCubeMap;
@@ -75,11 +84,27 @@ namespace MWRender
         }
     }
 
+    void CubemapReflection::traverse(osg::NodeVisitor& nv)
+    {
+        osgUtil::CullVisitor* cv = nv.asCullVisitor();
+        if (cv == nullptr)
+        {
+            osg::Group::traverse(nv);
+            return;
+        }
+
+        // The faces are independent views, let them be culled concurrently
+        for (const osg::ref_ptr<osg::Camera>& camera : mCameras)
+            if (camera && cv->validNodeMask(*camera))
+                SceneUtil::cullCamera(*cv, *camera);
+    }
+
     void CubemapReflection::createCubemapCameras()
     {
         for (int face = 0; face < 6; ++face)
         {
             mCameras[face] = new osg::Camera;
+            SceneUtil::addGpuTimer(*mCameras[face], "GPU Cubemap Reflection");
             setupCubemapCamera(face);
             addChild(mCameras[face]);
         }
@@ -201,44 +226,57 @@ namespace MWRender
         if (!mScene)
             return;
 
-        bool shouldUpdate = forceUpdate || mDirty || needsUpdate(currentGameHour);
-        if (!shouldUpdate)
-            return;
+        // Render the whole cubemap at once when there is nothing to show yet or it's requested, otherwise spread
+        // the faces over frames in round robin order
+        const bool fullUpdate = forceUpdate || !mRendered;
+        if (fullUpdate)
+            mPendingFaces = sAllFaces;
+        else if (mDirty || needsUpdate(currentGameHour))
+            mPendingFaces |= sSlicedFaces;
+
+        if (mPendingFaces != 0)
+        {
+            mLastUpdateHour = currentGameHour;
+            mDirty = false;
+            mRendered = true;
+        }
 
         // Set node mask based on reflection type
         unsigned int mask = mNodeMask;
         if (!mReflectActors)
             mask &= ~(Mask_Actor | Mask_Player);
 
-        // For dynamic mode, only update subset of faces per frame
-        int startFace = 0;
-        int endFace = 6;
-
-        if (mType == CubemapReflectionType::Dynamic && !forceUpdate && !mDirty)
+        std::array<bool, 6> render{};
+        if (fullUpdate)
+            render.fill(true);
+        else
         {
-            startFace = mCurrentFace;
-            endFace = std::min(mCurrentFace + mFacesPerFrame, 6);
-            mCurrentFace = (mCurrentFace + mFacesPerFrame) % 6;
+            for (int i = 0, count = 0; i < sNumSlicedFaces && count < mFacesPerFrame; ++i)
+            {
+                const int face = (mCurrentFace + i) % sNumSlicedFaces;
+                if (mPendingFaces & (1 << face))
+                {
+                    render[face] = true;
+                    ++count;
+                    mCurrentFace = (face + 1) % sNumSlicedFaces;
+                }
+            }
         }
 
-        for (int face = startFace; face < endFace; ++face)
+        for (int face = 0; face < 6; ++face)
         {
-            if (mCameras[face])
+            if (!mCameras[face])
+                continue;
+            if (!render[face])
             {
-                mCameras[face]->setViewMatrix(computeFaceMatrix(face));
-                mCameras[face]->setCullMask(mask);
-                mCameras[face]->setNodeMask(Mask_RenderToTexture);
+                mCameras[face]->setNodeMask(0);
+                continue;
             }
+            mCameras[face]->setViewMatrix(computeFaceMatrix(face));
+            mCameras[face]->setCullMask(mask);
+            mCameras[face]->setNodeMask(Mask_RenderToTexture);
+            mPendingFaces &= ~(1 << face);
         }
-
-        // Hide other faces this frame
-        for (int face = 0; face < startFace; ++face)
-            mCameras[face]->setNodeMask(0);
-        for (int face = endFace; face < 6; ++face)
-            mCameras[face]->setNodeMask(0);
-
-        mLastUpdateHour = currentGameHour;
-        mDirty = false;
     }
 
     std::unique_ptr<CubemapReflection> createCubemapReflection(
@@ -8,6 +8,7 @@
 #include <osg/ref_ptr>
 
 #include <array>
+#include <cstdint>
 #include <memory>
 
 namespace osg
@@ -38,6 +39,8 @@ namespace MWRender
             int cubemapSize, CubemapReflectionType type, float reflectionDistance);
         ~CubemapReflection();
 
+        void traverse(osg::NodeVisitor& nv) override;
+
         /// Get the cubemap texture for use in water shaders
         osg::TextureCubeMap* getCubemapTexture() { return mCubemap.get(); }
 
@@ -86,9 +89,10 @@ namespace MWRender
         unsigned int mNodeMask;
         bool mReflectActors;
         bool mDirty;
+        bool mRendered;
 
-        // Face update scheduling for dynamic mode
-        // Only update 1-2 faces per frame to spread load
+        // Face update scheduling, only a few faces are rendered per frame to spread the load
+        std::uint8_t mPendingFaces;
         int mCurrentFace;
         int mFacesPerFrame;
     };
@@ -1,11 +1,15 @@
 #include "effectmanager.hpp"
 
 #include <osg/PositionAttitudeTransform>
+#include <osg/Stats>
+
+#include <osgParticle/ParticleSystem>
 
 #include <components/resource/resourcesystem.hpp>
 #include <components/resource/scenemanager.hpp>
 
 #include <components/sceneutil/controller.hpp>
+#include <components/settings/values.hpp>
 
 #include "animation.hpp"
 #include "util.hpp"
@@ -15,9 +19,29 @@
 
 namespace MWRender
 {
+    namespace
+    {
+        // Particles of the previous play would otherwise show up at the old position of a reused effect
+        class KillParticlesVisitor : public osg::NodeVisitor
+        {
+        public:
+            KillParticlesVisitor()
+                : osg::NodeVisitor(TRAVERSE_ALL_CHILDREN)
+            {
+            }
+
+            void apply(osg::Drawable& drawable) override
+            {
+                if (osgParticle::ParticleSystem* const system = dynamic_cast<osgParticle::ParticleSystem*>(&drawable))
+                    for (int i = 0; i < system->numParticles(); ++i)
+                        system->getParticle(i)->kill();
+            }
+        };
+    }
 
     EffectManager::EffectManager(osg::ref_ptr<osg::Group> parent, Resource::ResourceSystem* resourceSystem)
-        : mParentNode(std::move(parent))
+        : mPoolCapacity(static_cast<std::size_t>(Settings::cells().mEffectPoolSize))
+        , mParentNode(std::move(parent))
         , mResourceSystem(resourceSystem)
     {
     }
@@ -30,11 +54,34 @@ namespace MWRender
     void EffectManager::addEffect(VFS::Path::NormalizedView model, std::string_view textureOverride,
         const osg::Vec3f& worldPosition, float scale, bool isMagicVFX, bool useAmbientLight)
     {
+        Key key(model, textureOverride, isMagicVFX, useAmbientLight);
+
+        if (const auto it = mPool.find(key); it != mPool.end() && !it->second.empty())
+        {
+            Effect effect = std::move(it->second.back());
+            it->second.pop_back();
+            --mPoolSize;
+            ++mPoolHits;
+
+            effect.mAnimTime->resetTime(0);
+            KillParticlesVisitor killParticlesVisitor;
+            effect.mTransform->accept(killParticlesVisitor);
+            effect.mTransform->setPosition(worldPosition);
+            effect.mTransform->setScale(osg::Vec3f(scale, scale, scale));
+
+            mParentNode->addChild(effect.mTransform);
+            mEffects.push_back(std::move(effect));
+            return;
+        }
+
+        ++mPoolMisses;
+
         osg::ref_ptr<osg::Node> node = mResourceSystem->getSceneManager()->getInstance(model);
 
         node->setNodeMask(Mask_Effect);
 
         Effect effect;
+        effect.mKey = std::move(key);
         effect.mAnimTime = std::make_shared<EffectAnimationTime>();
 
         SceneUtil::FindMaxControllerLengthVisitor findMaxLengthVisitor;
@@ -72,15 +119,17 @@ namespace MWRender
 
     void EffectManager::update(float dt)
     {
-        mEffects.erase(std::remove_if(mEffects.begin(), mEffects.end(),
-                           [dt, this](Effect& effect) {
-                               effect.mAnimTime->addTime(dt);
-                               const auto remove = effect.mAnimTime->getTime() >= effect.mMaxControllerLength;
-                               if (remove)
-                                   mParentNode->removeChild(effect.mTransform);
-                               return remove;
-                           }),
-            mEffects.end());
+        mPoolHits = 0;
+        mPoolMisses = 0;
+
+        std::erase_if(mEffects, [dt, this](Effect& effect) {
+            effect.mAnimTime->addTime(dt);
+            if (effect.mAnimTime->getTime() < effect.mMaxControllerLength)
+                return false;
+            mParentNode->removeChild(effect.mTransform);
+            release(std::move(effect));
+            return true;
+        });
     }
 
     void EffectManager::clear()
@@ -90,6 +139,24 @@ namespace MWRender
             mParentNode->removeChild(effect.mTransform);
         }
         mEffects.clear();
+        mPool.clear();
+        mPoolSize = 0;
+    }
+
+    void EffectManager::reportStats(unsigned int frameNumber, osg::Stats& stats) const
+    {
+        stats.setAttribute(frameNumber, "Effect Pool Size", static_cast<double>(mPoolSize));
+        stats.setAttribute(frameNumber, "Effect Pool Hits", static_cast<double>(mPoolHits));
+        stats.setAttribute(frameNumber, "Effect Pool Misses", static_cast<double>(mPoolMisses));
+    }
+
+    void EffectManager::release(Effect&& effect)
+    {
+        std::vector<Effect>& pooled = mPool[effect.mKey];
+        if (pooled.size() >= mPoolCapacity)
+            return;
+        pooled.push_back(std::move(effect));
+        ++mPoolSize;
     }
 
 }
@@ -1,7 +1,11 @@
 #ifndef OPENMW_MWRENDER_EFFECTMANAGER_H
 #define OPENMW_MWRENDER_EFFECTMANAGER_H
 
+#include <cstddef>
+#include <map>
 #include <memory>
+#include <string>
+#include <tuple>
 #include <vector>
 
 #include <osg/ref_ptr>
@@ -13,6 +17,7 @@ namespace osg
     class Group;
     class Vec3f;
     class PositionAttitudeTransform;
+    class Stats;
 }
 
 namespace Resource
@@ -42,15 +47,29 @@ namespace MWRender
         /// Remove all effects
         void clear();
 
+        void reportStats(unsigned int frameNumber, osg::Stats& stats) const;
+
     private:
+        // Model, texture override, magic VFX and ambient light, everything the instance is set up with
+        using Key = std::tuple<VFS::Path::Normalized, std::string, bool, bool>;
+
         struct Effect
         {
             float mMaxControllerLength;
             std::shared_ptr<EffectAnimationTime> mAnimTime;
             osg::ref_ptr<osg::PositionAttitudeTransform> mTransform;
+            Key mKey;
         };
 
         std::vector<Effect> mEffects;
+        // Instances of finished effects to play the same effect again without cloning the model
+        std::map<Key, std::vector<Effect>, std::less<>> mPool;
+        std::size_t mPoolCapacity;
+        std::size_t mPoolSize = 0;
+        std::size_t mPoolHits = 0;
+        std::size_t mPoolMisses = 0;
+
+        void release(Effect&& effect);
 
         osg::ref_ptr<osg::Group> mParentNode;
         Resource::ResourceSystem* mResourceSystem;
@@ -3,6 +3,7 @@
 #include <osg/Camera>
 #include <osg/ComputeBoundsVisitor>
 
+#include <components/misc/framearena.hpp>
 #include <components/settings/values.hpp>
 
 #include <algorithm>
@@ -74,7 +75,8 @@ namespace MWRender
         mStats.priorityEntities = 0;
 
         // First pass: update all entity data
-        std::vector<std::pair<const MWWorld::Ptr*, EntityData*>> sortedEntities;
+        auto sortedEntities
+            = Misc::makeFrameVector<std::pair<const MWWorld::Ptr*, EntityData*>>(Misc::FrameArenaUser::Rendering);
         sortedEntities.reserve(mEntities.size());
 
         for (auto& pair : mEntities)
@@ -280,7 +282,8 @@ namespace MWRender
 
     std::vector<const MWWorld::Ptr*> EntityPriorityManager::getSortedEntities() const
     {
-        std::vector<std::pair<const MWWorld::Ptr*, int>> sorted(mPriorities.begin(), mPriorities.end());
+        Misc::FrameVector<std::pair<const MWWorld::Ptr*, int>> sorted(
+            mPriorities.begin(), mPriorities.end(), Misc::getFrameArena(Misc::FrameArenaUser::Rendering));
         std::sort(sorted.begin(), sorted.end(),
             [](const auto& a, const auto& b) { return a.second > b.second; });
 
@@ -11,6 +11,12 @@
 
 namespace MWRender
 {
+    namespace
+    {
+        // Distance to the target in skeleton units at which a chain counts as solved
+        constexpr float sIKTolerance = 0.1f;
+    }
+
     // ======================== SpringConstraint ========================
 
     void SpringConstraint::update(float dt)
@@ -80,6 +86,7 @@ namespace MWRender
         leftLeg.rootBone = "Bip01 L Thigh";
         leftLeg.endBone = "Bip01 L Foot";
         leftLeg.intermediateBones = { "Bip01 L Calf" };
+        leftLeg.detail = IKDetail::Feet;
         addChain(leftLeg);
 
         // Right leg chain
@@ -87,6 +94,7 @@ namespace MWRender
         rightLeg.rootBone = "Bip01 R Thigh";
         rightLeg.endBone = "Bip01 R Foot";
         rightLeg.intermediateBones = { "Bip01 R Calf" };
+        rightLeg.detail = IKDetail::Feet;
         addChain(rightLeg);
 
         // Spine chain for looking/leaning
@@ -117,86 +125,127 @@ namespace MWRender
         return mEnabled && !mTargets.empty();
     }
 
-    void FullBodyIK::solve(float dt)
+    void FullBodyIK::solve(float dt, IKDetail detail)
     {
         if (!mEnabled || !mSkeleton || mTargets.empty())
             return;
 
         mSolvedRotations.clear();
 
+        if (detail == IKDetail::None)
+            return;
+
+        const int iterations = getMaxIterations(detail);
         for (auto& [chainName, target] : mTargets)
         {
             auto chainIt = mChains.find(chainName);
-            if (chainIt != mChains.end())
-            {
-                solveFABRIK(chainIt->second, target);
-            }
+            if (chainIt == mChains.end())
+                continue;
+            IKChain& chain = chainIt->second;
+            // A skipped chain follows the animation, don't start from a stale solution once it is solved again
+            if (chain.detail > detail)
+                chain.solvedOffsets.clear();
+            else
+                solveFABRIK(chain, target, iterations);
         }
     }
 
-    void FullBodyIK::solveFABRIK(IKChain& chain, const IKTarget& target, int iterations)
+    int FullBodyIK::getMaxIterations(IKDetail detail)
     {
-        // Simplified FABRIK algorithm
-        // In a full implementation, this would iterate forward and backward through the chain
+        switch (detail)
+        {
+            case IKDetail::None:
+                return 0;
+            case IKDetail::Feet:
+                return 4;
+            case IKDetail::Full:
+                return 10;
+        }
+        return 0;
+    }
 
+    void FullBodyIK::solveFABRIK(IKChain& chain, const IKTarget& target, int iterations)
+    {
         if (chain.intermediateBones.empty())
             return;
 
-        // Get current bone positions
-        std::vector<osg::Vec3f> positions;
-        std::vector<float> lengths;
+        // Bone lengths are taken from the current pose
+        std::vector<osg::Vec3f>& positions = mPositions;
+        std::vector<float>& lengths = mLengths;
+        positions.clear();
+        lengths.clear();
 
-        osg::Matrix rootTransform = getBoneWorldTransform(chain.rootBone);
-        positions.push_back(rootTransform.getTrans());
+        const osg::Vec3f rootPos = getBoneWorldTransform(chain.rootBone).getTrans();
+        positions.push_back(rootPos);
 
         for (const auto& bone : chain.intermediateBones)
         {
-            osg::Matrix transform = getBoneWorldTransform(bone);
-            osg::Vec3f pos = transform.getTrans();
-            if (!positions.empty())
-                lengths.push_back((pos - positions.back()).length());
+            const osg::Vec3f pos = getBoneWorldTransform(bone).getTrans();
+            lengths.push_back((pos - positions.back()).length());
             positions.push_back(pos);
         }
 
-        osg::Matrix endTransform = getBoneWorldTransform(chain.endBone);
-        positions.push_back(endTransform.getTrans());
-        if (!positions.empty() && positions.size() > 1)
-            lengths.push_back((endTransform.getTrans() - positions[positions.size() - 2]).length());
+        const osg::Vec3f endPos = getBoneWorldTransform(chain.endBone).getTrans();
+        lengths.push_back((endPos - positions.back()).length());
+        positions.push_back(endPos);
 
-        if (positions.size() < 2)
-            return;
+        const osg::Vec3f targetPos = target.position;
 
-        osg::Vec3f targetPos = target.position;
+        float chainLength = 0.0f;
+        for (float length : lengths)
+            chainLength += length;
+        chain.totalLength = chainLength;
 
-        // FABRIK iterations
-        for (int iter = 0; iter < iterations; ++iter)
+        if ((targetPos - rootPos).length() >= chainLength)
+        {
+            // Out of reach, stretch the chain towards the target
+            osg::Vec3f dir = targetPos - rootPos;
+            dir.normalize();
+            for (size_t i = 1; i < positions.size(); ++i)
+                positions[i] = positions[i - 1] + dir * lengths[i - 1];
+        }
+        else
         {
-            // Backward pass
-            positions.back() = targetPos;
-            for (int i = static_cast<int>(positions.size()) - 2; i >= 0; --i)
+            // Start from the last solution, the target usually moves little between frames
+            if (chain.solvedOffsets.size() == positions.size())
             {
-                osg::Vec3f dir = positions[i] - positions[i + 1];
-                dir.normalize();
-                positions[i] = positions[i + 1] + dir * lengths[i];
+                for (size_t i = 1; i < positions.size(); ++i)
+                    positions[i] = rootPos + chain.solvedOffsets[i];
             }
 
-            // Forward pass
-            positions[0] = rootTransform.getTrans();
-            for (size_t i = 1; i < positions.size(); ++i)
+            const float tolerance2 = sIKTolerance * sIKTolerance;
+            for (int iter = 0; iter < iterations && (positions.back() - targetPos).length2() > tolerance2; ++iter)
             {
-                osg::Vec3f dir = positions[i] - positions[i - 1];
-                dir.normalize();
-                positions[i] = positions[i - 1] + dir * lengths[i - 1];
+                // Backward pass
+                positions.back() = targetPos;
+                for (int i = static_cast<int>(positions.size()) - 2; i >= 0; --i)
+                {
+                    osg::Vec3f dir = positions[i] - positions[i + 1];
+                    dir.normalize();
+                    positions[i] = positions[i + 1] + dir * lengths[i];
+                }
+
+                // Forward pass
+                positions[0] = rootPos;
+                for (size_t i = 1; i < positions.size(); ++i)
+                {
+                    osg::Vec3f dir = positions[i] - positions[i - 1];
+                    dir.normalize();
+                    positions[i] = positions[i - 1] + dir * lengths[i - 1];
+                }
             }
         }
 
+        chain.solvedOffsets.resize(positions.size());
+        for (size_t i = 0; i < positions.size(); ++i)
+            chain.solvedOffsets[i] = positions[i] - rootPos;
+
         // Calculate rotations from solved positions
         // Simplified - just calculate the direction each bone should point
-        std::vector<std::string> allBones = { chain.rootBone };
-        allBones.insert(allBones.end(), chain.intermediateBones.begin(), chain.intermediateBones.end());
-
-        for (size_t i = 0; i < allBones.size() && i + 1 < positions.size(); ++i)
+        for (size_t i = 0; i + 1 < positions.size(); ++i)
         {
+            const std::string& boneName = i == 0 ? chain.rootBone : chain.intermediateBones[i - 1];
+
             osg::Vec3f direction = positions[i + 1] - positions[i];
             direction.normalize();
 
@@ -205,12 +254,12 @@ namespace MWRender
             rotation.makeRotate(osg::Vec3f(0, 1, 0), direction); // Assuming bones point along Y
 
             // Blend with original animation
-            osg::Matrix origTransform = getBoneWorldTransform(allBones[i]);
+            osg::Matrix origTransform = getBoneWorldTransform(boneName);
             osg::Quat origRotation = origTransform.getRotate();
             osg::Quat blendedRotation;
             blendedRotation.slerp(target.weight, origRotation, rotation);
 
-            mSolvedRotations[allBones[i]] = blendedRotation;
+            mSolvedRotations[boneName] = blendedRotation;
         }
     }
 
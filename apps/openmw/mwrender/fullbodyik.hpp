@@ -12,6 +12,8 @@
 #include <string>
 #include <vector>
 
+#include "animationlod.hpp"
+
 namespace osg
 {
     class Node;
@@ -31,6 +33,10 @@ namespace MWRender
         std::string endBone;
         std::vector<std::string> intermediateBones;
         float totalLength = 0.0f;
+        // Lowest IK detail the chain is solved at
+        IKDetail detail = IKDetail::Full;
+        // Joint positions of the last solution relative to the root, the next solve starts from them
+        std::vector<osg::Vec3f> solvedOffsets;
 
         // Constraints per joint
         struct JointConstraint
@@ -70,6 +76,8 @@ namespace MWRender
 
     /// Full Body Inverse Kinematics system
     /// Provides procedural animation for natural-looking limb placement
+    /// A solve only touches the instance and the skeleton it was initialized with, so the solves of different actors
+    /// can run on worker threads.
     class FullBodyIK
     {
     public:
@@ -89,7 +97,8 @@ namespace MWRender
         void addChain(const IKChain& chain);
 
         /// Update IK solution
-        void solve(float dt);
+        /// @param detail the chains to solve, see AnimationLOD::getIKDetail
+        void solve(float dt, IKDetail detail = IKDetail::Full);
 
         /// Get solved bone rotation
         bool getBoneRotation(const std::string& boneName, osg::Quat& rotation) const;
@@ -106,7 +115,9 @@ namespace MWRender
 
     private:
         // FABRIK (Forward And Backward Reaching Inverse Kinematics) solver
-        void solveFABRIK(IKChain& chain, const IKTarget& target, int iterations = 10);
+        void solveFABRIK(IKChain& chain, const IKTarget& target, int iterations);
+
+        static int getMaxIterations(IKDetail detail);
 
         // Get bone transform in world space
         osg::Matrix getBoneWorldTransform(const std::string& boneName) const;
@@ -118,6 +129,8 @@ namespace MWRender
         std::map<std::string, IKChain> mChains;
         std::map<std::string, IKTarget> mTargets;
         std::map<std::string, osg::Quat> mSolvedRotations;
+        std::vector<osg::Vec3f> mPositions;
+        std::vector<float> mLengths;
         bool mEnabled;
     };
 
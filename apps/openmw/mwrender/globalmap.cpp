@@ -97,6 +97,10 @@ namespace
         MWRender::GlobalMap* mParent;
     };
 
+    // Every explored cell is drawn by its own RTT camera and copied back to the CPU, spread them over frames when
+    // many cells are explored at once
+    constexpr std::size_t sMaxExploredCellsPerFrame = 4;
+
     std::vector<char> writePng(const osg::Image& overlayImage)
     {
         std::ostringstream ostream;
@@ -404,16 +408,34 @@ namespace MWRender
         if (!localMapTexture)
             return;
 
-        const int cellSize = Settings::map().mGlobalMapCellSize;
-        const int originX = (cellX - mMinX) * cellSize;
-        // +1 because we want the top left corner of the cell, not the bottom left
-        const int originY = (cellY - mMinY + 1) * cellSize;
-
         if (cellX > mMaxX || cellX < mMinX || cellY > mMaxY || cellY < mMinY)
             return;
 
-        requestOverlayTextureUpdate(
-            originX, mHeight - originY, cellSize, cellSize, std::move(localMapTexture), false, true);
+        mPendingExploredCells[{ cellX, cellY }] = std::move(localMapTexture);
+    }
+
+    void GlobalMap::updateExploredCells()
+    {
+        cleanupCameras();
+
+        if (mPendingExploredCells.empty())
+            return;
+
+        ensureLoaded();
+
+        const int cellSize = Settings::map().mGlobalMapCellSize;
+        std::size_t count = 0;
+        for (auto it = mPendingExploredCells.begin();
+             it != mPendingExploredCells.end() && count < sMaxExploredCellsPerFrame; ++count)
+        {
+            const auto [cellX, cellY] = it->first;
+            const int originX = (cellX - mMinX) * cellSize;
+            // +1 because we want the top left corner of the cell, not the bottom left
+            const int originY = (cellY - mMinY + 1) * cellSize;
+            requestOverlayTextureUpdate(
+                originX, mHeight - originY, cellSize, cellSize, std::move(it->second), false, true);
+            it = mPendingExploredCells.erase(it);
+        }
     }
 
     void GlobalMap::clear()
@@ -423,6 +445,7 @@ namespace MWRender
         memset(mOverlayImage->data(), 0, mOverlayImage->getTotalSizeInBytes());
 
         mPendingImageDest.clear();
+        mPendingExploredCells.clear();
 
         // just push a Camera to clear the FBO, instead of setImage()/dirty()
         // easier, since we don't need to worry about synchronizing access :)
@@ -43,8 +43,14 @@ namespace MWRender
 
         void worldPosToImageSpace(float x, float z, float& imageX, float& imageY);
 
+        /// Queue drawing the local map of the cell onto the overlay, see updateExploredCells.
+        /// @note Exploring the same cell again before it's drawn replaces the queued texture.
         void exploreCell(int cellX, int cellY, osg::ref_ptr<osg::Texture2D> localMapTexture);
 
+        /// Remove the cameras already rendered and draw a limited number of the queued explored cells.
+        /// Should be called every frame.
+        void updateExploredCells();
+
         /// Clears the overlay
         void clear();
 
@@ -111,6 +117,8 @@ namespace MWRender
 
         ImageDestMap mPendingImageDest;
 
+        std::map<std::pair<int, int>, osg::ref_ptr<osg::Texture2D>> mPendingExploredCells;
+
         osg::ref_ptr<osg::Texture2D> mBaseTexture;
         osg::ref_ptr<osg::Texture2D> mAlphaTexture;
 
@@ -0,0 +1,124 @@
+#include "gpuprecipitation.hpp"
+
+#include <cmath>
+
+#include <osg/Program>
+#include <osg/Texture>
+#include <osg/VertexAttribDivisor>
+
+#include <components/misc/rng.hpp>
+#include <components/resource/scenemanager.hpp>
+#include <components/shader/shadermanager.hpp>
+#include <components/stereo/stereomanager.hpp>
+
+namespace MWRender
+{
+    namespace
+    {
+        constexpr unsigned dropSeedAttribLocation = 6;
+
+        constexpr float dropWidth = 1.f;
+        constexpr float dropLength = 10.f;
+
+        float wrap(float value, float range)
+        {
+            if (range <= 0)
+                return 0;
+            value = std::fmod(value, range);
+            return value < 0 ? value + range : value;
+        }
+    }
+
+    GpuPrecipitation::GpuPrecipitation(Resource::SceneManager& sceneManager, osg::Texture* texture, bool occlusion)
+        : mGeometry(new osg::Geometry)
+        , mSeeds(new osg::Vec3Array)
+        , mOffsetUniform(new osg::Uniform("precipitationOffset", osg::Vec3f()))
+        , mRangeUniform(new osg::Uniform("precipitationRange", mRange))
+        , mCameraPositionUniform(new osg::Uniform("precipitationCameraPosition", osg::Vec3f()))
+        , mVelocityUniform(new osg::Uniform("precipitationVelocity", osg::Vec3f(0, 0, -1)))
+        , mAlphaUniform(new osg::Uniform("precipitationAlpha", 0.f))
+    {
+        osg::ref_ptr<osg::Vec3Array> vertices = new osg::Vec3Array;
+        osg::ref_ptr<osg::Vec2Array> texCoords = new osg::Vec2Array;
+        for (const osg::Vec2f corner : { osg::Vec2f(0, 0), osg::Vec2f(1, 0), osg::Vec2f(0, 1), osg::Vec2f(1, 1) })
+        {
+            vertices->push_back(osg::Vec3f(corner.x() - 0.5f, corner.y(), 0));
+            texCoords->push_back(corner);
+        }
+
+        mGeometry->setVertexArray(vertices);
+        mGeometry->setTexCoordArray(0, texCoords, osg::Array::BIND_PER_VERTEX);
+        mGeometry->setVertexAttribArray(dropSeedAttribLocation, mSeeds, osg::Array::BIND_PER_VERTEX);
+        mGeometry->addPrimitiveSet(new osg::DrawArrays(GL_TRIANGLE_STRIP, 0, 4, 0));
+
+        // Display lists do not support instancing in OSG 3.4
+        mGeometry->setUseDisplayList(false);
+        mGeometry->setUseVertexBufferObjects(true);
+        mGeometry->setDataVariance(osg::Object::DYNAMIC);
+        // Drops are placed around the camera by the vertex shader, the bounds of the quad are meaningless
+        mGeometry->setCullingActive(false);
+
+        osg::StateSet* stateset = mGeometry->getOrCreateStateSet();
+
+        Shader::ShaderManager::DefineMap defines = { { "particleOcclusion", occlusion ? "1" : "0" } };
+        Stereo::shaderStereoDefines(defines);
+        osg::ref_ptr<osg::Program> program = sceneManager.getShaderManager().getProgram("gpuprecipitation", defines);
+        program->addBindAttribLocation("dropSeed", dropSeedAttribLocation);
+        stateset->setAttributeAndModes(program, osg::StateAttribute::ON | osg::StateAttribute::PROTECTED);
+        stateset->setAttribute(new osg::VertexAttribDivisor(dropSeedAttribLocation, 1));
+
+        stateset->setTextureAttributeAndModes(0, texture);
+        stateset->addUniform(new osg::Uniform("diffuseMap", 0));
+        stateset->addUniform(new osg::Uniform("dropSize", osg::Vec2f(dropWidth, dropLength)));
+        stateset->addUniform(mOffsetUniform);
+        stateset->addUniform(mRangeUniform);
+        stateset->addUniform(mCameraPositionUniform);
+        stateset->addUniform(mVelocityUniform);
+        stateset->addUniform(mAlphaUniform);
+    }
+
+    void GpuPrecipitation::setDropCount(unsigned count)
+    {
+        if (count > mSeeds->size())
+        {
+            mSeeds->reserve(count);
+            while (mSeeds->size() < count)
+                mSeeds->push_back(osg::Vec3f(Misc::Rng::rollProbability(), Misc::Rng::rollProbability(),
+                    Misc::Rng::rollProbability()));
+            mSeeds->dirty();
+        }
+
+        mGeometry->getPrimitiveSet(0)->setNumInstances(static_cast<int>(count));
+    }
+
+    void GpuPrecipitation::setRange(const osg::Vec3f& range)
+    {
+        if (range == mRange)
+            return;
+        mRange = range;
+        mRangeUniform->set(range);
+        mGeometry->setInitialBound(osg::BoundingBox(-range / 2, range / 2));
+    }
+
+    void GpuPrecipitation::setVelocity(const osg::Vec3f& velocity)
+    {
+        mVelocity = velocity;
+        mVelocityUniform->set(velocity);
+    }
+
+    void GpuPrecipitation::update(float duration, float alpha, const osg::Vec3f& cameraPosition)
+    {
+        if (!mFrozen)
+        {
+            const osg::Vec3f offset = mOffset + mVelocity * duration;
+            mOffset = osg::Vec3f(
+                wrap(offset.x(), mRange.x()), wrap(offset.y(), mRange.y()), wrap(offset.z(), mRange.z()));
+            mOffsetUniform->set(mOffset);
+        }
+
+        // Only the position inside the range matters, wrap to keep the precision far from the origin
+        mCameraPositionUniform->set(osg::Vec3f(wrap(cameraPosition.x(), mRange.x()),
+            wrap(cameraPosition.y(), mRange.y()), wrap(cameraPosition.z(), mRange.z())));
+        mAlphaUniform->set(alpha);
+    }
+}
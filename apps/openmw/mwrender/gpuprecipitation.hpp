@@ -0,0 +1,53 @@
+#ifndef OPENMW_MWRENDER_GPUPRECIPITATION_H
+#define OPENMW_MWRENDER_GPUPRECIPITATION_H
+
+#include <osg/Geometry>
+#include <osg/Uniform>
+#include <osg/ref_ptr>
+
+namespace Resource
+{
+    class SceneManager;
+}
+
+namespace MWRender
+{
+    /// @brief Rain drawn as a single instanced quad, every instance is a drop.
+    /// @par Drop positions are computed in the vertex shader from a per instance seed and the accumulated movement,
+    /// wrapped into a box around the camera, so there is no per particle state on the CPU. When precipitation occlusion
+    /// is enabled occluded fragments are discarded the same way as for the particle system rain.
+    /// @note Must be attached to a child of CameraRelativeTransform.
+    class GpuPrecipitation
+    {
+    public:
+        GpuPrecipitation(Resource::SceneManager& sceneManager, osg::Texture* texture, bool occlusion);
+
+        osg::Node* getNode() const { return mGeometry; }
+
+        void setDropCount(unsigned count);
+
+        void setRange(const osg::Vec3f& range);
+
+        void setVelocity(const osg::Vec3f& velocity);
+
+        void setFrozen(bool frozen) { mFrozen = frozen; }
+
+        void update(float duration, float alpha, const osg::Vec3f& cameraPosition);
+
+    private:
+        osg::ref_ptr<osg::Geometry> mGeometry;
+        osg::ref_ptr<osg::Vec3Array> mSeeds;
+        osg::ref_ptr<osg::Uniform> mOffsetUniform;
+        osg::ref_ptr<osg::Uniform> mRangeUniform;
+        osg::ref_ptr<osg::Uniform> mCameraPositionUniform;
+        osg::ref_ptr<osg::Uniform> mVelocityUniform;
+        osg::ref_ptr<osg::Uniform> mAlphaUniform;
+        osg::Vec3f mRange{ 1, 1, 1 };
+        osg::Vec3f mVelocity;
+        // Distance travelled by the drops wrapped into the range to keep precision
+        osg::Vec3f mOffset;
+        bool mFrozen = false;
+    };
+}
+
+#endif
@@ -1,6 +1,9 @@
 #include "grassinteraction.hpp"
 
 #include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <memory>
 
 #include <osg/StateSet>
 #include <osg/Uniform>
@@ -12,31 +15,51 @@
 namespace
 {
     std::unique_ptr<MWRender::GrassInteractionSystem> sGrassInteractionSystem;
+
+    int toTexel(float coordinate)
+    {
+        return static_cast<int>(std::floor(coordinate / MWRender::GrassInteractionSystem::TEXEL_SIZE));
+    }
+
+    unsigned char encode(float value)
+    {
+        return static_cast<unsigned char>(std::clamp(std::lround((value * 0.5f + 0.5f) * 255.f), 0L, 255L));
+    }
 }
 
 namespace MWRender
 {
     GrassInteractionSystem::GrassInteractionSystem()
-        : mInteractionRadius(Settings::game().mGrassInteractionRadius)
+        : mDisplacement(TEXTURE_SIZE * TEXTURE_SIZE)
+        , mOriginX(0)
+        , mOriginY(0)
+        , mHasDisplacement(false)
+        , mImage(new osg::Image)
+        , mTexture(new osg::Texture2D)
+        , mTextureUnit(-1)
+        , mInteractionRadius(Settings::game().mGrassInteractionRadius)
         , mBendIntensity(Settings::game().mGrassBendIntensity)
         , mRecoverySpeed(Settings::game().mGrassRecoverySpeed)
         , mCurrentTime(0.0f)
         , mEnabled(Settings::game().mGrassInteraction)
     {
-        // Create uniforms for shader communication
-        // Each interaction point is packed as vec4: xyz = position, w = intensity
-        // Plus vec4 for velocity: xyz = velocity, w = radius
-        mInteractionPointsUniform = new osg::Uniform(osg::Uniform::FLOAT_VEC4, "grassInteractionPoints",
-            MAX_INTERACTION_POINTS * 2);
-        mInteractionCountUniform = new osg::Uniform("grassInteractionCount", 0);
+        // Luminance holds the displacement along x, alpha along y, both mapped from [-1, 1] to [0, 1]
+        mImage->allocateImage(TEXTURE_SIZE, TEXTURE_SIZE, 1, GL_LUMINANCE_ALPHA, GL_UNSIGNED_BYTE);
+        mImage->setInternalTextureFormat(GL_LUMINANCE8_ALPHA8);
+        updateImage();
+
+        mTexture->setImage(mImage);
+        mTexture->setDataVariance(osg::Object::DYNAMIC);
+        mTexture->setFilter(osg::Texture::MIN_FILTER, osg::Texture::LINEAR);
+        mTexture->setFilter(osg::Texture::MAG_FILTER, osg::Texture::LINEAR);
+        // World positions are used as texture coordinates, the window around the player wraps around the texture
+        mTexture->setWrap(osg::Texture::WRAP_S, osg::Texture::REPEAT);
+        mTexture->setWrap(osg::Texture::WRAP_T, osg::Texture::REPEAT);
+        mTexture->setResizeNonPowerOfTwoHint(false);
+
+        // xy = centre of the window, z = 1 / covered world size, w = maximum displacement
         mInteractionParamsUniform = new osg::Uniform("grassInteractionParams",
-            osg::Vec4f(mInteractionRadius, mBendIntensity, mRecoverySpeed, 0.0f));
-
-        // Initialize uniform array
-        for (int i = 0; i < MAX_INTERACTION_POINTS * 2; ++i)
-        {
-            mInteractionPointsUniform->setElement(i, osg::Vec4f(0, 0, 0, 0));
-        }
+            osg::Vec4f(0.f, 0.f, 1.f / (TEXTURE_SIZE * TEXEL_SIZE), MAX_DISPLACEMENT));
     }
 
     GrassInteractionSystem::~GrassInteractionSystem() = default;
@@ -62,120 +85,157 @@ namespace MWRender
         if (actor.isEmpty())
             return;
 
-        unsigned int actorKey = actor.getCellRef().getRefNum().mIndex;
-        auto it = mActorInteractions.find(actorKey);
-        if (it != mActorInteractions.end())
-        {
-            // Move to decaying list for smooth recovery
-            GrassInteractionPoint decaying = it->second;
-            decaying.velocity = osg::Vec3f(0, 0, 0);
-            mDecayingInteractions.push_back(decaying);
-            mActorInteractions.erase(it);
-        }
+        mActorInteractions.erase(actor.getCellRef().getRefNum().mIndex);
     }
 
-    void GrassInteractionSystem::update(float dt)
+    void GrassInteractionSystem::update(float dt, const osg::Vec3f& playerPos)
     {
-        if (!mEnabled)
-            return;
+        const bool hadDisplacement = mHasDisplacement;
 
-        mCurrentTime += dt;
-
-        // Update decaying interactions
-        for (auto it = mDecayingInteractions.begin(); it != mDecayingInteractions.end();)
+        if (!mEnabled)
         {
-            it->intensity -= mRecoverySpeed * dt;
-            if (it->intensity <= 0.0f)
+            if (hadDisplacement)
             {
-                it = mDecayingInteractions.erase(it);
-            }
-            else
-            {
-                ++it;
+                clear();
+                updateImage();
             }
+            return;
         }
 
+        mCurrentTime += dt;
+
         // Prune old active interactions (actors that haven't been updated)
         pruneOldInteractions(mCurrentTime);
 
-        // Update shader uniforms
-        updateUniforms();
+        scroll(toTexel(playerPos.x()) - TEXTURE_SIZE / 2, toTexel(playerPos.y()) - TEXTURE_SIZE / 2);
+
+        if (mHasDisplacement)
+            fade(mRecoverySpeed * dt);
+
+        for (const auto& [key, point] : mActorInteractions)
+            splat(point);
+
+        if (hadDisplacement || mHasDisplacement)
+            updateImage();
+
+        const float centreOffset = TEXTURE_SIZE / 2 * TEXEL_SIZE;
+        mInteractionParamsUniform->set(osg::Vec4f(mOriginX * TEXEL_SIZE + centreOffset,
+            mOriginY * TEXEL_SIZE + centreOffset, 1.f / (TEXTURE_SIZE * TEXEL_SIZE), MAX_DISPLACEMENT));
     }
 
     void GrassInteractionSystem::pruneOldInteractions(float currentTime)
     {
         const float maxAge = 0.5f; // Seconds without update before removal
 
-        for (auto it = mActorInteractions.begin(); it != mActorInteractions.end();)
-        {
-            if (currentTime - it->second.timestamp > maxAge)
-            {
-                // Move to decaying
-                GrassInteractionPoint decaying = it->second;
-                decaying.velocity = osg::Vec3f(0, 0, 0);
-                mDecayingInteractions.push_back(decaying);
-                it = mActorInteractions.erase(it);
-            }
-            else
-            {
-                ++it;
-            }
-        }
+        std::erase_if(mActorInteractions,
+            [&](const auto& entry) { return currentTime - entry.second.timestamp > maxAge; });
     }
 
-    void GrassInteractionSystem::updateUniforms()
+    void GrassInteractionSystem::scroll(int originX, int originY)
     {
-        int count = 0;
-        int uniformIndex = 0;
+        const int dx = originX - mOriginX;
+        const int dy = originY - mOriginY;
+        if (dx == 0 && dy == 0)
+            return;
 
-        // Pack active actor interactions
-        for (const auto& [key, point] : mActorInteractions)
+        if (std::abs(dx) >= TEXTURE_SIZE || std::abs(dy) >= TEXTURE_SIZE)
+            clear();
+        else if (mHasDisplacement)
         {
-            if (count >= MAX_INTERACTION_POINTS)
-                break;
+            // The columns and rows leaving the window share their texels with the ones entering it
+            const int leftX = dx > 0 ? mOriginX : originX + TEXTURE_SIZE;
+            for (int x = leftX; x < leftX + std::abs(dx); ++x)
+                for (int y = 0; y < TEXTURE_SIZE; ++y)
+                    getTexel(x, y) = osg::Vec2f();
+
+            const int leftY = dy > 0 ? mOriginY : originY + TEXTURE_SIZE;
+            for (int y = leftY; y < leftY + std::abs(dy); ++y)
+                for (int x = 0; x < TEXTURE_SIZE; ++x)
+                    getTexel(x, y) = osg::Vec2f();
+        }
 
-            // Position + intensity
-            mInteractionPointsUniform->setElement(uniformIndex++,
-                osg::Vec4f(point.position.x(), point.position.y(), point.position.z(), point.intensity));
-            // Velocity + radius
-            mInteractionPointsUniform->setElement(uniformIndex++,
-                osg::Vec4f(point.velocity.x(), point.velocity.y(), point.velocity.z(), point.radius));
+        mOriginX = originX;
+        mOriginY = originY;
+    }
 
-            ++count;
-        }
+    void GrassInteractionSystem::clear()
+    {
+        std::fill(mDisplacement.begin(), mDisplacement.end(), osg::Vec2f());
+        mHasDisplacement = false;
+    }
 
-        // Pack decaying interactions
-        for (const auto& point : mDecayingInteractions)
+    void GrassInteractionSystem::fade(float amount)
+    {
+        mHasDisplacement = false;
+        for (osg::Vec2f& texel : mDisplacement)
         {
-            if (count >= MAX_INTERACTION_POINTS)
-                break;
+            const float length = texel.length();
+            if (length <= amount)
+            {
+                texel = osg::Vec2f();
+                continue;
+            }
+            texel *= (length - amount) / length;
+            mHasDisplacement = true;
+        }
+    }
 
-            mInteractionPointsUniform->setElement(uniformIndex++,
-                osg::Vec4f(point.position.x(), point.position.y(), point.position.z(), point.intensity));
-            mInteractionPointsUniform->setElement(uniformIndex++,
-                osg::Vec4f(point.velocity.x(), point.velocity.y(), point.velocity.z(), point.radius));
+    void GrassInteractionSystem::splat(const GrassInteractionPoint& point)
+    {
+        if (point.radius <= 0.f || point.intensity <= 0.f)
+            return;
+
+        const int minX = std::max(toTexel(point.position.x() - point.radius), mOriginX);
+        const int maxX = std::min(toTexel(point.position.x() + point.radius), mOriginX + TEXTURE_SIZE - 1);
+        const int minY = std::max(toTexel(point.position.y() - point.radius), mOriginY);
+        const int maxY = std::min(toTexel(point.position.y() + point.radius), mOriginY + TEXTURE_SIZE - 1);
 
-            ++count;
+        for (int y = minY; y <= maxY; ++y)
+        {
+            for (int x = minX; x <= maxX; ++x)
+            {
+                const osg::Vec2f offset((x + 0.5f) * TEXEL_SIZE - point.position.x(),
+                    (y + 0.5f) * TEXEL_SIZE - point.position.y());
+                const float distance = offset.length();
+                if (distance >= point.radius || distance <= 0.f)
+                    continue;
+
+                // Bend away from the actor, most strongly right next to it
+                const float strength = std::min(point.intensity * (1.f - distance / point.radius), 1.f);
+                const osg::Vec2f bend = offset * (strength / distance);
+                osg::Vec2f& texel = getTexel(x, y);
+                if (bend.length2() > texel.length2())
+                    texel = bend;
+                mHasDisplacement = true;
+            }
         }
+    }
 
-        // Clear remaining slots
-        while (uniformIndex < MAX_INTERACTION_POINTS * 2)
+    void GrassInteractionSystem::updateImage()
+    {
+        unsigned char* data = mImage->data();
+        for (const osg::Vec2f& texel : mDisplacement)
         {
-            mInteractionPointsUniform->setElement(uniformIndex++, osg::Vec4f(0, 0, 0, 0));
+            *data++ = encode(texel.x());
+            *data++ = encode(texel.y());
         }
+        mImage->dirty();
+    }
 
-        mInteractionCountUniform->set(count);
-        mInteractionParamsUniform->set(
-            osg::Vec4f(mInteractionRadius, mBendIntensity, mRecoverySpeed, mCurrentTime));
+    osg::Vec2f& GrassInteractionSystem::getTexel(int x, int y)
+    {
+        const int column = (x % TEXTURE_SIZE + TEXTURE_SIZE) % TEXTURE_SIZE;
+        const int row = (y % TEXTURE_SIZE + TEXTURE_SIZE) % TEXTURE_SIZE;
+        return mDisplacement[row * TEXTURE_SIZE + column];
     }
 
     void GrassInteractionSystem::applyToStateSet(osg::StateSet* stateSet)
     {
-        if (!stateSet || !mEnabled)
+        if (!stateSet || mTextureUnit < 0)
             return;
 
-        stateSet->addUniform(mInteractionPointsUniform);
-        stateSet->addUniform(mInteractionCountUniform);
+        stateSet->setTextureAttribute(mTextureUnit, mTexture);
+        stateSet->addUniform(new osg::Uniform("grassInteractionMap", mTextureUnit));
         stateSet->addUniform(mInteractionParamsUniform);
     }
 
@@ -1,9 +1,10 @@
 #ifndef OPENMW_MWRENDER_GRASSINTERACTION_H
 #define OPENMW_MWRENDER_GRASSINTERACTION_H
 
-#include <osg/Vec3f>
-#include <osg/Vec4f>
+#include <osg/Image>
 #include <osg/Texture2D>
+#include <osg/Vec2f>
+#include <osg/Vec3f>
 #include <osg/ref_ptr>
 
 #include <map>
@@ -11,7 +12,6 @@
 
 namespace osg
 {
-    class Group;
     class StateSet;
     class Uniform;
 }
@@ -34,12 +34,18 @@ namespace MWRender
     };
 
     /// Grass Interaction System
-    /// Provides GPU-accelerated grass bending based on actor positions
-    /// Uses uniform array for efficiency (avoids texture updates each frame)
+    /// Actors are splatted into a displacement texture centred on the player, groundcover shaders displace grass by
+    /// a single fetch from it, no matter how many actors interact with the grass.
+    /// The texture wraps around: when the player moves only the texels scrolling into the window are cleared.
+    /// Recovery is handled by fading the texels, so grass stays bent for a while after the actor is gone.
     class GrassInteractionSystem
     {
     public:
-        static constexpr int MAX_INTERACTION_POINTS = 16;
+        static constexpr int TEXTURE_SIZE = 128;
+        // World units covered by one texel
+        static constexpr float TEXEL_SIZE = 16.f;
+        // How far fully bent grass is displaced, in world units
+        static constexpr float MAX_DISPLACEMENT = 40.f;
 
         GrassInteractionSystem();
         ~GrassInteractionSystem();
@@ -47,20 +53,20 @@ namespace MWRender
         /// Update actor position for grass interaction
         void updateActorPosition(const MWWorld::Ptr& actor, const osg::Vec3f& position, const osg::Vec3f& velocity);
 
-        /// Remove actor from interaction system
+        /// Remove actor from interaction system, the grass it bent recovers over time
         void removeActor(const MWWorld::Ptr& actor);
 
-        /// Update interaction simulation
-        void update(float dt);
+        /// Move the texture with the player, fade it and splat the actors into it
+        void update(float dt, const osg::Vec3f& playerPos);
 
-        /// Apply interaction uniforms to a state set (used by groundcover shader)
-        void applyToStateSet(osg::StateSet* stateSet);
+        /// Set the texture unit reserved for the displacement texture, nothing is bound to state sets without one
+        void setTextureUnit(int unit) { mTextureUnit = unit; }
 
-        /// Get uniform for shader binding
-        osg::Uniform* getInteractionPointsUniform() { return mInteractionPointsUniform.get(); }
-        osg::Uniform* getInteractionCountUniform() { return mInteractionCountUniform.get(); }
+        /// Bind the displacement texture to a state set (used by groundcover shader)
+        void applyToStateSet(osg::StateSet* stateSet);
 
         /// Enable/disable grass interaction
+        /// @note Groundcover shaders only sample the texture when grass interaction is enabled in the settings
         void setEnabled(bool enabled) { mEnabled = enabled; }
         bool isEnabled() const { return mEnabled; }
 
@@ -70,15 +76,29 @@ namespace MWRender
         void setRecoverySpeed(float speed) { mRecoverySpeed = speed; }
 
     private:
-        void updateUniforms();
         void pruneOldInteractions(float currentTime);
+        void scroll(int originX, int originY);
+        void clear();
+        void fade(float amount);
+        void splat(const GrassInteractionPoint& point);
+        void updateImage();
+
+        osg::Vec2f& getTexel(int x, int y);
 
         std::map<unsigned int, GrassInteractionPoint> mActorInteractions;
-        std::vector<GrassInteractionPoint> mDecayingInteractions;
 
-        osg::ref_ptr<osg::Uniform> mInteractionPointsUniform;
-        osg::ref_ptr<osg::Uniform> mInteractionCountUniform;
+        // Displacement of every texel as a fraction of MAX_DISPLACEMENT, indexed by world texel coordinates modulo
+        // TEXTURE_SIZE
+        std::vector<osg::Vec2f> mDisplacement;
+        // World texel coordinates of the lower corner of the window covered by the texture
+        int mOriginX;
+        int mOriginY;
+        bool mHasDisplacement;
+
+        osg::ref_ptr<osg::Image> mImage;
+        osg::ref_ptr<osg::Texture2D> mTexture;
         osg::ref_ptr<osg::Uniform> mInteractionParamsUniform;
+        int mTextureUnit;
 
         float mInteractionRadius;
         float mBendIntensity;
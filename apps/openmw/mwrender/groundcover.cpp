@@ -8,12 +8,12 @@
 #include <osg/Geometry>
 #include <osg/Program>
 #include <osg/VertexAttribDivisor>
-#include <osgUtil/CullVisitor>
 
 #include <components/esm3/esmreader.hpp>
 #include <components/esm3/loadland.hpp>
 #include <components/esm3/readerscache.hpp>
 #include <components/misc/convert.hpp>
+#include <components/sceneutil/instancing.hpp>
 #include <components/sceneutil/lightmanager.hpp>
 #include <components/sceneutil/nodecallback.hpp>
 #include <components/settings/values.hpp>
@@ -22,21 +22,13 @@
 
 #include "../mwworld/groundcoverstore.hpp"
 
+#include "grassinteraction.hpp"
 #include "vismask.hpp"
 
 namespace MWRender
 {
     namespace
     {
-        using value_type = osgUtil::CullVisitor::value_type;
-
-        // From OSG's CullVisitor.cpp
-        inline value_type distance(const osg::Vec3& coord, const osg::Matrix& matrix)
-        {
-            return -((value_type)coord[0] * (value_type)matrix(0, 2) + (value_type)coord[1] * (value_type)matrix(1, 2)
-                + (value_type)coord[2] * (value_type)matrix(2, 2) + matrix(3, 2));
-        }
-
         inline osg::Matrix computeInstanceMatrix(
             const Groundcover::GroundcoverEntry& entry, const osg::Vec3& chunkPosition)
         {
@@ -45,151 +37,6 @@ namespace MWRender
                 * osg::Matrix::translate(entry.mPos.asVec3() - chunkPosition);
         }
 
-        class InstancedComputeNearFarCullCallback : public osg::DrawableCullCallback
-        {
-        public:
-            explicit InstancedComputeNearFarCullCallback(std::span<const Groundcover::GroundcoverEntry> instances,
-                const osg::Vec3& chunkPosition, const osg::BoundingBox& instanceBounds)
-                : mInstanceMatrices()
-                , mInstanceBounds(instanceBounds)
-            {
-                mInstanceMatrices.reserve(instances.size());
-                for (const Groundcover::GroundcoverEntry& instance : instances)
-                    mInstanceMatrices.emplace_back(computeInstanceMatrix(instance, chunkPosition));
-            }
-
-            bool cull(osg::NodeVisitor* nv, osg::Drawable* drawable, osg::RenderInfo* renderInfo) const override
-            {
-                osgUtil::CullVisitor& cullVisitor = *nv->asCullVisitor();
-                osg::CullSettings::ComputeNearFarMode cnfMode = cullVisitor.getComputeNearFarMode();
-                const osg::BoundingBox& boundingBox = drawable->getBoundingBox();
-                osg::RefMatrix& matrix = *cullVisitor.getModelViewMatrix();
-
-                if (cnfMode != osg::CullSettings::COMPUTE_NEAR_FAR_USING_PRIMITIVES
-                    && cnfMode != osg::CullSettings::COMPUTE_NEAR_USING_PRIMITIVES)
-                    return false;
-
-                if (drawable->isCullingActive() && cullVisitor.isCulled(boundingBox))
-                    return true;
-
-                osg::Vec3 lookVector = cullVisitor.getLookVectorLocal();
-                unsigned int bbCornerFar
-                    = (lookVector.x() >= 0 ? 1 : 0) | (lookVector.y() >= 0 ? 2 : 0) | (lookVector.z() >= 0 ? 4 : 0);
-                unsigned int bbCornerNear = (~bbCornerFar) & 7;
-                value_type dNear = distance(boundingBox.corner(bbCornerNear), matrix);
-                value_type dFar = distance(boundingBox.corner(bbCornerFar), matrix);
-
-                if (dNear > dFar)
-                    std::swap(dNear, dFar);
-
-                if (dFar < 0)
-                    return true;
-
-                value_type computedZNear = cullVisitor.getCalculatedNearPlane();
-                value_type computedZFar = cullVisitor.getCalculatedFarPlane();
-
-                if (dNear < computedZNear || dFar > computedZFar)
-                {
-                    osg::Polytope frustum;
-                    osg::Polytope::ClippingMask resultMask
-                        = cullVisitor.getCurrentCullingSet().getFrustum().getResultMask();
-                    if (resultMask)
-                    {
-                        // Other objects are likely cheaper and should let us skip all but a few groundcover instances
-                        cullVisitor.computeNearPlane();
-                        computedZNear = cullVisitor.getCalculatedNearPlane();
-                        computedZFar = cullVisitor.getCalculatedFarPlane();
-
-                        if (dNear < computedZNear)
-                        {
-                            dNear = computedZNear;
-                            for (const auto& instanceMatrix : mInstanceMatrices)
-                            {
-                                osg::Matrix fullMatrix = instanceMatrix * matrix;
-                                osg::Vec3d instanceLookVector(-fullMatrix(0, 2), -fullMatrix(1, 2), -fullMatrix(2, 2));
-                                unsigned int instanceBbCornerFar = (instanceLookVector.x() >= 0 ? 1 : 0)
-                                    | (instanceLookVector.y() >= 0 ? 2 : 0) | (instanceLookVector.z() >= 0 ? 4 : 0);
-                                unsigned int instanceBbCornerNear = (~instanceBbCornerFar) & 7;
-                                value_type instanceDNear
-                                    = distance(mInstanceBounds.corner(instanceBbCornerNear), fullMatrix);
-                                value_type instanceDFar
-                                    = distance(mInstanceBounds.corner(instanceBbCornerFar), fullMatrix);
-
-                                if (instanceDNear > instanceDFar)
-                                    std::swap(instanceDNear, instanceDFar);
-
-                                if (instanceDFar < 0 || instanceDNear > dNear)
-                                    continue;
-
-                                frustum.setAndTransformProvidingInverse(
-                                    cullVisitor.getProjectionCullingStack().back().getFrustum(), fullMatrix);
-                                osg::Polytope::PlaneList planes;
-                                osg::Polytope::ClippingMask selectorMask = 0x1;
-                                for (const auto& plane : frustum.getPlaneList())
-                                {
-                                    if (resultMask & selectorMask)
-                                        planes.push_back(plane);
-                                    selectorMask <<= 1;
-                                }
-
-                                value_type newNear
-                                    = cullVisitor.computeNearestPointInFrustum(fullMatrix, planes, *drawable);
-                                dNear = std::min(dNear, newNear);
-                            }
-                            if (dNear < computedZNear)
-                                cullVisitor.setCalculatedNearPlane(dNear);
-                        }
-
-                        if (cnfMode == osg::CullSettings::COMPUTE_NEAR_FAR_USING_PRIMITIVES && dFar > computedZFar)
-                        {
-                            dFar = computedZFar;
-                            for (const auto& instanceMatrix : mInstanceMatrices)
-                            {
-                                osg::Matrix fullMatrix = instanceMatrix * matrix;
-                                osg::Vec3d instanceLookVector(-fullMatrix(0, 2), -fullMatrix(1, 2), -fullMatrix(2, 2));
-                                unsigned int instanceBbCornerFar = (instanceLookVector.x() >= 0 ? 1 : 0)
-                                    | (instanceLookVector.y() >= 0 ? 2 : 0) | (instanceLookVector.z() >= 0 ? 4 : 0);
-                                unsigned int instanceBbCornerNear = (~instanceBbCornerFar) & 7;
-                                value_type instanceDNear
-                                    = distance(mInstanceBounds.corner(instanceBbCornerNear), fullMatrix);
-                                value_type instanceDFar
-                                    = distance(mInstanceBounds.corner(instanceBbCornerFar), fullMatrix);
-
-                                if (instanceDNear > instanceDFar)
-                                    std::swap(instanceDNear, instanceDFar);
-
-                                if (instanceDFar < 0 || instanceDFar < dFar)
-                                    continue;
-
-                                frustum.setAndTransformProvidingInverse(
-                                    cullVisitor.getProjectionCullingStack().back().getFrustum(), fullMatrix);
-                                osg::Polytope::PlaneList planes;
-                                osg::Polytope::ClippingMask selectorMask = 0x1;
-                                for (const auto& plane : frustum.getPlaneList())
-                                {
-                                    if (resultMask & selectorMask)
-                                        planes.push_back(plane);
-                                    selectorMask <<= 1;
-                                }
-
-                                value_type newFar = cullVisitor.computeFurthestPointInFrustum(
-                                    instanceMatrix * matrix, planes, *drawable);
-                                dFar = std::max(dFar, newFar);
-                            }
-                            if (dFar > computedZFar)
-                                cullVisitor.setCalculatedFarPlane(dFar);
-                        }
-                    }
-                }
-
-                return false;
-            }
-
-        private:
-            std::vector<osg::Matrix> mInstanceMatrices;
-            osg::BoundingBox mInstanceBounds;
-        };
-
         class InstancingVisitor : public osg::NodeVisitor
         {
         public:
@@ -251,7 +98,12 @@ namespace MWRender
                 geom.setVertexAttribArray(6, transforms.get(), osg::Array::BIND_PER_VERTEX);
                 geom.setVertexAttribArray(7, rotations.get(), osg::Array::BIND_PER_VERTEX);
 
-                geom.addCullCallback(new InstancedComputeNearFarCullCallback(mInstances, mChunkPosition, originalBox));
+                std::vector<osg::Matrix> instanceMatrices;
+                instanceMatrices.reserve(mInstances.size());
+                for (const Groundcover::GroundcoverEntry& instance : mInstances)
+                    instanceMatrices.emplace_back(computeInstanceMatrix(instance, mChunkPosition));
+                geom.addCullCallback(
+                    new SceneUtil::InstancedComputeNearFarCullCallback(std::move(instanceMatrices), originalBox));
             }
 
         private:
@@ -306,13 +158,13 @@ namespace MWRender
             osg::BoundingBox mBox;
         };
 
-        inline bool isInChunkBorders(ESM::CellRef& ref, osg::Vec2f& minBound, osg::Vec2f& maxBound)
+        inline bool isInChunkBorders(const ESM::Position& position, osg::Vec2f& minBound, osg::Vec2f& maxBound)
         {
             osg::Vec2f size = maxBound - minBound;
             if (size.x() >= 1 && size.y() >= 1)
                 return true;
 
-            osg::Vec3f pos = ref.mPos.asVec3();
+            osg::Vec3f pos = position.asVec3();
             osg::Vec3f cellPos = pos / ESM::Land::REAL_SIZE;
             if ((minBound.x() > std::floor(minBound.x()) && cellPos.x() < minBound.x())
                 || (minBound.y() > std::floor(minBound.y()) && cellPos.y() < minBound.y())
@@ -324,6 +176,30 @@ namespace MWRender
         }
     }
 
+    class Groundcover::CellInstances : public osg::Object
+    {
+    public:
+        struct Instance
+        {
+            std::size_t mModel;
+            GroundcoverEntry mEntry;
+        };
+
+        std::vector<VFS::Path::Normalized> mModels;
+        std::vector<Instance> mInstances;
+
+        CellInstances() = default;
+
+        CellInstances(const CellInstances& copy, const osg::CopyOp& copyOp)
+            : osg::Object(copy, copyOp)
+            , mModels(copy.mModels)
+            , mInstances(copy.mInstances)
+        {
+        }
+
+        META_Object(MWRender, CellInstances)
+    };
+
     osg::ref_ptr<osg::Node> Groundcover::getChunk(float size, const osg::Vec2f& center, unsigned char lod,
         unsigned int lodFlags, bool activeGrid, const osg::Vec3f& viewPoint, bool compile)
     {
@@ -336,8 +212,12 @@ namespace MWRender
         else
         {
             InstanceMap instances;
-            collectInstances(instances, size, center);
+            std::vector<osg::ref_ptr<CellInstances>> cells;
+            collectInstances(instances, cells, size, center);
             osg::ref_ptr<osg::Node> node = createChunk(instances, center);
+            // Keep the instances of the cells while the chunk is in use, for the chunks of the same cells
+            for (const osg::ref_ptr<CellInstances>& cell : cells)
+                node->getOrCreateUserDataContainer()->addUserObject(cell);
             mCache->addEntryToObjectCache(id, node.get());
             return node;
         }
@@ -350,6 +230,7 @@ namespace MWRender
         , mDensity(density)
         , mStateset(new osg::StateSet)
         , mGroundcoverStore(store)
+        , mCellCache(new Resource::GenericObjectCache<std::pair<int, int>>)
     {
         setViewDistance(viewDistance);
         // MGE uses default alpha settings for groundcover, so we can not rely on alpha properties
@@ -360,6 +241,7 @@ namespace MWRender
         mStateset->setRenderBinDetails(0, "RenderBin", osg::StateSet::OVERRIDE_RENDERBIN_DETAILS);
         mStateset->setAttribute(new osg::VertexAttribDivisor(6, 1));
         mStateset->setAttribute(new osg::VertexAttribDivisor(7, 1));
+        getGrassInteractionSystem().applyToStateSet(mStateset);
 
         mProgramTemplate = mSceneManager->getShaderManager().getProgramTemplate()
             ? Shader::ShaderManager::cloneProgram(mSceneManager->getShaderManager().getProgramTemplate())
@@ -370,14 +252,87 @@ namespace MWRender
 
     Groundcover::~Groundcover() = default;
 
-    void Groundcover::collectInstances(InstanceMap& instances, float size, const osg::Vec2f& center)
+    void Groundcover::updateCache(double referenceTime)
+    {
+        GenericResourceManager::updateCache(referenceTime);
+        mCellCache->update(referenceTime, mExpiryDelay);
+    }
+
+    void Groundcover::expireCache(double referenceTime, double expiryDelay)
+    {
+        GenericResourceManager::expireCache(referenceTime, expiryDelay);
+        mCellCache->update(referenceTime, expiryDelay);
+    }
+
+    void Groundcover::clearCache()
+    {
+        GenericResourceManager::clearCache();
+        mCellCache->clear();
+    }
+
+    osg::ref_ptr<Groundcover::CellInstances> Groundcover::getCellInstances(
+        int cellX, int cellY, ESM::ReadersCache& readers)
+    {
+        const std::pair key(cellX, cellY);
+        if (osg::ref_ptr<osg::Object> obj = mCellCache->getRefFromObjectCache(key))
+            return static_cast<CellInstances*>(obj.get());
+
+        osg::ref_ptr<CellInstances> result = new CellInstances;
+        ESM::Cell cell;
+        mGroundcoverStore.initCell(cell, cellX, cellY);
+
+        // The density is applied to the references of the whole cell, so it doesn't depend on the chunk size
+        DensityCalculator calculator(mDensity);
+        std::map<ESM::RefNum, ESM::CellRef> refs;
+        for (size_t i = 0; i < cell.mContextList.size(); ++i)
+        {
+            const std::size_t index = static_cast<std::size_t>(cell.mContextList[i].index);
+            const ESM::ReadersCache::BusyItem reader = readers.get(index);
+            cell.restore(*reader, i);
+            ESM::CellRef ref;
+            bool deleted = false;
+            while (cell.getNextRef(*reader, ref, deleted))
+            {
+                if (!deleted && refs.find(ref.mRefNum) == refs.end() && !calculator.isInstanceEnabled())
+                    deleted = true;
+
+                if (deleted)
+                {
+                    refs.erase(ref.mRefNum);
+                    continue;
+                }
+                refs[ref.mRefNum] = std::move(ref);
+            }
+        }
+
+        std::map<VFS::Path::NormalizedView, std::size_t, std::less<>> modelIndices;
+        result->mInstances.reserve(refs.size());
+        for (const auto& [refNum, cellRef] : refs)
+        {
+            const VFS::Path::NormalizedView model = mGroundcoverStore.getGroundcoverModel(cellRef.mRefID);
+            if (model.empty())
+                continue;
+            auto it = modelIndices.find(model);
+            if (it == modelIndices.end())
+            {
+                it = modelIndices.emplace_hint(it, model, result->mModels.size());
+                result->mModels.emplace_back(model);
+            }
+            result->mInstances.push_back(CellInstances::Instance{ it->second, GroundcoverEntry(cellRef) });
+        }
+
+        mCellCache->addEntryToObjectCache(key, result.get());
+        return result;
+    }
+
+    void Groundcover::collectInstances(InstanceMap& instances, std::vector<osg::ref_ptr<CellInstances>>& cells,
+        float size, const osg::Vec2f& center)
     {
         if (mDensity <= 0.f)
             return;
 
         osg::Vec2f minBound = (center - osg::Vec2f(size / 2.f, size / 2.f));
         osg::Vec2f maxBound = (center + osg::Vec2f(size / 2.f, size / 2.f));
-        DensityCalculator calculator(mDensity);
         ESM::ReadersCache readers;
         osg::Vec2i startCell = osg::Vec2i(static_cast<int>(std::floor(center.x() - size / 2.f)),
             static_cast<int>(std::floor(center.y() - size / 2.f)));
@@ -385,46 +340,22 @@ namespace MWRender
         {
             for (int cellY = startCell.y(); cellY < startCell.y() + size; ++cellY)
             {
-                ESM::Cell cell;
-                mGroundcoverStore.initCell(cell, cellX, cellY);
-                if (cell.mContextList.empty())
+                osg::ref_ptr<CellInstances> cell = getCellInstances(cellX, cellY, readers);
+                if (cell->mInstances.empty())
                     continue;
 
-                calculator.reset();
-                std::map<ESM::RefNum, ESM::CellRef> refs;
-                for (size_t i = 0; i < cell.mContextList.size(); ++i)
+                for (const CellInstances::Instance& instance : cell->mInstances)
                 {
-                    const std::size_t index = static_cast<std::size_t>(cell.mContextList[i].index);
-                    const ESM::ReadersCache::BusyItem reader = readers.get(index);
-                    cell.restore(*reader, i);
-                    ESM::CellRef ref;
-                    bool deleted = false;
-                    while (cell.getNextRef(*reader, ref, deleted))
-                    {
-                        if (!deleted && refs.find(ref.mRefNum) == refs.end() && !calculator.isInstanceEnabled())
-                            deleted = true;
-                        if (!deleted && !isInChunkBorders(ref, minBound, maxBound))
-                            deleted = true;
-
-                        if (deleted)
-                        {
-                            refs.erase(ref.mRefNum);
-                            continue;
-                        }
-                        refs[ref.mRefNum] = std::move(ref);
-                    }
-                }
-
-                for (auto& [refNum, cellRef] : refs)
-                {
-                    const VFS::Path::NormalizedView model = mGroundcoverStore.getGroundcoverModel(cellRef.mRefID);
-                    if (model.empty())
+                    if (!isInChunkBorders(instance.mEntry.mPos, minBound, maxBound))
                         continue;
+                    const VFS::Path::Normalized& model = cell->mModels[instance.mModel];
                     auto it = instances.find(model);
                     if (it == instances.end())
-                        it = instances.emplace_hint(it, VFS::Path::Normalized(model), std::vector<GroundcoverEntry>());
-                    it->second.emplace_back(std::move(cellRef));
+                        it = instances.emplace_hint(it, model, std::vector<GroundcoverEntry>());
+                    it->second.push_back(instance.mEntry);
                 }
+
+                cells.push_back(std::move(cell));
             }
         }
     }
@@ -471,5 +402,6 @@ namespace MWRender
     void Groundcover::reportStats(unsigned int frameNumber, osg::Stats* stats) const
     {
         Resource::reportStats("Groundcover Chunk", frameNumber, mCache->getStats(), *stats);
+        Resource::reportStats("Groundcover Cell", frameNumber, mCellCache->getStats(), *stats);
     }
 }
@@ -6,6 +6,11 @@
 #include <components/terrain/quadtreeworld.hpp>
 #include <components/vfs/pathutil.hpp>
 
+namespace ESM
+{
+    class ReadersCache;
+}
+
 namespace MWWorld
 {
     class ESMStore;
@@ -34,6 +39,12 @@ namespace MWRender
 
         void reportStats(unsigned int frameNumber, osg::Stats* stats) const override;
 
+        void updateCache(double referenceTime) override;
+
+        void expireCache(double referenceTime, double expiryDelay) override;
+
+        void clearCache() override;
+
         struct GroundcoverEntry
         {
             ESM::Position mPos;
@@ -49,14 +60,20 @@ namespace MWRender
     private:
         using InstanceMap = std::map<VFS::Path::Normalized, std::vector<GroundcoverEntry>, std::less<>>;
 
+        class CellInstances;
+
         Resource::SceneManager* mSceneManager;
         float mDensity;
         osg::ref_ptr<osg::StateSet> mStateset;
         osg::ref_ptr<osg::Program> mProgramTemplate;
         const MWWorld::GroundcoverStore& mGroundcoverStore;
+        // Instances kept of every cell, so the chunks of a cell don't read its references again
+        osg::ref_ptr<Resource::GenericObjectCache<std::pair<int, int>>> mCellCache;
 
         osg::ref_ptr<osg::Node> createChunk(InstanceMap& instances, const osg::Vec2f& center);
-        void collectInstances(InstanceMap& instances, float size, const osg::Vec2f& center);
+        void collectInstances(InstanceMap& instances, std::vector<osg::ref_ptr<CellInstances>>& cells, float size,
+            const osg::Vec2f& center);
+        osg::ref_ptr<CellInstances> getCellInstances(int cellX, int cellY, ESM::ReadersCache& readers);
     };
 }
 
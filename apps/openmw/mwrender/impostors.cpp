@@ -0,0 +1,338 @@
+#include "impostors.hpp"
+
+#include <algorithm>
+#include <atomic>
+
+#include <osg/AlphaFunc>
+#include <osg/ComputeBoundsVisitor>
+#include <osg/Fog>
+#include <osg/Geometry>
+#include <osg/LightModel>
+#include <osg/LightSource>
+#include <osg/Texture2D>
+
+#include <components/resource/scenemanager.hpp>
+#include <components/sceneutil/depth.hpp>
+#include <components/sceneutil/lightmanager.hpp>
+#include <components/sceneutil/nodecallback.hpp>
+#include <components/sceneutil/rtt.hpp>
+#include <components/sceneutil/shadow.hpp>
+#include <components/sceneutil/shareduniforms.hpp>
+#include <components/settings/values.hpp>
+#include <components/stereo/multiview.hpp>
+
+#include "vismask.hpp"
+
+namespace MWRender
+{
+    namespace
+    {
+        // Every view is a render of the whole mesh, spread them over frames when many are requested at once
+        constexpr std::size_t sMaxImpostorRendersPerFrame = 4;
+
+        // Impostors no chunk uses anymore are released this often, in frames
+        constexpr unsigned sReleaseInterval = 64;
+
+        struct ImpostorState : public osg::Referenced
+        {
+            std::atomic<int> mPendingViews{ 2 };
+        };
+
+        class ImpostorCullCallback : public SceneUtil::NodeCallback<ImpostorCullCallback>
+        {
+        public:
+            explicit ImpostorCullCallback(osg::ref_ptr<const ImpostorState> state)
+                : mState(std::move(state))
+            {
+            }
+
+            void operator()(osg::Node* node, osg::NodeVisitor* nv)
+            {
+                // The texture is not rendered yet
+                if (mState->mPendingViews > 0)
+                    return;
+                traverse(node, nv);
+            }
+
+        private:
+            const osg::ref_ptr<const ImpostorState> mState;
+        };
+
+        osg::Matrix makeOrtho(float halfWidth, float halfHeight, float near, float far)
+        {
+            if (SceneUtil::AutoDepth::isReversed())
+                return SceneUtil::getReversedZProjectionMatrixAsOrtho(
+                    -halfWidth, halfWidth, -halfHeight, halfHeight, near, far);
+            return osg::Matrix::ortho(-halfWidth, halfWidth, -halfHeight, halfHeight, near, far);
+        }
+    }
+
+    class ImpostorRenderToTexture : public SceneUtil::RTTNode
+    {
+    public:
+        ImpostorRenderToTexture(osg::ref_ptr<osg::Node> node, osg::ref_ptr<osg::Texture2D> texture, int view,
+            int resolution, const osg::Matrix& projectionMatrix, const osg::Matrix& viewMatrix,
+            SceneUtil::LightManager* lightManager, bool useUniformBuffers, osg::ref_ptr<ImpostorState> state);
+
+        void setDefaults(osg::Camera* camera) override;
+
+        osg::ref_ptr<osg::Node> mNode;
+        osg::ref_ptr<osg::Texture2D> mTexture;
+        int mView;
+        int mResolution;
+        osg::Matrix mProjectionMatrix;
+        osg::Matrix mViewMatrix;
+        SceneUtil::LightManager* mLightManager;
+        bool mUseUniformBuffers;
+        osg::ref_ptr<ImpostorState> mState;
+        bool mActive = true;
+    };
+
+    class ImpostorUpdateCallback : public SceneUtil::NodeCallback<ImpostorUpdateCallback, ImpostorRenderToTexture*>
+    {
+    public:
+        void operator()(ImpostorRenderToTexture* node, osg::NodeVisitor* nv)
+        {
+            if (!node->mActive)
+                node->setNodeMask(0);
+
+            node->mActive = false;
+
+            traverse(node, nv);
+        }
+    };
+
+    ImpostorRenderToTexture::ImpostorRenderToTexture(osg::ref_ptr<osg::Node> node,
+        osg::ref_ptr<osg::Texture2D> texture, int view, int resolution, const osg::Matrix& projectionMatrix,
+        const osg::Matrix& viewMatrix, SceneUtil::LightManager* lightManager, bool useUniformBuffers,
+        osg::ref_ptr<ImpostorState> state)
+        : RTTNode(static_cast<uint32_t>(resolution * 2), static_cast<uint32_t>(resolution), 0, false, 0,
+            StereoAwareness::Unaware, false)
+        , mNode(std::move(node))
+        , mTexture(std::move(texture))
+        , mView(view)
+        , mResolution(resolution)
+        , mProjectionMatrix(projectionMatrix)
+        , mViewMatrix(viewMatrix)
+        , mLightManager(lightManager)
+        , mUseUniformBuffers(useUniformBuffers)
+        , mState(std::move(state))
+    {
+        setNodeMask(Mask_RenderToTexture);
+        setUpdateCallback(new ImpostorUpdateCallback);
+    }
+
+    void ImpostorRenderToTexture::setDefaults(osg::Camera* camera)
+    {
+        // Both views share the texture, each camera only clears and draws its half
+        camera->setViewport(mView * mResolution, 0, mResolution, mResolution);
+        camera->attach(osg::Camera::COLOR_BUFFER, mTexture, 0, 0, true);
+
+        camera->setCullingMode(osg::Camera::DEFAULT_CULLING & ~osg::Camera::SMALL_FEATURE_CULLING);
+        camera->setComputeNearFarMode(osg::Camera::DO_NOT_COMPUTE_NEAR_FAR);
+        camera->setReferenceFrame(osg::Camera::ABSOLUTE_RF);
+        camera->setClearColor(osg::Vec4(0.f, 0.f, 0.f, 0.f));
+        camera->setCullMask(~0u);
+        camera->setProjectionMatrix(mProjectionMatrix);
+        camera->setViewMatrix(mViewMatrix);
+
+        osg::StateSet* stateset = camera->getOrCreateStateSet();
+        stateset->addUniform(new osg::Uniform("projectionMatrix", static_cast<osg::Matrixf>(mProjectionMatrix)),
+            osg::StateAttribute::ON | osg::StateAttribute::OVERRIDE);
+
+        // assign large value to effectively turn off fog
+        // shaders don't respect glDisable(GL_FOG)
+        osg::ref_ptr<osg::Fog> fog(new osg::Fog);
+        fog->setStart(10000000);
+        fog->setEnd(10000000);
+        stateset->setAttributeAndModes(fog, osg::StateAttribute::OFF | osg::StateAttribute::OVERRIDE);
+
+        SceneUtil::SharedUniformData sharedUniforms;
+        sharedUniforms.get<SceneUtil::SharedUniform::Near>() = Settings::camera().mNearClip;
+        sharedUniforms.get<SceneUtil::SharedUniform::Far>() = 10000000.0f;
+        sharedUniforms.get<SceneUtil::SharedUniform::SkyBlendingStart>() = 8000000.0f;
+        sharedUniforms.get<SceneUtil::SharedUniform::ScreenRes>() = osg::Vec2f(1, 1);
+        SceneUtil::addSharedUniforms(*stateset, sharedUniforms, mUseUniformBuffers);
+
+        // The impostors are lit again where they are drawn, bake only a soft light from above into the views
+        osg::ref_ptr<osg::LightModel> lightmodel = new osg::LightModel;
+        lightmodel->setAmbientIntensity(osg::Vec4(0.6f, 0.6f, 0.6f, 1.f));
+        stateset->setAttributeAndModes(lightmodel, osg::StateAttribute::ON | osg::StateAttribute::OVERRIDE);
+
+        osg::ref_ptr<osg::Light> light = new osg::Light;
+        light->setPosition(osg::Vec4(0.f, 0.f, 1.f, 0.f));
+        light->setDiffuse(osg::Vec4(0.4f, 0.4f, 0.4f, 1.f));
+        light->setAmbient(osg::Vec4(0, 0, 0, 1));
+        light->setSpecular(osg::Vec4(0, 0, 0, 0));
+        light->setLightNum(0);
+        light->setConstantAttenuation(1.f);
+        light->setLinearAttenuation(0.f);
+        light->setQuadraticAttenuation(0.f);
+
+        osg::ref_ptr<osg::LightSource> lightSource = new osg::LightSource;
+        lightSource->setLight(light);
+        lightSource->setStateSetModes(*stateset, osg::StateAttribute::ON | osg::StateAttribute::OVERRIDE);
+
+        SceneUtil::ShadowManager::instance().disableShadowsForStateSet(*stateset);
+        SceneUtil::configureStateSetSunOverride(mLightManager, light, stateset);
+
+        camera->addChild(lightSource);
+        camera->addChild(mNode);
+    }
+
+    ImpostorCache::ImpostorCache(osg::Group* root, SceneUtil::LightManager* lightManager,
+        Resource::SceneManager& sceneManager, int resolution)
+        : mRoot(root)
+        , mLightManager(lightManager)
+        , mSceneManager(sceneManager)
+        , mResolution(resolution)
+    {
+    }
+
+    ImpostorCache::~ImpostorCache()
+    {
+        for (const osg::ref_ptr<ImpostorRenderToTexture>& rtt : mRTTs)
+            mRoot->removeChild(rtt);
+    }
+
+    osg::ref_ptr<osg::Node> ImpostorCache::getImpostor(const VFS::Path::Normalized& model, const osg::Node& node)
+    {
+        // The views would have to be rendered for every eye with multiview shaders
+        if (Stereo::getMultiview())
+            return nullptr;
+
+        {
+            const std::lock_guard lock(mMutex);
+            if (const auto it = mImpostors.find(model); it != mImpostors.end())
+                return it->second;
+        }
+
+        osg::ComputeBoundsVisitor computeBounds;
+        // const-trickery required because there is no const version of NodeVisitor
+        const_cast<osg::Node&>(node).accept(computeBounds);
+        const osg::BoundingBox& bounds = computeBounds.getBoundingBox();
+        if (!bounds.valid())
+            return nullptr;
+
+        const osg::Vec3f center = bounds.center();
+        const float halfX = std::max(1.f, (bounds.xMax() - bounds.xMin()) / 2);
+        const float halfY = std::max(1.f, (bounds.yMax() - bounds.yMin()) / 2);
+        const float halfZ = std::max(1.f, (bounds.zMax() - bounds.zMin()) / 2);
+        const float distance = bounds.radius() + 1;
+
+        osg::ref_ptr<osg::Texture2D> texture = new osg::Texture2D;
+        texture->setTextureSize(mResolution * 2, mResolution);
+        texture->setInternalFormat(GL_RGBA);
+        texture->setSourceFormat(GL_RGBA);
+        texture->setSourceType(GL_UNSIGNED_BYTE);
+        texture->setFilter(osg::Texture::MIN_FILTER, osg::Texture::LINEAR_MIPMAP_LINEAR);
+        texture->setFilter(osg::Texture::MAG_FILTER, osg::Texture::LINEAR);
+        texture->setWrap(osg::Texture::WRAP_S, osg::Texture::CLAMP_TO_EDGE);
+        texture->setWrap(osg::Texture::WRAP_T, osg::Texture::CLAMP_TO_EDGE);
+
+        // The front view looks along +Y and shows +X to the right, the side view looks along -X and shows +Y to the
+        // right, both with +Z up
+        const osg::Vec3f up(0, 0, 1);
+        osg::ref_ptr<ImpostorState> state = new ImpostorState;
+        osg::ref_ptr<osg::Node> source = const_cast<osg::Node*>(&node);
+        osg::ref_ptr<ImpostorRenderToTexture> front = new ImpostorRenderToTexture(source, texture, 0, mResolution,
+            makeOrtho(halfX, halfZ, 0.5f, distance * 2),
+            osg::Matrix::lookAt(center - osg::Vec3f(0, distance, 0), center, up), mLightManager,
+            mSceneManager.getUseUniformBuffers(), state);
+        osg::ref_ptr<ImpostorRenderToTexture> side = new ImpostorRenderToTexture(source, texture, 1, mResolution,
+            makeOrtho(halfY, halfZ, 0.5f, distance * 2),
+            osg::Matrix::lookAt(center + osg::Vec3f(distance, 0, 0), center, up), mLightManager,
+            mSceneManager.getUseUniformBuffers(), state);
+
+        osg::ref_ptr<osg::Vec3Array> vertices = new osg::Vec3Array{
+            osg::Vec3f(center.x() - halfX, center.y(), center.z() - halfZ),
+            osg::Vec3f(center.x() + halfX, center.y(), center.z() - halfZ),
+            osg::Vec3f(center.x() + halfX, center.y(), center.z() + halfZ),
+            osg::Vec3f(center.x() - halfX, center.y(), center.z() + halfZ),
+            osg::Vec3f(center.x(), center.y() - halfY, center.z() - halfZ),
+            osg::Vec3f(center.x(), center.y() + halfY, center.z() - halfZ),
+            osg::Vec3f(center.x(), center.y() + halfY, center.z() + halfZ),
+            osg::Vec3f(center.x(), center.y() - halfY, center.z() + halfZ),
+        };
+        osg::ref_ptr<osg::Vec2Array> texCoords = new osg::Vec2Array{
+            osg::Vec2f(0.f, 0.f),
+            osg::Vec2f(0.5f, 0.f),
+            osg::Vec2f(0.5f, 1.f),
+            osg::Vec2f(0.f, 1.f),
+            osg::Vec2f(0.5f, 0.f),
+            osg::Vec2f(1.f, 0.f),
+            osg::Vec2f(1.f, 1.f),
+            osg::Vec2f(0.5f, 1.f),
+        };
+        // Both sides of the quads are seen, light them as if they were facing up
+        osg::ref_ptr<osg::Vec3Array> normals = new osg::Vec3Array(osg::Array::BIND_OVERALL);
+        normals->push_back(up);
+
+        osg::ref_ptr<osg::DrawElementsUShort> primitives = new osg::DrawElementsUShort(GL_TRIANGLES);
+        for (const unsigned short first : { 0, 4 })
+            for (const unsigned short index : { 0, 1, 2, 0, 2, 3 })
+                primitives->push_back(static_cast<unsigned short>(first + index));
+
+        osg::ref_ptr<osg::Geometry> geometry = new osg::Geometry;
+        geometry->setVertexArray(vertices);
+        geometry->setNormalArray(normals, osg::Array::BIND_OVERALL);
+        geometry->setTexCoordArray(0, texCoords, osg::Array::BIND_PER_VERTEX);
+        geometry->addPrimitiveSet(primitives);
+        geometry->setUseVertexBufferObjects(true);
+
+        osg::StateSet* stateset = geometry->getOrCreateStateSet();
+        stateset->setTextureAttributeAndModes(0, texture, osg::StateAttribute::ON);
+        stateset->setAttributeAndModes(new osg::AlphaFunc(osg::AlphaFunc::GREATER, 0.5f), osg::StateAttribute::ON);
+        stateset->setMode(GL_CULL_FACE, osg::StateAttribute::OFF);
+
+        osg::ref_ptr<osg::Group> impostor = new osg::Group;
+        impostor->setName("Impostor");
+        impostor->addChild(geometry);
+        impostor->addCullCallback(new ImpostorCullCallback(state));
+        mSceneManager.recreateShaders(impostor, "objects");
+
+        const std::lock_guard lock(mMutex);
+        // Another thread might have created it meanwhile
+        const auto [it, inserted] = mImpostors.emplace(model, impostor);
+        if (inserted)
+        {
+            mPendingRTTs.push_back(std::move(front));
+            mPendingRTTs.push_back(std::move(side));
+        }
+        return it->second;
+    }
+
+    void ImpostorCache::update()
+    {
+        const std::lock_guard lock(mMutex);
+
+        std::erase_if(mRTTs, [&](const osg::ref_ptr<ImpostorRenderToTexture>& rtt) {
+            if (rtt->mActive)
+                return false;
+            mRoot->removeChild(rtt);
+            --rtt->mState->mPendingViews;
+            return true;
+        });
+
+        const std::size_t count = std::min(mPendingRTTs.size(), sMaxImpostorRendersPerFrame);
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            mRoot->addChild(mPendingRTTs[i]);
+            mRTTs.push_back(std::move(mPendingRTTs[i]));
+        }
+        mPendingRTTs.erase(mPendingRTTs.begin(), mPendingRTTs.begin() + count);
+
+        if (++mFrames % sReleaseInterval == 0)
+            std::erase_if(mImpostors, [](const auto& v) { return v.second->referenceCount() == 1; });
+    }
+
+    void ImpostorCache::clear()
+    {
+        const std::lock_guard lock(mMutex);
+        for (const osg::ref_ptr<ImpostorRenderToTexture>& rtt : mRTTs)
+            mRoot->removeChild(rtt);
+        mRTTs.clear();
+        mPendingRTTs.clear();
+        mImpostors.clear();
+    }
+}
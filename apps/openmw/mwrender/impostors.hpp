@@ -0,0 +1,63 @@
+#ifndef OPENMW_MWRENDER_IMPOSTORS_H
+#define OPENMW_MWRENDER_IMPOSTORS_H
+
+#include <components/vfs/pathutil.hpp>
+
+#include <osg/Group>
+#include <osg/ref_ptr>
+
+#include <map>
+#include <mutex>
+#include <vector>
+
+namespace Resource
+{
+    class SceneManager;
+}
+
+namespace SceneUtil
+{
+    class LightManager;
+}
+
+namespace MWRender
+{
+    class ImpostorRenderToTexture;
+
+    /// @brief Replaces static meshes in distant object paging chunks with two crossed quads showing the mesh seen
+    /// from the front and from the side. Both views are rendered into one texture.
+    /// @par Impostors are created on first use and can be requested from the threads building the chunks. The views
+    /// are rendered over the next frames, an impostor is not drawn until its texture is ready.
+    class ImpostorCache
+    {
+    public:
+        /// @param root node the render to texture cameras are attached to
+        /// @param resolution width and height of each view
+        ImpostorCache(osg::Group* root, SceneUtil::LightManager* lightManager, Resource::SceneManager& sceneManager,
+            int resolution);
+
+        ~ImpostorCache();
+
+        /// @return the impostor shared by all instances of the mesh
+        /// @note Thread safe.
+        osg::ref_ptr<osg::Node> getImpostor(const VFS::Path::Normalized& model, const osg::Node& node);
+
+        /// Attach the cameras requested since the last frame and remove the ones done rendering.
+        void update();
+
+        void clear();
+
+    private:
+        const osg::ref_ptr<osg::Group> mRoot;
+        SceneUtil::LightManager* const mLightManager;
+        Resource::SceneManager& mSceneManager;
+        const int mResolution;
+        std::mutex mMutex;
+        std::map<VFS::Path::Normalized, osg::ref_ptr<osg::Node>, std::less<>> mImpostors;
+        std::vector<osg::ref_ptr<ImpostorRenderToTexture>> mPendingRTTs;
+        std::vector<osg::ref_ptr<ImpostorRenderToTexture>> mRTTs;
+        unsigned mFrames = 0;
+    };
+}
+
+#endif
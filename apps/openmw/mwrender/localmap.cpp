@@ -1,5 +1,6 @@
 #include "localmap.hpp"
 
+#include <algorithm>
 #include <cstdint>
 
 #include <osg/ComputeBoundsVisitor>
@@ -16,11 +17,14 @@
 #include <components/esm3/loadcell.hpp>
 #include <components/files/memorystream.hpp>
 #include <components/misc/constants.hpp>
+#include <components/resource/resourcesystem.hpp>
+#include <components/resource/scenemanager.hpp>
 #include <components/sceneutil/depth.hpp>
 #include <components/sceneutil/lightmanager.hpp>
 #include <components/sceneutil/nodecallback.hpp>
 #include <components/sceneutil/rtt.hpp>
 #include <components/sceneutil/shadow.hpp>
+#include <components/sceneutil/shareduniforms.hpp>
 #include <components/sceneutil/visitor.hpp>
 #include <components/settings/values.hpp>
 #include <components/stereo/multiview.hpp>
@@ -35,6 +39,9 @@
 
 namespace
 {
+    // Every segment is a full render of the scene, spread them over frames when many are requested at once
+    constexpr std::size_t sMaxMapRendersPerFrame = 2;
+
     float square(float val)
     {
         return val * val;
@@ -107,6 +114,8 @@ namespace MWRender
     {
         mExteriorSegments.clear();
         mInteriorSegments.clear();
+        mPendingLocalMapRTTs.clear();
+        mFogUpToDate = false;
     }
 
     void LocalMap::saveFogOfWar(MWWorld::CellStore* cell)
@@ -163,14 +172,17 @@ namespace MWRender
     void LocalMap::setupRenderToTexture(
         int segmentX, int segmentY, float left, float top, const osg::Vec3d& upVector, float zmin, float zmax)
     {
-        mLocalMapRTTs.emplace_back(
-            new LocalMapRenderToTexture(mSceneRoot, mMapResolution, mMapWorldSize, left, top, upVector, zmin, zmax));
-
-        mRoot->addChild(mLocalMapRTTs.back());
+        osg::ref_ptr<LocalMapRenderToTexture> rtt
+            = new LocalMapRenderToTexture(mSceneRoot, mMapResolution, mMapWorldSize, left, top, upVector, zmin, zmax);
 
         MapSegment& segment = mInterior ? mInteriorSegments[std::make_pair(segmentX, segmentY)]
                                         : mExteriorSegments[std::make_pair(segmentX, segmentY)];
-        segment.mMapTexture = static_cast<osg::Texture2D*>(mLocalMapRTTs.back()->getColorTexture(nullptr));
+        segment.mMapTexture = static_cast<osg::Texture2D*>(rtt->getColorTexture(nullptr));
+
+        // The segment may have to be revealed in the fog of war while the player stays in place
+        mFogUpToDate = false;
+
+        mPendingLocalMapRTTs.push_back({ { segmentX, segmentY }, std::move(rtt) });
     }
 
     void LocalMap::requestMap(const MWWorld::CellStore* cell)
@@ -247,6 +259,26 @@ namespace MWRender
             else
                 it++;
         }
+
+        if (mPendingLocalMapRTTs.empty())
+            return;
+
+        // Render the segments closest to the player first, the one the player is in has to be rendered in the same
+        // frame it's requested in to be drawn onto the global map
+        const auto distance = [&](const PendingRTT& pending) {
+            return std::max(std::abs(pending.mSegment.first - mPlayerSegment.first),
+                std::abs(pending.mSegment.second - mPlayerSegment.second));
+        };
+        std::stable_sort(mPendingLocalMapRTTs.begin(), mPendingLocalMapRTTs.end(),
+            [&](const PendingRTT& l, const PendingRTT& r) { return distance(l) < distance(r); });
+
+        const std::size_t count = std::min(mPendingLocalMapRTTs.size(), sMaxMapRendersPerFrame);
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            mRoot->addChild(mPendingLocalMapRTTs[i].mRTT);
+            mLocalMapRTTs.push_back(std::move(mPendingLocalMapRTTs[i].mRTT));
+        }
+        mPendingLocalMapRTTs.erase(mPendingLocalMapRTTs.begin(), mPendingLocalMapRTTs.begin() + count);
     }
 
     void LocalMap::requestExteriorMap(const MWWorld::CellStore* cell, MapSegment& segment)
@@ -494,6 +526,15 @@ namespace MWRender
             v = 1.0f - std::abs((pos.y() - (mMapWorldSize * y)) / mMapWorldSize);
         }
 
+        mPlayerSegment = { x, y };
+
+        // The explored area only grows when the player moves
+        if (mFogUpToDate && mFogInterior == mInterior && mFogPosition == osg::Vec4f(x, y, u, v))
+            return;
+        mFogUpToDate = true;
+        mFogInterior = mInterior;
+        mFogPosition = osg::Vec4f(x, y, u, v);
+
         // explore radius (squared)
         const float exploreRadius = 0.17f * (sFogOfWarResolution - 1); // explore radius from 0 to sFogOfWarResolution-1
         const float sqrExploreRadius = square(exploreRadius);
@@ -734,10 +775,14 @@ namespace MWRender
         fog->setEnd(10000000);
         stateset->setAttributeAndModes(fog, osg::StateAttribute::OFF | osg::StateAttribute::OVERRIDE);
 
-        // turn of sky blending
-        stateset->addUniform(new osg::Uniform("far", 10000000.0f));
-        stateset->addUniform(new osg::Uniform("skyBlendingStart", 8000000.0f));
-        stateset->addUniform(new osg::Uniform("screenRes", osg::Vec2f{ 1, 1 }));
+        // turn off sky blending
+        SceneUtil::SharedUniformData sharedUniforms;
+        sharedUniforms.get<SceneUtil::SharedUniform::Near>() = Settings::camera().mNearClip;
+        sharedUniforms.get<SceneUtil::SharedUniform::Far>() = 10000000.0f;
+        sharedUniforms.get<SceneUtil::SharedUniform::SkyBlendingStart>() = 8000000.0f;
+        sharedUniforms.get<SceneUtil::SharedUniform::ScreenRes>() = osg::Vec2f(1, 1);
+        const Resource::SceneManager& sceneManager = *MWBase::Environment::get().getResourceSystem()->getSceneManager();
+        SceneUtil::addSharedUniforms(*stateset, sharedUniforms, sceneManager.getUseUniformBuffers());
 
         osg::ref_ptr<osg::LightModel> lightmodel = new osg::LightModel;
         lightmodel->setAmbientIntensity(osg::Vec4(0.3f, 0.3f, 0.3f, 1.f));
@@ -9,6 +9,7 @@
 #include <MyGUI_Types.h>
 #include <osg/BoundingBox>
 #include <osg/Quat>
+#include <osg/Vec4f>
 #include <osg/ref_ptr>
 
 namespace MWWorld
@@ -50,7 +51,7 @@ namespace MWRender
 
         /**
          * Request a map render for the given cell. Render textures will be immediately created and can be retrieved
-         * with the getMapTexture function.
+         * with the getMapTexture function, they are rendered over the next frames.
          */
         void requestMap(const MWWorld::CellStore* cell);
 
@@ -67,6 +68,7 @@ namespace MWRender
          * Removes cameras that have already been rendered. Should be called every frame to ensure that
          * we do not render the same map more than once. Note, this cleanup is difficult to implement in an
          * automated fashion, since we can't alter the scene graph structure from within an update callback.
+         * Also starts rendering a limited number of the requested maps, closest to the player first.
          */
         void cleanupCameras();
 
@@ -108,6 +110,21 @@ namespace MWRender
         typedef std::vector<osg::ref_ptr<LocalMapRenderToTexture>> RTTVector;
         RTTVector mLocalMapRTTs;
 
+        struct PendingRTT
+        {
+            std::pair<int, int> mSegment;
+            osg::ref_ptr<LocalMapRenderToTexture> mRTT;
+        };
+
+        // Not added to the scene yet, see cleanupCameras
+        std::vector<PendingRTT> mPendingLocalMapRTTs;
+
+        std::pair<int, int> mPlayerSegment{ 0, 0 };
+
+        bool mFogUpToDate = false;
+        bool mFogInterior = false;
+        osg::Vec4f mFogPosition;
+
         enum NeighbourCellFlag : std::uint8_t
         {
             NeighbourCellTopLeft = 1,
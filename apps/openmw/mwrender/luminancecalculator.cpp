@@ -4,11 +4,14 @@
 #include <components/settings/values.hpp>
 #include <components/shader/shadermanager.hpp>
 
+#include <osg/FrameStamp>
+
 #include "pingpongcanvas.hpp"
 
 namespace MWRender
 {
     LuminanceCalculator::LuminanceCalculator(Shader::ShaderManager& shaderManager)
+        : mInterval(static_cast<unsigned>(Settings::postProcessing().mAutoExposureInterval))
     {
         Shader::ShaderManager::DefineMap defines = {
             { "hdrExposureTime", std::to_string(Settings::postProcessing().mAutoExposureSpeed) },
@@ -104,28 +107,38 @@ namespace MWRender
             compile();
 
         auto& buffer = mBuffers[frameId];
-        buffer.sceneLumFbo->apply(state, osg::FrameBufferObject::DRAW_FRAMEBUFFER);
-        buffer.sceneLumSS->setTextureAttributeAndModes(0, canvas.getSceneTexture(frameId));
-        buffer.sceneLumSS->getUniform("scaling")->set(mScale);
-
-        state.apply(buffer.sceneLumSS);
-        canvas.drawGeometry(renderInfo);
+        const unsigned frameNumber = state.getFrameStamp()->getFrameNumber();
 
-        state.applyTextureAttribute(0, buffer.mipmappedSceneLuminanceTex);
-        ext->glGenerateMipmap(GL_TEXTURE_2D);
-
-        buffer.resolveSceneLumFbo->apply(state, osg::FrameBufferObject::READ_FRAMEBUFFER);
-        buffer.luminanceProxyFbo->apply(state, osg::FrameBufferObject::DRAW_FRAMEBUFFER);
-        ext->glBlitFramebuffer(0, 0, 1, 1, 0, 0, 1, 1, GL_COLOR_BUFFER_BIT, GL_NEAREST);
-
-        if (mIsBlank)
+        // Measuring the scene is what costs, the exposure still adapts every frame to the latest measured luminance
+        if (dirty || mIsBlank || frameNumber - mMeasureFrameNumber >= mInterval)
         {
-            // Use current frame data for previous frame to warm up calculations and prevent popin
-            mBuffers[(frameId + 1) % 2].resolveFbo->apply(state, osg::FrameBufferObject::DRAW_FRAMEBUFFER);
-            ext->glBlitFramebuffer(0, 0, 1, 1, 0, 0, 1, 1, GL_COLOR_BUFFER_BIT, GL_NEAREST);
-
-            buffer.luminanceProxyFbo->apply(state, osg::FrameBufferObject::DRAW_FRAMEBUFFER);
-            mIsBlank = false;
+            buffer.sceneLumFbo->apply(state, osg::FrameBufferObject::DRAW_FRAMEBUFFER);
+            buffer.sceneLumSS->setTextureAttributeAndModes(0, canvas.getSceneTexture(frameId));
+            buffer.sceneLumSS->getUniform("scaling")->set(mScale);
+
+            state.apply(buffer.sceneLumSS);
+            canvas.drawGeometry(renderInfo);
+
+            state.applyTextureAttribute(0, buffer.mipmappedSceneLuminanceTex);
+            ext->glGenerateMipmap(GL_TEXTURE_2D);
+
+            // Both buffers resolve the same measurement until the next one
+            buffer.resolveSceneLumFbo->apply(state, osg::FrameBufferObject::READ_FRAMEBUFFER);
+            for (auto& v : mBuffers)
+            {
+                v.luminanceProxyFbo->apply(state, osg::FrameBufferObject::DRAW_FRAMEBUFFER);
+                ext->glBlitFramebuffer(0, 0, 1, 1, 0, 0, 1, 1, GL_COLOR_BUFFER_BIT, GL_NEAREST);
+            }
+
+            if (mIsBlank)
+            {
+                // Use current frame data for previous frame to warm up calculations and prevent popin
+                mBuffers[(frameId + 1) % 2].resolveFbo->apply(state, osg::FrameBufferObject::DRAW_FRAMEBUFFER);
+                ext->glBlitFramebuffer(0, 0, 1, 1, 0, 0, 1, 1, GL_COLOR_BUFFER_BIT, GL_NEAREST);
+                mIsBlank = false;
+            }
+
+            mMeasureFrameNumber = frameNumber;
         }
 
         buffer.resolveFbo->apply(state, osg::FrameBufferObject::DRAW_FRAMEBUFFER);
@@ -56,6 +56,10 @@ namespace MWRender
         osg::ref_ptr<osg::Program> mLuminanceProgram;
         osg::ref_ptr<osg::Program> mResolveProgram;
 
+        // Frames between measurements of the scene luminance
+        unsigned mInterval = 1;
+        unsigned mMeasureFrameNumber = 0;
+
         bool mCompiled = false;
         bool mEnabled = false;
         bool mIsBlank = true;
@@ -187,6 +187,7 @@ namespace MWRender
         explicit DeallocateCreateNavMeshTileGroups(osg::ref_ptr<NavMesh::CreateNavMeshTileGroups>&& workItem)
             : mWorkItem(std::move(workItem))
         {
+            setPriority(SceneUtil::WorkPriority::Low);
         }
     };
 
@@ -1,8 +1,13 @@
 #include "objectpaging.hpp"
 
+#include <algorithm>
+#include <set>
+#include <span>
+#include <typeinfo>
 #include <unordered_map>
 #include <vector>
 
+#include <osg/Geode>
 #include <osg/LOD>
 #include <osg/Material>
 #include <osg/MatrixTransform>
@@ -27,10 +32,12 @@
 #include <components/esm4/loadfurn.hpp>
 #include <components/esm4/loadstat.hpp>
 #include <components/esm4/loadtree.hpp>
+#include <components/misc/osguservalues.hpp>
 #include <components/misc/pathhelpers.hpp>
 #include <components/misc/resourcehelpers.hpp>
 #include <components/misc/rng.hpp>
 #include <components/resource/scenemanager.hpp>
+#include <components/sceneutil/instancing.hpp>
 #include <components/sceneutil/lightmanager.hpp>
 #include <components/sceneutil/morphgeometry.hpp>
 #include <components/sceneutil/optimizer.hpp>
@@ -39,6 +46,7 @@
 #include <components/sceneutil/riggeometryosgaextension.hpp>
 #include <components/sceneutil/util.hpp>
 #include <components/settings/values.hpp>
+#include <components/shader/shadermanager.hpp>
 #include <components/vfs/manager.hpp>
 
 #include "apps/openmw/mwbase/environment.hpp"
@@ -46,6 +54,7 @@
 #include "apps/openmw/mwclass/esm4base.hpp"
 #include "apps/openmw/mwworld/esmstore.hpp"
 
+#include "impostors.hpp"
 #include "vismask.hpp"
 
 namespace MWRender
@@ -174,6 +183,7 @@ namespace MWRender
             osg::Vec3f mViewVector;
             osg::Node::NodeMask mCopyMask = ~0u;
             mutable std::vector<const osg::Node*> mNodePath;
+            mutable bool mHasOptimizedBillboards = false;
 
             CopyOp(bool activeGrid, osg::Node::NodeMask copyMask)
                 : mActiveGrid(activeGrid)
@@ -266,6 +276,7 @@ namespace MWRender
                     {
                         if (mOptimizeBillboards)
                         {
+                            mHasOptimizedBillboards = true;
                             handleBillboard(cloned);
                             continue;
                         }
@@ -363,6 +374,49 @@ namespace MWRender
             std::vector<ESM::RefNum> mRefnums;
         };
 
+        // Hidden objects are kept in the chunk until this fraction of its objects is hidden, then it's rebuilt
+        constexpr std::size_t sMaxHiddenRatio = 4;
+
+        // Objects drawn by a chunk and the parts of the chunk to hide them without a rebuild.
+        class PagedRefs : public osg::Object
+        {
+        public:
+            struct Range
+            {
+                ESM::RefNum mRefNum;
+                unsigned int mFirst;
+                unsigned int mCount;
+            };
+
+            // Geometry several objects were merged into, drawn without the vertices of its hidden objects
+            struct MergedGeometry
+            {
+                osg::ref_ptr<osg::Geometry> mSource;
+                osg::ref_ptr<osg::Geometry> mCurrent;
+                std::vector<Range> mRanges;
+            };
+
+            PagedRefs() {}
+            PagedRefs(const PagedRefs& copy, const osg::CopyOp&)
+                : mRefs(copy.mRefs)
+                , mFixed(copy.mFixed)
+                , mNodes(copy.mNodes)
+                , mMergedGeometries(copy.mMergedGeometries)
+                , mHidden(copy.mHidden)
+            {
+            }
+            META_Object(MWRender, PagedRefs)
+
+            // Sorted
+            std::vector<ESM::RefNum> mRefs;
+            // Sorted, objects that can't be hidden without a rebuild, e.g. instanced ones
+            std::vector<ESM::RefNum> mFixed;
+            // Sorted by object, objects drawn by their own transform
+            std::vector<std::pair<ESM::RefNum, osg::ref_ptr<osg::Node>>> mNodes;
+            std::vector<MergedGeometry> mMergedGeometries;
+            std::set<ESM::RefNum> mHidden;
+        };
+
         class AnalyzeVisitor : public osg::NodeVisitor
         {
         public:
@@ -483,6 +537,9 @@ namespace MWRender
             {
             }
             ESM::RefNum mRefnum;
+            // Whether every drawable got a marker, the object can be hidden in merged geometry then
+            bool mHideable = true;
+            void apply(osg::Drawable& node) override { mHideable = false; }
             void apply(osg::Geometry& node) override
             {
                 osg::ref_ptr<RefnumMarker> marker(new RefnumMarker);
@@ -492,6 +549,261 @@ namespace MWRender
                 node.getOrCreateUserDataContainer()->addUserObject(marker);
             }
         };
+
+        // Collects the vertex ranges of the objects in merged geometries from their RefnumMarkers.
+        class CollectMergedGeometriesVisitor : public osg::NodeVisitor
+        {
+        public:
+            CollectMergedGeometriesVisitor(PagedRefs& refs, bool removeMarkers)
+                : osg::NodeVisitor(TRAVERSE_ALL_CHILDREN)
+                , mRefs(refs)
+                , mRemoveMarkers(removeMarkers)
+            {
+            }
+
+            void apply(osg::Geometry& geometry) override
+            {
+                osg::UserDataContainer* const udc = geometry.getUserDataContainer();
+                if (udc == nullptr)
+                    return;
+
+                PagedRefs::MergedGeometry merged;
+                unsigned int first = 0;
+                for (unsigned int i = 0; i < udc->getNumUserObjects(); ++i)
+                {
+                    if (const RefnumMarker* marker = dynamic_cast<const RefnumMarker*>(udc->getUserObject(i)))
+                    {
+                        merged.mRanges.push_back(PagedRefs::Range{ marker->mRefnum, first, marker->mNumVertices });
+                        first += marker->mNumVertices;
+                    }
+                }
+                if (merged.mRanges.empty())
+                    return;
+
+                // Markers are only needed by ray casts, which don't look for objects outside of the active grid
+                if (mRemoveMarkers)
+                    for (unsigned int i = udc->getNumUserObjects(); i > 0; --i)
+                        if (dynamic_cast<const RefnumMarker*>(udc->getUserObject(i - 1)) != nullptr)
+                            udc->removeUserObject(i - 1);
+
+                if (typeid(geometry) != typeid(osg::Geometry))
+                {
+                    for (const PagedRefs::Range& range : merged.mRanges)
+                        mRefs.mFixed.push_back(range.mRefNum);
+                    return;
+                }
+
+                merged.mSource = &geometry;
+                merged.mCurrent = &geometry;
+                mRefs.mMergedGeometries.push_back(std::move(merged));
+            }
+
+        private:
+            PagedRefs& mRefs;
+            bool mRemoveMarkers;
+        };
+
+        unsigned int getPrimitiveSize(GLenum mode)
+        {
+            switch (mode)
+            {
+                case GL_POINTS:
+                    return 1;
+                case GL_LINES:
+                    return 2;
+                case GL_TRIANGLES:
+                    return 3;
+                default:
+                    return 0;
+            }
+        }
+
+        /// Add the parts of the primitive set not using hidden vertices to the list.
+        /// @return false if the primitive set can't be split
+        bool filterPrimitiveSet(
+            osg::PrimitiveSet& primitiveSet, const std::vector<bool>& hidden, osg::Geometry::PrimitiveSetList& out)
+        {
+            const auto isHidden = [&](unsigned int index) { return index < hidden.size() && hidden[index]; };
+            const unsigned int primitiveSize = getPrimitiveSize(primitiveSet.getMode());
+
+            if (primitiveSet.getType() == osg::PrimitiveSet::DrawArraysPrimitiveType && primitiveSize != 0)
+            {
+                const osg::DrawArrays& drawArrays = static_cast<const osg::DrawArrays&>(primitiveSet);
+                const GLint end = drawArrays.getFirst() + drawArrays.getCount();
+                bool changed = false;
+                osg::Geometry::PrimitiveSetList ranges;
+                for (GLint first = drawArrays.getFirst(); first < end;)
+                {
+                    GLint last = first;
+                    while (last < end && !isHidden(static_cast<unsigned int>(last)))
+                        ++last;
+                    if (last > first)
+                        ranges.push_back(new osg::DrawArrays(
+                            drawArrays.getMode(), first, last - first, drawArrays.getNumInstances()));
+                    first = last;
+                    while (first < end && isHidden(static_cast<unsigned int>(first)))
+                    {
+                        changed = true;
+                        ++first;
+                    }
+                }
+                if (!changed)
+                    out.push_back(&primitiveSet);
+                else
+                    out.insert(out.end(), ranges.begin(), ranges.end());
+                return true;
+            }
+
+            if (const osg::DrawElements* const drawElements = primitiveSet.getDrawElements();
+                drawElements != nullptr && primitiveSize != 0)
+            {
+                const unsigned int numIndices = drawElements->getNumIndices();
+                osg::ref_ptr<osg::DrawElements> filtered = static_cast<osg::DrawElements*>(drawElements->cloneType());
+                filtered->setMode(drawElements->getMode());
+                filtered->setNumInstances(drawElements->getNumInstances());
+                filtered->reserveElements(numIndices);
+                // All vertices of a primitive belong to the same object
+                for (unsigned int i = 0; i + primitiveSize <= numIndices; i += primitiveSize)
+                    if (!isHidden(drawElements->getElement(i)))
+                        for (unsigned int j = 0; j < primitiveSize; ++j)
+                            filtered->addElement(drawElements->getElement(i + j));
+                if (filtered->getNumIndices() == numIndices)
+                    out.push_back(&primitiveSet);
+                else if (filtered->getNumIndices() > 0)
+                    out.push_back(filtered);
+                return true;
+            }
+
+            // Strips and fans can only be kept or dropped as a whole
+            bool anyHidden = false;
+            bool allHidden = true;
+            for (unsigned int i = 0; i < primitiveSet.getNumIndices(); ++i)
+            {
+                const bool indexHidden = isHidden(primitiveSet.index(i));
+                anyHidden = anyHidden || indexHidden;
+                allHidden = allHidden && indexHidden;
+            }
+            if (!anyHidden)
+                out.push_back(&primitiveSet);
+            else if (!allHidden)
+                return false;
+            return true;
+        }
+
+        /// @return nullptr if the hidden vertices can't be split from the others
+        osg::ref_ptr<osg::Geometry> hideVertices(const osg::Geometry& source, const std::vector<bool>& hidden)
+        {
+            osg::Geometry::PrimitiveSetList primitiveSets;
+            for (const osg::ref_ptr<osg::PrimitiveSet>& primitiveSet : source.getPrimitiveSetList())
+                if (!filterPrimitiveSet(*primitiveSet, hidden, primitiveSets))
+                    return nullptr;
+            // Shares the arrays and their buffer objects with the source
+            osg::ref_ptr<osg::Geometry> result = new osg::Geometry(source, osg::CopyOp::SHALLOW_COPY);
+            result->setPrimitiveSetList(primitiveSets);
+            return result;
+        }
+
+        // Collects geometries of a paged copy which can be drawn with per instance transforms.
+        class CollectInstanceableVisitor : public osg::NodeVisitor
+        {
+        public:
+            CollectInstanceableVisitor()
+                : osg::NodeVisitor(TRAVERSE_ALL_CHILDREN)
+            {
+            }
+
+            bool mInstanceable = true;
+            std::vector<std::pair<osg::Geometry*, osg::Matrixf>> mGeometries;
+            std::vector<osg::Transform*> mTransforms;
+
+            void apply(osg::Node& node) override
+            {
+                // LODs, cameras and other special nodes would be evaluated once for all instances
+                if (node.getCullCallback() != nullptr
+                    || (typeid(node) != typeid(osg::Group) && typeid(node) != typeid(osg::Geode)))
+                {
+                    mInstanceable = false;
+                    return;
+                }
+                traverse(node);
+            }
+
+            void apply(osg::Transform& transform) override
+            {
+                if (transform.getCullCallback() != nullptr
+                    || transform.getReferenceFrame() != osg::Transform::RELATIVE_RF
+                    || (transform.asMatrixTransform() == nullptr
+                        && dynamic_cast<SceneUtil::PositionAttitudeTransform*>(&transform) == nullptr))
+                {
+                    mInstanceable = false;
+                    return;
+                }
+                mTransforms.push_back(&transform);
+                traverse(transform);
+            }
+
+            void apply(osg::Drawable& drawable) override { mInstanceable = false; }
+
+            void apply(osg::Geometry& geometry) override
+            {
+                if (geometry.getCullCallback() != nullptr || typeid(geometry) != typeid(osg::Geometry))
+                {
+                    mInstanceable = false;
+                    return;
+                }
+                mGeometries.emplace_back(&geometry, osg::computeLocalToWorld(getNodePath()));
+            }
+        };
+
+        void resetTransform(osg::Transform& transform)
+        {
+            if (osg::MatrixTransform* const matrixTransform = transform.asMatrixTransform())
+                matrixTransform->setMatrix(osg::Matrix::identity());
+            else if (auto* const pat = dynamic_cast<SceneUtil::PositionAttitudeTransform*>(&transform))
+            {
+                pat->setPosition(osg::Vec3f());
+                pat->setAttitude(osg::Quat());
+                pat->setScale(osg::Vec3f(1, 1, 1));
+            }
+        }
+
+        /// @return nullptr if the copied node can't be instanced
+        osg::ref_ptr<osg::Group> createInstancedNode(
+            const osg::Node& node, std::span<const osg::Matrixf> transforms, CopyOp& copyop)
+        {
+            osg::ref_ptr<osg::Group> root = new osg::Group;
+            copyop.mHasOptimizedBillboards = false;
+            copyop.mNodePath.push_back(root);
+            copyop.copy(&node, root);
+            copyop.mNodePath.pop_back();
+            // billboards were pointed at the camera for a single chunk relative position
+            if (copyop.mHasOptimizedBillboards)
+                return nullptr;
+
+            CollectInstanceableVisitor collector;
+            for (unsigned int i = 0; i < root->getNumChildren(); ++i)
+                root->getChild(i)->accept(collector);
+            if (!collector.mInstanceable || collector.mGeometries.empty())
+                return nullptr;
+
+            std::vector<osg::Matrixf> geometryTransforms(transforms.size());
+            for (const auto& [geometry, localToChunk] : collector.mGeometries)
+            {
+                for (std::size_t i = 0; i < transforms.size(); ++i)
+                    geometryTransforms[i] = localToChunk * transforms[i];
+                if (!SceneUtil::makeInstanced(*geometry, geometryTransforms))
+                    return nullptr;
+            }
+
+            // transforms are part of the per instance data now
+            for (osg::Transform* transform : collector.mTransforms)
+                resetTransform(*transform);
+
+            SceneUtil::setUpInstancingForStateSet(*root->getOrCreateStateSet());
+            root->setUserValue(Misc::OsgUserValues::sInstancing, true);
+            root->setDataVariance(osg::Object::STATIC);
+            return root;
+        }
     }
 
     ObjectPaging::ObjectPaging(Resource::SceneManager* sceneManager, ESM::RefId worldspace)
@@ -504,8 +816,18 @@ namespace MWRender
         , mMinSize(Settings::terrain().mObjectPagingMinSize)
         , mMinSizeMergeFactor(Settings::terrain().mObjectPagingMinSizeMergeFactor)
         , mMinSizeCostMultiplier(Settings::terrain().mObjectPagingMinSizeCostMultiplier)
+        , mInstancing(Settings::terrain().mObjectPagingInstancing)
+        , mImpostorDistance(Settings::terrain().mObjectPagingImpostorDistance)
+        , mImpostorMinSize(Settings::terrain().mObjectPagingImpostorMinSize)
         , mRefTrackerLocked(false)
     {
+        if (mInstancing)
+        {
+            const osg::Program* const programTemplate = mSceneManager->getShaderManager().getProgramTemplate();
+            mInstancingProgramTemplate = programTemplate ? Shader::ShaderManager::cloneProgram(programTemplate)
+                                                         : osg::ref_ptr<osg::Program>(new osg::Program);
+            SceneUtil::addBindInstancingAttribLocations(*mInstancingProgramTemplate);
+        }
     }
 
     namespace
@@ -519,6 +841,22 @@ namespace MWRender
             float mScale;
         };
 
+        osg::Quat makeNodeAttitude(const PagedCellRef& ref)
+        {
+            return osg::Quat(ref.mRotation.z(), osg::Vec3f(0, 0, -1))
+                * osg::Quat(ref.mRotation.y(), osg::Vec3f(0, -1, 0))
+                * osg::Quat(ref.mRotation.x(), osg::Vec3f(-1, 0, 0));
+        }
+
+        osg::Matrixf makeNodeMatrix(const PagedCellRef& ref, const osg::Vec3f& worldCenter)
+        {
+            osg::Matrixf matrix;
+            matrix.preMultTranslate(ref.mPosition - worldCenter);
+            matrix.preMultRotate(makeNodeAttitude(ref));
+            matrix.preMultScale(osg::Vec3f(ref.mScale, ref.mScale, ref.mScale));
+            return matrix;
+        }
+
         PagedCellRef makePagedCellRef(const ESM::CellRef& value)
         {
             return PagedCellRef{
@@ -704,12 +1042,19 @@ namespace MWRender
         // 2. For nodes masked via Flag_Hidden (VisController can change this flag value at runtime).
         // Since ObjectPaging does not handle VisController, we can just ignore both types of nodes.
         constexpr auto copyMask = ~Mask_UpdateVisitor;
+        // Fewer instances are not worth a separate vertex attribute buffer per geometry.
+        constexpr std::size_t minInstancedCount = 4;
 
         const int cellSize = getCellSize(mWorldspace);
         const float smallestDistanceToChunk = (size > 1 / 8.f) ? (size * cellSize) : 0.f;
         const float higherDistanceToChunk
             = activeGrid ? ((size < 1) ? 5 : 3) * cellSize * size + 1 : smallestDistanceToChunk + 1;
 
+        // Large statics of distant chunks are drawn as impostors instead of their meshes
+        std::vector<std::pair<osg::ref_ptr<osg::Node>, const PagedCellRef*>> impostors;
+        const bool useImpostors
+            = mImpostors != nullptr && !activeGrid && smallestDistanceToChunk >= mImpostorDistance * cellSize;
+
         AnalyzeVisitor analyzeVisitor(copyMask);
         const float minSize = mMinSizeMergeFactor ? mMinSize * mMinSizeMergeFactor : mMinSize;
         for (const auto& [refNum, ref] : refs)
@@ -845,6 +1190,17 @@ namespace MWRender
                 continue;
             }
 
+            if (useImpostors && (type == ESM::REC_STAT || type == ESM::REC_STAT4)
+                && radius2 >= mImpostorMinSize * mImpostorMinSize
+                && cnode->getNumChildrenRequiringUpdateTraversal() == 0)
+            {
+                if (osg::ref_ptr<osg::Node> impostor = mImpostors->getImpostor(model, *cnode))
+                {
+                    impostors.emplace_back(std::move(impostor), &ref);
+                    continue;
+                }
+            }
+
             const auto emplaced = nodes.emplace(std::move(cnode), InstanceList());
             if (emplaced.second)
             {
@@ -865,6 +1221,7 @@ namespace MWRender
         osg::ref_ptr<osg::Group> group = new osg::Group;
         osg::ref_ptr<osg::Group> mergeGroup = new osg::Group;
         osg::ref_ptr<Resource::TemplateMultiRef> templateRefs = new Resource::TemplateMultiRef;
+        osg::ref_ptr<PagedRefs> pagedRefs = new PagedRefs;
         osgUtil::StateToCompile stateToCompile(0, nullptr);
         CopyOp copyop(activeGrid, copyMask);
         for (const auto& pair : nodes)
@@ -882,31 +1239,76 @@ namespace MWRender
             const float minSizeMergeFactor2 = (1 - factor2) * mMinSizeMergeFactor + factor2;
             const float minSizeMerged = minSizeMergeFactor2 > 0 ? mMinSize * minSizeMergeFactor2 : mMinSize;
 
+            const auto isTooSmall = [&](const PagedCellRef& ref) {
+                return !activeGrid && minSizeMerged != minSize
+                    && cnode->getBound().radius2() * ref.mScale * ref.mScale
+                    < (viewPoint - ref.mPosition).length2() * minSizeMerged * minSizeMerged;
+            };
+
+            if (mInstancing && !activeGrid && pair.second.mInstances.size() >= minInstancedCount)
+            {
+                std::vector<osg::Matrixf> transforms;
+                std::vector<ESM::RefNum> instancedRefs;
+                float scaleSum = 0;
+                for (const PagedCellRef* refPtr : pair.second.mInstances)
+                {
+                    if (isTooSmall(*refPtr))
+                        continue;
+                    transforms.push_back(makeNodeMatrix(*refPtr, worldCenter));
+                    instancedRefs.push_back(refPtr->mRefNum);
+                    scaleSum += refPtr->mScale;
+                }
+
+                if (transforms.size() >= minInstancedCount)
+                {
+                    const float scale = scaleSum / transforms.size();
+                    copyop.setCopyFlags(osg::CopyOp::DEEP_COPY_NODES | osg::CopyOp::DEEP_COPY_DRAWABLES
+                        | osg::CopyOp::DEEP_COPY_PRIMITIVES);
+                    copyop.mOptimizeBillboards = false;
+                    copyop.mDistances = LODRange{ smallestDistanceToChunk, higherDistanceToChunk } / scale;
+                    copyop.mViewVector = (viewPoint - worldCenter);
+                    if (osg::ref_ptr<osg::Group> instanced = createInstancedNode(*cnode, transforms, copyop))
+                    {
+                        if (mDebugBatches)
+                        {
+                            DebugVisitor dv;
+                            instanced->accept(dv);
+                        }
+                        mSceneManager->recreateShaders(instanced, "objects", true, mInstancingProgramTemplate);
+                        mSceneManager->shareState(instanced);
+                        group->addChild(instanced);
+                        templateRefs->addRef(cnode);
+                        // Hiding an instance would need new per instance data
+                        pagedRefs->mRefs.insert(pagedRefs->mRefs.end(), instancedRefs.begin(), instancedRefs.end());
+                        pagedRefs->mFixed.insert(pagedRefs->mFixed.end(), instancedRefs.begin(), instancedRefs.end());
+                        if (compile)
+                        {
+                            stateToCompile._mode = osgUtil::GLObjectsVisitor::COMPILE_STATE_ATTRIBUTES
+                                | osgUtil::GLObjectsVisitor::COMPILE_DISPLAY_LISTS;
+                            instanced->accept(stateToCompile);
+                        }
+                        continue;
+                    }
+                }
+            }
+
             unsigned int numinstances = 0;
             for (const PagedCellRef* refPtr : pair.second.mInstances)
             {
                 const PagedCellRef& ref = *refPtr;
 
-                if (!activeGrid && minSizeMerged != minSize
-                    && cnode->getBound().radius2() * ref.mScale * ref.mScale
-                        < (viewPoint - ref.mPosition).length2() * minSizeMerged * minSizeMerged)
+                if (isTooSmall(ref))
                     continue;
 
                 const osg::Vec3f nodePos = ref.mPosition - worldCenter;
-                const osg::Quat nodeAttitude = osg::Quat(ref.mRotation.z(), osg::Vec3f(0, 0, -1))
-                    * osg::Quat(ref.mRotation.y(), osg::Vec3f(0, -1, 0))
-                    * osg::Quat(ref.mRotation.x(), osg::Vec3f(-1, 0, 0));
+                const osg::Quat nodeAttitude = makeNodeAttitude(ref);
                 const osg::Vec3f nodeScale(ref.mScale, ref.mScale, ref.mScale);
 
                 osg::ref_ptr<osg::Group> trans;
                 if (merge)
                 {
                     // Optimizer currently supports only MatrixTransforms.
-                    osg::Matrixf matrix;
-                    matrix.preMultTranslate(nodePos);
-                    matrix.preMultRotate(nodeAttitude);
-                    matrix.preMultScale(nodeScale);
-                    trans = new osg::MatrixTransform(matrix);
+                    trans = new osg::MatrixTransform(makeNodeMatrix(ref, worldCenter));
                     trans->setDataVariance(osg::Object::STATIC);
                 }
                 else
@@ -934,20 +1336,25 @@ namespace MWRender
                 copyop.copy(cnode, trans);
                 copyop.mNodePath.pop_back();
 
-                if (activeGrid)
+                if (merge)
                 {
-                    if (merge)
-                    {
-                        AddRefnumMarkerVisitor visitor(ref.mRefNum);
-                        trans->accept(visitor);
-                    }
-                    else
+                    // Outside of the active grid the markers are only used to find the vertices of merged objects
+                    AddRefnumMarkerVisitor visitor(ref.mRefNum);
+                    trans->accept(visitor);
+                    if (!visitor.mHideable)
+                        pagedRefs->mFixed.push_back(ref.mRefNum);
+                }
+                else
+                {
+                    if (activeGrid)
                     {
                         osg::ref_ptr<RefnumMarker> marker = new RefnumMarker;
                         marker->mRefnum = ref.mRefNum;
                         trans->getOrCreateUserDataContainer()->addUserObject(marker);
                     }
+                    pagedRefs->mNodes.emplace_back(ref.mRefNum, trans);
                 }
+                pagedRefs->mRefs.push_back(ref.mRefNum);
 
                 osg::Group* const attachTo = merge ? mergeGroup : group;
                 attachTo->addChild(trans);
@@ -970,6 +1377,18 @@ namespace MWRender
             }
         }
 
+        for (const auto& [impostor, ref] : impostors)
+        {
+            osg::ref_ptr<SceneUtil::PositionAttitudeTransform> trans = new SceneUtil::PositionAttitudeTransform;
+            trans->setPosition(ref->mPosition - worldCenter);
+            trans->setScale(osg::Vec3f(ref->mScale, ref->mScale, ref->mScale));
+            trans->setAttitude(makeNodeAttitude(*ref));
+            trans->addChild(impostor);
+            group->addChild(trans);
+            pagedRefs->mRefs.push_back(ref->mRefNum);
+            pagedRefs->mNodes.emplace_back(ref->mRefNum, trans);
+        }
+
         const osg::Vec3f relativeViewPoint = viewPoint - worldCenter;
 
         if (mergeGroup->getNumChildren())
@@ -986,6 +1405,9 @@ namespace MWRender
 
             optimizer.optimize(mergeGroup, options);
 
+            CollectMergedGeometriesVisitor collectMergedGeometries(*pagedRefs, !activeGrid);
+            mergeGroup->accept(collectMergedGeometries);
+
             group->addChild(mergeGroup);
 
             if (mDebugBatches)
@@ -1019,7 +1441,18 @@ namespace MWRender
             udc->addUserObject(refnumSet);
             group->addCullCallback(new SceneUtil::LightListCallback);
         }
+        if (mOcclusionCulling != nullptr)
+            group->addCullCallback(new SceneUtil::OcclusionCullCallback(mOcclusionCulling));
         udc->addUserObject(templateRefs);
+        const auto sortUnique = [](std::vector<ESM::RefNum>& refNums) {
+            std::sort(refNums.begin(), refNums.end());
+            refNums.erase(std::unique(refNums.begin(), refNums.end()), refNums.end());
+        };
+        sortUnique(pagedRefs->mRefs);
+        sortUnique(pagedRefs->mFixed);
+        std::sort(pagedRefs->mNodes.begin(), pagedRefs->mNodes.end(),
+            [](const auto& l, const auto& r) { return l.first < r.first; });
+        udc->addUserObject(pagedRefs);
 
         return group;
     }
@@ -1047,15 +1480,18 @@ namespace MWRender
             {
             }
 
-            void operator()(const ChunkId& id, osg::Object* /*obj*/)
+            void operator()(const ChunkId& id, osg::Object* obj)
             {
                 if (mActiveGridOnly && !std::get<2>(id))
                     return;
                 if (intersects(id))
-                    mCollected.push_back(id);
+                    mCollected.emplace_back(id, obj);
             }
 
-            const std::vector<ChunkId>& getCollected() const { return mCollected; }
+            const std::vector<std::pair<ChunkId, osg::ref_ptr<osg::Object>>>& getCollected() const
+            {
+                return mCollected;
+            }
 
         private:
             bool intersects(ChunkId id) const
@@ -1068,55 +1504,128 @@ namespace MWRender
 
             bool mActiveGridOnly;
             osg::Vec2f mPosition;
-            std::vector<ChunkId> mCollected;
+            std::vector<std::pair<ChunkId, osg::ref_ptr<osg::Object>>> mCollected;
         };
+
+        PagedRefs* getPagedRefs(osg::Object& chunk)
+        {
+            osg::UserDataContainer* const udc = chunk.getUserDataContainer();
+            if (udc == nullptr)
+                return nullptr;
+            for (unsigned int i = 0; i < udc->getNumUserObjects(); ++i)
+                if (PagedRefs* const refs = dynamic_cast<PagedRefs*>(udc->getUserObject(i)))
+                    return refs;
+            return nullptr;
+        }
+
+        /// Show or hide the object in the chunk without rebuilding it where possible.
+        ObjectPaging::ChunkChange setRefVisible(osg::Object& chunk, ESM::RefNum refNum, bool visible)
+        {
+            using ChunkChange = ObjectPaging::ChunkChange;
+
+            PagedRefs* const refs = getPagedRefs(chunk);
+            if (refs == nullptr)
+                return ChunkChange::Removed;
+            // An object not drawn by the chunk yet can only be added by a rebuild
+            if (!std::binary_search(refs->mRefs.begin(), refs->mRefs.end(), refNum))
+                return visible ? ChunkChange::Removed : ChunkChange::None;
+            if (std::binary_search(refs->mFixed.begin(), refs->mFixed.end(), refNum))
+                return ChunkChange::Removed;
+            if (visible ? refs->mHidden.erase(refNum) == 0 : !refs->mHidden.insert(refNum).second)
+                return ChunkChange::None;
+            // Hidden objects still take memory and vertex processing
+            if (refs->mHidden.size() * sMaxHiddenRatio > refs->mRefs.size())
+                return ChunkChange::Removed;
+
+            const auto isLess = [](const auto& node, ESM::RefNum value) { return node.first < value; };
+            for (auto it = std::lower_bound(refs->mNodes.begin(), refs->mNodes.end(), refNum, isLess);
+                 it != refs->mNodes.end() && it->first == refNum; ++it)
+                it->second->setNodeMask(visible ? ~0u : 0u);
+
+            for (PagedRefs::MergedGeometry& merged : refs->mMergedGeometries)
+            {
+                const auto hasRef = [&](const PagedRefs::Range& range) { return range.mRefNum == refNum; };
+                if (std::none_of(merged.mRanges.begin(), merged.mRanges.end(), hasRef))
+                    continue;
+
+                std::vector<bool> hidden(merged.mRanges.back().mFirst + merged.mRanges.back().mCount, false);
+                bool anyHidden = false;
+                for (const PagedRefs::Range& range : merged.mRanges)
+                {
+                    if (!refs->mHidden.contains(range.mRefNum))
+                        continue;
+                    std::fill_n(hidden.begin() + range.mFirst, range.mCount, true);
+                    anyHidden = true;
+                }
+
+                osg::ref_ptr<osg::Geometry> replacement
+                    = anyHidden ? hideVertices(*merged.mSource, hidden) : merged.mSource;
+                if (replacement == nullptr)
+                    return ChunkChange::Removed;
+
+                // The replaced geometry may still be drawn by the previous frame, so it's not changed in place
+                const osg::Node::ParentList parents = merged.mCurrent->getParents();
+                for (osg::Group* parent : parents)
+                    parent->replaceChild(merged.mCurrent, replacement);
+                merged.mCurrent = std::move(replacement);
+            }
+
+            return ChunkChange::Modified;
+        }
     }
 
-    bool ObjectPaging::enableObject(
+    ObjectPaging::ChunkChange ObjectPaging::enableObject(
         int type, ESM::RefNum refnum, const osg::Vec3f& pos, const osg::Vec2i& cell, bool enabled)
     {
         if (!typeFilter(type, false))
-            return false;
+            return ChunkChange::None;
 
         {
             std::lock_guard<std::mutex> lock(mRefTrackerMutex);
             if (enabled && !getWritableRefTracker().mDisabled.erase(refnum))
-                return false;
+                return ChunkChange::None;
             if (!enabled && !getWritableRefTracker().mDisabled.insert(refnum).second)
-                return false;
+                return ChunkChange::None;
             if (mRefTrackerLocked)
-                return false;
+                return ChunkChange::None;
         }
 
         CollectIntersecting ccf(false, pos, cell, mWorldspace);
         mCache->call(ccf);
-        if (ccf.getCollected().empty())
-            return false;
-        for (const ChunkId& chunk : ccf.getCollected())
-            mCache->removeFromObjectCache(chunk);
-        return true;
+        return updateChunks(ccf.getCollected(), refnum, enabled);
     }
 
-    bool ObjectPaging::blacklistObject(int type, ESM::RefNum refnum, const osg::Vec3f& pos, const osg::Vec2i& cell)
+    ObjectPaging::ChunkChange ObjectPaging::blacklistObject(
+        int type, ESM::RefNum refnum, const osg::Vec3f& pos, const osg::Vec2i& cell)
     {
         if (!typeFilter(type, false))
-            return false;
+            return ChunkChange::None;
 
         {
             std::lock_guard<std::mutex> lock(mRefTrackerMutex);
             if (!getWritableRefTracker().mBlacklist.insert(refnum).second)
-                return false;
+                return ChunkChange::None;
             if (mRefTrackerLocked)
-                return false;
+                return ChunkChange::None;
         }
 
         CollectIntersecting ccf(true, pos, cell, mWorldspace);
         mCache->call(ccf);
-        if (ccf.getCollected().empty())
-            return false;
-        for (const ChunkId& chunk : ccf.getCollected())
-            mCache->removeFromObjectCache(chunk);
-        return true;
+        return updateChunks(ccf.getCollected(), refnum, false);
+    }
+
+    ObjectPaging::ChunkChange ObjectPaging::updateChunks(
+        const std::vector<std::pair<ChunkId, osg::ref_ptr<osg::Object>>>& chunks, ESM::RefNum refnum, bool visible)
+    {
+        ChunkChange result = ChunkChange::None;
+        for (const auto& [chunk, object] : chunks)
+        {
+            const ChunkChange change = setRefVisible(*object, refnum, visible);
+            if (change == ChunkChange::Removed)
+                mCache->removeFromObjectCache(chunk);
+            result = std::max(result, change);
+        }
+        return result;
     }
 
     void ObjectPaging::clear()
@@ -1181,6 +1690,16 @@ namespace MWRender
         };
     }
 
+    void ObjectPaging::setOcclusionCulling(osg::ref_ptr<SceneUtil::OcclusionCulling> occlusionCulling)
+    {
+        mOcclusionCulling = std::move(occlusionCulling);
+    }
+
+    void ObjectPaging::setImpostors(std::shared_ptr<ImpostorCache> impostors)
+    {
+        mImpostors = std::move(impostors);
+    }
+
     void ObjectPaging::getPagedRefnums(const osg::Vec4i& activeGrid, std::vector<ESM::RefNum>& out)
     {
         GetRefnumsFunctor grf(out);
@@ -3,9 +3,16 @@
 
 #include <components/esm3/refnum.hpp>
 #include <components/resource/resourcemanager.hpp>
+#include <components/sceneutil/occlusionculling.hpp>
 #include <components/terrain/quadtreeworld.hpp>
 
+#include <osg/Program>
+
+#include <memory>
 #include <mutex>
+#include <set>
+#include <utility>
+#include <vector>
 
 namespace Resource
 {
@@ -14,6 +21,7 @@ namespace Resource
 
 namespace MWRender
 {
+    class ImpostorCache;
 
     typedef std::tuple<osg::Vec2f, float, bool> ChunkId; // Center, Size, ActiveGrid
 
@@ -31,11 +39,19 @@ namespace MWRender
 
         unsigned int getNodeMask() override;
 
-        /// @return true if view needs rebuild
-        bool enableObject(int type, ESM::RefNum refnum, const osg::Vec3f& pos, const osg::Vec2i& cell, bool enabled);
+        enum class ChunkChange
+        {
+            None,
+            /// Objects were shown or hidden in the cached chunks, views don't need a rebuild
+            Modified,
+            /// Chunks were removed from the cache, views need a rebuild
+            Removed,
+        };
 
-        /// @return true if view needs rebuild
-        bool blacklistObject(int type, ESM::RefNum refnum, const osg::Vec3f& pos, const osg::Vec2i& cell);
+        ChunkChange enableObject(
+            int type, ESM::RefNum refnum, const osg::Vec3f& pos, const osg::Vec2i& cell, bool enabled);
+
+        ChunkChange blacklistObject(int type, ESM::RefNum refnum, const osg::Vec3f& pos, const osg::Vec2i& cell);
 
         void clear();
 
@@ -47,6 +63,12 @@ namespace MWRender
 
         void getPagedRefnums(const osg::Vec4i& activeGrid, std::vector<ESM::RefNum>& out);
 
+        /// Cull the chunks created from now on that are hidden in the view culled by the given occlusion culling.
+        void setOcclusionCulling(osg::ref_ptr<SceneUtil::OcclusionCulling> occlusionCulling);
+
+        /// Draw large statics in distant chunks created from now on as impostors.
+        void setImpostors(std::shared_ptr<ImpostorCache> impostors);
+
     private:
         Resource::SceneManager* mSceneManager;
         bool mActiveGrid;
@@ -55,6 +77,12 @@ namespace MWRender
         float mMinSize;
         float mMinSizeMergeFactor;
         float mMinSizeCostMultiplier;
+        bool mInstancing;
+        osg::ref_ptr<osg::Program> mInstancingProgramTemplate;
+        osg::ref_ptr<SceneUtil::OcclusionCulling> mOcclusionCulling;
+        std::shared_ptr<ImpostorCache> mImpostors;
+        float mImpostorDistance;
+        float mImpostorMinSize;
 
         std::mutex mRefTrackerMutex;
         struct RefTracker
@@ -73,6 +101,9 @@ namespace MWRender
         const RefTracker& getRefTracker() const { return mRefTracker; }
         RefTracker& getWritableRefTracker() { return mRefTrackerLocked ? mRefTrackerNew : mRefTracker; }
 
+        ChunkChange updateChunks(const std::vector<std::pair<ChunkId, osg::ref_ptr<osg::Object>>>& chunks,
+            ESM::RefNum refnum, bool visible);
+
         std::mutex mSizeCacheMutex;
         typedef std::map<ESM::RefNum, float> SizeCache;
         SizeCache mSizeCache;
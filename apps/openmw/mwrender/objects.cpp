@@ -7,10 +7,13 @@
 
 #include <components/misc/resourcehelpers.hpp>
 #include <components/misc/strings/algorithm.hpp>
+#include <components/sceneutil/contributionculling.hpp>
+#include <components/sceneutil/occlusionculling.hpp>
 #include <components/sceneutil/positionattitudetransform.hpp>
 #include <components/sceneutil/unrefqueue.hpp>
 #include <components/sceneutil/workqueue.hpp>
 #include <components/esm/defs.hpp>
+#include <components/settings/values.hpp>
 
 #include "../mwworld/class.hpp"
 #include "../mwworld/ptr.hpp"
@@ -23,6 +26,38 @@
 
 namespace MWRender
 {
+    namespace
+    {
+        bool isLight(const MWWorld::Ptr& ptr)
+        {
+            return ptr.getType() == ESM::REC_LIGH || ptr.getType() == ESM::REC_LIGH4;
+        }
+
+        void addContributionCulling(const MWWorld::Ptr& ptr)
+        {
+            SceneUtil::ContributionThresholds thresholds;
+            const float shadowTexelSize = Settings::camera().mShadowCullingTexelSize;
+            const auto type = ptr.getType();
+            if (isLight(ptr))
+            {
+                // Culling a light in the main view would also turn off the light it casts
+                thresholds.mShadow = shadowTexelSize;
+            }
+            else if (type == ESM::REC_STAT || ptr.getClass().isItem(ptr))
+            {
+                const float pixelSize = type == ESM::REC_STAT ? Settings::camera().mStaticCullingPixelSize
+                                                              : Settings::camera().mClutterCullingPixelSize;
+                thresholds.mMain = pixelSize;
+                thresholds.mReflection = pixelSize * Settings::camera().mReflectionCullingScale;
+                thresholds.mShadow = shadowTexelSize;
+            }
+            else
+                return;
+
+            ptr.getRefData().getBaseNode()->addCullCallback(
+                new SceneUtil::ContributionCullCallback(thresholds, Settings::camera().mCullingHysteresis));
+        }
+    }
 
     class CellOptimizationWorkItem : public SceneUtil::WorkItem
     {
@@ -33,6 +68,7 @@ namespace MWRender
             , mBakeGroup(new osg::Group)
             , mAnyAdded(false)
         {
+            setPriority(SceneUtil::WorkPriority::Low);
         }
 
         void doWork() override
@@ -97,6 +133,11 @@ namespace MWRender
     {
     }
 
+    void Objects::setOcclusionCulling(osg::ref_ptr<SceneUtil::OcclusionCulling> occlusionCulling)
+    {
+        mOcclusionCulling = std::move(occlusionCulling);
+    }
+
     Objects::~Objects()
     {
         mObjects.clear();
@@ -157,6 +198,13 @@ namespace MWRender
         osg::ref_ptr<ObjectAnimation> anim(
             new ObjectAnimation(ptr, animationMesh, mResourceSystem, animated, allowLight));
 
+        if (Settings::camera().mContributionCulling)
+            addContributionCulling(ptr);
+
+        // Culling a light would also turn off the light it casts
+        if (mOcclusionCulling != nullptr && !isLight(ptr))
+            ptr.getRefData().getBaseNode()->addCullCallback(new SceneUtil::OcclusionCullCallback(mOcclusionCulling));
+
         mObjects.emplace(ptr.mRef, std::move(anim));
     }
 
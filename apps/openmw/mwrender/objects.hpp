@@ -27,6 +27,7 @@ namespace MWWorld
 
 namespace SceneUtil
 {
+    class OcclusionCulling;
     class UnrefQueue;
     class WorkQueue;
     class WorkItem;
@@ -68,6 +69,7 @@ namespace MWRender
         Resource::ResourceSystem* mResourceSystem;
         SceneUtil::UnrefQueue& mUnrefQueue;
         SceneUtil::WorkQueue* mWorkQueue;
+        osg::ref_ptr<SceneUtil::OcclusionCulling> mOcclusionCulling;
 
         void insertBegin(const MWWorld::Ptr& ptr);
 
@@ -76,6 +78,9 @@ namespace MWRender
             SceneUtil::UnrefQueue& unrefQueue, SceneUtil::WorkQueue* workQueue = nullptr);
         ~Objects();
 
+        /// Cull the objects inserted from now on that are hidden in the view culled by the given occlusion culling.
+        void setOcclusionCulling(osg::ref_ptr<SceneUtil::OcclusionCulling> occlusionCulling);
+
         /// @param allowLight If false, no lights will be created, and particles systems will be removed.
         void insertModel(const MWWorld::Ptr& ptr, const std::string& model, bool allowLight = true);
 
@@ -3,6 +3,7 @@
 #include <SDL_opengl_glext.h>
 #include <algorithm>
 #include <chrono>
+#include <map>
 #include <thread>
 
 #include <osg/Texture1D>
@@ -18,6 +19,7 @@
 #include <components/resource/scenemanager.hpp>
 #include <components/sceneutil/color.hpp>
 #include <components/sceneutil/depth.hpp>
+#include <components/sceneutil/gputimer.hpp>
 #include <components/sceneutil/nodecallback.hpp>
 #include <components/settings/values.hpp>
 #include <components/shader/shadermanager.hpp>
@@ -108,6 +110,19 @@ namespace
         return Stereo::createMultiviewCompatibleAttachment(texture);
     }
 
+    bool canShareTexture(const Fx::Types::RenderTarget& left, const Fx::Types::RenderTarget& right)
+    {
+        const osg::Texture2D& l = *left.mTarget;
+        const osg::Texture2D& r = *right.mTarget;
+        return left.mSize == right.mSize && left.mMipMap == right.mMipMap
+            && l.getInternalFormat() == r.getInternalFormat() && l.getSourceFormat() == r.getSourceFormat()
+            && l.getSourceType() == r.getSourceType()
+            && l.getFilter(osg::Texture::MIN_FILTER) == r.getFilter(osg::Texture::MIN_FILTER)
+            && l.getFilter(osg::Texture::MAG_FILTER) == r.getFilter(osg::Texture::MAG_FILTER)
+            && l.getWrap(osg::Texture::WRAP_S) == r.getWrap(osg::Texture::WRAP_S)
+            && l.getWrap(osg::Texture::WRAP_T) == r.getWrap(osg::Texture::WRAP_T);
+    }
+
     constexpr float DistortionRatio = 0.25;
 }
 
@@ -135,6 +150,7 @@ namespace MWRender
 
         mHUDCamera->setReferenceFrame(osg::Camera::ABSOLUTE_RF);
         mHUDCamera->setRenderOrder(osg::Camera::POST_RENDER);
+        SceneUtil::addGpuTimer(*mHUDCamera, "GPU PostProcessing");
         mHUDCamera->setClearColor(osg::Vec4(0.45f, 0.45f, 0.14f, 1.f));
         mHUDCamera->setClearMask(0);
         mHUDCamera->setProjectionMatrix(osg::Matrix::ortho2D(0, 1, 0, 1));
@@ -567,6 +583,9 @@ namespace MWRender
         mPassLights = false;
 
         std::vector<Fx::Types::RenderTarget> attachmentsToDirty;
+        // Techniques run one after another, so the transient render targets of different techniques can use the same
+        // texture
+        std::vector<Fx::Types::RenderTarget> transientTargets;
 
         for (const auto& technique : mTechniques)
         {
@@ -610,6 +629,31 @@ namespace MWRender
 
             node.mRootStateSet->addUniform(new osg::Uniform("omw_SamplerDistortion", Unit_Distortion));
 
+            std::map<std::string, Fx::Types::RenderTarget, std::less<>> renderTargets;
+            std::vector<const osg::Texture2D*> claimedTargets;
+            auto getRenderTarget = [&](const std::string& name) -> const Fx::Types::RenderTarget& {
+                auto found = renderTargets.find(name);
+                if (found != renderTargets.end())
+                    return found->second;
+
+                Fx::Types::RenderTarget renderTarget = technique->getRenderTargetsMap()[name];
+                if (renderTarget.mTransient)
+                {
+                    auto shared = std::find_if(transientTargets.begin(), transientTargets.end(), [&](const auto& rt) {
+                        return canShareTexture(rt, renderTarget)
+                            && std::find(claimedTargets.begin(), claimedTargets.end(), rt.mTarget.get())
+                            == claimedTargets.end();
+                    });
+                    if (shared != transientTargets.end())
+                        renderTarget.mTarget = shared->mTarget;
+                    else
+                        transientTargets.push_back(renderTarget);
+                    claimedTargets.push_back(renderTarget.mTarget.get());
+                }
+
+                return renderTargets.emplace(name, std::move(renderTarget)).first->second;
+            };
+
             int texUnit = Unit_NextFree;
 
             // user-defined samplers
@@ -647,7 +691,7 @@ namespace MWRender
 
                 if (!pass->getTarget().empty())
                 {
-                    auto& renderTarget = technique->getRenderTargetsMap()[pass->getTarget()];
+                    const auto& renderTarget = getRenderTarget(pass->getTarget());
                     subPass.mSize = renderTarget.mSize;
                     subPass.mRenderTexture = renderTarget.mTarget;
                     subPass.mMipMap = renderTarget.mMipMap;
@@ -685,7 +729,7 @@ namespace MWRender
                         continue;
                     }
 
-                    auto& renderTarget = technique->getRenderTargetsMap()[name];
+                    const auto& renderTarget = getRenderTarget(name);
                     subPass.mStateSet->setTextureAttribute(subTexUnit, renderTarget.mTarget);
                     subPass.mStateSet->addUniform(new osg::Uniform(name.c_str(), subTexUnit));
 
@@ -857,6 +901,11 @@ namespace MWRender
             dirtyTechniques();
     }
 
+    void PostProcessor::setOcclusionCulling(osg::ref_ptr<SceneUtil::OcclusionCulling> occlusionCulling)
+    {
+        mTransparentDepthPostPass->mOcclusionCulling = std::move(occlusionCulling);
+    }
+
     int PostProcessor::renderWidth() const
     {
         if (Stereo::getStereo())
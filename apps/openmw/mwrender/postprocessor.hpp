@@ -30,6 +30,11 @@ namespace osgViewer
     class Viewer;
 }
 
+namespace SceneUtil
+{
+    class OcclusionCulling;
+}
+
 namespace Stereo
 {
     class MultiviewFramebuffer;
@@ -195,6 +200,9 @@ namespace MWRender
 
         void disableDynamicShaders();
 
+        /// Read back the opaque depth of the scene for occlusion culling.
+        void setOcclusionCulling(osg::ref_ptr<SceneUtil::OcclusionCulling> occlusionCulling);
+
         int renderWidth() const;
         int renderHeight() const;
 
@@ -61,6 +61,8 @@ namespace MWRender
         mPlayerDynamicShadows = settings.mPlayerDynamicShadows;
         mObjectDynamicShadows = settings.mObjectDynamicShadows;
 
+        const int previousResolution = mProbeTexture ? mProbeTexture->getTextureWidth() : 0;
+
         // Adjust settings based on quality level
         switch (mQuality)
         {
@@ -80,7 +82,7 @@ namespace MWRender
                 break;
         }
 
-        if (mEnabled && !mProbeTexture)
+        if (mEnabled && (!mProbeTexture || previousResolution != mProbeGridResolution))
         {
             createProbeGrid();
         }
@@ -88,6 +90,11 @@ namespace MWRender
         {
             clearResources();
         }
+        else if (mProbeTexture)
+        {
+            mGIIntensityUniform->set(mIntensity);
+            mProbeGridSizeUniform->set(mMaxDistance);
+        }
     }
 
     void RadianceHints::createProbeGrid()
@@ -121,7 +128,7 @@ namespace MWRender
         // Create uniforms
         mProbeUniform = new osg::Uniform("radianceProbes", 8); // Texture unit 8
         mGIIntensityUniform = new osg::Uniform("giIntensity", mIntensity);
-        mProbeGridCenterUniform = new osg::Uniform("probeGridCenter", osg::Vec3f(0, 0, 0));
+        mProbeGridCenterUniform = new osg::Uniform("probeGridCenter", mLastProbeCenter);
         mProbeGridSizeUniform = new osg::Uniform("probeGridSize", mMaxDistance);
     }
 
@@ -151,17 +158,19 @@ namespace MWRender
 
     void RadianceHints::updateProbes(const osg::Vec3f& center)
     {
-        // Only update if player has moved significantly
-        osg::Vec3f delta = center - mLastProbeCenter;
-        float moveThreshold = mMaxDistance / (mProbeGridResolution * 2.0f);
+        // Keep the grid aligned to the probe spacing in world space, so moving the grid shifts it by whole slabs of
+        // probes and the probes that stay inside keep their position instead of being resampled elsewhere
+        const float spacing = mMaxDistance / mProbeGridResolution;
+        const osg::Vec3f snapped(std::round(center.x() / spacing) * spacing, std::round(center.y() / spacing) * spacing,
+            std::round(center.z() / spacing) * spacing);
 
-        if (delta.length() < moveThreshold)
+        if (snapped == mLastProbeCenter)
             return;
 
-        mLastProbeCenter = center;
+        mLastProbeCenter = snapped;
 
         if (mProbeGridCenterUniform)
-            mProbeGridCenterUniform->set(center);
+            mProbeGridCenterUniform->set(snapped);
 
         // In a full implementation, this would:
         // 1. Render scene from probe positions
@@ -35,10 +35,14 @@
 
 #include <components/sceneutil/cullsafeboundsvisitor.hpp>
 #include <components/sceneutil/depth.hpp>
+#include <components/sceneutil/gputimer.hpp>
 #include <components/sceneutil/lightmanager.hpp>
+#include <components/sceneutil/occlusionculling.hpp>
+#include <components/sceneutil/parallelcull.hpp>
 #include <components/sceneutil/positionattitudetransform.hpp>
 #include <components/sceneutil/rtt.hpp>
 #include <components/sceneutil/shadow.hpp>
+#include <components/sceneutil/shareduniforms.hpp>
 #include <components/sceneutil/statesetupdater.hpp>
 #include <components/sceneutil/visitor.hpp>
 #include <components/sceneutil/workqueue.hpp>
@@ -75,13 +79,16 @@
 #include "effectmanager.hpp"
 #include "entityculling.hpp"
 #include "fogmanager.hpp"
+#include "grassinteraction.hpp"
 #include "groundcover.hpp"
+#include "impostors.hpp"
 #include "navmesh.hpp"
 #include "npcanimation.hpp"
 #include "objectpaging.hpp"
 #include "pathgrid.hpp"
 #include "postprocessor.hpp"
 #include "radiancehints.hpp"
+#include "renderbin.hpp"
 #include "recastmesh.hpp"
 #include "screenshotmanager.hpp"
 #include "sky.hpp"
@@ -161,53 +168,45 @@ namespace MWRender
     class SharedUniformStateUpdater : public SceneUtil::StateSetUpdater
     {
     public:
-        SharedUniformStateUpdater()
-            : mNear(0.f)
-            , mFar(0.f)
-            , mWindSpeed(0.f)
+        SharedUniformStateUpdater(bool useUBO)
+            : mUseUBO(useUBO)
             , mSkyBlendingStartCoef(Settings::fog().mSkyBlendingStart)
         {
         }
 
         void setDefaults(osg::StateSet* stateset) override
         {
-            stateset->addUniform(new osg::Uniform("near", 0.f));
-            stateset->addUniform(new osg::Uniform("far", 0.f));
-            stateset->addUniform(new osg::Uniform("skyBlendingStart", 0.f));
-            stateset->addUniform(new osg::Uniform("screenRes", osg::Vec2f{}));
+            SceneUtil::addSharedUniforms(*stateset, mData, mUseUBO);
             stateset->addUniform(new osg::Uniform("isReflection", false));
-            stateset->addUniform(new osg::Uniform("windSpeed", 0.0f));
-            stateset->addUniform(new osg::Uniform("playerPos", osg::Vec3f(0.f, 0.f, 0.f)));
             stateset->addUniform(new osg::Uniform("useTreeAnim", false));
         }
 
         void apply(osg::StateSet* stateset, osg::NodeVisitor* nv) override
         {
-            stateset->getUniform("near")->set(mNear);
-            stateset->getUniform("far")->set(mFar);
-            stateset->getUniform("skyBlendingStart")->set(mFar * mSkyBlendingStartCoef);
-            stateset->getUniform("screenRes")->set(mScreenRes);
-            stateset->getUniform("windSpeed")->set(mWindSpeed);
-            stateset->getUniform("playerPos")->set(mPlayerPos);
+            SceneUtil::setSharedUniforms(*stateset, mData, mUseUBO);
         }
 
-        void setNear(float near) { mNear = near; }
+        void setNear(float near) { mData.get<SceneUtil::SharedUniform::Near>() = near; }
 
-        void setFar(float far) { mFar = far; }
+        void setFar(float far)
+        {
+            mData.get<SceneUtil::SharedUniform::Far>() = far;
+            mData.get<SceneUtil::SharedUniform::SkyBlendingStart>() = far * mSkyBlendingStartCoef;
+        }
 
-        void setScreenRes(float width, float height) { mScreenRes = osg::Vec2f(width, height); }
+        void setScreenRes(float width, float height)
+        {
+            mData.get<SceneUtil::SharedUniform::ScreenRes>() = osg::Vec2f(width, height);
+        }
 
-        void setWindSpeed(float windSpeed) { mWindSpeed = windSpeed; }
+        void setWindSpeed(float windSpeed) { mData.get<SceneUtil::SharedUniform::WindSpeed>() = windSpeed; }
 
-        void setPlayerPos(osg::Vec3f playerPos) { mPlayerPos = playerPos; }
+        void setPlayerPos(osg::Vec3f playerPos) { mData.get<SceneUtil::SharedUniform::PlayerPos>() = playerPos; }
 
     private:
-        float mNear;
-        float mFar;
-        float mWindSpeed;
+        bool mUseUBO;
         float mSkyBlendingStartCoef;
-        osg::Vec3f mPlayerPos;
-        osg::Vec2f mScreenRes;
+        SceneUtil::SharedUniformData mData;
     };
 
     class StateUpdater : public SceneUtil::StateSetUpdater
@@ -311,7 +310,7 @@ namespace MWRender
     RenderingManager::RenderingManager(osgViewer::Viewer* viewer, osg::ref_ptr<osg::Group> rootNode,
         Resource::ResourceSystem* resourceSystem, SceneUtil::WorkQueue* workQueue,
         DetourNavigator::Navigator& navigator, const MWWorld::GroundcoverStore& groundcoverStore,
-        SceneUtil::UnrefQueue& unrefQueue)
+        SceneUtil::UnrefQueue& unrefQueue, const std::filesystem::path& userDataPath)
         : mSkyBlending(Settings::fog().mSkyBlending)
         , mViewer(viewer)
         , mRootNode(rootNode)
@@ -328,6 +327,7 @@ namespace MWRender
         , mFieldOfView(Settings::camera().mFieldOfView)
         , mFirstPersonFieldOfView(Settings::camera().mFirstPersonFieldOfView)
         , mGroundCoverStore(groundcoverStore)
+        , mCompositeMapCachePath(userDataPath / "compositemaps")
     {
         bool reverseZ = SceneUtil::AutoDepth::isReversed();
         const SceneUtil::LightingMethod lightingMethod = Settings::shaders().mLightingMethod;
@@ -395,6 +395,13 @@ namespace MWRender
         resourceSystem->getSceneManager()->setConvertAlphaTestToAlphaToCoverage(shouldAddMSAAIntermediateTarget());
         resourceSystem->getSceneManager()->setAdjustCoverageForAlphaTest(
             Settings::shaders().mAdjustCoverageForAlphaTest);
+        resourceSystem->getSceneManager()->setGpuSkinning(Settings::shaders().mGpuSkinning);
+        resourceSystem->getSceneManager()->setGpuMorphing(Settings::shaders().mGpuMorphing);
+
+        int clusterTextureUnit = -1;
+        if (lightingMethod == SceneUtil::LightingMethod::Clustered)
+            clusterTextureUnit = resourceSystem->getSceneManager()->getShaderManager().reserveGlobalTextureUnits(
+                Shader::ShaderManager::Slot::LightClusters);
 
         // Let LightManager choose which backend to use based on our hint. For methods besides legacy lighting, this
         // depends on support for various OpenGL extensions.
@@ -404,6 +411,15 @@ namespace MWRender
             .mMaximumLightDistance = Settings::shaders().mMaximumLightDistance,
             .mLightFadeStart = Settings::shaders().mLightFadeStart,
             .mLightBoundsMultiplier = Settings::shaders().mLightBoundsMultiplier,
+            .mClustering = SceneUtil::LightClustering::Settings{
+                .clustersX = Settings::lightClustering().mClustersX,
+                .clustersY = Settings::lightClustering().mClustersY,
+                .clustersZ = Settings::lightClustering().mClustersZ,
+                .maxLightsPerCluster = Settings::lightClustering().mMaxLightsPerCluster,
+                .clusterNear = Settings::lightClustering().mClusterNear,
+                .clusterFar = Settings::lightClustering().mClusterFar,
+            },
+            .mClusterTextureUnit = clusterTextureUnit,
         });
         resourceSystem->getSceneManager()->setLightingMethod(sceneRoot->getLightingMethod());
         resourceSystem->getSceneManager()->setSupportedLightingMethods(sceneRoot->getSupportedLightingMethods());
@@ -430,6 +446,12 @@ namespace MWRender
             indoorShadowCastingTraversalMask, Mask_Terrain | Mask_Object | Mask_Static, Settings::shadows(),
             mResourceSystem->getSceneManager()->getShaderManager());
 
+        const int staticShadowCastingMask = Mask_Static | Mask_Terrain;
+        if (Settings::shadows().mStaticShadowCache && (shadowCastingTraversalMask & staticShadowCastingMask) != 0)
+            mShadowManager->setStaticShadowCastingMasks(
+                shadowCastingTraversalMask & (Mask_Scene | staticShadowCastingMask),
+                shadowCastingTraversalMask & ~staticShadowCastingMask);
+
         Shader::ShaderManager::DefineMap shadowDefines = mShadowManager->getShadowDefines(Settings::shadows());
         Shader::ShaderManager::DefineMap lightDefines = sceneRoot->getLightDefines();
         Shader::ShaderManager::DefineMap globalDefines
@@ -462,6 +484,16 @@ namespace MWRender
         globalDefines["groundcoverStompMode"] = std::to_string(Settings::groundcover().mStompMode);
         globalDefines["groundcoverStompIntensity"] = std::to_string(Settings::groundcover().mStompIntensity);
 
+        bool grassInteraction = false;
+        if (Settings::game().mGrassInteraction && Settings::groundcover().mEnabled)
+        {
+            getGrassInteractionSystem().setTextureUnit(
+                resourceSystem->getSceneManager()->getShaderManager().reserveGlobalTextureUnits(
+                    Shader::ShaderManager::Slot::GrassInteraction));
+            grassInteraction = true;
+        }
+        globalDefines["grassInteraction"] = grassInteraction ? "1" : "0";
+
         globalDefines["reverseZ"] = reverseZ ? "1" : "0";
 
         // It is unnecessary to stop/start the viewer as no frames are being rendered yet.
@@ -473,7 +505,16 @@ namespace MWRender
         mRecastMesh = std::make_unique<RecastMesh>(mRootNode, Settings::navigator().mEnableRecastMeshRender);
         mPathgrid = std::make_unique<Pathgrid>(mRootNode);
 
+        // Only the main view has its depth read back, eye views are not culled
+        if (Settings::camera().mOcclusionCulling && !Stereo::getStereo())
+            mOcclusionCulling = new SceneUtil::OcclusionCulling;
+
         mObjects = std::make_unique<Objects>(mResourceSystem, sceneRoot, unrefQueue, workQueue);
+        mObjects->setOcclusionCulling(mOcclusionCulling);
+
+        if (Settings::terrain().mObjectPaging && Settings::terrain().mObjectPagingImpostors)
+            mImpostors = std::make_shared<ImpostorCache>(mRootNode, sceneRoot, *mResourceSystem->getSceneManager(),
+                Settings::terrain().mObjectPagingImpostorResolution);
 
         if (getenv("OPENMW_DONT_PRECOMPILE") == nullptr)
         {
@@ -506,7 +547,8 @@ namespace MWRender
         mStateUpdater = new StateUpdater;
         sceneRoot->addUpdateCallback(mStateUpdater);
 
-        mSharedUniformStateUpdater = new SharedUniformStateUpdater();
+        mSharedUniformStateUpdater
+            = new SharedUniformStateUpdater(mResourceSystem->getSceneManager()->getUseUniformBuffers());
         rootNode->addUpdateCallback(mSharedUniformStateUpdater);
 
         mPerViewUniformStateUpdater = new PerViewUniformStateUpdater(mResourceSystem->getSceneManager());
@@ -519,6 +561,18 @@ namespace MWRender
         resourceSystem->getSceneManager()->setSupportsNormalsRT(mPostProcessor->getSupportsNormalsRT());
         resourceSystem->getSceneManager()->setWeatherParticleOcclusion(Settings::shaders().mWeatherParticleOcclusion);
 
+        if (mOcclusionCulling)
+        {
+            mPostProcessor->setOcclusionCulling(mOcclusionCulling);
+            mViewer->getCamera()->addCullCallback(new SceneUtil::OcclusionCameraCullCallback(mOcclusionCulling));
+
+            // The opaque depth is read back when the depth sorted bin is drawn, which it is not if it is empty
+            osg::ref_ptr<osg::Node> dummyNodeToReadBack = new osg::Node;
+            dummyNodeToReadBack->setCullingActive(false);
+            dummyNodeToReadBack->getOrCreateStateSet()->setRenderBinDetails(RenderBin_DepthSorted, "DepthSortedBin");
+            mRootNode->addChild(dummyNodeToReadBack);
+        }
+
         // water goes after terrain for correct waterculling order
         mWater = std::make_unique<Water>(
             sceneRoot->getParent(0), sceneRoot, mResourceSystem, mViewer->getIncrementalCompileOperation());
@@ -580,6 +634,12 @@ namespace MWRender
 
         mViewer->getCamera()->setComputeNearFarMode(osg::Camera::DO_NOT_COMPUTE_NEAR_FAR);
         mViewer->getCamera()->setCullingMode(cullingMode);
+
+        if (const int threads = Settings::camera().mParallelCullThreads; threads > 0)
+        {
+            mParallelCull = std::make_unique<SceneUtil::ParallelCull>(static_cast<std::size_t>(threads));
+            mRootNode->addCullCallback(new SceneUtil::ParallelCull::JoinCallback);
+        }
         mViewer->getCamera()->setName(Constants::SceneCamera);
 
         auto mask = ~(Mask_UpdateVisitor | Mask_SimpleWater);
@@ -587,6 +647,8 @@ namespace MWRender
         NifOsg::Loader::setHiddenNodeMask(Mask_UpdateVisitor);
         NifOsg::Loader::setIntersectionDisabledNodeMask(Mask_Effect);
         NifOsg::Loader::setSoftEffectEnabled(Settings::shaders().mSoftParticles);
+        NifOsg::Loader::setParallelMeshBuilding(Settings::cells().mParallelMeshBuilding);
+        NifOsg::Loader::setOptimizeVertexCache(Settings::cells().mOptimizeVertexCache);
         Nif::Reader::setLoadUnsupportedFiles(Settings::models().mLoadUnsupportedNifFiles);
 
         mStateUpdater->setFogEnd(mViewDistance);
@@ -623,12 +685,25 @@ namespace MWRender
 
         // Initialize VRAM Management system
         mVRAMManagement = std::make_unique<VRAMManagement>(mResourceSystem);
+        mViewer->getCamera()->getGraphicsContext()->add(mVRAMManagement->getOperation());
+        mVRAMManagement->setShedder(VRAMManagement::ShedStep::ObjectCache,
+            [this] { mResourceSystem->expireCache(getReferenceTime(), 0.0); });
+        mVRAMManagement->setShedder(VRAMManagement::ShedStep::Terrain, [this] {
+            if (mTerrain)
+                mTerrain->clearAssociatedCaches();
+        });
+        if (mVRAMManagement->isTextureStreamingEnabled())
+        {
+            mTextureStreaming = std::make_unique<TextureStreaming>(mResourceSystem, mWorkQueue.get());
+            mViewer->getCamera()->getGraphicsContext()->add(mTextureStreaming->getOperation());
+        }
     }
 
     RenderingManager::~RenderingManager()
     {
         // let background loading thread finish before we delete anything else
         mWorkQueue = nullptr;
+        mParallelCull = nullptr;
     }
 
     osgUtil::IncrementalCompileOperation* RenderingManager::getIncrementalCompileOperation()
@@ -659,6 +734,7 @@ namespace MWRender
     void RenderingManager::preloadCommonAssets()
     {
         osg::ref_ptr<PreloadCommonAssetsWorkItem> workItem(new PreloadCommonAssetsWorkItem(mResourceSystem));
+        workItem->setPriority(SceneUtil::WorkPriority::High);
         mSky->listAssetsToPreload(workItem->mModels, workItem->mTextures);
         mWater->listAssetsToPreload(workItem->mTextures);
 
@@ -801,6 +877,7 @@ namespace MWRender
         {
             enableTerrain(true, store->getCell()->getWorldSpace());
             mTerrain->loadCell(store->getCell()->getGridX(), store->getCell()->getGridY());
+            mShadowManager->invalidateStaticShadowCache();
         }
     }
     void RenderingManager::removeCell(const MWWorld::CellStore* store)
@@ -813,6 +890,7 @@ namespace MWRender
         {
             getWorldspaceChunkMgr(store->getCell()->getWorldSpace())
                 .mTerrain->unloadCell(store->getCell()->getGridX(), store->getCell()->getGridY());
+            mShadowManager->invalidateStaticShadowCache();
         }
 
         mWater->removeCell(store);
@@ -936,8 +1014,13 @@ namespace MWRender
             float windSpeed = mSky->getBaseWindSpeed();
             mSharedUniformStateUpdater->setWindSpeed(windSpeed);
             mSharedUniformStateUpdater->setPlayerPos(playerPos);
+
+            getGrassInteractionSystem().update(dt, playerPos);
         }
 
+        if (mImpostors)
+            mImpostors->update();
+
         updateNavMesh();
         updateRecastMesh();
 
@@ -979,6 +1062,11 @@ namespace MWRender
             mVRAMManagement->update(dt);
         }
 
+        if (mTextureStreaming)
+            mTextureStreaming->update(
+                dt, *mSceneRoot, *mViewer->getCamera(),
+                mVRAMManagement->getTextureStreamingBudget(mTextureStreaming->getResidentSize()));
+
         bool isUnderwater = mWater->isUnderwater(mCamera->getPosition());
 
         float fogStart = mFog->getFogStart(isUnderwater);
@@ -1517,10 +1605,15 @@ namespace MWRender
             auto quadTreeWorld = std::make_unique<Terrain::QuadTreeWorld>(mSceneRoot, mRootNode, mResourceSystem,
                 mTerrainStorage.get(), Mask_Terrain, Mask_PreCompile, Mask_Debug, compMapResolution, compMapLevel,
                 lodFactor, vertexLodMod, maxCompGeometrySize, debugChunks, worldspace, expiryDelay);
+            quadTreeWorld->setViewUpdateBudget(Settings::terrain().mViewUpdateBudget);
+            if (Settings::terrain().mGeomorphing)
+                quadTreeWorld->enableGeomorphing();
             if (Settings::terrain().mObjectPaging)
             {
                 newChunkMgr.mObjectPaging
                     = std::make_unique<ObjectPaging>(mResourceSystem->getSceneManager(), worldspace);
+                newChunkMgr.mObjectPaging->setOcclusionCulling(mOcclusionCulling);
+                newChunkMgr.mObjectPaging->setImpostors(mImpostors);
                 quadTreeWorld->addChunkManager(newChunkMgr.mObjectPaging.get());
                 mResourceSystem->addResourceManager(newChunkMgr.mObjectPaging.get());
             }
@@ -1540,6 +1633,11 @@ namespace MWRender
             newChunkMgr.mTerrain = std::make_unique<Terrain::TerrainGrid>(mSceneRoot, mRootNode, mResourceSystem,
                 mTerrainStorage.get(), Mask_Terrain, worldspace, expiryDelay, Mask_PreCompile, Mask_Debug);
 
+        if (Settings::terrain().mCompositeMapCache)
+            newChunkMgr.mTerrain->enableCompositeMapCache(mCompositeMapCachePath);
+        if (Settings::terrain().mTextureArrays)
+            newChunkMgr.mTerrain->enableTextureArrays();
+
         newChunkMgr.mTerrain->setTargetFrameRate(Settings::cells().mTargetFramerate);
         float distanceMult = std::cos(osg::DegreesToRadians(std::min(mFieldOfView, 140.f)) / 2.f);
         newChunkMgr.mTerrain->setViewDistance(mViewDistance * (distanceMult ? 1.f / distanceMult : 1.f));
@@ -1555,6 +1653,11 @@ namespace MWRender
         if (stats->collectStats("resource"))
         {
             mTerrain->reportStats(frameNumber, stats);
+            mVRAMManagement->reportStats(frameNumber, *stats);
+            mEffectManager->reportStats(frameNumber, *stats);
+            SceneUtil::reportGpuTimers(frameNumber, *stats);
+            if (mTextureStreaming)
+                mTextureStreaming->reportStats(frameNumber, *stats);
         }
     }
 
@@ -1855,13 +1958,16 @@ namespace MWRender
     {
         if (!ptr.isInCell() || !ptr.getCell()->isExterior() || !mObjectPaging)
             return false;
-        if (mObjectPaging->enableObject(type, ptr.getCellRef().getRefNum(), ptr.getCellRef().getPosition().asVec3(),
-                osg::Vec2i(ptr.getCell()->getCell()->getGridX(), ptr.getCell()->getCell()->getGridY()), enabled))
-        {
-            mTerrain->rebuildViews();
-            return true;
-        }
-        return false;
+        const ObjectPaging::ChunkChange change = mObjectPaging->enableObject(type, ptr.getCellRef().getRefNum(),
+            ptr.getCellRef().getPosition().asVec3(),
+            osg::Vec2i(ptr.getCell()->getCell()->getGridX(), ptr.getCell()->getCell()->getGridY()), enabled);
+        if (change == ObjectPaging::ChunkChange::None)
+            return false;
+        mShadowManager->invalidateStaticShadowCache();
+        if (change == ObjectPaging::ChunkChange::Modified)
+            return false;
+        mTerrain->rebuildViews();
+        return true;
     }
     void RenderingManager::pagingBlacklistObject(int type, const MWWorld::ConstPtr& ptr)
     {
@@ -1870,8 +1976,13 @@ namespace MWRender
         ESM::RefNum refnum = ptr.getCellRef().getRefNum();
         if (!refnum.hasContentFile())
             return;
-        if (mObjectPaging->blacklistObject(type, refnum, ptr.getCellRef().getPosition().asVec3(),
-                osg::Vec2i(ptr.getCell()->getCell()->getGridX(), ptr.getCell()->getCell()->getGridY())))
+        const ObjectPaging::ChunkChange change = mObjectPaging->blacklistObject(type, refnum,
+            ptr.getCellRef().getPosition().asVec3(),
+            osg::Vec2i(ptr.getCell()->getCell()->getGridX(), ptr.getCell()->getCell()->getGridY()));
+        if (change == ObjectPaging::ChunkChange::None)
+            return;
+        mShadowManager->invalidateStaticShadowCache();
+        if (change == ObjectPaging::ChunkChange::Removed)
             mTerrain->rebuildViews();
     }
     bool RenderingManager::pagingUnlockCache()
@@ -1879,6 +1990,7 @@ namespace MWRender
         if (mObjectPaging && mObjectPaging->unlockCache())
         {
             mTerrain->rebuildViews();
+            mShadowManager->invalidateStaticShadowCache();
             return true;
         }
         return false;
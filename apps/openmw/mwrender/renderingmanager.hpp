@@ -18,6 +18,7 @@
 #include <osgUtil/IncrementalCompileOperation>
 
 #include <deque>
+#include <filesystem>
 #include <memory>
 #include <span>
 #include <unordered_map>
@@ -64,8 +65,10 @@ namespace Fallback
 namespace SceneUtil
 {
     class ShadowManager;
+    class ParallelCull;
     class WorkQueue;
     class LightManager;
+    class OcclusionCulling;
     class UnrefQueue;
 }
 
@@ -108,6 +111,7 @@ namespace MWRender
     class ActorsPaths;
     class RecastMesh;
     class ObjectPaging;
+    class ImpostorCache;
     class Groundcover;
     class PostProcessor;
 
@@ -117,7 +121,7 @@ namespace MWRender
         RenderingManager(osgViewer::Viewer* viewer, osg::ref_ptr<osg::Group> rootNode,
             Resource::ResourceSystem* resourceSystem, SceneUtil::WorkQueue* workQueue,
             DetourNavigator::Navigator& navigator, const MWWorld::GroundcoverStore& groundcoverStore,
-            SceneUtil::UnrefQueue& unrefQueue);
+            SceneUtil::UnrefQueue& unrefQueue, const std::filesystem::path& userDataPath);
         ~RenderingManager();
 
         osgUtil::IncrementalCompileOperation* getIncrementalCompileOperation();
@@ -322,6 +326,8 @@ namespace MWRender
         std::unique_ptr<ActorsPaths> mActorsPaths;
         std::unique_ptr<RecastMesh> mRecastMesh;
         std::unique_ptr<Pathgrid> mPathgrid;
+        osg::ref_ptr<SceneUtil::OcclusionCulling> mOcclusionCulling;
+        std::shared_ptr<ImpostorCache> mImpostors;
         std::unique_ptr<Objects> mObjects;
         std::unique_ptr<Water> mWater;
         std::unordered_map<ESM::RefId, WorldspaceChunkMgr> mWorldspaceChunks;
@@ -356,11 +362,14 @@ namespace MWRender
         bool mUpdateProjectionMatrix = false;
         bool mNight = false;
         const MWWorld::GroundcoverStore& mGroundCoverStore;
+        const std::filesystem::path mCompositeMapCachePath;
 
         std::unique_ptr<AnimationLOD> mAnimationLOD;
         std::unique_ptr<RadianceHints> mRadianceHints;
         std::unique_ptr<EntityCulling> mEntityCulling;
         std::unique_ptr<VRAMManagement> mVRAMManagement;
+        std::unique_ptr<TextureStreaming> mTextureStreaming;
+        std::unique_ptr<SceneUtil::ParallelCull> mParallelCull;
 
         void operator=(const RenderingManager&);
         RenderingManager(const RenderingManager&);
@@ -1,5 +1,7 @@
 #include "sky.hpp"
 
+#include <algorithm>
+
 #include <osg/Depth>
 #include <osg/PositionAttitudeTransform>
 
@@ -40,6 +42,8 @@
 
 namespace
 {
+    constexpr float rainThreshold = 0.6f; // Rain_Threshold?
+
     class WrapAroundOperator : public osgParticle::Operator
     {
     public:
@@ -121,7 +125,6 @@ namespace
 
         void operate(osgParticle::Particle* particle, double dt) override
         {
-            constexpr float rainThreshold = 0.6f; // Rain_Threshold?
             float alpha = mIsRain ? mAlpha * rainThreshold : mAlpha;
             particle->setAlphaRange(osgParticle::rangef(alpha, alpha));
         }
@@ -387,21 +390,42 @@ namespace MWRender
 
         mRainNode = new osg::Group;
 
-        mRainParticleSystem = new NifOsg::ParticleSystem;
         osg::Vec3 rainRange = osg::Vec3(mRainDiameter, mRainDiameter, (mRainMinHeight + mRainMaxHeight) / 2.f);
 
-        mRainParticleSystem->setParticleAlignment(osgParticle::ParticleSystem::FIXED);
-        mRainParticleSystem->setAlignVectorX(osg::Vec3f(0.1f, 0, 0));
-        mRainParticleSystem->setAlignVectorY(osg::Vec3f(0, 0, 1));
-
-        osg::ref_ptr<osg::StateSet> stateset = mRainParticleSystem->getOrCreateStateSet();
-
         constexpr VFS::Path::NormalizedView raindropImage("textures/tx_raindrop_01.dds");
         osg::ref_ptr<osg::Texture2D> raindropTex
             = new osg::Texture2D(mSceneManager->getImageManager()->getImage(raindropImage));
         raindropTex->setWrap(osg::Texture::WRAP_S, osg::Texture::CLAMP_TO_EDGE);
         raindropTex->setWrap(osg::Texture::WRAP_T, osg::Texture::CLAMP_TO_EDGE);
 
+        if (Settings::shaders().mGpuPrecipitation && mSceneManager->getForceShaders())
+        {
+            mGpuRain = std::make_unique<GpuPrecipitation>(*mSceneManager, raindropTex, mPrecipitationOcclusion);
+
+            osg::StateSet* stateset = mGpuRain->getNode()->getOrCreateStateSet();
+            stateset->setNestRenderBins(false);
+            stateset->setRenderingHint(osg::StateSet::TRANSPARENT_BIN);
+            stateset->setMode(GL_CULL_FACE, osg::StateAttribute::OFF);
+            stateset->setMode(GL_BLEND, osg::StateAttribute::ON);
+
+            mRainNode->addChild(mGpuRain->getNode());
+            mRainNode->addCullCallback(mUnderwaterSwitch);
+            mRainNode->setNodeMask(Mask_WeatherParticles);
+
+            mSkyNode->addChild(mRainNode);
+            if (mPrecipitationOcclusion)
+                mPrecipitationOccluder->enable();
+            return;
+        }
+
+        mRainParticleSystem = new NifOsg::ParticleSystem;
+
+        mRainParticleSystem->setParticleAlignment(osgParticle::ParticleSystem::FIXED);
+        mRainParticleSystem->setAlignVectorX(osg::Vec3f(0.1f, 0, 0));
+        mRainParticleSystem->setAlignVectorY(osg::Vec3f(0, 0, 1));
+
+        osg::ref_ptr<osg::StateSet> stateset = mRainParticleSystem->getOrCreateStateSet();
+
         stateset->setTextureAttributeAndModes(0, raindropTex);
         stateset->setNestRenderBins(false);
         stateset->setRenderingHint(osg::StateSet::TRANSPARENT_BIN);
@@ -479,6 +503,7 @@ namespace MWRender
         mCounter = nullptr;
         mRainParticleSystem = nullptr;
         mRainShooter = nullptr;
+        mGpuRain = nullptr;
         mPrecipitationOccluder->disable();
     }
 
@@ -544,6 +569,10 @@ namespace MWRender
 
         switchUnderwaterRain();
 
+        if (mGpuRain)
+            mGpuRain->update(
+                duration, mPrecipitationAlpha * rainThreshold, mCamera->getInverseViewMatrix().getTrans());
+
         if (mIsStorm && mParticleNode)
         {
             osg::Quat quat;
@@ -614,7 +643,19 @@ namespace MWRender
 
     void SkyManager::updateRainParameters()
     {
-        if (mRainShooter)
+        if (mGpuRain)
+        {
+            float angle = -std::atan(mWindSpeed / 50.f);
+            mGpuRain->setVelocity(osg::Vec3f(0, mRainSpeed * std::sin(angle), -mRainSpeed / std::cos(angle)));
+
+            osg::Vec3 rainRange = osg::Vec3(mRainDiameter, mRainDiameter, (mRainMinHeight + mRainMaxHeight) / 2.f);
+            mGpuRain->setRange(rainRange);
+
+            // Particles live for a second, so this is the amount of drops the particle system rain settles at
+            mGpuRain->setDropCount(static_cast<unsigned>(std::max(0.f, mRainMaxRaindrops / mRainEntranceSpeed * 20)));
+            mPrecipitationOccluder->updateRange(rainRange);
+        }
+        else if (mRainShooter)
         {
             float angle = -std::atan(mWindSpeed / 50.f);
             mRainShooter->setVelocity(osg::Vec3f(0, mRainSpeed * std::sin(angle), -mRainSpeed / std::cos(angle)));
@@ -633,10 +674,13 @@ namespace MWRender
 
     void SkyManager::switchUnderwaterRain()
     {
+        bool freeze = mUnderwaterSwitch->isUnderwater();
+        if (mGpuRain)
+            mGpuRain->setFrozen(freeze);
+
         if (!mRainParticleSystem)
             return;
 
-        bool freeze = mUnderwaterSwitch->isUnderwater();
         mRainParticleSystem->setFrozen(freeze);
     }
 
@@ -10,6 +10,7 @@
 
 #include <components/vfs/pathutil.hpp>
 
+#include "gpuprecipitation.hpp"
 #include "precipitationocclusion.hpp"
 #include "skyutil.hpp"
 
@@ -150,6 +151,7 @@ namespace MWRender
         osg::ref_ptr<osgParticle::BoxPlacer> mPlacer;
         osg::ref_ptr<RainCounter> mCounter;
         osg::ref_ptr<RainShooter> mRainShooter;
+        std::unique_ptr<GpuPrecipitation> mGpuRain;
 
         bool mPrecipitationOcclusion = false;
         std::unique_ptr<PrecipitationOccluder> mPrecipitationOccluder;
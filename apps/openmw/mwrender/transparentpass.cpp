@@ -94,6 +94,14 @@ namespace MWRender
             opaqueFbo->apply(state, osg::FrameBufferObject::DRAW_FRAMEBUFFER);
             ext->glBlitFramebuffer(0, 0, tex->getTextureWidth(), tex->getTextureHeight(), 0, 0, tex->getTextureWidth(),
                 tex->getTextureHeight(), GL_DEPTH_BUFFER_BIT, GL_NEAREST);
+
+            if (mOcclusionCulling)
+            {
+                opaqueFbo->apply(state, osg::FrameBufferObject::READ_FRAMEBUFFER);
+                mOcclusionCulling->capture(state, tex->getTextureWidth(), tex->getTextureHeight());
+                msaaFbo ? msaaFbo->apply(state, osg::FrameBufferObject::READ_FRAMEBUFFER)
+                        : fbo->apply(state, osg::FrameBufferObject::READ_FRAMEBUFFER);
+            }
         }
 
         msaaFbo ? msaaFbo->apply(state, osg::FrameBufferObject::DRAW_FRAMEBUFFER)
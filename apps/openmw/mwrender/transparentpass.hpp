@@ -9,6 +9,8 @@
 
 #include <osgUtil/RenderBin>
 
+#include <components/sceneutil/occlusionculling.hpp>
+
 namespace Shader
 {
     class ShaderManager;
@@ -35,6 +37,9 @@ namespace MWRender
 
         std::array<std::unique_ptr<Stereo::MultiviewFramebufferResolve>, 2> mMultiviewResolve;
 
+        // Reads back the resolved opaque depth, if set
+        osg::ref_ptr<SceneUtil::OcclusionCulling> mOcclusionCulling;
+
     private:
         osg::ref_ptr<osg::StateSet> mStateSet;
         bool mPostPass;
@@ -4,22 +4,113 @@
 #include <osg/Image>
 #include <osg/Texture2D>
 #include <osg/Array>
-
+#include <osg/Camera>
+#include <osg/NodeVisitor>
+#include <osg/Stats>
+#include <osg/GL>
+#include <osg/GLExtensions>
+#include <osg/State>
+#include <osg/Timer>
+#include <osg/Transform>
+
+#include <components/resource/imagemanager.hpp>
 #include <components/resource/resourcesystem.hpp>
 #include <components/resource/scenemanager.hpp>
 #include <components/sceneutil/color.hpp>
 #include <components/sceneutil/glextensions.hpp>
+#include <components/sceneutil/workqueue.hpp>
 #include <components/settings/values.hpp>
 
 #include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <deque>
 #include <functional>
+#include <limits>
+#include <mutex>
 
 namespace MWRender
 {
+    namespace
+    {
+#ifndef GL_GPU_MEMORY_INFO_DEDICATED_VIDMEM_NVX
+        constexpr GLenum GL_GPU_MEMORY_INFO_DEDICATED_VIDMEM_NVX = 0x9047;
+#endif
+#ifndef GL_GPU_MEMORY_INFO_CURRENT_AVAILABLE_VIDMEM_NVX
+        constexpr GLenum GL_GPU_MEMORY_INFO_CURRENT_AVAILABLE_VIDMEM_NVX = 0x9049;
+#endif
+#ifndef GL_TEXTURE_FREE_MEMORY_ATI
+        constexpr GLenum GL_TEXTURE_FREE_MEMORY_ATI = 0x87FC;
+#endif
+
+        // Querying the driver may stall, so don't do it every frame
+        constexpr double sMemoryInfoInterval = 1.0;
+    }
+
+    class VRAMManagement::MemoryInfoOperation : public osg::GraphicsOperation
+    {
+    public:
+        MemoryInfoOperation()
+            : osg::GraphicsOperation("VRAMMemoryInfoOperation", true)
+        {
+        }
+
+        void operator()(osg::GraphicsContext* graphicsContext) override
+        {
+            const double time = osg::Timer::instance()->time_s();
+            if (mLastQuery >= 0 && time - mLastQuery < sMemoryInfoInterval)
+                return;
+            mLastQuery = time;
+
+            const unsigned contextID = graphicsContext->getState()->getContextID();
+            if (!mChecked)
+            {
+                mNVX = osg::isGLExtensionSupported(contextID, "GL_NVX_gpu_memory_info");
+                mATI = !mNVX && osg::isGLExtensionSupported(contextID, "GL_ATI_meminfo");
+                mChecked = true;
+            }
+
+            if (mNVX)
+            {
+                GLint total = 0;
+                GLint available = 0;
+                glGetIntegerv(GL_GPU_MEMORY_INFO_DEDICATED_VIDMEM_NVX, &total);
+                glGetIntegerv(GL_GPU_MEMORY_INFO_CURRENT_AVAILABLE_VIDMEM_NVX, &available);
+                mTotal = static_cast<std::size_t>(total) * 1024;
+                mAvailable = static_cast<std::size_t>(available) * 1024;
+                mValid = total > 0;
+            }
+            else if (mATI)
+            {
+                // The total is not reported, take what was free when we started as the VRAM available to us
+                GLint info[4] = {};
+                glGetIntegerv(GL_TEXTURE_FREE_MEMORY_ATI, info);
+                mAvailable = static_cast<std::size_t>(info[0]) * 1024;
+                if (!mValid)
+                    mTotal = mAvailable.load();
+                mValid = info[0] > 0;
+            }
+        }
+
+        /// In bytes, only meaningful once valid
+        std::atomic<std::size_t> mTotal = 0;
+        std::atomic<std::size_t> mAvailable = 0;
+        std::atomic_bool mValid = false;
+
+    private:
+        double mLastQuery = -1;
+        bool mChecked = false;
+        bool mNVX = false;
+        bool mATI = false;
+    };
+
     VRAMManagement::VRAMManagement(Resource::ResourceSystem* resourceSystem)
         : mResourceSystem(resourceSystem)
+        , mMemoryInfo(new MemoryInfoOperation)
+        , mShedSteps(0)
         , mEnabled(true)
         , mMaxVRAMUsage(0)
+        , mAutoMaxVRAMUsage(true)
         , mUnloadStaticGeometry(true)
         , mUnloadDuplicateTextures(true)
         , mEnableTextureCompression(true)
@@ -62,7 +153,10 @@ namespace MWRender
         mEnableGeometryLOD = settings.mEnableGeometryLod;
 
         // Auto-detect VRAM if not specified
-        if (mMaxVRAMUsage == 0)
+        mAutoMaxVRAMUsage = mMaxVRAMUsage == 0;
+        if (mAutoMaxVRAMUsage && mMemoryInfo->mValid)
+            mMaxVRAMUsage = mMemoryInfo->mTotal / 10 * 9;
+        else if (mAutoMaxVRAMUsage)
         {
             // Default to 1.5GB for a 2GB card like GTX 960, leaving headroom for system
             mMaxVRAMUsage = 1536 * 1024 * 1024;
@@ -87,12 +181,30 @@ namespace MWRender
 
         mUpdateTimer = 0.0f;
 
+        // The driver reports the VRAM once the draw thread ran
+        if (mAutoMaxVRAMUsage && mMemoryInfo->mValid)
+            mMaxVRAMUsage = mMemoryInfo->mTotal / 10 * 9;
+
         // Check if we need to unload resources
         if (mEstimatedVRAMUsage > mMaxVRAMUsage)
         {
             unloadUnusedResources();
         }
 
+        // Take one step at a time, freed VRAM is only reported once the objects are deleted on the draw thread
+        const size_t usage = getVRAMUsage();
+        if (usage > mMaxVRAMUsage)
+        {
+            if (mShedSteps < mShedders.size())
+            {
+                if (mShedders[mShedSteps])
+                    mShedders[mShedSteps]();
+                ++mShedSteps;
+            }
+        }
+        else if (usage <= mMaxVRAMUsage * 0.9f)
+            mShedSteps = 0;
+
         // Detect duplicates periodically
         if (mUnloadDuplicateTextures || mEnableGeometryDeduplication)
         {
@@ -100,6 +212,49 @@ namespace MWRender
         }
     }
 
+    size_t VRAMManagement::getVRAMUsage() const
+    {
+        if (!mMemoryInfo->mValid)
+            return mEstimatedVRAMUsage;
+        const size_t total = mMemoryInfo->mTotal;
+        const size_t available = mMemoryInfo->mAvailable;
+        return total > available ? total - available : 0;
+    }
+
+    size_t VRAMManagement::getTextureStreamingBudget(size_t streamedSize) const
+    {
+        // The estimate doesn't cover streamed textures, the driver does
+        size_t otherUsage = mEstimatedVRAMUsage;
+        if (mMemoryInfo->mValid)
+        {
+            const size_t usage = getVRAMUsage();
+            otherUsage = usage > streamedSize ? usage - streamedSize : 0;
+        }
+        const size_t budget = mMaxVRAMUsage > otherUsage ? mMaxVRAMUsage - otherUsage : 0;
+
+        // Keep the streamed levels until dropping unused cached objects turned out not to be enough
+        if (mShedSteps <= static_cast<size_t>(ShedStep::TextureStreaming))
+            return std::max(budget, streamedSize);
+        return budget;
+    }
+
+    void VRAMManagement::setShedder(ShedStep step, std::function<void()> shed)
+    {
+        mShedders[static_cast<size_t>(step)] = std::move(shed);
+    }
+
+    osg::GraphicsOperation* VRAMManagement::getOperation() const
+    {
+        return mMemoryInfo.get();
+    }
+
+    void VRAMManagement::reportStats(unsigned int frameNumber, osg::Stats& stats) const
+    {
+        stats.setAttribute(frameNumber, "VRAM Usage", static_cast<double>(getVRAMUsage() / (1024 * 1024)));
+        stats.setAttribute(frameNumber, "VRAM Budget", static_cast<double>(mMaxVRAMUsage / (1024 * 1024)));
+        stats.setAttribute(frameNumber, "VRAM Shed", static_cast<double>(mShedSteps));
+    }
+
     void VRAMManagement::unloadUnusedResources()
     {
         auto now = std::chrono::steady_clock::now();
@@ -491,7 +646,7 @@ namespace MWRender
                 stats.loadedGeometry++;
         }
 
-        stats.estimatedVRAMUsageMB = mEstimatedVRAMUsage / (1024 * 1024);
+        stats.estimatedVRAMUsageMB = getVRAMUsage() / (1024 * 1024);
         stats.targetVRAMUsageMB = mMaxVRAMUsage / (1024 * 1024);
 
         return stats;
@@ -499,69 +654,380 @@ namespace MWRender
 
     // TextureStreaming implementation
 
-    TextureStreaming::TextureStreaming(Resource::ResourceSystem* resourceSystem)
+    namespace
+    {
+        // Spread the uploads over frames to not replace the blurry textures with a hitch
+        constexpr std::size_t sSwapsPerFrame = 4;
+
+        /// Make the target use the data of the source without copying it.
+        void moveImageData(osg::Image& target, osg::Image& source)
+        {
+            const osg::Image::MipmapDataType mipmaps = source.getMipmapLevels();
+            target.setImage(source.s(), source.t(), source.r(), source.getInternalTextureFormat(),
+                source.getPixelFormat(), source.getDataType(), source.data(), source.getAllocationMode(),
+                source.getPacking(), source.getRowLength());
+            target.setMipmapLevels(mipmaps);
+            source.setAllocationMode(osg::Image::NO_DELETE);
+            // Texture2D recreates its texture object once the size of the image changes
+            target.dirty();
+        }
+
+        class StreamingVisitor : public osg::NodeVisitor
+        {
+        public:
+            StreamingVisitor(TextureStreaming& streaming, const osg::Camera& camera, float minScreenSize)
+                : osg::NodeVisitor(TRAVERSE_ACTIVE_CHILDREN)
+                , mStreaming(streaming)
+                , mMinScreenSize(minScreenSize)
+            {
+                setTraversalMask(camera.getCullMask());
+                mEyePoint = osg::Vec3f(0, 0, 0) * camera.getInverseViewMatrix();
+
+                double fovy = 0;
+                double aspectRatio = 0;
+                double zNear = 0;
+                double zFar = 0;
+                camera.getProjectionMatrixAsPerspective(fovy, aspectRatio, zNear, zFar);
+                const osg::Viewport* viewport = camera.getViewport();
+                const float height = viewport != nullptr ? static_cast<float>(viewport->height()) : 1080.f;
+                mPixelsPerUnit = height / (2 * std::tan(osg::DegreesToRadians(static_cast<float>(fovy)) / 2));
+            }
+
+            void apply(osg::Node& node) override
+            {
+                if (handle(node))
+                    traverse(node);
+            }
+
+            void apply(osg::Transform& transform) override
+            {
+                if (!handle(transform))
+                    return;
+                const osg::Matrix matrix = mMatrix;
+                transform.computeLocalToWorldMatrix(mMatrix, this);
+                traverse(transform);
+                mMatrix = matrix;
+            }
+
+        private:
+            TextureStreaming& mStreaming;
+            float mMinScreenSize;
+            osg::Vec3f mEyePoint;
+            float mPixelsPerUnit;
+            osg::Matrix mMatrix;
+
+            /// @return false if the node is too small on the screen for any of its textures to need streamed levels
+            bool handle(osg::Node& node)
+            {
+                const osg::BoundingSphere& bound = node.getBound();
+                if (!bound.valid())
+                    return false;
+
+                const osg::Vec3f center = bound.center() * mMatrix;
+                const float radius = bound.radius() * static_cast<float>(mMatrix.getScale().x());
+                const float distance = (center - mEyePoint).length();
+                const float screenSize = distance > radius ? 2 * radius * mPixelsPerUnit / distance
+                                                           : std::numeric_limits<float>::max();
+                if (screenSize <= mMinScreenSize)
+                    return false;
+
+                if (const osg::StateSet* stateset = node.getStateSet())
+                    for (unsigned unit = 0; unit < stateset->getTextureAttributeList().size(); ++unit)
+                        if (const osg::Texture* texture = dynamic_cast<const osg::Texture*>(
+                                stateset->getTextureAttribute(unit, osg::StateAttribute::TEXTURE)))
+                            for (unsigned i = 0; i < texture->getNumImages(); ++i)
+                                mStreaming.requestTexture(texture->getImage(i), screenSize);
+
+                return true;
+            }
+        };
+    }
+
+    class TextureStreaming::LoadLevelsItem : public SceneUtil::WorkItem
+    {
+    public:
+        LoadLevelsItem(Resource::ImageManager& imageManager, const Entry& entry)
+            : mImageManager(imageManager)
+            , mImage(entry.mImage)
+            , mPath(entry.mPath)
+            , mBaseLevel(entry.mBaseLevel)
+            , mLevel(entry.mTargetLevel)
+        {
+        }
+
+        void doWork() override
+        {
+            // Lower levels are resident, only the ones above them have to be loaded from the file
+            if (mLevel < mBaseLevel)
+                mResult = mImageManager.loadMipmapLevels(mPath, mLevel);
+            else if (osg::ref_ptr<osg::Image> image = mImage.lock())
+                mResult = Resource::ImageManager::copyMipmapLevels(*image, mLevel - mBaseLevel);
+        }
+
+        void apply()
+        {
+            if (osg::ref_ptr<osg::Image> image = mImage.lock())
+                moveImageData(*image, *mResult);
+            mResult = nullptr;
+            mApplied = true;
+        }
+
+        unsigned getLevel() const { return mLevel; }
+
+        bool hasResult() const { return mResult != nullptr; }
+
+        bool isApplied() const { return mApplied; }
+
+        bool mQueued = false;
+
+    private:
+        Resource::ImageManager& mImageManager;
+        osg::observer_ptr<osg::Image> mImage;
+        VFS::Path::Normalized mPath;
+        unsigned mBaseLevel;
+        unsigned mLevel;
+        osg::ref_ptr<osg::Image> mResult;
+        std::atomic_bool mApplied = false;
+    };
+
+    class TextureStreaming::SwapOperation : public osg::GraphicsOperation
+    {
+    public:
+        SwapOperation()
+            : osg::GraphicsOperation("TextureStreamingSwapOperation", true)
+        {
+        }
+
+        void add(osg::ref_ptr<LoadLevelsItem> item)
+        {
+            std::lock_guard<std::mutex> lock(mMutex);
+            mItems.push_back(std::move(item));
+        }
+
+        void operator()(osg::GraphicsContext* /*graphicsContext*/) override
+        {
+            // Changing the data of an image is only safe while no texture uploads it
+            std::vector<osg::ref_ptr<LoadLevelsItem>> items;
+            {
+                std::lock_guard<std::mutex> lock(mMutex);
+                const std::size_t count = std::min(mItems.size(), sSwapsPerFrame);
+                items.assign(mItems.begin(), mItems.begin() + static_cast<std::ptrdiff_t>(count));
+                mItems.erase(mItems.begin(), mItems.begin() + static_cast<std::ptrdiff_t>(count));
+            }
+            for (const osg::ref_ptr<LoadLevelsItem>& item : items)
+                item->apply();
+        }
+
+    private:
+        std::mutex mMutex;
+        std::deque<osg::ref_ptr<LoadLevelsItem>> mItems;
+    };
+
+    TextureStreaming::TextureStreaming(Resource::ResourceSystem* resourceSystem, SceneUtil::WorkQueue* workQueue)
         : mResourceSystem(resourceSystem)
-        , mMaxLoadsPerFrame(2)
+        , mWorkQueue(workQueue)
+        , mOperation(new SwapOperation)
+        , mUpdateTimer(0.0f)
+        , mBudget(0)
+        , mLoading(0)
+    {
+    }
+
+    TextureStreaming::~TextureStreaming() = default;
+
+    osg::GraphicsOperation* TextureStreaming::getOperation() const
     {
+        return mOperation.get();
     }
 
-    TextureStreaming::~TextureStreaming()
+    void TextureStreaming::requestTexture(const osg::Image* image, float screenSize)
     {
-        mPendingRequests.clear();
-        mLoadedTextures.clear();
+        auto it = mEntries.find(image);
+        if (it != mEntries.end())
+            it->second.mScreenSize = std::max(it->second.mScreenSize, screenSize);
     }
 
-    void TextureStreaming::requestTexture(const std::string& path, int priority)
+    void TextureStreaming::update(float dt, osg::Node& scene, const osg::Camera& camera, std::size_t budget)
     {
-        // Check if already loaded
-        if (mLoadedTextures.count(path) > 0)
+        addImages();
+        finishItems();
+
+        mUpdateTimer += dt;
+        if (mUpdateTimer < UPDATE_INTERVAL)
             return;
+        mUpdateTimer = 0.0f;
+
+        for (auto& pair : mEntries)
+            pair.second.mScreenSize = 0;
+
+        // Images can't need more than their resident levels on objects smaller than those on the screen
+        const float bias = std::exp2(Settings::vramManagement().mMipmapBias);
+        StreamingVisitor visitor(
+            *this, camera, mResourceSystem->getImageManager()->getStreamedImageSize() / bias);
+        scene.accept(visitor);
 
-        // Check if already pending
-        for (auto& req : mPendingRequests)
+        for (auto& pair : mEntries)
+            pair.second.mScreenSize *= bias;
+
+        updateTargetLevels(budget);
+        startItems();
+    }
+
+    void TextureStreaming::addImages()
+    {
+        for (Resource::ImageManager::StreamedImage& streamed :
+            mResourceSystem->getImageManager()->takeStreamedImages())
         {
-            if (req.path == path)
+            const osg::Image& image = *streamed.mImage;
+            Entry entry;
+            entry.mImage = streamed.mImage;
+            entry.mPath = std::move(streamed.mPath);
+            entry.mSize = std::max(image.s(), image.t()) << streamed.mBaseLevel;
+            const unsigned numLevels = image.getNumMipmapLevels() + streamed.mBaseLevel;
+            entry.mSizes.resize(numLevels);
+            std::size_t size = 0;
+            for (unsigned level = numLevels; level-- > 0;)
             {
-                req.priority = std::max(req.priority, priority);
-                return;
+                size += osg::Image::computeImageSizeInBytes(std::max((image.s() << streamed.mBaseLevel) >> level, 1),
+                    std::max((image.t() << streamed.mBaseLevel) >> level, 1), 1, image.getPixelFormat(),
+                    image.getDataType(), image.getPacking());
+                entry.mSizes[level] = size;
             }
+            entry.mBaseLevel = streamed.mBaseLevel;
+            entry.mLoadedBaseLevel = streamed.mBaseLevel;
+            entry.mTargetLevel = streamed.mBaseLevel;
+            entry.mScreenSize = 0;
+            entry.mLoadFailed = false;
+            // An image released before its entry was removed can be replaced by one allocated at the same address
+            Entry& existing = mEntries[streamed.mImage.get()];
+            if (existing.mItem)
+                --mLoading;
+            existing = std::move(entry);
         }
+    }
+
+    void TextureStreaming::finishItems()
+    {
+        for (auto it = mEntries.begin(); it != mEntries.end();)
+        {
+            Entry& entry = it->second;
+            if (entry.mItem && entry.mItem->isDone())
+            {
+                if (!entry.mItem->mQueued)
+                {
+                    if (entry.mItem->hasResult())
+                    {
+                        entry.mItem->mQueued = true;
+                        mOperation->add(entry.mItem);
+                    }
+                    else
+                    {
+                        // Don't retry loading levels of a file that fails to load
+                        entry.mLoadFailed |= entry.mItem->getLevel() < entry.mBaseLevel;
+                        entry.mItem = nullptr;
+                        --mLoading;
+                    }
+                }
+                else if (entry.mItem->isApplied())
+                {
+                    entry.mBaseLevel = entry.mItem->getLevel();
+                    entry.mItem = nullptr;
+                    --mLoading;
+                }
+            }
 
-        mPendingRequests.push_back({ path, priority, false });
+            // The image is released once no texture uses it anymore and the cache expired it
+            if (!entry.mItem && entry.mImage == nullptr)
+                it = mEntries.erase(it);
+            else
+                ++it;
+        }
     }
 
-    void TextureStreaming::update(float dt)
+    void TextureStreaming::updateTargetLevels(std::size_t budget)
     {
-        if (mPendingRequests.empty())
-            return;
+        mBudget = budget;
 
-        // Sort by priority
-        std::sort(mPendingRequests.begin(), mPendingRequests.end(),
-            [](const auto& a, const auto& b) { return a.priority > b.priority; });
+        for (auto& pair : mEntries)
+        {
+            Entry& entry = pair.second;
+            // The highest level at least as large as the image is on the screen
+            unsigned level = entry.mLoadFailed ? entry.mBaseLevel : 0;
+            while (level < entry.mLoadedBaseLevel
+                && static_cast<float>(entry.mSize >> (level + 1)) >= entry.mScreenSize)
+                ++level;
+            entry.mTargetLevel = level;
+        }
 
-        // Load up to max per frame
-        int loaded = 0;
-        auto it = mPendingRequests.begin();
-        while (it != mPendingRequests.end() && loaded < mMaxLoadsPerFrame)
+        // Evict the same number of levels from all images until they fit into the budget
+        for (unsigned evicted = 0;; ++evicted)
         {
-            // In a full implementation, this would async load the texture
-            // For now, we just mark it as ready
-            mLoadedTextures[it->path] = nullptr; // Would be actual texture
-            it = mPendingRequests.erase(it);
-            loaded++;
+            std::size_t size = 0;
+            bool canEvict = false;
+            for (auto& pair : mEntries)
+            {
+                const Entry& entry = pair.second;
+                const unsigned level = std::min(entry.mTargetLevel + evicted, entry.mLoadedBaseLevel);
+                size += entry.mSizes[level];
+                canEvict |= level < entry.mLoadedBaseLevel;
+            }
+            if (size <= budget || !canEvict)
+            {
+                for (auto& pair : mEntries)
+                    pair.second.mTargetLevel
+                        = std::min(pair.second.mTargetLevel + evicted, pair.second.mLoadedBaseLevel);
+                break;
+            }
+        }
+    }
+
+    void TextureStreaming::startItems()
+    {
+        std::vector<Entry*> entries;
+        for (auto& pair : mEntries)
+            if (!pair.second.mItem && pair.second.mTargetLevel != pair.second.mBaseLevel)
+                entries.push_back(&pair.second);
+
+        // Free memory first, then load the levels of the images that are largest on the screen
+        std::sort(entries.begin(), entries.end(), [](const Entry* a, const Entry* b) {
+            const bool aEvicts = a->mTargetLevel > a->mBaseLevel;
+            const bool bEvicts = b->mTargetLevel > b->mBaseLevel;
+            if (aEvicts != bEvicts)
+                return aEvicts;
+            return a->mScreenSize > b->mScreenSize;
+        });
+
+        for (Entry* entry : entries)
+        {
+            if (mLoading >= MAX_LOADING)
+                break;
+            entry->mItem = new LoadLevelsItem(*mResourceSystem->getImageManager(), *entry);
+            entry->mItem->setPriority(SceneUtil::WorkPriority::Low);
+            mWorkQueue->addWorkItem(entry->mItem);
+            ++mLoading;
         }
     }
 
-    bool TextureStreaming::isTextureLoaded(const std::string& path) const
+    std::size_t TextureStreaming::getResidentSize() const
     {
-        return mLoadedTextures.count(path) > 0;
+        std::size_t size = 0;
+        for (const auto& pair : mEntries)
+            size += pair.second.mSizes[pair.second.mBaseLevel];
+        return size;
     }
 
-    osg::Texture* TextureStreaming::getTexture(const std::string& path)
+    void TextureStreaming::reportStats(unsigned int frameNumber, osg::Stats& stats) const
     {
-        auto it = mLoadedTextures.find(path);
-        if (it != mLoadedTextures.end())
-            return it->second.get();
-        return nullptr;
+        std::size_t streamed = 0;
+        for (const auto& pair : mEntries)
+            if (pair.second.mBaseLevel < pair.second.mLoadedBaseLevel)
+                ++streamed;
+        const std::size_t size = getResidentSize();
+
+        stats.setAttribute(frameNumber, "TextureStreaming Images", static_cast<double>(mEntries.size()));
+        stats.setAttribute(frameNumber, "TextureStreaming Streamed", static_cast<double>(streamed));
+        stats.setAttribute(frameNumber, "TextureStreaming Loading", static_cast<double>(mLoading));
+        stats.setAttribute(frameNumber, "TextureStreaming Size", static_cast<double>(size / (1024 * 1024)));
+        stats.setAttribute(frameNumber, "TextureStreaming Budget", static_cast<double>(mBudget / (1024 * 1024)));
     }
 }
@@ -4,19 +4,27 @@
 #include <osg/ref_ptr>
 #include <osg/Texture>
 #include <osg/Geometry>
+#include <osg/GraphicsThread>
+#include <osg/observer_ptr>
 
+#include <components/vfs/pathutil.hpp>
+
+#include <array>
 #include <unordered_map>
 #include <unordered_set>
 #include <vector>
 #include <memory>
 #include <string>
 #include <chrono>
+#include <functional>
 
 namespace osg
 {
+    class Camera;
     class StateSet;
     class Node;
     class Image;
+    class Stats;
 }
 
 namespace Resource
@@ -24,6 +32,11 @@ namespace Resource
     class ResourceSystem;
 }
 
+namespace SceneUtil
+{
+    class WorkQueue;
+}
+
 namespace MWRender
 {
     /// VRAM Management system for unloading unused resources and managing GPU memory
@@ -50,6 +63,26 @@ namespace MWRender
         /// Get estimated VRAM usage in MB
         size_t getEstimatedVRAMUsage() const { return mEstimatedVRAMUsage / (1024 * 1024); }
 
+        /// Get VRAM usage in bytes as reported by the driver, or the estimate when the driver doesn't report it
+        size_t getVRAMUsage() const;
+
+        /// Ways to free VRAM while over budget, in the order they are tried
+        enum class ShedStep
+        {
+            ObjectCache,
+            TextureStreaming,
+            Terrain,
+        };
+
+        /// Set what to do once the VRAM is still over budget after the previous steps. TextureStreaming sheds its
+        /// levels through getTextureStreamingBudget instead.
+        void setShedder(ShedStep step, std::function<void()> shed);
+
+        /// Queries the VRAM usage from the driver, has to be added to the graphics context
+        osg::GraphicsOperation* getOperation() const;
+
+        void reportStats(unsigned int frameNumber, osg::Stats& stats) const;
+
         /// Get statistics
         struct Stats
         {
@@ -67,7 +100,15 @@ namespace MWRender
         void setEnabled(bool enabled) { mEnabled = enabled; }
         bool isEnabled() const { return mEnabled; }
 
+        bool isTextureStreamingEnabled() const { return mEnableTextureStreaming; }
+
+        /// Get the VRAM left for streamed textures in bytes
+        /// @param streamedSize the VRAM used by streamed textures now
+        size_t getTextureStreamingBudget(size_t streamedSize) const;
+
     private:
+        class MemoryInfoOperation;
+
         struct TextureEntry
         {
             osg::ref_ptr<osg::Texture> texture;
@@ -98,6 +139,9 @@ namespace MWRender
         void reloadTextureToVRAM(TextureEntry& entry);
 
         Resource::ResourceSystem* mResourceSystem;
+        osg::ref_ptr<MemoryInfoOperation> mMemoryInfo;
+        std::array<std::function<void()>, 3> mShedders;
+        size_t mShedSteps;
 
         std::unordered_map<osg::Texture*, TextureEntry> mTextures;
         std::unordered_map<osg::Geometry*, GeometryEntry> mGeometry;
@@ -106,6 +150,7 @@ namespace MWRender
         // Settings
         bool mEnabled;
         size_t mMaxVRAMUsage; // bytes
+        bool mAutoMaxVRAMUsage;
         bool mUnloadStaticGeometry;
         bool mUnloadDuplicateTextures;
         bool mEnableTextureCompression;
@@ -123,37 +168,66 @@ namespace MWRender
         static constexpr float UPDATE_INTERVAL = 1.0f; // Update every second
     };
 
-    /// Texture streaming system for loading textures on-demand
+    /// Streams the mipmap levels of images loaded with Resource::ImageManager::getStreamedImage that are not resident
+    /// yet, depending on the size objects using them are projected to on the screen. The high levels of the least
+    /// needed images are evicted again to keep their estimated size within the budget.
     class TextureStreaming
     {
     public:
-        TextureStreaming(Resource::ResourceSystem* resourceSystem);
+        TextureStreaming(Resource::ResourceSystem* resourceSystem, SceneUtil::WorkQueue* workQueue);
         ~TextureStreaming();
 
-        /// Request a texture to be loaded
-        void requestTexture(const std::string& path, int priority);
+        /// Request the levels needed to draw the image at the given size in pixels until the next update of the
+        /// requests
+        void requestTexture(const osg::Image* image, float screenSize);
 
         /// Update streaming (call each frame)
-        void update(float dt);
+        /// @param budget the estimated VRAM usage of streamed images should stay below in bytes
+        void update(float dt, osg::Node& scene, const osg::Camera& camera, std::size_t budget);
 
-        /// Check if a texture is loaded
-        bool isTextureLoaded(const std::string& path) const;
+        /// Swaps the loaded levels into the images, has to be added to the graphics context
+        osg::GraphicsOperation* getOperation() const;
 
-        /// Get loaded texture
-        osg::Texture* getTexture(const std::string& path);
+        /// Get the estimated VRAM used by the resident levels of streamed images in bytes
+        std::size_t getResidentSize() const;
+
+        void reportStats(unsigned int frameNumber, osg::Stats& stats) const;
 
     private:
-        struct StreamRequest
+        class LoadLevelsItem;
+        class SwapOperation;
+
+        struct Entry
         {
-            std::string path;
-            int priority;
-            bool isLoading;
+            osg::observer_ptr<osg::Image> mImage;
+            VFS::Path::Normalized mPath;
+            /// Estimated size for each base level
+            std::vector<std::size_t> mSizes;
+            int mSize;
+            /// The level of the complete image the resident levels start at
+            unsigned mBaseLevel;
+            /// The base level the image was loaded with, levels above it are never evicted
+            unsigned mLoadedBaseLevel;
+            unsigned mTargetLevel;
+            float mScreenSize;
+            bool mLoadFailed;
+            osg::ref_ptr<LoadLevelsItem> mItem;
         };
 
+        void addImages();
+        void finishItems();
+        void updateTargetLevels(std::size_t budget);
+        void startItems();
+
         Resource::ResourceSystem* mResourceSystem;
-        std::vector<StreamRequest> mPendingRequests;
-        std::unordered_map<std::string, osg::ref_ptr<osg::Texture>> mLoadedTextures;
-        int mMaxLoadsPerFrame;
+        osg::ref_ptr<SceneUtil::WorkQueue> mWorkQueue;
+        osg::ref_ptr<SwapOperation> mOperation;
+        std::unordered_map<const osg::Image*, Entry> mEntries;
+        float mUpdateTimer;
+        std::size_t mBudget;
+        std::size_t mLoading;
+        static constexpr float UPDATE_INTERVAL = 0.5f;
+        static constexpr std::size_t MAX_LOADING = 8;
     };
 }
 
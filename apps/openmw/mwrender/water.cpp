@@ -20,6 +20,7 @@
 #include <components/resource/scenemanager.hpp>
 
 #include <components/sceneutil/depth.hpp>
+#include <components/sceneutil/gputimer.hpp>
 #include <components/sceneutil/rtt.hpp>
 #include <components/sceneutil/shadow.hpp>
 #include <components/sceneutil/waterutil.hpp>
@@ -29,6 +30,7 @@
 
 #include <components/nifosg/controller.hpp>
 
+#include <components/shader/asyncprogram.hpp>
 #include <components/shader/shadermanager.hpp>
 
 #include <components/esm3/loadcell.hpp>
@@ -262,7 +264,9 @@ namespace MWRender
         {
             camera->setReferenceFrame(osg::Camera::RELATIVE_RF);
             camera->setSmallFeatureCullingPixelSize(Settings::water().mSmallFeatureCullingPixelSize);
-            camera->setName("RefractionCamera");
+            camera->setName(Constants::RefractionCamera);
+            SceneUtil::addGpuTimer(*camera, "GPU Water Refraction");
+            Shader::allowSkippingDraws(*camera);
             camera->addCullCallback(new RealtimeReflectionCallback);
             camera->setComputeNearFarMode(osg::CullSettings::DO_NOT_COMPUTE_NEAR_FAR);
 
@@ -341,7 +345,9 @@ namespace MWRender
         {
             camera->setReferenceFrame(osg::Camera::RELATIVE_RF);
             camera->setSmallFeatureCullingPixelSize(Settings::water().mSmallFeatureCullingPixelSize);
-            camera->setName("ReflectionCamera");
+            camera->setName(Constants::ReflectionCamera);
+            SceneUtil::addGpuTimer(*camera, "GPU Water Reflection");
+            Shader::allowSkippingDraws(*camera);
             camera->addCullCallback(new RealtimeReflectionCallback);
 
             // Inform the shader that we're in a reflection
@@ -541,7 +547,10 @@ namespace MWRender
         {
             const unsigned int rttSize = Settings::water().mRttSize;
 
-            mReflection = new Reflection(rttSize, mInterior);
+            const unsigned int reflectionSize = std::max(
+                1u, static_cast<unsigned int>(rttSize * Settings::water().mReflectionResolutionScale.get()));
+
+            mReflection = new Reflection(reflectionSize, mInterior);
             // Real-time reflections - update every frame to avoid flickering
             // Quality settings are preserved via mReflectionDetail
             mReflection->setWaterLevel(mTop);
@@ -1756,6 +1756,16 @@ namespace MWScript
             }
         };
 
+        class OpDumpLuaProfile : public Interpreter::Opcode0
+        {
+        public:
+            void execute(Interpreter::Runtime& runtime) override
+            {
+                const auto filename = MWBase::Environment::get().getLuaManager()->exportResourceUsageStats();
+                runtime.getContext().report("Wrote '" + Files::pathToUnicodeString(filename) + "'");
+            }
+        };
+
         class OpTestModels : public Interpreter::Opcode0
         {
             template <class T>
@@ -1936,6 +1946,7 @@ namespace MWScript
             interpreter.installSegment5<OpToggleRecastMesh>(Compiler::Misc::opcodeToggleRecastMesh);
             interpreter.installSegment5<OpHelp>(Compiler::Misc::opcodeHelp);
             interpreter.installSegment5<OpReloadLua>(Compiler::Misc::opcodeReloadLua);
+            interpreter.installSegment5<OpDumpLuaProfile>(Compiler::Misc::opcodeDumpLuaProfile);
             interpreter.installSegment5<OpTestModels>(Compiler::Misc::opcodeTestModels);
         }
     }
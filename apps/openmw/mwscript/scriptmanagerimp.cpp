@@ -16,6 +16,7 @@
 #include <components/compiler/exception.hpp>
 #include <components/compiler/quickfileparser.hpp>
 #include <components/compiler/scanner.hpp>
+#include <components/compiler/scriptanalysis.hpp>
 
 #include "../mwworld/esmstore.hpp"
 
@@ -36,6 +37,13 @@ namespace MWScript
         mErrorHandler.setWarningsMode(warningsMode);
     }
 
+    ScriptManager::CompiledScript::CompiledScript(Interpreter::Program&& program, const Compiler::Locals& locals)
+        : mProgram(std::move(program))
+        , mLocals(locals)
+        , mActivationOnly(Compiler::isActivationOnly(mProgram))
+    {
+    }
+
     bool ScriptManager::compile(const ESM::RefId& name)
     {
         mParser.reset();
@@ -126,6 +134,12 @@ namespace MWScript
         return false;
     }
 
+    bool ScriptManager::isActivationOnly(const ESM::RefId& name) const
+    {
+        const auto iter = mScripts.find(name);
+        return iter != mScripts.end() && iter->second.mActivationOnly;
+    }
+
     void ScriptManager::clear()
     {
         for (auto& script : mScripts)
@@ -48,12 +48,9 @@ namespace MWScript
             Interpreter::Program mProgram;
             Compiler::Locals mLocals;
             std::set<ESM::RefId> mInactive;
+            bool mActivationOnly;
 
-            explicit CompiledScript(Interpreter::Program&& program, const Compiler::Locals& locals)
-                : mProgram(std::move(program))
-                , mLocals(locals)
-            {
-            }
+            explicit CompiledScript(Interpreter::Program&& program, const Compiler::Locals& locals);
         };
 
         std::unordered_map<ESM::RefId, CompiledScript> mScripts;
@@ -68,6 +65,10 @@ namespace MWScript
         bool run(const ESM::RefId& name, Interpreter::Context& interpreterContext) override;
         ///< Run the script with the given name (compile first, if not compiled yet)
 
+        bool isActivationOnly(const ESM::RefId& name) const;
+        ///< Does the compiled script do nothing until its reference is activated? False if not compiled yet,
+        /// see Compiler::isActivationOnly.
+
         bool compile(const ESM::RefId& name) override;
         ///< Compile script with the given namen
         /// \return Success?
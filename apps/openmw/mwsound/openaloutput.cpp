@@ -12,6 +12,7 @@
 #include <cstdint>
 
 #include <components/debug/debuglog.hpp>
+#include <components/debug/tracing.hpp>
 #include <components/misc/constants.hpp>
 #include <components/misc/resourcehelpers.hpp>
 #include <components/misc/thread.hpp>
@@ -37,6 +38,10 @@ namespace
 
     const float sLoudnessFPS = 20.0f; // loudness values per second of audio
 
+    // Direct path low-pass filter of a fully occluded sound
+    const float sOcclusionGain = 0.6f;
+    const float sOcclusionGainHF = 0.1f;
+
     ALCenum checkALCError(ALCdevice* device, const char* func, int line)
     {
         ALCenum err = alcGetError(device);
@@ -349,16 +354,20 @@ namespace MWSound
         // thread entry point
         void run()
         {
+            Debug::Tracing::setThreadName("Sound streaming");
             std::unique_lock<std::mutex> lock(mMutex);
             while (!mQuitNow)
             {
-                auto iter = mStreams.begin();
-                while (iter != mStreams.end())
                 {
-                    if ((*iter)->process() == false)
-                        iter = mStreams.erase(iter);
-                    else
-                        ++iter;
+                    const Debug::TraceZone zone("Sound streams");
+                    auto iter = mStreams.begin();
+                    while (iter != mStreams.end())
+                    {
+                        if ((*iter)->process() == false)
+                            iter = mStreams.erase(iter);
+                        else
+                            ++iter;
+                    }
                 }
 
                 mCondVar.wait_for(lock, std::chrono::milliseconds(50));
@@ -925,6 +934,20 @@ namespace MWSound
                 alGetError();
             }
 
+            if (mWaterFilter)
+            {
+                alGenFilters(1, &mOcclusionFilter);
+                if (alGetError() == AL_NO_ERROR)
+                    alFilteri(mOcclusionFilter, AL_FILTER_TYPE, AL_FILTER_LOWPASS);
+                if (alGetError() != AL_NO_ERROR)
+                {
+                    if (mOcclusionFilter && alIsFilter(mOcclusionFilter))
+                        alDeleteFilters(1, &mOcclusionFilter);
+                    mOcclusionFilter = 0;
+                    alGetError();
+                }
+            }
+
             alGenAuxiliaryEffectSlots(1, &mEffectSlot);
             alGetError();
 
@@ -979,6 +1002,8 @@ namespace MWSound
         for (ALuint source : mFreeSources)
             alDeleteSources(1, &source);
         mFreeSources.clear();
+        mPendingSounds.clear();
+        mLoadingBuffers.clear();
 
         if (mEffectSlot)
             alDeleteAuxiliaryEffectSlots(1, &mEffectSlot);
@@ -992,6 +1017,9 @@ namespace MWSound
         if (mWaterFilter)
             alDeleteFilters(1, &mWaterFilter);
         mWaterFilter = 0;
+        if (mOcclusionFilter)
+            alDeleteFilters(1, &mOcclusionFilter);
+        mOcclusionFilter = 0;
 
         if (alEventCallbackSOFT)
             alEventCallbackSOFT(nullptr, nullptr);
@@ -1029,52 +1057,67 @@ namespace MWSound
         return ret;
     }
 
-    std::pair<Sound_Handle, size_t> OpenALOutput::loadSound(VFS::Path::NormalizedView fname)
+    std::optional<size_t> OpenALOutput::fillBuffer(ALuint buffer, DecodedSound&& sound)
     {
         getALError();
 
-        std::vector<char> data;
-        ALenum format = AL_NONE;
-        int srate = 0;
-
-        try
-        {
-            DecoderPtr decoder = mManager.getDecoder();
-            decoder->open(Misc::ResourceHelpers::correctSoundPath(fname, *decoder->mResourceMgr));
-
-            ChannelConfig chans;
-            SampleType type;
-            decoder->getInfo(&srate, &chans, &type);
-            format = getALFormat(chans, type);
-            if (format)
-                decoder->readAll(data);
-        }
-        catch (std::exception& e)
-        {
-            Log(Debug::Error) << "Failed to load audio from " << fname << ": " << e.what();
-        }
-
-        if (data.empty())
+        ALenum format = sound.mData.empty() ? AL_NONE : getALFormat(sound.mChannels, sound.mType);
+        if (format == AL_NONE)
         {
             // If we failed to get any usable audio, substitute with silence.
             format = AL_FORMAT_MONO8;
-            srate = 8000;
-            data.assign(8000, -128);
+            sound.mSampleRate = 8000;
+            sound.mData.assign(8000, -128);
         }
 
-        ALint size;
+        ALint size = 0;
+        alBufferData(buffer, format, sound.mData.data(), static_cast<ALsizei>(sound.mData.size()), sound.mSampleRate);
+        alGetBufferi(buffer, AL_SIZE, &size);
+        if (getALError() != AL_NO_ERROR)
+            return std::nullopt;
+        return static_cast<size_t>(size);
+    }
+
+    std::pair<Sound_Handle, size_t> OpenALOutput::loadSound(VFS::Path::NormalizedView fname)
+    {
+        DecoderPtr decoder = mManager.getDecoder();
+        DecodedSound sound = decodeSound(*decoder, fname);
+
+        getALError();
         ALuint buf = 0;
         alGenBuffers(1, &buf);
-        alBufferData(buf, format, data.data(), static_cast<ALsizei>(data.size()), srate);
-        alGetBufferi(buf, AL_SIZE, &size);
-        if (getALError() != AL_NO_ERROR)
+        if (getALError() == AL_NO_ERROR)
         {
-            if (buf && alIsBuffer(buf))
-                alDeleteBuffers(1, &buf);
-            getALError();
-            return std::make_pair(nullptr, 0);
+            if (const std::optional<size_t> size = fillBuffer(buf, std::move(sound)))
+                return std::make_pair(MAKE_PTRID(buf), *size);
         }
-        return std::make_pair(MAKE_PTRID(buf), size);
+        if (buf && alIsBuffer(buf))
+            alDeleteBuffers(1, &buf);
+        getALError();
+        return std::make_pair(nullptr, 0);
+    }
+
+    Sound_Handle OpenALOutput::createSound()
+    {
+        getALError();
+        ALuint buf = 0;
+        alGenBuffers(1, &buf);
+        if (getALError() != AL_NO_ERROR)
+            return nullptr;
+        mLoadingBuffers.insert(buf);
+        return MAKE_PTRID(buf);
+    }
+
+    size_t OpenALOutput::loadSound(Sound_Handle data, DecodedSound&& sound)
+    {
+        const ALuint buffer = GET_PTRID(data);
+        if (mLoadingBuffers.erase(buffer) == 0)
+            return 0;
+        // Sources waiting for a failed buffer are started anyway and stop right away, so they are found not
+        // playing and get finished by the manager.
+        const size_t size = fillBuffer(buffer, std::move(sound)).value_or(0);
+        startPendingSounds();
+        return size;
     }
 
     size_t OpenALOutput::unloadSound(Sound_Handle data)
@@ -1083,6 +1126,11 @@ namespace MWSound
         if (!buffer)
             return 0;
 
+        // Sounds waiting for this buffer will never start, leave their sources in the initial state so they are
+        // reported as not playing.
+        if (mLoadingBuffers.erase(buffer) > 0)
+            std::erase_if(mPendingSounds, [&](const PendingSound& pending) { return pending.mBuffer == buffer; });
+
         // Make sure no sources are playing this buffer before unloading it.
         SoundVec::const_iterator iter = mActiveSounds.begin();
         for (; iter != mActiveSounds.end(); ++iter)
@@ -1200,20 +1248,34 @@ namespace MWSound
         alSourcefv(source, AL_VELOCITY, vel.ptr());
     }
 
-    bool OpenALOutput::playSound(Sound* sound, Sound_Handle data, float offset)
+    void OpenALOutput::updateOcclusionFilter(ALuint source, SoundBase& sound)
     {
-        ALuint source;
+        if (!mOcclusionFilter || !sound.getIs3D() || !sound.getUseEnv())
+            return;
 
-        if (mFreeSources.empty())
+        const float occlusion = sound.getOcclusion();
+        if (occlusion <= 0.0f && !sound.mOccluded)
+            return;
+
+        const bool underwater = mListenerEnv == Env_Underwater;
+        sound.mOccluded = occlusion > 0.0f;
+        if (!sound.mOccluded)
         {
-            Log(Debug::Warning) << "No free sources!";
-            return false;
+            alSourcei(source, AL_DIRECT_FILTER, underwater ? mWaterFilter : AL_FILTER_NULL);
+            return;
         }
-        source = mFreeSources.front();
 
-        initCommon2D(source, sound->getPosition(), sound->getRealVolume(), getTimeScaledPitch(sound),
-            sound->getIsLooping(), sound->getUseEnv());
-        alSourcei(source, AL_BUFFER, GET_PTRID(data));
+        // Source copies the filter properties, so the same filter object is reused with different values
+        const float gain = (underwater ? 0.9f : 1.0f) * (1.0f - occlusion * (1.0f - sOcclusionGain));
+        const float gainHF = (underwater ? 0.125f : 1.0f) * (1.0f - occlusion * (1.0f - sOcclusionGainHF));
+        alFilterf(mOcclusionFilter, AL_LOWPASS_GAIN, gain);
+        alFilterf(mOcclusionFilter, AL_LOWPASS_GAINHF, gainHF);
+        alSourcei(source, AL_DIRECT_FILTER, mOcclusionFilter);
+    }
+
+    bool OpenALOutput::startSource(ALuint source, ALuint buffer, float offset)
+    {
+        alSourcei(source, AL_BUFFER, buffer);
         alSourcef(source, AL_SEC_OFFSET, offset);
         if (getALError() != AL_NO_ERROR)
         {
@@ -1232,6 +1294,46 @@ namespace MWSound
             return false;
         }
 
+        return true;
+    }
+
+    bool OpenALOutput::isPending(const Sound* sound) const
+    {
+        return std::any_of(mPendingSounds.begin(), mPendingSounds.end(),
+            [&](const PendingSound& pending) { return pending.mSound == sound; });
+    }
+
+    void OpenALOutput::startPendingSounds()
+    {
+        std::erase_if(mPendingSounds, [&](const PendingSound& pending) {
+            if (mLoadingBuffers.contains(pending.mBuffer))
+                return false;
+            startSource(GET_PTRID(pending.mSound->mHandle), pending.mBuffer, pending.mOffset);
+            return true;
+        });
+    }
+
+    bool OpenALOutput::playSound(Sound* sound, Sound_Handle data, float offset)
+    {
+        ALuint source;
+
+        if (mFreeSources.empty())
+        {
+            Log(Debug::Warning) << "No free sources!";
+            return false;
+        }
+        source = mFreeSources.front();
+
+        initCommon2D(source, sound->getPosition(), sound->getRealVolume(), getTimeScaledPitch(sound),
+            sound->getIsLooping(), sound->getUseEnv());
+
+        const ALuint buffer = GET_PTRID(data);
+        // Start playing once the buffer data is decoded
+        if (mLoadingBuffers.contains(buffer))
+            mPendingSounds.push_back(PendingSound{ sound, buffer, offset });
+        else if (!startSource(source, buffer, offset))
+            return false;
+
         mFreeSources.pop_front();
         sound->mHandle = MAKE_PTRID(source);
         mActiveSounds.push_back(sound);
@@ -1253,24 +1355,13 @@ namespace MWSound
         initCommon3D(source, sound->getPosition(), sound->getVelocity(), sound->getMinDistance(),
             sound->getMaxDistance(), sound->getRealVolume(), getTimeScaledPitch(sound), sound->getIsLooping(),
             sound->getUseEnv());
-        alSourcei(source, AL_BUFFER, GET_PTRID(data));
-        alSourcef(source, AL_SEC_OFFSET, offset);
-        if (getALError() != AL_NO_ERROR)
-        {
-            alSourceRewind(source);
-            alSourcei(source, AL_BUFFER, 0);
-            alGetError();
-            return false;
-        }
 
-        alSourcePlay(source);
-        if (getALError() != AL_NO_ERROR)
-        {
-            alSourceRewind(source);
-            alSourcei(source, AL_BUFFER, 0);
-            alGetError();
+        const ALuint buffer = GET_PTRID(data);
+        // Start playing once the buffer data is decoded
+        if (mLoadingBuffers.contains(buffer))
+            mPendingSounds.push_back(PendingSound{ sound, buffer, offset });
+        else if (!startSource(source, buffer, offset))
             return false;
-        }
 
         mFreeSources.pop_front();
         sound->mHandle = MAKE_PTRID(source);
@@ -1286,6 +1377,8 @@ namespace MWSound
         ALuint source = GET_PTRID(sound->mHandle);
         sound->mHandle = nullptr;
 
+        std::erase_if(mPendingSounds, [&](const PendingSound& pending) { return pending.mSound == sound; });
+
         // Rewind the stream to put the source back into an AL_INITIAL state, for
         // the next time it's used.
         alSourceRewind(source);
@@ -1300,6 +1393,8 @@ namespace MWSound
     {
         if (!sound->mHandle)
             return false;
+        if (isPending(sound))
+            return true;
         ALuint source = GET_PTRID(sound->mHandle);
         ALint state = AL_STOPPED;
 
@@ -1317,6 +1412,7 @@ namespace MWSound
 
         updateCommon(source, sound->getPosition(), sound->getVelocity(), sound->getMaxDistance(),
             sound->getRealVolume(), getTimeScaledPitch(sound), sound->getUseEnv());
+        updateOcclusionFilter(source, *sound);
         getALError();
     }
 
@@ -1448,6 +1544,7 @@ namespace MWSound
 
         updateCommon(source, sound->getPosition(), sound->getVelocity(), sound->getMaxDistance(),
             sound->getRealVolume(), getTimeScaledPitch(sound), sound->getUseEnv());
+        updateOcclusionFilter(source, *sound);
         getALError();
     }
 
@@ -1565,7 +1662,7 @@ namespace MWSound
         std::vector<ALuint> sources;
         for (Sound* sound : mActiveSounds)
         {
-            if ((types & sound->getPlayType()))
+            if ((types & sound->getPlayType()) && !isPending(sound))
                 sources.push_back(GET_PTRID(sound->mHandle));
         }
         for (Stream* sound : mActiveStreams)
@@ -1589,6 +1686,7 @@ namespace MWSound
         , mContext(nullptr)
         , mListenerEnv(Env_Normal)
         , mWaterFilter(0)
+        , mOcclusionFilter(0)
         , mWaterEffect(0)
         , mDefaultEffect(0)
         , mEffectSlot(0)
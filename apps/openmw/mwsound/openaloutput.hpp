@@ -4,7 +4,9 @@
 #include <deque>
 #include <map>
 #include <mutex>
+#include <optional>
 #include <string>
+#include <unordered_set>
 #include <vector>
 
 #include <components/vfs/pathutil.hpp>
@@ -45,11 +47,24 @@ namespace MWSound
         typedef std::vector<Stream*> StreamVec;
         StreamVec mActiveStreams;
 
+        struct PendingSound
+        {
+            Sound* mSound;
+            ALuint mBuffer;
+            float mOffset;
+        };
+
+        // Sounds having a source but waiting for the buffer data to start
+        std::vector<PendingSound> mPendingSounds;
+        // Buffers created by createSound and not yet filled with data
+        std::unordered_set<ALuint> mLoadingBuffers;
+
         osg::Vec3f mListenerPos;
         osg::Vec3f mListenerVel;
         Environment mListenerEnv;
 
         ALuint mWaterFilter;
+        ALuint mOcclusionFilter;
         ALuint mWaterEffect;
         ALuint mDefaultEffect;
         ALuint mEffectSlot;
@@ -73,6 +88,16 @@ namespace MWSound
 
         float getTimeScaledPitch(SoundBase* sound);
 
+        void updateOcclusionFilter(ALuint source, SoundBase& sound);
+
+        std::optional<size_t> fillBuffer(ALuint buffer, DecodedSound&& sound);
+
+        bool startSource(ALuint source, ALuint buffer, float offset);
+
+        bool isPending(const Sound* sound) const;
+
+        void startPendingSounds();
+
         OpenALOutput& operator=(const OpenALOutput& rhs);
         OpenALOutput(const OpenALOutput& rhs);
 
@@ -89,6 +114,8 @@ namespace MWSound
         std::vector<std::string> enumerateHrtf() override;
 
         std::pair<Sound_Handle, size_t> loadSound(VFS::Path::NormalizedView fname) override;
+        Sound_Handle createSound() override;
+        size_t loadSound(Sound_Handle data, DecodedSound&& sound) override;
         size_t unloadSound(Sound_Handle data) override;
 
         bool playSound(Sound* sound, Sound_Handle data, float offset) override;
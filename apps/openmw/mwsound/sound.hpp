@@ -42,6 +42,9 @@ namespace MWSound
         float mFadeVolume = 1.0f;
         float mFadeTarget = 0.0f;
         float mFadeStep = 0.0f;
+        // 0 means a clear path to the listener, 1 means fully occluded
+        float mOcclusion = 0.0f;
+        float mOcclusionTarget = 0.0f;
     };
 
     class SoundBase
@@ -54,6 +57,7 @@ namespace MWSound
 
     protected:
         Sound_Instance mHandle = nullptr;
+        bool mOccluded = false;
 
         friend class OpenALOutput;
 
@@ -153,6 +157,15 @@ namespace MWSound
             return getInFade() || !(mParams.mFlags & Play_StopAtFadeEnd);
         }
 
+        void setOcclusionTarget(float value) { mParams.mOcclusionTarget = value; }
+
+        /// Moves occlusion towards the target by at most maxStep.
+        void updateOcclusion(float maxStep)
+        {
+            const float delta = mParams.mOcclusionTarget - mParams.mOcclusion;
+            mParams.mOcclusion += std::clamp(delta, -maxStep, maxStep);
+        }
+
         const osg::Vec3f& getPosition() const { return mParams.mPos; }
         const osg::Vec3f& getLastPosition() const { return mParams.mLastPos; }
         const osg::Vec3f& getVelocity() const { return mParams.mVel; }
@@ -167,11 +180,13 @@ namespace MWSound
         bool getDistanceCull() const { return mParams.mFlags & MWSound::PlayMode::RemoveAtDistance; }
         bool getIs3D() const { return mParams.mFlags & Play_3D; }
         bool getInFade() const { return mParams.mFlags & Play_InFade; }
+        float getOcclusion() const { return mParams.mOcclusion; }
 
         void init(const SoundParams& params)
         {
             mParams = params;
             mHandle = nullptr;
+            mOccluded = false;
         }
 
         SoundBase() = default;
@@ -1,5 +1,8 @@
 #include "soundbuffer.hpp"
 
+#include "ffmpegdecoder.hpp"
+#include "sounddecoder.hpp"
+
 #include "../mwbase/environment.hpp"
 #include "../mwworld/esmstore.hpp"
 
@@ -9,10 +12,12 @@
 #include <components/esm4/loadsoun.hpp>
 #include <components/misc/resourcehelpers.hpp>
 #include <components/resource/resourcesystem.hpp>
+#include <components/sceneutil/workqueue.hpp>
 #include <components/settings/values.hpp>
 #include <components/vfs/pathutil.hpp>
 
 #include <algorithm>
+#include <atomic>
 #include <cmath>
 
 namespace MWSound
@@ -36,14 +41,52 @@ namespace MWSound
             params.mAudioMaxDistanceMult = settings.find("fAudioMaxDistanceMult")->mValue.getFloat();
             return params;
         }
+
+        std::size_t megabytesToBytes(int value)
+        {
+            return static_cast<std::size_t>(value) * 1024 * 1024;
+        }
     }
 
-    SoundBufferPool::SoundBufferPool(SoundOutput& output)
+    class DecodeSoundWorkItem : public SceneUtil::WorkItem
+    {
+    public:
+        explicit DecodeSoundWorkItem(const VFS::Manager& vfs, VFS::Path::NormalizedView fileName)
+            : mVFS(vfs)
+            , mFileName(fileName)
+        {
+        }
+
+        void doWork() override
+        {
+            if (mAborted)
+                return;
+            FFmpegDecoder decoder(&mVFS);
+            mResult = decodeSound(decoder, mFileName);
+        }
+
+        void abort() override { mAborted = true; }
+
+        DecodedSound takeResult() { return std::move(mResult); }
+
+    private:
+        const VFS::Manager& mVFS;
+        VFS::Path::Normalized mFileName;
+        std::atomic_bool mAborted{ false };
+        DecodedSound mResult;
+    };
+
+    SoundBufferPool::SoundBufferPool(SoundOutput& output, const VFS::Manager& vfs)
         : mOutput(&output)
-        , mBufferCacheMax(Settings::sound().mBufferCacheMax * 1024 * 1024)
-        , mBufferCacheMin(
-              std::min(static_cast<std::size_t>(Settings::sound().mBufferCacheMin) * 1024 * 1024, mBufferCacheMax))
+        , mVFS(&vfs)
+        , mLongBufferSize(static_cast<std::size_t>(Settings::sound().mLongBufferSize) * 1024)
+        , mBufferCache{ .mMax = megabytesToBytes(Settings::sound().mBufferCacheMax),
+            .mMin = megabytesToBytes(std::min(Settings::sound().mBufferCacheMin, Settings::sound().mBufferCacheMax)) }
+        , mLongBufferCache{ .mMax = megabytesToBytes(Settings::sound().mLongBufferCacheMax),
+            .mMin = megabytesToBytes(Settings::sound().mLongBufferCacheMax) }
     {
+        if (const int threads = Settings::sound().mDecoderThreads; threads > 0)
+            mWorkQueue = new SceneUtil::WorkQueue(static_cast<std::size_t>(threads));
     }
 
     SoundBufferPool::~SoundBufferPool()
@@ -80,24 +123,82 @@ namespace MWSound
         if (sfx->getHandle() != nullptr)
             return sfx;
 
-        auto [handle, size] = mOutput->loadSound(sfx->getResourceName());
-        if (handle == nullptr)
-            return {};
-
-        sfx->mHandle = handle;
+        if (mWorkQueue == nullptr)
+        {
+            auto [handle, size] = mOutput->loadSound(sfx->getResourceName());
+            if (handle == nullptr)
+                return {};
 
-        mBufferCacheSize += size;
-        if (mBufferCacheSize > mBufferCacheMax)
+            sfx->mHandle = handle;
+            onBufferLoaded(*sfx, size);
+            checkBufferCacheSize(getBufferCache(*sfx));
+        }
+        else
         {
-            unloadUnused();
-            if (!mUnusedBuffers.empty() && mBufferCacheSize > mBufferCacheMax)
-                Log(Debug::Warning) << "No unused sound buffers to free, using " << mBufferCacheSize << " bytes!";
+            // Output delays playing the sound until the data is provided by update
+            sfx->mHandle = mOutput->createSound();
+            if (sfx->mHandle == nullptr)
+                return {};
+
+            osg::ref_ptr<DecodeSoundWorkItem> item(new DecodeSoundWorkItem(*mVFS, sfx->getResourceName()));
+            mWorkQueue->addWorkItem(item);
+            mDecoding.emplace_back(sfx, std::move(item));
         }
+
         mUnusedBuffers.push_front(sfx);
 
         return sfx;
     }
 
+    void SoundBufferPool::onBufferLoaded(SoundBuffer& sfx, std::size_t size)
+    {
+        sfx.mSize = size;
+        getBufferCache(sfx).mSize += size;
+    }
+
+    void SoundBufferPool::checkBufferCacheSize(BufferCache& cache)
+    {
+        if (cache.mSize > cache.mMax)
+        {
+            unloadUnused(cache);
+            if (!mUnusedBuffers.empty() && cache.mSize > cache.mMax)
+                Log(Debug::Warning) << "No unused sound buffers to free, using " << cache.mSize << " bytes!";
+        }
+    }
+
+    void SoundBufferPool::cancelDecoding(SoundBuffer& sfx)
+    {
+        const auto it
+            = std::find_if(mDecoding.begin(), mDecoding.end(), [&](const auto& v) { return v.first == &sfx; });
+        if (it == mDecoding.end())
+            return;
+        it->second->abort();
+        mDecoding.erase(it);
+    }
+
+    void SoundBufferPool::update()
+    {
+        bool loaded = false;
+        std::erase_if(mDecoding, [&](auto& v) {
+            if (!v.second->isDone())
+                return false;
+            onBufferLoaded(*v.first, mOutput->loadSound(v.first->mHandle, v.second->takeResult()));
+            loaded = true;
+            return true;
+        });
+        if (loaded)
+        {
+            checkBufferCacheSize(mBufferCache);
+            checkBufferCacheSize(mLongBufferCache);
+        }
+    }
+
+    void SoundBufferPool::preload(const ESM::RefId& soundId)
+    {
+        if (mWorkQueue != nullptr)
+            load(soundId);
+    }
+
     SoundBuffer* SoundBufferPool::load(const ESM::RefId& soundId)
     {
         if (mBufferNameMap.empty())
@@ -142,12 +243,19 @@ namespace MWSound
 
     void SoundBufferPool::clear()
     {
+        for (const auto& [sfx, item] : mDecoding)
+            item->abort();
+        mDecoding.clear();
+
         for (auto& sfx : mSoundBuffers)
         {
             if (sfx.mHandle)
                 mOutput->unloadSound(sfx.mHandle);
             sfx.mHandle = nullptr;
+            sfx.mSize = 0;
         }
+        mBufferCache.mSize = 0;
+        mLongBufferCache.mSize = 0;
 
         mBufferFileNameMap.clear();
         mBufferNameMap.clear();
@@ -220,16 +328,21 @@ namespace MWSound
         return &sfx;
     }
 
-    void SoundBufferPool::unloadUnused()
+    void SoundBufferPool::unloadUnused(BufferCache& cache)
     {
-        while (!mUnusedBuffers.empty() && mBufferCacheSize > mBufferCacheMin)
+        for (auto it = mUnusedBuffers.end(); it != mUnusedBuffers.begin() && cache.mSize > cache.mMin;)
         {
-            SoundBuffer* const unused = mUnusedBuffers.back();
+            --it;
+            SoundBuffer* const unused = *it;
+            if (&getBufferCache(*unused) != &cache)
+                continue;
 
-            mBufferCacheSize -= mOutput->unloadSound(unused->getHandle());
+            cancelDecoding(*unused);
+            cache.mSize -= mOutput->unloadSound(unused->getHandle());
             unused->mHandle = nullptr;
+            unused->mSize = 0;
 
-            mUnusedBuffers.pop_back();
+            it = mUnusedBuffers.erase(it);
         }
     }
 }
@@ -5,6 +5,10 @@
 #include <deque>
 #include <string>
 #include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include <osg/ref_ptr>
 
 #include <components/esm/refid.hpp>
 
@@ -26,9 +30,15 @@ namespace VFS
     class Manager;
 }
 
+namespace SceneUtil
+{
+    class WorkQueue;
+}
+
 namespace MWSound
 {
     class SoundBufferPool;
+    class DecodeSoundWorkItem;
 
     class SoundBuffer
     {
@@ -59,6 +69,8 @@ namespace MWSound
         float mMaxDist;
         Sound_Handle mHandle = nullptr;
         std::size_t mUses = 0;
+        // Size of the decoded data, 0 until it's loaded
+        std::size_t mSize = 0;
 
         friend class SoundBufferPool;
     };
@@ -66,7 +78,7 @@ namespace MWSound
     class SoundBufferPool
     {
     public:
-        SoundBufferPool(SoundOutput& output);
+        SoundBufferPool(SoundOutput& output, const VFS::Manager& vfs);
 
         SoundBufferPool(const SoundBufferPool&) = delete;
 
@@ -87,6 +99,13 @@ namespace MWSound
         // Lookup for a sound by file name, and ensure it's ready for use.
         SoundBuffer* load(std::string_view fileName);
 
+        /// Start decoding a sound in background so it's ready by the time it's played. Does nothing when
+        /// sounds are decoded on the main thread.
+        void preload(const ESM::RefId& soundId);
+
+        /// Pass decoded sounds to the output, sounds already played with them start playing. Call every frame.
+        void update();
+
         void use(SoundBuffer& sfx)
         {
             if (sfx.mUses++ == 0)
@@ -108,13 +127,35 @@ namespace MWSound
     private:
         SoundBuffer* loadSfx(SoundBuffer* sfx);
 
+        void cancelDecoding(SoundBuffer& sfx);
+
+        struct BufferCache
+        {
+            std::size_t mMax;
+            std::size_t mMin;
+            std::size_t mSize = 0;
+        };
+
+        BufferCache& getBufferCache(const SoundBuffer& sfx)
+        {
+            return mLongBufferSize != 0 && sfx.mSize >= mLongBufferSize ? mLongBufferCache : mBufferCache;
+        }
+
+        void onBufferLoaded(SoundBuffer& sfx, std::size_t size);
+
+        void checkBufferCacheSize(BufferCache& cache);
+
         SoundOutput* mOutput;
+        const VFS::Manager* mVFS;
+        osg::ref_ptr<SceneUtil::WorkQueue> mWorkQueue;
+        std::vector<std::pair<SoundBuffer*, osg::ref_ptr<DecodeSoundWorkItem>>> mDecoding;
         std::deque<SoundBuffer> mSoundBuffers;
         std::unordered_map<ESM::RefId, SoundBuffer*> mBufferNameMap;
         std::unordered_map<std::string, SoundBuffer*> mBufferFileNameMap;
-        std::size_t mBufferCacheMax;
-        std::size_t mBufferCacheMin;
-        std::size_t mBufferCacheSize = 0;
+        std::size_t mLongBufferSize;
+        BufferCache mBufferCache;
+        // Long sounds like ambient loops are kept apart to not push out short sounds played often
+        BufferCache mLongBufferCache;
         // NOTE: unused buffers are stored in front-newest order.
         std::deque<SoundBuffer*> mUnusedBuffers;
 
@@ -123,7 +164,7 @@ namespace MWSound
         SoundBuffer* insertSound(const ESM::RefId& soundId, const ESM4::SoundReference& sound);
         SoundBuffer* insertSound(std::string_view fileName);
 
-        inline void unloadUnused();
+        inline void unloadUnused(BufferCache& cache);
     };
 }
 
@@ -34,6 +34,14 @@ namespace MWSound
     size_t framesToBytes(size_t frames, ChannelConfig config, SampleType type);
     size_t bytesToFrames(size_t bytes, ChannelConfig config, SampleType type);
 
+    struct DecodedSound
+    {
+        std::vector<char> mData;
+        int mSampleRate = 0;
+        ChannelConfig mChannels = ChannelConfig_Mono;
+        SampleType mType = SampleType_UInt8;
+    };
+
     struct SoundDecoder
     {
         const VFS::Manager* mResourceMgr;
@@ -58,6 +66,10 @@ namespace MWSound
         SoundDecoder(const SoundDecoder& rhs);
         SoundDecoder& operator=(const SoundDecoder& rhs);
     };
+
+    // Reads whole file, returns empty data on failure. Doesn't depend on the sound output so can be used from any
+    // thread with own decoder.
+    DecodedSound decodeSound(SoundDecoder& decoder, VFS::Path::NormalizedView fname);
 }
 
 #endif
@@ -8,6 +8,7 @@
 #include <osg/Matrixf>
 
 #include <components/debug/debuglog.hpp>
+#include <components/esm3/loadregn.hpp>
 #include <components/misc/resourcehelpers.hpp>
 #include <components/misc/rng.hpp>
 #include <components/settings/values.hpp>
@@ -25,6 +26,8 @@
 
 #include "../mwmechanics/actorutil.hpp"
 
+#include "../mwphysics/raycasting.hpp"
+
 #include "constants.hpp"
 #include "ffmpegdecoder.hpp"
 #include "openaloutput.hpp"
@@ -41,6 +44,25 @@ namespace MWSound
         constexpr float sSfxFadeInDuration = 1.0f;
         constexpr float sSfxFadeOutDuration = 1.0f;
         constexpr float sSoundCullDistance = 2000.f;
+        // Occlusion changes from none to full within 1/speed seconds
+        constexpr float sOcclusionChangeSpeed = 4.0f;
+        // Stop occlusion rays short of the sound position to not hit the collision of the sound source itself
+        constexpr float sOcclusionSourceMargin = 64.0f;
+
+        bool isOccludable(const SoundBase& sound)
+        {
+            return sound.getIs3D() && sound.getUseEnv();
+        }
+
+        MWPhysics::RaySegment makeOcclusionRay(const osg::Vec3f& listener, const osg::Vec3f& source)
+        {
+            const osg::Vec3f direction = source - listener;
+            const float distance = direction.length();
+            if (distance <= sOcclusionSourceMargin)
+                return MWPhysics::RaySegment{ listener, listener };
+            const float factor = (distance - sOcclusionSourceMargin) / distance;
+            return MWPhysics::RaySegment{ listener, listener + direction * factor };
+        }
 
         WaterSoundUpdaterSettings makeWaterSoundUpdaterSettings()
         {
@@ -113,7 +135,7 @@ namespace MWSound
         : mVFS(vfs)
         , mOutput(std::make_unique<OpenALOutput>(*this))
         , mWaterSoundUpdater(makeWaterSoundUpdaterSettings())
-        , mSoundBuffers(*mOutput)
+        , mSoundBuffers(*mOutput, *vfs)
         , mMusicType(MWSound::MusicType::Normal)
         , mListenerUnderwater(false)
         , mListenerPos(0, 0, 0)
@@ -492,11 +514,11 @@ namespace MWSound
         if (!mOutput->isInitialized())
             return nullptr;
 
-        std::string normalizedName = VFS::Path::normalizeFilename(fileName);
+        const VFS::Path::Normalized normalizedName(fileName);
         if (!mVFS->exists(normalizedName))
             return nullptr;
 
-        SoundBuffer* sfx = mSoundBuffers.load(normalizedName);
+        SoundBuffer* sfx = mSoundBuffers.load(normalizedName.view());
         if (!sfx)
             return nullptr;
 
@@ -591,11 +613,11 @@ namespace MWSound
             return nullptr;
 
         // Look up the sound
-        std::string normalizedName = VFS::Path::normalizeFilename(fileName);
+        const VFS::Path::Normalized normalizedName(fileName);
         if (!mVFS->exists(normalizedName))
             return nullptr;
 
-        SoundBuffer* sfx = mSoundBuffers.load(normalizedName);
+        SoundBuffer* sfx = mSoundBuffers.load(normalizedName.view());
         if (!sfx)
             return nullptr;
 
@@ -637,6 +659,14 @@ namespace MWSound
         return result;
     }
 
+    void SoundManager::preloadSound(const ESM::RefId& soundId)
+    {
+        if (!mOutput->isInitialized())
+            return;
+
+        mSoundBuffers.preload(soundId);
+    }
+
     void SoundManager::stopSound(Sound* sound)
     {
         if (sound)
@@ -673,8 +703,8 @@ namespace MWSound
         if (!mOutput->isInitialized())
             return;
 
-        std::string normalizedName = VFS::Path::normalizeFilename(fileName);
-        SoundBuffer* sfx = mSoundBuffers.lookup(normalizedName);
+        const VFS::Path::Normalized normalizedName(fileName);
+        SoundBuffer* sfx = mSoundBuffers.lookup(normalizedName.view());
         if (!sfx)
             return;
 
@@ -739,12 +769,12 @@ namespace MWSound
 
     bool SoundManager::getSoundPlaying(const MWWorld::ConstPtr& ptr, std::string_view fileName) const
     {
-        std::string normalizedName = VFS::Path::normalizeFilename(fileName);
+        const VFS::Path::Normalized normalizedName(fileName);
 
         SoundMap::const_iterator snditer = mActiveSounds.find(ptr.mRef);
         if (snditer != mActiveSounds.end())
         {
-            SoundBuffer* sfx = mSoundBuffers.lookup(normalizedName);
+            SoundBuffer* sfx = mSoundBuffers.lookup(normalizedName.view());
             if (!sfx)
                 return false;
 
@@ -830,6 +860,11 @@ namespace MWSound
 
         if (!cell->isExterior() && !cell->isQuasiExterior())
             return;
+        if (cell->getRegion() != mPreloadedRegion)
+        {
+            mPreloadedRegion = cell->getRegion();
+            preloadRegionSounds(mPreloadedRegion);
+        }
         if (mCurrentRegionSound && mOutput->isSoundPlaying(mCurrentRegionSound))
             return;
 
@@ -838,6 +873,16 @@ namespace MWSound
             mCurrentRegionSound = playSound(next, 1.0f, 1.0f);
     }
 
+    void SoundManager::preloadRegionSounds(const ESM::RefId& regionId)
+    {
+        const ESM::Region* const region
+            = MWBase::Environment::get().getESMStore()->get<ESM::Region>().search(regionId);
+        if (region == nullptr)
+            return;
+        for (const ESM::Region::SoundRef& sound : region->mSoundList)
+            mSoundBuffers.preload(sound.mSound);
+    }
+
     void SoundManager::updateWaterSound()
     {
         MWBase::World* world = MWBase::Environment::get().getWorld();
@@ -930,6 +975,46 @@ namespace MWSound
         }
     }
 
+    void SoundManager::updateOcclusion()
+    {
+        if (!Settings::sound().mOcclusion)
+            return;
+
+        mOcclusionCandidates.clear();
+        for (const auto& [ref, activeSound] : mActiveSounds)
+            for (const SoundBufferRefPair& sound : activeSound.mList)
+                if (isOccludable(*sound.first))
+                    mOcclusionCandidates.push_back(sound.first.get());
+        for (const auto& [ref, saySound] : mActiveSaySounds)
+            if (isOccludable(*saySound.mStream))
+                mOcclusionCandidates.push_back(saySound.mStream.get());
+
+        if (mOcclusionCandidates.empty())
+            return;
+
+        // Sounds are checked in turns, so the number of rays per update is limited no matter how much is playing
+        const std::size_t count = std::min(mOcclusionCandidates.size(),
+            static_cast<std::size_t>(Settings::sound().mOcclusionRaysPerUpdate));
+        mOcclusionRays.clear();
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            const SoundBase& sound = *mOcclusionCandidates[(mNextOcclusionCandidate + i) % mOcclusionCandidates.size()];
+            mOcclusionRays.push_back(makeOcclusionRay(mListenerPos, sound.getPosition()));
+        }
+
+        const std::vector<bool> hits = MWBase::Environment::get().getWorld()->getRayCasting()->castRays(
+            mOcclusionRays, MWPhysics::CollisionType_World | MWPhysics::CollisionType_HeightMap
+                | MWPhysics::CollisionType_Door);
+
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            SoundBase& sound = *mOcclusionCandidates[(mNextOcclusionCandidate + i) % mOcclusionCandidates.size()];
+            sound.setOcclusionTarget(hits[i] ? 1.0f : 0.0f);
+        }
+
+        mNextOcclusionCandidate = (mNextOcclusionCandidate + count) % mOcclusionCandidates.size();
+    }
+
     void SoundManager::updateSounds(float duration)
     {
         // We update active say sounds map for specific actors here
@@ -963,6 +1048,8 @@ namespace MWSound
         mOutput->startUpdate();
         mOutput->updateListener(mListenerPos, mListenerDir, mListenerUp, mListenerVel, env);
 
+        updateOcclusion();
+
         updateMusic(duration);
 
         // Check if any sounds are finished playing, and trash them
@@ -987,6 +1074,7 @@ namespace MWSound
                     }
 
                     cull3DSound(sound);
+                    sound->updateOcclusion(duration * sOcclusionChangeSpeed);
                 }
 
                 if (!sound->updateFade(duration) || !mOutput->isSoundPlaying(sound))
@@ -1028,6 +1116,7 @@ namespace MWSound
                 }
 
                 cull3DSound(sound);
+                sound->updateOcclusion(duration * sOcclusionChangeSpeed);
             }
 
             if (!sound->updateFade(duration) || !mOutput->isStreamPlaying(sound))
@@ -1094,6 +1183,8 @@ namespace MWSound
         if (!mOutput->isInitialized() || mPlaybackPaused)
             return;
 
+        mSoundBuffers.update();
+
         MWBase::StateManager::State state = MWBase::Environment::get().getStateManager()->getState();
         bool isMainMenu = MWBase::Environment::get().getWindowManager()->containsMode(MWGui::GM_MainMenu)
             && state == MWBase::StateManager::State_NoGame;
@@ -1197,6 +1288,23 @@ namespace MWSound
         output.resize(total);
     }
 
+    DecodedSound decodeSound(SoundDecoder& decoder, VFS::Path::NormalizedView fname)
+    {
+        DecodedSound result;
+        try
+        {
+            decoder.open(Misc::ResourceHelpers::correctSoundPath(fname, *decoder.mResourceMgr));
+            decoder.getInfo(&result.mSampleRate, &result.mChannels, &result.mType);
+            decoder.readAll(result.mData);
+        }
+        catch (const std::exception& e)
+        {
+            Log(Debug::Error) << "Failed to load audio from " << fname << ": " << e.what();
+            result.mData.clear();
+        }
+        return result;
+    }
+
     const char* getSampleTypeName(SampleType type)
     {
         switch (type)
@@ -1285,6 +1393,7 @@ namespace MWSound
         mActiveSounds.clear();
         mUnderwaterSound = nullptr;
         mNearWaterSound = nullptr;
+        mPreloadedRegion = ESM::RefId();
 
         for (SaySoundMap::value_type& snd : mSaySoundsQueue)
             mOutput->finishStream(snd.second.mStream.get());
@@ -6,6 +6,7 @@
 #include <string>
 #include <unordered_map>
 #include <utility>
+#include <vector>
 
 #include <components/fallback/fallback.hpp>
 #include <components/misc/objectpool.hpp>
@@ -35,6 +36,11 @@ namespace MWWorld
     class Cell;
 }
 
+namespace MWPhysics
+{
+    struct RaySegment;
+}
+
 namespace MWSound
 {
     class SoundOutput;
@@ -110,6 +116,12 @@ namespace MWSound
 
         Sound* mCurrentRegionSound;
 
+        ESM::RefId mPreloadedRegion;
+
+        std::vector<SoundBase*> mOcclusionCandidates;
+        std::vector<MWPhysics::RaySegment> mOcclusionRays;
+        std::size_t mNextOcclusionCandidate = 0;
+
         SoundBuffer* insertSound(const std::string& soundId, const ESM::Sound* sound);
 
         // returns a decoder to start streaming, or nullptr if the sound was not found
@@ -133,7 +145,9 @@ namespace MWSound
             PlayMode mode, float offset);
 
         void updateSounds(float duration);
+        void updateOcclusion();
         void updateRegionSound(float duration);
+        void preloadRegionSounds(const ESM::RefId& regionId);
         void updateWaterSound();
         void updateMusic(float duration);
 
@@ -242,6 +256,9 @@ namespace MWSound
         ///< Sound::setPosition.
         ///< @param offset Number of seconds into the sound to start playback.
 
+        void preloadSound(const ESM::RefId& soundId) override;
+        ///< Start decoding the given sound in background so it's ready by the time it's played.
+
         void stopSound(Sound* sound) override;
         ///< Stop the given sound from playing
         /// @note no-op if \a sound is null
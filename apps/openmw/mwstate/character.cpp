@@ -2,7 +2,10 @@
 
 #include <algorithm>
 #include <cctype>
+#include <cstdint>
 #include <filesystem>
+#include <fstream>
+#include <map>
 #include <sstream>
 #include <tuple>
 #include <utility>
@@ -10,9 +13,66 @@
 #include <components/debug/debuglog.hpp>
 #include <components/esm/defs.hpp>
 #include <components/esm3/esmreader.hpp>
+#include <components/esm3/esmwriter.hpp>
+#include <components/esm3/formatversion.hpp>
+#include <components/files/conversion.hpp>
 #include <components/misc/strings/algorithm.hpp>
 #include <components/misc/utf8stream.hpp>
 
+namespace
+{
+    constexpr ESM::NAME sIndexRecordName = "SLOT";
+
+    struct IndexEntry
+    {
+        std::uintmax_t mSize;
+        std::filesystem::file_time_type mTimeStamp;
+        ESM::SavedGame mProfile;
+    };
+
+    using Index = std::map<std::filesystem::path, IndexEntry>;
+
+    Index readIndex(const std::filesystem::path& path)
+    {
+        Index result;
+        if (!std::filesystem::exists(path))
+            return result;
+        try
+        {
+            ESM::ESMReader reader;
+            reader.open(path);
+            if (reader.getFormatVersion() != ESM::CurrentSaveGameFormatVersion)
+                return result;
+            while (reader.hasMoreRecs())
+            {
+                if (reader.getRecName() != sIndexRecordName)
+                {
+                    reader.skipRecord();
+                    continue;
+                }
+                reader.getRecHeader();
+                const std::string fileName = reader.getHNString("FILE");
+                IndexEntry entry;
+                std::uint64_t size = 0;
+                reader.getHNT(size, "SIZE");
+                entry.mSize = static_cast<std::uintmax_t>(size);
+                std::int64_t timeStamp = 0;
+                reader.getHNT(timeStamp, "TIME");
+                entry.mTimeStamp = std::filesystem::file_time_type(std::filesystem::file_time_type::duration(
+                    static_cast<std::filesystem::file_time_type::rep>(timeStamp)));
+                entry.mProfile.load(reader);
+                result.emplace(std::filesystem::path(fileName), std::move(entry));
+            }
+        }
+        catch (const std::exception& e)
+        {
+            Log(Debug::Warning) << "Failed to read saved games index " << path << ": " << e.what();
+            result.clear();
+        }
+        return result;
+    }
+}
+
 bool MWState::operator<(const Slot& left, const Slot& right)
 {
     return left.mTimeStamp < right.mTimeStamp;
@@ -104,11 +164,37 @@ MWState::Character::Character(const std::filesystem::path& saves, const std::str
     }
     else
     {
+        Index index = readIndex(mPath / sIndexFileName);
+        bool indexChanged = false;
+        std::size_t indexUsed = 0;
+
         for (const auto& iter : std::filesystem::directory_iterator(mPath))
         {
+            const std::filesystem::path fileName = iter.path().filename();
+            if (fileName == sIndexFileName)
+                continue;
+
             try
             {
+                const auto indexed = index.find(fileName);
+                if (indexed != index.end() && indexed->second.mSize == iter.file_size()
+                    && indexed->second.mTimeStamp == iter.last_write_time())
+                {
+                    ++indexUsed;
+                    if (Misc::StringUtils::ciEqual(getFirstGameFile(indexed->second.mProfile.mContentFiles), game))
+                        mSlots.push_back(Slot{ iter.path(), std::move(indexed->second.mProfile),
+                            indexed->second.mTimeStamp });
+                    continue;
+                }
+
+                const std::size_t slotsCount = mSlots.size();
                 addSlot(iter, game);
+                if (mSlots.size() != slotsCount)
+                {
+                    indexChanged = true;
+                    // Keep only headers in memory like for slots restored from the index
+                    mSlots.back().mProfile.mScreenshot = {};
+                }
             }
             catch (const std::exception& e)
             {
@@ -118,6 +204,58 @@ MWState::Character::Character(const std::filesystem::path& saves, const std::str
         }
 
         std::sort(mSlots.begin(), mSlots.end());
+
+        if (indexChanged || indexUsed != index.size())
+            writeIndex();
+    }
+}
+
+void MWState::Character::writeIndex() const
+{
+    const std::filesystem::path path = mPath / sIndexFileName;
+
+    try
+    {
+        std::stringstream stream;
+
+        ESM::ESMWriter writer;
+        writer.setFormatVersion(ESM::CurrentSaveGameFormatVersion);
+        writer.setVersion(0);
+        writer.setType(0);
+        writer.setRecordCount(static_cast<int>(mSlots.size()));
+        writer.save(stream);
+
+        for (const Slot& slot : mSlots)
+        {
+            std::error_code ec;
+            const std::uintmax_t size = std::filesystem::file_size(slot.mPath, ec);
+            if (ec)
+                continue;
+            const std::filesystem::file_time_type timeStamp = std::filesystem::last_write_time(slot.mPath, ec);
+            if (ec)
+                continue;
+
+            ESM::SavedGame profile = slot.mProfile;
+            profile.mScreenshot.clear();
+
+            writer.startRecord(sIndexRecordName);
+            writer.writeHNString("FILE", Files::pathToUnicodeString(slot.mPath.filename()));
+            writer.writeHNT("SIZE", static_cast<std::uint64_t>(size));
+            writer.writeHNT("TIME", static_cast<std::int64_t>(timeStamp.time_since_epoch().count()));
+            profile.save(writer);
+            writer.endRecord(sIndexRecordName);
+        }
+
+        writer.close();
+
+        std::ofstream file(path, std::ios::binary);
+        file << stream.rdbuf();
+        if (file.fail())
+            throw std::runtime_error("Write operation failed: " + std::generic_category().message(errno));
+    }
+    catch (const std::exception& e)
+    {
+        Log(Debug::Warning) << "Failed to write saved games index " << path << ": " << e.what();
     }
 }
 
@@ -128,6 +266,9 @@ void MWState::Character::cleanup()
         // All slots are gone, no need to keep the empty directory
         if (std::filesystem::is_directory(mPath))
         {
+            std::error_code ec;
+            std::filesystem::remove(mPath / sIndexFileName, ec);
+
             // Extra safety check to make sure the directory is empty (e.g. slots failed to parse header)
             std::filesystem::directory_iterator it(mPath);
             if (it == std::filesystem::directory_iterator())
@@ -156,6 +297,8 @@ void MWState::Character::deleteSlot(const Slot* slot)
     std::filesystem::remove(slot->mPath);
 
     mSlots.erase(mSlots.begin() + index);
+
+    writeIndex();
 }
 
 const MWState::Slot* MWState::Character::updateSlot(const Slot* slot, const ESM::SavedGame& profile)
@@ -203,6 +346,22 @@ const ESM::SavedGame& MWState::Character::getSignature() const
     return std::max_element(mSlots.begin(), mSlots.end(), lessByPlayerLevelAndTimeStamp)->mProfile;
 }
 
+std::vector<char> MWState::readScreenshot(const std::filesystem::path& path)
+{
+    ESM::ESMReader reader;
+    reader.open(path);
+
+    if (reader.getRecName() != ESM::REC_SAVE)
+        throw std::runtime_error("Saved game does not start with a header");
+
+    reader.getRecHeader();
+
+    ESM::SavedGame profile;
+    profile.load(reader);
+
+    return std::move(profile.mScreenshot);
+}
+
 const std::filesystem::path& MWState::Character::getPath() const
 {
     return mPath;
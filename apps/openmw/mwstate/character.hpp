@@ -17,6 +17,9 @@ namespace MWState
 
     std::string_view getFirstGameFile(const std::vector<std::string>& contentFiles);
 
+    /// Reads screenshot from a saved game file. Slots restored from the index have no screenshot in the profile.
+    std::vector<char> readScreenshot(const std::filesystem::path& path);
+
     class Character
     {
     public:
@@ -31,6 +34,10 @@ namespace MWState
         void addSlot(const ESM::SavedGame& profile);
 
     public:
+        /// File in the character directory storing profiles of all slots without screenshots. Entries are verified by
+        /// file size and modification time, so the save files are opened only when changed.
+        static constexpr std::string_view sIndexFileName = "saves.index";
+
         Character(const std::filesystem::path& saves, const std::string& game);
 
         void cleanup();
@@ -51,6 +58,9 @@ namespace MWState
         ///
         /// \attention The \a slot pointer will be invalidated by this call.
 
+        void writeIndex() const;
+        ///< Write the index for slots which files exist.
+
         SlotIterator begin() const;
         ///<  Any call to createSlot and updateSlot can invalidate the returned iterator.
 
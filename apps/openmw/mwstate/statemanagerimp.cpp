@@ -1,11 +1,13 @@
 #include "statemanagerimp.hpp"
 
 #include <filesystem>
+#include <fstream>
 
 #include <SDL_clipboard.h>
 
 #include <components/debug/debuglog.hpp>
 
+#include <components/esm3/compressedsavedgame.hpp>
 #include <components/esm3/esmreader.hpp>
 #include <components/esm3/esmwriter.hpp>
 #include <components/esm3/loadcell.hpp>
@@ -211,8 +213,55 @@ void MWState::StateManager::resumeGame()
     MWBase::Environment::get().getLuaManager()->gameLoaded();
 }
 
+void MWState::StateManager::finishPendingSave()
+{
+    if (!mPendingSave.has_value())
+        return;
+
+    PendingSave pendingSave = std::move(*mPendingSave);
+    mPendingSave.reset();
+
+    try
+    {
+        pendingSave.mWrite.get();
+
+        pendingSave.mCharacter->writeIndex();
+
+        const auto finish = std::chrono::steady_clock::now();
+
+        Log(Debug::Info) << '\'' << pendingSave.mDescription << "' is written in "
+                         << std::chrono::duration_cast<std::chrono::duration<float, std::milli>>(
+                                finish - pendingSave.mStart)
+                                .count()
+                         << "ms";
+    }
+    catch (const std::exception& e)
+    {
+        std::stringstream error;
+        error << "Failed to save game: " << e.what();
+
+        Log(Debug::Error) << error.str();
+
+        std::vector<std::string> buttons;
+        buttons.emplace_back("#{Interface:OK}");
+        MWBase::Environment::get().getWindowManager()->interactiveMessageBox(error.str(), buttons);
+
+        // If no file was written, clean up the slot
+        if (!std::filesystem::exists(pendingSave.mSlot->mPath))
+        {
+            if (mLastSavegame == pendingSave.mSlot->mPath)
+                mLastSavegame.clear();
+            pendingSave.mCharacter->deleteSlot(pendingSave.mSlot);
+            pendingSave.mCharacter->cleanup();
+        }
+    }
+}
+
 void MWState::StateManager::saveGame(std::string_view description, const Slot* slot)
 {
+    // Slots of the character may be changed below
+    finishPendingSave();
+
     MWBase::Environment::get().getLuaManager()->applyDelayedActions();
 
     MWState::Character* character = getCurrentCharacter();
@@ -313,6 +362,9 @@ void MWState::StateManager::saveGame(std::string_view description, const Slot* s
         slot->mProfile.save(writer);
         writer.endRecord(ESM::REC_SAVE);
 
+        // Records after the header and the screenshot are compressed if enabled
+        const std::size_t bodyOffset = static_cast<std::size_t>(stream.tellp());
+
         MWBase::Environment::get().getJournal()->write(writer, listener);
         MWBase::Environment::get().getDialogueManager()->write(writer, listener);
         // LuaManager::write should be called before World::write because world also saves
@@ -335,19 +387,37 @@ void MWState::StateManager::saveGame(std::string_view description, const Slot* s
             throw std::runtime_error(
                 "Write operation failed (memory stream): " + std::generic_category().message(errno));
 
-        // All good, write to file
-        std::ofstream filestream(slot->mPath, std::ios::binary);
-        filestream << stream.rdbuf();
-
-        if (filestream.fail())
-            throw std::runtime_error("Write operation failed (file stream): " + std::generic_category().message(errno));
+        // All good, write to file in background. Use a temporary file to keep the existing save intact until the
+        // new one is completely written.
+        mPendingSave = PendingSave{
+            .mCharacter = character,
+            .mSlot = slot,
+            .mDescription = std::string(description),
+            .mStart = start,
+            .mWrite = std::async(std::launch::async,
+                [path = slot->mPath, data = stream.str(), bodyOffset, compress = Settings::saves().mCompress.get(),
+                    sectionSize = Settings::saves().mCompressedSectionSize.get()]() mutable {
+                    if (compress)
+                        data = ESM::compressSavedGame(data, bodyOffset, sectionSize);
+                    std::filesystem::path temporaryPath = path;
+                    temporaryPath += ".tmp";
+                    {
+                        std::ofstream filestream(temporaryPath, std::ios::binary);
+                        filestream.write(data.data(), static_cast<std::streamsize>(data.size()));
+                        if (filestream.fail())
+                            throw std::runtime_error(
+                                "Write operation failed (file stream): " + std::generic_category().message(errno));
+                    }
+                    std::filesystem::rename(temporaryPath, path);
+                }),
+        };
 
         Settings::saves().mCharacter.set(Files::pathToUnicodeString(slot->mPath.parent_path().filename()));
         mLastSavegame = slot->mPath;
 
         const auto finish = std::chrono::steady_clock::now();
 
-        Log(Debug::Info) << '\'' << description << "' is saved in "
+        Log(Debug::Info) << '\'' << description << "' is serialized in "
                          << std::chrono::duration_cast<std::chrono::duration<float, std::milli>>(finish - start).count()
                          << "ms";
     }
@@ -453,6 +523,8 @@ struct SaveVersionTooNewError : SaveFormatVersionError
 
 void MWState::StateManager::loadGame(const Character* character, const std::filesystem::path& filepath)
 {
+    finishPendingSave();
+
     try
     {
         cleanup();
@@ -460,7 +532,7 @@ void MWState::StateManager::loadGame(const Character* character, const std::file
         Log(Debug::Info) << "Reading save file " << filepath.filename();
 
         ESM::ESMReader reader;
-        reader.open(filepath);
+        reader.open(ESM::openSavedGame(filepath), filepath);
 
         ESM::FormatVersion version = reader.getFormatVersion();
         if (version > ESM::CurrentSaveGameFormatVersion)
@@ -706,6 +778,8 @@ void MWState::StateManager::quickLoad()
 
 void MWState::StateManager::deleteGame(const MWState::Character* character, const MWState::Slot* slot)
 {
+    finishPendingSave();
+
     const std::filesystem::path savePath = slot->mPath;
     mCharacterManager.deleteSlot(slot, character);
     if (mLastSavegame == savePath)
@@ -736,6 +810,9 @@ void MWState::StateManager::update(float duration)
 {
     mTimePlayed += duration;
 
+    if (mPendingSave.has_value() && mPendingSave->mWrite.wait_for(std::chrono::seconds(0)) == std::future_status::ready)
+        finishPendingSave();
+
     // Note: It would be nicer to trigger this from InputManager, i.e. the very beginning of the frame update.
     if (mAskLoadRecent)
     {
@@ -1,8 +1,12 @@
 #ifndef GAME_STATE_STATEMANAGER_H
 #define GAME_STATE_STATEMANAGER_H
 
+#include <chrono>
 #include <filesystem>
+#include <future>
 #include <map>
+#include <optional>
+#include <string>
 
 #include "../mwbase/statemanager.hpp"
 
@@ -21,7 +25,23 @@ namespace MWState
         double mTimePlayed;
         std::filesystem::path mLastSavegame;
 
+        // Saved game serialized in memory and written to a file in background
+        struct PendingSave
+        {
+            Character* mCharacter;
+            const Slot* mSlot;
+            std::string mDescription;
+            std::chrono::steady_clock::time_point mStart;
+            std::future<void> mWrite;
+        };
+
+        // std::future returned by std::async waits for the write on destruction.
+        std::optional<PendingSave> mPendingSave;
+
     private:
+        /// Waits until pending saved game is written and reports the result.
+        void finishPendingSave();
+
         void cleanup(bool force = false);
 
         void printSavegameFormatError(const std::string& exceptionText, const std::string& messageBoxText);
@@ -4,11 +4,14 @@
 #include <atomic>
 #include <limits>
 #include <span>
+#include <vector>
 
 #include <osg/Stats>
 
 #include <components/debug/debuglog.hpp>
+#include <components/esm/util.hpp>
 #include <components/esm3/loadcell.hpp>
+#include <components/loadinglistener/loadinglistener.hpp>
 #include <components/loadinglistener/reporter.hpp>
 #include <components/misc/constants.hpp>
 #include <components/misc/pathhelpers.hpp>
@@ -25,6 +28,7 @@
 
 #include "../mwrender/landmanager.hpp"
 
+#include "cellrefsbuffer.hpp"
 #include "cellstore.hpp"
 #include "class.hpp"
 
@@ -164,6 +168,28 @@ namespace MWWorld
         std::set<osg::ref_ptr<const osg::Object>> mPreloadedObjects;
     };
 
+    /// Worker thread item: read the references of a cell from the content files.
+    class ReadRefsItem : public SceneUtil::WorkItem
+    {
+    public:
+        explicit ReadRefsItem(std::shared_ptr<CellRefsBuffer> buffer)
+            : mBuffer(std::move(buffer))
+        {
+        }
+
+        void abort() override { mAbort = true; }
+
+        void doWork() override
+        {
+            if (!mAbort)
+                mBuffer->read();
+        }
+
+    private:
+        std::shared_ptr<CellRefsBuffer> mBuffer;
+        std::atomic<bool> mAbort{ false };
+    };
+
     class TerrainPreloadItem : public SceneUtil::WorkItem
     {
     public:
@@ -174,6 +200,8 @@ namespace MWWorld
             , mWorld(world)
             , mPreloadPositions(preloadPositions.begin(), preloadPositions.end())
         {
+            // Distant terrain must not hold up preloading of cells the player is about to enter
+            setPriority(SceneUtil::WorkPriority::Low);
         }
 
         void doWork() override
@@ -207,6 +235,7 @@ namespace MWWorld
             : mReferenceTime(referenceTime)
             , mResourceSystem(resourceSystem)
         {
+            setPriority(SceneUtil::WorkPriority::High);
         }
 
         void doWork() override { mResourceSystem->updateCache(mReferenceTime); }
@@ -234,17 +263,19 @@ namespace MWWorld
         clearAllTasks();
     }
 
-    void CellPreloader::preload(CellStore& cell, double timestamp)
+    void CellPreloader::preload(
+        CellStore& cell, double timestamp, std::optional<SceneUtil::WorkItem::Clock::time_point> deadline)
     {
         if (!mWorkQueue)
         {
             Log(Debug::Error) << "Error: can't preload, no work queue set";
             return;
         }
-        if (cell.getState() == CellStore::State_Unloaded)
+        if (cell.getState() != CellStore::State_Loaded)
         {
-            Log(Debug::Error) << "Error: can't preload objects for unloaded cell";
-            return;
+            if (!readRefs(cell))
+                return;
+            cell.load();
         }
 
         PreloadMap::iterator found = mPreloadCells.find(&cell);
@@ -282,30 +313,75 @@ namespace MWWorld
 
         osg::ref_ptr<PreloadItem> item(new PreloadItem(&cell, mResourceSystem->getSceneManager(), mBulletShapeManager,
             mResourceSystem->getKeyframeManager(), mTerrain, mLandManager, mPreloadInstances));
+        item->setPriority(SceneUtil::WorkPriority::High);
+        if (deadline.has_value())
+            item->setDeadline(*deadline);
+        if (cell.getCell()->isExterior())
+        {
+            const osg::Vec2f center = ESM::indexToPosition(cell.getCell()->getExteriorCellLocation(), true);
+            item->setPosition(osg::Vec3f(center, 0));
+        }
         mWorkQueue->addWorkItem(item);
 
         mPreloadCells.emplace(&cell, PreloadEntry(timestamp, item));
         ++mAdded;
     }
 
+    bool CellPreloader::readRefs(CellStore& cell)
+    {
+        const auto found = mReadingRefs.find(&cell);
+        if (found == mReadingRefs.end())
+        {
+            std::shared_ptr<CellRefsBuffer> buffer = cell.prepareRefsBuffer();
+            if (buffer == nullptr)
+                return true;
+            osg::ref_ptr<ReadRefsItem> item(new ReadRefsItem(std::move(buffer)));
+            item->setPriority(SceneUtil::WorkPriority::High);
+            mWorkQueue->addWorkItem(item);
+            mReadingRefs.emplace(&cell, std::move(item));
+            return false;
+        }
+
+        if (!found->second->isDone())
+            return false;
+
+        mReadingRefs.erase(found);
+        return true;
+    }
+
     void CellPreloader::notifyLoaded(CellStore* cell)
     {
+        if (const auto reading = mReadingRefs.find(cell); reading != mReadingRefs.end())
+        {
+            reading->second->abort();
+            mReadingRefs.erase(reading);
+        }
+
         PreloadMap::iterator found = mPreloadCells.find(cell);
-        if (found != mPreloadCells.end())
+        if (found == mPreloadCells.end())
         {
-            if (found->second.mWorkItem)
-            {
-                found->second.mWorkItem->abort();
-                found->second.mWorkItem = nullptr;
-            }
+            ++mMissed;
+            return;
+        }
 
-            mPreloadCells.erase(found);
-            ++mLoaded;
+        if (found->second.mWorkItem)
+        {
+            if (!found->second.mWorkItem->isDone())
+                ++mTooLate;
+            found->second.mWorkItem->abort();
+            found->second.mWorkItem = nullptr;
         }
+
+        mPreloadCells.erase(found);
+        ++mLoaded;
     }
 
     void CellPreloader::clear()
     {
+        for (const auto& [cell, item] : mReadingRefs)
+            item->abort();
+        mReadingRefs.clear();
+
         for (PreloadMap::iterator it = mPreloadCells.begin(); it != mPreloadCells.end();)
         {
             if (it->second.mWorkItem)
@@ -373,6 +449,29 @@ namespace MWWorld
             mTerrainPreloadItem->wait(listener);
     }
 
+    void CellPreloader::syncPreload(std::span<CellStore* const> cells, double timestamp, Loading::Listener& listener)
+    {
+        std::vector<osg::ref_ptr<SceneUtil::WorkItem>> items;
+        for (CellStore* cell : cells)
+        {
+            preload(*cell, timestamp);
+            const auto found = mPreloadCells.find(cell);
+            if (found != mPreloadCells.end() && !found->second.mWorkItem->isDone())
+                items.push_back(found->second.mWorkItem);
+        }
+        if (items.empty())
+            return;
+
+        listener.setProgressRange(items.size());
+        std::size_t done = 0;
+        for (const osg::ref_ptr<SceneUtil::WorkItem>& item : items)
+        {
+            while (!item->waitTillDone(Loading::listenerUpdateInterval))
+                listener.setProgress(done);
+            listener.setProgress(++done);
+        }
+    }
+
     void CellPreloader::abortTerrainPreloadExcept(const PositionCellGrid* exceptPos)
     {
         if (exceptPos != nullptr && contains(mTerrainPreloadPositions, *exceptPos, Constants::CellSizeInUnits))
@@ -445,6 +544,9 @@ namespace MWWorld
             mUpdateCacheItem = nullptr;
         }
 
+        for (const auto& [cell, item] : mReadingRefs)
+            item->abort();
+
         for (PreloadMap::iterator it = mPreloadCells.begin(); it != mPreloadCells.end(); ++it)
             it->second.mWorkItem->abort();
 
@@ -461,5 +563,10 @@ namespace MWWorld
         stats.setAttribute(frameNumber, "CellPreloader Evicted", static_cast<double>(mEvicted));
         stats.setAttribute(frameNumber, "CellPreloader Loaded", static_cast<double>(mLoaded));
         stats.setAttribute(frameNumber, "CellPreloader Expired", static_cast<double>(mExpired));
+        stats.setAttribute(frameNumber, "CellPreloader TooLate", static_cast<double>(mTooLate));
+        stats.setAttribute(frameNumber, "CellPreloader Missed", static_cast<double>(mMissed));
+        if (const std::size_t requested = mLoaded + mMissed; requested > 0)
+            stats.setAttribute(frameNumber, "CellPreloader HitRate",
+                100.0 * static_cast<double>(mLoaded - mTooLate) / static_cast<double>(requested));
     }
 }
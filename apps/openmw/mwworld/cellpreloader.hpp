@@ -8,6 +8,7 @@
 #include <osg/ref_ptr>
 
 #include <map>
+#include <optional>
 #include <span>
 
 namespace osg
@@ -50,8 +51,11 @@ namespace MWWorld
         ~CellPreloader();
 
         /// Ask a background thread to preload rendering meshes and collision shapes for objects in this cell.
-        /// @note The cell itself must be in State_Loaded or State_Preloaded.
-        void preload(MWWorld::CellStore& cell, double timestamp);
+        /// @note A cell that is not loaded yet gets its references read by a background thread first, it's loaded
+        /// and its objects are preloaded by a later call once they are read.
+        /// @param deadline Estimated time when the cell will be loaded, used to order preloading work.
+        void preload(MWWorld::CellStore& cell, double timestamp,
+            std::optional<SceneUtil::WorkItem::Clock::time_point> deadline = std::nullopt);
 
         void notifyLoaded(MWWorld::CellStore* cell);
 
@@ -81,6 +85,10 @@ namespace MWWorld
         void setTerrainPreloadPositions(std::span<const PositionCellGrid> positions);
 
         void syncTerrainLoad(Loading::Listener& listener);
+
+        /// Preload the cells and wait till they are done, updating the listener meanwhile. Cells with references
+        /// still being read and cells that don't fit into the cache are skipped and loaded without preloading.
+        void syncPreload(std::span<MWWorld::CellStore* const> cells, double timestamp, Loading::Listener& listener);
         void abortTerrainPreloadExcept(const PositionCellGrid* exceptPos);
         bool isTerrainLoaded(const PositionCellGrid& position, double referenceTime) const;
         void setTerrain(Terrain::World* terrain);
@@ -90,6 +98,9 @@ namespace MWWorld
     private:
         void clearAllTasks();
 
+        /// @return true once the references of the cell are read and it can be loaded
+        bool readRefs(MWWorld::CellStore& cell);
+
         Resource::ResourceSystem* mResourceSystem;
         Resource::BulletShapeManager* mBulletShapeManager;
         Terrain::World* mTerrain;
@@ -122,6 +133,9 @@ namespace MWWorld
         // Cells that are currently being preloaded, or have already finished preloading
         PreloadMap mPreloadCells;
 
+        // Cells with references being read to be loaded
+        std::map<const MWWorld::CellStore*, osg::ref_ptr<SceneUtil::WorkItem>> mReadingRefs;
+
         std::vector<osg::ref_ptr<Terrain::View>> mTerrainViews;
         std::vector<PositionCellGrid> mTerrainPreloadPositions;
         osg::ref_ptr<TerrainPreloadItem> mTerrainPreloadItem;
@@ -133,6 +147,8 @@ namespace MWWorld
         std::size_t mAdded = 0;
         std::size_t mExpired = 0;
         std::size_t mLoaded = 0;
+        std::size_t mTooLate = 0;
+        std::size_t mMissed = 0;
     };
 
 }
@@ -0,0 +1,68 @@
+#include "cellrefsbuffer.hpp"
+
+#include <components/debug/debuglog.hpp>
+#include <components/esm3/esmreader.hpp>
+#include <components/esm3/loadcell.hpp>
+#include <components/esm3/readerscache.hpp>
+
+#include <algorithm>
+
+namespace MWWorld
+{
+    CellRefsBuffer::CellRefsBuffer(const ESM::Cell& cell, ESM::ReadersCache& readers)
+        : mCellDescription(cell.getDescription())
+        , mContexts(cell.mContextList)
+    {
+        for (const ESM::MovedCellRef& movedRef : cell.mMovedRefs)
+            mMovedRefs.push_back(movedRef.mRefNum);
+
+        // The encoder keeps a conversion buffer, the worker needs its own copy
+        if (!mContexts.empty())
+        {
+            const ESM::ReadersCache::BusyItem reader = readers.get(static_cast<std::size_t>(mContexts.front().index));
+            if (reader->getEncoder() != nullptr)
+                mEncoder.emplace(*reader->getEncoder());
+        }
+    }
+
+    void CellRefsBuffer::read()
+    {
+        ESM::ESMReader reader;
+        if (mEncoder.has_value())
+            reader.setEncoder(&*mEncoder);
+
+        for (const ESM::ESM_Context& context : mContexts)
+        {
+            try
+            {
+                if (reader.getName() != context.filename)
+                    reader.open(context.filename);
+                reader.restoreContext(context);
+
+                ESM::CellRef ref;
+                ESM::MovedCellRef cMRef;
+                bool deleted = false;
+                bool moved = false;
+                while (ESM::Cell::getNextRef(
+                    reader, ref, deleted, cMRef, moved, ESM::Cell::GetNextRefMode::LoadOnlyNotMoved))
+                {
+                    if (moved)
+                        continue;
+
+                    // Don't load reference if it was moved to a different cell.
+                    if (std::find(mMovedRefs.begin(), mMovedRefs.end(), ref.mRefNum) != mMovedRefs.end())
+                        continue;
+
+                    mRefs.emplace_back(ref, deleted);
+                }
+            }
+            catch (const std::exception& e)
+            {
+                Log(Debug::Error) << "An error occurred loading references for cell " << mCellDescription << ": "
+                                  << e.what();
+            }
+        }
+
+        mDone = true;
+    }
+}
@@ -0,0 +1,49 @@
+#ifndef OPENMW_APPS_OPENMW_MWWORLD_CELLREFSBUFFER_H
+#define OPENMW_APPS_OPENMW_MWWORLD_CELLREFSBUFFER_H
+
+#include <components/esm/esmcommon.hpp>
+#include <components/esm3/cellref.hpp>
+#include <components/toutf8/toutf8.hpp>
+
+#include <atomic>
+#include <optional>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace ESM
+{
+    struct Cell;
+    class ReadersCache;
+}
+
+namespace MWWorld
+{
+    /// @brief References of an ESM3 cell read from the content files ahead of CellStore::load.
+    /// @par Everything read needs to be copied from the cell and the readers on construction, so read can be called
+    /// from a worker thread while the main thread keeps using them.
+    class CellRefsBuffer
+    {
+    public:
+        /// Constructor to be called from the main thread.
+        CellRefsBuffer(const ESM::Cell& cell, ESM::ReadersCache& readers);
+
+        /// Can be called from any thread, once.
+        void read();
+
+        bool isDone() const { return mDone; }
+
+        /// @return the references with their deleted flag in the order of the content files, only valid once done
+        std::vector<std::pair<ESM::CellRef, bool>>& getRefs() { return mRefs; }
+
+    private:
+        std::string mCellDescription;
+        std::vector<ESM::ESM_Context> mContexts;
+        std::vector<ESM::RefNum> mMovedRefs;
+        std::optional<ToUTF8::Utf8Encoder> mEncoder;
+        std::vector<std::pair<ESM::CellRef, bool>> mRefs;
+        std::atomic<bool> mDone{ false };
+    };
+}
+
+#endif
@@ -1,4 +1,5 @@
 #include "cellstore.hpp"
+#include "cellrefsbuffer.hpp"
 #include "magiceffects.hpp"
 
 #include <algorithm>
@@ -502,7 +503,7 @@ namespace MWWorld
         {
             mMovedHere.insert(std::make_pair(object.getBase(), from));
         }
-        requestMergedRefsUpdate();
+        addMergedRef(object.getBase());
     }
 
     MWWorld::Ptr CellStore::moveTo(const Ptr& object, CellStore* cellToMoveTo)
@@ -527,6 +528,7 @@ namespace MWWorld
             originalCell->moveFrom(object, this);
 
             mMovedHere.erase(found);
+            removeMergedRef(object.getBase());
 
             // Now that object is back to its rightful owner, we can move it
             if (cellToMoveTo != originalCell)
@@ -534,14 +536,13 @@ namespace MWWorld
                 originalCell->moveTo(object, cellToMoveTo);
             }
 
-            requestMergedRefsUpdate();
             return MWWorld::Ptr(object.getBase(), cellToMoveTo);
         }
 
         cellToMoveTo->moveFrom(object, this);
         mMovedToAnotherCell.insert(std::make_pair(object.getBase(), cellToMoveTo));
+        removeMergedRef(object.getBase());
 
-        requestMergedRefsUpdate();
         return MWWorld::Ptr(object.getBase(), cellToMoveTo);
     }
 
@@ -583,13 +584,63 @@ namespace MWWorld
         mMergedRefsNeedsUpdate = true;
     }
 
-    void CellStore::updateMergedRefs(bool includeDeleted) const
+    void CellStore::updateMergedRefs() const
     {
         mMergedRefs.clear();
         MergeVisitor visitor(mMergedRefs, mMovedHere, mMovedToAnotherCell);
-        CellStoreImp::forEachInternal(visitor, const_cast<CellStore&>(*this), includeDeleted);
+        CellStoreImp::forEachInternal(visitor, const_cast<CellStore&>(*this), true);
         visitor.merge();
         mMergedRefsNeedsUpdate = false;
+        mMergedRefsByIdNeedsUpdate = true;
+    }
+
+    void CellStore::addMergedRef(LiveCellRefBase* ref)
+    {
+        mRechargingItemsUpToDate = false;
+        // The ref is picked up by the pending rebuild
+        if (mMergedRefsNeedsUpdate)
+            return;
+        mMergedRefs.push_back(ref);
+        if (!mMergedRefsByIdNeedsUpdate)
+            mMergedRefsById[ref->mRef.getRefId()].push_back(ref);
+    }
+
+    void CellStore::removeMergedRef(LiveCellRefBase* ref)
+    {
+        mRechargingItemsUpToDate = false;
+        if (mMergedRefsNeedsUpdate)
+            return;
+        std::erase(mMergedRefs, ref);
+        if (mMergedRefsByIdNeedsUpdate)
+            return;
+        const auto it = mMergedRefsById.find(ref->mRef.getRefId());
+        if (it == mMergedRefsById.end())
+            return;
+        std::erase(it->second, ref);
+        if (it->second.empty())
+            mMergedRefsById.erase(it);
+    }
+
+    LiveCellRefBase* CellStore::searchMergedRefs(const ESM::RefId& id) const
+    {
+        if (mMergedRefsNeedsUpdate)
+            updateMergedRefs();
+
+        if (mMergedRefsByIdNeedsUpdate)
+        {
+            mMergedRefsById.clear();
+            for (LiveCellRefBase* mergedRef : mMergedRefs)
+                mMergedRefsById[mergedRef->mRef.getRefId()].push_back(mergedRef);
+            mMergedRefsByIdNeedsUpdate = false;
+        }
+
+        const auto it = mMergedRefsById.find(id);
+        if (it == mMergedRefsById.end())
+            return nullptr;
+        for (LiveCellRefBase* mergedRef : it->second)
+            if (isAccessible(mergedRef->mData, mergedRef->mRef))
+                return mergedRef;
+        return nullptr;
     }
 
     bool CellStore::movedHere(const MWWorld::Ptr& ptr) const
@@ -651,38 +702,22 @@ namespace MWWorld
         return searchConst(id).isEmpty();
     }
 
-    template <typename PtrType>
-    struct SearchVisitor
-    {
-        PtrType mFound;
-        const ESM::RefId& mIdToFind;
-        SearchVisitor(const ESM::RefId& id)
-            : mIdToFind(id)
-        {
-        }
-        bool operator()(const PtrType& ptr)
-        {
-            if (ptr.getCellRef().getRefId() == mIdToFind)
-            {
-                mFound = ptr;
-                return false;
-            }
-            return true;
-        }
-    };
-
     Ptr CellStore::search(const ESM::RefId& id)
     {
-        SearchVisitor<MWWorld::Ptr> searchVisitor(id);
-        forEach(searchVisitor);
-        return searchVisitor.mFound;
+        if (mState != State_Loaded)
+            return Ptr();
+        LiveCellRefBase* ref = searchMergedRefs(id);
+        if (!mMergedRefs.empty())
+            mHasState = true;
+        return ref != nullptr ? Ptr(ref, this) : Ptr();
     }
 
     ConstPtr CellStore::searchConst(const ESM::RefId& id) const
     {
-        SearchVisitor<MWWorld::ConstPtr> searchVisitor(id);
-        forEachConst(searchVisitor);
-        return searchVisitor.mFound;
+        if (mState != State_Loaded)
+            return ConstPtr();
+        const LiveCellRefBase* ref = searchMergedRefs(id);
+        return ref != nullptr ? ConstPtr(ref, this) : ConstPtr();
     }
 
     Ptr CellStore::searchViaActorId(int id)
@@ -705,6 +740,16 @@ namespace MWWorld
         return Ptr();
     }
 
+    void CellStore::releaseCaches()
+    {
+        std::vector<LiveCellRefBase*>().swap(mMergedRefs);
+        mMergedRefsNeedsUpdate = true;
+        std::unordered_map<ESM::RefId, std::vector<LiveCellRefBase*>>().swap(mMergedRefsById);
+        mMergedRefsByIdNeedsUpdate = true;
+        TRechargingItems().swap(mRechargingItems);
+        mRechargingItemsUpToDate = false;
+    }
+
     class RefNumSearchVisitor
     {
         ESM::RefNum mRefNum;
@@ -745,7 +790,8 @@ namespace MWWorld
     {
         if (mMergedRefsNeedsUpdate)
             updateMergedRefs();
-        return mMergedRefs.size();
+        return static_cast<std::size_t>(std::count_if(mMergedRefs.begin(), mMergedRefs.end(),
+            [](const LiveCellRefBase* ref) { return isAccessible(ref->mData, ref->mRef); }));
     }
 
     void CellStore::load()
@@ -771,6 +817,22 @@ namespace MWWorld
         }
     }
 
+    std::shared_ptr<CellRefsBuffer> CellStore::prepareRefsBuffer()
+    {
+        if (mState == State_Loaded)
+            return nullptr;
+        ESM::visit(ESM::VisitOverload{
+                       [&](const ESM::Cell& cell) {
+                           // Dynamically generated cells have no references to read
+                           if (!cell.mContextList.empty())
+                               mRefsBuffer = std::make_shared<CellRefsBuffer>(cell, mReaders);
+                       },
+                       [&](const ESM4::Cell& /*cell*/) {},
+                   },
+            mCellVariant);
+        return mRefsBuffer;
+    }
+
     void CellStore::listRefs(const ESM::Cell& cell)
     {
         if (cell.mContextList.empty())
@@ -860,44 +922,55 @@ namespace MWWorld
         if (cell.mContextList.empty())
             return; // this is a dynamically generated cell -> skipping.
 
-        // Load references from all plugins that do something with this cell.
-        for (size_t i = 0; i < cell.mContextList.size(); i++)
+        // References read on another thread, when they are not read yet it's faster to read them here than to wait
+        const std::shared_ptr<CellRefsBuffer> refsBuffer = std::move(mRefsBuffer);
+        if (refsBuffer != nullptr && refsBuffer->isDone())
         {
-            try
+            for (auto& [ref, deleted] : refsBuffer->getRefs())
+                loadRef(ref, deleted, refNumToID);
+        }
+        else
+        {
+            // Load references from all plugins that do something with this cell.
+            for (size_t i = 0; i < cell.mContextList.size(); i++)
             {
-                // Reopen the ESM reader and seek to the right position.
-                const std::size_t index = static_cast<std::size_t>(cell.mContextList[i].index);
-                const ESM::ReadersCache::BusyItem reader = mReaders.get(index);
-                cell.restore(*reader, i);
-
-                ESM::CellRef ref;
-                // Get each reference in turn
-                ESM::MovedCellRef cMRef;
-                bool deleted = false;
-                bool moved = false;
-                while (ESM::Cell::getNextRef(
-                    *reader, ref, deleted, cMRef, moved, ESM::Cell::GetNextRefMode::LoadOnlyNotMoved))
+                try
                 {
-                    if (moved)
-                        continue;
-
-                    // Don't load reference if it was moved to a different cell.
-                    ESM::MovedCellRefTracker::const_iterator iter
-                        = std::find(cell.mMovedRefs.begin(), cell.mMovedRefs.end(), ref.mRefNum);
-                    if (iter != cell.mMovedRefs.end())
+                    // Reopen the ESM reader and seek to the right position.
+                    const std::size_t index = static_cast<std::size_t>(cell.mContextList[i].index);
+                    const ESM::ReadersCache::BusyItem reader = mReaders.get(index);
+                    cell.restore(*reader, i);
+
+                    ESM::CellRef ref;
+                    // Get each reference in turn
+                    ESM::MovedCellRef cMRef;
+                    bool deleted = false;
+                    bool moved = false;
+                    while (ESM::Cell::getNextRef(
+                        *reader, ref, deleted, cMRef, moved, ESM::Cell::GetNextRefMode::LoadOnlyNotMoved))
                     {
-                        continue;
-                    }
+                        if (moved)
+                            continue;
 
-                    loadRef(ref, deleted, refNumToID);
+                        // Don't load reference if it was moved to a different cell.
+                        ESM::MovedCellRefTracker::const_iterator iter
+                            = std::find(cell.mMovedRefs.begin(), cell.mMovedRefs.end(), ref.mRefNum);
+                        if (iter != cell.mMovedRefs.end())
+                        {
+                            continue;
+                        }
+
+                        loadRef(ref, deleted, refNumToID);
+                    }
+                }
+                catch (std::exception& e)
+                {
+                    Log(Debug::Error) << "An error occurred loading references for cell "
+                                      << getCell()->getDescription() << ": " << e.what();
                 }
-            }
-            catch (std::exception& e)
-            {
-                Log(Debug::Error) << "An error occurred loading references for cell " << getCell()->getDescription()
-                                  << ": " << e.what();
             }
         }
+
         // Load moved references, from separately tracked list.
         for (const auto& leasedRef : cell.mLeasedRefs)
         {
@@ -1076,6 +1149,8 @@ namespace MWWorld
     void CellStore::readReferences(ESM::ESMReader& reader, GetCellStoreCallback* callback)
     {
         mHasState = true;
+        // References are added to the lists directly
+        requestMergedRefsUpdate();
 
         while (reader.isNextSub("OBJE"))
         {
@@ -9,6 +9,7 @@
 #include <string_view>
 #include <tuple>
 #include <typeinfo>
+#include <unordered_map>
 #include <vector>
 
 #include "cell.hpp"
@@ -102,6 +103,8 @@ namespace MWWorld
         CellRefList<ESM4::MovableStatic>, CellRefList<ESM4::Weapon>, CellRefList<ESM4::Furniture>,
         CellRefList<ESM4::Creature>, CellRefList<ESM4::Npc>, CellRefList<ESM4::StaticCollection>>;
 
+    class CellRefsBuffer;
+
     /// \brief Mutable state of a cell
     class CellStore
     {
@@ -140,7 +143,7 @@ namespace MWWorld
             mHasState = true;
             CellRefList<T>& list = get<T>();
             LiveCellRefBase* ret = &list.insert(*ref);
-            requestMergedRefsUpdate();
+            addMergedRef(ret);
             return ret;
         }
 
@@ -186,6 +189,9 @@ namespace MWWorld
         Ptr searchViaActorId(int id);
         ///< Will return an empty Ptr if cell is not loaded.
 
+        void releaseCaches();
+        ///< Free the lookup structures that are rebuilt on the next access, for cells leaving the scene.
+
         float getWaterLevel() const;
 
         bool movedHere(const MWWorld::Ptr& ptr) const;
@@ -206,6 +212,11 @@ namespace MWWorld
         void preload();
         ///< Build ID list from content file.
 
+        std::shared_ptr<CellRefsBuffer> prepareRefsBuffer();
+        ///< Prepare reading the references from the content files on another thread, load uses them once they are
+        /// read instead of reading them itself.
+        /// @return nullptr if there is nothing to read ahead
+
         /// Call visitor (MWWorld::Ptr) for each reference. visitor must return a bool. Returning
         /// false will abort the iteration.
         /// \note Prefer using forEachConst when possible.
@@ -219,7 +230,7 @@ namespace MWWorld
                 return false;
 
             if (mMergedRefsNeedsUpdate)
-                updateMergedRefs(includeDeleted);
+                updateMergedRefs();
             if (mMergedRefs.empty())
                 return true;
 
@@ -248,7 +259,7 @@ namespace MWWorld
                 return false;
 
             if (mMergedRefsNeedsUpdate)
-                updateMergedRefs(includeDeleted);
+                updateMergedRefs();
 
             for (const LiveCellRefBase* mergedRef : mMergedRefs)
             {
@@ -273,7 +284,7 @@ namespace MWWorld
                 return false;
 
             if (mMergedRefsNeedsUpdate)
-                updateMergedRefs(includeDeleted);
+                updateMergedRefs();
             if (mMergedRefs.empty())
                 return true;
 
@@ -393,10 +404,17 @@ namespace MWWorld
         MovedRefTracker mMovedToAnotherCell;
 
         // Merged list of ref's currently in this cell - i.e. with added refs from mMovedHere, removed refs from
-        // mMovedToAnotherCell
+        // mMovedToAnotherCell. Includes deleted refs, built once the cell is loaded and kept up to date on insert and
+        // move afterwards.
         mutable std::vector<LiveCellRefBase*> mMergedRefs;
         mutable bool mMergedRefsNeedsUpdate = false;
 
+        // mMergedRefs grouped by id in the same order, built by the first search after mMergedRefs changed
+        mutable std::unordered_map<ESM::RefId, std::vector<LiveCellRefBase*>> mMergedRefsById;
+        mutable bool mMergedRefsByIdNeedsUpdate = true;
+
+        std::shared_ptr<CellRefsBuffer> mRefsBuffer;
+
         // Get the Ptr for the given ref which originated from this cell (possibly moved to another cell at this point).
         Ptr getCurrentPtr(MWWorld::LiveCellRefBase* ref);
 
@@ -405,7 +423,13 @@ namespace MWWorld
 
         /// Repopulate mMergedRefs.
         void requestMergedRefsUpdate();
-        void updateMergedRefs(bool includeDeleted = false) const;
+        void updateMergedRefs() const;
+
+        void addMergedRef(LiveCellRefBase* ref);
+        void removeMergedRef(LiveCellRefBase* ref);
+
+        /// @return the first accessible reference with the id, nullptr if there is none
+        LiveCellRefBase* searchMergedRefs(const ESM::RefId& id) const;
 
         // (item, max charge)
         typedef std::vector<std::pair<LiveCellRefBase*, float>> TRechargingItems;
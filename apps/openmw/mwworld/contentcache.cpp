@@ -0,0 +1,129 @@
+#include "contentcache.hpp"
+
+#include "esmstore.hpp"
+
+#include <components/debug/debuglog.hpp>
+#include <components/esm3/esmreader.hpp>
+#include <components/esm3/esmwriter.hpp>
+#include <components/esm3/formatversion.hpp>
+#include <components/files/conversion.hpp>
+#include <components/files/hash.hpp>
+#include <components/files/mappedfile.hpp>
+#include <components/toutf8/toutf8.hpp>
+
+#include <array>
+#include <cstdint>
+#include <format>
+#include <fstream>
+#include <memory>
+#include <sstream>
+#include <stdexcept>
+
+namespace MWWorld
+{
+    namespace
+    {
+        // Increment when the set of cached record types or the way they are written changes
+        constexpr int contentCacheVersion = 1;
+
+        constexpr std::string_view contentCacheAuthor = "OpenMW";
+    }
+
+    std::string makeContentCacheKey(const std::vector<std::filesystem::path>& files, ToUTF8::Utf8Encoder* encoder)
+    {
+        std::ostringstream material;
+        material << contentCacheVersion << ' ' << ESM::CurrentSaveGameFormatVersion << '\n';
+
+        if (encoder != nullptr)
+        {
+            // Cached strings are already converted to UTF-8 so the result depends on the legacy encoding
+            std::string legacy;
+            for (int c = 0x80; c <= 0xff; ++c)
+                legacy.push_back(static_cast<char>(c));
+            material << encoder->getUtf8(legacy) << '\n';
+        }
+
+        for (const std::filesystem::path& file : files)
+            material << Files::pathToUnicodeString(file) << ' ' << std::filesystem::file_size(file) << ' '
+                     << std::filesystem::last_write_time(file).time_since_epoch().count() << '\n';
+
+        std::istringstream stream(std::move(material).str());
+        const std::array<std::uint64_t, 2> hash = Files::getHash("content cache key", stream);
+        return std::format("{:016x}{:016x}", hash[0], hash[1]);
+    }
+
+    bool readContentCache(const std::filesystem::path& path, std::string_view key, ESMStore& store)
+    {
+        std::error_code ec;
+        if (!std::filesystem::exists(path, ec))
+            return false;
+
+        ESM::ESMReader reader;
+        try
+        {
+            const auto file = std::make_shared<const Files::MappedFile>(path);
+            reader.open(Files::openMappedFileStream(file, 0, file->size()), path);
+        }
+        catch (const std::exception& e)
+        {
+            Log(Debug::Warning) << "Failed to open content cache " << path << ": " << e.what();
+            return false;
+        }
+
+        if (reader.getAuthor() != contentCacheAuthor || reader.getDesc() != key)
+        {
+            Log(Debug::Info) << "Content cache " << path << " is outdated";
+            return false;
+        }
+
+        try
+        {
+            store.readContentCache(reader);
+        }
+        catch (const std::exception& e)
+        {
+            // Store is partially filled at this point so there is no way to fall back to the content files
+            std::filesystem::remove(path, ec);
+            throw std::runtime_error("Failed to read content cache " + Files::pathToUnicodeString(path)
+                + ", it is removed and will be recreated on the next start: " + e.what());
+        }
+
+        Log(Debug::Info) << "Restored records from content cache " << path;
+        return true;
+    }
+
+    void writeContentCache(const std::filesystem::path& path, std::string_view key, const ESMStore& store)
+    {
+        std::filesystem::path temporaryPath = path;
+        temporaryPath += ".tmp";
+
+        try
+        {
+            ESM::ESMWriter writer;
+            writer.setFormatVersion(ESM::CurrentSaveGameFormatVersion);
+            writer.setVersion(0);
+            writer.setType(0);
+            writer.setAuthor(contentCacheAuthor);
+            writer.setDescription(key);
+
+            {
+                std::ofstream stream(temporaryPath, std::ios::binary);
+                stream.exceptions(std::ios::failbit | std::ios::badbit);
+                writer.save(stream);
+                store.writeContentCache(writer);
+                writer.close();
+            }
+
+            std::filesystem::rename(temporaryPath, path);
+        }
+        catch (const std::exception& e)
+        {
+            std::error_code ec;
+            std::filesystem::remove(temporaryPath, ec);
+            Log(Debug::Warning) << "Failed to write content cache " << path << ": " << e.what();
+            return;
+        }
+
+        Log(Debug::Info) << "Content cache is written to " << path;
+    }
+}
@@ -0,0 +1,29 @@
+#ifndef GAME_MWWORLD_CONTENTCACHE_H
+#define GAME_MWWORLD_CONTENTCACHE_H
+
+#include <filesystem>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace ToUTF8
+{
+    class Utf8Encoder;
+}
+
+namespace MWWorld
+{
+    class ESMStore;
+
+    /// Make a key identifying the given content files in their current state on disk.
+    std::string makeContentCacheKey(const std::vector<std::filesystem::path>& files, ToUTF8::Utf8Encoder* encoder);
+
+    /// Restore cached records into the store if the cache exists and matches the key.
+    /// @return true if records are restored and content files don't need to provide them.
+    bool readContentCache(const std::filesystem::path& path, std::string_view key, ESMStore& store);
+
+    /// Write records loaded from the content files. Failures are logged and otherwise ignored.
+    void writeContentCache(const std::filesystem::path& path, std::string_view key, const ESMStore& store);
+}
+
+#endif
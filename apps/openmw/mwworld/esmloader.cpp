@@ -2,20 +2,45 @@
 #include "esmstore.hpp"
 
 #include <fstream>
+#include <sstream>
+#include <unordered_set>
 
 #include <components/esm/format.hpp>
 #include <components/esm3/esmreader.hpp>
 #include <components/esm3/readerscache.hpp>
 #include <components/esm4/reader.hpp>
+#include <components/esmloader/headercache.hpp>
 #include <components/files/conversion.hpp>
 #include <components/files/openfile.hpp>
 #include <components/misc/strings/lower.hpp>
 #include <components/resource/resourcesystem.hpp>
+#include <components/toutf8/toutf8.hpp>
 
 #include "../mwbase/environment.hpp"
 
 namespace MWWorld
 {
+    namespace
+    {
+        Files::IStreamPtr readFile(const std::filesystem::path& filepath)
+        {
+            auto stream = Files::openBinaryInputFileStream(filepath);
+            stream->seekg(0, std::ios::end);
+            std::string data(static_cast<std::size_t>(stream->tellg()), '\0');
+            stream->seekg(0, std::ios::beg);
+            stream->read(data.data(), static_cast<std::streamsize>(data.size()));
+            if (!*stream)
+                throw std::runtime_error("Failed to read content file " + Files::pathToUnicodeString(filepath));
+            return std::make_unique<std::istringstream>(std::move(data), std::ios::in | std::ios::binary);
+        }
+
+        std::string makeMissingParentMessage(const std::filesystem::path& filepath, std::string_view parent)
+        {
+            return "File " + Files::pathToUnicodeString(filepath) + " asks for parent file " + std::string(parent)
+                + ", but it is not available or has been loaded in the wrong order. "
+                  "Please run the launcher to fix this issue.";
+        }
+    }
 
     EsmLoader::EsmLoader(MWWorld::ESMStore& store, ESM::ReadersCache& readers, ToUTF8::Utf8Encoder* encoder,
         std::vector<int>& esmVersions)
@@ -28,10 +53,71 @@ namespace MWWorld
     {
     }
 
-    void EsmLoader::load(const std::filesystem::path& filepath, int& index, Loading::Listener* listener)
+    void EsmLoader::setReadAhead(std::vector<std::filesystem::path> files, std::size_t readAhead)
+    {
+        mReadAheadFiles = std::move(files);
+        mReadAhead = readAhead;
+        mNextReadAhead = 0;
+        mReadAheadResults.clear();
+    }
+
+    Files::IStreamPtr EsmLoader::takeReadAheadFile(const std::filesystem::path& filepath, int index)
     {
+        if (mReadAhead == 0)
+            return nullptr;
+
+        const std::size_t position = static_cast<std::size_t>(index);
+        // Keep the current file and up to mReadAhead following files in flight to bound memory usage
+        for (; mNextReadAhead < mReadAheadFiles.size() && mNextReadAhead <= position + mReadAhead; ++mNextReadAhead)
+        {
+            if (mNextReadAhead < position || mReadAheadFiles[mNextReadAhead].empty())
+                continue;
+            mReadAheadResults.emplace(mNextReadAhead,
+                std::async(std::launch::async, readFile, std::cref(mReadAheadFiles[mNextReadAhead])));
+        }
 
-        auto stream = Files::openBinaryInputFileStream(filepath);
+        const auto it = mReadAheadResults.find(position);
+        if (it == mReadAheadResults.end())
+            return nullptr;
+        std::future<Files::IStreamPtr> result = std::move(it->second);
+        mReadAheadResults.erase(mReadAheadResults.begin(), std::next(it));
+        if (mReadAheadFiles[position] != filepath)
+            return nullptr;
+        return result.get();
+    }
+
+    void EsmLoader::checkMasters(
+        std::span<const std::filesystem::path> files, ::EsmLoader::HeaderCache& headerCache) const
+    {
+        std::vector<std::filesystem::path> esmFiles;
+        for (const std::filesystem::path& file : files)
+            if (!file.empty())
+                esmFiles.push_back(file);
+        const std::vector<::EsmLoader::PluginHeaderResult> headers = headerCache.get(esmFiles);
+
+        std::unordered_set<std::string> loaded;
+        for (std::size_t i = 0; i < esmFiles.size(); ++i)
+        {
+            // Files that can't be read are reported when they are loaded
+            const std::optional<::EsmLoader::PluginHeader>& header = headers[i].mHeader;
+            if (!header.has_value() || header->mFormat != ESM::Format::Tes3)
+                continue;
+            for (const std::string& master : header->mMasters)
+            {
+                const std::string name = mEncoder != nullptr ? std::string(mEncoder->getUtf8(master)) : master;
+                if (!loaded.contains(Misc::StringUtils::lowerCase(name)))
+                    throw std::runtime_error(makeMissingParentMessage(esmFiles[i], name));
+            }
+            loaded.insert(Misc::StringUtils::lowerCase(Files::pathToUnicodeString(esmFiles[i].filename())));
+        }
+    }
+
+    void EsmLoader::load(const std::filesystem::path& filepath, int& index, Loading::Listener* listener)
+    {
+        Files::IStreamPtr stream = takeReadAheadFile(filepath, index);
+        const bool readAhead = stream != nullptr;
+        if (!readAhead)
+            stream = Files::openBinaryInputFileStream(filepath);
         const ESM::Format format = ESM::readFormat(*stream);
         stream->seekg(0);
 
@@ -42,20 +128,24 @@ namespace MWWorld
                 const ESM::ReadersCache::BusyItem reader = mReaders.get(static_cast<std::size_t>(index));
                 reader->setEncoder(mEncoder);
                 reader->setIndex(index);
-                reader->open(filepath);
+                reader->open(std::move(stream), filepath);
                 reader->resolveParentFileIndices(mReaders);
 
                 const std::vector<int>& parentIndices = reader->getParentFileIndices();
                 assert(reader->getGameFiles().size() == parentIndices.size());
                 for (std::size_t i = 0, n = parentIndices.size(); i < n; ++i)
                     if (parentIndices[i] == reader->getIndex())
-                        throw std::runtime_error("File " + Files::pathToUnicodeString(reader->getName()) + " asks for parent file "
-                + reader->getGameFiles()[i].name
-                + ", but it is not available or has been loaded in the wrong order. "
-                  "Please run the launcher to fix this issue.");
+                        throw std::runtime_error(
+                            makeMissingParentMessage(reader->getName(), reader->getGameFiles()[i].name));
 
                 mESMVersions[index] = reader->getVer();
+                reader->setBufferRecords(true);
                 mStore.load(*reader, listener, mDialogue);
+                reader->setBufferRecords(false);
+
+                // Readers are reused later to load cell references, don't keep the in-memory copy around
+                if (readAhead)
+                    reader->open(filepath);
 
                 if (!mMasterFileFormat.has_value()
                     && (Misc::StringUtils::ciEndsWith(reader->getName().u8string(), u8".esm")
@@ -71,6 +161,7 @@ namespace MWWorld
                 reader.setModIndex(index);
                 reader.updateModIndices(mNameToIndex);
                 mStore.loadESM4(reader, listener);
+                mHasTes4Content = true;
                 break;
             }
         }
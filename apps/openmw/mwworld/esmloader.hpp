@@ -1,10 +1,15 @@
 #ifndef ESMLOADER_HPP
 #define ESMLOADER_HPP
 
+#include <filesystem>
+#include <future>
 #include <map>
 #include <optional>
+#include <span>
 #include <vector>
 
+#include <components/files/istreamptr.hpp>
+
 #include "contentloader.hpp"
 
 namespace ToUTF8
@@ -18,6 +23,11 @@ namespace ESM
     struct Dialogue;
 }
 
+namespace EsmLoader
+{
+    class HeaderCache;
+}
+
 namespace MWWorld
 {
 
@@ -30,16 +40,35 @@ namespace MWWorld
 
         std::optional<int> getMasterFileFormat() const { return mMasterFileFormat; }
 
+        bool hasTes4Content() const { return mHasTes4Content; }
+
+        /// Read content files ahead of time on background threads. Records are still parsed in load order.
+        /// @param files Content files by index, empty paths are not handled by this loader.
+        /// @param readAhead Number of files to read in addition to the one being loaded.
+        void setReadAhead(std::vector<std::filesystem::path> files, std::size_t readAhead);
+
+        /// Check with the headers of the content files that every TES3 file is loaded after its masters, so an
+        /// invalid load order fails before anything is loaded. Throws on failure.
+        /// @param files Content files by index, empty paths are not handled by this loader.
+        void checkMasters(std::span<const std::filesystem::path> files, ::EsmLoader::HeaderCache& headerCache) const;
+
         void load(const std::filesystem::path& filepath, int& index, Loading::Listener* listener) override;
 
     private:
+        Files::IStreamPtr takeReadAheadFile(const std::filesystem::path& filepath, int index);
+
         ESM::ReadersCache& mReaders;
         MWWorld::ESMStore& mStore;
         ToUTF8::Utf8Encoder* mEncoder;
         ESM::Dialogue* mDialogue;
         std::optional<int> mMasterFileFormat;
+        bool mHasTes4Content = false;
         std::vector<int>& mESMVersions;
         std::map<std::string, int> mNameToIndex;
+        std::vector<std::filesystem::path> mReadAheadFiles;
+        std::size_t mReadAhead = 0;
+        std::size_t mNextReadAhead = 0;
+        std::map<std::size_t, std::future<Files::IStreamPtr>> mReadAheadResults;
     };
 
 } /* namespace MWWorld */
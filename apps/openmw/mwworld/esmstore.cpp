@@ -3,6 +3,7 @@
 #include <algorithm>
 #include <fstream>
 #include <tuple>
+#include <utility>
 
 #include <components/debug/debuglog.hpp>
 
@@ -18,6 +19,7 @@
 #include <components/lua/configuration.hpp>
 #include <components/misc/algorithm.hpp>
 
+#include "../mwmechanics/levelledlist.hpp"
 #include "../mwmechanics/spelllist.hpp"
 
 namespace
@@ -228,6 +230,55 @@ namespace
 
 namespace MWWorld
 {
+    // Records which are fully replaced by later content files and don't refer to the file they come from,
+    // so the merged result can be cached. Cells, lands, land textures, path grids and dialogues are excluded.
+    static constexpr bool isContentCacheRecord(ESM::RecNameInts id)
+    {
+        switch (id)
+        {
+            case ESM::REC_ACTI:
+            case ESM::REC_ALCH:
+            case ESM::REC_APPA:
+            case ESM::REC_ARMO:
+            case ESM::REC_BODY:
+            case ESM::REC_BOOK:
+            case ESM::REC_BSGN:
+            case ESM::REC_CLAS:
+            case ESM::REC_CLOT:
+            case ESM::REC_CONT:
+            case ESM::REC_CREA:
+            case ESM::REC_DOOR:
+            case ESM::REC_ENCH:
+            case ESM::REC_FACT:
+            case ESM::REC_GLOB:
+            case ESM::REC_GMST:
+            case ESM::REC_INGR:
+            case ESM::REC_LEVC:
+            case ESM::REC_LEVI:
+            case ESM::REC_LIGH:
+            case ESM::REC_LOCK:
+            case ESM::REC_MGEF:
+            case ESM::REC_MISC:
+            case ESM::REC_NPC_:
+            case ESM::REC_PROB:
+            case ESM::REC_RACE:
+            case ESM::REC_REGN:
+            case ESM::REC_REPA:
+            case ESM::REC_SCPT:
+            case ESM::REC_SKIL:
+            case ESM::REC_SNDG:
+            case ESM::REC_SOUN:
+            case ESM::REC_SPEL:
+            case ESM::REC_SSCR:
+            case ESM::REC_STAT:
+            case ESM::REC_WEAP:
+                return true;
+            default:
+                break;
+        }
+        return false;
+    }
+
     using IDMap = std::unordered_map<ESM::RefId, int>;
 
     struct ESMStoreImp
@@ -277,7 +328,7 @@ namespace MWWorld
                         reader.getRecordData();
                         T value;
                         value.load(reader);
-                        store.insertStatic(value);
+                        store.insertStatic(std::move(value));
                         return true;
                     }
                 }
@@ -285,6 +336,43 @@ namespace MWWorld
             return false;
         }
 
+        template <typename T>
+        static void writeContentCacheRecords(const Store<T>& store, ESM::ESMWriter& writer)
+        {
+            if constexpr (HasRecordId<T>::value)
+            {
+                if constexpr (isContentCacheRecord(T::sRecordId))
+                {
+                    if constexpr (std::is_same_v<T, ESM::MagicEffect>)
+                    {
+                        for (const auto& [index, record] : store)
+                        {
+                            writer.startRecord(T::sRecordId);
+                            record.save(writer);
+                            writer.endRecord(T::sRecordId);
+                        }
+                    }
+                    else
+                    {
+                        for (const T& record : store)
+                        {
+                            writer.startRecord(T::sRecordId);
+                            record.save(writer);
+                            writer.endRecord(T::sRecordId);
+                        }
+                    }
+                }
+            }
+        }
+
+        template <typename T>
+        static void makeFlat(Store<T>& store)
+        {
+            if constexpr (std::is_convertible_v<Store<T>*, TypedDynamicStore<T>*>)
+                if constexpr (!ESM::isESM4Rec(T::sRecordId))
+                    store.makeFlat();
+        }
+
         static bool readRecord(ESM4::Reader& reader, ESMStore& store)
         {
             return std::apply(
@@ -327,6 +415,7 @@ namespace MWWorld
         for (const auto& store : mDynamicStores)
             store->clearDynamic();
         mStoreImp->mIds = mStoreImp->mStaticIds;
+        mLevelledListTables.clear();
 
         movePlayerRecord();
     }
@@ -406,7 +495,14 @@ namespace MWWorld
             ESM::RecNameInts recName = static_cast<ESM::RecNameInts>(n.toInt());
             const auto& it = mStoreImp->mRecNameToStore.find(recName);
 
-            if (it == mStoreImp->mRecNameToStore.end())
+            if (mContentCacheRestored && isContentCacheRecord(recName))
+            {
+                // Merged result is already restored from the content cache
+                esm.skipRecord();
+                if (it != mStoreImp->mRecNameToStore.end())
+                    dialogue = nullptr;
+            }
+            else if (it == mStoreImp->mRecNameToStore.end())
             {
                 if (recName == ESM::REC_INFO)
                 {
@@ -481,9 +577,41 @@ namespace MWWorld
         ESM4::ReaderUtils::readAll(reader, visitorRec, [](ESM4::Reader&) {});
     }
 
+    void ESMStore::writeContentCache(ESM::ESMWriter& writer) const
+    {
+        std::apply(
+            [&](const auto&... stores) { (ESMStoreImp::writeContentCacheRecords(stores, writer), ...); },
+            mStoreImp->mStores);
+    }
+
+    void ESMStore::makeFlat()
+    {
+        std::apply([](auto&... x) { (ESMStoreImp::makeFlat(x), ...); }, mStoreImp->mStores);
+    }
+
+    void ESMStore::readContentCache(ESM::ESMReader& reader)
+    {
+        while (reader.hasMoreRecs())
+        {
+            const ESM::NAME n = reader.getRecName();
+            reader.getRecHeader();
+
+            const ESM::RecNameInts recName = static_cast<ESM::RecNameInts>(n.toInt());
+            if (!isContentCacheRecord(recName))
+                throw std::runtime_error("Unexpected record in content cache: " + n.toString());
+
+            if (recName == ESM::REC_MGEF)
+                getWritable<ESM::MagicEffect>().load(reader);
+            else
+                mStoreImp->mRecNameToStore.at(recName)->load(reader);
+        }
+        mContentCacheRestored = true;
+    }
+
     void ESMStore::setIdType(const ESM::RefId& id, ESM::RecNameInts type)
     {
         mStoreImp->mIds[id] = type;
+        mLevelledListTables.clear();
     }
 
     ESM::LuaScriptsCfg ESMStore::getLuaScriptsCfg() const
@@ -539,6 +667,7 @@ namespace MWWorld
     void ESMStore::rebuildIdsIndex()
     {
         mStoreImp->mIds.clear();
+        mLevelledListTables.clear();
         for (const auto& [recordType, store] : mStoreImp->mRecNameToStore)
         {
             if (isCacheableRecord(recordType))
@@ -659,6 +788,7 @@ namespace MWWorld
 
         removeMissingObjects(getWritable<ESM::CreatureLevList>());
         removeMissingObjects(getWritable<ESM::ItemLevList>());
+        mLevelledListTables.clear();
     }
 
     // Leveled lists can be modified by scripts. This removes items that no longer exist (presumably because the
@@ -793,6 +923,26 @@ namespace MWWorld
         return { ptr, true };
     }
 
+    std::shared_ptr<const MWMechanics::LevelledListTable> ESMStore::getLevelledListTable(
+        const ESM::LevelledListBase& list, bool creature) const
+    {
+        const ESM::LevelledListBase* stored = nullptr;
+        if (creature)
+            stored = get<ESM::CreatureLevList>().search(list.mId);
+        else
+            stored = get<ESM::ItemLevList>().search(list.mId);
+        // Lists that are not in the store may change at any time
+        if (stored != &list)
+            return std::make_shared<const MWMechanics::LevelledListTable>(list, creature, *this);
+
+        auto it = mLevelledListTables.find(stored);
+        if (it == mLevelledListTables.end())
+            it = mLevelledListTables
+                     .emplace(stored, std::make_shared<const MWMechanics::LevelledListTable>(list, creature, *this))
+                     .first;
+        return it->second;
+    }
+
     template <>
     const ESM::Cell* ESMStore::insert<ESM::Cell>(const ESM::Cell& cell)
     {
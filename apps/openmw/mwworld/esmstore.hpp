@@ -21,6 +21,7 @@ namespace Loading
 
 namespace MWMechanics
 {
+    class LevelledListTable;
     class SpellList;
 }
 
@@ -51,6 +52,7 @@ namespace ESM
     struct ItemLevList;
     struct Land;
     struct LandTexture;
+    struct LevelledListBase;
     struct Light;
     struct Lockpick;
     struct MagicEffect;
@@ -170,6 +172,8 @@ namespace MWWorld
         uint64_t mDynamicCount;
 
         mutable std::unordered_map<ESM::RefId, std::weak_ptr<MWMechanics::SpellList>> mSpellListCache;
+        mutable std::unordered_map<const ESM::LevelledListBase*, std::shared_ptr<const MWMechanics::LevelledListTable>>
+            mLevelledListTables;
 
         template <class T>
         Store<T>& getWritable()
@@ -192,6 +196,7 @@ namespace MWWorld
         std::vector<LuaContent> mLuaContent;
 
         bool mIsSetUpDone = false;
+        bool mContentCacheRestored = false;
 
     public:
         void addOMWScripts(std::filesystem::path filePath) { mLuaContent.push_back(std::move(filePath)); }
@@ -224,6 +229,18 @@ namespace MWWorld
         void load(ESM::ESMReader& esm, Loading::Listener* listener, ESM::Dialogue*& dialogue);
         void loadESM4(ESM4::Reader& esm, Loading::Listener* listener);
 
+        /// Write merged records of the types that don't depend on the content file they come from, in load order.
+        /// Must be called after loading all content files and before setUp().
+        void writeContentCache(ESM::ESMWriter& writer) const;
+
+        /// Restore records written by writeContentCache. Must be called before loading content files, subsequent
+        /// calls to load() skip records of the cached types.
+        void readContentCache(ESM::ESMReader& reader);
+
+        /// Move static ESM3 records into contiguous storage, see TypedDynamicStore::makeFlat. Must be called after
+        /// setUp() and before anything keeps pointers to the records.
+        void makeFlat();
+
         template <class T>
         const Store<T>& get() const
         {
@@ -302,6 +319,10 @@ namespace MWWorld
         /// Actors with the same ID share spells, abilities, etc.
         /// @return The shared spell list to use for this actor and whether or not it has already been initialized.
         std::pair<std::shared_ptr<MWMechanics::SpellList>, bool> getSpellList(const ESM::RefId& id) const;
+
+        /// Levelled lists of the store are flattened once and again after any record is inserted or removed.
+        std::shared_ptr<const MWMechanics::LevelledListTable> getLevelledListTable(
+            const ESM::LevelledListBase& list, bool creature) const;
     };
     template <>
     const ESM::Cell* ESMStore::insert<ESM::Cell>(const ESM::Cell& cell);
@@ -1,6 +1,7 @@
 #include "inventorystore.hpp"
 
 #include <algorithm>
+#include <cassert>
 #include <iterator>
 
 #include <components/esm3/inventorystate.hpp>
@@ -94,7 +95,8 @@ void MWWorld::InventoryStore::readEquipmentState(
 MWWorld::InventoryStore::InventoryStore()
     : ContainerStore()
     , mInventoryListener(nullptr)
-    , mUpdatesEnabled(true)
+    , mUpdatesDisabled(0)
+    , mEquipmentChangedPending(false)
     , mFirstAutoEquip(true)
     , mSelectedEnchantItem(end())
 {
@@ -104,7 +106,8 @@ MWWorld::InventoryStore::InventoryStore()
 MWWorld::InventoryStore::InventoryStore(const InventoryStore& store)
     : ContainerStore(store)
     , mInventoryListener(store.mInventoryListener)
-    , mUpdatesEnabled(store.mUpdatesEnabled)
+    , mUpdatesDisabled(0)
+    , mEquipmentChangedPending(false)
     , mFirstAutoEquip(store.mFirstAutoEquip)
     , mSelectedEnchantItem(end())
 {
@@ -185,12 +188,10 @@ void MWWorld::InventoryStore::equip(int slot, const ContainerStoreIterator& iter
 
 void MWWorld::InventoryStore::unequipAll()
 {
-    mUpdatesEnabled = false;
+    UpdateBatch batch(*this);
     for (int slot = 0; slot < MWWorld::InventoryStore::Slots; ++slot)
         unequipSlot(slot);
 
-    mUpdatesEnabled = true;
-
     fireEquipmentChangedEvent();
 }
 
@@ -498,7 +499,7 @@ void MWWorld::InventoryStore::autoEquip()
     initSlots(slots);
 
     // Disable model update during auto-equip
-    mUpdatesEnabled = false;
+    UpdateBatch batch(*this);
 
     // Autoequip clothing, armor and weapons.
     // Equipping lights is handled in Actors::updateEquippedLight based on environment light.
@@ -515,7 +516,6 @@ void MWWorld::InventoryStore::autoEquip()
             break;
         }
     }
-    mUpdatesEnabled = true;
 
     if (changed)
     {
@@ -701,8 +701,12 @@ void MWWorld::InventoryStore::setInvListener(InventoryStoreListener* listener)
 
 void MWWorld::InventoryStore::fireEquipmentChangedEvent()
 {
-    if (!mUpdatesEnabled)
+    if (mUpdatesDisabled > 0)
+    {
+        mEquipmentChangedPending = true;
         return;
+    }
+    mEquipmentChangedPending = false;
     if (mInventoryListener)
         mInventoryListener->equipmentChanged();
 
@@ -715,6 +719,18 @@ void MWWorld::InventoryStore::fireEquipmentChangedEvent()
     */
 }
 
+void MWWorld::InventoryStore::disableUpdates()
+{
+    ++mUpdatesDisabled;
+}
+
+void MWWorld::InventoryStore::enableUpdates()
+{
+    assert(mUpdatesDisabled > 0);
+    if (--mUpdatesDisabled == 0 && mEquipmentChangedPending)
+        fireEquipmentChangedEvent();
+}
+
 void MWWorld::InventoryStore::clear()
 {
     mSlots.clear();
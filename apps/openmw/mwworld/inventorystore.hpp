@@ -54,12 +54,34 @@ namespace MWWorld
 
         static constexpr int Slot_NoSlot = -1;
 
+        /// Defers the equipment change notification until the batch ends, to update the actor only once for many
+        /// items equipped or unequipped in a row.
+        class UpdateBatch
+        {
+        public:
+            explicit UpdateBatch(InventoryStore& store)
+                : mStore(store)
+            {
+                mStore.disableUpdates();
+            }
+
+            ~UpdateBatch() { mStore.enableUpdates(); }
+
+            UpdateBatch(const UpdateBatch&) = delete;
+            UpdateBatch& operator=(const UpdateBatch&) = delete;
+
+        private:
+            InventoryStore& mStore;
+        };
+
     private:
         InventoryStoreListener* mInventoryListener;
 
-        // Enables updates of magic effects and actor model whenever items are equipped or unequipped.
-        // This is disabled during autoequip to avoid excessive updates
-        bool mUpdatesEnabled;
+        // Disables updates of magic effects and actor model whenever items are equipped or unequipped while non-zero.
+        // This is used during autoequip and UpdateBatch to avoid excessive updates, the changes are reported once
+        // updates are enabled again
+        int mUpdatesDisabled;
+        bool mEquipmentChangedPending;
 
         bool mFirstAutoEquip;
 
@@ -79,6 +101,10 @@ namespace MWWorld
 
         void fireEquipmentChangedEvent();
 
+        void disableUpdates();
+
+        void enableUpdates();
+
         void storeEquipmentState(
             const MWWorld::LiveCellRefBase& ref, size_t index, ESM::InventoryState& inventory) const override;
         void readEquipmentState(
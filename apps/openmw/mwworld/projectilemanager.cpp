@@ -393,6 +393,17 @@ namespace MWWorld
         periodicCleanup(dt);
         moveProjectiles(dt);
         moveMagicBolts(dt);
+        mCombatTargets.clear();
+    }
+
+    const std::vector<MWWorld::Ptr>& ProjectileManager::getCombatTargets(const MWWorld::Ptr& caster)
+    {
+        // For AI actors, get combat targets to use in the ray cast. Only those targets will return a positive hit
+        // result. Casters of a volley launch many projectiles at once, look the targets up once per frame.
+        const auto [it, inserted] = mCombatTargets.try_emplace(caster.mRef);
+        if (inserted && !caster.isEmpty() && caster.getClass().isActor() && caster != MWMechanics::getPlayer())
+            caster.getClass().getCreatureStats(caster).getAiSequence().getCombatTargets(it->second);
+        return it->second;
     }
 
     void ProjectileManager::periodicCleanup(float dt)
@@ -425,6 +436,7 @@ namespace MWWorld
     void ProjectileManager::moveMagicBolts(float duration)
     {
         const bool normaliseRaceSpeed = Settings::game().mNormaliseRaceSpeed;
+        const auto& store = *MWBase::Environment::get().getESMStore();
         for (auto& magicBoltState : mMagicBolts)
         {
             if (magicBoltState.mToDelete)
@@ -444,7 +456,6 @@ namespace MWWorld
                 }
             }
 
-            const auto& store = *MWBase::Environment::get().getESMStore();
             osg::Quat orient = magicBoltState.mNode->getAttitude();
             static float fTargetSpellMaxSpeed
                 = store.get<ESM::GameSetting>().find("fTargetSpellMaxSpeed")->mValue.getFloat();
@@ -466,12 +477,7 @@ namespace MWWorld
                 sound->setVelocity(direction * speed);
             }
 
-            // For AI actors, get combat targets to use in the ray cast. Only those targets will return a positive hit
-            // result.
-            std::vector<MWWorld::Ptr> targetActors;
-            if (!caster.isEmpty() && caster.getClass().isActor() && caster != MWMechanics::getPlayer())
-                caster.getClass().getCreatureStats(caster).getAiSequence().getCombatTargets(targetActors);
-            projectile->setValidTargets(targetActors);
+            projectile->setValidTargets(getCombatTargets(caster));
         }
     }
 
@@ -503,14 +509,7 @@ namespace MWWorld
 
             update(projectileState, duration);
 
-            MWWorld::Ptr caster = projectileState.getCaster();
-
-            // For AI actors, get combat targets to use in the ray cast. Only those targets will return a positive hit
-            // result.
-            std::vector<MWWorld::Ptr> targetActors;
-            if (!caster.isEmpty() && caster.getClass().isActor() && caster != MWMechanics::getPlayer())
-                caster.getClass().getCreatureStats(caster).getAiSequence().getCombatTargets(targetActors);
-            projectile->setValidTargets(targetActors);
+            projectile->setValidTargets(getCombatTargets(projectileState.getCaster()));
         }
     }
 
@@ -557,6 +556,7 @@ namespace MWWorld
             projectileState.mToDelete = true;
         }
         const MWWorld::ESMStore& esmStore = *MWBase::Environment::get().getESMStore();
+        const MWBase::World& world = *MWBase::Environment::get().getWorld();
         for (auto& magicBoltState : mMagicBolts)
         {
             if (magicBoltState.mToDelete)
@@ -571,7 +571,6 @@ namespace MWWorld
 
             const Ptr caster = magicBoltState.getCaster();
 
-            const MWBase::World& world = *MWBase::Environment::get().getWorld();
             const bool active = projectile->isActive();
             if (active && !world.isUnderwater(caster.getCell(), pos))
                 continue;
@@ -2,6 +2,8 @@
 #define OPENMW_MWWORLD_PROJECTILEMANAGER_H
 
 #include <string>
+#include <unordered_map>
+#include <vector>
 
 #include <osg/PositionAttitudeTransform>
 #include <osg/ref_ptr>
@@ -129,6 +131,9 @@ namespace MWWorld
         std::vector<MagicBoltState> mMagicBolts;
         std::vector<ProjectileState> mProjectiles;
 
+        // Combat targets of the casters of the projectiles moved this frame
+        std::unordered_map<const MWWorld::LiveCellRefBase*, std::vector<MWWorld::Ptr>> mCombatTargets;
+
         void cleanupProjectile(ProjectileState& state);
         void cleanupMagicBolt(MagicBoltState& state);
         void periodicCleanup(float dt);
@@ -136,6 +141,8 @@ namespace MWWorld
         void moveProjectiles(float dt);
         void moveMagicBolts(float dt);
 
+        const std::vector<MWWorld::Ptr>& getCombatTargets(const MWWorld::Ptr& caster);
+
         void createModel(State& state, VFS::Path::NormalizedView model, const osg::Vec3f& pos, const osg::Quat& orient,
             bool rotate, bool createLight, osg::Vec4 lightDiffuseColor, const std::string& texture = "");
         void update(State& state, float duration);
@@ -35,7 +35,7 @@ namespace MWWorld
     void RefData::copy(const RefData& refData)
     {
         mBaseNode = refData.mBaseNode;
-        mLocals = refData.mLocals;
+        mScriptState = refData.mScriptState ? std::make_unique<ScriptState>(*refData.mScriptState) : nullptr;
         mEnabled = refData.mEnabled;
         mPosition = refData.mPosition;
         mChanged = refData.mChanged;
@@ -43,12 +43,17 @@ namespace MWWorld
         mFlags = refData.mFlags;
         mPhysicsPostponed = refData.mPhysicsPostponed;
 
-        mAnimationState = refData.mAnimationState;
-
         mCustomData = refData.mCustomData ? refData.mCustomData->clone() : nullptr;
         mLuaScripts = refData.mLuaScripts;
     }
 
+    RefData::ScriptState& RefData::getScriptState()
+    {
+        if (mScriptState == nullptr)
+            mScriptState = std::make_unique<ScriptState>();
+        return *mScriptState;
+    }
+
     void RefData::cleanup()
     {
         mBaseNode = nullptr;
@@ -111,7 +116,6 @@ namespace MWWorld
     RefData::RefData(const ESM::ObjectState& objectState, bool deletedByContentFile)
         : mBaseNode(nullptr)
         , mPosition(objectState.mPosition)
-        , mAnimationState(objectState.mAnimationState)
         , mCustomData(nullptr)
         , mFlags(objectState.mFlags) // Loading from a savegame -> assume changed
         , mDeletedByContentFile(deletedByContentFile)
@@ -124,6 +128,9 @@ namespace MWWorld
         // This occurred when removing the animated containers mod, and the fix in MCP is to reset UseEnabled to true on
         // loading a game."
         mFlags &= (~Flag_SuppressActivate);
+
+        if (!objectState.mAnimationState.empty())
+            getScriptState().mAnimationState = objectState.mAnimationState;
     }
 
     RefData::RefData(const RefData& refData)
@@ -144,13 +151,13 @@ namespace MWWorld
 
     void RefData::write(ESM::ObjectState& objectState, const ESM::RefId& scriptId) const
     {
-        objectState.mHasLocals = mLocals.write(objectState.mLocals, scriptId);
+        objectState.mHasLocals = mScriptState != nullptr && mScriptState->mLocals.write(objectState.mLocals, scriptId);
 
         objectState.mEnabled = mEnabled;
         objectState.mPosition = mPosition;
         objectState.mFlags = mFlags;
 
-        objectState.mAnimationState = mAnimationState;
+        objectState.mAnimationState = getAnimationState();
     }
 
     RefData& RefData::operator=(const RefData& refData)
@@ -200,7 +207,8 @@ namespace MWWorld
 
     void RefData::setLocals(const ESM::Script& script)
     {
-        if (mLocals.configure(script) && !mLocals.isEmpty())
+        MWScript::Locals& locals = getScriptState().mLocals;
+        if (locals.configure(script) && !locals.isEmpty())
             mChanged = true;
     }
 
@@ -216,7 +224,7 @@ namespace MWWorld
 
     MWScript::Locals& RefData::getLocals()
     {
-        return mLocals;
+        return getScriptState().mLocals;
     }
 
     bool RefData::isEnabled() const
@@ -271,7 +279,7 @@ namespace MWWorld
 
     bool RefData::hasChanged() const
     {
-        return mChanged || !mAnimationState.empty();
+        return mChanged || !getAnimationState().empty();
     }
 
     bool RefData::activateByScript()
@@ -302,14 +310,20 @@ namespace MWWorld
         return ret;
     }
 
+    bool RefData::isWaitingForActivation() const
+    {
+        return (mFlags & Flag_SuppressActivate) && !(mFlags & Flag_OnActivate);
+    }
+
     const ESM::AnimationState& RefData::getAnimationState() const
     {
-        return mAnimationState;
+        static const ESM::AnimationState empty;
+        return mScriptState != nullptr ? mScriptState->mAnimationState : empty;
     }
 
     ESM::AnimationState& RefData::getAnimationState()
     {
-        return mAnimationState;
+        return getScriptState().mAnimationState;
     }
 
 }
@@ -43,12 +43,19 @@ namespace MWWorld
 
     class RefData
     {
+        /// State only a small part of all references ever has, allocated on the first non-const access to keep the
+        /// references of every visited cell small.
+        struct ScriptState
+        {
+            MWScript::Locals mLocals;
+            ESM::AnimationState mAnimationState;
+        };
+
         osg::ref_ptr<SceneUtil::PositionAttitudeTransform> mBaseNode;
 
-        MWScript::Locals mLocals;
+        std::unique_ptr<ScriptState> mScriptState;
         std::shared_ptr<MWLua::LocalScripts> mLuaScripts;
         ESM::Position mPosition;
-        ESM::AnimationState mAnimationState;
         std::unique_ptr<CustomData> mCustomData;
         unsigned int mFlags;
 
@@ -68,6 +75,8 @@ namespace MWWorld
 
         void cleanup();
 
+        ScriptState& getScriptState();
+
     public:
         RefData();
 
@@ -139,6 +148,9 @@ namespace MWWorld
 
         bool onActivate();
 
+        /// Is activation redirected to the OnActivate flag and the flag not set? onActivate would change nothing then.
+        bool isWaitingForActivation() const;
+
         bool activateByScript();
 
         bool hasChanged() const;
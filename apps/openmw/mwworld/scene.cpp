@@ -1,11 +1,17 @@
 #include "scene.hpp"
 
+#include <algorithm>
 #include <atomic>
 #include <chrono>
 #include <limits>
+#include <map>
+#include <span>
+#include <vector>
 
 #include <BulletCollision/CollisionDispatch/btCollisionObject.h>
 
+#include <osg/Stats>
+
 #include <components/debug/debuglog.hpp>
 #include <components/detournavigator/agentbounds.hpp>
 #include <components/detournavigator/debug.hpp>
@@ -21,6 +27,7 @@
 #include <components/resource/resourcesystem.hpp>
 #include <components/resource/scenemanager.hpp>
 #include <components/sceneutil/positionattitudetransform.hpp>
+#include <components/sceneutil/workqueue.hpp>
 #include <components/settings/values.hpp>
 #include <components/terrain/terraingrid.hpp>
 #include <components/vfs/pathutil.hpp>
@@ -352,14 +359,20 @@ namespace MWWorld
         if (mChangeCellGridRequest.has_value())
         {
             changeCellGrid(mChangeCellGridRequest->mPosition, mChangeCellGridRequest->mCellIndex,
-                mChangeCellGridRequest->mChangeEvent);
+                mChangeCellGridRequest->mChangeEvent, true);
             mChangeCellGridRequest.reset();
         }
+        else
+            loadPendingCells();
 
-        mPreloader->updateCache(mRendering.getReferenceTime());
         preloadCells(duration);
     }
 
+    void Scene::updateCache()
+    {
+        mPreloader->updateCache(mRendering.getReferenceTime());
+    }
+
     void Scene::unloadCell(CellStore* cell, const DetourNavigator::UpdateGuard* navigatorUpdateGuard)
     {
         if (mActiveCells.find(cell) == mActiveCells.end())
@@ -418,6 +431,7 @@ namespace MWWorld
 
         MWBase::Environment::get().getSoundManager()->stopSound(cell);
         mActiveCells.erase(cell);
+        cell->releaseCaches();
         // Clean up any effects that may have been spawned while unloading all cells
         if (mActiveCells.empty())
             mRendering.notifyWorldSpaceChanged();
@@ -430,6 +444,7 @@ namespace MWWorld
 
         assert(mActiveCells.find(&cell) == mActiveCells.end());
         mActiveCells.insert(&cell);
+        ++mLoadedCells;
 
         Log(Debug::Info) << "Loading cell " << cell.getCell()->getDescription();
 
@@ -531,6 +546,7 @@ namespace MWWorld
 
     void Scene::clear()
     {
+        mCellsToLoad.clear();
         auto navigatorUpdateGuard = mNavigator.makeUpdateGuard();
         for (auto iter = mActiveCells.begin(); iter != mActiveCells.end();)
         {
@@ -612,8 +628,33 @@ namespace MWWorld
             ESM::ExteriorCellLocation(cell.x(), cell.y(), mCurrentCell->getCell()->getWorldSpace()), changeEvent };
     }
 
-    void Scene::changeCellGrid(const osg::Vec3f& pos, ESM::ExteriorCellLocation playerCellIndex, bool changeEvent)
+    void Scene::loadPendingCells()
+    {
+        if (mCellsToLoad.empty())
+            return;
+
+        auto navigatorUpdateGuard = mNavigator.makeUpdateGuard();
+        const osg::Vec3f pos = mWorld.getPlayerPtr().getRefData().getPosition().asVec3();
+
+        std::size_t loaded = 0;
+        while (!mCellsToLoad.empty() && loaded < mMaxCellLoadsPerFrame)
+        {
+            const ESM::ExteriorCellLocation location = mCellsToLoad.front();
+            mCellsToLoad.erase(mCellsToLoad.begin());
+            if (isCellInCollection(location, mActiveCells))
+                continue;
+            CellStore& cell = mWorld.getWorldModel().getExterior(location);
+            loadCell(cell, nullptr, mCellsToLoadRespawn, pos, navigatorUpdateGuard.get());
+            ++loaded;
+        }
+
+        mNavigator.update(pos, navigatorUpdateGuard.get());
+    }
+
+    void Scene::changeCellGrid(
+        const osg::Vec3f& pos, ESM::ExteriorCellLocation playerCellIndex, bool changeEvent, bool timeSliced)
     {
+        mCellsToLoad.clear();
         const int halfGridSize
             = isEsm4Ext(playerCellIndex.mWorldspace) ? Constants::ESM4CellGridRadius : Constants::CellGridRadius;
         auto navigatorUpdateGuard = mNavigator.makeUpdateGuard();
@@ -672,13 +713,39 @@ namespace MWWorld
         Loading::Listener* loadingListener = MWBase::Environment::get().getWindowManager()->getLoadingScreen();
         Loading::ScopedLoad load(loadingListener);
         loadingListener->setLabel("#{OMWEngine:LoadingExterior}");
-        loadingListener->setProgressRange(refsToLoad);
 
         sortCellsToLoad(playerCellX, playerCellY, cellsPositionsToLoad);
 
-        for (const auto& [x, y] : cellsPositionsToLoad)
+        // The nearest cells are loaded right away. The others stay inactive until they are loaded, so their scripts
+        // and actors don't run before their objects are in the scene.
+        std::size_t cellsToLoadNow = cellsPositionsToLoad.size();
+        if (timeSliced && mMaxCellLoadsPerFrame > 0 && cellsToLoadNow > mMaxCellLoadsPerFrame)
+        {
+            cellsToLoadNow = mMaxCellLoadsPerFrame;
+            mCellsToLoadRespawn = changeEvent;
+            for (std::size_t i = cellsToLoadNow; i < cellsPositionsToLoad.size(); ++i)
+                mCellsToLoad.emplace_back(
+                    cellsPositionsToLoad[i].first, cellsPositionsToLoad[i].second, playerCellIndex.mWorldspace);
+        }
+
+        if (mPreloadEnabled)
+        {
+            std::vector<CellStore*> cellsToPreload;
+            cellsToPreload.reserve(cellsToLoadNow);
+            for (std::size_t i = 0; i < cellsToLoadNow; ++i)
+                cellsToPreload.push_back(&mWorld.getWorldModel().getExterior(ESM::ExteriorCellLocation(
+                    cellsPositionsToLoad[i].first, cellsPositionsToLoad[i].second, playerCellIndex.mWorldspace)));
+            // Models are loaded by the work queue while the loading screen is drawn, the objects are then created
+            // from the cache
+            mPreloader->syncPreload(cellsToPreload, mRendering.getReferenceTime(), *loadingListener);
+        }
+
+        loadingListener->setProgressRange(refsToLoad);
+
+        for (std::size_t i = 0; i < cellsToLoadNow; ++i)
         {
-            ESM::ExteriorCellLocation indexToLoad = { x, y, playerCellIndex.mWorldspace };
+            ESM::ExteriorCellLocation indexToLoad
+                = { cellsPositionsToLoad[i].first, cellsPositionsToLoad[i].second, playerCellIndex.mWorldspace };
             if (!isCellInCollection(indexToLoad, mActiveCells))
             {
                 CellStore& cell = mWorld.getWorldModel().getExterior(indexToLoad);
@@ -897,7 +964,10 @@ namespace MWWorld
         , mPreloadDoors(Settings::cells().mPreloadDoors)
         , mPreloadFastTravel(Settings::cells().mPreloadFastTravel)
         , mPredictionTime(Settings::cells().mPredictionTime)
+        , mPredictivePreload(Settings::cells().mPredictivePreload)
+        , mPredictivePreloadTime(Settings::cells().mPredictivePreloadTime)
         , mLowestPoint(std::numeric_limits<float>::max())
+        , mMaxCellLoadsPerFrame(static_cast<std::size_t>(Settings::cells().mMaxCellLoadsPerFrame.get()))
     {
         mPreloader = std::make_unique<CellPreloader>(rendering.getResourceSystem(), physics->getShapeManager(),
             rendering.getTerrain(), rendering.getLandManager());
@@ -955,6 +1025,7 @@ namespace MWWorld
         auto navigatorUpdateGuard = mNavigator.makeUpdateGuard();
 
         // unload
+        mCellsToLoad.clear();
         for (auto iter = mActiveCells.begin(); iter != mActiveCells.end();)
         {
             auto* cellToUnload = *iter++;
@@ -962,6 +1033,12 @@ namespace MWWorld
         }
         assert(mActiveCells.empty());
 
+        if (mPreloadEnabled)
+        {
+            CellStore* const cellToPreload = &cell;
+            mPreloader->syncPreload(std::span(&cellToPreload, 1), mRendering.getReferenceTime(), *loadingListener);
+        }
+
         loadingListener->setProgressRange(cell.count());
 
         mNavigator.updateBounds(
@@ -1161,6 +1238,8 @@ namespace MWWorld
 
         mLastPlayerPos = playerPos;
 
+        mRendering.getWorkQueue()->setViewPoint(predictedPos);
+
         if (mPreloadEnabled)
         {
             if (mPreloadDoors)
@@ -1169,6 +1248,8 @@ namespace MWWorld
                 preloadExteriorGrid(playerPos, predictedPos);
             if (mPreloadFastTravel)
                 preloadFastTravelDestinations(playerPos, exteriorPositions);
+            if (mPredictivePreload)
+                preloadAlongPredictedPath(playerPos, moved / dt, exteriorPositions);
         }
 
         mPreloader->setTerrainPreloadPositions(exteriorPositions);
@@ -1243,12 +1324,98 @@ namespace MWWorld
                         std::abs(thisCellCenter.y() - predictedPos.y())));
                 float loadDist = cellSize / 2 + cellSize - mCellLoadingThreshold + mPreloadDistance;
 
+                // The preloader loads the cell once its references are read in the background
                 if (dist < loadDist)
-                    preloadCell(mWorld.getWorldModel().getExterior(cellIndex));
+                    preloadCell(mWorld.getWorldModel().getExterior(cellIndex, false));
             }
         }
     }
 
+    void Scene::preloadAlongPredictedPath(
+        const osg::Vec3f& playerPos, const osg::Vec3f& velocity, std::vector<PositionCellGrid>& exteriorPositions)
+    {
+        const float speed = velocity.length();
+        if (speed < 1e-3f || mPredictivePreloadTime <= 0)
+            return;
+
+        const osg::Vec3f direction = velocity / speed;
+        const float pathLength = speed * mPredictivePreloadTime;
+
+        // Estimated time of arrival in seconds for each cell that will be needed
+        std::map<CellStore*, float> arrivals;
+        const auto addArrival = [&](CellStore& cell, float eta) {
+            if (isCellActive(cell))
+                return;
+            const auto [it, inserted] = arrivals.emplace(&cell, eta);
+            if (!inserted)
+                it->second = std::min(it->second, eta);
+        };
+
+        for (const CellStore* cellStore : mActiveCells)
+        {
+            for (const auto& door : cellStore->getReadOnlyDoors().mList)
+            {
+                if (!door.mRef.getTeleport())
+                    continue;
+                const osg::Vec3f toDoor = door.mData.getPosition().asVec3() - playerPos;
+                const float along = toDoor * direction;
+                if (along < 0 || along > pathLength)
+                    continue;
+                if ((toDoor - direction * along).length2() > mPreloadDistance * mPreloadDistance)
+                    continue;
+                try
+                {
+                    addArrival(mWorld.getWorldModel().getCell(door.mRef.getDestCell()), along / speed);
+                }
+                catch (const std::exception& e)
+                {
+                    Log(Debug::Warning) << "Failed to predict preload for door destination "
+                                        << door.mRef.getDestCell() << ": " << e.what();
+                }
+            }
+        }
+
+        if (mWorld.isCellExterior())
+        {
+            const ESM::RefId worldspace = mWorld.getCurrentWorldspace();
+            const float step = static_cast<float>(ESM::getCellSize(worldspace)) / 4;
+            osg::Vec2i gridCenter = mCurrentGridCenter;
+            osg::Vec3f position = playerPos;
+            for (float distance = step; distance <= pathLength; distance += step)
+            {
+                position = playerPos + direction * distance;
+                const osg::Vec2i newGridCenter = getNewGridCenter(position, &gridCenter);
+                if (newGridCenter == gridCenter)
+                    continue;
+                gridCenter = newGridCenter;
+                const float eta = distance / speed;
+                iterateOverCellsAround(gridCenter.x(), gridCenter.y(), mHalfGridSize, [&](int x, int y) {
+                    addArrival(mWorld.getWorldModel().getExterior(ESM::ExteriorCellLocation(x, y, worldspace)), eta);
+                });
+            }
+            if (gridCenter != mCurrentGridCenter)
+                exteriorPositions.push_back(PositionCellGrid{ position, gridCenterToBounds(gridCenter) });
+        }
+
+        std::vector<std::pair<float, CellStore*>> cells;
+        cells.reserve(arrivals.size());
+        for (const auto& [cell, eta] : arrivals)
+            cells.emplace_back(eta, cell);
+        std::sort(cells.begin(), cells.end());
+
+        const std::size_t leftCapacity = mPreloader->getMaxCacheSize() - mPreloader->getCacheSize();
+        if (cells.size() > leftCapacity)
+            cells.resize(leftCapacity);
+
+        using Clock = SceneUtil::WorkItem::Clock;
+        const Clock::time_point now = Clock::now();
+        for (const auto& [eta, cell] : cells)
+        {
+            const auto deadline = now + std::chrono::duration_cast<Clock::duration>(std::chrono::duration<float>(eta));
+            mPreloader->preload(*cell, mRendering.getReferenceTime(), deadline);
+        }
+    }
+
     void Scene::preloadCellWithSurroundings(CellStore& cell)
     {
         if (!cell.isExterior())
@@ -1375,5 +1542,6 @@ namespace MWWorld
     void Scene::reportStats(unsigned int frameNumber, osg::Stats& stats) const
     {
         mPreloader->reportStats(frameNumber, stats);
+        stats.setAttribute(frameNumber, "Scene Loaded Cells", static_cast<double>(mLoadedCells));
     }
 }
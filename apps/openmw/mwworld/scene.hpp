@@ -102,6 +102,8 @@ namespace MWWorld
         bool mPreloadDoors;
         bool mPreloadFastTravel;
         float mPredictionTime;
+        bool mPredictivePreload;
+        float mPredictivePreloadTime;
         float mLowestPoint;
 
         int mHalfGridSize = Constants::CellGridRadius;
@@ -114,13 +116,23 @@ namespace MWWorld
 
         std::optional<ChangeCellGridRequest> mChangeCellGridRequest;
 
+        // Cells of the active grid that are not loaded yet, nearest to the player first
+        std::vector<ESM::ExteriorCellLocation> mCellsToLoad;
+        bool mCellsToLoadRespawn = false;
+        std::size_t mMaxCellLoadsPerFrame;
+        std::size_t mLoadedCells = 0;
+
         void insertCell(CellStore& cell, Loading::Listener* loadingListener,
             const DetourNavigator::UpdateGuard* navigatorUpdateGuard);
 
         osg::Vec2i mCurrentGridCenter;
 
         // Load and unload cells as necessary to create a cell grid with "X" and "Y" in the center
-        void changeCellGrid(const osg::Vec3f& pos, ESM::ExteriorCellLocation playerCellIndex, bool changeEvent = true);
+        // @param timeSliced load only the nearest cells now and the others over the next frames
+        void changeCellGrid(const osg::Vec3f& pos, ESM::ExteriorCellLocation playerCellIndex, bool changeEvent = true,
+            bool timeSliced = false);
+
+        void loadPendingCells();
 
         void requestChangeCellGrid(const osg::Vec3f& position, const osg::Vec2i& cell, bool changeEvent = true);
 
@@ -129,6 +141,8 @@ namespace MWWorld
         void preloadExteriorGrid(const osg::Vec3f& playerPos, const osg::Vec3f& predictedPos);
         void preloadFastTravelDestinations(
             const osg::Vec3f& playerPos, std::vector<PositionCellGrid>& exteriorPositions);
+        void preloadAlongPredictedPath(
+            const osg::Vec3f& playerPos, const osg::Vec3f& velocity, std::vector<PositionCellGrid>& exteriorPositions);
         void preloadCellWithSurroundings(MWWorld::CellStore& cell);
         void preloadCell(MWWorld::CellStore& cell);
         void preloadTerrain(const osg::Vec3f& pos, ESM::RefId worldspace, bool sync = false);
@@ -180,6 +194,9 @@ namespace MWWorld
 
         void update(float duration);
 
+        /// Expire preloaded cells and objects in the resource caches.
+        void updateCache();
+
         void addObjectToScene(const Ptr& ptr);
         ///< Add an object that already exists in the world model to the scene.
 
@@ -1,5 +1,7 @@
 #include "store.hpp"
 
+#include <algorithm>
+#include <bit>
 #include <iterator>
 #include <sstream>
 #include <stdexcept>
@@ -121,6 +123,9 @@ namespace MWWorld
     template <class T, class Id>
     TypedDynamicStore<T, Id>::TypedDynamicStore(const TypedDynamicStore<T, Id>& orig)
         : mStatic(orig.mStatic)
+        , mFlat(orig.mFlat)
+        , mFlatIndex(orig.mFlatIndex)
+        , mFlatIndexShift(orig.mFlatIndexShift)
     {
     }
 
@@ -128,11 +133,100 @@ namespace MWWorld
     void TypedDynamicStore<T, Id>::clearDynamic()
     {
         // remove the dynamic part of mShared
-        assert(mShared.size() >= mStatic.size());
-        mShared.erase(mShared.begin() + mStatic.size(), mShared.end());
+        assert(mShared.size() >= getStaticSize());
+        mShared.erase(mShared.begin() + getStaticSize(), mShared.end());
         mDynamic.clear();
     }
 
+    template <class T, class Id>
+    std::size_t TypedDynamicStore<T, Id>::getFlatSlot(const Id& id) const
+    {
+        // Fibonacci hashing, std::hash of pointer based ids has poorly distributed low bits
+        const std::uint64_t hash = std::hash<Id>{}(id);
+        return static_cast<std::size_t>((hash * 11400714819323198485ull) >> mFlatIndexShift);
+    }
+
+    template <class T, class Id>
+    const T* TypedDynamicStore<T, Id>::searchFlat(const Id& id) const
+    {
+        const std::size_t mask = mFlatIndex.size() - 1;
+        for (std::size_t slot = getFlatSlot(id); mFlatIndex[slot] != sInvalidHandle; slot = (slot + 1) & mask)
+        {
+            const T& record = mFlat[mFlatIndex[slot]];
+            if (record.mId == id)
+                return &record;
+        }
+        return nullptr;
+    }
+
+    template <class T, class Id>
+    void TypedDynamicStore<T, Id>::checkNotFlat() const
+    {
+        if (isFlat())
+            throw std::logic_error("Static records of a flat store can't be modified");
+    }
+
+    template <class T, class Id>
+    void TypedDynamicStore<T, Id>::makeFlat()
+    {
+        if (isFlat() || mStatic.empty())
+            return;
+
+        const std::size_t staticSize = mStatic.size();
+        if (staticSize >= sInvalidHandle / 2)
+            throw std::runtime_error("Too many records to make store flat");
+        assert(mShared.size() >= staticSize);
+
+        // Static part of mShared goes first and keeps the content files order
+        mFlat.reserve(staticSize);
+        for (std::size_t i = 0; i < staticSize; ++i)
+            mFlat.push_back(std::move(*mShared[i]));
+        mStatic.clear();
+        for (std::size_t i = 0; i < staticSize; ++i)
+            mShared[i] = &mFlat[i];
+
+        // Keep load factor at most 0.5
+        const std::size_t capacity = std::bit_ceil(staticSize * 2);
+        mFlatIndexShift = 64 - std::countr_zero(capacity);
+        mFlatIndex.assign(capacity, sInvalidHandle);
+        const std::size_t mask = capacity - 1;
+        for (std::size_t i = 0; i < staticSize; ++i)
+        {
+            std::size_t slot = getFlatSlot(mFlat[i].mId);
+            while (mFlatIndex[slot] != sInvalidHandle)
+                slot = (slot + 1) & mask;
+            mFlatIndex[slot] = static_cast<Handle>(i);
+        }
+    }
+
+    template <class T, class Id>
+    typename TypedDynamicStore<T, Id>::Handle TypedDynamicStore<T, Id>::searchHandle(const Id& id) const
+    {
+        if (const auto dit = mDynamic.find(id); dit != mDynamic.end())
+        {
+            const auto it = std::find(mShared.begin() + getStaticSize(), mShared.end(), &dit->second);
+            assert(it != mShared.end());
+            return static_cast<Handle>(it - mShared.begin());
+        }
+
+        if (isFlat())
+        {
+            if (const T* const record = searchFlat(id))
+                return static_cast<Handle>(record - mFlat.data());
+            return sInvalidHandle;
+        }
+
+        if (const auto it = mStatic.find(id); it != mStatic.end())
+        {
+            const auto end = mShared.begin() + mStatic.size();
+            const auto sharedIt = std::find(mShared.begin(), end, &it->second);
+            assert(sharedIt != end);
+            return static_cast<Handle>(sharedIt - mShared.begin());
+        }
+
+        return sInvalidHandle;
+    }
+
     template <class T, class Id>
     const T* TypedDynamicStore<T, Id>::search(const Id& id) const
     {
@@ -140,15 +234,14 @@ namespace MWWorld
         if (dit != mDynamic.end())
             return &dit->second;
 
-        typename Static::const_iterator it = mStatic.find(id);
-        if (it != mStatic.end())
-            return &(it->second);
-
-        return nullptr;
+        return searchStatic(id);
     }
     template <class T, class Id>
     const T* TypedDynamicStore<T, Id>::searchStatic(const Id& id) const
     {
+        if (isFlat())
+            return searchFlat(id);
+
         typename Static::const_iterator it = mStatic.find(id);
         if (it != mStatic.end())
             return &(it->second);
@@ -210,6 +303,8 @@ namespace MWWorld
     {
         if constexpr (!ESM::isESM4Rec(T::sRecordId))
         {
+            checkNotFlat();
+
             T record;
             bool isDeleted = false;
             record.load(esm, isDeleted);
@@ -275,12 +370,8 @@ namespace MWWorld
     {
         if constexpr (std::is_same_v<decltype(item.mId), ESM::RefId>)
             overrideOnly = overrideOnly && !item.mId.template is<ESM::GeneratedRefId>();
-        if (overrideOnly)
-        {
-            auto it = mStatic.find(item.mId);
-            if (it == mStatic.end())
-                return nullptr;
-        }
+        if (overrideOnly && searchStatic(item.mId) == nullptr)
+            return nullptr;
         std::pair<typename Dynamic::iterator, bool> result = mDynamic.insert_or_assign(item.mId, item);
         T* ptr = &result.first->second;
         if (result.second)
@@ -290,6 +381,7 @@ namespace MWWorld
     template <class T, class Id>
     T* TypedDynamicStore<T, Id>::insertStatic(const T& item)
     {
+        checkNotFlat();
         std::pair<typename Static::iterator, bool> result = mStatic.insert_or_assign(item.mId, item);
         T* ptr = &result.first->second;
         if (result.second)
@@ -297,8 +389,20 @@ namespace MWWorld
         return ptr;
     }
     template <class T, class Id>
+    T* TypedDynamicStore<T, Id>::insertStatic(T&& item)
+    {
+        checkNotFlat();
+        const Id id = item.mId;
+        std::pair<typename Static::iterator, bool> result = mStatic.insert_or_assign(id, std::move(item));
+        T* ptr = &result.first->second;
+        if (result.second)
+            mShared.push_back(ptr);
+        return ptr;
+    }
+    template <class T, class Id>
     bool TypedDynamicStore<T, Id>::eraseStatic(const Id& id)
     {
+        checkNotFlat();
         typename Static::iterator it = mStatic.find(id);
 
         if (it != mStatic.end())
@@ -329,8 +433,8 @@ namespace MWWorld
             return false;
 
         // have to reinit the whole shared part
-        assert(mShared.size() >= mStatic.size());
-        mShared.erase(mShared.begin() + mStatic.size(), mShared.end());
+        assert(mShared.size() >= getStaticSize());
+        mShared.erase(mShared.begin() + getStaticSize(), mShared.end());
         for (auto it = mDynamic.begin(); it != mDynamic.end(); ++it)
         {
             mShared.push_back(&it->second);
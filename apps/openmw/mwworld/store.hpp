@@ -1,6 +1,8 @@
 #ifndef OPENMW_MWWORLD_STORE_H
 #define OPENMW_MWWORLD_STORE_H
 
+#include <cstdint>
+#include <limits>
 #include <map>
 #include <memory>
 #include <set>
@@ -198,15 +200,40 @@ namespace MWWorld
         std::vector<T*> mShared;
         typedef std::unordered_map<Id, T> Dynamic;
         Dynamic mDynamic;
+        // static records moved by makeFlat() in mShared order, mStatic is empty then
+        std::vector<T> mFlat;
+        // open addressing hash table of indices into mFlat, the size is a power of two
+        std::vector<std::uint32_t> mFlatIndex;
+        int mFlatIndexShift = 0;
 
         friend class ESMStore;
 
+        std::size_t getStaticSize() const { return mFlat.empty() ? mStatic.size() : mFlat.size(); }
+        std::size_t getFlatSlot(const Id& id) const;
+        const T* searchFlat(const Id& id) const;
+        void checkNotFlat() const;
+
     public:
+        /// Dense index of a record in iteration order, the same as used by at().
+        using Handle = std::uint32_t;
+        static constexpr Handle sInvalidHandle = std::numeric_limits<Handle>::max();
+
         TypedDynamicStore();
         TypedDynamicStore(const TypedDynamicStore<T, Id>& orig);
 
         typedef SharedIterator<T> iterator;
 
+        /// Move static records into contiguous storage and index them with a flat hash table. Static records can't be
+        /// loaded, inserted or erased afterwards. Pointers to static records obtained before are invalidated.
+        void makeFlat();
+
+        bool isFlat() const { return !mFlat.empty(); }
+
+        /// @return Handle of the record returned by search(id) to be used with at() or sInvalidHandle. Handles of
+        /// static records are stable once the store is flat. Handles of dynamic records are valid until the dynamic
+        /// part is modified.
+        Handle searchHandle(const Id& id) const;
+
         // setUp needs to be called again after
         void clearDynamic() override;
         void setUp() override;
@@ -237,6 +264,7 @@ namespace MWWorld
 
         T* insert(const T& item, bool overrideOnly = false);
         T* insertStatic(const T& item);
+        T* insertStatic(T&& item);
 
         bool eraseStatic(const Id& id) override;
         bool erase(const Id& id);
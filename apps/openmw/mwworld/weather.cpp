@@ -63,9 +63,9 @@ namespace MWWorld
 
     template <typename T>
     T TimeOfDayInterpolator<T>::getValue(
-        const float gameHour, const TimeOfDaySettings& timeSettings, const std::string& prefix) const
+        const float gameHour, const TimeOfDaySettings& timeSettings, TimeOfDayTransition transition) const
     {
-        WeatherSetting setting = timeSettings.getSetting(prefix);
+        const WeatherSetting& setting = timeSettings.getSetting(transition);
         float preSunriseTime = setting.mPreSunriseTime;
         float postSunriseTime = setting.mPostSunriseTime;
         float preSunsetTime = setting.mPreSunsetTime;
@@ -635,10 +635,10 @@ namespace MWWorld
         mTimeSettings.mDayStart = mSunriseTime + mSunriseDuration;
         mTimeSettings.mDayEnd = mSunsetTime;
 
-        mTimeSettings.addSetting("Sky");
-        mTimeSettings.addSetting("Ambient");
-        mTimeSettings.addSetting("Fog");
-        mTimeSettings.addSetting("Sun");
+        mTimeSettings.addSetting(TimeOfDayTransition::Sky, "Sky");
+        mTimeSettings.addSetting(TimeOfDayTransition::Ambient, "Ambient");
+        mTimeSettings.addSetting(TimeOfDayTransition::Fog, "Fog");
+        mTimeSettings.addSetting(TimeOfDayTransition::Sun, "Sun");
 
         // Morrowind handles stars settings differently for other ones
         mTimeSettings.mStarsPostSunsetStart = Fallback::Map::getFloat("Weather_Stars_Post-Sunset_Start");
@@ -880,7 +880,7 @@ namespace MWWorld
             mRendering.setNight(isNight);
         }
 
-        float underwaterFog = mUnderwaterFog.getValue(time.getHour(), mTimeSettings, "Fog");
+        float underwaterFog = mUnderwaterFog.getValue(time.getHour(), mTimeSettings, TimeOfDayTransition::Fog);
 
         float peakHour = mSunriseTime + (mTimeSettings.mNightStart - mSunriseTime) / 2;
         float glareFade = 1.f;
@@ -1287,16 +1287,16 @@ namespace MWWorld
             || gameHour
                 > mTimeSettings.mNightStart + mTimeSettings.mStarsPostSunsetStart - mTimeSettings.mStarsFadingDuration);
 
-        mResult.mFogDepth = current.mLandFogDepth.getValue(gameHour, mTimeSettings, "Fog");
-        mResult.mFogColor = current.mFogColor.getValue(gameHour, mTimeSettings, "Fog");
-        mResult.mAmbientColor = current.mAmbientColor.getValue(gameHour, mTimeSettings, "Ambient");
-        mResult.mSunColor = current.mSunColor.getValue(gameHour, mTimeSettings, "Sun");
-        mResult.mSkyColor = current.mSkyColor.getValue(gameHour, mTimeSettings, "Sky");
-        mResult.mNightFade = mNightFade.getValue(gameHour, mTimeSettings, "Stars");
+        mResult.mFogDepth = current.mLandFogDepth.getValue(gameHour, mTimeSettings, TimeOfDayTransition::Fog);
+        mResult.mFogColor = current.mFogColor.getValue(gameHour, mTimeSettings, TimeOfDayTransition::Fog);
+        mResult.mAmbientColor = current.mAmbientColor.getValue(gameHour, mTimeSettings, TimeOfDayTransition::Ambient);
+        mResult.mSunColor = current.mSunColor.getValue(gameHour, mTimeSettings, TimeOfDayTransition::Sun);
+        mResult.mSkyColor = current.mSkyColor.getValue(gameHour, mTimeSettings, TimeOfDayTransition::Sky);
+        mResult.mNightFade = mNightFade.getValue(gameHour, mTimeSettings, TimeOfDayTransition::Stars);
         mResult.mDLFogFactor = current.mDL.FogFactor;
         mResult.mDLFogOffset = current.mDL.FogOffset;
 
-        WeatherSetting setting = mTimeSettings.getSetting("Sun");
+        const WeatherSetting& setting = mTimeSettings.getSetting(TimeOfDayTransition::Sun);
         float preSunsetTime = setting.mPreSunsetTime;
 
         if (gameHour >= mTimeSettings.mDayEnd - preSunsetTime)
@@ -1,9 +1,12 @@
 #ifndef GAME_MWWORLD_WEATHER_H
 #define GAME_MWWORLD_WEATHER_H
 
+#include <array>
+#include <cstddef>
 #include <cstdint>
 #include <map>
 #include <string>
+#include <string_view>
 
 #include <osg/Vec4f>
 
@@ -56,6 +59,17 @@ namespace MWWorld
         float mPostSunsetTime;
     };
 
+    /// Values with their own sunrise and sunset transition times
+    enum class TimeOfDayTransition
+    {
+        Sky,
+        Ambient,
+        Fog,
+        Sun,
+        Stars,
+        Count,
+    };
+
     struct TimeOfDaySettings
     {
         float mNightStart;
@@ -63,33 +77,29 @@ namespace MWWorld
         float mDayStart;
         float mDayEnd;
 
-        std::map<std::string, WeatherSetting> mSunriseTransitions;
+        // Looked up once instead of by name on every update
+        std::array<WeatherSetting, static_cast<std::size_t>(TimeOfDayTransition::Count)> mSunriseTransitions;
 
         float mStarsPostSunsetStart;
         float mStarsPreSunriseFinish;
         float mStarsFadingDuration;
 
-        WeatherSetting getSetting(const std::string& type) const
+        TimeOfDaySettings() { mSunriseTransitions.fill({ 1.f, 1.f, 1.f, 1.f }); }
+
+        const WeatherSetting& getSetting(TimeOfDayTransition type) const
         {
-            std::map<std::string, WeatherSetting>::const_iterator it = mSunriseTransitions.find(type);
-            if (it != mSunriseTransitions.end())
-            {
-                return it->second;
-            }
-            else
-            {
-                return { 1.f, 1.f, 1.f, 1.f };
-            }
+            return mSunriseTransitions[static_cast<std::size_t>(type)];
         }
 
-        void addSetting(const std::string& type)
+        void addSetting(TimeOfDayTransition type, std::string_view name)
         {
-            WeatherSetting setting = { Fallback::Map::getFloat("Weather_" + type + "_Pre-Sunrise_Time"),
-                Fallback::Map::getFloat("Weather_" + type + "_Post-Sunrise_Time"),
-                Fallback::Map::getFloat("Weather_" + type + "_Pre-Sunset_Time"),
-                Fallback::Map::getFloat("Weather_" + type + "_Post-Sunset_Time") };
+            const std::string prefix = "Weather_" + std::string(name);
+            WeatherSetting setting = { Fallback::Map::getFloat(prefix + "_Pre-Sunrise_Time"),
+                Fallback::Map::getFloat(prefix + "_Post-Sunrise_Time"),
+                Fallback::Map::getFloat(prefix + "_Pre-Sunset_Time"),
+                Fallback::Map::getFloat(prefix + "_Post-Sunset_Time") };
 
-            mSunriseTransitions[type] = setting;
+            mSunriseTransitions[static_cast<std::size_t>(type)] = setting;
         }
     };
 
@@ -107,7 +117,7 @@ namespace MWWorld
         {
         }
 
-        T getValue(const float gameHour, const TimeOfDaySettings& timeSettings, const std::string& prefix) const;
+        T getValue(const float gameHour, const TimeOfDaySettings& timeSettings, TimeOfDayTransition transition) const;
 
         const T& getSunriseValue() const { return mSunriseValue; }
         const T& getDayValue() const { return mDayValue; }
@@ -1,5 +1,6 @@
 #include "worldimp.hpp"
 
+#include <algorithm>
 #include <charconv>
 #include <vector>
 
@@ -28,6 +29,7 @@
 #include <components/esm4/loaddoor.hpp>
 #include <components/esm4/loadstat.hpp>
 #include <components/esm4/loadwrld.hpp>
+#include <components/esmloader/headercache.hpp>
 
 #include <components/misc/constants.hpp>
 #include <components/misc/convert.hpp>
@@ -103,6 +105,7 @@
 #include "projectilemanager.hpp"
 #include "weather.hpp"
 
+#include "contentcache.hpp"
 #include "contentloader.hpp"
 #include "esmloader.hpp"
 
@@ -201,17 +204,24 @@ namespace MWWorld
             mLoaders.emplace(std::move(extension), &loader);
         }
 
-        void load(const std::filesystem::path& filepath, int& index, Loading::Listener* listener) override
+        ContentLoader* findLoader(const std::filesystem::path& filepath) const
         {
             const auto it
                 = mLoaders.find(Misc::StringUtils::lowerCase(Files::pathToUnicodeString(filepath.extension())));
-            if (it != mLoaders.end())
+            if (it == mLoaders.end())
+                return nullptr;
+            return it->second;
+        }
+
+        void load(const std::filesystem::path& filepath, int& index, Loading::Listener* listener) override
+        {
+            if (ContentLoader* const loader = findLoader(filepath))
             {
                 const auto filename = filepath.filename();
                 Log(Debug::Info) << "Loading content file " << filename;
                 if (listener != nullptr)
                     listener->setLabel(MyGUI::TextIterator::toTagsString(Files::pathToUnicodeString(filename)));
-                it->second->load(filepath, index, listener);
+                loader->load(filepath, index, listener);
             }
             else
             {
@@ -288,6 +298,9 @@ namespace MWWorld
         mStore.validateRecords(mReaders);
         mStore.movePlayerRecord();
 
+        if (Settings::general().mFlatRecordStorage)
+            mStore.makeFlat();
+
         mSwimHeightScale = mStore.get<ESM::GameSetting>().find("fSwimHeightScale")->mValue.getFloat();
     }
 
@@ -308,7 +321,7 @@ namespace MWWorld
         }
 
         mRendering = std::make_unique<MWRender::RenderingManager>(
-            viewer, rootNode, mResourceSystem, workQueue, *mNavigator, mGroundcoverStore, unrefQueue);
+            viewer, rootNode, mResourceSystem, workQueue, *mNavigator, mGroundcoverStore, unrefQueue, mUserDataPath);
         mProjectileManager = std::make_unique<ProjectileManager>(
             mRendering->getLightRoot()->asGroup(), mResourceSystem, mRendering.get(), mPhysics.get());
         mRendering->preloadCommonAssets();
@@ -2629,6 +2642,31 @@ namespace MWWorld
         return mPhysics->getLineOfSight(actor, targetActor);
     }
 
+    std::vector<bool> World::getLOS(const MWWorld::ConstPtr& actor, std::span<const MWWorld::ConstPtr> targets)
+    {
+        const auto isInActiveCell = [](const MWWorld::ConstPtr& ptr) {
+            return ptr.getRefData().isEnabled() && ptr.getRefData().getBaseNode();
+        };
+        if (!isInActiveCell(actor))
+            return std::vector<bool>(targets.size(), false);
+
+        std::vector<MWWorld::ConstPtr> active;
+        std::vector<std::size_t> indices;
+        for (std::size_t i = 0; i < targets.size(); ++i)
+        {
+            if (!isInActiveCell(targets[i]))
+                continue;
+            active.push_back(targets[i]);
+            indices.push_back(i);
+        }
+
+        std::vector<bool> result(targets.size(), false);
+        const std::vector<bool> linesOfSight = mPhysics->getLinesOfSight(actor, active);
+        for (std::size_t i = 0; i < indices.size(); ++i)
+            result[indices[i]] = linesOfSight[i];
+        return result;
+    }
+
     float World::getDistToNearestRayHit(const osg::Vec3f& from, const osg::Vec3f& dir, float maxDist, bool includeWater)
     {
         osg::Vec3f to(dir);
@@ -2883,22 +2921,53 @@ namespace MWWorld
         OMWScriptsLoader omwScriptsLoader(mStore);
         gameContentLoader.addLoader(".omwscripts", omwScriptsLoader);
 
-        int idx = 0;
+        std::vector<std::filesystem::path> paths;
+        paths.reserve(content.size());
         for (const std::string& file : content)
         {
             const Files::MultiDirCollection& col = fileCollections.getCollection(Misc::getFileExtension(file));
-            if (col.doesExist(file))
+            paths.push_back(col.doesExist(file) ? col.getPath(file) : std::filesystem::path());
+        }
+
+        std::vector<std::filesystem::path> readAheadFiles;
+        readAheadFiles.reserve(paths.size());
+        for (const std::filesystem::path& path : paths)
+            readAheadFiles.push_back(
+                !path.empty() && gameContentLoader.findLoader(path) == &esmLoader ? path : std::filesystem::path());
+        ::EsmLoader::HeaderCache headerCache(mUserDataPath / "pluginheaders");
+        esmLoader.checkMasters(readAheadFiles, headerCache);
+        headerCache.write();
+        esmLoader.setReadAhead(std::move(readAheadFiles), Settings::general().mContentReadAhead);
+
+        const bool useContentCache = Settings::general().mContentCache
+            && std::none_of(paths.begin(), paths.end(), [](const auto& path) { return path.empty(); });
+        const std::filesystem::path contentCachePath = mUserDataPath / "contentcache";
+        std::string contentCacheKey;
+        bool contentCacheRestored = false;
+        if (useContentCache)
+        {
+            contentCacheKey = makeContentCacheKey(paths, encoder);
+            contentCacheRestored = readContentCache(contentCachePath, contentCacheKey, mStore);
+        }
+
+        int idx = 0;
+        for (std::size_t i = 0; i < content.size(); ++i)
+        {
+            if (!paths[i].empty())
             {
-                gameContentLoader.load(col.getPath(file), idx, listener);
+                gameContentLoader.load(paths[i], idx, listener);
             }
             else
             {
-                std::string message = "Failed loading " + file + ": the content file does not exist";
+                std::string message = "Failed loading " + content[i] + ": the content file does not exist";
                 throw std::runtime_error(message);
             }
             idx++;
         }
 
+        if (useContentCache && !contentCacheRestored && !esmLoader.hasTes4Content())
+            writeContentCache(contentCachePath, contentCacheKey, mStore);
+
         if (const auto v = esmLoader.getMasterFileFormat(); v.has_value() && *v == 0)
             ensureNeededRecords(); // Insert records that may not be present in all versions of master files.
     }
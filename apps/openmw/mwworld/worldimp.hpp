@@ -505,6 +505,8 @@ namespace MWWorld
         ///< get all items in active cells owned by this Npc
 
         bool getLOS(const MWWorld::ConstPtr& actor, const MWWorld::ConstPtr& targetActor) override;
+
+        std::vector<bool> getLOS(const MWWorld::ConstPtr& actor, std::span<const MWWorld::ConstPtr> targets) override;
         ///< get Line of Sight (morrowind stupid implementation)
 
         float getDistToNearestRayHit(
@@ -95,6 +95,10 @@ namespace OpenMW
         addOption("random-seed", bpo::value<unsigned int>()->default_value(Misc::Rng::generateDefaultSeed()),
             "seed value for random number generator");
 
+        addOption("benchmark-frames", bpo::value<std::size_t>()->default_value(0),
+            "run the given number of frames with a fixed frame time once the game is running, log the time taken by "
+            "every subsystem and quit");
+
         return desc;
     }
 }
@@ -4,6 +4,8 @@
 #include <osg/Stats>
 #include <osg/Timer>
 
+#include <components/debug/tracing.hpp>
+
 #include <cstddef>
 #include <string>
 
@@ -37,6 +39,7 @@ namespace OMW
         PhysicsWorker,
         World,
         Gui,
+        Deferred,
         Focus,
         Lua,
         Number,
@@ -75,6 +78,9 @@ namespace OMW
     template <>
     inline const UserStats UserStatsValue<UserStatsType::Gui>::sValue{ "GUI", "gui" };
 
+    template <>
+    inline const UserStats UserStatsValue<UserStatsType::Deferred>::sValue{ "Defer", "deferred" };
+
     template <>
     inline const UserStats UserStatsValue<UserStatsType::Lua>::sValue{ "Lua", "lua" };
 
@@ -122,6 +128,7 @@ namespace OMW
             , mFrameNumber(frameNumber)
             , mTimer(timer)
             , mStats(stats)
+            , mZone(UserStatsValue<type>::sValue.mLabel.c_str())
         {
         }
 
@@ -147,6 +154,8 @@ namespace OMW
         const unsigned int mFrameNumber;
         const osg::Timer& mTimer;
         osg::Stats& mStats;
+        // Profiled scopes are traced as well
+        const Debug::TraceZone mZone;
     };
 }
 
@@ -0,0 +1,107 @@
+#include "spikedetector.hpp"
+
+#include <osg/Stats>
+
+#include <algorithm>
+#include <format>
+#include <string>
+
+#include "profile.hpp"
+
+namespace OMW
+{
+    namespace
+    {
+        std::optional<double> getAttribute(unsigned frameNumber, const std::string& name, const osg::Stats& stats)
+        {
+            double value = 0;
+            if (!stats.getAttribute(frameNumber, name, value))
+                return std::nullopt;
+            return value;
+        }
+
+        // For the counters that only grow
+        std::optional<double> getIncrease(unsigned frameNumber, const std::string& name, const osg::Stats& stats)
+        {
+            if (frameNumber == 0)
+                return std::nullopt;
+            const std::optional<double> current = getAttribute(frameNumber, name, stats);
+            const std::optional<double> previous = getAttribute(frameNumber - 1, name, stats);
+            if (!current.has_value() || !previous.has_value())
+                return std::nullopt;
+            return *current - *previous;
+        }
+    }
+
+    SpikeDetector::SpikeDetector(double factor)
+        : mFactor(factor)
+    {
+        mDurations.reserve(sWindowSize);
+    }
+
+    std::optional<double> SpikeDetector::addFrame(double duration)
+    {
+        std::optional<double> result;
+        if (mPercentile > 0 && duration > mPercentile * mFactor)
+            result = mPercentile;
+
+        if (mDurations.size() < sWindowSize)
+            mDurations.push_back(duration);
+        else
+            mDurations[mNext] = duration;
+        mNext = (mNext + 1) % sWindowSize;
+
+        ++mFramesSinceUpdate;
+        if (mDurations.size() >= sMinFrames && (mPercentile == 0 || mFramesSinceUpdate >= sUpdateInterval))
+        {
+            mSorted = mDurations;
+            const auto percentile = mSorted.begin() + static_cast<std::ptrdiff_t>((mSorted.size() - 1) * 99 / 100);
+            std::nth_element(mSorted.begin(), percentile, mSorted.end());
+            mPercentile = *percentile;
+            mFramesSinceUpdate = 0;
+        }
+
+        return result;
+    }
+
+    void reportSpike(unsigned frameNumber, double duration, double percentile, std::string_view location,
+        const osg::Stats& stats, std::ostream& stream)
+    {
+        stream << std::format("Frame {} took {:.3f} ms, {:.1f} times the 99th percentile of {:.3f} ms, at {}",
+            frameNumber, duration * 1000, duration / percentile, percentile * 1000, location);
+
+        stream << "\n  Subsystems:";
+        forEachUserStatsValue([&](const UserStats& v) {
+            if (const std::optional<double> value = getAttribute(frameNumber, v.mTaken, stats))
+            {
+                std::string_view label = v.mLabel;
+                label.remove_prefix(std::min(label.find_first_not_of(" -"), label.size()));
+                stream << std::format(" {} {:.3f} ms", label, *value * 1000);
+            }
+        });
+
+        const auto writeValue = [&](std::string_view label, std::optional<double> value) {
+            if (value.has_value())
+                stream << std::format(" {} {}", label, *value);
+        };
+
+        stream << "\n  Work:";
+        writeValue("cells loaded", getIncrease(frameNumber, "Scene Loaded Cells", stats));
+        writeValue("cells preloaded", getIncrease(frameNumber, "CellPreloader Loaded", stats));
+        writeValue("objects to compile", getAttribute(frameNumber, "Compiling", stats));
+        writeValue("Lua scripts over budget", getAttribute(frameNumber, "Lua Deferred", stats));
+        writeValue("Lua GC steps", getAttribute(frameNumber, "Lua GC Steps", stats));
+        if (const std::optional<double> gcTime = getAttribute(frameNumber, "Lua GC", stats))
+            stream << std::format(" Lua GC {:.3f} ms", *gcTime);
+
+        constexpr std::string_view caches[] = { "Node", "Shape", "Image", "Nif", "Keyframe", "Terrain Chunk" };
+        stream << "\n  Resource cache misses:";
+        for (std::string_view cache : caches)
+        {
+            const std::optional<double> get = getIncrease(frameNumber, std::format("{} Get", cache), stats);
+            const std::optional<double> hit = getIncrease(frameNumber, std::format("{} Hit", cache), stats);
+            if (get.has_value() && hit.has_value())
+                writeValue(cache, *get - *hit);
+        }
+    }
+}
@@ -0,0 +1,52 @@
+#ifndef OPENMW_SPIKEDETECTOR_H
+#define OPENMW_SPIKEDETECTOR_H
+
+#include <cstddef>
+#include <optional>
+#include <ostream>
+#include <string_view>
+#include <vector>
+
+namespace osg
+{
+    class Stats;
+}
+
+namespace OMW
+{
+    /// @brief Detects frames that take much longer than the 99th percentile of the recent frames.
+    /// @par The percentile is updated every sUpdateInterval frames over the last sWindowSize frames, nothing is a
+    /// spike before sMinFrames frames are known.
+    class SpikeDetector
+    {
+    public:
+        static constexpr std::size_t sWindowSize = 1000;
+        static constexpr std::size_t sMinFrames = 100;
+        static constexpr std::size_t sUpdateInterval = 60;
+
+        /// @param factor how many times longer than the percentile a frame has to take to be a spike
+        explicit SpikeDetector(double factor);
+
+        /// @param duration time in seconds taken by the frame
+        /// @return the percentile in seconds the frame is compared to if it is a spike
+        std::optional<double> addFrame(double duration);
+
+    private:
+        double mFactor;
+        std::vector<double> mDurations;
+        std::size_t mNext = 0;
+        std::size_t mFramesSinceUpdate = 0;
+        double mPercentile = 0;
+        std::vector<double> mSorted;
+    };
+
+    /// Write the time taken by every profiled subsystem in the frame and the work done that usually causes spikes,
+    /// as far as it is in the stats.
+    /// @param duration time in seconds taken by the frame
+    /// @param percentile time in seconds the frame is compared to
+    /// @param location where the player was
+    void reportSpike(unsigned frameNumber, double duration, double percentile, std::string_view location,
+        const osg::Stats& stats, std::ostream& stream);
+}
+
+#endif
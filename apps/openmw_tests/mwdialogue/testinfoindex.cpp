@@ -0,0 +1,99 @@
+#include "apps/openmw/mwdialogue/infoindex.hpp"
+
+#include <components/esm3/loaddial.hpp>
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+namespace
+{
+    using namespace testing;
+    using namespace MWDialogue;
+
+    struct MWDialogueInfoIndexTest : Test
+    {
+        ESM::Dialogue mDialogue;
+        InfoIndex mIndex;
+
+        ESM::DialInfo& addInfo(std::string_view id)
+        {
+            ESM::DialInfo& info = mDialogue.mInfo.emplace_back();
+            info.mId = ESM::RefId::stringRefId(id);
+            info.mFactionLess = false;
+            return info;
+        }
+
+        std::vector<ESM::RefId> getCandidates(const InfoIndex::Speaker& speaker)
+        {
+            std::vector<ESM::RefId> result;
+            if (const std::vector<const ESM::DialInfo*>* candidates = mIndex.getCandidates(mDialogue, speaker))
+                for (const ESM::DialInfo* info : *candidates)
+                    result.push_back(info->mId);
+            return result;
+        }
+
+        static InfoIndex::Speaker makeNpc()
+        {
+            InfoIndex::Speaker speaker;
+            speaker.mId = ESM::RefId::stringRefId("npc");
+            speaker.mIsNpc = true;
+            speaker.mRace = ESM::RefId::stringRefId("dark elf");
+            speaker.mClass = ESM::RefId::stringRefId("warrior");
+            speaker.mFaction = ESM::RefId::stringRefId("redoran");
+            return speaker;
+        }
+    };
+
+    TEST_F(MWDialogueInfoIndexTest, getCandidatesShouldReturnNullptrForNotAddedDialogue)
+    {
+        EXPECT_EQ(mIndex.getCandidates(mDialogue, makeNpc()), nullptr);
+    }
+
+    TEST_F(MWDialogueInfoIndexTest, getCandidatesShouldReturnInfosMatchingStaticFieldsInTopicOrder)
+    {
+        addInfo("other actor").mActor = ESM::RefId::stringRefId("other");
+        addInfo("any");
+        addInfo("race").mRace = ESM::RefId::stringRefId("dark elf");
+        addInfo("other race").mRace = ESM::RefId::stringRefId("nord");
+        addInfo("actor").mActor = ESM::RefId::stringRefId("npc");
+        addInfo("other class").mClass = ESM::RefId::stringRefId("mage");
+        addInfo("faction").mFaction = ESM::RefId::stringRefId("redoran");
+        addInfo("female").mData.mGender = ESM::DialInfo::Female;
+        addInfo("male").mData.mGender = ESM::DialInfo::Male;
+        addInfo("factionless").mFactionLess = true;
+        mIndex.add(mDialogue);
+
+        EXPECT_THAT(getCandidates(makeNpc()),
+            ElementsAre(ESM::RefId::stringRefId("any"), ESM::RefId::stringRefId("race"),
+                ESM::RefId::stringRefId("actor"), ESM::RefId::stringRefId("faction"), ESM::RefId::stringRefId("male"),
+                ESM::RefId::stringRefId("factionless")));
+    }
+
+    TEST_F(MWDialogueInfoIndexTest, getCandidatesShouldReturnOnlyInfosForIdOfCreature)
+    {
+        addInfo("any");
+        addInfo("actor").mActor = ESM::RefId::stringRefId("creature");
+        mIndex.add(mDialogue);
+
+        InfoIndex::Speaker speaker;
+        speaker.mId = ESM::RefId::stringRefId("creature");
+
+        EXPECT_THAT(getCandidates(speaker), ElementsAre(ESM::RefId::stringRefId("actor")));
+    }
+
+    TEST_F(MWDialogueInfoIndexTest, getCandidatesShouldReturnCandidatesOfGivenSpeakerWhenDifferentIsMemoised)
+    {
+        addInfo("female").mData.mGender = ESM::DialInfo::Female;
+        addInfo("male").mData.mGender = ESM::DialInfo::Male;
+        mIndex.add(mDialogue);
+
+        const InfoIndex::Speaker npc = makeNpc();
+        mIndex.setSpeaker(&npc);
+        EXPECT_THAT(getCandidates(npc), ElementsAre(ESM::RefId::stringRefId("male")));
+
+        InfoIndex::Speaker female = makeNpc();
+        female.mIsFemale = true;
+        EXPECT_THAT(getCandidates(female), ElementsAre(ESM::RefId::stringRefId("female")));
+        EXPECT_THAT(getCandidates(npc), ElementsAre(ESM::RefId::stringRefId("male")));
+    }
+}
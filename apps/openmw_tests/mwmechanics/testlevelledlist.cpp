@@ -0,0 +1,111 @@
+#include <gtest/gtest.h>
+
+#include <components/esm3/loadlevlist.hpp>
+#include <components/esm3/loadmisc.hpp>
+
+#include "apps/openmw/mwmechanics/levelledlist.hpp"
+#include "apps/openmw/mwworld/esmstore.hpp"
+
+#include <string_view>
+#include <vector>
+
+namespace MWMechanics
+{
+    namespace
+    {
+        using namespace testing;
+
+        using Category = LevelledListTable::Category;
+
+        ESM::RefId makeId(std::string_view value)
+        {
+            return ESM::RefId::stringRefId(value);
+        }
+
+        struct MWMechanicsLevelledListTableTest : Test
+        {
+            MWWorld::ESMStore mStore;
+            ESM::ItemLevList mList;
+
+            MWMechanicsLevelledListTableTest()
+            {
+                for (std::string_view id : { "a", "b", "c", "d" })
+                {
+                    ESM::Miscellaneous item;
+                    item.blank();
+                    item.mId = makeId(id);
+                    mStore.insertStatic(item);
+                }
+                mList.blank();
+                mList.mId = makeId("list");
+                mList.mFlags = 0;
+                mList.mChanceNone = 0;
+                mList.mList = { { makeId("c"), 5 }, { makeId("a"), 1 }, { makeId("d"), 5 }, { makeId("b"), 3 } };
+            }
+
+            std::vector<ESM::RefId> getCandidates(const LevelledListTable& table, int level) const
+            {
+                std::vector<ESM::RefId> result;
+                for (const LevelledListTable::Candidate& candidate : table.getCandidates(level))
+                    result.push_back(candidate.mId);
+                return result;
+            }
+        };
+
+        TEST_F(MWMechanicsLevelledListTableTest, shouldPickEntriesOfHighestLevelNotAboveGiven)
+        {
+            const LevelledListTable table(mList, false, mStore);
+            EXPECT_EQ(getCandidates(table, 0), std::vector<ESM::RefId>());
+            EXPECT_EQ(getCandidates(table, 1), std::vector<ESM::RefId>({ makeId("a") }));
+            EXPECT_EQ(getCandidates(table, 4), std::vector<ESM::RefId>({ makeId("b") }));
+            EXPECT_EQ(getCandidates(table, 100), std::vector<ESM::RefId>({ makeId("c"), makeId("d") }));
+        }
+
+        TEST_F(MWMechanicsLevelledListTableTest, shouldPickEntriesOfAllLevelsNotAboveGiven)
+        {
+            mList.mFlags = ESM::ItemLevList::AllLevels;
+            const LevelledListTable table(mList, false, mStore);
+            EXPECT_EQ(getCandidates(table, 0), std::vector<ESM::RefId>());
+            EXPECT_EQ(getCandidates(table, 2), std::vector<ESM::RefId>({ makeId("a") }));
+            EXPECT_EQ(getCandidates(table, 3), std::vector<ESM::RefId>({ makeId("a"), makeId("b") }));
+            EXPECT_EQ(getCandidates(table, 5),
+                std::vector<ESM::RefId>({ makeId("a"), makeId("b"), makeId("c"), makeId("d") }));
+        }
+
+        TEST_F(MWMechanicsLevelledListTableTest, creatureListsShouldUseTheirAllLevelsFlag)
+        {
+            mList.mFlags = ESM::CreatureLevList::AllLevels;
+            const LevelledListTable table(mList, true, mStore);
+            EXPECT_EQ(getCandidates(table, 3), std::vector<ESM::RefId>({ makeId("a"), makeId("b") }));
+            const LevelledListTable itemTable(mList, false, mStore);
+            EXPECT_EQ(getCandidates(itemTable, 3), std::vector<ESM::RefId>({ makeId("b") }));
+        }
+
+        TEST_F(MWMechanicsLevelledListTableTest, shouldResolveCategories)
+        {
+            ESM::ItemLevList nested;
+            nested.blank();
+            nested.mId = makeId("nested");
+            mStore.insertStatic(nested);
+            mList.mList = { { makeId("a"), 1 }, { makeId("nested"), 1 }, { makeId("missing"), 1 } };
+            const LevelledListTable table(mList, false, mStore);
+            std::vector<Category> categories;
+            for (const LevelledListTable::Candidate& candidate : table.getCandidates(1))
+                categories.push_back(candidate.mCategory);
+            EXPECT_EQ(categories, std::vector<Category>({ Category::Object, Category::ItemList, Category::Missing }));
+        }
+
+        TEST_F(MWMechanicsLevelledListTableTest, storeShouldUpdateTableWhenListIsOverridden)
+        {
+            const ESM::ItemLevList* stored = mStore.insertStatic(mList);
+            const auto table = mStore.getLevelledListTable(*stored, false);
+            EXPECT_EQ(mStore.getLevelledListTable(*stored, false), table);
+
+            ESM::ItemLevList changed = mList;
+            changed.mList = { { makeId("d"), 1 } };
+            const ESM::ItemLevList* overridden = mStore.overrideRecord(changed);
+            const auto changedTable = mStore.getLevelledListTable(*overridden, false);
+            EXPECT_EQ(getCandidates(*changedTable, 1), std::vector<ESM::RefId>({ makeId("d") }));
+        }
+    }
+}
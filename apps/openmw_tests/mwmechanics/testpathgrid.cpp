@@ -0,0 +1,68 @@
+#include <gtest/gtest.h>
+
+#include <initializer_list>
+#include <utility>
+
+#include "apps/openmw/mwmechanics/pathgrid.hpp"
+
+namespace MWMechanics
+{
+    namespace
+    {
+        // 0 - 1 - 2 - 3 with a longer detour 0 - 4 - 3, and 5 - 6 not connected to them
+        ESM::Pathgrid makePathgrid()
+        {
+            ESM::Pathgrid pathgrid;
+            pathgrid.mPoints = { ESM::Pathgrid::Point(0, 0, 0), ESM::Pathgrid::Point(100, 0, 0),
+                ESM::Pathgrid::Point(200, 0, 0), ESM::Pathgrid::Point(300, 0, 0), ESM::Pathgrid::Point(150, 1000, 0),
+                ESM::Pathgrid::Point(0, 500, 0), ESM::Pathgrid::Point(100, 500, 0) };
+            const std::initializer_list<std::pair<size_t, size_t>> edges
+                = { { 0, 1 }, { 1, 2 }, { 2, 3 }, { 0, 4 }, { 4, 3 }, { 5, 6 } };
+            for (const auto& [v0, v1] : edges)
+            {
+                pathgrid.mEdges.push_back(ESM::Pathgrid::Edge{ v0, v1 });
+                pathgrid.mEdges.push_back(ESM::Pathgrid::Edge{ v1, v0 });
+            }
+            return pathgrid;
+        }
+
+        std::vector<int> getX(const std::deque<ESM::Pathgrid::Point>& path)
+        {
+            std::vector<int> result;
+            for (const ESM::Pathgrid::Point& point : path)
+                result.push_back(point.mX);
+            return result;
+        }
+
+        TEST(MWMechanicsPathgridGraphTest, aStarSearchShouldFindShortestPath)
+        {
+            const ESM::Pathgrid pathgrid = makePathgrid();
+            const PathgridGraph graph(pathgrid);
+            EXPECT_EQ(getX(graph.aStarSearch(0, 3)), std::vector<int>({ 0, 100, 200, 300 }));
+            EXPECT_EQ(getX(graph.aStarSearch(3, 0)), std::vector<int>({ 300, 200, 100, 0 }));
+        }
+
+        TEST(MWMechanicsPathgridGraphTest, aStarSearchShouldReturnEmptyPathForNotConnectedPoints)
+        {
+            const ESM::Pathgrid pathgrid = makePathgrid();
+            const PathgridGraph graph(pathgrid);
+            EXPECT_FALSE(graph.isPointConnected(0, 5));
+            EXPECT_TRUE(graph.aStarSearch(0, 5).empty());
+            EXPECT_EQ(getX(graph.aStarSearch(5, 6)), std::vector<int>({ 0, 100 }));
+        }
+
+        TEST(MWMechanicsPathgridGraphTest, aStarSearchShouldReturnSamePathWhenCached)
+        {
+            const ESM::Pathgrid pathgrid = makePathgrid();
+            const PathgridGraph graph(pathgrid);
+            const std::vector<int> expected = getX(graph.aStarSearch(4, 2));
+            // Evict the path by searching more distinct paths than the cache holds
+            for (int i = 0; i < 40; ++i)
+            {
+                EXPECT_EQ(getX(graph.aStarSearch(4, 2)), expected);
+                graph.aStarSearch(static_cast<size_t>(i % 4), static_cast<size_t>((i / 4) % 5));
+            }
+            EXPECT_EQ(expected, std::vector<int>({ 150, 300, 200 }));
+        }
+    }
+}
@@ -0,0 +1,66 @@
+#include <gtest/gtest.h>
+
+#include <array>
+
+#include "apps/openmw/mwmechanics/updatescheduler.hpp"
+
+namespace MWMechanics
+{
+    namespace
+    {
+        TEST(MWMechanicsUpdateSchedulerTest, scheduleShouldUpdateBucketZeroEveryFrame)
+        {
+            UpdateScheduler scheduler;
+            UpdateScheduler::Entry entry;
+            for (int i = 0; i < 4; ++i)
+            {
+                scheduler.nextFrame();
+                EXPECT_TRUE(scheduler.schedule(entry, 0, 0.1f));
+                EXPECT_FLOAT_EQ(entry.mDuration, 0.1f);
+            }
+        }
+
+        TEST(MWMechanicsUpdateSchedulerTest, scheduleShouldAccumulateSkippedTime)
+        {
+            UpdateScheduler scheduler;
+            UpdateScheduler::Entry entry;
+            int updates = 0;
+            float total = 0;
+            for (int i = 0; i < 8; ++i)
+            {
+                scheduler.nextFrame();
+                if (scheduler.schedule(entry, 2, 0.25f))
+                {
+                    ++updates;
+                    total += entry.mDuration;
+                }
+            }
+            EXPECT_EQ(updates, 2);
+            EXPECT_FLOAT_EQ(total + entry.mSkippedTime, 2.0f);
+        }
+
+        TEST(MWMechanicsUpdateSchedulerTest, scheduleShouldSpreadBucketOverFrames)
+        {
+            UpdateScheduler scheduler;
+            std::array<UpdateScheduler::Entry, 8> entries;
+            for (int i = 0; i < 4; ++i)
+            {
+                scheduler.nextFrame();
+                int due = 0;
+                for (UpdateScheduler::Entry& entry : entries)
+                    due += scheduler.schedule(entry, 2, 0.1f);
+                EXPECT_EQ(due, 2) << "frame " << i;
+            }
+        }
+
+        TEST(MWMechanicsUpdateSchedulerTest, scheduleShouldBeCalledOncePerFrame)
+        {
+            UpdateScheduler scheduler;
+            UpdateScheduler::Entry entry;
+            scheduler.nextFrame();
+            ASSERT_TRUE(scheduler.schedule(entry, 0, 0.1f));
+            EXPECT_TRUE(scheduler.schedule(entry, 0, 0.1f));
+            EXPECT_FLOAT_EQ(entry.mDuration, 0.1f);
+        }
+    }
+}
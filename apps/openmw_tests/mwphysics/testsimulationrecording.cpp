@@ -0,0 +1,67 @@
+#include <gtest/gtest.h>
+
+#include "apps/openmw/mwphysics/simulationrecording.hpp"
+
+#include <sstream>
+#include <string>
+
+namespace MWPhysics
+{
+    namespace
+    {
+        RecordedFrame makeFrame()
+        {
+            RecordedFrame frame;
+            frame.mDt = 1.0f / 60;
+            frame.mActors.push_back(RecordedActor{ ESM::RefNum{}, true, osg::Vec3f(-1234.5678f, 0.1f, 3e5f),
+                osg::Vec3f(0, 0, 3.14159265f), osg::Vec3f(0, 150.25f, 0) });
+            frame.mActors.push_back(RecordedActor{ ESM::RefNum{ 42, 1 }, false, osg::Vec3f(1, 2, 3),
+                osg::Vec3f(0.5f, 0, -1), osg::Vec3f(1.0f / 3, 0, 0) });
+            return frame;
+        }
+
+        TEST(MWPhysicsSimulationRecordingTest, readShouldReturnWrittenFramesExactly)
+        {
+            const RecordedFrame frame = makeFrame();
+            std::stringstream stream;
+            writeRecordingHeader(stream);
+            writeRecordedFrame(stream, frame);
+            writeRecordedFrame(stream, RecordedFrame{ 0.5f, {} });
+
+            const std::vector<RecordedFrame> result = readRecordedFrames(stream);
+            ASSERT_EQ(result.size(), 2);
+            EXPECT_EQ(result[0].mDt, frame.mDt);
+            ASSERT_EQ(result[0].mActors.size(), frame.mActors.size());
+            for (std::size_t i = 0; i < frame.mActors.size(); ++i)
+            {
+                EXPECT_EQ(result[0].mActors[i].mRefNum, frame.mActors[i].mRefNum);
+                EXPECT_EQ(result[0].mActors[i].mIsPlayer, frame.mActors[i].mIsPlayer);
+                EXPECT_EQ(result[0].mActors[i].mPosition, frame.mActors[i].mPosition);
+                EXPECT_EQ(result[0].mActors[i].mRotation, frame.mActors[i].mRotation);
+                EXPECT_EQ(result[0].mActors[i].mVelocity, frame.mActors[i].mVelocity);
+            }
+            EXPECT_EQ(result[1].mDt, 0.5f);
+            EXPECT_TRUE(result[1].mActors.empty());
+        }
+
+        TEST(MWPhysicsSimulationRecordingTest, readShouldReturnNothingWithoutHeader)
+        {
+            std::stringstream stream;
+            writeRecordedFrame(stream, makeFrame());
+            EXPECT_TRUE(readRecordedFrames(stream).empty());
+        }
+
+        TEST(MWPhysicsSimulationRecordingTest, readShouldSkipTruncatedFrame)
+        {
+            std::stringstream stream;
+            writeRecordingHeader(stream);
+            writeRecordedFrame(stream, makeFrame());
+            writeRecordedFrame(stream, makeFrame());
+            std::string data = stream.str();
+            // Drop the last actor of the last frame
+            data.resize(data.rfind('\n', data.size() - 2) + 1);
+            std::istringstream truncated(data);
+            EXPECT_EQ(readRecordedFrames(truncated).size(), 1);
+        }
+    }
+}
@@ -3,6 +3,8 @@
 #include <array>
 #include <sstream>
 
+#include <components/compiler/scriptanalysis.hpp>
+
 #include "testutils.hpp"
 
 namespace
@@ -507,6 +509,41 @@ set a to 1
 ( GetDisabled == 1 )
 GetDisabled == 1
 
+End)mwscript";
+
+    const std::string sActivationOnly = R"mwscript(Begin activation_only
+
+short done
+
+if ( OnActivate == 1 )
+    set done to 1
+    Activate
+endif
+
+End)mwscript";
+
+    const std::string sActivationWithElse = R"mwscript(Begin activation_with_else
+
+short done
+
+if ( OnActivate )
+    set done to 1
+else
+    set done to 2
+endif
+
+End)mwscript";
+
+    const std::string sActivationAndMore = R"mwscript(Begin activation_and_more
+
+short done
+
+if ( OnActivate )
+    set done to 1
+endif
+
+set done to 2
+
 End)mwscript";
 
     TEST_F(MWScriptTest, mwscript_test_invalid)
@@ -1006,4 +1043,33 @@ End)mwscript";
         registerExtensions();
         EXPECT_FALSE(!compile(sIssue6807));
     }
+
+    TEST_F(MWScriptTest, mwscript_test_activation_only)
+    {
+        registerExtensions();
+        const auto script = compile(sActivationOnly);
+        ASSERT_TRUE(script.has_value());
+        EXPECT_TRUE(Compiler::isActivationOnly(script->mProgram));
+    }
+
+    TEST_F(MWScriptTest, mwscript_test_activation_with_else_is_not_activation_only)
+    {
+        registerExtensions();
+        const auto script = compile(sActivationWithElse);
+        ASSERT_TRUE(script.has_value());
+        EXPECT_FALSE(Compiler::isActivationOnly(script->mProgram));
+    }
+
+    TEST_F(MWScriptTest, mwscript_test_activation_and_more_is_not_activation_only)
+    {
+        registerExtensions();
+        const auto script = compile(sActivationAndMore);
+        ASSERT_TRUE(script.has_value());
+        EXPECT_FALSE(Compiler::isActivationOnly(script->mProgram));
+    }
+
+    TEST_F(MWScriptTest, mwscript_test_basic_logic_is_not_activation_only)
+    {
+        EXPECT_FALSE(Compiler::isActivationOnly(compile(sScript1)->mProgram));
+    }
 }
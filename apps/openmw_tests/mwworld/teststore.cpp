@@ -868,4 +868,137 @@ namespace
         ASSERT_NE(dialogue, nullptr);
         EXPECT_THAT(dialogue->mInfo, ElementsAre(HasIdEqualTo("info0"), HasIdEqualTo("info2")));
     }
+
+    std::unique_ptr<std::stringstream> saveStatics(std::span<const std::string_view> ids)
+    {
+        auto stream = std::make_unique<std::stringstream>();
+
+        ESM::ESMWriter writer;
+        writer.setFormatVersion(ESM::CurrentSaveGameFormatVersion);
+        writer.save(*stream);
+
+        for (const std::string_view id : ids)
+        {
+            ESM::Static record;
+            record.blank();
+            record.mId = ESM::RefId::stringRefId(id);
+            writer.startRecord(ESM::REC_STAT);
+            record.save(writer);
+            writer.endRecord(ESM::REC_STAT);
+        }
+
+        return stream;
+    }
+
+    std::unique_ptr<std::stringstream> saveContentCache(const MWWorld::ESMStore& esmStore)
+    {
+        auto stream = std::make_unique<std::stringstream>();
+
+        ESM::ESMWriter writer;
+        writer.setFormatVersion(ESM::CurrentSaveGameFormatVersion);
+        writer.save(*stream);
+        esmStore.writeContentCache(writer);
+
+        return stream;
+    }
+
+    TEST(MWWorldStoreTest, readContentCacheShouldRestoreRecordsInLoadOrder)
+    {
+        MWWorld::ESMStore esmStore;
+        loadEsmStore(0, saveStatics(std::array<std::string_view, 3>{ "c", "a", "b" }), esmStore);
+        loadEsmStore(1, saveStatics(std::array<std::string_view, 2>{ "d", "a" }), esmStore);
+
+        MWWorld::ESMStore restored;
+        ESM::ESMReader reader;
+        reader.open(saveContentCache(esmStore), "cache");
+        restored.readContentCache(reader);
+
+        std::vector<ESM::RefId> expected;
+        esmStore.get<ESM::Static>().listIdentifier(expected);
+        std::vector<ESM::RefId> actual;
+        restored.get<ESM::Static>().listIdentifier(actual);
+        EXPECT_EQ(actual, expected);
+    }
+
+    TEST(MWWorldStoreTest, loadShouldSkipRecordsRestoredFromContentCache)
+    {
+        const DialogueData data = generateDialogueWithInfos(2);
+
+        MWWorld::ESMStore esmStore;
+        loadEsmStore(0, saveStatics(std::array<std::string_view, 1>{ "a" }), esmStore);
+
+        MWWorld::ESMStore restored;
+        ESM::ESMReader reader;
+        reader.open(saveContentCache(esmStore), "cache");
+        restored.readContentCache(reader);
+
+        loadEsmStore(0, saveStatics(std::array<std::string_view, 2>{ "a", "b" }), restored);
+        loadEsmStore(1, saveDialogueWithInfos(data.mDialogue, data.mInfos), restored);
+        restored.setUp();
+
+        EXPECT_EQ(restored.get<ESM::Static>().getSize(), 1);
+        const ESM::Dialogue* dialogue = restored.get<ESM::Dialogue>().search(ESM::RefId::stringRefId("dialogue"));
+        ASSERT_NE(dialogue, nullptr);
+        EXPECT_THAT(dialogue->mInfo, ElementsAre(HasIdEqualTo("info0"), HasIdEqualTo("info1")));
+    }
+
+    TEST(MWWorldStoreTest, makeFlatShouldPreserveRecordsAndOrder)
+    {
+        MWWorld::ESMStore esmStore;
+        loadEsmStore(0, saveStatics(std::array<std::string_view, 3>{ "c", "a", "b" }), esmStore);
+        esmStore.setUp();
+
+        std::vector<ESM::RefId> expected;
+        esmStore.get<ESM::Static>().listIdentifier(expected);
+
+        esmStore.makeFlat();
+
+        const MWWorld::Store<ESM::Static>& statics = esmStore.get<ESM::Static>();
+        EXPECT_TRUE(statics.isFlat());
+        std::vector<ESM::RefId> actual;
+        statics.listIdentifier(actual);
+        EXPECT_EQ(actual, expected);
+        for (const ESM::RefId& id : expected)
+        {
+            const ESM::Static* record = statics.search(id);
+            ASSERT_NE(record, nullptr);
+            EXPECT_EQ(record->mId, id);
+        }
+        EXPECT_EQ(statics.search(ESM::RefId::stringRefId("d")), nullptr);
+    }
+
+    TEST(MWWorldStoreTest, searchHandleShouldReturnIndexOfStaticAndDynamicRecordsInFlatStore)
+    {
+        MWWorld::ESMStore esmStore;
+        loadEsmStore(0, saveStatics(std::array<std::string_view, 2>{ "a", "b" }), esmStore);
+        esmStore.setUp();
+        esmStore.makeFlat();
+
+        ESM::Static record;
+        record.blank();
+        record.mId = ESM::RefId::stringRefId("c");
+        esmStore.insert(record);
+
+        const MWWorld::Store<ESM::Static>& statics = esmStore.get<ESM::Static>();
+        for (std::string_view id : { "a", "b", "c" })
+        {
+            const auto handle = statics.searchHandle(ESM::RefId::stringRefId(id));
+            ASSERT_NE(handle, MWWorld::Store<ESM::Static>::sInvalidHandle) << id;
+            EXPECT_EQ(statics.at(handle)->mId, ESM::RefId::stringRefId(id));
+        }
+        EXPECT_EQ(statics.searchHandle(ESM::RefId::stringRefId("d")), MWWorld::Store<ESM::Static>::sInvalidHandle);
+    }
+
+    TEST(MWWorldStoreTest, insertStaticShouldThrowForFlatStore)
+    {
+        MWWorld::ESMStore esmStore;
+        loadEsmStore(0, saveStatics(std::array<std::string_view, 1>{ "a" }), esmStore);
+        esmStore.setUp();
+        esmStore.makeFlat();
+
+        ESM::Static record;
+        record.blank();
+        record.mId = ESM::RefId::stringRefId("b");
+        EXPECT_THROW(esmStore.insertStatic(record), std::logic_error);
+    }
 }
@@ -0,0 +1,55 @@
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+
+#include <osg/Stats>
+
+#include <sstream>
+
+#include "apps/openmw/benchmark.hpp"
+#include "apps/openmw/profile.hpp"
+
+namespace OMW
+{
+    namespace
+    {
+        using namespace testing;
+
+        TEST(OMWBenchmarkTest, isDoneShouldReturnTrueAfterAddingAllFrames)
+        {
+            Benchmark benchmark(2);
+            osg::Stats stats("test");
+            EXPECT_FALSE(benchmark.isDone());
+            benchmark.addFrame(0, 0.01, stats);
+            EXPECT_FALSE(benchmark.isDone());
+            benchmark.addFrame(1, 0.01, stats);
+            EXPECT_TRUE(benchmark.isDone());
+            benchmark.addFrame(2, 0.01, stats);
+            EXPECT_EQ(benchmark.getFrames(), 2u);
+        }
+
+        TEST(OMWBenchmarkTest, reportShouldContainStatsOfFrames)
+        {
+            Benchmark benchmark(2);
+            osg::Stats stats("test");
+            const UserStats& physics = UserStatsValue<UserStatsType::Physics>::sValue;
+            stats.setAttribute(0, physics.mTaken, 0.002);
+            stats.setAttribute(1, physics.mTaken, 0.004);
+            benchmark.addFrame(0, 0.01, stats);
+            benchmark.addFrame(1, 0.02, stats);
+            std::ostringstream report;
+            benchmark.report(report);
+            EXPECT_THAT(report.str(), HasSubstr("Frame            15.000     10.000     10.000     20.000        2\n"));
+            EXPECT_THAT(report.str(), HasSubstr("Phys              3.000      2.000      2.000      4.000        2\n"));
+        }
+
+        TEST(OMWBenchmarkTest, reportShouldSkipStatsWithoutValues)
+        {
+            Benchmark benchmark(1);
+            osg::Stats stats("test");
+            benchmark.addFrame(0, 0.01, stats);
+            std::ostringstream report;
+            benchmark.report(report);
+            EXPECT_THAT(report.str(), Not(HasSubstr("Phys")));
+        }
+    }
+}
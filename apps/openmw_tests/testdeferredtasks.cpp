@@ -0,0 +1,69 @@
+#include <gtest/gtest.h>
+
+#include <osg/Stats>
+
+#include <chrono>
+#include <thread>
+#include <vector>
+
+#include "apps/openmw/deferredtasks.hpp"
+
+namespace OMW
+{
+    namespace
+    {
+        using namespace std::chrono_literals;
+
+        TEST(OMWDeferredTasksTest, runShouldCallTasksInPriorityOrder)
+        {
+            DeferredTasks tasks;
+            std::vector<int> calls;
+            tasks.add("B", 1, [&] { calls.push_back(1); });
+            tasks.add("A", 0, [&] { calls.push_back(0); });
+            tasks.add("C", 2, [&] { calls.push_back(2); });
+            osg::Stats stats("test");
+            tasks.run(0, 0, stats);
+            EXPECT_EQ(calls, (std::vector<int>{ 0, 1, 2 }));
+            EXPECT_EQ(tasks.getLastSkipped(), 0u);
+        }
+
+        TEST(OMWDeferredTasksTest, runShouldCallDelayedTasksFirstInNextFrame)
+        {
+            DeferredTasks tasks;
+            std::vector<int> calls;
+            tasks.add("Slow", 0, [&] {
+                calls.push_back(0);
+                std::this_thread::sleep_for(2ms);
+            });
+            tasks.add("Other", 1, [&] { calls.push_back(1); });
+            osg::Stats stats("test");
+            tasks.run(1e-3, 0, stats);
+            EXPECT_EQ(calls, (std::vector<int>{ 0 }));
+            EXPECT_EQ(tasks.getLastSkipped(), 1u);
+            calls.clear();
+            tasks.run(1, 1, stats);
+            EXPECT_EQ(calls, (std::vector<int>{ 1, 0 }));
+            EXPECT_EQ(tasks.getLastSkipped(), 0u);
+        }
+
+        TEST(OMWDeferredTasksTest, runShouldNotDelayTaskForMoreThanMaxDelayedFrames)
+        {
+            DeferredTasks tasks;
+            int slow = 0;
+            int other = 0;
+            tasks.add("Slow", 0, [&] {
+                ++slow;
+                std::this_thread::sleep_for(2ms);
+            });
+            tasks.add("Other", 1, [&] {
+                ++other;
+                std::this_thread::sleep_for(2ms);
+            });
+            osg::Stats stats("test");
+            for (unsigned i = 0; i < 4 * DeferredTasks::maxDelayedFrames; ++i)
+                tasks.run(1e-3, i, stats);
+            EXPECT_GT(slow, 0);
+            EXPECT_GT(other, 0);
+        }
+    }
+}
@@ -0,0 +1,76 @@
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <osg/Stats>
+
+#include <sstream>
+
+#include "apps/openmw/profile.hpp"
+#include "apps/openmw/spikedetector.hpp"
+
+namespace OMW
+{
+    namespace
+    {
+        using namespace testing;
+
+        void addFrames(SpikeDetector& detector, std::size_t count, double duration)
+        {
+            for (std::size_t i = 0; i < count; ++i)
+                ASSERT_EQ(detector.addFrame(duration), std::nullopt);
+        }
+
+        TEST(OMWSpikeDetectorTest, addFrameShouldNotDetectSpikesBeforeMinFrames)
+        {
+            SpikeDetector detector(2);
+            addFrames(detector, SpikeDetector::sMinFrames - 1, 0.01);
+            EXPECT_EQ(detector.addFrame(1), std::nullopt);
+        }
+
+        TEST(OMWSpikeDetectorTest, addFrameShouldDetectFrameLongerThanPercentileTimesFactor)
+        {
+            SpikeDetector detector(2);
+            addFrames(detector, SpikeDetector::sMinFrames, 0.01);
+            EXPECT_EQ(detector.addFrame(0.015), std::nullopt);
+            EXPECT_EQ(detector.addFrame(0.03), 0.01);
+        }
+
+        TEST(OMWSpikeDetectorTest, addFrameShouldIgnoreFramesBeyondPercentile)
+        {
+            SpikeDetector detector(2);
+            addFrames(detector, SpikeDetector::sWindowSize - 5, 0.01);
+            for (int i = 0; i < 5; ++i)
+                detector.addFrame(1);
+            addFrames(detector, SpikeDetector::sUpdateInterval, 0.01);
+            EXPECT_EQ(detector.addFrame(0.03), 0.01);
+        }
+
+        TEST(OMWSpikeDetectorTest, addFrameShouldForgetFramesOutsideWindow)
+        {
+            SpikeDetector detector(2);
+            addFrames(detector, SpikeDetector::sWindowSize, 0.1);
+            addFrames(detector, SpikeDetector::sWindowSize + SpikeDetector::sUpdateInterval, 0.01);
+            EXPECT_EQ(detector.addFrame(0.03), 0.01);
+        }
+
+        TEST(OMWSpikeDetectorTest, reportSpikeShouldWriteSubsystemsAndWorkOfFrame)
+        {
+            osg::Stats stats("test");
+            stats.setAttribute(0, "Scene Loaded Cells", 3);
+            stats.setAttribute(1, "Scene Loaded Cells", 5);
+            stats.setAttribute(1, "Lua Deferred", 2);
+            stats.setAttribute(0, "Node Get", 10);
+            stats.setAttribute(1, "Node Get", 14);
+            stats.setAttribute(0, "Node Hit", 10);
+            stats.setAttribute(1, "Node Hit", 11);
+            stats.setAttribute(1, UserStatsValue<UserStatsType::Physics>::sValue.mTaken, 0.05);
+            std::ostringstream stream;
+            reportSpike(1, 0.06, 0.02, "Ebonheart (1, 2, 3)", stats, stream);
+            EXPECT_EQ(stream.str(),
+                "Frame 1 took 60.000 ms, 3.0 times the 99th percentile of 20.000 ms, at Ebonheart (1, 2, 3)\n"
+                "  Subsystems: Phys 50.000 ms\n"
+                "  Work: cells loaded 2 Lua scripts over budget 2\n"
+                "  Resource cache misses: Node 3");
+        }
+    }
+}
@@ -6,12 +6,14 @@
 #include <filesystem>
 #include <format>
 #include <istream>
+#include <span>
 
 #include <zlib.h>
 
 #include <components/esm/fourcc.hpp>
 #include <components/files/constrainedfilestream.hpp>
 #include <components/files/conversion.hpp>
+#include <components/files/mappedfile.hpp>
 #include <components/files/utils.hpp>
 #include <components/misc/strings/lower.hpp>
 
@@ -629,7 +631,7 @@ namespace Bsa
 
         auto memoryStreamPtr = std::make_unique<MemoryInputStream>(textureSize);
         char* buff = memoryStreamPtr->getRawData();
-        std::vector<char> inputBuffer(maxPackedChunkSize);
+        std::vector<char> inputBuffer(mMappedFile == nullptr ? maxPackedChunkSize : 0);
 
         uint32_t dds = ESM::fourCC("DDS ");
         buff = (char*)std::memcpy(buff, &dds, sizeof(uint32_t)) + sizeof(uint32_t);
@@ -640,21 +642,33 @@ namespace Bsa
         for (const auto& c : fileRecord.texturesChunks)
         {
             const uint32_t inputSize = c.packedSize != 0 ? c.packedSize : c.size;
-            Files::IStreamPtr streamPtr = Files::openConstrainedFileStream(mFilepath, c.offset, inputSize);
+            std::span<const char> input;
+            if (mMappedFile != nullptr)
+                input = mMappedFile->get(c.offset, inputSize);
             if (c.packedSize != 0)
             {
-                streamPtr->read(inputBuffer.data(), c.packedSize);
+                if (mMappedFile == nullptr)
+                {
+                    Files::openConstrainedFileStream(mFilepath, c.offset, inputSize)
+                        ->read(inputBuffer.data(), c.packedSize);
+                    input = std::span<const char>(inputBuffer.data(), c.packedSize);
+                }
                 uLongf destSize = static_cast<uLongf>(c.size);
                 int ec = ::uncompress(reinterpret_cast<Bytef*>(memoryStreamPtr->getRawData() + offset), &destSize,
-                    reinterpret_cast<Bytef*>(inputBuffer.data()), static_cast<uLong>(c.packedSize));
+                    reinterpret_cast<const Bytef*>(input.data()), static_cast<uLong>(input.size()));
 
                 if (ec != Z_OK)
                     fail("zlib uncompress failed: " + std::string(::zError(ec)));
             }
             // uncompressed chunk
+            else if (mMappedFile != nullptr)
+            {
+                std::memcpy(memoryStreamPtr->getRawData() + offset, input.data(), c.size);
+            }
             else
             {
-                streamPtr->read(memoryStreamPtr->getRawData() + offset, c.size);
+                Files::openConstrainedFileStream(mFilepath, c.offset, inputSize)
+                    ->read(memoryStreamPtr->getRawData() + offset, c.size);
             }
             offset += c.size;
         }
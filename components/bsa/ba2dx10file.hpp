@@ -52,6 +52,7 @@ namespace Bsa
         using BSAFile::getList;
         using BSAFile::getPath;
         using BSAFile::open;
+        using BSAFile::setMemoryMapped;
 
         BA2DX10File();
         virtual ~BA2DX10File();
@@ -5,12 +5,14 @@
 #include <filesystem>
 #include <format>
 #include <fstream>
+#include <span>
 
 #include <zlib.h>
 
 #include <components/esm/fourcc.hpp>
 #include <components/files/constrainedfilestream.hpp>
 #include <components/files/conversion.hpp>
+#include <components/files/mappedfile.hpp>
 #include <components/files/utils.hpp>
 #include <components/misc/strings/lower.hpp>
 
@@ -196,22 +198,33 @@ namespace Bsa
     Files::IStreamPtr BA2GNRLFile::getFile(const FileRecord& fileRecord)
     {
         const uint32_t inputSize = fileRecord.packedSize ? fileRecord.packedSize : fileRecord.size;
-        Files::IStreamPtr streamPtr = Files::openConstrainedFileStream(mFilepath, fileRecord.offset, inputSize);
+        if (mMappedFile != nullptr && fileRecord.packedSize == 0)
+            return Files::openMappedFileStream(mMappedFile, fileRecord.offset, inputSize);
         auto memoryStreamPtr = std::make_unique<MemoryInputStream>(fileRecord.size);
         if (fileRecord.packedSize)
         {
-            std::vector<char> buffer(inputSize);
-            streamPtr->read(buffer.data(), inputSize);
+            std::vector<char> buffer;
+            std::span<const char> input;
+            if (mMappedFile != nullptr)
+                input = mMappedFile->get(fileRecord.offset, inputSize);
+            else
+            {
+                buffer.resize(inputSize);
+                Files::openConstrainedFileStream(mFilepath, fileRecord.offset, inputSize)
+                    ->read(buffer.data(), inputSize);
+                input = buffer;
+            }
             uLongf destSize = static_cast<uLongf>(fileRecord.size);
             int ec = ::uncompress(reinterpret_cast<Bytef*>(memoryStreamPtr->getRawData()), &destSize,
-                reinterpret_cast<Bytef*>(buffer.data()), static_cast<uLong>(buffer.size()));
+                reinterpret_cast<const Bytef*>(input.data()), static_cast<uLong>(input.size()));
 
             if (ec != Z_OK)
                 fail("zlib uncompress failed: " + std::string(::zError(ec)));
         }
         else
         {
-            streamPtr->read(memoryStreamPtr->getRawData(), fileRecord.size);
+            Files::openConstrainedFileStream(mFilepath, fileRecord.offset, inputSize)
+                ->read(memoryStreamPtr->getRawData(), fileRecord.size);
         }
         return std::make_unique<Files::StreamWithBuffer<MemoryInputStream>>(std::move(memoryStreamPtr));
     }
@@ -34,7 +34,9 @@
 #include <system_error>
 
 #include <components/esm/fourcc.hpp>
+#include <components/debug/debuglog.hpp>
 #include <components/files/constrainedfilestream.hpp>
+#include <components/files/mappedfile.hpp>
 #include <components/files/utils.hpp>
 
 using namespace Bsa;
@@ -268,6 +270,19 @@ void BSAFile::open(const std::filesystem::path& file)
         std::ifstream input(mFilepath, std::ios_base::binary);
         readHeader(input);
         mIsLoaded = true;
+
+        if (mMemoryMapped)
+        {
+            try
+            {
+                mMappedFile = std::make_shared<Files::MappedFile>(mFilepath);
+            }
+            catch (const std::exception& e)
+            {
+                Log(Debug::Warning) << "Failed to memory map archive " << mFilepath
+                                    << ", falling back to file streams: " << e.what();
+            }
+        }
     }
     else
     {
@@ -287,12 +302,21 @@ void Bsa::BSAFile::close()
 
     mFiles.clear();
     mStringBuf.clear();
+    mReservedDataOffset = 0;
+    mMappedFile = nullptr;
     mIsLoaded = false;
 }
 
+Files::IStreamPtr Bsa::BSAFile::openRegion(std::size_t offset, std::size_t size) const
+{
+    if (mMappedFile != nullptr)
+        return Files::openMappedFileStream(mMappedFile, offset, size);
+    return Files::openConstrainedFileStream(mFilepath, offset, size);
+}
+
 Files::IStreamPtr Bsa::BSAFile::getFile(const FileStruct* file)
 {
-    return Files::openConstrainedFileStream(mFilepath, file->mOffset, file->mFileSize);
+    return openRegion(file->mOffset, file->mFileSize);
 }
 
 void Bsa::BSAFile::addFile(const std::string& filename, std::istream& file)
@@ -300,7 +324,11 @@ void Bsa::BSAFile::addFile(const std::string& filename, std::istream& file)
     if (!mIsLoaded)
         fail("Unable to add file " + filename + " the archive is not opened");
 
-    auto newStartOfDataBuffer = 12 + (12 + 8) * (mFiles.size() + 1) + mStringBuf.size() + filename.size() + 1;
+    // The archive is going to be resized and rewritten so the mapping would become invalid
+    mMappedFile = nullptr;
+
+    const auto newStartOfDataBuffer = std::max(mReservedDataOffset,
+        12 + (12 + 8) * (mFiles.size() + 1) + mStringBuf.size() + filename.size() + 1);
     if (mFiles.empty())
         std::filesystem::resize_file(mFilepath, newStartOfDataBuffer);
 
@@ -352,6 +380,15 @@ void Bsa::BSAFile::addFile(const std::string& filename, std::istream& file)
     stream << file.rdbuf();
 }
 
+void Bsa::BSAFile::reserveDirectory(std::size_t fileCount, std::size_t namesSize)
+{
+    if (!mFiles.empty())
+        fail("Unable to reserve the directory for an archive with files");
+
+    // Offsets, sizes and name offsets, names with null terminators and hashes
+    mReservedDataOffset = 12 + (12 + 8) * fileCount + namesSize + fileCount;
+}
+
 BsaVersion Bsa::BSAFile::detectVersion(const std::filesystem::path& filePath)
 {
     std::ifstream input(filePath, std::ios_base::binary);
@@ -27,12 +27,18 @@
 #include <cstdint>
 #include <filesystem>
 #include <iosfwd>
+#include <memory>
 #include <string>
 #include <vector>
 
 #include <components/files/conversion.hpp>
 #include <components/files/istreamptr.hpp>
 
+namespace Files
+{
+    class MappedFile;
+}
+
 namespace Bsa
 {
 
@@ -92,6 +98,18 @@ namespace Bsa
         /// Used for error messages
         std::filesystem::path mFilepath;
 
+        /// Map the archive into memory on open
+        bool mMemoryMapped = false;
+
+        /// Where the data of the first added file starts, 0 if only as much as needed is left for the directory
+        std::size_t mReservedDataOffset = 0;
+
+        /// Memory mapping of the whole archive, nullptr if the archive is read with file streams
+        std::shared_ptr<const Files::MappedFile> mMappedFile;
+
+        /// Open a stream for a region of the archive file, reads directly from the mapping when available.
+        Files::IStreamPtr openRegion(std::size_t offset, std::size_t size) const;
+
         /// Error handling
         [[noreturn]] void fail(const std::string& msg) const;
 
@@ -110,6 +128,10 @@ namespace Bsa
             close();
         }
 
+        /// Read files directly from a memory mapping of the archive instead of file streams.
+        /// @note Takes effect on the next open().
+        void setMemoryMapped(bool value) { mMemoryMapped = value; }
+
         /// Open an archive file.
         void open(const std::filesystem::path& file);
 
@@ -127,6 +149,11 @@ namespace Bsa
 
         void addFile(const std::string& filename, std::istream& file);
 
+        /// Leave room for the directory of the files added next to an empty archive, so addFile appends their data
+        /// in the order they are added without moving the data of the files added before.
+        /// @param namesSize total size of the file names not counting the null terminators
+        void reserveDirectory(std::size_t fileCount, std::size_t namesSize);
+
         /// Get a list of all files
         /// @note Thread safe.
         const FileList& getList() const
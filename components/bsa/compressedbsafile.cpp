@@ -27,6 +27,7 @@
 #include <algorithm>
 #include <cassert>
 #include <cerrno>
+#include <cstring>
 #include <filesystem>
 #include <format>
 #include <istream>
@@ -37,6 +38,7 @@
 
 #include <components/files/constrainedfilestream.hpp>
 #include <components/files/conversion.hpp>
+#include <components/files/mappedfile.hpp>
 #include <components/files/utils.hpp>
 #include <components/misc/strings/lower.hpp>
 
@@ -275,9 +277,33 @@ namespace Bsa
     Files::IStreamPtr CompressedBSAFile::getFile(const FileRecord& fileRecord)
     {
         size_t size = fileRecord.mSize & (~FileSizeFlag_Compression);
+        const bool compressed = (fileRecord.mSize != size) == ((mHeader.mFlags & ArchiveFlag_Compress) == 0);
+
+        if (mMappedFile != nullptr)
+        {
+            std::span<const char> data = mMappedFile->get(fileRecord.mOffset, size);
+            if ((mHeader.mFlags & ArchiveFlag_EmbeddedNames) != 0)
+            {
+                // Skip over the embedded file name
+                const std::size_t length = data.empty() ? 0 : static_cast<std::uint8_t>(data.front());
+                data = data.subspan(std::min(data.size(), length + sizeof(uint8_t)));
+            }
+            if (!compressed)
+                return Files::openMappedFileStream(
+                    mMappedFile, fileRecord.mOffset + (size - data.size()), data.size());
+            if (data.size() < sizeof(uint32_t))
+                fail("Truncated compressed file record: "
+                    + std::string(fileRecord.mName.begin(), fileRecord.mName.end()));
+            uint32_t resultSize = 0;
+            std::memcpy(&resultSize, data.data(), sizeof(uint32_t));
+            data = data.subspan(sizeof(uint32_t));
+            auto memoryStreamPtr = std::make_unique<MemoryInputStream>(resultSize);
+            decompress(fileRecord, data, memoryStreamPtr->getRawData(), resultSize);
+            return std::make_unique<Files::StreamWithBuffer<MemoryInputStream>>(std::move(memoryStreamPtr));
+        }
+
         size_t resultSize = size;
         Files::IStreamPtr streamPtr = Files::openConstrainedFileStream(mFilepath, fileRecord.mOffset, size);
-        bool compressed = (fileRecord.mSize != size) == ((mHeader.mFlags & ArchiveFlag_Compress) == 0);
         if ((mHeader.mFlags & ArchiveFlag_EmbeddedNames) != 0)
         {
             // Skip over the embedded file name
@@ -288,7 +314,9 @@ namespace Bsa
         }
         if (compressed)
         {
-            streamPtr->read(reinterpret_cast<char*>(&resultSize), sizeof(uint32_t));
+            uint32_t uncompressedSize = 0;
+            streamPtr->read(reinterpret_cast<char*>(&uncompressedSize), sizeof(uint32_t));
+            resultSize = uncompressedSize;
             size -= sizeof(uint32_t);
         }
         auto memoryStreamPtr = std::make_unique<MemoryInputStream>(resultSize);
@@ -297,44 +325,50 @@ namespace Bsa
         {
             std::vector<char> buffer(size);
             streamPtr->read(buffer.data(), size);
+            decompress(fileRecord, buffer, memoryStreamPtr->getRawData(), resultSize);
+        }
+        else
+        {
+            streamPtr->read(memoryStreamPtr->getRawData(), size);
+        }
 
-            if (mHeader.mVersion != Version_SSE)
-            {
-                uLongf destSize = static_cast<uLongf>(resultSize);
-                int ec = ::uncompress(reinterpret_cast<Bytef*>(memoryStreamPtr->getRawData()), &destSize,
-                    reinterpret_cast<Bytef*>(buffer.data()), static_cast<uLong>(buffer.size()));
+        return std::make_unique<Files::StreamWithBuffer<MemoryInputStream>>(std::move(memoryStreamPtr));
+    }
 
-                if (ec != Z_OK)
-                {
-                    std::string message = "zlib uncompress failed for file ";
-                    message.append(fileRecord.mName.begin(), fileRecord.mName.end());
-                    message += ": ";
-                    message += ::zError(ec);
-                    fail(message);
-                }
-            }
-            else
+    void CompressedBSAFile::decompress(
+        const FileRecord& fileRecord, std::span<const char> input, char* output, std::size_t outputSize) const
+    {
+        if (mHeader.mVersion != Version_SSE)
+        {
+            uLongf destSize = static_cast<uLongf>(outputSize);
+            int ec = ::uncompress(reinterpret_cast<Bytef*>(output), &destSize,
+                reinterpret_cast<const Bytef*>(input.data()), static_cast<uLong>(input.size()));
+
+            if (ec != Z_OK)
             {
-                LZ4F_decompressionContext_t context = nullptr;
-                LZ4F_createDecompressionContext(&context, LZ4F_VERSION);
-                LZ4F_decompressOptions_t options = {};
-                LZ4F_errorCode_t errorCode = LZ4F_decompress(
-                    context, memoryStreamPtr->getRawData(), &resultSize, buffer.data(), &size, &options);
-                if (LZ4F_isError(errorCode))
-                    fail("LZ4 decompression error (file " + Files::pathToUnicodeString(mFilepath)
-                        + "): " + LZ4F_getErrorName(errorCode));
-                errorCode = LZ4F_freeDecompressionContext(context);
-                if (LZ4F_isError(errorCode))
-                    fail("LZ4 decompression error (file " + Files::pathToUnicodeString(mFilepath)
-                        + "): " + LZ4F_getErrorName(errorCode));
+                std::string message = "zlib uncompress failed for file ";
+                message.append(fileRecord.mName.begin(), fileRecord.mName.end());
+                message += ": ";
+                message += ::zError(ec);
+                fail(message);
             }
         }
         else
         {
-            streamPtr->read(memoryStreamPtr->getRawData(), size);
+            std::size_t inputSize = input.size();
+            LZ4F_decompressionContext_t context = nullptr;
+            LZ4F_createDecompressionContext(&context, LZ4F_VERSION);
+            LZ4F_decompressOptions_t options = {};
+            LZ4F_errorCode_t errorCode
+                = LZ4F_decompress(context, output, &outputSize, input.data(), &inputSize, &options);
+            if (LZ4F_isError(errorCode))
+                fail("LZ4 decompression error (file " + Files::pathToUnicodeString(mFilepath)
+                    + "): " + LZ4F_getErrorName(errorCode));
+            errorCode = LZ4F_freeDecompressionContext(context);
+            if (LZ4F_isError(errorCode))
+                fail("LZ4 decompression error (file " + Files::pathToUnicodeString(mFilepath)
+                    + "): " + LZ4F_getErrorName(errorCode));
         }
-
-        return std::make_unique<Files::StreamWithBuffer<MemoryInputStream>>(std::move(memoryStreamPtr));
     }
 
     std::uint64_t CompressedBSAFile::generateHash(const std::filesystem::path& stem, std::string extension)
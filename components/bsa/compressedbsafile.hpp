@@ -29,6 +29,7 @@
 #include <filesystem>
 #include <limits>
 #include <map>
+#include <span>
 
 #include "bsafile.hpp"
 
@@ -115,11 +116,15 @@ namespace Bsa
         static std::uint64_t generateHash(const std::filesystem::path& stem, std::string extension);
         Files::IStreamPtr getFile(const FileRecord& fileRecord);
 
+        void decompress(
+            const FileRecord& fileRecord, std::span<const char> input, char* output, std::size_t outputSize) const;
+
     public:
         using BSAFile::getFilename;
         using BSAFile::getList;
         using BSAFile::getPath;
         using BSAFile::open;
+        using BSAFile::setMemoryMapped;
 
         CompressedBSAFile() = default;
         virtual ~CompressedBSAFile() = default;
@@ -326,6 +326,7 @@ namespace Compiler
             extensions.registerInstruction("togglerecastmesh", "", opcodeToggleRecastMesh);
             extensions.registerInstruction("help", "", opcodeHelp);
             extensions.registerInstruction("reloadlua", "", opcodeReloadLua);
+            extensions.registerInstruction("dumpluaprofile", "", opcodeDumpLuaProfile);
             extensions.registerInstruction("testmodels", "", opcodeTestModels);
             extensions.registerInstruction("t3d", "", opcodeTestModels);
         }
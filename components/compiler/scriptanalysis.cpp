@@ -0,0 +1,51 @@
+#include "scriptanalysis.hpp"
+
+#include <components/interpreter/program.hpp>
+
+#include "generator.hpp"
+#include "opcodes.hpp"
+
+namespace Compiler
+{
+    namespace
+    {
+        // Codes as emitted by the generator
+        constexpr unsigned opcodePushInt = 0;
+        constexpr unsigned opcodeJumpForward = 1;
+        constexpr unsigned opcodeFetchIntLiteral = 4;
+        constexpr unsigned opcodeSkipOnNonZero = 25;
+        constexpr unsigned opcodeEqualInt = 26;
+
+        bool isSegment0(Interpreter::Type_Code code, unsigned opcode)
+        {
+            return (code >> 30) == 0 && (code >> 24) == opcode;
+        }
+    }
+
+    bool isActivationOnly(const Interpreter::Program& program)
+    {
+        const auto& code = program.mInstructions;
+        std::size_t i = 0;
+
+        if (code.empty() || code[i++] != Generator::segment5(Misc::opcodeOnActivate))
+            return false;
+
+        // OnActivate == 1
+        if (i + 2 < code.size() && isSegment0(code[i], opcodePushInt)
+            && code[i + 1] == Generator::segment5(opcodeFetchIntLiteral)
+            && code[i + 2] == Generator::segment5(opcodeEqualInt))
+        {
+            const std::size_t literal = code[i] & 0xffffff;
+            if (literal >= program.mIntegers.size() || program.mIntegers[literal] != 1)
+                return false;
+            i += 3;
+        }
+
+        // The condition skips to the end of the script when it is false
+        if (i + 1 >= code.size() || code[i] != Generator::segment5(opcodeSkipOnNonZero)
+            || !isSegment0(code[i + 1], opcodeJumpForward))
+            return false;
+        const std::size_t offset = code[i + 1] & 0xffffff;
+        return i + 1 + offset == code.size();
+    }
+}
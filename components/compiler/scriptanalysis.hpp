@@ -0,0 +1,18 @@
+#ifndef COMPILER_SCRIPTANALYSIS_H_INCLUDED
+#define COMPILER_SCRIPTANALYSIS_H_INCLUDED
+
+namespace Interpreter
+{
+    struct Program;
+}
+
+namespace Compiler
+{
+    /// \brief Is the whole script a single if block on OnActivate of the implicit reference, without else or elseif?
+    ///
+    /// Running such a script does nothing but clear the OnActivate flag of the reference, it doesn't have to run
+    /// until the reference is activated.
+    bool isActivationOnly(const Interpreter::Program& program);
+}
+
+#endif
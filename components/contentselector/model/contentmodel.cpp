@@ -15,15 +15,14 @@
 #include <QIODevice>
 #include <QProgressDialog>
 
-#include <components/esm/format.hpp>
-#include <components/esm3/esmreader.hpp>
-#include <components/esm4/reader.hpp>
-#include <components/files/openfile.hpp>
+#include <components/esmloader/headercache.hpp>
 #include <components/files/qtconversion.hpp>
+#include <components/toutf8/toutf8.hpp>
 
 ContentSelectorModel::ContentModel::ContentModel(
     QObject* parent, QIcon& warningIcon, QIcon& errorIcon, bool showOMWScripts)
     : QAbstractTableModel(parent)
+    , mHeaderCache(std::make_shared<EsmLoader::HeaderCache>())
     , mWarningIcon(warningIcon)
     , mErrorIcon(errorIcon)
     , mShowOMWScripts(showOMWScripts)
@@ -47,6 +46,11 @@ void ContentSelectorModel::ContentModel::setEncoding(const QString& encoding)
     mEncoding = encoding;
 }
 
+void ContentSelectorModel::ContentModel::setHeaderCache(std::shared_ptr<EsmLoader::HeaderCache> headerCache)
+{
+    mHeaderCache = std::move(headerCache);
+}
+
 int ContentSelectorModel::ContentModel::columnCount(const QModelIndex& parent) const
 {
     if (parent.isValid())
@@ -393,7 +397,23 @@ void ContentSelectorModel::ContentModel::addFiles(const QString& path, bool newf
     dir.setNameFilters(filters);
     dir.setSorting(QDir::Name);
 
-    for (const QString& path2 : dir.entryList())
+    const QStringList entries = dir.entryList();
+
+    // Read the headers of all the content files at once, opening only the ones that aren't cached
+    std::vector<std::filesystem::path> contentPaths;
+    for (const QString& path2 : entries)
+        if (!path2.endsWith(".omwscripts", Qt::CaseInsensitive))
+            contentPaths.push_back(Files::pathFromQString(dir.absoluteFilePath(path2)));
+    const std::vector<EsmLoader::PluginHeaderResult> headers = mHeaderCache->get(contentPaths);
+    std::size_t nextHeader = 0;
+
+    ToUTF8::Utf8Encoder encoder(ToUTF8::calculateEncoding(mEncoding.toStdString()));
+    const auto toQString = [&](const std::string& value) {
+        const std::string_view utf8 = encoder.getUtf8(value);
+        return QString::fromUtf8(utf8.data(), static_cast<qsizetype>(utf8.size()));
+    };
+
+    for (const QString& path2 : entries)
     {
         QFileInfo info(dir.absoluteFilePath(path2));
 
@@ -427,65 +447,26 @@ void ContentSelectorModel::ContentModel::addFiles(const QString& path, bool newf
             continue;
         }
 
-        try
-        {
-            file->setDate(info.lastModified());
-            file->setFilePath(info.absoluteFilePath());
-            std::filesystem::path filepath = Files::pathFromQString(info.absoluteFilePath());
-
-            auto stream = Files::openBinaryInputFileStream(filepath);
-            if (!stream->is_open())
-            {
-                qWarning() << "Failed to open addon file " << info.fileName() << ": "
-                           << std::generic_category().message(errno).c_str();
-                continue;
-            }
-            const ESM::Format format = ESM::readFormat(*stream);
-            stream->seekg(0);
-            switch (format)
-            {
-                case ESM::Format::Tes3:
-                {
-                    ToUTF8::Utf8Encoder encoder(ToUTF8::calculateEncoding(mEncoding.toStdString()));
-                    ESM::ESMReader fileReader;
-                    fileReader.setEncoder(&encoder);
-                    fileReader.open(std::move(stream), filepath);
-                    file->setAuthor(QString::fromUtf8(fileReader.getAuthor().c_str()));
-                    file->setFormat(QString::number(fileReader.esmVersionF()));
-                    file->setDescription(QString::fromUtf8(fileReader.getDesc().c_str()));
-                    for (const auto& master : fileReader.getGameFiles())
-                        file->addGameFile(QString::fromUtf8(master.name.c_str()));
-                    break;
-                }
-                case ESM::Format::Tes4:
-                {
-                    ToUTF8::StatelessUtf8Encoder encoder(ToUTF8::calculateEncoding(mEncoding.toStdString()));
-                    ESM4::Reader fileReader(std::move(stream), filepath, nullptr, &encoder, true);
-                    file->setAuthor(QString::fromUtf8(fileReader.getAuthor().c_str()));
-                    file->setFormat(QString::number(fileReader.esmVersionF()));
-                    file->setDescription(QString::fromUtf8(fileReader.getDesc().c_str()));
-                    for (const auto& master : fileReader.getGameFiles())
-                        file->addGameFile(QString::fromUtf8(master.name.c_str()));
-                    break;
-                }
-                default:
-                {
-                    qWarning() << "Error reading addon file " << info.fileName() << ": unsupported ESM format "
-                               << ESM::NAME(format).toString().c_str();
-                    continue;
-                }
-            }
-
-            // Put the file in the table
-            if (add)
-                addFile(newFile.release());
-            setNew(file, newfiles);
-        }
-        catch (std::runtime_error& e)
+        const EsmLoader::PluginHeaderResult& header = headers[nextHeader++];
+        if (!header.mHeader.has_value())
         {
             // An error occurred while reading the .esp
-            qWarning() << "Error reading addon file: " << e.what();
+            qWarning() << "Error reading addon file " << info.fileName() << ": " << header.mError.c_str();
+            continue;
         }
+
+        file->setDate(info.lastModified());
+        file->setFilePath(info.absoluteFilePath());
+        file->setAuthor(toQString(header.mHeader->mAuthor));
+        file->setFormat(QString::number(header.mHeader->mVersion));
+        file->setDescription(toQString(header.mHeader->mDescription));
+        for (const std::string& master : header.mHeader->mMasters)
+            file->addGameFile(toQString(master));
+
+        // Put the file in the table
+        if (add)
+            addFile(newFile.release());
+        setNew(file, newfiles);
     }
 }
 
@@ -7,8 +7,14 @@
 #include <QSet>
 #include <QStringList>
 
+#include <memory>
 #include <set>
 
+namespace EsmLoader
+{
+    class HeaderCache;
+}
+
 namespace ContentSelectorModel
 {
     class EsmFile;
@@ -29,6 +35,8 @@ namespace ContentSelectorModel
         ~ContentModel();
 
         void setEncoding(const QString& encoding);
+        /// Share headers of the content files with other users of the cache
+        void setHeaderCache(std::shared_ptr<EsmLoader::HeaderCache> headerCache);
 
         int rowCount(const QModelIndex& parent = QModelIndex()) const override;
         int columnCount(const QModelIndex& parent = QModelIndex()) const override;
@@ -88,6 +96,7 @@ namespace ContentSelectorModel
         std::set<const EsmFile*> mCheckedFiles;
         QHash<QString, bool> mNewFiles;
         QString mEncoding;
+        std::shared_ptr<EsmLoader::HeaderCache> mHeaderCache;
         QIcon mWarningIcon;
         QIcon mErrorIcon;
         bool mShowOMWScripts;
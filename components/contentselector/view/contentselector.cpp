@@ -178,6 +178,11 @@ void ContentSelectorView::ContentSelector::setEncoding(const QString& encoding)
     mContentModel->setEncoding(encoding);
 }
 
+void ContentSelectorView::ContentSelector::setHeaderCache(std::shared_ptr<EsmLoader::HeaderCache> headerCache)
+{
+    mContentModel->setHeaderCache(std::move(headerCache));
+}
+
 void ContentSelectorView::ContentSelector::setContentList(const QStringList& list)
 {
     if (list.isEmpty())
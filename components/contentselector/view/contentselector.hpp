@@ -45,6 +45,7 @@ namespace ContentSelectorView
 
         void clearCheckStates();
         void setEncoding(const QString& encoding);
+        void setHeaderCache(std::shared_ptr<EsmLoader::HeaderCache> headerCache);
         void setContentList(const QStringList& list);
 
         ContentSelectorModel::ContentFileList selectedFiles() const;
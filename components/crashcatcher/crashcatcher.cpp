@@ -66,6 +66,8 @@ static struct
     std::optional<siginfo_t> siginfo;
 } crash_info;
 
+static void (*log_flush)() = nullptr;
+
 namespace
 {
     constexpr char crash_switch[] = "--cc-handle-crash";
@@ -304,6 +306,10 @@ static void crash_catcher(int signum, siginfo_t* siginfo, void* /*context*/)
         return;
     }
 
+    /* Give the log writer a chance to write what was logged before the crash */
+    if (log_flush != nullptr)
+        log_flush();
+
     safe_write(STDERR_FILENO, fatal_err, sizeof(fatal_err) - 1);
     int fd[2];
     if (pipe(fd) == -1)
@@ -581,6 +587,11 @@ static bool isDebuggerPresent()
 #endif
 }
 
+void crashCatcherSetLogFlush(void (*flush)())
+{
+    log_flush = flush;
+}
+
 void crashCatcherInstall(int argc, char** argv, const std::filesystem::path& crashLogPath)
 {
     if (argc == 2 && strcmp(argv[1], crash_switch) == 0)
@@ -6,8 +6,11 @@
 #if (defined(__APPLE__) || (defined(__linux) && !defined(ANDROID)) || (defined(__unix) && !defined(ANDROID))           \
     || defined(__posix))
 void crashCatcherInstall(int argc, char** argv, const std::filesystem::path& crashLogPath);
+// Called by the crash handler before the crash is reported, has to be safe to call from a signal handler
+void crashCatcherSetLogFlush(void (*flush)());
 #else
 inline void crashCatcherInstall(int /*argc*/, char** /*argv*/, const std::filesystem::path& /*crashLogPath*/) {}
+inline void crashCatcherSetLogFlush(void (* /*flush*/)()) {}
 #endif
 
 #endif
@@ -1,10 +1,15 @@
 #include "debugging.hpp"
 
+#include <atomic>
 #include <chrono>
+#include <condition_variable>
 #include <deque>
 #include <fstream>
 #include <iostream>
 #include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
 
 #ifdef _MSC_VER
 // TODO: why is this necessary? this has /external:I
@@ -21,6 +26,8 @@
 #include <components/misc/strings/conversion.hpp>
 #include <components/misc/strings/lower.hpp>
 
+#include "logfilter.hpp"
+
 #ifdef _WIN32
 #include <components/crashcatcher/windowscrashcatcher.hpp>
 #include <components/files/conversion.hpp>
@@ -108,6 +115,34 @@ namespace Debug
 
     namespace
     {
+        struct Prefix
+        {
+            char mValue[32];
+            std::size_t mSize;
+
+            std::string_view get() const { return std::string_view(mValue, mSize); }
+        };
+
+        Prefix makePrefix(Level level)
+        {
+            Prefix prefix;
+            prefix.mValue[0] = '[';
+            const auto now = std::chrono::system_clock::now();
+            const auto time = std::chrono::system_clock::to_time_t(now);
+            tm timeInfo{};
+#ifdef _WIN32
+            (void)localtime_s(&timeInfo, &time);
+#else
+            (void)localtime_r(&time, &timeInfo);
+#endif
+            prefix.mSize = std::strftime(prefix.mValue + 1, sizeof(prefix.mValue) - 1, "%T", &timeInfo) + 1;
+            char levelLetter = " EWIVD*"[int(level)];
+            const auto ms = std::chrono::duration_cast<std::chrono::milliseconds>(now.time_since_epoch()).count();
+            prefix.mSize += snprintf(prefix.mValue + prefix.mSize, sizeof(prefix.mValue) - prefix.mSize, ".%03u %c] ",
+                static_cast<unsigned>(ms % 1000), levelLetter);
+            return prefix;
+        }
+
         class DebugOutputBase : public boost::iostreams::sink
         {
         public:
@@ -125,25 +160,7 @@ namespace Debug
                     msg = msg.substr(1);
                 }
 
-                char prefix[32];
-                std::size_t prefixSize;
-                {
-                    prefix[0] = '[';
-                    const auto now = std::chrono::system_clock::now();
-                    const auto time = std::chrono::system_clock::to_time_t(now);
-                    tm timeInfo{};
-#ifdef _WIN32
-                    (void)localtime_s(&timeInfo, &time);
-#else
-                    (void)localtime_r(&time, &timeInfo);
-#endif
-                    prefixSize = std::strftime(prefix + 1, sizeof(prefix) - 1, "%T", &timeInfo) + 1;
-                    char levelLetter = " EWIVD*"[int(level)];
-                    const auto ms
-                        = std::chrono::duration_cast<std::chrono::milliseconds>(now.time_since_epoch()).count();
-                    prefixSize += snprintf(prefix + prefixSize, sizeof(prefix) - prefixSize, ".%03u %c] ",
-                        static_cast<unsigned>(ms % 1000), levelLetter);
-                }
+                const Prefix prefix = makePrefix(level);
 
                 while (!msg.empty())
                 {
@@ -152,11 +169,9 @@ namespace Debug
                     size_t lineSize = 1;
                     while (lineSize < msg.size() && msg[lineSize - 1] != '\n')
                         lineSize++;
-                    writeImpl(prefix, prefixSize, level);
-                    writeImpl(msg.data(), lineSize, level);
+                    writeLine(prefix.get(), std::string_view(msg.data(), lineSize), level);
                     if (logListener)
-                        logListener(
-                            level, std::string_view(prefix, prefixSize), std::string_view(msg.data(), lineSize));
+                        logListener(level, prefix.get(), std::string_view(msg.data(), lineSize));
                     msg = msg.substr(lineSize);
                 }
 
@@ -173,6 +188,12 @@ namespace Debug
                 return All;
             }
 
+            virtual void writeLine(std::string_view prefix, std::string_view line, Level level)
+            {
+                writeImpl(prefix.data(), static_cast<std::streamsize>(prefix.size()), level);
+                writeImpl(line.data(), static_cast<std::streamsize>(line.size()), level);
+            }
+
             virtual std::streamsize writeImpl(const char* str, std::streamsize size, Level debugLevel)
             {
                 return size;
@@ -326,6 +347,144 @@ namespace Debug
             First mFirst;
             Second mSecond;
         };
+
+        // Writes the log lines on its own thread, so the threads that log never wait for the disk or the console
+        class AsyncWriter
+        {
+        public:
+            explicit AsyncWriter(Identity log, Coloured out, Coloured err)
+                : mLog(log)
+                , mOut(out)
+                , mErr(err)
+                , mThread([this] { run(); })
+            {
+            }
+
+            ~AsyncWriter() { stop(); }
+
+            void push(std::string_view prefix, std::string_view line, Level level, bool error)
+            {
+                std::lock_guard<std::mutex> lock(mMutex);
+                // Lines written while shutting down can't be left to the thread
+                if (mStop)
+                {
+                    write(Line{ std::string(prefix) + std::string(line), level, error });
+                    return;
+                }
+                LogFilter::Skipped skipped;
+                if (!mFilter.filter(line, level, LogFilter::Clock::now(), skipped))
+                    return;
+                pushSkipped(skipped, error);
+                pushLine(Line{ std::string(prefix) + std::string(line), level, error });
+                mCondVar.notify_one();
+            }
+
+            /// Wait for the queued lines to be written, without locking anything to be usable by a crash handler.
+            void flush(std::chrono::milliseconds timeout)
+            {
+                const auto end = std::chrono::steady_clock::now() + timeout;
+                while (mPending.load() != 0 && std::chrono::steady_clock::now() < end)
+                    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            }
+
+            void stop()
+            {
+                {
+                    std::lock_guard<std::mutex> lock(mMutex);
+                    mStop = true;
+                }
+                mCondVar.notify_one();
+                if (mThread.joinable())
+                    mThread.join();
+            }
+
+        private:
+            struct Line
+            {
+                std::string mValue;
+                Level mLevel;
+                bool mError;
+            };
+
+            Identity mLog;
+            Coloured mOut;
+            Coloured mErr;
+            std::mutex mMutex;
+            std::condition_variable mCondVar;
+            bool mStop = false;
+            LogFilter mFilter;
+            std::vector<Line> mQueue;
+            std::atomic<std::size_t> mPending{ 0 };
+            std::thread mThread;
+
+            void pushLine(Line&& line)
+            {
+                mQueue.push_back(std::move(line));
+                ++mPending;
+            }
+
+            void pushSkipped(const LogFilter::Skipped& skipped, bool error)
+            {
+                if (skipped.mRepeated > 0)
+                    pushLine(Line{ std::string(makePrefix(Info).get()) + "Previous message repeated "
+                            + std::to_string(skipped.mRepeated) + " times\n",
+                        Info, error });
+                if (skipped.mDropped > 0)
+                    pushLine(Line{ std::string(makePrefix(Warning).get()) + std::to_string(skipped.mDropped)
+                            + " log messages were dropped\n",
+                        Warning, error });
+            }
+
+            void write(const Line& line)
+            {
+                mLog.write(line.mValue.data(), static_cast<std::streamsize>(line.mValue.size()), line.mLevel);
+                (line.mError ? mErr : mOut)
+                    .write(line.mValue.data(), static_cast<std::streamsize>(line.mValue.size()), line.mLevel);
+            }
+
+            void run()
+            {
+                std::vector<Line> lines;
+                while (true)
+                {
+                    {
+                        std::unique_lock<std::mutex> lock(mMutex);
+                        mCondVar.wait_for(
+                            lock, std::chrono::seconds(1), [&] { return mStop || !mQueue.empty(); });
+                        // Report a flood of repeated lines once it is over
+                        if (mQueue.empty())
+                            pushSkipped(mFilter.takeSkipped(), false);
+                        if (mQueue.empty() && mStop)
+                            return;
+                        std::swap(lines, mQueue);
+                    }
+                    for (const Line& line : lines)
+                        write(line);
+                    mPending -= lines.size();
+                    lines.clear();
+                }
+            }
+        };
+
+        class AsyncTee : public DebugOutputBase
+        {
+        public:
+            explicit AsyncTee(std::shared_ptr<AsyncWriter> writer, bool error)
+                : mWriter(std::move(writer))
+                , mError(error)
+            {
+            }
+
+        protected:
+            void writeLine(std::string_view prefix, std::string_view line, Level level) override
+            {
+                mWriter->push(prefix, line, level, mError);
+            }
+
+        private:
+            std::shared_ptr<AsyncWriter> mWriter;
+            bool mError;
+        };
 #endif
 
         Level toLevel(std::string_view value)
@@ -352,8 +511,9 @@ namespace Debug
 #if defined(_WIN32) && defined(_DEBUG)
         static boost::iostreams::stream_buffer<DebugOutput> sb;
 #else
-        static boost::iostreams::stream_buffer<Tee<Identity, Coloured>> standardOut;
-        static boost::iostreams::stream_buffer<Tee<Identity, Coloured>> standardErr;
+        static std::shared_ptr<AsyncWriter> asyncWriter;
+        static boost::iostreams::stream_buffer<AsyncTee> standardOut;
+        static boost::iostreams::stream_buffer<AsyncTee> standardErr;
         static boost::iostreams::stream_buffer<Tee<Buffer, Coloured>> bufferedOut;
         static boost::iostreams::stream_buffer<Tee<Buffer, Coloured>> bufferedErr;
 #endif
@@ -406,8 +566,11 @@ namespace Debug
 
         globalBuffer.clear();
 
-        standardOut.open(Tee(log, Coloured(*rawStdout)));
-        standardErr.open(Tee(log, Coloured(*rawStderr)));
+        asyncWriter = std::make_shared<AsyncWriter>(log, Coloured(*rawStdout), Coloured(*rawStderr));
+        crashCatcherSetLogFlush([] { asyncWriter->flush(std::chrono::seconds(1)); });
+
+        standardOut.open(AsyncTee(asyncWriter, false));
+        standardErr.open(AsyncTee(asyncWriter, true));
 
         std::cout.rdbuf(&standardOut);
         std::cerr.rdbuf(&standardErr);
@@ -489,6 +652,11 @@ namespace Debug
         std::cout.rdbuf(rawStdout->rdbuf());
         std::cerr.rdbuf(rawStderr->rdbuf());
 
+#if !(defined(_WIN32) && defined(_DEBUG))
+        if (asyncWriter != nullptr)
+            asyncWriter->stop();
+#endif
+
         Log::sMinDebugLevel = All;
         Log::sWriteLevel = false;
 
@@ -0,0 +1,49 @@
+#include "logfilter.hpp"
+
+#include <algorithm>
+#include <utility>
+
+namespace Debug
+{
+    bool LogFilter::filter(std::string_view line, Level level, Clock::time_point now, Skipped& skipped)
+    {
+        if (level == mLastLevel && line == mLast)
+        {
+            if (mLastWritten)
+                ++mSkipped.mRepeated;
+            else
+                ++mSkipped.mDropped;
+            return false;
+        }
+
+        mLast = line;
+        mLastLevel = level;
+        mLastWritten = false;
+
+        if (mLastRefill != Clock::time_point{})
+            mTokens = std::min(
+                sMaxBurst, mTokens + std::chrono::duration<double>(now - mLastRefill).count() * sMaxLinesPerSecond);
+        mLastRefill = now;
+
+        if (level != Error)
+        {
+            if (mTokens < 1)
+            {
+                ++mSkipped.mDropped;
+                // The repetitions of the dropped line were not written either
+                mSkipped.mDropped += std::exchange(mSkipped.mRepeated, 0);
+                return false;
+            }
+            mTokens -= 1;
+        }
+
+        skipped = takeSkipped();
+        mLastWritten = true;
+        return true;
+    }
+
+    LogFilter::Skipped LogFilter::takeSkipped()
+    {
+        return std::exchange(mSkipped, Skipped{});
+    }
+}
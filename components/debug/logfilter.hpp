@@ -0,0 +1,48 @@
+#ifndef OPENMW_COMPONENTS_DEBUG_LOGFILTER_H
+#define OPENMW_COMPONENTS_DEBUG_LOGFILTER_H
+
+#include "debuglog.hpp"
+
+#include <chrono>
+#include <cstddef>
+#include <string>
+#include <string_view>
+
+namespace Debug
+{
+    /// @brief Decides which log lines to write, so a flood of lines, like the same warning for every object of a
+    /// broken mod, doesn't keep the log writer busy.
+    /// @par A line equal to the previous one is only counted. Lines beyond sMaxLinesPerSecond on average, with
+    /// bursts of up to sMaxBurst lines, are dropped unless they are errors.
+    class LogFilter
+    {
+    public:
+        using Clock = std::chrono::steady_clock;
+
+        static constexpr double sMaxLinesPerSecond = 200;
+        static constexpr double sMaxBurst = 1000;
+
+        struct Skipped
+        {
+            std::size_t mRepeated = 0;
+            std::size_t mDropped = 0;
+        };
+
+        /// @param skipped lines skipped since the previous written line, to report before this one if it is written
+        /// @return true if the line is to be written
+        bool filter(std::string_view line, Level level, Clock::time_point now, Skipped& skipped);
+
+        /// @return the skipped lines that are not reported yet
+        Skipped takeSkipped();
+
+    private:
+        std::string mLast;
+        Level mLastLevel = All;
+        bool mLastWritten = false;
+        Skipped mSkipped;
+        double mTokens = sMaxBurst;
+        Clock::time_point mLastRefill{};
+    };
+}
+
+#endif
@@ -0,0 +1,166 @@
+#include "tracing.hpp"
+
+#include <algorithm>
+#include <format>
+#include <memory>
+#include <mutex>
+#include <string_view>
+
+namespace Debug
+{
+    namespace Tracing
+    {
+        namespace
+        {
+            struct ThreadBuffer
+            {
+                std::mutex mMutex;
+                std::size_t mId = 0;
+                std::string mName;
+                std::vector<TraceEvent> mEvents;
+                // Where the next event is written once the buffer is full
+                std::size_t mNext = 0;
+            };
+
+            struct Registry
+            {
+                std::mutex mMutex;
+                std::atomic<std::size_t> mCapacity{ 0 };
+                // Buffers of threads that are gone are kept to not lose what they did before a stutter
+                std::vector<std::shared_ptr<ThreadBuffer>> mBuffers;
+            };
+
+            Registry& getRegistry()
+            {
+                static Registry registry;
+                return registry;
+            }
+
+            ThreadBuffer& getThreadBuffer()
+            {
+                thread_local const std::shared_ptr<ThreadBuffer> buffer = [] {
+                    auto result = std::make_shared<ThreadBuffer>();
+                    Registry& registry = getRegistry();
+                    std::lock_guard<std::mutex> lock(registry.mMutex);
+                    result->mId = registry.mBuffers.size() + 1;
+                    registry.mBuffers.push_back(result);
+                    return result;
+                }();
+                return *buffer;
+            }
+
+            void writeEscaped(std::string_view value, std::ostream& stream)
+            {
+                for (const char c : value)
+                {
+                    if (c == '"' || c == '\\')
+                        stream << '\\' << c;
+                    else if (static_cast<unsigned char>(c) < 0x20)
+                        stream << std::format("\\u{:04x}", static_cast<int>(c));
+                    else
+                        stream << c;
+                }
+            }
+        }
+
+        void setCapacity(std::size_t capacity)
+        {
+            Registry& registry = getRegistry();
+            std::lock_guard<std::mutex> lock(registry.mMutex);
+            registry.mCapacity = capacity;
+            for (const std::shared_ptr<ThreadBuffer>& buffer : registry.mBuffers)
+            {
+                std::lock_guard<std::mutex> bufferLock(buffer->mMutex);
+                buffer->mEvents.clear();
+                buffer->mEvents.shrink_to_fit();
+                buffer->mNext = 0;
+            }
+            Detail::sEnabled = capacity != 0;
+        }
+
+        void setThreadName(std::string name)
+        {
+            ThreadBuffer& buffer = getThreadBuffer();
+            std::lock_guard<std::mutex> lock(buffer.mMutex);
+            buffer.mName = std::move(name);
+        }
+
+        void addEvent(const TraceEvent& event)
+        {
+            ThreadBuffer& buffer = getThreadBuffer();
+            const std::size_t capacity = getRegistry().mCapacity.load(std::memory_order_relaxed);
+            std::lock_guard<std::mutex> lock(buffer.mMutex);
+            if (buffer.mEvents.size() < capacity)
+            {
+                if (buffer.mEvents.capacity() < capacity)
+                    buffer.mEvents.reserve(capacity);
+                buffer.mEvents.push_back(event);
+                return;
+            }
+            if (buffer.mEvents.empty())
+                return;
+            buffer.mEvents[buffer.mNext] = event;
+            buffer.mNext = (buffer.mNext + 1) % buffer.mEvents.size();
+        }
+
+        std::vector<TraceThread> collect()
+        {
+            std::vector<TraceThread> result;
+            Registry& registry = getRegistry();
+            std::lock_guard<std::mutex> lock(registry.mMutex);
+            for (const std::shared_ptr<ThreadBuffer>& buffer : registry.mBuffers)
+            {
+                std::lock_guard<std::mutex> bufferLock(buffer->mMutex);
+                if (buffer->mEvents.empty())
+                    continue;
+                TraceThread& thread = result.emplace_back(TraceThread{ buffer->mId, buffer->mName, {} });
+                thread.mEvents.reserve(buffer->mEvents.size());
+                const auto next = buffer->mEvents.begin() + static_cast<std::ptrdiff_t>(buffer->mNext);
+                thread.mEvents.insert(thread.mEvents.end(), next, buffer->mEvents.end());
+                thread.mEvents.insert(thread.mEvents.end(), buffer->mEvents.begin(), next);
+            }
+            return result;
+        }
+
+        void writeChromeTrace(std::span<const TraceThread> threads, std::ostream& stream)
+        {
+            TraceClock::time_point start = TraceClock::time_point::max();
+            for (const TraceThread& thread : threads)
+                for (const TraceEvent& event : thread.mEvents)
+                    start = std::min(start, event.mBegin);
+
+            const auto toMicroseconds = [](TraceClock::duration value) {
+                return std::chrono::duration<double, std::micro>(value).count();
+            };
+
+            stream << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+            bool first = true;
+            const auto separate = [&] {
+                if (!first)
+                    stream << ',';
+                first = false;
+                stream << '\n';
+            };
+            for (const TraceThread& thread : threads)
+            {
+                separate();
+                stream << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" << thread.mId
+                       << ",\"args\":{\"name\":\"";
+                if (thread.mName.empty())
+                    stream << "Thread " << thread.mId;
+                else
+                    writeEscaped(thread.mName, stream);
+                stream << "\"}}";
+                for (const TraceEvent& event : thread.mEvents)
+                {
+                    separate();
+                    stream << "{\"name\":\"";
+                    writeEscaped(event.mName, stream);
+                    stream << std::format("\",\"ph\":\"X\",\"pid\":1,\"tid\":{},\"ts\":{:.3f},\"dur\":{:.3f}}}",
+                        thread.mId, toMicroseconds(event.mBegin - start), toMicroseconds(event.mEnd - event.mBegin));
+                }
+            }
+            stream << "\n]}\n";
+        }
+    }
+}
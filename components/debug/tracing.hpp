@@ -0,0 +1,93 @@
+#ifndef OPENMW_COMPONENTS_DEBUG_TRACING_H
+#define OPENMW_COMPONENTS_DEBUG_TRACING_H
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+#include <span>
+#include <string>
+#include <vector>
+
+namespace Debug
+{
+    using TraceClock = std::chrono::steady_clock;
+
+    struct TraceEvent
+    {
+        // Has to outlive the tracer, usually a string literal
+        const char* mName;
+        TraceClock::time_point mBegin;
+        TraceClock::time_point mEnd;
+    };
+
+    struct TraceThread
+    {
+        std::size_t mId;
+        std::string mName;
+        // Oldest first
+        std::vector<TraceEvent> mEvents;
+    };
+
+    /// @brief Keeps the latest zones of every thread in a ring buffer per thread to look at what happened during a
+    /// stutter after it already happened.
+    /// @par A thread only locks its own buffer to add a zone, so threads never wait for each other unless the
+    /// buffers are collected at the same time.
+    /// @note Thread safe.
+    namespace Tracing
+    {
+        namespace Detail
+        {
+            inline std::atomic<bool> sEnabled{ false };
+        }
+
+        inline bool isEnabled()
+        {
+            return Detail::sEnabled.load(std::memory_order_relaxed);
+        }
+
+        /// @param capacity number of zones kept per thread, 0 disables tracing and frees the buffers
+        void setCapacity(std::size_t capacity);
+
+        /// Name the current thread in the collected traces.
+        void setThreadName(std::string name);
+
+        void addEvent(const TraceEvent& event);
+
+        /// @return the zones kept for every thread that recorded any
+        std::vector<TraceThread> collect();
+
+        /// Write the zones in the Chrome trace event format, that Perfetto and chrome://tracing can open.
+        void writeChromeTrace(std::span<const TraceThread> threads, std::ostream& stream);
+    }
+
+    /// @brief Adds a zone from construction to destruction while tracing is enabled, does nothing but check a
+    /// flag otherwise.
+    class TraceZone
+    {
+    public:
+        /// @param name has to outlive the tracer, usually a string literal
+        explicit TraceZone(const char* name)
+            : mName(Tracing::isEnabled() ? name : nullptr)
+        {
+            if (mName != nullptr)
+                mBegin = TraceClock::now();
+        }
+
+        ~TraceZone()
+        {
+            if (mName != nullptr)
+                Tracing::addEvent(TraceEvent{ mName, mBegin, TraceClock::now() });
+        }
+
+        TraceZone(const TraceZone&) = delete;
+        TraceZone& operator=(const TraceZone&) = delete;
+
+    private:
+        const char* mName;
+        TraceClock::time_point mBegin;
+    };
+}
+
+#endif
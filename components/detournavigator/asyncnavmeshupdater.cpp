@@ -8,6 +8,7 @@
 #include "version.hpp"
 
 #include <components/debug/debuglog.hpp>
+#include <components/debug/tracing.hpp>
 #include <components/loadinglistener/loadinglistener.hpp>
 #include <components/misc/strings/conversion.hpp>
 #include <components/misc/thread.hpp>
@@ -19,11 +20,15 @@
 #include <boost/geometry.hpp>
 
 #include <algorithm>
+#include <chrono>
+#include <exception>
 #include <format>
+#include <functional>
 #include <optional>
 #include <set>
 #include <tuple>
 #include <type_traits>
+#include <vector>
 
 namespace DetourNavigator
 {
@@ -51,6 +56,21 @@ namespace DetourNavigator
             return false;
         }
 
+        void addDemand(Job& job, std::chrono::steady_clock::time_point now)
+        {
+            if (job.mDemand == 0)
+                job.mFirstDemandTime = now;
+            ++job.mDemand;
+        }
+
+        std::size_t getMaxDemand(const std::deque<JobIt>& jobs)
+        {
+            std::size_t result = 0;
+            for (JobIt job : jobs)
+                result = std::max(result, job->mDemand);
+            return result;
+        }
+
         auto getAgentAndTile(const Job& job) noexcept
         {
             return std::make_tuple(job.mAgentBounds, job.mChangedTile);
@@ -61,8 +81,7 @@ namespace DetourNavigator
         {
             if (db == nullptr)
                 return nullptr;
-            return std::make_unique<DbWorker>(updater, std::move(db), TileVersion(navMeshFormatVersion),
-                settings.mRecast, settings.mWriteToNavMeshDb);
+            return std::make_unique<DbWorker>(updater, std::move(db), TileVersion(navMeshFormatVersion), settings);
         }
 
         std::size_t getNextJobId()
@@ -137,6 +156,7 @@ namespace DetourNavigator
     {
         mValues.clear();
         mIndex.clear();
+        mDemanded.clear();
         mSize = 0;
     }
 
@@ -152,6 +172,9 @@ namespace DetourNavigator
 
         it->second.push_back(job);
 
+        if (job->mDemand > 0)
+            mDemanded.insert(job->mChangedTile);
+
         ++mSize;
     }
 
@@ -163,17 +186,36 @@ namespace DetourNavigator
         if (it == mIndex.qend())
             return std::nullopt;
 
-        const UpdatingMap::iterator mapIt = it->second;
+        UpdatingMap::iterator mapIt = it->second;
+        float minScore = static_cast<float>(getManhattanDistance(mapIt->first, playerTile));
+
+        for (const TilePosition& tilePosition : mDemanded)
+        {
+            const auto demandedIt = mValues.find(tilePosition);
+            const float score = static_cast<float>(getManhattanDistance(tilePosition, playerTile))
+                / static_cast<float>(1 + getMaxDemand(demandedIt->second));
+            if (score < minScore)
+            {
+                minScore = score;
+                mapIt = demandedIt;
+            }
+        }
+
         std::deque<JobIt>& tileJobs = mapIt->second;
-        JobIt result = tileJobs.front();
-        tileJobs.pop_front();
+        const auto jobIt = std::max_element(tileJobs.begin(), tileJobs.end(),
+            [](JobIt lhs, JobIt rhs) { return lhs->mDemand < rhs->mDemand; });
+        const JobIt result = *jobIt;
+        tileJobs.erase(jobIt);
 
         --mSize;
 
+        if (result->mDemand > 0 && getMaxDemand(tileJobs) == 0)
+            mDemanded.erase(mapIt->first);
+
         if (tileJobs.empty())
         {
+            mIndex.remove(IndexValue(IndexPoint(mapIt->first.x(), mapIt->first.y()), mapIt));
             mValues.erase(mapIt);
-            mIndex.remove(*it);
         }
 
         return result;
@@ -196,11 +238,32 @@ namespace DetourNavigator
             }
 
             mSize -= it->second.size();
+            mDemanded.erase(it->first);
             mIndex.remove(IndexValue(IndexPoint(it->first.x(), it->first.y()), it));
             it = mValues.erase(it);
         }
     }
 
+    void SpatialJobQueue::demand(
+        const AgentBounds& agentBounds, const TilePosition& tilePosition, std::chrono::steady_clock::time_point now)
+    {
+        const auto it = mValues.find(tilePosition);
+        if (it == mValues.end())
+            return;
+
+        bool demanded = false;
+        for (JobIt job : it->second)
+        {
+            if (job->mAgentBounds != agentBounds)
+                continue;
+            addDemand(*job, now);
+            demanded = true;
+        }
+
+        if (demanded)
+            mDemanded.insert(tilePosition);
+    }
+
     bool JobQueue::hasJob(std::chrono::steady_clock::time_point now) const
     {
         return !mRemoving.empty() || mUpdating.size() > 0
@@ -272,13 +335,25 @@ namespace DetourNavigator
         }
     }
 
+    void JobQueue::demand(
+        const AgentBounds& agentBounds, const TilePosition& tilePosition, std::chrono::steady_clock::time_point now)
+    {
+        // Delayed jobs keep the demand to go first once they are due
+        for (JobIt job : mDelayed)
+            if (job->mAgentBounds == agentBounds && job->mChangedTile == tilePosition)
+                addDemand(*job, now);
+
+        mUpdating.demand(agentBounds, tilePosition, now);
+    }
+
     AsyncNavMeshUpdater::AsyncNavMeshUpdater(const Settings& settings, TileCachedRecastMeshManager& recastMeshManager,
         OffMeshConnectionsManager& offMeshConnectionsManager, std::unique_ptr<NavMeshDb>&& db)
         : mSettings(settings)
         , mRecastMeshManager(recastMeshManager)
         , mOffMeshConnectionsManager(offMeshConnectionsManager)
         , mShouldStop()
-        , mNavMeshTilesCache(settings.mMaxNavMeshTilesCacheSize)
+        , mNavMeshTilesCache(settings.mMaxNavMeshTilesCacheSize, settings.mMaxAgentNavMeshTilesCacheSize)
+        , mCompactHeightfieldCache(settings.mMaxObstacleHeightfieldsCacheSize)
         , mDbWorker(makeDbWorker(*this, std::move(db), mSettings))
     {
         for (std::size_t i = 0; i < mSettings.get().mAsyncNavMeshUpdaterThreads; ++i)
@@ -429,6 +504,15 @@ namespace DetourNavigator
         mProcessingTiles.wait(mProcessed, [](const auto& v) { return v.empty(); });
     }
 
+    void AsyncNavMeshUpdater::demand(const AgentBounds& agentBounds, std::span<const TilePosition> tiles)
+    {
+        const auto now = std::chrono::steady_clock::now();
+        const std::lock_guard lock(mMutex);
+        for (const TilePosition& tilePosition : tiles)
+            if (mPushed.contains(std::make_tuple(agentBounds, tilePosition)))
+                mWaiting.demand(agentBounds, tilePosition, now);
+    }
+
     AsyncNavMeshUpdaterStats AsyncNavMeshUpdater::getStats() const
     {
         AsyncNavMeshUpdaterStats result;
@@ -437,6 +521,8 @@ namespace DetourNavigator
             result.mJobs = mJobs.size();
             result.mWaiting = mWaiting.getStats();
             result.mPushed = mPushed.size();
+            result.mDemandedJobs = mDemandedJobs;
+            result.mDemandedJobsLatency = mDemandedJobsLatency;
         }
         result.mProcessing = mProcessingTiles.lockConst()->size();
         if (mDbWorker != nullptr)
@@ -450,13 +536,17 @@ namespace DetourNavigator
     {
         Log(Debug::Debug) << "Start process navigator jobs by thread=" << std::this_thread::get_id();
         Misc::setCurrentThreadIdlePriority();
+        Debug::Tracing::setThreadName("Navigator");
         while (!mShouldStop)
         {
             if (JobIt job = getNextJob(); job != mJobs.end())
             {
                 try
                 {
-                    const JobStatus status = processJob(*job);
+                    const JobStatus status = [&] {
+                        const Debug::TraceZone zone("Navigator job");
+                        return processJob(*job);
+                    }();
                     Log(Debug::Debug) << "Processed job " << job->mId << " with status=" << status
                                       << " changeType=" << job->mChangeType;
                     switch (status)
@@ -577,8 +667,10 @@ namespace DetourNavigator
                 return JobStatus::MemoryCacheMiss;
             }
 
-            preparedNavMeshData = prepareNavMeshTileData(
-                *recastMesh, job.mWorldspace, job.mChangedTile, job.mAgentBounds, mSettings.get().mRecast);
+            const auto generationStart = std::chrono::steady_clock::now();
+
+            preparedNavMeshData = prepareNavMeshTileData(*recastMesh, job.mWorldspace, job.mChangedTile,
+                job.mAgentBounds, mSettings.get().mRecast, &mCompactHeightfieldCache);
 
             if (preparedNavMeshData == nullptr)
             {
@@ -593,8 +685,8 @@ namespace DetourNavigator
             }
             else
             {
-                cachedNavMeshData = mNavMeshTilesCache.set(
-                    job.mAgentBounds, job.mChangedTile, *recastMesh, std::move(preparedNavMeshData));
+                cachedNavMeshData = mNavMeshTilesCache.set(job.mAgentBounds, job.mChangedTile, *recastMesh,
+                    std::move(preparedNavMeshData), std::chrono::steady_clock::now() - generationStart);
                 preparedNavMeshDataPtr = cachedNavMeshData ? &cachedNavMeshData.get() : preparedNavMeshData.get();
             }
         }
@@ -617,6 +709,8 @@ namespace DetourNavigator
 
         std::unique_ptr<PreparedNavMeshData> preparedNavMeshData;
         bool generatedNavMeshData = false;
+        // Evicted tiles are read from the db again or generated if there were none
+        const auto generationStart = std::chrono::steady_clock::now();
 
         if (job.mCachedTileData.has_value() && job.mCachedTileData->mVersion == navMeshFormatVersion)
         {
@@ -629,8 +723,8 @@ namespace DetourNavigator
 
         if (preparedNavMeshData == nullptr)
         {
-            preparedNavMeshData = prepareNavMeshTileData(
-                *job.mRecastMesh, job.mWorldspace, job.mChangedTile, job.mAgentBounds, mSettings.get().mRecast);
+            preparedNavMeshData = prepareNavMeshTileData(*job.mRecastMesh, job.mWorldspace, job.mChangedTile,
+                job.mAgentBounds, mSettings.get().mRecast, &mCompactHeightfieldCache);
             generatedNavMeshData = true;
         }
 
@@ -641,8 +735,8 @@ namespace DetourNavigator
             return JobStatus::Done;
         }
 
-        auto cachedNavMeshData = mNavMeshTilesCache.set(
-            job.mAgentBounds, job.mChangedTile, *job.mRecastMesh, std::move(preparedNavMeshData));
+        auto cachedNavMeshData = mNavMeshTilesCache.set(job.mAgentBounds, job.mChangedTile, *job.mRecastMesh,
+            std::move(preparedNavMeshData), std::chrono::steady_clock::now() - generationStart);
 
         const auto offMeshConnections = mOffMeshConnectionsManager.get().get(job.mChangedTile);
 
@@ -736,10 +830,19 @@ namespace DetourNavigator
             return mJobs.end();
         }
 
+        const auto now = std::chrono::steady_clock::now();
+
         if (job->mChangeType == ChangeType::update)
-            mLastUpdates[getAgentAndTile(*job)] = std::chrono::steady_clock::now();
+            mLastUpdates[getAgentAndTile(*job)] = now;
         mPushed.erase(getAgentAndTile(*job));
 
+        if (job->mDemand > 0)
+        {
+            ++mDemandedJobs;
+            mDemandedJobsLatency += now - job->mFirstDemandTime;
+            job->mDemand = 0;
+        }
+
         return job;
     }
 
@@ -808,13 +911,16 @@ namespace DetourNavigator
         mHasJob.notify_all();
     }
 
-    std::optional<JobIt> DbJobQueue::pop()
+    std::optional<JobIt> DbJobQueue::pop(std::optional<std::chrono::steady_clock::time_point> deadline)
     {
         std::unique_lock lock(mMutex);
 
         const auto hasJob = [&] { return mShouldStop || mReading.size() > 0 || mWriting.size() > 0; };
 
-        mHasJob.wait(lock, hasJob);
+        if (!deadline.has_value())
+            mHasJob.wait(lock, hasJob);
+        else if (!mHasJob.wait_until(lock, *deadline, hasJob))
+            return std::nullopt;
 
         if (mShouldStop)
             return std::nullopt;
@@ -831,6 +937,18 @@ namespace DetourNavigator
         return job;
     }
 
+    void DbJobQueue::popReading(std::size_t maxCount, std::vector<JobIt>& jobs)
+    {
+        const std::lock_guard lock(mMutex);
+        for (std::size_t i = 0; i < maxCount && !mShouldStop; ++i)
+        {
+            const std::optional<JobIt> job = mReading.pop(mPlayerTile);
+            if (!job.has_value())
+                break;
+            jobs.push_back(*job);
+        }
+    }
+
     void DbJobQueue::update(TilePosition playerTile)
     {
         const std::lock_guard lock(mMutex);
@@ -855,13 +973,15 @@ namespace DetourNavigator
         };
     }
 
-    DbWorker::DbWorker(AsyncNavMeshUpdater& updater, std::unique_ptr<NavMeshDb>&& db, TileVersion version,
-        const RecastSettings& recastSettings, bool writeToDb)
+    DbWorker::DbWorker(
+        AsyncNavMeshUpdater& updater, std::unique_ptr<NavMeshDb>&& db, TileVersion version, const Settings& settings)
         : mUpdater(updater)
-        , mRecastSettings(recastSettings)
+        , mRecastSettings(settings.mRecast)
         , mDb(std::move(db))
         , mVersion(version)
-        , mWriteToDb(writeToDb)
+        , mMaxTransactionTiles(std::max<std::size_t>(settings.mDbTransactionTiles, 1))
+        , mMaxTransactionDuration(settings.mDbTransactionInterval)
+        , mWriteToDb(settings.mWriteToNavMeshDb)
         , mNextTileId(mDb->getMaxTileId() + 1)
         , mNextShapeId(mDb->getMaxShapeId() + 1)
         , mThread([this] { run(); })
@@ -897,124 +1017,182 @@ namespace DetourNavigator
 
     void DbWorker::run() noexcept
     {
+        Debug::Tracing::setThreadName("Navigator db");
         while (!mShouldStop)
         {
             try
             {
-                if (const auto job = mQueue.pop())
+                if (const auto job = mQueue.pop(getTransactionDeadline()))
+                {
+                    const Debug::TraceZone zone("Navigator db job");
                     processJob(*job);
+                }
+                if (shouldCommitTransaction())
+                    commitTransaction();
             }
             catch (const std::exception& e)
             {
                 Log(Debug::Error) << "DbWorker exception: " << e.what();
             }
         }
+
+        try
+        {
+            commitTransaction();
+        }
+        catch (const std::exception& e)
+        {
+            Log(Debug::Error) << "DbWorker failed to commit written tiles on stop: " << e.what();
+        }
     }
 
     void DbWorker::processJob(JobIt job)
     {
-        const auto process = [&](auto f) {
+        if (isWritingDbJob(*job))
+        {
             try
             {
-                f(job);
+                processWritingJob(job);
+                if (mTransaction.has_value())
+                    ++mTransactionTiles;
             }
             catch (const std::exception& e)
             {
-                Log(Debug::Error) << "DbWorker exception while processing job " << job->mId << ": " << e.what();
-                if (mWriteToDb)
-                {
-                    const std::string_view message(e.what());
-                    if (message.find("database or disk is full") != std::string_view::npos)
-                    {
-                        mWriteToDb = false;
-                        Log(Debug::Warning)
-                            << "Writes to navmeshdb are disabled because file size limit is reached or disk is full";
-                    }
-                    else if (message.find("database is locked") != std::string_view::npos)
-                    {
-                        mWriteToDb = false;
-                        Log(Debug::Warning)
-                            << "Writes to navmeshdb are disabled to avoid concurrent writes from multiple processes";
-                    }
-                    else if (message.find("UNIQUE constraint failed: tiles.tile_id") != std::string_view::npos)
-                    {
-                        Log(Debug::Warning) << "Found duplicate navmeshdb tile_id, please report the "
-                                               "issue to https://gitlab.com/OpenMW/openmw/-/issues, attach openmw.log: "
-                                            << mNextTileId;
-                        try
-                        {
-                            mNextTileId = TileId(mDb->getMaxTileId() + 1);
-                            Log(Debug::Info) << "Updated navmeshdb tile_id to: " << mNextTileId;
-                        }
-                        catch (const std::exception& exception)
-                        {
-                            mWriteToDb = false;
-                            Log(Debug::Warning) << "Failed to update next tile_id, writes to navmeshdb are disabled: "
-                                                << exception.what();
-                        }
-                    }
-                }
+                // SQLite may have rolled back the whole transaction on failure, the tiles are generated again anyway
+                mTransaction.reset();
+                handleException(job, e);
             }
-        };
-
-        if (isWritingDbJob(*job))
-        {
-            process([&](JobIt it) { processWritingJob(it); });
             mUpdater.removeJob(job);
             return;
         }
 
-        process([&](JobIt it) { processReadingJob(it); });
-        job->mState = JobState::WithDbResult;
-        mUpdater.enqueueJob(job);
+        // Read together with other jobs closest to the player to fetch tiles around with a single query
+        std::vector<JobIt> jobs{ job };
+        mQueue.popReading(NavMeshDb::sTilesDataBatchSize - 1, jobs);
+        processReadingJobs(jobs);
     }
 
-    void DbWorker::processReadingJob(JobIt job)
+    void DbWorker::handleException(JobIt job, const std::exception& e)
     {
-        ++mGetTileCount;
+        Log(Debug::Error) << "DbWorker exception while processing job " << job->mId << ": " << e.what();
+        if (!mWriteToDb)
+            return;
+        const std::string_view message(e.what());
+        if (message.find("database or disk is full") != std::string_view::npos)
+        {
+            mWriteToDb = false;
+            Log(Debug::Warning)
+                << "Writes to navmeshdb are disabled because file size limit is reached or disk is full";
+        }
+        else if (message.find("database is locked") != std::string_view::npos)
+        {
+            mWriteToDb = false;
+            Log(Debug::Warning)
+                << "Writes to navmeshdb are disabled to avoid concurrent writes from multiple processes";
+        }
+        else if (message.find("UNIQUE constraint failed: tiles.tile_id") != std::string_view::npos)
+        {
+            Log(Debug::Warning) << "Found duplicate navmeshdb tile_id, please report the "
+                                   "issue to https://gitlab.com/OpenMW/openmw/-/issues, attach openmw.log: "
+                                << mNextTileId;
+            try
+            {
+                mNextTileId = TileId(mDb->getMaxTileId() + 1);
+                Log(Debug::Info) << "Updated navmeshdb tile_id to: " << mNextTileId;
+            }
+            catch (const std::exception& exception)
+            {
+                mWriteToDb = false;
+                Log(Debug::Warning) << "Failed to update next tile_id, writes to navmeshdb are disabled: "
+                                    << exception.what();
+            }
+        }
+    }
 
-        Log(Debug::Debug) << "Processing db read job " << job->mId;
+    void DbWorker::processReadingJobs(const std::vector<JobIt>& jobs)
+    {
+        std::vector<JobIt> found;
+        std::vector<TileKey> keys;
 
-        if (job->mInput.empty())
+        for (JobIt job : jobs)
         {
-            Log(Debug::Debug) << "Serializing input for job " << job->mId;
-            if (mWriteToDb)
+            ++mGetTileCount;
+            try
             {
-                const auto objects = makeDbRefGeometryObjects(job->mRecastMesh->getMeshSources(),
-                    [&](const MeshSource& v) { return resolveMeshSource(*mDb, v, mNextShapeId); });
-                job->mInput = serialize(mRecastSettings, job->mAgentBounds, *job->mRecastMesh, objects);
+                if (serializeInput(job))
+                {
+                    found.push_back(job);
+                    keys.push_back(TileKey{ job->mWorldspace, job->mChangedTile, std::cref(job->mInput) });
+                }
             }
-            else
+            catch (const std::exception& e)
             {
-                struct HandleResult
-                {
-                    const RecastSettings& mRecastSettings;
-                    Job& mJob;
+                handleException(job, e);
+            }
+        }
 
-                    bool operator()(const std::vector<DbRefGeometryObject>& objects) const
-                    {
-                        mJob.mInput = serialize(mRecastSettings, mJob.mAgentBounds, *mJob.mRecastMesh, objects);
-                        return true;
-                    }
+        if (!keys.empty())
+        {
+            Log(Debug::Debug) << "Reading " << keys.size() << " db tiles for job " << found.front()->mId;
+            try
+            {
+                std::vector<std::optional<TileData>> tiles = mDb->getTilesData(keys);
+                for (std::size_t i = 0; i < found.size(); ++i)
+                    found[i]->mCachedTileData = std::move(tiles[i]);
+            }
+            catch (const std::exception& e)
+            {
+                handleException(found.front(), e);
+            }
+        }
 
-                    bool operator()(const MeshSource& meshSource) const
-                    {
-                        Log(Debug::Debug) << "No object for mesh source (fileName=\"" << meshSource.mShape->mFileName
-                                          << "\", areaType=" << meshSource.mAreaType
-                                          << ", fileHash=" << Misc::StringUtils::toHex(meshSource.mShape->mFileHash)
-                                          << ") for job " << mJob.mId;
-                        return false;
-                    }
-                };
+        for (JobIt job : jobs)
+        {
+            job->mState = JobState::WithDbResult;
+            mUpdater.enqueueJob(job);
+        }
+    }
 
-                const auto result = makeDbRefGeometryObjects(job->mRecastMesh->getMeshSources(),
-                    [&](const MeshSource& v) { return resolveMeshSource(*mDb, v); });
-                if (!std::visit(HandleResult{ mRecastSettings, *job }, result))
-                    return;
-            }
+    bool DbWorker::serializeInput(JobIt job)
+    {
+        Log(Debug::Debug) << "Processing db read job " << job->mId;
+
+        if (!job->mInput.empty())
+            return true;
+
+        Log(Debug::Debug) << "Serializing input for job " << job->mId;
+        if (mWriteToDb)
+        {
+            const auto objects = makeDbRefGeometryObjects(job->mRecastMesh->getMeshSources(),
+                [&](const MeshSource& v) { return resolveMeshSource(*mDb, v, mNextShapeId); });
+            job->mInput = serialize(mRecastSettings, job->mAgentBounds, *job->mRecastMesh, objects);
+            return true;
         }
 
-        job->mCachedTileData = mDb->getTileData(job->mWorldspace, job->mChangedTile, job->mInput);
+        struct HandleResult
+        {
+            const RecastSettings& mRecastSettings;
+            Job& mJob;
+
+            bool operator()(const std::vector<DbRefGeometryObject>& objects) const
+            {
+                mJob.mInput = serialize(mRecastSettings, mJob.mAgentBounds, *mJob.mRecastMesh, objects);
+                return true;
+            }
+
+            bool operator()(const MeshSource& meshSource) const
+            {
+                Log(Debug::Debug) << "No object for mesh source (fileName=\"" << meshSource.mShape->mFileName
+                                  << "\", areaType=" << meshSource.mAreaType
+                                  << ", fileHash=" << Misc::StringUtils::toHex(meshSource.mShape->mFileHash)
+                                  << ") for job " << mJob.mId;
+                return false;
+            }
+        };
+
+        const auto result = makeDbRefGeometryObjects(
+            job->mRecastMesh->getMeshSources(), [&](const MeshSource& v) { return resolveMeshSource(*mDb, v); });
+        return std::visit(HandleResult{ mRecastSettings, *job }, result);
     }
 
     void DbWorker::processWritingJob(JobIt job)
@@ -1027,6 +1205,13 @@ namespace DetourNavigator
 
         Log(Debug::Debug) << "Processing db write job " << job->mId;
 
+        if (!mTransaction.has_value())
+        {
+            mTransaction.emplace(mDb->startTransaction(Sqlite3::TransactionMode::Immediate));
+            mTransactionStart = std::chrono::steady_clock::now();
+            mTransactionTiles = 0;
+        }
+
         if (job->mInput.empty())
         {
             Log(Debug::Debug) << "Serializing input for job " << job->mId;
@@ -1057,4 +1242,28 @@ namespace DetourNavigator
             serialize(*job->mGeneratedNavMeshData));
         ++mNextTileId;
     }
+
+    std::optional<std::chrono::steady_clock::time_point> DbWorker::getTransactionDeadline() const
+    {
+        if (!mTransaction.has_value())
+            return std::nullopt;
+        return mTransactionStart + mMaxTransactionDuration;
+    }
+
+    bool DbWorker::shouldCommitTransaction() const
+    {
+        return mTransaction.has_value()
+            && (mTransactionTiles >= mMaxTransactionTiles
+                || std::chrono::steady_clock::now() >= mTransactionStart + mMaxTransactionDuration);
+    }
+
+    void DbWorker::commitTransaction()
+    {
+        if (!mTransaction.has_value())
+            return;
+        Log(Debug::Debug) << "Commit " << mTransactionTiles << " db tiles";
+        std::optional<Sqlite3::Transaction> transaction = std::move(mTransaction);
+        mTransaction.reset();
+        transaction->commit();
+    }
 }
@@ -3,6 +3,7 @@
 
 #include "agentbounds.hpp"
 #include "changetype.hpp"
+#include "compactheightfieldcache.hpp"
 #include "guardednavmeshcacheitem.hpp"
 #include "navmeshcacheitem.hpp"
 #include "navmeshdb.hpp"
@@ -21,14 +22,17 @@
 #include <chrono>
 #include <condition_variable>
 #include <deque>
+#include <exception>
 #include <iosfwd>
 #include <list>
 #include <memory>
 #include <mutex>
 #include <optional>
 #include <set>
+#include <span>
 #include <thread>
 #include <tuple>
+#include <vector>
 
 class dtNavMesh;
 
@@ -59,6 +63,9 @@ namespace DetourNavigator
         std::shared_ptr<RecastMesh> mRecastMesh;
         std::optional<TileData> mCachedTileData;
         std::unique_ptr<PreparedNavMeshData> mGeneratedNavMeshData;
+        // Number of path requests that wanted the tile since the job is posted
+        std::size_t mDemand = 0;
+        std::chrono::steady_clock::time_point mFirstDemandTime;
 
         Job(const AgentBounds& agentBounds, std::weak_ptr<GuardedNavMeshCacheItem> navMeshCacheItem,
             ESM::RefId worldspace, const TilePosition& changedTile, ChangeType changeType,
@@ -67,11 +74,16 @@ namespace DetourNavigator
 
     using JobIt = std::list<Job>::iterator;
 
+    /// @brief Orders jobs by the distance from their tile to the player.
+    /// @par A tile wanted by path requests is taken before closer tiles when its distance divided by the number of
+    /// requests is smaller, so actors far from the player don't wait for the whole area around the player to be built.
     class SpatialJobQueue
     {
     public:
         std::size_t size() const { return mSize; }
 
+        std::size_t getDemandedTiles() const { return mDemanded.size(); }
+
         void clear();
 
         void push(JobIt job);
@@ -80,6 +92,9 @@ namespace DetourNavigator
 
         void update(TilePosition playerTile, int maxTiles, std::vector<JobIt>& removing);
 
+        void demand(const AgentBounds& agentBounds, const TilePosition& tilePosition,
+            std::chrono::steady_clock::time_point now);
+
     private:
         using IndexPoint = boost::geometry::model::point<int, 2, boost::geometry::cs::cartesian>;
         using UpdatingMap = std::map<TilePosition, std::deque<JobIt>>;
@@ -88,6 +103,7 @@ namespace DetourNavigator
         std::size_t mSize = 0;
         UpdatingMap mValues;
         boost::geometry::index::rtree<IndexValue, boost::geometry::index::linear<4>> mIndex;
+        std::set<TilePosition> mDemanded;
     };
 
     class JobQueue
@@ -99,6 +115,7 @@ namespace DetourNavigator
                 .mRemoving = mRemoving.size(),
                 .mUpdating = mUpdating.size(),
                 .mDelayed = mDelayed.size(),
+                .mDemanded = mUpdating.getDemandedTiles(),
             };
         }
 
@@ -114,6 +131,9 @@ namespace DetourNavigator
         void update(TilePosition playerTile, int maxTiles,
             std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now());
 
+        void demand(const AgentBounds& agentBounds, const TilePosition& tilePosition,
+            std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now());
+
     private:
         std::vector<JobIt> mRemoving;
         SpatialJobQueue mUpdating;
@@ -134,7 +154,11 @@ namespace DetourNavigator
     public:
         void push(JobIt job);
 
-        std::optional<JobIt> pop();
+        // Waits for a job until the deadline if it's given
+        std::optional<JobIt> pop(std::optional<std::chrono::steady_clock::time_point> deadline = std::nullopt);
+
+        // Pops up to maxCount reading jobs closest to the player without waiting for them
+        void popReading(std::size_t maxCount, std::vector<JobIt>& jobs);
 
         void update(TilePosition playerTile);
 
@@ -157,7 +181,7 @@ namespace DetourNavigator
     {
     public:
         DbWorker(AsyncNavMeshUpdater& updater, std::unique_ptr<NavMeshDb>&& db, TileVersion version,
-            const RecastSettings& recastSettings, bool writeToDb);
+            const Settings& settings);
 
         ~DbWorker();
 
@@ -174,7 +198,13 @@ namespace DetourNavigator
         const RecastSettings& mRecastSettings;
         const std::unique_ptr<NavMeshDb> mDb;
         const TileVersion mVersion;
+        const std::size_t mMaxTransactionTiles;
+        const std::chrono::milliseconds mMaxTransactionDuration;
         bool mWriteToDb;
+        // Tiles are written in transactions grouping up to mMaxTransactionTiles for at most mMaxTransactionDuration
+        std::optional<Sqlite3::Transaction> mTransaction;
+        std::chrono::steady_clock::time_point mTransactionStart;
+        std::size_t mTransactionTiles = 0;
         TileId mNextTileId;
         ShapeId mNextShapeId;
         DbJobQueue mQueue;
@@ -186,9 +216,19 @@ namespace DetourNavigator
 
         inline void processJob(JobIt job);
 
-        inline void processReadingJob(JobIt job);
+        inline void processReadingJobs(const std::vector<JobIt>& jobs);
+
+        inline bool serializeInput(JobIt job);
+
+        inline void handleException(JobIt job, const std::exception& e);
 
         inline void processWritingJob(JobIt job);
+
+        inline std::optional<std::chrono::steady_clock::time_point> getTransactionDeadline() const;
+
+        inline bool shouldCommitTransaction() const;
+
+        inline void commitTransaction();
     };
 
     class AsyncNavMeshUpdater
@@ -206,6 +246,9 @@ namespace DetourNavigator
 
         void stop();
 
+        /// Raise the priority of the jobs for the tiles a path request goes through
+        void demand(const AgentBounds& agentBounds, std::span<const TilePosition> tiles);
+
         AsyncNavMeshUpdaterStats getStats() const;
 
         void enqueueJob(JobIt job);
@@ -226,12 +269,15 @@ namespace DetourNavigator
         std::set<std::tuple<AgentBounds, TilePosition>> mPushed;
         Misc::ScopeGuarded<TilePosition> mPlayerTile;
         NavMeshTilesCache mNavMeshTilesCache;
+        CompactHeightfieldCache mCompactHeightfieldCache;
         Misc::ScopeGuarded<std::set<std::tuple<AgentBounds, TilePosition>>> mProcessingTiles;
         std::map<std::tuple<AgentBounds, TilePosition>, std::chrono::steady_clock::time_point> mLastUpdates;
         std::set<std::tuple<AgentBounds, TilePosition>> mPresentTiles;
         std::vector<std::thread> mThreads;
         std::unique_ptr<DbWorker> mDbWorker;
         std::atomic_size_t mDbGetTileHits{ 0 };
+        std::size_t mDemandedJobs = 0;
+        std::chrono::steady_clock::duration mDemandedJobsLatency{ 0 };
 
         void process() noexcept;
 
@@ -0,0 +1,129 @@
+#include "asyncpathfinder.hpp"
+#include "debug.hpp"
+#include "navigatorutils.hpp"
+#include "settings.hpp"
+#include "settingsutils.hpp"
+
+#include <components/debug/debuglog.hpp>
+
+#include <osg/io_utils>
+
+#include <exception>
+#include <iterator>
+
+namespace DetourNavigator
+{
+    namespace
+    {
+        // Queries starting or ending further apart than this are found separately even within the same tiles
+        constexpr float sMaxSharedDistance = 128.0f;
+
+        bool isEqual(const AreaCosts& lhs, const AreaCosts& rhs)
+        {
+            return lhs.mWater == rhs.mWater && lhs.mDoor == rhs.mDoor && lhs.mPathgrid == rhs.mPathgrid
+                && lhs.mGround == rhs.mGround;
+        }
+    }
+
+    AsyncPathFinder::AsyncPathFinder(const Settings& settings)
+        : mSettings(settings)
+        , mThread([this] { process(); })
+    {
+    }
+
+    AsyncPathFinder::~AsyncPathFinder()
+    {
+        stop();
+    }
+
+    std::shared_ptr<const PathRequest> AsyncPathFinder::request(SharedNavMeshCacheItem navMesh, const PathQuery& query)
+    {
+        const RecastSettings& recast = mSettings.mRecast;
+        auto result = std::make_shared<PathRequest>(query,
+            getTilePosition(recast, toNavMeshCoordinates(recast, query.mStart)),
+            getTilePosition(recast, toNavMeshCoordinates(recast, query.mEnd)));
+
+        if (navMesh == nullptr)
+        {
+            result->complete(Status::NavMeshNotFound, {});
+            return result;
+        }
+
+        result->mNavMesh = std::move(navMesh);
+
+        const std::lock_guard lock(mMutex);
+        if (std::shared_ptr<PathRequest> queued = findQueued(*result))
+            return queued;
+        mQueue.push_back(result);
+        mHasJob.notify_one();
+        return result;
+    }
+
+    void AsyncPathFinder::stop()
+    {
+        {
+            const std::lock_guard lock(mMutex);
+            mShouldStop = true;
+            mQueue.clear();
+        }
+        mHasJob.notify_all();
+        if (mThread.joinable())
+            mThread.join();
+    }
+
+    std::shared_ptr<PathRequest> AsyncPathFinder::findQueued(const PathRequest& request) const
+    {
+        const PathQuery& query = request.mQuery;
+        for (const std::shared_ptr<PathRequest>& queued : mQueue)
+        {
+            const PathQuery& other = queued->mQuery;
+            if (queued->mNavMesh == request.mNavMesh && queued->mStartTile == request.mStartTile
+                && queued->mEndTile == request.mEndTile && other.mAgentBounds == query.mAgentBounds
+                && other.mIncludeFlags == query.mIncludeFlags && other.mEndTolerance == query.mEndTolerance
+                && isEqual(other.mAreaCosts, query.mAreaCosts)
+                && (other.mStart - query.mStart).length2() <= sMaxSharedDistance * sMaxSharedDistance
+                && (other.mEnd - query.mEnd).length2() <= sMaxSharedDistance * sMaxSharedDistance)
+                return queued;
+        }
+        return nullptr;
+    }
+
+    void AsyncPathFinder::process() noexcept
+    {
+        Log(Debug::Debug) << "Start process path requests by thread=" << std::this_thread::get_id();
+        while (true)
+        {
+            std::shared_ptr<PathRequest> request;
+            {
+                std::unique_lock lock(mMutex);
+                mHasJob.wait(lock, [&] { return mShouldStop || !mQueue.empty(); });
+                if (mShouldStop)
+                    break;
+                request = std::move(mQueue.front());
+                mQueue.pop_front();
+            }
+
+            // Nobody waits for the result
+            if (request.use_count() == 1)
+                continue;
+
+            const PathQuery& query = request->mQuery;
+            std::vector<osg::Vec3f> path;
+            Status status = Status::FindPathOverPolygonsFailed;
+            try
+            {
+                status = findPath(*request->mNavMesh, mSettings, query.mAgentBounds, query.mStart, query.mEnd,
+                    query.mIncludeFlags, query.mAreaCosts, query.mEndTolerance, {}, std::back_inserter(path));
+            }
+            catch (const std::exception& e)
+            {
+                Log(Debug::Warning) << "Failed to find path for agent=" << query.mAgentBounds << " from "
+                                    << query.mStart << " to " << query.mEnd << ": " << e.what();
+                path.clear();
+            }
+            request->mNavMesh.reset();
+            request->complete(status, std::move(path));
+        }
+        Log(Debug::Debug) << "Stop process path requests by thread=" << std::this_thread::get_id();
+    }
+}
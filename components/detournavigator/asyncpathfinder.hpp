@@ -0,0 +1,107 @@
+#ifndef OPENMW_COMPONENTS_DETOURNAVIGATOR_ASYNCPATHFINDER_H
+#define OPENMW_COMPONENTS_DETOURNAVIGATOR_ASYNCPATHFINDER_H
+
+#include "agentbounds.hpp"
+#include "areatype.hpp"
+#include "flags.hpp"
+#include "sharednavmeshcacheitem.hpp"
+#include "status.hpp"
+#include "tileposition.hpp"
+
+#include <osg/Vec3f>
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace DetourNavigator
+{
+    struct Settings;
+
+    struct PathQuery
+    {
+        AgentBounds mAgentBounds;
+        osg::Vec3f mStart;
+        osg::Vec3f mEnd;
+        Flags mIncludeFlags;
+        AreaCosts mAreaCosts;
+        float mEndTolerance;
+    };
+
+    /// @brief Result of a path query found by AsyncPathFinder.
+    /// @note getStatus and getPath may be called only after isDone returns true.
+    class PathRequest
+    {
+    public:
+        PathRequest(const PathQuery& query, const TilePosition& startTile, const TilePosition& endTile)
+            : mQuery(query)
+            , mStartTile(startTile)
+            , mEndTile(endTile)
+        {
+        }
+
+        const PathQuery& getQuery() const { return mQuery; }
+
+        bool isDone() const { return mDone.load(std::memory_order_acquire); }
+
+        Status getStatus() const { return mStatus; }
+
+        /// Points in world coordinates
+        const std::vector<osg::Vec3f>& getPath() const { return mPath; }
+
+        void complete(Status status, std::vector<osg::Vec3f>&& path)
+        {
+            mStatus = status;
+            mPath = std::move(path);
+            mDone.store(true, std::memory_order_release);
+        }
+
+    private:
+        friend class AsyncPathFinder;
+
+        const PathQuery mQuery;
+        const TilePosition mStartTile;
+        const TilePosition mEndTile;
+        SharedNavMeshCacheItem mNavMesh;
+        Status mStatus = Status::Success;
+        std::vector<osg::Vec3f> mPath;
+        std::atomic_bool mDone{ false };
+    };
+
+    /// @brief Finds paths over the navmesh in a separate thread.
+    /// @par A query is shared with a queued one for the same agent bounds, flags, area costs and tolerance when both
+    /// start and end in the same tiles close to each other, so a group of actors heading to the same target costs a
+    /// single search. Queries nobody waits for anymore are dropped.
+    class AsyncPathFinder
+    {
+    public:
+        explicit AsyncPathFinder(const Settings& settings);
+
+        ~AsyncPathFinder();
+
+        /// @param navMesh has to be the navmesh for the query agent bounds, a request without navmesh is done with
+        /// Status::NavMeshNotFound
+        std::shared_ptr<const PathRequest> request(SharedNavMeshCacheItem navMesh, const PathQuery& query);
+
+        void stop();
+
+    private:
+        const Settings& mSettings;
+        std::mutex mMutex;
+        std::condition_variable mHasJob;
+        std::deque<std::shared_ptr<PathRequest>> mQueue;
+        bool mShouldStop = false;
+        std::thread mThread;
+
+        std::shared_ptr<PathRequest> findQueued(const PathRequest& request) const;
+
+        void process() noexcept;
+    };
+}
+
+#endif
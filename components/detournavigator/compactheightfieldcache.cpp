@@ -0,0 +1,108 @@
+#include "compactheightfieldcache.hpp"
+#include "recast.hpp"
+#include "recastmesh.hpp"
+
+#include <Recast.h>
+
+#include <tuple>
+#include <vector>
+
+namespace DetourNavigator
+{
+    struct CompactHeightfieldCache::Value
+    {
+        explicit Value(const RecastMesh& recastMesh, const rcCompactHeightfield& compactHeightfield)
+            : mMesh(recastMesh.getMesh())
+            , mWater(recastMesh.getWater())
+            , mHeightfields(recastMesh.getHeightfields())
+            , mFlatHeightfields(recastMesh.getFlatHeightfields())
+        {
+            copyCompactHeightfield(compactHeightfield, mCompactHeightfield);
+        }
+
+        Mesh mMesh;
+        std::vector<CellWater> mWater;
+        std::vector<Heightfield> mHeightfields;
+        std::vector<FlatHeightfield> mFlatHeightfields;
+        rcCompactHeightfield mCompactHeightfield;
+    };
+
+    namespace
+    {
+        bool hasSameGeometry(const Mesh& mesh, const std::vector<CellWater>& water,
+            const std::vector<Heightfield>& heightfields, const std::vector<FlatHeightfield>& flatHeightfields,
+            const RecastMesh& recastMesh)
+        {
+            const auto lhs = std::tie(mesh, water, heightfields, flatHeightfields);
+            const auto rhs = std::tie(recastMesh.getMesh(), recastMesh.getWater(), recastMesh.getHeightfields(),
+                recastMesh.getFlatHeightfields());
+            return !(lhs < rhs) && !(rhs < lhs);
+        }
+    }
+
+    CompactHeightfieldCache::CompactHeightfieldCache(std::size_t maxSize)
+        : mMaxSize(maxSize)
+    {
+    }
+
+    CompactHeightfieldCache::~CompactHeightfieldCache() = default;
+
+    bool CompactHeightfieldCache::get(const AgentBounds& agentBounds, const TilePosition& tilePosition,
+        const RecastMesh& recastMesh, rcCompactHeightfield& result)
+    {
+        std::shared_ptr<const Value> value;
+
+        {
+            const std::lock_guard lock(mMutex);
+            const auto it = mValues.find(std::make_pair(agentBounds, tilePosition));
+            if (it == mValues.end())
+                return false;
+            mItems.splice(mItems.begin(), mItems, it->second);
+            value = it->second->mValue;
+        }
+
+        if (!hasSameGeometry(
+                value->mMesh, value->mWater, value->mHeightfields, value->mFlatHeightfields, recastMesh))
+            return false;
+
+        copyCompactHeightfield(value->mCompactHeightfield, result);
+        return true;
+    }
+
+    void CompactHeightfieldCache::set(const AgentBounds& agentBounds, const TilePosition& tilePosition,
+        const RecastMesh& recastMesh, const rcCompactHeightfield& value)
+    {
+        const std::size_t size = sizeof(Value) + getSize(recastMesh) + getSize(value);
+        if (size > mMaxSize)
+            return;
+
+        auto newValue = std::make_shared<const Value>(recastMesh, value);
+
+        // Values are destructed out of the lock
+        std::vector<std::shared_ptr<const Value>> evicted;
+
+        const std::lock_guard lock(mMutex);
+
+        const auto key = std::make_pair(agentBounds, tilePosition);
+        if (const auto it = mValues.find(key); it != mValues.end())
+        {
+            mUsedSize -= it->second->mSize;
+            evicted.push_back(std::move(it->second->mValue));
+            mItems.erase(it->second);
+            mValues.erase(it);
+        }
+
+        while (!mItems.empty() && mUsedSize + size > mMaxSize)
+        {
+            Item& item = mItems.back();
+            mUsedSize -= item.mSize;
+            evicted.push_back(std::move(item.mValue));
+            mValues.erase(item.mKey);
+            mItems.pop_back();
+        }
+
+        mItems.push_front(Item{ .mKey = key, .mSize = size, .mValue = std::move(newValue) });
+        mValues.emplace(key, mItems.begin());
+        mUsedSize += size;
+    }
+}
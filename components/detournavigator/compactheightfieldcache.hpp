@@ -0,0 +1,59 @@
+#ifndef OPENMW_COMPONENTS_DETOURNAVIGATOR_COMPACTHEIGHTFIELDCACHE_H
+#define OPENMW_COMPONENTS_DETOURNAVIGATOR_COMPACTHEIGHTFIELDCACHE_H
+
+#include "agentbounds.hpp"
+#include "tileposition.hpp"
+
+#include <cstddef>
+#include <list>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <utility>
+
+struct rcCompactHeightfield;
+
+namespace DetourNavigator
+{
+    class RecastMesh;
+
+    /// @brief Keeps compact heightfields of tiles with obstacles rasterized without the obstacles, so moving an
+    /// obstacle only takes to mark its box on a copy of the heightfield instead of rasterizing the whole tile again.
+    /// @par Heightfields are replaced when the rest of the tile geometry changes, least recently used ones are
+    /// evicted to fit into the max size.
+    /// @note Thread safe.
+    class CompactHeightfieldCache
+    {
+    public:
+        explicit CompactHeightfieldCache(std::size_t maxSize);
+
+        ~CompactHeightfieldCache();
+
+        /// Copy the heightfield rasterized for the same geometry of the recast mesh not counting the obstacles
+        /// @return false if there is no such heightfield
+        bool get(const AgentBounds& agentBounds, const TilePosition& tilePosition, const RecastMesh& recastMesh,
+            rcCompactHeightfield& result);
+
+        void set(const AgentBounds& agentBounds, const TilePosition& tilePosition, const RecastMesh& recastMesh,
+            const rcCompactHeightfield& value);
+
+    private:
+        struct Value;
+
+        struct Item
+        {
+            std::pair<AgentBounds, TilePosition> mKey;
+            std::size_t mSize;
+            std::shared_ptr<const Value> mValue;
+        };
+
+        const std::size_t mMaxSize;
+        std::size_t mUsedSize = 0;
+        std::mutex mMutex;
+        // Most recently used first
+        std::list<Item> mItems;
+        std::map<std::pair<AgentBounds, TilePosition>, std::list<Item>::iterator> mValues;
+    };
+}
+
+#endif
@@ -3,6 +3,7 @@
 
 #include "areatype.hpp"
 #include "flags.hpp"
+#include "polygonpathcache.hpp"
 #include "settings.hpp"
 #include "settingsutils.hpp"
 #include "status.hpp"
@@ -82,10 +83,14 @@ namespace DetourNavigator
         const RecastSettings& mSettings;
     };
 
-    inline std::optional<std::size_t> findPolygonPath(const dtNavMeshQuery& navMeshQuery, const dtPolyRef startRef,
-        const dtPolyRef endRef, const osg::Vec3f& startPos, const osg::Vec3f& endPos, const dtQueryFilter& queryFilter,
+    inline std::optional<std::size_t> findPolygonPath(const dtNavMeshQuery& navMeshQuery, PolygonPathCache& pathCache,
+        const dtPolyRef startRef, const dtPolyRef endRef, const osg::Vec3f& startPos, const osg::Vec3f& endPos,
+        const Flags includeFlags, const AreaCosts& areaCosts, const dtQueryFilter& queryFilter,
         std::span<dtPolyRef> pathBuffer)
     {
+        if (const std::optional<std::size_t> cached
+            = pathCache.find(startRef, endRef, includeFlags, areaCosts, pathBuffer))
+            return cached;
         int pathLen = 0;
         const auto status = navMeshQuery.findPath(startRef, endRef, startPos.ptr(), endPos.ptr(), &queryFilter,
             pathBuffer.data(), &pathLen, static_cast<int>(pathBuffer.size()));
@@ -93,7 +98,11 @@ namespace DetourNavigator
             return {};
         assert(pathLen >= 0);
         assert(static_cast<std::size_t>(pathLen) <= pathBuffer.size());
-        return static_cast<std::size_t>(pathLen);
+        const std::size_t pathSize = static_cast<std::size_t>(pathLen);
+        // partial paths depend on start and end positions and can't be reused
+        if (pathSize > 0 && pathBuffer[pathSize - 1] == endRef)
+            pathCache.add(includeFlags, areaCosts, pathBuffer.first(pathSize));
+        return pathSize;
     }
 
     Status makeSmoothPath(const dtNavMeshQuery& navMeshQuery, const osg::Vec3f& start, const osg::Vec3f& end,
@@ -119,10 +128,10 @@ namespace DetourNavigator
         return Status::Success;
     }
 
-    Status findSmoothPath(const dtNavMeshQuery& navMeshQuery, const osg::Vec3f& halfExtents, const osg::Vec3f& start,
-        const osg::Vec3f& end, const Flags includeFlags, const AreaCosts& areaCosts, const DetourSettings& settings,
-        float endTolerance, const ToNavMeshCoordinatesSpan<const osg::Vec3f>& checkpoints,
-        std::output_iterator<osg::Vec3f> auto out)
+    Status findSmoothPath(const dtNavMeshQuery& navMeshQuery, PolygonPathCache& pathCache,
+        const osg::Vec3f& halfExtents, const osg::Vec3f& start, const osg::Vec3f& end, const Flags includeFlags,
+        const AreaCosts& areaCosts, const DetourSettings& settings, float endTolerance,
+        const ToNavMeshCoordinatesSpan<const osg::Vec3f>& checkpoints, std::output_iterator<osg::Vec3f> auto out)
     {
         dtQueryFilter queryFilter;
         queryFilter.setIncludeFlags(includeFlags);
@@ -165,8 +174,9 @@ namespace DetourNavigator
                 dtStatusFailed(status) || checkpointRef == 0)
                 continue;
 
-            const std::optional<std::size_t> toCheckpointPathSize = findPolygonPath(navMeshQuery, currentRef,
-                checkpointRef, currentNavMeshPos, checkpointNavMeshPos, queryFilter, polygonPath);
+            const std::optional<std::size_t> toCheckpointPathSize
+                = findPolygonPath(navMeshQuery, pathCache, currentRef, checkpointRef, currentNavMeshPos,
+                    checkpointNavMeshPos, includeFlags, areaCosts, queryFilter, polygonPath);
 
             if (!toCheckpointPathSize.has_value())
                 continue;
@@ -188,8 +198,8 @@ namespace DetourNavigator
             skipFirst = true;
         }
 
-        const std::optional<std::size_t> toEndPathSize = findPolygonPath(
-            navMeshQuery, currentRef, endRef, currentNavMeshPos, endNavMeshPos, queryFilter, polygonPathBuffer);
+        const std::optional<std::size_t> toEndPathSize = findPolygonPath(navMeshQuery, pathCache, currentRef, endRef,
+            currentNavMeshPos, endNavMeshPos, includeFlags, areaCosts, queryFilter, polygonPathBuffer);
 
         if (!toEndPathSize.has_value())
             return Status::FindPathOverPolygonsFailed;
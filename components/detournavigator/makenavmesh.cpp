@@ -1,4 +1,5 @@
 #include "makenavmesh.hpp"
+#include "compactheightfieldcache.hpp"
 #include "debug.hpp"
 #include "exceptions.hpp"
 #include "flags.hpp"
@@ -440,13 +441,23 @@ namespace DetourNavigator
                 polyMesh.flags[i] = getFlag(static_cast<AreaType>(polyMesh.areas[i]));
         }
 
-        [[nodiscard]] bool fillPolyMesh(RecastContext& context, const RecastSettings& settings,
-            const RecastParams& params, rcHeightfield& solid, rcPolyMesh& polyMesh, rcPolyMeshDetail& polyMeshDetail)
+        void markObstacles(RecastContext& context, const std::vector<Obstacle>& obstacles,
+            const RecastSettings& settings, rcCompactHeightfield& compact)
         {
-            rcCompactHeightfield compact;
-            if (!buildCompactHeightfield(context, params.mWalkableHeight, params.mWalkableClimb, solid, compact))
-                return false;
+            for (const Obstacle& obstacle : obstacles)
+            {
+                // Include the surface the obstacle stands on
+                const osg::Vec3f min
+                    = toNavMeshCoordinates(settings, obstacle.mMin - osg::Vec3f(0, 0, settings.mMaxClimb));
+                const osg::Vec3f max = toNavMeshCoordinates(settings, obstacle.mMax);
+                rcMarkBoxArea(&context, min.ptr(), max.ptr(), AreaType_null, compact);
+            }
+        }
 
+        [[nodiscard]] bool fillPolyMesh(RecastContext& context, const RecastSettings& settings,
+            const RecastParams& params, rcCompactHeightfield& compact, rcPolyMesh& polyMesh,
+            rcPolyMeshDetail& polyMeshDetail)
+        {
             if (!erodeWalkableArea(context, params.mWalkableRadius, compact))
                 return false;
 
@@ -514,33 +525,58 @@ namespace DetourNavigator
 
             return { minZ, maxZ };
         }
+
+        [[nodiscard]] bool makeCompactHeightfield(RecastContext& context, const RecastMesh& recastMesh,
+            const TilePosition& tilePosition, const AgentBounds& agentBounds, const RecastSettings& settings,
+            const RecastParams& params, rcCompactHeightfield& compact)
+        {
+            const auto [minZ, maxZ] = getBoundsByZ(recastMesh, agentBounds.mHalfExtents.z(), settings);
+
+            rcHeightfield solid;
+            if (!initHeightfield(context, tilePosition, toNavMeshCoordinates(settings, minZ),
+                    toNavMeshCoordinates(settings, maxZ), settings, solid))
+                return false;
+
+            if (!rasterizeTriangles(
+                    context, tilePosition, agentBounds.mHalfExtents.z(), recastMesh, settings, params, solid))
+                return false;
+
+            rcFilterLowHangingWalkableObstacles(&context, params.mWalkableClimb, solid);
+            rcFilterLedgeSpans(&context, params.mWalkableHeight, params.mWalkableClimb, solid);
+            rcFilterWalkableLowHeightSpans(&context, params.mWalkableHeight, solid);
+
+            return buildCompactHeightfield(context, params.mWalkableHeight, params.mWalkableClimb, solid, compact);
+        }
     }
 
     std::unique_ptr<PreparedNavMeshData> prepareNavMeshTileData(const RecastMesh& recastMesh, ESM::RefId worldspace,
-        const TilePosition& tilePosition, const AgentBounds& agentBounds, const RecastSettings& settings)
+        const TilePosition& tilePosition, const AgentBounds& agentBounds, const RecastSettings& settings,
+        CompactHeightfieldCache* compactHeightfieldCache)
     {
         RecastContext context(worldspace, tilePosition, agentBounds, recastMesh.getVersion(), settings.mMaxLogLevel);
 
-        const auto [minZ, maxZ] = getBoundsByZ(recastMesh, agentBounds.mHalfExtents.z(), settings);
+        const RecastParams params = makeRecastParams(settings, agentBounds);
 
-        rcHeightfield solid;
-        if (!initHeightfield(context, tilePosition, toNavMeshCoordinates(settings, minZ),
-                toNavMeshCoordinates(settings, maxZ), settings, solid))
-            return nullptr;
+        // Obstacles move often, the rest of the tile is rasterized only when it changes
+        if (recastMesh.getObstacles().empty())
+            compactHeightfieldCache = nullptr;
 
-        const RecastParams params = makeRecastParams(settings, agentBounds);
+        rcCompactHeightfield compact;
+        if (compactHeightfieldCache == nullptr
+            || !compactHeightfieldCache->get(agentBounds, tilePosition, recastMesh, compact))
+        {
+            if (!makeCompactHeightfield(context, recastMesh, tilePosition, agentBounds, settings, params, compact))
+                return nullptr;
 
-        if (!rasterizeTriangles(
-                context, tilePosition, agentBounds.mHalfExtents.z(), recastMesh, settings, params, solid))
-            return nullptr;
+            if (compactHeightfieldCache != nullptr)
+                compactHeightfieldCache->set(agentBounds, tilePosition, recastMesh, compact);
+        }
 
-        rcFilterLowHangingWalkableObstacles(&context, params.mWalkableClimb, solid);
-        rcFilterLedgeSpans(&context, params.mWalkableHeight, params.mWalkableClimb, solid);
-        rcFilterWalkableLowHeightSpans(&context, params.mWalkableHeight, solid);
+        markObstacles(context, recastMesh.getObstacles(), settings, compact);
 
         std::unique_ptr<PreparedNavMeshData> result = std::make_unique<PreparedNavMeshData>();
 
-        if (!fillPolyMesh(context, settings, params, solid, result->mPolyMesh, result->mPolyMeshDetail))
+        if (!fillPolyMesh(context, settings, params, compact, result->mPolyMesh, result->mPolyMeshDetail))
             return nullptr;
 
         result->mCellSize = settings.mCellSize;
@@ -20,6 +20,7 @@ namespace DetourNavigator
     struct OffMeshConnection;
     struct AgentBounds;
     struct RecastSettings;
+    class CompactHeightfieldCache;
 
     inline float getLength(const osg::Vec2i& value)
     {
@@ -43,8 +44,10 @@ namespace DetourNavigator
             && recastMesh.getHeightfields().empty() && recastMesh.getFlatHeightfields().empty();
     }
 
+    /// @param compactHeightfieldCache to reuse the tile heightfield rasterized without obstacles, may be null
     std::unique_ptr<PreparedNavMeshData> prepareNavMeshTileData(const RecastMesh& recastMesh, ESM::RefId worldspace,
-        const TilePosition& tilePosition, const AgentBounds& agentBounds, const RecastSettings& settings);
+        const TilePosition& tilePosition, const AgentBounds& agentBounds, const RecastSettings& settings,
+        CompactHeightfieldCache* compactHeightfieldCache = nullptr);
 
     NavMeshData makeNavMeshTileData(const PreparedNavMeshData& data,
         const std::vector<OffMeshConnection>& offMeshConnections, const AgentBounds& agentBounds,
@@ -20,6 +20,9 @@ namespace DetourNavigator
             try
             {
                 db = std::make_unique<NavMeshDb>(path, settings.mMaxDbFileSize);
+                if (settings.mDbWriteAheadLog
+                    && !db->enableWriteAheadLog(settings.mDbSynchronous, settings.mDbCheckpointInterval))
+                    Log(Debug::Warning) << "Write-ahead log is not supported for " << path;
             }
             catch (const std::exception& e)
             {
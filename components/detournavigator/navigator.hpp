@@ -3,8 +3,10 @@
 
 #include <cassert>
 #include <filesystem>
+#include <memory>
 #include <optional>
 
+#include "asyncpathfinder.hpp"
 #include "cellgridbounds.hpp"
 #include "heightfieldshape.hpp"
 #include "objectid.hpp"
@@ -184,6 +186,13 @@ namespace DetourNavigator
          */
         virtual SharedNavMeshCacheItem getNavMesh(const AgentBounds& agentBounds) const = 0;
 
+        /**
+         * @brief requestPath starts to find a path in a background thread.
+         * @return request to poll for the result, it is done with Status::NavMeshNotFound if there is no navmesh for
+         * the query agent bounds
+         */
+        virtual std::shared_ptr<const PathRequest> requestPath(const PathQuery& query) = 0;
+
         /**
          * @brief getNavMeshes returns all current navmeshes
          * @return map of agent half extents to navmesh
@@ -7,11 +7,15 @@
 #include <components/misc/convert.hpp>
 #include <components/misc/coordinateconverter.hpp>
 
+#include <array>
+#include <span>
+
 namespace DetourNavigator
 {
     NavigatorImpl::NavigatorImpl(const Settings& settings, std::unique_ptr<NavMeshDb>&& db)
         : mSettings(settings)
         , mNavMeshManager(mSettings, std::move(db))
+        , mAsyncPathFinder(mSettings)
     {
     }
 
@@ -160,6 +164,18 @@ namespace DetourNavigator
         return mNavMeshManager.getNavMesh(agentBounds);
     }
 
+    std::shared_ptr<const PathRequest> NavigatorImpl::requestPath(const PathQuery& query)
+    {
+        // Missing or outdated tiles at the ends of the path go before the ones closer to the player
+        const std::array tiles{
+            getTilePosition(mSettings.mRecast, toNavMeshCoordinates(mSettings.mRecast, query.mStart)),
+            getTilePosition(mSettings.mRecast, toNavMeshCoordinates(mSettings.mRecast, query.mEnd)),
+        };
+        mNavMeshManager.demand(
+            query.mAgentBounds, std::span<const TilePosition>(tiles.data(), tiles[0] == tiles[1] ? 1 : 2));
+        return mAsyncPathFinder.request(mNavMeshManager.getNavMesh(query.mAgentBounds), query);
+    }
+
     std::map<AgentBounds, SharedNavMeshCacheItem> NavigatorImpl::getNavMeshes() const
     {
         return mNavMeshManager.getNavMeshes();
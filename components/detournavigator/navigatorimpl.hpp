@@ -1,6 +1,7 @@
 #ifndef OPENMW_COMPONENTS_DETOURNAVIGATOR_NAVIGATORIMPL_H
 #define OPENMW_COMPONENTS_DETOURNAVIGATOR_NAVIGATORIMPL_H
 
+#include "asyncpathfinder.hpp"
 #include "navigator.hpp"
 #include "navmeshmanager.hpp"
 #include "updateguard.hpp"
@@ -63,6 +64,8 @@ namespace DetourNavigator
 
         SharedNavMeshCacheItem getNavMesh(const AgentBounds& agentBounds) const override;
 
+        std::shared_ptr<const PathRequest> requestPath(const PathQuery& query) override;
+
         std::map<AgentBounds, SharedNavMeshCacheItem> getNavMeshes() const override;
 
         const Settings& getSettings() const override;
@@ -76,6 +79,7 @@ namespace DetourNavigator
     private:
         Settings mSettings;
         NavMeshManager mNavMeshManager;
+        AsyncPathFinder mAsyncPathFinder;
         std::optional<TilePosition> mLastPlayerPosition;
         std::map<AgentBounds, std::size_t> mAgents;
         std::unordered_map<ObjectId, ObjectId> mAvoidIds;
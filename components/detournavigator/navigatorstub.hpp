@@ -78,6 +78,13 @@ namespace DetourNavigator
             return mEmptyNavMeshCacheItem;
         }
 
+        std::shared_ptr<const PathRequest> requestPath(const PathQuery& query) override
+        {
+            auto result = std::make_shared<PathRequest>(query, TilePosition(), TilePosition());
+            result->complete(Status::NavMeshNotFound, {});
+            return result;
+        }
+
         std::map<AgentBounds, SharedNavMeshCacheItem> getNavMeshes() const override { return {}; }
 
         const Settings& getSettings() const override { return mDefaultSettings; }
@@ -9,12 +9,41 @@
 
 #include <components/misc/guarded.hpp>
 
+#include <chrono>
 #include <iterator>
 #include <optional>
 #include <span>
 
 namespace DetourNavigator
 {
+    /**
+     * @brief findPath fills output iterator with points of scene surfaces to be used for actor to walk through.
+     * @param navMesh is used to find the path, has to be built for the agentBounds.
+     * @param agentBounds defines which navmesh to use.
+     * @param start path from given point.
+     * @param end path at given point.
+     * @param includeFlags setup allowed navmesh areas.
+     * @param out the beginning of the destination range.
+     * @param endTolerance defines maximum allowed distance to end path point in addition to agentHalfExtents.
+     * @param checkpoints is a sequence of positions the path should go over if possible.
+     * @return Status.
+     */
+    inline Status findPath(GuardedNavMeshCacheItem& navMesh, const Settings& settings, const AgentBounds& agentBounds,
+        const osg::Vec3f& start, const osg::Vec3f& end, const Flags includeFlags, const AreaCosts& areaCosts,
+        float endTolerance, std::span<const osg::Vec3f> checkpoints, std::output_iterator<osg::Vec3f> auto out)
+    {
+        FromNavMeshCoordinatesIterator outTransform(out, settings.mRecast);
+        const auto locked = navMesh.lock();
+        const auto startedAt = std::chrono::steady_clock::now();
+        const Status status = findSmoothPath(locked->getQuery(), locked->getPathCache(),
+            toNavMeshCoordinates(settings.mRecast, agentBounds.mHalfExtents),
+            toNavMeshCoordinates(settings.mRecast, start), toNavMeshCoordinates(settings.mRecast, end), includeFlags,
+            areaCosts, settings.mDetour, endTolerance, ToNavMeshCoordinatesSpan(checkpoints, settings.mRecast),
+            outTransform);
+        locked->getPathCache().reportQuery(std::chrono::steady_clock::now() - startedAt);
+        return status;
+    }
+
     /**
      * @brief findPath fills output iterator with points of scene surfaces to be used for actor to walk through.
      * @param agentBounds defines which navmesh to use.
@@ -33,13 +62,8 @@ namespace DetourNavigator
         const auto navMesh = navigator.getNavMesh(agentBounds);
         if (navMesh == nullptr)
             return Status::NavMeshNotFound;
-        const Settings& settings = navigator.getSettings();
-        FromNavMeshCoordinatesIterator outTransform(out, settings.mRecast);
-        const auto locked = navMesh->lock();
-        return findSmoothPath(locked->getQuery(), toNavMeshCoordinates(settings.mRecast, agentBounds.mHalfExtents),
-            toNavMeshCoordinates(settings.mRecast, start), toNavMeshCoordinates(settings.mRecast, end), includeFlags,
-            areaCosts, settings.mDetour, endTolerance, ToNavMeshCoordinatesSpan(checkpoints, settings.mRecast),
-            outTransform);
+        return findPath(*navMesh, navigator.getSettings(), agentBounds, start, end, includeFlags, areaCosts,
+            endTolerance, checkpoints, out);
     }
 
     /**
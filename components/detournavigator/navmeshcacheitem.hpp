@@ -3,6 +3,7 @@
 
 #include "navmeshdata.hpp"
 #include "navmeshtilescache.hpp"
+#include "polygonpathcache.hpp"
 #include "tileposition.hpp"
 #include "version.hpp"
 
@@ -114,6 +115,10 @@ namespace DetourNavigator
 
         const Version& getVersion() const { return mVersion; }
 
+        PolygonPathCache& getPathCache() { return mPathCache; }
+
+        const PolygonPathCache& getPathCache() const { return mPathCache; }
+
         UpdateNavMeshStatus updateTile(
             const TilePosition& position, NavMeshTilesCache::Value&& cached, NavMeshData&& navMeshData);
 
@@ -153,6 +158,7 @@ namespace DetourNavigator
         dtNavMeshQuery mQuery;
         std::map<TilePosition, Tile> mUsedTiles;
         std::set<TilePosition> mEmptyTiles;
+        PolygonPathCache mPathCache;
     };
 }
 
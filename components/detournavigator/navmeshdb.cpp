@@ -4,14 +4,22 @@
 #include <components/misc/compression.hpp>
 #include <components/sqlite3/db.hpp>
 #include <components/sqlite3/request.hpp>
+#include <components/sqlite3/transaction.hpp>
 
 #include <DetourAlloc.h>
 
 #include <sqlite3.h>
 
+#include <algorithm>
 #include <cstddef>
 #include <format>
+#include <iterator>
+#include <memory>
+#include <stdexcept>
+#include <string>
 #include <string_view>
+#include <tuple>
+#include <type_traits>
 #include <vector>
 
 namespace DetourNavigator
@@ -73,6 +81,22 @@ namespace DetourNavigator
                AND input = :input
         )";
 
+        std::string makeGetTilesDataQuery()
+        {
+            std::string result = R"(
+            SELECT worldspace, tile_position_x, tile_position_y, input, tile_id, version, data
+              FROM tiles
+             WHERE (worldspace, tile_position_x, tile_position_y, input) IN (VALUES )";
+            for (std::size_t i = 0; i < NavMeshDb::sTilesDataBatchSize; ++i)
+            {
+                if (i > 0)
+                    result += ", ";
+                result += std::format("(?{}, ?{}, ?{}, ?{})", 4 * i + 1, 4 * i + 2, 4 * i + 3, 4 * i + 4);
+            }
+            result += ")";
+            return result;
+        }
+
         constexpr std::string_view insertTileQuery = R"(
             INSERT INTO tiles ( tile_id,  worldspace,  version,  tile_position_x,  tile_position_y,  input,  data)
                    VALUES     (:tile_id, :worldspace, :version, :tile_position_x, :tile_position_y, :input, :data)
@@ -132,6 +156,42 @@ namespace DetourNavigator
             VACUUM;
         )";
 
+        constexpr std::string_view attachMergedDbQuery = R"(
+            ATTACH DATABASE :path AS merged
+        )";
+
+        constexpr std::string_view detachMergedDbQuery = R"(
+            DETACH DATABASE merged
+        )";
+
+        constexpr std::string_view countConflictingMergedShapesQuery = R"(
+            SELECT (SELECT count(*)
+                      FROM merged.shapes AS m
+                      JOIN shapes AS s ON s.shape_id = m.shape_id
+                     WHERE s.name != m.name OR s.type != m.type OR s.hash != m.hash)
+                 + (SELECT count(*)
+                      FROM merged.shapes AS m
+                      JOIN shapes AS s ON s.name = m.name AND s.type = m.type AND s.hash = m.hash
+                     WHERE s.shape_id != m.shape_id)
+        )";
+
+        constexpr std::string_view insertMergedShapesQuery = R"(
+            INSERT OR IGNORE INTO shapes (shape_id, name, type, hash)
+                 SELECT shape_id, name, type, hash FROM merged.shapes
+        )";
+
+        constexpr std::string_view insertMergedTilesQuery = R"(
+            INSERT INTO tiles (tile_id, worldspace, tile_position_x, tile_position_y, version, input, data)
+                 SELECT tile_id + :tile_id_offset, worldspace, tile_position_x, tile_position_y, version, input, data
+                   FROM merged.tiles
+                  WHERE true
+            ON CONFLICT (worldspace, tile_position_x, tile_position_y, input)
+                DO UPDATE SET version = excluded.version,
+                              data = excluded.data,
+                              revision = revision + 1
+                        WHERE version != excluded.version OR data != excluded.data
+        )";
+
         struct GetPageSize
         {
             static std::string_view text() noexcept { return "pragma page_size;"; }
@@ -146,12 +206,105 @@ namespace DetourNavigator
             return value;
         }
 
+        struct AttachMergedDb
+        {
+            static std::string_view text() noexcept { return attachMergedDbQuery; }
+            static void bind(sqlite3& db, sqlite3_stmt& statement, std::string_view path)
+            {
+                Sqlite3::bindParameter(db, statement, ":path", path);
+            }
+        };
+
+        struct DetachMergedDb
+        {
+            static std::string_view text() noexcept { return detachMergedDbQuery; }
+            static void bind(sqlite3&, sqlite3_stmt&) {}
+        };
+
+        struct CountConflictingMergedShapes
+        {
+            static std::string_view text() noexcept { return countConflictingMergedShapesQuery; }
+            static void bind(sqlite3&, sqlite3_stmt&) {}
+        };
+
+        struct InsertMergedShapes
+        {
+            static std::string_view text() noexcept { return insertMergedShapesQuery; }
+            static void bind(sqlite3&, sqlite3_stmt&) {}
+        };
+
+        struct InsertMergedTiles
+        {
+            static std::string_view text() noexcept { return insertMergedTilesQuery; }
+            static void bind(sqlite3& db, sqlite3_stmt& statement, TileId tileIdOffset)
+            {
+                Sqlite3::bindParameter(db, statement, ":tile_id_offset", tileIdOffset);
+            }
+        };
+
+        class MergedDbGuard
+        {
+        public:
+            explicit MergedDbGuard(sqlite3& db, std::string_view path)
+                : mDb(db)
+            {
+                Sqlite3::Statement<AttachMergedDb> statement(mDb);
+                execute(mDb, statement, path);
+            }
+
+            ~MergedDbGuard()
+            {
+                try
+                {
+                    Sqlite3::Statement<DetachMergedDb> statement(mDb);
+                    execute(mDb, statement);
+                }
+                catch (const std::exception& e)
+                {
+                    Log(Debug::Error) << "Failed to detach merged navmeshdb: " << e.what();
+                }
+            }
+
+        private:
+            sqlite3& mDb;
+        };
+
         void setMaxPageCount(sqlite3& db, std::uint64_t value)
         {
             const auto query = std::format("pragma max_page_count = {};", value);
             if (const int ec = sqlite3_exec(&db, query.c_str(), nullptr, nullptr, nullptr); ec != SQLITE_OK)
                 throw std::runtime_error("Failed set max page count: " + std::string(sqlite3_errmsg(&db)));
         }
+
+        struct SetWalJournalMode
+        {
+            static std::string_view text() noexcept { return "pragma journal_mode = wal;"; }
+            static void bind(sqlite3&, sqlite3_stmt&) {}
+        };
+
+        // Returns the journal mode actually set
+        std::string setWalJournalMode(sqlite3& db)
+        {
+            Sqlite3::Statement<SetWalJournalMode> statement(db);
+            std::string value;
+            request(db, statement, &value, 1);
+            return value;
+        }
+
+        void setSynchronous(sqlite3& db, Sqlite3::Synchronous value)
+        {
+            const auto query = std::format(
+                "pragma synchronous = {};", static_cast<std::underlying_type_t<Sqlite3::Synchronous>>(value));
+            if (const int ec = sqlite3_exec(&db, query.c_str(), nullptr, nullptr, nullptr); ec != SQLITE_OK)
+                throw std::runtime_error("Failed set synchronous: " + std::string(sqlite3_errmsg(&db)));
+        }
+
+        void setWalAutocheckpoint(sqlite3& db, int pages)
+        {
+            const auto query = std::format("pragma wal_autocheckpoint = {};", pages);
+            if (const int ec = sqlite3_exec(&db, query.c_str(), nullptr, nullptr, nullptr); ec != SQLITE_OK)
+                throw std::runtime_error("Failed set wal autocheckpoint: " + std::string(sqlite3_errmsg(&db)));
+        }
     }
 
     std::ostream& operator<<(std::ostream& stream, ShapeType value)
@@ -171,6 +324,7 @@ namespace DetourNavigator
         , mGetMaxTileId(*mDb, DbQueries::GetMaxTileId{})
         , mFindTile(*mDb, DbQueries::FindTile{})
         , mGetTileData(*mDb, DbQueries::GetTileData{})
+        , mGetTilesData(*mDb, DbQueries::GetTilesData{})
         , mInsertTile(*mDb, DbQueries::InsertTile{})
         , mUpdateTile(*mDb, DbQueries::UpdateTile{})
         , mDeleteTilesAt(*mDb, DbQueries::DeleteTilesAt{})
@@ -187,6 +341,19 @@ namespace DetourNavigator
         setMaxPageCount(*mDb, maxFileSize / dbPageSize + static_cast<std::uint64_t>((maxFileSize % dbPageSize) != 0));
     }
 
+    bool NavMeshDb::enableWriteAheadLog(Sqlite3::Synchronous synchronous, std::chrono::milliseconds checkpointInterval)
+    {
+        if (setWalJournalMode(*mDb) != "wal")
+            return false;
+        setSynchronous(*mDb, synchronous);
+        if (checkpointInterval == std::chrono::milliseconds::zero())
+            return true;
+        setWalAutocheckpoint(*mDb, 0);
+        mCheckpointer
+            = std::make_unique<Sqlite3::Checkpointer>(sqlite3_db_filename(mDb.get(), "main"), checkpointInterval);
+        return true;
+    }
+
     Sqlite3::Transaction NavMeshDb::startTransaction(Sqlite3::TransactionMode mode)
     {
         return Sqlite3::Transaction(*mDb, mode);
@@ -222,6 +389,52 @@ namespace DetourNavigator
         return result;
     }
 
+    std::vector<std::optional<TileData>> NavMeshDb::getTilesData(std::span<const TileKey> keys)
+    {
+        using Row = std::tuple<std::string, int, int, std::vector<std::byte>, TileId, TileVersion,
+            std::vector<std::byte>>;
+
+        std::vector<std::optional<TileData>> result(keys.size());
+        std::vector<std::string> worldspaces;
+        std::vector<TilePosition> tilePositions;
+        std::vector<std::vector<std::byte>> compressedInputs;
+        std::vector<Row> rows;
+
+        for (std::size_t begin = 0; begin < keys.size(); begin += sTilesDataBatchSize)
+        {
+            const std::size_t end = std::min(begin + sTilesDataBatchSize, keys.size());
+
+            worldspaces.clear();
+            tilePositions.clear();
+            compressedInputs.clear();
+            for (std::size_t i = begin; i < end; ++i)
+            {
+                worldspaces.push_back(keys[i].mWorldspace.serializeText());
+                tilePositions.push_back(keys[i].mTilePosition);
+                compressedInputs.push_back(Misc::compress(keys[i].mInput.get()));
+            }
+
+            rows.clear();
+            request(*mDb, mGetTilesData, std::back_inserter(rows), end - begin, std::span(worldspaces),
+                std::span(tilePositions), std::span(compressedInputs));
+
+            for (Row& row : rows)
+            {
+                auto& [worldspace, x, y, input, tileId, version, data] = row;
+                for (std::size_t i = begin; i < end; ++i)
+                {
+                    const std::size_t index = i - begin;
+                    if (worldspaces[index] != worldspace || tilePositions[index] != TilePosition(x, y)
+                        || compressedInputs[index] != input)
+                        continue;
+                    result[i] = TileData{ tileId, version, Misc::decompress(data) };
+                }
+            }
+        }
+
+        return result;
+    }
+
     int NavMeshDb::insertTile(TileId tileId, ESM::RefId worldspace, const TilePosition& tilePosition,
         TileVersion version, const std::vector<std::byte>& input, const std::vector<std::byte>& data)
     {
@@ -272,6 +485,25 @@ namespace DetourNavigator
         return execute(*mDb, mInsertShape, shapeId, name, type, hash);
     }
 
+    int NavMeshDb::mergeFrom(std::string_view path)
+    {
+        const MergedDbGuard guard(*mDb, path);
+        // statements using merged db have to be finalized before it is detached
+        Sqlite3::Statement<CountConflictingMergedShapes> countConflictingShapes(*mDb);
+        Sqlite3::Statement<InsertMergedShapes> insertShapes(*mDb);
+        Sqlite3::Statement<InsertMergedTiles> insertTiles(*mDb);
+        Sqlite3::Transaction transaction(*mDb, Sqlite3::TransactionMode::Immediate);
+        std::int64_t conflictingShapes = 0;
+        request(*mDb, countConflictingShapes, &conflictingShapes, 1);
+        if (conflictingShapes != 0)
+            throw std::runtime_error("Navmeshdb \"" + std::string(path) + "\" has " + std::to_string(conflictingShapes)
+                + " shapes with ids different from the target db");
+        execute(*mDb, insertShapes);
+        const int result = execute(*mDb, insertTiles, getMaxTileId());
+        transaction.commit();
+        return result;
+    }
+
     void NavMeshDb::vacuum()
     {
         execute(*mDb, mVacuum);
@@ -312,6 +544,27 @@ namespace DetourNavigator
             Sqlite3::bindParameter(db, statement, ":input", input);
         }
 
+        std::string_view GetTilesData::text() noexcept
+        {
+            static const std::string query = makeGetTilesDataQuery();
+            return query;
+        }
+
+        void GetTilesData::bind(sqlite3& db, sqlite3_stmt& statement, std::span<const std::string> worldspaces,
+            std::span<const TilePosition> tilePositions, std::span<const std::vector<std::byte>> inputs)
+        {
+            // unused parameters are bound to the first key, it does not produce additional rows
+            for (std::size_t i = 0; i < NavMeshDb::sTilesDataBatchSize; ++i)
+            {
+                const std::size_t key = i < worldspaces.size() ? i : 0;
+                const int index = static_cast<int>(4 * i);
+                Sqlite3::bindParameter(db, statement, index + 1, std::string_view(worldspaces[key]));
+                Sqlite3::bindParameter(db, statement, index + 2, tilePositions[key].x());
+                Sqlite3::bindParameter(db, statement, index + 3, tilePositions[key].y());
+                Sqlite3::bindParameter(db, statement, index + 4, inputs[key]);
+            }
+        }
+
         std::string_view InsertTile::text() noexcept
         {
             return insertTileQuery;
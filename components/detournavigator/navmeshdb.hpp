@@ -6,14 +6,20 @@
 
 #include <components/esm/refid.hpp>
 #include <components/misc/strongtypedef.hpp>
+#include <components/sqlite3/checkpointer.hpp>
 #include <components/sqlite3/db.hpp>
 #include <components/sqlite3/statement.hpp>
 #include <components/sqlite3/transaction.hpp>
 #include <components/sqlite3/types.hpp>
 
+#include <chrono>
 #include <cstddef>
 #include <cstdint>
+#include <functional>
+#include <memory>
 #include <optional>
+#include <span>
+#include <string>
 #include <string_view>
 #include <vector>
 
@@ -40,6 +46,13 @@ namespace DetourNavigator
         std::vector<std::byte> mData;
     };
 
+    struct TileKey
+    {
+        ESM::RefId mWorldspace;
+        TilePosition mTilePosition;
+        std::reference_wrapper<const std::vector<std::byte>> mInput;
+    };
+
     enum class ShapeType
     {
         Collision = 1,
@@ -70,6 +83,13 @@ namespace DetourNavigator
                 const TilePosition& tilePosition, const std::vector<std::byte>& input);
         };
 
+        struct GetTilesData
+        {
+            static std::string_view text() noexcept;
+            static void bind(sqlite3& db, sqlite3_stmt& statement, std::span<const std::string> worldspaces,
+                std::span<const TilePosition> tilePositions, std::span<const std::vector<std::byte>> inputs);
+        };
+
         struct InsertTile
         {
             static std::string_view text() noexcept;
@@ -138,6 +158,11 @@ namespace DetourNavigator
     public:
         explicit NavMeshDb(std::string_view path, std::uint64_t maxFileSize);
 
+        // Switches to the write-ahead log journal mode so readers don't block the writer and commits don't sync the
+        // database file. The log is checkpointed by a separate thread every checkpointInterval, or on commits when
+        // it's zero. Returns false if the database doesn't support it like an in-memory one.
+        bool enableWriteAheadLog(Sqlite3::Synchronous synchronous, std::chrono::milliseconds checkpointInterval);
+
         Sqlite3::Transaction startTransaction(Sqlite3::TransactionMode mode = Sqlite3::TransactionMode::Default);
 
         TileId getMaxTileId();
@@ -148,6 +173,12 @@ namespace DetourNavigator
         std::optional<TileData> getTileData(
             ESM::RefId worldspace, const TilePosition& tilePosition, const std::vector<std::byte>& input);
 
+        // Number of tiles requested by a single query in getTilesData
+        static constexpr std::size_t sTilesDataBatchSize = 16;
+
+        // Returns data for each key in the same order, fetches multiple tiles per query.
+        std::vector<std::optional<TileData>> getTilesData(std::span<const TileKey> keys);
+
         int insertTile(TileId tileId, ESM::RefId worldspace, const TilePosition& tilePosition, TileVersion version,
             const std::vector<std::byte>& input, const std::vector<std::byte>& data);
 
@@ -165,6 +196,11 @@ namespace DetourNavigator
 
         int insertShape(ShapeId shapeId, std::string_view name, ShapeType type, const Sqlite3::ConstBlob& hash);
 
+        // Copies shapes and tiles from other navmeshdb overriding tiles with the same input. Tile inputs refer to
+        // shapes by id so both databases must use the same ids for the same shapes, otherwise throws
+        // std::runtime_error. Returns number of inserted or updated tiles.
+        int mergeFrom(std::string_view path);
+
         void vacuum();
 
     private:
@@ -172,6 +208,7 @@ namespace DetourNavigator
         Sqlite3::Statement<DbQueries::GetMaxTileId> mGetMaxTileId;
         Sqlite3::Statement<DbQueries::FindTile> mFindTile;
         Sqlite3::Statement<DbQueries::GetTileData> mGetTileData;
+        Sqlite3::Statement<DbQueries::GetTilesData> mGetTilesData;
         Sqlite3::Statement<DbQueries::InsertTile> mInsertTile;
         Sqlite3::Statement<DbQueries::UpdateTile> mUpdateTile;
         Sqlite3::Statement<DbQueries::DeleteTilesAt> mDeleteTilesAt;
@@ -181,6 +218,7 @@ namespace DetourNavigator
         Sqlite3::Statement<DbQueries::FindShapeId> mFindShapeId;
         Sqlite3::Statement<DbQueries::InsertShape> mInsertShape;
         Sqlite3::Statement<DbQueries::Vacuum> mVacuum;
+        std::unique_ptr<Sqlite3::Checkpointer> mCheckpointer;
     };
 }
 
@@ -239,6 +239,11 @@ namespace DetourNavigator
         mAsyncNavMeshUpdater.wait(waitConditionType, listener);
     }
 
+    void NavMeshManager::demand(const AgentBounds& agentBounds, std::span<const TilePosition> tiles)
+    {
+        mAsyncNavMeshUpdater.demand(agentBounds, tiles);
+    }
+
     SharedNavMeshCacheItem NavMeshManager::getNavMesh(const AgentBounds& agentBounds) const
     {
         return getCached(agentBounds);
@@ -251,9 +256,19 @@ namespace DetourNavigator
 
     Stats NavMeshManager::getStats() const
     {
+        PathQueryStats pathQuery;
+        for (const auto& [agentBounds, cached] : mCache)
+        {
+            const PathQueryStats itemStats = cached->lockConst()->getPathCache().getStats();
+            pathQuery.mCount += itemStats.mCount;
+            pathQuery.mDuration += itemStats.mDuration;
+            pathQuery.mCacheGetCount += itemStats.mCacheGetCount;
+            pathQuery.mCacheHitCount += itemStats.mCacheHitCount;
+        }
         return Stats{
             .mUpdater = mAsyncNavMeshUpdater.getStats(),
             .mRecast = mRecastMeshManager.getStats(),
+            .mPathQuery = pathQuery,
         };
     }
 
@@ -13,6 +13,7 @@
 
 #include <map>
 #include <memory>
+#include <span>
 
 class dtNavMesh;
 
@@ -57,6 +58,8 @@ namespace DetourNavigator
 
         void wait(WaitConditionType waitConditionType, Loading::Listener* listener);
 
+        void demand(const AgentBounds& agentBounds, std::span<const TilePosition> tiles);
+
         SharedNavMeshCacheItem getNavMesh(const AgentBounds& agentBounds) const;
 
         std::map<AgentBounds, SharedNavMeshCacheItem> getNavMeshes() const;
@@ -1,16 +1,20 @@
 #include "navmeshtilescache.hpp"
 #include "stats.hpp"
 
+#include <algorithm>
 #include <cstring>
 
 namespace DetourNavigator
 {
-    NavMeshTilesCache::NavMeshTilesCache(const std::size_t maxNavMeshDataSize)
+    NavMeshTilesCache::NavMeshTilesCache(std::size_t maxNavMeshDataSize, std::size_t maxAgentBoundsNavMeshDataSize)
         : mMaxNavMeshDataSize(maxNavMeshDataSize)
+        , mMaxAgentBoundsNavMeshDataSize(maxAgentBoundsNavMeshDataSize)
         , mUsedNavMeshDataSize(0)
         , mFreeNavMeshDataSize(0)
         , mHitCount(0)
         , mGetCount(0)
+        , mInflation(0)
+        , mReleasedCount(0)
     {
     }
 
@@ -33,23 +37,36 @@ namespace DetourNavigator
     }
 
     NavMeshTilesCache::Value NavMeshTilesCache::set(const AgentBounds& agentBounds, const TilePosition& changedTile,
-        const RecastMesh& recastMesh, std::unique_ptr<PreparedNavMeshData>&& value)
+        const RecastMesh& recastMesh, std::unique_ptr<PreparedNavMeshData>&& value,
+        std::chrono::steady_clock::duration generationTime)
     {
         const auto itemSize = sizeof(RecastMesh) + getSize(recastMesh)
             + (value == nullptr ? 0 : sizeof(PreparedNavMeshData) + getSize(*value));
+        const double cost = std::chrono::duration<double>(generationTime).count() / static_cast<double>(itemSize);
 
         const std::lock_guard<std::mutex> lock(mMutex);
 
-        if (itemSize > mFreeNavMeshDataSize + (mMaxNavMeshDataSize - mUsedNavMeshDataSize))
+        if (itemSize > mFreeNavMeshDataSize + (mMaxNavMeshDataSize - mUsedNavMeshDataSize)
+            || itemSize > mMaxAgentBoundsNavMeshDataSize)
+            return Value();
+
+        AgentBoundsItems& agentBoundsItems = mAgentBoundsItems[agentBounds];
+
+        while (!agentBoundsItems.mFreeItems.empty()
+            && agentBoundsItems.mUsedSize + itemSize > mMaxAgentBoundsNavMeshDataSize)
+            removeLowestPriority(agentBoundsItems);
+
+        if (agentBoundsItems.mUsedSize + itemSize > mMaxAgentBoundsNavMeshDataSize)
             return Value();
 
         while (!mFreeItems.empty() && mUsedNavMeshDataSize + itemSize > mMaxNavMeshDataSize)
-            removeLeastRecentlyUsed();
+            removeLowestPriority();
 
         RecastMeshData key{ recastMesh.getMesh(), recastMesh.getWater(), recastMesh.getHeightfields(),
-            recastMesh.getFlatHeightfields() };
+            recastMesh.getFlatHeightfields(), recastMesh.getObstacles() };
 
-        const auto iterator = mFreeItems.emplace(mFreeItems.end(), agentBounds, changedTile, std::move(key), itemSize);
+        const auto iterator
+            = mFreeItems.emplace(mFreeItems.end(), agentBounds, changedTile, std::move(key), itemSize, cost);
         const auto emplaced = mValues.emplace(
             std::make_tuple(agentBounds, changedTile, std::cref(iterator->mRecastMeshData)), iterator);
 
@@ -65,6 +82,7 @@ namespace DetourNavigator
         iterator->mPreparedNavMeshData = std::move(value);
         ++iterator->mUseCount;
         mUsedNavMeshDataSize += itemSize;
+        agentBoundsItems.mUsedSize += itemSize;
         mBusyItems.splice(mBusyItems.end(), mFreeItems, iterator);
 
         return Value(*this, iterator);
@@ -84,19 +102,35 @@ namespace DetourNavigator
         return result;
     }
 
-    void NavMeshTilesCache::removeLeastRecentlyUsed()
+    void NavMeshTilesCache::removeLowestPriority()
     {
-        const auto& item = mFreeItems.back();
+        AgentBoundsItems* lowest = nullptr;
+        for (auto& [agentBounds, items] : mAgentBoundsItems)
+            if (!items.mFreeItems.empty()
+                && (lowest == nullptr || items.mFreeItems.begin()->first < lowest->mFreeItems.begin()->first))
+                lowest = &items;
+
+        if (lowest != nullptr)
+            removeLowestPriority(*lowest);
+    }
 
-        const auto value = mValues.find(std::tie(item.mAgentBounds, item.mChangedTile, item.mRecastMeshData));
-        if (value == mValues.end())
-            return;
+    void NavMeshTilesCache::removeLowestPriority(AgentBoundsItems& items)
+    {
+        const auto lowest = items.mFreeItems.begin();
+        const ItemIterator item = lowest->second;
+
+        mInflation = std::max(mInflation, item->mPriority.first);
+
+        const auto value = mValues.find(std::tie(item->mAgentBounds, item->mChangedTile, item->mRecastMeshData));
+        if (value != mValues.end())
+            mValues.erase(value);
 
-        mUsedNavMeshDataSize -= item.mSize;
-        mFreeNavMeshDataSize -= item.mSize;
+        mUsedNavMeshDataSize -= item->mSize;
+        mFreeNavMeshDataSize -= item->mSize;
+        items.mUsedSize -= item->mSize;
 
-        mValues.erase(value);
-        mFreeItems.pop_back();
+        items.mFreeItems.erase(lowest);
+        mFreeItems.erase(item);
     }
 
     void NavMeshTilesCache::acquireItemUnsafe(ItemIterator iterator)
@@ -104,6 +138,7 @@ namespace DetourNavigator
         if (++iterator->mUseCount > 1)
             return;
 
+        mAgentBoundsItems[iterator->mAgentBounds].mFreeItems.erase(iterator->mPriority);
         mBusyItems.splice(mBusyItems.end(), mFreeItems, iterator);
         mFreeNavMeshDataSize -= iterator->mSize;
     }
@@ -117,5 +152,7 @@ namespace DetourNavigator
 
         mFreeItems.splice(mFreeItems.begin(), mBusyItems, iterator);
         mFreeNavMeshDataSize += iterator->mSize;
+        iterator->mPriority = { mInflation + iterator->mCost, ++mReleasedCount };
+        mAgentBoundsItems[iterator->mAgentBounds].mFreeItems.emplace(iterator->mPriority, iterator);
     }
 }
@@ -8,10 +8,13 @@
 
 #include <atomic>
 #include <cassert>
+#include <chrono>
 #include <cstring>
+#include <limits>
 #include <list>
 #include <map>
 #include <mutex>
+#include <utility>
 #include <vector>
 
 namespace DetourNavigator
@@ -22,28 +25,37 @@ namespace DetourNavigator
         std::vector<CellWater> mWater;
         std::vector<Heightfield> mHeightfields;
         std::vector<FlatHeightfield> mFlatHeightfields;
+        std::vector<Obstacle> mObstacles;
     };
 
     inline bool operator<(const RecastMeshData& lhs, const RecastMeshData& rhs)
     {
-        return std::tie(lhs.mMesh, lhs.mWater, lhs.mHeightfields, lhs.mFlatHeightfields)
-            < std::tie(rhs.mMesh, rhs.mWater, rhs.mHeightfields, rhs.mFlatHeightfields);
+        return std::tie(lhs.mMesh, lhs.mWater, lhs.mHeightfields, lhs.mFlatHeightfields, lhs.mObstacles)
+            < std::tie(rhs.mMesh, rhs.mWater, rhs.mHeightfields, rhs.mFlatHeightfields, rhs.mObstacles);
     }
 
     inline bool operator<(const RecastMeshData& lhs, const RecastMesh& rhs)
     {
-        return std::tie(lhs.mMesh, lhs.mWater, lhs.mHeightfields, lhs.mFlatHeightfields)
-            < std::tie(rhs.getMesh(), rhs.getWater(), rhs.getHeightfields(), rhs.getFlatHeightfields());
+        return std::tie(lhs.mMesh, lhs.mWater, lhs.mHeightfields, lhs.mFlatHeightfields, lhs.mObstacles)
+            < std::tie(
+                   rhs.getMesh(), rhs.getWater(), rhs.getHeightfields(), rhs.getFlatHeightfields(), rhs.getObstacles());
     }
 
     inline bool operator<(const RecastMesh& lhs, const RecastMeshData& rhs)
     {
-        return std::tie(lhs.getMesh(), lhs.getWater(), lhs.getHeightfields(), lhs.getFlatHeightfields())
-            < std::tie(rhs.mMesh, rhs.mWater, rhs.mHeightfields, rhs.mFlatHeightfields);
+        return std::tie(
+                   lhs.getMesh(), lhs.getWater(), lhs.getHeightfields(), lhs.getFlatHeightfields(), lhs.getObstacles())
+            < std::tie(rhs.mMesh, rhs.mWater, rhs.mHeightfields, rhs.mFlatHeightfields, rhs.mObstacles);
     }
 
     struct NavMeshTilesCacheStats;
 
+    /// @brief Keeps prepared nav mesh data to not generate it again for the same recast mesh.
+    /// @par Unused items are evicted by GreedyDual-Size: an item priority is the priority of the last evicted item
+    /// plus the time it took to generate the item per byte when the item is released. Items that took long to
+    /// generate for their size stay longer, items with the same cost are evicted in least recently used order.
+    /// @par Items of one agent bounds can't take more than a quota of the cache, so the tiles of a rare actor don't
+    /// evict the tiles used by everyone else.
     class NavMeshTilesCache
     {
     public:
@@ -55,14 +67,19 @@ namespace DetourNavigator
             RecastMeshData mRecastMeshData;
             std::unique_ptr<PreparedNavMeshData> mPreparedNavMeshData;
             std::size_t mSize;
+            // Seconds spent per byte to generate the item
+            double mCost;
+            // Eviction order of the item while it is not used
+            std::pair<double, std::size_t> mPriority{ 0, 0 };
 
             Item(const AgentBounds& agentBounds, const TilePosition& changedTile, RecastMeshData&& recastMeshData,
-                std::size_t size)
+                std::size_t size, double cost)
                 : mUseCount(0)
                 , mAgentBounds(agentBounds)
                 , mChangedTile(changedTile)
                 , mRecastMeshData(std::move(recastMeshData))
                 , mSize(size)
+                , mCost(cost)
             {
             }
         };
@@ -123,29 +140,46 @@ namespace DetourNavigator
             ItemIterator mIterator;
         };
 
-        NavMeshTilesCache(const std::size_t maxNavMeshDataSize);
+        /// @param maxAgentBoundsNavMeshDataSize quota of the items of a single agent bounds
+        explicit NavMeshTilesCache(std::size_t maxNavMeshDataSize,
+            std::size_t maxAgentBoundsNavMeshDataSize = std::numeric_limits<std::size_t>::max());
 
         Value get(const AgentBounds& agentBounds, const TilePosition& changedTile, const RecastMesh& recastMesh);
 
+        /// @param generationTime how long it took to get the value, the more the longer it is kept
         Value set(const AgentBounds& agentBounds, const TilePosition& changedTile, const RecastMesh& recastMesh,
-            std::unique_ptr<PreparedNavMeshData>&& value);
+            std::unique_ptr<PreparedNavMeshData>&& value, std::chrono::steady_clock::duration generationTime = {});
 
         NavMeshTilesCacheStats getStats() const;
 
     private:
+        struct AgentBoundsItems
+        {
+            std::size_t mUsedSize = 0;
+            // Unused items in eviction order
+            std::map<std::pair<double, std::size_t>, ItemIterator> mFreeItems;
+        };
+
         mutable std::mutex mMutex;
         std::size_t mMaxNavMeshDataSize;
+        std::size_t mMaxAgentBoundsNavMeshDataSize;
         std::size_t mUsedNavMeshDataSize;
         std::size_t mFreeNavMeshDataSize;
         std::size_t mHitCount;
         std::size_t mGetCount;
+        // Priority of the last evicted item, the base for the priorities of released items
+        double mInflation;
+        std::size_t mReleasedCount;
         std::list<Item> mBusyItems;
         std::list<Item> mFreeItems;
+        std::map<AgentBounds, AgentBoundsItems> mAgentBoundsItems;
         std::map<std::tuple<AgentBounds, TilePosition, std::reference_wrapper<const RecastMeshData>>, ItemIterator,
             std::less<>>
             mValues;
 
-        void removeLeastRecentlyUsed();
+        void removeLowestPriority();
+
+        void removeLowestPriority(AgentBoundsItems& items);
 
         void acquireItemUnsafe(ItemIterator iterator);
 
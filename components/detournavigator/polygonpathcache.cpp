@@ -0,0 +1,71 @@
+#include "polygonpathcache.hpp"
+
+#include <algorithm>
+#include <iterator>
+
+namespace DetourNavigator
+{
+    namespace
+    {
+        bool isEqual(const AreaCosts& lhs, const AreaCosts& rhs)
+        {
+            return lhs.mWater == rhs.mWater && lhs.mDoor == rhs.mDoor && lhs.mPathgrid == rhs.mPathgrid
+                && lhs.mGround == rhs.mGround;
+        }
+    }
+
+    std::optional<std::size_t> PolygonPathCache::find(dtPolyRef start, dtPolyRef end, Flags includeFlags,
+        const AreaCosts& areaCosts, std::span<dtPolyRef> out)
+    {
+        ++mGetCount;
+        for (auto it = mItems.begin(); it != mItems.end(); ++it)
+        {
+            if (it->mPath.back() != end || it->mIncludeFlags != includeFlags || !isEqual(it->mAreaCosts, areaCosts))
+                continue;
+            const auto begin = std::find(it->mPath.begin(), it->mPath.end(), start);
+            if (begin == it->mPath.end())
+                continue;
+            const std::size_t size = static_cast<std::size_t>(it->mPath.end() - begin);
+            if (size > out.size())
+                continue;
+            std::copy(begin, it->mPath.end(), out.begin());
+            mItems.splice(mItems.begin(), mItems, it);
+            ++mHitCount;
+            return size;
+        }
+        return std::nullopt;
+    }
+
+    void PolygonPathCache::add(Flags includeFlags, const AreaCosts& areaCosts, std::span<const dtPolyRef> path)
+    {
+        if (path.empty() || mMaxSize == 0)
+            return;
+        if (mItems.size() >= mMaxSize)
+        {
+            // reuse the least recently used item to keep its allocated path buffer
+            mItems.splice(mItems.begin(), mItems, std::prev(mItems.end()));
+            Item& item = mItems.front();
+            item.mIncludeFlags = includeFlags;
+            item.mAreaCosts = areaCosts;
+            item.mPath.assign(path.begin(), path.end());
+            return;
+        }
+        mItems.push_front(Item{ includeFlags, areaCosts, std::vector<dtPolyRef>(path.begin(), path.end()) });
+    }
+
+    void PolygonPathCache::reportQuery(std::chrono::steady_clock::duration duration)
+    {
+        ++mQueryCount;
+        mQueryDuration += duration;
+    }
+
+    PathQueryStats PolygonPathCache::getStats() const
+    {
+        return PathQueryStats{
+            .mCount = mQueryCount,
+            .mDuration = mQueryDuration,
+            .mCacheGetCount = mGetCount,
+            .mCacheHitCount = mHitCount,
+        };
+    }
+}
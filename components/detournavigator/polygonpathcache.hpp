@@ -0,0 +1,64 @@
+#ifndef OPENMW_COMPONENTS_DETOURNAVIGATOR_POLYGONPATHCACHE_H
+#define OPENMW_COMPONENTS_DETOURNAVIGATOR_POLYGONPATHCACHE_H
+
+#include "areatype.hpp"
+#include "flags.hpp"
+#include "stats.hpp"
+
+#include <DetourNavMesh.h>
+
+#include <chrono>
+#include <cstddef>
+#include <list>
+#include <optional>
+#include <span>
+#include <vector>
+
+namespace DetourNavigator
+{
+    /// @brief Keeps recently found complete polygon paths of a single navmesh.
+    /// @par A path is reused for a query with the same end polygon and filter when it goes over the start polygon,
+    /// so actors moving to the same target from nearby positions share a single traversal. Owner has to clear the
+    /// cache on each navmesh change because cached polygon references may no longer be valid or optimal.
+    class PolygonPathCache
+    {
+    public:
+        static constexpr std::size_t sDefaultMaxSize = 32;
+
+        explicit PolygonPathCache(std::size_t maxSize = sDefaultMaxSize)
+            : mMaxSize(maxSize)
+        {
+        }
+
+        /// Copies cached path from start to end polygon into out. Returns number of copied polygons if found.
+        std::optional<std::size_t> find(dtPolyRef start, dtPolyRef end, Flags includeFlags,
+            const AreaCosts& areaCosts, std::span<dtPolyRef> out);
+
+        /// Stores complete path, last polygon is considered to be the end. Empty paths are ignored.
+        void add(Flags includeFlags, const AreaCosts& areaCosts, std::span<const dtPolyRef> path);
+
+        void clear() { mItems.clear(); }
+
+        void reportQuery(std::chrono::steady_clock::duration duration);
+
+        PathQueryStats getStats() const;
+
+    private:
+        struct Item
+        {
+            Flags mIncludeFlags;
+            AreaCosts mAreaCosts;
+            std::vector<dtPolyRef> mPath;
+        };
+
+        std::size_t mMaxSize;
+        // most recently used items first
+        std::list<Item> mItems;
+        std::size_t mGetCount = 0;
+        std::size_t mHitCount = 0;
+        std::size_t mQueryCount = 0;
+        std::chrono::steady_clock::duration mQueryDuration{ 0 };
+    };
+}
+
+#endif
@@ -80,4 +80,42 @@ namespace DetourNavigator
         std::memcpy(dst.verts, src.verts, getVertsLength(src) * sizeof(*dst.verts));
         std::memcpy(dst.tris, src.tris, getTrisLength(src) * sizeof(*dst.tris));
     }
+
+    void copyCompactHeightfield(const rcCompactHeightfield& src, rcCompactHeightfield& dst)
+    {
+        dst.width = src.width;
+        dst.height = src.height;
+        dst.spanCount = src.spanCount;
+        dst.walkableHeight = src.walkableHeight;
+        dst.walkableClimb = src.walkableClimb;
+        dst.borderSize = src.borderSize;
+        dst.maxDistance = src.maxDistance;
+        dst.maxRegions = src.maxRegions;
+        rcVcopy(dst.bmin, src.bmin);
+        rcVcopy(dst.bmax, src.bmax);
+        dst.cs = src.cs;
+        dst.ch = src.ch;
+        const std::size_t cellsCount = static_cast<std::size_t>(src.width) * static_cast<std::size_t>(src.height);
+        const std::size_t spansCount = static_cast<std::size_t>(src.spanCount);
+        dst.cells = static_cast<rcCompactCell*>(permRecastAlloc(cellsCount * sizeof(rcCompactCell)));
+        std::memcpy(dst.cells, src.cells, cellsCount * sizeof(rcCompactCell));
+        dst.spans = static_cast<rcCompactSpan*>(permRecastAlloc(spansCount * sizeof(rcCompactSpan)));
+        std::memcpy(dst.spans, src.spans, spansCount * sizeof(rcCompactSpan));
+        permRecastAlloc(dst.areas, spansCount);
+        std::memcpy(dst.areas, src.areas, spansCount * sizeof(*dst.areas));
+        if (src.dist != nullptr)
+        {
+            permRecastAlloc(dst.dist, spansCount);
+            std::memcpy(dst.dist, src.dist, spansCount * sizeof(*dst.dist));
+        }
+    }
+
+    std::size_t getSize(const rcCompactHeightfield& value) noexcept
+    {
+        const std::size_t cellsCount = static_cast<std::size_t>(value.width) * static_cast<std::size_t>(value.height);
+        const std::size_t spansCount = static_cast<std::size_t>(value.spanCount);
+        const std::size_t spanSize
+            = sizeof(rcCompactSpan) + sizeof(*value.areas) + (value.dist == nullptr ? 0 : sizeof(*value.dist));
+        return cellsCount * sizeof(rcCompactCell) + spansCount * spanSize;
+    }
 }
@@ -66,6 +66,11 @@ namespace DetourNavigator
     void copyPolyMesh(const rcPolyMesh& src, rcPolyMesh& dst);
 
     void copyPolyMeshDetail(const rcPolyMeshDetail& src, rcPolyMeshDetail& dst);
+
+    /// @param dst has to be without allocated data
+    void copyCompactHeightfield(const rcCompactHeightfield& src, rcCompactHeightfield& dst);
+
+    std::size_t getSize(const rcCompactHeightfield& value) noexcept;
 }
 
 #endif
@@ -18,13 +18,14 @@ namespace DetourNavigator
 
     RecastMesh::RecastMesh(const Version& version, Mesh mesh, std::vector<CellWater> water,
         std::vector<Heightfield> heightfields, std::vector<FlatHeightfield> flatHeightfields,
-        std::vector<MeshSource> meshSources)
+        std::vector<MeshSource> meshSources, std::vector<Obstacle> obstacles)
         : mVersion(version)
         , mMesh(std::move(mesh))
         , mWater(std::move(water))
         , mHeightfields(std::move(heightfields))
         , mFlatHeightfields(std::move(flatHeightfields))
         , mMeshSources(std::move(meshSources))
+        , mObstacles(std::move(obstacles))
     {
         mWater.shrink_to_fit();
         mHeightfields.shrink_to_fit();
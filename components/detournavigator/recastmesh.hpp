@@ -117,6 +117,19 @@ namespace DetourNavigator
         return tie(lhs) < tie(rhs);
     }
 
+    /// Bounding box of a small moving object, its footprint is marked not walkable instead of rasterizing its shape
+    struct Obstacle
+    {
+        osg::Vec3f mMin;
+        osg::Vec3f mMax;
+    };
+
+    inline bool operator<(const Obstacle& lhs, const Obstacle& rhs) noexcept
+    {
+        const auto tie = [](const Obstacle& v) { return std::tie(v.mMin, v.mMax); };
+        return tie(lhs) < tie(rhs);
+    }
+
     struct MeshSource
     {
         osg::ref_ptr<const Resource::BulletShape> mShape;
@@ -129,7 +142,7 @@ namespace DetourNavigator
     public:
         explicit RecastMesh(const Version& version, Mesh mesh, std::vector<CellWater> water,
             std::vector<Heightfield> heightfields, std::vector<FlatHeightfield> flatHeightfields,
-            std::vector<MeshSource> sources);
+            std::vector<MeshSource> sources, std::vector<Obstacle> obstacles = {});
 
         const Version& getVersion() const noexcept { return mVersion; }
 
@@ -143,6 +156,8 @@ namespace DetourNavigator
 
         const std::vector<MeshSource>& getMeshSources() const noexcept { return mMeshSources; }
 
+        const std::vector<Obstacle>& getObstacles() const noexcept { return mObstacles; }
+
     private:
         Version mVersion;
         Mesh mMesh;
@@ -150,6 +165,7 @@ namespace DetourNavigator
         std::vector<Heightfield> mHeightfields;
         std::vector<FlatHeightfield> mFlatHeightfields;
         std::vector<MeshSource> mMeshSources;
+        std::vector<Obstacle> mObstacles;
 
         friend inline std::size_t getSize(const RecastMesh& value) noexcept
         {
@@ -157,7 +173,8 @@ namespace DetourNavigator
                 + value.mHeightfields.size() * sizeof(Heightfield)
                 + std::accumulate(value.mHeightfields.begin(), value.mHeightfields.end(), std::size_t{ 0 },
                     [](std::size_t r, const Heightfield& v) { return r + v.mHeights.size() * sizeof(float); })
-                + value.mFlatHeightfields.size() * sizeof(FlatHeightfield);
+                + value.mFlatHeightfields.size() * sizeof(FlatHeightfield)
+                + value.mObstacles.size() * sizeof(Obstacle);
         }
     };
 }
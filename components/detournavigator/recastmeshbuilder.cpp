@@ -216,6 +216,17 @@ namespace DetourNavigator
         }
     }
 
+    void RecastMeshBuilder::addObstacle(const btCollisionShape& shape, const btTransform& transform)
+    {
+        btVector3 aabbMin;
+        btVector3 aabbMax;
+        shape.getAabb(transform, aabbMin, aabbMax);
+        const TileBounds bounds{ osg::Vec2f(aabbMin.x(), aabbMin.y()), osg::Vec2f(aabbMax.x(), aabbMax.y()) };
+        if (!getIntersection(mBounds, bounds).has_value())
+            return;
+        mObstacles.push_back(Obstacle{ Misc::Convert::toOsg(aabbMin), Misc::Convert::toOsg(aabbMax) });
+    }
+
     void RecastMeshBuilder::addWater(const osg::Vec2i& cellPosition, const Water& water)
     {
         mWater.push_back(CellWater{ cellPosition, water });
@@ -274,9 +285,10 @@ namespace DetourNavigator
         std::sort(mWater.begin(), mWater.end());
         std::sort(mHeightfields.begin(), mHeightfields.end());
         std::sort(mFlatHeightfields.begin(), mFlatHeightfields.end());
+        std::sort(mObstacles.begin(), mObstacles.end());
         Mesh mesh = makeMesh(std::move(mTriangles));
         return std::make_shared<RecastMesh>(version, std::move(mesh), std::move(mWater), std::move(mHeightfields),
-            std::move(mFlatHeightfields), std::move(mSources));
+            std::move(mFlatHeightfields), std::move(mSources), std::move(mObstacles));
     }
 
     void RecastMeshBuilder::addObject(
@@ -51,6 +51,9 @@ namespace DetourNavigator
 
         void addObject(const btBoxShape& shape, const btTransform& transform, const AreaType areaType);
 
+        /// Add the bounding box of the shape as an obstacle instead of its triangles
+        void addObstacle(const btCollisionShape& shape, const btTransform& transform);
+
         void addWater(const osg::Vec2i& cellPosition, const Water& water);
 
         void addHeightfield(const osg::Vec2i& cellPosition, int cellSize, float height);
@@ -67,6 +70,7 @@ namespace DetourNavigator
         std::vector<Heightfield> mHeightfields;
         std::vector<FlatHeightfield> mFlatHeightfields;
         std::vector<MeshSource> mSources;
+        std::vector<Obstacle> mObstacles;
 
         inline void addObject(const btCollisionShape& shape, const btTransform& transform, const AreaType areaType);
 
@@ -14,7 +14,10 @@
 #include <components/serialization/sizeaccumulator.hpp>
 
 #include <cstddef>
+#include <cstdint>
 #include <cstring>
+#include <limits>
+#include <stdexcept>
 #include <type_traits>
 #include <vector>
 
@@ -22,6 +25,36 @@ namespace DetourNavigator
 {
     namespace
     {
+        // Unsigned integers written with 7 bits per byte, so small values take less space
+        template <class T>
+        struct VarInts
+        {
+            static_assert(std::is_unsigned_v<T>);
+
+            T* mData;
+            std::size_t mCount;
+            // When not 0 values are written as the difference to the value that many positions before, so
+            // coordinates of nearby vertices take a byte or two
+            std::size_t mStride = 0;
+            // Added to the values before they are written, so the most common value is written as 0
+            T mOffset = 0;
+        };
+
+        template <class T>
+        T zigzagEncode(T value)
+        {
+            using Signed = std::make_signed_t<T>;
+            return static_cast<T>(static_cast<T>(value << 1)
+                ^ static_cast<T>(static_cast<Signed>(value) >> (std::numeric_limits<T>::digits - 1)));
+        }
+
+        template <class T>
+        T zigzagDecode(T value)
+        {
+            using Signed = std::make_signed_t<T>;
+            return static_cast<T>(static_cast<T>(value >> 1) ^ static_cast<T>(-static_cast<Signed>(value & 1)));
+        }
+
         template <Serialization::Mode mode>
         struct Format : Serialization::Format<mode, Format<mode>>
         {
@@ -108,12 +141,20 @@ namespace DetourNavigator
                 visitor(*this, value.mHeight);
             }
 
+            template <class Visitor>
+            void operator()(Visitor&& visitor, const Obstacle& value) const
+            {
+                visitor(*this, value.mMin);
+                visitor(*this, value.mMax);
+            }
+
             template <class Visitor>
             void operator()(Visitor&& visitor, const RecastMesh& value) const
             {
                 visitor(*this, value.getWater());
                 visitor(*this, value.getHeightfields());
                 visitor(*this, value.getFlatHeightfields());
+                visitor(*this, value.getObstacles());
             }
 
             template <class Visitor>
@@ -149,6 +190,48 @@ namespace DetourNavigator
                 visitor(*this, dbRefGeometryObjects);
             }
 
+            template <class Visitor, class T>
+            void operator()(Visitor&& visitor, const VarInts<T>& value) const
+            {
+                for (std::size_t i = 0; i < value.mCount; ++i)
+                {
+                    const T previous = value.mStride != 0 && i >= value.mStride ? value.mData[i - value.mStride] : 0;
+                    if constexpr (mode == Serialization::Mode::Write)
+                    {
+                        T encoded = static_cast<T>(value.mData[i] - previous + value.mOffset);
+                        if (value.mStride != 0)
+                            encoded = zigzagEncode(encoded);
+                        while (encoded >= 0x80)
+                        {
+                            visitor(*this, static_cast<std::uint8_t>(encoded | 0x80));
+                            encoded = static_cast<T>(encoded >> 7);
+                        }
+                        visitor(*this, static_cast<std::uint8_t>(encoded));
+                    }
+                    else
+                    {
+                        static_assert(mode == Serialization::Mode::Read);
+                        std::uint64_t decoded = 0;
+                        for (int shift = 0;; shift += 7)
+                        {
+                            if (shift >= std::numeric_limits<T>::digits)
+                                throw std::runtime_error("Too long variable length integer");
+                            std::uint8_t byte = 0;
+                            visitor(*this, byte);
+                            decoded |= static_cast<std::uint64_t>(byte & 0x7f) << shift;
+                            if ((byte & 0x80) == 0)
+                                break;
+                        }
+                        if (decoded > std::numeric_limits<T>::max())
+                            throw std::runtime_error("Too big variable length integer");
+                        T encoded = static_cast<T>(decoded);
+                        if (value.mStride != 0)
+                            encoded = zigzagDecode(encoded);
+                        value.mData[i] = static_cast<T>(encoded - value.mOffset + previous);
+                    }
+                }
+            }
+
             template <class Visitor, class T>
             auto operator()(Visitor&& visitor, T& value) const
                 -> std::enable_if_t<std::is_same_v<std::decay_t<T>, rcPolyMesh>>
@@ -176,10 +259,11 @@ namespace DetourNavigator
                     if (value.areas == nullptr)
                         permRecastAlloc(value.areas, getAreasLength(value));
                 }
-                visitor(*this, value.verts, getVertsLength(value));
-                visitor(*this, value.polys, getPolysLength(value));
-                visitor(*this, value.regs, getRegsLength(value));
-                visitor(*this, value.flags, getFlagsLength(value));
+                (*this)(visitor, VarInts<unsigned short>{ value.verts, getVertsLength(value), 3 });
+                // Unused vertices and neighbours are RC_MESH_NULL_IDX
+                (*this)(visitor, VarInts<unsigned short>{ value.polys, getPolysLength(value), 0, 1 });
+                (*this)(visitor, VarInts<unsigned short>{ value.regs, getRegsLength(value) });
+                (*this)(visitor, VarInts<unsigned short>{ value.flags, getFlagsLength(value) });
                 visitor(*this, value.areas, getAreasLength(value));
             }
 
@@ -191,7 +275,8 @@ namespace DetourNavigator
                 if constexpr (mode == Serialization::Mode::Read)
                     if (value.meshes == nullptr)
                         permRecastAlloc(value.meshes, getMeshesLength(value));
-                visitor(*this, value.meshes, getMeshesLength(value));
+                // Sub-meshes are made of consecutive vertices and triangles
+                (*this)(visitor, VarInts<unsigned int>{ value.meshes, getMeshesLength(value), 4 });
                 visitor(*this, value.nverts);
                 if constexpr (mode == Serialization::Mode::Read)
                     if (value.verts == nullptr)
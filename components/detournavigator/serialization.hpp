@@ -14,10 +14,10 @@ namespace DetourNavigator
     struct AgentBounds;
 
     constexpr char recastMeshMagic[] = { 'r', 'c', 's', 't' };
-    constexpr std::uint32_t recastMeshVersion = 2;
+    constexpr std::uint32_t recastMeshVersion = 3;
 
     constexpr char preparedNavMeshDataMagic[] = { 'p', 'n', 'a', 'v' };
-    constexpr std::uint32_t preparedNavMeshDataVersion = 1;
+    constexpr std::uint32_t preparedNavMeshDataVersion = 2;
 
     std::vector<std::byte> serialize(const RecastSettings& settings, const AgentBounds& agentBounds,
         const RecastMesh& recastMesh, const std::vector<DbRefGeometryObject>& dbRefGeometryObjects);
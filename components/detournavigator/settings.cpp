@@ -63,6 +63,7 @@ namespace DetourNavigator
             result.mRegionMergeArea = ::Settings::navigator().mRegionMergeArea;
             result.mRegionMinArea = ::Settings::navigator().mRegionMinArea;
             result.mTileSize = ::Settings::navigator().mTileSize;
+            result.mMaxObstacleSize = ::Settings::navigator().mMaxObstacleSize;
             result.mMaxLogLevel = maxLogLevel;
 
             return result;
@@ -96,6 +97,8 @@ namespace DetourNavigator
         result.mWaitUntilMinDistanceToPlayer = ::Settings::navigator().mWaitUntilMinDistanceToPlayer;
         result.mAsyncNavMeshUpdaterThreads = ::Settings::navigator().mAsyncNavMeshUpdaterThreads;
         result.mMaxNavMeshTilesCacheSize = ::Settings::navigator().mMaxNavMeshTilesCacheSize;
+        result.mMaxAgentNavMeshTilesCacheSize = ::Settings::navigator().mMaxAgentNavMeshTilesCacheSize;
+        result.mMaxObstacleHeightfieldsCacheSize = ::Settings::navigator().mMaxObstacleHeightfieldsCacheSize;
         result.mEnableWriteRecastMeshToFile = ::Settings::navigator().mEnableWriteRecastMeshToFile;
         result.mEnableWriteNavMeshToFile = ::Settings::navigator().mEnableWriteNavMeshToFile;
         result.mRecastMeshPathPrefix = ::Settings::navigator().mRecastMeshPathPrefix;
@@ -106,6 +109,13 @@ namespace DetourNavigator
         result.mEnableNavMeshDiskCache = ::Settings::navigator().mEnableNavMeshDiskCache;
         result.mWriteToNavMeshDb = ::Settings::navigator().mWriteToNavmeshdb;
         result.mMaxDbFileSize = ::Settings::navigator().mMaxNavmeshdbFileSize;
+        result.mDbWriteAheadLog = ::Settings::navigator().mNavmeshdbWriteAheadLog;
+        result.mDbSynchronous = static_cast<Sqlite3::Synchronous>(::Settings::navigator().mNavmeshdbSynchronous.get());
+        result.mDbCheckpointInterval
+            = std::chrono::milliseconds(::Settings::navigator().mNavmeshdbCheckpointIntervalMs);
+        result.mDbTransactionTiles = static_cast<std::size_t>(::Settings::navigator().mNavmeshdbTransactionTiles);
+        result.mDbTransactionInterval
+            = std::chrono::milliseconds(::Settings::navigator().mNavmeshdbTransactionIntervalMs);
 
         return result;
     }
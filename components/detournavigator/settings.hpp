@@ -2,6 +2,7 @@
 #define OPENMW_COMPONENTS_DETOURNAVIGATOR_SETTINGS_H
 
 #include <components/debug/debuglog.hpp>
+#include <components/sqlite3/db.hpp>
 
 #include <chrono>
 #include <string>
@@ -25,6 +26,7 @@ namespace DetourNavigator
         int mRegionMergeArea = 0;
         int mRegionMinArea = 0;
         int mTileSize = 0;
+        float mMaxObstacleSize = 0;
         Debug::Level mMaxLogLevel = Debug::Error;
     };
 
@@ -50,13 +52,20 @@ namespace DetourNavigator
         int mMaxTilesNumber = 0;
         std::size_t mAsyncNavMeshUpdaterThreads = 0;
         std::size_t mMaxNavMeshTilesCacheSize = 0;
+        std::size_t mMaxAgentNavMeshTilesCacheSize = 0;
+        std::size_t mMaxObstacleHeightfieldsCacheSize = 0;
         std::string mRecastMeshPathPrefix;
         std::string mNavMeshPathPrefix;
         std::chrono::milliseconds mMinUpdateInterval;
         std::uint64_t mMaxDbFileSize = 0;
+        bool mDbWriteAheadLog = false;
+        Sqlite3::Synchronous mDbSynchronous = Sqlite3::Synchronous::Full;
+        std::chrono::milliseconds mDbCheckpointInterval{ 0 };
+        std::size_t mDbTransactionTiles = 1;
+        std::chrono::milliseconds mDbTransactionInterval{ 0 };
     };
 
-    inline constexpr std::int64_t navMeshFormatVersion = 2;
+    inline constexpr std::int64_t navMeshFormatVersion = 3;
 
     Settings makeSettingsFromSettingsManager(Debug::Level maxLogLevel);
 }
@@ -12,8 +12,15 @@ namespace DetourNavigator
             out.setAttribute(frameNumber, "NavMesh Removing", static_cast<double>(stats.mWaiting.mRemoving));
             out.setAttribute(frameNumber, "NavMesh Updating", static_cast<double>(stats.mWaiting.mUpdating));
             out.setAttribute(frameNumber, "NavMesh Delayed", static_cast<double>(stats.mWaiting.mDelayed));
+            out.setAttribute(frameNumber, "NavMesh Demanded", static_cast<double>(stats.mWaiting.mDemanded));
             out.setAttribute(frameNumber, "NavMesh Pushed", static_cast<double>(stats.mPushed));
             out.setAttribute(frameNumber, "NavMesh Processing", static_cast<double>(stats.mProcessing));
+            out.setAttribute(frameNumber, "NavMesh Demanded Jobs", static_cast<double>(stats.mDemandedJobs));
+            if (stats.mDemandedJobs != 0)
+            {
+                const std::chrono::duration<double, std::milli> latency = stats.mDemandedJobsLatency;
+                out.setAttribute(frameNumber, "NavMesh Demanded Latency", latency.count() / stats.mDemandedJobs);
+            }
 
             if (stats.mDb.has_value())
             {
@@ -40,11 +47,24 @@ namespace DetourNavigator
             out.setAttribute(frameNumber, "NavMesh Recast Heightfields", static_cast<double>(stats.mHeightfields));
             out.setAttribute(frameNumber, "NavMesh Recast Water", static_cast<double>(stats.mWater));
         }
+
+        void reportStats(const PathQueryStats& stats, unsigned int frameNumber, osg::Stats& out)
+        {
+            out.setAttribute(frameNumber, "NavMesh PathQuery Count", static_cast<double>(stats.mCount));
+            if (stats.mCount != 0)
+            {
+                const std::chrono::duration<double, std::milli> duration = stats.mDuration;
+                out.setAttribute(frameNumber, "NavMesh PathQuery Time", duration.count() / stats.mCount);
+            }
+            out.setAttribute(frameNumber, "NavMesh PathCache Get", static_cast<double>(stats.mCacheGetCount));
+            out.setAttribute(frameNumber, "NavMesh PathCache Hit", static_cast<double>(stats.mCacheHitCount));
+        }
     }
 
     void reportStats(const Stats& stats, unsigned int frameNumber, osg::Stats& out)
     {
         reportStats(stats.mUpdater, frameNumber, out);
         reportStats(stats.mRecast, frameNumber, out);
+        reportStats(stats.mPathQuery, frameNumber, out);
     }
 }
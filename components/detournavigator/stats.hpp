@@ -1,6 +1,7 @@
 #ifndef OPENMW_COMPONENTS_DETOURNAVIGATOR_STATS_H
 #define OPENMW_COMPONENTS_DETOURNAVIGATOR_STATS_H
 
+#include <chrono>
 #include <cstddef>
 #include <optional>
 
@@ -16,6 +17,7 @@ namespace DetourNavigator
         std::size_t mRemoving = 0;
         std::size_t mUpdating = 0;
         std::size_t mDelayed = 0;
+        std::size_t mDemanded = 0;
     };
 
     struct DbJobQueueStats
@@ -46,6 +48,9 @@ namespace DetourNavigator
         std::size_t mPushed = 0;
         std::size_t mProcessing = 0;
         std::size_t mDbGetTileHits = 0;
+        // Jobs wanted by path requests taken for processing and the total time they have waited since requested
+        std::size_t mDemandedJobs = 0;
+        std::chrono::steady_clock::duration mDemandedJobsLatency{ 0 };
         std::optional<DbWorkerStats> mDb;
         NavMeshTilesCacheStats mCache;
     };
@@ -58,10 +63,19 @@ namespace DetourNavigator
         std::size_t mWater = 0;
     };
 
+    struct PathQueryStats
+    {
+        std::size_t mCount = 0;
+        std::chrono::steady_clock::duration mDuration{ 0 };
+        std::size_t mCacheGetCount = 0;
+        std::size_t mCacheHitCount = 0;
+    };
+
     struct Stats
     {
         AsyncNavMeshUpdaterStats mUpdater;
         TileCachedRecastMeshManagerStats mRecast;
+        PathQueryStats mPathQuery;
     };
 
     void reportStats(const Stats& stats, unsigned int frameNumber, osg::Stats& out);
@@ -13,6 +13,8 @@
 #include <boost/geometry/geometry.hpp>
 
 #include <limits>
+#include <mutex>
+#include <shared_mutex>
 
 namespace DetourNavigator
 {
@@ -55,6 +57,15 @@ namespace DetourNavigator
             const std::optional<std::unique_lock<Mutex>> mImpl;
         };
 
+        bool isObstacle(const RecastMeshObject& object, bool moved, float maxObstacleSize)
+        {
+            if (maxObstacleSize <= 0 || !moved || object.getAreaType() != AreaType_ground)
+                return false;
+            const btAABB aabb = BulletHelpers::getAabb(object.getShape(), object.getTransform());
+            const btVector3 size = aabb.m_max - aabb.m_min;
+            return size.x() <= maxObstacleSize && size.y() <= maxObstacleSize && size.z() <= maxObstacleSize;
+        }
+
         TilesPositionsRange getIndexRange(const auto& index)
         {
             const auto bounds = index.bounds();
@@ -101,6 +112,7 @@ namespace DetourNavigator
                 });
             }
 
+            const std::lock_guard cacheLock(mCacheMutex);
             getTilesPositions(mRange, [&](const TilePosition& v) {
                 if (!isInTilesPositionsRange(range, v))
                     mCache.erase(v);
@@ -153,6 +165,7 @@ namespace DetourNavigator
         mObjects.clear();
         mWater.clear();
         mHeightfields.clear();
+        const std::lock_guard cacheLock(mCacheMutex);
         mCache.clear();
     }
 
@@ -177,6 +190,7 @@ namespace DetourNavigator
                               .mRevision = revision,
                               .mLastNavMeshReportedChange = {},
                               .mLastNavMeshReport = {},
+                              .mMoved = false,
                           }))
                       ->second.get();
             assert(range.mBegin != range.mEnd);
@@ -216,6 +230,7 @@ namespace DetourNavigator
             }
             ++mRevision;
             it->second->mRevision = mRevision;
+            it->second->mMoved = true;
         }
         if (newRange == oldRange)
         {
@@ -353,11 +368,12 @@ namespace DetourNavigator
         ESM::RefId worldspace, const TilePosition& tilePosition)
     {
         {
-            const std::lock_guard lock(mMutex);
+            const std::shared_lock lock(mMutex);
             if (mWorldspace != worldspace)
                 return nullptr;
             if (!isInTilesPositionsRange(mRange, tilePosition))
                 return nullptr;
+            const std::lock_guard cacheLock(mCacheMutex);
             const auto it = mCache.find(tilePosition);
             if (it != mCache.end() && it->second.mRecastMesh->getVersion() == it->second.mVersion)
                 return it->second.mRecastMesh;
@@ -365,7 +381,7 @@ namespace DetourNavigator
         auto result = makeMesh(tilePosition);
         if (result != nullptr)
         {
-            const std::lock_guard lock(mMutex);
+            const std::lock_guard lock(mCacheMutex);
             mCache.insert_or_assign(tilePosition,
                 CachedTile{
                     .mVersion = result->getVersion(),
@@ -378,11 +394,12 @@ namespace DetourNavigator
     std::shared_ptr<RecastMesh> TileCachedRecastMeshManager::getCachedMesh(
         ESM::RefId worldspace, const TilePosition& tilePosition) const
     {
-        const std::lock_guard lock(mMutex);
+        const std::shared_lock lock(mMutex);
         if (mWorldspace != worldspace)
             return nullptr;
         if (!isInTilesPositionsRange(mRange, tilePosition))
             return nullptr;
+        const std::lock_guard cacheLock(mCacheMutex);
         const auto it = mCache.find(tilePosition);
         if (it == mCache.end())
             return nullptr;
@@ -393,7 +410,7 @@ namespace DetourNavigator
         ESM::RefId worldspace, const TilePosition& tilePosition) const
     {
         {
-            const std::lock_guard lock(mMutex);
+            const std::shared_lock lock(mMutex);
             if (mWorldspace != worldspace)
                 return nullptr;
         }
@@ -431,6 +448,7 @@ namespace DetourNavigator
     {
         {
             const MaybeLockGuard lock(mMutex, guard);
+            const std::lock_guard cacheLock(mCacheMutex);
             for (const auto& [tilePosition, changeType] : mChangedTiles)
                 if (const auto it = mCache.find(tilePosition); it != mCache.end())
                     ++it->second.mVersion.mRevision;
@@ -440,7 +458,8 @@ namespace DetourNavigator
 
     TileCachedRecastMeshManagerStats TileCachedRecastMeshManager::getStats() const
     {
-        const std::lock_guard lock(mMutex);
+        const std::shared_lock lock(mMutex);
+        const std::lock_guard cacheLock(mCacheMutex);
         return TileCachedRecastMeshManagerStats{
             .mTiles = mCache.size(),
             .mObjects = mObjects.size(),
@@ -492,10 +511,13 @@ namespace DetourNavigator
         using Object = std::tuple<osg::ref_ptr<const Resource::BulletShapeInstance>, ObjectTransform,
             std::reference_wrapper<const btCollisionShape>, btTransform, AreaType>;
         std::vector<Object> objects;
+        using ObstacleObject = std::tuple<osg::ref_ptr<const Resource::BulletShapeInstance>,
+            std::reference_wrapper<const btCollisionShape>, btTransform>;
+        std::vector<ObstacleObject> obstacles;
         Version version;
         bool hasInput = false;
         {
-            const std::lock_guard lock(mMutex);
+            const std::shared_lock lock(mMutex);
             for (auto it = mWaterIndex.qbegin(makeIndexQuery(tilePosition)); it != mWaterIndex.qend(); ++it)
             {
                 const auto& [cellPosition, data] = *it->second;
@@ -512,8 +534,11 @@ namespace DetourNavigator
             for (auto it = mObjectIndex.qbegin(makeIndexQuery(tilePosition)); it != mObjectIndex.qend(); ++it)
             {
                 const auto& object = it->second->mObject;
-                objects.emplace_back(object.getInstance(), object.getObjectTransform(), object.getShape(),
-                    object.getTransform(), object.getAreaType());
+                if (isObstacle(object, it->second->mMoved, mSettings.mMaxObstacleSize))
+                    obstacles.emplace_back(object.getInstance(), object.getShape(), object.getTransform());
+                else
+                    objects.emplace_back(object.getInstance(), object.getObjectTransform(), object.getShape(),
+                        object.getTransform(), object.getAreaType());
                 hasInput = true;
             }
             if (hasInput)
@@ -532,6 +557,8 @@ namespace DetourNavigator
             return nullptr;
         for (const auto& [instance, objectTransform, shape, transform, areaType] : objects)
             builder.addObject(shape, transform, areaType, instance->getSource(), objectTransform);
+        for (const auto& [instance, shape, transform] : obstacles)
+            builder.addObstacle(shape, transform);
         return std::move(builder).create(version);
     }
 
@@ -25,6 +25,7 @@
 #include <memory>
 #include <mutex>
 #include <optional>
+#include <shared_mutex>
 #include <unordered_map>
 
 namespace DetourNavigator
@@ -32,6 +33,11 @@ namespace DetourNavigator
     class RecastMesh;
     struct TileCachedRecastMeshManagerStats;
 
+    /// @brief Keeps the objects, water and heightfields around the player indexed by tile and builds recast meshes
+    /// for the tiles.
+    /// @par Worker threads building recast meshes only take a shared lock on the input, so they do not wait for each
+    /// other. The cache of built meshes has its own mutex, so a cache hit does not wait for the input update.
+    /// @note mMutex is always locked before mCacheMutex.
     class TileCachedRecastMeshManager
     {
     public:
@@ -97,6 +103,7 @@ namespace DetourNavigator
             std::size_t mRevision = 0;
             std::optional<Report> mLastNavMeshReportedChange;
             std::optional<Report> mLastNavMeshReport;
+            bool mMoved = false;
         };
 
         struct WaterData
@@ -138,10 +145,12 @@ namespace DetourNavigator
         std::map<osg::Vec2i, HeightfieldData>::const_iterator mInfiniteHeightfield = mHeightfields.end();
         boost::geometry::index::rtree<HeightfieldIndexValue, boost::geometry::index::linear<4>> mHeightfieldIndex;
         std::map<osg::Vec2i, ChangeType> mChangedTiles;
+        // Guarded by mCacheMutex
         std::map<TilePosition, CachedTile> mCache;
         std::size_t mGeneration = 0;
         std::size_t mRevision = 0;
-        mutable std::mutex mMutex;
+        mutable std::shared_mutex mMutex;
+        mutable std::mutex mCacheMutex;
         UpdateGuard mUpdateGuard{ mMutex };
 
         inline static IndexPoint makeIndexPoint(const TilePosition& tilePosition);
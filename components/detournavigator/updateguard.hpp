@@ -2,20 +2,20 @@
 #define OPENMW_COMPONENTS_DETOURNAVIGATOR_UPDATEGUARD_H
 
 #include <memory>
-#include <mutex>
+#include <shared_mutex>
 
 namespace DetourNavigator
 {
     class UpdateGuard
     {
     public:
-        explicit UpdateGuard(std::mutex& mutex)
+        explicit UpdateGuard(std::shared_mutex& mutex)
             : mMutex(mutex)
         {
         }
 
     private:
-        std::mutex& mMutex;
+        std::shared_mutex& mMutex;
 
         friend struct UnlockUpdateGuard;
     };
@@ -145,6 +145,9 @@ namespace ESM
         // format 21 - Random state in saved games.
         REC_RAND = esm3Recname("RAND"), // Random state.
 
+        // format 35 - Compressed sections in saved games.
+        REC_CSEC = esm3Recname("CSEC"), // LZ4 compressed saved game records
+
         REC_ATTR = esm3Recname("ATTR"), // Attribute
 
         REC_AACT4 = esm4Recname(ESM4::REC_AACT), // Action
@@ -66,6 +66,10 @@ namespace ESM
 
     bool StringRefId::operator<(StringRefId rhs) const noexcept
     {
+        // Values are interned, equal ids share the string. Ordered containers end every lookup with comparing equal
+        // ids, this saves a string comparison for each of them.
+        if (mValue == rhs.mValue)
+            return false;
         return Misc::StringUtils::ciLess(*mValue, *rhs.mValue);
     }
 
@@ -0,0 +1,166 @@
+#include "compressedsavedgame.hpp"
+
+#include <components/esm/defs.hpp>
+#include <components/files/conversion.hpp>
+#include <components/files/openfile.hpp>
+#include <components/misc/compression.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <future>
+#include <iterator>
+#include <sstream>
+#include <stdexcept>
+#include <thread>
+#include <variant>
+#include <vector>
+
+namespace ESM
+{
+    namespace
+    {
+        // Record header: name, size, unused, flags
+        constexpr std::size_t recordHeaderSize = 4 * sizeof(std::uint32_t);
+        // Subrecord header: name, size
+        constexpr std::size_t subRecordHeaderSize = 2 * sizeof(std::uint32_t);
+
+        constexpr std::uint32_t dataSubRecordName = esm3Recname("DATA");
+
+        std::uint32_t readUint(std::string_view data, std::size_t offset)
+        {
+            std::uint32_t result;
+            std::memcpy(&result, data.data() + offset, sizeof(result));
+            return result;
+        }
+
+        void appendUint(std::string& out, std::uint32_t value)
+        {
+            out.append(reinterpret_cast<const char*>(&value), sizeof(value));
+        }
+
+        std::string_view getRecord(std::string_view data, std::size_t offset)
+        {
+            if (data.size() - offset < recordHeaderSize)
+                throw std::runtime_error("Unexpected end of saved game while reading record header");
+            const std::uint32_t size = readUint(data, offset + sizeof(std::uint32_t));
+            if (data.size() - offset - recordHeaderSize < size)
+                throw std::runtime_error("Unexpected end of saved game while reading record");
+            return data.substr(offset, recordHeaderSize + size);
+        }
+
+        std::string_view getCompressedSection(std::string_view record)
+        {
+            const std::string_view subRecord = record.substr(recordHeaderSize);
+            if (subRecord.size() < subRecordHeaderSize || readUint(subRecord, 0) != dataSubRecordName)
+                throw std::runtime_error("Compressed saved game section doesn't start with DATA subrecord");
+            const std::uint32_t size = readUint(subRecord, sizeof(std::uint32_t));
+            if (subRecord.size() - subRecordHeaderSize != size)
+                throw std::runtime_error("Invalid size of compressed saved game section");
+            return subRecord.substr(subRecordHeaderSize);
+        }
+
+        void appendCompressedSection(std::string& out, const std::vector<std::byte>& compressed)
+        {
+            appendUint(out, REC_CSEC);
+            appendUint(out, static_cast<std::uint32_t>(subRecordHeaderSize + compressed.size()));
+            appendUint(out, 0);
+            appendUint(out, 0);
+            appendUint(out, dataSubRecordName);
+            appendUint(out, static_cast<std::uint32_t>(compressed.size()));
+            out.append(reinterpret_cast<const char*>(compressed.data()), compressed.size());
+        }
+
+        std::vector<std::byte> toBytes(std::string_view data)
+        {
+            const std::byte* const begin = reinterpret_cast<const std::byte*>(data.data());
+            return std::vector<std::byte>(begin, begin + data.size());
+        }
+    }
+
+    std::string compressSavedGame(std::string_view data, std::size_t bodyOffset, std::size_t sectionSize)
+    {
+        std::string result(data.substr(0, bodyOffset));
+        std::size_t begin = bodyOffset;
+        while (begin < data.size())
+        {
+            std::size_t end = begin;
+            while (end < data.size() && end - begin < sectionSize)
+                end += getRecord(data, end).size();
+            appendCompressedSection(result, Misc::compress(toBytes(data.substr(begin, end - begin))));
+            begin = end;
+        }
+        return result;
+    }
+
+    std::string decompressSavedGame(std::string_view data)
+    {
+        struct Section
+        {
+            std::string_view mCompressed;
+            std::vector<std::byte> mDecompressed;
+        };
+
+        // Either uncompressed record or index of a section
+        std::vector<std::variant<std::string_view, std::size_t>> parts;
+        std::vector<Section> sections;
+        for (std::size_t offset = 0; offset < data.size();)
+        {
+            const std::string_view record = getRecord(data, offset);
+            if (readUint(record, 0) == REC_CSEC)
+            {
+                parts.emplace_back(sections.size());
+                sections.push_back(Section{ getCompressedSection(record), {} });
+            }
+            else if (!parts.empty() && std::holds_alternative<std::string_view>(parts.back()))
+            {
+                const std::string_view previous = std::get<std::string_view>(parts.back());
+                parts.back() = std::string_view(previous.data(), previous.size() + record.size());
+            }
+            else
+                parts.emplace_back(record);
+            offset += record.size();
+        }
+
+        std::atomic_size_t next = 0;
+        const auto decompress = [&] {
+            for (std::size_t i; (i = next++) < sections.size();)
+                sections[i].mDecompressed = Misc::decompress(toBytes(sections[i].mCompressed));
+        };
+
+        {
+            const std::size_t threads
+                = std::min<std::size_t>(sections.size(), std::max(1U, std::thread::hardware_concurrency()));
+            std::vector<std::future<void>> tasks;
+            for (std::size_t i = 1; i < threads; ++i)
+                tasks.push_back(std::async(std::launch::async, decompress));
+            decompress();
+            for (std::future<void>& task : tasks)
+                task.get();
+        }
+
+        std::string result;
+        for (const auto& part : parts)
+        {
+            if (const std::string_view* records = std::get_if<std::string_view>(&part))
+                result.append(*records);
+            else
+            {
+                const std::vector<std::byte>& records = sections[std::get<std::size_t>(part)].mDecompressed;
+                result.append(reinterpret_cast<const char*>(records.data()), records.size());
+            }
+        }
+        return result;
+    }
+
+    std::unique_ptr<std::istream> openSavedGame(const std::filesystem::path& path)
+    {
+        std::unique_ptr<std::ifstream> file = Files::openBinaryInputFileStream(path);
+        std::string data{ std::istreambuf_iterator<char>(*file), std::istreambuf_iterator<char>() };
+        if (file->bad())
+            throw std::runtime_error("Failed to read saved game: " + Files::pathToUnicodeString(path));
+        return std::make_unique<std::istringstream>(decompressSavedGame(data));
+    }
+}
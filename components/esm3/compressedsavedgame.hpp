@@ -0,0 +1,28 @@
+#ifndef OPENMW_COMPONENTS_ESM3_COMPRESSEDSAVEDGAME_H
+#define OPENMW_COMPONENTS_ESM3_COMPRESSEDSAVEDGAME_H
+
+#include <cstddef>
+#include <filesystem>
+#include <istream>
+#include <memory>
+#include <string>
+#include <string_view>
+
+namespace ESM
+{
+    // Compressed saved game keeps the TES3 header and all records before `bodyOffset` (normally the REC_SAVE record
+    // with the screenshot) as is, so they can be read without decompression. Following records are grouped into
+    // sections of at least `sectionSize` bytes, each section is stored as a REC_CSEC record with a single DATA
+    // subrecord holding the section compressed by Misc::compress.
+
+    // `data` is a complete saved game file.
+    std::string compressSavedGame(std::string_view data, std::size_t bodyOffset, std::size_t sectionSize);
+
+    // Replaces REC_CSEC records by their content. Sections are decompressed in parallel.
+    std::string decompressSavedGame(std::string_view data);
+
+    // Opens a saved game file decompressing it if needed.
+    std::unique_ptr<std::istream> openSavedGame(const std::filesystem::path& path);
+}
+
+#endif
@@ -19,7 +19,7 @@ namespace ESM
     ESM_Context ESMReader::getContext()
     {
         // Update the file position before returning
-        mCtx.filePos = mEsm->tellg();
+        mCtx.filePos = getFileOffset();
         return mCtx;
     }
 
@@ -43,11 +43,13 @@ namespace ESM
         mCtx = rc;
 
         // Make sure we seek to the right place
+        mRecordBuffered = false;
         mEsm->seekg(mCtx.filePos);
     }
 
     void ESMReader::close()
     {
+        mRecordBuffered = false;
         mEsm.reset();
         clearCtx();
         mHeader.blank();
@@ -198,7 +200,7 @@ namespace ESM
         // them. For some reason, they break the rules, and contain a byte
         // (value 0) even if the header says there is no data. If
         // Morrowind accepts it, so should we.
-        if (mCtx.leftSub == 0 && hasMoreSubs() && !mEsm->peek())
+        if (mCtx.leftSub == 0 && hasMoreSubs() && !peek())
         {
             // Skip the following zero byte
             mCtx.leftRec--;
@@ -228,7 +230,7 @@ namespace ESM
         // (value 0) even if the header says there is no data. If
         // Morrowind accepts it, so should we.
         if (mHeader.mFormatVersion <= MaxStringRefIdFormatVersion && mCtx.leftSub == 0 && hasMoreSubs()
-            && !mEsm->peek())
+            && !peek())
         {
             // Skip the following zero byte
             mCtx.leftRec--;
@@ -350,6 +352,8 @@ namespace ESM
         if (hasMoreSubs())
             fail("Previous record contains unread bytes");
 
+        dropRecordBuffer();
+
         // We went out of the previous record's bounds. Backtrack.
         if (mCtx.leftRec < 0)
             mEsm->seekg(mCtx.leftRec, std::ios::cur);
@@ -390,6 +394,51 @@ namespace ESM
 
         // Adjust number of bytes mCtx.left in file
         mCtx.leftFile -= mCtx.leftRec;
+
+        if (!mBufferRecords)
+            return;
+
+        dropRecordBuffer();
+        const std::streamoff offset = mEsm->tellg();
+        mRecordBuffer.resize(static_cast<std::size_t>(mCtx.leftRec));
+        mEsm->read(mRecordBuffer.data(), static_cast<std::streamsize>(mRecordBuffer.size()));
+        if (mEsm->gcount() != static_cast<std::streamsize>(mRecordBuffer.size()))
+        {
+            // Truncated file, let the regular reads report it
+            mEsm->clear();
+            mEsm->seekg(offset);
+            return;
+        }
+        mRecordBufferOffset = static_cast<std::size_t>(offset);
+        mRecordBufferPos = 0;
+        mRecordBuffered = true;
+    }
+
+    void ESMReader::setBufferRecords(bool value)
+    {
+        mBufferRecords = value;
+        if (value)
+            return;
+        dropRecordBuffer();
+        mRecordBuffer = std::vector<char>();
+    }
+
+    void ESMReader::dropRecordBuffer()
+    {
+        if (!mRecordBuffered)
+            return;
+        mRecordBuffered = false;
+        // The stream is at the end of the record already unless the record wasn't read to the end
+        if (mRecordBufferPos != mRecordBuffer.size())
+            mEsm->seekg(static_cast<std::streamoff>(mRecordBufferOffset + mRecordBufferPos));
+    }
+
+    int ESMReader::peek()
+    {
+        if (mRecordBuffered && mRecordBufferPos < mRecordBuffer.size())
+            return static_cast<unsigned char>(mRecordBuffer[mRecordBufferPos]);
+        dropRecordBuffer();
+        return mEsm->peek();
     }
 
     /*************************************************************************
@@ -422,6 +471,17 @@ namespace ESM
 
     std::string_view ESMReader::getStringView(std::size_t size)
     {
+        if (mRecordBuffered && size <= mRecordBuffer.size() - mRecordBufferPos)
+        {
+            // Hand out the bytes of the record without copying them
+            const char* ptr = mRecordBuffer.data() + mRecordBufferPos;
+            mRecordBufferPos += size;
+            size = strnlen(ptr, size);
+            if (mEncoder != nullptr)
+                return mEncoder->getUtf8(std::string_view(ptr, size));
+            return std::string_view(ptr, size);
+        }
+
         if (mBuffer.size() <= size)
             // Add some extra padding to reduce the chance of having to resize
             // again later.
@@ -523,7 +583,7 @@ namespace ESM
         ss << "\n  Record: " << mCtx.recName.toStringView();
         ss << "\n  Subrecord: " << mCtx.subName.toStringView();
         if (mEsm.get())
-            ss << "\n  Offset: 0x" << std::hex << mEsm->tellg();
+            ss << "\n  Offset: 0x" << std::hex << getFileOffset();
         throw std::runtime_error(ss.str());
     }
 
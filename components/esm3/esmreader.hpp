@@ -3,6 +3,7 @@
 
 #include <array>
 #include <cstdint>
+#include <cstring>
 #include <filesystem>
 #include <istream>
 #include <map>
@@ -100,7 +101,18 @@ namespace ESM
         void openRaw(const std::filesystem::path& filename);
 
         /// Get the current position in the file. Make sure that the file has been opened!
-        size_t getFileOffset() const { return mEsm->tellg(); }
+        size_t getFileOffset() const
+        {
+            if (mRecordBuffered)
+                return mRecordBufferOffset + mRecordBufferPos;
+            return mEsm->tellg();
+        }
+
+        /// Read each record into memory with a single read when its header is read, subrecords are then read from
+        /// that buffer. String views returned by getHStringView and getStringView point into the buffer when no
+        /// conversion is needed and stay valid until the next string is read.
+        /// @note Reading past the end of a record, which broken files do, switches back to the stream.
+        void setBufferRecords(bool value);
 
         // This is a quick hack for multiple esm/esp files. Each plugin introduces its own
         //  terrain palette, but ESMReader does not pass a reference to the correct plugin
@@ -322,6 +334,13 @@ namespace ESM
 
         void getExact(void* x, std::size_t size)
         {
+            if (mRecordBuffered && size <= mRecordBuffer.size() - mRecordBufferPos)
+            {
+                std::memcpy(x, mRecordBuffer.data() + mRecordBufferPos, size);
+                mRecordBufferPos += size;
+                return;
+            }
+            dropRecordBuffer();
             mEsm->read(static_cast<char*>(x), static_cast<std::streamsize>(size));
         }
 
@@ -340,6 +359,12 @@ namespace ESM
 
         void skip(std::size_t bytes)
         {
+            if (mRecordBuffered && bytes <= mRecordBuffer.size() - mRecordBufferPos)
+            {
+                mRecordBufferPos += bytes;
+                return;
+            }
+            dropRecordBuffer();
             char buffer[4096];
             if (bytes > std::size(buffer))
                 mEsm->seekg(getFileOffset() + bytes);
@@ -353,6 +378,8 @@ namespace ESM
         /// Sets font encoder for ESM strings
         void setEncoder(ToUTF8::Utf8Encoder* encoder) { mEncoder = encoder; }
 
+        ToUTF8::Utf8Encoder* getEncoder() const { return mEncoder; }
+
         /// Get record flags of last record
         uint32_t getRecordFlags() { return mRecordFlags; }
 
@@ -368,6 +395,11 @@ namespace ESM
 
         RefId getRefIdImpl(std::size_t size);
 
+        // Continue reading from the stream at the current position within the buffered record
+        void dropRecordBuffer();
+
+        int peek();
+
         std::unique_ptr<std::istream> mEsm;
 
         ESM_Context mCtx;
@@ -379,6 +411,13 @@ namespace ESM
         // Buffer for ESM strings
         std::vector<char> mBuffer;
 
+        // The current record if records are buffered, mRecordBufferOffset is the file offset of the first byte
+        std::vector<char> mRecordBuffer;
+        std::size_t mRecordBufferPos = 0;
+        std::size_t mRecordBufferOffset = 0;
+        bool mRecordBuffered = false;
+        bool mBufferRecords = false;
+
         Header mHeader;
 
         ToUTF8::Utf8Encoder* mEncoder;
@@ -144,6 +144,14 @@ namespace ESM
         endRecord("TES3");
     }
 
+    void ESMWriter::setStream(std::ostream& file)
+    {
+        mRecordCount = 0;
+        mRecords.clear();
+        mCounting = true;
+        mStream = &file;
+    }
+
     void ESMWriter::close()
     {
         if (!mRecords.empty())
@@ -59,6 +59,10 @@ namespace ESM
         void save(std::ostream& file);
         ///< Start saving a file by writing the TES3 header.
 
+        void setStream(std::ostream& file);
+        ///< Write records to \a file without a TES3 header, e.g. to serialize them separately from the file they are
+        /// appended to later.
+
         void close();
         ///< \note Does not close the stream.
 
@@ -3,6 +3,7 @@
 #include <algorithm>
 #include <cstdint>
 #include <limits>
+#include <mutex>
 #include <utility>
 
 #include <components/esm/defs.hpp>
@@ -230,6 +231,10 @@ namespace ESM
 
     void Land::loadData(int dataTypes) const
     {
+        // The data may be loaded when it is used first, which can happen on several threads at the same time
+        static std::mutex mutex;
+        const std::lock_guard<std::mutex> lock(mutex);
+
         if (mLandData == nullptr)
             mLandData = std::make_unique<LandData>();
 
@@ -25,6 +25,7 @@
 #undef DEBUG_GROUPSTACK
 
 #include <algorithm>
+#include <cstring>
 #include <iomanip>
 #include <iostream>
 #include <optional>
@@ -34,11 +35,11 @@
 
 #include <zlib.h>
 
-#include <components/bsa/memorystream.hpp>
 #include <components/debug/debuglog.hpp>
 #include <components/esm/refid.hpp>
 #include <components/files/constrainedfilestream.hpp>
 #include <components/files/conversion.hpp>
+#include <components/files/memorystream.hpp>
 #include <components/misc/strings/lower.hpp>
 #include <components/toutf8/toutf8.hpp>
 #include <components/vfs/manager.hpp>
@@ -128,33 +129,28 @@ namespace ESM4
             return std::nullopt;
         }
 
-        std::unique_ptr<Bsa::MemoryInputStream> decompress(
-            std::streamoff position, std::span<char> compressed, std::uint32_t uncompressedSize)
+        void decompress(std::streamoff position, std::span<char> compressed, std::span<char> decompressed)
         {
-            auto result = std::make_unique<Bsa::MemoryInputStream>(uncompressedSize);
-
-            const std::span decompressed(result->getRawData(), uncompressedSize);
-
             const auto allError = tryDecompressAll(compressed, decompressed);
             if (!allError.has_value())
-                return result;
+                return;
 
             Log(Debug::Warning) << "Failed to decompress record data at 0x" << std::hex << position
                                 << std::resetiosflags(std::ios_base::hex) << " compressed size = " << compressed.size()
-                                << " uncompressed size = " << uncompressedSize << ": " << *allError
+                                << " uncompressed size = " << decompressed.size() << ": " << *allError
                                 << ". Trying to decompress by block...";
 
-            std::memset(result->getRawData(), 0, uncompressedSize);
+            std::memset(decompressed.data(), 0, decompressed.size());
 
             constexpr std::size_t blockSize = 4;
             const auto blockError = tryDecompressByBlock(compressed, decompressed, blockSize);
             if (!blockError.has_value())
-                return result;
+                return;
 
             std::ostringstream s;
             s << "Failed to decompress record data by block of " << blockSize << " bytes at 0x" << std::hex << position
               << std::resetiosflags(std::ios_base::hex) << " compressed size = " << compressed.size()
-              << " uncompressed size = " << uncompressedSize << ": " << *blockError;
+              << " uncompressed size = " << decompressed.size() << ": " << *blockError;
             throw std::runtime_error(s.str());
         }
     }
@@ -523,20 +519,21 @@ namespace ESM4
             const std::streamoff position = mStream->tellg();
 
             const std::uint32_t recordSize = mCtx.recordHeader.record.dataSize - sizeof(std::uint32_t);
-            std::vector<char> compressed(recordSize);
-            mStream->read(compressed.data(), recordSize);
+            mCompressedData.resize(recordSize);
+            mStream->read(mCompressedData.data(), recordSize);
             mSavedStream = std::move(mStream);
 
             mCtx.recordHeader.record.dataSize = uncompressedSize - sizeof(uncompressedSize);
 
-            auto memoryStreamPtr = decompress(position, compressed, uncompressedSize);
+            mDecompressedData.resize(uncompressedSize);
+            decompress(position, mCompressedData, mDecompressedData);
 
             // For debugging only
             // #if 0
             if (dump)
             {
                 std::ostringstream ss;
-                char* data = memoryStreamPtr->getRawData();
+                const char* data = mDecompressedData.data();
                 for (unsigned int i = 0; i < uncompressedSize; ++i)
                 {
                     if (data[i] > 64 && data[i] < 91)
@@ -551,7 +548,7 @@ namespace ESM4
                 std::cout << ss.str() << std::endl;
             }
             // #endif
-            mStream = std::make_unique<Files::StreamWithBuffer<Bsa::MemoryInputStream>>(std::move(memoryStreamPtr));
+            mStream = std::make_unique<Files::IMemStream>(mDecompressedData.data(), mDecompressedData.size());
         }
     }
 
@@ -29,6 +29,7 @@
 #include <map>
 #include <memory>
 #include <unordered_map>
+#include <vector>
 
 #include "cellgrid.hpp"
 #include "common.hpp"
@@ -157,6 +158,11 @@ namespace ESM4
         Files::IStreamPtr mStream;
         Files::IStreamPtr mSavedStream; // mStream is saved here while using deflated memory stream
 
+        // Reused for every compressed record to not allocate each time, the deflated memory stream reads from
+        // mDecompressedData
+        std::vector<char> mCompressedData;
+        std::vector<char> mDecompressedData;
+
         Files::IStreamPtr mStrings;
         Files::IStreamPtr mILStrings;
         Files::IStreamPtr mDLStrings;
@@ -5,6 +5,7 @@
 #include <components/esm/defs.hpp>
 #include <components/esm3/loadacti.hpp>
 #include <components/esm3/loadcont.hpp>
+#include <components/esm3/loadcrea.hpp>
 #include <components/esm3/loaddoor.hpp>
 #include <components/esm3/loadgmst.hpp>
 #include <components/esm3/loadland.hpp>
@@ -52,6 +53,8 @@ namespace EsmLoader
                     return withStatic(refId, content.mActivators, std::forward<F>(f));
                 case ESM::REC_CONT:
                     return withStatic(refId, content.mContainers, std::forward<F>(f));
+                case ESM::REC_CREA:
+                    return withStatic(refId, content.mCreatures, std::forward<F>(f));
                 case ESM::REC_DOOR:
                     return withStatic(refId, content.mDoors, std::forward<F>(f));
                 case ESM::REC_STAT:
@@ -12,6 +12,7 @@ namespace ESM
     struct Activator;
     struct Cell;
     struct Container;
+    struct Creature;
     struct Door;
     struct GameSetting;
     struct Land;
@@ -33,6 +34,7 @@ namespace EsmLoader
         std::vector<ESM::Activator> mActivators;
         std::vector<ESM::Cell> mCells;
         std::vector<ESM::Container> mContainers;
+        std::vector<ESM::Creature> mCreatures;
         std::vector<ESM::Door> mDoors;
         std::vector<ESM::GameSetting> mGameSettings;
         std::vector<ESM::Land> mLands;
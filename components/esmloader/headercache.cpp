@@ -0,0 +1,250 @@
+#include "headercache.hpp"
+
+#include <components/debug/debuglog.hpp>
+#include <components/esm/fourcc.hpp>
+#include <components/esm3/esmreader.hpp>
+#include <components/esm3/esmwriter.hpp>
+#include <components/esm3/formatversion.hpp>
+#include <components/esm4/reader.hpp>
+#include <components/files/conversion.hpp>
+#include <components/files/openfile.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <fstream>
+#include <future>
+#include <stdexcept>
+#include <system_error>
+#include <thread>
+
+namespace EsmLoader
+{
+    namespace
+    {
+        // Increment when the way headers are written changes
+        constexpr int headerCacheVersion = 1;
+
+        constexpr std::string_view headerCacheAuthor = "OpenMW";
+
+        constexpr std::uint32_t headerRecordId = ESM::fourCC("PHDR");
+
+        std::string getHeaderCacheDescription()
+        {
+            return "plugin headers " + std::to_string(headerCacheVersion);
+        }
+
+        bool getFileState(const std::filesystem::path& path, std::uint64_t& size, std::int64_t& time)
+        {
+            std::error_code ec;
+            size = std::filesystem::file_size(path, ec);
+            if (ec)
+                return false;
+            time = static_cast<std::int64_t>(std::filesystem::last_write_time(path, ec).time_since_epoch().count());
+            return !ec;
+        }
+
+        template <class Reader>
+        PluginHeader makePluginHeader(ESM::Format format, const Reader& reader)
+        {
+            PluginHeader header;
+            header.mFormat = format;
+            header.mVersion = reader.esmVersionF();
+            header.mAuthor = reader.getAuthor();
+            header.mDescription = reader.getDesc();
+            for (const auto& master : reader.getGameFiles())
+                header.mMasters.push_back(master.name);
+            return header;
+        }
+    }
+
+    PluginHeader readPluginHeader(const std::filesystem::path& path)
+    {
+        auto stream = Files::openBinaryInputFileStream(path);
+        if (!stream->is_open())
+            throw std::runtime_error(
+                "Failed to open " + Files::pathToUnicodeString(path) + ": " + std::generic_category().message(errno));
+        const ESM::Format format = ESM::readFormat(*stream);
+        stream->seekg(0);
+        switch (format)
+        {
+            case ESM::Format::Tes3:
+            {
+                ESM::ESMReader reader;
+                reader.open(std::move(stream), path);
+                return makePluginHeader(format, reader);
+            }
+            case ESM::Format::Tes4:
+            {
+                ESM4::Reader reader(std::move(stream), path, nullptr, nullptr, true);
+                return makePluginHeader(format, reader);
+            }
+        }
+        throw std::runtime_error("Unsupported ESM format " + ESM::NAME(format).toString());
+    }
+
+    HeaderCache::HeaderCache(std::filesystem::path path)
+        : mPath(std::move(path))
+    {
+        if (!mPath.empty())
+            read();
+    }
+
+    std::vector<PluginHeaderResult> HeaderCache::get(std::span<const std::filesystem::path> files)
+    {
+        std::vector<PluginHeaderResult> result(files.size());
+        std::vector<std::size_t> missing;
+        std::vector<Entry> states(files.size());
+        for (std::size_t i = 0; i < files.size(); ++i)
+        {
+            Entry& state = states[i];
+            if (!getFileState(files[i], state.mSize, state.mTime))
+            {
+                result[i].mError = "Failed to open " + Files::pathToUnicodeString(files[i]);
+                continue;
+            }
+            const auto it = mEntries.find(files[i]);
+            if (it != mEntries.end() && it->second.mSize == state.mSize && it->second.mTime == state.mTime)
+            {
+                result[i].mHeader = it->second.mHeader;
+                continue;
+            }
+            missing.push_back(i);
+        }
+
+        if (missing.empty())
+            return result;
+
+        std::atomic<std::size_t> next{ 0 };
+        const auto readMissing = [&] {
+            for (std::size_t i; (i = next.fetch_add(1, std::memory_order_relaxed)) < missing.size();)
+            {
+                const std::size_t index = missing[i];
+                try
+                {
+                    result[index].mHeader = readPluginHeader(files[index]);
+                }
+                catch (const std::exception& e)
+                {
+                    result[index].mError = e.what();
+                }
+            }
+        };
+
+        const std::size_t threads
+            = std::min<std::size_t>(std::max(1u, std::thread::hardware_concurrency()), missing.size());
+        std::vector<std::future<void>> workers;
+        for (std::size_t i = 1; i < threads; ++i)
+            workers.push_back(std::async(std::launch::async, readMissing));
+        readMissing();
+        for (std::future<void>& worker : workers)
+            worker.get();
+
+        for (const std::size_t index : missing)
+        {
+            if (!result[index].mHeader.has_value())
+                continue;
+            Entry& entry = states[index];
+            entry.mHeader = *result[index].mHeader;
+            mEntries.insert_or_assign(files[index], std::move(entry));
+            mChanged = true;
+        }
+
+        return result;
+    }
+
+    void HeaderCache::read()
+    {
+        std::error_code ec;
+        if (!std::filesystem::exists(mPath, ec))
+            return;
+
+        try
+        {
+            ESM::ESMReader reader;
+            reader.open(mPath);
+            if (reader.getAuthor() != headerCacheAuthor || reader.getDesc() != getHeaderCacheDescription())
+            {
+                Log(Debug::Info) << "Plugin header cache " << mPath << " is outdated";
+                return;
+            }
+
+            std::map<std::filesystem::path, Entry> entries;
+            while (reader.hasMoreRecs())
+            {
+                if (reader.getRecName().toInt() != headerRecordId)
+                    throw std::runtime_error("Unexpected record " + reader.getRecName().toString());
+                reader.getRecHeader();
+                const std::filesystem::path path = Files::pathFromUnicodeString(reader.getHNString("PATH"));
+                Entry entry;
+                reader.getHNT(entry.mSize, "SIZE");
+                reader.getHNT(entry.mTime, "TIME");
+                std::uint32_t format = 0;
+                reader.getHNT(format, "FORM");
+                entry.mHeader.mFormat = static_cast<ESM::Format>(format);
+                reader.getHNT(entry.mHeader.mVersion, "VERS");
+                entry.mHeader.mAuthor = reader.getHNOString("AUTH");
+                entry.mHeader.mDescription = reader.getHNOString("DESC");
+                while (reader.isNextSub("MAST"))
+                    entry.mHeader.mMasters.push_back(reader.getHString());
+                entries.insert_or_assign(path, std::move(entry));
+            }
+            mEntries = std::move(entries);
+        }
+        catch (const std::exception& e)
+        {
+            Log(Debug::Warning) << "Failed to read plugin header cache " << mPath << ": " << e.what();
+        }
+    }
+
+    void HeaderCache::write()
+    {
+        if (mPath.empty() || !mChanged)
+            return;
+
+        std::filesystem::path temporaryPath = mPath;
+        temporaryPath += ".tmp";
+
+        try
+        {
+            ESM::ESMWriter writer;
+            writer.setFormatVersion(ESM::CurrentSaveGameFormatVersion);
+            writer.setVersion(0);
+            writer.setType(0);
+            writer.setAuthor(headerCacheAuthor);
+            writer.setDescription(getHeaderCacheDescription());
+
+            {
+                std::ofstream stream(temporaryPath, std::ios::binary);
+                stream.exceptions(std::ios::failbit | std::ios::badbit);
+                writer.save(stream);
+                for (const auto& [path, entry] : mEntries)
+                {
+                    writer.startRecord(headerRecordId);
+                    writer.writeHNString("PATH", Files::pathToUnicodeString(path));
+                    writer.writeHNT("SIZE", entry.mSize);
+                    writer.writeHNT("TIME", entry.mTime);
+                    writer.writeHNT("FORM", static_cast<std::uint32_t>(entry.mHeader.mFormat));
+                    writer.writeHNT("VERS", entry.mHeader.mVersion);
+                    writer.writeHNOString("AUTH", entry.mHeader.mAuthor);
+                    writer.writeHNOString("DESC", entry.mHeader.mDescription);
+                    for (const std::string& master : entry.mHeader.mMasters)
+                        writer.writeHNString("MAST", master);
+                    writer.endRecord(headerRecordId);
+                }
+                writer.close();
+            }
+
+            std::filesystem::rename(temporaryPath, mPath);
+        }
+        catch (const std::exception& e)
+        {
+            std::error_code ec;
+            std::filesystem::remove(temporaryPath, ec);
+            Log(Debug::Warning) << "Failed to write plugin header cache " << mPath << ": " << e.what();
+            return;
+        }
+
+        mChanged = false;
+    }
+}
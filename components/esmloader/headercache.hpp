@@ -0,0 +1,66 @@
+#ifndef OPENMW_COMPONENTS_ESMLOADER_HEADERCACHE_H
+#define OPENMW_COMPONENTS_ESMLOADER_HEADERCACHE_H
+
+#include <components/esm/format.hpp>
+
+#include <cstdint>
+#include <filesystem>
+#include <map>
+#include <optional>
+#include <span>
+#include <string>
+#include <vector>
+
+namespace EsmLoader
+{
+    /// Header of a TES3 or TES4 content file. Strings are in the legacy encoding of the file.
+    struct PluginHeader
+    {
+        ESM::Format mFormat = ESM::Format::Tes3;
+        float mVersion = 0;
+        std::string mAuthor;
+        std::string mDescription;
+        std::vector<std::string> mMasters;
+    };
+
+    struct PluginHeaderResult
+    {
+        std::optional<PluginHeader> mHeader;
+        // Why the header couldn't be read when there is none
+        std::string mError;
+    };
+
+    /// Reads only the header of the content file. Throws on failure.
+    PluginHeader readPluginHeader(const std::filesystem::path& path);
+
+    /// Headers of content files by path, reused while the size and the modification time of the file stay the same.
+    /// Not thread safe.
+    class HeaderCache
+    {
+    public:
+        /// @param path file to persist the cache in between runs, nothing is persisted if it is empty
+        explicit HeaderCache(std::filesystem::path path = {});
+
+        /// @return the header of each of the files, the ones that aren't cached are read in parallel
+        std::vector<PluginHeaderResult> get(std::span<const std::filesystem::path> files);
+
+        /// Writes the cache if there are new headers. Failures are logged and otherwise ignored.
+        void write();
+
+    private:
+        struct Entry
+        {
+            std::uint64_t mSize;
+            std::int64_t mTime;
+            PluginHeader mHeader;
+        };
+
+        std::filesystem::path mPath;
+        std::map<std::filesystem::path, Entry> mEntries;
+        bool mChanged = false;
+
+        void read();
+    };
+}
+
+#endif
@@ -9,6 +9,7 @@
 #include <components/esm3/loadacti.hpp>
 #include <components/esm3/loadcell.hpp>
 #include <components/esm3/loadcont.hpp>
+#include <components/esm3/loadcrea.hpp>
 #include <components/esm3/loaddoor.hpp>
 #include <components/esm3/loadgmst.hpp>
 #include <components/esm3/loadland.hpp>
@@ -143,6 +144,7 @@ namespace EsmLoader
             Records<ESM::Activator> mActivators;
             CellRecords mCells;
             Records<ESM::Container> mContainers;
+            Records<ESM::Creature> mCreatures;
             Records<ESM::Door> mDoors;
             Records<ESM::GameSetting> mGameSettings;
             Records<ESM::Land> mLands;
@@ -165,6 +167,10 @@ namespace EsmLoader
                     if (query.mLoadContainers)
                         return loadRecord(reader, content.mContainers);
                     break;
+                case ESM::REC_CREA:
+                    if (query.mLoadCreatures)
+                        return loadRecord(reader, content.mCreatures);
+                    break;
                 case ESM::REC_DOOR:
                     if (query.mLoadDoors)
                         return loadRecord(reader, content.mDoors);
@@ -272,11 +278,12 @@ namespace EsmLoader
 
         void addRefIdsTypes(EsmData& content)
         {
-            content.mRefIdTypes.reserve(content.mActivators.size() + content.mContainers.size() + content.mDoors.size()
-                + content.mStatics.size());
+            content.mRefIdTypes.reserve(content.mActivators.size() + content.mContainers.size()
+                + content.mCreatures.size() + content.mDoors.size() + content.mStatics.size());
 
             addRefIdsTypes(content.mActivators, content.mRefIdTypes);
             addRefIdsTypes(content.mContainers, content.mRefIdTypes);
+            addRefIdsTypes(content.mCreatures, content.mRefIdTypes);
             addRefIdsTypes(content.mDoors, content.mRefIdTypes);
             addRefIdsTypes(content.mStatics, content.mRefIdTypes);
 
@@ -309,6 +316,8 @@ namespace EsmLoader
             loaded << ' ' << content.mCells.mValues.size() << " cells,";
         if (query.mLoadContainers)
             loaded << ' ' << content.mContainers.size() << " containers,";
+        if (query.mLoadCreatures)
+            loaded << ' ' << content.mCreatures.size() << " creatures,";
         if (query.mLoadDoors)
             loaded << ' ' << content.mDoors.size() << " doors,";
         if (query.mLoadGameSettings)
@@ -328,6 +337,8 @@ namespace EsmLoader
             result.mCells = prepareCellRecords(content.mCells.mValues);
         if (query.mLoadContainers)
             result.mContainers = prepareRecords(content.mContainers, GetKey{});
+        if (query.mLoadCreatures)
+            result.mCreatures = prepareRecords(content.mCreatures, GetKey{});
         if (query.mLoadDoors)
             result.mDoors = prepareRecords(content.mDoors, GetKey{});
         if (query.mLoadGameSettings)
@@ -347,6 +358,8 @@ namespace EsmLoader
             prepared << ' ' << result.mCells.size() << " unique cells,";
         if (query.mLoadContainers)
             prepared << ' ' << result.mContainers.size() << " unique containers,";
+        if (query.mLoadCreatures)
+            prepared << ' ' << result.mCreatures.size() << " unique creatures,";
         if (query.mLoadDoors)
             prepared << ' ' << result.mDoors.size() << " unique doors,";
         if (query.mLoadGameSettings)
@@ -32,6 +32,7 @@ namespace EsmLoader
         bool mLoadActivators = false;
         bool mLoadCells = false;
         bool mLoadContainers = false;
+        bool mLoadCreatures = false;
         bool mLoadDoors = false;
         bool mLoadGameSettings = false;
         bool mLoadLands = false;
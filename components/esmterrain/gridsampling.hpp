@@ -27,6 +27,14 @@ namespace ESMTerrain
         return { cell, local };
     }
 
+    // Unlike toCellAndLocal the vertex on the border between two cells always belongs to the cell it is the first
+    // vertex of, global may be negative
+    inline std::pair<int, std::size_t> toSharedCellAndLocal(int global, int quadsPerCell)
+    {
+        const int cell = (global >= 0 ? global : global - quadsPerCell + 1) / quadsPerCell;
+        return { cell, static_cast<std::size_t>(global - cell * quadsPerCell) };
+    }
+
     template <class F>
     void sampleGrid(
         std::size_t sampleSize, std::size_t beginX, std::size_t beginY, std::size_t endX, std::size_t endY, F&& f)
@@ -0,0 +1,37 @@
+#ifndef OPENMW_COMPONENTS_ESMTERRAIN_MORPHTARGETS_H
+#define OPENMW_COMPONENTS_ESMTERRAIN_MORPHTARGETS_H
+
+#include <cstddef>
+
+namespace ESMTerrain
+{
+    /// @return true if the vertices of a chunk with numVerts vertices per side can be morphed to the next coarser LOD
+    /// level. The coarser level keeps every second vertex, and the position of the chunk within its parent must not
+    /// change the triangulation of the parent.
+    inline bool canMorph(std::size_t numVerts)
+    {
+        return numVerts > 1 && (numVerts - 1) % 4 == 0;
+    }
+
+    /// Get the height the vertex has on the surface of the next coarser LOD level. The surface is triangulated like
+    /// the index buffers of Terrain::BufferCache, without stitching.
+    /// @param getHeight returns the height of a vertex of the chunk by the x and y index
+    template <class F>
+    float getMorphTargetHeight(std::size_t x, std::size_t y, F&& getHeight)
+    {
+        const bool oddX = x % 2 == 1;
+        const bool oddY = y % 2 == 1;
+        if (!oddX && !oddY)
+            return getHeight(x, y);
+        if (!oddY)
+            return (getHeight(x - 1, y) + getHeight(x + 1, y)) * 0.5f;
+        if (!oddX)
+            return (getHeight(x, y - 1) + getHeight(x, y + 1)) * 0.5f;
+        // Centre of a quad of the coarser level, the diagonal alternates in a diamond pattern
+        if (((x - 1) / 2 + (y - 1) / 2) % 2 == 1)
+            return (getHeight(x + 1, y - 1) + getHeight(x - 1, y + 1)) * 0.5f;
+        return (getHeight(x - 1, y - 1) + getHeight(x + 1, y + 1)) * 0.5f;
+    }
+}
+
+#endif
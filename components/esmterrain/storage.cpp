@@ -1,7 +1,9 @@
 #include "storage.hpp"
 
 #include <algorithm>
+#include <cmath>
 #include <optional>
+#include <span>
 #include <stdexcept>
 
 #include <osg/Image>
@@ -19,6 +21,7 @@
 #include <components/vfs/manager.hpp>
 
 #include "gridsampling.hpp"
+#include "morphtargets.hpp"
 
 namespace ESMTerrain
 {
@@ -42,6 +45,24 @@ namespace ESMTerrain
 
             return { tex, land->getPlugin() };
         }
+
+        struct CellVertexData
+        {
+            const ESM::LandData* mHeightData = nullptr;
+            const ESM::LandData* mNormalData = nullptr;
+            const ESM::LandData* mColourData = nullptr;
+            bool mHasLand = false;
+        };
+
+        CellVertexData makeCellVertexData(const LandObject& land)
+        {
+            return CellVertexData{
+                .mHeightData = land.getData(ESM::Land::DATA_VHGT),
+                .mNormalData = land.getData(ESM::Land::DATA_VNML),
+                .mColourData = land.getData(ESM::Land::DATA_VCLR),
+                .mHasLand = true,
+            };
+        }
     }
 
     class LandCache
@@ -140,16 +161,14 @@ namespace ESMTerrain
         {
             min = std::numeric_limits<float>::max();
             max = -std::numeric_limits<float>::max();
-            for (int row = startRow; row < endRow; ++row)
+            // Heights of a column are contiguous
+            for (int col = startColumn; col < endColumn; ++col)
             {
-                for (int col = startColumn; col < endColumn; ++col)
-                {
-                    float h = data->getHeights()[col * landSize + row];
-                    if (h > max)
-                        max = h;
-                    if (h < min)
-                        min = h;
-                }
+                const std::span<const float> heights = data->getHeights().subspan(
+                    static_cast<std::size_t>(col * landSize + startRow), static_cast<std::size_t>(endRow - startRow));
+                const auto [heightMin, heightMax] = std::minmax_element(heights.begin(), heights.end());
+                min = std::min(min, *heightMin);
+                max = std::max(max, *heightMax);
             }
             return true;
         }
@@ -159,89 +178,6 @@ namespace ESMTerrain
         return false;
     }
 
-    void Storage::fixNormal(
-        osg::Vec3f& normal, ESM::ExteriorCellLocation cellLocation, int col, int row, LandCache& cache)
-    {
-
-        const int landSize = ESM::getLandSize(cellLocation.mWorldspace);
-
-        while (col >= landSize - 1)
-        {
-            ++cellLocation.mY;
-            col -= landSize - 1;
-        }
-        while (row >= landSize - 1)
-        {
-            ++cellLocation.mX;
-            row -= landSize - 1;
-        }
-        while (col < 0)
-        {
-            --cellLocation.mY;
-            col += landSize - 1;
-        }
-        while (row < 0)
-        {
-            --cellLocation.mX;
-            row += landSize - 1;
-        }
-        const LandObject* land = getLand(cellLocation, cache);
-        const ESM::LandData* data = land ? land->getData(ESM::Land::DATA_VNML) : nullptr;
-        if (data)
-        {
-            normal.x() = data->getNormals()[col * landSize * 3 + row * 3];
-            normal.y() = data->getNormals()[col * landSize * 3 + row * 3 + 1];
-            normal.z() = data->getNormals()[col * landSize * 3 + row * 3 + 2];
-            normal.normalize();
-        }
-        else
-            normal = osg::Vec3f(0, 0, 1);
-    }
-
-    void Storage::averageNormal(
-        osg::Vec3f& normal, ESM::ExteriorCellLocation cellLocation, int col, int row, LandCache& cache)
-    {
-        osg::Vec3f n1, n2, n3, n4;
-        fixNormal(n1, cellLocation, col + 1, row, cache);
-        fixNormal(n2, cellLocation, col - 1, row, cache);
-        fixNormal(n3, cellLocation, col, row + 1, cache);
-        fixNormal(n4, cellLocation, col, row - 1, cache);
-        normal = (n1 + n2 + n3 + n4);
-        normal.normalize();
-    }
-
-    void Storage::fixColour(
-        osg::Vec4ub& color, ESM::ExteriorCellLocation cellLocation, int col, int row, LandCache& cache)
-    {
-
-        const int landSize = ESM::getLandSize(cellLocation.mWorldspace);
-
-        if (col == landSize - 1)
-        {
-            ++cellLocation.mY;
-            col = 0;
-        }
-        if (row == landSize - 1)
-        {
-            ++cellLocation.mX;
-            row = 0;
-        }
-        const LandObject* land = getLand(cellLocation, cache);
-        const ESM::LandData* data = land ? land->getData(ESM::Land::DATA_VCLR) : nullptr;
-        if (data)
-        {
-            color.r() = data->getColors()[col * landSize * 3 + row * 3];
-            color.g() = data->getColors()[col * landSize * 3 + row * 3 + 1];
-            color.b() = data->getColors()[col * landSize * 3 + row * 3 + 2];
-        }
-        else
-        {
-            color.r() = 255;
-            color.g() = 255;
-            color.b() = 255;
-        }
-    }
-
     void Storage::fillVertexBuffers(int lodLevel, float size, const osg::Vec2f& center, ESM::RefId worldspace,
         osg::Vec3Array& positions, osg::Vec3Array& normals, osg::Vec4ubArray& colours)
     {
@@ -265,79 +201,85 @@ namespace ESMTerrain
         const osg::Vec2f origin = center - osg::Vec2f(size, size) * 0.5f;
         const int startCellX = static_cast<int>(std::floor(origin.x()));
         const int startCellY = static_cast<int>(std::floor(origin.y()));
-        LandCache cache(startCellX - 1, startCellY - 1, static_cast<std::size_t>(std::ceil(size)) + 2);
-        std::pair lastCell{ startCellX, startCellY };
-        const LandObject* land = getLand(ESM::ExteriorCellLocation(startCellX, startCellY, worldspace), cache);
-        const ESM::LandData* heightData = nullptr;
-        const ESM::LandData* normalData = nullptr;
-        const ESM::LandData* colourData = nullptr;
+        const std::size_t cellsPerSide = static_cast<std::size_t>(std::ceil(size)) + 2;
+        LandCache cache(startCellX - 1, startCellY - 1, cellsPerSide);
         bool validHeightDataExists = false;
 
-        if (land != nullptr)
-        {
-            heightData = land->getData(ESM::Land::DATA_VHGT);
-            normalData = land->getData(ESM::Land::DATA_VNML);
-            colourData = land->getData(ESM::Land::DATA_VCLR);
-            validHeightDataExists = true;
-        }
+        // Data of the cells of the chunk and of the cells around it, looked up once per chunk instead of per vertex
+        std::vector<std::optional<CellVertexData>> cells(cellsPerSide * cellsPerSide);
 
-        const auto handleSample = [&](std::size_t cellShiftX, std::size_t cellShiftY, std::size_t row, std::size_t col,
-                                      std::size_t vertX, std::size_t vertY) {
-            const int cellX = startCellX + static_cast<int>(cellShiftX);
-            const int cellY = startCellY + static_cast<int>(cellShiftY);
-            const std::pair cell{ cellX, cellY };
-            const ESM::ExteriorCellLocation cellLocation(cellX, cellY, worldspace);
-
-            if (lastCell != cell)
+        const auto getCell = [&](int cellShiftX, int cellShiftY) -> const CellVertexData& {
+            assert(cellShiftX >= -1 && cellShiftX + 1 < static_cast<int>(cellsPerSide));
+            assert(cellShiftY >= -1 && cellShiftY + 1 < static_cast<int>(cellsPerSide));
+            std::optional<CellVertexData>& cell = cells[static_cast<std::size_t>(cellShiftX + 1) * cellsPerSide
+                + static_cast<std::size_t>(cellShiftY + 1)];
+            if (!cell.has_value())
             {
-                land = getLand(cellLocation, cache);
+                const LandObject* land = getLand(
+                    ESM::ExteriorCellLocation(startCellX + cellShiftX, startCellY + cellShiftY, worldspace), cache);
+                cell = land == nullptr ? CellVertexData{} : makeCellVertexData(*land);
+            }
+            return *cell;
+        };
 
-                heightData = nullptr;
-                normalData = nullptr;
-                colourData = nullptr;
+        // Normals and colours apparently don't connect seamlessly between cells, so a vertex on the border between
+        // cells takes them from the cell it is the first vertex of
+        const int quadsPerCell = static_cast<int>(cellSize) - 1;
+
+        const auto getSharedNormal = [&](int x, int y) {
+            const auto [cellShiftX, row] = toSharedCellAndLocal(x, quadsPerCell);
+            const auto [cellShiftY, col] = toSharedCellAndLocal(y, quadsPerCell);
+            const ESM::LandData* normalData = getCell(cellShiftX, cellShiftY).mNormalData;
+            if (normalData == nullptr)
+                return osg::Vec3f(0, 0, 1);
+            const std::span<const std::int8_t> source = normalData->getNormals().subspan(col * cellSize * 3 + row * 3);
+            osg::Vec3f normal(source[0], source[1], source[2]);
+            normal.normalize();
+            return normal;
+        };
 
-                if (land != nullptr)
-                {
-                    heightData = land->getData(ESM::Land::DATA_VHGT);
-                    normalData = land->getData(ESM::Land::DATA_VNML);
-                    colourData = land->getData(ESM::Land::DATA_VCLR);
-                    validHeightDataExists = true;
-                }
+        const auto getSharedColour = [&](int x, int y, osg::Vec4ub& color) {
+            const auto [cellShiftX, row] = toSharedCellAndLocal(x, quadsPerCell);
+            const auto [cellShiftY, col] = toSharedCellAndLocal(y, quadsPerCell);
+            const ESM::LandData* colourData = getCell(cellShiftX, cellShiftY).mColourData;
+            for (unsigned short i = 0; i < 3; ++i)
+                color[i] = colourData != nullptr ? colourData->getColors()[col * cellSize * 3 + row * 3 + i] : 255;
+        };
 
-                lastCell = cell;
-            }
+        // Vertices of the same column or row share the coordinate
+        std::vector<float> vertexCoordinates(numVerts);
+        for (std::size_t i = 0; i < numVerts; ++i)
+            vertexCoordinates[i] = (i / static_cast<float>(numVerts - 1) - 0.5f) * size * landSizeInUnits;
+
+        const auto handleSample = [&](std::size_t cellShiftX, std::size_t cellShiftY, std::size_t row, std::size_t col,
+                                      std::size_t vertX, std::size_t vertY) {
+            const CellVertexData& cell = getCell(static_cast<int>(cellShiftX), static_cast<int>(cellShiftY));
+            validHeightDataExists = validHeightDataExists || cell.mHasLand;
 
             float height = defaultHeight;
-            if (heightData != nullptr)
-                height = heightData->getHeights()[col * cellSize + row];
+            if (cell.mHeightData != nullptr)
+                height = cell.mHeightData->getHeights()[col * cellSize + row];
             if (alteration)
                 height += getAlteredHeight(static_cast<int>(col), static_cast<int>(row));
 
             const std::size_t vertIndex = vertX * numVerts + vertY;
 
-            positions[vertIndex]
-                = osg::Vec3f((vertX / static_cast<float>(numVerts - 1) - 0.5f) * size * landSizeInUnits,
-                    (vertY / static_cast<float>(numVerts - 1) - 0.5f) * size * landSizeInUnits, height);
+            positions[vertIndex] = osg::Vec3f(vertexCoordinates[vertX], vertexCoordinates[vertY], height);
 
-            const std::size_t srcArrayIndex = col * cellSize * 3 + row * 3;
+            const int x = static_cast<int>(cellShiftX) * quadsPerCell + static_cast<int>(row);
+            const int y = static_cast<int>(cellShiftY) * quadsPerCell + static_cast<int>(col);
 
-            osg::Vec3f normal(0, 0, 1);
+            osg::Vec3f normal;
 
-            if (normalData != nullptr)
+            // some corner normals appear to be complete garbage (z < 0)
+            if ((row == 0 || row == cellSize - 1) && (col == 0 || col == cellSize - 1))
             {
-                for (unsigned short i = 0; i < 3; ++i)
-                    normal[i] = normalData->getNormals()[srcArrayIndex + i];
-
+                normal = getSharedNormal(x, y + 1) + getSharedNormal(x, y - 1) + getSharedNormal(x + 1, y)
+                    + getSharedNormal(x - 1, y);
                 normal.normalize();
             }
-
-            // Normals apparently don't connect seamlessly between cells
-            if (col == cellSize - 1 || row == cellSize - 1)
-                fixNormal(normal, cellLocation, static_cast<int>(col), static_cast<int>(row), cache);
-
-            // some corner normals appear to be complete garbage (z < 0)
-            if ((row == 0 || row == cellSize - 1) && (col == 0 || col == cellSize - 1))
-                averageNormal(normal, cellLocation, static_cast<int>(col), static_cast<int>(row), cache);
+            else
+                normal = getSharedNormal(x, y);
 
             assert(normal.z() > 0);
 
@@ -345,17 +287,17 @@ namespace ESMTerrain
 
             osg::Vec4ub color(255, 255, 255, 255);
 
-            if (colourData != nullptr)
+            if (cell.mColourData != nullptr)
                 for (unsigned short i = 0; i < 3; ++i)
-                    color[i] = colourData->getColors()[srcArrayIndex + i];
+                    color[i] = cell.mColourData->getColors()[col * cellSize * 3 + row * 3 + i];
 
             // Does nothing by default, override in OpenMW-CS
             if (alteration)
-                adjustColor(static_cast<int>(col), static_cast<int>(row), heightData, color);
+                adjustColor(static_cast<int>(col), static_cast<int>(row), cell.mHeightData, color);
 
             // Unlike normals, colors mostly connect seamlessly between cells, but not always...
             if (col == cellSize - 1 || row == cellSize - 1)
-                fixColour(color, cellLocation, static_cast<int>(col), static_cast<int>(row), cache);
+                getSharedColour(x, y, color);
 
             colours[vertIndex] = color;
         };
@@ -370,6 +312,22 @@ namespace ESMTerrain
             std::fill(positions.begin(), positions.end(), osg::Vec3f());
     }
 
+    void Storage::fillMorphTargets(const osg::Vec3Array& positions, osg::FloatArray& morphHeights)
+    {
+        const std::size_t numVerts = static_cast<std::size_t>(std::lround(std::sqrt(positions.size())));
+        if (numVerts * numVerts != positions.size())
+            throw std::invalid_argument("Invalid terrain vertex count: " + std::to_string(positions.size()));
+
+        morphHeights.resize(positions.size());
+
+        // Vertices are stored column by column, see fillVertexBuffers
+        const auto getHeight = [&](std::size_t x, std::size_t y) { return positions[x * numVerts + y].z(); };
+        const bool morph = canMorph(numVerts);
+        for (std::size_t x = 0; x < numVerts; ++x)
+            for (std::size_t y = 0; y < numVerts; ++y)
+                morphHeights[x * numVerts + y] = morph ? getMorphTargetHeight(x, y, getHeight) : getHeight(x, y);
+    }
+
     std::string Storage::getTextureName(UniqueTextureId id)
     {
         std::string_view texture = "_land_default.dds";
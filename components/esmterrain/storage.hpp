@@ -113,6 +113,12 @@ namespace ESMTerrain
         void fillVertexBuffers(int lodLevel, float size, const osg::Vec2f& center, ESM::RefId worldspace,
             osg::Vec3Array& positions, osg::Vec3Array& normals, osg::Vec4ubArray& colours) override;
 
+        /// Fill the heights the vertices of a terrain chunk have with the next coarser LOD level.
+        /// @note May be called from background threads.
+        /// @param positions vertices written by fillVertexBuffers
+        /// @param morphHeights buffer to write a height for each vertex
+        void fillMorphTargets(const osg::Vec3Array& positions, osg::FloatArray& morphHeights) override;
+
         /// Create textures holding layer blend values for a terrain chunk.
         /// @note The terrain chunk shouldn't be larger than one cell since otherwise we might
         ///       have to do a ridiculous amount of different layers. For larger chunks, composite maps should be used.
@@ -145,13 +151,6 @@ namespace ESMTerrain
     private:
         const VFS::Manager* mVFS;
 
-        inline void fixNormal(
-            osg::Vec3f& normal, ESM::ExteriorCellLocation cellLocation, int col, int row, LandCache& cache);
-        inline void fixColour(
-            osg::Vec4ub& colour, ESM::ExteriorCellLocation cellLocation, int col, int row, LandCache& cache);
-        inline void averageNormal(
-            osg::Vec3f& normal, ESM::ExteriorCellLocation cellLocation, int col, int row, LandCache& cache);
-
         inline const LandObject* getLand(ESM::ExteriorCellLocation cellLocation, LandCache& cache);
 
         virtual bool useAlteration() const { return false; }
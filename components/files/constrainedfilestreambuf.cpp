@@ -1,6 +1,7 @@
 #include "constrainedfilestreambuf.hpp"
 
 #include <algorithm>
+#include <cstring>
 #include <filesystem>
 #include <limits>
 
@@ -37,6 +38,27 @@ namespace Files
         return traits_type::to_int_type(*gptr());
     }
 
+    std::streamsize ConstrainedFileStreamBuf::xsgetn(char_type* dest, std::streamsize count)
+    {
+        std::streamsize done = std::min<std::streamsize>(egptr() - gptr(), count);
+        if (done > 0)
+        {
+            std::memcpy(dest, gptr(), static_cast<std::size_t>(done));
+            gbump(static_cast<int>(done));
+        }
+
+        const std::size_t left = static_cast<std::size_t>(count - done);
+        if (left == 0)
+            return done;
+
+        if (left < sizeof(mBuffer))
+            return done + std::streambuf::xsgetn(dest + done, static_cast<std::streamsize>(left));
+
+        // The buffer is empty at this point, so the file position matches the stream position
+        const std::size_t toRead = std::min((mOrigin + mSize) - File::tell(mFile), left);
+        return done + static_cast<std::streamsize>(File::read(mFile, dest + done, toRead));
+    }
+
     std::streambuf::pos_type ConstrainedFileStreamBuf::seekoff(
         off_type offset, std::ios_base::seekdir whence, std::ios_base::openmode mode)
     {
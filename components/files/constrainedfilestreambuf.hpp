@@ -16,6 +16,9 @@ namespace Files
 
         int_type underflow() final;
 
+        /// Reads larger than the buffer go directly from the file to the destination.
+        std::streamsize xsgetn(char_type* dest, std::streamsize count) final;
+
         pos_type seekoff(off_type offset, std::ios_base::seekdir whence, std::ios_base::openmode mode) final;
 
         pos_type seekpos(pos_type pos, std::ios_base::openmode mode) final;
@@ -0,0 +1,74 @@
+#include "mappedfile.hpp"
+
+#include "conversion.hpp"
+#include "memorystream.hpp"
+
+#include <boost/iostreams/device/mapped_file.hpp>
+
+#include <stdexcept>
+#include <string>
+
+namespace Files
+{
+    namespace
+    {
+        struct MappedFileHolder
+        {
+            std::shared_ptr<const MappedFile> mFile;
+        };
+
+        class MappedFileStream final : private MappedFileHolder, public IMemStream
+        {
+        public:
+            explicit MappedFileStream(std::shared_ptr<const MappedFile>&& file, std::span<const char> region)
+                : MemBuf(region.data(), region.size())
+                , MappedFileHolder{ std::move(file) }
+                , IMemStream(region.data(), region.size())
+            {
+            }
+        };
+    }
+
+    struct MappedFile::Impl
+    {
+        boost::iostreams::mapped_file_source mSource;
+    };
+
+    MappedFile::MappedFile(const std::filesystem::path& path)
+        : mPath(path)
+        , mImpl(std::make_unique<Impl>())
+    {
+        try
+        {
+            mImpl->mSource.open(path.native());
+        }
+        catch (const std::exception& e)
+        {
+            throw std::runtime_error("Failed to map file \"" + pathToUnicodeString(path) + "\": " + e.what());
+        }
+        if (!mImpl->mSource.is_open())
+            throw std::runtime_error("Failed to map file \"" + pathToUnicodeString(path) + "\"");
+    }
+
+    MappedFile::~MappedFile() = default;
+
+    std::size_t MappedFile::size() const
+    {
+        return mImpl->mSource.size();
+    }
+
+    std::span<const char> MappedFile::get(std::size_t offset, std::size_t size) const
+    {
+        if (offset > mImpl->mSource.size() || size > mImpl->mSource.size() - offset)
+            throw std::runtime_error("Region " + std::to_string(offset) + "+" + std::to_string(size)
+                + " is out of bounds of mapped file \"" + pathToUnicodeString(mPath)
+                + "\" with size " + std::to_string(mImpl->mSource.size()));
+        return std::span<const char>(mImpl->mSource.data() + offset, size);
+    }
+
+    IStreamPtr openMappedFileStream(std::shared_ptr<const MappedFile> file, std::size_t offset, std::size_t size)
+    {
+        const std::span<const char> region = file->get(offset, size);
+        return std::make_unique<MappedFileStream>(std::move(file), region);
+    }
+}
@@ -0,0 +1,43 @@
+#ifndef OPENMW_COMPONENTS_FILES_MAPPEDFILE_H
+#define OPENMW_COMPONENTS_FILES_MAPPEDFILE_H
+
+#include "istreamptr.hpp"
+
+#include <cstddef>
+#include <filesystem>
+#include <memory>
+#include <span>
+
+namespace Files
+{
+    /// @brief Read only memory mapping of a whole file.
+    class MappedFile
+    {
+    public:
+        explicit MappedFile(const std::filesystem::path& path);
+
+        ~MappedFile();
+
+        MappedFile(const MappedFile&) = delete;
+
+        MappedFile& operator=(const MappedFile&) = delete;
+
+        std::size_t size() const;
+
+        /// Get a view of the given region. Throws if the region is out of the file bounds.
+        std::span<const char> get(std::size_t offset, std::size_t size) const;
+
+        const std::filesystem::path& getPath() const { return mPath; }
+
+    private:
+        struct Impl;
+
+        std::filesystem::path mPath;
+        std::unique_ptr<Impl> mImpl;
+    };
+
+    /// Open a stream reading directly from the mapped region without copying. The stream keeps the mapping alive.
+    IStreamPtr openMappedFileStream(std::shared_ptr<const MappedFile> file, std::size_t offset, std::size_t size);
+}
+
+#endif
@@ -591,6 +591,7 @@ namespace Gui
         // Underscore, use for NotDefined marker (used for glyphs not existing in the font)
         additional.emplace(95, MyGUI::FontCodeType::NotDefined);
 
+        ToUTF8::Utf8Encoder encoder(mEncoding);
         for (unsigned i = 0; i < 256; i++)
         {
             float x1 = data[i].top_left.x * width;
@@ -598,7 +599,6 @@ namespace Gui
             float w = data[i].top_right.x * width - x1;
             float h = data[i].bottom_left.y * height - y1;
 
-            ToUTF8::Utf8Encoder encoder(mEncoding);
             unsigned long unicodeVal = getUnicode(static_cast<unsigned char>(i), encoder, mEncoding);
             const std::string coord = MyGUI::utility::toString(x1) + " " + MyGUI::utility::toString(y1) + " "
                 + MyGUI::utility::toString(w) + " " + MyGUI::utility::toString(h);
@@ -319,6 +319,8 @@ namespace Fx
                 rt.mTarget->setSourceFormat(parseSourceFormat());
             else if (key == "mipmaps")
                 rt.mMipMap = parseBool();
+            else if (key == "transient")
+                rt.mTransient = parseBool();
             else if (key == "clear_color")
                 rt.mClearColor = parseVec<osg::Vec4f, Lexer::Vec4>();
             else
@@ -40,6 +40,8 @@ namespace Fx
 
                 return std::make_tuple(scaledWidth, scaledHeight);
             }
+
+            bool operator==(const SizeProxy& other) const = default;
         };
 
         struct RenderTarget
@@ -47,6 +49,9 @@ namespace Fx
             osg::ref_ptr<osg::Texture2D> mTarget = new osg::Texture2D;
             SizeProxy mSize;
             bool mMipMap = false;
+            // Contents are always written before they are read in the same frame, so the texture can be shared
+            // with the transient render targets of other techniques
+            bool mTransient = false;
             osg::Vec4f mClearColor = osg::Vec4f(0.0, 0.0, 0.0, 1.0);
         };
 
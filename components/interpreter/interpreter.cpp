@@ -25,14 +25,14 @@ namespace Interpreter
         }
 
         template <typename T>
-        auto& getDispatcher(const T& segment, unsigned int seg, int opcode)
+        T& getDispatcher(const OpcodeTable<T>& segment, unsigned int seg, int opcode)
         {
-            auto it = segment.find(opcode);
-            if (it == segment.end())
+            T* const dispatcher = segment.find(opcode);
+            if (dispatcher == nullptr)
             {
                 abortUnknownCode(seg, opcode);
             }
-            return it->second;
+            return *dispatcher;
         }
     }
 
@@ -53,7 +53,7 @@ namespace Interpreter
                 const int opcode = code >> 24;
                 const unsigned int arg0 = code & 0xffffff;
 
-                return getDispatcher(mSegment0, 0, opcode)->execute(mRuntime, arg0);
+                return getDispatcher(mSegment0, 0, opcode).execute(mRuntime, arg0);
             }
 
             case 2:
@@ -61,7 +61,7 @@ namespace Interpreter
                 const int opcode = (code >> 20) & 0x3ff;
                 const unsigned int arg0 = code & 0xfffff;
 
-                return getDispatcher(mSegment2, 2, opcode)->execute(mRuntime, arg0);
+                return getDispatcher(mSegment2, 2, opcode).execute(mRuntime, arg0);
             }
         }
 
@@ -74,14 +74,14 @@ namespace Interpreter
                 const int opcode = (code >> 8) & 0x3ffff;
                 const unsigned int arg0 = code & 0xff;
 
-                return getDispatcher(mSegment3, 3, opcode)->execute(mRuntime, arg0);
+                return getDispatcher(mSegment3, 3, opcode).execute(mRuntime, arg0);
             }
 
             case 0x32:
             {
                 const int opcode = code & 0x3ffffff;
 
-                return getDispatcher(mSegment5, 5, opcode)->execute(mRuntime);
+                return getDispatcher(mSegment5, 5, opcode).execute(mRuntime);
             }
         }
 
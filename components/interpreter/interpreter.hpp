@@ -1,12 +1,12 @@
 #ifndef INTERPRETER_INTERPRETER_H_INCLUDED
 #define INTERPRETER_INTERPRETER_H_INCLUDED
 
-#include <map>
 #include <memory>
 #include <stack>
 #include <utility>
 
 #include "opcodes.hpp"
+#include "opcodetable.hpp"
 #include "runtime.hpp"
 #include "types.hpp"
 
@@ -19,10 +19,10 @@ namespace Interpreter
         std::stack<Runtime> mCallstack;
         bool mRunning = false;
         Runtime mRuntime;
-        std::map<int, std::unique_ptr<Opcode1>> mSegment0;
-        std::map<int, std::unique_ptr<Opcode1>> mSegment2;
-        std::map<int, std::unique_ptr<Opcode1>> mSegment3;
-        std::map<int, std::unique_ptr<Opcode0>> mSegment5;
+        OpcodeTable<Opcode1> mSegment0;
+        OpcodeTable<Opcode1> mSegment2;
+        OpcodeTable<Opcode1> mSegment3;
+        OpcodeTable<Opcode0> mSegment5;
 
         void execute(Type_Code code);
 
@@ -35,9 +35,9 @@ namespace Interpreter
         template <typename T, typename... Args>
         void installSegment(auto& segment, std::string_view name, int code, Args&&... args)
         {
-            if (segment.find(code) != segment.end())
+            if (segment.contains(code))
                 abortDuplicateInstruction(name, code);
-            segment.emplace(code, std::make_unique<T>(std::forward<Args>(args)...));
+            segment.insert(code, std::make_unique<T>(std::forward<Args>(args)...));
         }
 
     public:
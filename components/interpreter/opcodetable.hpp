@@ -0,0 +1,50 @@
+#ifndef OPENMW_COMPONENTS_INTERPRETER_OPCODETABLE_H
+#define OPENMW_COMPONENTS_INTERPRETER_OPCODETABLE_H
+
+#include <algorithm>
+#include <array>
+#include <memory>
+#include <utility>
+#include <vector>
+
+namespace Interpreter
+{
+    /// @brief Maps opcodes of a segment to their implementation with array lookups.
+    /// @par Opcodes are stored in pages of 256 consecutive codes. Only a few pages are in use, one for the builtin
+    /// opcodes and a few for the extensions, so looking up the page is a short linear search.
+    template <class T>
+    class OpcodeTable
+    {
+    public:
+        bool contains(int code) const { return find(code) != nullptr; }
+
+        void insert(int code, std::unique_ptr<T> opcode)
+        {
+            const int page = code >> pageBits;
+            auto it = std::find_if(mPages.begin(), mPages.end(), [&](const auto& v) { return v.first >= page; });
+            if (it == mPages.end() || it->first != page)
+                it = mPages.emplace(it, page, std::make_unique<Page>());
+            (*it->second)[code & pageMask] = std::move(opcode);
+        }
+
+        /// @return nullptr if there is no opcode with this code
+        T* find(int code) const
+        {
+            const int page = code >> pageBits;
+            for (const auto& [index, opcodes] : mPages)
+                if (index == page)
+                    return (*opcodes)[code & pageMask].get();
+            return nullptr;
+        }
+
+    private:
+        static constexpr int pageBits = 8;
+        static constexpr int pageMask = (1 << pageBits) - 1;
+
+        using Page = std::array<std::unique_ptr<T>, 1 << pageBits>;
+
+        std::vector<std::pair<int, std::unique_ptr<Page>>> mPages;
+    };
+}
+
+#endif
@@ -39,20 +39,24 @@ namespace L10n
             return status.isSuccess();
         }
 
-        std::string loadGmst(
-            const std::function<std::string(std::string_view)>& gmstLoader, const icu::MessageFormat* message)
+        std::string loadGmst(const std::function<std::string(std::string_view)>& gmstLoader, std::string_view gmstName)
         {
-            icu::UnicodeString gmstNameUnicode;
-            std::string gmstName;
-            icu::ErrorCode success;
-            message->format(nullptr, nullptr, 0, gmstNameUnicode, success);
-            gmstNameUnicode.toUTF8String(gmstName);
             if (gmstLoader)
                 return gmstLoader(gmstName);
-            return "GMST:" + gmstName;
+            return "GMST:" + std::string(gmstName);
         }
     }
 
+    MessageBundles::Message::Message(icu::MessageFormat&& format)
+        : mFormat(std::move(format))
+    {
+        icu::UnicodeString result;
+        icu::ErrorCode success;
+        mFormat.format(nullptr, nullptr, 0, result, success);
+        if (success.isSuccess())
+            result.toUTF8String(mText.emplace());
+    }
+
     MessageBundles::MessageBundles(const std::vector<icu::Locale>& preferredLocales, icu::Locale& fallbackLocale)
         : mFallbackLocale(fallbackLocale)
     {
@@ -63,6 +67,11 @@ namespace L10n
     {
         mPreferredLocales.clear();
         mPreferredLocaleStrings.clear();
+        {
+            // Keys are formatted for the first preferred locale
+            std::lock_guard lock(mKeyMessagesMutex);
+            mKeyMessages.clear();
+        }
         for (const icu::Locale& loc : preferredLocales)
         {
             mPreferredLocales.push_back(loc);
@@ -99,12 +108,13 @@ namespace L10n
             icu::MessageFormat message(pattern, langOrEn, parseError, status);
             if (checkSuccess(status, parseError, "Failed to create message ", key, " for locale ", lang.getName()))
             {
-                mBundles[localeName].emplace(key, message);
+                mBundles[localeName].emplace(key, Message(std::move(message)));
             }
         }
     }
 
-    const icu::MessageFormat* MessageBundles::findMessage(std::string_view key, std::string_view localeName) const
+    const MessageBundles::Message* MessageBundles::findMessage(
+        std::string_view key, std::string_view localeName) const
     {
         auto iter = mBundles.find(localeName);
         if (iter != mBundles.end())
@@ -118,6 +128,50 @@ namespace L10n
         return nullptr;
     }
 
+    const MessageBundles::Message* MessageBundles::getKeyMessage(std::string_view key) const
+    {
+        std::lock_guard lock(mKeyMessagesMutex);
+        auto it = mKeyMessages.find(key);
+        if (it == mKeyMessages.end())
+        {
+            icu::Locale defaultLocale(nullptr);
+            if (!mPreferredLocales.empty())
+            {
+                defaultLocale = mPreferredLocales[0];
+            }
+            icu::ErrorCode success;
+            UParseError parseError;
+            icu::MessageFormat defaultMessage(
+                icu::UnicodeString::fromUTF8(icu::StringPiece(key.data(), static_cast<std::int32_t>(key.size()))),
+                defaultLocale, parseError, success);
+            std::optional<Message> message;
+            if (checkSuccess(success, parseError, "Failed to create message ", key))
+                message.emplace(std::move(defaultMessage));
+            it = mKeyMessages.emplace(std::string(key), std::move(message)).first;
+        }
+        // Elements of an unordered map keep their address
+        return it->second.has_value() ? &*it->second : nullptr;
+    }
+
+    std::string MessageBundles::format(const Message& message, std::string_view key,
+        const std::vector<icu::UnicodeString>& argNames, const std::vector<icu::Formattable>& args) const
+    {
+        if (args.empty() && message.mText.has_value())
+            return *message.mText;
+
+        icu::UnicodeString result;
+        std::string resultString;
+        icu::ErrorCode success;
+        if (!args.empty() && !argNames.empty())
+            message.mFormat.format(
+                argNames.data(), args.data(), static_cast<std::int32_t>(args.size()), result, success);
+        else
+            message.mFormat.format(nullptr, nullptr, static_cast<std::int32_t>(args.size()), result, success);
+        checkSuccess(success, {}, "Failed to format message ", key);
+        result.toUTF8String(resultString);
+        return resultString;
+    }
+
     std::string MessageBundles::formatMessage(
         std::string_view key, const std::map<std::string, icu::Formattable>& args) const
     {
@@ -135,18 +189,14 @@ namespace L10n
     std::string MessageBundles::formatMessage(std::string_view key, const std::vector<icu::UnicodeString>& argNames,
         const std::vector<icu::Formattable>& args) const
     {
-        icu::UnicodeString result;
-        std::string resultString;
-        icu::ErrorCode success;
-
-        const icu::MessageFormat* message = nullptr;
+        const Message* message = nullptr;
         for (auto& loc : mPreferredLocaleStrings)
         {
             message = findMessage(key, loc);
             if (message)
             {
                 if (loc == "gmst")
-                    return loadGmst(mGmstLoader, message);
+                    return loadGmst(mGmstLoader, format(*message, key, {}, {}));
                 break;
             }
         }
@@ -155,35 +205,12 @@ namespace L10n
             message = findMessage(key, mFallbackLocale.getName());
 
         if (message)
-        {
-            if (!args.empty() && !argNames.empty())
-                message->format(argNames.data(), args.data(), static_cast<std::int32_t>(args.size()), result, success);
-            else
-                message->format(nullptr, nullptr, static_cast<std::int32_t>(args.size()), result, success);
-            checkSuccess(success, {}, "Failed to format message ", key);
-            result.toUTF8String(resultString);
-            return resultString;
-        }
-        icu::Locale defaultLocale(nullptr);
-        if (!mPreferredLocales.empty())
-        {
-            defaultLocale = mPreferredLocales[0];
-        }
-        UParseError parseError;
-        icu::MessageFormat defaultMessage(
-            icu::UnicodeString::fromUTF8(icu::StringPiece(key.data(), static_cast<std::int32_t>(key.size()))),
-            defaultLocale, parseError, success);
-        if (!checkSuccess(success, parseError, "Failed to create message ", key))
-            // If we can't parse the key as a pattern, just return the key
-            return std::string(key);
+            return format(*message, key, argNames, args);
 
-        if (!args.empty() && !argNames.empty())
-            defaultMessage.format(
-                argNames.data(), args.data(), static_cast<std::int32_t>(args.size()), result, success);
-        else
-            defaultMessage.format(nullptr, nullptr, static_cast<std::int32_t>(args.size()), result, success);
-        checkSuccess(success, {}, "Failed to format message ", key);
-        result.toUTF8String(resultString);
-        return resultString;
+        if (const Message* keyMessage = getKeyMessage(key))
+            return format(*keyMessage, key, argNames, args);
+
+        // If we can't parse the key as a pattern, just return the key
+        return std::string(key);
     }
 }
@@ -3,6 +3,9 @@
 
 #include <functional>
 #include <map>
+#include <mutex>
+#include <optional>
+#include <string>
 #include <string_view>
 #include <unordered_map>
 #include <vector>
@@ -51,15 +54,31 @@ namespace L10n
         void setGmstLoader(std::function<std::string(std::string_view)> fn) { mGmstLoader = std::move(fn); }
 
     private:
+        struct Message
+        {
+            icu::MessageFormat mFormat;
+            // The message formatted without arguments, for messages that can be
+            std::optional<std::string> mText;
+
+            explicit Message(icu::MessageFormat&& format);
+        };
+
         template <class T>
         using StringMap = std::unordered_map<std::string, T, Misc::StringUtils::StringHash, std::equal_to<>>;
         // icu::Locale isn't hashable (or comparable), so we use the string form instead, which is canonicalized
-        StringMap<StringMap<icu::MessageFormat>> mBundles;
+        StringMap<StringMap<Message>> mBundles;
         const icu::Locale mFallbackLocale;
         std::vector<std::string> mPreferredLocaleStrings;
         std::vector<icu::Locale> mPreferredLocales;
         std::function<std::string(std::string_view)> mGmstLoader;
-        const icu::MessageFormat* findMessage(std::string_view key, std::string_view localeName) const;
+        // Keys missing from all bundles are formatted as messages themselves, those that fail to parse are kept empty
+        mutable std::mutex mKeyMessagesMutex;
+        mutable StringMap<std::optional<Message>> mKeyMessages;
+
+        const Message* findMessage(std::string_view key, std::string_view localeName) const;
+        const Message* getKeyMessage(std::string_view key) const;
+        std::string format(const Message& message, std::string_view key,
+            const std::vector<icu::UnicodeString>& argNames, const std::vector<icu::Formattable>& args) const;
     };
 
 }
@@ -1,11 +1,16 @@
 #ifndef COMPONENTS_LOADINGLISTENER_H
 #define COMPONENTS_LOADINGLISTENER_H
 
+#include <chrono>
 #include <memory>
 #include <string>
 
 namespace Loading
 {
+    /// How often to update the listener while waiting for work on other threads, the listener decides itself
+    /// whether to draw anything.
+    inline constexpr std::chrono::milliseconds listenerUpdateInterval(5);
+
     class Listener
     {
     public:
@@ -28,6 +33,7 @@ namespace Loading
         /// Set the total range of progress (e.g. the number of objects to load).
         virtual void setProgressRange(size_t range) {}
         /// Set current progress. Valid range is [0, progressRange)
+        /// @note Can be called with the same value again to keep the loading screen updated.
         virtual void setProgress(size_t value) {}
         /// Increase current progress, default by 1.
         virtual void increaseProgress(size_t increase = 1) {}
@@ -4,6 +4,7 @@
 #include <condition_variable>
 #include <cstddef>
 #include <mutex>
+#include <optional>
 
 namespace Loading
 {
@@ -31,11 +32,21 @@ namespace Loading
     void Reporter::wait(Listener& listener) const
     {
         std::unique_lock lock(mMutex);
+        std::optional<std::size_t> total;
         while (!mDone)
         {
-            listener.setProgressRange(mTotal);
-            listener.setProgress(mProgress);
-            mUpdated.wait(lock);
+            const std::size_t progress = mProgress;
+            const bool totalChanged = total != mTotal;
+            total = mTotal;
+            // The listener draws the loading screen, the work must not wait for it
+            lock.unlock();
+            if (totalChanged)
+                listener.setProgressRange(*total);
+            listener.setProgress(progress);
+            lock.lock();
+            // Wake up without progress too, so the loading screen is drawn at its own rate
+            mUpdated.wait_for(lock, listenerUpdateInterval,
+                [&] { return mDone || mProgress != progress || mTotal != *total; });
         }
     }
 }
@@ -0,0 +1,79 @@
+#include "bytecodecache.hpp"
+
+#include <array>
+#include <cstdint>
+#include <format>
+#include <fstream>
+#include <iterator>
+#include <sstream>
+
+#include <components/debug/debuglog.hpp>
+#include <components/files/hash.hpp>
+
+#include "luastate.hpp"
+
+namespace LuaUtil
+{
+    namespace
+    {
+        // Increment when the way scripts are keyed or stored changes
+        constexpr int bytecodeCacheVersion = 1;
+    }
+
+    BytecodeCache::BytecodeCache(const std::filesystem::path& path)
+        : mPath(path)
+    {
+        std::error_code ec;
+        std::filesystem::create_directories(mPath, ec);
+        if (ec)
+        {
+            Log(Debug::Warning) << "Lua bytecode cache is disabled: failed to create " << mPath << ": "
+                                << ec.message();
+            mEnabled = false;
+        }
+    }
+
+    std::string BytecodeCache::makeKey(std::string_view path, std::string_view source)
+    {
+        std::istringstream stream(
+            std::format("{}\n{}\n{}\n{}\n{}", bytecodeCacheVersion, getLuaVersion(), path, source.size(), source));
+        const std::array<std::uint64_t, 2> hash = Files::getHash("lua bytecode", stream);
+        return std::format("{:016x}{:016x}", hash[0], hash[1]);
+    }
+
+    std::optional<std::string> BytecodeCache::read(std::string_view key) const
+    {
+        if (!mEnabled)
+            return std::nullopt;
+
+        std::ifstream stream(mPath / std::format("{}.luac", key), std::ios::binary);
+        if (!stream.is_open())
+            return std::nullopt;
+        return std::string(std::istreambuf_iterator<char>(stream), {});
+    }
+
+    void BytecodeCache::write(std::string_view key, std::string_view bytecode) const
+    {
+        if (!mEnabled)
+            return;
+
+        const std::filesystem::path path = mPath / std::format("{}.luac", key);
+        // Write to a temporary file first to never read partially written bytecode
+        std::filesystem::path tmpPath = path;
+        tmpPath += ".tmp";
+
+        {
+            std::ofstream stream(tmpPath, std::ios::binary);
+            if (!stream.is_open() || !stream.write(bytecode.data(), static_cast<std::streamsize>(bytecode.size())))
+            {
+                Log(Debug::Warning) << "Failed to write Lua bytecode to " << tmpPath;
+                return;
+            }
+        }
+
+        std::error_code ec;
+        std::filesystem::rename(tmpPath, path, ec);
+        if (ec)
+            Log(Debug::Warning) << "Failed to rename " << tmpPath << " to " << path << ": " << ec.message();
+    }
+}
@@ -0,0 +1,32 @@
+#ifndef COMPONENTS_LUA_BYTECODECACHE_H
+#define COMPONENTS_LUA_BYTECODECACHE_H
+
+#include <filesystem>
+#include <optional>
+#include <string>
+#include <string_view>
+
+namespace LuaUtil
+{
+    // Stores compiled scripts on disk to load them in the next session instead of compiling them again.
+    // Bytecode is keyed by a hash of the script path, its source and the Lua version, so a changed script or another
+    // Lua runtime results in a different key instead of loading bytecode it can't run.
+    class BytecodeCache
+    {
+    public:
+        explicit BytecodeCache(const std::filesystem::path& path);
+
+        static std::string makeKey(std::string_view path, std::string_view source);
+
+        // Returns std::nullopt when there is no bytecode for the key.
+        std::optional<std::string> read(std::string_view key) const;
+
+        void write(std::string_view key, std::string_view bytecode) const;
+
+    private:
+        std::filesystem::path mPath;
+        bool mEnabled = true;
+    };
+}
+
+#endif // COMPONENTS_LUA_BYTECODECACHE_H
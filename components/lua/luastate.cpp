@@ -413,9 +413,35 @@ namespace LuaUtil
                 throw std::runtime_error("Lua error: " + res.get<std::string>());
             return res;
         }
-        sol::function res = loadFromVFS(path);
-        mCompiledScripts[path] = res.dump();
-        return res;
+        if (mBytecodeCache == nullptr)
+        {
+            sol::function res = loadFromVFS(path);
+            mCompiledScripts[path] = res.dump();
+            return res;
+        }
+
+        std::string fileContent(std::istreambuf_iterator<char>(*mVFS->get(path)), {});
+        const std::string key = BytecodeCache::makeKey(path.value(), fileContent);
+        if (const std::optional<std::string> bytecode = mBytecodeCache->read(key))
+        {
+            sol::load_result res = mSol.load(*bytecode, path.value(), sol::load_mode::binary);
+            if (res.valid())
+            {
+                sol::function function = res;
+                mCompiledScripts[path] = function.dump();
+                return function;
+            }
+            Log(Debug::Warning) << "Failed to load cached bytecode of " << path << ", compiling it again";
+        }
+
+        sol::load_result res = mSol.load(fileContent, path.value(), sol::load_mode::text);
+        if (!res.valid())
+            throw std::runtime_error(std::string("Lua error: ") += res.get<sol::error>().what());
+        sol::function function = res;
+        sol::bytecode bytecode = function.dump();
+        mBytecodeCache->write(key, bytecode.as_string_view());
+        mCompiledScripts[path] = std::move(bytecode);
+        return function;
     }
 
     sol::function LuaState::loadFromVFS(const VFS::Path::Normalized& path)
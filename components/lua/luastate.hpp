@@ -3,12 +3,14 @@
 
 #include <filesystem>
 #include <map>
+#include <memory>
 #include <typeinfo>
 
 #include <sol/sol.hpp>
 
 #include <components/vfs/pathutil.hpp>
 
+#include "bytecodecache.hpp"
 #include "configuration.hpp"
 #include "luastateptr.hpp"
 
@@ -161,6 +163,12 @@ namespace LuaUtil
 
         void dropScriptCache() { mCompiledScripts.clear(); }
 
+        // Store compiled scripts in the directory to not compile them again in the next session.
+        void enableBytecodeCache(const std::filesystem::path& path)
+        {
+            mBytecodeCache = std::make_unique<BytecodeCache>(path);
+        }
+
         const ScriptsConfiguration& getConfiguration() const { return *mConf; }
 
         // Load internal Lua library. All libraries are loaded in one sandbox and shouldn't be exposed to scripts
@@ -221,6 +229,7 @@ namespace LuaUtil
         const ScriptsConfiguration* mConf;
         sol::table mSandboxEnv;
         std::map<VFS::Path::Normalized, sol::bytecode> mCompiledScripts;
+        std::unique_ptr<BytecodeCache> mBytecodeCache;
         std::map<std::string, sol::object> mCommonPackages;
         const VFS::Manager* mVFS;
         std::vector<std::filesystem::path> mLibSearchPaths;
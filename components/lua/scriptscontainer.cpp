@@ -369,23 +369,38 @@ namespace LuaUtil
                 Log(Debug::Error) << mNamePrefix << " can not parse eventData for '" << eventName << "': " << e.what();
                 return;
             }
-            EventHandlerList& list = it->second;
-            for (size_t i = list.size(); i > 0; --i)
+            callEventHandlers(it->second, eventName, object);
+        });
+    }
+
+    void ScriptsContainer::receiveEventObject(std::string_view eventName, const sol::object& eventData)
+    {
+        LoadedData& data = ensureLoaded();
+        auto it = data.mEventHandlers.find(eventName);
+        if (it == data.mEventHandlers.end())
+            return;
+        mLua.protectedCall([&](LuaView&) { callEventHandlers(it->second, eventName, eventData); });
+    }
+
+    void ScriptsContainer::callEventHandlers(
+        EventHandlerList& list, std::string_view eventName, const sol::object& eventData)
+    {
+        for (size_t i = list.size(); i > 0; --i)
+        {
+            const Handler& h = list[i - 1];
+            try
             {
-                const Handler& h = list[i - 1];
-                try
-                {
-                    sol::object res = LuaUtil::call({ this, h.mScriptId }, h.mFn, object);
-                    if (res.is<bool>() && !res.as<bool>())
-                        break; // Skip other handlers if 'false' was returned.
-                }
-                catch (std::exception& e)
-                {
-                    Log(Debug::Error) << mNamePrefix << "[" << scriptPath(h.mScriptId) << "] eventHandler[" << eventName
-                                      << "] failed. " << e.what();
-                }
+                const ProfiledCall profiledCall(*this, h.mScriptId, HandlerType::Event, eventName);
+                sol::object res = LuaUtil::call({ this, h.mScriptId }, h.mFn, eventData);
+                if (res.is<bool>() && !res.as<bool>())
+                    break; // Skip other handlers if 'false' was returned.
             }
-        });
+            catch (std::exception& e)
+            {
+                Log(Debug::Error) << mNamePrefix << "[" << scriptPath(h.mScriptId) << "] eventHandler[" << eventName
+                                  << "] failed. " << e.what();
+            }
+        }
     }
 
     void ScriptsContainer::registerEngineHandlers(std::initializer_list<EngineHandlerList*> handlers)
@@ -617,6 +632,7 @@ namespace LuaUtil
 
         std::make_heap(data.mSimulationTimersQueue.begin(), data.mSimulationTimersQueue.end());
         std::make_heap(data.mGameTimersQueue.begin(), data.mGameTimersQueue.end());
+        scheduleTimers(data);
 
         if (mTracker)
             mTracker->onLoad(*this);
@@ -688,10 +704,35 @@ namespace LuaUtil
         getScript(scriptId).mRegisteredCallbacks.emplace(std::string(callbackName), std::move(callback));
     }
 
-    void ScriptsContainer::insertTimer(std::vector<Timer>& timerQueue, Timer&& t)
+    void ScriptsContainer::insertTimer(TimerType type, Timer&& t)
     {
+        LoadedData& data = ensureLoaded();
+        std::vector<Timer>& timerQueue
+            = type == TimerType::GAME_TIME ? data.mGameTimersQueue : data.mSimulationTimersQueue;
         timerQueue.push_back(std::move(t));
         std::push_heap(timerQueue.begin(), timerQueue.end());
+        scheduleTimers(data);
+    }
+
+    void ScriptsContainer::scheduleTimers()
+    {
+        if (LoadedData* data = std::get_if<LoadedData>(&mData))
+            scheduleTimers(*data);
+    }
+
+    void ScriptsContainer::scheduleTimers(LoadedData& data)
+    {
+        if (!mTracker)
+            return;
+        // Scheduled again only for an earlier timer, the tracker ignores all but the last time it was scheduled at
+        const auto schedule = [&](const std::vector<Timer>& timerQueue, double& scheduledTime, TimerType type) {
+            if (timerQueue.empty() || timerQueue.front().mTime >= scheduledTime)
+                return;
+            scheduledTime = timerQueue.front().mTime;
+            mTracker->scheduleTimers(*this, type, scheduledTime);
+        };
+        schedule(data.mSimulationTimersQueue, data.mScheduledSimulationTime, TimerType::SIMULATION_TIME);
+        schedule(data.mGameTimersQueue, data.mScheduledGameTime, TimerType::GAME_TIME);
     }
 
     void ScriptsContainer::setupSerializableTimer(
@@ -704,8 +745,7 @@ namespace LuaUtil
         t.mTime = time;
         t.mArg = std::move(callbackArg);
         t.mSerializedArg = serialize(t.mArg, mSerializer);
-        LoadedData& data = ensureLoaded();
-        insertTimer(type == TimerType::GAME_TIME ? data.mGameTimersQueue : data.mSimulationTimersQueue, std::move(t));
+        insertTimer(type, std::move(t));
     }
 
     void ScriptsContainer::setupUnsavableTimer(
@@ -719,8 +759,7 @@ namespace LuaUtil
         t.mCallback = mTemporaryCallbackCounter;
         getScript(t.mScriptId).mTemporaryCallbacks.emplace(mTemporaryCallbackCounter, std::move(callback));
         mTemporaryCallbackCounter++;
-        LoadedData& data = ensureLoaded();
-        insertTimer(type == TimerType::GAME_TIME ? data.mGameTimersQueue : data.mSimulationTimersQueue, std::move(t));
+        insertTimer(type, std::move(t));
     }
 
     void ScriptsContainer::callTimer(const Timer& t)
@@ -734,11 +773,13 @@ namespace LuaUtil
                 auto it = script.mRegisteredCallbacks.find(callbackName);
                 if (it == script.mRegisteredCallbacks.end())
                     throw std::logic_error("Callback '" + callbackName + "' doesn't exist");
+                const ProfiledCall profiledCall(*this, t.mScriptId, HandlerType::Timer, it->first);
                 LuaUtil::call({ this, t.mScriptId }, it->second, t.mArg);
             }
             else
             {
                 int64_t id = std::get<int64_t>(t.mCallback);
+                const ProfiledCall profiledCall(*this, t.mScriptId, HandlerType::Timer, "unsavable");
                 LuaUtil::call({ this, t.mScriptId }, script.mTemporaryCallbacks.at(id));
                 script.mTemporaryCallbacks.erase(id);
             }
@@ -765,6 +806,7 @@ namespace LuaUtil
             LoadedData& data = ensureLoaded();
             updateTimerQueue(data.mSimulationTimersQueue, simulationTime);
             updateTimerQueue(data.mGameTimersQueue, gameTime);
+            scheduleTimers(data);
         });
     }
 
@@ -803,7 +845,11 @@ namespace LuaUtil
                 {
                     auto it = variant.mScripts.find(scriptId);
                     if (it != variant.mScripts.end())
+                    {
+                        if (memoryDelta > 0)
+                            it->second.mStats.mAllocated += memoryDelta;
                         return &it->second.mStats.mMemoryUsage;
+                    }
                 }
                 auto [rIt, _] = mRemovedScriptsMemoryUsage.emplace(scriptId, 0);
                 return &rIt->second;
@@ -832,12 +878,75 @@ namespace LuaUtil
             {
                 stats[id].mAvgInstructionCount += script.mStats.mAvgInstructionCount;
                 stats[id].mMemoryUsage += script.mStats.mMemoryUsage;
+                stats[id].mAllocated += script.mStats.mAllocated;
             }
         }
         for (auto& [id, mem] : mRemovedScriptsMemoryUsage)
             stats[id].mMemoryUsage += mem;
     }
 
+    void ScriptsContainer::collectHandlerStats(std::vector<ScriptHandlerStats>& stats) const
+    {
+        stats.resize(mLua.getConfiguration().size());
+        const LoadedData* data = std::get_if<LoadedData>(&mData);
+        if (data == nullptr)
+            return;
+        for (const auto& [id, script] : data->mScripts)
+        {
+            for (std::size_t type = 0; type < sHandlerTypeCount; ++type)
+            {
+                for (const auto& [name, handlerStats] : script.mHandlerStats[type])
+                {
+                    HandlerStats& total = stats[id][type][name];
+                    total.mCallCount += handlerStats.mCallCount;
+                    total.mDuration += handlerStats.mDuration;
+                    total.mAllocated += handlerStats.mAllocated;
+                }
+            }
+        }
+    }
+
+    ScriptsContainer::ProfiledCall::ProfiledCall(
+        ScriptsContainer& container, int scriptId, HandlerType type, std::string_view name)
+        : mScriptId(scriptId)
+        , mType(type)
+        , mName(name)
+    {
+        if (!LuaState::isProfilerEnabled())
+            return;
+        LoadedData* data = std::get_if<LoadedData>(&container.mData);
+        if (data == nullptr)
+            return;
+        const auto it = data->mScripts.find(scriptId);
+        if (it == data->mScripts.end())
+            return;
+        mContainer = &container;
+        mAllocated = it->second.mStats.mAllocated;
+        mStart = std::chrono::steady_clock::now();
+    }
+
+    ScriptsContainer::ProfiledCall::~ProfiledCall()
+    {
+        if (mContainer == nullptr)
+            return;
+        const auto duration = std::chrono::steady_clock::now() - mStart;
+        // The handler may remove its own script
+        LoadedData* data = std::get_if<LoadedData>(&mContainer->mData);
+        if (data == nullptr)
+            return;
+        const auto it = data->mScripts.find(mScriptId);
+        if (it == data->mScripts.end())
+            return;
+        Script& script = it->second;
+        HandlerStatsMap& handlers = script.mHandlerStats[static_cast<std::size_t>(mType)];
+        auto handler = handlers.find(mName);
+        if (handler == handlers.end())
+            handler = handlers.emplace(mName, HandlerStats{}).first;
+        ++handler->second.mCallCount;
+        handler->second.mDuration += duration;
+        handler->second.mAllocated += script.mStats.mAllocated - mAllocated;
+    }
+
     ScriptsContainer::Script::~Script()
     {
         if (mHiddenData != sol::nil)
@@ -1,9 +1,13 @@
 #ifndef COMPONENTS_LUA_SCRIPTSCONTAINER_H
 #define COMPONENTS_LUA_SCRIPTSCONTAINER_H
 
+#include <array>
+#include <chrono>
+#include <limits>
 #include <map>
 #include <set>
 #include <string>
+#include <utility>
 #include <variant>
 
 #include <components/debug/debuglog.hpp>
@@ -101,11 +105,21 @@ namespace LuaUtil
         bool hasScript(int scriptId) const;
         void removeScript(int scriptId);
 
+        // Calls the expired timers. The timers of containers with a tracker are processed by
+        // ScriptTracker::processTimers.
         void processTimers(double simulationTime, double gameTime);
 
+        // Schedules the earliest timers in the tracker again, needed when the container becomes active because the
+        // tracker skips the timers of inactive containers.
+        void scheduleTimers();
+
         // Calls `onUpdate` (if present) for every script in the container.
         // Handlers are called in the same order as scripts were added.
-        void update(float dt) { callEngineHandlers(mUpdateHandlers, dt); }
+        // Time of the updates skipped by `skipUpdate` is added to `dt`.
+        void update(float dt) { callEngineHandlers(mUpdateHandlers, dt + std::exchange(mSkippedUpdateTime, 0.f)); }
+
+        // Defers `onUpdate` to the next call of `update`. Used to keep Lua within the frame time budget.
+        void skipUpdate(float dt) { mSkippedUpdateTime += dt; }
 
         // Calls event handlers `eventName` (if present) for every script.
         // If several scripts register handlers for `eventName`, they are called in reverse order.
@@ -113,6 +127,10 @@ namespace LuaUtil
         // (including `nil`) has no effect.
         void receiveEvent(std::string_view eventName, std::string_view eventData);
 
+        // Same as receiveEvent, but with data that is already a Lua value in this state, see
+        // LuaUtil::copySerializable. The value is passed to the handlers as it is.
+        void receiveEventObject(std::string_view eventName, const sol::object& eventData);
+
         // Serializer defines how to serialize/deserialize userdata. If serializer is not provided,
         // only built-in types and types from util package can be serialized.
         void setSerializer(const UserdataSerializer* serializer) { mSerializer = serializer; }
@@ -158,8 +176,35 @@ namespace LuaUtil
         {
             float mAvgInstructionCount = 0; // averaged number of Lua instructions per frame
             int64_t mMemoryUsage = 0; // bytes
+            int64_t mAllocated = 0; // bytes, sum of all tracked allocations
         };
         void collectStats(std::vector<ScriptStats>& stats) const;
+
+        enum class HandlerType
+        {
+            Engine,
+            Event,
+            Timer,
+        };
+
+        static constexpr std::size_t sHandlerTypeCount = 3;
+
+        struct HandlerStats
+        {
+            int64_t mCallCount = 0;
+            std::chrono::steady_clock::duration mDuration{};
+            int64_t mAllocated = 0; // bytes, only allocations tracked by the profiler
+        };
+
+        // Handler stats by handler name (event name or timer callback name for events and timers).
+        using HandlerStatsMap = std::map<std::string, HandlerStats, std::less<>>;
+
+        // Indexed by HandlerType.
+        using ScriptHandlerStats = std::array<HandlerStatsMap, sHandlerTypeCount>;
+
+        // Adds handler stats of loaded scripts to `stats` indexed by script id. Collected only if Lua profiler is
+        // enabled.
+        void collectHandlerStats(std::vector<ScriptHandlerStats>& stats) const;
         static int64_t getInstanceCount() { return sInstanceCount; }
 
         virtual bool isActive() const { return false; }
@@ -215,6 +260,7 @@ namespace LuaUtil
             {
                 try
                 {
+                    const ProfiledCall profiledCall(*this, handler.mScriptId, HandlerType::Engine, handlers.mName);
                     LuaUtil::call({ this, handler.mScriptId }, handler.mFn, args...);
                 }
                 catch (std::exception& e)
@@ -229,6 +275,26 @@ namespace LuaUtil
         // a public function (see how ScriptsContainer::update is implemented) that calls `callEngineHandlers`.
         void registerEngineHandlers(std::initializer_list<EngineHandlerList*> handlers);
 
+        // Measures duration and allocations of a handler call for the profiler. Does nothing if the profiler is
+        // disabled.
+        class ProfiledCall
+        {
+        public:
+            ProfiledCall(ScriptsContainer& container, int scriptId, HandlerType type, std::string_view name);
+
+            ProfiledCall(const ProfiledCall&) = delete;
+
+            ~ProfiledCall();
+
+        private:
+            ScriptsContainer* mContainer = nullptr;
+            int mScriptId;
+            HandlerType mType;
+            std::string_view mName;
+            std::chrono::steady_clock::time_point mStart;
+            int64_t mAllocated = 0;
+        };
+
         const std::string mNamePrefix;
         LuaUtil::LuaState& mLua;
 
@@ -244,6 +310,7 @@ namespace LuaUtil
             std::map<int64_t, sol::main_protected_function> mTemporaryCallbacks;
             VFS::Path::Normalized mPath;
             ScriptStats mStats;
+            ScriptHandlerStats mHandlerStats;
 
             ~Script();
         };
@@ -273,6 +340,8 @@ namespace LuaUtil
 
         void printError(int scriptId, std::string_view msg, const std::exception& e) const;
 
+        void callEventHandlers(EventHandlerList& list, std::string_view eventName, const sol::object& eventData);
+
         const VFS::Path::Normalized& scriptPath(int scriptId) const
         {
             return mLua.getConfiguration()[scriptId].mScriptPath;
@@ -281,7 +350,7 @@ namespace LuaUtil
         void callOnInit(LuaView& view, int scriptId, const sol::function& onInit, std::string_view data);
         void callTimer(const Timer& t);
         void updateTimerQueue(std::vector<Timer>& timerQueue, double time);
-        static void insertTimer(std::vector<Timer>& timerQueue, Timer&& t);
+        void insertTimer(TimerType type, Timer&& t);
         static void insertHandler(std::vector<Handler>& list, int scriptId, sol::function fn);
         static void removeHandler(std::vector<Handler>& list, int scriptId);
         void insertInterface(int scriptId, const Script& script);
@@ -302,6 +371,10 @@ namespace LuaUtil
 
             std::vector<Timer> mSimulationTimersQueue;
             std::vector<Timer> mGameTimersQueue;
+
+            // Time of the earliest timer the container is scheduled at in the tracker, infinity if not scheduled
+            double mScheduledSimulationTime = std::numeric_limits<double>::infinity();
+            double mScheduledGameTime = std::numeric_limits<double>::infinity();
         };
         using UnloadedData = ESM::LuaScripts;
 
@@ -311,11 +384,13 @@ namespace LuaUtil
         // handlers are invoked.
         UnloadedData& ensureUnloaded(LuaView& lua);
         LoadedData& ensureLoaded();
+        void scheduleTimers(LoadedData& data);
 
         EngineHandlerList mUpdateHandlers{ "onUpdate" };
         std::map<std::string_view, EngineHandlerList*> mEngineHandlers;
         std::variant<UnloadedData, LoadedData> mData;
         int64_t mTemporaryCallbackCounter = 0;
+        float mSkippedUpdateTime = 0;
 
         std::map<int, int64_t> mRemovedScriptsMemoryUsage;
         using WeakPtr = std::shared_ptr<ScriptsContainer*>;
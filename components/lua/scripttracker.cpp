@@ -1,5 +1,8 @@
 #include "scripttracker.hpp"
 
+#include <limits>
+#include <variant>
+
 namespace LuaUtil
 {
     namespace
@@ -50,4 +53,63 @@ namespace LuaUtil
         }
         ++mFrame;
     }
+
+    void ScriptTracker::scheduleTimers(ScriptsContainer& container, ScriptsContainer::TimerType type, double time)
+    {
+        ContainerTimerWheel& wheel = type == ScriptsContainer::TimerType::GAME_TIME ? mGameTimers : mSimulationTimers;
+        wheel.insert(time, container.mThis);
+    }
+
+    void ScriptTracker::collectExpiredTimers(ContainerTimerWheel& wheel, double time, ScriptsContainer::TimerType type)
+    {
+        wheel.advance(time, mExpiredTimers);
+        for (auto& [scheduledTime, ptr] : mExpiredTimers)
+        {
+            ScriptsContainer* container = *ptr.get();
+            // Object no longer exists, its timers are cancelled
+            if (!container)
+                continue;
+            // Unloaded containers are scheduled again when loaded
+            ScriptsContainer::LoadedData* data = std::get_if<ScriptsContainer::LoadedData>(&container->mData);
+            if (!data)
+                continue;
+            double& containerTime = type == ScriptsContainer::TimerType::GAME_TIME ? data->mScheduledGameTime
+                                                                                   : data->mScheduledSimulationTime;
+            // Stale, the container was scheduled again since
+            if (containerTime != scheduledTime)
+                continue;
+            containerTime = std::numeric_limits<double>::infinity();
+            if (container->isActive())
+                mContainersWithExpiredTimers.push_back(std::move(ptr));
+        }
+        mExpiredTimers.clear();
+    }
+
+    std::size_t ScriptTracker::processTimers(
+        double simulationTime, double gameTime, std::optional<std::chrono::steady_clock::time_point> deadline)
+    {
+        collectExpiredTimers(mSimulationTimers, simulationTime, ScriptsContainer::TimerType::SIMULATION_TIME);
+        collectExpiredTimers(mGameTimers, gameTime, ScriptsContainer::TimerType::GAME_TIME);
+        std::size_t processed = 0;
+        for (; processed < mContainersWithExpiredTimers.size(); ++processed)
+        {
+            if (deadline.has_value() && std::chrono::steady_clock::now() > *deadline)
+                break;
+            ScriptsContainer* container = *mContainersWithExpiredTimers[processed].get();
+            // Became inactive in the meantime, scheduled again when it becomes active
+            if (container && container->isActive())
+                container->processTimers(simulationTime, gameTime);
+        }
+        mContainersWithExpiredTimers.erase(mContainersWithExpiredTimers.begin(),
+            mContainersWithExpiredTimers.begin() + static_cast<std::ptrdiff_t>(processed));
+        return mContainersWithExpiredTimers.size();
+    }
+
+    void ScriptTracker::clearTimers()
+    {
+        mSimulationTimers.clear();
+        mGameTimers.clear();
+        mExpiredTimers.clear();
+        mContainersWithExpiredTimers.clear();
+    }
 }
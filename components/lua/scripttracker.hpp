@@ -1,11 +1,16 @@
 #ifndef COMPONENTS_LUA_SCRIPTTRACKER_H
 #define COMPONENTS_LUA_SCRIPTTRACKER_H
 
+#include <chrono>
+#include <cstddef>
 #include <memory>
+#include <optional>
 #include <queue>
 #include <utility>
+#include <vector>
 
 #include "scriptscontainer.hpp"
+#include "timerwheel.hpp"
 
 namespace LuaUtil
 {
@@ -16,12 +21,35 @@ namespace LuaUtil
         std::queue<TrackedScriptContainer> mLoadedScripts;
         Frame mFrame = 0;
 
+        // Containers by the time of their earliest timers, in seconds of simulation and game time
+        using ContainerTimerWheel = TimerWheel<ScriptsContainer::WeakPtr>;
+        ContainerTimerWheel mSimulationTimers{ 1.0 / 16 };
+        ContainerTimerWheel mGameTimers{ 1.0 };
+        std::vector<ContainerTimerWheel::Entry> mExpiredTimers;
+        std::vector<ScriptsContainer::WeakPtr> mContainersWithExpiredTimers;
+
+        void collectExpiredTimers(ContainerTimerWheel& wheel, double time, ScriptsContainer::TimerType type);
+
     public:
         void unloadInactiveScripts(LuaView& lua);
 
         void onLoad(ScriptsContainer& container);
 
         std::size_t size() const { return mLoadedScripts.size(); }
+
+        // Called by the container when it has a timer earlier than the time it was scheduled at
+        void scheduleTimers(ScriptsContainer& container, ScriptsContainer::TimerType type, double time);
+
+        // Calls ScriptsContainer::processTimers for the active containers with expired timers, in the order the
+        // timers expired. Time spent is proportional to the number of such containers. After the deadline the
+        // remaining containers are processed by the next call, the timers of inactive containers are processed after
+        // they become active.
+        // Returns the number of containers with deferred timers.
+        std::size_t processTimers(double simulationTime, double gameTime,
+            std::optional<std::chrono::steady_clock::time_point> deadline = std::nullopt);
+
+        // Forgets all scheduled timers, the containers keep them
+        void clearTimers();
     };
 }
 
@@ -195,6 +195,48 @@ namespace LuaUtil
             throw std::runtime_error("Value is not serializable.");
     }
 
+    static bool isBuiltinUserdata(const sol::userdata& data)
+    {
+        return data.is<osg::Vec2f>() || data.is<osg::Vec3f>() || data.is<osg::Vec4f>() || data.is<TransformM>()
+            || data.is<TransformQ>() || data.is<Misc::Color>();
+    }
+
+    static std::optional<sol::object> copySerializable(lua_State* lua, const sol::object& obj, int recursionCounter)
+    {
+        switch (obj.get_type())
+        {
+            case sol::type::lua_nil:
+            case sol::type::boolean:
+            case sol::type::number:
+            case sol::type::string:
+                return obj;
+            case sol::type::userdata:
+                if (isBuiltinUserdata(obj))
+                    return obj;
+                return std::nullopt;
+            case sol::type::table:
+            {
+                // Let serialize report the error
+                if (recursionCounter >= 32)
+                    return std::nullopt;
+                sol::table result(lua, sol::create);
+                for (auto& [key, value] : obj.as<sol::table>())
+                {
+                    std::optional<sol::object> keyCopy = copySerializable(lua, key, recursionCounter + 1);
+                    if (!keyCopy.has_value())
+                        return std::nullopt;
+                    std::optional<sol::object> valueCopy = copySerializable(lua, value, recursionCounter + 1);
+                    if (!valueCopy.has_value())
+                        return std::nullopt;
+                    result.raw_set(*keyCopy, *valueCopy);
+                }
+                return result;
+            }
+            default:
+                return std::nullopt;
+        }
+    }
+
     static void serialize(
         BinaryData& out, const sol::object& obj, const UserdataSerializer* customSerializer, int recursionCounter)
     {
@@ -356,6 +398,107 @@ namespace LuaUtil
         throw std::runtime_error("Unknown type in serialized data: " + std::to_string(type));
     }
 
+    static void skip(std::string_view& binaryData, size_t size)
+    {
+        if (binaryData.size() < size)
+            throw std::runtime_error("Unexpected end of serialized data.");
+        binaryData = binaryData.substr(size);
+    }
+
+    // Moves binaryData past a serialized value, checking its structure the same way as deserializeImpl
+    static void skipValue(std::string_view& binaryData)
+    {
+        if (binaryData.empty())
+            throw std::runtime_error("Unexpected end of serialized data.");
+        unsigned char type = binaryData[0];
+        binaryData = binaryData.substr(1);
+        if (type & (CUSTOM_COMPACT_FLAG | CUSTOM_FULL_FLAG))
+        {
+            size_t typeNameSize, dataSize;
+            if (type & CUSTOM_COMPACT_FLAG)
+            {
+                typeNameSize = (type & 7) + 1;
+                dataSize = (type >> 3) & 15;
+            }
+            else
+            {
+                typeNameSize = (type & 63) + 1;
+                dataSize = getValue<uint32_t>(binaryData);
+            }
+            skip(binaryData, typeNameSize + dataSize);
+            return;
+        }
+        if (type & SHORT_STRING_FLAG)
+        {
+            skip(binaryData, type & 0x1f);
+            return;
+        }
+        switch (static_cast<SerializedType>(type))
+        {
+            case SerializedType::NUMBER:
+                skip(binaryData, sizeof(double));
+                return;
+            case SerializedType::BOOLEAN:
+                skip(binaryData, sizeof(char));
+                return;
+            case SerializedType::LONG_STRING:
+                skip(binaryData, getValue<uint32_t>(binaryData));
+                return;
+            case SerializedType::TABLE_START:
+            {
+                while (!binaryData.empty() && binaryData[0] != char(SerializedType::TABLE_END))
+                {
+                    skipValue(binaryData);
+                    skipValue(binaryData);
+                }
+                skip(binaryData, 1);
+                return;
+            }
+            case SerializedType::TABLE_END:
+                throw std::runtime_error("Unexpected end of table during deserialization.");
+            case SerializedType::VEC2:
+                skip(binaryData, 2 * sizeof(double));
+                return;
+            case SerializedType::VEC3:
+                skip(binaryData, 3 * sizeof(double));
+                return;
+            case SerializedType::TRANSFORM_M:
+                skip(binaryData, 16 * sizeof(double));
+                return;
+            case SerializedType::TRANSFORM_Q:
+            case SerializedType::VEC4:
+                skip(binaryData, 4 * sizeof(double));
+                return;
+            case SerializedType::COLOR:
+                skip(binaryData, 4 * sizeof(float));
+                return;
+        }
+        throw std::runtime_error("Unknown type in serialized data: " + std::to_string(type));
+    }
+
+    static std::string_view getStringKey(std::string_view& binaryData)
+    {
+        if (binaryData.empty())
+            throw std::runtime_error("Unexpected end of serialized data.");
+        const unsigned char type = binaryData[0];
+        size_t size;
+        if ((type & (CUSTOM_COMPACT_FLAG | CUSTOM_FULL_FLAG)) == 0 && (type & SHORT_STRING_FLAG))
+        {
+            size = type & 0x1f;
+            binaryData = binaryData.substr(1);
+        }
+        else if (type == char(SerializedType::LONG_STRING))
+        {
+            binaryData = binaryData.substr(1);
+            size = getValue<uint32_t>(binaryData);
+        }
+        else
+            throw std::runtime_error("Serialized table has a key that is not a string");
+        const std::string_view key = binaryData.substr(0, size);
+        skip(binaryData, size);
+        return key;
+    }
+
     BinaryData serialize(const sol::object& obj, const UserdataSerializer* customSerializer)
     {
         if (obj == sol::nil)
@@ -366,6 +509,11 @@ namespace LuaUtil
         return res;
     }
 
+    std::optional<sol::object> copySerializable(lua_State* lua, const sol::object& value)
+    {
+        return copySerializable(lua, value, 0);
+    }
+
     sol::object deserialize(
         lua_State* lua, std::string_view binaryData, const UserdataSerializer* customSerializer, bool readOnly)
     {
@@ -381,4 +529,45 @@ namespace LuaUtil
         return sol::stack::pop<sol::object>(lua);
     }
 
+    BinaryData serializeTable(std::span<const std::pair<std::string_view, std::string_view>> entries)
+    {
+        BinaryData res;
+        res.push_back(FORMAT_VERSION);
+        appendType(res, SerializedType::TABLE_START);
+        for (const auto& [key, value] : entries)
+        {
+            if (value.empty() || value[0] != FORMAT_VERSION)
+                throw std::logic_error("Table value is not serialized");
+            appendString(res, key);
+            res.append(value.substr(1));
+        }
+        appendType(res, SerializedType::TABLE_END);
+        return res;
+    }
+
+    std::vector<std::pair<std::string, BinaryData>> splitSerializedTable(std::string_view binaryData)
+    {
+        if (binaryData.empty() || binaryData[0] != FORMAT_VERSION)
+            throw std::runtime_error("Incorrect version of Lua serialization format");
+        binaryData = binaryData.substr(1);
+        if (binaryData.empty() || binaryData[0] != char(SerializedType::TABLE_START))
+            throw std::runtime_error("Serialized data is not a table");
+        binaryData = binaryData.substr(1);
+        std::vector<std::pair<std::string, BinaryData>> res;
+        while (!binaryData.empty() && binaryData[0] != char(SerializedType::TABLE_END))
+        {
+            std::string key(getStringKey(binaryData));
+            const std::string_view value = binaryData;
+            skipValue(binaryData);
+            BinaryData serializedValue;
+            serializedValue.push_back(FORMAT_VERSION);
+            serializedValue.append(value.substr(0, value.size() - binaryData.size()));
+            res.emplace_back(std::move(key), std::move(serializedValue));
+        }
+        skip(binaryData, 1);
+        if (!binaryData.empty())
+            throw std::runtime_error("Unexpected data after serialized object");
+        return res;
+    }
+
 }
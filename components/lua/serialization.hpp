@@ -3,6 +3,12 @@
 
 #include <sol/sol.hpp>
 
+#include <optional>
+#include <span>
+#include <string>
+#include <utility>
+#include <vector>
+
 #include <components/esm3/cellref.hpp>
 
 namespace LuaUtil
@@ -51,9 +57,22 @@ namespace LuaUtil
     };
 
     BinaryData serialize(const sol::object&, const UserdataSerializer* customSerializer = nullptr);
+
+    // Returns a copy of the value that is equal to deserialize(serialize(value)) without going through BinaryData.
+    // Tables are copied, other values are immutable and shared. Returns std::nullopt if the value contains userdata
+    // that only a UserdataSerializer can handle, or anything serialize would reject.
+    std::optional<sol::object> copySerializable(lua_State* lua, const sol::object& value);
     sol::object deserialize(lua_State* lua, std::string_view binaryData,
         const UserdataSerializer* customSerializer = nullptr, bool readOnly = false);
 
+    // Serializes a table with string keys from already serialized values, the result is the same as serializing the
+    // table itself. Values are copied as they are, so userdata of any serializer can be used.
+    BinaryData serializeTable(std::span<const std::pair<std::string_view, std::string_view>> entries);
+
+    // Splits a serialized table with string keys into serialized values without deserializing them.
+    // Throws if the data is not a valid serialized table or some key is not a string.
+    std::vector<std::pair<std::string, BinaryData>> splitSerializedTable(std::string_view binaryData);
+
 }
 
 #endif // COMPONENTS_LUA_SERIALIZATION_H
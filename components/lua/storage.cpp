@@ -41,9 +41,10 @@ namespace LuaUtil
         return mReadOnlyValue;
     }
 
-    const LuaStorage::Value& LuaStorage::Section::get(std::string_view key) const
+    const LuaStorage::Value& LuaStorage::Section::get(std::string_view key)
     {
         checkIfActive();
+        loadValues();
         auto it = mValues.find(key);
         if (it != mValues.end())
             return it->second;
@@ -87,6 +88,7 @@ namespace LuaUtil
     {
         checkIfActive();
         throwIfCallbackRecursionIsTooDeep();
+        loadValues();
         if (value != sol::nil)
             mValues[std::string(key)] = Value(value);
         else
@@ -95,6 +97,7 @@ namespace LuaUtil
             if (it != mValues.end())
                 mValues.erase(it);
         }
+        changed();
         if (mStorage->mListener)
             mStorage->mListener->valueChanged(mSectionName, key, value);
         runCallbacks(key);
@@ -105,25 +108,73 @@ namespace LuaUtil
         checkIfActive();
         throwIfCallbackRecursionIsTooDeep();
         mValues.clear();
+        mValuesLoaded = true;
         if (values)
         {
             for (const auto& [k, v] : *values)
                 mValues[cast<std::string>(k)] = Value(v);
         }
+        changed();
         if (mStorage->mListener)
             mStorage->mListener->sectionReplaced(mSectionName, values);
         runCallbacks(sol::nullopt);
     }
 
+    void LuaStorage::Section::setLifeTime(LifeTime lifeTime)
+    {
+        if (lifeTime != mLifeTime && (lifeTime == Persistent || mLifeTime == Persistent))
+            mStorage->mSyncedPath.clear();
+        mLifeTime = lifeTime;
+    }
+
     sol::table LuaStorage::Section::asTable(lua_State* state)
     {
         checkIfActive();
+        loadValues();
         sol::table res(state, sol::create);
         for (const auto& [k, v] : mValues)
             res[k] = v.getCopy(state);
         return res;
     }
 
+    void LuaStorage::Section::loadValues()
+    {
+        if (mValuesLoaded)
+            return;
+        mValuesLoaded = true;
+        try
+        {
+            for (auto& [key, value] : splitSerializedTable(mSerialized))
+                mValues.emplace(std::move(key), Value::fromSerialized(std::move(value)));
+        }
+        catch (std::exception& e)
+        {
+            Log(Debug::Error) << "Cannot read Lua storage section \"" << mSectionName << "\": " << e.what();
+            mValues.clear();
+            changed();
+        }
+    }
+
+    void LuaStorage::Section::changed()
+    {
+        mSerialized.clear();
+        if (mLifeTime == Persistent)
+            mStorage->mSyncedPath.clear();
+    }
+
+    const BinaryData& LuaStorage::Section::getSerialized()
+    {
+        if (mSerialized.empty())
+        {
+            std::vector<std::pair<std::string_view, std::string_view>> entries;
+            entries.reserve(mValues.size());
+            for (const auto& [key, value] : mValues)
+                entries.emplace_back(key, value.getSerialized());
+            mSerialized = serializeTable(entries);
+        }
+        return mSerialized;
+    }
+
     void LuaStorage::initLuaBindings(LuaUtil::LuaView& view)
     {
         sol::usertype<SectionView> sview = view.sol().new_usertype<SectionView>("Section");
@@ -154,12 +205,12 @@ namespace LuaUtil
         sview["removeOnExit"] = [](const SectionView& section) {
             if (section.mReadOnly)
                 throw std::runtime_error("Access to storage is read only");
-            section.mSection->mLifeTime = Section::Temporary;
+            section.mSection->setLifeTime(Section::Temporary);
         };
         sview["setLifeTime"] = [](const SectionView& section, Section::LifeTime lifeTime) {
             if (section.mReadOnly)
                 throw std::runtime_error("Access to storage is read only");
-            section.mSection->mLifeTime = lifeTime;
+            section.mSection->setLifeTime(lifeTime);
         };
         sview["set"] = [](const SectionView& section, std::string_view key, const sol::object& value) {
             if (section.mReadOnly)
@@ -241,7 +292,7 @@ namespace LuaUtil
         }
     }
 
-    void LuaStorage::load(lua_State* state, const std::filesystem::path& path)
+    void LuaStorage::load(const std::filesystem::path& path)
     {
         assert(mData.empty()); // Shouldn't be used before loading
         try
@@ -253,13 +304,13 @@ namespace LuaUtil
 
             std::ifstream fin(path, std::fstream::binary);
             std::string serializedData((std::istreambuf_iterator<char>(fin)), std::istreambuf_iterator<char>());
-            sol::table data = deserialize(state, serializedData);
-            for (const auto& [sectionName, sectionTable] : data)
+            for (auto& [sectionName, sectionData] : splitSerializedTable(serializedData))
             {
-                const std::shared_ptr<Section>& section = getSection(cast<std::string_view>(sectionName));
-                for (const auto& [key, value] : cast<sol::table>(sectionTable))
-                    section->set(cast<std::string_view>(key), value);
+                const std::shared_ptr<Section>& section = getSection(sectionName);
+                section->mSerialized = std::move(sectionData);
+                section->mValuesLoaded = false;
             }
+            mSyncedPath = path;
         }
         catch (std::exception& e)
         {
@@ -267,19 +318,27 @@ namespace LuaUtil
         }
     }
 
-    void LuaStorage::save(lua_State* state, const std::filesystem::path& path) const
+    void LuaStorage::save(const std::filesystem::path& path)
     {
-        sol::table data(state, sol::create);
+        if (!mSyncedPath.empty() && mSyncedPath == path && std::filesystem::exists(path))
+        {
+            Log(Debug::Verbose) << "Lua storage \"" << path << "\" is not changed";
+            return;
+        }
+        // Sections that didn't change since loading or the last save are copied as they are
+        std::vector<std::pair<std::string_view, std::string_view>> sections;
         for (const auto& [sectionName, section] : mData)
         {
-            if (section->mLifeTime == Section::Persistent && !section->mValues.empty())
-                data[sectionName] = section->asTable(state);
+            if (section->mLifeTime == Section::Persistent && (!section->mValuesLoaded || !section->mValues.empty()))
+                sections.emplace_back(sectionName, section->getSerialized());
         }
-        std::string serializedData = serialize(data);
+        std::string serializedData = serializeTable(sections);
         Log(Debug::Info) << "Saving Lua storage \"" << path << "\" (" << serializedData.size() << " bytes)";
         std::ofstream fout(path, std::fstream::binary);
         fout.write(serializedData.data(), serializedData.size());
         fout.close();
+        if (!fout.fail())
+            mSyncedPath = path;
     }
 
     const std::shared_ptr<LuaStorage::Section>& LuaStorage::getSection(std::string_view sectionName)
@@ -1,6 +1,7 @@
 #ifndef COMPONENTS_LUA_STORAGE_H
 #define COMPONENTS_LUA_STORAGE_H
 
+#include <filesystem>
 #include <map>
 #include <sol/sol.hpp>
 #include <stdexcept>
@@ -25,8 +26,10 @@ namespace LuaUtil
         explicit LuaStorage() {}
 
         void clearTemporaryAndRemoveCallbacks();
-        void load(lua_State* state, const std::filesystem::path& path);
-        void save(lua_State* state, const std::filesystem::path& path) const;
+        // Sections are split into values on first access
+        void load(const std::filesystem::path& path);
+        // Does nothing if the file was loaded or saved by this storage and no persistent section changed since
+        void save(const std::filesystem::path& path);
 
         sol::object getSection(
             lua_State* state, std::string_view sectionName, bool readOnly, bool forMenuScripts = false);
@@ -70,8 +73,15 @@ namespace LuaUtil
                 : mSerializedValue(serialize(value))
             {
             }
+            static Value fromSerialized(BinaryData data)
+            {
+                Value value;
+                value.mSerializedValue = std::move(data);
+                return value;
+            }
             sol::object getCopy(lua_State* state) const;
             sol::object getReadOnly(lua_State* state) const;
+            const BinaryData& getSerialized() const { return mSerializedValue; }
 
         private:
             std::string mSerializedValue;
@@ -92,16 +102,24 @@ namespace LuaUtil
                 , mSectionName(std::move(name))
             {
             }
-            const Value& get(std::string_view key) const;
+            const Value& get(std::string_view key);
             void set(std::string_view key, const sol::object& value);
             void setAll(const sol::optional<sol::table>& values);
+            void setLifeTime(LifeTime lifeTime);
             sol::table asTable(lua_State* state);
             void runCallbacks(sol::optional<std::string_view> changedKey);
             void throwIfCallbackRecursionIsTooDeep();
+            void loadValues();
+            void changed();
+            const BinaryData& getSerialized();
 
             LuaStorage* mStorage;
             std::string mSectionName;
             std::map<std::string, Value, std::less<>> mValues;
+            // Serialized table of mValues, empty if the section changed since it was made
+            BinaryData mSerialized;
+            // False till mValues are split from mSerialized after loading
+            bool mValuesLoaded = true;
             std::vector<Callback> mCallbacks;
             std::vector<Callback> mMenuScriptsCallbacks; // menu callbacks are in a separate vector because we don't
                                                          // remove them in clear()
@@ -120,6 +138,8 @@ namespace LuaUtil
         const std::shared_ptr<Section>& getSection(std::string_view sectionName);
 
         std::map<std::string_view, std::shared_ptr<Section>> mData;
+        // File that has the persistent sections as they are
+        std::filesystem::path mSyncedPath;
         const Listener* mListener = nullptr;
         std::set<const Section*> mRunningCallbacks;
         bool mActive = false;
@@ -0,0 +1,163 @@
+#ifndef COMPONENTS_LUA_TIMERWHEEL_H
+#define COMPONENTS_LUA_TIMERWHEEL_H
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <utility>
+#include <vector>
+
+namespace LuaUtil
+{
+    // Hierarchical timer wheel. Entries are bucketed by the tick of their time, the coarser levels cover exponentially
+    // longer spans of ticks and are moved to the finer levels when the time reaches them. Advancing the time by a few
+    // ticks takes time proportional to the number of expired entries, longer jumps redistribute all entries.
+    template <class T>
+    class TimerWheel
+    {
+    public:
+        struct Entry
+        {
+            double mTime;
+            T mValue;
+        };
+
+        explicit TimerWheel(double tickLength)
+            : mTickLength(tickLength)
+        {
+        }
+
+        std::size_t size() const { return mSize; }
+
+        void insert(double time, T value)
+        {
+            place(Entry{ time, std::move(value) });
+            ++mSize;
+        }
+
+        // Moves the entries with time not greater than the given one to expired, ordered by time
+        void advance(double time, std::vector<Entry>& expired)
+        {
+            const std::size_t begin = expired.size();
+            const std::int64_t target = getTick(time);
+            if (target < mCurrentTick || target - mCurrentTick > static_cast<std::int64_t>(sSlots))
+                rebuild(target);
+            while (mCurrentTick < target)
+            {
+                // All entries of the elapsed ticks are expired
+                std::vector<Entry>& slot = getSlot(0, mCurrentTick);
+                std::move(slot.begin(), slot.end(), std::back_inserter(expired));
+                slot.clear();
+                ++mCurrentTick;
+                cascade();
+            }
+            std::vector<Entry>& current = getSlot(0, mCurrentTick);
+            const auto notExpired = std::stable_partition(
+                current.begin(), current.end(), [&](const Entry& entry) { return entry.mTime <= time; });
+            std::move(current.begin(), notExpired, std::back_inserter(expired));
+            current.erase(current.begin(), notExpired);
+            mSize -= expired.size() - begin;
+            std::stable_sort(expired.begin() + static_cast<std::ptrdiff_t>(begin), expired.end(),
+                [](const Entry& l, const Entry& r) { return l.mTime < r.mTime; });
+        }
+
+        void clear()
+        {
+            for (auto& level : mLevels)
+                for (std::vector<Entry>& slot : level)
+                    slot.clear();
+            mOverflow.clear();
+            mSize = 0;
+        }
+
+    private:
+        static constexpr std::size_t sSlotBits = 6;
+        static constexpr std::size_t sSlots = std::size_t{ 1 } << sSlotBits;
+        static constexpr std::int64_t sSlotMask = sSlots - 1;
+        static constexpr std::size_t sLevels = 4;
+        // Far enough from the limits of std::int64_t to not overflow the difference between ticks
+        static constexpr double sMaxTick = static_cast<double>(std::int64_t{ 1 } << 60);
+
+        const double mTickLength;
+        std::int64_t mCurrentTick = 0;
+        std::size_t mSize = 0;
+        std::array<std::array<std::vector<Entry>, sSlots>, sLevels> mLevels;
+        // Entries too far from the current tick for the coarsest level
+        std::vector<Entry> mOverflow;
+
+        std::int64_t getTick(double time) const
+        {
+            const double tick = std::floor(time / mTickLength);
+            if (!(tick < sMaxTick)) // also NaN
+                return static_cast<std::int64_t>(sMaxTick);
+            if (tick < -sMaxTick)
+                return -static_cast<std::int64_t>(sMaxTick);
+            return static_cast<std::int64_t>(tick);
+        }
+
+        std::vector<Entry>& getSlot(std::size_t level, std::int64_t tick)
+        {
+            return mLevels[level][static_cast<std::size_t>((tick >> (level * sSlotBits)) & sSlotMask)];
+        }
+
+        void place(Entry&& entry)
+        {
+            const std::int64_t tick = getTick(entry.mTime);
+            const std::int64_t delta = tick - mCurrentTick;
+            if (delta <= 0)
+            {
+                getSlot(0, mCurrentTick).push_back(std::move(entry));
+                return;
+            }
+            for (std::size_t level = 0; level < sLevels; ++level)
+            {
+                if (delta < std::int64_t{ 1 } << ((level + 1) * sSlotBits))
+                {
+                    getSlot(level, tick).push_back(std::move(entry));
+                    return;
+                }
+            }
+            mOverflow.push_back(std::move(entry));
+        }
+
+        void reinsert(std::vector<Entry>& entries)
+        {
+            std::vector<Entry> moved = std::move(entries);
+            entries.clear();
+            for (Entry& entry : moved)
+                place(std::move(entry));
+        }
+
+        // Moves the entries of the coarser levels that start at the current tick to the finer levels
+        void cascade()
+        {
+            if ((mCurrentTick & ((std::int64_t{ 1 } << (sLevels * sSlotBits)) - 1)) == 0)
+                reinsert(mOverflow);
+            for (std::size_t level = sLevels - 1; level > 0; --level)
+                if ((mCurrentTick & ((std::int64_t{ 1 } << (level * sSlotBits)) - 1)) == 0)
+                    reinsert(getSlot(level, mCurrentTick));
+        }
+
+        void rebuild(std::int64_t tick)
+        {
+            std::vector<Entry> entries = std::move(mOverflow);
+            mOverflow.clear();
+            for (auto& level : mLevels)
+            {
+                for (std::vector<Entry>& slot : level)
+                {
+                    std::move(slot.begin(), slot.end(), std::back_inserter(entries));
+                    slot.clear();
+                }
+            }
+            mCurrentTick = tick;
+            for (Entry& entry : entries)
+                place(std::move(entry));
+        }
+    };
+}
+
+#endif // COMPONENTS_LUA_TIMERWHEEL_H
@@ -278,6 +278,7 @@ namespace LuaUi
         if (mState == Update)
         {
             assert(mRoot);
+            const auto start = std::chrono::steady_clock::now();
             if (mRoot->widget()->getTypeName() != widgetType(layout()))
             {
                 destroyRoot(mRoot);
@@ -309,6 +310,8 @@ namespace LuaUi
             mLayer = setLayer(mRoot, layout());
             updateRootCoord(mRoot);
             mState = Created;
+            ++mUpdateCount;
+            mUpdateDuration += std::chrono::steady_clock::now() - start;
         }
     }
 
@@ -1,6 +1,9 @@
 #ifndef OPENMW_LUAUI_ELEMENT
 #define OPENMW_LUAUI_ELEMENT
 
+#include <chrono>
+#include <cstdint>
+
 #include "widget.hpp"
 
 namespace LuaUi
@@ -32,6 +35,10 @@ namespace LuaUi
         };
         State mState;
 
+        // Time spent in update since the element was created, reported by the Lua profiler
+        int64_t mUpdateCount = 0;
+        std::chrono::steady_clock::duration mUpdateDuration{};
+
         void create(uint64_t dept = 0);
 
         void update();
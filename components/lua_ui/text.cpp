@@ -23,18 +23,35 @@ namespace LuaUi
     {
         mAutoSized = propertyValue("autoSize", true);
 
-        setCaption(propertyValue("text", std::string()));
-        setFontHeight(propertyValue("textSize", 10));
-        setTextColour(propertyValue("textColor", MyGUI::Colour(0, 0, 0, 1)));
-        setEditMultiLine(propertyValue("multiline", false));
-        setEditWordWrap(propertyValue("wordWrap", false));
+        // Each of these makes the text laid out again, while most updates of a layout leave them as they are
+        const MyGUI::UString caption(propertyValue("text", std::string()));
+        if (getCaption() != caption)
+            setCaption(caption);
+        const int fontHeight = propertyValue("textSize", 10);
+        if (getFontHeight() != fontHeight)
+            setFontHeight(fontHeight);
+        const MyGUI::Colour textColour = propertyValue("textColor", MyGUI::Colour(0, 0, 0, 1));
+        if (getTextColour() != textColour)
+            setTextColour(textColour);
+        const bool multiLine = propertyValue("multiline", false);
+        if (getEditMultiLine() != multiLine)
+            setEditMultiLine(multiLine);
+        const bool wordWrap = propertyValue("wordWrap", false);
+        if (getEditWordWrap() != wordWrap)
+            setEditWordWrap(wordWrap);
 
         Alignment horizontal(propertyValue("textAlignH", Alignment::Start));
         Alignment vertical(propertyValue("textAlignV", Alignment::Start));
-        setTextAlign(alignmentToMyGui(horizontal, vertical));
+        const MyGUI::Align align = alignmentToMyGui(horizontal, vertical);
+        if (getTextAlign() != align)
+            setTextAlign(align);
 
-        setTextShadow(propertyValue("textShadow", false));
-        setTextShadowColour(propertyValue("textShadowColor", MyGUI::Colour(0, 0, 0, 1)));
+        const bool textShadow = propertyValue("textShadow", false);
+        if (getTextShadow() != textShadow)
+            setTextShadow(textShadow);
+        const MyGUI::Colour textShadowColour = propertyValue("textShadowColor", MyGUI::Colour(0, 0, 0, 1));
+        if (getTextShadowColour() != textShadowColour)
+            setTextShadowColour(textShadowColour);
 
         WidgetExtension::updateProperties();
     }
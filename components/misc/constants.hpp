@@ -46,6 +46,12 @@ namespace Constants
     // Identifier for main scene camera
     const std::string SceneCamera = "SceneCam";
 
+    // Identifiers for cameras rendering the water and the shadow maps
+    const std::string ReflectionCamera = "ReflectionCamera";
+    const std::string RefractionCamera = "RefractionCamera";
+    const std::string ShadowCamera = "ShadowCamera";
+    const std::string StaticShadowCamera = "StaticShadowCamera";
+
 }
 
 #endif
@@ -0,0 +1,158 @@
+#include "framearena.hpp"
+
+#include <array>
+#include <atomic>
+#include <bit>
+#include <memory>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <utility>
+
+namespace Misc
+{
+    namespace
+    {
+        constexpr std::size_t initialArenaSize = 64 * 1024;
+
+        std::array<std::atomic<std::size_t>, frameArenaUserCount> sAllocations{};
+        std::array<std::atomic<std::size_t>, frameArenaUserCount> sBytes{};
+
+        // Thread the arena belongs to, set by resetFrameArena
+        std::atomic<std::thread::id> sArenaThread;
+
+        class Arena
+        {
+        public:
+            Arena()
+                : mBuffer(std::make_unique<std::byte[]>(initialArenaSize))
+                , mBufferSize(initialArenaSize)
+            {
+                mResource.emplace(mBuffer.get(), mBufferSize, std::pmr::new_delete_resource());
+            }
+
+            void* allocate(std::size_t bytes, std::size_t alignment)
+            {
+                mUsed += bytes + alignment;
+                return mResource->allocate(bytes, alignment);
+            }
+
+            void reset()
+            {
+                mResource.reset();
+                // Fit everything the last frame needed in the buffer, so the usual frame doesn't touch the heap
+                if (mUsed > mBufferSize)
+                {
+                    mBufferSize = std::bit_ceil(mUsed);
+                    mBuffer = std::make_unique<std::byte[]>(mBufferSize);
+                }
+                mUsed = 0;
+                mResource.emplace(mBuffer.get(), mBufferSize, std::pmr::new_delete_resource());
+            }
+
+        private:
+            std::unique_ptr<std::byte[]> mBuffer;
+            std::size_t mBufferSize;
+            std::size_t mUsed = 0;
+            std::optional<std::pmr::monotonic_buffer_resource> mResource;
+        };
+
+        // Counts the allocations of a user, allocates from the arena or from the heap without one
+        class CountingResource final : public std::pmr::memory_resource
+        {
+        public:
+            CountingResource(std::size_t user, Arena* arena)
+                : mUser(user)
+                , mArena(arena)
+            {
+            }
+
+        private:
+            std::size_t mUser;
+            Arena* mArena;
+
+            void* do_allocate(std::size_t bytes, std::size_t alignment) override
+            {
+                sAllocations[mUser].fetch_add(1, std::memory_order_relaxed);
+                sBytes[mUser].fetch_add(bytes, std::memory_order_relaxed);
+                if (mArena != nullptr)
+                    return mArena->allocate(bytes, alignment);
+                return std::pmr::new_delete_resource()->allocate(bytes, alignment);
+            }
+
+            void do_deallocate(void* p, std::size_t bytes, std::size_t alignment) override
+            {
+                if (mArena == nullptr)
+                    std::pmr::new_delete_resource()->deallocate(p, bytes, alignment);
+            }
+
+            bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override { return this == &other; }
+        };
+
+        template <std::size_t... users>
+        std::array<CountingResource, frameArenaUserCount> makeResources(Arena* arena, std::index_sequence<users...>)
+        {
+            return { CountingResource(users, arena)... };
+        }
+
+        std::array<CountingResource, frameArenaUserCount> makeResources(Arena* arena)
+        {
+            return makeResources(arena, std::make_index_sequence<frameArenaUserCount>());
+        }
+
+        std::array<CountingResource, frameArenaUserCount> sHeapResources = makeResources(nullptr);
+
+        struct ArenaResources
+        {
+            Arena mArena;
+            std::array<CountingResource, frameArenaUserCount> mUsers = makeResources(&mArena);
+        };
+
+        ArenaResources& getArenaResources()
+        {
+            thread_local ArenaResources resources;
+            return resources;
+        }
+    }
+
+    std::string_view getFrameArenaUserName(FrameArenaUser user)
+    {
+        switch (user)
+        {
+            case FrameArenaUser::Mechanics:
+                return "Mechanics";
+            case FrameArenaUser::Lua:
+                return "Lua";
+            case FrameArenaUser::Rendering:
+                return "Rendering";
+        }
+        throw std::logic_error("Unknown frame arena user: " + std::to_string(static_cast<int>(user)));
+    }
+
+    std::pmr::memory_resource* getFrameArena(FrameArenaUser user)
+    {
+        const auto index = static_cast<std::size_t>(user);
+        if (sArenaThread.load(std::memory_order_relaxed) == std::this_thread::get_id())
+            return &getArenaResources().mUsers[index];
+        return &sHeapResources[index];
+    }
+
+    FrameArenaStats getFrameArenaStats(FrameArenaUser user)
+    {
+        const auto index = static_cast<std::size_t>(user);
+        return FrameArenaStats{ sAllocations[index].load(std::memory_order_relaxed),
+            sBytes[index].load(std::memory_order_relaxed) };
+    }
+
+    void resetFrameArena()
+    {
+        sArenaThread.store(std::this_thread::get_id(), std::memory_order_relaxed);
+        getArenaResources().mArena.reset();
+        for (std::size_t i = 0; i < frameArenaUserCount; ++i)
+        {
+            sAllocations[i].store(0, std::memory_order_relaxed);
+            sBytes[i].store(0, std::memory_order_relaxed);
+        }
+    }
+}
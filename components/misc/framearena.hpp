@@ -0,0 +1,53 @@
+#ifndef OPENMW_COMPONENTS_MISC_FRAMEARENA_H
+#define OPENMW_COMPONENTS_MISC_FRAMEARENA_H
+
+#include <cstddef>
+#include <memory_resource>
+#include <string_view>
+#include <vector>
+
+namespace Misc
+{
+    /// Allocations from the frame arena are counted separately for each user
+    enum class FrameArenaUser
+    {
+        Mechanics,
+        Lua,
+        Rendering,
+    };
+
+    inline constexpr std::size_t frameArenaUserCount = 3;
+
+    std::string_view getFrameArenaUserName(FrameArenaUser user);
+
+    struct FrameArenaStats
+    {
+        std::size_t mAllocations = 0;
+        std::size_t mBytes = 0;
+    };
+
+    /// @brief Returns a monotonic memory resource for memory that is only used until the end of the frame.
+    /// Deallocation does nothing, all the memory is released at once by resetFrameArena. Only the thread calling
+    /// resetFrameArena has an arena, on other threads the resource allocates from the heap, so the same code can run
+    /// on any thread.
+    std::pmr::memory_resource* getFrameArena(FrameArenaUser user);
+
+    /// Vector for the frame arena, meant for local variables: it must not outlive the frame.
+    template <class T>
+    using FrameVector = std::pmr::vector<T>;
+
+    template <class T>
+    FrameVector<T> makeFrameVector(FrameArenaUser user)
+    {
+        return FrameVector<T>(getFrameArena(user));
+    }
+
+    /// @return the allocations made through getFrameArena since the last resetFrameArena, on all threads
+    FrameArenaStats getFrameArenaStats(FrameArenaUser user);
+
+    /// Releases the memory of the frame arena and resets the stats. The arena belongs to the calling thread
+    /// from then on. Nothing allocated from the arena may be used after this call.
+    void resetFrameArena();
+}
+
+#endif
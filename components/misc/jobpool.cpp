@@ -0,0 +1,102 @@
+#include "jobpool.hpp"
+
+#include <algorithm>
+#include <utility>
+
+namespace Misc
+{
+    JobPool::JobPool(std::size_t threadCount)
+    {
+        mThreads.reserve(threadCount);
+        for (std::size_t i = 0; i < threadCount; ++i)
+            mThreads.emplace_back([this] { work(); });
+    }
+
+    JobPool::~JobPool()
+    {
+        {
+            const std::lock_guard lock(mMutex);
+            mStopping = true;
+        }
+        mHasJobs.notify_all();
+        for (std::thread& thread : mThreads)
+            thread.join();
+    }
+
+    void JobPool::run(std::size_t count, std::size_t chunkSize, const std::function<void(std::size_t)>& job)
+    {
+        chunkSize = std::max<std::size_t>(chunkSize, 1);
+
+        if (mThreads.empty() || count <= chunkSize)
+        {
+            for (std::size_t i = 0; i < count; ++i)
+                job(i);
+            return;
+        }
+
+        {
+            const std::lock_guard lock(mMutex);
+            mJob = &job;
+            mCount = count;
+            mChunkSize = chunkSize;
+            mNext.store(0, std::memory_order_relaxed);
+            mBusyThreads = mThreads.size();
+            mError = nullptr;
+            ++mGeneration;
+        }
+        mHasJobs.notify_all();
+
+        process();
+
+        std::unique_lock lock(mMutex);
+        mJobsDone.wait(lock, [&] { return mBusyThreads == 0; });
+        mJob = nullptr;
+        if (mError != nullptr)
+            std::rethrow_exception(std::exchange(mError, nullptr));
+    }
+
+    void JobPool::work()
+    {
+        std::size_t generation = 0;
+        while (true)
+        {
+            {
+                std::unique_lock lock(mMutex);
+                mHasJobs.wait(lock, [&] { return mStopping || mGeneration != generation; });
+                if (mStopping)
+                    return;
+                generation = mGeneration;
+            }
+
+            process();
+
+            const std::lock_guard lock(mMutex);
+            if (--mBusyThreads == 0)
+                mJobsDone.notify_one();
+        }
+    }
+
+    void JobPool::process()
+    {
+        try
+        {
+            while (true)
+            {
+                const std::size_t begin = mNext.fetch_add(mChunkSize, std::memory_order_relaxed);
+                if (begin >= mCount)
+                    break;
+                const std::size_t end = std::min(begin + mChunkSize, mCount);
+                for (std::size_t i = begin; i < end; ++i)
+                    (*mJob)(i);
+            }
+        }
+        catch (...)
+        {
+            // make other threads stop claiming new chunks
+            mNext.store(mCount, std::memory_order_relaxed);
+            const std::lock_guard lock(mMutex);
+            if (mError == nullptr)
+                mError = std::current_exception();
+        }
+    }
+}
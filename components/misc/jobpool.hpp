@@ -0,0 +1,53 @@
+#ifndef OPENMW_COMPONENTS_MISC_JOBPOOL_H
+#define OPENMW_COMPONENTS_MISC_JOBPOOL_H
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace Misc
+{
+    /// @brief Runs a batch of index based jobs on a fixed set of worker threads and the calling thread.
+    /// @par Threads claim indices in chunks from a shared counter, so a thread finishing its chunk early takes the
+    /// next one instead of waiting for others. Jobs must be independent from each other and must not call run().
+    class JobPool
+    {
+    public:
+        /// @param threadCount number of worker threads in addition to the calling thread
+        explicit JobPool(std::size_t threadCount);
+
+        ~JobPool();
+
+        std::size_t getThreadCount() const { return mThreads.size(); }
+
+        /// @brief Call job for each index in [0, count) and wait for all of them to complete.
+        /// @param chunkSize number of consecutive indices claimed by a thread at once
+        /// @par Rethrows the first exception thrown by a job after all threads have stopped processing.
+        void run(std::size_t count, std::size_t chunkSize, const std::function<void(std::size_t)>& job);
+
+    private:
+        std::mutex mMutex;
+        std::condition_variable mHasJobs;
+        std::condition_variable mJobsDone;
+        const std::function<void(std::size_t)>* mJob = nullptr;
+        std::size_t mCount = 0;
+        std::size_t mChunkSize = 1;
+        std::atomic_size_t mNext{ 0 };
+        std::size_t mGeneration = 0;
+        std::size_t mBusyThreads = 0;
+        bool mStopping = false;
+        std::exception_ptr mError;
+        std::vector<std::thread> mThreads;
+
+        void work();
+
+        void process();
+    };
+}
+
+#endif
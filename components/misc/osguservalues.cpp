@@ -4,4 +4,5 @@ namespace Misc
 {
     const std::string OsgUserValues::sFileHash = "fileHash";
     const std::string OsgUserValues::sXSoftEffect = "xSoftEffect";
+    const std::string OsgUserValues::sInstancing = "instancing";
 }
@@ -4,7 +4,10 @@
 #include "lower.hpp"
 
 #include <algorithm>
+#include <bit>
+#include <cstddef>
 #include <cstdint>
+#include <cstring>
 #include <functional>
 #include <string>
 #include <string_view>
@@ -23,24 +26,53 @@ namespace Misc::StringUtils
         return newName;
     }
 
+    /// @return the position of the first character that differs ignoring case, size if there is none
+    inline std::size_t ciMismatch(const char* x, const char* y, std::size_t size)
+    {
+        std::size_t i = 0;
+        for (; i + Word::size <= size; i += Word::size)
+        {
+            const std::uint64_t left = Word::load(x + i);
+            const std::uint64_t right = Word::load(y + i);
+            if (left == right)
+                continue;
+            const std::uint64_t difference = Word::toLower(left) ^ Word::toLower(right);
+            if (difference == 0)
+                continue;
+            if constexpr (std::endian::native == std::endian::little)
+                return i + std::countr_zero(difference) / 8;
+            else if constexpr (std::endian::native == std::endian::big)
+                return i + std::countl_zero(difference) / 8;
+            else
+                break;
+        }
+        for (; i < size; ++i)
+            if (toLower(x[i]) != toLower(y[i]))
+                break;
+        return i;
+    }
+
     inline bool ciLess(std::string_view x, std::string_view y)
     {
-        return std::lexicographical_compare(x.begin(), x.end(), y.begin(), y.end(), CiCharLess());
+        const std::size_t size = std::min(x.size(), y.size());
+        const std::size_t i = ciMismatch(x.data(), y.data(), size);
+        if (i == size)
+            return x.size() < y.size();
+        return CiCharLess()(x[i], y[i]);
     }
 
     inline bool ciEqual(std::string_view x, std::string_view y)
     {
         if (std::size(x) != std::size(y))
             return false;
-        return std::equal(
-            std::begin(x), std::end(x), std::begin(y), [](char l, char r) { return toLower(l) == toLower(r); });
+        return ciMismatch(x.data(), y.data(), x.size()) == x.size();
     }
     inline bool ciEqual(std::u8string_view x, std::u8string_view y)
     {
         if (std::size(x) != std::size(y))
             return false;
-        return std::equal(
-            std::begin(x), std::end(x), std::begin(y), [](char l, char r) { return toLower(l) == toLower(r); });
+        return ciMismatch(reinterpret_cast<const char*>(x.data()), reinterpret_cast<const char*>(y.data()), x.size())
+            == x.size();
     }
 
     inline bool ciStartsWith(std::string_view value, std::string_view prefix)
@@ -88,13 +120,20 @@ namespace Misc::StringUtils
 
         std::size_t operator()(std::string_view str) const
         {
-            // FNV-1a
-            std::uint64_t hash{ 0xcbf29ce484222325ull };
-            constexpr std::uint64_t prime{ 0x00000100000001B3ull };
-            for (char c : str)
+            // FxHash taking 8 characters at once
+            constexpr std::uint64_t seed{ 0x517cc1b727220a95ull };
+            const auto add = [](std::uint64_t hash, std::uint64_t word) {
+                return (std::rotl(hash, 5) ^ Word::toLower(word)) * seed;
+            };
+            std::uint64_t hash = str.size();
+            std::size_t i = 0;
+            for (; i + Word::size <= str.size(); i += Word::size)
+                hash = add(hash, Word::load(str.data() + i));
+            if (i < str.size())
             {
-                hash ^= static_cast<std::uint64_t>(toLower(c));
-                hash *= prime;
+                std::uint64_t tail = 0;
+                std::memcpy(&tail, str.data() + i, str.size() - i);
+                hash = add(hash, tail);
             }
             return std::hash<std::uint64_t>()(hash);
         }
@@ -1,6 +1,9 @@
 #ifndef COMPONENTS_MISC_STRINGS_LOWER_H
 #define COMPONENTS_MISC_STRINGS_LOWER_H
 
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
 #include <string>
 #include <string_view>
 
@@ -32,16 +35,68 @@ namespace Misc::StringUtils
         return tolowermap[static_cast<unsigned char>(c)];
     }
 
+    /// Functions working on 8 characters packed into a 64-bit integer at once, the order of the characters doesn't
+    /// matter
+    namespace Word
+    {
+        inline constexpr std::size_t size = sizeof(std::uint64_t);
+        inline constexpr std::uint64_t lowBits = 0x7f7f7f7f7f7f7f7full;
+        inline constexpr std::uint64_t highBits = 0x8080808080808080ull;
+
+        inline constexpr std::uint64_t repeat(unsigned char c)
+        {
+            return 0x0101010101010101ull * c;
+        }
+
+        inline std::uint64_t load(const void* data)
+        {
+            std::uint64_t result;
+            std::memcpy(&result, data, size);
+            return result;
+        }
+
+        inline void store(std::uint64_t value, void* data)
+        {
+            std::memcpy(data, &value, size);
+        }
+
+        /// @return the high bit set for every character equal to c
+        inline constexpr std::uint64_t equal(std::uint64_t value, unsigned char c)
+        {
+            const std::uint64_t x = value ^ repeat(c);
+            return ~(((x & lowBits) + lowBits) | x | lowBits);
+        }
+
+        /// Same as toLower for every character.
+        inline constexpr std::uint64_t toLower(std::uint64_t value)
+        {
+            // Adding to the lower 7 bits of a character sets its high bit if it's greater or equal, doesn't carry
+            const std::uint64_t low = value & lowBits;
+            const std::uint64_t atLeastA = low + repeat(0x80 - 'A');
+            const std::uint64_t afterZ = low + repeat(0x80 - 'Z' - 1);
+            const std::uint64_t upper = atLeastA & ~afterZ & ~value & highBits;
+            // 'a' - 'A' is 0x20, the upper case letters have that bit cleared
+            return value | (upper >> 2);
+        }
+    }
+
+    inline void lowerCaseInPlace(char* data, std::size_t size)
+    {
+        std::size_t i = 0;
+        for (; i + Word::size <= size; i += Word::size)
+            Word::store(Word::toLower(Word::load(data + i)), data + i);
+        for (; i < size; ++i)
+            data[i] = toLower(data[i]);
+    }
+
     /// Transforms input string to lower case w/o copy
     inline void lowerCaseInPlace(std::string& str)
     {
-        for (auto& ch : str)
-            ch = toLower(ch);
+        lowerCaseInPlace(str.data(), str.size());
     }
     inline void lowerCaseInPlace(std::u8string& str)
     {
-        for (auto& ch : str)
-            ch = toLower(ch);
+        lowerCaseInPlace(reinterpret_cast<char*>(str.data()), str.size());
     }
 
     /// Returns lower case copy of input string
@@ -2,9 +2,61 @@
 
 #include <components/debug/debuglog.hpp>
 
+#include <charconv>
 #include <cstring>
+#include <sstream>
+#include <string>
 #include <thread>
 
+namespace Misc
+{
+    namespace
+    {
+        // No system has this many cores, a larger range is most likely a typo
+        constexpr unsigned maxCoreRange = 4096;
+
+        std::string toString(std::span<const unsigned> cores)
+        {
+            std::ostringstream stream;
+            for (std::size_t i = 0; i < cores.size(); ++i)
+                stream << (i == 0 ? "" : ",") << cores[i];
+            return stream.str();
+        }
+    }
+
+    std::vector<unsigned> parseCoreList(std::string_view value)
+    {
+        std::vector<unsigned> result;
+        if (value.empty())
+            return result;
+        while (true)
+        {
+            const std::size_t end = value.find(',');
+            const std::string_view item = value.substr(0, end);
+
+            unsigned first = 0;
+            const auto [firstEnd, firstError] = std::from_chars(item.data(), item.data() + item.size(), first);
+            if (firstError != std::errc())
+                return {};
+            unsigned last = first;
+            if (firstEnd != item.data() + item.size())
+            {
+                if (*firstEnd != '-')
+                    return {};
+                const auto [lastEnd, lastError] = std::from_chars(firstEnd + 1, item.data() + item.size(), last);
+                if (lastError != std::errc() || lastEnd != item.data() + item.size() || last < first
+                    || last - first >= maxCoreRange)
+                    return {};
+            }
+            for (unsigned core = first; core <= last; ++core)
+                result.push_back(core);
+            if (end == std::string_view::npos)
+                return result;
+            value.remove_prefix(end + 1);
+        }
+    }
+}
+
 #ifdef __linux__
 
 #include <pthread.h>
@@ -22,6 +74,21 @@ namespace Misc
             Log(Debug::Warning) << "Failed to set idle priority for thread=" << std::this_thread::get_id() << ": "
                                 << std::generic_category().message(errno);
     }
+
+    void setCurrentThreadAffinity(std::span<const unsigned> cores)
+    {
+        cpu_set_t set;
+        CPU_ZERO(&set);
+        for (const unsigned core : cores)
+            if (core < CPU_SETSIZE)
+                CPU_SET(core, &set);
+        if (const int error = pthread_setaffinity_np(pthread_self(), sizeof(set), &set); error == 0)
+            Log(Debug::Verbose) << "Using cores " << toString(cores) << " for thread=" << std::this_thread::get_id();
+        else
+            Log(Debug::Warning) << "Failed to set affinity to cores " << toString(cores)
+                                << " for thread=" << std::this_thread::get_id() << ": "
+                                << std::generic_category().message(error);
+    }
 }
 
 #elif defined(WIN32)
@@ -38,6 +105,19 @@ namespace Misc
             Log(Debug::Warning) << "Failed to set idle priority for thread=" << std::this_thread::get_id() << ": "
                                 << GetLastError();
     }
+
+    void setCurrentThreadAffinity(std::span<const unsigned> cores)
+    {
+        DWORD_PTR mask = 0;
+        for (const unsigned core : cores)
+            if (core < sizeof(mask) * 8)
+                mask |= DWORD_PTR(1) << core;
+        if (SetThreadAffinityMask(GetCurrentThread(), mask) != 0)
+            Log(Debug::Verbose) << "Using cores " << toString(cores) << " for thread=" << std::this_thread::get_id();
+        else
+            Log(Debug::Warning) << "Failed to set affinity to cores " << toString(cores)
+                                << " for thread=" << std::this_thread::get_id() << ": " << GetLastError();
+    }
 }
 
 #elif defined(__FreeBSD__)
@@ -58,6 +138,11 @@ namespace Misc
             Log(Debug::Warning) << "Failed to set idle priority for thread=" << std::this_thread::get_id() << ": "
                                 << std::generic_category().message(errno);
     }
+
+    void setCurrentThreadAffinity(std::span<const unsigned> /*cores*/)
+    {
+        Log(Debug::Warning) << "Thread affinity is not supported on this system";
+    }
 }
 
 #else
@@ -68,6 +153,11 @@ namespace Misc
     {
         Log(Debug::Warning) << "Idle thread priority is not supported on this system";
     }
+
+    void setCurrentThreadAffinity(std::span<const unsigned> /*cores*/)
+    {
+        Log(Debug::Warning) << "Thread affinity is not supported on this system";
+    }
 }
 
 #endif
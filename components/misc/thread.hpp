@@ -1,9 +1,20 @@
 #ifndef OPENMW_COMPONENTS_MISC_THREAD_H
 #define OPENMW_COMPONENTS_MISC_THREAD_H
 
+#include <span>
+#include <string_view>
+#include <vector>
+
 namespace Misc
 {
     void setCurrentThreadIdlePriority();
+
+    /// @param value comma separated core indices and inclusive ranges of them, like "0-3,8"
+    /// @return no cores if the value is empty or malformed
+    std::vector<unsigned> parseCoreList(std::string_view value);
+
+    /// Allow the current thread to run only on the given cores.
+    void setCurrentThreadAffinity(std::span<const unsigned> cores);
 }
 
 #endif
@@ -11,6 +11,7 @@
 #include <osgGA/GUIEventHandler>
 
 #include <components/resource/imagemanager.hpp>
+#include <components/sceneutil/gputimer.hpp>
 #include <components/sceneutil/nodecallback.hpp>
 #include <components/shader/shadermanager.hpp>
 
@@ -100,15 +101,22 @@ namespace MyGUIPlatform
 
             mReadFrom = (mReadFrom + 1) % sNumBuffers;
             const std::vector<Batch>& vec = mBatchVector[mReadFrom];
+            // Consecutive batches usually share the injected state of their layer or widget, only apply it when it
+            // changes instead of around every batch
+            const osg::StateSet* currentStateSet = nullptr;
             for (std::vector<Batch>::const_iterator it = vec.begin(); it != vec.end(); ++it)
             {
                 const Batch& batch = *it;
                 osg::VertexBufferObject* vbo = batch.mVertexBuffer;
 
-                if (batch.mStateSet)
+                if (batch.mStateSet != currentStateSet)
                 {
-                    state->pushStateSet(batch.mStateSet);
+                    if (currentStateSet != nullptr)
+                        state->popStateSet();
+                    if (batch.mStateSet)
+                        state->pushStateSet(batch.mStateSet);
                     state->apply();
+                    currentStateSet = batch.mStateSet;
                 }
 
                 // A GUI element without an associated texture would be extremely rare.
@@ -142,12 +150,12 @@ namespace MyGUIPlatform
                 }
 
                 glDrawArrays(GL_TRIANGLES, 0, static_cast<GLsizei>(batch.mVertexCount));
+            }
 
-                if (batch.mStateSet)
-                {
-                    state->popStateSet();
-                    state->apply();
-                }
+            if (currentStateSet != nullptr)
+            {
+                state->popStateSet();
+                state->apply();
             }
 
             glDisableClientState(GL_VERTEX_ARRAY);
@@ -398,6 +406,7 @@ namespace MyGUIPlatform
         camera->setViewMatrix(osg::Matrix::identity());
         camera->setRenderOrder(osg::Camera::POST_RENDER);
         camera->setClearMask(GL_NONE);
+        SceneUtil::addGpuTimer(*camera, "GPU UI");
         mDrawable->setCullingActive(false);
         camera->addChild(mDrawable.get());
 
@@ -444,6 +453,10 @@ namespace MyGUIPlatform
 
     void RenderManager::doRender(MyGUI::IVertexBuffer* buffer, MyGUI::ITexture* texture, size_t count)
     {
+        // Hidden and empty widgets still have their render items submitted
+        if (count == 0)
+            return;
+
         Drawable::Batch batch;
         batch.mVertexCount = count;
         batch.mVertexBuffer = static_cast<OSGVertexBuffer*>(buffer)->getVertexBuffer();
@@ -31,6 +31,13 @@ namespace Nif
         T mOutTan; // Only for Quadratic interpolation, and never for QuaternionKeyList
     };
 
+    // Quaternion keys never have tangents, don't store them for every key of every rotation track
+    template <>
+    struct KeyT<osg::Quat>
+    {
+        osg::Quat mValue;
+    };
+
     template <typename T>
     struct TCBKey
     {
@@ -56,6 +63,8 @@ namespace Nif
         float mLegacyWeight;
         uint32_t mInterpolationType = InterpolationType_Unknown;
         MapType mKeys;
+        // Times of mKeys stored contiguously to search them without touching the values
+        std::vector<float> mTimes;
 
         // Read in a KeyGroup (see http://niftools.sourceforge.net/doc/nif/NiKeyframeData.html)
         void read(NIFStream* nif, bool morph = false)
@@ -81,6 +90,23 @@ namespace Nif
             if (count == 0 && !morph)
                 return;
 
+            readKeys(nif, count);
+            updateTimes();
+        }
+
+        // Has to be called when mKeys is filled by something else than read
+        void updateTimes()
+        {
+            mTimes.clear();
+            mTimes.reserve(mKeys.size());
+            for (const auto& [time, _] : mKeys)
+                mTimes.push_back(time);
+        }
+
+    private:
+        void readKeys(NIFStream* nif, uint32_t count)
+        {
+
             nif->read(mInterpolationType);
 
             mKeys.reserve(count);
@@ -99,8 +125,13 @@ namespace Nif
                 nif->readVectorOfRecords(count, readTCBKey, tcbKeys);
                 generateTCBTangents(tcbKeys);
                 for (TCBKey<T>& tcbKey : tcbKeys)
-                    mKeys.emplace_back(tcbKey.mTime,
-                        KeyType{ std::move(tcbKey.mValue), std::move(tcbKey.mInTan), std::move(tcbKey.mOutTan) });
+                {
+                    if constexpr (std::is_same_v<T, osg::Quat>)
+                        mKeys.emplace_back(tcbKey.mTime, KeyType{ tcbKey.mValue });
+                    else
+                        mKeys.emplace_back(tcbKey.mTime,
+                            KeyType{ std::move(tcbKey.mValue), std::move(tcbKey.mInTan), std::move(tcbKey.mOutTan) });
+                }
             }
             else if (mInterpolationType == InterpolationType_XYZ)
             {
@@ -120,7 +151,6 @@ namespace Nif
             // Note: NetImmerse does NOT sort keys or remove duplicates
         }
 
-    private:
         static void readValue(NIFStream& nif, KeyType& key) { key.mValue = (nif.*getValue)(); }
 
         static void readValuePair(NIFStream& nif, std::pair<float, KeyType>& value)
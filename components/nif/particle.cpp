@@ -677,6 +677,7 @@ namespace Nif
         mFloatKeyList->read(nif);
         mVisKeyList = std::make_shared<BoolKeyMap>();
         nif->readVectorOfRecords<uint32_t>(readKeyMapPair<float, bool>, mVisKeyList->mKeys);
+        mVisKeyList->updateTimes();
     }
 
     void NiPSysCollider::read(NIFStream* nif)
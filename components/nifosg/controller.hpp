@@ -38,24 +38,21 @@ namespace NifOsg
     template <typename MapT>
     class ValueInterpolator
     {
-        typename MapT::MapType::const_iterator retrieveKey(float time) const
+        std::size_t retrieveKey(float time) const
         {
+            const std::vector<float>& times = mKeys->mTimes;
             // retrieve the current position in the map, optimized for the most common case
             // where time moves linearly along the keyframe track
-            if (mLastHighKey != mKeys->mKeys.end())
+            if (mLastHighKey < times.size())
             {
-                if (time > mLastHighKey->first)
-                {
-                    // try if we're there by incrementing one
-                    ++mLastLowKey;
+                // try if we're there by incrementing one
+                if (time > times[mLastHighKey])
                     ++mLastHighKey;
-                }
-                if (mLastHighKey != mKeys->mKeys.end() && time >= mLastLowKey->first && time <= mLastHighKey->first)
+                if (mLastHighKey < times.size() && time >= times[mLastHighKey - 1] && time <= times[mLastHighKey])
                     return mLastHighKey;
             }
 
-            return std::lower_bound(mKeys->mKeys.begin(), mKeys->mKeys.end(), time,
-                [](const typename MapT::MapType::value_type& key, float t) { return key.first < t; });
+            return static_cast<std::size_t>(std::lower_bound(times.begin(), times.end(), time) - times.begin());
         }
 
     public:
@@ -76,10 +73,7 @@ namespace NifOsg
                 return;
             mKeys = interpolator->mData->mKeyList;
             if (mKeys)
-            {
-                mLastLowKey = mKeys->mKeys.end();
-                mLastHighKey = mKeys->mKeys.end();
-            }
+                mLastHighKey = mKeys->mTimes.size();
         }
 
         ValueInterpolator(std::shared_ptr<const MapT> keys, ValueT defaultVal = ValueT())
@@ -87,10 +81,7 @@ namespace NifOsg
             , mDefaultVal(defaultVal)
         {
             if (keys)
-            {
-                mLastLowKey = mKeys->mKeys.end();
-                mLastHighKey = mKeys->mKeys.end();
-            }
+                mLastHighKey = mKeys->mTimes.size();
         }
 
         ValueT interpKey(float time) const
@@ -103,23 +94,22 @@ namespace NifOsg
             if (time <= keys.front().first)
                 return keys.front().second.mValue;
 
-            typename MapT::MapType::const_iterator it = retrieveKey(time);
+            const std::size_t high = retrieveKey(time);
 
             // now do the actual interpolation
-            if (it != keys.end())
+            if (high < keys.size())
             {
                 // cache for next time
-                mLastHighKey = it;
-                mLastLowKey = --it;
+                mLastHighKey = high;
 
-                const float highTime = mLastHighKey->first;
-                const float lowTime = mLastLowKey->first;
+                const auto& [highTime, highKey] = keys[high];
+                const auto& [lowTime, lowKey] = keys[high - 1];
                 if (highTime == lowTime)
-                    return mLastLowKey->second.mValue;
+                    return lowKey.mValue;
 
                 const float a = (time - lowTime) / (highTime - lowTime);
 
-                return interpolate(mLastLowKey->second, mLastHighKey->second, a, mKeys->mInterpolationType);
+                return interpolate(lowKey, highKey, a, mKeys->mInterpolationType);
             }
 
             return keys.back().second.mValue;
@@ -175,8 +165,8 @@ namespace NifOsg
             }
         }
 
-        mutable typename MapT::MapType::const_iterator mLastLowKey;
-        mutable typename MapT::MapType::const_iterator mLastHighKey;
+        // Index of the key after the last looked up time, the key before it is the low one
+        mutable std::size_t mLastHighKey = 0;
 
         std::shared_ptr<const MapT> mKeys;
 
@@ -1,7 +1,13 @@
 #include "nifloader.hpp"
 
+#include <algorithm>
+#include <atomic>
+#include <functional>
+#include <future>
+#include <limits>
 #include <mutex>
 #include <string_view>
+#include <thread>
 
 #include <osg/Array>
 #include <osg/Geometry>
@@ -34,6 +40,8 @@
 #include <osgParticle/ParticleSystem>
 #include <osgParticle/ParticleSystemUpdater>
 
+#include <osgUtil/MeshOptimizers>
+
 #include <osg/AlphaFunc>
 #include <osg/BlendFunc>
 #include <osg/FrontFace>
@@ -67,6 +75,9 @@
 
 namespace
 {
+    // Total number of vertices of a file worth building its drawables on more than one thread
+    constexpr std::size_t sMinParallelVertices = 16384;
+
     struct DisableOptimizer : osg::NodeVisitor
     {
         DisableOptimizer(osg::NodeVisitor::TraversalMode mode = TRAVERSE_ALL_CHILDREN)
@@ -227,6 +238,26 @@ namespace
             }
         }
     }
+
+    // Reorders the triangles only, vertex indices of skin and morph data stay valid
+    void optimizeVertexCache(osg::Geometry& geometry)
+    {
+        osgUtil::VertexCacheVisitor visitor;
+        visitor.optimizeVertices(geometry);
+
+        // The visitor always writes 32 bit indices, the vertex count of a NIF shape fits into 16 bit
+        const osg::Array* vertices = geometry.getVertexArray();
+        if (vertices == nullptr || vertices->getNumElements() > std::numeric_limits<unsigned short>::max() + 1u)
+            return;
+        for (unsigned i = 0; i < geometry.getNumPrimitiveSets(); ++i)
+        {
+            const auto* elements = dynamic_cast<const osg::DrawElementsUInt*>(geometry.getPrimitiveSet(i));
+            if (elements == nullptr)
+                continue;
+            geometry.setPrimitiveSet(
+                i, new osg::DrawElementsUShort(elements->getMode(), elements->begin(), elements->end()));
+        }
+    }
 }
 
 namespace NifOsg
@@ -278,6 +309,30 @@ namespace NifOsg
         return sSoftEffectEnabled;
     }
 
+    bool Loader::sParallelMeshBuilding = false;
+
+    void Loader::setParallelMeshBuilding(bool enabled)
+    {
+        sParallelMeshBuilding = enabled;
+    }
+
+    bool Loader::getParallelMeshBuilding()
+    {
+        return sParallelMeshBuilding;
+    }
+
+    bool Loader::sOptimizeVertexCache = false;
+
+    void Loader::setOptimizeVertexCache(bool enabled)
+    {
+        sOptimizeVertexCache = enabled;
+    }
+
+    bool Loader::getOptimizeVertexCache()
+    {
+        return sOptimizeVertexCache;
+    }
+
     class LoaderImpl
     {
     public:
@@ -307,6 +362,18 @@ namespace NifOsg
         // This is used to queue emitters that weren't attached to their node yet.
         std::vector<std::pair<size_t, osg::ref_ptr<Emitter>>> mEmitterQueue;
 
+        struct QueuedDrawable
+        {
+            osg::Group* mParentNode;
+            unsigned int mIndex;
+            std::size_t mNumVertices;
+            std::function<osg::ref_ptr<osg::Drawable>()> mCreate;
+            osg::ref_ptr<osg::Drawable> mDrawable;
+        };
+
+        // This is used to queue drawables that are built once the node hierarchy is created.
+        std::vector<QueuedDrawable> mDrawableQueue;
+
         void loadKf(Nif::FileView nif, SceneUtil::KeyframeHolder& target) const
         {
             const Nif::NiSequenceStreamHelper* seq = nullptr;
@@ -420,6 +487,9 @@ namespace NifOsg
                     root, nullptr, nullptr, { .mNifVersion = nif.getVersion(), .mTextKeys = &textkeys->mTextKeys });
                 created->addChild(node);
             }
+
+            handleQueuedDrawables();
+
             if (mHasNightDayLabel)
                 created->getOrCreateUserDataContainer()->addDescription(Constants::NightDayLabel);
             if (mHasHerbalismLabel)
@@ -821,7 +891,7 @@ namespace NifOsg
                     if (isNiGeometry)
                         handleNiGeometry(nifNode, parent, node, composite, args.mBoundTextures, args.mAnimFlags);
                     else // isBSGeometry
-                        handleBSGeometry(nifNode, parent, node, composite, args.mBoundTextures, args.mAnimFlags);
+                        handleBSGeometry(nifNode, parent, node, composite, args.mAnimFlags);
 
                     if (!nifNode->mController.empty())
                         handleMeshControllers(nifNode, node, composite, args.mBoundTextures, args.mAnimFlags);
@@ -1070,7 +1140,7 @@ namespace NifOsg
             if (!mImageManager)
                 return nullptr;
 
-            return mImageManager->getImage(
+            return mImageManager->getStreamedImage(
                 VFS::Path::toNormalized(Misc::ResourceHelpers::correctTexturePath(path, mImageManager->getVFS())));
         }
 
@@ -1173,7 +1243,7 @@ namespace NifOsg
             osg::Group* attachTo, osgParticle::ParticleSystem* partsys,
             osgParticle::ParticleProcessor::ReferenceFrame rf) const
         {
-            osgParticle::ModularProgram* program = new osgParticle::ModularProgram;
+            ParticleProgram* program = new ParticleProgram;
             attachTo->addChild(program);
             program->setParticleSystem(partsys);
             program->setReferenceFrame(rf);
@@ -1467,13 +1537,31 @@ namespace NifOsg
                     });
         }
 
-        void handleNiGeometryData(const Nif::NiAVObject* nifNode, const Nif::Parent* parent, osg::Geometry* geometry,
-            osg::Node* parentNode, SceneUtil::CompositeStateSetUpdater* composite,
-            const std::vector<unsigned int>& boundTextures, int animflags)
+        // Partitioned geometry is checked for being empty once it's built
+        static bool hasNiGeometryData(const Nif::NiGeometry* niGeometry)
         {
-            const Nif::NiGeometry* niGeometry = static_cast<const Nif::NiGeometry*>(nifNode);
             if (niGeometry->mData.empty())
-                return;
+                return false;
+            if (!niGeometry->mSkin.empty() && niGeometry->mSkin->getPartitions() != nullptr)
+                return true;
+
+            const Nif::NiGeometryData* niGeometryData = niGeometry->mData.getPtr();
+            if (niGeometry->recType == Nif::RC_NiTriShape || niGeometry->recType == Nif::RC_BSLODTriShape)
+                return !static_cast<const Nif::NiTriShapeData*>(niGeometryData)->mTriangles.empty();
+            if (niGeometry->recType == Nif::RC_NiTriStrips)
+            {
+                const auto& strips = static_cast<const Nif::NiTriStripsData*>(niGeometryData)->mStrips;
+                return std::any_of(strips.begin(), strips.end(), [](const auto& strip) { return strip.size() >= 3; });
+            }
+            if (niGeometry->recType == Nif::RC_NiLines)
+                return !static_cast<const Nif::NiLinesData*>(niGeometryData)->mLines.empty();
+            return true;
+        }
+
+        void handleNiGeometryData(const Nif::NiAVObject* nifNode, osg::Geometry* geometry,
+            const std::vector<unsigned int>& boundTextures) const
+        {
+            const Nif::NiGeometry* niGeometry = static_cast<const Nif::NiGeometry*>(nifNode);
 
             bool hasPartitions = false;
             if (!niGeometry->mSkin.empty())
@@ -1509,32 +1597,24 @@ namespace NifOsg
                 {
                     auto data = static_cast<const Nif::NiTriShapeData*>(niGeometryData);
                     const std::vector<unsigned short>& triangles = data->mTriangles;
-                    if (triangles.empty())
-                        return;
                     geometry->addPrimitiveSet(new osg::DrawElementsUShort(
                         osg::PrimitiveSet::TRIANGLES, static_cast<unsigned>(triangles.size()), triangles.data()));
                 }
                 else if (niGeometry->recType == Nif::RC_NiTriStrips)
                 {
                     auto data = static_cast<const Nif::NiTriStripsData*>(niGeometryData);
-                    bool hasGeometry = false;
                     for (const std::vector<unsigned short>& strip : data->mStrips)
                     {
                         if (strip.size() < 3)
                             continue;
                         geometry->addPrimitiveSet(new osg::DrawElementsUShort(
                             osg::PrimitiveSet::TRIANGLE_STRIP, static_cast<unsigned>(strip.size()), strip.data()));
-                        hasGeometry = true;
                     }
-                    if (!hasGeometry)
-                        return;
                 }
                 else if (niGeometry->recType == Nif::RC_NiLines)
                 {
                     auto data = static_cast<const Nif::NiLinesData*>(niGeometryData);
                     const auto& line = data->mLines;
-                    if (line.empty())
-                        return;
                     geometry->addPrimitiveSet(new osg::DrawElementsUShort(
                         osg::PrimitiveSet::LINES, static_cast<unsigned>(line.size()), line.data()));
                 }
@@ -1570,6 +1650,22 @@ namespace NifOsg
                     new osg::Vec2Array(static_cast<unsigned>(uvlist[uvSet].size()), uvlist[uvSet].data()),
                     osg::Array::BIND_PER_VERTEX);
             }
+}
+
+            if (Loader::getOptimizeVertexCache() && niGeometry->recType != Nif::RC_NiLines)
+                optimizeVertexCache(*geometry);
+        }
+
+        void handleNiGeometry(const Nif::NiAVObject* nifNode, const Nif::Parent* parent, osg::Group* parentNode,
+            SceneUtil::CompositeStateSetUpdater* composite, const std::vector<unsigned int>& boundTextures,
+            int animflags)
+        {
+            assert(isTypeNiGeometry(nifNode->recType));
+
+            auto niGeometry = static_cast<const Nif::NiGeometry*>(nifNode);
+            // If the record had no valid geometry data in it, early-out
+            if (!hasNiGeometryData(niGeometry))
+                return;
 
             // osg::Material properties are handled here for two reasons:
             // - if there are no vertex colors, we need to disable colorMode.
@@ -1581,20 +1677,21 @@ namespace NifOsg
                 drawableProps.emplace_back(niGeometry->mShaderProperty.getPtr());
             if (!niGeometry->mAlphaProperty.empty())
                 drawableProps.emplace_back(niGeometry->mAlphaProperty.getPtr());
-            applyDrawableProperties(parentNode, drawableProps, composite, !niGeometryData->mColors.empty(), animflags);
+            applyDrawableProperties(
+                parentNode, drawableProps, composite, !niGeometry->mData->mColors.empty(), animflags);
+
+            addDrawable(parentNode, niGeometry->mData->mVertices.size(), [this, nifNode, boundTextures, animflags] {
+                return createNiGeometry(nifNode, boundTextures, animflags);
+            });
         }
 
-        void handleNiGeometry(const Nif::NiAVObject* nifNode, const Nif::Parent* parent, osg::Group* parentNode,
-            SceneUtil::CompositeStateSetUpdater* composite, const std::vector<unsigned int>& boundTextures,
-            int animflags)
+        osg::ref_ptr<osg::Drawable> createNiGeometry(
+            const Nif::NiAVObject* nifNode, const std::vector<unsigned int>& boundTextures, int animflags) const
         {
-            assert(isTypeNiGeometry(nifNode->recType));
-
             osg::ref_ptr<osg::Geometry> geom(new osg::Geometry);
-            handleNiGeometryData(nifNode, parent, geom, parentNode, composite, boundTextures, animflags);
-            // If the record had no valid geometry data in it, early-out
+            handleNiGeometryData(nifNode, geom, boundTextures);
             if (geom->empty())
-                return;
+                return nullptr;
 
             osg::ref_ptr<osg::Drawable> drawable = geom;
 
@@ -1665,20 +1762,37 @@ namespace NifOsg
             }
 
             drawable->setName(nifNode->mName);
-            parentNode->addChild(drawable);
+            return drawable;
         }
 
         void handleBSGeometry(const Nif::NiAVObject* nifNode, const Nif::Parent* parent, osg::Group* parentNode,
-            SceneUtil::CompositeStateSetUpdater* composite, const std::vector<unsigned int>& boundTextures,
-            int animflags)
+            SceneUtil::CompositeStateSetUpdater* composite, int animflags)
         {
             assert(isTypeBSGeometry(nifNode->recType));
 
             auto bsTriShape = static_cast<const Nif::BSTriShape*>(nifNode);
-            const std::vector<unsigned short>& triangles = bsTriShape->mTriangles;
-            if (triangles.empty())
+            if (bsTriShape->mTriangles.empty())
                 return;
 
+            const bool hasColors = bsTriShape->mVertDesc.mFlags & Nif::BSVertexDesc::VertexAttribute::Vertex_Colors;
+
+            std::vector<const Nif::NiProperty*> drawableProps;
+            collectDrawableProperties(nifNode, parent, drawableProps);
+            if (!bsTriShape->mShaderProperty.empty())
+                drawableProps.emplace_back(bsTriShape->mShaderProperty.getPtr());
+            if (!bsTriShape->mAlphaProperty.empty())
+                drawableProps.emplace_back(bsTriShape->mAlphaProperty.getPtr());
+            applyDrawableProperties(
+                parentNode, drawableProps, composite, hasColors && !bsTriShape->mVertData.empty(), animflags);
+
+            addDrawable(parentNode, bsTriShape->mVertData.size(), [nifNode] { return createBSGeometry(nifNode); });
+        }
+
+        static osg::ref_ptr<osg::Drawable> createBSGeometry(const Nif::NiAVObject* nifNode)
+        {
+            auto bsTriShape = static_cast<const Nif::BSTriShape*>(nifNode);
+            const std::vector<unsigned short>& triangles = bsTriShape->mTriangles;
+
             osg::ref_ptr<osg::Geometry> geometry(new osg::Geometry);
             geometry->addPrimitiveSet(new osg::DrawElementsUShort(
                 osg::PrimitiveSet::TRIANGLES, static_cast<unsigned>(triangles.size()), triangles.data()));
@@ -1793,16 +1907,53 @@ namespace NifOsg
                 drawable = rig;
             }
 
-            std::vector<const Nif::NiProperty*> drawableProps;
-            collectDrawableProperties(nifNode, parent, drawableProps);
-            if (!bsTriShape->mShaderProperty.empty())
-                drawableProps.emplace_back(bsTriShape->mShaderProperty.getPtr());
-            if (!bsTriShape->mAlphaProperty.empty())
-                drawableProps.emplace_back(bsTriShape->mAlphaProperty.getPtr());
-            applyDrawableProperties(parentNode, drawableProps, composite, !colors.empty(), animflags);
-
             drawable->setName(nifNode->mName);
-            parentNode->addChild(drawable);
+            return drawable;
+        }
+
+        void addDrawable(
+            osg::Group* parentNode, std::size_t numVertices, std::function<osg::ref_ptr<osg::Drawable>()> create)
+        {
+            if (!Loader::getParallelMeshBuilding())
+            {
+                if (osg::ref_ptr<osg::Drawable> drawable = create())
+                    parentNode->addChild(drawable);
+                return;
+            }
+            mDrawableQueue.push_back(
+                QueuedDrawable{ parentNode, parentNode->getNumChildren(), numVertices, std::move(create), nullptr });
+        }
+
+        void handleQueuedDrawables()
+        {
+            std::size_t numVertices = 0;
+            for (const QueuedDrawable& queued : mDrawableQueue)
+                numVertices += queued.mNumVertices;
+
+            std::atomic_size_t next = 0;
+            const auto create = [&] {
+                for (std::size_t i; (i = next++) < mDrawableQueue.size();)
+                    mDrawableQueue[i].mDrawable = mDrawableQueue[i].mCreate();
+            };
+
+            {
+                // Starting threads costs more than building a few small shapes
+                const std::size_t threads = numVertices < sMinParallelVertices
+                    ? 1
+                    : std::min<std::size_t>(mDrawableQueue.size(), std::max(1U, std::thread::hardware_concurrency()));
+                std::vector<std::future<void>> tasks;
+                for (std::size_t i = 1; i < threads; ++i)
+                    tasks.push_back(std::async(std::launch::async, create));
+                create();
+                for (std::future<void>& task : tasks)
+                    task.get();
+            }
+
+            // Insert in reverse to keep the indices taken before the preceding drawables were added valid
+            for (auto it = mDrawableQueue.rbegin(); it != mDrawableQueue.rend(); ++it)
+                if (it->mDrawable != nullptr)
+                    it->mParentNode->insertChild(it->mIndex, it->mDrawable);
+            mDrawableQueue.clear();
         }
 
         osg::BlendFunc::BlendFuncMode getBlendMode(int mode) const
@@ -58,11 +58,25 @@ namespace NifOsg
         static void setSoftEffectEnabled(bool enabled);
         static bool getSoftEffectEnabled();
 
+        /// Set whether the drawables of a file should be built on several threads once its node hierarchy is
+        /// created. The resulting scene graph is the same either way.
+        /// Default: false.
+        static void setParallelMeshBuilding(bool enabled);
+        static bool getParallelMeshBuilding();
+
+        /// Set whether the triangles of every shape should be reordered for the post-transform vertex cache when
+        /// it is created. Vertices are left where they are, so skinning and morphing are not affected.
+        /// Default: false.
+        static void setOptimizeVertexCache(bool enabled);
+        static bool getOptimizeVertexCache();
+
     private:
         static unsigned int sHiddenNodeMask;
         static unsigned int sIntersectionDisabledNodeMask;
         static bool sShowMarkers;
         static bool sSoftEffectEnabled;
+        static bool sParallelMeshBuilding;
+        static bool sOptimizeVertexCache;
     };
 
 }
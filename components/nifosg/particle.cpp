@@ -1,5 +1,7 @@
 #include "particle.hpp"
 
+#include <algorithm>
+#include <cmath>
 #include <limits>
 #include <optional>
 
@@ -100,6 +102,95 @@ namespace
 namespace NifOsg
 {
 
+    void ParticleBatch::gather(osgParticle::ParticleSystem& partsys)
+    {
+        mParticles.clear();
+        const int count = partsys.numParticles();
+        for (int i = 0; i < count; ++i)
+        {
+            osgParticle::Particle* const particle = partsys.getParticle(i);
+            if (particle->isAlive())
+                mParticles.push_back(particle);
+        }
+
+        const std::size_t size = mParticles.size();
+        for (std::vector<float>* values : { &mPositionX, &mPositionY, &mPositionZ, &mVelocityX, &mVelocityY,
+                 &mVelocityZ, &mAge, &mLifeTime, &mSize, &mColorR, &mColorG, &mColorB, &mAlpha })
+            values->resize(size);
+
+        for (std::size_t i = 0; i < size; ++i)
+        {
+            const osgParticle::Particle& particle = *mParticles[i];
+            const osg::Vec3& position = particle.getPosition();
+            mPositionX[i] = position.x();
+            mPositionY[i] = position.y();
+            mPositionZ[i] = position.z();
+            const osg::Vec3& velocity = particle.getVelocity();
+            mVelocityX[i] = velocity.x();
+            mVelocityY[i] = velocity.y();
+            mVelocityZ[i] = velocity.z();
+            mAge[i] = static_cast<float>(particle.getAge());
+            mLifeTime[i] = static_cast<float>(particle.getLifeTime());
+        }
+
+        mVelocityChanged = false;
+        mSizeChanged = false;
+        mColorChanged = false;
+    }
+
+    void ParticleBatch::scatter() const
+    {
+        if (!mVelocityChanged && !mSizeChanged && !mColorChanged)
+            return;
+
+        for (std::size_t i = 0, n = size(); i < n; ++i)
+        {
+            osgParticle::Particle& particle = *mParticles[i];
+            if (mVelocityChanged)
+                particle.setVelocity(osg::Vec3f(mVelocityX[i], mVelocityY[i], mVelocityZ[i]));
+            if (mSizeChanged)
+                particle.setSizeRange(osgParticle::rangef(mSize[i], mSize[i]));
+            if (mColorChanged)
+            {
+                const osg::Vec4f color(mColorR[i], mColorG[i], mColorB[i], 1.0f);
+                particle.setColorRange(osgParticle::rangev4(color, color));
+                particle.setAlphaRange(osgParticle::rangef(mAlpha[i], mAlpha[i]));
+            }
+        }
+    }
+
+    ParticleProgram::ParticleProgram(const ParticleProgram& copy, const osg::CopyOp& copyop)
+        : osgParticle::ModularProgram(copy, copyop)
+    {
+    }
+
+    void ParticleProgram::execute(double dt)
+    {
+        const int count = numOperators();
+        for (int i = 0; i < count; ++i)
+        {
+            const osgParticle::Operator* const op = getOperator(i);
+            if (op->isEnabled() && dynamic_cast<const BatchOperator*>(op) == nullptr)
+            {
+                osgParticle::ModularProgram::execute(dt);
+                return;
+            }
+        }
+
+        mBatch.gather(*getParticleSystem());
+
+        for (int i = 0; i < count; ++i)
+        {
+            osgParticle::Operator* const op = getOperator(i);
+            op->beginOperate(this);
+            if (op->isEnabled())
+                dynamic_cast<BatchOperator*>(op)->operateBatch(mBatch, static_cast<float>(dt));
+            op->endOperate();
+        }
+
+        mBatch.scatter();
+    }
+
     ParticleSystem::ParticleSystem()
         : osgParticle::ParticleSystem()
         , mQuota(std::numeric_limits<int>::max())
@@ -253,6 +344,31 @@ namespace NifOsg
         particle->setSizeRange(osgParticle::rangef(size, size));
     }
 
+    void GrowFadeAffector::operateBatch(ParticleBatch& batch, float /* dt */)
+    {
+        const std::size_t count = batch.size();
+        const float* const age = batch.mAge.data();
+        const float* const lifeTime = batch.mLifeTime.data();
+        float* const size = batch.mSize.data();
+        const float defaultSize = mCachedDefaultSize;
+        const float growTime = mGrowTime;
+        const float fadeTime = mFadeTime;
+        const bool grow = growTime != 0.f;
+        const bool fade = fadeTime != 0.f;
+
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            float value = defaultSize;
+            if (grow)
+                value *= std::min(age[i] / growTime, 1.f);
+            if (fade)
+                value *= std::min((lifeTime[i] - age[i]) / fadeTime, 1.f);
+            size[i] = value;
+        }
+
+        batch.mSizeChanged = true;
+    }
+
     ParticleColorAffector::ParticleColorAffector(const Nif::NiColorData* clrdata)
         : mData(clrdata->mKeyMap, osg::Vec4f(1, 1, 1, 1))
     {
@@ -278,6 +394,21 @@ namespace NifOsg
         particle->setAlphaRange(osgParticle::rangef(alpha, alpha));
     }
 
+    void ParticleColorAffector::operateBatch(ParticleBatch& batch, float /* dt */)
+    {
+        for (std::size_t i = 0, n = batch.size(); i < n; ++i)
+        {
+            assert(batch.mLifeTime[i] > 0);
+            const osg::Vec4f color = mData.interpKey(batch.mAge[i] / batch.mLifeTime[i]);
+            batch.mColorR[i] = color.r();
+            batch.mColorG[i] = color.g();
+            batch.mColorB[i] = color.b();
+            batch.mAlpha[i] = color.a();
+        }
+
+        batch.mColorChanged = true;
+    }
+
     GravityAffector::GravityAffector(const Nif::NiGravity* gravity)
         : mForce(gravity->mForce)
         , mType(gravity->mType)
@@ -346,6 +477,72 @@ namespace NifOsg
         }
     }
 
+    void GravityAffector::operateBatch(ParticleBatch& batch, float dt)
+    {
+        const float magic = 1.6f;
+        const std::size_t count = batch.size();
+        const float* const positionX = batch.mPositionX.data();
+        const float* const positionY = batch.mPositionY.data();
+        const float* const positionZ = batch.mPositionZ.data();
+        float* const velocityX = batch.mVelocityX.data();
+        float* const velocityY = batch.mVelocityY.data();
+        float* const velocityZ = batch.mVelocityZ.data();
+        const float scale = mForce * dt * magic;
+        const float decay = mDecay;
+        const osg::Vec3f direction = mCachedWorldDirection;
+        const osg::Vec3f position = mCachedWorldPosition;
+
+        switch (mType)
+        {
+            case Nif::ForceType::Wind:
+            {
+                if (decay == 0.f)
+                {
+                    const osg::Vec3f delta = direction * scale;
+                    for (std::size_t i = 0; i < count; ++i)
+                    {
+                        velocityX[i] += delta.x();
+                        velocityY[i] += delta.y();
+                        velocityZ[i] += delta.z();
+                    }
+                    break;
+                }
+
+                // Distance to the gravity plane
+                const float planeOffset = -(direction * position);
+                for (std::size_t i = 0; i < count; ++i)
+                {
+                    const float distance = std::abs(direction.x() * positionX[i] + direction.y() * positionY[i]
+                        + direction.z() * positionZ[i] + planeOffset);
+                    const float factor = scale * std::exp(-decay * distance);
+                    velocityX[i] += direction.x() * factor;
+                    velocityY[i] += direction.y() * factor;
+                    velocityZ[i] += direction.z() * factor;
+                }
+                break;
+            }
+            case Nif::ForceType::Point:
+            {
+                for (std::size_t i = 0; i < count; ++i)
+                {
+                    const float diffX = position.x() - positionX[i];
+                    const float diffY = position.y() - positionY[i];
+                    const float diffZ = position.z() - positionZ[i];
+                    const float length = std::sqrt(diffX * diffX + diffY * diffY + diffZ * diffZ);
+                    float factor = length > 0.f ? scale / length : 0.f;
+                    if (decay != 0.f)
+                        factor *= std::exp(-decay * length);
+                    velocityX[i] += diffX * factor;
+                    velocityY[i] += diffY * factor;
+                    velocityZ[i] += diffZ * factor;
+                }
+                break;
+            }
+        }
+
+        batch.mVelocityChanged = true;
+    }
+
     ParticleBomb::ParticleBomb(const Nif::NiParticleBomb* bomb)
         : mRange(bomb->mRange)
         , mStrength(bomb->mStrength)
@@ -670,6 +867,48 @@ namespace NifOsg
         particle->setVelocity(reflectedVelocity);
     }
 
+    void PlanarCollider::operateBatch(ParticleBatch& batch, float /* dt */)
+    {
+        const std::size_t count = batch.size();
+        const float* const positionX = batch.mPositionX.data();
+        const float* const positionY = batch.mPositionY.data();
+        const float* const positionZ = batch.mPositionZ.data();
+        float* const velocityX = batch.mVelocityX.data();
+        float* const velocityY = batch.mVelocityY.data();
+        float* const velocityZ = batch.mVelocityZ.data();
+        const osg::Vec3f normal = mPlaneInParticleSpace.getNormal();
+        const float planeOffset = static_cast<float>(mPlaneInParticleSpace[3]);
+        const osg::Vec3f origin = mPositionInParticleSpace;
+        const osg::Vec3f xVector = mXVectorInParticleSpace;
+        const osg::Vec3f yVector = mYVectorInParticleSpace;
+        const float halfX = mExtents.x() * 0.5f;
+        const float halfY = mExtents.y() * 0.5f;
+        const float bounceFactor = mBounceFactor;
+
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            const float velDotProduct
+                = velocityX[i] * normal.x() + velocityY[i] * normal.y() + velocityZ[i] * normal.z();
+            const float distance
+                = positionX[i] * normal.x() + positionY[i] * normal.y() + positionZ[i] * normal.z() + planeOffset;
+            const float relativeX = positionX[i] - origin.x();
+            const float relativeY = positionY[i] - origin.y();
+            const float relativeZ = positionZ[i] - origin.z();
+            const float xDotProduct = relativeX * xVector.x() + relativeY * xVector.y() + relativeZ * xVector.z();
+            const float yDotProduct = relativeX * yVector.x() + relativeY * yVector.y() + relativeZ * yVector.z();
+            // Moves towards the collider, intersects its plane and is inside its bounds
+            const bool deflect = velDotProduct > 0 && distance > 0 && xDotProduct >= -halfX && xDotProduct <= halfX
+                && yDotProduct >= -halfY && yDotProduct <= halfY;
+            const float offset = deflect ? 2 * velDotProduct : 0.f;
+            const float factor = deflect ? bounceFactor : 1.f;
+            velocityX[i] = (velocityX[i] - normal.x() * offset) * factor;
+            velocityY[i] = (velocityY[i] - normal.y() * offset) * factor;
+            velocityZ[i] = (velocityZ[i] - normal.z() * offset) * factor;
+        }
+
+        batch.mVelocityChanged = true;
+    }
+
     SphericalCollider::SphericalCollider(const Nif::NiSphericalCollider* collider)
         : mBounceFactor(collider->mBounceFactor)
         , mSphere(collider->mCenter, collider->mRadius)
@@ -738,4 +977,49 @@ namespace NifOsg
         }
     }
 
+    void SphericalCollider::operateBatch(ParticleBatch& batch, float dt)
+    {
+        const std::size_t count = batch.size();
+        const float* const positionX = batch.mPositionX.data();
+        const float* const positionY = batch.mPositionY.data();
+        const float* const positionZ = batch.mPositionZ.data();
+        float* const velocityX = batch.mVelocityX.data();
+        float* const velocityY = batch.mVelocityY.data();
+        float* const velocityZ = batch.mVelocityZ.data();
+        const osg::Vec3f center = mSphereInParticleSpace.center();
+        const float radius2 = mSphereInParticleSpace.radius2();
+        const float bounceFactor = mBounceFactor;
+
+        // Same as operate, see the comments there
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            const osg::Vec3f cent(positionX[i] - center.x(), positionY[i] - center.y(), positionZ[i] - center.z());
+            const osg::Vec3f velocity(velocityX[i], velocityY[i], velocityZ[i]);
+            const float centDotVelocity = cent * velocity;
+            const bool insideSphere = cent.length2() <= radius2;
+            if (!insideSphere && centDotVelocity >= 0.0f)
+                continue;
+
+            const float velocityLength2 = velocity.length2();
+            const float b = -centDotVelocity / velocityLength2;
+            const osg::Vec3f u = cent + velocity * b;
+            if (!insideSphere && u.length2() >= radius2)
+                continue;
+
+            const float d = (radius2 - u.length2()) / velocityLength2;
+            const float k = insideSphere ? (std::sqrt(d) + b) : (b - std::sqrt(d));
+            if (!(k < dt))
+                continue;
+
+            osg::Vec3f normal = cent + velocity * k;
+            normal.normalize();
+            const osg::Vec3f reflectedVelocity = (velocity - normal * (2 * (velocity * normal))) * bounceFactor;
+            velocityX[i] = reflectedVelocity.x();
+            velocityY[i] = reflectedVelocity.y();
+            velocityZ[i] = reflectedVelocity.z();
+        }
+
+        batch.mVelocityChanged = true;
+    }
+
 }
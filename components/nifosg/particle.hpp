@@ -1,10 +1,13 @@
 #ifndef OPENMW_COMPONENTS_NIFOSG_PARTICLE_H
 #define OPENMW_COMPONENTS_NIFOSG_PARTICLE_H
 
+#include <cstddef>
 #include <optional>
+#include <vector>
 
 #include <osgParticle/Counter>
 #include <osgParticle/Emitter>
+#include <osgParticle/ModularProgram>
 #include <osgParticle/Operator>
 #include <osgParticle/Particle>
 #include <osgParticle/Placer>
@@ -44,6 +47,63 @@ namespace NifOsg
         osg::ref_ptr<osg::Vec3Array> mNormalArray;
     };
 
+    // Structure of arrays holding the state of alive particles used by the NIF particle operators. Operators update
+    // all particles of a system at once with loops over contiguous arrays simple enough for the compiler to vectorise.
+    struct ParticleBatch
+    {
+        std::vector<osgParticle::Particle*> mParticles;
+        std::vector<float> mPositionX;
+        std::vector<float> mPositionY;
+        std::vector<float> mPositionZ;
+        std::vector<float> mVelocityX;
+        std::vector<float> mVelocityY;
+        std::vector<float> mVelocityZ;
+        std::vector<float> mAge;
+        std::vector<float> mLifeTime;
+        std::vector<float> mSize;
+        std::vector<float> mColorR;
+        std::vector<float> mColorG;
+        std::vector<float> mColorB;
+        std::vector<float> mAlpha;
+        bool mVelocityChanged = false;
+        bool mSizeChanged = false;
+        bool mColorChanged = false;
+
+        std::size_t size() const { return mParticles.size(); }
+
+        void gather(osgParticle::ParticleSystem& partsys);
+
+        // Writes changed values back to the particles
+        void scatter() const;
+    };
+
+    // Operator able to update a whole ParticleBatch, must give the same result as osgParticle::Operator::operate
+    class BatchOperator
+    {
+    public:
+        virtual void operateBatch(ParticleBatch& batch, float dt) = 0;
+
+    protected:
+        ~BatchOperator() = default;
+    };
+
+    // ModularProgram updating particles through ParticleBatch when all enabled operators are BatchOperator.
+    // Otherwise falls back to the per particle osgParticle::Operator::operate.
+    class ParticleProgram : public osgParticle::ModularProgram
+    {
+    public:
+        ParticleProgram() = default;
+        ParticleProgram(const ParticleProgram& copy, const osg::CopyOp& copyop = osg::CopyOp::SHALLOW_COPY);
+
+        META_Object(NifOsg, ParticleProgram)
+
+    protected:
+        void execute(double dt) override;
+
+    private:
+        ParticleBatch mBatch;
+    };
+
     // HACK: Particle doesn't allow setting the initial age, but we need this for loading the particle system state
     class ParticleAgeSetter : public osgParticle::Particle
     {
@@ -98,7 +158,7 @@ namespace NifOsg
         float mLifetimeRandom;
     };
 
-    class PlanarCollider : public osgParticle::Operator
+    class PlanarCollider : public osgParticle::Operator, public BatchOperator
     {
     public:
         PlanarCollider(const Nif::NiPlanarCollider* collider);
@@ -109,6 +169,7 @@ namespace NifOsg
 
         void beginOperate(osgParticle::Program* program) override;
         void operate(osgParticle::Particle* particle, double dt) override;
+        void operateBatch(ParticleBatch& batch, float dt) override;
 
     private:
         float mBounceFactor{ 0.f };
@@ -119,7 +180,7 @@ namespace NifOsg
         osg::Plane mPlane, mPlaneInParticleSpace;
     };
 
-    class SphericalCollider : public osgParticle::Operator
+    class SphericalCollider : public osgParticle::Operator, public BatchOperator
     {
     public:
         SphericalCollider(const Nif::NiSphericalCollider* collider);
@@ -130,6 +191,7 @@ namespace NifOsg
 
         void beginOperate(osgParticle::Program* program) override;
         void operate(osgParticle::Particle* particle, double dt) override;
+        void operateBatch(ParticleBatch& batch, float dt) override;
 
     private:
         float mBounceFactor;
@@ -137,7 +199,7 @@ namespace NifOsg
         osg::BoundingSphere mSphereInParticleSpace;
     };
 
-    class GrowFadeAffector : public osgParticle::Operator
+    class GrowFadeAffector : public osgParticle::Operator, public BatchOperator
     {
     public:
         GrowFadeAffector(float growTime, float fadeTime);
@@ -150,6 +212,7 @@ namespace NifOsg
 
         void beginOperate(osgParticle::Program* program) override;
         void operate(osgParticle::Particle* particle, double dt) override;
+        void operateBatch(ParticleBatch& batch, float dt) override;
 
     private:
         float mGrowTime;
@@ -158,7 +221,7 @@ namespace NifOsg
         float mCachedDefaultSize;
     };
 
-    class ParticleColorAffector : public osgParticle::Operator
+    class ParticleColorAffector : public osgParticle::Operator, public BatchOperator
     {
     public:
         ParticleColorAffector(const Nif::NiColorData* clrdata);
@@ -170,12 +233,13 @@ namespace NifOsg
         META_Object(NifOsg, ParticleColorAffector)
 
         void operate(osgParticle::Particle* particle, double dt) override;
+        void operateBatch(ParticleBatch& batch, float dt) override;
 
     private:
         Vec4Interpolator mData;
     };
 
-    class GravityAffector : public osgParticle::Operator
+    class GravityAffector : public osgParticle::Operator, public BatchOperator
     {
     public:
         GravityAffector(const Nif::NiGravity* gravity);
@@ -187,6 +251,7 @@ namespace NifOsg
         META_Object(NifOsg, GravityAffector)
 
         void operate(osgParticle::Particle* particle, double dt) override;
+        void operateBatch(ParticleBatch& batch, float dt) override;
         void beginOperate(osgParticle::Program*) override;
 
     private:
@@ -1,5 +1,6 @@
 #include "bulletshapemanager.hpp"
 
+#include <cassert>
 #include <cstring>
 
 #include <osg/Drawable>
@@ -100,6 +101,7 @@ namespace Resource
         const VFS::Manager* vfs, SceneManager* sceneMgr, NifFileManager* nifFileManager, double expiryDelay)
         : ResourceManager(vfs, expiryDelay)
         , mInstanceCache(new MultiObjectCache)
+        , mScaledInstanceCache(new GenericObjectCache<std::pair<const BulletShape*, float>>)
         , mSceneManager(sceneMgr)
         , mNifFileManager(nifFileManager)
     {
@@ -179,6 +181,20 @@ namespace Resource
         return createInstance(name);
     }
 
+    osg::ref_ptr<BulletShapeInstance> BulletShapeManager::getScaledInstance(
+        osg::ref_ptr<const BulletShape> shape, float scale)
+    {
+        assert(!shape->isAnimated());
+        const std::pair<const BulletShape*, float> key(shape.get(), scale);
+        if (osg::ref_ptr<osg::Object> obj = mScaledInstanceCache->getRefFromObjectCache(key))
+            return static_cast<BulletShapeInstance*>(obj.get());
+
+        osg::ref_ptr<BulletShapeInstance> instance = makeInstance(std::move(shape));
+        instance->setLocalScaling(btVector3(scale, scale, scale));
+        mScaledInstanceCache->addEntryToObjectCache(key, instance.get());
+        return instance;
+    }
+
     osg::ref_ptr<BulletShapeInstance> BulletShapeManager::createInstance(VFS::Path::NormalizedView name)
     {
         if (osg::ref_ptr<const BulletShape> shape = getShape(name))
@@ -191,6 +207,7 @@ namespace Resource
         ResourceManager::updateCache(referenceTime);
 
         mInstanceCache->removeUnreferencedObjectsInCache();
+        mScaledInstanceCache->update(referenceTime, mExpiryDelay);
     }
 
     void BulletShapeManager::clearCache()
@@ -198,6 +215,7 @@ namespace Resource
         ResourceManager::clearCache();
 
         mInstanceCache->clear();
+        mScaledInstanceCache->clear();
     }
 
     void BulletShapeManager::reportStats(unsigned int frameNumber, osg::Stats* stats) const
@@ -5,7 +5,10 @@
 
 #include <components/vfs/pathutil.hpp>
 
+#include <utility>
+
 #include "bulletshape.hpp"
+#include "objectcache.hpp"
 #include "resourcemanager.hpp"
 
 namespace Resource
@@ -40,6 +43,11 @@ namespace Resource
         /// @note May return a null pointer if the object has no shape.
         osg::ref_ptr<BulletShapeInstance> getInstance(VFS::Path::NormalizedView name);
 
+        /// Get an instance of the shape with the given scale applied, shared by all users of the same shape and scale
+        /// instead of copying its compound shape for each of them.
+        /// @note The returned instance must not be modified, so it can't be used for animated shapes.
+        osg::ref_ptr<BulletShapeInstance> getScaledInstance(osg::ref_ptr<const BulletShape> shape, float scale);
+
         /// @see ResourceManager::updateCache
         void updateCache(double referenceTime) override;
 
@@ -51,6 +59,8 @@ namespace Resource
         osg::ref_ptr<BulletShapeInstance> createInstance(VFS::Path::NormalizedView name);
 
         osg::ref_ptr<MultiObjectCache> mInstanceCache;
+        // Keyed by the source shape, which is kept alive by the cached instance
+        osg::ref_ptr<GenericObjectCache<std::pair<const BulletShape*, float>>> mScaledInstanceCache;
         SceneManager* mSceneManager;
         NifFileManager* mNifFileManager;
     };
@@ -19,6 +19,8 @@ namespace Resource
         std::size_t mGet = 0;
         std::size_t mHit = 0;
         std::size_t mExpired = 0;
+        std::size_t mEvicted = 0;
+        std::size_t mContended = 0;
     };
 
     void addCacheStatsAttibutes(std::string_view prefix, std::vector<std::string>& out);
@@ -83,6 +83,34 @@ namespace Resource
             return result;
         }
 
+        VFS::Path::Normalized getModelPath(
+            const EsmLoader::EsmData& esmData, const VFS::Manager& vfs, const CellRef& cellRef)
+        {
+            VFS::Path::Normalized model(getModel(esmData, cellRef.mRefId, cellRef.mType));
+            if (model.empty())
+                return model;
+
+            if (cellRef.mType != ESM::REC_STAT)
+                model = Misc::ResourceHelpers::correctActorModelPath(model, &vfs);
+
+            constexpr VFS::Path::NormalizedView prefix("meshes");
+            return prefix / model;
+        }
+
+        bool isBulletObjectType(ESM::RecNameInts type)
+        {
+            switch (type)
+            {
+                case ESM::REC_ACTI:
+                case ESM::REC_CONT:
+                case ESM::REC_DOOR:
+                case ESM::REC_STAT:
+                    return true;
+                default:
+                    return false;
+            }
+        }
+
         template <class F>
         void forEachObject(const ESM::Cell& cell, const EsmLoader::EsmData& esmData, const VFS::Manager& vfs,
             Resource::BulletShapeManager& bulletShapeManager, ESM::ReadersCache& readers, F&& f)
@@ -93,18 +121,14 @@ namespace Resource
 
             for (CellRef& cellRef : cellRefs)
             {
-                VFS::Path::Normalized model(getModel(esmData, cellRef.mRefId, cellRef.mType));
+                const VFS::Path::Normalized model = getModelPath(esmData, vfs, cellRef);
                 if (model.empty())
                     continue;
 
-                if (cellRef.mType != ESM::REC_STAT)
-                    model = Misc::ResourceHelpers::correctActorModelPath(model, &vfs);
-
                 osg::ref_ptr<const Resource::BulletShape> shape = [&] {
                     try
                     {
-                        constexpr VFS::Path::NormalizedView prefix("meshes");
-                        return bulletShapeManager.getShape(prefix / model);
+                        return bulletShapeManager.getShape(model);
                     }
                     catch (const std::exception& e)
                     {
@@ -117,17 +141,8 @@ namespace Resource
                 if (shape == nullptr)
                     continue;
 
-                switch (cellRef.mType)
-                {
-                    case ESM::REC_ACTI:
-                    case ESM::REC_CONT:
-                    case ESM::REC_DOOR:
-                    case ESM::REC_STAT:
-                        f(BulletObject{ std::move(shape), cellRef.mPos, cellRef.mScale });
-                        break;
-                    default:
-                        break;
-                }
+                if (isBulletObjectType(cellRef.mType))
+                    f(BulletObject{ std::move(shape), cellRef.mPos, cellRef.mScale });
             }
         }
     }
@@ -158,4 +173,27 @@ namespace Resource
                              << " objects";
         }
     }
+
+    std::vector<VFS::Path::Normalized> getBulletObjectModels(
+        ESM::ReadersCache& readers, const VFS::Manager& vfs, const EsmLoader::EsmData& esmData)
+    {
+        std::vector<VFS::Path::Normalized> result;
+
+        for (const ESM::Cell& cell : esmData.mCells)
+        {
+            for (const CellRef& cellRef : loadCellRefs(cell, esmData, readers))
+            {
+                if (!isBulletObjectType(cellRef.mType))
+                    continue;
+                VFS::Path::Normalized model = getModelPath(esmData, vfs, cellRef);
+                if (!model.empty())
+                    result.push_back(std::move(model));
+            }
+        }
+
+        std::sort(result.begin(), result.end());
+        result.erase(std::unique(result.begin(), result.end()), result.end());
+
+        return result;
+    }
 }
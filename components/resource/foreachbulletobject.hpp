@@ -3,6 +3,7 @@
 
 #include <components/esm/position.hpp>
 #include <components/resource/bulletshape.hpp>
+#include <components/vfs/pathutil.hpp>
 
 #include <osg/ref_ptr>
 
@@ -42,6 +43,10 @@ namespace Resource
     void forEachBulletObject(ESM::ReadersCache& readers, const VFS::Manager& vfs,
         Resource::BulletShapeManager& bulletShapeManager, const EsmLoader::EsmData& esmData,
         std::function<void(const ESM::Cell&, const BulletObject& object)> callback);
+
+    // Returns sorted unique paths of the models forEachBulletObject loads shapes for
+    std::vector<VFS::Path::Normalized> getBulletObjectModels(
+        ESM::ReadersCache& readers, const VFS::Manager& vfs, const EsmLoader::EsmData& esmData);
 }
 
 #endif
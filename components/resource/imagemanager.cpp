@@ -1,15 +1,20 @@
 #include "imagemanager.hpp"
 
+#include <algorithm>
 #include <cassert>
+#include <cstring>
+
 #include <osgDB/Registry>
 
 #include <components/debug/debuglog.hpp>
 #include <components/misc/pathhelpers.hpp>
 #include <components/sceneutil/glextensions.hpp>
+#include <components/sceneutil/workqueue.hpp>
 #include <components/vfs/manager.hpp>
 #include <components/vfs/pathutil.hpp>
 
 #include "objectcache.hpp"
+#include "texturecache.hpp"
 
 #ifdef OSG_LIBRARY_STATIC
 // This list of plugins should match with the list in the top-level CMakelists.txt.
@@ -42,6 +47,31 @@ namespace
         return warningImage;
     }
 
+    unsigned computeLevelSize(const osg::Image& image, unsigned level)
+    {
+        const int width = std::max(image.s() >> level, 1);
+        const int height = std::max(image.t() >> level, 1);
+        return osg::Image::computeImageSizeInBytes(
+            width, height, 1, image.getPixelFormat(), image.getDataType(), image.getPacking());
+    }
+
+    // Levels can only be dropped from images with all of them stored one after another
+    bool isStreamable(const osg::Image& image)
+    {
+        return image.r() == 1 && image.isDataContiguous() && image.getRowLength() == 0
+            && static_cast<int>(image.getNumMipmapLevels())
+            == osg::Image::computeNumberOfMipmapLevels(image.s(), image.t());
+    }
+
+    unsigned getResidentBaseLevel(const osg::Image& image, unsigned maxSize)
+    {
+        unsigned level = 0;
+        while (static_cast<unsigned>(std::max(image.s(), image.t()) >> level) > maxSize
+            && level + 1 < image.getNumMipmapLevels())
+            ++level;
+        return level;
+    }
+
 }
 
 namespace Resource
@@ -55,7 +85,7 @@ namespace Resource
     {
     }
 
-    ImageManager::~ImageManager() {}
+    ImageManager::~ImageManager() = default;
 
     bool checkSupported(osg::Image* image)
     {
@@ -78,6 +108,14 @@ namespace Resource
                 }
                 break;
             }
+            case (GL_COMPRESSED_RED_GREEN_RGTC2_EXT):
+            {
+                if (!SceneUtil::glExtensionsReady())
+                    return true;
+                if (!SceneUtil::getGLExtensions().isTextureCompressionRGTCSupported)
+                    return false;
+                break;
+            }
             // not bothering with checks for other compression formats right now
             default:
                 return true;
@@ -90,105 +128,219 @@ namespace Resource
         osg::ref_ptr<osg::Object> obj = mCache->getRefFromObjectCache(path);
         if (obj)
             return osg::ref_ptr<osg::Image>(static_cast<osg::Image*>(obj.get()));
-        else
+
+        osg::ref_ptr<osg::Image> image = loadImage(path, disableFlip);
+        if (image == nullptr)
+            image = mWarningImage;
+        mCache->addEntryToObjectCache(path.value(), image);
+        return image;
+    }
+
+    osg::ref_ptr<osg::Image> ImageManager::getStreamedImage(VFS::Path::NormalizedView path)
+    {
+        if (mStreamedImageSize == 0)
+            return getImage(path);
+
+        // Paths don't contain this, so the key doesn't collide with the ones of getImage
+        const std::string key = std::string(path.value()) + '\0' + "streamed";
+        osg::ref_ptr<osg::Object> obj = mCache->getRefFromObjectCache(key);
+        if (obj)
+            return osg::ref_ptr<osg::Image>(static_cast<osg::Image*>(obj.get()));
+
+        osg::ref_ptr<osg::Image> image = loadImage(path, false);
+        if (image == nullptr)
+            image = mWarningImage;
+        else if (isStreamable(*image))
         {
-            Files::IStreamPtr stream;
-            try
+            const unsigned baseLevel = getResidentBaseLevel(*image, mStreamedImageSize);
+            if (baseLevel > 0)
             {
-                stream = mVFS->get(path);
+                image = copyMipmapLevels(*image, baseLevel);
+                std::lock_guard<std::mutex> lock(mStreamedImagesMutex);
+                mStreamedImages.push_back(StreamedImage{ image, VFS::Path::Normalized(path), baseLevel });
             }
-            catch (std::exception& e)
+        }
+        mCache->addEntryToObjectCache(key, image);
+        return image;
+    }
+
+    osg::ref_ptr<osg::Image> ImageManager::loadMipmapLevels(VFS::Path::NormalizedView path, unsigned baseLevel)
+    {
+        osg::ref_ptr<osg::Image> image = loadImage(path, false);
+        if (image == nullptr || !isStreamable(*image) || baseLevel >= image->getNumMipmapLevels())
+            return nullptr;
+        if (baseLevel == 0)
+            return image;
+        return copyMipmapLevels(*image, baseLevel);
+    }
+
+    void ImageManager::enableTextureCache(const std::filesystem::path& path, std::uint64_t maxSize,
+        osg::ref_ptr<SceneUtil::WorkQueue> workQueue, std::string_view normalMapPattern,
+        std::string_view normalHeightMapPattern)
+    {
+        if (!SceneUtil::glExtensionsReady() || !SceneUtil::getGLExtensions().isTextureCompressionS3TCSupported)
+        {
+            Log(Debug::Warning) << "Texture cache is disabled: S3TC texture compression is not supported";
+            return;
+        }
+        const bool rgtc = SceneUtil::getGLExtensions().isTextureCompressionRGTCSupported;
+        mTextureCache = std::make_unique<TextureCache>(
+            path, maxSize, std::move(workQueue), normalMapPattern, normalHeightMapPattern, rgtc);
+    }
+
+    std::vector<ImageManager::StreamedImage> ImageManager::takeStreamedImages()
+    {
+        std::vector<StreamedImage> result;
+        std::lock_guard<std::mutex> lock(mStreamedImagesMutex);
+        result.swap(mStreamedImages);
+        return result;
+    }
+
+    osg::ref_ptr<osg::Image> ImageManager::copyMipmapLevels(const osg::Image& image, unsigned baseLevel)
+    {
+        const unsigned numLevels = image.getNumMipmapLevels();
+        std::size_t size = 0;
+        for (unsigned level = baseLevel; level < numLevels; ++level)
+            size += computeLevelSize(image, level);
+
+        unsigned char* data = new unsigned char[size];
+        osg::Image::MipmapDataType offsets;
+        std::size_t offset = 0;
+        for (unsigned level = baseLevel; level < numLevels; ++level)
+        {
+            if (level != baseLevel)
+                offsets.push_back(static_cast<unsigned>(offset));
+            const std::size_t levelSize = computeLevelSize(image, level);
+            std::memcpy(data + offset, image.getMipmapData(level), levelSize);
+            offset += levelSize;
+        }
+
+        osg::ref_ptr<osg::Image> result = new osg::Image;
+        result->setFileName(image.getFileName());
+        result->setImage(std::max(image.s() >> baseLevel, 1), std::max(image.t() >> baseLevel, 1), 1,
+            image.getInternalTextureFormat(), image.getPixelFormat(), image.getDataType(), data,
+            osg::Image::USE_NEW_DELETE, image.getPacking());
+        result->setMipmapLevels(offsets);
+        return result;
+    }
+
+    osg::ref_ptr<osg::Image> ImageManager::loadImage(VFS::Path::NormalizedView path, bool disableFlip)
+    {
+        Files::IStreamPtr stream;
+        try
+        {
+            stream = mVFS->get(path);
+        }
+        catch (std::exception& e)
+        {
+            Log(Debug::Error) << "Failed to open image: " << e.what();
+            return nullptr;
+        }
+
+        const std::string ext(Misc::getFileExtension(path.value()));
+        osgDB::ReaderWriter* reader = osgDB::Registry::instance()->getReaderWriterForExtension(ext);
+        if (!reader)
+        {
+            Log(Debug::Error) << "Error loading " << path << ": no readerwriter for '" << ext << "' found";
+            return nullptr;
+        }
+
+        // DDS files are compressed already or use formats that are meant to stay uncompressed
+        std::string cacheKey;
+        if (mTextureCache != nullptr && ext != "dds")
+        {
+            try
             {
-                Log(Debug::Error) << "Failed to open image: " << e.what();
-                mCache->addEntryToObjectCache(path.value(), mWarningImage);
-                return mWarningImage;
+                cacheKey = mTextureCache->makeKey(path.value(), *stream);
             }
-
-            const std::string ext(Misc::getFileExtension(path.value()));
-            osgDB::ReaderWriter* reader = osgDB::Registry::instance()->getReaderWriterForExtension(ext);
-            if (!reader)
+            catch (const std::exception& e)
             {
-                Log(Debug::Error) << "Error loading " << path << ": no readerwriter for '" << ext << "' found";
-                mCache->addEntryToObjectCache(path.value(), mWarningImage);
-                return mWarningImage;
+                Log(Debug::Warning) << "Failed to look up " << path << " in texture cache: " << e.what();
             }
 
-            bool killAlpha = false;
-            if (reader->supportedExtensions().count("tga"))
+            if (!cacheKey.empty())
             {
-                // Morrowind ignores the alpha channel of 16bpp TGA files even when the header says not to
-                unsigned char header[18];
-                stream->read((char*)header, 18);
-                if (stream->gcount() != 18)
+                osg::ref_ptr<osg::Image> image = mTextureCache->read(cacheKey);
+                if (image != nullptr && checkSupported(image))
                 {
-                    Log(Debug::Error) << "Error loading " << path << ": couldn't read TGA header";
-                    mCache->addEntryToObjectCache(path.value(), mWarningImage);
-                    return mWarningImage;
+                    image->setFileName(std::string(path.value()));
+                    return image;
                 }
-                int type = header[2];
-                int depth;
-                if (type == 1 || type == 9)
-                    depth = header[7];
-                else
-                    depth = header[16];
-                int alphaBPP = header[17] & 0x0F;
-                killAlpha = depth == 16 && alphaBPP == 1;
-                stream->seekg(0);
             }
+        }
 
-            osgDB::ReaderWriter::ReadResult result
-                = reader->readImage(*stream, disableFlip ? mOptionsNoFlip : mOptions);
-            if (!result.success())
+        bool killAlpha = false;
+        if (reader->supportedExtensions().count("tga"))
+        {
+            // Morrowind ignores the alpha channel of 16bpp TGA files even when the header says not to
+            unsigned char header[18];
+            stream->read((char*)header, 18);
+            if (stream->gcount() != 18)
             {
-                Log(Debug::Error) << "Error loading " << path << ": " << result.message() << " code "
-                                  << result.status();
-                mCache->addEntryToObjectCache(path.value(), mWarningImage);
-                return mWarningImage;
+                Log(Debug::Error) << "Error loading " << path << ": couldn't read TGA header";
+                return nullptr;
             }
+            int type = header[2];
+            int depth;
+            if (type == 1 || type == 9)
+                depth = header[7];
+            else
+                depth = header[16];
+            int alphaBPP = header[17] & 0x0F;
+            killAlpha = depth == 16 && alphaBPP == 1;
+            stream->seekg(0);
+        }
 
-            osg::ref_ptr<osg::Image> image = result.getImage();
+        osgDB::ReaderWriter::ReadResult result = reader->readImage(*stream, disableFlip ? mOptionsNoFlip : mOptions);
+        if (!result.success())
+        {
+            Log(Debug::Error) << "Error loading " << path << ": " << result.message() << " code " << result.status();
+            return nullptr;
+        }
+
+        osg::ref_ptr<osg::Image> image = result.getImage();
 
-            image->setFileName(std::string(path.value()));
-            if (!checkSupported(image))
+        image->setFileName(std::string(path.value()));
+        if (!checkSupported(image))
+        {
+            static bool uncompress = (getenv("OPENMW_DECOMPRESS_TEXTURES") != nullptr);
+            if (!uncompress)
             {
-                static bool uncompress = (getenv("OPENMW_DECOMPRESS_TEXTURES") != nullptr);
-                if (!uncompress)
-                {
-                    Log(Debug::Error) << "Error loading " << path << ": no S3TC texture compression support installed";
-                    mCache->addEntryToObjectCache(path.value(), mWarningImage);
-                    return mWarningImage;
-                }
-                else
-                {
-                    // decompress texture in software if not supported by GPU
-                    // requires update to getColor() to be released with OSG 3.6
-                    osg::ref_ptr<osg::Image> newImage = new osg::Image;
-                    newImage->setFileName(image->getFileName());
-                    newImage->allocateImage(image->s(), image->t(), image->r(),
-                        image->isImageTranslucent() ? GL_RGBA : GL_RGB, GL_UNSIGNED_BYTE);
-                    for (int s = 0; s < image->s(); ++s)
-                        for (int t = 0; t < image->t(); ++t)
-                            for (int r = 0; r < image->r(); ++r)
-                                newImage->setColor(image->getColor(s, t, r), s, t, r);
-                    image = newImage;
-                }
+                Log(Debug::Error) << "Error loading " << path << ": no S3TC texture compression support installed";
+                return nullptr;
             }
-            else if (killAlpha)
+            else
             {
+                // decompress texture in software if not supported by GPU
+                // requires update to getColor() to be released with OSG 3.6
                 osg::ref_ptr<osg::Image> newImage = new osg::Image;
                 newImage->setFileName(image->getFileName());
-                newImage->allocateImage(image->s(), image->t(), image->r(), GL_RGB, GL_UNSIGNED_BYTE);
-                // OSG just won't write the alpha as there's nowhere to put it.
+                newImage->allocateImage(image->s(), image->t(), image->r(),
+                    image->isImageTranslucent() ? GL_RGBA : GL_RGB, GL_UNSIGNED_BYTE);
                 for (int s = 0; s < image->s(); ++s)
                     for (int t = 0; t < image->t(); ++t)
                         for (int r = 0; r < image->r(); ++r)
                             newImage->setColor(image->getColor(s, t, r), s, t, r);
                 image = newImage;
             }
-
-            mCache->addEntryToObjectCache(path.value(), image);
-            return image;
         }
+        else if (killAlpha)
+        {
+            osg::ref_ptr<osg::Image> newImage = new osg::Image;
+            newImage->setFileName(image->getFileName());
+            newImage->allocateImage(image->s(), image->t(), image->r(), GL_RGB, GL_UNSIGNED_BYTE);
+            // OSG just won't write the alpha as there's nowhere to put it.
+            for (int s = 0; s < image->s(); ++s)
+                for (int t = 0; t < image->t(); ++t)
+                    for (int r = 0; r < image->r(); ++r)
+                        newImage->setColor(image->getColor(s, t, r), s, t, r);
+            image = newImage;
+        }
+
+        if (!cacheKey.empty())
+            mTextureCache->compress(cacheKey, image);
+
+        return image;
     }
 
     osg::Image* ImageManager::getWarningImage()
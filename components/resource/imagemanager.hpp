@@ -9,13 +9,26 @@
 
 #include "resourcemanager.hpp"
 
+#include <cstdint>
+#include <filesystem>
+#include <memory>
+#include <mutex>
+#include <string_view>
+#include <vector>
+
 namespace osgDB
 {
     class Options;
 }
 
+namespace SceneUtil
+{
+    class WorkQueue;
+}
+
 namespace Resource
 {
+    class TextureCache;
 
     /// @brief Handles loading/caching of Images.
     /// @note May be used from any thread.
@@ -25,10 +38,50 @@ namespace Resource
         explicit ImageManager(const VFS::Manager* vfs, double expiryDelay);
         ~ImageManager();
 
+        struct StreamedImage
+        {
+            osg::ref_ptr<osg::Image> mImage;
+            VFS::Path::Normalized mPath;
+            /// The level of the complete image the resident levels start at
+            unsigned mBaseLevel;
+        };
+
         /// Create or retrieve an Image
         /// Returns the dummy image if the given image is not found.
         osg::ref_ptr<osg::Image> getImage(VFS::Path::NormalizedView path, bool disableFlip = false);
 
+        /// Create or retrieve an Image with only the mipmap levels up to the streamed image size resident, if it has
+        /// a complete mipmap chain and is larger than that. The other levels can be loaded with loadMipmapLevels.
+        /// @note Streamed images are cached separately from the ones returned by getImage, so these always have all
+        /// levels.
+        osg::ref_ptr<osg::Image> getStreamedImage(VFS::Path::NormalizedView path);
+
+        /// Load the image again, starting at the given mipmap level.
+        /// @return nullptr if the image can't be loaded or doesn't have that level, doesn't use the cache
+        osg::ref_ptr<osg::Image> loadMipmapLevels(VFS::Path::NormalizedView path, unsigned baseLevel);
+
+        /// @return the images returned by getStreamedImage with only part of their levels resident since the last
+        /// call
+        std::vector<StreamedImage> takeStreamedImages();
+
+        /// Set the size of the largest mipmap level resident for images returned by getStreamedImage, 0 disables
+        /// streaming.
+        /// @note Not thread safe, has to be called before images are loaded.
+        void setStreamedImageSize(unsigned size) { mStreamedImageSize = size; }
+
+        unsigned getStreamedImageSize() const { return mStreamedImageSize; }
+
+        /// Load block compressed versions of uncompressed images from a TextureCache at the given path. Images not
+        /// stored there yet are compressed on the work queue after loading them.
+        /// @param maxSize in bytes
+        /// @note Not thread safe, has to be called before images are loaded.
+        void enableTextureCache(const std::filesystem::path& path, std::uint64_t maxSize,
+            osg::ref_ptr<SceneUtil::WorkQueue> workQueue, std::string_view normalMapPattern,
+            std::string_view normalHeightMapPattern);
+
+        /// @return a copy of the image with its mipmap levels starting at the given one
+        static osg::ref_ptr<osg::Image> copyMipmapLevels(const osg::Image& image, unsigned baseLevel);
+
         osg::Image* getWarningImage();
 
         void reportStats(unsigned int frameNumber, osg::Stats* stats) const override;
@@ -37,6 +90,14 @@ namespace Resource
         osg::ref_ptr<osg::Image> mWarningImage;
         osg::ref_ptr<osgDB::Options> mOptions;
         osg::ref_ptr<osgDB::Options> mOptionsNoFlip;
+        unsigned mStreamedImageSize = 0;
+        std::unique_ptr<TextureCache> mTextureCache;
+
+        std::mutex mStreamedImagesMutex;
+        std::vector<StreamedImage> mStreamedImages;
+
+        /// @return nullptr if the image can't be loaded
+        osg::ref_ptr<osg::Image> loadImage(VFS::Path::NormalizedView path, bool disableFlip);
 
         ImageManager(const ImageManager&);
         void operator=(const ImageManager&);
@@ -0,0 +1,354 @@
+#include "meshcache.hpp"
+
+#include <osg/Drawable>
+#include <osg/NodeVisitor>
+#include <osg/StateSet>
+#include <osg/Texture>
+#include <osg/UserDataContainer>
+#include <osgDB/ObjectWrapper>
+#include <osgDB/Registry>
+
+#include <components/debug/debuglog.hpp>
+#include <components/files/hash.hpp>
+#include <components/misc/resourcehelpers.hpp>
+#include <components/nifosg/nifloader.hpp>
+#include <components/sceneutil/depth.hpp>
+#include <components/sceneutil/serialize.hpp>
+#include <components/vfs/pathutil.hpp>
+
+#include <algorithm>
+#include <array>
+#include <format>
+#include <fstream>
+#include <sstream>
+#include <tuple>
+#include <vector>
+
+namespace Resource
+{
+    namespace
+    {
+        // Increment when the way meshes are converted or stored changes
+        constexpr int meshCacheVersion = 1;
+
+        // Evict a bit more than needed to not scan the cache on every write once it is full
+        constexpr std::uint64_t sEvictRatio = 4;
+
+        bool isStorableClass(const osg::Object& object)
+        {
+            const std::string_view libraryName = object.libraryName();
+            const std::string_view className = object.className();
+            if (libraryName == "osg")
+                return true;
+            if (libraryName == "NifOsg")
+                return className == "MatrixTransform" || className == "Fog";
+            if (libraryName == "SceneUtil")
+                return className == "TextureType";
+            return false;
+        }
+
+        bool canStore(const osg::UserDataContainer* container)
+        {
+            if (container == nullptr)
+                return true;
+            if (!isStorableClass(*container) || container->getUserData() != nullptr)
+                return false;
+            for (unsigned i = 0; i < container->getNumUserObjects(); ++i)
+                if (!isStorableClass(*container->getUserObject(i)))
+                    return false;
+            return true;
+        }
+
+        bool canStore(const osg::StateAttribute& attribute)
+        {
+            if (!isStorableClass(attribute) || attribute.getUpdateCallback() != nullptr
+                || attribute.getEventCallback() != nullptr)
+                return false;
+            if (const osg::Texture* texture = attribute.asTexture())
+            {
+                for (unsigned i = 0; i < texture->getNumImages(); ++i)
+                {
+                    const osg::Image* image = texture->getImage(i);
+                    if (image == nullptr || image->getFileName().empty())
+                        return false;
+                }
+            }
+            return true;
+        }
+
+        bool canStore(const osg::StateSet* stateset)
+        {
+            if (stateset == nullptr)
+                return true;
+            if (stateset->getUpdateCallback() != nullptr || stateset->getEventCallback() != nullptr
+                || !canStore(stateset->getUserDataContainer()))
+                return false;
+            for (const auto& [_, attribute] : stateset->getAttributeList())
+                if (!canStore(*attribute.first))
+                    return false;
+            for (const osg::StateSet::AttributeList& attributes : stateset->getTextureAttributeList())
+                for (const auto& [_, attribute] : attributes)
+                    if (!canStore(*attribute.first))
+                        return false;
+            for (const auto& [_, uniform] : stateset->getUniformList())
+                if (!isStorableClass(*uniform.first) || uniform.first->getUpdateCallback() != nullptr)
+                    return false;
+            return true;
+        }
+
+        class CanStoreVisitor : public osg::NodeVisitor
+        {
+        public:
+            CanStoreVisitor()
+                : osg::NodeVisitor(TRAVERSE_ALL_CHILDREN)
+            {
+            }
+
+            void apply(osg::Node& node) override
+            {
+                if (!mResult)
+                    return;
+                if (!canStoreNode(node))
+                {
+                    mResult = false;
+                    return;
+                }
+                traverse(node);
+            }
+
+            void apply(osg::Drawable& drawable) override
+            {
+                if (!mResult)
+                    return;
+                // Rig and morph geometry would need their controllers and bone references stored as well
+                if (drawable.asGeometry() == nullptr || drawable.getDrawCallback() != nullptr
+                    || drawable.getComputeBoundingBoxCallback() != nullptr || !canStoreNode(drawable))
+                    mResult = false;
+            }
+
+            bool mResult = true;
+
+        private:
+            static bool canStoreNode(const osg::Node& node)
+            {
+                return isStorableClass(node) && node.getUpdateCallback() == nullptr
+                    && node.getCullCallback() == nullptr && node.getEventCallback() == nullptr
+                    && node.getComputeBoundingSphereCallback() == nullptr && canStore(node.getStateSet())
+                    && canStore(node.getUserDataContainer());
+            }
+        };
+
+        class CheckTexturePathsVisitor : public osg::NodeVisitor
+        {
+        public:
+            explicit CheckTexturePathsVisitor(const VFS::Manager& vfs)
+                : osg::NodeVisitor(TRAVERSE_ALL_CHILDREN)
+                , mVFS(vfs)
+            {
+            }
+
+            void apply(osg::Node& node) override
+            {
+                if (node.getStateSet() != nullptr)
+                    check(*node.getStateSet());
+                traverse(node);
+            }
+
+            bool mResult = true;
+
+        private:
+            const VFS::Manager& mVFS;
+
+            void check(const osg::StateSet& stateset)
+            {
+                for (const osg::StateSet::AttributeList& attributes : stateset.getTextureAttributeList())
+                {
+                    for (const auto& [_, attribute] : attributes)
+                    {
+                        const osg::Texture* texture = attribute.first->asTexture();
+                        if (texture == nullptr)
+                            continue;
+                        for (unsigned i = 0; i < texture->getNumImages(); ++i)
+                        {
+                            const osg::Image* image = texture->getImage(i);
+                            // An image that failed to load or a texture that resolves to another file now, for
+                            // example because a replacer with a different extension was added
+                            if (image == nullptr
+                                || VFS::Path::toNormalized(
+                                       Misc::ResourceHelpers::correctTexturePath(image->getFileName(), &mVFS))
+                                    != image->getFileName())
+                                mResult = false;
+                        }
+                    }
+                }
+            }
+        };
+    }
+
+    MeshCache::MeshCache(const std::filesystem::path& path, std::uint64_t maxSize, const VFS::Manager* vfs,
+        osg::ref_ptr<const osgDB::Options> readOptions)
+        : mPath(path)
+        , mMaxSize(maxSize)
+        , mVFS(vfs)
+        , mReadOptions(std::move(readOptions))
+        , mWriteOptions(new osgDB::Options)
+        , mReaderWriter(osgDB::Registry::instance()->getReaderWriterForExtension("osgb"))
+    {
+        if (mReaderWriter == nullptr)
+        {
+            Log(Debug::Warning) << "Mesh cache is disabled: no readerwriter for 'osgb' found";
+            return;
+        }
+
+        std::error_code ec;
+        std::filesystem::create_directories(mPath, ec);
+        if (ec)
+        {
+            Log(Debug::Warning) << "Mesh cache is disabled: failed to create " << mPath << ": " << ec.message();
+            mReaderWriter = nullptr;
+            return;
+        }
+
+        SceneUtil::registerNifSerializers();
+        mGeometryWrapper = osgDB::Registry::instance()->getObjectWrapperManager()->findWrapper("osg::Geometry");
+        // Texture images are read through the VFS by their file name instead of being stored with every mesh
+        mWriteOptions->setPluginStringData("WriteImageHint", "UseExternal");
+
+        for (const auto& entry : std::filesystem::directory_iterator(mPath, ec))
+            if (entry.path().extension() == ".osgb")
+                mSize += entry.file_size(ec);
+
+        Log(Debug::Info) << "Mesh cache uses " << mSize / (1024 * 1024) << " MiB of " << mMaxSize / (1024 * 1024)
+                         << " MiB";
+    }
+
+    std::string MeshCache::makeKey(std::string_view path, std::istream& source)
+    {
+        const std::array<std::uint64_t, 2> fileHash = Files::getHash(path, source);
+        std::istringstream stream(std::format("{}\n{}\n{:016x}{:016x}\n{} {} {} {} {} {}", meshCacheVersion,
+            path, fileHash[0], fileHash[1], NifOsg::Loader::getShowMarkers(), NifOsg::Loader::getHiddenNodeMask(),
+            NifOsg::Loader::getIntersectionDisabledNodeMask(), NifOsg::Loader::getSoftEffectEnabled(),
+            NifOsg::Loader::getOptimizeVertexCache(), SceneUtil::AutoDepth::isReversed()));
+        const std::array<std::uint64_t, 2> hash = Files::getHash("mesh", stream);
+        return std::format("{:016x}{:016x}", hash[0], hash[1]);
+    }
+
+    bool MeshCache::canStore(const osg::Node& node)
+    {
+        CanStoreVisitor visitor;
+        const_cast<osg::Node&>(node).accept(visitor);
+        return visitor.mResult;
+    }
+
+    bool MeshCache::isUsable() const
+    {
+        // Writing a scene for debugging replaces the osg::Geometry serializer with one that skips the vertex data
+        return mReaderWriter != nullptr
+            && osgDB::Registry::instance()->getObjectWrapperManager()->findWrapper("osg::Geometry")
+            == mGeometryWrapper;
+    }
+
+    osg::ref_ptr<osg::Node> MeshCache::read(std::string_view key)
+    {
+        if (!isUsable())
+            return nullptr;
+
+        const std::filesystem::path path = mPath / std::format("{}.osgb", key);
+        osgDB::ReaderWriter::ReadResult result;
+        {
+            std::ifstream stream(path, std::ios::binary);
+            if (!stream.is_open())
+                return nullptr;
+            result = mReaderWriter->readNode(stream, mReadOptions);
+        }
+
+        if (!result.success())
+        {
+            Log(Debug::Warning) << "Failed to read cached mesh " << key << ": " << result.message();
+            return nullptr;
+        }
+
+        osg::ref_ptr<osg::Node> node = result.getNode();
+        CheckTexturePathsVisitor checkTexturePathsVisitor(*mVFS);
+        node->accept(checkTexturePathsVisitor);
+        if (!checkTexturePathsVisitor.mResult)
+            return nullptr;
+
+        // AutoDepth is stored as osg::Depth
+        SceneUtil::ReplaceDepthVisitor replaceDepthVisitor;
+        node->accept(replaceDepthVisitor);
+
+        // Mark the entry as recently used for the eviction
+        std::error_code ec;
+        std::filesystem::last_write_time(path, std::filesystem::file_time_type::clock::now(), ec);
+
+        return node;
+    }
+
+    void MeshCache::write(std::string_view key, const osg::Node& node)
+    {
+        if (!isUsable())
+            return;
+
+        const std::filesystem::path path = mPath / std::format("{}.osgb", key);
+        // Write to a temporary file first to never read a partially written mesh
+        std::filesystem::path tmpPath = path;
+        tmpPath += ".tmp";
+
+        {
+            std::ofstream stream(tmpPath, std::ios::binary);
+            if (!stream.is_open())
+            {
+                Log(Debug::Warning) << "Failed to open " << tmpPath << " to cache mesh";
+                return;
+            }
+
+            const osgDB::ReaderWriter::WriteResult result = mReaderWriter->writeNode(node, stream, mWriteOptions);
+            if (!result.success())
+            {
+                Log(Debug::Warning) << "Failed to write cached mesh " << key << ": " << result.message();
+                return;
+            }
+        }
+
+        std::error_code ec;
+        std::filesystem::rename(tmpPath, path, ec);
+        if (ec)
+        {
+            Log(Debug::Warning) << "Failed to rename " << tmpPath << " to " << path << ": " << ec.message();
+            return;
+        }
+
+        const std::uint64_t size = std::filesystem::file_size(path, ec);
+        std::lock_guard<std::mutex> lock(mMutex);
+        mSize += ec ? 0 : size;
+        if (mSize > mMaxSize)
+            evict();
+    }
+
+    void MeshCache::evict()
+    {
+        std::vector<std::tuple<std::filesystem::file_time_type, std::uint64_t, std::filesystem::path>> entries;
+        std::error_code ec;
+        mSize = 0;
+        for (const auto& entry : std::filesystem::directory_iterator(mPath, ec))
+        {
+            if (entry.path().extension() != ".osgb")
+                continue;
+            const std::uint64_t size = entry.file_size(ec);
+            mSize += size;
+            entries.emplace_back(entry.last_write_time(ec), size, entry.path());
+        }
+
+        std::sort(entries.begin(), entries.end());
+
+        const std::uint64_t target = mMaxSize - mMaxSize / sEvictRatio;
+        for (const auto& [_, size, path] : entries)
+        {
+            if (mSize <= target)
+                break;
+            if (std::filesystem::remove(path, ec))
+                mSize -= size;
+        }
+    }
+}
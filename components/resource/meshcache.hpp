@@ -0,0 +1,73 @@
+#ifndef OPENMW_COMPONENTS_RESOURCE_MESHCACHE_H
+#define OPENMW_COMPONENTS_RESOURCE_MESHCACHE_H
+
+#include <osg/Node>
+#include <osg/ref_ptr>
+
+#include <cstdint>
+#include <filesystem>
+#include <istream>
+#include <mutex>
+#include <string>
+#include <string_view>
+
+namespace osgDB
+{
+    class ObjectWrapper;
+    class Options;
+    class ReaderWriter;
+}
+
+namespace VFS
+{
+    class Manager;
+}
+
+namespace Resource
+{
+    /// @brief Stores scene graphs converted from NIF files on disk to not parse and convert them again in the next
+    /// session.
+    /// @par Meshes are keyed by a hash of the file and the loader settings the conversion depends on, so changed
+    /// content results in a different key instead of reading a stale mesh. The least recently used entries are
+    /// removed once the cache grows beyond its size limit.
+    /// @par Only meshes that can be written and read back without losing anything are stored, see canStore.
+    /// @note Thread safe.
+    class MeshCache
+    {
+    public:
+        /// @param readOptions used to read the cached meshes, have to make the images referenced by them read from
+        /// the VFS
+        MeshCache(const std::filesystem::path& path, std::uint64_t maxSize, const VFS::Manager* vfs,
+            osg::ref_ptr<const osgDB::Options> readOptions);
+
+        /// @param source the file the mesh is converted from
+        static std::string makeKey(std::string_view path, std::istream& source);
+
+        /// @return true if the mesh contains nothing but osg classes and NifOsg classes with a serializer, no
+        /// callbacks, and no images that don't come from the VFS
+        static bool canStore(const osg::Node& node);
+
+        /// @return nullptr when there is no usable mesh for the key
+        osg::ref_ptr<osg::Node> read(std::string_view key);
+
+        void write(std::string_view key, const osg::Node& node);
+
+    private:
+        bool isUsable() const;
+
+        void evict();
+
+        std::filesystem::path mPath;
+        std::uint64_t mMaxSize;
+        const VFS::Manager* mVFS;
+        osg::ref_ptr<const osgDB::Options> mReadOptions;
+        osg::ref_ptr<osgDB::Options> mWriteOptions;
+        osgDB::ReaderWriter* mReaderWriter;
+        const osgDB::ObjectWrapper* mGeometryWrapper = nullptr;
+
+        std::mutex mMutex;
+        std::uint64_t mSize = 0;
+    };
+}
+
+#endif
@@ -6,6 +6,10 @@
 #include <components/vfs/pathutil.hpp>
 
 #include "objectcache.hpp"
+#include "shardedobjectcache.hpp"
+
+#include <cstddef>
+#include <string>
 
 namespace VFS
 {
@@ -26,20 +30,25 @@ namespace Resource
     public:
         virtual ~BaseResourceManager() = default;
         virtual void updateCache(double referenceTime) = 0;
+        /// Clear cache entries that have not been referenced for longer than the given delay instead of the configured
+        /// one. Ignored by managers without such a cache.
+        virtual void expireCache(double /*referenceTime*/, double /*expiryDelay*/) {}
         virtual void clearCache() = 0;
         virtual void setExpiryDelay(double expiryDelay) = 0;
         virtual void reportStats(unsigned int frameNumber, osg::Stats* stats) const = 0;
         virtual void releaseGLObjects(osg::State* state) = 0;
+        /// Limit number of cached items per cache shard, 0 means unlimited. Ignored by caches without eviction.
+        virtual void setCacheShardSizeLimit(std::size_t /*value*/) {}
     };
 
     /// @brief Base class for managers that require a virtual file system and object cache.
     /// @par This base class implements clearing of the cache, but populating it and what it's used for is up to the
     /// individual sub classes.
-    template <class KeyType>
+    template <class KeyType, class CacheT = GenericObjectCache<KeyType>>
     class GenericResourceManager : public BaseResourceManager
     {
     public:
-        typedef GenericObjectCache<KeyType> CacheType;
+        typedef CacheT CacheType;
 
         explicit GenericResourceManager(const VFS::Manager* vfs, double expiryDelay)
             : mVFS(vfs)
@@ -53,6 +62,11 @@ namespace Resource
         /// Clear cache entries that have not been referenced for longer than expiryDelay.
         void updateCache(double referenceTime) override { mCache->update(referenceTime, mExpiryDelay); }
 
+        void expireCache(double referenceTime, double expiryDelay) override
+        {
+            mCache->update(referenceTime, expiryDelay);
+        }
+
         /// Clear all cache entries.
         void clearCache() override { mCache->clear(); }
 
@@ -72,13 +86,19 @@ namespace Resource
         double mExpiryDelay;
     };
 
-    class ResourceManager : public GenericResourceManager<std::string>
+    /// @brief Resource manager keyed by normalized VFS path.
+    /// @par Uses a sharded cache since these managers are accessed concurrently by the main thread, the cell preloader
+    /// and object paging.
+    class ResourceManager
+        : public GenericResourceManager<std::string, ShardedObjectCache<std::string, VFS::Path::Hash>>
     {
     public:
         explicit ResourceManager(const VFS::Manager* vfs, double expiryDelay)
             : GenericResourceManager(vfs, expiryDelay)
         {
         }
+
+        void setCacheShardSizeLimit(std::size_t value) override { mCache->setMaxShardSize(value); }
     };
 
 }
@@ -81,6 +81,12 @@ namespace Resource
         mNifFileManager->setExpiryDelay(0.0);
     }
 
+    void ResourceSystem::setCacheShardSizeLimit(std::size_t value)
+    {
+        for (BaseResourceManager* manager : mResourceManagers)
+            manager->setCacheShardSizeLimit(value);
+    }
+
     void ResourceSystem::updateCache(double referenceTime)
     {
         for (std::vector<BaseResourceManager*>::iterator it = mResourceManagers.begin(); it != mResourceManagers.end();
@@ -88,6 +94,15 @@ namespace Resource
             (*it)->updateCache(referenceTime);
     }
 
+    void ResourceSystem::expireCache(double referenceTime, double expiryDelay)
+    {
+        for (BaseResourceManager* manager : mResourceManagers)
+            manager->expireCache(referenceTime, expiryDelay);
+
+        // Managers release what else they hold on to for the expired objects
+        updateCache(referenceTime);
+    }
+
     void ResourceSystem::clearCache()
     {
         for (std::vector<BaseResourceManager*>::iterator it = mResourceManagers.begin(); it != mResourceManagers.end();
@@ -1,6 +1,7 @@
 #ifndef OPENMW_COMPONENTS_RESOURCE_RESOURCESYSTEM_H
 #define OPENMW_COMPONENTS_RESOURCE_RESOURCESYSTEM_H
 
+#include <cstddef>
 #include <memory>
 #include <vector>
 
@@ -53,6 +54,10 @@ namespace Resource
         /// @note May be called from any thread if you do not add or remove resource managers at that point.
         void updateCache(double referenceTime);
 
+        /// Like updateCache, but with the given expiry delay instead of the configured ones, to free memory sooner.
+        /// @note May be called from any thread if you do not add or remove resource managers at that point.
+        void expireCache(double referenceTime, double expiryDelay);
+
         /// Indicates to each resource manager to clear the entire cache.
         /// @note May be called from any thread if you do not add or remove resource managers at that point.
         void clearCache();
@@ -67,6 +72,9 @@ namespace Resource
         /// How long to keep objects in cache after no longer being referenced.
         void setExpiryDelay(double expiryDelay);
 
+        /// Limit number of items kept per cache shard, least recently used items are evicted first. 0 means unlimited.
+        void setCacheShardSizeLimit(std::size_t value);
+
         /// @note May be called from any thread.
         const VFS::Manager* getVFS() const;
 
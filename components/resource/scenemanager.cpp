@@ -48,6 +48,7 @@
 #include <components/sceneutil/util.hpp>
 #include <components/sceneutil/visitor.hpp>
 
+#include <components/shader/asyncprogram.hpp>
 #include <components/shader/shadermanager.hpp>
 #include <components/shader/shadervisitor.hpp>
 
@@ -58,6 +59,7 @@
 #include "bgsmfilemanager.hpp"
 #include "errormarker.hpp"
 #include "imagemanager.hpp"
+#include "meshcache.hpp"
 #include "niffilemanager.hpp"
 #include "objectcache.hpp"
 
@@ -538,10 +540,11 @@ namespace Resource
     {
         mLightingMethod = method;
 
-        if (mLightingMethod == SceneUtil::LightingMethod::SingleUBO)
+        if (getUseUniformBuffers())
         {
             osg::ref_ptr<osg::Program> program = new osg::Program;
             program->addBindUniformBlock("LightBufferBinding", static_cast<int>(UBOBinding::LightBuffer));
+            program->addBindUniformBlock("SharedUniforms", static_cast<int>(UBOBinding::SharedUniforms));
             mShaderManager->setProgramTemplate(program);
         }
     }
@@ -551,6 +554,12 @@ namespace Resource
         return mLightingMethod;
     }
 
+    bool SceneManager::getUseUniformBuffers() const
+    {
+        return mLightingMethod == SceneUtil::LightingMethod::SingleUBO
+            || mLightingMethod == SceneUtil::LightingMethod::Clustered;
+    }
+
     void SceneManager::setConvertAlphaTestToAlphaToCoverage(bool convert)
     {
         mConvertAlphaTestToAlphaToCoverage = convert;
@@ -605,8 +614,9 @@ namespace Resource
     class ImageReadCallback : public osgDB::ReadFileCallback
     {
     public:
-        ImageReadCallback(Resource::ImageManager* imageMgr)
+        ImageReadCallback(Resource::ImageManager* imageMgr, bool streamed = false)
             : mImageManager(imageMgr)
+            , mStreamed(streamed)
         {
         }
 
@@ -619,8 +629,9 @@ namespace Resource
                 filePath = std::filesystem::relative(filename, osgDB::getCurrentWorkingDirectory());
             try
             {
+                const VFS::Path::Normalized path = VFS::Path::toNormalized(Files::pathToUnicodeString(filePath));
                 return osgDB::ReaderWriter::ReadResult(
-                    mImageManager->getImage(VFS::Path::toNormalized(Files::pathToUnicodeString(filePath))),
+                    mStreamed ? mImageManager->getStreamedImage(path) : mImageManager->getImage(path),
                     osgDB::ReaderWriter::ReadResult::FILE_LOADED);
             }
             catch (std::exception& e)
@@ -631,6 +642,7 @@ namespace Resource
 
     private:
         Resource::ImageManager* mImageManager;
+        bool mStreamed;
     };
 
     namespace
@@ -911,8 +923,9 @@ namespace Resource
     {
         using namespace SceneUtil;
         const char* env = getenv("OPENMW_OPTIMIZE");
-        unsigned int options
-            = Optimizer::FLATTEN_STATIC_TRANSFORMS | Optimizer::REMOVE_REDUNDANT_NODES | Optimizer::MERGE_GEOMETRY;
+        unsigned int options = Optimizer::FLATTEN_STATIC_TRANSFORMS | Optimizer::REMOVE_REDUNDANT_NODES
+            | Optimizer::INDEX_MESH | Optimizer::MERGE_GEOMETRY | Optimizer::VERTEX_POSTTRANSFORM
+            | Optimizer::VERTEX_PRETRANSFORM;
         if (env)
         {
             std::string str(env);
@@ -920,20 +933,25 @@ namespace Resource
             if (str.find("OFF") != std::string::npos || str.find('0') != std::string::npos)
                 options = 0;
 
-            if (str.find("~FLATTEN_STATIC_TRANSFORMS") != std::string::npos)
-                options ^= Optimizer::FLATTEN_STATIC_TRANSFORMS;
-            else if (str.find("FLATTEN_STATIC_TRANSFORMS") != std::string::npos)
-                options |= Optimizer::FLATTEN_STATIC_TRANSFORMS;
-
-            if (str.find("~REMOVE_REDUNDANT_NODES") != std::string::npos)
-                options ^= Optimizer::REMOVE_REDUNDANT_NODES;
-            else if (str.find("REMOVE_REDUNDANT_NODES") != std::string::npos)
-                options |= Optimizer::REMOVE_REDUNDANT_NODES;
+            static constexpr std::pair<std::string_view, unsigned int> names[] = {
+                { "FLATTEN_STATIC_TRANSFORMS", Optimizer::FLATTEN_STATIC_TRANSFORMS },
+                { "REMOVE_REDUNDANT_NODES", Optimizer::REMOVE_REDUNDANT_NODES },
+                { "INDEX_MESH", Optimizer::INDEX_MESH },
+                { "MERGE_GEOMETRY", Optimizer::MERGE_GEOMETRY },
+                { "VERTEX_POSTTRANSFORM", Optimizer::VERTEX_POSTTRANSFORM },
+                { "VERTEX_PRETRANSFORM", Optimizer::VERTEX_PRETRANSFORM },
+            };
 
-            if (str.find("~MERGE_GEOMETRY") != std::string::npos)
-                options ^= Optimizer::MERGE_GEOMETRY;
-            else if (str.find("MERGE_GEOMETRY") != std::string::npos)
-                options |= Optimizer::MERGE_GEOMETRY;
+            for (const auto& [name, option] : names)
+            {
+                const std::size_t pos = str.find(name);
+                if (pos == std::string::npos)
+                    continue;
+                if (pos > 0 && str[pos - 1] == '~')
+                    options &= ~option;
+                else
+                    options |= option;
+            }
         }
         return options;
     }
@@ -967,6 +985,28 @@ namespace Resource
         return loadNonNif(errorMarker, file, mImageManager);
     }
 
+    void SceneManager::enableMeshCache(const std::filesystem::path& path, std::uint64_t maxSize)
+    {
+        osg::ref_ptr<osgDB::Options> options(new osgDB::Options);
+        // Cached meshes are converted from NIF files, their textures are streamed the same way
+        options->setReadFileCallback(new ImageReadCallback(mImageManager, true));
+        mMeshCache = std::make_unique<MeshCache>(path, maxSize, mVFS, std::move(options));
+    }
+
+    osg::ref_ptr<osg::Node> SceneManager::loadNifWithMeshCache(VFS::Path::NormalizedView path)
+    {
+        const std::string key = MeshCache::makeKey(path.value(), *mVFS->get(path));
+        if (osg::ref_ptr<osg::Node> cached = mMeshCache->read(key))
+            return cached;
+
+        const Nif::NIFFilePtr file = mNifFileManager->get(path);
+        osg::ref_ptr<osg::Node> loaded = NifOsg::Loader::load(*file, mImageManager, mBgsmFileManager);
+        // Meshes using external material files would have to be keyed by those files as well
+        if (file->getBethVersion() < Nif::NIFFile::BETHVER_FO4 && MeshCache::canStore(*loaded))
+            mMeshCache->write(key, *loaded);
+        return loaded;
+    }
+
     void SceneManager::loadSelectionMarker(
         osg::ref_ptr<osg::Group> parentNode, const char* markerData, long long markerSize) const
     {
@@ -992,7 +1032,10 @@ namespace Resource
             osg::ref_ptr<osg::Node> loaded;
             try
             {
-                loaded = load(path, mVFS, mImageManager, mNifFileManager, mBgsmFileManager);
+                if (mMeshCache != nullptr && Misc::getFileExtension(path.value()) == "nif")
+                    loaded = loadNifWithMeshCache(path);
+                else
+                    loaded = load(path, mVFS, mImageManager, mNifFileManager, mBgsmFileManager);
             }
             catch (const std::exception& e)
             {
@@ -1217,6 +1260,9 @@ namespace Resource
                 frameNumber, "Compiling", static_cast<double>(mIncrementalCompileOperation->getToCompile().size()));
         }
 
+        if (const Shader::AsyncProgramCompiler* compiler = mShaderManager->getAsyncProgramCompiler())
+            stats->setAttribute(frameNumber, "Compiling Programs", static_cast<double>(compiler->getNumPending()));
+
         {
             std::lock_guard<std::mutex> lock(mSharedStateMutex);
             stats->setAttribute(
@@ -1243,6 +1289,8 @@ namespace Resource
         shaderVisitor->setAdjustCoverageForAlphaTest(mAdjustCoverageForAlphaTest);
         shaderVisitor->setSupportsNormalsRT(mSupportsNormalsRT);
         shaderVisitor->setWeatherParticleOcclusion(mWeatherParticleOcclusion);
+        shaderVisitor->setGpuSkinning(mGpuSkinning);
+        shaderVisitor->setGpuMorphing(mGpuMorphing);
         return shaderVisitor;
     }
 }
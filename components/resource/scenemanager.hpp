@@ -2,6 +2,7 @@
 #define OPENMW_COMPONENTS_RESOURCE_SCENEMANAGER_H
 
 #include <array>
+#include <cstdint>
 #include <memory>
 #include <mutex>
 #include <string>
@@ -31,6 +32,7 @@ namespace osg
 namespace Resource
 {
     class ImageManager;
+    class MeshCache;
     class NifFileManager;
     class BgsmFileManager;
     class SharedStateManager;
@@ -144,16 +146,26 @@ namespace Resource
             // If we add more UBO's, we should probably assign their bindings dynamically according to the current count
             // of UBO's in the programTemplate
             LightBuffer,
-            PostProcessor
+            PostProcessor,
+            SharedUniforms
         };
         void setLightingMethod(SceneUtil::LightingMethod method);
         SceneUtil::LightingMethod getLightingMethod() const;
 
+        /// @return whether shaders read the lights and the shared uniforms from uniform buffers, as with the useUBO
+        /// define
+        bool getUseUniformBuffers() const;
+
         void setConvertAlphaTestToAlphaToCoverage(bool convert);
         void setAdjustCoverageForAlphaTest(bool adjustCoverage);
 
         void setShaderPath(const std::filesystem::path& path);
 
+        /// Store meshes converted from NIF files in a MeshCache at the given path and load them from there.
+        /// @param maxSize in bytes
+        /// @note Not thread safe, has to be called before any mesh is loaded.
+        void enableMeshCache(const std::filesystem::path& path, std::uint64_t maxSize);
+
         /// Check if a given scene is loaded and if so, update its usage timestamp to prevent it from being unloaded
         bool checkLoaded(VFS::Path::NormalizedView name, double referenceTime);
 
@@ -232,9 +244,14 @@ namespace Resource
 
         void setWeatherParticleOcclusion(bool value) { mWeatherParticleOcclusion = value; }
 
+        void setGpuSkinning(bool value) { mGpuSkinning = value; }
+
+        void setGpuMorphing(bool value) { mGpuMorphing = value; }
+
     private:
         osg::ref_ptr<Shader::ShaderVisitor> createShaderVisitor(const std::string& shaderPrefix = "objects");
         osg::ref_ptr<osg::Node> loadErrorMarker();
+        osg::ref_ptr<osg::Node> loadNifWithMeshCache(VFS::Path::NormalizedView path);
         osg::ref_ptr<osg::Node> cloneErrorMarker();
 
         mutable std::mutex mSharedStateMutex;
@@ -250,6 +267,7 @@ namespace Resource
         Resource::ImageManager* mImageManager;
         Resource::NifFileManager* mNifFileManager;
         Resource::BgsmFileManager* mBgsmFileManager;
+        std::unique_ptr<MeshCache> mMeshCache;
         osg::ref_ptr<osgUtil::IncrementalCompileOperation> mIncrementalCompileOperation;
         mutable osg::ref_ptr<osg::Node> mErrorMarker;
         mutable std::once_flag mErrorMarkerFlag;
@@ -270,6 +288,8 @@ namespace Resource
         bool mAdjustCoverageForAlphaTest = false;
         bool mSupportsNormalsRT = false;
         bool mWeatherParticleOcclusion = false;
+        bool mGpuSkinning = false;
+        bool mGpuMorphing = false;
         bool mUnRefImageDataAfterApply = false;
 
         SceneManager(const SceneManager&) = delete;
@@ -0,0 +1,279 @@
+#ifndef OPENMW_COMPONENTS_RESOURCE_SHARDEDOBJECTCACHE
+#define OPENMW_COMPONENTS_RESOURCE_SHARDEDOBJECTCACHE
+
+#include "cachestats.hpp"
+#include "objectcache.hpp"
+
+#include <osg/Node>
+#include <osg/Referenced>
+#include <osg/ref_ptr>
+
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <unordered_map>
+#include <vector>
+
+namespace Resource
+{
+    /// @brief Object cache with keys distributed over independently locked shards.
+    /// @par Provides the same interface as GenericObjectCache except for ordered lookups. Each shard keeps its own
+    /// hash table and LRU list, so concurrent lookups of different keys rarely hit the same mutex. When a per shard
+    /// size limit is set, least recently used items are evicted on insertion, preferring items not referenced
+    /// elsewhere.
+    template <typename KeyType, typename Hash = std::hash<KeyType>, typename Equal = std::equal_to<>>
+    class ShardedObjectCache : public osg::Referenced
+    {
+    public:
+        static constexpr std::size_t sDefaultShardCount = 16;
+
+        explicit ShardedObjectCache(std::size_t shardCount = sDefaultShardCount, std::size_t maxShardSize = 0)
+            : mShards(std::max<std::size_t>(shardCount, 1))
+        {
+            for (Shard& shard : mShards)
+                shard.mMaxSize = maxShardSize;
+        }
+
+        /// Limit number of items per shard, 0 means unlimited. Applied on the next insertion into each shard.
+        void setMaxShardSize(std::size_t value)
+        {
+            for (Shard& shard : mShards)
+            {
+                const std::unique_lock lock = lockShard(shard);
+                shard.mMaxSize = value;
+            }
+        }
+
+        std::size_t getShardCount() const { return mShards.size(); }
+
+        /// @see GenericObjectCache::update
+        void update(double referenceTime, double expiryDelay)
+        {
+            std::vector<osg::ref_ptr<osg::Object>> objectsToRemove;
+            const double expiryTime = referenceTime - expiryDelay;
+            for (Shard& shard : mShards)
+            {
+                const std::unique_lock lock = lockShard(shard);
+                for (auto it = shard.mItems.begin(); it != shard.mItems.end();)
+                {
+                    Item& item = it->second.mItem;
+
+                    if ((item.mValue != nullptr && item.mValue->referenceCount() > 1) || item.mLastUsage == 0)
+                        item.mLastUsage = referenceTime;
+
+                    if (item.mLastUsage > expiryTime)
+                    {
+                        ++it;
+                        continue;
+                    }
+
+                    ++shard.mExpired;
+
+                    if (item.mValue != nullptr)
+                        objectsToRemove.push_back(std::move(item.mValue));
+
+                    it = shard.erase(it);
+                }
+            }
+            // remove expired items from cache outside the lock
+            objectsToRemove.clear();
+        }
+
+        void clear()
+        {
+            for (Shard& shard : mShards)
+            {
+                const std::unique_lock lock = lockShard(shard);
+                shard.mLru.clear();
+                shard.mItems.clear();
+            }
+        }
+
+        template <class K>
+        void addEntryToObjectCache(K&& key, osg::Object* object, double timestamp = 0.0)
+        {
+            osg::ref_ptr<osg::Object> evicted;
+            Shard& shard = getShard(key);
+            const std::unique_lock lock = lockShard(shard);
+            const auto it = shard.mItems.find(key);
+            if (it != shard.mItems.end())
+            {
+                it->second.mItem = Item{ object, timestamp };
+                shard.touch(it->second);
+                return;
+            }
+            const auto inserted = shard.mItems.emplace(std::forward<K>(key), Entry{ Item{ object, timestamp }, {} });
+            inserted.first->second.mLruIt = shard.mLru.insert(shard.mLru.end(), &inserted.first->first);
+            if (shard.mMaxSize != 0 && shard.mItems.size() > shard.mMaxSize)
+                evicted = shard.evictOne();
+        }
+
+        void removeFromObjectCache(const auto& key)
+        {
+            Shard& shard = getShard(key);
+            const std::unique_lock lock = lockShard(shard);
+            const auto it = shard.mItems.find(key);
+            if (it != shard.mItems.end())
+                shard.erase(it);
+        }
+
+        osg::ref_ptr<osg::Object> getRefFromObjectCache(const auto& key)
+        {
+            Shard& shard = getShard(key);
+            const std::unique_lock lock = lockShard(shard);
+            if (Item* const item = shard.find(key))
+                return item->mValue;
+            return nullptr;
+        }
+
+        std::optional<osg::ref_ptr<osg::Object>> getRefFromObjectCacheOrNone(const auto& key)
+        {
+            Shard& shard = getShard(key);
+            const std::unique_lock lock = lockShard(shard);
+            if (Item* const item = shard.find(key))
+                return item->mValue;
+            return std::nullopt;
+        }
+
+        bool checkInObjectCache(const auto& key, double timeStamp)
+        {
+            Shard& shard = getShard(key);
+            const std::unique_lock lock = lockShard(shard);
+            if (Item* const item = shard.find(key))
+            {
+                item->mLastUsage = timeStamp;
+                return true;
+            }
+            return false;
+        }
+
+        void releaseGLObjects(osg::State* state)
+        {
+            for (Shard& shard : mShards)
+            {
+                const std::unique_lock lock = lockShard(shard);
+                for (const auto& [k, v] : shard.mItems)
+                    if (v.mItem.mValue != nullptr)
+                        v.mItem.mValue->releaseGLObjects(state);
+            }
+        }
+
+        void accept(osg::NodeVisitor& nv)
+        {
+            for (Shard& shard : mShards)
+            {
+                const std::unique_lock lock = lockShard(shard);
+                for (const auto& [k, v] : shard.mItems)
+                    if (osg::Object* const object = v.mItem.mValue.get())
+                        if (osg::Node* const node = dynamic_cast<osg::Node*>(object))
+                            node->accept(nv);
+            }
+        }
+
+        template <class Functor>
+        void call(Functor&& f)
+        {
+            for (Shard& shard : mShards)
+            {
+                const std::unique_lock lock = lockShard(shard);
+                for (const auto& [k, v] : shard.mItems)
+                    f(k, v.mItem.mValue.get());
+            }
+        }
+
+        CacheStats getStats() const
+        {
+            CacheStats result;
+            for (const Shard& shard : mShards)
+            {
+                const std::lock_guard lock(shard.mMutex);
+                result.mSize += shard.mItems.size();
+                result.mGet += shard.mGet;
+                result.mHit += shard.mHit;
+                result.mExpired += shard.mExpired;
+                result.mEvicted += shard.mEvicted;
+                result.mContended += shard.mContended;
+            }
+            return result;
+        }
+
+    private:
+        using Item = GenericObjectCacheItem;
+
+        struct Entry
+        {
+            Item mItem;
+            typename std::list<const KeyType*>::iterator mLruIt;
+        };
+
+        struct Shard
+        {
+            std::unordered_map<KeyType, Entry, Hash, Equal> mItems;
+            // least recently used keys first, points to keys stored in mItems
+            std::list<const KeyType*> mLru;
+            std::size_t mMaxSize = 0;
+            mutable std::mutex mMutex;
+            std::size_t mGet = 0;
+            std::size_t mHit = 0;
+            std::size_t mExpired = 0;
+            std::size_t mEvicted = 0;
+            std::size_t mContended = 0;
+
+            void touch(Entry& entry) { mLru.splice(mLru.end(), mLru, entry.mLruIt); }
+
+            Item* find(const auto& key)
+            {
+                ++mGet;
+                const auto it = mItems.find(key);
+                if (it == mItems.end())
+                    return nullptr;
+                ++mHit;
+                touch(it->second);
+                return &it->second.mItem;
+            }
+
+            auto erase(auto it)
+            {
+                mLru.erase(it->second.mLruIt);
+                return mItems.erase(it);
+            }
+
+            osg::ref_ptr<osg::Object> evictOne()
+            {
+                // prefer items that nobody else is holding to avoid loading the same resource twice
+                auto candidate = std::find_if(mLru.begin(), mLru.end(), [&](const KeyType* key) {
+                    const Item& item = mItems.find(*key)->second.mItem;
+                    return item.mValue == nullptr || item.mValue->referenceCount() <= 1;
+                });
+                if (candidate == mLru.end())
+                    candidate = mLru.begin();
+                const auto it = mItems.find(**candidate);
+                osg::ref_ptr<osg::Object> result = std::move(it->second.mItem.mValue);
+                erase(it);
+                ++mEvicted;
+                return result;
+            }
+        };
+
+        std::vector<Shard> mShards;
+
+        Shard& getShard(const auto& key) { return mShards[Hash{}(key) % mShards.size()]; }
+
+        static std::unique_lock<std::mutex> lockShard(Shard& shard)
+        {
+            std::unique_lock<std::mutex> lock(shard.mMutex, std::try_to_lock);
+            if (!lock.owns_lock())
+            {
+                lock.lock();
+                ++shard.mContended;
+            }
+            return lock;
+        }
+    };
+}
+
+#endif
@@ -56,6 +56,7 @@ namespace Resource
                 "",
                 "Loading",
                 "Compiling",
+                "Compiling Programs",
                 "WorkQueue",
                 "WorkThread",
                 "UnrefQueue",
@@ -71,11 +72,11 @@ namespace Resource
                 "Physics Objects",
                 "Physics Projectiles",
                 "Physics HeightFields",
+                "Physics Animated Objects",
+                "Physics Animated Objects Updated",
                 "",
                 "Lua UsedMemory",
-                "",
-                "",
-                "",
+                "Lua Deferred",
             };
 
             static_assert(std::size(firstPage) == itemsPerPage);
@@ -89,6 +90,7 @@ namespace Resource
                 "Keyframe",
                 "BSShader Material",
                 "Groundcover Chunk",
+                "Groundcover Cell",
                 "Object Chunk",
                 "Terrain Chunk",
                 "Terrain Texture",
@@ -102,6 +104,82 @@ namespace Resource
                 "CellPreloader Evicted",
                 "CellPreloader Loaded",
                 "CellPreloader Expired",
+                "CellPreloader TooLate",
+                "CellPreloader Missed",
+                "CellPreloader HitRate",
+                "Scene Loaded Cells",
+            };
+
+            constexpr std::string_view textureStreaming[] = {
+                "TextureStreaming Images",
+                "TextureStreaming Streamed",
+                "TextureStreaming Loading",
+                "TextureStreaming Size",
+                "TextureStreaming Budget",
+            };
+
+            constexpr std::string_view vramManagement[] = {
+                "VRAM Usage",
+                "VRAM Budget",
+                "VRAM Shed",
+            };
+
+            constexpr std::string_view gpu[] = {
+                "GPU Shadows",
+                "GPU Water Reflection",
+                "GPU Water Refraction",
+                "GPU Cubemap Reflection",
+                "GPU PostProcessing",
+                "GPU UI",
+            };
+
+            constexpr std::string_view physicsLineOfSight[] = {
+                "Physics Full Solves",
+                "Physics Skipped Solves",
+                "Physics LOS Cache",
+                "Physics LOS Requests",
+                "Physics LOS HitRate",
+            };
+
+            constexpr std::string_view deferredTasks[] = {
+                "Deferred Skipped",
+                "Deferred UnrefQueue",
+                "Deferred CellPreloader",
+            };
+
+            constexpr std::string_view lua[] = {
+                "Lua GC",
+                "Lua GC Steps",
+            };
+
+            constexpr std::string_view effectPool[] = {
+                "Effect Pool Size",
+                "Effect Pool Hits",
+                "Effect Pool Misses",
+            };
+
+            constexpr std::string_view frameArena[] = {
+                "FrameArena Mechanics",
+                "FrameArena Lua",
+                "FrameArena Rendering",
+                "FrameArena Bytes",
+            };
+
+            constexpr std::string_view workQueue[] = {
+                "WorkQueue High Depth",
+                "WorkQueue High Processed",
+                "WorkQueue High Wait",
+                "WorkQueue High Run",
+                "",
+                "WorkQueue Normal Depth",
+                "WorkQueue Normal Processed",
+                "WorkQueue Normal Wait",
+                "WorkQueue Normal Run",
+                "",
+                "WorkQueue Low Depth",
+                "WorkQueue Low Processed",
+                "WorkQueue Low Wait",
+                "WorkQueue Low Run",
             };
 
             constexpr std::string_view navMesh[] = {
@@ -109,8 +187,11 @@ namespace Resource
                 "NavMesh Removing",
                 "NavMesh Updating",
                 "NavMesh Delayed",
+                "NavMesh Demanded",
                 "NavMesh Pushed",
                 "NavMesh Processing",
+                "NavMesh Demanded Jobs",
+                "NavMesh Demanded Latency",
                 "NavMesh DbJobs Write",
                 "NavMesh DbJobs Read",
                 "NavMesh DbCache Get",
@@ -124,6 +205,10 @@ namespace Resource
                 "NavMesh Recast Objects",
                 "NavMesh Recast Heightfields",
                 "NavMesh Recast Water",
+                "NavMesh PathQuery Count",
+                "NavMesh PathQuery Time",
+                "NavMesh PathCache Get",
+                "NavMesh PathCache Hit",
             };
 
             std::vector<std::string> statNames;
@@ -134,13 +219,62 @@ namespace Resource
             for (std::size_t i = 0; i < std::size(caches); ++i)
             {
                 Resource::addCacheStatsAttibutes(caches[i], statNames);
-                if ((i + 1) % 5 != 0)
+                if ((i + 1) % 3 != 0)
                     statNames.emplace_back();
+                else
+                    while (statNames.size() % itemsPerPage != 0)
+                        statNames.emplace_back();
             }
 
             for (std::string_view name : cellPreloader)
                 statNames.emplace_back(name);
 
+            statNames.emplace_back();
+
+            for (std::string_view name : textureStreaming)
+                statNames.emplace_back(name);
+
+            statNames.emplace_back();
+
+            for (std::string_view name : vramManagement)
+                statNames.emplace_back(name);
+
+            statNames.emplace_back();
+
+            for (std::string_view name : gpu)
+                statNames.emplace_back(name);
+
+            statNames.emplace_back();
+
+            for (std::string_view name : physicsLineOfSight)
+                statNames.emplace_back(name);
+
+            statNames.emplace_back();
+
+            for (std::string_view name : deferredTasks)
+                statNames.emplace_back(name);
+
+            statNames.emplace_back();
+
+            for (std::string_view name : lua)
+                statNames.emplace_back(name);
+
+            statNames.emplace_back();
+
+            for (std::string_view name : effectPool)
+                statNames.emplace_back(name);
+
+            statNames.emplace_back();
+
+            for (std::string_view name : frameArena)
+                statNames.emplace_back(name);
+
+            while (statNames.size() % itemsPerPage != 0)
+                statNames.emplace_back();
+
+            for (std::string_view name : workQueue)
+                statNames.emplace_back(name);
+
             while (statNames.size() % itemsPerPage != 0)
                 statNames.emplace_back();
 
@@ -303,7 +437,8 @@ namespace Resource
         if (viewer != nullptr)
         {
             // Add/remove openmw stats to the osd as necessary
-            viewer->getViewerStats()->collectStats("engine", _statsType >= StatsHandler::StatsType::VIEWER_STATS);
+            viewer->getViewerStats()->collectStats(
+                "engine", mCollectEngineStats || _statsType >= StatsHandler::StatsType::VIEWER_STATS);
 
             if (mOfflineCollect)
                 collectStatistics(*viewer);
@@ -407,7 +542,7 @@ namespace Resource
             mCamera->setNodeMask(0);
             mSwitch->setAllChildrenOff();
 
-            viewer.getViewerStats()->collectStats("resource", false);
+            viewer.getViewerStats()->collectStats("resource", mCollectResourceStats);
         }
         else
         {
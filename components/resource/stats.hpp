@@ -32,11 +32,15 @@ namespace Resource
 
         bool handle(const osgGA::GUIEventAdapter& ea, osgGA::GUIActionAdapter& aa) override;
 
+        /// Collect the engine stats even while they are not shown.
+        void setCollectEngineStats(bool value) { mCollectEngineStats = value; }
+
     private:
         void setUpFonts();
 
         bool mInitFonts = false;
         bool mOfflineCollect;
+        bool mCollectEngineStats = false;
         osg::ref_ptr<osgText::Font> mTextFont;
     };
 
@@ -50,10 +54,14 @@ namespace Resource
         /** Get the keyboard and mouse usage of this manipulator.*/
         void getUsage(osg::ApplicationUsage& usage) const override;
 
+        /// Collect the resource stats even while they are not shown.
+        void setCollectResourceStats(bool value) { mCollectResourceStats = value; }
+
     private:
         unsigned mPage = 0;
         bool mInitialized = false;
         bool mOfflineCollect;
+        bool mCollectResourceStats = false;
         osg::ref_ptr<osg::Switch> mSwitch;
         osg::ref_ptr<osg::Camera> mCamera;
         osg::ref_ptr<osgText::Font> mTextFont;
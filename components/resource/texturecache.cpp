@@ -0,0 +1,285 @@
+#include "texturecache.hpp"
+
+#include "texturecompression.hpp"
+
+#include <components/debug/debuglog.hpp>
+#include <components/files/hash.hpp>
+#include <components/sceneutil/workqueue.hpp>
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <format>
+#include <fstream>
+#include <mutex>
+#include <optional>
+#include <set>
+#include <sstream>
+#include <tuple>
+#include <vector>
+
+namespace Resource
+{
+    namespace
+    {
+        // Increment when the way images are compressed or stored changes
+        constexpr std::uint32_t textureCacheVersion = 1;
+
+        constexpr std::array<char, 4> sMagic{ 'O', 'M', 'W', 'T' };
+
+        // Evict a bit more than needed to not scan the cache on every write once it is full
+        constexpr std::uint64_t sEvictRatio = 4;
+
+        struct Header
+        {
+            std::array<char, 4> mMagic;
+            std::uint32_t mVersion;
+            std::uint32_t mWidth;
+            std::uint32_t mHeight;
+            std::uint32_t mPixelFormat;
+            std::uint32_t mNumLevels;
+            std::uint64_t mDataSize;
+        };
+
+        bool isValidPixelFormat(std::uint32_t value)
+        {
+            return value == GL_COMPRESSED_RGB_S3TC_DXT1_EXT || value == GL_COMPRESSED_RGBA_S3TC_DXT5_EXT
+                || value == GL_COMPRESSED_RED_GREEN_RGTC2_EXT;
+        }
+    }
+
+    struct TextureCache::Storage
+    {
+        std::filesystem::path mPath;
+        std::uint64_t mMaxSize;
+        std::mutex mMutex;
+        std::uint64_t mSize = 0;
+        std::set<std::string, std::less<>> mPending;
+
+        void write(const std::string& key, const osg::Image& image);
+
+        void evict();
+    };
+
+    class TextureCache::CompressImageWorkItem : public SceneUtil::WorkItem
+    {
+    public:
+        CompressImageWorkItem(std::shared_ptr<Storage> storage, std::string key, osg::ref_ptr<const osg::Image> image,
+            bool normalMap, bool rgtc)
+            : mStorage(std::move(storage))
+            , mKey(std::move(key))
+            , mImage(std::move(image))
+            , mNormalMap(normalMap)
+            , mRgtc(rgtc)
+        {
+        }
+
+        void doWork() override
+        {
+            std::optional<TextureCompression> format = chooseTextureCompression(*mImage, mNormalMap);
+            if (format == TextureCompression::BC5 && !mRgtc)
+                format = TextureCompression::BC3;
+            if (format.has_value() && !mAborted)
+                mStorage->write(mKey, *compressImage(*mImage, *format, mNormalMap));
+            mImage = nullptr;
+            const std::lock_guard lock(mStorage->mMutex);
+            mStorage->mPending.erase(mKey);
+        }
+
+        void abort() override { mAborted = true; }
+
+    private:
+        const std::shared_ptr<Storage> mStorage;
+        const std::string mKey;
+        osg::ref_ptr<const osg::Image> mImage;
+        const bool mNormalMap;
+        const bool mRgtc;
+        std::atomic_bool mAborted{ false };
+    };
+
+    TextureCache::TextureCache(const std::filesystem::path& path, std::uint64_t maxSize,
+        osg::ref_ptr<SceneUtil::WorkQueue> workQueue, std::string_view normalMapPattern,
+        std::string_view normalHeightMapPattern, bool rgtc)
+        : mWorkQueue(std::move(workQueue))
+        , mNormalMapPattern(normalMapPattern)
+        , mNormalHeightMapPattern(normalHeightMapPattern)
+        , mRgtc(rgtc)
+    {
+        std::error_code ec;
+        std::filesystem::create_directories(path, ec);
+        if (ec)
+        {
+            Log(Debug::Warning) << "Texture cache is disabled: failed to create " << path << ": " << ec.message();
+            return;
+        }
+
+        mStorage = std::make_shared<Storage>();
+        mStorage->mPath = path;
+        mStorage->mMaxSize = maxSize;
+        for (const auto& entry : std::filesystem::directory_iterator(path, ec))
+            if (entry.path().extension() == ".tex")
+                mStorage->mSize += entry.file_size(ec);
+
+        Log(Debug::Info) << "Texture cache uses " << mStorage->mSize / (1024 * 1024) << " MiB of "
+                         << maxSize / (1024 * 1024) << " MiB";
+    }
+
+    TextureCache::~TextureCache() = default;
+
+    std::string TextureCache::makeKey(std::string_view path, std::istream& source) const
+    {
+        const std::array<std::uint64_t, 2> fileHash = Files::getHash(path, source);
+        std::istringstream stream(std::format("{}\n{}\n{:016x}{:016x}\n{}\n{}\n{}", textureCacheVersion, path,
+            fileHash[0], fileHash[1], mNormalMapPattern, mNormalHeightMapPattern, mRgtc));
+        const std::array<std::uint64_t, 2> hash = Files::getHash("texture", stream);
+        return std::format("{:016x}{:016x}", hash[0], hash[1]);
+    }
+
+    osg::ref_ptr<osg::Image> TextureCache::read(std::string_view key)
+    {
+        if (mStorage == nullptr)
+            return nullptr;
+
+        const std::filesystem::path path = mStorage->mPath / std::format("{}.tex", key);
+        std::ifstream stream(path, std::ios::binary);
+        if (!stream.is_open())
+            return nullptr;
+
+        Header header;
+        stream.read(reinterpret_cast<char*>(&header), sizeof(header));
+        if (!stream || header.mMagic != sMagic || header.mVersion != textureCacheVersion
+            || !isValidPixelFormat(header.mPixelFormat) || header.mNumLevels == 0 || header.mWidth == 0
+            || header.mHeight == 0 || header.mDataSize == 0)
+        {
+            Log(Debug::Warning) << "Failed to read cached texture " << key << ": invalid header";
+            return nullptr;
+        }
+
+        std::vector<std::uint32_t> offsets(header.mNumLevels - 1);
+        stream.read(reinterpret_cast<char*>(offsets.data()),
+            static_cast<std::streamsize>(offsets.size() * sizeof(std::uint32_t)));
+        const auto isOutside = [&](std::uint32_t offset) { return offset >= header.mDataSize; };
+        if (!stream || std::any_of(offsets.begin(), offsets.end(), isOutside))
+        {
+            Log(Debug::Warning) << "Failed to read cached texture " << key << ": invalid mipmap levels";
+            return nullptr;
+        }
+
+        std::unique_ptr<unsigned char[]> data(new unsigned char[header.mDataSize]);
+        stream.read(reinterpret_cast<char*>(data.get()), static_cast<std::streamsize>(header.mDataSize));
+        if (!stream)
+        {
+            Log(Debug::Warning) << "Failed to read cached texture " << key << ": truncated data";
+            return nullptr;
+        }
+        stream.close();
+
+        const GLenum pixelFormat = static_cast<GLenum>(header.mPixelFormat);
+        osg::ref_ptr<osg::Image> image = new osg::Image;
+        image->setImage(static_cast<int>(header.mWidth), static_cast<int>(header.mHeight), 1, pixelFormat,
+            pixelFormat, GL_UNSIGNED_BYTE, data.release(), osg::Image::USE_NEW_DELETE);
+        image->setMipmapLevels(osg::Image::MipmapDataType(offsets.begin(), offsets.end()));
+
+        // Mark the entry as recently used for the eviction
+        std::error_code ec;
+        std::filesystem::last_write_time(path, std::filesystem::file_time_type::clock::now(), ec);
+
+        return image;
+    }
+
+    void TextureCache::compress(std::string_view key, osg::ref_ptr<const osg::Image> image)
+    {
+        if (mStorage == nullptr || !canCompressImage(*image))
+            return;
+
+        {
+            const std::lock_guard lock(mStorage->mMutex);
+            if (!mStorage->mPending.emplace(key).second)
+                return;
+        }
+
+        const bool normalMap = isNormalMap(image->getFileName(), mNormalMapPattern, mNormalHeightMapPattern);
+        osg::ref_ptr<CompressImageWorkItem> item
+            = new CompressImageWorkItem(mStorage, std::string(key), std::move(image), normalMap, mRgtc);
+        item->setPriority(SceneUtil::WorkPriority::Low);
+        mWorkQueue->addWorkItem(std::move(item));
+    }
+
+    void TextureCache::Storage::write(const std::string& key, const osg::Image& image)
+    {
+        const std::filesystem::path path = mPath / std::format("{}.tex", key);
+        // Write to a temporary file first to never read a partially written image
+        std::filesystem::path tmpPath = path;
+        tmpPath += ".tmp";
+
+        {
+            std::ofstream stream(tmpPath, std::ios::binary);
+            if (!stream.is_open())
+            {
+                Log(Debug::Warning) << "Failed to open " << tmpPath << " to cache texture";
+                return;
+            }
+
+            const Header header{
+                .mMagic = sMagic,
+                .mVersion = textureCacheVersion,
+                .mWidth = static_cast<std::uint32_t>(image.s()),
+                .mHeight = static_cast<std::uint32_t>(image.t()),
+                .mPixelFormat = static_cast<std::uint32_t>(image.getPixelFormat()),
+                .mNumLevels = image.getNumMipmapLevels(),
+                .mDataSize = image.getTotalSizeInBytesIncludingMipmaps(),
+            };
+            const std::vector<std::uint32_t> offsets(
+                image.getMipmapLevels().begin(), image.getMipmapLevels().end());
+            stream.write(reinterpret_cast<const char*>(&header), sizeof(header));
+            stream.write(reinterpret_cast<const char*>(offsets.data()),
+                static_cast<std::streamsize>(offsets.size() * sizeof(std::uint32_t)));
+            stream.write(reinterpret_cast<const char*>(image.data()), static_cast<std::streamsize>(header.mDataSize));
+            if (!stream)
+            {
+                Log(Debug::Warning) << "Failed to write cached texture " << key;
+                return;
+            }
+        }
+
+        std::error_code ec;
+        std::filesystem::rename(tmpPath, path, ec);
+        if (ec)
+        {
+            Log(Debug::Warning) << "Failed to rename " << tmpPath << " to " << path << ": " << ec.message();
+            return;
+        }
+
+        const std::uint64_t size = std::filesystem::file_size(path, ec);
+        const std::lock_guard lock(mMutex);
+        mSize += ec ? 0 : size;
+        if (mSize > mMaxSize)
+            evict();
+    }
+
+    void TextureCache::Storage::evict()
+    {
+        std::vector<std::tuple<std::filesystem::file_time_type, std::uint64_t, std::filesystem::path>> entries;
+        std::error_code ec;
+        mSize = 0;
+        for (const auto& entry : std::filesystem::directory_iterator(mPath, ec))
+        {
+            if (entry.path().extension() != ".tex")
+                continue;
+            const std::uint64_t size = entry.file_size(ec);
+            mSize += size;
+            entries.emplace_back(entry.last_write_time(ec), size, entry.path());
+        }
+
+        std::sort(entries.begin(), entries.end());
+
+        const std::uint64_t target = mMaxSize - mMaxSize / sEvictRatio;
+        for (const auto& [_, size, path] : entries)
+        {
+            if (mSize <= target)
+                break;
+            if (std::filesystem::remove(path, ec))
+                mSize -= size;
+        }
+    }
+}
@@ -0,0 +1,61 @@
+#ifndef OPENMW_COMPONENTS_RESOURCE_TEXTURECACHE_H
+#define OPENMW_COMPONENTS_RESOURCE_TEXTURECACHE_H
+
+#include <osg/Image>
+#include <osg/ref_ptr>
+
+#include <cstdint>
+#include <filesystem>
+#include <istream>
+#include <memory>
+#include <string>
+#include <string_view>
+
+namespace SceneUtil
+{
+    class WorkQueue;
+}
+
+namespace Resource
+{
+    /// @brief Stores block compressed versions of uncompressed images on disk to load them instead of the images in
+    /// later sessions.
+    /// @par Images are compressed on the work queue after they are loaded for the first time, so the first session
+    /// uses the uncompressed ones. Images are keyed by a hash of the file, changed content results in a different key
+    /// instead of reading a stale image. The least recently used entries are removed once the cache grows beyond its
+    /// size limit.
+    /// @note Thread safe.
+    class TextureCache
+    {
+    public:
+        /// @param rgtc if normal maps are compressed as BC5, BC3 is used otherwise
+        TextureCache(const std::filesystem::path& path, std::uint64_t maxSize,
+            osg::ref_ptr<SceneUtil::WorkQueue> workQueue, std::string_view normalMapPattern,
+            std::string_view normalHeightMapPattern, bool rgtc);
+
+        ~TextureCache();
+
+        /// @param source the file the image is loaded from
+        std::string makeKey(std::string_view path, std::istream& source) const;
+
+        /// @return nullptr when there is no compressed image for the key
+        osg::ref_ptr<osg::Image> read(std::string_view key);
+
+        /// Compress the image in the background and store it, does nothing if the image can't be compressed or is
+        /// already being compressed.
+        void compress(std::string_view key, osg::ref_ptr<const osg::Image> image);
+
+    private:
+        struct Storage;
+        class CompressImageWorkItem;
+
+        // Shared with the work items, which may still run after the cache is destroyed
+        std::shared_ptr<Storage> mStorage;
+        osg::ref_ptr<SceneUtil::WorkQueue> mWorkQueue;
+        std::string mNormalMapPattern;
+        std::string mNormalHeightMapPattern;
+        bool mRgtc;
+    };
+}
+
+#endif
@@ -0,0 +1,367 @@
+#include "texturecompression.hpp"
+
+#include <osg/Texture>
+#include <osg/Vec3f>
+#include <osg/Vec4>
+
+#include <components/misc/pathhelpers.hpp>
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <cstdlib>
+#include <limits>
+#include <vector>
+
+namespace Resource
+{
+    namespace
+    {
+        using Pixel = std::array<std::uint8_t, 4>;
+
+        // 4x4 pixels of a block, row by row
+        using Block = std::array<Pixel, 16>;
+
+        constexpr int sBlockSize = 4;
+
+        struct Level
+        {
+            int mWidth;
+            int mHeight;
+            std::vector<Pixel> mPixels;
+        };
+
+        std::uint8_t toByte(float value)
+        {
+            return static_cast<std::uint8_t>(std::clamp(value, 0.f, 1.f) * 255.f + 0.5f);
+        }
+
+        Level readLevel(const osg::Image& image)
+        {
+            Level result{ image.s(), image.t(), {} };
+            result.mPixels.reserve(static_cast<std::size_t>(result.mWidth) * static_cast<std::size_t>(result.mHeight));
+            for (int t = 0; t < result.mHeight; ++t)
+            {
+                for (int s = 0; s < result.mWidth; ++s)
+                {
+                    const osg::Vec4 color = image.getColor(s, t);
+                    result.mPixels.push_back(Pixel{ toByte(color.r()), toByte(color.g()), toByte(color.b()),
+                        toByte(color.a()) });
+                }
+            }
+            return result;
+        }
+
+        osg::Vec3f toNormal(const Pixel& pixel)
+        {
+            return osg::Vec3f(pixel[0], pixel[1], pixel[2]) / 127.5f - osg::Vec3f(1, 1, 1);
+        }
+
+        Level downsample(const Level& level, bool normalMap)
+        {
+            Level result{ std::max(level.mWidth / 2, 1), std::max(level.mHeight / 2, 1), {} };
+            result.mPixels.reserve(static_cast<std::size_t>(result.mWidth) * static_cast<std::size_t>(result.mHeight));
+            const auto get = [&](int s, int t) -> const Pixel& {
+                return level.mPixels[static_cast<std::size_t>(std::min(t, level.mHeight - 1) * level.mWidth
+                    + std::min(s, level.mWidth - 1))];
+            };
+            for (int t = 0; t < result.mHeight; ++t)
+            {
+                for (int s = 0; s < result.mWidth; ++s)
+                {
+                    const std::array<const Pixel*, 4> source{ &get(s * 2, t * 2), &get(s * 2 + 1, t * 2),
+                        &get(s * 2, t * 2 + 1), &get(s * 2 + 1, t * 2 + 1) };
+                    Pixel pixel;
+                    for (std::size_t channel = 0; channel < pixel.size(); ++channel)
+                    {
+                        int sum = 2;
+                        for (const Pixel* value : source)
+                            sum += (*value)[channel];
+                        pixel[channel] = static_cast<std::uint8_t>(sum / 4);
+                    }
+                    if (normalMap)
+                    {
+                        osg::Vec3f normal;
+                        for (const Pixel* value : source)
+                            normal += toNormal(*value);
+                        if (normal.normalize() > 0)
+                            for (std::size_t channel = 0; channel < 3; ++channel)
+                                pixel[channel] = toByte(normal[static_cast<unsigned>(channel)] * 0.5f + 0.5f);
+                    }
+                    result.mPixels.push_back(pixel);
+                }
+            }
+            return result;
+        }
+
+        // Levels smaller than a block repeat their last row and column
+        Block getBlock(const Level& level, int blockX, int blockY)
+        {
+            Block result;
+            for (int y = 0; y < sBlockSize; ++y)
+            {
+                const int t = std::min(blockY * sBlockSize + y, level.mHeight - 1);
+                for (int x = 0; x < sBlockSize; ++x)
+                {
+                    const int s = std::min(blockX * sBlockSize + x, level.mWidth - 1);
+                    result[static_cast<std::size_t>(y * sBlockSize + x)]
+                        = level.mPixels[static_cast<std::size_t>(t * level.mWidth + s)];
+                }
+            }
+            return result;
+        }
+
+        std::uint16_t toRgb565(int r, int g, int b)
+        {
+            return static_cast<std::uint16_t>(((r >> 3) << 11) | ((g >> 2) << 5) | (b >> 3));
+        }
+
+        std::array<int, 3> fromRgb565(std::uint16_t value)
+        {
+            const int r = (value >> 11) & 31;
+            const int g = (value >> 5) & 63;
+            const int b = value & 31;
+            return { (r << 3) | (r >> 2), (g << 2) | (g >> 4), (b << 3) | (b >> 2) };
+        }
+
+        void writeLittleEndian(std::uint64_t value, std::size_t size, unsigned char* out)
+        {
+            for (std::size_t i = 0; i < size; ++i)
+                out[i] = static_cast<unsigned char>((value >> (8 * i)) & 0xff);
+        }
+
+        // The endpoints are the corners of the bounding box of the colors moved inwards a bit, which is close to
+        // what fitting a line through them gives for the smooth gradients textures mostly consist of
+        void encodeColorBlock(const Block& block, unsigned char* out)
+        {
+            std::array<int, 3> min{ 255, 255, 255 };
+            std::array<int, 3> max{ 0, 0, 0 };
+            for (const Pixel& pixel : block)
+            {
+                for (std::size_t channel = 0; channel < 3; ++channel)
+                {
+                    min[channel] = std::min<int>(min[channel], pixel[channel]);
+                    max[channel] = std::max<int>(max[channel], pixel[channel]);
+                }
+            }
+            for (std::size_t channel = 0; channel < 3; ++channel)
+            {
+                const int inset = (max[channel] - min[channel]) >> 4;
+                min[channel] += inset;
+                max[channel] -= inset;
+            }
+
+            std::uint16_t color0 = toRgb565(max[0], max[1], max[2]);
+            std::uint16_t color1 = toRgb565(min[0], min[1], min[2]);
+            // The four color mode needs the first endpoint to be larger
+            if (color0 < color1)
+                std::swap(color0, color1);
+
+            std::uint32_t indices = 0;
+            if (color0 != color1)
+            {
+                const std::array<int, 3> end0 = fromRgb565(color0);
+                const std::array<int, 3> end1 = fromRgb565(color1);
+                std::array<std::array<int, 3>, 4> palette{ end0, end1 };
+                for (std::size_t channel = 0; channel < 3; ++channel)
+                {
+                    palette[2][channel] = (2 * end0[channel] + end1[channel]) / 3;
+                    palette[3][channel] = (end0[channel] + 2 * end1[channel]) / 3;
+                }
+                for (std::size_t i = 0; i < block.size(); ++i)
+                {
+                    int bestDistance = std::numeric_limits<int>::max();
+                    std::uint32_t best = 0;
+                    for (std::uint32_t index = 0; index < palette.size(); ++index)
+                    {
+                        int distance = 0;
+                        for (std::size_t channel = 0; channel < 3; ++channel)
+                        {
+                            const int delta = block[i][channel] - palette[index][channel];
+                            distance += delta * delta;
+                        }
+                        if (distance < bestDistance)
+                        {
+                            bestDistance = distance;
+                            best = index;
+                        }
+                    }
+                    indices |= best << (2 * i);
+                }
+            }
+
+            writeLittleEndian(color0, 2, out);
+            writeLittleEndian(color1, 2, out + 2);
+            writeLittleEndian(indices, 4, out + 4);
+        }
+
+        // Single channel block of BC3 alpha and BC4/BC5, always using the mode with 8 interpolated values
+        void encodeChannelBlock(const Block& block, std::size_t channel, unsigned char* out)
+        {
+            int min = 255;
+            int max = 0;
+            for (const Pixel& pixel : block)
+            {
+                min = std::min<int>(min, pixel[channel]);
+                max = std::max<int>(max, pixel[channel]);
+            }
+
+            std::uint64_t indices = 0;
+            if (min != max)
+            {
+                std::array<int, 8> palette{ max, min };
+                for (int i = 1; i < 7; ++i)
+                    palette[static_cast<std::size_t>(i + 1)] = ((7 - i) * max + i * min) / 7;
+                for (std::size_t i = 0; i < block.size(); ++i)
+                {
+                    int bestDistance = std::numeric_limits<int>::max();
+                    std::uint64_t best = 0;
+                    for (std::uint64_t index = 0; index < palette.size(); ++index)
+                    {
+                        const int distance = std::abs(block[i][channel] - palette[index]);
+                        if (distance < bestDistance)
+                        {
+                            bestDistance = distance;
+                            best = index;
+                        }
+                    }
+                    indices |= best << (3 * i);
+                }
+            }
+
+            out[0] = static_cast<unsigned char>(max);
+            out[1] = static_cast<unsigned char>(min);
+            writeLittleEndian(indices, 6, out + 2);
+        }
+
+        std::size_t getBlockBytes(TextureCompression format)
+        {
+            return format == TextureCompression::BC1 ? 8 : 16;
+        }
+
+        GLenum getPixelFormat(TextureCompression format)
+        {
+            switch (format)
+            {
+                case TextureCompression::BC1:
+                    return GL_COMPRESSED_RGB_S3TC_DXT1_EXT;
+                case TextureCompression::BC3:
+                    return GL_COMPRESSED_RGBA_S3TC_DXT5_EXT;
+                case TextureCompression::BC5:
+                    return GL_COMPRESSED_RED_GREEN_RGTC2_EXT;
+            }
+            return GL_COMPRESSED_RGB_S3TC_DXT1_EXT;
+        }
+
+        void encodeLevel(const Level& level, TextureCompression format, unsigned char* out)
+        {
+            const int blocksX = (level.mWidth + sBlockSize - 1) / sBlockSize;
+            const int blocksY = (level.mHeight + sBlockSize - 1) / sBlockSize;
+            const std::size_t blockBytes = getBlockBytes(format);
+            for (int y = 0; y < blocksY; ++y)
+            {
+                for (int x = 0; x < blocksX; ++x)
+                {
+                    const Block block = getBlock(level, x, y);
+                    switch (format)
+                    {
+                        case TextureCompression::BC1:
+                            encodeColorBlock(block, out);
+                            break;
+                        case TextureCompression::BC3:
+                            encodeChannelBlock(block, 3, out);
+                            encodeColorBlock(block, out + 8);
+                            break;
+                        case TextureCompression::BC5:
+                            encodeChannelBlock(block, 0, out);
+                            encodeChannelBlock(block, 1, out + 8);
+                            break;
+                    }
+                    out += blockBytes;
+                }
+            }
+        }
+
+        std::size_t getLevelBytes(const Level& level, TextureCompression format)
+        {
+            const std::size_t blocksX = static_cast<std::size_t>((level.mWidth + sBlockSize - 1) / sBlockSize);
+            const std::size_t blocksY = static_cast<std::size_t>((level.mHeight + sBlockSize - 1) / sBlockSize);
+            return blocksX * blocksY * getBlockBytes(format);
+        }
+    }
+
+    bool canCompressImage(const osg::Image& image)
+    {
+        if (image.s() <= 0 || image.t() <= 0 || image.r() != 1 || image.s() % sBlockSize != 0
+            || image.t() % sBlockSize != 0 || image.getDataType() != GL_UNSIGNED_BYTE
+            || image.getNumMipmapLevels() > 1)
+            return false;
+        switch (image.getPixelFormat())
+        {
+            case GL_RGB:
+            case GL_RGBA:
+            case GL_BGR:
+            case GL_BGRA:
+            case GL_LUMINANCE:
+            case GL_LUMINANCE_ALPHA:
+                return true;
+            default:
+                return false;
+        }
+    }
+
+    bool isNormalMap(std::string_view path, std::string_view normalMapPattern, std::string_view normalHeightMapPattern)
+    {
+        const std::string_view stem = Misc::stemFile(path);
+        return !normalMapPattern.empty() && stem.ends_with(normalMapPattern)
+            && (normalHeightMapPattern.empty() || !stem.ends_with(normalHeightMapPattern));
+    }
+
+    std::optional<TextureCompression> chooseTextureCompression(const osg::Image& image, bool normalMap)
+    {
+        if (!canCompressImage(image))
+            return std::nullopt;
+        if (normalMap)
+            return TextureCompression::BC5;
+        const GLenum pixelFormat = image.getPixelFormat();
+        if (pixelFormat == GL_RGBA || pixelFormat == GL_BGRA || pixelFormat == GL_LUMINANCE_ALPHA)
+        {
+            for (int t = 0; t < image.t(); ++t)
+                for (int s = 0; s < image.s(); ++s)
+                    if (toByte(image.getColor(s, t).a()) != 255)
+                        return TextureCompression::BC3;
+        }
+        return TextureCompression::BC1;
+    }
+
+    osg::ref_ptr<osg::Image> compressImage(const osg::Image& image, TextureCompression format, bool normalMap)
+    {
+        std::vector<Level> levels;
+        levels.push_back(readLevel(image));
+        while (levels.back().mWidth > 1 || levels.back().mHeight > 1)
+            levels.push_back(downsample(levels.back(), normalMap));
+
+        std::size_t size = 0;
+        for (const Level& level : levels)
+            size += getLevelBytes(level, format);
+
+        unsigned char* data = new unsigned char[size];
+        osg::Image::MipmapDataType offsets;
+        std::size_t offset = 0;
+        for (const Level& level : levels)
+        {
+            if (offset != 0)
+                offsets.push_back(static_cast<unsigned>(offset));
+            encodeLevel(level, format, data + offset);
+            offset += getLevelBytes(level, format);
+        }
+
+        const GLenum pixelFormat = getPixelFormat(format);
+        osg::ref_ptr<osg::Image> result = new osg::Image;
+        result->setFileName(image.getFileName());
+        result->setImage(image.s(), image.t(), 1, pixelFormat, pixelFormat, GL_UNSIGNED_BYTE, data,
+            osg::Image::USE_NEW_DELETE);
+        result->setMipmapLevels(offsets);
+        return result;
+    }
+}
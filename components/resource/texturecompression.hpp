@@ -0,0 +1,37 @@
+#ifndef OPENMW_COMPONENTS_RESOURCE_TEXTURECOMPRESSION_H
+#define OPENMW_COMPONENTS_RESOURCE_TEXTURECOMPRESSION_H
+
+#include <osg/Image>
+#include <osg/ref_ptr>
+
+#include <optional>
+#include <string_view>
+
+namespace Resource
+{
+    enum class TextureCompression
+    {
+        BC1,
+        BC3,
+        BC5,
+    };
+
+    /// @return true if the image is a 2D image of 8 bit unsigned channels without mipmaps and with a size that is a
+    /// multiple of the block size
+    bool canCompressImage(const osg::Image& image);
+
+    /// @return true if the file name ends with the normal map pattern but not with the normal height map pattern, the
+    /// height of those is stored in the alpha channel
+    bool isNormalMap(std::string_view path, std::string_view normalMapPattern, std::string_view normalHeightMapPattern);
+
+    /// @return BC5 for normal maps, BC3 for images with translucent pixels and BC1 for the others, nothing if the
+    /// image can't be compressed
+    std::optional<TextureCompression> chooseTextureCompression(const osg::Image& image, bool normalMap);
+
+    /// Compress the image generating a complete chain of mipmap levels with a box filter. The normals of normal maps
+    /// are normalized again after filtering, the Z component is dropped for BC5.
+    /// @note The image has to satisfy canCompressImage.
+    osg::ref_ptr<osg::Image> compressImage(const osg::Image& image, TextureCompression format, bool normalMap);
+}
+
+#endif
@@ -0,0 +1,64 @@
+#include "contributionculling.hpp"
+
+#include <osg/Camera>
+#include <osgUtil/CullVisitor>
+
+#include <components/misc/constants.hpp>
+
+namespace SceneUtil
+{
+    CullingView getCullingView(const osg::Camera& camera)
+    {
+        const std::string& name = camera.getName();
+        if (name == Constants::SceneCamera)
+            return CullingView::Main;
+        if (name == Constants::ReflectionCamera || name == Constants::RefractionCamera)
+            return CullingView::Reflection;
+        if (name == Constants::ShadowCamera || name == Constants::StaticShadowCamera)
+            return CullingView::Shadow;
+        return CullingView::Other;
+    }
+
+    bool isContributing(float size, float threshold, float hysteresis, bool culled)
+    {
+        return size >= (culled ? threshold * hysteresis : threshold);
+    }
+
+    ContributionCullCallback::ContributionCullCallback(const ContributionThresholds& thresholds, float hysteresis)
+        : mThresholds(thresholds)
+        , mHysteresis(hysteresis)
+    {
+    }
+
+    void ContributionCullCallback::operator()(osg::Node* node, osgUtil::CullVisitor* cv)
+    {
+        const CullingView view = getCullingView(*cv->getCurrentCamera());
+        float threshold = 0;
+        switch (view)
+        {
+            case CullingView::Main:
+                threshold = mThresholds.mMain;
+                break;
+            case CullingView::Reflection:
+                threshold = mThresholds.mReflection;
+                break;
+            case CullingView::Shadow:
+                threshold = mThresholds.mShadow;
+                break;
+            case CullingView::Other:
+                break;
+        }
+
+        if (threshold > 0)
+        {
+            std::atomic<bool>& culled = mCulled[static_cast<std::size_t>(view)];
+            const bool contributing = isContributing(
+                cv->clampedPixelSize(node->getBound()), threshold, mHysteresis, culled.load(std::memory_order_relaxed));
+            culled.store(!contributing, std::memory_order_relaxed);
+            if (!contributing)
+                return;
+        }
+
+        traverse(node, cv);
+    }
+}
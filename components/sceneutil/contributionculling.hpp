@@ -0,0 +1,67 @@
+#ifndef OPENMW_COMPONENTS_SCENEUTIL_CONTRIBUTIONCULLING_H
+#define OPENMW_COMPONENTS_SCENEUTIL_CONTRIBUTIONCULLING_H
+
+#include <components/sceneutil/nodecallback.hpp>
+
+#include <array>
+#include <atomic>
+
+namespace osg
+{
+    class Camera;
+}
+
+namespace osgUtil
+{
+    class CullVisitor;
+}
+
+namespace SceneUtil
+{
+    enum class CullingView
+    {
+        Main,
+        Reflection,
+        Shadow,
+        Other,
+    };
+
+    /// @return the kind of view the camera renders, judging by its name
+    CullingView getCullingView(const osg::Camera& camera);
+
+    /// Projected size below which a node does not contribute enough to be drawn, in pixels or in shadow map texels
+    /// for shadow views. 0 never skips the node.
+    struct ContributionThresholds
+    {
+        float mMain = 0;
+        float mReflection = 0;
+        float mShadow = 0;
+    };
+
+    /// @param size projected size of the node
+    /// @param culled whether the node was skipped the last time, it has to grow past the threshold multiplied by the
+    /// hysteresis to be drawn again, so nodes right at the threshold do not flicker
+    bool isContributing(float size, float threshold, float hysteresis, bool culled);
+
+    /// @brief Skips a node whose bounding sphere projects to less than the threshold of the view being culled.
+    /// @par Small feature culling uses a single threshold for everything a camera draws, this allows every kind of
+    /// node to have its own thresholds. Nodes are never skipped in views other than the main, reflection and shadow
+    /// views.
+    /// @note Every node needs its own callback, it remembers whether the node was skipped in each view.
+    class ContributionCullCallback
+        : public SceneUtil::NodeCallback<ContributionCullCallback, osg::Node*, osgUtil::CullVisitor*>
+    {
+    public:
+        ContributionCullCallback(const ContributionThresholds& thresholds, float hysteresis);
+
+        void operator()(osg::Node* node, osgUtil::CullVisitor* cv);
+
+    private:
+        ContributionThresholds mThresholds;
+        float mHysteresis;
+        // Indexed by CullingView, views of other cameras are never culled
+        std::array<std::atomic<bool>, 3> mCulled{};
+    };
+}
+
+#endif
@@ -0,0 +1,123 @@
+#include "depthpyramid.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <limits>
+
+namespace SceneUtil
+{
+    namespace
+    {
+        // Depth read back from a 24 bit buffer is not exact, a surface must not hide a box lying on it
+        constexpr float sDepthTolerance = 1.01f;
+    }
+
+    DepthPyramid::DepthPyramid(
+        std::vector<float> depth, std::size_t width, std::size_t height, const osg::Matrixd& viewProjection)
+        : mViewProjection(viewProjection)
+    {
+        assert(depth.size() == width * height);
+        if (width == 0 || height == 0)
+            return;
+
+        mLevels.push_back(Level{ width, height, std::move(depth) });
+        while (mLevels.back().mWidth > 1 || mLevels.back().mHeight > 1)
+        {
+            const Level& previous = mLevels.back();
+            Level level{ (previous.mWidth + 1) / 2, (previous.mHeight + 1) / 2, {} };
+            level.mDepth.resize(level.mWidth * level.mHeight);
+            for (std::size_t y = 0; y < level.mHeight; ++y)
+            {
+                const std::size_t y0 = y * 2;
+                const std::size_t y1 = std::min(y0 + 1, previous.mHeight - 1);
+                for (std::size_t x = 0; x < level.mWidth; ++x)
+                {
+                    const std::size_t x0 = x * 2;
+                    const std::size_t x1 = std::min(x0 + 1, previous.mWidth - 1);
+                    level.mDepth[y * level.mWidth + x] = std::max({ previous.mDepth[y0 * previous.mWidth + x0],
+                        previous.mDepth[y0 * previous.mWidth + x1], previous.mDepth[y1 * previous.mWidth + x0],
+                        previous.mDepth[y1 * previous.mWidth + x1] });
+                }
+            }
+            mLevels.push_back(std::move(level));
+        }
+    }
+
+    bool DepthPyramid::isOccluded(const osg::BoundingBox& box) const
+    {
+        if (mLevels.empty() || !box.valid())
+            return false;
+
+        const Level& base = mLevels.front();
+        double minX = std::numeric_limits<double>::max();
+        double minY = std::numeric_limits<double>::max();
+        double maxX = std::numeric_limits<double>::lowest();
+        double maxY = std::numeric_limits<double>::lowest();
+        double nearest = std::numeric_limits<double>::max();
+        for (unsigned int i = 0; i < 8; ++i)
+        {
+            const osg::Vec4d clip = osg::Vec4d(box.corner(i), 1) * mViewProjection;
+            // w is the distance from the camera plane
+            if (clip.w() <= 0)
+                return false;
+            const double x = (clip.x() / clip.w() * 0.5 + 0.5) * base.mWidth;
+            const double y = (clip.y() / clip.w() * 0.5 + 0.5) * base.mHeight;
+            minX = std::min(minX, x);
+            minY = std::min(minY, y);
+            maxX = std::max(maxX, x);
+            maxY = std::max(maxY, y);
+            nearest = std::min(nearest, clip.w());
+        }
+
+        // What is out of the view was not drawn
+        if (minX < 0 || minY < 0 || maxX >= base.mWidth || maxY >= base.mHeight)
+            return false;
+
+        // The first level the box covers at most 2x2 texels of
+        const double extent = std::max(maxX - minX, maxY - minY);
+        std::size_t levelIndex = 0;
+        while (levelIndex + 1 < mLevels.size() && extent > static_cast<double>(std::size_t(1) << levelIndex))
+            ++levelIndex;
+
+        const Level& level = mLevels[levelIndex];
+        const double scale = 1.0 / static_cast<double>(std::size_t(1) << levelIndex);
+        const std::size_t x0 = static_cast<std::size_t>(minX * scale);
+        const std::size_t y0 = static_cast<std::size_t>(minY * scale);
+        const std::size_t x1 = std::min(static_cast<std::size_t>(maxX * scale), level.mWidth - 1);
+        const std::size_t y1 = std::min(static_cast<std::size_t>(maxY * scale), level.mHeight - 1);
+        for (std::size_t y = y0; y <= y1; ++y)
+            for (std::size_t x = x0; x <= x1; ++x)
+                if (nearest <= level.mDepth[y * level.mWidth + x] * sDepthTolerance)
+                    return false;
+
+        return true;
+    }
+
+    float linearizeDepth(float depth, float near, float far, bool reversed)
+    {
+        if (reversed)
+            return far * near / (depth * (far - near) + near);
+        return far * near / (far - depth * (far - near));
+    }
+
+    std::vector<float> downsampleDepth(
+        std::span<const float> depth, std::size_t width, std::size_t height, std::size_t blockSize, bool reversed)
+    {
+        assert(depth.size() == width * height);
+        assert(blockSize > 0);
+        const std::size_t resultWidth = (width + blockSize - 1) / blockSize;
+        const std::size_t resultHeight = (height + blockSize - 1) / blockSize;
+        std::vector<float> result(resultWidth * resultHeight, reversed ? 1.f : 0.f);
+        for (std::size_t y = 0; y < height; ++y)
+        {
+            float* const row = result.data() + (y / blockSize) * resultWidth;
+            const float* const source = depth.data() + y * width;
+            for (std::size_t x = 0; x < width; ++x)
+            {
+                float& value = row[x / blockSize];
+                value = reversed ? std::min(value, source[x]) : std::max(value, source[x]);
+            }
+        }
+        return result;
+    }
+}
@@ -0,0 +1,54 @@
+#ifndef OPENMW_COMPONENTS_SCENEUTIL_DEPTHPYRAMID_H
+#define OPENMW_COMPONENTS_SCENEUTIL_DEPTHPYRAMID_H
+
+#include <osg/BoundingBox>
+#include <osg/Matrixd>
+
+#include <cstddef>
+#include <span>
+#include <vector>
+
+namespace SceneUtil
+{
+    /// @brief Mip chain of a depth buffer keeping the farthest depth of every 2x2 texels, to tell whether a box is
+    /// hidden behind what was drawn by looking at a few texels only.
+    /// @par Depth is stored as the distance from the camera plane, so it is independent of the depth range and of
+    /// whether the depth buffer is reversed.
+    class DepthPyramid
+    {
+    public:
+        /// @param depth distance from the camera plane of every texel, bottom row first as glReadPixels returns it
+        /// @param viewProjection transforms world space to the clip space of the perspective view the depth was
+        /// drawn with
+        DepthPyramid(
+            std::vector<float> depth, std::size_t width, std::size_t height, const osg::Matrixd& viewProjection);
+
+        std::size_t getNumLevels() const { return mLevels.size(); }
+
+        /// @return whether the whole box is behind the depth, boxes reaching out of the view or behind the camera
+        /// are never occluded
+        bool isOccluded(const osg::BoundingBox& box) const;
+
+    private:
+        struct Level
+        {
+            std::size_t mWidth;
+            std::size_t mHeight;
+            std::vector<float> mDepth;
+        };
+
+        std::vector<Level> mLevels;
+        osg::Matrixd mViewProjection;
+    };
+
+    /// @return the distance from the camera plane of a window space depth drawn with a perspective projection
+    /// @param reversed whether the depth was drawn with a reversed projection and [0, 1] clip depth range
+    float linearizeDepth(float depth, float near, float far, bool reversed);
+
+    /// @return the farthest depth of every blockSize x blockSize texels, the last blocks of a row or column can be
+    /// smaller
+    std::vector<float> downsampleDepth(
+        std::span<const float> depth, std::size_t width, std::size_t height, std::size_t blockSize, bool reversed);
+}
+
+#endif
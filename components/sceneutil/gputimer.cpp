@@ -0,0 +1,136 @@
+#include "gputimer.hpp"
+
+#include <osg/GLExtensions>
+#include <osg/State>
+#include <osg/Stats>
+#include <osg/observer_ptr>
+
+#include <map>
+#include <mutex>
+#include <vector>
+
+namespace SceneUtil
+{
+    namespace
+    {
+        struct Registry
+        {
+            std::mutex mMutex;
+            std::map<std::string, std::vector<osg::observer_ptr<GpuTimer>>, std::less<>> mTimers;
+        };
+
+        Registry& getRegistry()
+        {
+            static Registry registry;
+            return registry;
+        }
+    }
+
+    void GpuTimer::begin(osg::State& state)
+    {
+        const osg::GLExtensions* extensions = state.get<osg::GLExtensions>();
+        PerContext& context = mPerContext[state.getContextID()];
+        context.mStarted = false;
+        if (!extensions->isARBTimerQuerySupported)
+            return;
+
+        if (!context.mInitialized)
+        {
+            for (Query& query : context.mQueries)
+            {
+                extensions->glGenQueries(1, &query.mBegin);
+                extensions->glGenQueries(1, &query.mEnd);
+            }
+            context.mInitialized = true;
+        }
+
+        // Oldest first, so the latest available result is the one kept
+        for (std::size_t i = 0; i < sQueries; ++i)
+        {
+            Query& query = context.mQueries[(context.mCurrent + i) % sQueries];
+            if (!query.mPending)
+                continue;
+            GLint available = 0;
+            extensions->glGetQueryObjectiv(query.mEnd, GL_QUERY_RESULT_AVAILABLE, &available);
+            if (!available)
+                continue;
+            GLuint64 beginTime = 0;
+            GLuint64 endTime = 0;
+            extensions->glGetQueryObjectui64v(query.mBegin, GL_QUERY_RESULT, &beginTime);
+            extensions->glGetQueryObjectui64v(query.mEnd, GL_QUERY_RESULT, &endTime);
+            mDuration = endTime > beginTime ? static_cast<double>(endTime - beginTime) / 1e9 : 0.0;
+            query.mPending = false;
+        }
+
+        Query& query = context.mQueries[context.mCurrent];
+        if (query.mPending)
+            return;
+        extensions->glQueryCounter(query.mBegin, GL_TIMESTAMP);
+        context.mStarted = true;
+    }
+
+    void GpuTimer::end(osg::State& state)
+    {
+        PerContext& context = mPerContext[state.getContextID()];
+        if (!context.mStarted)
+            return;
+
+        Query& query = context.mQueries[context.mCurrent];
+        state.get<osg::GLExtensions>()->glQueryCounter(query.mEnd, GL_TIMESTAMP);
+        query.mPending = true;
+        context.mCurrent = (context.mCurrent + 1) % sQueries;
+        context.mStarted = false;
+    }
+
+    GpuTimerDrawCallback::GpuTimerDrawCallback(osg::ref_ptr<GpuTimer> timer, bool begin)
+        : mTimer(std::move(timer))
+        , mBegin(begin)
+    {
+    }
+
+    void GpuTimerDrawCallback::operator()(osg::RenderInfo& renderInfo) const
+    {
+        if (mBegin)
+            mTimer->begin(*renderInfo.getState());
+        else
+            mTimer->end(*renderInfo.getState());
+    }
+
+    osg::ref_ptr<GpuTimer> createGpuTimer(std::string_view statName)
+    {
+        osg::ref_ptr<GpuTimer> timer = new GpuTimer;
+        Registry& registry = getRegistry();
+        std::lock_guard<std::mutex> lock(registry.mMutex);
+        auto it = registry.mTimers.find(statName);
+        if (it == registry.mTimers.end())
+            it = registry.mTimers.emplace(statName, std::vector<osg::observer_ptr<GpuTimer>>()).first;
+        it->second.emplace_back(timer);
+        return timer;
+    }
+
+    void addGpuTimer(osg::Camera& camera, std::string_view statName)
+    {
+        osg::ref_ptr<GpuTimer> timer = createGpuTimer(statName);
+        camera.addPreDrawCallback(new GpuTimerDrawCallback(timer, true));
+        camera.addPostDrawCallback(new GpuTimerDrawCallback(timer, false));
+    }
+
+    void reportGpuTimers(unsigned int frameNumber, osg::Stats& stats)
+    {
+        Registry& registry = getRegistry();
+        std::lock_guard<std::mutex> lock(registry.mMutex);
+        for (auto& [statName, timers] : registry.mTimers)
+        {
+            double duration = 0;
+            std::erase_if(timers, [&](const osg::observer_ptr<GpuTimer>& timer) {
+                osg::ref_ptr<GpuTimer> locked;
+                if (!timer.lock(locked))
+                    return true;
+                duration += locked->getDuration();
+                return false;
+            });
+            if (!timers.empty())
+                stats.setAttribute(frameNumber, statName, duration * 1000);
+        }
+    }
+}
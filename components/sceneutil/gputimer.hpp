@@ -0,0 +1,84 @@
+#ifndef OPENMW_COMPONENTS_SCENEUTIL_GPUTIMER_H
+#define OPENMW_COMPONENTS_SCENEUTIL_GPUTIMER_H
+
+#include <osg/Camera>
+#include <osg/GL>
+#include <osg/Referenced>
+#include <osg/buffered_value>
+#include <osg/ref_ptr>
+
+#include <array>
+#include <atomic>
+#include <string>
+#include <string_view>
+
+namespace osg
+{
+    class State;
+    class Stats;
+}
+
+namespace SceneUtil
+{
+    /// @brief Measures how long the GPU spends on what is drawn between begin and end.
+    /// @par Timestamps are queried into a ring of query objects and read back once the driver reports them
+    /// available, so measuring never waits for the GPU. The measured duration lags a few frames behind, frames are
+    /// skipped while all queries are still pending.
+    /// @note begin and end have to be called from the draw thread, once per frame.
+    class GpuTimer : public osg::Referenced
+    {
+    public:
+        /// @return the last measured duration in seconds
+        double getDuration() const { return mDuration; }
+
+        void begin(osg::State& state);
+
+        void end(osg::State& state);
+
+    private:
+        static constexpr std::size_t sQueries = 4;
+
+        struct Query
+        {
+            GLuint mBegin = 0;
+            GLuint mEnd = 0;
+            bool mPending = false;
+        };
+
+        struct PerContext
+        {
+            std::array<Query, sQueries> mQueries;
+            std::size_t mCurrent = 0;
+            bool mInitialized = false;
+            bool mStarted = false;
+        };
+
+        osg::buffered_object<PerContext> mPerContext;
+        std::atomic<double> mDuration{ 0 };
+    };
+
+    /// @brief Calls GpuTimer::begin before and GpuTimer::end after the camera is drawn.
+    class GpuTimerDrawCallback : public osg::Camera::DrawCallback
+    {
+    public:
+        GpuTimerDrawCallback(osg::ref_ptr<GpuTimer> timer, bool begin);
+
+        void operator()(osg::RenderInfo& renderInfo) const override;
+
+    private:
+        osg::ref_ptr<GpuTimer> mTimer;
+        bool mBegin;
+    };
+
+    /// @return a new timer reported as the stat with the given name, the durations of every timer of a stat are
+    /// summed up
+    osg::ref_ptr<GpuTimer> createGpuTimer(std::string_view statName);
+
+    /// Measure the time spent on drawing the camera with a new timer of the stat.
+    void addGpuTimer(osg::Camera& camera, std::string_view statName);
+
+    /// Report the durations measured by the timers still in use in milliseconds.
+    void reportGpuTimers(unsigned int frameNumber, osg::Stats& stats);
+}
+
+#endif
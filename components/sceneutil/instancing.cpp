@@ -0,0 +1,219 @@
+#include "instancing.hpp"
+
+#include <osg/Geometry>
+#include <osg/Program>
+#include <osg/StateSet>
+#include <osg/VertexAttribDivisor>
+#include <osgUtil/CullVisitor>
+
+#include <cmath>
+
+namespace SceneUtil
+{
+    namespace
+    {
+        using value_type = osgUtil::CullVisitor::value_type;
+
+        // From OSG's CullVisitor.cpp
+        inline value_type distance(const osg::Vec3& coord, const osg::Matrix& matrix)
+        {
+            return -((value_type)coord[0] * (value_type)matrix(0, 2) + (value_type)coord[1] * (value_type)matrix(1, 2)
+                + (value_type)coord[2] * (value_type)matrix(2, 2) + matrix(3, 2));
+        }
+
+        bool hasUniformScale(const osg::Vec3f& scale)
+        {
+            constexpr float tolerance = 1e-3f;
+            return std::abs(scale.x() - scale.y()) <= tolerance * std::abs(scale.x())
+                && std::abs(scale.x() - scale.z()) <= tolerance * std::abs(scale.x());
+        }
+    }
+
+    void addBindInstancingAttribLocations(osg::Program& program)
+    {
+        program.addBindAttribLocation("instanceOffset", instanceOffsetAttribLocation);
+        program.addBindAttribLocation("instanceRotation", instanceRotationAttribLocation);
+    }
+
+    void setUpInstancingForStateSet(osg::StateSet& stateSet)
+    {
+        stateSet.setAttribute(new osg::VertexAttribDivisor(instanceOffsetAttribLocation, 1));
+        stateSet.setAttribute(new osg::VertexAttribDivisor(instanceRotationAttribLocation, 1));
+        stateSet.addUniform(new osg::Uniform("useInstancing", true));
+    }
+
+    bool makeInstanced(osg::Geometry& geometry, std::span<const osg::Matrixf> transforms)
+    {
+        osg::ref_ptr<osg::Vec4Array> offsets(new osg::Vec4Array(static_cast<unsigned>(transforms.size())));
+        osg::ref_ptr<osg::Vec4Array> rotations(new osg::Vec4Array(static_cast<unsigned>(transforms.size())));
+        const osg::BoundingBox originalBox = geometry.getBoundingBox();
+        const osg::BoundingSphere originalSphere(originalBox);
+        osg::BoundingBox box;
+        std::vector<osg::Matrix> instanceMatrices;
+        instanceMatrices.reserve(transforms.size());
+        for (std::size_t i = 0; i < transforms.size(); ++i)
+        {
+            osg::Vec3f translation;
+            osg::Quat rotation;
+            osg::Vec3f scale;
+            osg::Quat scaleOrientation;
+            transforms[i].decompose(translation, rotation, scale, scaleOrientation);
+            if (!hasUniformScale(scale) || scale.x() <= 0)
+                return false;
+
+            (*offsets)[i] = osg::Vec4f(translation, scale.x());
+            (*rotations)[i] = rotation.asVec4();
+
+            box.expandBy(osg::BoundingSphere(
+                originalSphere.center() * transforms[i], originalSphere.radius() * scale.x()));
+            instanceMatrices.emplace_back(transforms[i]);
+        }
+
+        for (unsigned int i = 0; i < geometry.getNumPrimitiveSets(); ++i)
+            geometry.getPrimitiveSet(i)->setNumInstances(static_cast<int>(transforms.size()));
+
+        // Display lists do not support instancing in OSG 3.4
+        geometry.setUseDisplayList(false);
+        geometry.setUseVertexBufferObjects(true);
+
+        // don't let the new arrays share a buffer object with arrays of the template geometry
+        osg::ref_ptr<osg::VertexBufferObject> vbo(new osg::VertexBufferObject);
+        offsets->setVertexBufferObject(vbo);
+        rotations->setVertexBufferObject(vbo);
+        geometry.setVertexAttribArray(instanceOffsetAttribLocation, offsets, osg::Array::BIND_PER_VERTEX);
+        geometry.setVertexAttribArray(instanceRotationAttribLocation, rotations, osg::Array::BIND_PER_VERTEX);
+
+        geometry.setInitialBound(box);
+        geometry.addCullCallback(new InstancedComputeNearFarCullCallback(std::move(instanceMatrices), originalBox));
+
+        return true;
+    }
+
+    bool InstancedComputeNearFarCullCallback::cull(
+        osg::NodeVisitor* nv, osg::Drawable* drawable, osg::RenderInfo* renderInfo) const
+    {
+        osgUtil::CullVisitor& cullVisitor = *nv->asCullVisitor();
+        osg::CullSettings::ComputeNearFarMode cnfMode = cullVisitor.getComputeNearFarMode();
+        const osg::BoundingBox& boundingBox = drawable->getBoundingBox();
+        osg::RefMatrix& matrix = *cullVisitor.getModelViewMatrix();
+
+        if (cnfMode != osg::CullSettings::COMPUTE_NEAR_FAR_USING_PRIMITIVES
+            && cnfMode != osg::CullSettings::COMPUTE_NEAR_USING_PRIMITIVES)
+            return false;
+
+        if (drawable->isCullingActive() && cullVisitor.isCulled(boundingBox))
+            return true;
+
+        osg::Vec3 lookVector = cullVisitor.getLookVectorLocal();
+        unsigned int bbCornerFar
+            = (lookVector.x() >= 0 ? 1 : 0) | (lookVector.y() >= 0 ? 2 : 0) | (lookVector.z() >= 0 ? 4 : 0);
+        unsigned int bbCornerNear = (~bbCornerFar) & 7;
+        value_type dNear = distance(boundingBox.corner(bbCornerNear), matrix);
+        value_type dFar = distance(boundingBox.corner(bbCornerFar), matrix);
+
+        if (dNear > dFar)
+            std::swap(dNear, dFar);
+
+        if (dFar < 0)
+            return true;
+
+        value_type computedZNear = cullVisitor.getCalculatedNearPlane();
+        value_type computedZFar = cullVisitor.getCalculatedFarPlane();
+
+        if (dNear < computedZNear || dFar > computedZFar)
+        {
+            osg::Polytope frustum;
+            osg::Polytope::ClippingMask resultMask
+                = cullVisitor.getCurrentCullingSet().getFrustum().getResultMask();
+            if (resultMask)
+            {
+                // Other objects are likely cheaper and should let us skip all but a few groundcover instances
+                cullVisitor.computeNearPlane();
+                computedZNear = cullVisitor.getCalculatedNearPlane();
+                computedZFar = cullVisitor.getCalculatedFarPlane();
+
+                if (dNear < computedZNear)
+                {
+                    dNear = computedZNear;
+                    for (const auto& instanceMatrix : mInstanceMatrices)
+                    {
+                        osg::Matrix fullMatrix = instanceMatrix * matrix;
+                        osg::Vec3d instanceLookVector(-fullMatrix(0, 2), -fullMatrix(1, 2), -fullMatrix(2, 2));
+                        unsigned int instanceBbCornerFar = (instanceLookVector.x() >= 0 ? 1 : 0)
+                            | (instanceLookVector.y() >= 0 ? 2 : 0) | (instanceLookVector.z() >= 0 ? 4 : 0);
+                        unsigned int instanceBbCornerNear = (~instanceBbCornerFar) & 7;
+                        value_type instanceDNear
+                            = distance(mInstanceBounds.corner(instanceBbCornerNear), fullMatrix);
+                        value_type instanceDFar
+                            = distance(mInstanceBounds.corner(instanceBbCornerFar), fullMatrix);
+
+                        if (instanceDNear > instanceDFar)
+                            std::swap(instanceDNear, instanceDFar);
+
+                        if (instanceDFar < 0 || instanceDNear > dNear)
+                            continue;
+
+                        frustum.setAndTransformProvidingInverse(
+                            cullVisitor.getProjectionCullingStack().back().getFrustum(), fullMatrix);
+                        osg::Polytope::PlaneList planes;
+                        osg::Polytope::ClippingMask selectorMask = 0x1;
+                        for (const auto& plane : frustum.getPlaneList())
+                        {
+                            if (resultMask & selectorMask)
+                                planes.push_back(plane);
+                            selectorMask <<= 1;
+                        }
+
+                        value_type newNear
+                            = cullVisitor.computeNearestPointInFrustum(fullMatrix, planes, *drawable);
+                        dNear = std::min(dNear, newNear);
+                    }
+                    if (dNear < computedZNear)
+                        cullVisitor.setCalculatedNearPlane(dNear);
+                }
+
+                if (cnfMode == osg::CullSettings::COMPUTE_NEAR_FAR_USING_PRIMITIVES && dFar > computedZFar)
+                {
+                    dFar = computedZFar;
+                    for (const auto& instanceMatrix : mInstanceMatrices)
+                    {
+                        osg::Matrix fullMatrix = instanceMatrix * matrix;
+                        osg::Vec3d instanceLookVector(-fullMatrix(0, 2), -fullMatrix(1, 2), -fullMatrix(2, 2));
+                        unsigned int instanceBbCornerFar = (instanceLookVector.x() >= 0 ? 1 : 0)
+                            | (instanceLookVector.y() >= 0 ? 2 : 0) | (instanceLookVector.z() >= 0 ? 4 : 0);
+                        unsigned int instanceBbCornerNear = (~instanceBbCornerFar) & 7;
+                        value_type instanceDNear
+                            = distance(mInstanceBounds.corner(instanceBbCornerNear), fullMatrix);
+                        value_type instanceDFar
+                            = distance(mInstanceBounds.corner(instanceBbCornerFar), fullMatrix);
+
+                        if (instanceDNear > instanceDFar)
+                            std::swap(instanceDNear, instanceDFar);
+
+                        if (instanceDFar < 0 || instanceDFar < dFar)
+                            continue;
+
+                        frustum.setAndTransformProvidingInverse(
+                            cullVisitor.getProjectionCullingStack().back().getFrustum(), fullMatrix);
+                        osg::Polytope::PlaneList planes;
+                        osg::Polytope::ClippingMask selectorMask = 0x1;
+                        for (const auto& plane : frustum.getPlaneList())
+                        {
+                            if (resultMask & selectorMask)
+                                planes.push_back(plane);
+                            selectorMask <<= 1;
+                        }
+
+                        value_type newFar = cullVisitor.computeFurthestPointInFrustum(
+                            instanceMatrix * matrix, planes, *drawable);
+                        dFar = std::max(dFar, newFar);
+                    }
+                    if (dFar > computedZFar)
+                        cullVisitor.setCalculatedFarPlane(dFar);
+                }
+            }
+        }
+
+        return false;
+    }
+}
@@ -0,0 +1,56 @@
+#ifndef OPENMW_COMPONENTS_SCENEUTIL_INSTANCING_H
+#define OPENMW_COMPONENTS_SCENEUTIL_INSTANCING_H
+
+#include <osg/BoundingBox>
+#include <osg/Drawable>
+#include <osg/Matrix>
+
+#include <span>
+#include <vector>
+
+namespace osg
+{
+    class Geometry;
+    class Program;
+    class StateSet;
+}
+
+namespace SceneUtil
+{
+    // The shadow casting shader reads instancing and skinning data from the same locations
+    inline constexpr unsigned instanceOffsetAttribLocation = 6;
+    inline constexpr unsigned instanceRotationAttribLocation = 7;
+
+    /// Bind the vertex attributes used by the instancing variant of the objects shaders.
+    void addBindInstancingAttribLocations(osg::Program& program);
+
+    /// Set up the attribute divisors and a uniform telling the shadow casting shader to apply instance
+    /// transforms.
+    void setUpInstancingForStateSet(osg::StateSet& stateSet);
+
+    /// Draw the geometry once per transform, every transform has to be a rotation, uniform scale and translation.
+    /// @note Primitive sets of the geometry are modified, so they must not be shared with other geometries.
+    /// @return false if some transform can't be represented, the geometry is left unchanged in this case.
+    bool makeInstanced(osg::Geometry& geometry, std::span<const osg::Matrixf> transforms);
+
+    /// Computes near and far planes for instanced geometry by considering every instance separately, the drawable
+    /// bounds only cover the area occupied by all instances.
+    class InstancedComputeNearFarCullCallback : public osg::DrawableCullCallback
+    {
+    public:
+        explicit InstancedComputeNearFarCullCallback(
+            std::vector<osg::Matrix>&& instanceMatrices, const osg::BoundingBox& instanceBounds)
+            : mInstanceMatrices(std::move(instanceMatrices))
+            , mInstanceBounds(instanceBounds)
+        {
+        }
+
+        bool cull(osg::NodeVisitor* nv, osg::Drawable* drawable, osg::RenderInfo* renderInfo) const override;
+
+    private:
+        std::vector<osg::Matrix> mInstanceMatrices;
+        osg::BoundingBox mInstanceBounds;
+    };
+}
+
+#endif
@@ -0,0 +1,73 @@
+#include "lightbvh.hpp"
+
+#include <algorithm>
+#include <numeric>
+
+namespace SceneUtil
+{
+    void LightBvh::build(std::span<const osg::BoundingSphere> bounds)
+    {
+        mNodes.clear();
+        mBounds.assign(bounds.begin(), bounds.end());
+        mIndices.resize(bounds.size());
+        std::iota(mIndices.begin(), mIndices.end(), std::size_t(0));
+        if (!bounds.empty())
+            buildNode(0, bounds.size());
+    }
+
+    bool LightBvh::intersects(const osg::BoundingBox& box, const osg::BoundingSphere& sphere)
+    {
+        float distance2 = 0;
+        for (int i = 0; i < 3; ++i)
+        {
+            const float delta
+                = std::max({ box._min[i] - sphere._center[i], sphere._center[i] - box._max[i], 0.f });
+            distance2 += delta * delta;
+        }
+        return distance2 <= sphere._radius * sphere._radius;
+    }
+
+    std::size_t LightBvh::buildNode(std::size_t first, std::size_t count)
+    {
+        const std::size_t index = mNodes.size();
+        Node& node = mNodes.emplace_back();
+        osg::BoundingBox centers;
+        for (std::size_t i = first; i < first + count; ++i)
+        {
+            node.mBounds.expandBy(mBounds[i]);
+            centers.expandBy(mBounds[i].center());
+        }
+
+        if (count <= sMaxLeafSize)
+        {
+            node.mFirst = first;
+            node.mCount = count;
+            return index;
+        }
+
+        // Split at the median of the centers along the longest axis
+        const osg::Vec3f extent = centers._max - centers._min;
+        const int axis = extent.x() >= extent.y() && extent.x() >= extent.z() ? 0 : (extent.y() >= extent.z() ? 1 : 2);
+        const std::size_t half = count / 2;
+        std::vector<std::size_t> order(count);
+        std::iota(order.begin(), order.end(), first);
+        std::nth_element(order.begin(), order.begin() + half, order.end(), [&](std::size_t left, std::size_t right) {
+            return mBounds[left]._center[axis] < mBounds[right]._center[axis];
+        });
+
+        std::vector<osg::BoundingSphere> bounds(count);
+        std::vector<std::size_t> indices(count);
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            bounds[i] = mBounds[order[i]];
+            indices[i] = mIndices[order[i]];
+        }
+        std::copy(bounds.begin(), bounds.end(), mBounds.begin() + first);
+        std::copy(indices.begin(), indices.end(), mIndices.begin() + first);
+
+        mNodes[index].mCount = 0;
+        buildNode(first, half);
+        mNodes[index].mFirst = buildNode(first + half, count - half);
+        return index;
+    }
+}
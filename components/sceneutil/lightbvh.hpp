@@ -0,0 +1,77 @@
+#ifndef OPENMW_COMPONENTS_SCENEUTIL_LIGHTBVH_H
+#define OPENMW_COMPONENTS_SCENEUTIL_LIGHTBVH_H
+
+#include <osg/BoundingBox>
+#include <osg/BoundingSphere>
+
+#include <cstddef>
+#include <span>
+#include <vector>
+
+namespace SceneUtil
+{
+    /// @brief Bounding volume hierarchy of light bounds, to find the lights reaching a node without testing every
+    /// light of the scene.
+    class LightBvh
+    {
+    public:
+        /// Replace the indexed bounds, the index of a bound in the span is the one reported by intersect.
+        void build(std::span<const osg::BoundingSphere> bounds);
+
+        /// Call the function with the index of every bound intersecting the sphere, in no particular order.
+        template <class Function>
+        void intersect(const osg::BoundingSphere& sphere, Function&& function) const
+        {
+            if (mNodes.empty() || !sphere.valid())
+                return;
+
+            std::size_t stack[sMaxDepth];
+            std::size_t size = 0;
+            stack[size++] = 0;
+            while (size > 0)
+            {
+                const std::size_t index = stack[--size];
+                const Node& node = mNodes[index];
+                if (!intersects(node.mBounds, sphere))
+                    continue;
+                if (node.mCount > 0)
+                {
+                    for (std::size_t i = node.mFirst; i < node.mFirst + node.mCount; ++i)
+                        if (mBounds[i].intersects(sphere))
+                            function(mIndices[i]);
+                    continue;
+                }
+                // The left child follows its parent
+                stack[size++] = node.mFirst;
+                stack[size++] = index + 1;
+            }
+        }
+
+        std::size_t size() const { return mIndices.size(); }
+
+    private:
+        static constexpr std::size_t sMaxLeafSize = 4;
+        // Every split halves the bounds, so it is deep enough for any number of bounds fitting in memory
+        static constexpr std::size_t sMaxDepth = 64;
+
+        struct Node
+        {
+            osg::BoundingBox mBounds;
+            // First bound of a leaf or right child of an inner node
+            std::size_t mFirst;
+            // Number of bounds of a leaf, 0 for an inner node
+            std::size_t mCount;
+        };
+
+        static bool intersects(const osg::BoundingBox& box, const osg::BoundingSphere& sphere);
+
+        std::size_t buildNode(std::size_t first, std::size_t count);
+
+        std::vector<Node> mNodes;
+        // Sorted by leaf
+        std::vector<osg::BoundingSphere> mBounds;
+        std::vector<std::size_t> mIndices;
+    };
+}
+
+#endif
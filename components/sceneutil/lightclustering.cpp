@@ -10,8 +10,6 @@ namespace SceneUtil
     const std::vector<int> LightClustering::sEmptyLightIndices;
 
     LightClustering::LightClustering()
-        : mScreenWidth(1920)
-        , mScreenHeight(1080)
     {
         loadSettings();
         initClusters();
@@ -19,8 +17,6 @@ namespace SceneUtil
 
     LightClustering::LightClustering(const Settings& settings)
         : mSettings(settings)
-        , mScreenWidth(1920)
-        , mScreenHeight(1080)
     {
         initClusters();
     }
@@ -28,7 +24,6 @@ namespace SceneUtil
     void LightClustering::loadSettings()
     {
         const auto& globalSettings = ::Settings::lightClustering();
-        mSettings.enabled = globalSettings.mEnabled;
         mSettings.clustersX = globalSettings.mClustersX;
         mSettings.clustersY = globalSettings.mClustersY;
         mSettings.clustersZ = globalSettings.mClustersZ;
@@ -41,35 +36,11 @@ namespace SceneUtil
     {
         int totalClusters = mSettings.clustersX * mSettings.clustersY * mSettings.clustersZ;
         mClusters.resize(totalClusters);
-
-        // Initialize uniforms
-        // Cluster info: (clustersX, clustersY, clustersZ, maxLightsPerCluster)
-        mClusterInfoUniform = new osg::Uniform(osg::Uniform::FLOAT_VEC4, "omw_ClusterInfo");
-        mClusterInfoUniform->set(osg::Vec4f(
-            static_cast<float>(mSettings.clustersX),
-            static_cast<float>(mSettings.clustersY),
-            static_cast<float>(mSettings.clustersZ),
-            static_cast<float>(mSettings.maxLightsPerCluster)
-        ));
-
-        // Light indices buffer (simplified - stores max lights per cluster for all clusters)
-        int maxIndices = totalClusters * mSettings.maxLightsPerCluster;
-        mClusterLightIndicesUniform = new osg::Uniform(osg::Uniform::INT, "omw_ClusterLightIndices", maxIndices);
-
-        // Light counts per cluster
-        mClusterLightCountsUniform = new osg::Uniform(osg::Uniform::INT, "omw_ClusterLightCounts", totalClusters);
     }
 
-    void LightClustering::updateClusters(const osg::Matrixf& viewMatrix, const osg::Matrixf& projMatrix,
-                                         float screenWidth, float screenHeight)
+    void LightClustering::updateClusters(const osg::Matrixf& projMatrix)
     {
-        if (!mSettings.enabled)
-            return;
-
-        mInvViewMatrix = osg::Matrixf::inverse(viewMatrix);
-        mInvProjMatrix = osg::Matrixf::inverse(projMatrix);
-        mScreenWidth = screenWidth;
-        mScreenHeight = screenHeight;
+        mProjMatrix = projMatrix;
 
         // Recalculate cluster bounds in view space
         for (int z = 0; z < mSettings.clustersZ; ++z)
@@ -107,18 +78,15 @@ namespace SceneUtil
         // Calculate view space corners
         osg::BoundingBoxf bounds;
 
-        // Transform corners from NDC to view space
-        auto transformCorner = [this](float ndcX, float ndcY, float depth) -> osg::Vec3f {
-            // For view space, we directly construct the position
-            // Using the inverse projection matrix
-            float ndcZ = 2.0f * (depth - mSettings.clusterNear) / (mSettings.clusterFar - mSettings.clusterNear) - 1.0f;
-            osg::Vec4f ndc(ndcX, ndcY, ndcZ, 1.0f);
-            osg::Vec4f view = ndc * mInvProjMatrix;
-            if (std::abs(view.w()) > 0.0001f)
-            {
-                view /= view.w();
-            }
-            return osg::Vec3f(view.x(), view.y(), view.z());
+        // Transform corners from NDC to view space at the given distance from the camera. Solving the projection for
+        // the view position does not depend on the depth range, so it also works for reversed and infinite depth.
+        const bool perspective = mProjMatrix(2, 3) != 0.0f;
+        auto transformCorner = [&](float ndcX, float ndcY, float depth) -> osg::Vec3f {
+            if (perspective)
+                return osg::Vec3f(depth * (ndcX + mProjMatrix(2, 0)) / mProjMatrix(0, 0),
+                    depth * (ndcY + mProjMatrix(2, 1)) / mProjMatrix(1, 1), -depth);
+            return osg::Vec3f((ndcX - mProjMatrix(3, 0)) / mProjMatrix(0, 0),
+                (ndcY - mProjMatrix(3, 1)) / mProjMatrix(1, 1), -depth);
         };
 
         // Add all 8 corners of the cluster frustum
@@ -165,9 +133,6 @@ namespace SceneUtil
 
     void LightClustering::assignLights(const std::vector<std::pair<osg::Vec3f, float>>& lightsViewSpace)
     {
-        if (!mSettings.enabled)
-            return;
-
         // Clear previous assignments
         for (auto& cluster : mClusters)
         {
@@ -183,8 +148,11 @@ namespace SceneUtil
             // We need to find all clusters whose bounds intersect the light sphere
 
             // Simple broad-phase: calculate Z range
-            float minDepth = -position.y() - radius; // View space Z is negative forward
-            float maxDepth = -position.y() + radius;
+            float minDepth = -position.z() - radius; // View space Z is negative forward
+            float maxDepth = -position.z() + radius;
+
+            if (maxDepth < 0)
+                continue;
 
             int minZ = depthToClusterZ(minDepth);
             int maxZ = depthToClusterZ(maxDepth);
@@ -254,37 +222,36 @@ namespace SceneUtil
         return mClusters[clusterIndex].lightIndices;
     }
 
-    void LightClustering::applyToUniforms(osg::StateSet* stateSet, size_t frame)
+    osg::Vec2f LightClustering::getDepthSlicing() const
     {
-        if (!mSettings.enabled || !stateSet)
-            return;
-
-        // Update cluster info uniform
-        mClusterInfoUniform->set(osg::Vec4f(
-            static_cast<float>(mSettings.clustersX),
-            static_cast<float>(mSettings.clustersY),
-            static_cast<float>(mSettings.clustersZ),
-            static_cast<float>(mSettings.maxLightsPerCluster)
-        ));
-
-        // Update light counts and indices
-        int totalClusters = getTotalClusters();
-        for (int i = 0; i < totalClusters; ++i)
-        {
-            const auto& lights = mClusters[i].lightIndices;
-            mClusterLightCountsUniform->setElement(i, static_cast<int>(lights.size()));
+        return osg::Vec2f(std::log(mSettings.clusterNear + 1.0f), std::log(mSettings.clusterFar + 1.0f));
+    }
 
-            int baseIdx = i * mSettings.maxLightsPerCluster;
-            for (size_t j = 0; j < lights.size() && j < static_cast<size_t>(mSettings.maxLightsPerCluster); ++j)
+    void LightClustering::getGridSize(int& width, int& height) const
+    {
+        width = mSettings.clustersX * (mSettings.maxLightsPerCluster + 1);
+        height = mSettings.clustersY * mSettings.clustersZ;
+    }
+
+    void LightClustering::writeGrid(osg::Image& image, std::span<const int> lightIndices) const
+    {
+        const int stride = mSettings.maxLightsPerCluster + 1;
+        for (int z = 0; z < mSettings.clustersZ; ++z)
+        {
+            for (int y = 0; y < mSettings.clustersY; ++y)
             {
-                mClusterLightIndicesUniform->setElement(baseIdx + static_cast<int>(j), lights[j]);
+                float* row = reinterpret_cast<float*>(image.data(0, z * mSettings.clustersY + y));
+                for (int x = 0; x < mSettings.clustersX; ++x)
+                {
+                    const std::vector<int>& lights = mClusters[getClusterIndex(x, y, z)].lightIndices;
+                    float* cell = row + x * stride;
+                    cell[0] = static_cast<float>(lights.size());
+                    for (std::size_t i = 0; i < lights.size(); ++i)
+                        cell[i + 1] = static_cast<float>(lightIndices[lights[i]]);
+                }
             }
         }
-
-        // Add uniforms to state set
-        stateSet->addUniform(mClusterInfoUniform);
-        stateSet->addUniform(mClusterLightCountsUniform);
-        stateSet->addUniform(mClusterLightIndicesUniform);
+        image.dirty();
     }
 
     void LightClustering::clear()
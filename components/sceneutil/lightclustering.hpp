@@ -1,29 +1,27 @@
 #ifndef OPENMW_COMPONENTS_SCENEUTIL_LIGHTCLUSTERING_H
 #define OPENMW_COMPONENTS_SCENEUTIL_LIGHTCLUSTERING_H
 
-#include <memory>
+#include <span>
+#include <utility>
 #include <vector>
 
 #include <osg/BoundingBox>
-#include <osg/Light>
+#include <osg/Image>
 #include <osg/Matrix>
+#include <osg/Vec2f>
 #include <osg/Vec3f>
-#include <osg/ref_ptr>
-#include <osg/Uniform>
-#include <osg/StateSet>
 
 namespace SceneUtil
 {
-    class LightSource;
-
     /// Cluster-based light culling system for improved lighting performance.
     /// Divides the view frustum into 3D cells (clusters) and assigns lights to each cluster.
+    /// @par Clusters are uniform in screen space and exponentially sliced in depth. The assignment is written into a
+    /// grid image, see writeGrid, which the shaders of the clustered lighting method index with the fragment position.
     class LightClustering
     {
     public:
         struct Settings
         {
-            bool enabled = true;
             int clustersX = 16;
             int clustersY = 9;
             int clustersZ = 24;
@@ -41,9 +39,8 @@ namespace SceneUtil
         LightClustering();
         explicit LightClustering(const Settings& settings);
 
-        /// Update cluster bounds based on camera matrices
-        void updateClusters(const osg::Matrixf& viewMatrix, const osg::Matrixf& projMatrix,
-                           float screenWidth, float screenHeight);
+        /// Update cluster bounds in view space based on the projection matrix
+        void updateClusters(const osg::Matrixf& projMatrix);
 
         /// Assign lights to clusters based on their positions and radii
         void assignLights(const std::vector<std::pair<osg::Vec3f, float>>& lightsViewSpace);
@@ -66,20 +63,16 @@ namespace SceneUtil
         /// Get settings
         const Settings& getSettings() const { return mSettings; }
 
-        /// Check if clustering is enabled
-        bool isEnabled() const { return mSettings.enabled; }
-
-        /// Apply cluster data to uniforms
-        void applyToUniforms(osg::StateSet* stateSet, size_t frame);
-
-        /// Get cluster info uniform for shader access
-        osg::Uniform* getClusterInfoUniform() { return mClusterInfoUniform.get(); }
+        /// Get logarithms of the slicing near and far planes as used by the shaders to find the depth slice
+        osg::Vec2f getDepthSlicing() const;
 
-        /// Get cluster light indices buffer
-        osg::Uniform* getClusterLightIndicesUniform() { return mClusterLightIndicesUniform.get(); }
+        /// Get size of the grid image
+        void getGridSize(int& width, int& height) const;
 
-        /// Get cluster light counts buffer
-        osg::Uniform* getClusterLightCountsUniform() { return mClusterLightCountsUniform.get(); }
+        /// Write assigned lights into a single channel float image of getGridSize.
+        /// @par Every cluster is a run of (maxLightsPerCluster + 1) texels in a row, the first one is the light count
+        /// followed by the light indices mapped through lightIndices. Rows are the Y clusters of every depth slice.
+        void writeGrid(osg::Image& image, std::span<const int> lightIndices) const;
 
         /// Clear all cluster assignments
         void clear();
@@ -88,15 +81,7 @@ namespace SceneUtil
         Settings mSettings;
 
         std::vector<ClusterData> mClusters;
-        osg::Matrixf mInvViewMatrix;
-        osg::Matrixf mInvProjMatrix;
-        float mScreenWidth;
-        float mScreenHeight;
-
-        // Uniform data for shader access
-        osg::ref_ptr<osg::Uniform> mClusterInfoUniform;
-        osg::ref_ptr<osg::Uniform> mClusterLightIndicesUniform;
-        osg::ref_ptr<osg::Uniform> mClusterLightCountsUniform;
+        osg::Matrixf mProjMatrix;
 
         static const std::vector<int> sEmptyLightIndices;
 
@@ -2,12 +2,14 @@
 
 #include <algorithm>
 #include <array>
+#include <cmath>
 #include <cstring>
 #include <iterator>
 
 #include <osg/BufferIndexBinding>
 #include <osg/BufferObject>
 #include <osg/Endian>
+#include <osg/Texture2D>
 #include <osg/ValueObject>
 
 #include <osgUtil/CullVisitor>
@@ -26,6 +28,9 @@ namespace
 {
     constexpr int ffpMaxLights = 8;
 
+    // World units a node has to move by to look up its lights again
+    constexpr float sMoveTolerance = 0.1f;
+
     void configurePosition(osg::Matrixf& mat, const osg::Vec4& pos)
     {
         mat(0, 0) = pos.x();
@@ -72,6 +77,7 @@ namespace SceneUtil
             { "legacy", LightingMethod::FFP },
             { "shaders compatibility", LightingMethod::PerObjectUniform },
             { "shaders", LightingMethod::SingleUBO },
+            { "shaders clustered", LightingMethod::Clustered },
         };
     }
 
@@ -270,6 +276,7 @@ namespace SceneUtil
                 break;
             }
             case LightingMethod::SingleUBO:
+            case LightingMethod::Clustered:
             {
                 osg::ref_ptr<LightBuffer> buffer = new LightBuffer(lightManager->getMaxLightsInScene());
 
@@ -628,7 +635,8 @@ namespace SceneUtil
         {
             osg::ref_ptr<osg::StateSet> stateset = new osg::StateSet;
 
-            if (node->getLightingMethod() == LightingMethod::SingleUBO)
+            if (node->getLightingMethod() == LightingMethod::SingleUBO
+                || node->getLightingMethod() == LightingMethod::Clustered)
             {
                 const size_t frameId = cv->getTraversalNumber() % 2;
                 stateset->setAttributeAndModes(mUBBs[frameId], osg::StateAttribute::ON);
@@ -642,6 +650,9 @@ namespace SceneUtil
                     buffer->setDiffuse(0, sun->getDiffuse());
                     buffer->setSpecular(0, sun->getSpecular());
                 }
+
+                if (node->getLightingMethod() == LightingMethod::Clustered)
+                    node->applyClusters(cv, stateset);
             }
             else if (node->getLightingMethod() == LightingMethod::PerObjectUniform)
             {
@@ -827,6 +838,7 @@ namespace SceneUtil
         mSupported[static_cast<int>(LightingMethod::FFP)] = true;
         mSupported[static_cast<int>(LightingMethod::PerObjectUniform)] = true;
         mSupported[static_cast<int>(LightingMethod::SingleUBO)] = supportsUBO && supportsGPU4;
+        mSupported[static_cast<int>(LightingMethod::Clustered)] = supportsUBO && supportsGPU4;
 
         setUpdateCallback(new LightManagerUpdateCallback);
 
@@ -838,7 +850,10 @@ namespace SceneUtil
         {
             static bool hasLoggedWarnings = false;
 
-            if (settings.mLightingMethod == LightingMethod::SingleUBO && !hasLoggedWarnings)
+            const bool requestsUBO = settings.mLightingMethod == LightingMethod::SingleUBO
+                || settings.mLightingMethod == LightingMethod::Clustered;
+
+            if (requestsUBO && !hasLoggedWarnings)
             {
                 if (!supportsUBO)
                     Log(Debug::Warning) << "GL_ARB_uniform_buffer_object not supported: switching to shader "
@@ -851,6 +866,8 @@ namespace SceneUtil
 
             if (!supportsUBO || !supportsGPU4 || settings.mLightingMethod == LightingMethod::PerObjectUniform)
                 initPerObjectUniform(settings.mMaxLights);
+            else if (settings.mLightingMethod == LightingMethod::Clustered && settings.mClusterTextureUnit >= 0)
+                initClustered(settings.mMaxLights, settings.mClustering, settings.mClusterTextureUnit);
             else
                 initSingleUBO(settings.mMaxLights);
 
@@ -910,13 +927,22 @@ namespace SceneUtil
         defines["maxLightsInScene"] = std::to_string(getMaxLightsInScene());
         defines["lightingMethodFFP"] = getLightingMethod() == LightingMethod::FFP ? "1" : "0";
         defines["lightingMethodPerObjectUniform"] = getLightingMethod() == LightingMethod::PerObjectUniform ? "1" : "0";
-        defines["lightingMethodUBO"] = getLightingMethod() == LightingMethod::SingleUBO ? "1" : "0";
-        defines["useUBO"] = std::to_string(getLightingMethod() == LightingMethod::SingleUBO);
-        // exposes bitwise operators
-        defines["useGPUShader4"] = std::to_string(getLightingMethod() == LightingMethod::SingleUBO);
+        // clustered lighting uses the same light buffer, only the way shaders pick the lights differs
+        const bool useUBO = getLightingMethod() == LightingMethod::SingleUBO
+            || getLightingMethod() == LightingMethod::Clustered;
+        defines["lightingMethodUBO"] = useUBO ? "1" : "0";
+        defines["lightingMethodClustered"] = getLightingMethod() == LightingMethod::Clustered ? "1" : "0";
+        defines["useUBO"] = std::to_string(useUBO);
+        // exposes bitwise operators and texelFetch
+        defines["useGPUShader4"] = std::to_string(useUBO);
         defines["getLight"] = getLightingMethod() == LightingMethod::FFP ? "gl_LightSource" : "LightBuffer";
-        defines["startLight"] = getLightingMethod() == LightingMethod::SingleUBO ? "0" : "1";
-        defines["endLight"] = getLightingMethod() == LightingMethod::FFP ? defines["maxLights"] : "PointLightCount";
+        defines["startLight"] = useUBO ? "0" : "1";
+        if (getLightingMethod() == LightingMethod::FFP)
+            defines["endLight"] = defines["maxLights"];
+        else if (getLightingMethod() == LightingMethod::Clustered)
+            defines["endLight"] = "clusterLightCount";
+        else
+            defines["endLight"] = "PointLightCount";
 
         return defines;
     }
@@ -978,6 +1004,15 @@ namespace SceneUtil
         getOrCreateStateSet()->setAttributeAndModes(mUBOManager);
     }
 
+    void LightManager::initClustered(int targetLights, const LightClustering::Settings& settings, int textureUnit)
+    {
+        initSingleUBO(targetLights);
+        setLightingMethod(LightingMethod::Clustered);
+
+        mClusterSettings = settings;
+        mClusterTextureUnit = textureUnit;
+    }
+
     void LightManager::setLightingMethod(LightingMethod method)
     {
         mLightingMethod = method;
@@ -987,6 +1022,7 @@ namespace SceneUtil
                 mStateSetGenerator = std::make_unique<StateSetGeneratorFFP>();
                 break;
             case LightingMethod::SingleUBO:
+            case LightingMethod::Clustered:
                 mStateSetGenerator = std::make_unique<StateSetGeneratorSingleUBO>();
                 break;
             case LightingMethod::PerObjectUniform:
@@ -1043,6 +1079,14 @@ namespace SceneUtil
             if (mStateSetCache[i].size() > 5000)
                 mStateSetCache[i].clear();
         }
+
+        for (auto it = mClusterGrids.begin(); it != mClusterGrids.end();)
+        {
+            if (it->first.valid())
+                ++it;
+            else
+                it = mClusterGrids.erase(it);
+        }
     }
 
     void LightManager::addLight(LightSource* lightSource, const osg::Matrixf& worldMat, size_t frameNum)
@@ -1080,6 +1124,8 @@ namespace SceneUtil
     osg::ref_ptr<osg::StateSet> LightManager::getLightListStateSet(
         const LightList& lightList, size_t frameNum, const osg::RefMatrix* viewMatrix)
     {
+        std::lock_guard<std::recursive_mutex> lock(mCullMutex);
+
         if (getLightingMethod() == LightingMethod::PerObjectUniform)
         {
             mStateSetGenerator->mViewMatrix = *viewMatrix;
@@ -1122,9 +1168,42 @@ namespace SceneUtil
         return stateset;
     }
 
-    const std::vector<LightManager::LightSourceViewBound>& LightManager::getLightsInViewSpace(
+    void LightManager::updateLightBvh()
+    {
+        std::vector<osg::BoundingSphere> bounds;
+        bounds.reserve(mLights.size());
+        for (const LightSourceTransform& transform : mLights)
+        {
+            osg::BoundingSphere bound(osg::Vec3f(), transform.mLightSource->getRadius() * mPointLightRadiusMultiplier);
+            transformBoundingSphere(transform.mWorldMatrix, bound);
+            bounds.push_back(bound);
+        }
+
+        const bool changed = bounds != mLightBvhBounds
+            || !std::equal(mLights.begin(), mLights.end(), mLightBvhSources.begin(), mLightBvhSources.end(),
+                [](const LightSourceTransform& transform, const LightSource* lightSource) {
+                    return transform.mLightSource == lightSource;
+                });
+        if (!changed)
+            return;
+
+        mLightBvhSources.clear();
+        for (const LightSourceTransform& transform : mLights)
+            mLightBvhSources.push_back(transform.mLightSource);
+        mLightBvhBounds = std::move(bounds);
+        mLightBvh.build(mLightBvhBounds);
+        ++mLightsVersion;
+    }
+
+    const LightManager::ViewLights& LightManager::getLightsInViewSpace(
         osgUtil::CullVisitor* cv, const osg::RefMatrix* viewMatrix, size_t frameNum)
     {
+        std::lock_guard<std::recursive_mutex> lock(mCullMutex);
+
+        // The lights of the frame are complete once the first view is culled
+        if (mLightsInViewSpace.empty())
+            updateLightBvh();
+
         osg::Camera* camera = cv->getCurrentCamera();
 
         osg::observer_ptr<osg::Camera> camPtr(camera);
@@ -1132,10 +1211,12 @@ namespace SceneUtil
 
         if (it == mLightsInViewSpace.end())
         {
-            it = mLightsInViewSpace.insert(std::make_pair(camPtr, LightSourceViewBoundCollection())).first;
+            it = mLightsInViewSpace.insert(std::make_pair(camPtr, ViewLights())).first;
+            std::vector<LightSourceViewBound>& lights = it->second.mLights;
 
-            for (const auto& transform : mLights)
+            for (std::size_t i = 0; i < mLights.size(); ++i)
             {
+                const LightSourceTransform& transform = mLights[i];
                 osg::Matrixf worldViewMat = transform.mWorldMatrix * (*viewMatrix);
 
                 float radius = transform.mLightSource->getRadius();
@@ -1160,12 +1241,14 @@ namespace SceneUtil
                 LightSourceViewBound l;
                 l.mLightSource = transform.mLightSource;
                 l.mViewBound = viewBound;
-                it->second.push_back(l);
+                l.mLightIndex = i;
+                lights.push_back(l);
             }
 
             const bool fillPPLights = mPPLightBuffer && it->first->getName() == Constants::SceneCamera;
-            const bool sceneLimitReached = getLightingMethod() == LightingMethod::SingleUBO
-                && it->second.size() > static_cast<size_t>(getMaxLightsInScene() - 1);
+            const bool sceneLimitReached = (getLightingMethod() == LightingMethod::SingleUBO
+                                               || getLightingMethod() == LightingMethod::Clustered)
+                && lights.size() > static_cast<size_t>(getMaxLightsInScene() - 1);
 
             if (fillPPLights || sceneLimitReached)
             {
@@ -1174,12 +1257,12 @@ namespace SceneUtil
                         < right.mViewBound.center().length2() - right.mViewBound.radius2();
                 };
 
-                std::sort(it->second.begin(), it->second.end(), sorter);
+                std::sort(lights.begin(), lights.end(), sorter);
 
                 if (fillPPLights)
                 {
                     osg::CullingSet& cullingSet = cv->getModelViewCullingStack().front();
-                    for (const auto& bound : it->second)
+                    for (const auto& bound : lights)
                     {
                         if (bound.mLightSource->getEmpty())
                             continue;
@@ -1198,8 +1281,13 @@ namespace SceneUtil
                 }
 
                 if (sceneLimitReached)
-                    it->second.resize(getMaxLightsInScene() - 1);
+                    lights.resize(getMaxLightsInScene() - 1);
             }
+
+            it->second.mIndices.assign(mLights.size(), -1);
+            for (std::size_t i = 0; i < lights.size(); ++i)
+                it->second.mIndices[lights[i].mLightIndex] = static_cast<int>(i);
+            it->second.mInverseViewMatrix = osg::Matrixd::inverse(*viewMatrix);
         }
 
         return it->second;
@@ -1219,6 +1307,96 @@ namespace SceneUtil
         buf->setPosition(index, light->getPosition() * (*viewMatrix));
     }
 
+    int LightManager::getLightBufferIndex(LightSource* lightSource, size_t frameNum, const osg::RefMatrix* viewMatrix)
+    {
+        LightIndexMap& lightIndexMap = getLightIndexMap(frameNum);
+        const auto it = lightIndexMap.find(lightSource->getId());
+        if (it != lightIndexMap.end())
+            return it->second;
+
+        // index 0 is reserved for the sun
+        const int index = static_cast<int>(lightIndexMap.size()) + 1;
+        if (index >= getMaxLightsInScene())
+            return -1;
+
+        updateGPUPointLight(index, lightSource, frameNum, viewMatrix);
+        lightIndexMap.emplace(lightSource->getId(), index);
+        return index;
+    }
+
+    struct LightManager::ClusterGrid
+    {
+        explicit ClusterGrid(const LightClustering::Settings& settings)
+            : mClustering(settings)
+        {
+            int width = 0;
+            int height = 0;
+            mClustering.getGridSize(width, height);
+
+            for (auto& texture : mTextures)
+            {
+                osg::ref_ptr<osg::Image> image = new osg::Image;
+                image->allocateImage(width, height, 1, GL_RED, GL_FLOAT);
+                image->setInternalTextureFormat(GL_R32F);
+                std::memset(image->data(), 0, image->getTotalSizeInBytes());
+                image->setDataVariance(osg::Object::DYNAMIC);
+
+                texture = new osg::Texture2D(image);
+                texture->setFilter(osg::Texture::MIN_FILTER, osg::Texture::NEAREST);
+                texture->setFilter(osg::Texture::MAG_FILTER, osg::Texture::NEAREST);
+                texture->setWrap(osg::Texture::WRAP_S, osg::Texture::CLAMP_TO_EDGE);
+                texture->setWrap(osg::Texture::WRAP_T, osg::Texture::CLAMP_TO_EDGE);
+                texture->setResizeNonPowerOfTwoHint(false);
+                texture->setDataVariance(osg::Object::DYNAMIC);
+            }
+        }
+
+        LightClustering mClustering;
+        // double buffered, since one of them may be in use by the draw thread at any given time
+        std::array<osg::ref_ptr<osg::Texture2D>, 2> mTextures;
+        std::vector<std::pair<osg::Vec3f, float>> mLights;
+        std::vector<int> mLightIndices;
+    };
+
+    void LightManager::applyClusters(osgUtil::CullVisitor* cv, osg::StateSet* stateset)
+    {
+        std::lock_guard<std::recursive_mutex> lock(mCullMutex);
+
+        const size_t frameNum = cv->getTraversalNumber();
+        // Don't use Camera::getViewMatrix, that one might be relative to another camera!
+        const osg::RefMatrix* viewMatrix = cv->getCurrentRenderStage()->getInitialViewMatrix();
+        const std::vector<LightSourceViewBound>& lights = getLightsInViewSpace(cv, viewMatrix, frameNum).mLights;
+
+        std::unique_ptr<ClusterGrid>& grid = mClusterGrids[osg::observer_ptr<osg::Camera>(cv->getCurrentCamera())];
+        if (grid == nullptr)
+            grid = std::make_unique<ClusterGrid>(mClusterSettings);
+
+        grid->mLights.clear();
+        grid->mLightIndices.clear();
+        for (const LightSourceViewBound& light : lights)
+        {
+            const int index = getLightBufferIndex(light.mLightSource, frameNum, viewMatrix);
+            if (index < 0)
+                break;
+            grid->mLights.emplace_back(light.mViewBound.center(), light.mViewBound.radius());
+            grid->mLightIndices.push_back(index);
+        }
+
+        grid->mClustering.updateClusters(*cv->getProjectionMatrix());
+        grid->mClustering.assignLights(grid->mLights);
+
+        osg::Texture2D* texture = grid->mTextures[frameNum % 2];
+        grid->mClustering.writeGrid(*texture->getImage(), grid->mLightIndices);
+
+        const LightClustering::Settings& settings = grid->mClustering.getSettings();
+        stateset->setTextureAttribute(mClusterTextureUnit, texture, osg::StateAttribute::ON);
+        stateset->addUniform(new osg::Uniform("omw_ClusterGrid", mClusterTextureUnit));
+        stateset->addUniform(new osg::Uniform("omw_ClusterInfo",
+            osg::Vec4f(static_cast<float>(settings.clustersX), static_cast<float>(settings.clustersY),
+                static_cast<float>(settings.clustersZ), static_cast<float>(settings.maxLightsPerCluster))));
+        stateset->addUniform(new osg::Uniform("omw_ClusterDepth", grid->mClustering.getDepthSlicing()));
+    }
+
     osg::ref_ptr<osg::Uniform> LightManager::generateLightBufferUniform(const osg::Matrixf& sun)
     {
         osg::ref_ptr<osg::Uniform> uniform = new osg::Uniform(osg::Uniform::FLOAT_MAT4, "LightBuffer", getMaxLights());
@@ -1266,6 +1444,9 @@ namespace SceneUtil
 
     bool LightListCallback::pushLightState(osg::Node* node, osgUtil::CullVisitor* cv)
     {
+        // The node may be culled by several views at once
+        std::lock_guard<std::mutex> lock(mMutex);
+
         if (!mLightManager)
         {
             mLightManager = findLightManager(cv->getNodePath());
@@ -1276,8 +1457,9 @@ namespace SceneUtil
         if (!(cv->getTraversalMask() & mLightManager->getLightingMask()))
             return false;
 
-        // Possible optimizations:
-        // - organize lights in a quad tree
+        // Shaders look up the lights in the cluster grid, there is nothing to do per object
+        if (mLightManager->getLightingMethod() == LightingMethod::Clustered)
+            return false;
 
         // Don't use Camera::getViewMatrix, that one might be relative to another camera!
         const osg::RefMatrix* viewMatrix = cv->getCurrentRenderStage()->getInitialViewMatrix();
@@ -1302,44 +1484,50 @@ namespace SceneUtil
 
             transformBoundingSphere(*cv->getModelViewMatrix(), nodeBound);
 
-            const std::vector<LightManager::LightSourceViewBound>& lights
+            const LightManager::ViewLights& lights
                 = mLightManager->getLightsInViewSpace(cv, viewMatrix, mLastFrameNumber);
 
-            mLightList.clear();
-            for (const LightManager::LightSourceViewBound& light : lights)
+            // Nodes are looked up in world space, so a node that did not move keeps its lights until a light moves
+            const osg::BoundingSphere worldBound(nodeBound.center() * lights.mInverseViewMatrix, nodeBound.radius());
+            if (mCandidatesVersion != mLightManager->getLightsVersion()
+                || (mCandidatesBound.center() - worldBound.center()).length2() > sMoveTolerance * sMoveTolerance
+                || std::abs(mCandidatesBound.radius() - worldBound.radius()) > sMoveTolerance)
             {
-                if (mIgnoredLightSources.contains(light.mLightSource))
-                    continue;
-
-                if (light.mViewBound.intersects(nodeBound))
-                    mLightList.push_back(&light);
+                mCandidatesVersion = mLightManager->getLightsVersion();
+                mCandidatesBound = worldBound;
+                mCandidates.clear();
+                mLightManager->getLightBvh().intersect(worldBound, [&](std::size_t index) {
+                    if (!mIgnoredLightSources.contains(mLightManager->getLightSource(index)))
+                        mCandidates.push_back(index);
+                });
+
+                // Prefer closer lights with larger radius
+                const auto distance2 = [&](std::size_t index) {
+                    return (worldBound.center() - mLightManager->getLightBound(index).center()).length2();
+                };
+                std::sort(mCandidates.begin(), mCandidates.end(), [&](std::size_t left, std::size_t right) {
+                    // A tricky way to compare normalized distance. This avoids division by near zero
+                    return mLightManager->getLightBound(left).radius() * distance2(right)
+                        > mLightManager->getLightBound(right).radius() * distance2(left);
+                });
             }
 
             size_t maxLights = mLightManager->getMaxLights() - mLightManager->getStartLight();
 
             // Virtual Lighting: Reduce light count for distant objects to improve performance in large scenes
             float dist = nodeBound.center().length();
-            if (dist > 3000.0f) 
+            if (dist > 3000.0f)
                 maxLights = std::min(maxLights, size_t(0));
             else if (dist > 1500.0f)
                 maxLights = std::min(maxLights, size_t(1));
-            else if (dist > 750.0f) 
+            else if (dist > 750.0f)
                 maxLights = std::min(maxLights, size_t(2));
 
-            if (mLightList.size() > maxLights)
-            {
-                // Sort by proximity to object: prefer closer lights with larger radius
-                std::sort(mLightList.begin(), mLightList.end(),
-                    [&](const SceneUtil::LightManager::LightSourceViewBound* left,
-                        const SceneUtil::LightManager::LightSourceViewBound* right) {
-                        const float leftDist = (nodeBound.center() - left->mViewBound.center()).length2();
-                        const float rightDist = (nodeBound.center() - right->mViewBound.center()).length2();
-                        // A tricky way to compare normalized distance. This avoids division by near zero
-                        return left->mViewBound.radius() * rightDist > right->mViewBound.radius() * leftDist;
-                    });
-
-                mLightList.resize(maxLights);
-            }
+            // Lights faded out in the view are skipped
+            mLightList.clear();
+            for (std::size_t i = 0; i < mCandidates.size() && mLightList.size() < maxLights; ++i)
+                if (const int index = lights.mIndices[mCandidates[i]]; index >= 0)
+                    mLightList.push_back(&lights.mLights[index]);
         }
 
         if (!mLightList.empty())
@@ -3,8 +3,10 @@
 
 #include <array>
 #include <memory>
+#include <mutex>
 #include <set>
 #include <unordered_map>
+#include <vector>
 
 #include <osg/Group>
 #include <osg/Light>
@@ -13,6 +15,8 @@
 
 #include <components/sceneutil/nodecallback.hpp>
 
+#include "lightbvh.hpp"
+#include "lightclustering.hpp"
 #include "lightingmethod.hpp"
 
 namespace SceneUtil
@@ -187,6 +191,9 @@ namespace SceneUtil
         float mMaximumLightDistance = 0;
         float mLightFadeStart = 0;
         float mLightBoundsMultiplier = 0;
+        LightClustering::Settings mClustering;
+        // Texture unit of the cluster grid, must be reserved for LightingMethod::Clustered
+        int mClusterTextureUnit = -1;
     };
 
     /// @brief Decorator node implementing the rendering of any number of LightSources that can be anywhere in the
@@ -208,10 +215,20 @@ namespace SceneUtil
         {
             LightSource* mLightSource;
             osg::BoundingSphere mViewBound;
+            // Index in the lights of the frame
+            std::size_t mLightIndex;
+        };
+
+        struct ViewLights
+        {
+            std::vector<LightSourceViewBound> mLights;
+            // Index in mLights of every light of the frame, -1 for the lights not lit in the view
+            std::vector<int> mIndices;
+            osg::Matrixd mInverseViewMatrix;
         };
 
         using LightList = std::vector<const LightSourceViewBound*>;
-        using SupportedMethods = std::array<bool, 3>;
+        using SupportedMethods = std::array<bool, 4>;
 
         META_Node(SceneUtil, LightManager)
 
@@ -237,12 +254,28 @@ namespace SceneUtil
         /// Internal use only, called automatically by the LightSource's UpdateCallback
         void addLight(LightSource* lightSource, const osg::Matrixf& worldMat, size_t frameNum);
 
-        const std::vector<LightSourceViewBound>& getLightsInViewSpace(
+        const ViewLights& getLightsInViewSpace(
             osgUtil::CullVisitor* cv, const osg::RefMatrix* viewMatrix, size_t frameNum);
 
+        /// @return the world space bounds of the lights of the frame, indexed like the lights of the frame
+        /// @note Only valid once getLightsInViewSpace was called in the frame.
+        const LightBvh& getLightBvh() const { return mLightBvh; }
+
+        LightSource* getLightSource(std::size_t index) const { return mLightBvhSources[index]; }
+
+        const osg::BoundingSphere& getLightBound(std::size_t index) const { return mLightBvhBounds[index]; }
+
+        /// @return a number changing whenever a light is added, removed or moved, so light lists of nodes that did
+        /// not move only need to be looked up again when it changes
+        std::size_t getLightsVersion() const { return mLightsVersion; }
+
         osg::ref_ptr<osg::StateSet> getLightListStateSet(
             const LightList& lightList, size_t frameNum, const osg::RefMatrix* viewMatrix);
 
+        /// Internal use only, called automatically by the LightManager's CullCallback for LightingMethod::Clustered.
+        /// Assigns the lights in view of the current camera to its cluster grid and adds the grid to \a stateset.
+        void applyClusters(osgUtil::CullVisitor* cv, osg::StateSet* stateset);
+
         void setSunlight(osg::ref_ptr<osg::Light> sun);
         osg::ref_ptr<osg::Light> getSunlight();
 
@@ -283,6 +316,7 @@ namespace SceneUtil
         void initFFP(int targetLights);
         void initPerObjectUniform(int targetLights);
         void initSingleUBO(int targetLights);
+        void initClustered(int targetLights, const LightClustering::Settings& settings, int textureUnit);
 
         void updateSettings(float lightBoundsMultiplier, float maximumLightDistance, float lightFadeStart);
 
@@ -292,10 +326,25 @@ namespace SceneUtil
         void updateGPUPointLight(
             int index, LightSource* lightSource, size_t frameNum, const osg::RefMatrix* viewMatrix);
 
+        /// @return index of the light in the light buffer of the frame, adding it when necessary, or -1 if the
+        /// buffer is full
+        int getLightBufferIndex(LightSource* lightSource, size_t frameNum, const osg::RefMatrix* viewMatrix);
+
+        /// Index the world space bounds of the lights of the frame, if they changed since the last frame.
+        void updateLightBvh();
+
         std::vector<LightSourceTransform> mLights;
 
-        using LightSourceViewBoundCollection = std::vector<LightSourceViewBound>;
-        std::map<osg::observer_ptr<osg::Camera>, LightSourceViewBoundCollection> mLightsInViewSpace;
+        // The lights and their world space bounds the BVH was built from
+        std::vector<LightSource*> mLightBvhSources;
+        std::vector<osg::BoundingSphere> mLightBvhBounds;
+        LightBvh mLightBvh;
+        std::size_t mLightsVersion = 1;
+
+        // Guards the per frame state built while culling, views may be culled in parallel
+        std::recursive_mutex mCullMutex;
+
+        std::map<osg::observer_ptr<osg::Camera>, ViewLights> mLightsInViewSpace;
 
         using LightIdList = std::vector<int>;
         struct HashLightIdList
@@ -334,6 +383,11 @@ namespace SceneUtil
         SupportedMethods mSupported;
 
         std::shared_ptr<PPLightBuffer> mPPLightBuffer;
+
+        struct ClusterGrid;
+        std::map<osg::observer_ptr<osg::Camera>, std::unique_ptr<ClusterGrid>> mClusterGrids;
+        LightClustering::Settings mClusterSettings;
+        int mClusterTextureUnit = -1;
     };
 
     /// To receive lighting, objects must be decorated by a LightListCallback. Light list callbacks must be added via
@@ -373,8 +427,14 @@ namespace SceneUtil
     private:
         LightManager* mLightManager;
         size_t mLastFrameNumber;
+        std::mutex mMutex;
         LightManager::LightList mLightList;
         std::set<SceneUtil::LightSource*> mIgnoredLightSources;
+
+        // Lights of the frame reaching the node, best first, valid as long as neither the node nor the lights moved
+        std::vector<std::size_t> mCandidates;
+        osg::BoundingSphere mCandidatesBound;
+        std::size_t mCandidatesVersion = 0;
     };
 
     void configureStateSetSunOverride(LightManager* lightManager, const osg::Light* light, osg::StateSet* stateset,
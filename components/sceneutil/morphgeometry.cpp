@@ -1,7 +1,11 @@
 #include "morphgeometry.hpp"
 
+#include <osg/Image>
+#include <osg/Program>
+
 #include <osgUtil/CullVisitor>
 
+#include <algorithm>
 #include <cassert>
 #include <components/resource/scenemanager.hpp>
 
@@ -21,6 +25,9 @@ namespace SceneUtil
         , mLastFrameNumber(0)
         , mDirty(true)
         , mMorphedBoundingBox(false)
+        , mGpuMorphing(copy.mGpuMorphing)
+        , mGpuMorphingTextureUnit(copy.mGpuMorphingTextureUnit)
+        , mGpuMorphData(copy.mGpuMorphData)
     {
         setSourceGeometry(copy.getSourceGeometry());
     }
@@ -28,10 +35,20 @@ namespace SceneUtil
     void MorphGeometry::setSourceGeometry(osg::ref_ptr<osg::Geometry> sourceGeom)
     {
         for (unsigned int i = 0; i < 2; ++i)
+        {
             mGeometry[i] = nullptr;
+            mMorphWeights[i] = nullptr;
+        }
 
         mSourceGeometry = sourceGeom;
 
+        if (mGpuMorphing && mGpuMorphData == nullptr)
+        {
+            mGpuMorphData = createGpuMorphData();
+            if (mGpuMorphData == nullptr)
+                mGpuMorphing = false;
+        }
+
         for (unsigned int i = 0; i < 2; ++i)
         {
             // DO NOT COPY AND PASTE THIS CODE. Cloning osg::Geometry without also cloning its contained Arrays is
@@ -49,6 +66,31 @@ namespace SceneUtil
             to.setUseVertexBufferObjects(true);
             to.setCullingActive(false); // make sure to disable culling since that's handled by this class
 
+            if (mGpuMorphing)
+            {
+                // vertices stay at the base positions, only the weights are per instance
+                to.setVertexArray(mGpuMorphData->mVertices);
+                to.setVertexAttribArray(
+                    sMorphTexCoordAttribLocation, mGpuMorphData->mTexCoords, osg::Array::BIND_PER_VERTEX);
+
+                const osg::Image& deltas = *mGpuMorphData->mDeltaMap->getImage();
+                osg::ref_ptr<osg::StateSet> stateSet = from.getStateSet() != nullptr
+                    ? new osg::StateSet(*from.getStateSet(), osg::CopyOp::SHALLOW_COPY)
+                    : new osg::StateSet;
+                mMorphWeights[i] = new osg::Uniform(osg::Uniform::FLOAT, "morphWeights", sMaxGpuMorphTargets);
+                stateSet->addUniform(mMorphWeights[i]);
+                stateSet->addUniform(new osg::Uniform("morphTargetCount", static_cast<int>(mMorphTargets.size() - 1)));
+                stateSet->addUniform(new osg::Uniform("morphDeltaMapParams",
+                    osg::Vec3f(1.f / deltas.s(), 1.f / deltas.t(), static_cast<float>(mGpuMorphData->mRowsPerTarget))));
+                stateSet->addUniform(new osg::Uniform("morphDeltaMap", mGpuMorphingTextureUnit));
+                stateSet->addUniform(new osg::Uniform("useMorphing", true));
+                stateSet->setTextureAttribute(mGpuMorphingTextureUnit, mGpuMorphData->mDeltaMap);
+                to.setStateSet(stateSet);
+
+                updateMorphWeights(i);
+                continue;
+            }
+
             // vertices are modified every frame, so we need to deep copy them.
             // assign a dedicated VBO to make sure that modifications don't interfere with source geometry's VBO.
             osg::ref_ptr<osg::VertexBufferObject> vbo(new osg::VertexBufferObject);
@@ -68,6 +110,11 @@ namespace SceneUtil
     {
         mMorphTargets.push_back(MorphTarget(offsets, weight));
         mMorphedBoundingBox = false;
+        if (mGpuMorphing)
+        {
+            mGpuMorphData = nullptr;
+            setSourceGeometry(mSourceGeometry);
+        }
         dirty();
     }
 
@@ -83,6 +130,82 @@ namespace SceneUtil
         return mSourceGeometry;
     }
 
+    bool MorphGeometry::setGpuMorphing(bool enabled, int textureUnit)
+    {
+        if (enabled == mGpuMorphing && (!enabled || textureUnit == mGpuMorphingTextureUnit))
+            return mGpuMorphing;
+        mGpuMorphing = enabled;
+        mGpuMorphingTextureUnit = textureUnit;
+        if (mSourceGeometry != nullptr)
+            setSourceGeometry(mSourceGeometry);
+        mDirty = true;
+        return mGpuMorphing;
+    }
+
+    void MorphGeometry::addBindMorphingAttribLocations(osg::Program& program)
+    {
+        program.addBindAttribLocation("morphTexCoord", sMorphTexCoordAttribLocation);
+    }
+
+    osg::ref_ptr<const MorphGeometry::GpuMorphData> MorphGeometry::createGpuMorphData() const
+    {
+        // the first morph target holds the base vertices, the shader only adds up the others
+        if (mMorphTargets.size() < 2 || mMorphTargets.size() - 1 > sMaxGpuMorphTargets || mSourceGeometry == nullptr)
+            return nullptr;
+
+        const osg::Vec3Array& base = *mMorphTargets[0].getOffsets();
+        const unsigned numVertices = base.getNumElements();
+        if (numVertices == 0 || numVertices != mSourceGeometry->getVertexArray()->getNumElements())
+            return nullptr;
+
+        // every morph target starts at a new row, so all targets share the texture coordinates of a vertex
+        const unsigned numTargets = static_cast<unsigned>(mMorphTargets.size() - 1);
+        const unsigned width = std::min(numVertices, sMaxGpuMorphDeltaMapSize);
+        const unsigned rowsPerTarget = (numVertices + width - 1) / width;
+        if (rowsPerTarget * numTargets > sMaxGpuMorphDeltaMapSize)
+            return nullptr;
+        for (unsigned i = 1; i <= numTargets; ++i)
+            if (mMorphTargets[i].getOffsets()->getNumElements() != numVertices)
+                return nullptr;
+
+        osg::ref_ptr<osg::Image> image(new osg::Image);
+        image->allocateImage(width, rowsPerTarget * numTargets, 1, GL_RGB, GL_FLOAT);
+        image->setInternalTextureFormat(GL_RGB32F_ARB);
+        osg::Vec3f* texels = reinterpret_cast<osg::Vec3f*>(image->data());
+        std::fill(texels, texels + width * rowsPerTarget * numTargets, osg::Vec3f());
+        for (unsigned i = 0; i < numTargets; ++i)
+        {
+            const osg::Vec3Array& offsets = *mMorphTargets[i + 1].getOffsets();
+            std::copy(offsets.begin(), offsets.end(), texels + i * rowsPerTarget * width);
+        }
+
+        osg::ref_ptr<osg::Texture2D> deltaMap(new osg::Texture2D(image));
+        deltaMap->setInternalFormat(GL_RGB32F_ARB);
+        deltaMap->setSourceFormat(GL_RGB);
+        deltaMap->setSourceType(GL_FLOAT);
+        deltaMap->setFilter(osg::Texture::MIN_FILTER, osg::Texture::NEAREST);
+        deltaMap->setFilter(osg::Texture::MAG_FILTER, osg::Texture::NEAREST);
+        deltaMap->setWrap(osg::Texture::WRAP_S, osg::Texture::CLAMP_TO_EDGE);
+        deltaMap->setWrap(osg::Texture::WRAP_T, osg::Texture::CLAMP_TO_EDGE);
+        deltaMap->setResizeNonPowerOfTwoHint(false);
+
+        osg::ref_ptr<osg::Vec2Array> texCoords(new osg::Vec2Array(numVertices));
+        for (unsigned vertex = 0; vertex < numVertices; ++vertex)
+            (*texCoords)[vertex].set(static_cast<float>(vertex % width), static_cast<float>(vertex / width));
+
+        osg::ref_ptr<osg::Vec3Array> vertices(new osg::Vec3Array(base));
+        osg::ref_ptr<osg::VertexBufferObject> vbo(new osg::VertexBufferObject);
+        vertices->setVertexBufferObject(vbo);
+        texCoords->setVertexBufferObject(vbo);
+
+        osg::ref_ptr<GpuMorphData> data(new GpuMorphData);
+        data->mVertices = std::move(vertices);
+        data->mTexCoords = std::move(texCoords);
+        data->mDeltaMap = std::move(deltaMap);
+        data->mRowsPerTarget = rowsPerTarget;
+        return data;
+    }
+
     void MorphGeometry::accept(osg::NodeVisitor& nv)
     {
         if (!nv.validNodeMask(*this))
@@ -172,19 +295,30 @@ namespace SceneUtil
 
     void MorphGeometry::cull(osg::NodeVisitor* nv)
     {
-        if (mLastFrameNumber == nv->getTraversalNumber() || !mDirty || mMorphTargets.size() == 0)
-        {
-            osg::Geometry& geom = *getGeometry(mLastFrameNumber);
-            nv->pushOntoNodePath(&geom);
-            nv->apply(geom);
-            nv->popFromNodePath();
-            return;
-        }
+        osg::Geometry& geom = update(nv->getTraversalNumber());
+        nv->pushOntoNodePath(&geom);
+        nv->apply(geom);
+        nv->popFromNodePath();
+    }
+
+    osg::Geometry& MorphGeometry::update(unsigned int traversalNumber)
+    {
+        // Views culled in parallel share the morphed geometry of the frame
+        std::lock_guard<std::mutex> lock(mCullMutex);
+
+        if (mLastFrameNumber == traversalNumber || !mDirty || mMorphTargets.size() == 0)
+            return *getGeometry(mLastFrameNumber);
 
         mDirty = false;
-        mLastFrameNumber = nv->getTraversalNumber();
+        mLastFrameNumber = traversalNumber;
         osg::Geometry& geom = *getGeometry(mLastFrameNumber);
 
+        if (mGpuMorphing)
+        {
+            updateMorphWeights(mLastFrameNumber);
+            return geom;
+        }
+
         const osg::Vec3Array* positionSrc = mMorphTargets[0].getOffsets();
         osg::Vec3Array* positionDst = static_cast<osg::Vec3Array*>(geom.getVertexArray());
         assert(positionSrc->size() == positionDst->size());
@@ -205,9 +339,14 @@ namespace SceneUtil
 
         geom.osg::Drawable::dirtyGLObjects();
 
-        nv->pushOntoNodePath(&geom);
-        nv->apply(geom);
-        nv->popFromNodePath();
+        return geom;
+    }
+
+    void MorphGeometry::updateMorphWeights(unsigned int frame) const
+    {
+        osg::Uniform& weights = *mMorphWeights[frame % 2];
+        for (unsigned int i = 1; i < mMorphTargets.size(); ++i)
+            weights.setElement(i - 1, mMorphTargets[i].getWeight());
     }
 
     osg::Geometry* MorphGeometry::getGeometry(unsigned int frame) const
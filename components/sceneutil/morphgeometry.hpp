@@ -2,6 +2,16 @@
 #define OPENMW_COMPONENTS_MORPHGEOMETRY_H
 
 #include <osg/Geometry>
+#include <osg/Texture2D>
+#include <osg/Uniform>
+
+#include <cstddef>
+#include <mutex>
+
+namespace osg
+{
+    class Program;
+}
 
 namespace SceneUtil
 {
@@ -10,9 +20,16 @@ namespace SceneUtil
     /// @note The internal Geometry used for rendering is double buffered, this allows updates to be done in a thread
     /// safe way while not compromising rendering performance. This is crucial when using osg's default threading model
     /// of DrawThreadPerContext.
+    /// @note With GPU morphing enabled the internal Geometry keeps the base vertices and only the weights are updated
+    /// per frame, the morph target deltas are read from a float texture by the vertex shader.
     class MorphGeometry : public osg::Drawable
     {
     public:
+        // Must match MAX_MORPH_TARGETS in lib/core/morphing.glsl
+        static constexpr std::size_t sMaxGpuMorphTargets = 32;
+        static constexpr unsigned sMaxGpuMorphDeltaMapSize = 4096;
+        static constexpr unsigned sMorphTexCoordAttribLocation = 6;
+
         MorphGeometry();
         MorphGeometry(const MorphGeometry& copy, const osg::CopyOp& copyop);
 
@@ -67,6 +84,17 @@ namespace SceneUtil
 
         osg::ref_ptr<osg::Geometry> getSourceGeometry() const;
 
+        /// Blend the morph targets in the vertex shader instead of on the CPU. The shader in use must support morphing.
+        /// @param textureUnit the texture unit the morph target deltas are bound to
+        /// @return Whether GPU morphing is used, which is not the case when there are too many morph targets or
+        /// vertices to fit into the delta texture.
+        bool setGpuMorphing(bool enabled, int textureUnit);
+
+        bool getGpuMorphing() const { return mGpuMorphing; }
+
+        /// Bind the vertex attributes used by GPU morphing.
+        static void addBindMorphingAttribLocations(osg::Program& program);
+
         void accept(osg::NodeVisitor& nv) override;
         bool supports(const osg::PrimitiveFunctor&) const override { return true; }
         void accept(osg::PrimitiveFunctor&) const override;
@@ -75,6 +103,20 @@ namespace SceneUtil
 
     private:
         void cull(osg::NodeVisitor* nv);
+        osg::Geometry& update(unsigned int traversalNumber);
+        void updateMorphWeights(unsigned int frame) const;
+
+        // Shared by all copies, the morph targets themselves are shared too
+        struct GpuMorphData : public osg::Referenced
+        {
+            // base vertices with a dedicated VBO
+            osg::ref_ptr<osg::Vec3Array> mVertices;
+            // texel of the vertex in the rows of the first morph target
+            osg::ref_ptr<osg::Vec2Array> mTexCoords;
+            osg::ref_ptr<osg::Texture2D> mDeltaMap;
+            unsigned mRowsPerTarget = 0;
+        };
+        osg::ref_ptr<const GpuMorphData> createGpuMorphData() const;
 
         MorphTargetList mMorphTargets;
 
@@ -84,9 +126,15 @@ namespace SceneUtil
         osg::Geometry* getGeometry(unsigned int frame) const;
 
         unsigned int mLastFrameNumber;
+        std::mutex mCullMutex;
         bool mDirty; // Have any morph targets changed?
 
         mutable bool mMorphedBoundingBox;
+
+        bool mGpuMorphing{ false };
+        int mGpuMorphingTextureUnit{ -1 };
+        osg::ref_ptr<const GpuMorphData> mGpuMorphData;
+        osg::ref_ptr<osg::Uniform> mMorphWeights[2];
     };
 
 }
@@ -18,6 +18,7 @@
 */
 
 #include "mwshadowtechnique.hpp"
+#include "gputimer.hpp"
 
 #include <osgShadow/ShadowedScene>
 #include <osg/CullFace>
@@ -26,10 +27,16 @@
 #include <osg/Depth>
 #include <osg/ClipControl>
 
+#include <cmath>
 #include <sstream>
 #include <vector>
 
+#include <components/misc/constants.hpp>
+
 #include "glextensions.hpp"
+#include "instancing.hpp"
+#include "morphgeometry.hpp"
+#include "riggeometry.hpp"
 #include "shadowsbin.hpp"
 
 // NOLINTBEGIN(readability-identifier-naming)
@@ -249,12 +256,16 @@ class VDSMCameraCullCallback : public osg::NodeCallback
         osg::RefMatrix* getProjectionMatrix() { return _projectionMatrix.get(); }
         osgUtil::RenderStage* getRenderStage() { return _renderStage.get(); }
 
+        void setStaticComposite(osg::Node* node, osg::StateSet* stateset) { _staticComposite = node; _staticCompositeStateSet = stateset; }
+
     protected:
 
         MWShadowTechnique*                      _vdsm;
         osg::ref_ptr<osg::RefMatrix>            _projectionMatrix;
         osg::ref_ptr<osgUtil::RenderStage>      _renderStage;
         osg::Polytope                           _polytope;
+        osg::ref_ptr<osg::Node>                 _staticComposite;
+        osg::ref_ptr<osg::StateSet>             _staticCompositeStateSet;
 };
 
 VDSMCameraCullCallback::VDSMCameraCullCallback(MWShadowTechnique* vdsm, osg::Polytope& polytope):
@@ -281,6 +292,14 @@ void VDSMCameraCullCallback::operator()(osg::Node* node, osg::NodeVisitor* nv)
         cv->pushCullingSet();
     }
 #endif
+    // the composite must stay out of the shadows bin, which would strip its state
+    if (_staticComposite)
+    {
+        cv->pushStateSet(_staticCompositeStateSet);
+        _staticComposite->accept(*nv);
+        cv->popStateSet();
+    }
+
     // bin has to go inside camera cull or the rendertexture stage will override it
     cv->pushStateSet(_vdsm->getOrCreateShadowsBinStateSet());
     if (_vdsm->getShadowedScene())
@@ -565,7 +584,8 @@ MWShadowTechnique::ShadowData::ShadowData(MWShadowTechnique::ViewDependentData*
 
     // set up the camera
     _camera = new osg::Camera;
-    _camera->setName("ShadowCamera");
+    _camera->setName(Constants::ShadowCamera);
+    SceneUtil::addGpuTimer(*_camera, "GPU Shadows");
     _camera->setReferenceFrame(osg::Camera::ABSOLUTE_RF_INHERIT_VIEWPOINT);
 #ifndef __APPLE__ // workaround shadow issue on macOS, https://gitlab.com/OpenMW/openmw/-/issues/6057
     _camera->setImplicitBufferAttachmentMask(0, 0);
@@ -624,6 +644,46 @@ void MWShadowTechnique::ShadowData::releaseGLObjects(osg::State* state) const
     OSG_INFO<<"MWShadowTechnique::ShadowData::releaseGLObjects"<<std::endl;
     _texture->releaseGLObjects(state);
     _camera->releaseGLObjects(state);
+    if (_staticComposite)
+        _staticComposite->releaseGLObjects(state);
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////
+//
+// StaticShadowData
+//
+MWShadowTechnique::StaticShadowData::StaticShadowData(int textureSize)
+{
+    _texture = new osg::Texture2D;
+    _texture->setTextureSize(textureSize, textureSize);
+    _texture->setInternalFormat(GL_DEPTH_COMPONENT);
+    // sampled as plain depth by the composite pass, interpolating between depths makes no sense
+    _texture->setFilter(osg::Texture2D::MIN_FILTER,osg::Texture2D::NEAREST);
+    _texture->setFilter(osg::Texture2D::MAG_FILTER,osg::Texture2D::NEAREST);
+    _texture->setWrap(osg::Texture2D::WRAP_S,osg::Texture2D::CLAMP_TO_EDGE);
+    _texture->setWrap(osg::Texture2D::WRAP_T,osg::Texture2D::CLAMP_TO_EDGE);
+
+    _camera = new osg::Camera;
+    _camera->setName(Constants::StaticShadowCamera);
+    SceneUtil::addGpuTimer(*_camera, "GPU Shadows");
+    _camera->setReferenceFrame(osg::Camera::ABSOLUTE_RF_INHERIT_VIEWPOINT);
+#ifndef __APPLE__ // workaround shadow issue on macOS, https://gitlab.com/OpenMW/openmw/-/issues/6057
+    _camera->setImplicitBufferAttachmentMask(0, 0);
+#endif
+    _camera->setComputeNearFarMode(osg::Camera::DO_NOT_COMPUTE_NEAR_FAR);
+    _camera->setCullingMode(_camera->getCullingMode() & ~osg::CullSettings::SMALL_FEATURE_CULLING);
+    _camera->setViewport(0, 0, textureSize, textureSize);
+    _camera->setClearMask(GL_DEPTH_BUFFER_BIT);
+    // has to be rendered before the shadow maps copying it
+    _camera->setRenderOrder(osg::Camera::PRE_RENDER, -1);
+    _camera->setRenderTargetImplementation(osg::Camera::FRAME_BUFFER_OBJECT);
+    _camera->attach(osg::Camera::DEPTH_BUFFER, _texture.get());
+}
+
+void MWShadowTechnique::StaticShadowData::releaseGLObjects(osg::State* state) const
+{
+    _texture->releaseGLObjects(state);
+    _camera->releaseGLObjects(state);
 }
 
 ///////////////////////////////////////////////////////////////////////////////////////////////
@@ -797,6 +857,8 @@ void MWShadowTechnique::ViewDependentData::releaseGLObjects(osg::State* state) c
     {
         (*itr)->releaseGLObjects(state);
     }
+    if (_staticShadowData)
+        _staticShadowData->releaseGLObjects(state);
 }
 
 ///////////////////////////////////////////////////////////////////////////////////////////////
@@ -919,12 +981,19 @@ void SceneUtil::MWShadowTechnique::setupCastingShader(Shader::ShaderManager & sh
 {
     // This can't be part of the constructor as OSG mandates that there be a trivial constructor available
 
+    // Skinning and instancing share the extra vertex attributes of the casting shader
+    static_assert(instanceOffsetAttribLocation == RigGeometry::sBoneIndicesAttribLocation);
+    static_assert(instanceRotationAttribLocation == RigGeometry::sBoneWeightsAttribLocation);
+    static_assert(MorphGeometry::sMorphTexCoordAttribLocation == RigGeometry::sBoneIndicesAttribLocation);
+
     osg::ref_ptr<osg::Shader> castingVertexShader = shaderManager.getShader("shadowcasting.vert");
     std::string useGPUShader4 = SceneUtil::getGLExtensions().isGpuShader4Supported ? "1" : "0";
     for (int alphaFunc = GL_NEVER; alphaFunc <= GL_ALWAYS; ++alphaFunc)
     {
         auto& program = _castingPrograms[alphaFunc - GL_NEVER];
         program = new osg::Program();
+        program->addBindAttribLocation("extraAttrib0", RigGeometry::sBoneIndicesAttribLocation);
+        program->addBindAttribLocation("extraAttrib1", RigGeometry::sBoneWeightsAttribLocation);
         program->addShader(castingVertexShader);
         program->addShader(shaderManager.getShader("shadowcasting.frag", { {"alphaFunc", std::to_string(alphaFunc)},
                                                                                     {"alphaToCoverage", "0"},
@@ -932,6 +1001,20 @@ void SceneUtil::MWShadowTechnique::setupCastingShader(Shader::ShaderManager & sh
                                                                                     {"useGPUShader4", useGPUShader4}
                                                                                   }));
     }
+
+    _staticCompositeProgram = shaderManager.getProgram("shadowcomposite");
+}
+
+void SceneUtil::MWShadowTechnique::setStaticShadowCastingMasks(unsigned int staticMask, unsigned int dynamicMask)
+{
+    _staticShadowCastingMask = staticMask;
+    _dynamicShadowCastingMask = dynamicMask;
+    invalidateStaticShadowCache();
+}
+
+void SceneUtil::MWShadowTechnique::setStaticShadowCacheResolution(int resolution)
+{
+    _staticShadowCacheResolution = resolution;
 }
 
 MWShadowTechnique::ViewDependentData* MWShadowTechnique::createViewDependentData(osgUtil::CullVisitor* /*cv*/)
@@ -1308,6 +1391,12 @@ void MWShadowTechnique::cull(osgUtil::CullVisitor& cv)
 
         }
 
+        // 3.3 render the static casters into their own shadow map if it is out of date
+        //
+        bool useStaticShadowMap = false;
+        if (_staticShadowCastingMask != 0 && pl.directionalLight && itr == pll.begin() && !settings->getDebugDraw())
+            useStaticShadowMap = updateStaticShadowMap(cv, *vdd, pl, maxZFar);
+
 #if 0
         double splitPoint = 0.0;
 
@@ -1503,12 +1592,24 @@ void MWShadowTechnique::cull(osgUtil::CullVisitor& cv)
             osg::ref_ptr<VDSMCameraCullCallback> vdsmCallback = new VDSMCameraCullCallback(this, local_polytope);
             camera->setCullCallback(vdsmCallback.get());
 
+            // 4.2 copy the static shadow map instead of rendering the static casters if it has no less detail
+            //
+            unsigned int castsShadowTraversalMask = settings->getCastsShadowTraversalMask();
+            osg::StateSet* staticCompositeStateSet = nullptr;
+            if (useStaticShadowMap
+                && cascadeFar / settings->getTextureSize().x() >= vdd->_staticShadowData->_halfExtent / _staticShadowCacheResolution)
+            {
+                staticCompositeStateSet = prepareStateSetForStaticShadowComposite(*sd, *vdd->_staticShadowData, cv.getTraversalNumber());
+                vdsmCallback->setStaticComposite(sd->_staticComposite, staticCompositeStateSet);
+                castsShadowTraversalMask &= _dynamicShadowCastingMask;
+            }
+
             // 4.3 traverse RTT camera
             //
 
             cv.pushStateSet(_shadowCastingStateSet.get());
 
-            cullShadowCastingScene(&cv, camera.get());
+            cullShadowCastingScene(&cv, camera.get(), castsShadowTraversalMask);
 
             cv.popStateSet();
 
@@ -1525,6 +1626,16 @@ void MWShadowTechnique::cull(osgUtil::CullVisitor& cv)
                     vdsmCallback->getProjectionMatrix()->set(camera->getProjectionMatrix());
                 }
             }
+
+            if (staticCompositeStateSet)
+            {
+                // the shadow camera matrices are final now, map its clip space to the one of the static shadow map
+                const osg::Camera& staticCamera = *vdd->_staticShadowData->_camera;
+                osg::Matrixd staticShadowMatrix = osg::Matrixd::inverse(camera->getViewMatrix() * camera->getProjectionMatrix())
+                    * staticCamera.getViewMatrix() * staticCamera.getProjectionMatrix();
+                staticCompositeStateSet->getUniform("staticShadowMatrix")->set(osg::Matrixf(staticShadowMatrix));
+                staticCompositeStateSet->getUniform("inverseStaticShadowMatrix")->set(osg::Matrixf(osg::Matrixd::inverse(staticShadowMatrix)));
+            }
  
             // 4.4 compute main scene graph TexGen + uniform settings + setup state
             //
@@ -1735,6 +1846,9 @@ void MWShadowTechnique::createShaders()
     _shadowCastingStateSet->setTextureAttribute(0, _fallbackBaseTexture.get(), osg::StateAttribute::ON);
     _shadowCastingStateSet->addUniform(new osg::Uniform("useDiffuseMapForShadowAlpha", true));
     _shadowCastingStateSet->addUniform(new osg::Uniform("alphaTestShadows", false));
+    _shadowCastingStateSet->addUniform(new osg::Uniform("useSkinning", false));
+    _shadowCastingStateSet->addUniform(new osg::Uniform("useInstancing", false));
+    _shadowCastingStateSet->addUniform(new osg::Uniform("useMorphing", false));
     osg::ref_ptr<osg::Depth> depth = new osg::Depth;
     depth->setWriteMask(true);
     osg::ref_ptr<osg::ClipControl> clipcontrol = new osg::ClipControl(osg::ClipControl::LOWER_LEFT, osg::ClipControl::NEGATIVE_ONE_TO_ONE);
@@ -3120,14 +3234,14 @@ void MWShadowTechnique::cullShadowReceivingScene(osgUtil::CullVisitor* cv) const
     return;
 }
 
-void MWShadowTechnique::cullShadowCastingScene(osgUtil::CullVisitor* cv, osg::Camera* camera) const
+void MWShadowTechnique::cullShadowCastingScene(osgUtil::CullVisitor* cv, osg::Camera* camera, unsigned int castsShadowTraversalMask) const
 {
     OSG_INFO<<"cullShadowCastingScene()"<<std::endl;
 
     // record the traversal mask on entry so we can reapply it later.
     unsigned int traversalMask = cv->getTraversalMask();
 
-    cv->setTraversalMask( traversalMask & _shadowedScene->getShadowSettings()->getCastsShadowTraversalMask() );
+    cv->setTraversalMask( traversalMask & castsShadowTraversalMask );
 
         if (camera) camera->accept(*cv);
 
@@ -3136,6 +3250,96 @@ void MWShadowTechnique::cullShadowCastingScene(osgUtil::CullVisitor* cv, osg::Ca
     return;
 }
 
+bool MWShadowTechnique::updateStaticShadowMap(osgUtil::CullVisitor& cv, ViewDependentData& vdd, LightData& positionedLight, double radius)
+{
+    if (!_staticCompositeProgram || !(radius < dbl_max))
+        return false;
+
+    if (!vdd._staticShadowData)
+        vdd._staticShadowData = new StaticShadowData(_staticShadowCacheResolution);
+
+    StaticShadowData& ssd = *vdd._staticShadowData;
+
+    // any point within the shadow map distance stays covered until the camera moves by half of it
+    const double halfExtent = radius * 1.5;
+    const osg::Vec3d eye = osg::Matrixd::inverse(*cv.getModelViewMatrix()).getTrans();
+    const unsigned int revision = _staticShadowCacheRevision;
+    const double maxLightAngleCos = std::cos(osg::DegreesToRadians(0.25));
+
+    if (ssd._valid && ssd._revision == revision && ssd._lightDir * positionedLight.lightDir >= maxLightAngleCos
+        && std::abs(ssd._halfExtent - halfExtent) <= halfExtent * 0.1 && (eye - ssd._center).length() <= radius * 0.5)
+        return true;
+
+    OSG_INFO<<"Updating static shadow map"<<std::endl;
+
+    const osg::Vec3d& lightDir = positionedLight.lightDir;
+    const osg::Vec3d up = std::abs(lightDir.z()) < 0.99 ? osg::Vec3d(0.0, 0.0, 1.0) : osg::Vec3d(0.0, 1.0, 0.0);
+    osg::Matrixd viewMatrix = osg::Matrixd::lookAt(osg::Vec3d(), lightDir, up);
+
+    // snap to texels so the static casters do not shimmer whenever the map is updated
+    const double texelSize = 2.0 * halfExtent / _staticShadowCacheResolution;
+    osg::Vec3d center = eye * viewMatrix;
+    center.x() = std::floor(center.x() / texelSize) * texelSize;
+    center.y() = std::floor(center.y() / texelSize) * texelSize;
+
+    // casters anywhere along the light direction can shadow the covered area
+    const osg::BoundingSphere& bs = _shadowedScene->getBound();
+    const double boundCenterZ = (osg::Vec3d(bs.center()) * viewMatrix).z();
+    const double zNear = -boundCenterZ - bs.radius();
+    const double zFar = -boundCenterZ + bs.radius();
+    if (!bs.valid() || zFar <= zNear)
+        return false;
+
+    ssd._camera->setViewMatrix(viewMatrix);
+    ssd._camera->setProjectionMatrix(osg::Matrixd::ortho(center.x() - halfExtent, center.x() + halfExtent,
+        center.y() - halfExtent, center.y() + halfExtent, zNear, zFar));
+
+    osg::Polytope polytope;
+    ssd._camera->setCullCallback(new VDSMCameraCullCallback(this, polytope));
+
+    cv.pushStateSet(_shadowCastingStateSet.get());
+
+    cullShadowCastingScene(&cv, ssd._camera.get(), _shadowedScene->getShadowSettings()->getCastsShadowTraversalMask() & _staticShadowCastingMask);
+
+    cv.popStateSet();
+
+    ssd._lightDir = lightDir;
+    ssd._center = eye;
+    ssd._halfExtent = halfExtent;
+    ssd._revision = revision;
+    ssd._valid = true;
+
+    return true;
+}
+
+osg::StateSet* MWShadowTechnique::prepareStateSetForStaticShadowComposite(ShadowData& sd, const StaticShadowData& ssd, unsigned int traversalNumber)
+{
+    if (!sd._staticComposite)
+    {
+        // already in clip space, the vertex shader passes positions through
+        sd._staticComposite = osg::createTexturedQuadGeometry(osg::Vec3(-1.0f, -1.0f, 0.0f), osg::Vec3(2.0f, 0.0f, 0.0f), osg::Vec3(0.0f, 2.0f, 0.0f));
+        sd._staticComposite->setUseDisplayList(false);
+        sd._staticComposite->setUseVertexBufferObjects(true);
+        sd._staticComposite->setCullingActive(false);
+
+        for (auto& stateset : sd._staticCompositeStateSet)
+        {
+            stateset = new osg::StateSet;
+            stateset->setAttribute(_staticCompositeProgram, osg::StateAttribute::ON | osg::StateAttribute::OVERRIDE | osg::StateAttribute::PROTECTED);
+            stateset->setTextureAttribute(0, ssd._texture, osg::StateAttribute::ON | osg::StateAttribute::OVERRIDE | osg::StateAttribute::PROTECTED);
+            stateset->setMode(GL_CULL_FACE, osg::StateAttribute::OFF | osg::StateAttribute::OVERRIDE | osg::StateAttribute::PROTECTED);
+            stateset->setMode(GL_POLYGON_OFFSET_FILL, osg::StateAttribute::OFF | osg::StateAttribute::OVERRIDE | osg::StateAttribute::PROTECTED);
+            stateset->addUniform(new osg::Uniform("staticShadowTexture", 0));
+            stateset->addUniform(new osg::Uniform(osg::Uniform::FLOAT_MAT4, "staticShadowMatrix"));
+            stateset->addUniform(new osg::Uniform(osg::Uniform::FLOAT_MAT4, "inverseStaticShadowMatrix"));
+            // draw before any of the dynamic casters
+            stateset->setRenderBinDetails(-1, "RenderBin", osg::StateSet::OVERRIDE_PROTECTED_RENDERBIN_DETAILS);
+        }
+    }
+
+    return sd._staticCompositeStateSet[traversalNumber % 2];
+}
+
 osg::StateSet* MWShadowTechnique::prepareStateSetForRenderingShadow(ViewDependentData& vdd, unsigned int traversalNumber) const
 {
     OSG_INFO<<"   prepareStateSetForRenderingShadow() "<<vdd.getStateSet(traversalNumber)<<std::endl;
@@ -21,10 +21,12 @@
 #define COMPONENTS_SCENEUTIL_MWSHADOWTECHNIQUE_H 1
 
 #include <array>
+#include <atomic>
 #include <mutex>
 #include <string>
 
 #include <osg/Camera>
+#include <osg/Geometry>
 #include <osg/Material>
 #include <osg/MatrixTransform>
 #include <osg/LightSource>
@@ -90,6 +92,16 @@ namespace SceneUtil {
 
         virtual void setupCastingShader(Shader::ShaderManager &shaderManager);
 
+        /** Enable the static shadow cache. Casters matching staticMask are rendered into a separate shadow map which is only
+        * updated when needed, shadow maps using the cache then only traverse casters matching dynamicMask.
+        * Passing a zero staticMask disables the cache. */
+        virtual void setStaticShadowCastingMasks(unsigned int staticMask, unsigned int dynamicMask);
+
+        virtual void setStaticShadowCacheResolution(int resolution);
+
+        /** Request the static shadow map to be rendered again, e.g. when cells or paged objects change. */
+        void invalidateStaticShadowCache() { ++_staticShadowCacheRevision; }
+
         class ComputeLightSpaceBounds : public osg::NodeVisitor, public osg::CullStack
         {
         public:
@@ -198,10 +210,31 @@ namespace SceneUtil {
             unsigned int                        _sm_i;
             osg::ref_ptr<osg::Texture2D>        _texture;
             osg::ref_ptr<osg::Camera>           _camera;
+
+            // Fullscreen pass copying the static shadow map into this one, created on first use
+            osg::ref_ptr<osg::Geometry>         _staticComposite;
+            std::array<osg::ref_ptr<osg::StateSet>, 2> _staticCompositeStateSet;
         };
 
         typedef std::list< osg::ref_ptr<ShadowData> > ShadowDataList;
 
+        /** Orthographic shadow map of the static casters around the camera, rendered only when it gets out of date. */
+        struct StaticShadowData : public osg::Referenced
+        {
+            StaticShadowData(int textureSize);
+
+            virtual void releaseGLObjects(osg::State* = 0) const;
+
+            osg::ref_ptr<osg::Texture2D>        _texture;
+            osg::ref_ptr<osg::Camera>           _camera;
+
+            osg::Vec3d                          _lightDir;
+            osg::Vec3d                          _center;
+            double                              _halfExtent = 0.0;
+            unsigned int                        _revision = 0;
+            bool                                _valid = false;
+        };
+
 
         class ViewDependentData : public osg::Referenced
         {
@@ -233,6 +266,7 @@ namespace SceneUtil {
             LightDataList               _lightDataList;
             ShadowDataList              _shadowDataList;
             std::array<Uniforms, 2>     _uniforms;
+            osg::ref_ptr<StaticShadowData> _staticShadowData;
 
             unsigned int _numValidShadows;
         };
@@ -265,7 +299,11 @@ namespace SceneUtil {
 
         virtual void cullShadowReceivingScene(osgUtil::CullVisitor* cv) const;
 
-        virtual void cullShadowCastingScene(osgUtil::CullVisitor* cv, osg::Camera* camera) const;
+        virtual void cullShadowCastingScene(osgUtil::CullVisitor* cv, osg::Camera* camera, unsigned int castsShadowTraversalMask) const;
+
+        virtual bool updateStaticShadowMap(osgUtil::CullVisitor& cv, ViewDependentData& vdd, LightData& positionedLight, double radius);
+
+        virtual osg::StateSet* prepareStateSetForStaticShadowComposite(ShadowData& sd, const StaticShadowData& ssd, unsigned int traversalNumber);
 
         virtual osg::StateSet* prepareStateSetForRenderingShadow(ViewDependentData& vdd, unsigned int traversalNumber) const;
 
@@ -309,6 +347,12 @@ namespace SceneUtil {
 
         unsigned int                            _worldMask = ~0u;
 
+        unsigned int                            _staticShadowCastingMask = 0;
+        unsigned int                            _dynamicShadowCastingMask = ~0u;
+        int                                     _staticShadowCacheResolution = 4096;
+        std::atomic<unsigned int>               _staticShadowCacheRevision = 0;
+        osg::ref_ptr<osg::Program>              _staticCompositeProgram;
+
         class DebugHUD final : public osg::Referenced
         {
         public:
@@ -0,0 +1,222 @@
+#include "occlusionculling.hpp"
+
+#include <osg/Camera>
+#include <osg/FrameStamp>
+#include <osg/GLExtensions>
+#include <osg/State>
+#include <osg/Transform>
+#include <osgUtil/CullVisitor>
+
+#include <algorithm>
+#include <cmath>
+#include <span>
+#include <vector>
+
+#include "depth.hpp"
+#include "depthpyramid.hpp"
+
+namespace SceneUtil
+{
+    namespace
+    {
+        // Width of the first pyramid level, the depth read back is reduced to it
+        constexpr std::size_t sPyramidWidth = 256;
+        // Frames a pyramid is culled against at most, what is older is too likely to hide something that moved
+        constexpr unsigned int sMaxPyramidAge = 4;
+        // World units a box has to change by to count as moved
+        constexpr float sMoveTolerance = 0.01f;
+
+        bool hasMoved(const osg::BoundingBox& last, const osg::BoundingBox& current)
+        {
+            for (int i = 0; i < 3; ++i)
+                if (std::abs(last._min[i] - current._min[i]) > sMoveTolerance
+                    || std::abs(last._max[i] - current._max[i]) > sMoveTolerance)
+                    return true;
+            return false;
+        }
+    }
+
+    OcclusionCulling::OcclusionCulling() = default;
+
+    OcclusionCulling::~OcclusionCulling() = default;
+
+    void OcclusionCulling::beginCull(const osg::Camera& camera, unsigned int frameNumber)
+    {
+        mCullCamera = &camera;
+        mCullInverseView = camera.getInverseViewMatrix();
+
+        Frame frame{ frameNumber, camera.getViewMatrix() * camera.getProjectionMatrix(), 0, 0 };
+        double fovy = 0;
+        double aspect = 0;
+        const bool perspective = camera.getProjectionMatrix().getPerspective(fovy, aspect, frame.mNear, frame.mFar);
+
+        std::lock_guard<std::mutex> lock(mMutex);
+        if (perspective)
+            mFrames[frameNumber % sFrames] = frame;
+        if (mPyramid != nullptr && frameNumber - mPyramidFrameNumber <= sMaxPyramidAge)
+        {
+            mCullPyramid = mPyramid;
+            mCullPyramidFrameNumber = mPyramidFrameNumber;
+        }
+        else
+            mCullPyramid = nullptr;
+    }
+
+    void OcclusionCulling::capture(osg::State& state, std::size_t width, std::size_t height)
+    {
+        const osg::GLExtensions* extensions = state.get<osg::GLExtensions>();
+        if (!extensions->isPBOSupported || extensions->glFenceSync == nullptr || width == 0 || height == 0)
+            return;
+
+        PerContext& context = mPerContext[state.getContextID()];
+
+        // Reduce the latest depth the GPU is done with, the older ones are not needed anymore
+        Readback* latest = nullptr;
+        for (Readback& readback : context.mReadbacks)
+        {
+            if (readback.mSync == nullptr)
+                continue;
+            const GLenum status = extensions->glClientWaitSync(readback.mSync, 0, 0);
+            if (status != GL_ALREADY_SIGNALED && status != GL_CONDITION_SATISFIED)
+                continue;
+            extensions->glDeleteSync(readback.mSync);
+            readback.mSync = nullptr;
+            if (latest == nullptr || readback.mFrameNumber > latest->mFrameNumber)
+                latest = &readback;
+        }
+
+        if (latest != nullptr)
+        {
+            extensions->glBindBuffer(GL_PIXEL_PACK_BUFFER_ARB, latest->mBuffer);
+            if (const void* data = extensions->glMapBuffer(GL_PIXEL_PACK_BUFFER_ARB, GL_READ_ONLY_ARB))
+            {
+                reduce(static_cast<const float*>(data), *latest);
+                extensions->glUnmapBuffer(GL_PIXEL_PACK_BUFFER_ARB);
+            }
+        }
+
+        // Every buffer is still waited for when the GPU is more than a few frames behind
+        const auto free = std::find_if(context.mReadbacks.begin(), context.mReadbacks.end(),
+            [](const Readback& readback) { return readback.mSync == nullptr; });
+        if (free != context.mReadbacks.end())
+        {
+            Readback& readback = *free;
+            if (readback.mBuffer == 0)
+                extensions->glGenBuffers(1, &readback.mBuffer);
+            extensions->glBindBuffer(GL_PIXEL_PACK_BUFFER_ARB, readback.mBuffer);
+            const std::size_t size = width * height * sizeof(float);
+            if (readback.mSize != size)
+            {
+                extensions->glBufferData(GL_PIXEL_PACK_BUFFER_ARB, size, nullptr, GL_STREAM_READ_ARB);
+                readback.mSize = size;
+            }
+            readback.mWidth = width;
+            readback.mHeight = height;
+            readback.mFrameNumber = state.getFrameStamp()->getFrameNumber();
+            glReadPixels(0, 0, static_cast<GLsizei>(width), static_cast<GLsizei>(height), GL_DEPTH_COMPONENT,
+                GL_FLOAT, nullptr);
+            readback.mSync = extensions->glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+        }
+
+        extensions->glBindBuffer(GL_PIXEL_PACK_BUFFER_ARB, 0);
+    }
+
+    void OcclusionCulling::reduce(const float* depth, const Readback& readback)
+    {
+        Frame frame;
+        {
+            std::lock_guard<std::mutex> lock(mMutex);
+            frame = mFrames[readback.mFrameNumber % sFrames];
+        }
+        if (frame.mFrameNumber != readback.mFrameNumber || frame.mFar <= frame.mNear)
+            return;
+
+        const bool reversed = AutoDepth::isReversed();
+        const std::size_t blockSize = (readback.mWidth + sPyramidWidth - 1) / sPyramidWidth;
+        std::vector<float> reduced = downsampleDepth(std::span(depth, readback.mWidth * readback.mHeight),
+            readback.mWidth, readback.mHeight, blockSize, reversed);
+        for (float& value : reduced)
+            value = linearizeDepth(value, static_cast<float>(frame.mNear), static_cast<float>(frame.mFar), reversed);
+
+        auto pyramid = std::make_shared<const DepthPyramid>(std::move(reduced),
+            (readback.mWidth + blockSize - 1) / blockSize, (readback.mHeight + blockSize - 1) / blockSize,
+            frame.mViewProjection);
+
+        std::lock_guard<std::mutex> lock(mMutex);
+        if (mPyramid == nullptr || readback.mFrameNumber > mPyramidFrameNumber)
+        {
+            mPyramid = std::move(pyramid);
+            mPyramidFrameNumber = readback.mFrameNumber;
+        }
+    }
+
+    bool OcclusionCulling::isCulling(osgUtil::CullVisitor& cv) const
+    {
+        return mCullPyramid != nullptr && cv.getCurrentCamera() == mCullCamera;
+    }
+
+    osg::BoundingBox OcclusionCulling::getWorldBound(const osg::BoundingBox& box, osgUtil::CullVisitor& cv) const
+    {
+        const osg::Matrixd localToWorld = *cv.getModelViewMatrix() * mCullInverseView;
+        osg::BoundingBox result;
+        for (unsigned int i = 0; i < 8; ++i)
+            result.expandBy(box.corner(i) * localToWorld);
+        return result;
+    }
+
+    bool OcclusionCulling::isOccluded(const osg::BoundingBox& box, unsigned int movedFrameNumber) const
+    {
+        // The pyramid may still have the box where it was before it moved
+        return movedFrameNumber < mCullPyramidFrameNumber && mCullPyramid->isOccluded(box);
+    }
+
+    OcclusionCameraCullCallback::OcclusionCameraCullCallback(osg::ref_ptr<OcclusionCulling> occlusionCulling)
+        : mOcclusionCulling(std::move(occlusionCulling))
+    {
+    }
+
+    void OcclusionCameraCullCallback::operator()(osg::Camera* camera, osgUtil::CullVisitor* cv)
+    {
+        mOcclusionCulling->beginCull(*camera, cv->getFrameStamp()->getFrameNumber());
+        traverse(camera, cv);
+    }
+
+    OcclusionCullCallback::OcclusionCullCallback(osg::ref_ptr<OcclusionCulling> occlusionCulling)
+        : mOcclusionCulling(std::move(occlusionCulling))
+    {
+    }
+
+    void OcclusionCullCallback::operator()(osg::Node* node, osgUtil::CullVisitor* cv)
+    {
+        if (mOcclusionCulling->isCulling(*cv) && isOccluded(*node, *cv))
+            return;
+
+        traverse(node, cv);
+    }
+
+    bool OcclusionCullCallback::isOccluded(const osg::Node& node, osgUtil::CullVisitor& cv)
+    {
+        // Cull callbacks of transforms are called with their own matrix applied, their bound is in the space of their
+        // parents
+        osg::BoundingBox box;
+        if (const osg::Transform* transform = node.asTransform())
+        {
+            for (unsigned int i = 0; i < transform->getNumChildren(); ++i)
+                box.expandBy(transform->getChild(i)->getBound());
+        }
+        else
+            box.expandBy(node.getBound());
+
+        if (!box.valid())
+            return false;
+
+        const osg::BoundingBox worldBox = mOcclusionCulling->getWorldBound(box, cv);
+        if (!mLastBound.valid() || hasMoved(mLastBound, worldBox))
+        {
+            mLastBound = worldBox;
+            mMovedFrameNumber = cv.getFrameStamp()->getFrameNumber();
+        }
+
+        return mOcclusionCulling->isOccluded(worldBox, mMovedFrameNumber);
+    }
+}
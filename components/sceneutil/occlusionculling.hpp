@@ -0,0 +1,140 @@
+#ifndef OPENMW_COMPONENTS_SCENEUTIL_OCCLUSIONCULLING_H
+#define OPENMW_COMPONENTS_SCENEUTIL_OCCLUSIONCULLING_H
+
+#include <components/sceneutil/nodecallback.hpp>
+
+#include <osg/BoundingBox>
+#include <osg/GL>
+#include <osg/GLDefines>
+#include <osg/Matrixd>
+#include <osg/Referenced>
+#include <osg/buffered_value>
+#include <osg/ref_ptr>
+
+#include <array>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+
+namespace osg
+{
+    class Camera;
+    class State;
+}
+
+namespace osgUtil
+{
+    class CullVisitor;
+}
+
+namespace SceneUtil
+{
+    class DepthPyramid;
+
+    /// @brief Culls nodes hidden behind what the previous frames of a view have drawn.
+    /// @par The opaque depth of the view is read back asynchronously, a frame late, and reduced into a DepthPyramid.
+    /// Nodes are tested against the pyramid with the matrices its frame was drawn with, so camera movement needs no
+    /// reprojection. Something that was hidden shows up a frame or two late when what hid it is gone.
+    /// @note A node moving away from the camera would be hidden by its own depth, so nodes are not culled for a while
+    /// after they moved.
+    class OcclusionCulling : public osg::Referenced
+    {
+    public:
+        OcclusionCulling();
+        ~OcclusionCulling();
+
+        /// Remember the matrices the camera is drawn with this frame and pick the pyramid to cull it against.
+        /// @note Has to be called from the cull thread of the camera, before it is traversed.
+        void beginCull(const osg::Camera& camera, unsigned int frameNumber);
+
+        /// Read back the depth of the currently bound read framebuffer and reduce what was read back before.
+        /// @note Has to be called from the draw thread, once the opaque depth of the camera culled by beginCull is
+        /// complete.
+        void capture(osg::State& state, std::size_t width, std::size_t height);
+
+        /// @return whether the view being culled is the one culled by beginCull and has a pyramid to cull it against
+        bool isCulling(osgUtil::CullVisitor& cv) const;
+
+        /// @return the world space box of a box in the local space of the node being culled
+        osg::BoundingBox getWorldBound(const osg::BoundingBox& box, osgUtil::CullVisitor& cv) const;
+
+        /// @return whether the world space box is hidden in the view being culled
+        /// @param movedFrameNumber the last frame the box moved in
+        bool isOccluded(const osg::BoundingBox& box, unsigned int movedFrameNumber) const;
+
+    private:
+        static constexpr std::size_t sFrames = 4;
+        static constexpr std::size_t sReadbacks = 3;
+
+        struct Frame
+        {
+            unsigned int mFrameNumber = 0;
+            osg::Matrixd mViewProjection;
+            double mNear = 0;
+            double mFar = 0;
+        };
+
+        struct Readback
+        {
+            GLuint mBuffer = 0;
+            GLsync mSync = nullptr;
+            std::size_t mWidth = 0;
+            std::size_t mHeight = 0;
+            std::size_t mSize = 0;
+            unsigned int mFrameNumber = 0;
+        };
+
+        struct PerContext
+        {
+            std::array<Readback, sReadbacks> mReadbacks;
+        };
+
+        void reduce(const float* depth, const Readback& readback);
+
+        std::mutex mMutex;
+        std::array<Frame, sFrames> mFrames;
+        std::shared_ptr<const DepthPyramid> mPyramid;
+        unsigned int mPyramidFrameNumber = 0;
+
+        osg::buffered_object<PerContext> mPerContext;
+
+        // Only used by the cull thread
+        const osg::Camera* mCullCamera = nullptr;
+        osg::Matrixd mCullInverseView;
+        std::shared_ptr<const DepthPyramid> mCullPyramid;
+        unsigned int mCullPyramidFrameNumber = 0;
+    };
+
+    /// @brief Calls OcclusionCulling::beginCull for the camera it is added to.
+    class OcclusionCameraCullCallback
+        : public SceneUtil::NodeCallback<OcclusionCameraCullCallback, osg::Camera*, osgUtil::CullVisitor*>
+    {
+    public:
+        explicit OcclusionCameraCullCallback(osg::ref_ptr<OcclusionCulling> occlusionCulling);
+
+        void operator()(osg::Camera* camera, osgUtil::CullVisitor* cv);
+
+    private:
+        osg::ref_ptr<OcclusionCulling> mOcclusionCulling;
+    };
+
+    /// @brief Skips a node hidden in the view culled by OcclusionCulling.
+    /// @note Every node needs its own callback, it remembers when the node last moved.
+    class OcclusionCullCallback
+        : public SceneUtil::NodeCallback<OcclusionCullCallback, osg::Node*, osgUtil::CullVisitor*>
+    {
+    public:
+        explicit OcclusionCullCallback(osg::ref_ptr<OcclusionCulling> occlusionCulling);
+
+        void operator()(osg::Node* node, osgUtil::CullVisitor* cv);
+
+    private:
+        bool isOccluded(const osg::Node& node, osgUtil::CullVisitor& cv);
+
+        osg::ref_ptr<OcclusionCulling> mOcclusionCulling;
+        osg::BoundingBox mLastBound;
+        unsigned int mMovedFrameNumber = 0;
+    };
+}
+
+#endif
@@ -110,6 +110,15 @@ void Optimizer::optimize(osg::Node* node, unsigned int options)
         node->accept(mgrp);
     }
 
+    // Before merging, so the triangles of the merged geometries end up in a single primitive set
+    if (options & INDEX_MESH)
+    {
+        OSG_INFO<<"Optimizer::optimize() doing INDEX_MESH"<<std::endl;
+        MeshOptimizerVisitor imv(this, INDEX_MESH);
+        node->accept(imv);
+        imv.optimizeMeshes();
+    }
+
     if (options & MERGE_GEOMETRY)
     {
         OSG_INFO<<"Optimizer::optimize() doing MERGE_GEOMETRY"<<std::endl;
@@ -130,17 +139,17 @@ void Optimizer::optimize(osg::Node* node, unsigned int options)
     if (options & VERTEX_POSTTRANSFORM)
     {
         OSG_INFO<<"Optimizer::optimize() doing VERTEX_POSTTRANSFORM"<<std::endl;
-        VertexCacheVisitor vcv;
+        MeshOptimizerVisitor vcv(this, VERTEX_POSTTRANSFORM);
         node->accept(vcv);
-        vcv.optimizeVertices();
+        vcv.optimizeMeshes();
     }
 
     if (options & VERTEX_PRETRANSFORM)
     {
         OSG_INFO<<"Optimizer::optimize() doing VERTEX_PRETRANSFORM"<<std::endl;
-        VertexAccessOrderVisitor vaov;
+        MeshOptimizerVisitor vaov(this, VERTEX_PRETRANSFORM);
         node->accept(vaov);
-        vaov.optimizeOrder();
+        vaov.optimizeMeshes();
     }
 
     if (options & ENABLE_BACKFACE_CULLING)
@@ -2106,6 +2115,56 @@ void Optimizer::BackfaceCullingVisitor::apply(osg::Node& node)
     }
 }
 
+void Optimizer::MeshOptimizerVisitor::apply(osg::Geometry& geometry)
+{
+    // Subclasses like RigGeometry and MorphGeometry keep data referring to the vertices
+    if (geometry.className() != std::string("Geometry")) return;
+    if (geometry.getDataVariance() == osg::Object::DYNAMIC) return;
+    if (!isOperationPermissibleForObject(&geometry)) return;
+
+    _geometries.insert(&geometry);
+}
+
+void Optimizer::MeshOptimizerVisitor::apply(osg::Group& group)
+{
+    if (isOperationPermissibleForObject(&group))
+    {
+        traverse(group);
+    }
+}
+
+void Optimizer::MeshOptimizerVisitor::apply(osg::Node& node)
+{
+    if (isOperationPermissibleForObject(&node))
+    {
+        traverse(node);
+    }
+}
+
+void Optimizer::MeshOptimizerVisitor::optimizeMeshes()
+{
+    osgUtil::IndexMeshVisitor indexMesh;
+    osgUtil::VertexCacheVisitor vertexCache;
+    osgUtil::VertexAccessOrderVisitor vertexAccessOrder;
+
+    for (osg::Geometry* geometry : _geometries)
+    {
+        switch (_operationType)
+        {
+            case INDEX_MESH:
+                indexMesh.makeMesh(*geometry);
+                break;
+            case VERTEX_POSTTRANSFORM:
+                vertexCache.optimizeVertices(*geometry);
+                break;
+            case VERTEX_PRETRANSFORM:
+                vertexAccessOrder.optimizeOrder(*geometry);
+                break;
+        }
+    }
+    _geometries.clear();
+}
+
 }
 
 // NOLINTEND(readability-identifier-naming)
@@ -387,6 +387,25 @@ class Optimizer
                 void apply(osg::Node& node) override;
         };
 
+        /** Run an osgUtil mesh optimizer on the static geometries: convert the primitives into indexed triangle
+          * lists sharing duplicate vertices (INDEX_MESH), order the triangles for the post-transform vertex cache
+          * (VERTEX_POSTTRANSFORM) or order the vertices by first use (VERTEX_PRETRANSFORM). */
+        class MeshOptimizerVisitor : public BaseOptimizerVisitor
+        {
+            public:
+                MeshOptimizerVisitor(Optimizer* optimizer, unsigned int operation) :
+                    BaseOptimizerVisitor(optimizer, operation) {}
+
+                void apply(osg::Geometry& geometry) override;
+                void apply(osg::Group& group) override;
+                void apply(osg::Node& node) override;
+
+                void optimizeMeshes();
+
+            protected:
+                std::set<osg::Geometry*> _geometries;
+        };
+
         /** Merge adjacent Groups that have the same StateSet. */
         class MergeGroupsVisitor : public SceneUtil::BaseOptimizerVisitor
         {
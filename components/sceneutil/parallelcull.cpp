@@ -0,0 +1,207 @@
+#include "parallelcull.hpp"
+
+#include <osg/Camera>
+#include <osg/observer_ptr>
+#include <osgUtil/CullVisitor>
+#include <osgUtil/RenderStage>
+#include <osgUtil/StateGraph>
+
+#include <algorithm>
+#include <memory>
+#include <stdexcept>
+
+#include "workqueue.hpp"
+
+namespace SceneUtil
+{
+    namespace
+    {
+        // The CullVisitor whose JoinCallback traversal is running on this thread
+        thread_local osgUtil::CullVisitor* sJoinScope = nullptr;
+    }
+
+    ParallelCull* ParallelCull::sInstance = nullptr;
+
+    struct ParallelCull::Context
+    {
+        osg::observer_ptr<osg::Camera> mCamera;
+        osg::ref_ptr<osgUtil::CullVisitor> mCullVisitor;
+        osg::ref_ptr<osgUtil::RenderStage> mRenderStage;
+        osg::ref_ptr<osgUtil::StateGraph> mStateGraph;
+    };
+
+    class ParallelCull::CullJob : public WorkItem
+    {
+    public:
+        CullJob(Context& context, osgUtil::CullVisitor& parent)
+            : mContext(context)
+            , mCamera(context.mCamera.get())
+            , mParentStage(parent.getCurrentRenderBin()->getStage())
+            , mViewport(parent.getViewport())
+            , mProjectionMatrix(new osg::RefMatrix(*parent.getProjectionMatrix()))
+            , mModelViewMatrix(new osg::RefMatrix(*parent.getModelViewMatrix()))
+            , mNodePath(parent.getNodePath())
+        {
+            osgUtil::CullVisitor& cv = *mContext.mCullVisitor;
+            cv.setCullSettings(parent);
+            cv.setTraversalMask(parent.getTraversalMask());
+            cv.setFrameStamp(const_cast<osg::FrameStamp*>(parent.getFrameStamp()));
+            cv.setTraversalNumber(parent.getTraversalNumber());
+            cv.setRenderInfo(parent.getRenderInfo());
+
+            for (const osgUtil::StateGraph* sg = parent.getCurrentStateGraph(); sg; sg = sg->_parent)
+                if (sg->getStateSet())
+                    mStateSets.push_back(sg->getStateSet());
+            std::reverse(mStateSets.begin(), mStateSets.end());
+        }
+
+        void doWork() override
+        {
+            osgUtil::CullVisitor& cv = *mContext.mCullVisitor;
+            osgUtil::RenderStage& stage = *mContext.mRenderStage;
+
+            cv.reset();
+            mContext.mStateGraph->clean();
+            stage.reset();
+            cv.setStateGraph(mContext.mStateGraph);
+            cv.setRenderStage(&stage);
+            stage.setViewport(mViewport);
+            stage.setInitialViewMatrix(mModelViewMatrix);
+
+            cv.pushViewport(mViewport);
+            cv.pushProjectionMatrix(mProjectionMatrix);
+            cv.pushModelViewMatrix(mModelViewMatrix, osg::Transform::ABSOLUTE_RF);
+            for (osg::Node* node : mNodePath)
+                cv.pushOntoNodePath(node);
+            for (const osg::StateSet* stateset : mStateSets)
+                cv.pushStateSet(stateset);
+
+            mCamera->accept(cv);
+
+            for (std::size_t i = 0; i < mStateSets.size(); ++i)
+                cv.popStateSet();
+            for (std::size_t i = 0; i < mNodePath.size(); ++i)
+                cv.popFromNodePath();
+            cv.popModelViewMatrix();
+            cv.popProjectionMatrix();
+            cv.popViewport();
+
+            mContext.mStateGraph->prune();
+        }
+
+        /// Move the render stages created for the camera to the parent one.
+        void attach()
+        {
+            for (const auto& [order, stage] : mContext.mRenderStage->getPreRenderList())
+                mParentStage->addPreRenderStage(stage, order);
+            for (const auto& [order, stage] : mContext.mRenderStage->getPostRenderList())
+                mParentStage->addPostRenderStage(stage, order);
+        }
+
+    private:
+        Context& mContext;
+        osg::ref_ptr<osg::Camera> mCamera;
+        osg::ref_ptr<osgUtil::RenderStage> mParentStage;
+        osg::ref_ptr<osg::Viewport> mViewport;
+        osg::ref_ptr<osg::RefMatrix> mProjectionMatrix;
+        osg::ref_ptr<osg::RefMatrix> mModelViewMatrix;
+        osg::NodePath mNodePath;
+        std::vector<const osg::StateSet*> mStateSets;
+    };
+
+    void ParallelCull::JoinCallback::operator()(osg::Node* node, osgUtil::CullVisitor* cv)
+    {
+        ParallelCull* parallelCull = ParallelCull::getInstance();
+        if (!parallelCull || sJoinScope != nullptr)
+        {
+            traverse(node, cv);
+            return;
+        }
+
+        sJoinScope = cv;
+        traverse(node, cv);
+        sJoinScope = nullptr;
+
+        parallelCull->join(*cv);
+    }
+
+    ParallelCull::ParallelCull(std::size_t workerThreads)
+        : mWorkQueue(new WorkQueue(workerThreads))
+    {
+        if (sInstance)
+            throw std::logic_error("A ParallelCull already exists");
+        sInstance = this;
+    }
+
+    ParallelCull::~ParallelCull()
+    {
+        mWorkQueue->stop();
+        sInstance = nullptr;
+    }
+
+    void ParallelCull::cull(osgUtil::CullVisitor& cv, osg::Camera& camera)
+    {
+        // Nested cameras of a job and views culled outside of a JoinCallback are culled inline
+        if (sJoinScope != &cv)
+        {
+            camera.accept(cv);
+            return;
+        }
+
+        osg::ref_ptr<CullJob> job;
+        {
+            std::lock_guard<std::mutex> lock(mMutex);
+            std::unique_ptr<Context>& context = mContexts[std::make_pair(&cv, &camera)];
+            if (context == nullptr || context->mCamera != &camera)
+            {
+                context = std::make_unique<Context>();
+                context->mCamera = &camera;
+                context->mCullVisitor = cv.clone();
+                context->mRenderStage = new osgUtil::RenderStage;
+                context->mStateGraph = new osgUtil::StateGraph;
+            }
+            job = new CullJob(*context, cv);
+            job->setPriority(WorkPriority::High);
+            mPending.push_back(Pending{ job, &cv });
+        }
+        mWorkQueue->addWorkItem(job);
+    }
+
+    void ParallelCull::join(osgUtil::CullVisitor& cv)
+    {
+        std::vector<Pending> pending;
+        {
+            std::lock_guard<std::mutex> lock(mMutex);
+            const auto it = std::stable_partition(
+                mPending.begin(), mPending.end(), [&](const Pending& item) { return item.mParent != &cv; });
+            pending.assign(std::make_move_iterator(it), std::make_move_iterator(mPending.end()));
+            mPending.erase(it, mPending.end());
+        }
+
+        for (const Pending& item : pending)
+        {
+            item.mJob->waitTillDone();
+            item.mJob->attach();
+        }
+
+        if (pending.empty())
+            return;
+
+        std::lock_guard<std::mutex> lock(mMutex);
+        for (auto it = mContexts.begin(); it != mContexts.end();)
+        {
+            if (it->second->mCamera == nullptr)
+                it = mContexts.erase(it);
+            else
+                ++it;
+        }
+    }
+
+    void cullCamera(osgUtil::CullVisitor& cv, osg::Camera& camera)
+    {
+        if (ParallelCull* parallelCull = ParallelCull::getInstance())
+            parallelCull->cull(cv, camera);
+        else
+            camera.accept(cv);
+    }
+}
@@ -0,0 +1,77 @@
+#ifndef OPENMW_COMPONENTS_SCENEUTIL_PARALLELCULL_H
+#define OPENMW_COMPONENTS_SCENEUTIL_PARALLELCULL_H
+
+#include <osg/ref_ptr>
+
+#include <map>
+#include <memory>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+#include "nodecallback.hpp"
+
+namespace osg
+{
+    class Camera;
+}
+
+namespace osgUtil
+{
+    class CullVisitor;
+}
+
+namespace SceneUtil
+{
+    class WorkQueue;
+
+    /// @brief Culls render to texture cameras on worker threads while the cull traversal of the parent view goes on.
+    /// @par Every camera gets its own CullVisitor, render stage and state graph per parent CullVisitor. The state
+    /// inherited from the parent state graph is pushed first, so the result is the same as culling the camera inline.
+    /// The render stages are attached to the parent render stage by join(), which JoinCallback calls after the
+    /// traversal of the node it is set on.
+    /// @note Everything culled by the cameras has to be safe to cull from several threads at once.
+    class ParallelCull
+    {
+    public:
+        class JoinCallback : public SceneUtil::NodeCallback<JoinCallback, osg::Node*, osgUtil::CullVisitor*>
+        {
+        public:
+            void operator()(osg::Node* node, osgUtil::CullVisitor* cv);
+        };
+
+        static ParallelCull* getInstance() { return sInstance; }
+
+        explicit ParallelCull(std::size_t workerThreads);
+        ~ParallelCull();
+
+        /// Cull the camera on a worker thread when called from within a JoinCallback traversal of cv, otherwise
+        /// cull it inline.
+        void cull(osgUtil::CullVisitor& cv, osg::Camera& camera);
+
+        /// Wait for the cameras culled for cv and attach their render stages.
+        void join(osgUtil::CullVisitor& cv);
+
+    private:
+        struct Context;
+        class CullJob;
+
+        struct Pending
+        {
+            osg::ref_ptr<CullJob> mJob;
+            osgUtil::CullVisitor* mParent;
+        };
+
+        static ParallelCull* sInstance;
+
+        osg::ref_ptr<WorkQueue> mWorkQueue;
+        std::mutex mMutex;
+        std::map<std::pair<const osgUtil::CullVisitor*, const osg::Camera*>, std::unique_ptr<Context>> mContexts;
+        std::vector<Pending> mPending;
+    };
+
+    /// Cull the camera through ParallelCull if there is one.
+    void cullCamera(osgUtil::CullVisitor& cv, osg::Camera& camera);
+}
+
+#endif
@@ -1,8 +1,10 @@
 #include "riggeometry.hpp"
 
+#include <algorithm>
 #include <unordered_map>
 
 #include <osg/MatrixTransform>
+#include <osg/Program>
 
 #include <osgUtil/CullVisitor>
 
@@ -25,6 +27,7 @@ namespace SceneUtil
     RigGeometry::RigGeometry(const RigGeometry& copy, const osg::CopyOp& copyop)
         : Drawable(copy, copyop)
         , mData(copy.mData)
+        , mGpuSkinning(copy.mGpuSkinning)
     {
         setSourceGeometry(copy.mSourceGeometry);
         setNumChildrenRequiringUpdateTraversal(1);
@@ -33,10 +36,18 @@ namespace SceneUtil
     void RigGeometry::setSourceGeometry(osg::ref_ptr<osg::Geometry> sourceGeometry)
     {
         for (unsigned int i = 0; i < 2; ++i)
+        {
             mGeometry[i] = nullptr;
+            mBonePalette[i] = nullptr;
+            mSkinTransform[i] = nullptr;
+        }
 
         mSourceGeometry = sourceGeometry;
 
+        if (mGpuSkinning
+            && (mData == nullptr || !mData->initGpuSkinning(sourceGeometry->getVertexArray()->getNumElements())))
+            mGpuSkinning = false;
+
         for (unsigned int i = 0; i < 2; ++i)
         {
             const osg::Geometry& from = *sourceGeometry;
@@ -57,6 +68,26 @@ namespace SceneUtil
             to.setComputeBoundingBoxCallback(new CopyBoundingBoxCallback());
             to.setComputeBoundingSphereCallback(new CopyBoundingSphereCallback());
 
+            if (mGpuSkinning)
+            {
+                // vertices stay in the bind pose, only the uniforms are per instance
+                to.setVertexAttribArray(sBoneIndicesAttribLocation, mData->mBoneIndices, osg::Array::BIND_PER_VERTEX);
+                to.setVertexAttribArray(sBoneWeightsAttribLocation, mData->mBoneWeights, osg::Array::BIND_PER_VERTEX);
+
+                osg::ref_ptr<osg::StateSet> stateSet = from.getStateSet() != nullptr
+                    ? new osg::StateSet(*from.getStateSet(), osg::CopyOp::SHALLOW_COPY)
+                    : new osg::StateSet;
+                mBonePalette[i] = new osg::Uniform(osg::Uniform::FLOAT_MAT4, "boneMatrices", sMaxGpuSkinningBones);
+                mSkinTransform[i] = new osg::Uniform("skinTransform", osg::Matrixf());
+                stateSet->addUniform(mBonePalette[i]);
+                stateSet->addUniform(mSkinTransform[i]);
+                stateSet->addUniform(new osg::Uniform("useSkinning", true));
+                to.setStateSet(stateSet);
+
+                mSourceTangents = nullptr;
+                continue;
+            }
+
             // vertices and normals are modified every frame, so we need to deep copy them.
             // assign a dedicated VBO to make sure that modifications don't interfere with source geometry's VBO.
             osg::ref_ptr<osg::VertexBufferObject> vbo(new osg::VertexBufferObject);
@@ -99,6 +130,69 @@ namespace SceneUtil
         return mSourceGeometry;
     }
 
+    bool RigGeometry::setGpuSkinning(bool enabled)
+    {
+        if (enabled == mGpuSkinning)
+            return mGpuSkinning;
+        mGpuSkinning = enabled;
+        if (mSourceGeometry != nullptr)
+            setSourceGeometry(mSourceGeometry);
+        return mGpuSkinning;
+    }
+
+    void RigGeometry::addBindSkinningAttribLocations(osg::Program& program)
+    {
+        program.addBindAttribLocation("boneIndices", sBoneIndicesAttribLocation);
+        program.addBindAttribLocation("boneWeights", sBoneWeightsAttribLocation);
+    }
+
+    bool RigGeometry::InfluenceData::initGpuSkinning(std::size_t vertexCount)
+    {
+        std::call_once(mGpuSkinningInitialized, [&] {
+            if (mBones.size() > sMaxGpuSkinningBones)
+                return;
+
+            osg::ref_ptr<osg::Vec4Array> indices(new osg::Vec4Array(vertexCount));
+            osg::ref_ptr<osg::Vec4Array> weights(new osg::Vec4Array(vertexCount));
+            std::vector<bool> hasInfluences(vertexCount, false);
+            for (const auto& [influences, vertices] : mInfluences)
+            {
+                if (influences.size() > sMaxGpuSkinningInfluences)
+                    return;
+
+                osg::Vec4f vertexIndices;
+                osg::Vec4f vertexWeights;
+                for (std::size_t i = 0; i < influences.size(); ++i)
+                {
+                    vertexIndices[i] = static_cast<float>(influences[i].first);
+                    vertexWeights[i] = influences[i].second;
+                }
+
+                for (unsigned short vertex : vertices)
+                {
+                    if (vertex >= vertexCount)
+                        return;
+                    (*indices)[vertex] = vertexIndices;
+                    (*weights)[vertex] = vertexWeights;
+                    hasInfluences[vertex] = true;
+                }
+            }
+
+            // CPU skinning leaves such vertices untransformed which the shader can't reproduce
+            if (std::find(hasInfluences.begin(), hasInfluences.end(), false) != hasInfluences.end())
+                return;
+
+            osg::ref_ptr<osg::VertexBufferObject> vbo(new osg::VertexBufferObject);
+            indices->setVertexBufferObject(vbo);
+            weights->setVertexBufferObject(vbo);
+
+            mBoneIndices = std::move(indices);
+            mBoneWeights = std::move(weights);
+        });
+
+        return mBoneIndices != nullptr && mBoneIndices->size() == vertexCount;
+    }
+
     bool RigGeometry::initFromParentSkeleton(osg::NodeVisitor* nv)
     {
         const osg::NodePath& path = nv->getNodePath();
@@ -148,28 +242,33 @@ namespace SceneUtil
                 return;
         }
 
-        unsigned int traversalNumber = nv->getTraversalNumber();
+        osg::Geometry& geom = update(nv->getTraversalNumber());
+        nv->pushOntoNodePath(&geom);
+        nv->apply(geom);
+        nv->popFromNodePath();
+    }
+
+    osg::Geometry& RigGeometry::update(unsigned int traversalNumber)
+    {
+        // Views culled in parallel share the skinned geometry of the frame
+        std::lock_guard<std::mutex> lock(mCullMutex);
+
         if (mLastFrameNumber == traversalNumber || (mLastFrameNumber != 0 && !mSkeleton->getActive()))
+            return *getGeometry(mLastFrameNumber);
+
+        if (mLastFrameNumber != 0 && mSkeleton->getSkinOnRequest())
         {
-            osg::Geometry& geom = *getGeometry(mLastFrameNumber);
-            nv->pushOntoNodePath(&geom);
-            nv->apply(geom);
-            nv->popFromNodePath();
-            return;
+            // The buffer drawn in the last frame is only free again an odd number of frames after it was skinned
+            if (mSkeleton->getSkinningRequest() == mLastSkinningRequest
+                || (traversalNumber - mLastFrameNumber) % 2 == 0)
+                return *getGeometry(mLastFrameNumber);
         }
+
+        mLastSkinningRequest = mSkeleton->getSkinningRequest();
         mLastFrameNumber = traversalNumber;
         osg::Geometry& geom = *getGeometry(mLastFrameNumber);
 
-        mSkeleton->updateBoneMatrices(traversalNumber);
-
-        // skinning
-        const osg::Vec3Array* positionSrc = static_cast<osg::Vec3Array*>(mSourceGeometry->getVertexArray());
-        const osg::Vec3Array* normalSrc = static_cast<osg::Vec3Array*>(mSourceGeometry->getNormalArray());
-        const osg::Vec4Array* tangentSrc = mSourceTangents;
-
-        osg::Vec3Array* positionDst = static_cast<osg::Vec3Array*>(geom.getVertexArray());
-        osg::Vec3Array* normalDst = static_cast<osg::Vec3Array*>(geom.getNormalArray());
-        osg::Vec4Array* tangentDst = static_cast<osg::Vec4Array*>(geom.getTexCoordArray(7));
+        mSkeleton->updateBoneMatrices(traversalNumber, mNodes);
 
         std::vector<osg::Matrixf> boneMatrices(mNodes.size());
         std::vector<Bone*>::const_iterator bone = mNodes.begin();
@@ -188,6 +287,25 @@ namespace SceneUtil
         else
             transform = mData->mTransform;
 
+        if (mGpuSkinning)
+            updateBonePalette(mLastFrameNumber, boneMatrices, transform);
+        else
+            skinOnCpu(geom, boneMatrices, transform);
+
+        return geom;
+    }
+
+    void RigGeometry::skinOnCpu(
+        osg::Geometry& geom, const std::vector<osg::Matrixf>& boneMatrices, const osg::Matrixf& transform) const
+    {
+        const osg::Vec3Array* positionSrc = static_cast<osg::Vec3Array*>(mSourceGeometry->getVertexArray());
+        const osg::Vec3Array* normalSrc = static_cast<osg::Vec3Array*>(mSourceGeometry->getNormalArray());
+        const osg::Vec4Array* tangentSrc = mSourceTangents;
+
+        osg::Vec3Array* positionDst = static_cast<osg::Vec3Array*>(geom.getVertexArray());
+        osg::Vec3Array* normalDst = static_cast<osg::Vec3Array*>(geom.getNormalArray());
+        osg::Vec4Array* tangentDst = static_cast<osg::Vec4Array*>(geom.getTexCoordArray(7));
+
         for (const auto& [influences, vertices] : mData->mInfluences)
         {
             osg::Matrixf resultMat(0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 1);
@@ -228,10 +346,16 @@ namespace SceneUtil
             tangentDst->dirty();
 
         geom.osg::Drawable::dirtyGLObjects();
+    }
 
-        nv->pushOntoNodePath(&geom);
-        nv->apply(geom);
-        nv->popFromNodePath();
+    void RigGeometry::updateBonePalette(
+        unsigned int frame, const std::vector<osg::Matrixf>& boneMatrices, const osg::Matrixf& transform) const
+    {
+        osg::Uniform& palette = *mBonePalette[frame % 2];
+        const osg::Matrixf zero(0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0);
+        for (std::size_t i = 0; i < boneMatrices.size(); ++i)
+            palette.setElement(static_cast<unsigned>(i), mNodes[i] != nullptr ? boneMatrices[i] : zero);
+        mSkinTransform[frame % 2]->set(transform);
     }
 
     void RigGeometry::updateBounds(osg::NodeVisitor* nv)
@@ -246,7 +370,7 @@ namespace SceneUtil
             return;
         mBoundsFirstFrame = false;
 
-        mSkeleton->updateBoneMatrices(nv->getTraversalNumber());
+        mSkeleton->updateBoneMatrices(nv->getTraversalNumber(), mNodes);
 
         updateSkinToSkelMatrix(nv->getNodePath());
 
@@ -3,9 +3,16 @@
 
 #include <osg/Geometry>
 #include <osg/Matrixf>
+#include <osg/Uniform>
 
+#include <mutex>
 #include <string_view>
 
+namespace osg
+{
+    class Program;
+}
+
 namespace SceneUtil
 {
     class Skeleton;
@@ -25,9 +32,17 @@ namespace SceneUtil
     /// @note The internal Geometry used for rendering is double buffered, this allows updates to be done in a thread
     /// safe way while not compromising rendering performance. This is crucial when using osg's default threading model
     /// of DrawThreadPerContext.
+    /// @note With GPU skinning enabled the internal Geometry keeps the bind pose and only the bone palette is updated
+    /// per frame, the skinning is done by the vertex shader. Bounds are still computed on the CPU.
     class RigGeometry : public osg::Drawable
     {
     public:
+        // Must match MAX_SKINNING_BONES in lib/core/skinning.glsl
+        static constexpr std::size_t sMaxGpuSkinningBones = 64;
+        static constexpr std::size_t sMaxGpuSkinningInfluences = 4;
+        static constexpr unsigned sBoneIndicesAttribLocation = 6;
+        static constexpr unsigned sBoneWeightsAttribLocation = 7;
+
         RigGeometry();
         RigGeometry(const RigGeometry& copy, const osg::CopyOp& copyop);
 
@@ -66,6 +81,16 @@ namespace SceneUtil
 
         osg::ref_ptr<osg::Geometry> getSourceGeometry() const;
 
+        /// Skin in the vertex shader instead of on the CPU. The shader in use must support skinning.
+        /// @return Whether GPU skinning is used, which is not the case when the mesh has too many bones or some vertex
+        /// has too many or no influences.
+        bool setGpuSkinning(bool enabled);
+
+        bool getGpuSkinning() const { return mGpuSkinning; }
+
+        /// Bind the vertex attributes used by GPU skinning.
+        static void addBindSkinningAttribLocations(osg::Program& program);
+
         void accept(osg::NodeVisitor& nv) override;
         bool supports(const osg::PrimitiveFunctor&) const override { return true; }
         void accept(osg::PrimitiveFunctor&) const override;
@@ -86,7 +111,13 @@ namespace SceneUtil
 
     private:
         void cull(osg::NodeVisitor* nv);
+        /// Skin the geometry for the traversal unless it was already done, returns the geometry to draw.
+        osg::Geometry& update(unsigned int traversalNumber);
         void updateBounds(osg::NodeVisitor* nv);
+        void skinOnCpu(osg::Geometry& geom, const std::vector<osg::Matrixf>& boneMatrices,
+            const osg::Matrixf& transform) const;
+        void updateBonePalette(unsigned int frame, const std::vector<osg::Matrixf>& boneMatrices,
+            const osg::Matrixf& transform) const;
 
         osg::ref_ptr<osg::Geometry> mGeometry[2];
         osg::Geometry* getGeometry(unsigned int frame) const;
@@ -104,11 +135,24 @@ namespace SceneUtil
             std::vector<std::pair<BoneWeights, VertexList>> mInfluences;
             osg::Matrixf mTransform;
             std::string mRootBone;
+
+            // per vertex influences for GPU skinning, null if they don't fit into the vertex attributes
+            osg::ref_ptr<osg::Vec4Array> mBoneIndices;
+            osg::ref_ptr<osg::Vec4Array> mBoneWeights;
+            std::once_flag mGpuSkinningInitialized;
+
+            bool initGpuSkinning(std::size_t vertexCount);
         };
         osg::ref_ptr<InfluenceData> mData;
         std::vector<Bone*> mNodes;
 
+        bool mGpuSkinning{ false };
+        osg::ref_ptr<osg::Uniform> mBonePalette[2];
+        osg::ref_ptr<osg::Uniform> mSkinTransform[2];
+
         unsigned int mLastFrameNumber{ 0 };
+        unsigned mLastSkinningRequest{ 0 };
+        std::mutex mCullMutex;
         bool mBoundsFirstFrame{ true };
 
         bool initFromParentSkeleton(osg::NodeVisitor* nv);
@@ -245,44 +245,41 @@ namespace SceneUtil
             if (stateset)
                 cv->pushStateSet(stateset);
 
-            unsigned int traversalNumber = nv.getTraversalNumber();
-            if (mLastFrameNumber == traversalNumber)
+            OsgaRigGeometry* geom = nullptr;
             {
-                OsgaRigGeometry& geom = *getRigGeometryPerFrame(mLastFrameNumber);
+                // Views culled in parallel share the skinned geometry of the frame
+                std::lock_guard<std::mutex> lock(mCullMutex);
 
-                nv.pushOntoNodePath(&geom);
-                nv.apply(geom);
-                nv.popFromNodePath();
-            }
-            else
-            {
-                mLastFrameNumber = traversalNumber;
-
-                OsgaRigGeometry& geom = *getRigGeometryPerFrame(mLastFrameNumber);
-
-                if (mIsBodyPart)
+                unsigned int traversalNumber = nv.getTraversalNumber();
+                geom = getRigGeometryPerFrame(traversalNumber);
+                if (mLastFrameNumber != traversalNumber)
                 {
-                    if (mBackToOrigin)
-                        updateBackToOriginTransform(&geom);
-                    else
+                    mLastFrameNumber = traversalNumber;
+
+                    if (mIsBodyPart)
                     {
-                        osg::MatrixTransform* matrixTransform
-                            = dynamic_cast<osg::MatrixTransform*>(this->getParents()[0]);
-                        if (matrixTransform)
+                        if (mBackToOrigin)
+                            updateBackToOriginTransform(geom);
+                        else
                         {
-                            mBackToOrigin = matrixTransform;
-                            updateBackToOriginTransform(&geom);
+                            osg::MatrixTransform* matrixTransform
+                                = dynamic_cast<osg::MatrixTransform*>(this->getParents()[0]);
+                            if (matrixTransform)
+                            {
+                                mBackToOrigin = matrixTransform;
+                                updateBackToOriginTransform(geom);
+                            }
                         }
                     }
-                }
-
-                updateRigGeometry(&geom, &nv);
 
-                nv.pushOntoNodePath(&geom);
-                nv.apply(geom);
-                nv.popFromNodePath();
+                    updateRigGeometry(geom, &nv);
+                }
             }
 
+            nv.pushOntoNodePath(geom);
+            nv.apply(*geom);
+            nv.popFromNodePath();
+
             if (stateset)
                 cv->popStateSet();
         }
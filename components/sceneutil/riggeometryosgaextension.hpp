@@ -2,6 +2,7 @@
 #define OPENMW_COMPONENTS_OSGAEXTENSION_RIGGEOMETRY_H
 
 #include <array>
+#include <mutex>
 
 #include <osg/Drawable>
 #include <osgAnimation/RigGeometry>
@@ -61,6 +62,7 @@ namespace SceneUtil
                                              // origin in order to get correct deformations for bodyparts
 
         unsigned int mLastFrameNumber;
+        std::mutex mCullMutex;
         bool mIsBodyPart;
 
         void updateBackToOriginTransform(OsgaRigGeometry* geometry);
@@ -8,6 +8,7 @@
 #include <components/sceneutil/color.hpp>
 #include <components/sceneutil/depth.hpp>
 #include <components/sceneutil/nodecallback.hpp>
+#include <components/sceneutil/parallelcull.hpp>
 #include <components/stereo/multiview.hpp>
 #include <components/stereo/stereomanager.hpp>
 
@@ -65,7 +66,7 @@ namespace SceneUtil
                     if (sm.getEye(cv) == Stereo::Eye::Right)
                         applyRight(vdd->mCamera);
                 }
-                vdd->mCamera->accept(*cv);
+                cullCamera(*cv, *vdd->mCamera);
             }
         }
         vdd->mFrameNumber = frameNumber;
@@ -195,6 +196,11 @@ namespace SceneUtil
 
             setDefaults(camera);
 
+            // A single camera draws every view, so everything visible in any of them has to pass its culling
+            if (mStereoAwareness == StereoAwareness::Aware && Stereo::getMultiview()
+                && camera->getReferenceFrame() == osg::Camera::RELATIVE_RF)
+                Stereo::Manager::instance().addMultiviewCamera(camera);
+
             if (camera->getBufferAttachmentMap().count(osg::Camera::COLOR_BUFFER))
                 vdd->mColorTexture = camera->getBufferAttachmentMap()[osg::Camera::COLOR_BUFFER]._texture;
             if (camera->getBufferAttachmentMap().count(osg::Camera::PACKED_DEPTH_STENCIL_BUFFER))
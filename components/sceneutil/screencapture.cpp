@@ -4,13 +4,16 @@
 #include <components/files/conversion.hpp>
 #include <components/sceneutil/workqueue.hpp>
 
+#include <osg/GLExtensions>
 #include <osg/Image>
+#include <osg/State>
 #include <osg/ref_ptr>
 #include <osgDB/ReaderWriter>
 #include <osgDB/Registry>
 
 #include <atomic>
 #include <cassert>
+#include <cstring>
 #include <filesystem>
 #include <fstream>
 #include <iomanip>
@@ -162,4 +165,81 @@ namespace SceneUtil
         workItems->erase(std::remove_if(workItems->begin(), workItems->end(), isDone), workItems->end());
         workItems->emplace_back(std::move(item));
     }
+
+    AsyncScreenCapture::AsyncScreenCapture(osg::ref_ptr<osgViewer::ScreenCaptureHandler::CaptureOperation> operation)
+        : mOperation(std::move(operation))
+    {
+        assert(mOperation != nullptr);
+    }
+
+    void AsyncScreenCapture::swapBuffersImplementation(osg::GraphicsContext* gc)
+    {
+        if (!mReadbacks.empty())
+            finish(*gc->getState());
+
+        if (mRequested > 0)
+        {
+            --mRequested;
+            read(*gc);
+        }
+
+        gc->swapBuffersImplementation();
+    }
+
+    void AsyncScreenCapture::finish(osg::State& state)
+    {
+        const osg::GLExtensions* extensions = state.get<osg::GLExtensions>();
+
+        std::erase_if(mReadbacks, [&](Readback& readback) {
+            const GLenum status = extensions->glClientWaitSync(readback.mSync, 0, 0);
+            if (status != GL_ALREADY_SIGNALED && status != GL_CONDITION_SATISFIED)
+                return false;
+            extensions->glDeleteSync(readback.mSync);
+            extensions->glBindBuffer(GL_PIXEL_PACK_BUFFER_ARB, readback.mBuffer);
+            if (const void* data = extensions->glMapBuffer(GL_PIXEL_PACK_BUFFER_ARB, GL_READ_ONLY_ARB))
+            {
+                osg::ref_ptr<osg::Image> image = new osg::Image;
+                image->allocateImage(readback.mWidth, readback.mHeight, 1, GL_RGB, GL_UNSIGNED_BYTE, 1);
+                std::memcpy(image->data(), data, image->getTotalSizeInBytes());
+                extensions->glUnmapBuffer(GL_PIXEL_PACK_BUFFER_ARB);
+                (*mOperation)(*image, state.getContextID());
+            }
+            else
+                Log(Debug::Error) << "Failed to map screenshot pixel buffer";
+            extensions->glBindBuffer(GL_PIXEL_PACK_BUFFER_ARB, 0);
+            extensions->glDeleteBuffers(1, &readback.mBuffer);
+            return true;
+        });
+    }
+
+    void AsyncScreenCapture::read(osg::GraphicsContext& gc)
+    {
+        osg::State& state = *gc.getState();
+        const osg::GLExtensions* extensions = state.get<osg::GLExtensions>();
+        const osg::GraphicsContext::Traits& traits = *gc.getTraits();
+        const int width = traits.width;
+        const int height = traits.height;
+
+        glReadBuffer(traits.doubleBuffer ? GL_BACK : GL_FRONT);
+
+        if (!extensions->isPBOSupported || extensions->glFenceSync == nullptr)
+        {
+            osg::ref_ptr<osg::Image> image = new osg::Image;
+            image->readPixels(0, 0, width, height, GL_RGB, GL_UNSIGNED_BYTE, 1);
+            (*mOperation)(*image, state.getContextID());
+            return;
+        }
+
+        Readback& readback = mReadbacks.emplace_back(Readback{ .mWidth = width, .mHeight = height });
+        extensions->glGenBuffers(1, &readback.mBuffer);
+        extensions->glBindBuffer(GL_PIXEL_PACK_BUFFER_ARB, readback.mBuffer);
+        extensions->glBufferData(GL_PIXEL_PACK_BUFFER_ARB, static_cast<std::size_t>(width) * height * 3, nullptr,
+            GL_STREAM_READ_ARB);
+        // Rows of the image are not padded
+        glPixelStorei(GL_PACK_ALIGNMENT, 1);
+        glReadPixels(0, 0, width, height, GL_RGB, GL_UNSIGNED_BYTE, nullptr);
+        glPixelStorei(GL_PACK_ALIGNMENT, 4);
+        readback.mSync = extensions->glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+        extensions->glBindBuffer(GL_PIXEL_PACK_BUFFER_ARB, 0);
+    }
 }
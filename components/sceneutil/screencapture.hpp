@@ -3,9 +3,14 @@
 
 #include <components/misc/guarded.hpp>
 
+#include <osg/GL>
+#include <osg/GLDefines>
+#include <osg/GraphicsContext>
 #include <osg/ref_ptr>
 #include <osgViewer/ViewerEventHandlers>
 
+#include <atomic>
+#include <cstddef>
 #include <filesystem>
 #include <string>
 #include <vector>
@@ -54,6 +59,40 @@ namespace SceneUtil
         const osg::ref_ptr<osgViewer::ScreenCaptureHandler::CaptureOperation> mImpl;
         Misc::ScopeGuarded<std::vector<osg::ref_ptr<SceneUtil::WorkItem>>> mWorkItems;
     };
+
+    /// @brief Reads the whole frame back into a pixel buffer right before the swap and passes it to the operation
+    /// once the GPU is done with it, usually a frame or two later, instead of waiting for the GPU in the middle of
+    /// the frame.
+    /// @par Falls back to reading the pixels right away when pixel buffers or fences are not supported.
+    class AsyncScreenCapture : public osg::GraphicsContext::SwapCallback
+    {
+    public:
+        explicit AsyncScreenCapture(osg::ref_ptr<osgViewer::ScreenCaptureHandler::CaptureOperation> operation);
+
+        /// Capture the next frame drawn.
+        /// @note Thread safe.
+        void capture() { ++mRequested; }
+
+        void swapBuffersImplementation(osg::GraphicsContext* gc) override;
+
+    private:
+        struct Readback
+        {
+            GLuint mBuffer = 0;
+            GLsync mSync = nullptr;
+            int mWidth = 0;
+            int mHeight = 0;
+        };
+
+        const osg::ref_ptr<osgViewer::ScreenCaptureHandler::CaptureOperation> mOperation;
+        std::atomic<unsigned> mRequested{ 0 };
+        // Only accessed by the thread drawing the context
+        std::vector<Readback> mReadbacks;
+
+        void finish(osg::State& state);
+
+        void read(osg::GraphicsContext& gc);
+    };
 }
 
 #endif
@@ -1,6 +1,8 @@
 #include "serialize.hpp"
 
+#include <osgDB/InputStream>
 #include <osgDB/ObjectWrapper>
+#include <osgDB/OutputStream>
 #include <osgDB/Registry>
 
 #include <components/nifosg/fog.hpp>
@@ -122,6 +124,45 @@ namespace SceneUtil
             : osgDB::ObjectWrapper(createInstanceFunc<NifOsg::MatrixTransform>, "NifOsg::MatrixTransform",
                 "osg::Object osg::Node osg::Group osg::Transform osg::MatrixTransform NifOsg::MatrixTransform")
         {
+            // The components can't be decomposed from the matrix again, keep them for controllers added later
+            addSerializer(new osgDB::UserSerializer<NifOsg::MatrixTransform>(
+                              "NifScale", &checkComponents, &readScale, &writeScale),
+                osgDB::BaseSerializer::RW_USER);
+            addSerializer(new osgDB::UserSerializer<NifOsg::MatrixTransform>(
+                              "NifRotationScale", &checkComponents, &readRotationScale, &writeRotationScale),
+                osgDB::BaseSerializer::RW_USER);
+        }
+
+    private:
+        static bool checkComponents(const NifOsg::MatrixTransform& /*transform*/) { return true; }
+
+        static bool readScale(osgDB::InputStream& stream, NifOsg::MatrixTransform& transform)
+        {
+            stream >> transform.mScale;
+            return true;
+        }
+
+        static bool writeScale(osgDB::OutputStream& stream, const NifOsg::MatrixTransform& transform)
+        {
+            stream << transform.mScale << std::endl;
+            return true;
+        }
+
+        static bool readRotationScale(osgDB::InputStream& stream, NifOsg::MatrixTransform& transform)
+        {
+            for (auto& row : transform.mRotationScale.mValues)
+                for (float& value : row)
+                    stream >> value;
+            return true;
+        }
+
+        static bool writeRotationScale(osgDB::OutputStream& stream, const NifOsg::MatrixTransform& transform)
+        {
+            for (const auto& row : transform.mRotationScale.mValues)
+                for (const float value : row)
+                    stream << value;
+            stream << std::endl;
+            return true;
         }
     };
 
@@ -163,11 +204,27 @@ namespace SceneUtil
         }
     };
 
+    void registerNifSerializers()
+    {
+        static bool done = false;
+        if (!done)
+        {
+            osgDB::ObjectWrapperManager* mgr = osgDB::Registry::instance()->getObjectWrapperManager();
+            mgr->addWrapper(new MatrixTransformSerializer);
+            mgr->addWrapper(new FogSerializer);
+            mgr->addWrapper(new TextureTypeSerializer);
+
+            done = true;
+        }
+    }
+
     void registerSerializers()
     {
         static bool done = false;
         if (!done)
         {
+            registerNifSerializers();
+
             osgDB::ObjectWrapperManager* mgr = osgDB::Registry::instance()->getObjectWrapperManager();
             mgr->addWrapper(new PositionAttitudeTransformSerializer);
             mgr->addWrapper(new SkeletonSerializer);
@@ -177,9 +234,6 @@ namespace SceneUtil
             mgr->addWrapper(new MorphGeometrySerializer);
             mgr->addWrapper(new LightManagerSerializer);
             mgr->addWrapper(new CameraRelativeTransformSerializer);
-            mgr->addWrapper(new MatrixTransformSerializer);
-            mgr->addWrapper(new FogSerializer);
-            mgr->addWrapper(new TextureTypeSerializer);
 
             // Don't serialize Geometry data as we are more interested in the overall structure rather than tons of
             // vertex data that would make the file large and hard to read.
@@ -4,7 +4,13 @@
 namespace SceneUtil
 {
 
+    /// Register the osg serializers needed to write and read back static scene graphs created by NifOsg::Loader if
+    /// not already done so
+    void registerNifSerializers();
+
     /// Register osg node serializers for certain SceneUtil classes if not already done so
+    /// @note Also replaces the osg::Geometry serializer with one that skips the vertex data, geometry written
+    /// afterwards can't be read back.
     void registerSerializers();
 
 }
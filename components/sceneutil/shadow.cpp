@@ -64,6 +64,8 @@ namespace SceneUtil
         const short mapres = static_cast<short>(settings.mShadowMapResolution);
         mShadowSettings->setTextureSize(osg::Vec2s(mapres, mapres));
 
+        mShadowTechnique->setStaticShadowCacheResolution(settings.mStaticShadowCacheResolution);
+
         mShadowTechnique->setSplitPointUniformLogarithmicRatio(settings.mSplitPointUniformLogarithmicRatio);
         mShadowTechnique->setSplitPointDeltaBias(settings.mSplitPointBias);
 
@@ -202,6 +204,7 @@ namespace SceneUtil
             mShadowSettings->setCastsShadowTraversalMask(mIndoorShadowCastingMask);
         else
             mShadowTechnique->disableShadows(true);
+        mShadowTechnique->setStaticShadowCastingMasks(0, ~0u);
     }
 
     void ShadowManager::enableOutdoorMode()
@@ -209,5 +212,18 @@ namespace SceneUtil
         if (mEnableShadows)
             mShadowTechnique->enableShadows();
         mShadowSettings->setCastsShadowTraversalMask(mOutdoorShadowCastingMask);
+        mShadowTechnique->setStaticShadowCastingMasks(mStaticShadowCastingMask, mDynamicShadowCastingMask);
+    }
+
+    void ShadowManager::setStaticShadowCastingMasks(unsigned int staticMask, unsigned int dynamicMask)
+    {
+        mStaticShadowCastingMask = staticMask;
+        mDynamicShadowCastingMask = dynamicMask;
+        enableOutdoorMode();
+    }
+
+    void ShadowManager::invalidateStaticShadowCache()
+    {
+        mShadowTechnique->invalidateStaticShadowCache();
     }
 }
@@ -45,6 +45,13 @@ namespace SceneUtil
 
         void enableOutdoorMode();
 
+        /// Cache casters matching staticMask outdoors, only casters matching dynamicMask are rendered every frame.
+        /// Switches to outdoor mode.
+        void setStaticShadowCastingMasks(unsigned int staticMask, unsigned int dynamicMask);
+
+        /// Must be called when static casters appear or disappear
+        void invalidateStaticShadowCache();
+
     protected:
         static ShadowManager* sInstance;
 
@@ -56,6 +63,8 @@ namespace SceneUtil
 
         unsigned int mOutdoorShadowCastingMask;
         unsigned int mIndoorShadowCastingMask;
+        unsigned int mStaticShadowCastingMask = 0;
+        unsigned int mDynamicShadowCastingMask = ~0u;
     };
 }
 
@@ -0,0 +1,69 @@
+#include "shareduniforms.hpp"
+
+#include <osg/BufferIndexBinding>
+#include <osg/BufferObject>
+#include <osg/BufferTemplate>
+#include <osg/StateSet>
+#include <osg/Uniform>
+
+#include <components/resource/scenemanager.hpp>
+
+#include <stdexcept>
+#include <string>
+#include <tuple>
+#include <type_traits>
+
+namespace SceneUtil
+{
+    namespace
+    {
+        using Buffer = osg::BufferTemplate<SharedUniformData::BufferType>;
+
+        constexpr int sBinding = static_cast<int>(Resource::SceneManager::UBOBinding::SharedUniforms);
+    }
+
+    void addSharedUniforms(osg::StateSet& stateset, const SharedUniformData& data, bool useUBO)
+    {
+        if (useUBO)
+        {
+            osg::ref_ptr<osg::UniformBufferObject> ubo = new osg::UniformBufferObject;
+            osg::ref_ptr<Buffer> buffer = new Buffer;
+            buffer->setBufferObject(ubo);
+            data.copyTo(buffer->getData());
+
+            stateset.setAttributeAndModes(
+                new osg::UniformBufferBinding(sBinding, buffer, 0, SharedUniformData::getGPUSize()),
+                osg::StateAttribute::ON);
+            return;
+        }
+
+        const auto addUniform = [&](const auto& v) {
+            using T = std::decay_t<decltype(v)>;
+            stateset.addUniform(new osg::Uniform(std::string(T::sName).c_str(), v.mValue));
+        };
+
+        std::apply([&](const auto&... v) { (addUniform(v), ...); }, data.getData());
+    }
+
+    void setSharedUniforms(osg::StateSet& stateset, const SharedUniformData& data, bool useUBO)
+    {
+        if (useUBO)
+        {
+            osg::UniformBufferBinding* binding = dynamic_cast<osg::UniformBufferBinding*>(
+                stateset.getAttribute(osg::StateAttribute::UNIFORMBUFFERBINDING, sBinding));
+            if (!binding)
+                throw std::runtime_error("setSharedUniforms: failed to get an UniformBufferBinding!");
+
+            data.copyTo(static_cast<Buffer*>(binding->getBufferData())->getData());
+            binding->getBufferData()->dirty();
+            return;
+        }
+
+        const auto setUniform = [&](const auto& v) {
+            using T = std::decay_t<decltype(v)>;
+            stateset.getUniform(std::string(T::sName))->set(v.mValue);
+        };
+
+        std::apply([&](const auto&... v) { (setUniform(v), ...); }, data.getData());
+    }
+}
@@ -0,0 +1,63 @@
+#ifndef OPENMW_COMPONENTS_SCENEUTIL_SHAREDUNIFORMS_H
+#define OPENMW_COMPONENTS_SCENEUTIL_SHAREDUNIFORMS_H
+
+#include <components/std140/ubo.hpp>
+
+#include <string_view>
+
+namespace osg
+{
+    class StateSet;
+}
+
+namespace SceneUtil
+{
+    namespace SharedUniform
+    {
+        struct PlayerPos : Std140::Vec3
+        {
+            static constexpr std::string_view sName = "playerPos";
+        };
+
+        struct Near : Std140::Float
+        {
+            static constexpr std::string_view sName = "near";
+        };
+
+        struct ScreenRes : Std140::Vec2
+        {
+            static constexpr std::string_view sName = "screenRes";
+        };
+
+        struct Far : Std140::Float
+        {
+            static constexpr std::string_view sName = "far";
+        };
+
+        struct SkyBlendingStart : Std140::Float
+        {
+            static constexpr std::string_view sName = "skyBlendingStart";
+        };
+
+        struct WindSpeed : Std140::Float
+        {
+            static constexpr std::string_view sName = "windSpeed";
+        };
+    }
+
+    /// Values read by most scene shaders that change at most once per frame. The order has to match the
+    /// SharedUniforms block in lib/core/uniforms.glsl.
+    using SharedUniformData = Std140::UBO<SharedUniform::PlayerPos, SharedUniform::Near, SharedUniform::ScreenRes,
+        SharedUniform::Far, SharedUniform::SkyBlendingStart, SharedUniform::WindSpeed>;
+
+    /// @brief Add the shared values to the stateset.
+    /// @par With uniform buffers the values are stored in a single block that is uploaded once when it changes,
+    /// instead of one uniform per value that every program using it uploads on its own.
+    /// @param useUBO has to match the useUBO shader define
+    void addSharedUniforms(osg::StateSet& stateset, const SharedUniformData& data, bool useUBO);
+
+    /// Update the values added to the stateset by addSharedUniforms.
+    void setSharedUniforms(osg::StateSet& stateset, const SharedUniformData& data, bool useUBO);
+}
+
+#endif
@@ -80,7 +80,9 @@ namespace SceneUtil
 
             if (it == bone->mChildren.end())
             {
+                Bone* const parent = bone == mRootBone.get() ? nullptr : bone;
                 bone = bone->mChildren.emplace_back(std::make_unique<Bone>()).get();
+                bone->mParent = parent;
                 mNeedToUpdateBoneMatrices = true;
             }
             else
@@ -94,6 +96,8 @@ namespace SceneUtil
 
     void Skeleton::updateBoneMatrices(unsigned int traversalNumber)
     {
+        std::lock_guard<std::mutex> lock(mBoneMatricesMutex);
+
         if (traversalNumber != mLastFrameNumber)
             mNeedToUpdateBoneMatrices = true;
 
@@ -111,6 +115,24 @@ namespace SceneUtil
         }
     }
 
+    void Skeleton::updateBoneMatrices(unsigned int traversalNumber, const std::vector<Bone*>& bones)
+    {
+        std::lock_guard<std::mutex> lock(mBoneMatricesMutex);
+
+        if (traversalNumber != mLastFrameNumber)
+            mNeedToUpdateBoneMatrices = true;
+
+        mLastFrameNumber = traversalNumber;
+
+        // The whole hierarchy was already updated in this frame
+        if (!mNeedToUpdateBoneMatrices)
+            return;
+
+        for (Bone* bone : bones)
+            if (bone != nullptr)
+                bone->updateChain(traversalNumber);
+    }
+
     void Skeleton::setActive(ActiveType active)
     {
         mActive = active;
@@ -155,6 +177,8 @@ namespace SceneUtil
 
     Bone::Bone()
         : mNode(nullptr)
+        , mParent(nullptr)
+        , mLastFrameNumber(0)
     {
     }
 
@@ -174,4 +198,24 @@ namespace SceneUtil
             child->update(&mMatrixInSkeletonSpace);
     }
 
+    void Bone::updateChain(unsigned int traversalNumber)
+    {
+        if (mLastFrameNumber == traversalNumber)
+            return;
+        if (!mNode)
+        {
+            Log(Debug::Error) << "Error: Bone without node";
+            return;
+        }
+        if (mParent)
+        {
+            mParent->updateChain(traversalNumber);
+            mMatrixInSkeletonSpace = mNode->getMatrix() * mParent->mMatrixInSkeletonSpace;
+        }
+        else
+            mMatrixInSkeletonSpace = mNode->getMatrix();
+
+        mLastFrameNumber = traversalNumber;
+    }
+
 }
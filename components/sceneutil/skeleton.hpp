@@ -3,8 +3,11 @@
 
 #include <osg/Group>
 
+#include <atomic>
 #include <memory>
+#include <mutex>
 #include <unordered_map>
+#include <vector>
 
 namespace SceneUtil
 {
@@ -20,10 +23,19 @@ namespace SceneUtil
 
         osg::MatrixTransform* mNode;
 
+        /// nullptr for bones attached to the root bone.
+        Bone* mParent;
+
         std::vector<std::unique_ptr<Bone>> mChildren;
 
         /// Update the skeleton-space matrix of this bone and all its children.
         void update(const osg::Matrixf* parentMatrixInSkeletonSpace);
+
+        /// Update the skeleton-space matrix of this bone and its parents, unless already updated in this frame.
+        void updateChain(unsigned int traversalNumber);
+
+    private:
+        unsigned int mLastFrameNumber;
     };
 
     /// @brief Handles the bone matrices for any number of child RigGeometries.
@@ -43,6 +55,10 @@ namespace SceneUtil
         /// Request an update of bone matrices. May be a no-op if already updated in this frame.
         void updateBoneMatrices(unsigned int traversalNumber);
 
+        /// Request an update of the given bones and their parents only, bones used only by rigs that aren't drawn or
+        /// whose bounds aren't computed in this frame are left alone.
+        void updateBoneMatrices(unsigned int traversalNumber, const std::vector<Bone*>& bones);
+
         enum ActiveType
         {
             Inactive = 0,
@@ -56,6 +72,18 @@ namespace SceneUtil
 
         bool getActive() const;
 
+        /// Skin the child rigs again only after requestSkinning() instead of in every frame, for skeletons animated
+        /// less often than every frame. The rigs keep drawing the geometry skinned for the last request meanwhile.
+        void setSkinOnRequest(bool value) { mSkinOnRequest = value; }
+
+        bool getSkinOnRequest() const { return mSkinOnRequest; }
+
+        /// Have the child rigs skinned again, call when the bones were moved.
+        /// @note Thread safe.
+        void requestSkinning() { ++mSkinningRequest; }
+
+        unsigned getSkinningRequest() const { return mSkinningRequest; }
+
         void traverse(osg::NodeVisitor& nv) override;
 
         void markDirty();
@@ -76,7 +104,11 @@ namespace SceneUtil
 
         ActiveType mActive;
 
+        std::atomic<bool> mSkinOnRequest{ false };
+        std::atomic<unsigned> mSkinningRequest{ 0 };
+
         unsigned int mLastFrameNumber;
+        std::mutex mBoneMatricesMutex;
         unsigned int mLastCullFrameNumber;
     };
 
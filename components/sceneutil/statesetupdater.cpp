@@ -59,6 +59,7 @@ namespace SceneUtil
 
     osg::StateSet* StateSetUpdater::getCvDependentStateset(osgUtil::CullVisitor* cv)
     {
+        std::lock_guard<std::mutex> lock(mStateSetsCullMutex);
         auto it = mStateSetsCull.find(cv);
         if (it == mStateSetsCull.end())
         {
@@ -5,6 +5,7 @@
 
 #include <array>
 #include <map>
+#include <mutex>
 
 namespace osgUtil
 {
@@ -67,6 +68,7 @@ namespace SceneUtil
 
         std::array<osg::ref_ptr<osg::StateSet>, 2> mStateSetsUpdate;
         std::map<osgUtil::CullVisitor*, osg::ref_ptr<osg::StateSet>> mStateSetsCull;
+        std::mutex mStateSetsCullMutex;
     };
 
     /// @brief A variant of the StateSetController that can be made up of multiple controllers all controlling the same
@@ -32,9 +32,26 @@ namespace SceneUtil
             if (separator != std::string::npos)
                 mGroups.emplace(textKey.substr(0, separator));
 
+            mTimeByTextKey.emplace(textKey, time);
             mTextKeyByTime.emplace(time, std::move(textKey));
         }
 
+        /// @return time of the earliest text key starting with the prefix or -1 if there is none
+        float findTime(std::string_view prefix) const
+        {
+            // Text keys starting with the prefix are adjacent in the name order, usually there is only one
+            float result = -1;
+            bool found = false;
+            for (auto it = mTimeByTextKey.lower_bound(prefix);
+                 it != mTimeByTextKey.end() && it->first.starts_with(prefix); ++it)
+            {
+                if (!found || it->second < result)
+                    result = it->second;
+                found = true;
+            }
+            return result;
+        }
+
         bool empty() const noexcept { return mTextKeyByTime.empty(); }
 
         auto findGroupStart(std::string_view groupName) const
@@ -59,6 +76,7 @@ namespace SceneUtil
 
         std::set<std::string, std::less<>> mGroups;
         std::multimap<float, std::string> mTextKeyByTime;
+        std::multimap<std::string, float, std::less<>> mTimeByTextKey;
     };
 }
 
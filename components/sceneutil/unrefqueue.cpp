@@ -13,6 +13,7 @@ namespace SceneUtil
             explicit ClearVector(std::vector<osg::ref_ptr<osg::Referenced>>&& objects)
                 : mObjects(std::move(objects))
             {
+                setPriority(SceneUtil::WorkPriority::Low);
             }
 
             void doWork() override { mObjects.clear(); }
@@ -1,11 +1,52 @@
 #include "workqueue.hpp"
 
 #include <components/debug/debuglog.hpp>
+#include <components/debug/tracing.hpp>
 
+#include <osg/Stats>
+
+#include <algorithm>
 #include <numeric>
+#include <string>
 
 namespace SceneUtil
 {
+    namespace
+    {
+        constexpr double statsSmoothing = 0.1;
+
+        void addSample(double& average, WorkItem::Clock::duration value)
+        {
+            average += (std::chrono::duration<double>(value).count() - average) * statsSmoothing;
+        }
+    }
+
+    std::string_view getWorkPriorityName(WorkPriority value)
+    {
+        switch (value)
+        {
+            case WorkPriority::High:
+                return "High";
+            case WorkPriority::Normal:
+                return "Normal";
+            case WorkPriority::Low:
+                return "Low";
+        }
+        return "Unknown";
+    }
+
+    void reportStats(unsigned frameNumber, const WorkQueueStats& stats, osg::Stats& out)
+    {
+        for (std::size_t i = 0; i < workPriorityCount; ++i)
+        {
+            const WorkQueueStats::Priority& priority = stats.mPriorities[i];
+            const std::string prefix = "WorkQueue " + std::string(getWorkPriorityName(static_cast<WorkPriority>(i)));
+            out.setAttribute(frameNumber, prefix + " Depth", static_cast<double>(priority.mDepth));
+            out.setAttribute(frameNumber, prefix + " Processed", static_cast<double>(priority.mProcessed));
+            out.setAttribute(frameNumber, prefix + " Wait", priority.mWaitTime * 1000.0);
+            out.setAttribute(frameNumber, prefix + " Run", priority.mRunTime * 1000.0);
+        }
+    }
 
     void WorkItem::waitTillDone()
     {
@@ -19,6 +60,15 @@ namespace SceneUtil
         }
     }
 
+    bool WorkItem::waitTillDone(Clock::duration timeout)
+    {
+        if (mDone)
+            return true;
+
+        std::unique_lock<std::mutex> lock(mMutex);
+        return mCondition.wait_for(lock, timeout, [&] { return mDone.load(); });
+    }
+
     void WorkItem::signalDone()
     {
         {
@@ -58,8 +108,8 @@ namespace SceneUtil
     {
         {
             std::unique_lock<std::mutex> lock(mMutex);
-            while (!mQueue.empty())
-                mQueue.pop_back();
+            for (std::deque<QueuedItem>& queue : mQueues)
+                queue.clear();
             mIsReleased = true;
             mCondition.notify_all();
         }
@@ -76,33 +126,107 @@ namespace SceneUtil
         }
 
         std::unique_lock<std::mutex> lock(mMutex);
+        std::deque<QueuedItem>& queue = mQueues[static_cast<std::size_t>(item->getPriority())];
         if (front)
-            mQueue.push_front(std::move(item));
+            queue.push_front(QueuedItem{ std::move(item), --mFrontOrder, WorkItem::Clock::now() });
         else
-            mQueue.push_back(std::move(item));
+            queue.push_back(QueuedItem{ std::move(item), ++mBackOrder, WorkItem::Clock::now() });
         mCondition.notify_one();
     }
 
+    void WorkQueue::setViewPoint(const osg::Vec3f& value)
+    {
+        std::unique_lock<std::mutex> lock(mMutex);
+        mViewPoint = value;
+    }
+
     osg::ref_ptr<WorkItem> WorkQueue::removeWorkItem()
     {
         std::unique_lock<std::mutex> lock(mMutex);
-        while (mQueue.empty() && !mIsReleased)
+        const auto isEmpty = [&] {
+            return std::all_of(mQueues.begin(), mQueues.end(), [](const auto& v) { return v.empty(); });
+        };
+        while (isEmpty() && !mIsReleased)
         {
             mCondition.wait(lock);
         }
-        if (!mQueue.empty())
+        if (isEmpty())
+            return nullptr;
+
+        const auto getDistance2 = [&](const QueuedItem& v) {
+            const std::optional<osg::Vec3f>& position = v.mItem->getPosition();
+            if (!position.has_value() || !mViewPoint.has_value())
+                return 0.0f;
+            return (*position - *mViewPoint).length2();
+        };
+        const auto isBefore = [&](const QueuedItem& lhs, const QueuedItem& rhs) {
+            const std::optional<WorkItem::Clock::time_point>& lhsDeadline = lhs.mItem->getDeadline();
+            const std::optional<WorkItem::Clock::time_point>& rhsDeadline = rhs.mItem->getDeadline();
+            if (lhsDeadline != rhsDeadline)
+                return lhsDeadline.has_value() && (!rhsDeadline.has_value() || *lhsDeadline < *rhsDeadline);
+            const float lhsDistance2 = getDistance2(lhs);
+            const float rhsDistance2 = getDistance2(rhs);
+            if (lhsDistance2 != rhsDistance2)
+                return lhsDistance2 < rhsDistance2;
+            return lhs.mOrder < rhs.mOrder;
+        };
+
+        const WorkItem::Clock::time_point now = WorkItem::Clock::now();
+        std::size_t queueIndex = workPriorityCount;
+        std::deque<QueuedItem>::iterator selected;
+
+        // Items that missed the deadline go first regardless of the priority class
+        for (std::size_t i = 0; i < mQueues.size(); ++i)
+        {
+            for (auto it = mQueues[i].begin(); it != mQueues[i].end(); ++it)
+            {
+                const std::optional<WorkItem::Clock::time_point>& deadline = it->mItem->getDeadline();
+                if (!deadline.has_value() || *deadline > now)
+                    continue;
+                if (queueIndex == workPriorityCount || *deadline < *selected->mItem->getDeadline())
+                {
+                    queueIndex = i;
+                    selected = it;
+                }
+            }
+        }
+
+        if (queueIndex == workPriorityCount)
         {
-            osg::ref_ptr<WorkItem> item = std::move(mQueue.front());
-            mQueue.pop_front();
-            return item;
+            queueIndex = static_cast<std::size_t>(
+                std::find_if(mQueues.begin(), mQueues.end(), [](const auto& v) { return !v.empty(); })
+                - mQueues.begin());
+            selected = std::min_element(mQueues[queueIndex].begin(), mQueues[queueIndex].end(), isBefore);
         }
-        return nullptr;
+
+        osg::ref_ptr<WorkItem> item = std::move(selected->mItem);
+        WorkQueueStats::Priority& stats = mStats.mPriorities[queueIndex];
+        ++stats.mProcessed;
+        addSample(stats.mWaitTime, now - selected->mQueued);
+        mQueues[queueIndex].erase(selected);
+        return item;
+    }
+
+    void WorkQueue::reportRunTime(WorkPriority priority, WorkItem::Clock::duration value)
+    {
+        std::unique_lock<std::mutex> lock(mMutex);
+        addSample(mStats.mPriorities[static_cast<std::size_t>(priority)].mRunTime, value);
     }
 
     size_t WorkQueue::getNumItems() const
     {
         std::unique_lock<std::mutex> lock(mMutex);
-        return mQueue.size();
+        return std::accumulate(
+            mQueues.begin(), mQueues.end(), std::size_t{ 0 }, [](auto r, const auto& v) { return r + v.size(); });
+    }
+
+    WorkQueueStats WorkQueue::getStats() const
+    {
+        std::unique_lock<std::mutex> lock(mMutex);
+        WorkQueueStats result = mStats;
+        for (std::size_t i = 0; i < mQueues.size(); ++i)
+            result.mPriorities[i].mDepth = mQueues[i].size();
+        return result;
     }
 
     size_t WorkQueue::getNumActiveThreads() const
@@ -125,13 +249,19 @@ namespace SceneUtil
 
     void WorkThread::run()
     {
+        Debug::Tracing::setThreadName("WorkQueue");
         while (true)
         {
             osg::ref_ptr<WorkItem> item = mWorkQueue->removeWorkItem();
             if (!item)
                 return;
             mActive = true;
-            item->doWork();
+            const WorkItem::Clock::time_point start = WorkItem::Clock::now();
+            {
+                Debug::TraceZone zone("WorkItem");
+                item->doWork();
+            }
+            mWorkQueue->reportRunTime(item->getPriority(), WorkItem::Clock::now() - start);
             item->signalDone();
             mActive = false;
         }
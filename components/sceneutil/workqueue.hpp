@@ -2,21 +2,45 @@
 #define OPENMW_COMPONENTS_SCENEUTIL_WORKQUEUE_H
 
 #include <osg/Referenced>
+#include <osg/Vec3f>
 #include <osg/ref_ptr>
 
+#include <array>
 #include <atomic>
+#include <chrono>
 #include <condition_variable>
+#include <cstddef>
+#include <cstdint>
 #include <deque>
 #include <mutex>
+#include <optional>
+#include <string_view>
 #include <thread>
 #include <vector>
 
+namespace osg
+{
+    class Stats;
+}
+
 namespace SceneUtil
 {
+    enum class WorkPriority : std::uint8_t
+    {
+        High,
+        Normal,
+        Low,
+    };
+
+    inline constexpr std::size_t workPriorityCount = 3;
+
+    std::string_view getWorkPriorityName(WorkPriority value);
 
     class WorkItem : public osg::Referenced
     {
     public:
+        using Clock = std::chrono::steady_clock;
+
         /// Override in a derived WorkItem to perform actual work.
         virtual void doWork() {}
 
@@ -25,13 +49,39 @@ namespace SceneUtil
         /// Wait until the work is completed. Usually called from the main thread.
         void waitTillDone();
 
+        /// Wait until the work is completed or the timeout expires.
+        /// @return true if the work is completed
+        bool waitTillDone(Clock::duration timeout);
+
         /// Internal use by the WorkQueue.
         void signalDone();
 
         /// Set abort flag in order to return from doWork() as soon as possible. May not be respected by all WorkItems.
         virtual void abort() {}
 
+        /// Items of a higher priority class are always processed before items of a lower one.
+        /// @note Should be set before the item is added to the queue.
+        void setPriority(WorkPriority value) { mPriority = value; }
+
+        WorkPriority getPriority() const { return mPriority; }
+
+        /// Items with expired deadline are processed before any other item regardless of priority class. Within a
+        /// priority class items with earlier deadlines go first.
+        /// @note Should be set before the item is added to the queue.
+        void setDeadline(Clock::time_point value) { mDeadline = value; }
+
+        const std::optional<Clock::time_point>& getDeadline() const { return mDeadline; }
+
+        /// Within a priority class items closer to the view point set by WorkQueue::setViewPoint go first.
+        /// @note Should be set before the item is added to the queue.
+        void setPosition(const osg::Vec3f& value) { mPosition = value; }
+
+        const std::optional<osg::Vec3f>& getPosition() const { return mPosition; }
+
     private:
+        WorkPriority mPriority = WorkPriority::Normal;
+        std::optional<Clock::time_point> mDeadline;
+        std::optional<osg::Vec3f> mPosition;
         std::atomic_bool mDone{ false };
         std::mutex mMutex;
         std::condition_variable mCondition;
@@ -39,9 +89,27 @@ namespace SceneUtil
 
     class WorkThread;
 
+    struct WorkQueueStats
+    {
+        struct Priority
+        {
+            std::size_t mDepth = 0;
+            std::size_t mProcessed = 0;
+            /// Exponential moving average of time items spend in the queue, in seconds.
+            double mWaitTime = 0;
+            /// Exponential moving average of WorkItem::doWork duration, in seconds.
+            double mRunTime = 0;
+        };
+
+        std::array<Priority, workPriorityCount> mPriorities;
+    };
+
+    void reportStats(unsigned frameNumber, const WorkQueueStats& stats, osg::Stats& out);
+
     /// @brief A work queue that users can push work items onto, to be completed by one or more background threads.
-    /// @note Work items will be processed in the order that they were given in, however
-    /// if multiple work threads are involved then it is possible for a later item to complete before earlier items.
+    /// @note Work items are processed by priority class first, then by deadline and distance to the view point, then
+    /// in the order that they were given in. If multiple work threads are involved then it is possible for a later
+    /// item to complete before earlier items.
     class WorkQueue : public osg::Referenced
     {
     public:
@@ -54,21 +122,40 @@ namespace SceneUtil
 
         /// Add a new work item to the back of the queue.
         /// @par The work item's waitTillDone() method may be used by the caller to wait until the work is complete.
-        /// @param front If true, add item to the front of the queue. If false (default), add to the back.
+        /// @param front If true, add item to the front of its priority class. If false (default), add to the back.
         void addWorkItem(osg::ref_ptr<WorkItem> item, bool front = false);
 
+        /// Reorder queued items having a position by distance to the given point, usually the camera or player.
+        void setViewPoint(const osg::Vec3f& value);
+
         /// Get the next work item from the front of the queue. If the queue is empty, waits until a new item is added.
         /// If the workqueue is in the process of being destroyed, may return nullptr.
         /// @par Used internally by the WorkThread.
         osg::ref_ptr<WorkItem> removeWorkItem();
 
+        /// @par Used internally by the WorkThread.
+        void reportRunTime(WorkPriority priority, WorkItem::Clock::duration value);
+
         size_t getNumItems() const;
 
         size_t getNumActiveThreads() const;
 
+        WorkQueueStats getStats() const;
+
     private:
+        struct QueuedItem
+        {
+            osg::ref_ptr<WorkItem> mItem;
+            std::int64_t mOrder;
+            WorkItem::Clock::time_point mQueued;
+        };
+
         bool mIsReleased;
-        std::deque<osg::ref_ptr<WorkItem>> mQueue;
+        std::array<std::deque<QueuedItem>, workPriorityCount> mQueues;
+        std::int64_t mFrontOrder = 0;
+        std::int64_t mBackOrder = 0;
+        std::optional<osg::Vec3f> mViewPoint;
+        WorkQueueStats mStats;
 
         mutable std::mutex mMutex;
         std::condition_variable mCondition;
@@ -32,9 +32,17 @@ namespace Settings
         SettingValue<float> mMinRateDistance{ mIndex, "Animation LOD", "min rate distance",
             makeClampSanitizerFloat(0, 16384) };
 
-        // Minimum animation update interval for distant actors (in seconds)
-        SettingValue<float> mMinUpdateInterval{ mIndex, "Animation LOD", "min update interval",
-            makeClampSanitizerFloat(0.0f, 1.0f) };
+        // Actors in bucket N are updated once per 2^N frames, distant actors get the max bucket
+        SettingValue<int> mMaxUpdateBucket{ mIndex, "Animation LOD", "max update bucket",
+            makeClampSanitizerInt(0, 4) };
+
+        // Max bucket for actors inside camera FOV
+        SettingValue<int> mMaxVisibleUpdateBucket{ mIndex, "Animation LOD", "max visible update bucket",
+            makeClampSanitizerInt(0, 4) };
+
+        // Visible actors with larger projected radius (fraction of half screen height) are updated every frame
+        SettingValue<float> mFullRateScreenSize{ mIndex, "Animation LOD", "full rate screen size",
+            makeClampSanitizerFloat(0, 1) };
 
         // Extra FOV margin for culling (in degrees) to prevent popping
         SettingValue<float> mFOVMargin{ mIndex, "Animation LOD", "fov margin",
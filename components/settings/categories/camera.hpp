@@ -22,11 +22,23 @@ namespace Settings
         SettingValue<bool> mSmallFeatureCulling{ mIndex, "Camera", "small feature culling" };
         SettingValue<float> mSmallFeatureCullingPixelSize{ mIndex, "Camera", "small feature culling pixel size",
             makeMaxStrictSanitizerFloat(0) };
+        SettingValue<bool> mContributionCulling{ mIndex, "Camera", "contribution culling" };
+        SettingValue<float> mClutterCullingPixelSize{ mIndex, "Camera", "clutter culling pixel size",
+            makeMaxSanitizerFloat(0) };
+        SettingValue<float> mStaticCullingPixelSize{ mIndex, "Camera", "static culling pixel size",
+            makeMaxSanitizerFloat(0) };
+        SettingValue<float> mReflectionCullingScale{ mIndex, "Camera", "reflection culling scale",
+            makeMaxSanitizerFloat(0) };
+        SettingValue<float> mShadowCullingTexelSize{ mIndex, "Camera", "shadow culling texel size",
+            makeMaxSanitizerFloat(0) };
+        SettingValue<float> mCullingHysteresis{ mIndex, "Camera", "culling hysteresis", makeMaxSanitizerFloat(1) };
+        SettingValue<bool> mOcclusionCulling{ mIndex, "Camera", "occlusion culling" };
         SettingValue<float> mViewingDistance{ mIndex, "Camera", "viewing distance", makeMaxStrictSanitizerFloat(0) };
         SettingValue<float> mFieldOfView{ mIndex, "Camera", "field of view", makeClampSanitizerFloat(1, 179) };
         SettingValue<float> mFirstPersonFieldOfView{ mIndex, "Camera", "first person field of view",
             makeClampSanitizerFloat(1, 179) };
         SettingValue<bool> mReverseZ{ mIndex, "Camera", "reverse z" };
+        SettingValue<int> mParallelCullThreads{ mIndex, "Camera", "parallel cull threads", makeMaxSanitizerInt(0) };
     };
 }
 
@@ -8,6 +8,7 @@
 #include <osg/Vec2f>
 #include <osg/Vec3f>
 
+#include <cstddef>
 #include <cstdint>
 #include <string>
 #include <string_view>
@@ -30,10 +31,20 @@ namespace Settings
         SettingValue<float> mPreloadCellExpiryDelay{ mIndex, "Cells", "preload cell expiry delay",
             makeMaxSanitizerFloat(0) };
         SettingValue<float> mPredictionTime{ mIndex, "Cells", "prediction time", makeMaxSanitizerFloat(0) };
+        SettingValue<bool> mPredictivePreload{ mIndex, "Cells", "predictive preload" };
+        SettingValue<float> mPredictivePreloadTime{ mIndex, "Cells", "predictive preload time",
+            makeMaxSanitizerFloat(0) };
         SettingValue<float> mCacheExpiryDelay{ mIndex, "Cells", "cache expiry delay", makeMaxSanitizerFloat(0) };
+        SettingValue<std::size_t> mCacheShardSizeLimit{ mIndex, "Cells", "cache shard size limit" };
+        SettingValue<bool> mMeshCache{ mIndex, "Cells", "mesh cache" };
+        SettingValue<int> mMeshCacheSize{ mIndex, "Cells", "mesh cache size", makeMaxSanitizerInt(1) };
+        SettingValue<bool> mParallelMeshBuilding{ mIndex, "Cells", "parallel mesh building" };
+        SettingValue<bool> mOptimizeVertexCache{ mIndex, "Cells", "optimize vertex cache" };
         SettingValue<float> mTargetFramerate{ mIndex, "Cells", "target framerate", makeMaxStrictSanitizerFloat(0) };
         SettingValue<int> mPointersCacheSize{ mIndex, "Cells", "pointers cache size", makeClampSanitizerInt(40, 1000) };
         SettingValue<bool> mCellOptimization{ mIndex, "Cells", "cell optimization" };
+        SettingValue<int> mMaxCellLoadsPerFrame{ mIndex, "Cells", "max cell loads per frame", makeMaxSanitizerInt(0) };
+        SettingValue<int> mEffectPoolSize{ mIndex, "Cells", "effect pool size", makeMaxSanitizerInt(0) };
     };
 }
 
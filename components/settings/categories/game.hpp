@@ -59,6 +59,7 @@ namespace Settings
             makeMaxSanitizerFloat(0.01f) };
         SettingValue<bool> mNPCsAvoidCollisions{ mIndex, "Game", "NPCs avoid collisions" };
         SettingValue<bool> mNPCsGiveWay{ mIndex, "Game", "NPCs give way" };
+        SettingValue<int> mActorsUpdateThreads{ mIndex, "Game", "actors update threads", makeMaxSanitizerInt(0) };
         SettingValue<bool> mSwimUpwardCorrection{ mIndex, "Game", "swim upward correction" };
         SettingValue<float> mSwimUpwardCoef{ mIndex, "Game", "swim upward coef", makeClampSanitizerFloat(-1, 1) };
         SettingValue<bool> mTrainersTrainingSkillsBasedOnBaseSkill{ mIndex, "Game",
@@ -32,6 +32,18 @@ namespace Settings
         SettingValue<bool> mGmstOverridesL10n{ mIndex, "General", "gmst overrides l10n" };
         SettingValue<std::size_t> mLogBufferSize{ mIndex, "General", "log buffer size" };
         SettingValue<std::size_t> mConsoleHistoryBufferSize{ mIndex, "General", "console history buffer size" };
+        SettingValue<bool> mMemoryMappedArchives{ mIndex, "General", "memory mapped archives" };
+        SettingValue<std::size_t> mContentReadAhead{ mIndex, "General", "content read ahead" };
+        SettingValue<bool> mContentCache{ mIndex, "General", "content cache" };
+        SettingValue<bool> mFlatRecordStorage{ mIndex, "General", "flat record storage" };
+        SettingValue<float> mDeferredTaskBudget{ mIndex, "General", "deferred task budget",
+            makeMaxSanitizerFloat(0) };
+        SettingValue<std::size_t> mTraceBufferSize{ mIndex, "General", "trace buffer size" };
+        SettingValue<float> mTraceFrameThreshold{ mIndex, "General", "trace frame threshold",
+            makeMaxSanitizerFloat(0) };
+        SettingValue<float> mFrameSpikeFactor{ mIndex, "General", "frame spike factor", makeMaxSanitizerFloat(0) };
+        SettingValue<bool> mRecordResourceAccess{ mIndex, "General", "record resource access" };
+        SettingValue<bool> mStartupPrefetch{ mIndex, "General", "startup prefetch" };
     };
 }
 
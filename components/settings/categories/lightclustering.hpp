@@ -18,9 +18,6 @@ namespace Settings
     {
         using WithIndex::WithIndex;
 
-        // Enable light clustering for improved performance
-        SettingValue<bool> mEnabled{ mIndex, "Light Clustering", "enabled" };
-
         // Number of clusters along X axis (screen width)
         SettingValue<int> mClustersX{ mIndex, "Light Clustering", "clusters x",
             makeClampSanitizerInt(1, 64) };
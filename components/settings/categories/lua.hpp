@@ -27,6 +27,9 @@ namespace Settings
         SettingValue<std::uint64_t> mInstructionLimitPerCall{ mIndex, "Lua", "instruction limit per call",
             makeMaxSanitizerUInt64(1001) };
         SettingValue<int> mGcStepsPerFrame{ mIndex, "Lua", "gc steps per frame", makeMaxSanitizerInt(0) };
+        SettingValue<float> mUpdateBudget{ mIndex, "Lua", "update budget", makeMaxSanitizerFloat(0) };
+        SettingValue<float> mGcTimeBudget{ mIndex, "Lua", "gc time budget", makeMaxSanitizerFloat(0) };
+        SettingValue<bool> mBytecodeCache{ mIndex, "Lua", "bytecode cache" };
     };
 }
 
@@ -43,6 +43,8 @@ namespace Settings
         SettingValue<std::size_t> mAsyncNavMeshUpdaterThreads{ mIndex, "Navigator", "async nav mesh updater threads",
             makeMaxSanitizerSize(1) };
         SettingValue<std::size_t> mMaxNavMeshTilesCacheSize{ mIndex, "Navigator", "max nav mesh tiles cache size" };
+        SettingValue<std::size_t> mMaxAgentNavMeshTilesCacheSize{ mIndex, "Navigator",
+            "max agent nav mesh tiles cache size" };
         SettingValue<std::size_t> mMaxPolygonPathSize{ mIndex, "Navigator", "max polygon path size" };
         SettingValue<std::size_t> mMaxSmoothPathSize{ mIndex, "Navigator", "max smooth path size" };
         SettingValue<bool> mEnableWriteRecastMeshToFile{ mIndex, "Navigator", "enable write recast mesh to file" };
@@ -58,12 +60,25 @@ namespace Settings
         SettingValue<bool> mEnableRecastMeshRender{ mIndex, "Navigator", "enable recast mesh render" };
         SettingValue<int> mMaxTilesNumber{ mIndex, "Navigator", "max tiles number", makeMaxSanitizerInt(0) };
         SettingValue<int> mMinUpdateIntervalMs{ mIndex, "Navigator", "min update interval ms", makeMaxSanitizerInt(0) };
+        SettingValue<float> mMaxObstacleSize{ mIndex, "Navigator", "max obstacle size", makeMaxSanitizerFloat(0) };
+        SettingValue<std::size_t> mMaxObstacleHeightfieldsCacheSize{ mIndex, "Navigator",
+            "max obstacle heightfields cache size" };
         SettingValue<int> mWaitUntilMinDistanceToPlayer{ mIndex, "Navigator", "wait until min distance to player",
             makeMaxSanitizerInt(0) };
         SettingValue<bool> mEnableNavMeshDiskCache{ mIndex, "Navigator", "enable nav mesh disk cache" };
         SettingValue<bool> mWriteToNavmeshdb{ mIndex, "Navigator", "write to navmeshdb" };
         SettingValue<std::uint64_t> mMaxNavmeshdbFileSize{ mIndex, "Navigator", "max navmeshdb file size" };
+        SettingValue<bool> mNavmeshdbWriteAheadLog{ mIndex, "Navigator", "navmeshdb write ahead log" };
+        SettingValue<int> mNavmeshdbSynchronous{ mIndex, "Navigator", "navmeshdb synchronous",
+            makeEnumSanitizerInt({ 0, 1, 2 }) };
+        SettingValue<int> mNavmeshdbCheckpointIntervalMs{ mIndex, "Navigator", "navmeshdb checkpoint interval ms",
+            makeMaxSanitizerInt(0) };
+        SettingValue<int> mNavmeshdbTransactionTiles{ mIndex, "Navigator", "navmeshdb transaction tiles",
+            makeMaxSanitizerInt(1) };
+        SettingValue<int> mNavmeshdbTransactionIntervalMs{ mIndex, "Navigator", "navmeshdb transaction interval ms",
+            makeMaxSanitizerInt(0) };
         SettingValue<bool> mWaitForAllJobsOnExit{ mIndex, "Navigator", "wait for all jobs on exit" };
+        SettingValue<bool> mAsyncPathRequests{ mIndex, "Navigator", "async path requests" };
     };
 }
 
@@ -19,8 +19,13 @@ namespace Settings
         using WithIndex::WithIndex;
 
         SettingValue<int> mAsyncNumThreads{ mIndex, "Physics", "async num threads", makeMaxSanitizerInt(0) };
+        SettingValue<std::string> mAsyncThreadCores{ mIndex, "Physics", "async thread cores" };
         SettingValue<int> mLineofsightKeepInactiveCache{ mIndex, "Physics", "lineofsight keep inactive cache",
             makeMaxSanitizerInt(-1) };
+        SettingValue<int> mLineofsightMaxRefreshInterval{ mIndex, "Physics", "lineofsight max refresh interval",
+            makeMaxSanitizerInt(1) };
+        SettingValue<int> mLineofsightCacheSize{ mIndex, "Physics", "lineofsight cache size",
+            makeMaxSanitizerInt(1) };
     };
 }
 
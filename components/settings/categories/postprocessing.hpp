@@ -22,6 +22,8 @@ namespace Settings
         SettingValue<std::vector<std::string>> mChain{ mIndex, "Post Processing", "chain" };
         SettingValue<float> mAutoExposureSpeed{ mIndex, "Post Processing", "auto exposure speed",
             makeMaxStrictSanitizerFloat(0.0001f) };
+        SettingValue<int> mAutoExposureInterval{ mIndex, "Post Processing", "auto exposure interval",
+            makeMaxSanitizerInt(1) };
         SettingValue<bool> mTransparentPostpass{ mIndex, "Post Processing", "transparent postpass" };
     };
 }
@@ -8,6 +8,7 @@
 #include <osg/Vec2f>
 #include <osg/Vec3f>
 
+#include <cstddef>
 #include <cstdint>
 #include <string>
 #include <string_view>
@@ -21,6 +22,9 @@ namespace Settings
         SettingValue<std::string> mCharacter{ mIndex, "Saves", "character" };
         SettingValue<bool> mAutosave{ mIndex, "Saves", "autosave" };
         SettingValue<int> mMaxQuicksaves{ mIndex, "Saves", "max quicksaves", makeMaxSanitizerInt(1) };
+        SettingValue<bool> mCompress{ mIndex, "Saves", "compress" };
+        SettingValue<std::size_t> mCompressedSectionSize{ mIndex, "Saves", "compressed section size",
+            makeMaxSanitizerSize(1) };
     };
 }
 
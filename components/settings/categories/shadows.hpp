@@ -31,6 +31,9 @@ namespace Settings
         SettingValue<std::string> mComputeSceneBounds{ mIndex, "Shadows", "compute scene bounds",
             makeEnumSanitizerString({ "primitives", "bounds", "none" }) };
         SettingValue<int> mShadowMapResolution{ mIndex, "Shadows", "shadow map resolution" };
+        SettingValue<bool> mStaticShadowCache{ mIndex, "Shadows", "static shadow cache" };
+        SettingValue<int> mStaticShadowCacheResolution{ mIndex, "Shadows", "static shadow cache resolution",
+            makeClampSanitizerInt(256, 16384) };
         SettingValue<float> mMinimumLispsmNearFarRatio{ mIndex, "Shadows", "minimum lispsm near far ratio",
             makeMaxStrictSanitizerFloat(0) };
         SettingValue<float> mPolygonOffsetFactor{ mIndex, "Shadows", "polygon offset factor" };
@@ -21,10 +21,16 @@ namespace Settings
         SettingValue<float> mVoiceVolume{ mIndex, "Sound", "voice volume", makeClampSanitizerFloat(0, 1) };
         SettingValue<int> mBufferCacheMin{ mIndex, "Sound", "buffer cache min", makeMaxSanitizerInt(1) };
         SettingValue<int> mBufferCacheMax{ mIndex, "Sound", "buffer cache max", makeMaxSanitizerInt(1) };
+        SettingValue<int> mLongBufferSize{ mIndex, "Sound", "long buffer size", makeMaxSanitizerInt(0) };
+        SettingValue<int> mLongBufferCacheMax{ mIndex, "Sound", "long buffer cache max", makeMaxSanitizerInt(1) };
+        SettingValue<int> mDecoderThreads{ mIndex, "Sound", "decoder threads", makeMaxSanitizerInt(0) };
         SettingValue<HrtfMode> mHrtfEnable{ mIndex, "Sound", "hrtf enable" };
         SettingValue<std::string> mHrtf{ mIndex, "Sound", "hrtf" };
         SettingValue<bool> mCameraListener{ mIndex, "Sound", "camera listener" };
         SettingValue<float> mDopplerFactor{ mIndex, "Sound", "doppler factor", makeClampSanitizerFloat(0, 1) };
+        SettingValue<bool> mOcclusion{ mIndex, "Sound", "occlusion" };
+        SettingValue<int> mOcclusionRaysPerUpdate{ mIndex, "Sound", "occlusion rays per update",
+            makeMaxSanitizerInt(1) };
     };
 }
 
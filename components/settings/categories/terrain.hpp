@@ -26,6 +26,10 @@ namespace Settings
             makeMaxSanitizerInt(1) };
         SettingValue<float> mMaxCompositeGeometrySize{ mIndex, "Terrain", "max composite geometry size",
             makeMaxSanitizerFloat(1) };
+        SettingValue<bool> mCompositeMapCache{ mIndex, "Terrain", "composite map cache" };
+        SettingValue<bool> mTextureArrays{ mIndex, "Terrain", "texture arrays" };
+        SettingValue<bool> mGeomorphing{ mIndex, "Terrain", "geomorphing" };
+        SettingValue<float> mViewUpdateBudget{ mIndex, "Terrain", "view update budget", makeMaxSanitizerFloat(0) };
         SettingValue<bool> mDebugChunks{ mIndex, "Terrain", "debug chunks" };
         SettingValue<bool> mObjectPaging{ mIndex, "Terrain", "object paging" };
         SettingValue<bool> mObjectPagingActiveGrid{ mIndex, "Terrain", "object paging active grid" };
@@ -37,6 +41,14 @@ namespace Settings
             makeMaxStrictSanitizerFloat(0) };
         SettingValue<float> mObjectPagingMinSizeCostMultiplier{ mIndex, "Terrain",
             "object paging min size cost multiplier", makeMaxStrictSanitizerFloat(0) };
+        SettingValue<bool> mObjectPagingInstancing{ mIndex, "Terrain", "object paging instancing" };
+        SettingValue<bool> mObjectPagingImpostors{ mIndex, "Terrain", "object paging impostors" };
+        SettingValue<float> mObjectPagingImpostorDistance{ mIndex, "Terrain", "object paging impostor distance",
+            makeMaxSanitizerFloat(0) };
+        SettingValue<float> mObjectPagingImpostorMinSize{ mIndex, "Terrain", "object paging impostor min size",
+            makeMaxSanitizerFloat(0) };
+        SettingValue<int> mObjectPagingImpostorResolution{ mIndex, "Terrain", "object paging impostor resolution",
+            makeClampSanitizerInt(16, 2048) };
         SettingValue<bool> mWaterCulling{ mIndex, "Terrain", "water culling" };
     };
 }
@@ -34,6 +34,13 @@ namespace Settings
         // Enable texture compression to save VRAM
         SettingValue<bool> mEnableTextureCompression{ mIndex, "VRAM Management", "enable texture compression" };
 
+        // Store block compressed versions of uncompressed textures on disk and load them instead
+        SettingValue<bool> mTextureCompressionCache{ mIndex, "VRAM Management", "texture compression cache" };
+
+        // Size limit of the texture compression cache in MB
+        SettingValue<int> mTextureCompressionCacheSize{ mIndex, "VRAM Management", "texture compression cache size",
+            makeMaxSanitizerInt(1) };
+
         // Enable geometry deduplication
         SettingValue<bool> mEnableGeometryDeduplication{ mIndex, "VRAM Management", "enable geometry deduplication" };
 
@@ -51,6 +58,10 @@ namespace Settings
         // Enable streaming of large textures
         SettingValue<bool> mEnableTextureStreaming{ mIndex, "VRAM Management", "enable texture streaming" };
 
+        // Largest size of the mipmap levels of streamed textures that are always resident
+        SettingValue<int> mStreamedTextureSize{ mIndex, "VRAM Management", "streamed texture size",
+            makeMaxSanitizerInt(1) };
+
         // Mipmap bias for VRAM optimization (negative = lower quality, positive = higher)
         SettingValue<float> mMipmapBias{ mIndex, "VRAM Management", "mipmap bias",
             makeClampSanitizerFloat(-4.0f, 4.0f) };
@@ -31,6 +31,8 @@ namespace Settings
         SettingValue<float> mSmallFeatureCullingPixelSize{ mIndex, "Water", "small feature culling pixel size",
             makeMaxStrictSanitizerFloat(0) };
         SettingValue<float> mRefractionScale{ mIndex, "Water", "refraction scale", makeClampSanitizerFloat(0, 1) };
+        SettingValue<float> mReflectionResolutionScale{ mIndex, "Water", "reflection resolution scale",
+            makeClampSanitizerFloat(0.25f, 1) };
         SettingValue<bool> mSunlightScattering{ mIndex, "Water", "sunlight scattering" };
         SettingValue<bool> mWobblyShores{ mIndex, "Water", "wobbly shores" };
         
@@ -0,0 +1,257 @@
+#include "asyncprogram.hpp"
+
+#include <osg/GLExtensions>
+#include <osg/State>
+
+#include <components/debug/debuglog.hpp>
+
+#include <algorithm>
+
+namespace Shader
+{
+    namespace
+    {
+        // Only set by the draw thread of the context the programs are drawn with
+        thread_local bool sSkippingAllowed = false;
+
+        constexpr std::string_view sFallbackVertexShader = R"GLSL(
+#version 120
+
+void main()
+{
+    // Outside of the clip volume, nothing is rasterized
+    gl_Position = vec4(2.0, 2.0, 2.0, 1.0);
+}
+)GLSL";
+
+        constexpr std::string_view sFallbackFragmentShader = R"GLSL(
+#version 120
+
+void main()
+{
+    discard;
+}
+)GLSL";
+
+        // Lets the driver compile on its own threads when it's able to, so a single program takes less time
+        void enableParallelShaderCompile(unsigned contextId)
+        {
+            using MaxShaderCompilerThreads = void(GL_APIENTRY*)(GLuint count);
+            const char* function = nullptr;
+            if (osg::isGLExtensionSupported(contextId, "GL_KHR_parallel_shader_compile"))
+                function = "glMaxShaderCompilerThreadsKHR";
+            else if (osg::isGLExtensionSupported(contextId, "GL_ARB_parallel_shader_compile"))
+                function = "glMaxShaderCompilerThreadsARB";
+            if (function == nullptr)
+                return;
+            const auto maxThreads = reinterpret_cast<MaxShaderCompilerThreads>(osg::getGLExtensionFuncPtr(function));
+            if (maxThreads != nullptr)
+            {
+                // The maximum value means the implementation chooses the count
+                maxThreads(0xffffffff);
+                Log(Debug::Info) << "Async program compilation uses parallel shader compile";
+            }
+        }
+    }
+
+    AsyncProgramCompiler::AsyncProgramCompiler(
+        unsigned contextId, std::function<bool()> makeCurrent, std::function<void()> release)
+        : mContextId(contextId)
+        , mFallback(new osg::Program)
+    {
+        mFallback->setName("AsyncProgramCompiler fallback");
+        mFallback->addShader(new osg::Shader(osg::Shader::VERTEX, std::string(sFallbackVertexShader)));
+        mFallback->addShader(new osg::Shader(osg::Shader::FRAGMENT, std::string(sFallbackFragmentShader)));
+        mThread = std::thread([this, makeCurrent = std::move(makeCurrent), release = std::move(release)] {
+            run(makeCurrent, release);
+        });
+    }
+
+    AsyncProgramCompiler::~AsyncProgramCompiler()
+    {
+        stop();
+    }
+
+    void AsyncProgramCompiler::stop()
+    {
+        {
+            const std::lock_guard lock(mMutex);
+            mDone = true;
+            mQueue.clear();
+        }
+        mHasWork.notify_all();
+        if (mThread.joinable())
+            mThread.join();
+        mRunning = false;
+        mCompiled.notify_all();
+    }
+
+    std::size_t AsyncProgramCompiler::getNumPending() const
+    {
+        const std::lock_guard lock(mMutex);
+        return mQueue.size() + (mCurrent != nullptr ? 1 : 0);
+    }
+
+    void AsyncProgramCompiler::request(const AsyncProgram& program)
+    {
+        {
+            const std::lock_guard lock(mMutex);
+            if (mDone)
+                return;
+            mQueue.emplace_back(&program);
+        }
+        mHasWork.notify_one();
+    }
+
+    void AsyncProgramCompiler::wait(const AsyncProgram& program)
+    {
+        std::unique_lock lock(mMutex);
+        const auto it = std::find(mQueue.begin(), mQueue.end(), &program);
+        if (it != mQueue.end() && it != mQueue.begin())
+        {
+            osg::ref_ptr<const AsyncProgram> value = std::move(*it);
+            mQueue.erase(it);
+            mQueue.push_front(std::move(value));
+        }
+        mCompiled.wait(lock, [&] {
+            return program.mStatus == AsyncProgram::Status::Compiled || (mDone && mCurrent == nullptr);
+        });
+    }
+
+    void AsyncProgramCompiler::run(std::function<bool()> makeCurrent, std::function<void()> release)
+    {
+        if (!makeCurrent())
+        {
+            Log(Debug::Warning) << "Async program compilation is disabled: failed to make the shared context current";
+            {
+                const std::lock_guard lock(mMutex);
+                mDone = true;
+                mQueue.clear();
+            }
+            mRunning = false;
+            mCompiled.notify_all();
+            release();
+            return;
+        }
+
+        osg::ref_ptr<osg::State> state = new osg::State;
+        state->setContextID(mContextId);
+        state->initializeExtensionProcs();
+        enableParallelShaderCompile(mContextId);
+
+        while (true)
+        {
+            osg::ref_ptr<const AsyncProgram> program;
+            {
+                std::unique_lock lock(mMutex);
+                mHasWork.wait(lock, [&] { return mDone || !mQueue.empty(); });
+                if (mDone)
+                    break;
+                program = std::move(mQueue.front());
+                mQueue.pop_front();
+                mCurrent = program;
+            }
+
+            {
+                const std::lock_guard lock(mCompileMutex);
+                program->osg::Program::compileGLObjects(*state);
+                // Objects changed by one context are only guaranteed to be complete in another one after this
+                glFinish();
+            }
+
+            {
+                const std::lock_guard lock(mMutex);
+                program->mStatus = AsyncProgram::Status::Compiled;
+                mCurrent = nullptr;
+            }
+            mCompiled.notify_all();
+        }
+
+        release();
+    }
+
+    AsyncProgram::AsyncProgram(const osg::Program* programTemplate, osg::ref_ptr<AsyncProgramCompiler> compiler)
+        : mCompiler(std::move(compiler))
+    {
+        if (programTemplate == nullptr)
+            return;
+        // Same as ShaderManager::cloneProgram
+        for (const auto& [name, index] : programTemplate->getAttribBindingList())
+            addBindAttribLocation(name, index);
+        for (const auto& [name, index] : programTemplate->getFragDataBindingList())
+            addBindFragDataLocation(name, index);
+        for (const auto& [name, index] : programTemplate->getUniformBlockBindingList())
+            addBindUniformBlock(name, index);
+    }
+
+    bool AsyncProgram::isPending() const
+    {
+        return mStatus != Status::Compiled && mCompiler->isRunning();
+    }
+
+    bool AsyncProgram::isCompiling() const
+    {
+        return mStatus == Status::Requested && mCompiler->isRunning();
+    }
+
+    void AsyncProgram::request() const
+    {
+        Status expected = Status::NotRequested;
+        if (mStatus.compare_exchange_strong(expected, Status::Requested))
+            mCompiler->request(*this);
+    }
+
+    void AsyncProgram::apply(osg::State& state) const
+    {
+        if (isPending())
+        {
+            request();
+            if (sSkippingAllowed)
+            {
+                mCompiler->getFallback().apply(state);
+                return;
+            }
+            mCompiler->wait(*this);
+        }
+        osg::Program::apply(state);
+    }
+
+    void AsyncProgram::compileGLObjects(osg::State& state) const
+    {
+        if (isPending())
+        {
+            request();
+            return;
+        }
+        if (!mCompiler->isRunning())
+        {
+            osg::Program::compileGLObjects(state);
+            return;
+        }
+        // Linking again for other defines or changed shaders, which may be shared with a program being compiled
+        const std::lock_guard lock(mCompiler->mCompileMutex);
+        osg::Program::compileGLObjects(state);
+    }
+
+    void AllowSkippingDrawCallback::operator()(osg::RenderInfo& /*renderInfo*/) const
+    {
+        sSkippingAllowed = mValue;
+    }
+
+    void allowSkippingDraws(osg::Camera& camera)
+    {
+        camera.addPreDrawCallback(new AllowSkippingDrawCallback(true));
+        camera.addPostDrawCallback(new AllowSkippingDrawCallback(false));
+    }
+
+    ScopedSynchronousCompilation::ScopedSynchronousCompilation()
+        : mPrevious(sSkippingAllowed)
+    {
+        sSkippingAllowed = false;
+    }
+
+    ScopedSynchronousCompilation::~ScopedSynchronousCompilation()
+    {
+        sSkippingAllowed = mPrevious;
+    }
+}
@@ -0,0 +1,142 @@
+#ifndef OPENMW_COMPONENTS_SHADER_ASYNCPROGRAM_H
+#define OPENMW_COMPONENTS_SHADER_ASYNCPROGRAM_H
+
+#include <osg/Camera>
+#include <osg/Program>
+#include <osg/Referenced>
+#include <osg/ref_ptr>
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+
+namespace Shader
+{
+    class AsyncProgram;
+
+    /// @brief Compiles and links AsyncPrograms on a thread with its own graphics context sharing objects with the
+    /// context the programs are drawn with.
+    /// @par Until a program is linked it draws nothing in the cameras skipping is allowed for, see
+    /// AllowSkippingDrawCallback, and everywhere else the draw thread waits for the program like it would link it.
+    class AsyncProgramCompiler : public osg::Referenced
+    {
+    public:
+        /// @param makeCurrent makes the shared context current on the calling thread, returns false on failure
+        /// @param release releases and destroys the shared context, called on the same thread
+        AsyncProgramCompiler(unsigned contextId, std::function<bool()> makeCurrent, std::function<void()> release);
+
+        ~AsyncProgramCompiler();
+
+        /// Stop the thread, programs that aren't linked yet are linked on the draw thread from then on.
+        void stop();
+
+        bool isRunning() const { return mRunning; }
+
+        /// @return the number of programs queued or being compiled
+        std::size_t getNumPending() const;
+
+        /// Draws nothing, used in place of programs that aren't linked yet
+        const osg::Program& getFallback() const { return *mFallback; }
+
+    private:
+        friend class AsyncProgram;
+
+        void request(const AsyncProgram& program);
+
+        /// Move the program to the front of the queue and wait till it's linked.
+        void wait(const AsyncProgram& program);
+
+        void run(std::function<bool()> makeCurrent, std::function<void()> release);
+
+        const unsigned mContextId;
+        osg::ref_ptr<osg::Program> mFallback;
+        std::atomic_bool mRunning{ true };
+        // Held while compiling, shaders are shared between programs and must not be compiled by both contexts at once
+        std::mutex mCompileMutex;
+        mutable std::mutex mMutex;
+        std::condition_variable mHasWork;
+        std::condition_variable mCompiled;
+        std::deque<osg::ref_ptr<const AsyncProgram>> mQueue;
+        osg::ref_ptr<const AsyncProgram> mCurrent;
+        bool mDone = false;
+        std::thread mThread;
+    };
+
+    /// @brief Program that is compiled and linked by an AsyncProgramCompiler the first time it's drawn.
+    class AsyncProgram : public osg::Program
+    {
+    public:
+        /// @param programTemplate the bindings are copied from, may be nullptr
+        AsyncProgram(const osg::Program* programTemplate, osg::ref_ptr<AsyncProgramCompiler> compiler);
+
+        void apply(osg::State& state) const override;
+
+        void compileGLObjects(osg::State& state) const override;
+
+        /// @return true while the program is queued or compiled by the AsyncProgramCompiler, the program must not be
+        /// used with the context of the compiler in that time
+        bool isCompiling() const;
+
+    private:
+        friend class AsyncProgramCompiler;
+
+        enum class Status
+        {
+            NotRequested,
+            Requested,
+            Compiled,
+        };
+
+        osg::ref_ptr<AsyncProgramCompiler> mCompiler;
+        mutable std::atomic<Status> mStatus{ Status::NotRequested };
+
+        /// @return true if the program has to be linked by the compiler before it can be used
+        bool isPending() const;
+
+        void request() const;
+    };
+
+    /// @brief Allows programs that aren't linked yet to draw nothing while drawing the camera, and disallows it after
+    /// the camera is drawn. Meant for cameras that are drawn every frame, where a missing object is replaced the next
+    /// frame.
+    /// @note Add as pre draw callback with true and as post draw callback with false.
+    class AllowSkippingDrawCallback : public osg::Camera::DrawCallback
+    {
+    public:
+        explicit AllowSkippingDrawCallback(bool value)
+            : mValue(value)
+        {
+        }
+
+        void operator()(osg::RenderInfo& renderInfo) const override;
+
+    private:
+        bool mValue;
+    };
+
+    /// Add AllowSkippingDrawCallbacks to the camera, has no effect without an AsyncProgramCompiler.
+    void allowSkippingDraws(osg::Camera& camera);
+
+    /// @brief Disallows programs that aren't linked yet to draw nothing in its scope, for drawing something that is
+    /// kept after it's drawn once.
+    class ScopedSynchronousCompilation
+    {
+    public:
+        ScopedSynchronousCompilation();
+
+        ~ScopedSynchronousCompilation();
+
+        ScopedSynchronousCompilation(const ScopedSynchronousCompilation&) = delete;
+
+        ScopedSynchronousCompilation& operator=(const ScopedSynchronousCompilation&) = delete;
+
+    private:
+        bool mPrevious;
+    };
+}
+
+#endif
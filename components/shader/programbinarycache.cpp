@@ -0,0 +1,302 @@
+#include "programbinarycache.hpp"
+
+#include "asyncprogram.hpp"
+
+#include <osg/State>
+
+#include <components/debug/debuglog.hpp>
+#include <components/files/hash.hpp>
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <format>
+#include <fstream>
+#include <optional>
+#include <sstream>
+
+namespace Shader
+{
+    namespace
+    {
+        // Increment when the way programs are keyed or stored changes
+        constexpr int programBinaryCacheVersion = 1;
+
+        // Spread the work over frames to not replace the hitches with a single longer one
+        constexpr std::size_t sWarmUpPerFrame = 4;
+        constexpr std::size_t sStorePerFrame = 8;
+
+        constexpr std::string_view sPermutationsFile = "permutations.txt";
+
+        template <class T>
+        void writeBindings(std::ostream& stream, std::string_view type, const T& bindings)
+        {
+            for (const auto& [name, index] : bindings)
+                stream << type << ' ' << name << ' ' << index << '\n';
+        }
+
+        std::set<ProgramBinaryCache::Permutation> readPermutations(std::istream& stream)
+        {
+            std::set<ProgramBinaryCache::Permutation> result;
+            std::optional<ProgramBinaryCache::Permutation> permutation;
+            std::string line;
+            while (std::getline(stream, line))
+            {
+                std::istringstream lineStream(line);
+                std::string type;
+                std::string name;
+                lineStream >> type >> name;
+                if (type == "program")
+                    permutation = ProgramBinaryCache::Permutation{ name, {}, {}, {} };
+                else if (!permutation.has_value())
+                    continue;
+                else if (type == "define")
+                {
+                    std::string value;
+                    std::getline(lineStream >> std::ws, value);
+                    permutation->mDefines[name] = std::move(value);
+                }
+                else if (type == "attrib" || type == "block")
+                {
+                    GLuint index = 0;
+                    lineStream >> index;
+                    if (type == "attrib")
+                        permutation->mAttribBindings[name] = index;
+                    else
+                        permutation->mUniformBlockBindings[name] = index;
+                }
+                else if (type == "end")
+                {
+                    result.insert(std::move(*permutation));
+                    permutation.reset();
+                }
+            }
+            return result;
+        }
+    }
+
+    ProgramBinaryCache::ProgramBinaryCache(const std::filesystem::path& path, std::string_view driver)
+        : mPath(path)
+        , mDriver(driver)
+    {
+        std::error_code ec;
+        std::filesystem::create_directories(mPath, ec);
+        if (ec)
+        {
+            Log(Debug::Warning) << "Program binary cache is disabled: failed to create " << mPath << ": "
+                                << ec.message();
+            mEnabled = false;
+            return;
+        }
+
+        std::ifstream stream(mPath / sPermutationsFile);
+        if (stream.is_open())
+            mPreviousPermutations = readPermutations(stream);
+    }
+
+    std::string ProgramBinaryCache::makeKey(const osg::Program& program) const
+    {
+        std::ostringstream source;
+        source << programBinaryCacheVersion << '\n' << mDriver << '\n';
+        for (unsigned i = 0; i < program.getNumShaders(); ++i)
+        {
+            const osg::Shader& shader = *program.getShader(i);
+            source << "shader " << shader.getType() << ' ' << shader.getShaderSource().size() << '\n'
+                   << shader.getShaderSource() << '\n';
+        }
+        writeBindings(source, "attrib", program.getAttribBindingList());
+        writeBindings(source, "fragdata", program.getFragDataBindingList());
+        writeBindings(source, "block", program.getUniformBlockBindingList());
+
+        std::istringstream stream(std::move(source).str());
+        const std::array<std::uint64_t, 2> hash = Files::getHash("program binary", stream);
+        return std::format("{:016x}{:016x}", hash[0], hash[1]);
+    }
+
+    osg::ref_ptr<osg::ProgramBinary> ProgramBinaryCache::read(std::string_view key) const
+    {
+        if (!mEnabled)
+            return nullptr;
+
+        const std::filesystem::path path = mPath / std::format("{}.bin", key);
+        std::ifstream stream(path, std::ios::binary | std::ios::ate);
+        if (!stream.is_open())
+            return nullptr;
+
+        const std::streamoff size = static_cast<std::streamoff>(stream.tellg()) - sizeof(std::uint32_t);
+        std::uint32_t format = 0;
+        stream.seekg(0);
+        if (size <= 0 || !stream.read(reinterpret_cast<char*>(&format), sizeof(format)))
+        {
+            Log(Debug::Warning) << "Failed to read cached program binary " << path;
+            return nullptr;
+        }
+
+        osg::ref_ptr<osg::ProgramBinary> binary = new osg::ProgramBinary;
+        binary->setFormat(static_cast<GLenum>(format));
+        binary->allocate(static_cast<unsigned>(size));
+        if (!stream.read(reinterpret_cast<char*>(binary->getData()), size))
+        {
+            Log(Debug::Warning) << "Failed to read cached program binary " << path;
+            return nullptr;
+        }
+
+        return binary;
+    }
+
+    void ProgramBinaryCache::write(std::string_view key, const osg::ProgramBinary& binary) const
+    {
+        if (!mEnabled)
+            return;
+
+        const std::filesystem::path path = mPath / std::format("{}.bin", key);
+        // Write to a temporary file first to never read a partially written binary
+        std::filesystem::path tmpPath = path;
+        tmpPath += ".tmp";
+
+        {
+            std::ofstream stream(tmpPath, std::ios::binary);
+            if (!stream.is_open())
+            {
+                Log(Debug::Warning) << "Failed to open " << tmpPath << " to cache program binary";
+                return;
+            }
+
+            const std::uint32_t format = binary.getFormat();
+            stream.write(reinterpret_cast<const char*>(&format), sizeof(format));
+            stream.write(reinterpret_cast<const char*>(binary.getData()), binary.getSize());
+            if (!stream)
+            {
+                Log(Debug::Warning) << "Failed to write cached program binary " << tmpPath;
+                return;
+            }
+        }
+
+        std::error_code ec;
+        std::filesystem::rename(tmpPath, path, ec);
+        if (ec)
+            Log(Debug::Warning) << "Failed to rename " << tmpPath << " to " << path << ": " << ec.message();
+    }
+
+    void ProgramBinaryCache::load(osg::Program& program)
+    {
+        if (!mEnabled)
+            return;
+
+        // Programs are linked from source when there is no binary or the driver rejects it, store them in that case
+        program.setProgramBinary(read(makeKey(program)));
+
+        std::lock_guard<std::mutex> lock(mMutex);
+        if (std::find(mPending.begin(), mPending.end(), &program) == mPending.end())
+            mPending.emplace_back(&program);
+    }
+
+    void ProgramBinaryCache::addPermutation(const std::string& templateName,
+        const std::map<std::string, std::string>& defines, const osg::Program* programTemplate)
+    {
+        Permutation permutation{ templateName, defines, {}, {} };
+        if (programTemplate != nullptr)
+        {
+            permutation.mAttribBindings = programTemplate->getAttribBindingList();
+            permutation.mUniformBlockBindings = programTemplate->getUniformBlockBindingList();
+        }
+
+        std::lock_guard<std::mutex> lock(mMutex);
+        mPermutations.insert(std::move(permutation));
+    }
+
+    void ProgramBinaryCache::writePermutations() const
+    {
+        if (!mEnabled)
+            return;
+
+        std::ostringstream stream;
+        {
+            std::lock_guard<std::mutex> lock(mMutex);
+            for (const Permutation& permutation : mPermutations)
+            {
+                stream << "program " << permutation.mTemplateName << '\n';
+                for (const auto& [name, value] : permutation.mDefines)
+                    stream << "define " << name << ' ' << value << '\n';
+                writeBindings(stream, "attrib", permutation.mAttribBindings);
+                writeBindings(stream, "block", permutation.mUniformBlockBindings);
+                stream << "end\n";
+            }
+        }
+
+        const std::filesystem::path path = mPath / sPermutationsFile;
+        std::ofstream file(path);
+        if (!file.is_open() || !(file << stream.str()))
+            Log(Debug::Warning) << "Failed to write program permutations to " << path;
+    }
+
+    void ProgramBinaryCache::warmUp(std::vector<osg::ref_ptr<osg::Program>> programs)
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        // Taken from the back, keep the order programs were requested in
+        mWarmUp.insert(mWarmUp.begin(), programs.rbegin(), programs.rend());
+    }
+
+    void ProgramBinaryCache::update(osg::State& state)
+    {
+        std::vector<osg::ref_ptr<osg::Program>> warmUp;
+        std::vector<osg::ref_ptr<osg::Program>> pending;
+        {
+            std::lock_guard<std::mutex> lock(mMutex);
+            const std::size_t count = std::min(mWarmUp.size(), sWarmUpPerFrame);
+            warmUp.assign(mWarmUp.end() - static_cast<std::ptrdiff_t>(count), mWarmUp.end());
+            mWarmUp.resize(mWarmUp.size() - count);
+            pending.swap(mPending);
+        }
+
+        for (const osg::ref_ptr<osg::Program>& program : warmUp)
+            program->compileGLObjects(state);
+
+        std::size_t stored = 0;
+        std::vector<osg::ref_ptr<osg::Program>> remaining;
+        for (osg::ref_ptr<osg::Program>& program : pending)
+        {
+            // The per context program is created by the thread compiling it
+            if (const auto* async = dynamic_cast<const AsyncProgram*>(program.get()); async && async->isCompiling())
+            {
+                remaining.push_back(std::move(program));
+                continue;
+            }
+
+            osg::Program::PerContextProgram* pcp = program->getPCP(state);
+            if (pcp == nullptr || pcp->needsLink() || stored >= sStorePerFrame)
+            {
+                remaining.push_back(std::move(program));
+                continue;
+            }
+
+            // Nothing to store for programs that failed to link or were loaded from the cache
+            if (!pcp->isLinked() || pcp->loadedBinary())
+                continue;
+
+            osg::ref_ptr<osg::ProgramBinary> binary = pcp->compileProgramBinary(state);
+            if (binary != nullptr && binary->getSize() > 0)
+                write(makeKey(*program), *binary);
+            ++stored;
+        }
+
+        if (remaining.empty())
+            return;
+
+        std::lock_guard<std::mutex> lock(mMutex);
+        for (osg::ref_ptr<osg::Program>& program : remaining)
+            if (std::find(mPending.begin(), mPending.end(), program) == mPending.end())
+                mPending.push_back(std::move(program));
+    }
+
+    ProgramBinaryCacheOperation::ProgramBinaryCacheOperation(ProgramBinaryCache& cache)
+        : osg::GraphicsOperation("ProgramBinaryCacheOperation", true)
+        , mCache(&cache)
+    {
+    }
+
+    void ProgramBinaryCacheOperation::operator()(osg::GraphicsContext* graphicsContext)
+    {
+        mCache->update(*graphicsContext->getState());
+    }
+}
@@ -0,0 +1,96 @@
+#ifndef OPENMW_COMPONENTS_SHADER_PROGRAMBINARYCACHE_H
+#define OPENMW_COMPONENTS_SHADER_PROGRAMBINARYCACHE_H
+
+#include <osg/GraphicsThread>
+#include <osg/Program>
+#include <osg/Referenced>
+#include <osg/ref_ptr>
+
+#include <compare>
+#include <filesystem>
+#include <map>
+#include <mutex>
+#include <set>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace Shader
+{
+    /// @brief Stores linked programs on disk to load them in the next session instead of compiling them again.
+    /// @par Binaries are keyed by a hash of the sources of all shaders of the program, its bindings and the driver
+    /// that produced the binary, so changed shaders or a driver update result in a different key instead of loading a
+    /// binary the driver would reject.
+    /// @par The permutations programs are requested with are recorded, so the next session can link them ahead of
+    /// their first use.
+    /// @note Thread safe.
+    class ProgramBinaryCache : public osg::Referenced
+    {
+    public:
+        struct Permutation
+        {
+            std::string mTemplateName;
+            std::map<std::string, std::string> mDefines;
+            osg::Program::AttribBindingList mAttribBindings;
+            osg::Program::UniformBlockBindingList mUniformBlockBindings;
+
+            friend auto operator<=>(const Permutation&, const Permutation&) = default;
+        };
+
+        /// @param driver identifies the driver and GPU binaries are produced by
+        ProgramBinaryCache(const std::filesystem::path& path, std::string_view driver);
+
+        std::string makeKey(const osg::Program& program) const;
+
+        /// @return nullptr when there is no binary for the key
+        osg::ref_ptr<osg::ProgramBinary> read(std::string_view key) const;
+
+        void write(std::string_view key, const osg::ProgramBinary& binary) const;
+
+        /// Set the stored binary of the program, or store one once the program is linked if there is none.
+        /// @note Has to be called again when the shaders of the program change.
+        void load(osg::Program& program);
+
+        void addPermutation(const std::string& templateName, const std::map<std::string, std::string>& defines,
+            const osg::Program* programTemplate);
+
+        /// @return the permutations recorded by the previous session
+        const std::set<Permutation>& getPreviousPermutations() const { return mPreviousPermutations; }
+
+        /// Write the permutations recorded by this session, to be read by the next one.
+        void writePermutations() const;
+
+        /// Link the programs a few per frame, so they don't have to be linked when first drawn.
+        void warmUp(std::vector<osg::ref_ptr<osg::Program>> programs);
+
+        /// Link the programs queued by warmUp and store the binaries of programs linked from source.
+        /// @note Has to be called from the draw thread.
+        void update(osg::State& state);
+
+    private:
+        std::filesystem::path mPath;
+        std::string mDriver;
+        bool mEnabled = true;
+
+        std::set<Permutation> mPreviousPermutations;
+
+        mutable std::mutex mMutex;
+        std::set<Permutation> mPermutations;
+        std::vector<osg::ref_ptr<osg::Program>> mPending;
+        std::vector<osg::ref_ptr<osg::Program>> mWarmUp;
+    };
+
+    /// @brief Calls ProgramBinaryCache::update on the graphics context it's added to.
+    class ProgramBinaryCacheOperation : public osg::GraphicsOperation
+    {
+    public:
+        explicit ProgramBinaryCacheOperation(ProgramBinaryCache& cache);
+
+        void operator()(osg::GraphicsContext* graphicsContext) override;
+
+    private:
+        osg::ref_ptr<ProgramBinaryCache> mCache;
+    };
+}
+
+#endif
@@ -21,6 +21,9 @@
 #include <components/misc/strings/conversion.hpp>
 #include <components/settings/settings.hpp>
 
+#include "asyncprogram.hpp"
+#include "programbinarycache.hpp"
+
 namespace
 {
     osg::Shader::Type getShaderType(const std::string& templateName)
@@ -83,13 +86,55 @@ namespace Shader
         mHotReloadManager = std::make_unique<HotReloadManager>();
     }
 
-    ShaderManager::~ShaderManager() = default;
+    ShaderManager::~ShaderManager()
+    {
+        if (mProgramBinaryCache != nullptr)
+            mProgramBinaryCache->writePermutations();
+    }
 
     void ShaderManager::setShaderPath(const std::filesystem::path& path)
     {
         mPath = path;
     }
 
+    void ShaderManager::enableProgramBinaryCache(const std::filesystem::path& path, std::string_view driver)
+    {
+        mProgramBinaryCache = new ProgramBinaryCache(path, driver);
+    }
+
+    void ShaderManager::setAsyncProgramCompiler(osg::ref_ptr<AsyncProgramCompiler> compiler)
+    {
+        mAsyncProgramCompiler = std::move(compiler);
+    }
+
+    void ShaderManager::warmUpPrograms()
+    {
+        if (mProgramBinaryCache == nullptr)
+            return;
+
+        std::vector<osg::ref_ptr<osg::Program>> programs;
+        for (const ProgramBinaryCache::Permutation& permutation : mProgramBinaryCache->getPreviousPermutations())
+        {
+            osg::ref_ptr<osg::Program> programTemplate = new osg::Program;
+            for (const auto& [name, index] : permutation.mAttribBindings)
+                programTemplate->addBindAttribLocation(name, index);
+            for (const auto& [name, index] : permutation.mUniformBlockBindings)
+                programTemplate->addBindUniformBlock(name, index);
+
+            try
+            {
+                programs.push_back(getProgram(permutation.mTemplateName, permutation.mDefines, programTemplate));
+            }
+            catch (const std::exception& e)
+            {
+                Log(Debug::Warning) << "Failed to warm up program: " << e.what();
+            }
+        }
+
+        Log(Debug::Info) << "Warming up " << programs.size() << " programs";
+        mProgramBinaryCache->warmUp(std::move(programs));
+    }
+
     bool addLineDirectivesAfterConditionalBlocks(std::string& source)
     {
         for (size_t position = 0; position < source.length();)
@@ -437,6 +482,7 @@ namespace Shader
         void reloadTouchedShaders(ShaderManager& manager, osgViewer::Viewer& viewer)
         {
             bool threadsRunningToStop = false;
+            bool reloaded = false;
             for (auto& [pathShaderToTest, shaderKeys] : mShaderFiles)
             {
                 const std::filesystem::file_time_type writeTime = std::filesystem::last_write_time(pathShaderToTest);
@@ -492,9 +538,12 @@ namespace Shader
                             break;
                         }
                         shaderIt->second->setShaderSource(shaderSource);
+                        reloaded = true;
                     }
                 }
             }
+            if (reloaded)
+                manager.reloadProgramBinaries();
             if (threadsRunningToStop)
                 viewer.startThreading();
             mLastAutoRecompileTime = std::filesystem::file_time_type::clock::now();
@@ -577,6 +626,10 @@ namespace Shader
         if (!vert || !frag)
             throw std::runtime_error("failed initializing shader: " + templateName);
 
+        if (mProgramBinaryCache != nullptr)
+            mProgramBinaryCache->addPermutation(
+                templateName, defines, programTemplate ? programTemplate : mProgramTemplate.get());
+
         return getProgram(std::move(vert), std::move(frag), programTemplate);
     }
 
@@ -589,12 +642,19 @@ namespace Shader
         {
             if (!programTemplate)
                 programTemplate = mProgramTemplate;
-            osg::ref_ptr<osg::Program> program
-                = programTemplate ? cloneProgram(programTemplate) : osg::ref_ptr<osg::Program>(new osg::Program);
+            osg::ref_ptr<osg::Program> program;
+            if (mAsyncProgramCompiler != nullptr)
+                program = new AsyncProgram(programTemplate, mAsyncProgramCompiler);
+            else if (programTemplate)
+                program = cloneProgram(programTemplate);
+            else
+                program = new osg::Program;
             program->addShader(vertexShader);
             program->addShader(fragmentShader);
             addLinkedShaders(vertexShader, program);
             addLinkedShaders(fragmentShader, program);
+            if (mProgramBinaryCache != nullptr)
+                mProgramBinaryCache->load(*program);
 
             found = mPrograms.insert(std::make_pair(std::make_pair(vertexShader, fragmentShader), program)).first;
         }
@@ -636,6 +696,7 @@ namespace Shader
 
             getLinkedShaders(shader, linkedShaderNames, defines);
         }
+        reloadProgramBinaries();
     }
 
     void ShaderManager::releaseGLObjects(osg::State* state)
@@ -684,6 +745,16 @@ namespace Shader
                 program->addShader(linkedShader);
     }
 
+    void ShaderManager::reloadProgramBinaries()
+    {
+        if (mProgramBinaryCache == nullptr)
+            return;
+
+        std::lock_guard<std::mutex> lock(mMutex);
+        for (const auto& [_, program] : mPrograms)
+            mProgramBinaryCache->load(*program);
+    }
+
     int ShaderManager::reserveGlobalTextureUnits(Slot slot, int count)
     {
         // TODO: Reuse units when count increase forces reallocation
@@ -713,6 +784,15 @@ namespace Shader
             case Slot::ShadowMaps:
                 slotDescr = "shadow maps";
                 break;
+            case Slot::LightClusters:
+                slotDescr = "light clusters";
+                break;
+            case Slot::GrassInteraction:
+                slotDescr = "grass interaction";
+                break;
+            case Slot::MorphTargets:
+                slotDescr = "morph targets";
+                break;
             default:
                 slotDescr = "UNKNOWN";
         }
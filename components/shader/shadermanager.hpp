@@ -8,6 +8,7 @@
 #include <mutex>
 #include <optional>
 #include <string>
+#include <string_view>
 #include <vector>
 
 #include <osg/Program>
@@ -22,6 +23,9 @@ namespace osgViewer
 namespace Shader
 {
     struct HotReloadManager;
+    class AsyncProgramCompiler;
+    class ProgramBinaryCache;
+
     /// @brief Reads shader template files and turns them into a concrete shader, based on a list of define's.
     /// @par Shader templates can get the value of a define with the syntax @define.
     class ShaderManager
@@ -33,6 +37,25 @@ namespace Shader
 
         void setShaderPath(const std::filesystem::path& path);
 
+        /// Load programs from and store them to a ProgramBinaryCache at the given path.
+        /// @param driver identifies the driver and GPU programs are linked by
+        /// @note Not thread safe, has to be called before any program is created.
+        void enableProgramBinaryCache(const std::filesystem::path& path, std::string_view driver);
+
+        /// @return nullptr if the program binary cache is not enabled
+        ProgramBinaryCache* getProgramBinaryCache() const { return mProgramBinaryCache; }
+
+        /// Compile and link the programs created from then on with the AsyncProgramCompiler.
+        /// @note Not thread safe, has to be called before any program is created.
+        void setAsyncProgramCompiler(osg::ref_ptr<AsyncProgramCompiler> compiler);
+
+        /// @return nullptr if async program compilation is not enabled
+        AsyncProgramCompiler* getAsyncProgramCompiler() const { return mAsyncProgramCompiler; }
+
+        /// Create the programs requested in the previous session and link them ahead of their first use.
+        /// @note Has to be called after the global defines and the program template are set up.
+        void warmUpPrograms();
+
         typedef std::map<std::string, std::string> DefineMap;
 
         /// Create or retrieve a shader instance.
@@ -80,6 +103,9 @@ namespace Shader
             OpaqueDepthTexture,
             SkyTexture,
             ShadowMaps,
+            LightClusters,
+            GrassInteraction,
+            MorphTargets,
             SLOT_COUNT
         };
 
@@ -94,6 +120,9 @@ namespace Shader
             const DefineMap& defines);
         void addLinkedShaders(osg::ref_ptr<osg::Shader> shader, osg::ref_ptr<osg::Program> program);
 
+        /// Look up the binaries of all programs again after their shaders changed.
+        void reloadProgramBinaries();
+
         std::filesystem::path mPath;
 
         DefineMap mGlobalDefines;
@@ -121,6 +150,8 @@ namespace Shader
         int mMaxTextureUnits = 0;
         int mReservedTextureUnits = 0;
         std::unique_ptr<HotReloadManager> mHotReloadManager;
+        osg::ref_ptr<ProgramBinaryCache> mProgramBinaryCache;
+        osg::ref_ptr<AsyncProgramCompiler> mAsyncProgramCompiler;
         struct ReservedTextureUnits
         {
             int index = -1;
@@ -189,6 +189,9 @@ namespace Shader
         , mReconstructNormalZ(false)
         , mTexStageRequiringTangents(-1)
         , mSoftParticles(false)
+        , mSkinning(false)
+        , mMorphing(false)
+        , mInstancing(false)
         , mNode(nullptr)
     {
     }
@@ -413,7 +416,7 @@ namespace Shader
                 const VFS::Path::Normalized normalHeightMapPath(normalHeightMap);
                 if (mImageManager.getVFS()->exists(normalHeightMapPath))
                 {
-                    image = mImageManager.getImage(normalHeightMapPath);
+                    image = mImageManager.getStreamedImage(normalHeightMapPath);
                     normalHeight = true;
                 }
                 else
@@ -422,7 +425,7 @@ namespace Shader
                     const VFS::Path::Normalized normalMapPath(normalMapFileName);
                     if (mImageManager.getVFS()->exists(normalMapPath))
                     {
-                        image = mImageManager.getImage(normalMapPath);
+                        image = mImageManager.getStreamedImage(normalMapPath);
                     }
                 }
                 // Avoid using the auto-detected normal map if it's already being used as a bump map.
@@ -476,7 +479,7 @@ namespace Shader
                 const VFS::Path::Normalized specularMapPath(specularMapFileName);
                 if (mImageManager.getVFS()->exists(specularMapPath))
                 {
-                    osg::ref_ptr<osg::Image> image(mImageManager.getImage(specularMapPath));
+                    osg::ref_ptr<osg::Image> image(mImageManager.getStreamedImage(specularMapPath));
                     osg::ref_ptr<osg::Texture2D> specularMapTex(new osg::Texture2D(image));
                     specularMapTex->setTextureSize(image->s(), image->t());
                     specularMapTex->setWrap(osg::Texture::WRAP_S, diffuseMap->getWrap(osg::Texture::WRAP_S));
@@ -597,6 +600,7 @@ namespace Shader
         else
             mRequirements.push_back(mRequirements.back());
         mRequirements.back().mNode = &node;
+        node.getUserValue(Misc::OsgUserValues::sInstancing, mRequirements.back().mInstancing);
     }
 
     void ShaderVisitor::popRequirements()
@@ -763,6 +767,9 @@ namespace Shader
         }
 
         defineMap["softParticles"] = reqs.mSoftParticles ? "1" : "0";
+        defineMap["skinning"] = reqs.mSkinning ? "1" : "0";
+        defineMap["morphing"] = reqs.mMorphing ? "1" : "0";
+        defineMap["instancing"] = reqs.mInstancing ? "1" : "0";
 
         Stereo::shaderStereoDefines(defineMap);
 
@@ -770,7 +777,8 @@ namespace Shader
         if (!node.getUserValue("shaderPrefix", shaderPrefix))
             shaderPrefix = mDefaultShaderPrefix;
 
-        auto program = mShaderManager.getProgram(shaderPrefix, defineMap, mProgramTemplate);
+        auto program = mShaderManager.getProgram(shaderPrefix, defineMap,
+            reqs.mSkinning || reqs.mMorphing ? getVertexAnimationProgramTemplate() : mProgramTemplate.get());
         writableStateSet->setAttributeAndModes(program, osg::StateAttribute::ON);
         addedState->setAttributeAndModes(std::move(program));
 
@@ -968,6 +976,16 @@ namespace Shader
         if (!needPop && dynamic_cast<osgParticle::ParticleSystem*>(&drawable))
             needPop = true;
 
+        // Same for skinned geometry when it's skinned by the shader.
+        auto rig = dynamic_cast<SceneUtil::RigGeometry*>(&drawable);
+        if (!needPop && rig && mGpuSkinning)
+            needPop = true;
+
+        // And morphed geometry when it's morphed by the shader.
+        auto morph = dynamic_cast<SceneUtil::MorphGeometry*>(&drawable);
+        if (!needPop && morph && mGpuMorphing)
+            needPop = true;
+
         if (needPop)
         {
             pushRequirements(drawable);
@@ -976,16 +994,41 @@ namespace Shader
                 applyStateSet(drawable.getStateSet(), drawable);
         }
 
+        if (rig)
+        {
+            ShaderRequirements& rigReqs = mRequirements.back();
+            std::string shaderPrefix;
+            if (!rig->getUserValue("shaderPrefix", shaderPrefix))
+                shaderPrefix = mDefaultShaderPrefix;
+            // only the objects shaders implement skinning
+            const bool useShader = rigReqs.mShaderRequired || mForceShaders;
+            rigReqs.mSkinning = rig->setGpuSkinning(mGpuSkinning && useShader && shaderPrefix == "objects");
+        }
+        else if (morph)
+        {
+            ShaderRequirements& morphReqs = mRequirements.back();
+            std::string shaderPrefix;
+            if (!morph->getUserValue("shaderPrefix", shaderPrefix))
+                shaderPrefix = mDefaultShaderPrefix;
+            // only the objects shaders implement morphing
+            const bool useShader = morphReqs.mShaderRequired || mForceShaders;
+            const bool gpuMorphing = mGpuMorphing && useShader && shaderPrefix == "objects";
+            const int unit = gpuMorphing
+                ? mShaderManager.reserveGlobalTextureUnits(Shader::ShaderManager::Slot::MorphTargets)
+                : -1;
+            morphReqs.mMorphing = morph->setGpuMorphing(gpuMorphing, unit);
+        }
+
         const ShaderRequirements& reqs = mRequirements.back();
         createProgram(reqs);
 
-        if (auto rig = dynamic_cast<SceneUtil::RigGeometry*>(&drawable))
+        if (rig)
         {
             osg::ref_ptr<osg::Geometry> sourceGeometry = rig->getSourceGeometry();
             if (sourceGeometry && adjustGeometry(*sourceGeometry, reqs))
                 rig->setSourceGeometry(std::move(sourceGeometry));
         }
-        else if (auto morph = dynamic_cast<SceneUtil::MorphGeometry*>(&drawable))
+        else if (morph)
         {
             osg::ref_ptr<osg::Geometry> sourceGeometry = morph->getSourceGeometry();
             if (sourceGeometry && adjustGeometry(*sourceGeometry, reqs))
@@ -1006,6 +1049,20 @@ namespace Shader
             popRequirements();
     }
 
+    const osg::Program* ShaderVisitor::getVertexAnimationProgramTemplate()
+    {
+        if (mVertexAnimationProgramTemplate == nullptr)
+        {
+            const osg::Program* base
+                = mProgramTemplate != nullptr ? mProgramTemplate.get() : mShaderManager.getProgramTemplate();
+            mVertexAnimationProgramTemplate
+                = base != nullptr ? ShaderManager::cloneProgram(base) : osg::ref_ptr<osg::Program>(new osg::Program);
+            SceneUtil::RigGeometry::addBindSkinningAttribLocations(*mVertexAnimationProgramTemplate);
+            SceneUtil::MorphGeometry::addBindMorphingAttribLocations(*mVertexAnimationProgramTemplate);
+        }
+        return mVertexAnimationProgramTemplate;
+    }
+
     void ShaderVisitor::setAllowedToModifyStateSets(bool allowed)
     {
         mAllowedToModifyStateSets = allowed;
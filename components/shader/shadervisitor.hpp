@@ -21,7 +21,11 @@ namespace Shader
         ShaderVisitor(
             ShaderManager& shaderManager, Resource::ImageManager& imageManager, const std::string& defaultShaderPrefix);
 
-        void setProgramTemplate(const osg::Program* programTemplate) { mProgramTemplate = programTemplate; }
+        void setProgramTemplate(const osg::Program* programTemplate)
+        {
+            mProgramTemplate = programTemplate;
+            mVertexAnimationProgramTemplate = nullptr;
+        }
 
         /// By default, only bump mapped objects will have a shader added to them.
         /// Setting force = true will cause all objects to render using shaders, regardless of having a bump map.
@@ -53,6 +57,13 @@ namespace Shader
 
         void setWeatherParticleOcclusion(bool value) { mWeatherParticleOcclusion = value; }
 
+        /// Skin RigGeometry in the vertex shader when it has one and the mesh fits the GPU skinning limits.
+        void setGpuSkinning(bool value) { mGpuSkinning = value; }
+
+        /// Blend the morph targets of MorphGeometry in the vertex shader when it has one and the mesh fits the GPU
+        /// morphing limits.
+        void setGpuMorphing(bool value) { mGpuMorphing = value; }
+
         void apply(osg::Node& node) override;
 
         void apply(osg::Drawable& drawable) override;
@@ -81,6 +92,8 @@ namespace Shader
 
         bool mSupportsNormalsRT;
         bool mWeatherParticleOcclusion = false;
+        bool mGpuSkinning = false;
+        bool mGpuMorphing = false;
 
         ShaderManager& mShaderManager;
         Resource::ImageManager& mImageManager;
@@ -117,6 +130,11 @@ namespace Shader
 
             bool mSoftParticles;
 
+            bool mSkinning;
+            bool mMorphing;
+            // set by the Misc::OsgUserValues::sInstancing user value
+            bool mInstancing;
+
             // the Node that requested these requirements
             osg::Node* mNode;
         };
@@ -127,8 +145,11 @@ namespace Shader
         void createProgram(const ShaderRequirements& reqs);
         void ensureFFP(osg::Node& node);
         bool adjustGeometry(osg::Geometry& sourceGeometry, const ShaderRequirements& reqs);
+        // binds the vertex attributes of GPU skinning and morphing, only one of them is used by a program
+        const osg::Program* getVertexAnimationProgramTemplate();
 
         osg::ref_ptr<const osg::Program> mProgramTemplate;
+        osg::ref_ptr<osg::Program> mVertexAnimationProgramTemplate;
     };
 
     class ReinstateRemovedStateVisitor : public osg::NodeVisitor
@@ -0,0 +1,43 @@
+#include "checkpointer.hpp"
+
+#include <components/debug/debuglog.hpp>
+
+#include <sqlite3.h>
+
+namespace Sqlite3
+{
+    Checkpointer::Checkpointer(std::string_view path, std::chrono::steady_clock::duration interval)
+        : mDb(makeDb(path, ""))
+        , mInterval(interval)
+        , mThread([this] { run(); })
+    {
+    }
+
+    Checkpointer::~Checkpointer()
+    {
+        {
+            const std::lock_guard lock(mMutex);
+            mShouldStop = true;
+        }
+        mStop.notify_all();
+        mThread.join();
+    }
+
+    void Checkpointer::run() noexcept
+    {
+        std::unique_lock lock(mMutex);
+        while (!mStop.wait_for(lock, mInterval, [&] { return mShouldStop; }))
+        {
+            int logFrames = 0;
+            int checkpointedFrames = 0;
+            const int ec = sqlite3_wal_checkpoint_v2(
+                mDb.get(), nullptr, SQLITE_CHECKPOINT_PASSIVE, &logFrames, &checkpointedFrames);
+            if (ec != SQLITE_OK && ec != SQLITE_BUSY)
+                Log(Debug::Warning) << "Failed to checkpoint SQLite3 write-ahead log: " << sqlite3_errmsg(mDb.get())
+                                    << " (" << ec << ")";
+            else
+                Log(Debug::Debug) << "Checkpointed " << checkpointedFrames << " of " << logFrames
+                                  << " SQLite3 write-ahead log frames";
+        }
+    }
+}
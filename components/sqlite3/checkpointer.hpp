@@ -0,0 +1,40 @@
+#ifndef OPENMW_COMPONENTS_SQLITE3_CHECKPOINTER_H
+#define OPENMW_COMPONENTS_SQLITE3_CHECKPOINTER_H
+
+#include "db.hpp"
+
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <string_view>
+#include <thread>
+
+namespace Sqlite3
+{
+    /// @brief Moves pages from the write-ahead log into the database file from a separate thread and connection, so
+    /// the writing connection doesn't stall on commits to checkpoint the log by itself.
+    /// @par Checkpoints are passive, they never wait for readers or writers of the database.
+    class Checkpointer
+    {
+    public:
+        /// @param path has to be a database in WAL journal mode
+        explicit Checkpointer(std::string_view path, std::chrono::steady_clock::duration interval);
+
+        ~Checkpointer();
+
+        Checkpointer(const Checkpointer&) = delete;
+        Checkpointer& operator=(const Checkpointer&) = delete;
+
+    private:
+        const Db mDb;
+        const std::chrono::steady_clock::duration mInterval;
+        std::mutex mMutex;
+        std::condition_variable mStop;
+        bool mShouldStop = false;
+        std::thread mThread;
+
+        void run() noexcept;
+    };
+}
+
+#endif
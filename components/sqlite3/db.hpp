@@ -15,6 +15,14 @@ namespace Sqlite3
 
     using Db = std::unique_ptr<sqlite3, CloseSqlite3>;
 
+    // Values of the synchronous pragma
+    enum class Synchronous
+    {
+        Off = 0,
+        Normal = 1,
+        Full = 2,
+    };
+
     Db makeDb(std::string_view path, const char* schema);
 }
 
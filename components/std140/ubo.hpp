@@ -113,7 +113,8 @@ namespace Std140
         {
             std::size_t size = 0;
             ((size += (sizeof(typename CArgs::Value) + roundUpRemainder(size, CArgs::sAlign))), ...);
-            return size;
+            // Blocks are padded to a multiple of vec4 like structures, a smaller buffer range is not enough
+            return size + roundUpRemainder(size, sizeof(osg::Vec4f));
         }
 
         static std::string getDefinition(const std::string& name)
@@ -121,6 +121,19 @@ namespace Stereo
             mShadowTechnique->setCustomFrustumCallback(mShadowFrustumCallback);
     }
 
+    void StereoFrustumManager::addMultiviewCamera(osg::Camera* camera)
+    {
+        if (!Stereo::getMultiview())
+            return;
+
+        // Cameras of render to texture nodes are replaced when the nodes are, forget the ones already gone
+        std::erase_if(mCameraFrustumCallbacks, [](const std::unique_ptr<MultiviewFrustumCallback>& callback) {
+            osg::ref_ptr<osg::Camera> camera;
+            return !callback->mCamera.lock(camera);
+        });
+        mCameraFrustumCallbacks.push_back(std::make_unique<MultiviewFrustumCallback>(this, camera));
+    }
+
     void StereoFrustumManager::customFrustumCallback(
         osgUtil::CullVisitor& cv, osg::BoundingBoxd& customClipSpace, osgUtil::CullVisitor*& sharedFrustumHint)
     {
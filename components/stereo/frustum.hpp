@@ -7,6 +7,7 @@
 #include <array>
 #include <map>
 #include <memory>
+#include <vector>
 
 namespace osg
 {
@@ -52,6 +53,10 @@ namespace Stereo
 
         void setShadowTechnique(SceneUtil::MWShadowTechnique* shadowTechnique);
 
+        //! Cull the camera with the frustum covering both views when multiview is enabled. The camera has to
+        //! render relative to the main camera with the same projection.
+        void addMultiviewCamera(osg::Camera* camera);
+
         void customFrustumCallback(
             osgUtil::CullVisitor& cv, osg::BoundingBoxd& customClipSpace, osgUtil::CullVisitor*& sharedFrustumHint);
 
@@ -63,6 +68,7 @@ namespace Stereo
         osg::BoundingBoxd mBoundingBox;
 
         std::unique_ptr<MultiviewFrustumCallback> mMultiviewFrustumCallback;
+        std::vector<std::unique_ptr<MultiviewFrustumCallback>> mCameraFrustumCallbacks;
     };
 }
 
@@ -200,6 +200,12 @@ namespace Stereo
             mFrustumManager->setShadowTechnique(shadowTechnique);
     }
 
+    void Manager::addMultiviewCamera(osg::Camera* camera)
+    {
+        if (mFrustumManager)
+            mFrustumManager->addMultiviewCamera(camera);
+    }
+
     void Manager::setupBruteForceTechnique()
     {
         auto* ds = osg::DisplaySettings::instance().get();
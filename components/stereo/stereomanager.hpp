@@ -128,6 +128,10 @@ namespace Stereo
 
         void setShadowTechnique(SceneUtil::MWShadowTechnique* shadowTechnique);
 
+        //! Cull a render to texture camera drawing both views in a single multiview pass with the frustum covering
+        //! both views, instead of the frustum of the main camera. This has no effect if multiview is not enabled.
+        void addMultiviewCamera(osg::Camera* camera);
+
         /// Determine which view the cull visitor belongs to
         Eye getEye(const osgUtil::CullVisitor* cv) const;
 
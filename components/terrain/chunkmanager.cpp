@@ -2,19 +2,27 @@
 
 #include <osg/Material>
 #include <osg/Texture2D>
+#include <osg/Texture2DArray>
 
 #include <osgUtil/IncrementalCompileOperation>
 
 #include <components/esm/util.hpp>
 #include <components/resource/objectcache.hpp>
 #include <components/resource/scenemanager.hpp>
+#include <components/vfs/manager.hpp>
 
 #include <components/sceneutil/lightmanager.hpp>
 
+#include <cstring>
+#include <format>
+#include <iterator>
+
+#include "compositemapcache.hpp"
 #include "compositemaprenderer.hpp"
 #include "material.hpp"
 #include "storage.hpp"
 #include "terraindrawable.hpp"
+#include "texturearray.hpp"
 #include "texturemanager.hpp"
 
 namespace Terrain
@@ -38,6 +46,36 @@ namespace Terrain
                     mSceneManager->applyFilterSettings(composite->mTexture);
             }
         };
+
+        // Layers blended from the same slice of the blendmap array, one per channel
+        constexpr std::size_t blendmapChannels = 4;
+
+        // Pack the single channel blendmaps of the layers into the channels of as few images as possible, so the
+        // array pass reads the weights of four layers with one lookup
+        std::vector<osg::ref_ptr<osg::Image>> packBlendmaps(const std::vector<osg::ref_ptr<osg::Image>>& blendmaps)
+        {
+            const int width = blendmaps.front()->s();
+            const int height = blendmaps.front()->t();
+            const std::size_t pixels = static_cast<std::size_t>(width) * static_cast<std::size_t>(height);
+            std::vector<osg::ref_ptr<osg::Image>> result((blendmaps.size() + blendmapChannels - 1) / blendmapChannels);
+            for (std::size_t i = 0; i < result.size(); ++i)
+            {
+                result[i] = new osg::Image;
+                result[i]->allocateImage(width, height, 1, GL_RGBA, GL_UNSIGNED_BYTE);
+                unsigned char* const dst = result[i]->data();
+                std::memset(dst, 0, result[i]->getTotalDataSize());
+                for (std::size_t channel = 0; channel < blendmapChannels; ++channel)
+                {
+                    const std::size_t layer = i * blendmapChannels + channel;
+                    if (layer >= blendmaps.size())
+                        break;
+                    const unsigned char* const src = blendmaps[layer]->data();
+                    for (std::size_t pixel = 0; pixel < pixels; ++pixel)
+                        dst[pixel * blendmapChannels + channel] = src[pixel];
+                }
+            }
+            return result;
+        }
     }
 
     ChunkManager::ChunkManager(Storage* storage, Resource::SceneManager* sceneMgr, TextureManager* textureManager,
@@ -48,10 +86,13 @@ namespace Terrain
         , mSceneManager(sceneMgr)
         , mTextureManager(textureManager)
         , mCompositeMapRenderer(renderer)
+        , mCompositeMapCache(nullptr)
         , mNodeMask(0)
         , mCompositeMapSize(512)
         , mCompositeMapLevel(1.f)
         , mMaxCompGeometrySize(1.f)
+        , mTextureArrays(false)
+        , mGeomorphing(false)
     {
         mMultiPassRoot = new osg::StateSet;
         mMultiPassRoot->setRenderingHint(osg::StateSet::OPAQUE_BIN);
@@ -146,7 +187,8 @@ namespace Terrain
             float width = texCoords.z() * 2.f;
             float height = texCoords.w() * 2.f;
 
-            std::vector<osg::ref_ptr<osg::StateSet>> passes = createPasses(chunkSize, chunkCenter, true);
+            std::vector<osg::ref_ptr<osg::StateSet>> passes = createPasses(
+                chunkSize, chunkCenter, true, mCompositeMapCache != nullptr ? &compositeMap.mCacheKey : nullptr);
             for (std::vector<osg::ref_ptr<osg::StateSet>>::iterator it = passes.begin(); it != passes.end(); ++it)
             {
                 osg::ref_ptr<osg::Geometry> geom = osg::createTexturedQuadGeometry(
@@ -164,12 +206,38 @@ namespace Terrain
     }
 
     std::vector<osg::ref_ptr<osg::StateSet>> ChunkManager::createPasses(
-        float chunkSize, const osg::Vec2f& chunkCenter, bool forCompositeMap)
+        float chunkSize, const osg::Vec2f& chunkCenter, bool forCompositeMap, std::string* cacheSource)
     {
         std::vector<LayerInfo> layerList;
         std::vector<osg::ref_ptr<osg::Image>> blendmaps;
         mStorage->getBlendmaps(chunkSize, chunkCenter, blendmaps, layerList, mWorldspace);
 
+        if (cacheSource != nullptr)
+        {
+            const VFS::Manager& vfs = *mSceneManager->getVFS();
+            std::format_to(std::back_inserter(*cacheSource), "{} {} {}\n", chunkSize, chunkCenter.x(), chunkCenter.y());
+            for (const LayerInfo& layer : layerList)
+            {
+                *cacheSource += layer.mDiffuseMap.value();
+                if (vfs.exists(layer.mDiffuseMap))
+                    std::format_to(std::back_inserter(*cacheSource), " {} {}", vfs.getArchive(layer.mDiffuseMap),
+                        vfs.getLastModified(layer.mDiffuseMap).time_since_epoch().count());
+                *cacheSource += '\n';
+            }
+            for (const osg::ref_ptr<osg::Image>& blendmap : blendmaps)
+            {
+                std::format_to(std::back_inserter(*cacheSource), "{} {} {}\n", blendmap->s(), blendmap->t(),
+                    blendmap->getPixelFormat());
+                cacheSource->append(reinterpret_cast<const char*>(blendmap->data()), blendmap->getTotalSizeInBytes());
+            }
+        }
+
+        if (mTextureArrays && !forCompositeMap)
+        {
+            if (osg::ref_ptr<osg::StateSet> pass = createArrayPass(chunkSize, layerList, blendmaps))
+                return { pass };
+        }
+
         bool useShaders = mSceneManager->getForceShaders();
         if (!mSceneManager->getClampLighting())
             useShaders = true; // always use shaders when lighting is unclamped, this is to avoid lighting seams between
@@ -195,6 +263,10 @@ namespace Terrain
             }
         }
 
+        // Vertices are morphed in the shader, chunks drawn without it would crack with their neighbours
+        if (mGeomorphing)
+            useShaders = true;
+
         if (forCompositeMap)
             useShaders = false;
 
@@ -212,7 +284,58 @@ namespace Terrain
         int tileCount = mStorage->getTextureTileCount(chunkSize, mWorldspace);
 
         return ::Terrain::createPasses(useShaders, mSceneManager, layers, blendmapTextures, tileCount,
-            static_cast<float>(tileCount), ESM::isEsm4Ext(mWorldspace));
+            static_cast<float>(tileCount), ESM::isEsm4Ext(mWorldspace), mGeomorphing && !forCompositeMap);
+    }
+
+    osg::ref_ptr<osg::StateSet> ChunkManager::createArrayPass(float chunkSize, const std::vector<LayerInfo>& layerList,
+        const std::vector<osg::ref_ptr<osg::Image>>& blendmaps)
+    {
+        // Keep the number of shader permutations and texture lookups per fragment bounded
+        constexpr std::size_t maxLayers = 16;
+
+        // A single layer is drawn in a single pass anyway. Chunks drawn with fixed function lighting keep it.
+        if (layerList.size() < 2 || layerList.size() > maxLayers || blendmaps.size() != layerList.size())
+            return nullptr;
+        if (!mSceneManager->getForceShaders() && mSceneManager->getClampLighting() && !mGeomorphing)
+            return nullptr;
+
+        osg::ref_ptr<TextureArray> diffuseMaps;
+        std::vector<int> layers;
+        layers.reserve(layerList.size());
+        for (const LayerInfo& layer : layerList)
+        {
+            if (layer.requiresShaders())
+                return nullptr;
+            const TextureArrayLayer arrayLayer = mTextureManager->getTextureArrayLayer(layer.mDiffuseMap);
+            if (arrayLayer.mArray == nullptr || (diffuseMaps != nullptr && arrayLayer.mArray != diffuseMaps))
+                return nullptr;
+            diffuseMaps = arrayLayer.mArray;
+            layers.push_back(arrayLayer.mLayer);
+        }
+
+        for (const osg::ref_ptr<osg::Image>& blendmap : blendmaps)
+        {
+            if (blendmap->getPixelFormat() != GL_ALPHA || blendmap->getDataType() != GL_UNSIGNED_BYTE
+                || blendmap->s() != blendmaps.front()->s() || blendmap->t() != blendmaps.front()->t())
+                return nullptr;
+        }
+
+        const std::vector<osg::ref_ptr<osg::Image>> packedBlendmaps = packBlendmaps(blendmaps);
+        osg::ref_ptr<osg::Texture2DArray> blendmapArray = new osg::Texture2DArray;
+        blendmapArray->setTextureSize(
+            blendmaps.front()->s(), blendmaps.front()->t(), static_cast<int>(packedBlendmaps.size()));
+        for (std::size_t i = 0; i < packedBlendmaps.size(); ++i)
+            blendmapArray->setImage(static_cast<unsigned>(i), packedBlendmaps[i]);
+        blendmapArray->setWrap(osg::Texture::WRAP_S, osg::Texture::CLAMP_TO_EDGE);
+        blendmapArray->setWrap(osg::Texture::WRAP_T, osg::Texture::CLAMP_TO_EDGE);
+        blendmapArray->setFilter(osg::Texture::MIN_FILTER, osg::Texture::LINEAR);
+        blendmapArray->setFilter(osg::Texture::MAG_FILTER, osg::Texture::LINEAR);
+        blendmapArray->setResizeNonPowerOfTwoHint(false);
+
+        const int tileCount = mStorage->getTextureTileCount(chunkSize, mWorldspace);
+
+        return ::Terrain::createArrayPass(mSceneManager, diffuseMaps->getTexture(), layers, blendmapArray, tileCount,
+            static_cast<float>(tileCount), ESM::isEsm4Ext(mWorldspace), mGeomorphing);
     }
 
     osg::ref_ptr<osg::Node> ChunkManager::createChunk(float chunkSize, const osg::Vec2f& chunkCenter, unsigned char lod,
@@ -237,6 +360,14 @@ namespace Terrain
             geometry->setVertexArray(positions);
             geometry->setNormalArray(normals, osg::Array::BIND_PER_VERTEX);
             geometry->setColorArray(colors, osg::Array::BIND_PER_VERTEX);
+
+            if (mGeomorphing)
+            {
+                osg::ref_ptr<osg::FloatArray> morphHeights(new osg::FloatArray);
+                mStorage->fillMorphTargets(*positions, *morphHeights);
+                morphHeights->setVertexBufferObject(vbo);
+                geometry->setVertexAttribArray(morphHeightAttribLocation, morphHeights, osg::Array::BIND_PER_VERTEX);
+            }
         }
         else
         {
@@ -256,6 +387,15 @@ namespace Terrain
             geometry->setVertexArray(positions);
             geometry->setNormalArray(normals, osg::Array::BIND_PER_VERTEX);
             geometry->setColorArray(colors, osg::Array::BIND_PER_VERTEX);
+
+            const osg::Array* templateMorphHeights = templateGeometry->getVertexAttribArray(morphHeightAttribLocation);
+            if (templateMorphHeights != nullptr)
+            {
+                osg::ref_ptr<osg::Array> morphHeights
+                    = static_cast<osg::Array*>(templateMorphHeights->clone(osg::CopyOp::DEEP_COPY_ALL));
+                morphHeights->setVertexBufferObject(vbo);
+                geometry->setVertexAttribArray(morphHeightAttribLocation, morphHeights, osg::Array::BIND_PER_VERTEX);
+            }
         }
 
         geometry->setUseDisplayList(false);
@@ -294,9 +434,25 @@ namespace Terrain
                 osg::ref_ptr<CompositeMap> compositeMap = new CompositeMap;
                 compositeMap->mTexture = createCompositeMapRTT();
 
+                if (mCompositeMapCache != nullptr)
+                    std::format_to(std::back_inserter(compositeMap->mCacheKey), "{} {} {}\n",
+                        mWorldspace.serializeText(), mCompositeMapSize, mMaxCompGeometrySize);
+
                 createCompositeMapGeometry(chunkSize, chunkCenter, osg::Vec4f(0, 0, 1, 1), *compositeMap);
 
-                mCompositeMapRenderer->addCompositeMap(compositeMap.get(), false);
+                if (mCompositeMapCache != nullptr)
+                {
+                    compositeMap->mCacheKey = CompositeMapCache::makeKey(compositeMap->mCacheKey);
+                    if (osg::ref_ptr<osg::Image> image = mCompositeMapCache->read(compositeMap->mCacheKey))
+                    {
+                        compositeMap->mTexture->setImage(image);
+                        compositeMap->mDrawables.clear();
+                        compositeMap->mCacheKey.clear();
+                    }
+                }
+
+                if (!compositeMap->mDrawables.empty())
+                    mCompositeMapRenderer->addCompositeMap(compositeMap.get(), false);
 
                 geometry->setCompositeMap(compositeMap);
                 geometry->setCompositeMapRenderer(mCompositeMapRenderer);
@@ -305,9 +461,11 @@ namespace Terrain
                 layer.mDiffuseMap = compositeMap->mTexture;
                 layer.mParallax = false;
                 layer.mSpecular = false;
+                layer.mMorphTexture = mGeomorphing;
                 geometry->setPasses(::Terrain::createPasses(
-                    mSceneManager->getForceShaders() || !mSceneManager->getClampLighting(), mSceneManager,
-                    std::vector<TextureLayer>(1, layer), std::vector<osg::ref_ptr<osg::Texture2D>>(), 1, 1.f));
+                    mSceneManager->getForceShaders() || !mSceneManager->getClampLighting() || mGeomorphing,
+                    mSceneManager, std::vector<TextureLayer>(1, layer), std::vector<osg::ref_ptr<osg::Texture2D>>(), 1,
+                    1.f, false, mGeomorphing));
             }
             else
             {
@@ -1,16 +1,19 @@
 #ifndef OPENMW_COMPONENTS_TERRAIN_CHUNKMANAGER_H
 #define OPENMW_COMPONENTS_TERRAIN_CHUNKMANAGER_H
 
+#include <string>
 #include <tuple>
 
 #include <components/resource/resourcemanager.hpp>
 
 #include "buffercache.hpp"
+#include "defs.hpp"
 #include "quadtreeworld.hpp"
 
 namespace osg
 {
     class Group;
+    class Image;
     class Texture2D;
 }
 
@@ -23,6 +26,7 @@ namespace Terrain
 {
 
     class TextureManager;
+    class CompositeMapCache;
     class CompositeMapRenderer;
     class Storage;
     class CompositeMap;
@@ -84,6 +88,10 @@ namespace Terrain
         void setCompositeMapSize(unsigned int size) { mCompositeMapSize = size; }
         void setCompositeMapLevel(float level) { mCompositeMapLevel = level; }
         void setMaxCompositeGeometrySize(float maxCompGeometrySize) { mMaxCompGeometrySize = maxCompGeometrySize; }
+        void setCompositeMapCache(const CompositeMapCache* cache) { mCompositeMapCache = cache; }
+        void setTextureArrays(bool enabled) { mTextureArrays = enabled; }
+        /// Store the heights of the next coarser LOD level with the vertices and draw chunks with shaders morphing them
+        void setGeomorphing(bool enabled) { mGeomorphing = enabled; }
 
         void updateTextureFiltering();
 
@@ -105,13 +113,19 @@ namespace Terrain
         void createCompositeMapGeometry(
             float chunkSize, const osg::Vec2f& chunkCenter, const osg::Vec4f& texCoords, CompositeMap& map);
 
+        /// @param cacheSource if not null, data the passes are created from is appended to it
         std::vector<osg::ref_ptr<osg::StateSet>> createPasses(
-            float chunkSize, const osg::Vec2f& chunkCenter, bool forCompositeMap);
+            float chunkSize, const osg::Vec2f& chunkCenter, bool forCompositeMap, std::string* cacheSource = nullptr);
+
+        /// @return a single pass drawing all layers from texture arrays, null if the layers don't fit into one
+        osg::ref_ptr<osg::StateSet> createArrayPass(float chunkSize, const std::vector<LayerInfo>& layerList,
+            const std::vector<osg::ref_ptr<osg::Image>>& blendmaps);
 
         Terrain::Storage* mStorage;
         Resource::SceneManager* mSceneManager;
         TextureManager* mTextureManager;
         CompositeMapRenderer* mCompositeMapRenderer;
+        const CompositeMapCache* mCompositeMapCache;
         BufferCache mBufferCache;
 
         osg::ref_ptr<osg::StateSet> mMultiPassRoot;
@@ -121,6 +135,8 @@ namespace Terrain
         unsigned int mCompositeMapSize;
         float mCompositeMapLevel;
         float mMaxCompGeometrySize;
+        bool mTextureArrays;
+        bool mGeomorphing;
     };
 
 }
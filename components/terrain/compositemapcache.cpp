@@ -0,0 +1,99 @@
+#include "compositemapcache.hpp"
+
+#include <osgDB/Registry>
+
+#include <components/debug/debuglog.hpp>
+#include <components/files/hash.hpp>
+
+#include <array>
+#include <cstdint>
+#include <format>
+#include <fstream>
+#include <sstream>
+
+namespace Terrain
+{
+    namespace
+    {
+        // Increment when the way composite maps are rendered changes
+        constexpr int compositeMapCacheVersion = 1;
+    }
+
+    CompositeMapCache::CompositeMapCache(const std::filesystem::path& path)
+        : mPath(path)
+        , mReaderWriter(osgDB::Registry::instance()->getReaderWriterForExtension("dds"))
+    {
+        if (mReaderWriter == nullptr)
+        {
+            Log(Debug::Warning) << "Composite map cache is disabled: no readerwriter for 'dds' found";
+            return;
+        }
+
+        std::error_code ec;
+        std::filesystem::create_directories(mPath, ec);
+        if (ec)
+        {
+            Log(Debug::Warning) << "Composite map cache is disabled: failed to create " << mPath << ": "
+                                << ec.message();
+            mReaderWriter = nullptr;
+        }
+    }
+
+    std::string CompositeMapCache::makeKey(std::string_view source)
+    {
+        std::istringstream stream(std::format("{}\n{}", compositeMapCacheVersion, source));
+        const std::array<std::uint64_t, 2> hash = Files::getHash("composite map", stream);
+        return std::format("{:016x}{:016x}", hash[0], hash[1]);
+    }
+
+    osg::ref_ptr<osg::Image> CompositeMapCache::read(std::string_view key) const
+    {
+        if (mReaderWriter == nullptr)
+            return nullptr;
+
+        std::ifstream stream(mPath / std::format("{}.dds", key), std::ios::binary);
+        if (!stream.is_open())
+            return nullptr;
+
+        osgDB::ReaderWriter::ReadResult result = mReaderWriter->readImage(stream);
+        if (!result.success())
+        {
+            Log(Debug::Warning) << "Failed to read cached composite map " << key << ": " << result.message();
+            return nullptr;
+        }
+
+        return result.getImage();
+    }
+
+    void CompositeMapCache::write(std::string_view key, const osg::Image& image) const
+    {
+        if (mReaderWriter == nullptr)
+            return;
+
+        const std::filesystem::path path = mPath / std::format("{}.dds", key);
+        // Write to a temporary file first to never read a partially written image
+        std::filesystem::path tmpPath = path;
+        tmpPath += ".tmp";
+
+        {
+            std::ofstream stream(tmpPath, std::ios::binary);
+            if (!stream.is_open())
+            {
+                Log(Debug::Warning) << "Failed to open " << tmpPath << " to cache composite map";
+                return;
+            }
+
+            const osgDB::ReaderWriter::WriteResult result = mReaderWriter->writeImage(image, stream);
+            if (!result.success())
+            {
+                Log(Debug::Warning) << "Failed to write cached composite map " << key << ": " << result.message();
+                return;
+            }
+        }
+
+        std::error_code ec;
+        std::filesystem::rename(tmpPath, path, ec);
+        if (ec)
+            Log(Debug::Warning) << "Failed to rename " << tmpPath << " to " << path << ": " << ec.message();
+    }
+}
@@ -0,0 +1,41 @@
+#ifndef OPENMW_COMPONENTS_TERRAIN_COMPOSITEMAPCACHE_H
+#define OPENMW_COMPONENTS_TERRAIN_COMPOSITEMAPCACHE_H
+
+#include <osg/Image>
+#include <osg/ref_ptr>
+
+#include <filesystem>
+#include <string>
+#include <string_view>
+
+namespace osgDB
+{
+    class ReaderWriter;
+}
+
+namespace Terrain
+{
+    /// @brief Stores rendered composite maps on disk to not render them again in the next session.
+    /// @par Images are keyed by a hash of everything the rendered map depends on, so changed content results in a
+    /// different key instead of reading a stale image.
+    /// @note Thread safe.
+    class CompositeMapCache
+    {
+    public:
+        explicit CompositeMapCache(const std::filesystem::path& path);
+
+        /// @param source all data the composite map is rendered from
+        static std::string makeKey(std::string_view source);
+
+        /// @return nullptr when there is no image for the key
+        osg::ref_ptr<osg::Image> read(std::string_view key) const;
+
+        void write(std::string_view key, const osg::Image& image) const;
+
+    private:
+        std::filesystem::path mPath;
+        osgDB::ReaderWriter* mReaderWriter;
+    };
+}
+
+#endif
@@ -6,12 +6,17 @@
 
 #include <algorithm>
 
+#include <components/shader/asyncprogram.hpp>
+
+#include "compositemapcache.hpp"
+
 namespace Terrain
 {
 
     CompositeMapRenderer::CompositeMapRenderer()
         : mTargetFrameRate(120)
         , mMinimumTimeAvailable(0.0025)
+        , mCompositeMapCache(nullptr)
     {
         setSupportsDisplayList(false);
         setCullingActive(false);
@@ -76,6 +81,9 @@ namespace Terrain
             return;
         }
 
+        // Composite maps are rendered once and kept, so they can't skip drawing layers that aren't linked yet
+        const Shader::ScopedSynchronousCompilation synchronousCompilation;
+
         osg::Timer timer;
         osg::State& state = *renderInfo.getState();
         osg::GLExtensions* ext = state.get<osg::GLExtensions>();
@@ -125,14 +133,59 @@ namespace Terrain
             compositeMap.mDrawables[i] = nullptr;
         }
         if (compositeMap.mCompiled == compositeMap.mDrawables.size())
+        {
             compositeMap.mDrawables = std::vector<osg::ref_ptr<osg::Drawable>>();
 
+            if (mCompositeMapCache != nullptr && !compositeMap.mCacheKey.empty())
+                storeCompositeMap(compositeMap, state);
+        }
+
         state.haveAppliedAttribute(osg::StateAttribute::VIEWPORT);
 
         GLuint fboId = state.getGraphicsContext() ? state.getGraphicsContext()->getDefaultFboId() : 0;
         ext->glBindFramebuffer(GL_FRAMEBUFFER_EXT, fboId);
     }
 
+    void CompositeMapRenderer::storeCompositeMap(const CompositeMap& compositeMap, osg::State& state) const
+    {
+        osg::GLExtensions* ext = state.get<osg::GLExtensions>();
+        if (!ext->isTextureCompressionS3TCSupported || ext->glGetCompressedTexImage == nullptr)
+            return;
+
+        const int width = compositeMap.mTexture->getTextureWidth();
+        const int height = compositeMap.mTexture->getTextureHeight();
+
+        // Let the driver compress a copy of the rendered texture
+        mFBO->apply(state, osg::FrameBufferObject::READ_FRAMEBUFFER);
+        GLuint texture = 0;
+        glGenTextures(1, &texture);
+        glBindTexture(GL_TEXTURE_2D, texture);
+        glCopyTexImage2D(GL_TEXTURE_2D, 0, GL_COMPRESSED_RGB_S3TC_DXT1_EXT, 0, 0, width, height, 0);
+
+        GLint compressed = GL_FALSE;
+        GLint size = 0;
+        glGetTexLevelParameteriv(GL_TEXTURE_2D, 0, GL_TEXTURE_COMPRESSED_ARB, &compressed);
+        if (compressed == GL_TRUE)
+            glGetTexLevelParameteriv(GL_TEXTURE_2D, 0, GL_TEXTURE_COMPRESSED_IMAGE_SIZE_ARB, &size);
+
+        osg::ref_ptr<osg::Image> image;
+        if (size > 0)
+        {
+            unsigned char* data = new unsigned char[size];
+            ext->glGetCompressedTexImage(GL_TEXTURE_2D, 0, data);
+            image = new osg::Image;
+            image->setImage(width, height, 1, GL_COMPRESSED_RGB_S3TC_DXT1_EXT, GL_COMPRESSED_RGB_S3TC_DXT1_EXT,
+                GL_UNSIGNED_BYTE, data, osg::Image::USE_NEW_DELETE);
+        }
+
+        glBindTexture(GL_TEXTURE_2D, 0);
+        glDeleteTextures(1, &texture);
+        state.haveAppliedTextureAttribute(state.getActiveTextureUnit(), osg::StateAttribute::TEXTURE);
+
+        if (image != nullptr)
+            mCompositeMapCache->write(compositeMap.mCacheKey, *image);
+    }
+
     void CompositeMapRenderer::setMinimumTimeAvailableForCompile(double time)
     {
         mMinimumTimeAvailable = time;
@@ -5,6 +5,7 @@
 
 #include <mutex>
 #include <set>
+#include <string>
 
 namespace osg
 {
@@ -15,6 +16,7 @@ namespace osg
 
 namespace Terrain
 {
+    class CompositeMapCache;
 
     class CompositeMap : public osg::Referenced
     {
@@ -24,6 +26,8 @@ namespace Terrain
         std::vector<osg::ref_ptr<osg::Drawable>> mDrawables;
         osg::ref_ptr<osg::Texture2D> mTexture;
         size_t mCompiled;
+        /// Key to store the rendered texture in the CompositeMapCache, empty to not store it
+        std::string mCacheKey;
     };
 
     /**
@@ -54,7 +58,12 @@ namespace Terrain
 
         size_t getCompileSetSize() const;
 
+        /// Store fully rendered composite maps with a cache key as compressed images
+        void setCompositeMapCache(const CompositeMapCache* cache) { mCompositeMapCache = cache; }
+
     private:
+        void storeCompositeMap(const CompositeMap& compositeMap, osg::State& state) const;
+
         float mTargetFrameRate;
         double mMinimumTimeAvailable;
         mutable osg::Timer mTimer;
@@ -67,6 +76,8 @@ namespace Terrain
         mutable std::mutex mMutex;
 
         osg::ref_ptr<osg::FrameBufferObject> mFBO;
+
+        const CompositeMapCache* mCompositeMapCache;
     };
 
 }
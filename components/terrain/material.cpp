@@ -7,6 +7,7 @@
 #include <osg/TexEnvCombine>
 #include <osg/TexMat>
 #include <osg/Texture2D>
+#include <osg/Texture2DArray>
 
 #include <components/resource/scenemanager.hpp>
 #include <components/sceneutil/depth.hpp>
@@ -217,13 +218,42 @@ namespace
         {
         }
     };
+
+    class MorphProgramTemplate
+    {
+    public:
+        static const osg::ref_ptr<osg::Program>& value(const Shader::ShaderManager& shaderManager)
+        {
+            static MorphProgramTemplate instance(shaderManager);
+            return instance.mValue;
+        }
+
+    private:
+        osg::ref_ptr<osg::Program> mValue;
+
+        explicit MorphProgramTemplate(const Shader::ShaderManager& shaderManager)
+            : mValue(shaderManager.getProgramTemplate() != nullptr
+                    ? Shader::ShaderManager::cloneProgram(shaderManager.getProgramTemplate())
+                    : osg::ref_ptr<osg::Program>(new osg::Program))
+        {
+            mValue->addBindAttribLocation("morphHeight", Terrain::morphHeightAttribLocation);
+        }
+    };
+
+    osg::ref_ptr<osg::Program> getTerrainProgram(
+        Shader::ShaderManager& shaderManager, Shader::ShaderManager::DefineMap& defineMap, bool morph)
+    {
+        defineMap["terrainMorph"] = morph ? "1" : "0";
+        return shaderManager.getProgram(
+            "terrain", defineMap, morph ? MorphProgramTemplate::value(shaderManager).get() : nullptr);
+    }
 }
 
 namespace Terrain
 {
     std::vector<osg::ref_ptr<osg::StateSet>> createPasses(bool useShaders, Resource::SceneManager* sceneManager,
         const std::vector<TextureLayer>& layers, const std::vector<osg::ref_ptr<osg::Texture2D>>& blendmaps,
-        int blendmapScale, float layerTileSize, bool esm4terrain)
+        int blendmapScale, float layerTileSize, bool esm4terrain, bool morph)
     {
         auto& shaderManager = sceneManager->getShaderManager();
         std::vector<osg::ref_ptr<osg::StateSet>> passes;
@@ -304,9 +334,12 @@ namespace Terrain
                 defineMap["parallax"] = parallax ? "1" : "0";
                 defineMap["writeNormals"] = (it == layers.end() - 1) ? "1" : "0";
                 defineMap["reconstructNormalZ"] = reconstructNormalZ ? "1" : "0";
+                defineMap["layerArray"] = "0";
+                defineMap["layerCount"] = "1";
+                defineMap["morphTexture"] = it->mMorphTexture ? "1" : "0";
                 Stereo::shaderStereoDefines(defineMap);
 
-                stateset->setAttributeAndModes(shaderManager.getProgram("terrain", defineMap));
+                stateset->setAttributeAndModes(getTerrainProgram(shaderManager, defineMap, morph));
                 stateset->addUniform(UniformCollection::value().mColorMode);
             }
             else
@@ -340,4 +373,44 @@ namespace Terrain
         return passes;
     }
 
+    osg::ref_ptr<osg::StateSet> createArrayPass(Resource::SceneManager* sceneManager, osg::Texture2DArray* diffuseMaps,
+        const std::vector<int>& layers, osg::Texture2DArray* blendmaps, int blendmapScale, float layerTileSize,
+        bool esm4terrain, bool morph)
+    {
+        osg::ref_ptr<osg::StateSet> stateset(new osg::StateSet);
+
+        stateset->setTextureAttributeAndModes(0, diffuseMaps);
+        if (layerTileSize != 1.f)
+            stateset->setTextureAttributeAndModes(0, LayerTexMat::value(layerTileSize), osg::StateAttribute::ON);
+        stateset->addUniform(UniformCollection::value().mDiffuseMap);
+
+        stateset->setTextureAttributeAndModes(1, blendmaps);
+        if (!esm4terrain)
+            stateset->setTextureAttributeAndModes(1, BlendmapTexMat::value(blendmapScale));
+        stateset->addUniform(UniformCollection::value().mBlendMap);
+
+        osg::ref_ptr<osg::Uniform> layerIndices
+            = new osg::Uniform(osg::Uniform::FLOAT, "layerIndices", static_cast<int>(layers.size()));
+        for (std::size_t i = 0; i < layers.size(); ++i)
+            layerIndices->setElement(static_cast<unsigned>(i), static_cast<float>(layers[i]));
+        stateset->addUniform(layerIndices);
+
+        Shader::ShaderManager::DefineMap defineMap;
+        defineMap["normalMap"] = "0";
+        defineMap["blendMap"] = "1";
+        defineMap["specularMap"] = "0";
+        defineMap["parallax"] = "0";
+        defineMap["writeNormals"] = "1";
+        defineMap["reconstructNormalZ"] = "0";
+        defineMap["layerArray"] = "1";
+        defineMap["layerCount"] = std::to_string(layers.size());
+        defineMap["morphTexture"] = "0";
+        Stereo::shaderStereoDefines(defineMap);
+
+        stateset->setAttributeAndModes(getTerrainProgram(sceneManager->getShaderManager(), defineMap, morph));
+        stateset->addUniform(UniformCollection::value().mColorMode);
+
+        return stateset;
+    }
+
 }
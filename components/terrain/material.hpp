@@ -6,6 +6,7 @@
 namespace osg
 {
     class Texture2D;
+    class Texture2DArray;
 }
 
 namespace Resource
@@ -15,6 +16,8 @@ namespace Resource
 
 namespace Terrain
 {
+    /// Location of the vertex attribute holding the heights of the next coarser LOD level
+    inline constexpr unsigned morphHeightAttribLocation = 6;
 
     struct TextureLayer
     {
@@ -22,11 +25,23 @@ namespace Terrain
         osg::ref_ptr<osg::Texture2D> mNormalMap; // optional
         bool mParallax = false;
         bool mSpecular = false;
+        // The diffuse map of the next coarser LOD level has half the resolution, so it's faded to a lower mipmap while
+        // vertices are morphed
+        bool mMorphTexture = false;
     };
 
     std::vector<osg::ref_ptr<osg::StateSet>> createPasses(bool useShaders, Resource::SceneManager* sceneManager,
         const std::vector<TextureLayer>& layers, const std::vector<osg::ref_ptr<osg::Texture2D>>& blendmaps,
-        int blendmapScale, float layerTileSize, bool esm4terrain = false);
+        int blendmapScale, float layerTileSize, bool esm4terrain = false, bool morph = false);
+
+    /// Create a single pass blending all layers in the shader.
+    /// @param diffuseMaps array holding the diffuse maps of all layers
+    /// @param layers layer of diffuseMaps for each blendmap layer
+    /// @param blendmaps array holding a blendmap for each layer
+    /// @param morph if vertices are morphed to the next coarser LOD level
+    osg::ref_ptr<osg::StateSet> createArrayPass(Resource::SceneManager* sceneManager, osg::Texture2DArray* diffuseMaps,
+        const std::vector<int>& layers, osg::Texture2DArray* blendmaps, int blendmapScale, float layerTileSize,
+        bool esm4terrain = false, bool morph = false);
 }
 
 #endif
@@ -3,8 +3,10 @@
 #include <osg/Material>
 #include <osg/PolygonMode>
 #include <osg/ShapeDrawable>
+#include <osg/Uniform>
 #include <osgUtil/CullVisitor>
 
+#include <chrono>
 #include <limits>
 
 #include <components/esm/util.hpp>
@@ -291,6 +293,8 @@ namespace Terrain
         , mVertexLodMod(vertexLodMod)
         , mViewDistance(std::numeric_limits<float>::max())
         , mMinSize(ESM::isEsm4Ext(worldspace) ? 1 / 2.f : 1 / 8.f)
+        , mViewUpdateBudget(0)
+        , mGeomorphing(false)
         , mDebugTerrainChunks(debugChunks)
     {
         mChunkManager->setCompositeMapSize(compMapResolution);
@@ -309,6 +313,17 @@ namespace Terrain
 
     QuadTreeWorld::~QuadTreeWorld() {}
 
+    void QuadTreeWorld::enableGeomorphing()
+    {
+        mGeomorphing = true;
+        mChunkManager->setGeomorphing(true);
+        // Chunks of the terrain grid keep their vertices, the shader still reads the uniforms
+        osg::StateSet* stateSet = mTerrainRoot->getOrCreateStateSet();
+        stateSet->addUniform(new osg::Uniform("terrainMorph", osg::Vec4f()));
+        stateSet->addUniform(new osg::Uniform("terrainMorphBounds", osg::Vec4f()));
+        stateSet->addUniform(new osg::Uniform("terrainViewPoint", osg::Vec3f()));
+    }
+
     /// get the level of vertex detail to render this node at, expressed relative to the native resolution of the vertex
     /// data set, NOT relative to mMinSize as is the case with node LODs.
     unsigned int getVertexLod(QuadTreeNode* node, int vertexLodMod)
@@ -364,6 +379,27 @@ namespace Terrain
         return lodFlags;
     }
 
+    /// get the edges shared with more detailed chunks. Their vertices must keep their height while morphing, the
+    /// neighbours don't morph them.
+    unsigned int getPinnedEdges(QuadTreeNode* node, const ViewData* vd)
+    {
+        unsigned int edges = 0;
+        for (unsigned int i = 0; i < 4; ++i)
+        {
+            QuadTreeNode* neighbour = node->getNeighbour(static_cast<Direction>(i));
+            if (neighbour == nullptr || vd->contains(neighbour))
+                continue;
+            // The neighbour is either replaced by a less detailed ancestor, which is stitched to us, or by more
+            // detailed descendants
+            QuadTreeNode* ancestor = neighbour->getParent();
+            while (ancestor && !vd->contains(ancestor))
+                ancestor = ancestor->getParent();
+            if (ancestor == nullptr)
+                edges |= 1u << i;
+        }
+        return edges;
+    }
+
     void QuadTreeWorld::loadRenderingNode(
         ViewDataEntry& entry, ViewData* vd, float cellWorldSize, const osg::Vec4i& gridbounds, bool compile)
     {
@@ -377,10 +413,12 @@ namespace Terrain
             unsigned int ourVertexLod = getVertexLod(entry.mNode, mVertexLodMod);
             // have to recompute the lodFlags in case a neighbour has changed LOD.
             unsigned int lodFlags = getLodFlags(entry.mNode, ourVertexLod, mVertexLodMod, vd);
-            if (lodFlags != entry.mLodFlags)
+            unsigned int pinnedEdges = mGeomorphing ? getPinnedEdges(entry.mNode, vd) : 0;
+            if (lodFlags != entry.mLodFlags || pinnedEdges != entry.mPinnedEdges)
             {
                 entry.mRenderingNode = nullptr;
                 entry.mLodFlags = lodFlags;
+                entry.mPinnedEdges = pinnedEdges;
             }
         }
 
@@ -402,10 +440,53 @@ namespace Terrain
                 if (n)
                     pat->addChild(n);
             }
+            if (mGeomorphing)
+                pat->setStateSet(createMorphStateSet(entry, cellWorldSize, gridbounds));
             entry.mRenderingNode = pat;
         }
     }
 
+    osg::ref_ptr<osg::StateSet> QuadTreeWorld::createMorphStateSet(
+        const ViewDataEntry& entry, float cellWorldSize, const osg::Vec4i& gridbounds) const
+    {
+        // Morph over the last part of the distances the chunk is used at
+        constexpr float morphStart = 0.75f;
+
+        QuadTreeNode* const node = entry.mNode;
+        QuadTreeNode* const parent = node->getParent();
+        const unsigned int vertexLod = getVertexLod(node, mVertexLodMod);
+
+        bool morph = parent != nullptr && getVertexLod(parent, mVertexLodMod) == vertexLod + 1;
+        if (morph && parent->getSize() > 1)
+        {
+            // Same as DefaultLodCallback, the parent is never used while it intersects the active grid
+            const float halfSize = parent->getSize() / 2;
+            const osg::Vec2f& center = parent->getCenter();
+            morph = !(center.x() - halfSize < gridbounds.z() && center.x() + halfSize > gridbounds.x()
+                && center.y() - halfSize < gridbounds.w() && center.y() + halfSize > gridbounds.y());
+        }
+
+        // The parent is used once it's at the distance the node is used from times two
+        const float end = 2 * node->getSize() * cellWorldSize * mLodFactor;
+        const float start = end * morphStart;
+        const float scale = morph ? 1 / (end - start) : 0.f;
+        const osg::Vec2f origin = node->getCenter() * cellWorldSize;
+
+        // Vertices of the edges are exactly at half of the size, leave some space for rounding
+        const float halfSize = node->getSize() * cellWorldSize / 2;
+        const float inside = halfSize - 1;
+        const float outside = halfSize + 1;
+        const osg::Vec4f bounds((entry.mPinnedEdges & (1u << West)) ? -inside : -outside,
+            (entry.mPinnedEdges & (1u << South)) ? -inside : -outside,
+            (entry.mPinnedEdges & (1u << East)) ? inside : outside,
+            (entry.mPinnedEdges & (1u << North)) ? inside : outside);
+
+        osg::ref_ptr<osg::StateSet> stateSet = new osg::StateSet;
+        stateSet->addUniform(new osg::Uniform("terrainMorph", osg::Vec4f(origin.x(), origin.y(), start, scale)));
+        stateSet->addUniform(new osg::Uniform("terrainMorphBounds", bounds));
+        return stateSet;
+    }
+
     namespace
     {
         osg::ref_ptr<osg::StateSet> makeStateSet()
@@ -476,25 +557,76 @@ namespace Terrain
         if (!isCullVisitor && nv.getVisitorType() != osg::NodeVisitor::INTERSECTION_VISITOR)
             return;
 
+        std::unique_lock<std::mutex> lock(mViewDataMutex);
+
         osg::Object* viewer = isCullVisitor ? static_cast<osgUtil::CullVisitor*>(&nv)->getCurrentCamera() : nullptr;
         bool needsUpdate = true;
         osg::Vec3f viewPoint = viewer ? nv.getViewPoint() : nv.getEyePoint();
         ViewData* vd = mViewDataMap->getViewData(viewer, viewPoint, mActiveGrid, needsUpdate);
+        const float cellWorldSize = static_cast<float>(ESM::getCellSize(mWorldspace));
+
         if (needsUpdate)
         {
-            vd->reset();
             DefaultLodCallback lodCallback(
                 mLodFactor, mMinSize, mViewDistance, mActiveGrid, ESM::getCellSize(mWorldspace));
-            mRootNode->traverseNodes(vd, viewPoint, &lodCallback);
+            // Keep rendering the current entries while the new ones are loaded unless nothing is rendered yet.
+            if (isCullVisitor && mViewUpdateBudget > 0 && vd->getNumEntries() != 0)
+            {
+                ViewData& pending = vd->getOrCreatePendingView();
+                pending.setViewPoint(viewPoint);
+                pending.setActiveGrid(mActiveGrid);
+                pending.reset();
+                pending.setNumLoadedEntries(0);
+                mRootNode->traverseNodes(&pending, viewPoint, &lodCallback);
+            }
+            else
+            {
+                vd->discardPendingView();
+                vd->reset();
+                mRootNode->traverseNodes(vd, viewPoint, &lodCallback);
+            }
         }
 
-        const float cellWorldSize = static_cast<float>(ESM::getCellSize(mWorldspace));
+        if (vd->getPendingView() != nullptr)
+            updatePendingView(vd, cellWorldSize);
 
-        for (unsigned int i = 0; i < vd->getNumEntries(); ++i)
+        if (isCullVisitor)
         {
-            ViewDataEntry& entry = vd->getEntry(i);
-            loadRenderingNode(entry, vd, cellWorldSize, mActiveGrid, false);
-            entry.mRenderingNode->accept(nv);
+            for (unsigned int i = 0; i < vd->getNumEntries(); ++i)
+                loadRenderingNode(vd->getEntry(i), vd, cellWorldSize, mActiveGrid, false);
+
+            // Check whole clusters first to not traverse each chunk outside of views with a narrow frustum like shadow
+            // cascades or cubemap faces.
+            vd->buildClusters();
+            lock.unlock();
+            osgUtil::CullVisitor* cv = static_cast<osgUtil::CullVisitor*>(&nv);
+            if (mGeomorphing)
+            {
+                // Differs for each view and frame, a state set still used for drawing the previous frame must not
+                // change
+                osg::ref_ptr<osg::StateSet> stateSet = new osg::StateSet;
+                stateSet->addUniform(new osg::Uniform("terrainViewPoint", viewPoint));
+                cv->pushStateSet(stateSet);
+            }
+            for (const ViewDataCluster& cluster : vd->getClusters())
+            {
+                if (cv->isCulled(cluster.mBoundingBox))
+                    continue;
+                for (unsigned int i = cluster.mBegin; i < cluster.mEnd; ++i)
+                    vd->getEntry(i).mRenderingNode->accept(nv);
+            }
+            if (mGeomorphing)
+                cv->popStateSet();
+            lock.lock();
+        }
+        else
+        {
+            for (unsigned int i = 0; i < vd->getNumEntries(); ++i)
+            {
+                ViewDataEntry& entry = vd->getEntry(i);
+                loadRenderingNode(entry, vd, cellWorldSize, mActiveGrid, false);
+                entry.mRenderingNode->accept(nv);
+            }
         }
 
         if (mHeightCullCallback && isCullVisitor)
@@ -511,6 +643,31 @@ namespace Terrain
         }
     }
 
+    void QuadTreeWorld::updatePendingView(ViewData* vd, float cellWorldSize)
+    {
+        ViewData& pending = *vd->getPendingView();
+        const auto deadline = std::chrono::steady_clock::now()
+            + std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+                std::chrono::duration<float, std::milli>(mViewUpdateBudget));
+
+        unsigned int i = pending.getNumLoadedEntries();
+        // Load at least one entry per frame to always make progress
+        do
+        {
+            if (i >= pending.getNumEntries())
+                break;
+            loadRenderingNode(pending.getEntry(i), &pending, cellWorldSize, mActiveGrid, false);
+            ++i;
+        } while (std::chrono::steady_clock::now() < deadline);
+        pending.setNumLoadedEntries(i);
+
+        if (i < pending.getNumEntries())
+            return;
+
+        vd->copyFrom(pending);
+        vd->discardPendingView();
+    }
+
     void QuadTreeWorld::ensureQuadTreeBuilt()
     {
         std::lock_guard<std::mutex> lock(mQuadTreeMutex);
@@ -13,6 +13,7 @@ namespace osg
 {
     class NodeVisitor;
     class Group;
+    class StateSet;
     class Stats;
 }
 
@@ -43,6 +44,15 @@ namespace Terrain
 
         void setViewDistance(float distance) override;
 
+        /// Spread loading of rendering nodes for an updated view over several frames, spending up to the given time
+        /// per frame and view. The previous view is rendered until the updated one is complete. 0 loads everything
+        /// at once.
+        void setViewUpdateBudget(float milliseconds) { mViewUpdateBudget = milliseconds; }
+
+        /// Morph the vertices of chunks to the next coarser LOD level while they get close to the distance they are
+        /// replaced at, so LOD transitions don't pop. Must be called before any chunks are created.
+        void enableGeomorphing();
+
         void cacheCell(View* view, int x, int y) override {}
         /// @note Not thread safe.
         void loadCell(int x, int y) override;
@@ -91,10 +101,15 @@ namespace Terrain
         void ensureQuadTreeBuilt();
         void loadRenderingNode(
             ViewDataEntry& entry, ViewData* vd, float cellWorldSize, const osg::Vec4i& gridbounds, bool compile);
+        void updatePendingView(ViewData* vd, float cellWorldSize);
+        osg::ref_ptr<osg::StateSet> createMorphStateSet(
+            const ViewDataEntry& entry, float cellWorldSize, const osg::Vec4i& gridbounds) const;
 
         osg::ref_ptr<RootNode> mRootNode;
 
         osg::ref_ptr<ViewDataMap> mViewDataMap;
+        // Views may be culled in parallel, the chunks are traversed without holding it
+        std::mutex mViewDataMutex;
 
         std::vector<ChunkManager*> mChunkManagers;
 
@@ -104,6 +119,8 @@ namespace Terrain
         int mVertexLodMod;
         float mViewDistance;
         float mMinSize;
+        float mViewUpdateBudget;
+        bool mGeomorphing;
         bool mDebugTerrainChunks;
         std::unique_ptr<DebugChunkManager> mDebugChunkManager;
     };
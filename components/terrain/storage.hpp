@@ -67,6 +67,13 @@ namespace Terrain
             osg::Vec3Array& positions, osg::Vec3Array& normals, osg::Vec4ubArray& colours)
             = 0;
 
+        /// Fill the heights the vertices of a terrain chunk have with the next coarser LOD level, for morphing the
+        /// chunk into its parent. Vertices that can't be morphed keep their height.
+        /// @note May be called from background threads.
+        /// @param positions vertices written by fillVertexBuffers
+        /// @param morphHeights buffer to write a height for each vertex
+        virtual void fillMorphTargets(const osg::Vec3Array& positions, osg::FloatArray& morphHeights) = 0;
+
         typedef std::vector<osg::ref_ptr<osg::Image>> ImageVector;
         /// Create textures holding layer blend values for a terrain chunk.
         /// @note The terrain chunk shouldn't be larger than one cell since otherwise we might
@@ -0,0 +1,180 @@
+#include "texturearray.hpp"
+
+#include <osg/GLExtensions>
+#include <osg/Image>
+#include <osg/State>
+#include <osg/Texture2DArray>
+#include <osg/buffered_value>
+
+#include <algorithm>
+#include <mutex>
+#include <vector>
+
+namespace Terrain
+{
+    namespace
+    {
+        // Storage for all layers is allocated at once, limit the memory spent on layers that may never be used
+        constexpr unsigned sLayerBudget = 32 * 1024 * 1024;
+        constexpr int sMinLayers = 8;
+        constexpr int sMaxLayers = 256;
+
+        unsigned computeLevelSize(const osg::Image& image, int level)
+        {
+            const int width = std::max(image.s() >> level, 1);
+            const int height = std::max(image.t() >> level, 1);
+            return osg::Image::computeImageSizeInBytes(
+                width, height, 1, image.getPixelFormat(), image.getDataType(), image.getPacking());
+        }
+
+        unsigned computeLayerSize(const osg::Image& image)
+        {
+            unsigned size = 0;
+            for (unsigned level = 0; level < image.getNumMipmapLevels(); ++level)
+                size += computeLevelSize(image, static_cast<int>(level));
+            return size;
+        }
+    }
+
+    class TextureArray::Subload : public osg::Texture::SubloadCallback
+    {
+    public:
+        Subload(const osg::Image& image, int capacity)
+            : mWidth(image.s())
+            , mHeight(image.t())
+            , mPixelFormat(image.getPixelFormat())
+            , mInternalFormat(image.getInternalTextureFormat())
+            , mDataType(image.getDataType())
+            , mPacking(image.getPacking())
+            , mNumMipmapLevels(image.getNumMipmapLevels())
+            , mCompressed(image.isCompressed())
+            , mCapacity(capacity)
+        {
+            mUploaded.setAllElementsTo(0);
+        }
+
+        bool isCompatible(const osg::Image& image) const
+        {
+            return image.s() == mWidth && image.t() == mHeight && image.r() == 1
+                && image.getPixelFormat() == mPixelFormat && image.getInternalTextureFormat() == mInternalFormat
+                && image.getDataType() == mDataType && image.getPacking() == mPacking
+                && image.getNumMipmapLevels() == mNumMipmapLevels;
+        }
+
+        int addLayer(osg::ref_ptr<osg::Image> image)
+        {
+            std::lock_guard<std::mutex> lock(mMutex);
+            if (static_cast<int>(mLayers.size()) >= mCapacity)
+                return -1;
+            mLayers.push_back(std::move(image));
+            return static_cast<int>(mLayers.size()) - 1;
+        }
+
+        void load(const osg::Texture& texture, osg::State& state) const override
+        {
+            const osg::GLExtensions* extensions = state.get<osg::GLExtensions>();
+            for (unsigned level = 0; level < mNumMipmapLevels; ++level)
+            {
+                const int width = std::max(mWidth >> level, 1);
+                const int height = std::max(mHeight >> level, 1);
+                if (mCompressed)
+                {
+                    const unsigned size = osg::Image::computeImageSizeInBytes(
+                        width, height, 1, mPixelFormat, mDataType, mPacking);
+                    extensions->glCompressedTexImage3D(GL_TEXTURE_2D_ARRAY, level, mInternalFormat, width, height,
+                        mCapacity, 0, static_cast<GLsizei>(size * mCapacity), nullptr);
+                }
+                else
+                    extensions->glTexImage3D(GL_TEXTURE_2D_ARRAY, level, mInternalFormat, width, height, mCapacity, 0,
+                        mPixelFormat, mDataType, nullptr);
+            }
+
+            mUploaded[state.getContextID()] = 0;
+            subload(texture, state);
+        }
+
+        void subload(const osg::Texture& /*texture*/, osg::State& state) const override
+        {
+            std::size_t& uploaded = mUploaded[state.getContextID()];
+            std::vector<osg::ref_ptr<osg::Image>> layers;
+            {
+                std::lock_guard<std::mutex> lock(mMutex);
+                if (uploaded == mLayers.size())
+                    return;
+                layers.assign(mLayers.begin() + static_cast<std::ptrdiff_t>(uploaded), mLayers.end());
+            }
+
+            const osg::GLExtensions* extensions = state.get<osg::GLExtensions>();
+            glPixelStorei(GL_UNPACK_ALIGNMENT, mPacking);
+            for (const osg::ref_ptr<osg::Image>& image : layers)
+            {
+                const GLint layer = static_cast<GLint>(uploaded++);
+                for (unsigned level = 0; level < mNumMipmapLevels; ++level)
+                {
+                    const int width = std::max(mWidth >> level, 1);
+                    const int height = std::max(mHeight >> level, 1);
+                    const unsigned char* data = image->getMipmapData(level);
+                    if (mCompressed)
+                        extensions->glCompressedTexSubImage3D(GL_TEXTURE_2D_ARRAY, level, 0, 0, layer, width, height,
+                            1, mInternalFormat, static_cast<GLsizei>(computeLevelSize(*image, level)), data);
+                    else
+                        extensions->glTexSubImage3D(GL_TEXTURE_2D_ARRAY, level, 0, 0, layer, width, height, 1,
+                            mPixelFormat, mDataType, data);
+                }
+            }
+        }
+
+    private:
+        const int mWidth;
+        const int mHeight;
+        const GLenum mPixelFormat;
+        const GLint mInternalFormat;
+        const GLenum mDataType;
+        const unsigned mPacking;
+        const unsigned mNumMipmapLevels;
+        const bool mCompressed;
+        const int mCapacity;
+
+        mutable std::mutex mMutex;
+        std::vector<osg::ref_ptr<osg::Image>> mLayers;
+        mutable osg::buffered_value<std::size_t> mUploaded;
+    };
+
+    TextureArray::TextureArray(const osg::Image& image)
+    {
+        const int capacity
+            = std::clamp(static_cast<int>(sLayerBudget / computeLayerSize(image)), sMinLayers, sMaxLayers);
+
+        mSubload = new Subload(image, capacity);
+
+        mTexture = new osg::Texture2DArray;
+        mTexture->setTextureSize(image.s(), image.t(), capacity);
+        mTexture->setInternalFormat(image.getInternalTextureFormat());
+        mTexture->setSourceFormat(image.getPixelFormat());
+        mTexture->setSourceType(image.getDataType());
+        mTexture->setNumMipmapLevels(image.getNumMipmapLevels());
+        mTexture->setUseHardwareMipMapGeneration(false);
+        mTexture->setWrap(osg::Texture::WRAP_S, osg::Texture::REPEAT);
+        mTexture->setWrap(osg::Texture::WRAP_T, osg::Texture::REPEAT);
+        mTexture->setSubloadCallback(mSubload);
+    }
+
+    bool TextureArray::isSupported(const osg::Image& image)
+    {
+        // Layers are uploaded as they are, mipmaps can't be generated for compressed ones
+        return image.valid() && image.r() == 1
+            && static_cast<int>(image.getNumMipmapLevels())
+            == osg::Image::computeNumberOfMipmapLevels(image.s(), image.t());
+    }
+
+    bool TextureArray::isCompatible(const osg::Image& image) const
+    {
+        return mSubload->isCompatible(image);
+    }
+
+    int TextureArray::addLayer(osg::ref_ptr<osg::Image> image)
+    {
+        return mSubload->addLayer(std::move(image));
+    }
+
+}
@@ -0,0 +1,45 @@
+#ifndef OPENMW_COMPONENTS_TERRAIN_TEXTUREARRAY_H
+#define OPENMW_COMPONENTS_TERRAIN_TEXTUREARRAY_H
+
+#include <osg/Referenced>
+#include <osg/ref_ptr>
+
+namespace osg
+{
+    class Image;
+    class Texture2DArray;
+}
+
+namespace Terrain
+{
+
+    /// @brief Land textures of the same size and format packed into the layers of a Texture2DArray.
+    /// @par The storage for all layers is allocated on the first use, layers added later are uploaded by the draw
+    /// thread the next time the texture is applied. This allows adding layers while the array is already in use.
+    /// @note Thread safe.
+    class TextureArray : public osg::Referenced
+    {
+    public:
+        explicit TextureArray(const osg::Image& image);
+
+        /// @return true if the image can be stored in a TextureArray
+        static bool isSupported(const osg::Image& image);
+
+        /// @return true if the image can be stored in this array
+        bool isCompatible(const osg::Image& image) const;
+
+        /// @return the layer the image is stored in, -1 if the array is full
+        int addLayer(osg::ref_ptr<osg::Image> image);
+
+        osg::Texture2DArray* getTexture() const { return mTexture; }
+
+    private:
+        class Subload;
+
+        osg::ref_ptr<osg::Texture2DArray> mTexture;
+        osg::ref_ptr<Subload> mSubload;
+    };
+
+}
+
+#endif
@@ -1,11 +1,14 @@
 #include "texturemanager.hpp"
 
 #include <osg/Texture2D>
+#include <osg/Texture2DArray>
 
 #include <components/resource/imagemanager.hpp>
 #include <components/resource/objectcache.hpp>
 #include <components/resource/scenemanager.hpp>
 
+#include "texturearray.hpp"
+
 namespace Terrain
 {
 
@@ -36,6 +39,10 @@ namespace Terrain
     {
         UpdateTextureFilteringFunctor f(mSceneManager);
         mCache->call(f);
+
+        std::lock_guard<std::mutex> lock(mArrayMutex);
+        for (const osg::ref_ptr<TextureArray>& array : mArrays)
+            mSceneManager->applyFilterSettings(array->getTexture());
     }
 
     osg::ref_ptr<osg::Texture2D> TextureManager::getTexture(VFS::Path::NormalizedView name)
@@ -55,6 +62,60 @@ namespace Terrain
         return texture;
     }
 
+    TextureArrayLayer TextureManager::getTextureArrayLayer(VFS::Path::NormalizedView name)
+    {
+        {
+            std::lock_guard<std::mutex> lock(mArrayMutex);
+            const auto it = mArrayLayers.find(name.value());
+            if (it != mArrayLayers.end())
+                return it->second;
+        }
+
+        osg::ref_ptr<osg::Image> image = mSceneManager->getImageManager()->getImage(name);
+
+        std::lock_guard<std::mutex> lock(mArrayMutex);
+        TextureArrayLayer& result = mArrayLayers[std::string(name.value())];
+        if (result.mLayer != -1 || image == nullptr || !TextureArray::isSupported(*image))
+            return result;
+
+        for (const osg::ref_ptr<TextureArray>& array : mArrays)
+        {
+            if (!array->isCompatible(*image))
+                continue;
+            result.mLayer = array->addLayer(image);
+            if (result.mLayer != -1)
+            {
+                result.mArray = array;
+                return result;
+            }
+        }
+
+        osg::ref_ptr<TextureArray> array = new TextureArray(*image);
+        mSceneManager->applyFilterSettings(array->getTexture());
+        mArrays.push_back(array);
+        result.mArray = array;
+        result.mLayer = array->addLayer(image);
+        return result;
+    }
+
+    void TextureManager::clearCache()
+    {
+        ResourceManager::clearCache();
+
+        std::lock_guard<std::mutex> lock(mArrayMutex);
+        mArrays.clear();
+        mArrayLayers.clear();
+    }
+
+    void TextureManager::releaseGLObjects(osg::State* state)
+    {
+        ResourceManager::releaseGLObjects(state);
+
+        std::lock_guard<std::mutex> lock(mArrayMutex);
+        for (const osg::ref_ptr<TextureArray>& array : mArrays)
+            array->getTexture()->releaseGLObjects(state);
+    }
+
     void TextureManager::reportStats(unsigned int frameNumber, osg::Stats* stats) const
     {
         Resource::reportStats("Terrain Texture", frameNumber, mCache->getStats(), *stats);
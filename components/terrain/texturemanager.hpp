@@ -4,6 +4,11 @@
 #include <components/resource/resourcemanager.hpp>
 #include <components/vfs/pathutil.hpp>
 
+#include <map>
+#include <mutex>
+#include <string>
+#include <vector>
+
 namespace Resource
 {
     class SceneManager;
@@ -16,6 +21,13 @@ namespace osg
 
 namespace Terrain
 {
+    class TextureArray;
+
+    struct TextureArrayLayer
+    {
+        osg::ref_ptr<TextureArray> mArray;
+        int mLayer = -1;
+    };
 
     class TextureManager : public Resource::ResourceManager
     {
@@ -26,10 +38,23 @@ namespace Terrain
 
         osg::ref_ptr<osg::Texture2D> getTexture(VFS::Path::NormalizedView name);
 
+        /// Get the layer of a texture array the texture is stored in.
+        /// @return a layer without array if the texture can't be stored in an array
+        TextureArrayLayer getTextureArrayLayer(VFS::Path::NormalizedView name);
+
         void reportStats(unsigned int frameNumber, osg::Stats* stats) const override;
 
+        void clearCache() override;
+
+        void releaseGLObjects(osg::State* state) override;
+
     private:
         Resource::SceneManager* mSceneManager;
+
+        // Arrays are not expired, the chunks using them are
+        std::mutex mArrayMutex;
+        std::vector<osg::ref_ptr<TextureArray>> mArrays;
+        std::map<std::string, TextureArrayLayer, std::less<>> mArrayLayers;
     };
 
 }
@@ -6,9 +6,14 @@
 
 namespace Terrain
 {
+    namespace
+    {
+        constexpr unsigned int clusterSize = 16;
+    }
 
     ViewData::ViewData()
         : mNumEntries(0)
+        , mNumLoadedEntries(0)
         , mLastUsageTimeStamp(0.0)
         , mChanged(false)
         , mHasViewPoint(false)
@@ -28,6 +33,7 @@ namespace Terrain
         mActiveGrid = other.mActiveGrid;
         mWorldUpdateRevision = other.mWorldUpdateRevision;
         mNodes = other.mNodes;
+        mClusters.clear();
     }
 
     void ViewData::add(QuadTreeNode* node)
@@ -42,6 +48,7 @@ namespace Terrain
         {
             mChanged = true;
             mNodes.clear();
+            mClusters.clear();
         }
     }
 
@@ -63,6 +70,7 @@ namespace Terrain
         mNumEntries = 0;
         mChanged = false;
         mNodes.clear();
+        mClusters.clear();
     }
 
     void ViewData::clear()
@@ -74,6 +82,8 @@ namespace Terrain
         mChanged = false;
         mHasViewPoint = false;
         mNodes.clear();
+        mClusters.clear();
+        mPendingView = nullptr;
     }
 
     bool ViewData::suitableToUse(const osg::Vec4i& activeGrid) const
@@ -107,9 +117,33 @@ namespace Terrain
         mNodes.erase(it);
     }
 
+    ViewData& ViewData::getOrCreatePendingView()
+    {
+        if (mPendingView == nullptr)
+            mPendingView = std::make_unique<ViewData>();
+        return *mPendingView;
+    }
+
+    void ViewData::buildClusters()
+    {
+        if (!mClusters.empty())
+            return;
+
+        mClusters.reserve((mNumEntries + clusterSize - 1) / clusterSize);
+        for (unsigned int begin = 0; begin < mNumEntries; begin += clusterSize)
+        {
+            ViewDataCluster& cluster = mClusters.emplace_back();
+            cluster.mBegin = begin;
+            cluster.mEnd = std::min(begin + clusterSize, mNumEntries);
+            for (unsigned int i = cluster.mBegin; i < cluster.mEnd; ++i)
+                cluster.mBoundingBox.expandBy(mEntries[i].mRenderingNode->getBound());
+        }
+    }
+
     ViewDataEntry::ViewDataEntry()
         : mNode(nullptr)
         , mLodFlags(0)
+        , mPinnedEdges(0)
     {
     }
 
@@ -160,6 +194,7 @@ namespace Terrain
             }
             if (mostSuitableView && mostSuitableView != vd)
             {
+                vd->discardPendingView();
                 vd->copyFrom(*mostSuitableView);
                 return vd;
             }
@@ -2,8 +2,10 @@
 #define OPENMW_COMPONENTS_TERRAIN_VIEWDATA_H
 
 #include <deque>
+#include <memory>
 #include <vector>
 
+#include <osg/BoundingBox>
 #include <osg/Node>
 
 #include "view.hpp"
@@ -22,9 +24,19 @@ namespace Terrain
         QuadTreeNode* mNode;
 
         unsigned int mLodFlags;
+        // Edges shared with more detailed chunks, one bit per Direction, only used with geomorphing
+        unsigned int mPinnedEdges;
         osg::ref_ptr<osg::Node> mRenderingNode;
     };
 
+    /// Range of consecutive entries with their combined bounds, for culling them at once.
+    struct ViewDataCluster
+    {
+        unsigned int mBegin;
+        unsigned int mEnd;
+        osg::BoundingBox mBoundingBox;
+    };
+
     class ViewData : public View
     {
     public:
@@ -68,6 +80,8 @@ namespace Terrain
                 mEntries.clear();
                 mNumEntries = 0;
                 mNodes.clear();
+                mClusters.clear();
+                mPendingView = nullptr;
             }
         }
 
@@ -78,10 +92,28 @@ namespace Terrain
 
         void removeNodeFromIndex(const QuadTreeNode* node);
 
+        /// Group entries into clusters. Entries are added in quadtree order, so consecutive entries are close to each
+        /// other. All entries must have a rendering node.
+        void buildClusters();
+
+        const std::vector<ViewDataCluster>& getClusters() const { return mClusters; }
+
+        /// View being built over several frames to replace this one once all its rendering nodes are loaded.
+        ViewData& getOrCreatePendingView();
+        ViewData* getPendingView() { return mPendingView.get(); }
+        void discardPendingView() { mPendingView = nullptr; }
+
+        /// Number of entries of this view with a loaded rendering node, used for a pending view.
+        unsigned int getNumLoadedEntries() const { return mNumLoadedEntries; }
+        void setNumLoadedEntries(unsigned int value) { mNumLoadedEntries = value; }
+
     private:
         std::vector<ViewDataEntry> mEntries;
         std::vector<const QuadTreeNode*> mNodes;
+        std::vector<ViewDataCluster> mClusters;
+        std::unique_ptr<ViewData> mPendingView;
         unsigned int mNumEntries;
+        unsigned int mNumLoadedEntries;
         double mLastUsageTimeStamp;
         bool mChanged;
         osg::Vec3f mViewPoint;
@@ -3,11 +3,14 @@
 #include <osg/Camera>
 #include <osg/Group>
 
+#include <components/debug/debuglog.hpp>
 #include <components/resource/resourcesystem.hpp>
 #include <components/resource/scenemanager.hpp>
+#include <components/sceneutil/glextensions.hpp>
 #include <components/settings/values.hpp>
 
 #include "chunkmanager.hpp"
+#include "compositemapcache.hpp"
 #include "compositemaprenderer.hpp"
 #include "heightcull.hpp"
 #include "storage.hpp"
@@ -85,6 +88,7 @@ namespace Terrain
 
         if (mCompositeMapCamera && mCompositeMapRenderer)
         {
+            mCompositeMapRenderer->setCompositeMapCache(nullptr);
             mCompositeMapCamera->removeChild(mCompositeMapRenderer);
             mCompositeMapCamera->getParent(0)->removeChild(mCompositeMapCamera);
         }
@@ -124,6 +128,27 @@ namespace Terrain
         mCompositeMapRenderer->setTargetFrameRate(rate);
     }
 
+    void World::enableCompositeMapCache(const std::filesystem::path& path)
+    {
+        if (!mChunkManager)
+            return;
+        mCompositeMapCache = std::make_unique<CompositeMapCache>(path);
+        mChunkManager->setCompositeMapCache(mCompositeMapCache.get());
+        mCompositeMapRenderer->setCompositeMapCache(mCompositeMapCache.get());
+    }
+
+    void World::enableTextureArrays()
+    {
+        if (!mChunkManager)
+            return;
+        if (!SceneUtil::glExtensionsReady() || !SceneUtil::getGLExtensions().isTexture2DArraySupported)
+        {
+            Log(Debug::Warning) << "Terrain texture arrays are not supported by the GPU";
+            return;
+        }
+        mChunkManager->setTextureArrays(true);
+    }
+
     float World::getHeightAt(const osg::Vec3f& worldPos)
     {
         return mStorage->getHeightAt(worldPos, mWorldspace);
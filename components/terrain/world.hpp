@@ -5,6 +5,7 @@
 #include <osg/Vec3f>
 #include <osg/ref_ptr>
 
+#include <filesystem>
 #include <memory>
 #include <set>
 
@@ -34,6 +35,7 @@ namespace Terrain
 
     class TextureManager;
     class ChunkManager;
+    class CompositeMapCache;
     class CompositeMapRenderer;
     class View;
     class HeightCullCallback;
@@ -58,6 +60,14 @@ namespace Terrain
         /// See CompositeMapRenderer::setTargetFrameRate
         void setTargetFrameRate(float rate);
 
+        /// Store rendered composite maps in the given directory and use them instead of rendering again.
+        /// @note Not thread safe, has to be called before any chunk is created.
+        void enableCompositeMapCache(const std::filesystem::path& path);
+
+        /// Draw chunks with several layers in a single pass if their textures fit into a texture array.
+        /// @note Not thread safe, has to be called before any chunk is created.
+        void enableTextureArrays();
+
         /// Apply the scene manager's texture filtering settings to all cached textures.
         /// @note Thread safe.
         void updateTextureFiltering();
@@ -124,6 +134,7 @@ namespace Terrain
 
         std::unique_ptr<TextureManager> mTextureManager;
         std::unique_ptr<ChunkManager> mChunkManager;
+        std::unique_ptr<CompositeMapCache> mCompositeMapCache;
 
         std::unique_ptr<CellBorder> mCellBorder;
 
@@ -2,10 +2,16 @@
 
 #include <algorithm>
 #include <cassert>
+#include <cstdint>
 #include <ios>
 #include <iterator>
 #include <stdexcept>
 
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define OPENMW_TOUTF8_SSE2
+#endif
+
 #include <components/debug/debuglog.hpp>
 
 /* This file contains the code to translate from WINDOWS-1252 (native
@@ -47,9 +53,47 @@ using namespace ToUTF8;
 
 namespace
 {
+    bool isAscii(unsigned char v)
+    {
+        return v != 0 && v < 128;
+    }
+
+#ifdef OPENMW_TOUTF8_SSE2
+    constexpr std::ptrdiff_t asciiBlockSize = 16;
+
+    // Checks whether none of asciiBlockSize bytes starting at the given one is zero or not ASCII
+    bool isAsciiBlock(const char* it)
+    {
+        const __m128i value = _mm_loadu_si128(reinterpret_cast<const __m128i*>(it));
+        // The high bit of each byte is set for non-ASCII bytes, zero bytes are found by the comparison
+        return _mm_movemask_epi8(_mm_or_si128(value, _mm_cmpeq_epi8(value, _mm_setzero_si128()))) == 0;
+    }
+#else
+    constexpr std::ptrdiff_t asciiBlockSize = 8;
+
+    bool isAsciiBlock(const char* it)
+    {
+        constexpr std::uint64_t ones = 0x0101010101010101;
+        constexpr std::uint64_t highBits = 0x8080808080808080;
+        std::uint64_t value;
+        std::memcpy(&value, it, sizeof(value));
+        // The high bit of a byte is set in the first operand for non-ASCII bytes, in the second one for zero bytes
+        return ((value | ((value - ones) & ~value)) & highBits) == 0;
+    }
+#endif
+
+    // Finds the first byte that is zero or not ASCII a block at a time
+    const char* skipAscii(const char* begin, const char* end)
+    {
+        const char* it = begin;
+        while (end - it >= asciiBlockSize && isAsciiBlock(it))
+            it += asciiBlockSize;
+        return std::find_if_not(it, end, [](unsigned char v) { return isAscii(v); });
+    }
+
     std::string_view::iterator skipAscii(std::string_view input)
     {
-        return std::find_if(input.begin(), input.end(), [](unsigned char v) { return v == 0 || v >= 128; });
+        return input.begin() + (skipAscii(input.data(), input.data() + input.size()) - input.data());
     }
 
     std::span<const signed char> getTranslationArray(FromType sourceEncoding)
@@ -126,9 +170,23 @@ std::string_view StatelessUtf8Encoder::getUtf8(
     resize(outlen, bufferAllocationPolicy, buffer);
     char* out = buffer.data();
 
-    // Translate
-    for (auto it = input.begin(); it != input.end() && *it != 0; ++it)
-        copyFromArray(*it, out);
+    // Translate, copying the ASCII blocks as they are. Text with more
+    // than a few non-ASCII characters goes byte by byte through the
+    // blocks containing them.
+    const char* const end = input.data() + input.size();
+    const char* it = input.data();
+    while (it != end && *it != 0)
+    {
+        if (end - it >= asciiBlockSize && isAsciiBlock(it))
+        {
+            out = std::copy_n(it, asciiBlockSize, out);
+            it += asciiBlockSize;
+            continue;
+        }
+        const char* const blockEnd = it + std::min(asciiBlockSize, end - it);
+        for (; it != blockEnd && *it != 0; ++it)
+            copyFromArray(*it, out);
+    }
 
     // Make sure that we wrote the correct number of bytes
     assert((out - buffer.data()) == (int)outlen);
@@ -201,14 +259,24 @@ std::pair<std::size_t, bool> StatelessUtf8Encoder::getLength(std::string_view in
         return { it - input.begin(), true };
 
     std::size_t len = it - input.begin();
+    const char* const end = input.data() + input.size();
+    const char* current = input.data() + len;
 
     do
     {
-        // Find the translated length of this character in the
+        // Every character of an ASCII block is translated into itself.
+        if (end - current >= asciiBlockSize && isAsciiBlock(current))
+        {
+            len += asciiBlockSize;
+            current += asciiBlockSize;
+            continue;
+        }
+        // Find the translated length of each character in the
         // lookup table.
-        len += mTranslationArray[static_cast<unsigned char>(*it) * 6];
-        ++it;
-    } while (it != input.end() && *it != 0);
+        const char* const blockEnd = current + std::min(asciiBlockSize, end - current);
+        for (; current != blockEnd && *current != 0; ++current)
+            len += mTranslationArray[static_cast<unsigned char>(*current) * 6];
+    } while (current != end && *current != 0);
 
     return { len, false };
 }
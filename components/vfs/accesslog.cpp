@@ -0,0 +1,52 @@
+#include "accesslog.hpp"
+
+#include <stdexcept>
+
+namespace VFS
+{
+    AccessLog::AccessLog(const std::filesystem::path& path)
+        : mStart(std::chrono::steady_clock::now())
+        , mStream(path, std::ios::out | std::ios::trunc)
+    {
+        if (!mStream)
+            throw std::runtime_error("Failed to open resource access log " + path.string());
+    }
+
+    void AccessLog::record(std::string_view normalizedPath)
+    {
+        const auto time
+            = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - mStart);
+        const std::lock_guard lock(mMutex);
+        if (mStopped || mRecorded.contains(normalizedPath))
+            return;
+        mRecorded.emplace(normalizedPath);
+        mStream << time.count() << '\t' << normalizedPath << '\n';
+        mStream.flush();
+    }
+
+    void AccessLog::stop()
+    {
+        const std::lock_guard lock(mMutex);
+        mStopped = true;
+        mRecorded.clear();
+        mStream.close();
+    }
+
+    std::vector<Path::Normalized> readAccessLog(std::istream& stream)
+    {
+        std::vector<Path::Normalized> result;
+        std::set<std::string, std::less<>> paths;
+        std::string line;
+        while (std::getline(stream, line))
+        {
+            const std::size_t separator = line.find('\t');
+            if (separator == std::string::npos)
+                continue;
+            Path::Normalized path(std::string_view(line).substr(separator + 1));
+            if (path.value().empty() || !paths.emplace(path.view()).second)
+                continue;
+            result.push_back(std::move(path));
+        }
+        return result;
+    }
+}
@@ -0,0 +1,43 @@
+#ifndef OPENMW_COMPONENTS_VFS_ACCESSLOG_H
+#define OPENMW_COMPONENTS_VFS_ACCESSLOG_H
+
+#include "pathutil.hpp"
+
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <istream>
+#include <mutex>
+#include <set>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace VFS
+{
+    /// @brief Writes the order the files are first opened in to lay them out in an archive in the same order later.
+    /// @par Each line holds the milliseconds since the log is opened and the normalized path separated by a tab.
+    /// @note Thread safe.
+    class AccessLog
+    {
+    public:
+        explicit AccessLog(const std::filesystem::path& path);
+
+        void record(std::string_view normalizedPath);
+
+        /// Close the log, the accesses after are not recorded.
+        void stop();
+
+    private:
+        const std::chrono::steady_clock::time_point mStart;
+        std::mutex mMutex;
+        std::ofstream mStream;
+        std::set<std::string, std::less<>> mRecorded;
+        bool mStopped = false;
+    };
+
+    /// @return paths in the order they are first found in the log
+    std::vector<Path::Normalized> readAccessLog(std::istream& stream);
+}
+
+#endif
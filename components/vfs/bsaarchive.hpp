@@ -64,11 +64,13 @@ namespace VFS
     class BsaArchive : public Archive
     {
     public:
-        BsaArchive(const std::filesystem::path& filename, const ToUTF8::StatelessUtf8Encoder* encoder)
+        BsaArchive(
+            const std::filesystem::path& filename, const ToUTF8::StatelessUtf8Encoder* encoder, bool memoryMapped)
             : Archive()
             , mEncoder(encoder)
         {
             mFile = std::make_unique<BSAFileType>();
+            mFile->setMemoryMapped(memoryMapped);
             mFile->open(filename);
 
             std::string buffer;
@@ -115,20 +117,20 @@ namespace VFS
     };
 
     inline std::unique_ptr<VFS::Archive> makeBsaArchive(
-        const std::filesystem::path& path, const ToUTF8::StatelessUtf8Encoder* encoder)
+        const std::filesystem::path& path, const ToUTF8::StatelessUtf8Encoder* encoder, bool memoryMapped = false)
     {
         switch (Bsa::BSAFile::detectVersion(path))
         {
             case Bsa::BsaVersion::Unknown:
                 break;
             case Bsa::BsaVersion::Uncompressed:
-                return std::make_unique<BsaArchive<Bsa::BSAFile>>(path, encoder);
+                return std::make_unique<BsaArchive<Bsa::BSAFile>>(path, encoder, memoryMapped);
             case Bsa::BsaVersion::Compressed:
-                return std::make_unique<BsaArchive<Bsa::CompressedBSAFile>>(path, encoder);
+                return std::make_unique<BsaArchive<Bsa::CompressedBSAFile>>(path, encoder, memoryMapped);
             case Bsa::BsaVersion::BA2GNRL:
-                return std::make_unique<BsaArchive<Bsa::BA2GNRLFile>>(path, encoder);
+                return std::make_unique<BsaArchive<Bsa::BA2GNRLFile>>(path, encoder, memoryMapped);
             case Bsa::BsaVersion::BA2DX10:
-                return std::make_unique<BsaArchive<Bsa::BA2DX10File>>(path, encoder);
+                return std::make_unique<BsaArchive<Bsa::BA2DX10File>>(path, encoder, memoryMapped);
         }
 
         throw std::runtime_error("Unknown archive type '" + Files::pathToUnicodeString(path) + "'");
@@ -1,12 +1,17 @@
 #include "manager.hpp"
 
+#include <algorithm>
+#include <atomic>
 #include <cassert>
+#include <future>
 #include <stdexcept>
+#include <thread>
 
 #include <components/files/conversion.hpp>
 #include <components/misc/strings/lower.hpp>
 #include <components/vfs/recursivedirectoryiterator.hpp>
 
+#include "accesslog.hpp"
 #include "archive.hpp"
 #include "file.hpp"
 #include "pathutil.hpp"
@@ -20,6 +25,7 @@ namespace VFS
 
     void Manager::reset()
     {
+        mLookup.clear();
         mIndex.clear();
         mArchives.clear();
     }
@@ -29,12 +35,49 @@ namespace VFS
         mArchives.push_back(std::move(archive));
     }
 
+    void Manager::addAccessLog(std::unique_ptr<AccessLog>&& accessLog)
+    {
+        mAccessLogs.push_back(std::move(accessLog));
+    }
+
     void Manager::buildIndex()
     {
+        mLookup.clear();
         mIndex.clear();
 
-        for (const auto& archive : mArchives)
-            archive->listResources(mIndex);
+        std::vector<FileMap> indices(mArchives.size());
+        std::atomic_size_t next = 0;
+        const auto list = [&] {
+            for (std::size_t i; (i = next++) < mArchives.size();)
+                mArchives[i]->listResources(indices[i]);
+        };
+
+        {
+            const std::size_t threads
+                = std::min<std::size_t>(mArchives.size(), std::max(1U, std::thread::hardware_concurrency()));
+            std::vector<std::future<void>> tasks;
+            for (std::size_t i = 1; i < threads; ++i)
+                tasks.push_back(std::async(std::launch::async, list));
+            list();
+            for (std::future<void>& task : tasks)
+                task.get();
+        }
+
+        // The last added archive has priority, merge keeps the files already in the index and moves the nodes
+        for (auto it = indices.rbegin(); it != indices.rend(); ++it)
+            mIndex.merge(*it);
+
+        mLookup.reserve(mIndex.size());
+        for (const auto& [path, file] : mIndex)
+            mLookup.emplace(path.view(), file);
+    }
+
+    File* Manager::findFile(std::string_view normalizedPath) const
+    {
+        const auto it = mLookup.find(normalizedPath);
+        if (it == mLookup.end())
+            return nullptr;
+        return it->second;
     }
 
     Files::IStreamPtr Manager::find(Path::NormalizedView name) const
@@ -42,6 +85,14 @@ namespace VFS
         return findNormalized(name.value());
     }
 
+    Files::IStreamPtr Manager::findUnrecorded(Path::NormalizedView name) const
+    {
+        File* const file = findFile(name.value());
+        if (file == nullptr)
+            return nullptr;
+        return file->open();
+    }
+
     Files::IStreamPtr Manager::get(const Path::Normalized& name) const
     {
         return getNormalized(name);
@@ -63,12 +114,12 @@ namespace VFS
 
     bool Manager::exists(const Path::Normalized& name) const
     {
-        return mIndex.find(name) != mIndex.end();
+        return findFile(name.view()) != nullptr;
     }
 
     bool Manager::exists(Path::NormalizedView name) const
     {
-        return mIndex.find(name) != mIndex.end();
+        return findFile(name.value()) != nullptr;
     }
 
     std::string Manager::getArchive(const Path::Normalized& name) const
@@ -83,18 +134,18 @@ namespace VFS
 
     std::filesystem::file_time_type Manager::getLastModified(VFS::Path::NormalizedView name) const
     {
-        const auto found = mIndex.find(name);
-        if (found == mIndex.end())
+        const File* const file = findFile(name.value());
+        if (file == nullptr)
             throw std::runtime_error("Resource '" + std::string(name.value()) + "' not found");
-        return found->second->getLastModified();
+        return file->getLastModified();
     }
 
     std::string Manager::getStem(VFS::Path::NormalizedView name) const
     {
-        const auto found = mIndex.find(name);
-        if (found == mIndex.end())
+        const File* const file = findFile(name.value());
+        if (file == nullptr)
             throw std::runtime_error("Resource '" + std::string(name.value()) + "' not found");
-        return found->second->getStem();
+        return file->getStem();
     }
 
     RecursiveDirectoryRange Manager::getRecursiveDirectoryIterator(std::string_view path) const
@@ -129,9 +180,11 @@ namespace VFS
     Files::IStreamPtr Manager::findNormalized(std::string_view normalizedPath) const
     {
         assert(Path::isNormalized(normalizedPath));
-        const auto it = mIndex.find(normalizedPath);
-        if (it == mIndex.end())
+        File* const file = findFile(normalizedPath);
+        if (file == nullptr)
             return nullptr;
-        return it->second->open();
+        for (const std::unique_ptr<AccessLog>& accessLog : mAccessLogs)
+            accessLog->record(normalizedPath);
+        return file->open();
     }
 }
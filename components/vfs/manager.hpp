@@ -7,6 +7,7 @@
 #include <memory>
 #include <string>
 #include <string_view>
+#include <unordered_map>
 #include <vector>
 
 #include "filemap.hpp"
@@ -14,6 +15,7 @@
 
 namespace VFS
 {
+    class AccessLog;
     class Archive;
     class RecursiveDirectoryRange;
 
@@ -39,6 +41,10 @@ namespace VFS
         /// Build the file index. Should be called when all archives have been registered.
         void buildIndex();
 
+        /// Record the order the files are opened in to one more log.
+        /// @note Should be called before the files are opened from other threads.
+        void addAccessLog(std::unique_ptr<AccessLog>&& accessLog);
+
         /// Does a file with this name exist?
         /// @note May be called from any thread once the index has been built.
         bool exists(const Path::Normalized& name) const;
@@ -48,6 +54,10 @@ namespace VFS
         // Returns open file if exists or nullptr.
         Files::IStreamPtr find(Path::NormalizedView name) const;
 
+        /// Same as find but the access logs don't record it, to read files ahead without changing what is recorded.
+        /// @note May be called from any thread once the index has been built.
+        Files::IStreamPtr findUnrecorded(Path::NormalizedView name) const;
+
         /// Retrieve a file by name.
         /// @note Throws an exception if the file can not be found.
         /// @note May be called from any thread once the index has been built.
@@ -75,6 +85,12 @@ namespace VFS
         std::vector<std::unique_ptr<Archive>> mArchives;
 
         FileMap mIndex;
+        // Keys point to the ones of mIndex. Exact lookups are much more frequent than iterating over directories, a
+        // failed one costs a hash and mostly no comparison.
+        std::unordered_map<std::string_view, File*, Path::Hash, std::equal_to<>> mLookup;
+        std::vector<std::unique_ptr<AccessLog>> mAccessLogs;
+
+        File* findFile(std::string_view normalizedPath) const;
 
         inline Files::IStreamPtr findNormalized(std::string_view normalizedPath) const;
 
@@ -4,10 +4,14 @@
 #include <components/misc/strings/lower.hpp>
 
 #include <algorithm>
+#include <cstdint>
+#include <iterator>
+#include <memory>
 #include <ostream>
 #include <stdexcept>
 #include <string>
 #include <string_view>
+#include <type_traits>
 
 namespace VFS::Path
 {
@@ -24,14 +28,32 @@ namespace VFS::Path
         return std::all_of(name.begin(), name.end(), [](char v) { return v == normalize(v); });
     }
 
+    inline void normalizeFilenameInPlace(char* data, std::size_t size)
+    {
+        namespace Word = Misc::StringUtils::Word;
+        std::size_t i = 0;
+        for (; i + Word::size <= size; i += Word::size)
+        {
+            const std::uint64_t value = Word::toLower(Word::load(data + i));
+            const std::uint64_t backslashes = Word::equal(value, '\\') >> 7;
+            Word::store(value ^ (backslashes * ('\\' ^ separator)), data + i);
+        }
+        for (; i < size; ++i)
+            data[i] = normalize(data[i]);
+    }
+
     inline void normalizeFilenameInPlace(auto begin, auto end)
     {
-        std::transform(begin, end, begin, normalize);
+        using Iterator = decltype(begin);
+        if constexpr (std::contiguous_iterator<Iterator> && std::is_same_v<std::iter_value_t<Iterator>, char>)
+            normalizeFilenameInPlace(std::to_address(begin), static_cast<std::size_t>(end - begin));
+        else
+            std::transform(begin, end, begin, normalize);
     }
 
     inline void normalizeFilenameInPlace(std::string& name)
     {
-        normalizeFilenameInPlace(name.begin(), name.end());
+        normalizeFilenameInPlace(name.data(), name.size());
     }
 
     /// Normalize the given filename, making slashes/backslashes consistent, and lower-casing.
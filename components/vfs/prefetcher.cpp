@@ -0,0 +1,55 @@
+#include "prefetcher.hpp"
+
+#include "manager.hpp"
+
+#include <components/debug/debuglog.hpp>
+
+#include <chrono>
+#include <istream>
+
+namespace VFS
+{
+    Prefetcher::Prefetcher(const Manager& vfs, std::vector<Path::Normalized>&& paths)
+        : mVFS(vfs)
+        , mPaths(std::move(paths))
+        , mThread([this] { run(); })
+    {
+    }
+
+    Prefetcher::~Prefetcher()
+    {
+        mStop = true;
+        mThread.join();
+    }
+
+    void Prefetcher::run() noexcept
+    {
+        const auto start = std::chrono::steady_clock::now();
+        std::vector<char> buffer(64 * 1024);
+        std::size_t files = 0;
+        std::size_t bytes = 0;
+        for (const Path::Normalized& path : mPaths)
+        {
+            if (mStop)
+                break;
+            try
+            {
+                const Files::IStreamPtr stream = mVFS.findUnrecorded(path);
+                if (stream == nullptr)
+                    continue;
+                while (!mStop && stream->read(buffer.data(), static_cast<std::streamsize>(buffer.size())))
+                    bytes += buffer.size();
+                bytes += static_cast<std::size_t>(stream->gcount());
+                ++files;
+            }
+            catch (const std::exception& e)
+            {
+                Log(Debug::Warning) << "Failed to prefetch " << path << ": " << e.what();
+            }
+        }
+        Log(Debug::Verbose) << "Prefetched " << files << " of " << mPaths.size() << " files, " << bytes
+                            << " bytes in "
+                            << std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count()
+                            << " s";
+    }
+}
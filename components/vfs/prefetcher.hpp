@@ -0,0 +1,35 @@
+#ifndef OPENMW_COMPONENTS_VFS_PREFETCHER_H
+#define OPENMW_COMPONENTS_VFS_PREFETCHER_H
+
+#include "pathutil.hpp"
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+namespace VFS
+{
+    class Manager;
+
+    /// @brief Reads files on a background thread and throws the data away, so the OS file cache has them when they
+    /// are opened later while the disk would be idle otherwise.
+    /// @par The files are read in the given order, the reads are not recorded by the access logs of the manager.
+    class Prefetcher
+    {
+    public:
+        explicit Prefetcher(const Manager& vfs, std::vector<Path::Normalized>&& paths);
+
+        /// Stops reading after the current file.
+        ~Prefetcher();
+
+    private:
+        const Manager& mVFS;
+        const std::vector<Path::Normalized> mPaths;
+        std::atomic_bool mStop{ false };
+        std::thread mThread;
+
+        void run() noexcept;
+    };
+}
+
+#endif
@@ -1,8 +1,13 @@
 #include "registerarchives.hpp"
 
+#include <algorithm>
+#include <atomic>
 #include <filesystem>
+#include <functional>
+#include <future>
 #include <set>
 #include <stdexcept>
+#include <thread>
 
 #include <components/debug/debuglog.hpp>
 
@@ -14,10 +19,15 @@ namespace VFS
 {
 
     void registerArchives(VFS::Manager* vfs, const Files::Collections& collections,
-        const std::vector<std::string>& archives, bool useLooseFiles, const ToUTF8::StatelessUtf8Encoder* encoder)
+        const std::vector<std::string>& archives, bool useLooseFiles, const ToUTF8::StatelessUtf8Encoder* encoder,
+        bool memoryMappedArchives)
     {
         const Files::PathContainer& dataDirs = collections.getPaths();
 
+        // Opening a BSA reads its file list and a data directory is scanned recursively, so create the archives in
+        // parallel and add them in the order of their priority afterwards
+        std::vector<std::function<std::unique_ptr<Archive>()>> factories;
+
         for (std::vector<std::string>::const_iterator archive = archives.begin(); archive != archives.end(); ++archive)
         {
             if (collections.doesExist(*archive))
@@ -25,7 +35,8 @@ namespace VFS
                 // Last BSA has the highest priority
                 const auto archivePath = collections.getPath(*archive);
                 Log(Debug::Info) << "Adding BSA archive " << archivePath;
-                vfs->addArchive(makeBsaArchive(archivePath, encoder));
+                factories.push_back(
+                    [=] { return makeBsaArchive(archivePath, encoder, memoryMappedArchives); });
             }
             else
             {
@@ -42,13 +53,34 @@ namespace VFS
                 {
                     Log(Debug::Info) << "Adding data directory " << dataDir;
                     // Last data dir has the highest priority
-                    vfs->addArchive(std::make_unique<FileSystemArchive>(dataDir));
+                    factories.push_back([&dataDir] { return std::make_unique<FileSystemArchive>(dataDir); });
                 }
                 else
                     Log(Debug::Info) << "Ignoring duplicate data directory " << dataDir;
             }
         }
 
+        std::vector<std::unique_ptr<Archive>> created(factories.size());
+        std::atomic_size_t next = 0;
+        const auto create = [&] {
+            for (std::size_t i; (i = next++) < factories.size();)
+                created[i] = factories[i]();
+        };
+
+        {
+            const std::size_t threads
+                = std::min<std::size_t>(factories.size(), std::max(1U, std::thread::hardware_concurrency()));
+            std::vector<std::future<void>> tasks;
+            for (std::size_t i = 1; i < threads; ++i)
+                tasks.push_back(std::async(std::launch::async, create));
+            create();
+            for (std::future<void>& task : tasks)
+                task.get();
+        }
+
+        for (std::unique_ptr<Archive>& archive : created)
+            vfs->addArchive(std::move(archive));
+
         vfs->buildIndex();
     }
 
@@ -35,6 +35,10 @@ namespace Gui
 
     void AutoSizedTextBox::setCaption(const MyGUI::UString& value)
     {
+        // Laying out the same text again and resizing the parent boxes is a waste
+        if (value == getCaption())
+            return;
+
         TextBox::setCaption(value);
 
         notifySizeChange(this);
@@ -89,6 +93,9 @@ namespace Gui
 
     void AutoSizedEditBox::setCaption(const MyGUI::UString& value)
     {
+        if (value == getCaption())
+            return;
+
         EditBox::setCaption(value);
         mWasResized = false;
 
@@ -131,6 +138,9 @@ namespace Gui
 
     void AutoSizedButton::setCaption(const MyGUI::UString& value)
     {
+        if (value == getCaption())
+            return;
+
         Button::setCaption(value);
 
         notifySizeChange(this);
@@ -36,6 +36,9 @@ namespace Video
         /// @note Takes ownership of the passed pointer.
         void setAudioFactory (MovieAudioFactory* factory);
 
+        /// Decode videos played from now on on the GPU when the codec and the platform support it.
+        void setHardwareDecoding(bool enabled);
+
         /// Return true if a video is currently playing and it has an audio stream.
         bool hasAudioStream();
 
@@ -77,6 +80,8 @@ namespace Video
         VideoState* mState;
 
         std::unique_ptr<MovieAudioFactory> mAudioFactory;
+
+        bool mHardwareDecoding;
     };
 
 }
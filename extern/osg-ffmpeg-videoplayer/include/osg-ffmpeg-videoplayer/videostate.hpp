@@ -130,6 +130,10 @@ struct VideoState {
 
     void setAudioFactory(MovieAudioFactory* factory);
 
+    /// Decode the video on the GPU when the codec and the platform support it, falls back to the CPU otherwise.
+    /// @note Has to be set before init.
+    void setHardwareDecoding(bool enabled);
+
     void init(std::unique_ptr<std::istream>&& inputstream, const std::string& name);
     void deinit();
 
@@ -139,6 +143,8 @@ struct VideoState {
     double getDuration() const;
 
     int stream_open(int stream_index, AVFormatContext *pFormatCtx);
+    void open_hw_device(const AVCodec* codec);
+    static AVPixelFormat get_hw_format(AVCodecContext* ctx, const AVPixelFormat* formats);
 
     bool update();
 
@@ -191,6 +197,10 @@ struct VideoState {
     PacketQueue videoq;
     SwsContext*  sws_context;
     int sws_context_w, sws_context_h;
+    AVPixelFormat sws_context_format;
+    bool mHardwareDecoding;
+    AVBufferRef* hw_device_ctx;
+    AVPixelFormat hw_pix_fmt;
     std::array<VideoPicture, VIDEO_PICTURE_QUEUE_SIZE+1> pictq;  // allocate one extra to make sure we do not overwrite the osg::Image currently set on the texture
     int pictq_size;
     unsigned long pictq_rindex, pictq_windex;
@@ -13,6 +13,7 @@ namespace Video
 
 VideoPlayer::VideoPlayer()
     : mState(nullptr)
+    , mHardwareDecoding(false)
 {
 
 }
@@ -28,6 +29,11 @@ void VideoPlayer::setAudioFactory(MovieAudioFactory *factory)
     mAudioFactory.reset(factory);
 }
 
+void VideoPlayer::setHardwareDecoding(bool enabled)
+{
+    mHardwareDecoding = enabled;
+}
+
 void VideoPlayer::playVideo(std::unique_ptr<std::istream>&& inputstream, const std::string& name)
 {
     if(mState)
@@ -36,6 +42,7 @@ void VideoPlayer::playVideo(std::unique_ptr<std::istream>&& inputstream, const s
     try {
         mState = new VideoState;
         mState->setAudioFactory(mAudioFactory.get());
+        mState->setHardwareDecoding(mHardwareDecoding);
         mState->init(std::move(inputstream), name);
 
         // wait until we have the first picture
@@ -21,6 +21,8 @@ extern "C"
     #include <libavcodec/avcodec.h>
     #include <libavformat/avformat.h>
     #include <libswscale/swscale.h>
+    #include <libavutil/hwcontext.h>
+    #include <libavutil/pixdesc.h>
     #include <libavutil/time.h>
 }
 
@@ -88,7 +90,8 @@ VideoState::VideoState()
     , audio_st(nullptr)
     , video_st(nullptr), frame_last_pts(0.0)
     , video_clock(0.0), sws_context(nullptr)
-    , sws_context_w(0), sws_context_h(0)
+    , sws_context_w(0), sws_context_h(0), sws_context_format(AV_PIX_FMT_NONE)
+    , mHardwareDecoding(false), hw_device_ctx(nullptr), hw_pix_fmt(AV_PIX_FMT_NONE)
     , pictq_size(0), pictq_rindex(0), pictq_windex(0)
     , mSeekRequested(false)
     , mSeekPos(0)
@@ -377,30 +380,47 @@ int VideoState::queue_picture(const AVFrame &pFrame, double pts)
     // windex is set to 0 initially
     vp = &this->pictq[this->pictq_windex];
 
+    // Frames decoded on the GPU are copied back first, usually as NV12
+    const AVFrame* frame = &pFrame;
+    std::unique_ptr<AVFrame, AVFrameFree> swFrame;
+    if (pFrame.format != AV_PIX_FMT_NONE && pFrame.format == this->hw_pix_fmt)
+    {
+        swFrame.reset(av_frame_alloc());
+        if (swFrame == nullptr || av_hwframe_transfer_data(swFrame.get(), &pFrame, 0) < 0)
+        {
+            OSG_WARN << "Failed to transfer a decoded video frame from the GPU" << std::endl;
+            return 0;
+        }
+        frame = swFrame.get();
+    }
+
     // Convert the image into RGBA format
     // TODO: we could do this in a pixel shader instead, if the source format
     // matches a commonly used format (ie YUV420P)
-    const int w = pFrame.width;
-    const int h = pFrame.height;
-    if(this->sws_context == nullptr || this->sws_context_w != w || this->sws_context_h != h)
+    const int w = frame->width;
+    const int h = frame->height;
+    const AVPixelFormat format = static_cast<AVPixelFormat>(frame->format);
+    if(this->sws_context == nullptr || this->sws_context_w != w || this->sws_context_h != h
+        || this->sws_context_format != format)
     {
         if (this->sws_context != nullptr)
             sws_freeContext(this->sws_context);
-        this->sws_context = sws_getContext(w, h, this->video_ctx->pix_fmt,
+        this->sws_context = sws_getContext(w, h, format,
                                            w, h, AV_PIX_FMT_RGBA, SWS_BICUBIC,
                                            nullptr, nullptr, nullptr);
         if(this->sws_context == nullptr)
             throw std::runtime_error("Cannot initialize the conversion context!\n");
         this->sws_context_w = w;
         this->sws_context_h = h;
+        this->sws_context_format = format;
     }
 
     vp->pts = pts;
     if (vp->set_dimensions(w, h) < 0)
         return -1;
 
-    sws_scale(this->sws_context, pFrame.data, pFrame.linesize,
-              0, this->video_ctx->height, vp->rgbaFrame->data, vp->rgbaFrame->linesize);
+    sws_scale(this->sws_context, frame->data, frame->linesize,
+              0, h, vp->rgbaFrame->data, vp->rgbaFrame->linesize);
 
     // now we inform our display thread that we have a pic ready
     this->pictq_windex = (this->pictq_windex+1) % this->pictq.size();
@@ -718,6 +738,9 @@ int VideoState::stream_open(int stream_index, AVFormatContext *pFormatCtx)
         av_codec_set_pkt_timebase(this->video_ctx, pFormatCtx->streams[stream_index]->time_base);
 #endif
 
+        if (mHardwareDecoding)
+            open_hw_device(codec);
+
         if (avcodec_open2(this->video_ctx, codec, nullptr) < 0)
         {
             fprintf(stderr, "Unsupported codec!\n");
@@ -734,6 +757,52 @@ int VideoState::stream_open(int stream_index, AVFormatContext *pFormatCtx)
     return 0;
 }
 
+void VideoState::open_hw_device(const AVCodec* codec)
+{
+#if LIBAVCODEC_VERSION_INT >= AV_VERSION_INT(58, 18, 100)
+    for (int i = 0;; ++i)
+    {
+        const AVCodecHWConfig* config = avcodec_get_hw_config(codec, i);
+        if (config == nullptr)
+            break;
+        if (!(config->methods & AV_CODEC_HW_CONFIG_METHOD_HW_DEVICE_CTX))
+            continue;
+        // VAAPI, DXVA2, D3D11VA, VideoToolbox... whichever the platform provides first
+        if (av_hwdevice_ctx_create(&this->hw_device_ctx, config->device_type, nullptr, nullptr, 0) < 0)
+            continue;
+        this->hw_pix_fmt = config->pix_fmt;
+        this->video_ctx->hw_device_ctx = av_buffer_ref(this->hw_device_ctx);
+        this->video_ctx->opaque = this;
+        this->video_ctx->get_format = get_hw_format;
+        OSG_INFO << "Decoding video with " << av_hwdevice_get_type_name(config->device_type) << std::endl;
+        return;
+    }
+#endif
+    OSG_INFO << "No hardware video decoding available for " << codec->name << std::endl;
+}
+
+AVPixelFormat VideoState::get_hw_format(AVCodecContext* ctx, const AVPixelFormat* formats)
+{
+    const VideoState* self = static_cast<const VideoState*>(ctx->opaque);
+    for (const AVPixelFormat* format = formats; *format != AV_PIX_FMT_NONE; ++format)
+        if (*format == self->hw_pix_fmt)
+            return *format;
+
+    // The decoder can't use the device for this stream, decode it in software
+    for (const AVPixelFormat* format = formats; *format != AV_PIX_FMT_NONE; ++format)
+    {
+        const AVPixFmtDescriptor* descriptor = av_pix_fmt_desc_get(*format);
+        if (descriptor != nullptr && !(descriptor->flags & AV_PIX_FMT_FLAG_HWACCEL))
+            return *format;
+    }
+    return AV_PIX_FMT_NONE;
+}
+
+void VideoState::setHardwareDecoding(bool enabled)
+{
+    mHardwareDecoding = enabled;
+}
+
 void VideoState::init(std::unique_ptr<std::istream>&& inputstream, const std::string &name)
 {
     int video_index = -1;
@@ -841,6 +910,10 @@ void VideoState::deinit()
     this->video_st = nullptr;
     this->video_ctx = nullptr;
 
+    if(this->hw_device_ctx)
+        av_buffer_unref(&this->hw_device_ctx);
+    this->hw_pix_fmt = AV_PIX_FMT_NONE;
+
     if(this->sws_context)
         sws_freeContext(this->sws_context);
     this->sws_context = nullptr;
@@ -295,6 +295,18 @@
 -- @type ObjectList
 -- @list <#GameObject>
 
+---
+-- Positions of all objects of the list as a flat array of numbers: x, y and z of the first object, then of the second one and so on.
+-- Faster than reading `object.position` of every object. The numbers are NaN for objects that don't exist anymore.
+-- @function [parent=#ObjectList] getPositions
+-- @param self
+-- @return #list<#number>
+-- @usage
+-- local positions = nearby.actors:getPositions()
+-- for i = 1, #nearby.actors do
+--     local x, y, z = positions[i * 3 - 2], positions[i * 3 - 1], positions[i * 3]
+-- end
+
 
 ---
 -- A cell of the game world.
@@ -448,6 +460,16 @@
 -- local all = playerInventory:getAll()
 -- local weapons = playerInventory:getAll(types.Weapon)
 
+---
+-- Get the total count of the items of every recordId in the inventory, optionally only of the given type.
+-- Faster than @{#Inventory.getAll} when the items themselves are not needed.
+-- @function [parent=#Inventory] getRecordCounts
+-- @param self
+-- @param type (optional) items type (see @{openmw.types#types})
+-- @return #map<#string, #number> recordId to count
+-- @usage
+-- for recordId, count in pairs(inventory:getRecordCounts(types.Potion)) do ... end
+
 ---
 -- Get first item with the given recordId from the inventory. Returns nil if not found.
 -- @function [parent=#Inventory] find
@@ -30,6 +30,40 @@
 -- List of nearby players. Currently (since multiplayer is not yet implemented) always has one element.
 -- @field [parent=#nearby] openmw.core#ObjectList players
 
+---
+-- @type OBJECT_GROUP
+-- @field [parent=#OBJECT_GROUP] #number Activators Objects from @{#nearby.activators}
+-- @field [parent=#OBJECT_GROUP] #number Actors Objects from @{#nearby.actors}
+-- @field [parent=#OBJECT_GROUP] #number Containers Objects from @{#nearby.containers}
+-- @field [parent=#OBJECT_GROUP] #number Doors Objects from @{#nearby.doors}
+-- @field [parent=#OBJECT_GROUP] #number Items Objects from @{#nearby.items}
+
+---
+-- Groups of nearby objects that are used in `query`.
+-- @field [parent=#nearby] #OBJECT_GROUP OBJECT_GROUP
+
+---
+-- A table of parameters for @{#nearby.query}
+-- @type QueryOptions
+-- @field openmw.util#Vector3 center
+-- @field #number radius
+-- @field #number type Group of objects to look for (see @{openmw.nearby#OBJECT_GROUP})
+-- @field #function filter An optional function that receives an @{openmw.core#GameObject} and returns true to keep it
+
+---
+-- Find nearby objects of a group within a radius. Much faster than iterating over a list like `nearby.actors`
+-- in Lua, as only the objects close to the center are looked at.
+-- Objects are found by their positions at the first query of the group in the frame.
+-- @function [parent=#nearby] query
+-- @param #QueryOptions options
+-- @return openmw.core#ObjectList Objects sorted by distance to the center, closest first
+-- @usage local enemies = nearby.query{
+--     center = self.position,
+--     radius = 500,
+--     type = nearby.OBJECT_GROUP.Actors,
+--     filter = function(actor) return actor ~= self.object and types.Actor.isDead(actor) == false end,
+-- }
+
 ---
 -- Return an object by RefNum/FormId.
 -- Note: the function always returns @{openmw.core#GameObject} and doesn't validate that
@@ -481,6 +481,20 @@
 -- @param openmw.core#GameObject actor
 -- @return #DynamicStat
 
+---
+-- Current and base values of health, magicka and fatigue of many actors as a flat array of numbers, six per actor:
+-- current and base health, current and base magicka, current and base fatigue.
+-- Faster than reading the stats of every actor one by one. The numbers are NaN for objects that aren't actors or don't exist anymore.
+-- Values set by the script in the same frame are not applied yet and not included.
+-- @function [parent=#DynamicStats] snapshot
+-- @param objects openmw.core#ObjectList or a list of openmw.core#GameObject
+-- @return #list<#number>
+-- @usage
+-- local stats = types.Actor.stats.dynamic.snapshot(nearby.actors)
+-- for i = 1, #nearby.actors do
+--     local health = stats[i * 6 - 5]
+-- end
+
 ---
 -- @type AIStats
 
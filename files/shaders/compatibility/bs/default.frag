@@ -32,8 +32,7 @@ varying float linearDepth;
 varying vec3 passViewPos;
 varying vec3 passNormal;
 
-uniform vec2 screenRes;
-uniform float far;
+#include "lib/core/uniforms.glsl"
 uniform float alphaRef;
 uniform float emissiveMult;
 uniform float specStrength;
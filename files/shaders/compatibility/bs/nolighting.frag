@@ -20,10 +20,8 @@ varying float euclideanDepth;
 varying float linearDepth;
 varying float passFalloff;
 
-uniform vec2 screenRes;
+#include "lib/core/uniforms.glsl"
 uniform bool useFalloff;
-uniform float far;
-uniform float near;
 uniform float alphaRef;
 
 #include "lib/core/fragment.h.glsl"
@@ -1,10 +1,10 @@
 #if @skyBlending
 #include "lib/core/fragment.h.glsl"
 
-uniform float skyBlendingStart;
+#include "lib/core/uniforms.glsl"
 #endif
 
-vec4 applyFogAtDist(vec4 color, float euclideanDist, float linearDist, float far)
+vec4 applyFogAtDist(vec4 color, float euclideanDist, float linearDist, float farPlane)
 {
 #if @radialFog
     float dist = euclideanDist;
@@ -23,7 +23,7 @@ vec4 applyFogAtDist(vec4 color, float euclideanDist, float linearDist, float far
 #endif
 
 #if @skyBlending
-    float fadeValue = clamp((far - dist) / (far - skyBlendingStart), 0.0, 1.0);
+    float fadeValue = clamp((farPlane - dist) / (farPlane - skyBlendingStart), 0.0, 1.0);
     fadeValue *= fadeValue;
 #ifdef ADDITIVE_BLENDING
     color.xyz *= fadeValue;
@@ -35,7 +35,7 @@ vec4 applyFogAtDist(vec4 color, float euclideanDist, float linearDist, float far
     return color;
 }
 
-vec4 applyFogAtPos(vec4 color, vec3 pos, float far)
+vec4 applyFogAtPos(vec4 color, vec3 pos, float farPlane)
 {
-    return applyFogAtDist(color, length(pos), pos.z, far);
+    return applyFogAtDist(color, length(pos), pos.z, farPlane);
 }
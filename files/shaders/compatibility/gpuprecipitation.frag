@@ -0,0 +1,22 @@
+#version 120
+
+uniform sampler2D diffuseMap;
+uniform float precipitationAlpha;
+
+varying vec2 diffuseMapUV;
+
+#if @particleOcclusion
+#include "lib/particle/occlusion.glsl"
+uniform sampler2D orthoDepthMap;
+varying vec3 orthoDepthMapCoord;
+#endif
+
+void main()
+{
+#if @particleOcclusion
+    applyOcclusionDiscard(orthoDepthMapCoord, texture2D(orthoDepthMap, orthoDepthMapCoord.xy * 0.5 + 0.5).r);
+#endif
+
+    gl_FragData[0] = texture2D(diffuseMap, diffuseMapUV);
+    gl_FragData[0].a *= precipitationAlpha;
+}
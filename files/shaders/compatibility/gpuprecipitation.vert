@@ -0,0 +1,48 @@
+#version 120
+
+#include "lib/core/vertex.h.glsl"
+
+// Position of the drop inside the range, each component is in [0, 1)
+attribute vec3 dropSeed;
+
+uniform vec3 precipitationRange;
+uniform vec3 precipitationOffset;
+uniform vec3 precipitationCameraPosition;
+uniform vec3 precipitationVelocity;
+uniform vec2 dropSize;
+
+varying vec2 diffuseMapUV;
+
+#if @particleOcclusion
+varying vec3 orthoDepthMapCoord;
+
+uniform mat4 depthSpaceMatrix;
+uniform mat4 osg_ViewMatrixInverse;
+#endif
+
+void main()
+{
+    // Drops move with the offset and wrap around the camera, the model space has world axes and the camera at origin
+    vec3 halfRange = precipitationRange * 0.5;
+    vec3 center = mod(dropSeed * precipitationRange + precipitationOffset - precipitationCameraPosition + halfRange,
+                      precipitationRange) - halfRange;
+
+    float speed = length(precipitationVelocity);
+    vec3 dir = speed > 0.0 ? precipitationVelocity / speed : vec3(0.0, 0.0, -1.0);
+    vec3 side = cross(dir, center);
+    float sideLength = length(side);
+    side = sideLength > 0.0 ? side / sideLength : vec3(1.0, 0.0, 0.0);
+
+    // gl_Vertex.x is in [-0.5, 0.5] across the streak, gl_Vertex.y is in [0, 1] along it
+    vec4 vertex = vec4(center + side * (gl_Vertex.x * dropSize.x) - dir * (gl_Vertex.y * dropSize.y), 1.0);
+
+#if @particleOcclusion
+    mat4 model = osg_ViewMatrixInverse * gl_ModelViewMatrix;
+    orthoDepthMapCoord = ((depthSpaceMatrix * model) * vertex).xyz;
+#endif
+
+    gl_Position = modelToClip(vertex);
+    gl_ClipVertex = modelToView(vertex);
+
+    diffuseMapUV = gl_MultiTexCoord0.xy;
+}
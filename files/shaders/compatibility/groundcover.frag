@@ -26,8 +26,7 @@ varying vec2 normalMapUV;
 
 varying float euclideanDepth;
 varying float linearDepth;
-uniform vec2 screenRes;
-uniform float far;
+#include "lib/core/uniforms.glsl"
 uniform float alphaRef;
 
 #if PER_PIXEL_LIGHTING
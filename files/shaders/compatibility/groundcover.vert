@@ -47,8 +47,7 @@ varying vec3 passNormal;
 uniform float osg_SimulationTime;
 uniform mat4 osg_ViewMatrixInverse;
 uniform mat4 osg_ViewMatrix;
-uniform float windSpeed;
-uniform vec3 playerPos;
+#include "lib/core/uniforms.glsl"
 
 #if @groundcoverStompMode == 0
 #else
@@ -59,6 +58,12 @@ uniform vec3 playerPos;
     #define STOMP_INTENSITY_LEVEL @groundcoverStompIntensity
 #endif
 
+#if @grassInteraction
+uniform sampler2D grassInteractionMap;
+// xy = centre of the area covered by the map, z = 1 / size of the area, w = maximum displacement
+uniform vec4 grassInteractionParams;
+#endif
+
 vec2 groundcoverDisplacement(in vec3 worldpos, float h)
 {
     vec2 windDirection = vec2(1.0);
@@ -98,7 +103,15 @@ vec2 groundcoverDisplacement(in vec3 worldpos, float h)
 #endif
 #endif
 
-    return clamp(0.02 * h, 0.0, 1.0) * (harmonics * displace + stomp);
+    vec2 interaction = vec2(0.0);
+#if @grassInteraction
+    // The map wraps around, only the area around the player holds valid displacement
+    vec2 interactionUV = worldpos.xy * grassInteractionParams.z;
+    if (all(lessThan(abs(worldpos.xy - grassInteractionParams.xy) * grassInteractionParams.z, vec2(0.5))))
+        interaction = (texture2DLod(grassInteractionMap, interactionUV, 0.0).ra * 2.0 - 1.0) * grassInteractionParams.w;
+#endif
+
+    return clamp(0.02 * h, 0.0, 1.0) * (harmonics * displace + stomp + interaction);
 }
 
 mat4 rotation(in vec3 angle)
@@ -62,9 +62,7 @@ uniform sampler2D glossMap;
 varying vec2 glossMapUV;
 #endif
 
-uniform vec2 screenRes;
-uniform float near;
-uniform float far;
+#include "lib/core/uniforms.glsl"
 uniform float alphaRef;
 uniform float distortionStrength;
 
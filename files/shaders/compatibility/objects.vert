@@ -72,6 +72,26 @@ varying vec4 passTangent;
 #include "lib/light/lighting.glsl"
 #include "lib/view/depth.glsl"
 
+#if @skinning
+#include "lib/core/skinning.glsl"
+
+attribute vec4 boneIndices;
+attribute vec4 boneWeights;
+#endif
+
+#if @morphing
+#include "lib/core/morphing.glsl"
+
+attribute vec2 morphTexCoord;
+#endif
+
+#if @instancing
+#include "lib/core/instancing.glsl"
+
+attribute vec4 instanceOffset;
+attribute vec4 instanceRotation;
+#endif
+
 #if @particleOcclusion
 varying vec3 orthoDepthMapCoord;
 
@@ -81,22 +101,43 @@ uniform mat4 osg_ViewMatrixInverse;
 
 void main(void)
 {
+#if @skinning
+    mat4 skinMatrix = skinningMatrix(boneIndices, boneWeights);
+    vec4 vertex = skinMatrix * vec4(gl_Vertex.xyz, 1.0);
+    vec3 normal = mat3(skinMatrix) * gl_Normal.xyz;
+#elif @morphing
+    vec4 vertex = morphVertex(gl_Vertex, morphTexCoord);
+    vec3 normal = gl_Normal.xyz;
+#elif @instancing
+    vec4 vertex = instanceTransform(gl_Vertex, instanceOffset, instanceRotation);
+    vec3 normal = instanceRotate(gl_Normal.xyz, instanceRotation);
+#else
+    vec4 vertex = gl_Vertex;
+    vec3 normal = gl_Normal.xyz;
+#endif
+
 #if @particleOcclusion
     mat4 model = osg_ViewMatrixInverse * gl_ModelViewMatrix;
-    orthoDepthMapCoord = ((depthSpaceMatrix * model) * vec4(gl_Vertex.xyz, 1.0)).xyz;
+    orthoDepthMapCoord = ((depthSpaceMatrix * model) * vec4(vertex.xyz, 1.0)).xyz;
 #endif
 
-    gl_Position = modelToClip(gl_Vertex);
+    gl_Position = modelToClip(vertex);
 
-    vec4 viewPos = modelToView(gl_Vertex);
+    vec4 viewPos = modelToView(vertex);
     gl_ClipVertex = viewPos;
     passColor = gl_Color;
     passViewPos = viewPos.xyz;
-    passNormal = gl_Normal.xyz;
+    passNormal = normal;
     normalToViewMatrix = gl_NormalMatrix;
 
 #if @normalMap || @diffuseParallax
+#if @skinning
+    passTangent = vec4(mat3(skinMatrix) * gl_MultiTexCoord7.xyz, gl_MultiTexCoord7.w);
+#elif @instancing
+    passTangent = vec4(instanceRotate(gl_MultiTexCoord7.xyz, instanceRotation), gl_MultiTexCoord7.w);
+#else
     passTangent = gl_MultiTexCoord7.xyzw;
+#endif
     normalToViewMatrix *= generateTangentSpace(passTangent, passNormal);
 #endif
 
@@ -8,12 +8,31 @@ uniform int colorMode;
 uniform bool useTreeAnim;
 uniform bool useDiffuseMapForShadowAlpha = true;
 uniform bool alphaTestShadows = true;
+uniform bool useSkinning = false;
+uniform bool useInstancing = false;
+uniform bool useMorphing = false;
+
+#include "lib/core/skinning.glsl"
+#include "lib/core/instancing.glsl"
+#include "lib/core/morphing.glsl"
+
+// Bone indices and weights for skinning, instance offset and rotation for instancing, delta map texel for morphing
+attribute vec4 extraAttrib0;
+attribute vec4 extraAttrib1;
 
 void main(void)
 {
-    gl_Position = gl_ModelViewProjectionMatrix * gl_Vertex;
+    vec4 vertex = gl_Vertex;
+    if (useSkinning)
+        vertex = skinningMatrix(extraAttrib0, extraAttrib1) * vec4(gl_Vertex.xyz, 1.0);
+    else if (useInstancing)
+        vertex = instanceTransform(gl_Vertex, extraAttrib0, extraAttrib1);
+    else if (useMorphing)
+        vertex = morphVertex(gl_Vertex, extraAttrib0.xy);
+
+    gl_Position = gl_ModelViewProjectionMatrix * vertex;
 
-    vec4 viewPos = (gl_ModelViewMatrix * gl_Vertex);
+    vec4 viewPos = (gl_ModelViewMatrix * vertex);
     gl_ClipVertex = viewPos;
 
     if (useDiffuseMapForShadowAlpha)
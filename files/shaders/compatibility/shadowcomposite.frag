@@ -0,0 +1,30 @@
+#version 120
+
+uniform sampler2D staticShadowTexture;
+// Clip space of the shadow map being rendered to clip space of the static shadow map and back
+uniform mat4 staticShadowMatrix;
+uniform mat4 inverseStaticShadowMatrix;
+
+varying vec2 shadowClipCoord;
+
+void main()
+{
+    // Each texel is a ray along the light direction, find where it crosses the static shadow map
+    vec4 nearPoint = staticShadowMatrix * vec4(shadowClipCoord, -1.0, 1.0);
+    vec4 farPoint = staticShadowMatrix * vec4(shadowClipCoord, 1.0, 1.0);
+    nearPoint.xyz /= nearPoint.w;
+    farPoint.xyz /= farPoint.w;
+
+    vec2 uv = nearPoint.xy * 0.5 + 0.5;
+    if (any(lessThan(uv, vec2(0.0))) || any(greaterThan(uv, vec2(1.0))))
+        discard;
+
+    float depth = texture2D(staticShadowTexture, uv).r;
+    if (depth >= 1.0)
+        discard;
+
+    // The static shadow map is orthographic, so its depth is linear along the ray
+    float t = (depth * 2.0 - 1.0 - nearPoint.z) / (farPoint.z - nearPoint.z);
+    vec4 position = inverseStaticShadowMatrix * vec4(mix(nearPoint.xyz, farPoint.xyz, t), 1.0);
+    gl_FragDepth = position.z / position.w * 0.5 + 0.5;
+}
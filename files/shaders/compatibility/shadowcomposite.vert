@@ -0,0 +1,9 @@
+#version 120
+
+varying vec2 shadowClipCoord;
+
+void main()
+{
+    gl_Position = gl_Vertex;
+    shadowClipCoord = gl_Vertex.xy;
+}
@@ -8,15 +8,26 @@
     #extension GL_EXT_gpu_shader4: require
 #endif
 
+#if @layerArray
+    #extension GL_EXT_texture_array : require
+#endif
+
 varying vec2 uv;
 
+#if @layerArray
+// All layers are blended in a single pass, layerIndices maps blendmap channels to diffuse map layers
+uniform sampler2DArray diffuseMap;
+uniform sampler2DArray blendMap;
+uniform float layerIndices[@layerCount];
+#else
 uniform sampler2D diffuseMap;
+#endif
 
 #if @normalMap
 uniform sampler2D normalMap;
 #endif
 
-#if @blendMap
+#if @blendMap && !@layerArray
 uniform sampler2D blendMap;
 #endif
 
@@ -34,8 +45,11 @@ centroid varying vec3 shadowSpecularLighting;
 varying vec3 passViewPos;
 varying vec3 passNormal;
 
-uniform vec2 screenRes;
-uniform float far;
+#if @terrainMorph
+varying float morphFactor;
+#endif
+
+#include "lib/core/uniforms.glsl"
 
 #include "vertexcolors.glsl"
 #include "shadows_fragment.glsl"
@@ -52,7 +66,28 @@ void main()
     float height = texture2D(normalMap, adjustedUV).a;
     adjustedUV += getParallaxOffset(transpose(normalToViewMatrix) * normalize(-passViewPos), height);
 #endif
+#if @layerArray
+    vec2 blendMapUV = (gl_TextureMatrix[1] * vec4(uv, 0.0, 1.0)).xy;
+    vec4 diffuseTex = vec4(0.0);
+    vec4 blend = vec4(0.0);
+    for (int i = 0; i < @layerCount; ++i)
+    {
+        // Every slice of the blendmap array holds the weights of four layers
+        int channel = i - (i / 4) * 4;
+        if (channel == 0)
+            blend = texture2DArray(blendMap, vec3(blendMapUV, float(i / 4)));
+        diffuseTex += texture2DArray(diffuseMap, vec3(adjustedUV, layerIndices[i])) * blend[channel];
+    }
+    gl_FragData[0] = vec4(diffuseTex.xyz, 1.0);
+
+    vec4 diffuseColor = getDiffuseColor();
+#else
+#if @terrainMorph && @morphTexture
+    // Match the resolution of the next coarser LOD level by the time it replaces the chunk
+    vec4 diffuseTex = texture2D(diffuseMap, adjustedUV, morphFactor);
+#else
     vec4 diffuseTex = texture2D(diffuseMap, adjustedUV);
+#endif
     gl_FragData[0] = vec4(diffuseTex.xyz, 1.0);
 
     vec4 diffuseColor = getDiffuseColor();
@@ -62,6 +97,7 @@ void main()
     vec2 blendMapUV = (gl_TextureMatrix[1] * vec4(uv, 0.0, 1.0)).xy;
     gl_FragData[0].a *= texture2D(blendMap, blendMapUV).a;
 #endif
+#endif
 
 #if @normalMap
     vec4 normalTex = texture2D(normalMap, adjustedUV);
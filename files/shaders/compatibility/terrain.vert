@@ -24,6 +24,18 @@ centroid varying vec3 shadowSpecularLighting;
 varying vec3 passViewPos;
 varying vec3 passNormal;
 
+#if @terrainMorph
+// Height of the vertex with the next coarser LOD level
+attribute float morphHeight;
+// xy: world position of the chunk, z: distance the morph starts at, w: inverse of the distance it takes
+uniform vec4 terrainMorph;
+// Vertices outside of the bounds are on edges shared with more detailed chunks and keep their height
+uniform vec4 terrainMorphBounds;
+// Point the LOD levels are chosen for, in world space
+uniform vec3 terrainViewPoint;
+varying float morphFactor;
+#endif
+
 #include "vertexcolors.glsl"
 #include "shadows_vertex.glsl"
 #include "compatibility/normals.glsl"
@@ -33,9 +45,19 @@ varying vec3 passNormal;
 
 void main(void)
 {
-    gl_Position = modelToClip(gl_Vertex);
+    vec4 modelPos = gl_Vertex;
+#if @terrainMorph
+    vec3 worldPos = vec3(terrainMorph.xy + modelPos.xy, modelPos.z);
+    morphFactor = clamp((distance(worldPos, terrainViewPoint) - terrainMorph.z) * terrainMorph.w, 0.0, 1.0);
+    bvec2 insideMin = greaterThanEqual(modelPos.xy, terrainMorphBounds.xy);
+    bvec2 insideMax = lessThanEqual(modelPos.xy, terrainMorphBounds.zw);
+    if (all(insideMin) && all(insideMax))
+        modelPos.z = mix(modelPos.z, morphHeight, morphFactor);
+#endif
+
+    gl_Position = modelToClip(modelPos);
 
-    vec4 viewPos = modelToView(gl_Vertex);
+    vec4 viewPos = modelToView(modelPos);
     gl_ClipVertex = viewPos;
     euclideanDepth = length(viewPos.xyz);
     linearDepth = getLinearDepth(gl_Position.z, viewPos.z);
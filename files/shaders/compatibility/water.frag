@@ -63,7 +63,7 @@ vec2 normalCoords(vec2 uv, float scale, float speed, float time, float timer1, f
 }
 
 uniform sampler2D rippleMap;
-uniform vec3 playerPos;
+#include "lib/core/uniforms.glsl"
 
 varying vec3 worldPos;
 
@@ -76,13 +76,10 @@ uniform sampler2D normalMap;
 
 uniform float osg_SimulationTime;
 
-uniform float near;
-uniform float far;
 
 uniform float rainIntensity;
 uniform bool enableRainRipples;
 
-uniform vec2 screenRes;
 
 #define PER_PIXEL_LIGHTING 0
 
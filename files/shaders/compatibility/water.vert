@@ -1,5 +1,9 @@
 #version 120
 
+#if @useUBO
+    #extension GL_ARB_uniform_buffer_object : require
+#endif
+
 #include "lib/core/vertex.h.glsl"
 
 varying vec4  position;
@@ -9,7 +13,7 @@ varying float linearDepth;
 #include "lib/view/depth.glsl"
 
 uniform vec3 nodePosition;
-uniform vec3 playerPos;
+#include "lib/core/uniforms.glsl"
 
 varying vec3 worldPos;
 varying vec2 rippleMapUV;
@@ -0,0 +1,18 @@
+#ifndef LIB_CORE_INSTANCING
+#define LIB_CORE_INSTANCING
+
+// Same as osg::Quat::operator*(const osg::Vec3&)
+vec3 instanceRotate(vec3 v, vec4 rotation)
+{
+    vec3 uv = cross(rotation.xyz, v);
+    vec3 uuv = cross(rotation.xyz, uv);
+    return v + 2.0 * (rotation.w * uv + uuv);
+}
+
+// offset.w holds the uniform scale
+vec4 instanceTransform(vec4 vertex, vec4 offset, vec4 rotation)
+{
+    return vec4(instanceRotate(vertex.xyz * offset.w, rotation) + offset.xyz, 1.0);
+}
+
+#endif
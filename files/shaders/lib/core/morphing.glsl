@@ -0,0 +1,29 @@
+#ifndef LIB_CORE_MORPHING
+#define LIB_CORE_MORPHING
+
+// Must match SceneUtil::MorphGeometry::sMaxGpuMorphTargets
+#define MAX_MORPH_TARGETS 32
+
+uniform sampler2D morphDeltaMap;
+uniform float morphWeights[MAX_MORPH_TARGETS];
+uniform int morphTargetCount;
+// xy: inverse size of the delta map, z: rows of the delta map per morph target
+uniform vec3 morphDeltaMapParams;
+
+// texCoord is the texel of the vertex in the rows of the first morph target
+vec4 morphVertex(vec4 vertex, vec2 texCoord)
+{
+    vec3 result = vertex.xyz;
+    for (int i = 0; i < MAX_MORPH_TARGETS; ++i)
+    {
+        if (i >= morphTargetCount)
+            break;
+        if (morphWeights[i] == 0.0)
+            continue;
+        vec2 uv = (texCoord + vec2(0.5, 0.5 + float(i) * morphDeltaMapParams.z)) * morphDeltaMapParams.xy;
+        result += texture2DLod(morphDeltaMap, uv, 0.0).xyz * morphWeights[i];
+    }
+    return vec4(result, vertex.w);
+}
+
+#endif
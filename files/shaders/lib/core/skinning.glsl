@@ -0,0 +1,24 @@
+#ifndef LIB_CORE_SKINNING
+#define LIB_CORE_SKINNING
+
+// Must match SceneUtil::RigGeometry::sMaxGpuSkinningBones
+#define MAX_SKINNING_BONES 64
+
+uniform mat4 boneMatrices[MAX_SKINNING_BONES];
+uniform mat4 skinTransform;
+
+mat4 skinningMatrix(vec4 boneIndices, vec4 boneWeights)
+{
+    mat4 result = boneWeights.x * boneMatrices[int(boneIndices.x)]
+        + boneWeights.y * boneMatrices[int(boneIndices.y)]
+        + boneWeights.z * boneMatrices[int(boneIndices.z)]
+        + boneWeights.w * boneMatrices[int(boneIndices.w)];
+    // weights don't always sum up to one, keep the matrix affine like CPU skinning does
+    result[0][3] = 0.0;
+    result[1][3] = 0.0;
+    result[2][3] = 0.0;
+    result[3][3] = 1.0;
+    return skinTransform * result;
+}
+
+#endif
@@ -0,0 +1,29 @@
+#ifndef LIB_CORE_UNIFORMS
+#define LIB_CORE_UNIFORMS
+
+// Has to match SceneUtil::SharedUniformData
+#if @useUBO
+// Only vec4 members, so the default shared layout matches std140 without a layout qualifier
+uniform SharedUniforms
+{
+    vec4 sharedUniforms0;
+    vec4 sharedUniforms1;
+    vec4 sharedUniforms2;
+};
+
+#define playerPos sharedUniforms0.xyz
+#define near sharedUniforms0.w
+#define screenRes sharedUniforms1.xy
+#define far sharedUniforms1.z
+#define skyBlendingStart sharedUniforms1.w
+#define windSpeed sharedUniforms2.x
+#else
+uniform vec3 playerPos;
+uniform float near;
+uniform vec2 screenRes;
+uniform float far;
+uniform float skyBlendingStart;
+uniform float windSpeed;
+#endif
+
+#endif
@@ -55,9 +55,16 @@ void doLighting(vec3 viewPos, vec3 viewNormal, float shininess, out vec3 diffuse
     specularLight = vec3(0.0);
 #endif
 
+#if @lightingMethodClustered
+    ivec2 clusterCell = lcalcClusterCell(viewPos);
+    int clusterLightCount = lcalcClusterLightCount(clusterCell);
+#endif
+
     for (int i = @startLight; i < @endLight; ++i)
     {
-#if @lightingMethodUBO
+#if @lightingMethodClustered
+        int lightIndex = lcalcClusterLightIndex(clusterCell, i);
+#elif @lightingMethodUBO
         int lightIndex = PointLightIndex[i];
 #else
         int lightIndex = i;
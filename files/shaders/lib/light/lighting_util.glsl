@@ -44,6 +44,38 @@ uniform LightBufferBinding
     LightData LightBuffer[@maxLightsInScene];
 };
 
+#if @lightingMethodClustered
+/* Layout:
+Every cluster is a run of (max lights per cluster + 1) texels in a row: the light count followed by the light buffer
+indices. Rows are the Y clusters of every depth slice.
+*/
+uniform sampler2D omw_ClusterGrid;
+// clusters x, clusters y, clusters z, max lights per cluster
+uniform vec4 omw_ClusterInfo;
+// log(near + 1), log(far + 1) of the depth slicing
+uniform vec2 omw_ClusterDepth;
+uniform mat4 projectionMatrix;
+
+ivec2 lcalcClusterCell(vec3 viewPos)
+{
+    vec4 clipPos = projectionMatrix * vec4(viewPos, 1.0);
+    vec2 screenPos = clipPos.xy / clipPos.w * 0.5 + 0.5;
+    float slice = (log(max(-viewPos.z, 0.0) + 1.0) - omw_ClusterDepth.x) / (omw_ClusterDepth.y - omw_ClusterDepth.x);
+    ivec3 cluster = ivec3(clamp(vec3(screenPos, slice), 0.0, 0.9999) * omw_ClusterInfo.xyz);
+    return ivec2(cluster.x * (int(omw_ClusterInfo.w) + 1), cluster.z * int(omw_ClusterInfo.y) + cluster.y);
+}
+
+int lcalcClusterLightCount(ivec2 cell)
+{
+    return int(texelFetch2D(omw_ClusterGrid, cell, 0).r);
+}
+
+int lcalcClusterLightIndex(ivec2 cell, int i)
+{
+    return int(texelFetch2D(omw_ClusterGrid, cell + ivec2(i + 1, 0), 0).r);
+}
+#endif
+
 #elif @lightingMethodPerObjectUniform
 
 /* Layout:
@@ -3,20 +3,20 @@
 
 #include "lib/util/quickstep.glsl"
 
-float viewDepth(float depth, float near, float far)
+float viewDepth(float depth, float nearPlane, float farPlane)
 {
 #if @reverseZ
     depth = 1.0 - depth;
 #endif
-    return (near * far) / ((far - near) * depth - far);
+    return (nearPlane * farPlane) / ((farPlane - nearPlane) * depth - farPlane);
 }
 
 float calcSoftParticleFade(
     in vec3 viewDir,
     in vec3 viewPos,
     in vec3 viewNormal,
-    float near,
-    float far,
+    float nearPlane,
+    float farPlane,
     float depth,
     float size,
     bool fade,
@@ -28,7 +28,7 @@ float calcSoftParticleFade(
     const float falloffMultiplier = 0.33;
     const float contrast = 1.30;
 
-    float sceneDepth = viewDepth(depth, near, far);
+    float sceneDepth = viewDepth(depth, nearPlane, farPlane);
     float particleDepth = viewPos.z;
     float falloff = size * falloffMultiplier;
     float delta = particleDepth - sceneDepth;
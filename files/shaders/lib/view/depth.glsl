@@ -1,13 +1,13 @@
 #ifndef LIB_VIEW_DEPTH
 #define LIB_VIEW_DEPTH
 
-float linearizeDepth(float depth, float near, float far)
+float linearizeDepth(float depth, float nearPlane, float farPlane)
 {
 #if @reverseZ
     depth = 1.0 - depth;
 #endif
     float z_n = 2.0 * depth - 1.0;
-    depth = 2.0 * near * far / (far + near - z_n * (far - near));
+    depth = 2.0 * nearPlane * farPlane / (farPlane + nearPlane - z_n * (farPlane - nearPlane));
     return depth;
 }
 